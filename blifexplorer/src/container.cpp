@@ -111,8 +111,11 @@ bool Container::addConnectionHash(QString start, QString end)
 //at the moment wire crossing is not considered
 void Container::arrangeContainer()
 {
+    //moving every item would update the index of the scene each time: rebuild it once instead
+    myScene->setItemIndexMethod(QGraphicsScene::NoIndex);
     computeLayers();
     spreadLayers();
+    myScene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
     myScene->setSceneRect(0,0,1000.0+400*maxlayer+maxcountPerLayer*50,1000.0+400*maxcountPerLayer);
 }
 
@@ -243,10 +246,13 @@ void Container::copySimCyclesIntoNodes()
 void Container::computeLayers()
 {
     QQueue<LogicUnit*> nodequeue;
+    //nodes which were ever enqueued: they are either still in the queue or done
+    QSet<LogicUnit*> queuedset;
     QHash<QString, LogicUnit*> donehashtable;
     for (int i = 0; i < myOdin->blifexplorer_netlist->num_top_input_nodes; i++){
         QString name = myOdin->blifexplorer_netlist->top_input_nodes[i]->name;
         nodequeue.enqueue(getReferenceToUnit(name));
+        queuedset.insert(nodequeue.last());
     }
 
     // Enqueue constant nodes.
@@ -257,6 +263,7 @@ void Container::computeLayers()
     for (int i = 0; i < num_constant_nodes; i++){
         QString name = constant_nodes[i]->name;
         nodequeue.enqueue(getReferenceToUnit(name));
+        queuedset.insert(nodequeue.last());
     }
 
     // go through the netlist. While doing so
@@ -290,27 +297,24 @@ void Container::computeLayers()
             QString kidName(nodeKid->name);
             LogicUnit* kidUnit = getReferenceToUnit(kidName);
 
-            bool inQueue = nodequeue.contains(kidUnit);
-            bool done = donehashtable.contains(kidName);
+            bool inQueueOrDone = queuedset.contains(kidUnit);
 
-            if(!inQueue && !done && parentsDone(kidUnit,donehashtable)){
+            if(!inQueueOrDone && parentsDone(kidUnit,donehashtable)){
                 nodequeue.enqueue(kidUnit);
+                queuedset.insert(kidUnit);
             }
         }
     }
     maxlayer++;
     /*Locate all outputs at the very end of the graph*/
     QHash<QString, LogicUnit*>::const_iterator blockIterator = unithashtable.constBegin();
-    for(int i = 0; i<=maxlayer;i++){
-        blockIterator = unithashtable.constBegin();
-        while(blockIterator != unithashtable.constEnd()){
-            LogicUnit* actUnit = blockIterator.value();
-            if(actUnit->getName().contains("top^out")){
-                actUnit->setLayer(maxlayer);
-            }
-
-            ++blockIterator;
+    while(blockIterator != unithashtable.constEnd()){
+        LogicUnit* actUnit = blockIterator.value();
+        if(actUnit->getName().contains("top^out")){
+            actUnit->setLayer(maxlayer);
         }
+
+        ++blockIterator;
     }
 
 }
@@ -325,23 +329,25 @@ void Container::spreadLayers()
     int counter = 0;
     int offset = 200;
 
+    //sort the visible units by layer first, so the netlist is only visited once
+    QVector<QList<LogicUnit*> > layerUnits(maxlayer+1);
+    while(blockIterator != unithashtable.constEnd()){
+        LogicUnit* actUnit = blockIterator.value();
+        if(actUnit->isVisible() && actUnit->getLayer() >= 0 && actUnit->getLayer() <= maxlayer){
+            layerUnits[actUnit->getLayer()].append(actUnit);
+        }
+        ++blockIterator;
+    }
+
     for(int i = 0; i<=maxlayer;i++){
-        blockIterator = unithashtable.constBegin();
-
-        while(blockIterator != unithashtable.constEnd()){
-            LogicUnit* actUnit = blockIterator.value();
-            if(actUnit->isVisible()){
-                if(actUnit->getLayer()== i){
-                    actUnit->setPos(offset+15*counter,100.0+200*counter);
-                    actUnit->updateWires();
-                    lastUnit = actUnit;
-                    counter++;
-                }
-                if(maxcountPerLayer < counter){
-                    maxcountPerLayer = counter;
-                }
-            }
-            ++blockIterator;
+        foreach(LogicUnit* actUnit, layerUnits[i]){
+            actUnit->setPos(offset+15*counter,100.0+200*counter);
+            actUnit->updateWires();
+            lastUnit = actUnit;
+            counter++;
+        }
+        if(maxcountPerLayer < counter){
+            maxcountPerLayer = counter;
         }
         if(lastUnit!=NULL){
             offset = lastUnit->x()+200;
@@ -388,6 +394,7 @@ int Container::createNodesFromOdin(){
     QHash<QString, nnode_t *>::const_iterator blockIterator = odinTable.constBegin();
     int items = 0;
     int odinNodeCount = odinTable.count();
+    int lastProgress = -1;
      while(blockIterator != odinTable.constEnd()){
          QString actName = blockIterator.key();
          nnode_t* actOdinNode = blockIterator.value();
@@ -460,9 +467,11 @@ int Container::createNodesFromOdin(){
              unithashtable[actName]->setVisible(false);
          }
          items++;
-         if((100*items/odinNodeCount)%5==0)
+         int progress = 100*(long long)items/odinNodeCount;
+         if(progress%5==0 && progress != lastProgress)
          {
-             fprintf(stdout, "VISUALIZATION: Node progress: %d\n", 100*items/odinNodeCount);
+             fprintf(stdout, "VISUALIZATION: Node progress: %d\n", progress);
+             lastProgress = progress;
          }
          ++blockIterator;
      }
@@ -785,12 +794,15 @@ int Container::readInFileOdinOnly(){
     start = clock();
     //let odin ii parse in the file and return a hashtable of all nodes in the netlist
     startOdin();
+    //the scene index is built once all the items are created, rather than updated for each one
+    myScene->setItemIndexMethod(QGraphicsScene::NoIndex);
     fprintf(stdout, "VISUALIZATION: Creating nodes...\n");
     //iterate through the hashtable and create all nodes based on the type
     myItemcount = createNodesFromOdin();
     fprintf(stdout, "VISUALIZATION: Creating Node connections...\n");
      //create connections
     cons = createConnectionsFromOdinIterate();
+    myScene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
      if(myItemcount <= 0)
          return -1;
 
@@ -977,23 +989,21 @@ void Container::showSimulationStep(int cycle)
 Wire *Container::getConnectionBetween(QString nodeName, QString kidName)
 {
     Wire* result = NULL;
-    QHash<QString, Wire *> wires;
-    QHash<QString, LogicUnit *> hash =unithashtable;
-    QHash<QString, LogicUnit *>::const_iterator blockIterator = hash.constBegin();
-
-     while(blockIterator != unithashtable.constEnd()){
-         QString actName = blockIterator.key();
-         if(actName.compare(nodeName)==0){
-             LogicUnit* actUnit = blockIterator.value();
-             wires = actUnit->getOutConsHash();
-         }
-         ++blockIterator;
-     }
-
-     if(wires.contains(kidName)){
-        result = wires.value(kidName);
-     }
-     return result;
+    if(!unithashtable.contains(nodeName))
+        return result;
+
+    //the latest connection to the kid, which is usually the one which was just created:
+    //search from the end, so nodes with a large fanout do not make this quadratic
+    LogicUnit* actUnit = unithashtable.value(nodeName);
+    QList<Wire *> wires = actUnit->getAllCons();
+    for(int i = wires.count()-1; i >= 0; i--){
+        Wire* wire = wires.at(i);
+        if(wire->startUnit() == actUnit && wire->endUnit()->getName().compare(kidName)==0){
+            result = wire;
+            break;
+        }
+    }
+    return result;
 }
 
 QList<LogicUnit *> Container::getClocks()
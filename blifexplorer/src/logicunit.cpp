@@ -153,7 +153,13 @@ void LogicUnit::addConnection(Wire *wire)
             wire->setMaxNumber(myIncount);
         }
         wires.append(wire);
-        itemChange(QGraphicsPolygonItem::ItemPositionChange,QVariant(0));
+        if(wire->endUnit() == this){
+            //the numbers of the inputs changed: move all the wires to their new input
+            itemChange(QGraphicsPolygonItem::ItemPositionChange,QVariant(0));
+        }else{
+            //a new output does not move the other wires, which matters for nodes with a large fanout
+            wire->updatePosition();
+        }
     }else{//I am a Module
         if(wire->startUnit()->hasModule){
             //I am the start module
@@ -287,84 +293,91 @@ QVariant LogicUnit::itemChange(GraphicsItemChange change,
 }
 
 /*---------------------------------------------------------------------------------------------
- * (function: paint)
+ * (function: typeImage)
  *-------------------------------------------------------------------------------------------*/
-void LogicUnit::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget){
-     QGraphicsPolygonItem::paint(painter,option,widget);
-QImage image;
-
-//If a picture defines the shape, use the fullrect and draw invisible borders
-
-    switch (myUnitType) {
-    case And:
-        image.load(":/images/nodeTypes/AND.png");
-        painter->drawImage(boundingRect(),image);
+//The picture of a unit type, loaded once for all the units
+const QImage& LogicUnit::typeImage(UnitType type)
+{
+    static QHash<int, QImage> images;
+    QHash<int, QImage>::iterator it = images.find(type);
+    if(it == images.end()){
+        QString path;
+        switch (type) {
+        case And:
+            path = ":/images/nodeTypes/AND.png";
             break;
-    case Nand:
-        image.load(":/images/nodeTypes/NAND.png");
-        painter->drawImage(boundingRect(),image);
+        case Nand:
+            path = ":/images/nodeTypes/NAND.png";
             break;
-    case Or:
-        image.load(":/images/nodeTypes/OR.png");
-        painter->drawImage(boundingRect(),image);
+        case Or:
+            path = ":/images/nodeTypes/OR.png";
             break;
-    case Nor:
-        image.load(":/images/nodeTypes/NOR.png");
-        painter->drawImage(boundingRect(),image);
+        case Nor:
+            path = ":/images/nodeTypes/NOR.png";
             break;
-    case Xor:
-        image.load(":/images/nodeTypes/XOR.png");
-        painter->drawImage(boundingRect(),image);
+        case Xor:
+            path = ":/images/nodeTypes/XOR.png";
             break;
-    case Xnor:
-        image.load(":/images/nodeTypes/XNOR.png");
-        painter->drawImage(boundingRect(),image);
+        case Xnor:
+            path = ":/images/nodeTypes/XNOR.png";
             break;
-    case Not:
-        image.load(":/images/nodeTypes/NOT.png");
-        painter->drawImage(boundingRect(),image);
+        case Not:
+            path = ":/images/nodeTypes/NOT.png";
             break;
-    case MUX:
-        image.load(":/images/nodeTypes/MUX.png");
-        painter->drawImage(boundingRect(),image);
+        case MUX:
+            path = ":/images/nodeTypes/MUX.png";
             break;
-    case ADDER_FUNC:
-        image.load(":/images/nodeTypes/ADDER_FUNC.png");
-        painter->drawImage(boundingRect(),image);
+        case ADDER_FUNC:
+            path = ":/images/nodeTypes/ADDER_FUNC.png";
             break;
-    case CARRY_FUNC:
-        image.load(":/images/nodeTypes/CARRY_FUNC.png");
-        painter->drawImage(boundingRect(),image);
-        break;
-    case MEMORY:
-        image.load(":/images/nodeTypes/Hmemory.png");
-        painter->drawImage(boundingRect(),image);
-        break;
-    case Module:
-        image.load(":/images/nodeTypes/module.png");
-        painter->drawImage(boundingRect(),image);
-        break;
-    case MINUS:
-        image.load(":/images/nodeTypes/Hminus.png");
-        painter->drawImage(boundingRect(),image);
-        break;
-    case ADD:
-        image.load(":/images/nodeTypes/Hadd.png");
-        painter->drawImage(boundingRect(),image);
-        break;
-    case MULTIPLY:
-        image.load(":/images/nodeTypes/Hmult.png");
+        case CARRY_FUNC:
+            path = ":/images/nodeTypes/CARRY_FUNC.png";
+            break;
+        case MEMORY:
+            path = ":/images/nodeTypes/Hmemory.png";
+            break;
+        case Module:
+            path = ":/images/nodeTypes/module.png";
+            break;
+        case MINUS:
+            path = ":/images/nodeTypes/Hminus.png";
+            break;
+        case ADD:
+            path = ":/images/nodeTypes/Hadd.png";
+            break;
+        case MULTIPLY:
+            path = ":/images/nodeTypes/Hmult.png";
+            break;
+        default:
+            break;
+        }
+        it = images.insert(type, path.isEmpty() ? QImage() : QImage(path));
+    }
+    return it.value();
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: paint)
+ *-------------------------------------------------------------------------------------------*/
+void LogicUnit::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget){
+     QGraphicsPolygonItem::paint(painter,option,widget);
+
+    //Zoomed out on a large netlist, the pictures and names are too small to be seen:
+    //only the outlines are drawn, which keeps the rendering fast
+    qreal levelOfDetail = option->levelOfDetailFromTransform(painter->worldTransform());
+    if(levelOfDetail < 0.1){
+        return;
+    }
+
+//If a picture defines the shape, use the fullrect and draw invisible borders
+    const QImage& image = typeImage(myUnitType);
+    if(!image.isNull()){
         painter->drawImage(boundingRect(),image);
-        break;
-    case LogicGate:
-    case Input:
-    case Output:
-    case Latch:
-    case Clock:
-    default:
-        break;
     }
 
+    if(levelOfDetail < 0.4){
+        return;
+    }
 
     painter->setFont(QFont("Times", 9));
 
@@ -392,7 +405,7 @@ QList<Wire *> LogicUnit::getOutCons()
     QList<Wire *> outgoing;
     //An outgoing connection has THIS as startUnit
    foreach (Wire *wire,wires) {
-        if(wire->startUnit()->getName().compare(myName)==0)
+        if(wire->startUnit() == this)
             outgoing.append(wire);
     }
    return outgoing;
@@ -406,7 +419,7 @@ QHash<QString, Wire *> LogicUnit::getOutConsHash()
     QHash <QString, Wire *> outgoing;
     //An outgoing connection has THIS as startUnit
    foreach (Wire *wire,wires) {
-        if(wire->startUnit()->getName().compare(myName)==0)
+        if(wire->startUnit() == this)
             outgoing.insert(wire->endUnit()->getName(), wire);
     }
    return outgoing;
@@ -559,7 +572,7 @@ QList<LogicUnit*> LogicUnit::getParents()
 {
     QList<LogicUnit*> result;
     foreach(Wire* wire, wires){
-        if(wire->endUnit()->getName().compare(myName) == 0){
+        if(wire->endUnit() == this){
             result.append(wire->startUnit());
         }
     }
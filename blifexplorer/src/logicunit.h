@@ -107,6 +107,8 @@ protected:
     QVariant itemChange(GraphicsItemChange change, const QVariant &value);
 
 private:
+    static const QImage& typeImage(UnitType type);
+
     UnitType myUnitType;
     QPolygonF myPolygon;
     QPolygonF fullPolygon;
@@ -96,6 +96,11 @@ class SetupHoldAnalysis : public GraphVisitor {
             return setup_modified || hold_modified;
         }
 
+        void do_compact_tags() override {
+            setup_visitor_.do_compact_tags();
+            hold_visitor_.do_compact_tags();
+        }
+
         TimingTags::tag_range setup_tags(const NodeId node_id) const { return setup_visitor_.setup_tags(node_id); }
         TimingTags::tag_range setup_tags(const NodeId node_id, TagType type) const { return setup_visitor_.setup_tags(node_id, type); }
 #ifdef TATUM_CALCULATE_EDGE_SLACKS
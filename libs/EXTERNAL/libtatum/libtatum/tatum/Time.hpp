@@ -27,6 +27,17 @@
 
 namespace tatum {
 
+/*
+ * A timing value.
+ *
+ * If TIME_VEC_WIDTH > 1 a Time holds one value per timing corner (e.g. slow/fast
+ * process corners), so that all the corners are propagated through the timing
+ * graph in a single traversal, with the arithmetic vectorized across corners.
+ *
+ * Corner 0 is the primary corner: it is the one reported by value() and used by
+ * the comparison operators (and so decides the worst path origin of a tag), while
+ * max()/min() and the arithmetic operators apply to every corner.
+ */
 class Time {
     public:
         typedef float scalar_type;
@@ -37,9 +48,15 @@ class Time {
         explicit Time(const double time) { set_value(time); }
 
     public: //Accessors
-        ///The current time value
+        ///The current time value (of the primary corner)
         scalar_type value() const;
 
+        ///The current time value of the specified corner
+        scalar_type value(size_t corner) const;
+
+        ///The number of timing corners held by a Time
+        static constexpr size_t num_corners() { return TIME_VEC_WIDTH; }
+
         ///Indicates whether the current time value is valid
         bool valid() const;
 
@@ -52,12 +69,16 @@ class Time {
         operator scalar_type() const { return value(); }
 
     public: //Mutators
-        ///Set the current time value to time
+        ///Set the current time value of all corners to time
         void set_value(scalar_type time);
 
+        ///Set the current time value of the specified corner to time
+        void set_value(size_t corner, scalar_type time);
 
         Time& operator+=(const Time& rhs);
         Time& operator-=(const Time& rhs);
+        ///Scales each corner by the matching corner of rhs
+        Time& operator*=(const Time& rhs);
 
         friend bool operator==(const Time lhs, const Time rhs);
         friend bool operator<(const Time lhs, const Time rhs);
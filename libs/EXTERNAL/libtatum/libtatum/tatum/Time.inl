@@ -49,7 +49,17 @@ namespace tatum {
         return *this;
     }
 
+    inline Time& Time::operator*=(const Time& rhs) {
+        for(size_t i = 0; i < time_.size(); i++) {
+            time_[i] *= rhs.time_[i];
+        }
+
+        return *this;
+    }
+
     inline Time::scalar_type Time::value() const { return time_[0]; }
+    inline Time::scalar_type Time::value(size_t corner) const { return time_[corner]; }
+    inline void Time::set_value(size_t corner, scalar_type time) { time_[corner] = time; }
 
     inline bool Time::valid() const {
         //This is a reduction with a function call inside,
@@ -62,13 +72,16 @@ namespace tatum {
     }
 #else //Scalar case (TIME_VEC_WIDTH == 1)
     inline Time::scalar_type Time::value() const { return time_; }
+    inline Time::scalar_type Time::value(size_t /*corner*/) const { return time_; }
     inline void Time::set_value(scalar_type time) { time_ = time; }
+    inline void Time::set_value(size_t /*corner*/, scalar_type time) { time_ = time; }
     inline bool Time::valid() const { return !std::isnan(time_); }
 
     inline void Time::max(const Time& other) { time_ = std::max(time_, other.time_); }
     inline void Time::min(const Time& other) { time_ = std::min(time_, other.time_); }
     inline Time& Time::operator+=(const Time& rhs) { time_ += rhs.time_; return *this; }
     inline Time& Time::operator-=(const Time& rhs) { time_ -= rhs.time_; return *this; }
+    inline Time& Time::operator*=(const Time& rhs) { time_ *= rhs.time_; return *this; }
 
 #endif //TIME_VEC_WIDTH
 
@@ -77,14 +90,27 @@ namespace tatum {
  */
 
 #if TIME_VEC_WIDTH > 1
+inline bool operator==(const Time lhs, const Time rhs) {
+    return lhs.time_ == rhs.time_;
+}
+
+//Ordering is defined by the primary corner
+inline bool operator<(const Time lhs, const Time rhs) {
+    return lhs.time_[0] < rhs.time_[0];
+}
+
+inline bool operator>(const Time lhs, const Time rhs) {
+    return lhs.time_[0] > rhs.time_[0];
+}
+
 inline Time operator-(Time in) {
-    for(size_t i = 0; i < time_.size(); i++) {
+    for(size_t i = 0; i < in.time_.size(); i++) {
         in.time_[i] = -in.time_[i];
     }
     return in;
 }
 inline Time operator+(Time in) {
-    for(size_t i = 0; i < time_.size(); i++) {
+    for(size_t i = 0; i < in.time_.size(); i++) {
         in.time_[i] = +in.time_[i];
     }
     return in;
@@ -120,6 +146,10 @@ inline Time operator-(Time lhs, const Time& rhs) {
     return lhs -= rhs;
 }
 
+inline Time operator*(Time lhs, const Time& rhs) {
+    return lhs *= rhs;
+}
+
 inline std::ostream& operator<<(std::ostream& os, const Time& time) {
     os << time.value();
     return os;
@@ -82,6 +82,9 @@ class TimingReporter {
         void report_unconstrained_hold(std::string filename, const tatum::HoldTimingAnalyzer& hold_analyzer) const;
         void report_unconstrained_hold(std::ostream& os, const tatum::HoldTimingAnalyzer& hold_analyzer) const;
 
+        ///Reports already collected timing paths (e.g. from a TimingPathCache)
+        void report_timing(std::ostream& os, const std::vector<TimingPath>& paths) const;
+
     private:
         struct PathSkew {
             NodeId launch_node;
@@ -96,8 +99,6 @@ class TimingReporter {
         };
 
     private:
-        void report_timing(std::ostream& os, const std::vector<TimingPath>& paths) const;
-
         void report_timing_path(std::ostream& os, const TimingPath& path) const;
 
         void report_unconstrained(std::ostream& os, const NodeType type, const detail::TagRetriever& tag_retriever) const;
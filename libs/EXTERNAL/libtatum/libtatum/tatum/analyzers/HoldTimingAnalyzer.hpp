@@ -15,7 +15,7 @@ namespace tatum {
 class HoldTimingAnalyzer : public virtual TimingAnalyzer {
     public:
         ///Update only the hold timing related arrival/required tags
-        void update_hold_timing() { update_hold_timing_impl(); }
+        void update_hold_timing() { update_hold_timing_impl(); ++num_updates_; }
 
         TimingTags::tag_range hold_tags(NodeId node_id) const { return hold_tags_impl(node_id); }
         TimingTags::tag_range hold_tags(NodeId node_id, TagType type) const { return hold_tags_impl(node_id, type); }
@@ -15,7 +15,7 @@ namespace tatum {
 class SetupTimingAnalyzer : public virtual TimingAnalyzer {
     public:
         ///Update only the setup timing related arrival/required tags
-        void update_setup_timing() { update_setup_timing_impl(); }
+        void update_setup_timing() { update_setup_timing_impl(); ++num_updates_; }
 
         TimingTags::tag_range setup_tags(NodeId node_id) const { return setup_tags_impl(node_id); }
         TimingTags::tag_range setup_tags(NodeId node_id, TagType type) const { return setup_tags_impl(node_id, type); }
@@ -32,7 +32,7 @@ class TimingAnalyzer {
         virtual ~TimingAnalyzer() {}
 
         ///Perform timing analysis to update timing information (i.e. arrival & required times)
-        void update_timing() { update_timing_impl(); }
+        void update_timing() { update_timing_impl(); ++num_updates_; }
 
         ///Invalidates the specified edge in the timing graph (for incremental updates)
         void invalidate_edge(const EdgeId edge) { invalidate_edge_impl(edge); }
@@ -42,6 +42,10 @@ class TimingAnalyzer {
 
         double get_profiling_data(std::string key) const { return get_profiling_data_impl(key); }
 
+        ///Returns the number of timing updates performed so far (which allows
+        ///results derived from the analysis to detect when they are stale)
+        size_t num_updates() const { return num_updates_; }
+
         virtual size_t num_unconstrained_startpoints() const { return num_unconstrained_startpoints_impl(); }
         virtual size_t num_unconstrained_endpoints() const { return num_unconstrained_endpoints_impl(); }
 
@@ -56,6 +60,8 @@ class TimingAnalyzer {
 
         virtual size_t num_unconstrained_startpoints_impl() const = 0;
         virtual size_t num_unconstrained_endpoints_impl() const = 0;
+
+        size_t num_updates_ = 0;
 };
 
 } //namepsace
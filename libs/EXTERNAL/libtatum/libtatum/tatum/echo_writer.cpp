@@ -18,15 +18,15 @@ void write_tags(std::ostream& os, const std::string& type, const TimingTags::tag
 void write_slacks(std::ostream& os, const std::string& type, const TimingTags::tag_range tags, const EdgeId edge);
 void write_slacks(std::ostream& os, const std::string& type, const TimingTags::tag_range tags, const NodeId edge);
 
-void write_echo(std::string filename, const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, const std::shared_ptr<const TimingAnalyzer> analyzer) {
+void write_echo(std::string filename, const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, const std::shared_ptr<const TimingAnalyzer> analyzer, bool anonymize_clocks) {
     std::ofstream os(filename);
 
-    write_echo(os, tg, tc, dc, analyzer);
+    write_echo(os, tg, tc, dc, analyzer, anonymize_clocks);
 }
 
-void write_echo(std::ostream& os, const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, const std::shared_ptr<const TimingAnalyzer> analyzer) {
+void write_echo(std::ostream& os, const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, const std::shared_ptr<const TimingAnalyzer> analyzer, bool anonymize_clocks) {
     write_timing_graph(os, tg);
-    write_timing_constraints(os, tc);
+    write_timing_constraints(os, tc, anonymize_clocks);
     write_delay_model(os, tg, dc);
     write_analysis_result(os, tg, analyzer);
 }
@@ -101,11 +101,12 @@ void write_timing_graph(std::ostream& os, const TimingGraph& tg) {
     os << "\n";
 }
 
-void write_timing_constraints(std::ostream& os, const TimingConstraints& tc) {
+void write_timing_constraints(std::ostream& os, const TimingConstraints& tc, bool anonymize_clocks) {
     os << "timing_constraints:\n";    
 
     for(auto domain_id : tc.clock_domains()) {
-        os << " type: CLOCK domain: " << size_t(domain_id) << " name: \"" << tc.clock_domain_name(domain_id) << "\"\n";
+        std::string name = anonymize_clocks ? "clk" + std::to_string(size_t(domain_id)) : tc.clock_domain_name(domain_id);
+        os << " type: CLOCK domain: " << size_t(domain_id) << " name: \"" << name << "\"\n";
     }
 
     for(auto domain_id : tc.clock_domains()) {
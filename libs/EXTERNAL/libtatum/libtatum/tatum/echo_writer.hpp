@@ -10,11 +10,12 @@
 namespace tatum {
 
 void write_timing_graph(std::ostream& os, const TimingGraph& tg);
-void write_timing_constraints(std::ostream& os, const TimingConstraints& tc);
+//With anonymize_clocks the clock domains are named by number (clk0, clk1...) instead of by their netlist names
+void write_timing_constraints(std::ostream& os, const TimingConstraints& tc, bool anonymize_clocks=false);
 void write_analysis_result(std::ostream& os, const TimingGraph& tg, const std::shared_ptr<const TimingAnalyzer> analyzer);
 void write_delay_model(std::ostream& os, const TimingGraph& tg, const DelayCalculator& dc);
 
-void write_echo(std::string filename, const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, const std::shared_ptr<const TimingAnalyzer> analyzer);
-void write_echo(std::ostream& os, const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, const std::shared_ptr<const TimingAnalyzer> analyzer);
+void write_echo(std::string filename, const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, const std::shared_ptr<const TimingAnalyzer> analyzer, bool anonymize_clocks=false);
+void write_echo(std::ostream& os, const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, const std::shared_ptr<const TimingAnalyzer> analyzer, bool anonymize_clocks=false);
 
 }
@@ -18,12 +18,12 @@ namespace tatum { namespace detail {
 class CommonAnalysisOps {
     public:
         CommonAnalysisOps(size_t num_nodes, size_t num_edges) 
-            : node_tags_(num_nodes)
+            : node_tags_(num_nodes, TimingTags(0))
 #ifdef TATUM_CALCULATE_EDGE_SLACKS
-            , edge_slacks_(num_edges)
+            , edge_slacks_(num_edges, TimingTags(0))
 #else
 #endif
-            , node_slacks_(num_nodes) {
+            , node_slacks_(num_nodes, TimingTags(0)) {
             static_cast<void>(num_edges); //Avoid unused param warning
         }
 
@@ -88,6 +88,65 @@ class CommonAnalysisOps {
             return Time(std::numeric_limits<float>::infinity());
         }
 
+        //Moves all the tags into a single contiguous arena, sized to the number of tags
+        //found by the previous traversals (the tags start out empty and grow on the
+        //heap during the first one). This avoids keeping a separate heap allocation per
+        //node, which fragments memory when there are many clock domains. Nothing is done
+        //unless some tags outgrew their arena slice since the last compaction.
+        void compact_tags() {
+            if (!needs_compaction(node_tags_) && !needs_compaction(node_slacks_)
+#ifdef TATUM_CALCULATE_EDGE_SLACKS
+                && !needs_compaction(edge_slacks_)
+#endif
+            ) {
+                return;
+            }
+
+            size_t num_tags = count_tags(node_tags_) + count_tags(node_slacks_);
+#ifdef TATUM_CALCULATE_EDGE_SLACKS
+            num_tags += count_tags(edge_slacks_);
+#endif
+
+            std::unique_ptr<TimingTag[]> new_tag_arena(new TimingTag[num_tags]);
+            TimingTag* next_tags = new_tag_arena.get();
+            next_tags = relocate_tags(node_tags_, next_tags);
+            next_tags = relocate_tags(node_slacks_, next_tags);
+#ifdef TATUM_CALCULATE_EDGE_SLACKS
+            next_tags = relocate_tags(edge_slacks_, next_tags);
+#endif
+            TATUM_ASSERT(next_tags == new_tag_arena.get() + num_tags);
+
+            //Safe to release the previous arena now that nothing refers to it
+            tag_arena_ = std::move(new_tag_arena);
+        }
+
+    private:
+        template<class Id>
+        static bool needs_compaction(const tatum::util::linear_map<Id,TimingTags>& tags_map) {
+            for (const TimingTags& tags : tags_map) {
+                if (tags.is_heap_allocated()) return true;
+            }
+            return false;
+        }
+
+        template<class Id>
+        static size_t count_tags(const tatum::util::linear_map<Id,TimingTags>& tags_map) {
+            size_t num_tags = 0;
+            for (const TimingTags& tags : tags_map) {
+                num_tags += tags.size();
+            }
+            return num_tags;
+        }
+
+        template<class Id>
+        static TimingTag* relocate_tags(tatum::util::linear_map<Id,TimingTags>& tags_map, TimingTag* storage) {
+            for (TimingTags& tags : tags_map) {
+                tags.relocate(storage);
+                storage += tags.size();
+            }
+            return storage;
+        }
+
 
     protected:
         tatum::util::linear_map<NodeId,TimingTags> node_tags_;
@@ -97,6 +156,10 @@ class CommonAnalysisOps {
 #endif
 
         tatum::util::linear_map<NodeId,TimingTags> node_slacks_;
+
+    private:
+        //Contiguous storage of (most of) the tags above, see compact_tags()
+        std::unique_ptr<TimingTag[]> tag_arena_;
 };
 
 }} //namespace
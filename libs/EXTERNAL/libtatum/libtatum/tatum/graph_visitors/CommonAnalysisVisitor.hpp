@@ -53,6 +53,8 @@ class CommonAnalysisVisitor : public GraphVisitor {
 
         bool do_slack_traverse_node(const TimingGraph& tg, const DelayCalculator& dc, const NodeId node) override;
 
+        void do_compact_tags() override { ops_.compact_tags(); }
+
     protected:
         AnalysisOps ops_;
 
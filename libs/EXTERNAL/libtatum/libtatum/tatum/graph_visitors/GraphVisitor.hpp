@@ -30,6 +30,9 @@ class GraphVisitor {
         virtual bool do_required_traverse_node(const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, const NodeId node_id) = 0;
 
         virtual bool do_slack_traverse_node(const TimingGraph& tg, const DelayCalculator& dc, const NodeId node) = 0;
+
+        //Compacts the storage of the timing tags (called once a traversal is complete)
+        virtual void do_compact_tags() = 0;
 };
 
 }
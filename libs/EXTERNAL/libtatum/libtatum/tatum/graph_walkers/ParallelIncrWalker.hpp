@@ -0,0 +1,159 @@
+#pragma once
+#include <vector>
+
+#ifdef TATUM_USE_TBB
+# include <tbb/blocked_range.h>
+# include <tbb/parallel_for.h>
+#endif
+
+#include "tatum/graph_walkers/SerialIncrWalker.hpp"
+
+namespace tatum {
+
+/**
+ * A parallel incremental graph walker. Like SerialIncrWalker it only
+ * re-evaluates the nodes affected by the invalidated edges, level by level,
+ * but the invalidated nodes of each level are processed in parallel using
+ * Thread Building Blocks (TBB). If TBB is not available it operates serially
+ * and is equivalent to the SerialIncrWalker.
+ *
+ * Each level is processed in three steps:
+ *  1) The invalidated tags of the level's nodes are reset (serially, since
+ *     this may enqueue further nodes for the required traversal),
+ *  2) The level's nodes are re-evaluated in parallel (as in
+ *     ParallelLevelizedWalker, nodes of the same level do not depend on each
+ *     other),
+ *  3) The dependencies of the modified nodes are enqueued (serially).
+ *
+ * Since enqueued nodes are sorted before they are processed, the results are
+ * identical to those of the SerialIncrWalker.
+ */
+class ParallelIncrWalker : public SerialIncrWalker {
+    protected:
+        void do_arrival_traversal_impl(const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, GraphVisitor& visitor) override {
+            prepare_incr_update(tg);
+
+            for(int level_idx = incr_arr_update_.min_level; level_idx <= incr_arr_update_.max_level; ++level_idx) {
+                auto& level_nodes = incr_arr_update_.nodes_to_process[level_idx];
+
+                //Sorting the level nodes tends to help memory locality, since the
+                //timing graph is laid out in traversal order
+                sort(level_nodes);
+
+                for (NodeId node : level_nodes) {
+                    invalidate_node_for_arrival_traversal(node, tg, visitor);
+                }
+
+                traverse_level_nodes(level_nodes, [&](NodeId node) {
+                    return visitor.do_arrival_traverse_node(tg, tc, dc, node);
+                });
+
+                for (size_t inode = 0; inode < level_nodes.size(); ++inode) {
+                    if (!node_updated_[inode]) continue;
+
+                    NodeId node = level_nodes[inode];
+
+                    //Record that this node was updated, for later efficient slack update
+                    enqueue_modified_node(node);
+
+                    //Queue this node's downstream dependencies for updating
+                    for (EdgeId edge : tg.node_out_edges(node)) {
+                        NodeId snk_node = tg.edge_sink_node(edge);
+                        enqueue_arr_node(tg, snk_node, edge);
+                    }
+                }
+            }
+        }
+
+        void do_required_traversal_impl(const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, GraphVisitor& visitor) override {
+            for(int level_idx = incr_req_update_.max_level; level_idx >= incr_req_update_.min_level; --level_idx) {
+                auto& level_nodes = incr_req_update_.nodes_to_process[level_idx];
+
+                //Sorting the level nodes tends to help memory locality, since the
+                //timing graph is laid out in traversal order
+                sort(level_nodes);
+
+                for (NodeId node : level_nodes) {
+                    invalidate_node_for_required_traversal(node, tg, visitor);
+                }
+
+                traverse_level_nodes(level_nodes, [&](NodeId node) {
+                    return visitor.do_required_traverse_node(tg, tc, dc, node);
+                });
+
+                for (size_t inode = 0; inode < level_nodes.size(); ++inode) {
+                    if (!node_updated_[inode]) continue;
+
+                    NodeId node = level_nodes[inode];
+
+                    //Record that this node was updated, for later efficient slack update
+                    enqueue_modified_node(node);
+
+                    //Queue this node's upstream dependencies for updating
+                    for (EdgeId edge : tg.node_in_edges(node)) {
+                        NodeId src_node = tg.edge_src_node(edge);
+
+                        enqueue_req_node(tg, src_node, edge);
+                    }
+                }
+            }
+        }
+
+        void do_update_slack_impl(const TimingGraph& tg, const DelayCalculator& dc, GraphVisitor& visitor) override {
+            sort(nodes_modified_);
+
+            auto update_node_slack = [&](NodeId node) {
+#ifdef TATUM_CALCULATE_EDGE_SLACKS
+                for (EdgeId edge : tg.node_in_edges(node)) {
+                    visitor.do_reset_edge(edge);
+                }
+#endif
+                visitor.do_reset_node_slack_tags(node);
+
+                visitor.do_slack_traverse_node(tg, dc, node);
+            };
+
+#if defined(TATUM_USE_TBB)
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, nodes_modified_.size(), MIN_NODES_PER_TASK),
+                              [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t inode = range.begin(); inode != range.end(); ++inode) {
+                    update_node_slack(nodes_modified_[inode]);
+                }
+            });
+#else //Serial
+            for(NodeId node : nodes_modified_) {
+                update_node_slack(node);
+            }
+#endif
+        }
+
+    private:
+        ///Re-evaluates the given nodes of a level, recording in node_updated_ which were modified
+        template<class TraverseNode>
+        void traverse_level_nodes(const std::vector<NodeId>& level_nodes, const TraverseNode& traverse_node) {
+            node_updated_.assign(level_nodes.size(), false);
+#if defined(TATUM_USE_TBB)
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, level_nodes.size(), MIN_NODES_PER_TASK),
+                              [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t inode = range.begin(); inode != range.end(); ++inode) {
+                    node_updated_[inode] = traverse_node(level_nodes[inode]);
+                }
+            });
+#else //Serial
+            for (size_t inode = 0; inode < level_nodes.size(); ++inode) {
+                node_updated_[inode] = traverse_node(level_nodes[inode]);
+            }
+#endif
+        }
+
+        ///Minimum number of nodes processed by a parallel task (incremental
+        ///updates often only touch a handful of nodes per level, which are
+        ///not worth distributing)
+        static constexpr size_t MIN_NODES_PER_TASK = 32;
+
+        ///Whether each node of the level being traversed was modified. Not a
+        ///std::vector<bool>, whose elements can not be written concurrently.
+        std::vector<char> node_updated_;
+};
+
+} //namepsace
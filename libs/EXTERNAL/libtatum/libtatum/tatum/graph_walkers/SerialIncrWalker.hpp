@@ -7,6 +7,7 @@
 
 #include "tatum/graph_walkers/TimingGraphWalker.hpp"
 #include "tatum/TimingGraph.hpp"
+#include "tatum/Time.hpp"
 #include "tatum/delay_calc/DelayCalculator.hpp"
 #include "tatum/graph_visitors/GraphVisitor.hpp"
 
@@ -32,6 +33,12 @@ namespace tatum {
  */
 //#define TATUM_INCR_BLOCK_INVALIDATION
 
+#if TIME_VEC_WIDTH > 1 && !defined(TATUM_INCR_BLOCK_INVALIDATION)
+//Tag origins only track the primary timing corner, so edge invalidation could
+//miss tags whose other corners are dominated by an invalidated edge
+# define TATUM_INCR_BLOCK_INVALIDATION
+#endif
+
 /**
  * A serial graph walker which traverses the timing graph in a levelized
  * manner. Unlike SerialWalker it attempts to incrementally (rather than
@@ -198,7 +205,8 @@ class SerialIncrWalker : public TimingGraphWalker {
 
         size_t num_unconstrained_startpoints_impl() const override { return num_unconstrained_startpoints_; }
         size_t num_unconstrained_endpoints_impl() const override { return num_unconstrained_endpoints_; }
-    private:
+    protected:
+        //The incremental traversal bookkeeping is shared with ParallelIncrWalker
 
         bool is_invalidated(EdgeId edge) const {
             if (edge_invalidated_.size() > size_t(edge)) {
@@ -292,10 +300,12 @@ class SerialIncrWalker : public TimingGraphWalker {
             //Invalidates the entire node (all the nodes arrival tags)
             //As a result, when processed the node will be re-computed from scratch
             visitor.do_reset_node_arrival_tags(node);
-#else
-            //Edge invalidation
+#endif
             for (EdgeId edge : tg.node_in_edges(node)) {
                 if (not_invalidated(edge)) continue;
+#ifndef TATUM_INCR_BLOCK_INVALIDATION
+                //Edge invalidation
+                //
                 //Data arrival tags track their associated origin node (i.e. dominant
                 //edge which determines the tag value). Rather than invalidate all
                 //tags to ensure the correctly updated tag when the node is re-traversed,
@@ -307,6 +317,7 @@ class SerialIncrWalker : public TimingGraphWalker {
                 //is 'unchanged', which helps keep the number of updated nodes small.
                 NodeId src_node = tg.edge_src_node(edge);
                 visitor.do_reset_node_arrival_tags_from_origin(node, /*origin=*/src_node);
+#endif
 
                 //At SOURCE/SINK nodes clock launch/capture tags are converted into
                 //data arrival/required tags, so we also need to carefully reset those
@@ -340,7 +351,6 @@ class SerialIncrWalker : public TimingGraphWalker {
                     visitor.do_reset_node_arrival_tags(node);
                 }
             }
-#endif
         }
 
         void invalidate_node_for_required_traversal(const NodeId node, const TimingGraph& tg, GraphVisitor& visitor) {
@@ -103,6 +103,9 @@ class TimingGraphWalker {
 
             do_update_slack_impl(tg, dc, visitor);
 
+            //The slack update completes the traversals, so the number of tags is now known
+            visitor.do_compact_tags();
+
             profiling_data_["update_slack_sec"] = std::chrono::duration_cast<dsec>(Clock::now() - start_time).count();
         }
 
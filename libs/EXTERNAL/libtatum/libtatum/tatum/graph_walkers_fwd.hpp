@@ -6,6 +6,10 @@ class SerialWalker;
 
 class ParallelLevelizedWalker;
 
+class SerialIncrWalker;
+
+class ParallelIncrWalker;
+
 ///The default parallel graph walker
 using ParallelWalker = ParallelLevelizedWalker;
 
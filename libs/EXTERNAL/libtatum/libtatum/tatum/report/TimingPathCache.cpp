@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <tuple>
+
+#include "tatum/TimingGraph.hpp"
+#include "tatum/report/TimingPathCache.hpp"
+#include "tatum/report/timing_path_tracing.hpp"
+#include "tatum/util/tatum_assert.hpp"
+
+namespace tatum {
+
+namespace detail {
+
+WorstTimingPathEnumerator::WorstTimingPathEnumerator(const TimingGraph& timing_graph, const TagRetriever& tag_retriever) {
+    //Add the slacks of all sinks
+    for(NodeId node : timing_graph.logical_outputs()) {
+        for(TimingTag tag : tag_retriever.slacks(node)) {
+            endpoint_heap_.emplace_back(tag, node);
+        }
+    }
+
+    std::make_heap(endpoint_heap_.begin(), endpoint_heap_.end(), worse_slack_last);
+}
+
+TimingPath WorstTimingPathEnumerator::next(const TimingGraph& timing_graph, const TagRetriever& tag_retriever) {
+    TATUM_ASSERT(!done());
+
+    std::pop_heap(endpoint_heap_.begin(), endpoint_heap_.end(), worse_slack_last);
+    TagNode tag_node = endpoint_heap_.back();
+    endpoint_heap_.pop_back();
+
+    return detail::trace_path(timing_graph, tag_retriever,
+                              tag_node.tag.launch_clock_domain(), tag_node.tag.capture_clock_domain(),
+                              tag_node.node);
+}
+
+bool WorstTimingPathEnumerator::worse_slack_last(const TagNode& lhs, const TagNode& rhs) {
+    //std::*_heap() keep the largest element on top, so order by descending slack
+    if(lhs.tag.time() > rhs.tag.time()) return true;
+    if(lhs.tag.time() < rhs.tag.time()) return false;
+
+    //Break ties deterministically
+    return std::make_tuple(lhs.node, lhs.tag.launch_clock_domain(), lhs.tag.capture_clock_domain())
+           > std::make_tuple(rhs.node, rhs.tag.launch_clock_domain(), rhs.tag.capture_clock_domain());
+}
+
+} //namespace detail
+
+TimingPathCache::TimingPathCache(const TimingGraph& timing_graph)
+    : timing_graph_(timing_graph) {}
+
+std::vector<TimingPath> TimingPathCache::worst_setup_timing_paths(const SetupTimingAnalyzer& setup_analyzer, size_t npaths) {
+    detail::SetupTagRetriever tag_retriever(setup_analyzer);
+    return worst_timing_paths(setup_paths_, setup_analyzer, tag_retriever, npaths);
+}
+
+std::vector<TimingPath> TimingPathCache::worst_hold_timing_paths(const HoldTimingAnalyzer& hold_analyzer, size_t npaths) {
+    detail::HoldTagRetriever tag_retriever(hold_analyzer);
+    return worst_timing_paths(hold_paths_, hold_analyzer, tag_retriever, npaths);
+}
+
+void TimingPathCache::clear() {
+    setup_paths_ = CachedPaths();
+    hold_paths_ = CachedPaths();
+}
+
+std::vector<TimingPath> TimingPathCache::query_setup_timing_paths(const SetupTimingAnalyzer& setup_analyzer, const TimingPathFilter& filter, size_t npaths) {
+    detail::SetupTagRetriever tag_retriever(setup_analyzer);
+    return query_timing_paths(setup_paths_, setup_analyzer, tag_retriever, filter, npaths);
+}
+
+std::vector<TimingPath> TimingPathCache::query_hold_timing_paths(const HoldTimingAnalyzer& hold_analyzer, const TimingPathFilter& filter, size_t npaths) {
+    detail::HoldTagRetriever tag_retriever(hold_analyzer);
+    return query_timing_paths(hold_paths_, hold_analyzer, tag_retriever, filter, npaths);
+}
+
+void TimingPathCache::validate(CachedPaths& cache,
+                               const TimingAnalyzer& analyzer,
+                               const detail::TagRetriever& tag_retriever) {
+    if(cache.analyzer != &analyzer || cache.num_updates != analyzer.num_updates()) {
+        //Cached paths are stale (or missing), restart the enumeration
+        cache = CachedPaths();
+        cache.analyzer = &analyzer;
+        cache.num_updates = analyzer.num_updates();
+        cache.enumerator = detail::WorstTimingPathEnumerator(timing_graph_, tag_retriever);
+    }
+}
+
+std::vector<TimingPath> TimingPathCache::worst_timing_paths(CachedPaths& cache,
+                                                            const TimingAnalyzer& analyzer,
+                                                            const detail::TagRetriever& tag_retriever,
+                                                            size_t npaths) {
+    validate(cache, analyzer, tag_retriever);
+
+    //Extend the cached paths as needed
+    while(cache.paths.size() < npaths && !cache.enumerator.done()) {
+        cache.paths.push_back(cache.enumerator.next(timing_graph_, tag_retriever));
+    }
+
+    size_t num_paths = std::min(npaths, cache.paths.size());
+    return std::vector<TimingPath>(cache.paths.begin(), cache.paths.begin() + num_paths);
+}
+
+std::vector<TimingPath> TimingPathCache::query_timing_paths(CachedPaths& cache,
+                                                            const TimingAnalyzer& analyzer,
+                                                            const detail::TagRetriever& tag_retriever,
+                                                            const TimingPathFilter& filter,
+                                                            size_t npaths) {
+    validate(cache, analyzer, tag_retriever);
+    if(!cache.is_indexed) {
+        build_index(cache, tag_retriever);
+    }
+
+    //The candidate end-points, in ascending slack order
+    const std::vector<size_t>* domain_pair_endpoints = nullptr;
+    if(filter.launch_domain && filter.capture_domain) {
+        auto iter = cache.domain_pair_endpoints.find({filter.launch_domain, filter.capture_domain});
+        if(iter == cache.domain_pair_endpoints.end()) {
+            return {};
+        }
+        domain_pair_endpoints = &iter->second;
+    }
+    size_t num_candidates = domain_pair_endpoints ? domain_pair_endpoints->size() : cache.endpoints.size();
+    auto candidate = [&](size_t icandidate) {
+        return domain_pair_endpoints ? (*domain_pair_endpoints)[icandidate] : icandidate;
+    };
+
+    //Skip the end-points below the slack range
+    size_t first_candidate = 0;
+    size_t last_candidate = num_candidates;
+    while(first_candidate < last_candidate) {
+        size_t mid = first_candidate + (last_candidate - first_candidate) / 2;
+        if(cache.endpoints[candidate(mid)].slack < filter.min_slack) {
+            first_candidate = mid + 1;
+        } else {
+            last_candidate = mid;
+        }
+    }
+
+    std::vector<TimingPath> paths;
+    for(size_t icandidate = first_candidate; icandidate < num_candidates && paths.size() < npaths; ++icandidate) {
+        size_t iendpoint = candidate(icandidate);
+        const IndexedEndpoint& endpoint = cache.endpoints[iendpoint];
+        if(filter.max_slack < endpoint.slack) {
+            break;
+        }
+
+        if(filter.launch_domain && filter.launch_domain != endpoint.launch_domain) continue;
+        if(filter.capture_domain && filter.capture_domain != endpoint.capture_domain) continue;
+        if(filter.endpoint && !filter.endpoint(endpoint.node)) continue;
+
+        //The start-point is only known once the path is traced
+        const TimingPath& path = endpoint_path(cache, tag_retriever, iendpoint);
+        if(filter.startpoint && !filter.startpoint(path.path_info().startpoint())) continue;
+
+        paths.push_back(path);
+    }
+
+    return paths;
+}
+
+void TimingPathCache::build_index(CachedPaths& cache, const detail::TagRetriever& tag_retriever) {
+    for(NodeId node : timing_graph_.logical_outputs()) {
+        for(TimingTag tag : tag_retriever.slacks(node)) {
+            cache.endpoints.push_back({tag.time(), node, tag.launch_clock_domain(), tag.capture_clock_domain()});
+        }
+    }
+
+    //Same order as detail::WorstTimingPathEnumerator
+    std::sort(cache.endpoints.begin(), cache.endpoints.end(),
+              [](const IndexedEndpoint& lhs, const IndexedEndpoint& rhs) {
+                  if(lhs.slack < rhs.slack) return true;
+                  if(rhs.slack < lhs.slack) return false;
+                  return std::make_tuple(lhs.node, lhs.launch_domain, lhs.capture_domain)
+                         < std::make_tuple(rhs.node, rhs.launch_domain, rhs.capture_domain);
+              });
+
+    for(size_t iendpoint = 0; iendpoint < cache.endpoints.size(); ++iendpoint) {
+        const IndexedEndpoint& endpoint = cache.endpoints[iendpoint];
+        cache.domain_pair_endpoints[{endpoint.launch_domain, endpoint.capture_domain}].push_back(iendpoint);
+    }
+
+    cache.is_indexed = true;
+}
+
+const TimingPath& TimingPathCache::endpoint_path(CachedPaths& cache, const detail::TagRetriever& tag_retriever, size_t iendpoint) {
+    //The enumerated paths are those of the first end-points
+    if(iendpoint < cache.paths.size()) {
+        return cache.paths[iendpoint];
+    }
+
+    auto iter = cache.endpoint_paths.find(iendpoint);
+    if(iter == cache.endpoint_paths.end()) {
+        const IndexedEndpoint& endpoint = cache.endpoints[iendpoint];
+        TimingPath path = detail::trace_path(timing_graph_, tag_retriever,
+                                             endpoint.launch_domain, endpoint.capture_domain,
+                                             endpoint.node);
+        iter = cache.endpoint_paths.emplace(iendpoint, std::move(path)).first;
+    }
+    return iter->second;
+}
+
+} //namespace
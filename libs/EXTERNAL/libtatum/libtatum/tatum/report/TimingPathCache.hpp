@@ -0,0 +1,163 @@
+#ifndef TATUM_TIMING_PATH_CACHE_HPP
+#define TATUM_TIMING_PATH_CACHE_HPP
+#include <vector>
+#include <functional>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include "tatum/TimingGraphFwd.hpp"
+#include "tatum/timing_analyzers_fwd.hpp"
+#include "tatum/tags/TimingTag.hpp"
+#include "tatum/report/TimingPath.hpp"
+#include "tatum/report/TimingReportTagRetriever.hpp"
+
+namespace tatum {
+
+namespace detail {
+
+/**
+ * Enumerates the worst timing paths (one per timing end-point and clock domain pair)
+ * in ascending slack order.
+ *
+ * The end-point slacks are heapified up-front (linear in the number of end-points),
+ * and each path is only selected and traced when requested, so collecting the k worst
+ * paths costs O(E + k log E) rather than sorting all E end-points.
+ */
+class WorstTimingPathEnumerator {
+    public:
+        WorstTimingPathEnumerator() = default;
+        WorstTimingPathEnumerator(const TimingGraph& timing_graph, const TagRetriever& tag_retriever);
+
+        ///\returns True if there are no more paths to enumerate
+        bool done() const { return endpoint_heap_.empty(); }
+
+        ///\returns The next worst path
+        TimingPath next(const TimingGraph& timing_graph, const TagRetriever& tag_retriever);
+
+    private:
+        struct TagNode {
+            TagNode(TimingTag t, NodeId n) noexcept
+                : tag(t), node(n) {}
+
+            TimingTag tag;
+            NodeId node;
+        };
+
+        //Heap order which puts the worst slack (ties broken by node) on top
+        static bool worse_slack_last(const TagNode& lhs, const TagNode& rhs);
+
+        std::vector<TagNode> endpoint_heap_;
+};
+
+} //namespace detail
+
+/**
+ * Selects the timing paths returned by TimingPathCache::query_setup_timing_paths()
+ * and TimingPathCache::query_hold_timing_paths().
+ */
+struct TimingPathFilter {
+    ///Launch clock domain of the paths (any domain if invalid)
+    DomainId launch_domain = DomainId::INVALID();
+
+    ///Capture clock domain of the paths (any domain if invalid)
+    DomainId capture_domain = DomainId::INVALID();
+
+    ///Slack range of the paths (inclusive)
+    Time min_slack = Time(-std::numeric_limits<Time::scalar_type>::infinity());
+    Time max_slack = Time(std::numeric_limits<Time::scalar_type>::infinity());
+
+    ///Accepts the path start-points (all of them if empty)
+    std::function<bool(NodeId)> startpoint;
+
+    ///Accepts the path end-points (all of them if empty)
+    std::function<bool(NodeId)> endpoint;
+};
+
+/**
+ * Caches the worst timing paths of timing analyzers, so that they can be queried
+ * repeatedly (e.g. interactively, for growing numbers of paths) without re-collecting
+ * and re-tracing them.
+ *
+ * Paths are enumerated lazily (see detail::WorstTimingPathEnumerator): a request only
+ * traces the paths beyond those already cached. The cached paths are dropped whenever
+ * the analyzer has performed a new timing update since they were collected.
+ *
+ * Filtered queries (see TimingPathFilter) go through an index of the end-point slacks,
+ * built by the first filtered query after each timing update: the end-point slacks sorted
+ * in the enumeration order, overall and per clock domain pair. A query then only visits
+ * the end-points within its slack range (and clock domain pair), and traces the paths of
+ * those accepted by its end-point filter. Traced paths are kept for the next queries.
+ */
+class TimingPathCache {
+    public:
+        TimingPathCache(const TimingGraph& timing_graph);
+
+        ///\returns The npaths worst setup timing paths (or fewer, if there are fewer end-points)
+        std::vector<TimingPath> worst_setup_timing_paths(const SetupTimingAnalyzer& setup_analyzer, size_t npaths);
+
+        ///\returns The npaths worst hold timing paths (or fewer, if there are fewer end-points)
+        std::vector<TimingPath> worst_hold_timing_paths(const HoldTimingAnalyzer& hold_analyzer, size_t npaths);
+
+        ///\returns The npaths worst setup timing paths accepted by filter (or fewer, if fewer paths are accepted)
+        std::vector<TimingPath> query_setup_timing_paths(const SetupTimingAnalyzer& setup_analyzer, const TimingPathFilter& filter, size_t npaths);
+
+        ///\returns The npaths worst hold timing paths accepted by filter (or fewer, if fewer paths are accepted)
+        std::vector<TimingPath> query_hold_timing_paths(const HoldTimingAnalyzer& hold_analyzer, const TimingPathFilter& filter, size_t npaths);
+
+        ///Drops all cached paths
+        void clear();
+
+    private:
+        //An end-point slack, in the index of the end-points
+        struct IndexedEndpoint {
+            Time slack;
+            NodeId node;
+            DomainId launch_domain;
+            DomainId capture_domain;
+        };
+
+        struct CachedPaths {
+            const TimingAnalyzer* analyzer = nullptr;
+            size_t num_updates = 0;
+            detail::WorstTimingPathEnumerator enumerator;
+            std::vector<TimingPath> paths;
+
+            //Index of the end-point slacks (in the enumeration order, so the paths above are
+            //those of the first end-points), valid if is_indexed
+            bool is_indexed = false;
+            std::vector<IndexedEndpoint> endpoints;
+            std::map<std::pair<DomainId, DomainId>, std::vector<size_t>> domain_pair_endpoints;
+            std::unordered_map<size_t, TimingPath> endpoint_paths; //Traced paths beyond the enumerated ones
+        };
+
+        //Drops the cache if the analyzer has been updated since it was filled
+        void validate(CachedPaths& cache,
+                      const TimingAnalyzer& analyzer,
+                      const detail::TagRetriever& tag_retriever);
+
+        std::vector<TimingPath> worst_timing_paths(CachedPaths& cache,
+                                                   const TimingAnalyzer& analyzer,
+                                                   const detail::TagRetriever& tag_retriever,
+                                                   size_t npaths);
+
+        std::vector<TimingPath> query_timing_paths(CachedPaths& cache,
+                                                   const TimingAnalyzer& analyzer,
+                                                   const detail::TagRetriever& tag_retriever,
+                                                   const TimingPathFilter& filter,
+                                                   size_t npaths);
+
+        void build_index(CachedPaths& cache, const detail::TagRetriever& tag_retriever);
+
+        const TimingPath& endpoint_path(CachedPaths& cache, const detail::TagRetriever& tag_retriever, size_t iendpoint);
+
+        const TimingGraph& timing_graph_;
+
+        CachedPaths setup_paths_;
+        CachedPaths hold_paths_;
+};
+
+} //namespace
+
+#endif
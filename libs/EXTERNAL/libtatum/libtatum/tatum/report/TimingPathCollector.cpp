@@ -3,6 +3,7 @@
 #include "tatum/report/TimingPathCollector.hpp"
 #include "tatum/report/TimingReportTagRetriever.hpp"
 #include "tatum/report/timing_path_tracing.hpp"
+#include "tatum/report/TimingPathCache.hpp"
 #include <map>
 
 namespace tatum {
@@ -15,43 +16,11 @@ std::vector<SkewPath> collect_worst_skew_paths(const TimingGraph& timing_graph,
 std::vector<TimingPath> collect_worst_timing_paths(const TimingGraph& timing_graph, const detail::TagRetriever& tag_retriever, size_t npaths) {
     std::vector<TimingPath> paths;
 
-    struct TagNode {
-        TagNode(TimingTag t, NodeId n) noexcept
-            : tag(t), node(n) {}
-
-        TimingTag tag;
-        NodeId node;
-
-    };
-
-    std::vector<TagNode> tags_and_sinks;
-
-    //Add the slacks of all sink
-    for(NodeId node : timing_graph.logical_outputs()) {
-        for(TimingTag tag : tag_retriever.slacks(node)) {
-            tags_and_sinks.emplace_back(tag,node);
-        }
-    }
-
-    //Sort in ascending slack order so most negative slacks are first
-    auto ascending_slack_order = [](const TagNode& lhs, const TagNode& rhs) {
-        return lhs.tag.time() < rhs.tag.time();
-    };
-    std::sort(tags_and_sinks.begin(), tags_and_sinks.end(), ascending_slack_order);
-
-
-    //Trace the paths for each tag/node pair
-    // The the map will sort the nodes and tags from worst to best slack (i.e. ascending slack order),
-    // so the first pair is the most critical end-point
-    for(const auto& tag_node : tags_and_sinks) {
-        NodeId sink_node = tag_node.node;
-        TimingTag sink_tag = tag_node.tag;
-
-        TimingPath path = detail::trace_path(timing_graph, tag_retriever, sink_tag.launch_clock_domain(), sink_tag.capture_clock_domain(), sink_node); 
-
-        paths.push_back(path);
-
-        if(paths.size() >= npaths) break;
+    //Trace the paths from worst to best slack (i.e. ascending slack order),
+    //so the first path is the most critical end-point
+    WorstTimingPathEnumerator enumerator(timing_graph, tag_retriever);
+    while(paths.size() < npaths && !enumerator.done()) {
+        paths.push_back(enumerator.next(timing_graph, tag_retriever));
     }
 
     return paths;
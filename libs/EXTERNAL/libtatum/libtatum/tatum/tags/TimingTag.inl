@@ -63,6 +63,25 @@ inline bool TimingTag::update(const Time& new_time, const NodeId origin, const T
 inline bool TimingTag::max(const Time& new_time, const NodeId origin, const TimingTag& base_tag) {
     bool modified = false;
 
+#if TIME_VEC_WIDTH > 1
+    if(time().valid() && !(new_time > time())) {
+        //The primary corner (and so the origin) is unchanged, but the
+        //other corners may still be dominated by the new value
+        Time max_time = time();
+        max_time.max(new_time);
+        if(!(max_time == time())) {
+            set_time(max_time);
+            modified = true;
+        }
+        return modified;
+    } else if(time().valid()) {
+        //New origin, but keep any corner of the old value which remains worse
+        Time max_time = new_time;
+        max_time.max(time());
+        return update(max_time, origin, base_tag);
+    }
+#endif
+
     //Need to min with existing value
     if(!time().valid() || new_time > time()) {
         //New value is smaller, or no previous valid value existed
@@ -77,6 +96,25 @@ inline bool TimingTag::max(const Time& new_time, const NodeId origin, const Timi
 inline bool TimingTag::min(const Time& new_time, const NodeId origin, const TimingTag& base_tag) {
     bool modified = false;
 
+#if TIME_VEC_WIDTH > 1
+    if(time().valid() && !(new_time < time())) {
+        //The primary corner (and so the origin) is unchanged, but the
+        //other corners may still be dominated by the new value
+        Time min_time = time();
+        min_time.min(new_time);
+        if(!(min_time == time())) {
+            set_time(min_time);
+            modified = true;
+        }
+        return modified;
+    } else if(time().valid()) {
+        //New origin, but keep any corner of the old value which remains better
+        Time min_time = new_time;
+        min_time.min(time());
+        return update(min_time, origin, base_tag);
+    }
+#endif
+
     //Need to min with existing value
     if(!time().valid() || new_time < time()) {
         //New value is smaller, or no previous valid value existed
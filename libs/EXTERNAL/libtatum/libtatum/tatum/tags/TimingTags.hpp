@@ -24,6 +24,10 @@ namespace tatum {
  *
  * Note that to allow efficient iteration of tag ranges (by type) we ensure that tags of the
  * same type are adjacent in the storage vector (i.e. the vector is sorted by type)
+ *
+ * The tags are either stored in their own heap allocation, or in a slice of a larger
+ * arena shared by many TimingTags (see relocate()), which avoids one allocation per
+ * node. Tags which outgrow an arena slice move to their own heap allocation.
  */
 class TimingTags {
     public:
@@ -50,7 +54,7 @@ class TimingTags {
         TimingTags(const TimingTags&);
         TimingTags(TimingTags&&);
         TimingTags& operator=(TimingTags);
-        ~TimingTags() = default;
+        ~TimingTags();
         friend void swap(TimingTags& lhs, TimingTags& rhs);
 
         /*
@@ -101,6 +105,14 @@ class TimingTags {
         ///Clears the tags in the current set
         void clear();
 
+        ///\returns True if the tags are stored in their own heap allocation (rather than an arena)
+        bool is_heap_allocated() const;
+
+        ///Moves the tags to externally owned storage (e.g. a slice of an arena), which must
+        ///hold at least size() tags and outlive this object (or its next relocate()/growth).
+        ///The capacity becomes size(), so any further tag moves back to the heap.
+        void relocate(TimingTag* storage);
+
     public:
 
         //Iterator definition
@@ -194,19 +206,21 @@ class TimingTags {
         //to be packed down to 16 bytes (8 for counters, 8 for pointer)
         //
         //In its current configuration we can store at most:
-        //  65536           total tags (size_ and capacity_)
+        //  32768           total tags (size_ and capacity_)
         //  256             clock launch tags (num_clock_launch_tags_)
         //  256             clock capture tags (num_clock_capture_tags_)
         //  256             data arrival tags (num_data_arrival_tags_)
         //  256             data required tags (num_data_required_tags_)
-        //  (65536 - 4*256) slack tags (size_ - num_*)
+        //  (32768 - 4*256) slack tags (size_ - num_*)
+        constexpr static size_t MAX_CAPACITY = (1 << 15) - 1;
         unsigned short size_ = 0;
-        unsigned short capacity_ = 0;
+        unsigned short capacity_ : 15;
+        unsigned short owns_tags_ : 1; //Whether tags_ is our own heap allocation (vs. an arena slice)
         unsigned char num_clock_launch_tags_ = 0;
         unsigned char num_clock_capture_tags_ = 0;
         unsigned char num_data_arrival_tags_ = 0;
         unsigned char num_data_required_tags_ = 0;
-        std::unique_ptr<TimingTag[]> tags_;
+        TimingTag* tags_ = nullptr;
 
 };
 
@@ -13,22 +13,31 @@ namespace tatum {
 inline TimingTags::TimingTags(size_t num_reserve)
     : size_(0)
     , capacity_(num_reserve)
+    , owns_tags_(true)
     , num_clock_launch_tags_(0)
     , num_clock_capture_tags_(0)
     , num_data_arrival_tags_(0)
     , num_data_required_tags_(0)
-    , tags_(capacity_ ? new TimingTag[capacity_] : nullptr)
-    {}
+    , tags_(capacity_ ? new TimingTag[capacity_] : nullptr) {
+    TATUM_ASSERT(num_reserve <= MAX_CAPACITY);
+}
 
 inline TimingTags::TimingTags(const TimingTags& other) 
     : size_(other.size())
     , capacity_(size_)
+    , owns_tags_(true)
     , num_clock_launch_tags_(other.num_clock_launch_tags_)
     , num_clock_capture_tags_(other.num_clock_capture_tags_)
     , num_data_arrival_tags_(other.num_data_arrival_tags_)
     , num_data_required_tags_(other.num_data_required_tags_)
     , tags_(capacity_ ? new TimingTag[capacity_] : nullptr) {
-    std::copy(other.tags_.get(), other.tags_.get() + other.size(), tags_.get());
+    std::copy(other.tags_, other.tags_ + other.size(), tags_);
+}
+
+inline TimingTags::~TimingTags() {
+    if(owns_tags_) {
+        delete[] tags_;
+    }
 }
 
 inline TimingTags::TimingTags(TimingTags&& other)
@@ -46,13 +55,13 @@ inline size_t TimingTags::size() const {
 }
 
 inline TimingTags::iterator TimingTags::begin() {
-    auto iter = iterator(tags_.get());
+    auto iter = iterator(tags_);
 
     return iter;
 }
 
 inline TimingTags::const_iterator TimingTags::begin() const {
-    return const_iterator(tags_.get());
+    return const_iterator(tags_);
 }
 
 inline TimingTags::iterator TimingTags::begin(TagType type) {
@@ -90,8 +99,8 @@ inline TimingTags::iterator TimingTags::end() {
 }
 
 inline TimingTags::const_iterator TimingTags::end() const {
-    auto iter = const_iterator(tags_.get() + size_);
-    TATUM_ASSERT_SAFE(iter.p_ >= tags_.get() && iter.p_ <= tags_.get() + size());
+    auto iter = const_iterator(tags_ + size_);
+    TATUM_ASSERT_SAFE(iter.p_ >= tags_ && iter.p_ <= tags_ + size());
     return iter;
 }
 
@@ -123,7 +132,7 @@ inline TimingTags::const_iterator TimingTags::end(TagType type) const {
         default:
             TATUM_ASSERT_MSG(false, "Invalid tag type");
     }
-    TATUM_ASSERT_SAFE(iter.p_ >= tags_.get() && iter.p_ <= tags_.get() + size());
+    TATUM_ASSERT_SAFE(iter.p_ >= tags_ && iter.p_ <= tags_ + size());
     return iter;
 }
 
@@ -281,6 +290,19 @@ inline std::pair<bool,TimingTags::iterator> TimingTags::find_data_required_with_
 
 inline size_t TimingTags::capacity() const { return capacity_; }
 
+inline bool TimingTags::is_heap_allocated() const { return owns_tags_ && tags_ != nullptr; }
+
+inline void TimingTags::relocate(TimingTag* storage) {
+    std::copy_n(tags_, size(), storage);
+
+    if(owns_tags_) {
+        delete[] tags_;
+    }
+    tags_ = storage;
+    capacity_ = size_;
+    owns_tags_ = false;
+}
+
 inline TimingTags::iterator TimingTags::insert(iterator iter, const TimingTag& tag) {
     size_t index = std::distance(begin(), iter);
     TATUM_ASSERT(index <= size());
@@ -309,15 +331,16 @@ inline TimingTags::iterator TimingTags::insert(iterator iter, const TimingTag& t
 }
 
 inline void TimingTags::grow_insert(size_t index, const TimingTag& tag) {
-    size_t new_capacity = (capacity() == 0) ? 1 : GROWTH_FACTOR * capacity();
+    size_t new_capacity = (capacity() == 0) ? 1 : std::min(GROWTH_FACTOR * capacity(), MAX_CAPACITY);
+    TATUM_ASSERT_MSG(new_capacity > size(), "Too many timing tags");
 
     //We construct a new copy of ourselves at the new capacity and with the new
     //tag inserted
     TimingTags new_tags(new_capacity);
 
-    std::copy_n(tags_.get(), index, new_tags.tags_.get()); //Copy before index
+    std::copy_n(tags_, index, new_tags.tags_); //Copy before index
     new_tags.tags_[index] = tag; //Insert the new value
-    std::copy_n(tags_.get() + index, size() - index, new_tags.tags_.get() + index + 1); //Copy after index
+    std::copy_n(tags_ + index, size() - index, new_tags.tags_ + index + 1); //Copy after index
 
     //Copy the sizes
     new_tags.size_ = size_;
@@ -358,12 +381,21 @@ inline void TimingTags::increment_size(TagType type) {
 
 inline void swap(TimingTags& lhs, TimingTags& rhs) {
     std::swap(lhs.tags_, rhs.tags_);
+
+    //Bit-fields can not be swapped by reference
+    unsigned short lhs_owns_tags = lhs.owns_tags_;
+    lhs.owns_tags_ = rhs.owns_tags_;
+    rhs.owns_tags_ = lhs_owns_tags;
+
     std::swap(lhs.num_clock_launch_tags_, rhs.num_clock_launch_tags_);
     std::swap(lhs.num_clock_capture_tags_, rhs.num_clock_capture_tags_);
     std::swap(lhs.num_data_arrival_tags_, rhs.num_data_arrival_tags_);
     std::swap(lhs.num_data_required_tags_, rhs.num_data_required_tags_);
     std::swap(lhs.size_, rhs.size_);
-    std::swap(lhs.capacity_, rhs.capacity_);
+
+    unsigned short lhs_capacity = lhs.capacity_;
+    lhs.capacity_ = rhs.capacity_;
+    rhs.capacity_ = lhs_capacity;
 }
 
 } //namepsace
@@ -79,6 +79,9 @@ struct Args {
     //Write an echo file of resutls?
     std::string write_echo;
 
+    //Write a CSV summary of the analysis run times?
+    std::string write_csv;
+
     //Optimize graph memory layout?
     size_t opt_graph_layout = 0;
 
@@ -104,6 +107,10 @@ Args parse_args(int argc, char** argv);
 double median(std::vector<double> values);
 double arithmean(std::vector<double> values);
 
+//Run times of the runs of each analyzer, in the order they were benchmarked
+typedef std::vector<std::pair<std::string,std::vector<double>>> BenchmarkRuns;
+void write_benchmark_csv(std::string filename, const TimingGraph& tg, const BenchmarkRuns& runs);
+
 template<class I>
 double median(I begin, I end) {
     std::sort(begin, end);
@@ -161,6 +168,10 @@ void usage(std::string prog) {
     cout << "    --write_echo WRITE_ECHO:                   Write an echo file of restuls.\n";
     cout << "                                               empty implies no, non-empty implies write to specified file.\n";
     cout << "                                               (default " << default_args.write_echo << ")\n";
+    cout << "    --write_csv WRITE_CSV:                     Write a CSV summary of the run times of each analyzer\n";
+    cout << "                                               (one row per analyzer: runs, median, mean, min and max seconds).\n";
+    cout << "                                               empty implies no, non-empty implies write to specified file.\n";
+    cout << "                                               (default " << default_args.write_csv << ")\n";
     cout << "    --opt_graph_layout OPT_LAYOUT:             Optimize graph layout.\n";
     cout << "                                               0 implies no, non-zero implies yes.\n";
     cout << "                                               (default " << default_args.opt_graph_layout << ")\n";
@@ -180,6 +191,10 @@ void usage(std::string prog) {
     cout << "                                               Values >= 0 dump the transitive connections of\n";
     cout << "                                               the matching node.\n";
     cout << "                                               (default " << default_args.debug_dot_node << ")\n";
+    cout << "\n";
+    cout << "  The timing graphs of VPR (with their constraints, delays and analysis results used as reference)\n";
+    cout << "  are written in this format by 'vpr --write_timing_graph_echo STAGES' (e.g. route_final), and\n";
+    cout << "  refer to netlist objects by number only (clock names too, with --anonymize_timing_graph_echo on).\n";
 }
 
 void cmd_error(std::string prog, std::string msg) {
@@ -208,6 +223,8 @@ Args parse_args(int argc, char** argv) {
         } else if (arg_str.size() >= 2 && arg_str[0] == '-' && arg_str[1] == '-') {
             if (arg_str == "--write_echo") {
                 args.write_echo = argv[i+1];
+            } else if (arg_str == "--write_csv") {
+                args.write_csv = argv[i+1];
             } else if (arg_str == "--analysis_type") {
                 args.analysis_type = argv[i+1];
             } else {
@@ -413,6 +430,8 @@ int main(int argc, char** argv) {
     std::shared_ptr<tatum::TimingAnalyzer> hold_analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis>::make(*timing_graph, *timing_constraints, *delay_calculator);
     std::shared_ptr<tatum::TimingAnalyzer> setup_hold_analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis>::make(*timing_graph, *timing_constraints, *delay_calculator);
 
+    BenchmarkRuns benchmark_runs;
+
     //Create the timing analyzer
     std::shared_ptr<tatum::TimingAnalyzer> serial_analyzer;
     if (args.analysis_type == "setuphold") {
@@ -437,6 +456,7 @@ int main(int argc, char** argv) {
         cout << "Running Serial Analysis " << args.num_serial_runs << " times" << endl;
 
         serial_prof_data = profile(args.num_serial_runs, serial_analyzer);
+        benchmark_runs.emplace_back("serial", serial_prof_data["analysis_sec"]);
 
         cout << "\n";
 
@@ -594,6 +614,10 @@ int main(int argc, char** argv) {
 
             serial_incr_verify_time += std::accumulate(serial_incr_prof_data["verify_sec"].begin(), serial_incr_prof_data["verify_sec"].end(), 0.);
 
+            //The first run is a full update
+            const auto& incr_sec = serial_incr_prof_data["analysis_sec"];
+            benchmark_runs.emplace_back("serial_incr", std::vector<double>(incr_sec.begin() + std::min<size_t>(1, incr_sec.size()), incr_sec.end()));
+
             cout << endl;
             cout << "SerialIncr Analysis took " << std::setprecision(6) << std::setw(6) << arithmean_skip_first(serial_incr_prof_data["analysis_sec"])*args.num_serial_incr_runs << " sec";
             if(serial_incr_prof_data["analysis_sec"].size() > 0) {
@@ -637,6 +661,46 @@ int main(int argc, char** argv) {
         cout << endl;
 
         cout << endl << "Net SerialIncr Analysis elapsed time: " << serial_incr_analyzer->get_profiling_data("total_analysis_sec") << " sec over " << serial_incr_analyzer->get_profiling_data("num_full_updates") << " full updates" << endl;
+
+        //The parallel incremental analyzer is checked on the same number of incremental runs
+        std::shared_ptr<tatum::TimingAnalyzer> parallel_incr_analyzer;
+        if (args.analysis_type == "setuphold") {
+            parallel_incr_analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis,tatum::ParallelIncrWalker>::make(*timing_graph, *timing_constraints, *delay_calculator);
+        } else if (args.analysis_type == "setup") {
+            parallel_incr_analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis,tatum::ParallelIncrWalker>::make(*timing_graph, *timing_constraints, *delay_calculator);
+        } else {
+            TATUM_ASSERT(args.analysis_type == "hold");
+            parallel_incr_analyzer = tatum::AnalyzerFactory<tatum::HoldAnalysis,tatum::ParallelIncrWalker>::make(*timing_graph, *timing_constraints, *delay_calculator);
+        }
+
+        std::map<std::string,std::vector<double>> parallel_incr_prof_data;
+        {
+            cout << endl << "Running ParallelIncr Analysis " << args.num_serial_incr_runs << " times" << endl;
+
+            bool equivalent = profile_incr(args.num_serial_incr_runs,
+                                           args.edge_change_prob,
+                                           args.verify,
+                                           *timing_graph,
+                                           parallel_incr_analyzer,
+                                           serial_analyzer,
+                                           *delay_calculator,
+                                           parallel_incr_prof_data);
+
+            if(!equivalent) {
+                cout << "Verification failed!\n";
+                exit_code = 1;
+            }
+
+            const auto& incr_sec = parallel_incr_prof_data["analysis_sec"];
+            benchmark_runs.emplace_back("parallel_incr", std::vector<double>(incr_sec.begin() + std::min<size_t>(1, incr_sec.size()), incr_sec.end()));
+
+            cout << "ParallelIncr Analysis took " << std::setprecision(6) << std::setw(6) << arithmean_skip_first(parallel_incr_prof_data["analysis_sec"])*args.num_serial_incr_runs << " sec";
+            if(parallel_incr_prof_data["analysis_sec"].size() > 0) {
+                cout << " Median: " << median_skip_first(parallel_incr_prof_data["analysis_sec"]);
+            }
+            cout << endl;
+        }
+        cout << "ParallelIncr Speed-Up over SerialIncr: " << std::fixed << median(serial_incr_prof_data["analysis_sec"]) / median(parallel_incr_prof_data["analysis_sec"]) << "x" << endl;
     }
 
     if (args.num_parallel_runs) {
@@ -664,6 +728,7 @@ int main(int argc, char** argv) {
 
             //Analyze
             parallel_prof_data = profile(args.num_parallel_runs, parallel_analyzer);
+            benchmark_runs.emplace_back("parallel", parallel_prof_data["analysis_sec"]);
 
             //Verify
             clock_gettime(CLOCK_MONOTONIC, &verify_start);
@@ -750,6 +815,10 @@ int main(int argc, char** argv) {
         cout << "  " << cpd.launch_domain() << " -> " << cpd.capture_domain() << ": " << std::scientific << cpd.delay() << "\n";
     }
 
+    if (!args.write_csv.empty()) {
+        write_benchmark_csv(args.write_csv, *timing_graph, benchmark_runs);
+    }
+
     if (exit_code) {
         cout << "FAILED!\n";
     }
@@ -774,3 +843,22 @@ double median(std::vector<double> values) {
 double arithmean(std::vector<double> values) {
     return std::accumulate(values.begin(), values.end(), 0.) / values.size();
 }
+
+void write_benchmark_csv(std::string filename, const TimingGraph& tg, const BenchmarkRuns& runs) {
+    std::ofstream os(filename);
+    os << "analyzer,nodes,edges,runs,median_sec,mean_sec,min_sec,max_sec\n";
+    for (const auto& run : runs) {
+        const std::vector<double>& sec = run.second;
+        os << run.first << "," << tg.nodes().size() << "," << tg.edges().size() << "," << sec.size();
+        if (sec.empty()) {
+            os << ",,,,\n";
+            continue;
+        }
+        os << std::setprecision(9)
+           << "," << median(sec)
+           << "," << arithmean(sec)
+           << "," << *std::min_element(sec.begin(), sec.end())
+           << "," << *std::max_element(sec.begin(), sec.end()) << "\n";
+    }
+    cout << "Wrote benchmark summary to " << filename << "\n";
+}
@@ -0,0 +1,1131 @@
+#include "binary_arch_file.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "arch_error.h"
+#include "arch_util.h"
+#include "vtr_assert.h"
+#include "vtr_bimap.h"
+#include "vtr_memory.h"
+#include "vtr_ndmatrix.h"
+
+/// @brief Identifies binary architecture files
+static constexpr char BINARY_ARCH_MAGIC[8] = {'V', 'T', 'R', 'A', 'R', 'C', 'H', '\0'};
+
+/// @brief Version of the binary architecture format, to be incremented when the recorded data changes
+static constexpr uint32_t BINARY_ARCH_VERSION = 1;
+
+/**
+ * @brief Writes or reads (depending on is_loading()) the architecture data structures.
+ *
+ * Each io() overload handles one type symmetrically, so that the write and read orders can
+ * not diverge. When writing, the values are only read, even though they are taken by
+ * non-const reference.
+ */
+class ArchBinaryArchive {
+  public:
+    /// @brief Creates an archive writing to an empty buffer
+    ArchBinaryArchive(t_arch& arch,
+                      std::vector<t_physical_tile_type>& physical_tile_types,
+                      std::vector<t_logical_block_type>& logical_block_types)
+        : arch_(arch)
+        , physical_tile_types_(physical_tile_types)
+        , logical_block_types_(logical_block_types)
+        , loading_(false) {}
+
+    /// @brief Creates an archive reading from data
+    ArchBinaryArchive(const std::string& binary_file,
+                      const std::vector<char>& data,
+                      t_arch& arch,
+                      std::vector<t_physical_tile_type>& physical_tile_types,
+                      std::vector<t_logical_block_type>& logical_block_types)
+        : arch_(arch)
+        , physical_tile_types_(physical_tile_types)
+        , logical_block_types_(logical_block_types)
+        , loading_(true)
+        , binary_file_(binary_file)
+        , read_pos_(data.data())
+        , read_end_(data.data() + data.size()) {}
+
+    bool is_loading() const { return loading_; }
+
+    const std::vector<char>& buffer() const { return buffer_; }
+
+    bool at_end() const { return read_pos_ == read_end_; }
+
+    /// @brief The whole architecture: t_arch, then the physical and logical block types
+    void io_architecture() {
+        io(arch_);
+
+        size_t num_physical_tile_types = physical_tile_types_.size();
+        size_t num_logical_block_types = logical_block_types_.size();
+        io(num_physical_tile_types);
+        io(num_logical_block_types);
+        if (loading_) {
+            // Sized before loading any type, since the types point to each other
+            physical_tile_types_.resize(num_physical_tile_types);
+            logical_block_types_.resize(num_logical_block_types);
+        }
+
+        for (t_physical_tile_type& type : physical_tile_types_) {
+            io(type);
+        }
+        for (t_logical_block_type& type : logical_block_types_) {
+            io(type);
+        }
+    }
+
+    /*
+     * Plain values and containers
+     */
+
+    template<typename T>
+    std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>> io(T& value) {
+        if (loading_) {
+            read_bytes(&value, sizeof(T));
+        } else {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+        }
+    }
+
+    void io(std::string& str) {
+        size_t size = str.size();
+        io(size);
+        if (loading_) {
+            check_remaining(size);
+            str.assign(read_pos_, size);
+            read_pos_ += size;
+        } else {
+            buffer_.insert(buffer_.end(), str.begin(), str.end());
+        }
+    }
+
+    /// @brief Strings allocated with vtr::strdup(), which may be null
+    void io(char*& str) {
+        bool is_set = (str != nullptr);
+        io(is_set);
+        if (!is_set) {
+            if (loading_) {
+                str = nullptr;
+            }
+            return;
+        }
+
+        std::string value = loading_ ? std::string() : std::string(str);
+        io(value);
+        if (loading_) {
+            str = vtr::strdup(value.c_str());
+        }
+    }
+
+    void io(std::vector<bool>& vec) {
+        size_t size = vec.size();
+        io(size);
+        if (loading_) {
+            check_remaining(size);
+            vec.resize(size);
+        }
+        for (size_t i = 0; i < size; i++) {
+            bool value = vec[i];
+            io(value);
+            vec[i] = value;
+        }
+    }
+
+    template<typename T>
+    void io(std::vector<T>& vec) {
+        size_t size = vec.size();
+        io(size);
+        if (loading_) {
+            check_remaining(size);
+            vec.resize(size);
+        }
+        for (T& value : vec) {
+            io(value);
+        }
+    }
+
+    template<typename T, typename U>
+    void io(std::pair<T, U>& pair) {
+        io(pair.first);
+        io(pair.second);
+    }
+
+    template<typename Map>
+    void io_map(Map& map) {
+        size_t size = map.size();
+        io(size);
+        if (loading_) {
+            check_remaining(size);
+            for (size_t i = 0; i < size; i++) {
+                typename Map::key_type key;
+                typename Map::mapped_type value;
+                io(key);
+                io(value);
+                map.emplace(std::move(key), std::move(value));
+            }
+        } else {
+            for (auto& [key, value] : map) {
+                typename Map::key_type key_copy = key;
+                io(key_copy);
+                io(value);
+            }
+        }
+    }
+
+    template<typename K, typename V, typename C>
+    void io(std::map<K, V, C>& map) {
+        io_map(map);
+    }
+
+    template<typename K, typename V, typename H>
+    void io(std::unordered_map<K, V, H>& map) {
+        io_map(map);
+    }
+
+    template<typename T>
+    void io(std::unordered_set<T>& set) {
+        size_t size = set.size();
+        io(size);
+        if (loading_) {
+            check_remaining(size);
+            for (size_t i = 0; i < size; i++) {
+                T value;
+                io(value);
+                set.insert(value);
+            }
+        } else {
+            for (T value : set) {
+                io(value);
+            }
+        }
+    }
+
+    template<typename T, size_t N>
+    void io(vtr::NdMatrix<T, N>& matrix) {
+        std::array<size_t, N> dim_sizes;
+        for (size_t dim = 0; dim < N; dim++) {
+            dim_sizes[dim] = matrix.dim_size(dim);
+            io(dim_sizes[dim]);
+        }
+        if (loading_) {
+            size_t size = 1;
+            for (size_t dim_size : dim_sizes) {
+                size *= dim_size;
+                check_remaining(size);
+            }
+            matrix.resize(dim_sizes);
+        }
+        for (size_t i = 0; i < matrix.size(); i++) {
+            io(matrix.get(i));
+        }
+    }
+
+    /// @brief Optional objects allocated with new
+    template<typename T>
+    void io_optional(T*& ptr) {
+        bool is_set = (ptr != nullptr);
+        io(is_set);
+        if (loading_) {
+            ptr = is_set ? new T() : nullptr;
+        }
+        if (is_set) {
+            io(*ptr);
+        }
+    }
+
+    /*
+     * Architecture
+     */
+
+    void io(t_arch& arch) {
+        io(arch.architecture_id);
+
+        io(arch.tileable);
+        io(arch.perimeter_cb);
+        io(arch.shrink_boundary);
+        io(arch.through_channel);
+        io(arch.opin2all_sides);
+        io(arch.concat_wire);
+        io(arch.concat_pass_wire);
+        io(arch.sub_fs);
+        io(arch.sb_sub_type);
+
+        io(arch.Chans.chan_x_dist);
+        io(arch.Chans.chan_y_dist);
+        io(arch.sb_type);
+        io(arch.switchblocks);
+        io(arch.R_minW_nmos);
+        io(arch.R_minW_pmos);
+        io(arch.Fs);
+        io(arch.grid_logic_tile_area);
+        io(arch.Segments);
+        io(arch.switches);
+        io(arch.directs);
+
+        io(arch.models);
+
+        // Power and clocks are only loaded if power analysis is enabled, which is checked
+        // rather than recorded since the caller allocates them.
+        bool has_power = (arch.power != nullptr);
+        bool has_clocks = (arch.clocks != nullptr);
+        io_expect(has_power, "power architecture");
+        io_expect(has_clocks, "power clock networks");
+        if (has_power) {
+            io(*arch.power);
+        }
+        if (has_clocks) {
+            io(*arch.clocks);
+        }
+
+        io(arch.layer_global_routing);
+
+        io(arch.gnd_cell);
+        io(arch.vcc_cell);
+        io(arch.gnd_net);
+        io(arch.vcc_net);
+        io(arch.default_clock_network_name);
+
+        io(arch.lut_cells);
+        io(arch.lut_elements);
+        io(arch.ipin_cblock_switch_name);
+
+        io(arch.grid_layouts);
+
+        io(arch.clock_arch.clock_networks_arch);
+        io(arch.clock_arch.clock_metal_layers);
+        io(arch.clock_arch.clock_connections_arch);
+
+        io_optional(arch.noc);
+
+        io(arch.scatter_gather_patterns);
+
+        std::vector<std::string> interned_strings;
+        for (const vtr::interned_string& interned_string : arch.interned_strings) {
+            interned_strings.push_back(interned_string.get(&arch.strings));
+        }
+        io(interned_strings);
+        if (loading_) {
+            for (const std::string& value : interned_strings) {
+                arch.interned_strings.push_back(arch.strings.intern_string(value));
+            }
+        }
+    }
+
+    void io(t_chan& chan) {
+        io(chan.type);
+        io(chan.peak);
+        io(chan.width);
+        io(chan.xpeak);
+        io(chan.dc);
+    }
+
+    void io(t_metadata_dict& meta) {
+        size_t num_keys = meta.size();
+        io(num_keys);
+        if (loading_) {
+            check_remaining(num_keys);
+            for (size_t i = 0; i < num_keys; i++) {
+                std::string key;
+                std::vector<std::string> values;
+                io(key);
+                io(values);
+                vtr::interned_string interned_key = arch_.strings.intern_string(key);
+                for (const std::string& value : values) {
+                    meta.add(interned_key, arch_.strings.intern_string(value));
+                }
+            }
+        } else {
+            for (const auto& [key, values] : meta) {
+                std::string key_str = key.get(&arch_.strings);
+                std::vector<std::string> value_strs;
+                for (const t_metadata_value& value : values) {
+                    value_strs.push_back(value.as_string().get(&arch_.strings));
+                }
+                io(key_str);
+                io(value_strs);
+            }
+        }
+    }
+
+    /*
+     * Routing architecture
+     */
+
+    void io(t_segment_inf& segment) {
+        io(segment.name);
+        io(segment.frequency);
+        io(segment.length);
+        io(segment.arch_wire_switch);
+        io(segment.arch_opin_switch);
+        io(segment.arch_wire_switch_dec);
+        io(segment.arch_opin_switch_dec);
+        io(segment.arch_inter_die_switch);
+        io(segment.frac_cb);
+        io(segment.frac_sb);
+        io(segment.longline);
+        io(segment.Rmetal);
+        io(segment.Cmetal);
+        io(segment.directionality);
+        io(segment.parallel_axis);
+        io(segment.cb);
+        io(segment.sb);
+        io(segment.is_bend);
+        io(segment.bend);
+        io(segment.part_len);
+        io(segment.seg_index);
+        io(segment.res_type);
+    }
+
+    void io(t_arch_switch_inf& arch_switch) {
+        io(arch_switch.name);
+        io(arch_switch.R);
+        io(arch_switch.Cin);
+        io(arch_switch.Cout);
+        io(arch_switch.Cinternal);
+        io(arch_switch.mux_trans_size);
+        io(arch_switch.buf_size_type);
+        io(arch_switch.buf_size);
+        io(arch_switch.power_buffer_type);
+        io(arch_switch.power_buffer_size);
+        io(arch_switch.intra_tile);
+        io(arch_switch.type_);
+        io(arch_switch.Tdel_map_);
+    }
+
+    void io(t_direct_inf& direct) {
+        io(direct.name);
+        io(direct.from_pin);
+        io(direct.to_pin);
+        io(direct.x_offset);
+        io(direct.y_offset);
+        io(direct.sub_tile_offset);
+        io(direct.switch_type);
+        io(direct.from_side);
+        io(direct.to_side);
+        io(direct.line);
+    }
+
+    void io(t_switchblock_inf& switchblock) {
+        io(switchblock.name);
+        io(switchblock.location);
+        io(switchblock.directionality);
+        io(switchblock.permutation_map);
+        io(switchblock.specified_loc);
+        io(switchblock.wireconns);
+    }
+
+    void io(SBSideConnection& connection) {
+        io(connection.from_side);
+        io(connection.to_side);
+    }
+
+    void io(t_specified_loc& loc) {
+        io(loc.x);
+        io(loc.y);
+        io(loc.reg_x);
+        io(loc.reg_y);
+    }
+
+    void io(t_sb_loc_spec& spec) {
+        io(spec.start);
+        io(spec.repeat);
+        io(spec.incr);
+        io(spec.end);
+    }
+
+    void io(t_wireconn_inf& wireconn) {
+        io(wireconn.from_switchpoint_set);
+        io(wireconn.to_switchpoint_set);
+        io(wireconn.from_switchpoint_order);
+        io(wireconn.to_switchpoint_order);
+        io(wireconn.switch_override_indx);
+        io(wireconn.num_conns_formula);
+        io(wireconn.sides);
+    }
+
+    void io(t_wire_switchpoints& switchpoints) {
+        io(switchpoints.segment_name);
+        io(switchpoints.switchpoints);
+    }
+
+    void io(t_scatter_gather_pattern& pattern) {
+        io(pattern.name);
+        io(pattern.type);
+        io(pattern.gather_pattern);
+        io(pattern.scatter_pattern);
+        io(pattern.sg_links);
+        io(pattern.sg_locations);
+    }
+
+    void io(t_sg_link& link) {
+        io(link.name);
+        io(link.mux_name);
+        io(link.seg_type);
+        io(link.x_offset);
+        io(link.y_offset);
+        io(link.z_offset);
+    }
+
+    void io(t_sg_location& location) {
+        io(location.type);
+        io(location.region);
+        io(location.num);
+        io(location.sg_link_name);
+    }
+
+    /*
+     * Clocks, power and NoC
+     */
+
+    void io(t_clock_network_arch& clock_network) {
+        io(clock_network.name);
+        io(clock_network.num_inst);
+        io(clock_network.type);
+        io(clock_network.metal_layer);
+        io(clock_network.wire.start);
+        io(clock_network.wire.end);
+        io(clock_network.wire.position);
+        io(clock_network.repeat.x);
+        io(clock_network.repeat.y);
+        io(clock_network.drive.name);
+        io(clock_network.drive.offset);
+        io(clock_network.drive.arch_switch_idx);
+        io(clock_network.tap.name);
+        io(clock_network.tap.offset);
+        io(clock_network.tap.increment);
+    }
+
+    void io(t_metal_layer& metal_layer) {
+        io(metal_layer.r_metal);
+        io(metal_layer.c_metal);
+    }
+
+    void io(t_clock_connection_arch& connection) {
+        io(connection.from);
+        io(connection.to);
+        io(connection.arch_switch_idx);
+        io(connection.locationx);
+        io(connection.locationy);
+        io(connection.fc);
+    }
+
+    void io(t_power_arch& power) {
+        io(power.C_wire_local);
+        io(power.logical_effort_factor);
+        io(power.local_interc_factor);
+        io(power.transistors_per_SRAM_bit);
+        io(power.mux_transistor_size);
+        io(power.FF_size);
+        io(power.LUT_transistor_size);
+    }
+
+    void io(t_clock_network& clock) {
+        io(clock.autosize_buffer);
+        io(clock.buffer_size);
+        io(clock.C_wire);
+        io(clock.prob);
+        io(clock.dens);
+        io(clock.period);
+    }
+
+    void io(t_noc_inf& noc) {
+        io(noc.link_bandwidth);
+        io(noc.link_latency);
+        io(noc.router_latency);
+        io(noc.router_list);
+        io(noc.router_latency_overrides);
+        io(noc.link_latency_overrides);
+        io(noc.link_bandwidth_overrides);
+        io(noc.noc_router_tile_name);
+    }
+
+    void io(t_router& router) {
+        io(router.id);
+        io(router.device_x_position);
+        io(router.device_y_position);
+        io(router.device_layer_position);
+        io(router.connection_list);
+    }
+
+    void io(t_lut_cell& lut_cell) {
+        io(lut_cell.name);
+        io(lut_cell.init_param);
+        io(lut_cell.inputs);
+    }
+
+    void io(t_lut_element& lut_element) {
+        io(lut_element.site_type);
+        io(lut_element.width);
+        io(lut_element.lut_bels);
+    }
+
+    void io(t_lut_bel& lut_bel) {
+        io(lut_bel.name);
+        io(lut_bel.input_pins);
+        io(lut_bel.output_pin);
+    }
+
+    /*
+     * Device grid layouts
+     */
+
+    void io(t_grid_def& grid_def) {
+        io(grid_def.grid_type);
+        io(grid_def.name);
+        io(grid_def.width);
+        io(grid_def.height);
+        io(grid_def.aspect_ratio);
+        io(grid_def.layers);
+    }
+
+    void io(t_layer_def& layer_def) {
+        // t_grid_loc_def has no default constructor, and its metadata may be owned by
+        // another definition of the layer (e.g. the edges of a perimeter)
+        size_t num_loc_defs = layer_def.loc_defs.size();
+        io(num_loc_defs);
+        if (loading_) {
+            check_remaining(num_loc_defs);
+        }
+
+        std::vector<int> meta_owners(num_loc_defs, -1);
+        for (size_t i = 0; i < num_loc_defs; i++) {
+            if (loading_) {
+                layer_def.loc_defs.emplace_back("", 0);
+            } else {
+                const t_metadata_dict* meta = layer_def.loc_defs[i].meta;
+                for (size_t j = 0; meta && j < num_loc_defs; j++) {
+                    if (layer_def.loc_defs[j].owned_meta.get() == meta) {
+                        meta_owners[i] = j;
+                    }
+                }
+                VTR_ASSERT(!meta || meta_owners[i] >= 0);
+            }
+
+            t_grid_loc_def& loc_def = layer_def.loc_defs[i];
+            io(loc_def.block_type);
+            io(loc_def.priority);
+            io(loc_def.x);
+            io(loc_def.y);
+
+            t_metadata_dict* owned_meta = loc_def.owned_meta.get();
+            io_optional(owned_meta);
+            if (loading_) {
+                loc_def.owned_meta.reset(owned_meta);
+            }
+            io(meta_owners[i]);
+        }
+
+        if (loading_) {
+            for (size_t i = 0; i < num_loc_defs; i++) {
+                if (meta_owners[i] >= 0) {
+                    check_index(meta_owners[i], num_loc_defs, "grid location metadata");
+                    layer_def.loc_defs[i].meta = layer_def.loc_defs[meta_owners[i]].owned_meta.get();
+                }
+            }
+        }
+
+        io(layer_def.interposer_cuts);
+    }
+
+    void io(t_grid_loc_spec& spec) {
+        io(spec.start_expr);
+        io(spec.end_expr);
+        io(spec.repeat_expr);
+        io(spec.incr_expr);
+    }
+
+    void io(t_interposer_cut_inf& cut) {
+        io(cut.dim);
+        io(cut.loc);
+        io(cut.interdie_wires);
+    }
+
+    void io(t_interdie_wire_inf& wire) {
+        io(wire.sg_name);
+        io(wire.sg_link);
+        io(wire.offset_definition);
+        io(wire.num);
+    }
+
+    /*
+     * Models
+     */
+
+    void io(LogicalModels& models) {
+        size_t num_models = models.all_models().size();
+        io(num_models);
+        if (loading_) {
+            check_remaining(num_models);
+            // The library models are recorded (and recreated) like the user models
+            models.clear_models();
+        }
+
+        for (size_t i = 0; i < num_models; i++) {
+            std::string name = loading_ ? std::string() : models.model_name(LogicalModelId(i));
+            io(name);
+
+            LogicalModelId model_id = loading_ ? models.create_logical_model(name) : LogicalModelId(i);
+            VTR_ASSERT(size_t(model_id) == i);
+            t_model& model = models.get_model(model_id);
+
+            io_model_ports(model.inputs);
+            io_model_ports(model.outputs);
+            io(model.never_prune);
+        }
+    }
+
+    /// @brief A linked list of model ports
+    void io_model_ports(t_model_ports*& ports) {
+        size_t num_ports = 0;
+        for (t_model_ports* port = ports; port != nullptr; port = port->next) {
+            num_ports++;
+        }
+        io(num_ports);
+        if (loading_) {
+            check_remaining(num_ports);
+        }
+
+        t_model_ports** next = &ports;
+        for (size_t i = 0; i < num_ports; i++) {
+            if (loading_) {
+                *next = new t_model_ports;
+            }
+            t_model_ports& port = **next;
+            io(port.dir);
+            io(port.name);
+            io(port.size);
+            io(port.min_size);
+            io(port.is_clock);
+            io(port.is_non_clock_global);
+            io(port.clock);
+            io(port.combinational_sink_ports);
+            io(port.index);
+            next = &port.next;
+        }
+    }
+
+    /*
+     * Physical tile types
+     */
+
+    void io(t_physical_tile_type& type) {
+        io(type.name);
+        io(type.num_pins);
+        io(type.num_inst_pins);
+        io(type.num_input_pins);
+        io(type.num_output_pins);
+        io(type.num_clock_pins);
+        io(type.clock_pin_indices);
+        io(type.capacity);
+        io(type.width);
+        io(type.height);
+        io(type.pinloc);
+        io(type.class_inf);
+        io(type.primitive_class_starting_idx);
+        io(type.pin_layer_offset);
+        io(type.pin_width_offset);
+        io(type.pin_height_offset);
+        io(type.pin_class);
+        io(type.is_ignored_pin);
+        io(type.is_pin_global);
+        io(type.fc_specs);
+        io(type.switchblock_locations);
+        io(type.switchblock_switch_overrides);
+        io(type.area);
+        io(type.num_drivers);
+        io(type.num_receivers);
+        io(type.index);
+        io(type.sub_tiles);
+        io(type.tile_block_pin_directs_map);
+        io(type.is_input_type);
+        io(type.is_output_type);
+    }
+
+    void io(t_class& class_inf) {
+        io(class_inf.type);
+        io(class_inf.equivalence);
+        io(class_inf.num_pins);
+        io(class_inf.pinlist);
+    }
+
+    void io(t_fc_specification& fc_spec) {
+        io(fc_spec.fc_type);
+        io(fc_spec.fc_value_type);
+        io(fc_spec.fc_value);
+        io(fc_spec.seg_index);
+        io(fc_spec.pins);
+    }
+
+    void io(vtr::bimap<t_logical_pin, t_physical_pin>& pin_map) {
+        size_t size = pin_map.size();
+        io(size);
+        if (loading_) {
+            check_remaining(size);
+            for (size_t i = 0; i < size; i++) {
+                int logical_pin;
+                int physical_pin;
+                io(logical_pin);
+                io(physical_pin);
+                pin_map.insert(t_logical_pin(logical_pin), t_physical_pin(physical_pin));
+            }
+        } else {
+            for (const auto& [logical_pin, physical_pin] : pin_map) {
+                int logical_pin_num = logical_pin.pin;
+                int physical_pin_num = physical_pin.pin;
+                io(logical_pin_num);
+                io(physical_pin_num);
+            }
+        }
+    }
+
+    void io(t_sub_tile& sub_tile) {
+        io(sub_tile.name);
+        io(sub_tile.sub_tile_to_tile_pin_indices);
+        io(sub_tile.ports);
+
+        size_t num_equivalent_sites = sub_tile.equivalent_sites.size();
+        io(num_equivalent_sites);
+        if (loading_) {
+            check_remaining(num_equivalent_sites);
+            sub_tile.equivalent_sites.resize(num_equivalent_sites);
+        }
+        for (t_logical_block_type_ptr& site : sub_tile.equivalent_sites) {
+            int index = loading_ ? -1 : site->index;
+            io(index);
+            if (loading_) {
+                check_index(index, logical_block_types_.size(), "equivalent site");
+                site = &logical_block_types_[index];
+            }
+        }
+
+        io(sub_tile.capacity.low);
+        io(sub_tile.capacity.high);
+        io(sub_tile.class_range.low);
+        io(sub_tile.class_range.high);
+        io(sub_tile.num_phy_pins);
+        io(sub_tile.index);
+    }
+
+    void io(t_physical_tile_port& port) {
+        io(port.name);
+        io(port.type);
+        io(port.is_clock);
+        io(port.is_non_clock_global);
+        io(port.num_pins);
+        io(port.equivalent);
+        io(port.index);
+        io(port.absolute_first_pin_index);
+        io(port.port_index_by_type);
+    }
+
+    /*
+     * Logical block types
+     */
+
+    void io(t_logical_block_type& type) {
+        io(type.name);
+
+        bool has_pb_type = (type.pb_type != nullptr);
+        io(has_pb_type);
+        if (has_pb_type) {
+            if (loading_) {
+                type.pb_type = new t_pb_type;
+            }
+            io_pb_type(*type.pb_type, nullptr);
+        }
+
+        io(type.index);
+
+        size_t num_equivalent_tiles = type.equivalent_tiles.size();
+        io(num_equivalent_tiles);
+        if (loading_) {
+            check_remaining(num_equivalent_tiles);
+            type.equivalent_tiles.resize(num_equivalent_tiles);
+        }
+        for (t_physical_tile_type_ptr& tile : type.equivalent_tiles) {
+            int index = loading_ ? -1 : tile->index;
+            io(index);
+            if (loading_) {
+                check_index(index, physical_tile_types_.size(), "equivalent tile");
+                tile = &physical_tile_types_[index];
+            }
+        }
+    }
+
+    /// @brief Allocates (when loading) an array of count elements, as for the pb_type arrays
+    template<typename T>
+    void io_array_size(T*& array, int& count) {
+        io(count);
+        if (loading_) {
+            check_remaining(std::max(count, 0));
+            array = new T[std::max(count, 0)]();
+        }
+    }
+
+    void io_pb_type(t_pb_type& pb_type, t_mode* parent_mode) {
+        io(pb_type.name);
+        io(pb_type.num_pb);
+        io(pb_type.blif_model);
+        io(pb_type.class_type);
+
+        io_array_size(pb_type.ports, pb_type.num_ports);
+        for (int i = 0; i < pb_type.num_ports; i++) {
+            io_port(pb_type.ports[i], pb_type);
+        }
+
+        io(pb_type.num_clock_pins);
+        io(pb_type.num_input_pins);
+        io(pb_type.num_output_pins);
+        io(pb_type.num_pins);
+        io(pb_type.depth);
+        io(pb_type.annotations);
+        io(pb_type.index_in_logical_block);
+        io_optional(pb_type.pb_type_power);
+        io(pb_type.meta);
+
+        pb_type.parent_mode = parent_mode;
+
+        io(pb_type.num_modes);
+        if (loading_) {
+            check_remaining(std::max(pb_type.num_modes, 0));
+            pb_type.modes = (pb_type.num_modes > 0) ? new t_mode[pb_type.num_modes] : nullptr;
+        }
+        for (int i = 0; i < pb_type.num_modes; i++) {
+            io_mode(pb_type.modes[i], pb_type);
+        }
+    }
+
+    void io_mode(t_mode& mode, t_pb_type& parent_pb_type) {
+        io(mode.name);
+        io(mode.index);
+        io(mode.disable_packing);
+        io_optional(mode.mode_power);
+        io(mode.meta);
+
+        mode.parent_pb_type = &parent_pb_type;
+
+        io_array_size(mode.pb_type_children, mode.num_pb_type_children);
+        for (int i = 0; i < mode.num_pb_type_children; i++) {
+            io_pb_type(mode.pb_type_children[i], &mode);
+        }
+
+        io_array_size(mode.interconnect, mode.num_interconnect);
+        for (int i = 0; i < mode.num_interconnect; i++) {
+            t_interconnect& interconnect = mode.interconnect[i];
+            io(interconnect.type);
+            io(interconnect.name);
+            io(interconnect.input_string);
+            io(interconnect.output_string);
+            io(interconnect.annotations);
+            io(interconnect.infer_annotations);
+            io(interconnect.line_num);
+            io(interconnect.parent_mode_index);
+            io_optional(interconnect.interconnect_power);
+            io(interconnect.meta);
+
+            interconnect.parent_mode = &mode;
+        }
+    }
+
+    /// @brief A pb_type port. The model port is linked by SyncModelsPbTypes() after loading.
+    void io_port(t_port& port, t_pb_type& parent_pb_type) {
+        io(port.name);
+        io(port.type);
+        io(port.is_clock);
+        io(port.is_non_clock_global);
+        io(port.num_pins);
+        io(port.equivalent);
+        io(port.port_class);
+        io(port.index);
+        io(port.port_index_by_type);
+        io(port.absolute_first_pin_index);
+
+        port.parent_pb_type = &parent_pb_type;
+
+        bool has_port_power = (port.port_power != nullptr);
+        io(has_port_power);
+        if (!has_port_power) {
+            return;
+        }
+        if (loading_) {
+            port.port_power = new t_port_power();
+        }
+
+        t_port_power& port_power = *port.port_power;
+        io(port_power.wire_type);
+        io(port_power.wire.C);
+        io(port_power.buffer_type);
+        io(port_power.buffer_size);
+        io(port_power.pin_toggle_initialized);
+        io(port_power.energy_per_toggle);
+        io(port_power.scaled_by_port_pin_idx);
+        io(port_power.reverse_scaled);
+
+        // Scaled by a port of the same pb_type, which may not be loaded yet
+        int scaled_by_port = port_power.scaled_by_port ? (port_power.scaled_by_port - parent_pb_type.ports) : -1;
+        io(scaled_by_port);
+        if (loading_ && scaled_by_port >= 0) {
+            check_index(scaled_by_port, parent_pb_type.num_ports, "scaled_by_port");
+            port_power.scaled_by_port = &parent_pb_type.ports[scaled_by_port];
+        }
+    }
+
+    void io(t_pin_to_pin_annotation& annotation) {
+        io(annotation.annotation_entries);
+        io(annotation.type);
+        io(annotation.format);
+        io(annotation.input_pins);
+        io(annotation.output_pins);
+        io(annotation.clock);
+        io(annotation.line_num);
+    }
+
+    void io(t_power_usage& power_usage) {
+        io(power_usage.dynamic);
+        io(power_usage.leakage);
+    }
+
+    void io(t_pb_type_power& pb_type_power) {
+        io(pb_type_power.estimation_method);
+        io(pb_type_power.absolute_power_per_instance);
+        io(pb_type_power.C_internal);
+        io(pb_type_power.leakage_default_mode);
+        io(pb_type_power.power_usage);
+        io(pb_type_power.power_usage_bufs_wires);
+    }
+
+    void io(t_mode_power& mode_power) {
+        io(mode_power.power_usage);
+    }
+
+    void io(t_interconnect_power& interconnect_power) {
+        io(interconnect_power.power_usage);
+        io(interconnect_power.port_info_initialized);
+        io(interconnect_power.num_input_ports);
+        io(interconnect_power.num_output_ports);
+        io(interconnect_power.num_pins_per_port);
+        io(interconnect_power.transistor_cnt);
+    }
+
+  private:
+    /// @brief Records (or checks, when loading) a value which must match the caller's setup
+    void io_expect(bool value, const char* what) {
+        bool recorded = value;
+        io(recorded);
+        if (loading_ && recorded != value) {
+            archfpga_throw(binary_file_.c_str(), 0,
+                           "Binary architecture file %s the %s, which does not match the current options\n",
+                           recorded ? "has" : "does not have", what);
+        }
+    }
+
+    void read_bytes(void* dest, size_t size) {
+        check_remaining(size);
+        std::memcpy(dest, read_pos_, size);
+        read_pos_ += size;
+    }
+
+    /// @brief Checks that at least size bytes are left, which also bounds the sizes of the containers to load
+    void check_remaining(size_t size) {
+        if (size > size_t(read_end_ - read_pos_)) {
+            archfpga_throw(binary_file_.c_str(), 0,
+                           "Binary architecture file is truncated or corrupted\n");
+        }
+    }
+
+    void check_index(int index, size_t size, const char* what) {
+        if (index < 0 || size_t(index) >= size) {
+            archfpga_throw(binary_file_.c_str(), 0,
+                           "Binary architecture file has an invalid %s index (%d)\n", what, index);
+        }
+    }
+
+    t_arch& arch_;
+    std::vector<t_physical_tile_type>& physical_tile_types_;
+    std::vector<t_logical_block_type>& logical_block_types_;
+
+    bool loading_;
+    std::string binary_file_;
+
+    std::vector<char> buffer_;
+
+    const char* read_pos_ = nullptr;
+    const char* read_end_ = nullptr;
+};
+
+bool binary_arch_file_supported(const t_arch& arch) {
+    return arch.vib_grid_layouts.empty() && arch.vib_infs.empty();
+}
+
+void write_binary_arch_file(const std::string& binary_file,
+                            const t_arch& arch,
+                            const std::vector<t_physical_tile_type>& physical_tile_types,
+                            const std::vector<t_logical_block_type>& logical_block_types) {
+    VTR_ASSERT(binary_arch_file_supported(arch));
+
+    // The archive only reads the data structures when writing
+    ArchBinaryArchive archive(const_cast<t_arch&>(arch),
+                              const_cast<std::vector<t_physical_tile_type>&>(physical_tile_types),
+                              const_cast<std::vector<t_logical_block_type>&>(logical_block_types));
+
+    uint32_t version = BINARY_ARCH_VERSION;
+    archive.io(version);
+    archive.io_architecture();
+
+    std::ofstream file(binary_file, std::ios::binary | std::ios::trunc);
+    file.write(BINARY_ARCH_MAGIC, sizeof(BINARY_ARCH_MAGIC));
+    file.write(archive.buffer().data(), archive.buffer().size());
+    file.close();
+    if (!file) {
+        archfpga_throw(binary_file.c_str(), 0, "Unable to write binary architecture file\n");
+    }
+}
+
+void read_binary_arch_file(const std::string& binary_file,
+                           const char* arch_file,
+                           t_arch* arch,
+                           std::vector<t_physical_tile_type>& physical_tile_types,
+                           std::vector<t_logical_block_type>& logical_block_types) {
+    std::ifstream file(binary_file, std::ios::binary);
+    if (!file) {
+        archfpga_throw(binary_file.c_str(), 0, "Unable to open binary architecture file\n");
+    }
+
+    char magic[sizeof(BINARY_ARCH_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    if (!file || std::memcmp(magic, BINARY_ARCH_MAGIC, sizeof(magic)) != 0) {
+        archfpga_throw(binary_file.c_str(), 0, "Not a binary architecture file\n");
+    }
+
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    ArchBinaryArchive archive(binary_file, data, *arch, physical_tile_types, logical_block_types);
+
+    uint32_t version = 0;
+    archive.io(version);
+    if (version != BINARY_ARCH_VERSION) {
+        archfpga_throw(binary_file.c_str(), 0,
+                       "Binary architecture file has version %u (expected %u)\n",
+                       version, BINARY_ARCH_VERSION);
+    }
+
+    set_arch_file_name(arch_file);
+
+    archive.io_architecture();
+    if (!archive.at_end()) {
+        archfpga_throw(binary_file.c_str(), 0, "Binary architecture file has trailing data\n");
+    }
+
+    // Link the pb_types to the models (and the models to the pb_types)
+    SyncModelsPbTypes(arch, logical_block_types);
+}
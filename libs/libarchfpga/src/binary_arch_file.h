@@ -0,0 +1,54 @@
+#pragma once
+/**
+ * @file
+ * @brief A binary form of the architecture loaded by xml_read_arch(): the t_arch and the
+ *        physical tile and logical block types.
+ *
+ * Loading the binary form skips the XML parsing and the post-processing of xml_read_arch()
+ * (model/pb_type linking, port and pin numbering, pin locations, Fc specifications...), which
+ * dominates the start-up time of large architectures.
+ *
+ * The file records the in-memory data structures as they are after xml_read_arch(), so it is only
+ * valid for the build of VTR which wrote it and for the options the architecture was read with
+ * (timing and power analysis): callers are expected to key the file on those (see the VPR setup cache).
+ * Pointers between the data structures are recorded as indices and rebuilt when loading.
+ *
+ * Only the data filled in by xml_read_arch() is recorded: the pb_graph and the intra-tile pin and
+ * class lookups VPR builds afterwards are built the same way from the loaded architecture.
+ */
+
+#include <string>
+#include <vector>
+
+#include "physical_types.h"
+
+/**
+ * @brief Returns true if the architecture can be written to a binary architecture file.
+ *
+ * Architectures with VIBs (<vib_arch>) are not supported, and are always read from XML.
+ */
+bool binary_arch_file_supported(const t_arch& arch);
+
+/**
+ * @brief Writes the architecture, as loaded by xml_read_arch(), to a binary architecture file.
+ */
+void write_binary_arch_file(const std::string& binary_file,
+                            const t_arch& arch,
+                            const std::vector<t_physical_tile_type>& physical_tile_types,
+                            const std::vector<t_logical_block_type>& logical_block_types);
+
+/**
+ * @brief Loads an architecture written by write_binary_arch_file(), in place of xml_read_arch().
+ *
+ *   @param binary_file The binary architecture file.
+ *   @param arch_file The architecture file the binary file was written from (reported in errors).
+ *   @param arch The architecture to load, initialized as for xml_read_arch() (e.g. power and clocks
+ *               allocated if power analysis is enabled).
+ *   @param physical_tile_types The loaded physical tile types.
+ *   @param logical_block_types The loaded logical block types.
+ */
+void read_binary_arch_file(const std::string& binary_file,
+                           const char* arch_file,
+                           t_arch* arch,
+                           std::vector<t_physical_tile_type>& physical_tile_types,
+                           std::vector<t_logical_block_type>& logical_block_types);
@@ -1851,6 +1851,7 @@ struct t_arch_switch_inf {
     std::map<int, double> Tdel_map_;
 
     friend void PrintArchInfo(FILE*, const t_arch*);
+    friend class ArchBinaryArchive;
 };
 
 /**
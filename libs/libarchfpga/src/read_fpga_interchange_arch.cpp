@@ -10,9 +10,9 @@
 #include "DeviceResources.capnp.h"
 #include "LogicalNetlist.capnp.h"
 #include "capnp/serialize.h"
+#include "serdes_utils.h"
 
 #include <algorithm>
-#include <kj/std/iostream.h>
 #include <limits>
 #include <map>
 #include <regex>
@@ -20,7 +20,6 @@
 #include <cstdlib>
 #include <string>
 #include <cstring>
-#include <zlib.h>
 #include <sstream>
 
 #include "vtr_assert.h"
@@ -2493,39 +2492,15 @@ void FPGAInterchangeReadArch(const char* FPGAInterchangeDeviceFile,
                              std::vector<t_physical_tile_type>& PhysicalTileTypes,
                              std::vector<t_logical_block_type>& LogicalBlockTypes) {
 #ifdef VTR_ENABLE_CAPNPROTO
-    // Decompress GZipped capnproto device file
-    gzFile file = gzopen(FPGAInterchangeDeviceFile, "r");
-    VTR_ASSERT(file != Z_NULL);
-
-    std::vector<uint8_t> output_data;
-    output_data.resize(4096);
-    std::stringstream sstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
-    while (true) {
-        int ret = gzread(file, output_data.data(), output_data.size());
-        VTR_ASSERT(ret >= 0);
-        if (ret > 0) {
-            sstream.write((const char*)output_data.data(), ret);
-            VTR_ASSERT(sstream);
-        } else {
-            VTR_ASSERT(ret == 0);
-            int error;
-            gzerror(file, &error);
-            VTR_ASSERT(error == Z_OK);
-            break;
-        }
-    }
-
-    VTR_ASSERT(gzclose(file) == Z_OK);
-
-    sstream.seekg(0);
-    kj::std::StdInputStream istream(sstream);
+    // Decompress GZipped capnproto device file, to be read in place
+    std::vector<capnp::word> message = readGzippedMessageFile(FPGAInterchangeDeviceFile);
 
     // Reader options
     capnp::ReaderOptions reader_options;
     reader_options.nestingLimit = std::numeric_limits<int>::max();
     reader_options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
 
-    capnp::InputStreamMessageReader message_reader(istream, reader_options);
+    capnp::FlatArrayMessageReader message_reader(kj::arrayPtr(message.data(), message.size()), reader_options);
 
     auto device_reader = message_reader.getRoot<DeviceResources::Device>();
 
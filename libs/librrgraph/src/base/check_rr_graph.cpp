@@ -1,3 +1,10 @@
+#include <atomic>
+
+#ifdef VPR_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif // VPR_USE_TBB
+
 #include "physical_types.h"
 #include "vtr_log.h"
 #include "vtr_util.h"
@@ -18,6 +25,23 @@ static void check_unbuffered_edges(const RRGraphView& rr_graph, int from_node);
 
 static bool has_adjacent_channel(const RRGraphView& rr_graph, const DeviceGrid& grid, const t_rr_node& node);
 
+/**
+ * @brief Checks the RR node and its outgoing edges, and adds its edges to the fan-in counts of their sink nodes.
+ *
+ * Only reads the RR graph (and atomically increments total_edges_to_node), so it can be called for several
+ * nodes in parallel. edges is scratch space.
+ */
+static void check_rr_node_and_edges(const RRGraphView& rr_graph,
+                                    const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
+                                    const DeviceGrid& grid,
+                                    const VibDeviceGrid& vib_grid,
+                                    const t_chan_width& chan_width,
+                                    const e_route_type route_type,
+                                    RRNodeId rr_node,
+                                    bool is_flat,
+                                    std::vector<int>& total_edges_to_node,
+                                    std::vector<std::pair<int, int>>& edges);
+
 static void check_rr_edge(const RRGraphView& rr_graph,
                           const DeviceGrid& grid,
                           const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
@@ -47,178 +71,200 @@ class node_edge_sorter {
     }
 };
 
-void check_rr_graph(const RRGraphView& rr_graph,
-                    const std::vector<t_physical_tile_type>& types,
-                    const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
-                    const DeviceGrid& grid,
-                    const VibDeviceGrid& vib_grid,
-                    const t_chan_width& chan_width,
-                    const e_graph_type graph_type,
-                    bool is_flat) {
-    e_route_type route_type = e_route_type::DETAILED;
-    if (graph_type == e_graph_type::GLOBAL) {
-        route_type = e_route_type::GLOBAL;
-    }
-
-    std::vector<int> total_edges_to_node(rr_graph.num_nodes());
-    std::vector<unsigned char> switch_types_from_current_to_node(rr_graph.num_nodes());
+static void check_rr_node_and_edges(const RRGraphView& rr_graph,
+                                    const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
+                                    const DeviceGrid& grid,
+                                    const VibDeviceGrid& vib_grid,
+                                    const t_chan_width& chan_width,
+                                    const e_route_type route_type,
+                                    RRNodeId rr_node,
+                                    bool is_flat,
+                                    std::vector<int>& total_edges_to_node,
+                                    std::vector<std::pair<int, int>>& edges) {
     const int num_rr_switches = rr_graph.num_rr_switches();
 
-    std::vector<std::pair<int, int>> edges;
-
-    for (const RRNodeId rr_node : rr_graph.nodes()) {
-        size_t inode = (size_t)rr_node;
-        rr_graph.validate_node(rr_node);
-
-        /* Ignore any uninitialized rr_graph nodes */
-        if (!rr_graph.node_is_initialized(rr_node)) {
-            continue;
-        }
-
-        // Virtual clock network sink is special, ignore.
-        if (rr_graph.is_virtual_clock_network_root(rr_node)) {
-            continue;
-        }
+    size_t inode = (size_t)rr_node;
+    rr_graph.validate_node(rr_node);
 
-        e_rr_type rr_type = rr_graph.node_type(rr_node);
-        int num_edges = rr_graph.num_edges(RRNodeId(inode));
+    /* Ignore any uninitialized rr_graph nodes */
+    if (!rr_graph.node_is_initialized(rr_node)) {
+        return;
+    }
 
-        check_rr_node(rr_graph, rr_indexed_data, grid, vib_grid, chan_width, route_type, inode, is_flat);
+    // Virtual clock network sink is special, ignore.
+    if (rr_graph.is_virtual_clock_network_root(rr_node)) {
+        return;
+    }
 
-        // Check all the connectivity (edges, etc.) information.
-        edges.resize(0);
-        edges.reserve(num_edges);
+    e_rr_type rr_type = rr_graph.node_type(rr_node);
+    int num_edges = rr_graph.num_edges(RRNodeId(inode));
 
-        for (int iedge = 0; iedge < num_edges; iedge++) {
-            int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
+    check_rr_node(rr_graph, rr_indexed_data, grid, vib_grid, chan_width, route_type, inode, is_flat);
 
-            if (to_node < 0 || to_node >= (int)rr_graph.num_nodes()) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_rr_graph: node %d has an edge %d.\n"
-                                "\tEdge is out of range.\n",
-                                inode, to_node);
-            }
+    // Check all the connectivity (edges, etc.) information.
+    edges.resize(0);
+    edges.reserve(num_edges);
 
-            check_rr_edge(rr_graph,
-                          grid,
-                          rr_indexed_data,
-                          inode,
-                          iedge,
-                          to_node,
-                          is_flat);
+    for (int iedge = 0; iedge < num_edges; iedge++) {
+        int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
 
-            edges.emplace_back(to_node, iedge);
-            total_edges_to_node[to_node]++;
+        if (to_node < 0 || to_node >= (int)rr_graph.num_nodes()) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_rr_graph: node %d has an edge %d.\n"
+                            "\tEdge is out of range.\n",
+                            inode, to_node);
+        }
 
-            auto switch_type = rr_graph.edge_switch(rr_node, iedge);
+        check_rr_edge(rr_graph,
+                      grid,
+                      rr_indexed_data,
+                      inode,
+                      iedge,
+                      to_node,
+                      is_flat);
 
-            if (switch_type < 0 || switch_type >= num_rr_switches) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_rr_graph: node %d has a switch type %d.\n"
-                                "\tSwitch type is out of range.\n",
-                                inode, switch_type);
-            }
-        } /* End for all edges of node. */
+        edges.emplace_back(to_node, iedge);
+        std::atomic_ref<int>(total_edges_to_node[to_node]).fetch_add(1, std::memory_order_relaxed);
 
-        std::sort(edges.begin(), edges.end(), [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) {
-            return lhs.first < rhs.first;
-        });
+        auto switch_type = rr_graph.edge_switch(rr_node, iedge);
 
-        //Check that multiple edges between the same from/to nodes make sense
-        for (int iedge = 0; iedge < num_edges; iedge++) {
-            int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
+        if (switch_type < 0 || switch_type >= num_rr_switches) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_rr_graph: node %d has a switch type %d.\n"
+                            "\tSwitch type is out of range.\n",
+                            inode, switch_type);
+        }
+    } /* End for all edges of node. */
 
-            auto range = std::equal_range(edges.begin(), edges.end(),
-                                          to_node, node_edge_sorter());
+    std::sort(edges.begin(), edges.end(), [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    //Check that multiple edges between the same from/to nodes make sense
+    for (int iedge = 0; iedge < num_edges; iedge++) {
+        int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
+
+        auto range = std::equal_range(edges.begin(), edges.end(),
+                                      to_node, node_edge_sorter());
+
+        size_t num_edges_to_node = std::distance(range.first, range.second);
+
+        if (num_edges_to_node == 1) continue; //Single edges are always OK
+
+        VTR_ASSERT_MSG(num_edges_to_node > 1, "Expect multiple edges");
+
+        e_rr_type to_rr_type = rr_graph.node_type(RRNodeId(to_node));
+
+        /* It is unusual to have more than one programmable switch (in the same direction) between a from_node and a to_node,
+         * as the duplicate switch doesn't add more routing flexibility.
+         *
+         * However, such duplicate switches can occur for some types of nodes, which we allow below.
+         * Reasons one could have duplicate switches between two nodes include:
+         *      - The two switches have different electrical characteristics.
+         *      - Wires near the edges of an FPGA are often cut off, and the stubs connected together.
+         *        A regular switch pattern could then result in one physical wire connecting multiple
+         *        times to other wires, IPINs or OPINs.
+         *
+         * Only expect the following cases to have multiple edges
+         * - CHAN <-> CHAN connections
+         * - CHAN  -> IPIN connections (unique rr_node for IPIN nodes on multiple sides)
+         * - OPIN  -> CHAN connections (unique rr_node for OPIN nodes on multiple sides)
+         */
+        bool is_chan_to_chan = (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY) && (to_rr_type == e_rr_type::CHANY || to_rr_type == e_rr_type::CHANX);
+        bool is_chan_to_ipin = (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY) && to_rr_type == e_rr_type::IPIN;
+        bool is_opin_to_chan = rr_type == e_rr_type::OPIN && (to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY);
+        bool is_internal_edge = false;
+        if (is_flat) {
+            is_internal_edge = (rr_type == e_rr_type::IPIN && to_rr_type == e_rr_type::IPIN) || (rr_type == e_rr_type::OPIN && to_rr_type == e_rr_type::OPIN);
+        }
+        if (!(is_chan_to_chan || is_chan_to_ipin || is_opin_to_chan || is_internal_edge)) {
+            VPR_ERROR(VPR_ERROR_ROUTE,
+                      "in check_rr_graph: node %d (%s) connects to node %d (%s) %zu times - multi-connections only expected for CHAN<->CHAN, CHAN->IPIN, OPIN->CHAN.\n",
+                      inode, rr_node_typename[rr_type], to_node, rr_node_typename[to_rr_type], num_edges_to_node);
+        }
 
-            size_t num_edges_to_node = std::distance(range.first, range.second);
+        // Between two wire segments
+        VTR_ASSERT_MSG(to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY || to_rr_type == e_rr_type::IPIN, "Expect channel type or input pin type");
+        VTR_ASSERT_MSG(rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY || rr_type == e_rr_type::OPIN, "Expect channel type or output pin type");
 
-            if (num_edges_to_node == 1) continue; //Single edges are always OK
+        //While multiple connections between the same wires can be electrically legal,
+        //they are redundant if they are of the same switch type.
+        //
+        //Identify any such edges with identical switches
+        std::map<short, int> switch_counts;
+        for (const auto& to_edge : vtr::Range<std::vector<std::pair<int, int>>::const_iterator>(range.first, range.second)) {
+            auto edge = to_edge.second;
+            auto edge_switch = rr_graph.edge_switch(rr_node, edge);
 
-            VTR_ASSERT_MSG(num_edges_to_node > 1, "Expect multiple edges");
+            switch_counts[edge_switch]++;
+        }
 
-            e_rr_type to_rr_type = rr_graph.node_type(RRNodeId(to_node));
+        //Tell the user about any redundant edges
+        for (auto kv : switch_counts) {
+            if (kv.second <= 1) continue;
 
-            /* It is unusual to have more than one programmable switch (in the same direction) between a from_node and a to_node,
-             * as the duplicate switch doesn't add more routing flexibility.
-             *
-             * However, such duplicate switches can occur for some types of nodes, which we allow below.
-             * Reasons one could have duplicate switches between two nodes include:
-             *      - The two switches have different electrical characteristics.
-             *      - Wires near the edges of an FPGA are often cut off, and the stubs connected together.
-             *        A regular switch pattern could then result in one physical wire connecting multiple
-             *        times to other wires, IPINs or OPINs.
-             *
-             * Only expect the following cases to have multiple edges
-             * - CHAN <-> CHAN connections
-             * - CHAN  -> IPIN connections (unique rr_node for IPIN nodes on multiple sides)
-             * - OPIN  -> CHAN connections (unique rr_node for OPIN nodes on multiple sides)
+            /* Redundant edges are not allowed for chan <-> chan connections
+             * but allowed for input pin <-> chan or output pin <-> chan connections 
              */
-            bool is_chan_to_chan = (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY) && (to_rr_type == e_rr_type::CHANY || to_rr_type == e_rr_type::CHANX);
-            bool is_chan_to_ipin = (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY) && to_rr_type == e_rr_type::IPIN;
-            bool is_opin_to_chan = rr_type == e_rr_type::OPIN && (to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY);
-            bool is_internal_edge = false;
-            if (is_flat) {
-                is_internal_edge = (rr_type == e_rr_type::IPIN && to_rr_type == e_rr_type::IPIN) || (rr_type == e_rr_type::OPIN && to_rr_type == e_rr_type::OPIN);
-            }
-            if (!(is_chan_to_chan || is_chan_to_ipin || is_opin_to_chan || is_internal_edge)) {
-                VPR_ERROR(VPR_ERROR_ROUTE,
-                          "in check_rr_graph: node %d (%s) connects to node %d (%s) %zu times - multi-connections only expected for CHAN<->CHAN, CHAN->IPIN, OPIN->CHAN.\n",
-                          inode, rr_node_typename[rr_type], to_node, rr_node_typename[to_rr_type], num_edges_to_node);
-            }
-
-            // Between two wire segments
-            VTR_ASSERT_MSG(to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY || to_rr_type == e_rr_type::IPIN, "Expect channel type or input pin type");
-            VTR_ASSERT_MSG(rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY || rr_type == e_rr_type::OPIN, "Expect channel type or output pin type");
+            if ((to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY)
+                && (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY)) {
+                e_switch_type switch_type = rr_graph.rr_switch_inf(RRSwitchId(kv.first)).type();
 
-            //While multiple connections between the same wires can be electrically legal,
-            //they are redundant if they are of the same switch type.
-            //
-            //Identify any such edges with identical switches
-            std::map<short, int> switch_counts;
-            for (const auto& to_edge : vtr::Range<decltype(edges)::const_iterator>(range.first, range.second)) {
-                auto edge = to_edge.second;
-                auto edge_switch = rr_graph.edge_switch(rr_node, edge);
-
-                switch_counts[edge_switch]++;
+                VPR_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d has %d redundant connections to node %d of switch type %d (%s)",
+                          inode, kv.second, to_node, kv.first, SWITCH_TYPE_STRINGS[size_t(switch_type)]);
             }
+        }
+    }
 
-            //Tell the user about any redundant edges
-            for (auto kv : switch_counts) {
-                if (kv.second <= 1) continue;
+    /* Slow test could leave commented out most of the time. */
+    check_unbuffered_edges(rr_graph, inode);
 
-                /* Redundant edges are not allowed for chan <-> chan connections
-                 * but allowed for input pin <-> chan or output pin <-> chan connections 
-                 */
-                if ((to_rr_type == e_rr_type::CHANX || to_rr_type == e_rr_type::CHANY)
-                    && (rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY)) {
-                    e_switch_type switch_type = rr_graph.rr_switch_inf(RRSwitchId(kv.first)).type();
+    //Check that all config/non-config edges are appropriately organized
+    for (t_edge_size edge : rr_graph.configurable_edges(RRNodeId(inode))) {
+        if (!rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is non-configurable, but in configurable edges",
+                            inode, edge);
+        }
+    }
 
-                    VPR_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d has %d redundant connections to node %d of switch type %d (%s)",
-                              inode, kv.second, to_node, kv.first, SWITCH_TYPE_STRINGS[size_t(switch_type)]);
-                }
-            }
+    for (t_edge_size edge : rr_graph.non_configurable_edges(RRNodeId(inode))) {
+        if (rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is configurable, but in non-configurable edges",
+                            inode, edge);
         }
+    }
+}
 
-        /* Slow test could leave commented out most of the time. */
-        check_unbuffered_edges(rr_graph, inode);
+void check_rr_graph(const RRGraphView& rr_graph,
+                    const std::vector<t_physical_tile_type>& types,
+                    const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
+                    const DeviceGrid& grid,
+                    const VibDeviceGrid& vib_grid,
+                    const t_chan_width& chan_width,
+                    const e_graph_type graph_type,
+                    bool is_flat) {
+    e_route_type route_type = e_route_type::DETAILED;
+    if (graph_type == e_graph_type::GLOBAL) {
+        route_type = e_route_type::GLOBAL;
+    }
 
-        //Check that all config/non-config edges are appropriately organized
-        for (t_edge_size edge : rr_graph.configurable_edges(RRNodeId(inode))) {
-            if (!rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is non-configurable, but in configurable edges",
-                                inode, edge);
-            }
-        }
+    std::vector<int> total_edges_to_node(rr_graph.num_nodes());
 
-        for (t_edge_size edge : rr_graph.non_configurable_edges(RRNodeId(inode))) {
-            if (rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is configurable, but in non-configurable edges",
-                                inode, edge);
-            }
+    // The nodes are checked in parallel: the checks only read the RR graph, and the fan-in
+    // counts are incremented atomically. The first error found stops the check.
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, rr_graph.num_nodes()), [&](const tbb::blocked_range<size_t>& node_range) {
+        std::vector<std::pair<int, int>> edges;
+        for (size_t inode = node_range.begin(); inode != node_range.end(); ++inode) {
+            check_rr_node_and_edges(rr_graph, rr_indexed_data, grid, vib_grid, chan_width, route_type, RRNodeId(inode), is_flat, total_edges_to_node, edges);
         }
-
-    } /* End for all rr_nodes */
+    });
+#else
+    std::vector<std::pair<int, int>> edges;
+    for (const RRNodeId rr_node : rr_graph.nodes()) {
+        check_rr_node_and_edges(rr_graph, rr_indexed_data, grid, vib_grid, chan_width, route_type, rr_node, is_flat, total_edges_to_node, edges);
+    }
+#endif // VPR_USE_TBB
 
     // AM: For the time being, if is_flat is enabled, we don't have proper tests to check whether a node should have an incoming
     // edge or not
@@ -3,6 +3,7 @@
 #include "rr_graph_builder.h"
 #include "vtr_time.h"
 #include "vtr_util.h"
+#include <algorithm>
 #include <queue>
 #include <random>
 
@@ -112,12 +113,75 @@ void RRGraphBuilder::clear() {
     is_incoming_edge_dirty_ = true;
 }
 
+size_t RRGraphBuilder::memory_used() const {
+    size_t bytes = node_storage_.memory_used() + node_lookup_.memory_used();
+    bytes += node_in_edges_.capacity() * sizeof(std::vector<RREdgeId>);
+    for (const std::vector<RREdgeId>& in_edges : node_in_edges_) {
+        bytes += in_edges.capacity() * sizeof(RREdgeId);
+    }
+    bytes += node_tilable_track_nums_.capacity() * sizeof(std::vector<short>);
+    for (const std::vector<short>& track_nums : node_tilable_track_nums_) {
+        bytes += track_nums.capacity() * sizeof(short);
+    }
+    bytes += edges_to_build_.capacity() * sizeof(t_rr_edge_info);
+    return bytes;
+}
+
+/** Position of (x, y) along a Hilbert curve filling an n x n square. n must be a power of 2 */
+static uint64_t hilbert_curve_index(uint32_t n, uint32_t x, uint32_t y) {
+    uint64_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += uint64_t(s) * s * ((3 * rx) ^ ry);
+        // Rotate the quadrant so the curve stays continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/** Edge-target locality of an rr_graph: statistics of |sink - source| over all edges */
+struct t_edge_locality {
+    double avg_span = 0.;
+    /* Fraction of edges whose sink is within 256 nodes (4 KiB of t_rr_node_data) of the source */
+    double near_frac = 0.;
+};
+
+static t_edge_locality compute_edge_locality(const t_rr_graph_storage& node_storage) {
+    constexpr size_t NEAR_SPAN = 256;
+    t_edge_locality out;
+    size_t num_edges = 0, num_near = 0;
+    double total_span = 0.;
+    for (size_t i = 0; i < node_storage.size(); ++i) {
+        RRNodeId u(i);
+        for (RREdgeId edge = node_storage.first_edge(u); edge < node_storage.last_edge(u); edge = RREdgeId(size_t(edge) + 1)) {
+            size_t v = size_t(node_storage.edge_sink_node(edge));
+            size_t span = v > i ? v - i : i - v;
+            total_span += span;
+            num_near += span <= NEAR_SPAN;
+            num_edges++;
+        }
+    }
+    if (num_edges > 0) {
+        out.avg_span = total_span / num_edges;
+        out.near_frac = double(num_near) / num_edges;
+    }
+    return out;
+}
+
 void RRGraphBuilder::reorder_nodes(e_rr_node_reorder_algorithm reorder_rr_graph_nodes_algorithm,
                                    int reorder_rr_graph_nodes_threshold,
                                    int reorder_rr_graph_nodes_seed) {
     size_t v_num = node_storage_.size();
     if (reorder_rr_graph_nodes_threshold < 0 || v_num < (size_t)reorder_rr_graph_nodes_threshold) return;
     vtr::ScopedStartFinishTimer timer("Reordering rr_graph nodes");
+    t_edge_locality locality_before = compute_edge_locality(node_storage_);
     vtr::vector<RRNodeId, RRNodeId> src_order(v_num); // new id -> old id
     size_t cur_idx = 0;
     for (RRNodeId& n : src_order) { // Initialize to [0, 1, 2 ...]
@@ -162,6 +226,75 @@ void RRGraphBuilder::reorder_nodes(e_rr_node_reorder_algorithm reorder_rr_graph_
     } else if (reorder_rr_graph_nodes_algorithm == RANDOM_SHUFFLE) {
         std::mt19937 g(reorder_rr_graph_nodes_seed);
         std::shuffle(src_order.begin(), src_order.end(), g);
+    } else if (reorder_rr_graph_nodes_algorithm == HILBERT_CURVE) {
+        // Use doubled coordinates, so that the center of a node spanning several tiles stays integral
+        uint32_t max_coord = 1;
+        for (RRNodeId u : src_order) {
+            max_coord = std::max<uint32_t>(max_coord, node_storage_.node_xhigh(u) + node_storage_.node_xlow(u));
+            max_coord = std::max<uint32_t>(max_coord, node_storage_.node_yhigh(u) + node_storage_.node_ylow(u));
+        }
+        uint32_t n = 1;
+        while (n <= max_coord)
+            n *= 2;
+
+        vtr::vector<RRNodeId, uint64_t> curve_idx(v_num);
+        for (RRNodeId u : src_order) {
+            uint32_t x = std::max(0, node_storage_.node_xlow(u) + node_storage_.node_xhigh(u));
+            uint32_t y = std::max(0, node_storage_.node_ylow(u) + node_storage_.node_yhigh(u));
+            curve_idx[u] = hilbert_curve_index(n, x, y);
+        }
+
+        // Nodes at the same position keep their original (builder) order
+        std::stable_sort(src_order.begin(), src_order.end(),
+                         [&](RRNodeId a, RRNodeId b) -> bool {
+                             short layer_a = node_storage_.node_layer_low(a);
+                             short layer_b = node_storage_.node_layer_low(b);
+                             return layer_a < layer_b || (layer_a == layer_b && curve_idx[a] < curve_idx[b]);
+                         });
+    } else if (reorder_rr_graph_nodes_algorithm == REVERSE_CUTHILL_MCKEE) {
+        vtr::vector<RRNodeId, size_t> degree(v_num);
+        for (size_t i = 0; i < v_num; ++i) {
+            RRNodeId u(i);
+            degree[u] += node_storage_.num_edges(u);
+            for (RREdgeId edge = node_storage_.first_edge(u); edge < node_storage_.last_edge(u); edge = RREdgeId(size_t(edge) + 1)) {
+                degree[node_storage_.edge_sink_node(edge)]++;
+            }
+        }
+        auto by_degree = [&](RRNodeId a, RRNodeId b) -> bool {
+            return degree[a] < degree[b];
+        };
+
+        // Start a new BFS from the lowest degree unvisited node for each connected component
+        std::vector<RRNodeId> start_nodes(src_order.begin(), src_order.end());
+        std::stable_sort(start_nodes.begin(), start_nodes.end(), by_degree);
+
+        vtr::vector<RRNodeId, bool> visited(v_num, false);
+        std::vector<RRNodeId> order;
+        std::vector<RRNodeId> neighbours;
+        std::queue<RRNodeId> que;
+        order.reserve(v_num);
+        for (RRNodeId start : start_nodes) {
+            if (visited[start]) continue;
+            visited[start] = true;
+            que.push(start);
+            while (!que.empty()) {
+                RRNodeId u = que.front();
+                que.pop();
+                order.push_back(u);
+                neighbours.clear();
+                for (RREdgeId edge = node_storage_.first_edge(u); edge < node_storage_.last_edge(u); edge = RREdgeId(size_t(edge) + 1)) {
+                    RRNodeId v = node_storage_.edge_sink_node(edge);
+                    if (visited[v]) continue;
+                    visited[v] = true;
+                    neighbours.push_back(v);
+                }
+                std::stable_sort(neighbours.begin(), neighbours.end(), by_degree);
+                for (RRNodeId v : neighbours)
+                    que.push(v);
+            }
+        }
+        VTR_ASSERT(order.size() == v_num);
+        std::copy(order.rbegin(), order.rend(), src_order.begin());
     }
     vtr::vector<RRNodeId, RRNodeId> dest_order(v_num);
     cur_idx = 0;
@@ -180,6 +313,11 @@ void RRGraphBuilder::reorder_nodes(e_rr_node_reorder_algorithm reorder_rr_graph_
                                size_t(dest_order[RRNodeId(std::get<1>(edge))]),
                                std::get<2>(edge));
     });
+
+    t_edge_locality locality_after = compute_edge_locality(node_storage_);
+    VTR_LOG("RR graph edge-target locality: average span %.1f -> %.1f nodes, %.1f%% -> %.1f%% of edges within 256 nodes\n",
+            locality_before.avg_span, locality_after.avg_span,
+            100. * locality_before.near_frac, 100. * locality_after.near_frac);
 }
 
 void RRGraphBuilder::create_edge_in_cache(RRNodeId src, RRNodeId dest, RRSwitchId edge_switch, bool remapped) {
@@ -164,6 +164,10 @@ class RRGraphBuilder {
 
     /** @brief Clear all the underlying data storage */
     void clear();
+
+    /** @brief Memory used by the nodes, edges and look-ups of the graph, in bytes (excluding the metadata) */
+    size_t memory_used() const;
+
     /** @brief reorder all the nodes
      * Reordering the rr-graph nodes may be helpful in
      *   - Increasing cache locality during routing
@@ -171,6 +175,10 @@ class RRGraphBuilder {
      * Reorder RRNodeId's using one of these algorithms:
      *   - DEGREE_BFS: Order by degree primarily, and BFS traversal order secondarily.
      *   - RANDOM_SHUFFLE: Shuffle using the specified seed. Great for testing.
+     *   - HILBERT_CURVE: Order by layer, then by the position of the node's center along a
+     *     Hilbert curve covering the device. Nodes close on the chip end up close in memory.
+     *   - REVERSE_CUTHILL_MCKEE: BFS visiting neighbours in increasing degree order, reversed.
+     *     Keeps edge targets close to their sources (bandwidth reduction).
      * The DEGREE_BFS algorithm was selected because it had the best performance of seven
      * existing algorithms here: https://github.com/SymbiFlow/vtr-rrgraph-reordering-tool
      * It might be worth further research, as the DEGREE_BFS algorithm is simple and
@@ -181,6 +189,9 @@ class RRGraphBuilder {
      * in the rr-graph before routing we check that no code depends on the rr-graph node order
      * Nonetheless, it does improve performance ~7% for the SymbiFlow Xilinx Artix 7 graph.
      *
+     * The edge-target locality (average node ID distance between an edge's source and sink)
+     * is logged before and after reordering, to help picking an algorithm per architecture.
+     *
      * NOTE: Re-ordering will invalidate any references to rr_graph nodes, so this
      *       should generally be called before creating such references.
      */
@@ -456,6 +467,16 @@ class RRGraphBuilder {
         node_storage_.init_fan_in();
     }
 
+    /** @brief Build the reverse (incoming) edge index of every node. See t_rr_graph_storage::init_reverse_edges() */
+    inline void init_reverse_edges() {
+        node_storage_.init_reverse_edges();
+    }
+
+    /** @brief Drop the per-edge source node array to save memory. See t_rr_graph_storage::compress_edges() */
+    inline void compress_edges() {
+        node_storage_.compress_edges();
+    }
+
     /** @brief Disable the flags which would prevent adding adding extra-resources, when flat-routing
      * is enabled, to the RR Graph
      * @note
@@ -463,6 +484,8 @@ class RRGraphBuilder {
      * are already added. This function disables the flags which would prevent adding extra-resources to the RR Graph
      */
     inline void reset_rr_graph_flags() {
+        // Edge sources are needed to re-partition the edges once new ones are added
+        node_storage_.decompress_edges();
         node_storage_.edges_read_ = false;
         node_storage_.partitioned_ = false;
         node_storage_.remapped_edges_ = false;
@@ -59,6 +59,7 @@ void t_rr_graph_storage::alloc_and_load_edges(const t_rr_edge_info_set* rr_edges
 
 void t_rr_graph_storage::assign_first_edges() {
     VTR_ASSERT(node_first_edge_.empty());
+    clear_reverse_edges();
 
     // Last element is a dummy element
     node_first_edge_.resize(node_storage_.size() + 1);
@@ -107,12 +108,17 @@ void t_rr_graph_storage::assign_first_edges() {
 }
 
 bool t_rr_graph_storage::verify_first_edges() const {
-    size_t num_edges = edge_src_node_.size();
+    size_t num_edges = edge_dest_node_.size();
     VTR_ASSERT_MSG(node_first_edge_[RRNodeId(node_storage_.size())] == RREdgeId(num_edges), 
                 vtr::string_fmt("node first edge is '%lu' while expected edge id is '%lu'\n", 
                 size_t(node_first_edge_[RRNodeId(node_storage_.size())]), 
                 num_edges).c_str());
 
+    // Compressed edges don't store their sources: they're defined by node_first_edge_
+    if (edges_compressed_) {
+        return true;
+    }
+
     // Each edge should belong with the edge range defined by
     // [node_first_edge_[src_node], node_first_edge_[src_node+1]).
     for (size_t iedge = 0; iedge < num_edges; ++iedge) {
@@ -126,6 +132,76 @@ bool t_rr_graph_storage::verify_first_edges() const {
     return true;
 }
 
+size_t t_rr_graph_storage::memory_used() const {
+    size_t bytes = node_storage_.capacity() * sizeof(t_rr_node_data);
+    bytes += node_ptc_.capacity() * sizeof(t_rr_node_ptc_data);
+    bytes += node_first_edge_.capacity() * sizeof(RREdgeId);
+    bytes += node_fan_in_.capacity() * sizeof(t_edge_size);
+    bytes += node_layer_.capacity() * sizeof(std::pair<char, char>);
+    bytes += (node_bend_start_.capacity() + node_bend_end_.capacity()) * sizeof(int16_t);
+    bytes += (edge_src_node_.capacity() + edge_dest_node_.capacity()) * sizeof(RRNodeId);
+    bytes += edge_switch_.capacity() * sizeof(short);
+    bytes += edge_remapped_.capacity() / 8;
+    bytes += node_first_reverse_edge_.capacity() * sizeof(uint32_t) + reverse_edges_.capacity() * sizeof(RREdgeId);
+    bytes += reverse_edge_src_nodes_.capacity() * sizeof(RRNodeId);
+    // Hash map entries also hold a next pointer and the cached hash
+    for (const auto& [node, name] : node_name_) {
+        bytes += sizeof(std::pair<const RRNodeId, std::string>) + 2 * sizeof(void*) + name.capacity();
+    }
+    return bytes;
+}
+
+void t_rr_graph_storage::compress_edges() {
+    VTR_ASSERT(partitioned_);
+    if (edges_compressed_) {
+        return;
+    }
+    edge_src_node_.clear();
+    edge_src_node_.shrink_to_fit();
+    edges_compressed_ = true;
+}
+
+void t_rr_graph_storage::decompress_edges() {
+    if (!edges_compressed_) {
+        return;
+    }
+    VTR_ASSERT(!node_first_edge_.empty());
+    edge_src_node_.resize(edge_dest_node_.size());
+    for (size_t inode = 0; inode < node_storage_.size(); ++inode) {
+        RRNodeId node(inode);
+        for (RREdgeId edge : edge_range(node)) {
+            edge_src_node_[edge] = node;
+        }
+    }
+    edges_compressed_ = false;
+}
+
+void t_rr_graph_storage::init_reverse_edges() {
+    VTR_ASSERT(partitioned_);
+    edges_read_ = true;
+
+    // Counting sort of the edges by sink node. Within a sink, edges keep their (source node) order.
+    node_first_reverse_edge_.clear();
+    node_first_reverse_edge_.resize(node_storage_.size() + 1, 0);
+    for (RRNodeId sink_node : edge_dest_node_) {
+        node_first_reverse_edge_[RRNodeId(size_t(sink_node) + 1)]++;
+    }
+    std::partial_sum(node_first_reverse_edge_.begin(), node_first_reverse_edge_.end(), node_first_reverse_edge_.begin());
+
+    // Walk the edges through the per-node ranges, so their sources are known even if edges are compressed
+    std::vector<uint32_t> next_reverse_edge(node_first_reverse_edge_.begin(), node_first_reverse_edge_.end() - 1);
+    reverse_edges_.resize(edge_dest_node_.size());
+    reverse_edge_src_nodes_.resize(edge_dest_node_.size());
+    for (size_t inode = 0; inode < node_storage_.size(); inode++) {
+        RRNodeId src_node(inode);
+        for (RREdgeId edge : edge_range(src_node)) {
+            uint32_t ireverse_edge = next_reverse_edge[size_t(edge_dest_node_[edge])]++;
+            reverse_edges_[ireverse_edge] = edge;
+            reverse_edge_src_nodes_[ireverse_edge] = src_node;
+        }
+    }
+}
+
 void t_rr_graph_storage::init_fan_in() {
     //Reset all fan-ins to zero
     edges_read_ = true;
@@ -230,7 +306,7 @@ void t_rr_graph_storage::remap_rr_node_switch_indices(const t_arch_switch_fanin&
     edges_read_ = true;
 
     VTR_ASSERT(!remapped_edges_);
-    for (size_t i = 0; i < edge_src_node_.size(); ++i) {
+    for (size_t i = 0; i < edge_dest_node_.size(); ++i) {
         RREdgeId edge(i);
         if (edge_remapped_[edge]) {
             continue;
@@ -637,7 +713,10 @@ t_rr_graph_view t_rr_graph_storage::view() const {
         vtr::make_const_array_view_id(edge_switch_),
         virtual_clock_network_root_idx_,
         vtr::make_const_array_view_id(node_bend_start_),
-        vtr::make_const_array_view_id(node_bend_end_));
+        vtr::make_const_array_view_id(node_bend_end_),
+        vtr::make_const_array_view_id(node_first_reverse_edge_),
+        vtr::array_view<const RREdgeId>(reverse_edges_.data(), reverse_edges_.size()),
+        vtr::array_view<const RRNodeId>(reverse_edge_src_nodes_.data(), reverse_edge_src_nodes_.size()));
 }
 
 // Given `order`, a vector mapping each RRNodeId to a new one (old -> new),
@@ -657,6 +736,7 @@ t_rr_graph_view t_rr_graph_storage::view() const {
 void t_rr_graph_storage::reorder(const vtr::vector<RRNodeId, RRNodeId>& order,
                                  const vtr::vector<RRNodeId, RRNodeId>& inverse_order) {
     VTR_ASSERT(order.size() == inverse_order.size());
+    clear_reverse_edges();
     {
         auto old_node_storage = node_storage_;
 
@@ -682,7 +762,9 @@ void t_rr_graph_storage::reorder(const vtr::vector<RRNodeId, RRNodeId>& order,
             for (RREdgeId e = old_node_first_edge[n];
                  e < old_node_first_edge[RRNodeId(size_t(n) + 1)];
                  e = RREdgeId(size_t(e) + 1)) {
-                edge_src_node_[cur_edge] = order[old_edge_src_node[e]]; // == n?
+                if (!edges_compressed_) {
+                    edge_src_node_[cur_edge] = order[old_edge_src_node[e]]; // == n?
+                }
                 edge_dest_node_[cur_edge] = order[old_edge_dest_node[e]];
                 edge_switch_[cur_edge] = old_edge_switch[e];
                 edge_remapped_[cur_edge] = old_edge_remapped[e];
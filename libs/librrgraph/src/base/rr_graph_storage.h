@@ -431,6 +431,9 @@ class t_rr_graph_storage {
      */
     RRNodeId edge_src_node(const RREdgeId edge) const {
         VTR_ASSERT_DEBUG(edge.is_valid());
+        if (edges_compressed_) {
+            return find_edge_src_node(edge);
+        }
         return edge_src_node_[edge];
     }
 
@@ -446,19 +449,91 @@ class t_rr_graph_storage {
      * @brief Get the source node for the specified edge. 
      */
     RRNodeId edge_source_node(const RREdgeId edge) const {
-        return edge_src_node_[edge];
+        return edge_src_node(edge);
     }
 
     /** 
      * @brief Call the `apply` function with the edge id, source, and sink nodes of every edge. 
      */
     void for_each_edge(std::function<void(RREdgeId, RRNodeId, RRNodeId)> apply) const {
+        if (edges_compressed_) {
+            // Edges are sorted by source node: walk the per-node edge ranges
+            for (size_t inode = 0; inode < node_storage_.size(); inode++) {
+                RRNodeId node(inode);
+                for (RREdgeId edge : edge_range(node)) {
+                    apply(edge, node, edge_dest_node_[edge]);
+                }
+            }
+            return;
+        }
         for (size_t i = 0; i < edge_dest_node_.size(); i++) {
             RREdgeId edge(i);
             apply(edge, edge_src_node_[edge], edge_dest_node_[edge]);
         }
     }
 
+    /** @brief Drop the per-edge source node array.
+     *
+     * Once edges are partitioned, they are sorted by source node, so the source of an
+     * edge can be found from node_first_edge_ with a binary search. This saves 4 bytes
+     * per edge (roughly 40% of the edge storage), which matters for large flat routing
+     * graphs. In exchange, edge_src_node() becomes O(log N) instead of O(1). The router's
+     * path search only looks up edge sinks, so it is not affected.
+     *
+     * Only call this after partition_edges(). decompress_edges() is called automatically
+     * by RRGraphBuilder before edges are added again (see reset_rr_graph_flags()).
+     */
+    void compress_edges();
+
+    /** @brief Rebuild the per-edge source node array dropped by compress_edges(). No-op if edges are not compressed. */
+    void decompress_edges();
+
+    /** @brief Has compress_edges() been called (and not undone)? */
+    bool edges_compressed() const {
+        return edges_compressed_;
+    }
+
+    /** @brief Build the reverse edge index: the incoming edges of every node, grouped by sink node.
+     *
+     * The index is stored like the (forward) edges, as arrays of edge ids and edge source nodes sorted
+     * by sink node, plus the offset of the first incoming edge of every node, so searches walking the
+     * RR graph backwards (e.g. from a sink towards the sources) get the same contiguous access as the
+     * forward ones, even when the edges are compressed. It costs 8 bytes per edge and 4 bytes per node,
+     * so it is only built on request.
+     *
+     * Only call this after partition_edges(). Any later change to the edges (or node order) clears it.
+     */
+    void init_reverse_edges();
+
+    /** @brief Free the reverse edge index built by init_reverse_edges() */
+    void clear_reverse_edges() {
+        node_first_reverse_edge_.clear();
+        node_first_reverse_edge_.shrink_to_fit();
+        reverse_edges_.clear();
+        reverse_edges_.shrink_to_fit();
+        reverse_edge_src_nodes_.clear();
+        reverse_edge_src_nodes_.shrink_to_fit();
+    }
+
+    /** @brief Has the reverse edge index been built? */
+    bool has_reverse_edges() const {
+        return !node_first_reverse_edge_.empty();
+    }
+
+    /** @brief The incoming edges of the node (i.e. the edges whose sink is id). init_reverse_edges() must have been called first. */
+    vtr::array_view<const RREdgeId> reverse_edges(const RRNodeId id) const {
+        uint32_t first = node_first_reverse_edge_[id];
+        uint32_t last = (&node_first_reverse_edge_[id])[1];
+        return vtr::array_view<const RREdgeId>(reverse_edges_.data() + first, last - first);
+    }
+
+    /** @brief The source nodes of the incoming edges of the node, in the order of reverse_edges(id). */
+    vtr::array_view<const RRNodeId> reverse_edge_src_nodes(const RRNodeId id) const {
+        uint32_t first = node_first_reverse_edge_[id];
+        uint32_t last = (&node_first_reverse_edge_[id])[1];
+        return vtr::array_view<const RRNodeId>(reverse_edge_src_nodes_.data() + first, last - first);
+    }
+
     /** 
      * @brief Get the destination node for the iedge'th edge from specified RRNodeId.
      *
@@ -595,6 +670,9 @@ class t_rr_graph_storage {
         return node_storage_.empty();
     }
 
+    /** @brief Memory used by the nodes and edges, in bytes. */
+    size_t memory_used() const;
+
     /** @brief Remove all nodes and edges from the RR graph.
      * This method re-enables graph mutation if the graph was read-only.
      */
@@ -612,9 +690,11 @@ class t_rr_graph_storage {
         edge_dest_node_.clear();
         edge_switch_.clear();
         edge_remapped_.clear();
+        clear_reverse_edges();
         edges_read_ = false;
         partitioned_ = false;
         remapped_edges_ = false;
+        edges_compressed_ = false;
         is_tileable_ = false;
     }
 
@@ -831,8 +911,17 @@ class t_rr_graph_storage {
     template <typename t_comp_func>
     void sort_edges(t_comp_func comparison_function) {
 
+        VTR_ASSERT(!edges_compressed_);
         size_t num_edges = edge_src_node_.size();
         vtr::StrongIdRange<RREdgeId> edge_range(RREdgeId(0), RREdgeId(num_edges));
+
+        // Edges read from an rr_graph file written by VPR are already in the requested order,
+        // since the writer walks the (sorted) edge storage. A linear check lets us skip the
+        // O(E log E) sort and the rearrangement of every edge array on load.
+        if (std::is_sorted(edge_range.begin(), edge_range.end(), comparison_function)) {
+            return;
+        }
+
         std::vector<RREdgeId> edge_indices(edge_range.begin(), edge_range.end());
 
         std::stable_sort(edge_indices.begin(), edge_indices.end(), comparison_function);
@@ -907,6 +996,14 @@ class t_rr_graph_storage {
     }
 
   private:
+    /** @brief Find the source node of an edge from node_first_edge_. Used when edges are compressed. */
+    RRNodeId find_edge_src_node(RREdgeId edge) const {
+        // node_first_edge_ is non-decreasing: the source is the last node whose first edge is <= edge
+        auto it = std::upper_bound(node_first_edge_.begin(), node_first_edge_.end() - 1, edge);
+        VTR_ASSERT_SAFE(it != node_first_edge_.begin());
+        return RRNodeId(std::distance(node_first_edge_.begin(), it) - 1);
+    }
+
     /** @brief
      * Take allocated edges in edge_src_node_/ edge_dest_node_ / edge_switch_
      * sort, and assign the first edge for each
@@ -936,7 +1033,7 @@ class t_rr_graph_storage {
      * storage_ stores the core RR node data used by the router and is **very**
      * hot.
      */
-    vtr::vector<RRNodeId, t_rr_node_data, vtr::aligned_allocator<t_rr_node_data>> node_storage_;
+    vtr::vector<RRNodeId, t_rr_node_data, vtr::huge_page_allocator<t_rr_node_data>> node_storage_;
 
     /** @brief
      * The PTC data is cold data, and is generally not used during the inner
@@ -1005,6 +1102,16 @@ class t_rr_graph_storage {
     */
     vtr::vector<RREdgeId, bool> edge_remapped_;
 
+    /** @brief
+     * Reverse edge index (see init_reverse_edges()): reverse_edges_ holds the edge ids sorted by
+     * sink node and reverse_edge_src_nodes_ their source nodes, node_first_reverse_edge_ the offset
+     * of the first incoming edge of each node in them (plus a dummy entry for one past the last node).
+     * Empty unless requested.
+     */
+    vtr::vector<RRNodeId, uint32_t> node_first_reverse_edge_;
+    std::vector<RREdgeId> reverse_edges_;
+    std::vector<RRNodeId> reverse_edge_src_nodes_;
+
     /** @brief
      * The following data structures are only used for tileable routing resource graph.
      * The tileable flag is set to true by tileable routing resource graph builder.
@@ -1043,6 +1150,9 @@ class t_rr_graph_storage {
 
     /** @brief Set after partition_edges has been called. */
     bool partitioned_;
+
+    /** @brief Set after compress_edges has been called: edge_src_node_ is empty. */
+    bool edges_compressed_ = false;
 };
 
 /**
@@ -1071,7 +1181,10 @@ class t_rr_graph_view {
         const vtr::array_view_id<RREdgeId, const short> edge_switch,
         const std::unordered_map<std::string, RRNodeId>& virtual_clock_network_root_idx,
         const vtr::array_view_id<RRNodeId, const int16_t> node_bend_start,
-        const vtr::array_view_id<RRNodeId, const int16_t> node_bend_end)
+        const vtr::array_view_id<RRNodeId, const int16_t> node_bend_end,
+        const vtr::array_view_id<RRNodeId, const uint32_t> node_first_reverse_edge,
+        const vtr::array_view<const RREdgeId> reverse_edges,
+        const vtr::array_view<const RRNodeId> reverse_edge_src_nodes)
         : node_storage_(node_storage)
         , node_ptc_(node_ptc)
         , node_first_edge_(node_first_edge)
@@ -1083,7 +1196,10 @@ class t_rr_graph_view {
         , edge_switch_(edge_switch)
         , virtual_clock_network_root_idx_(virtual_clock_network_root_idx)
         , node_bend_start_(node_bend_start)
-        , node_bend_end_(node_bend_end) {}
+        , node_bend_end_(node_bend_end)
+        , node_first_reverse_edge_(node_first_reverse_edge)
+        , reverse_edges_(reverse_edges)
+        , reverse_edge_src_nodes_(reverse_edge_src_nodes) {}
 
     /****************
      * Node methods *
@@ -1269,6 +1385,35 @@ class t_rr_graph_view {
         return edge_switch_[edge];
     }
 
+    /** @brief Was the reverse edge index built (see t_rr_graph_storage::init_reverse_edges()) when this view was made? */
+    bool has_reverse_edges() const {
+        return node_first_reverse_edge_.size() != 0;
+    }
+
+    /**
+     * @brief Get the incoming edges of the specified node, i.e. the edges whose sink is id.
+     *
+     * @param id The RRNodeId for which to retrieve the incoming edges.
+     * @return The ids of the edges driving the node.
+     */
+    vtr::array_view<const RREdgeId> reverse_edges(RRNodeId id) const {
+        uint32_t first = node_first_reverse_edge_[id];
+        uint32_t last = (&node_first_reverse_edge_[id])[1];
+        return vtr::array_view<const RREdgeId>(reverse_edges_.data() + first, last - first);
+    }
+
+    /**
+     * @brief Get the source nodes of the incoming edges of the specified node, in the order of reverse_edges(id).
+     *
+     * @param id The RRNodeId for which to retrieve the fan-in nodes.
+     * @return The source node of each edge of reverse_edges(id).
+     */
+    vtr::array_view<const RRNodeId> reverse_edge_src_nodes(RRNodeId id) const {
+        uint32_t first = node_first_reverse_edge_[id];
+        uint32_t last = (&node_first_reverse_edge_[id])[1];
+        return vtr::array_view<const RRNodeId>(reverse_edge_src_nodes_.data() + first, last - first);
+    }
+
   private:
     RREdgeId first_edge(RRNodeId id) const {
         return node_first_edge_[id];
@@ -1292,4 +1437,7 @@ class t_rr_graph_view {
     vtr::array_view_id<RRNodeId, const int16_t> node_bend_start_;
     vtr::array_view_id<RRNodeId, const int16_t> node_bend_end_;
 
+    vtr::array_view_id<RRNodeId, const uint32_t> node_first_reverse_edge_;
+    vtr::array_view<const RREdgeId> reverse_edges_;
+    vtr::array_view<const RRNodeId> reverse_edge_src_nodes_;
 };
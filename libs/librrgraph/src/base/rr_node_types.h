@@ -79,6 +79,8 @@ enum e_rr_node_reorder_algorithm {
     DONT_REORDER,
     DEGREE_BFS,
     RANDOM_SHUFFLE,
+    HILBERT_CURVE,
+    REVERSE_CUTHILL_MCKEE,
 };
 
 ///@brief Type used to express rr_node edge index.
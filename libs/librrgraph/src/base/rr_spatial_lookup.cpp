@@ -1,6 +1,7 @@
 #include "rr_graph_fwd.h"
 #include "vtr_assert.h"
 #include "rr_spatial_lookup.h"
+#include <limits>
 #include <set>
 
 RRNodeId RRSpatialLookup::find_node(int layer,
@@ -32,37 +33,16 @@ RRNodeId RRSpatialLookup::find_node(int layer,
         return RRNodeId::INVALID();
     }
 
-    VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
-
     /* Sanity check to ensure the layer, x, y, side and ptc are in range
      * - Return an valid id by searching in look-up when all the parameters are in range
      * - Return an invalid id if any out-of-range is detected
      */
-    if (size_t(type) >= rr_node_indices_.size()) {
-        return RRNodeId::INVALID();
-    }
-
-    if (size_t(layer) >= rr_node_indices_[type].dim_size(0)) {
+    std::span<const RRNodeId> nodes = nodes_at(layer, x, y, type, node_side);
+    if (size_t(ptc) >= nodes.size()) {
         return RRNodeId::INVALID();
     }
 
-    if (size_t(x) >= rr_node_indices_[type].dim_size(1)) {
-        return RRNodeId::INVALID();
-    }
-
-    if (size_t(y) >= rr_node_indices_[type].dim_size(2)){
-        return RRNodeId::INVALID();
-    }
-
-    if (node_side >= rr_node_indices_[type].dim_size(3)) {
-        return RRNodeId::INVALID();
-    }
-
-    if (size_t(ptc) >= rr_node_indices_[type][layer][x][y][node_side].size()) {
-        return RRNodeId::INVALID();
-    }
-
-    return rr_node_indices_[type][layer][x][y][node_side][ptc];
+    return nodes[ptc];
 }
 
 std::vector<RRNodeId> RRSpatialLookup::find_nodes_in_range(int layer,
@@ -101,42 +81,22 @@ std::vector<RRNodeId> RRSpatialLookup::find_nodes(int layer,
         return nodes;
     }
 
-    VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
-
     /* Sanity check to ensure the x, y, side are in range 
      * - Return a list of valid ids by searching in look-up when all the parameters are in range
      * - Return an empty list if any out-of-range is detected
      */
-    if (size_t(type) >= rr_node_indices_.size()) {
-        return nodes;
-    }
-
-    if (size_t(layer) >= rr_node_indices_[type].dim_size(0)) {
-        return nodes;
-    }
-
-    if (size_t(x) >= rr_node_indices_[type].dim_size(1)) {
-        return nodes;
-    }
-
-    if (size_t(y) >= rr_node_indices_[type].dim_size(2)){
-        return nodes;
-    }
-
-    if (side >= rr_node_indices_[type].dim_size(3)) {
-        return nodes;
-    }
+    std::span<const RRNodeId> all_nodes = nodes_at(layer, x, y, type, side);
 
     /* Reserve space to avoid memory fragmentation */
     size_t num_nodes = 0;
-    for (RRNodeId node : rr_node_indices_[type][layer][x][y][side]) {
+    for (RRNodeId node : all_nodes) {
         if (node.is_valid()) {
             num_nodes++;
         }
     }
 
     nodes.reserve(num_nodes);
-    for (RRNodeId node : rr_node_indices_[type][layer][x][y][side]) {
+    for (RRNodeId node : all_nodes) {
         if (node.is_valid()) {
             nodes.emplace_back(node);
         }
@@ -145,6 +105,40 @@ std::vector<RRNodeId> RRSpatialLookup::find_nodes(int layer,
     return nodes;
 }
 
+std::span<const RRNodeId> RRSpatialLookup::nodes_at(int layer,
+                                                    int x,
+                                                    int y,
+                                                    e_rr_type type,
+                                                    e_side side) const {
+    if (layer < 0 || x < 0 || y < 0 || size_t(type) >= rr_node_indices_.size()) {
+        return {};
+    }
+
+    if (is_compressed_) {
+        const t_compressed_node_indices& compressed = compressed_node_indices_[type];
+        if (size_t(layer) >= compressed.dims[0]
+            || size_t(x) >= compressed.dims[1]
+            || size_t(y) >= compressed.dims[2]
+            || size_t(side) >= compressed.dims[3]) {
+            return {};
+        }
+
+        size_t loc = ((layer * compressed.dims[1] + x) * compressed.dims[2] + y) * compressed.dims[3] + side;
+        return std::span<const RRNodeId>(compressed.nodes.data() + compressed.offsets[loc],
+                                         compressed.offsets[loc + 1] - compressed.offsets[loc]);
+    }
+
+    VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
+    if (size_t(layer) >= rr_node_indices_[type].dim_size(0)
+        || size_t(x) >= rr_node_indices_[type].dim_size(1)
+        || size_t(y) >= rr_node_indices_[type].dim_size(2)
+        || size_t(side) >= rr_node_indices_[type].dim_size(3)) {
+        return {};
+    }
+
+    return rr_node_indices_[type][layer][x][y][side];
+}
+
 std::vector<RRNodeId> RRSpatialLookup::find_channel_nodes(int layer,
                                                           int x,
                                                           int y,
@@ -216,6 +210,7 @@ void RRSpatialLookup::reserve_nodes(int layer,
                                     e_rr_type type,
                                     int num_nodes,
                                     e_side side) {
+    decompress();
     VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
 
     /* For non-IPIN/OPIN nodes, the side should always be the TOP side which follows the convention in find_node() API! */
@@ -236,6 +231,7 @@ void RRSpatialLookup::add_node(RRNodeId node,
                                int ptc,
                                e_side side) {
     VTR_ASSERT(node.is_valid()); /* Must have a valid node id to be added */
+    decompress();
     VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
 
     /* For non-IPIN/OPIN nodes, the side should always be the TOP side which follows the convention in find_node() API! */
@@ -262,6 +258,7 @@ bool RRSpatialLookup::remove_node(RRNodeId node,
                                   int ptc,
                                   e_side side) {
     VTR_ASSERT(node.is_valid());
+    decompress();
     VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
     VTR_ASSERT_SAFE(layer >= 0);
     VTR_ASSERT_SAFE(x >= 0);
@@ -291,6 +288,7 @@ void RRSpatialLookup::mirror_nodes(const int layer,
                                    e_rr_type type,
                                    e_side side) {
     VTR_ASSERT(e_rr_type::SOURCE == type || e_rr_type::SINK == type);
+    decompress();
     resize_nodes(layer, des_coord.x(), des_coord.y(), type, side);
     rr_node_indices_[type][layer][des_coord.x()][des_coord.y()][side] = rr_node_indices_[type][layer][src_coord.x()][src_coord.y()][side];
 }
@@ -304,6 +302,7 @@ void RRSpatialLookup::resize_nodes(int layer,
      * This may seldom happen because the rr_graph building function
      * should ensure the fast look-up well organized  
      */
+    decompress();
     VTR_ASSERT((size_t)type < rr_node_indices_.size());
     VTR_ASSERT(x >= 0);
     VTR_ASSERT(y >= 0);
@@ -321,6 +320,14 @@ void RRSpatialLookup::resize_nodes(int layer,
 }
 
 void RRSpatialLookup::reorder(const vtr::vector<RRNodeId, RRNodeId>& dest_order) {
+    for (t_compressed_node_indices& compressed : compressed_node_indices_) {
+        for (RRNodeId& node : compressed.nodes) {
+            if (node.is_valid()) {
+                node = dest_order[node];
+            }
+        }
+    }
+
     // update rr_node_indices, a map to optimize rr_index lookups
     for (auto& grid : rr_node_indices_) {
         for(size_t l = 0; l < grid.dim_size(0); l++) {
@@ -339,8 +346,86 @@ void RRSpatialLookup::reorder(const vtr::vector<RRNodeId, RRNodeId>& dest_order)
     }
 }
 
+void RRSpatialLookup::compress() {
+    if (is_compressed_) {
+        return;
+    }
+
+    for (e_rr_type type : RR_TYPES) {
+        const vtr::NdMatrix<std::vector<RRNodeId>, 4>& node_indices = rr_node_indices_[type];
+        t_compressed_node_indices& compressed = compressed_node_indices_[type];
+        for (size_t idim = 0; idim < 4; idim++) {
+            compressed.dims[idim] = node_indices.dim_size(idim);
+        }
+
+        // The NdMatrix stores its elements in the same (layer, x, y, side) order as the offsets
+        size_t num_locs = node_indices.size();
+        compressed.offsets.resize(num_locs + 1);
+        size_t num_nodes = 0;
+        for (size_t loc = 0; loc < num_locs; loc++) {
+            const std::vector<RRNodeId>& nodes = node_indices.get(loc);
+            size_t num_used_ptcs = nodes.size();
+            while (num_used_ptcs > 0 && !nodes[num_used_ptcs - 1].is_valid()) {
+                num_used_ptcs--;
+            }
+            compressed.offsets[loc] = num_nodes;
+            num_nodes += num_used_ptcs;
+        }
+        VTR_ASSERT(num_nodes <= std::numeric_limits<uint32_t>::max());
+        compressed.offsets[num_locs] = num_nodes;
+
+        compressed.nodes.reserve(num_nodes);
+        for (size_t loc = 0; loc < num_locs; loc++) {
+            const std::vector<RRNodeId>& nodes = node_indices.get(loc);
+            compressed.nodes.insert(compressed.nodes.end(), nodes.begin(), nodes.begin() + (compressed.offsets[loc + 1] - compressed.offsets[loc]));
+        }
+
+        // Free the nested vectors
+        rr_node_indices_[type].clear();
+    }
+
+    is_compressed_ = true;
+}
+
+void RRSpatialLookup::decompress() {
+    if (!is_compressed_) {
+        return;
+    }
+
+    for (e_rr_type type : RR_TYPES) {
+        t_compressed_node_indices& compressed = compressed_node_indices_[type];
+        vtr::NdMatrix<std::vector<RRNodeId>, 4>& node_indices = rr_node_indices_[type];
+        node_indices.resize(compressed.dims);
+        for (size_t loc = 0; loc < node_indices.size(); loc++) {
+            node_indices.get(loc).assign(compressed.nodes.begin() + compressed.offsets[loc],
+                                         compressed.nodes.begin() + compressed.offsets[loc + 1]);
+        }
+        compressed = t_compressed_node_indices();
+    }
+
+    is_compressed_ = false;
+}
+
+size_t RRSpatialLookup::memory_used() const {
+    size_t bytes = 0;
+    for (const t_compressed_node_indices& compressed : compressed_node_indices_) {
+        bytes += compressed.offsets.capacity() * sizeof(uint32_t) + compressed.nodes.capacity() * sizeof(RRNodeId);
+    }
+    for (const auto& data : rr_node_indices_) {
+        bytes += data.size() * sizeof(std::vector<RRNodeId>);
+        for (size_t i = 0; i < data.size(); i++) {
+            bytes += data.get(i).capacity() * sizeof(RRNodeId);
+        }
+    }
+    return bytes;
+}
+
 void RRSpatialLookup::clear() {
     for (auto& data : rr_node_indices_) {
         data.clear();
     }
+    for (t_compressed_node_indices& compressed : compressed_node_indices_) {
+        compressed = t_compressed_node_indices();
+    }
+    is_compressed_ = false;
 }
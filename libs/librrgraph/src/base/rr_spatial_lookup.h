@@ -12,8 +12,15 @@
  *
  *   - Update the look-up with new nodes
  *   - Find the id of a node with given information, e.g., x, y, type etc.
+ *
+ * Once the graph is built, the look-up can be compressed (see compress()) into a
+ * compact representation, with the same accessors.
  */
 
+#include <array>
+#include <cstdint>
+#include <span>
+
 #include "vtr_geometry.h"
 #include "vtr_vector.h"
 #include "physical_types.h"
@@ -271,9 +278,28 @@ class RRSpatialLookup {
     /** @brief Reorder the internal look up to be more memory efficient */
     void reorder(const vtr::vector<RRNodeId, RRNodeId>& dest_order);
 
+    /**
+     * @brief Compress the look-up, once all the nodes have been added.
+     *
+     * The nodes of each type are packed in a single array, ordered by (layer, x, y, side) and then ptc
+     * (without the unused trailing ptcs), along with a table of the offsets where the nodes
+     * of each (layer, x, y, side) start. This replaces one std::vector per location, most of them
+     * empty or nearly so on large devices, and makes each look-up two reads of contiguous arrays.
+     *
+     * @note The accessors are unchanged. Any later modification of the look-up (e.g. add_node())
+     * decompresses it first, so it should only be compressed when no more nodes are expected.
+     */
+    void compress();
+
+    /** @brief Whether the look-up is compressed (see compress()) */
+    bool is_compressed() const { return is_compressed_; }
+
     /** @brief Clear all the data inside */
     void clear();
 
+    /** @brief Memory used by the look-up, in bytes */
+    size_t memory_used() const;
+
     /* -- Internal data queries -- */
   private:
     /* An internal API to find all the nodes in a specific location with a given type
@@ -287,8 +313,31 @@ class RRSpatialLookup {
                                      e_rr_type type,
                                      e_side side = TOTAL_2D_SIDES[0]) const;
 
+    /* Returns the nodes (indexed by ptc, including invalid ids) at a specific location with a given type and side,
+     * from whichever of the look-ups is in use. Empty if the location is out of range */
+    std::span<const RRNodeId> nodes_at(int layer,
+                                       int x,
+                                       int y,
+                                       e_rr_type type,
+                                       e_side side) const;
+
+    /* Moves back the nodes of the compressed look-up to rr_node_indices_, so that it can be modified */
+    void decompress();
+
     /* -- Internal data storage -- */
   private:
     /* Fast look-up: TODO: Should rework the data type. Currently it is based on a 3-dimensional array mater where some dimensions must always be accessed with a specific index. Such limitation should be overcome */
     t_rr_node_indices rr_node_indices_;
+
+    /* The compressed look-up of the nodes of one type: the nodes at location (layer, x, y, side)
+     * are nodes[offsets[i]] to nodes[offsets[i + 1] - 1], where i is the flat index of the location in dims */
+    struct t_compressed_node_indices {
+        std::array<size_t, 4> dims = {0, 0, 0, 0};
+        std::vector<uint32_t> offsets;
+        std::vector<RRNodeId> nodes;
+    };
+
+    /* The look-up in use once compressed (rr_node_indices_ is then empty) */
+    vtr::array<e_rr_type, t_compressed_node_indices, (size_t)e_rr_type::NUM_RR_TYPES> compressed_node_indices_;
+    bool is_compressed_ = false;
 };
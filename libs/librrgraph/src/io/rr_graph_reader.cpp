@@ -17,6 +17,7 @@
 
 #include "rr_graph_uxsdcxx_serializer.h"
 #include "rr_graph_uxsdcxx.h"
+#include "rr_graph_xml_stream.h"
 
 #include <fstream>
 #include <utility>
@@ -110,11 +111,11 @@ void load_rr_file(RRGraphBuilder* rr_graph_builder,
         &arch->strings,
         is_flat);
 
-    if (vtr::check_file_name_extension(read_rr_graph_name, ".xml")) {
+    if (vtr::check_file_name_extension(read_rr_graph_name, ".xml") || is_gzip_rr_graph_xml_file(read_rr_graph_name)) {
         try {
-            std::ifstream file(read_rr_graph_name);
+            std::unique_ptr<std::istream> file = open_rr_graph_xml_input(read_rr_graph_name);
             void* context;
-            uxsd::load_rr_graph_xml(reader, context, read_rr_graph_name, file);
+            uxsd::load_rr_graph_xml(reader, context, read_rr_graph_name, *file);
         } catch (pugiutil::XmlError& e) {
             vpr_throw(VPR_ERROR_ROUTE, read_rr_graph_name, e.line(), "%s", e.what());
         }
@@ -127,7 +128,7 @@ void load_rr_file(RRGraphBuilder* rr_graph_builder,
     } else {
         VTR_LOG_WARN(
             "RR graph file '%s' may be in incorrect format. "
-            "Expecting .xml or .bin format\n",
+            "Expecting .xml, .xml.gz or .bin format\n",
             read_rr_graph_name);
     }
 }
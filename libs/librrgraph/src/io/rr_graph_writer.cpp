@@ -8,10 +8,11 @@
 #include "rr_graph_writer.h"
 
 #include <cstdio>
-#include <fstream>
 #include <limits>
 #include "rr_graph_uxsdcxx_serializer.h"
 #include "rr_graph_uxsdcxx.h"
+#include "rr_graph_xml_stream.h"
+#include "vtr_time.h"
 #ifdef VTR_ENABLE_CAPNPROTO
 #    include "serdes_utils.h"
 #    include "rr_graph_uxsdcxx_capnp.h"
@@ -38,6 +39,7 @@ void write_rr_graph(RRGraphBuilder* rr_graph_builder,
                     bool echo_enabled,
                     const char* echo_file_name,
                     bool is_flat) {
+    vtr::ScopedStartFinishTimer timer("Writing routing resource graph");
 
     RrGraphSerializer reader(
         /*graph_type=*/e_graph_type(),
@@ -66,12 +68,16 @@ void write_rr_graph(RRGraphBuilder* rr_graph_builder,
         &arch->strings,
         is_flat);
 
-    if (vtr::check_file_name_extension(file_name, ".xml")) {
-        std::fstream fp;
-        fp.open(file_name, std::fstream::out | std::fstream::trunc);
-        fp.precision(std::numeric_limits<float>::max_digits10);
+    if (vtr::check_file_name_extension(file_name, ".xml") || is_gzip_rr_graph_xml_file(file_name)) {
+        std::unique_ptr<std::ostream> os = open_rr_graph_xml_output(file_name);
         void* context;
-        uxsd::write_rr_graph_xml(reader, context, fp);
+        uxsd::write_rr_graph_xml(reader, context, *os);
+        os->flush();
+        if (!*os) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "Failed to write RR graph file '%s'\n",
+                            file_name);
+        }
 #ifdef VTR_ENABLE_CAPNPROTO
     } else if (vtr::check_file_name_extension(file_name, ".bin")) {
         ::capnp::MallocMessageBuilder builder;
@@ -0,0 +1,172 @@
+#include "rr_graph_xml_stream.h"
+
+#include <fstream>
+#include <limits>
+#include <streambuf>
+#include <vector>
+#include <zlib.h>
+
+#include "vpr_error.h"
+
+namespace {
+
+/// @brief Size of the buffer the RR graph files are written and read through.
+constexpr size_t RR_GRAPH_XML_BUFFER_SIZE = 1 << 22;
+
+/// @brief File stream writing through a large buffer.
+class BufferedXmlOutputStream : public std::ofstream {
+  public:
+    explicit BufferedXmlOutputStream(const std::string& file_name)
+        : buffer_(RR_GRAPH_XML_BUFFER_SIZE) {
+        //The buffer must be set before the file is opened
+        rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+        open(file_name, std::ios::out | std::ios::trunc);
+    }
+
+    ~BufferedXmlOutputStream() override {
+        //Flush while the buffer is still alive
+        close();
+    }
+
+  private:
+    std::vector<char> buffer_;
+};
+
+/// @brief Stream buffer gzip compressing what is written to it into a file (or decompressing what is read from it).
+class GzipStreambuf : public std::streambuf {
+  public:
+    GzipStreambuf(const std::string& file_name, const char* mode)
+        : buffer_(RR_GRAPH_XML_BUFFER_SIZE)
+        , file_(gzopen(file_name.c_str(), mode)) {
+        if (file_) {
+            gzbuffer(file_, RR_GRAPH_XML_BUFFER_SIZE);
+        }
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+        setg(buffer_.data(), buffer_.data(), buffer_.data());
+    }
+
+    ~GzipStreambuf() override {
+        flush_buffer();
+        if (file_) {
+            gzclose(file_);
+        }
+    }
+
+    bool is_open() const { return file_ != nullptr; }
+
+  protected:
+    int_type overflow(int_type ch) override {
+        if (!flush_buffer()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override {
+        return flush_buffer() ? 0 : -1;
+    }
+
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        int num_bytes = file_ ? gzread(file_, buffer_.data(), buffer_.size()) : -1;
+        if (num_bytes <= 0) {
+            return traits_type::eof();
+        }
+        setg(buffer_.data(), buffer_.data(), buffer_.data() + num_bytes);
+        return traits_type::to_int_type(*gptr());
+    }
+
+  private:
+    ///@brief Compresses the buffered data, returns false on error.
+    bool flush_buffer() {
+        int num_bytes = int(pptr() - pbase());
+        if (num_bytes > 0) {
+            if (!file_ || gzwrite(file_, pbase(), num_bytes) != num_bytes) {
+                return false;
+            }
+            pbump(-num_bytes);
+        }
+        return true;
+    }
+
+    std::vector<char> buffer_;
+    gzFile file_;
+};
+
+/// @brief Output stream gzip compressing into a file.
+class GzipXmlOutputStream : public std::ostream {
+  public:
+    explicit GzipXmlOutputStream(const std::string& file_name)
+        : std::ostream(nullptr)
+        , streambuf_(file_name, "wb") {
+        rdbuf(&streambuf_);
+        if (!streambuf_.is_open()) {
+            setstate(std::ios::failbit);
+        }
+    }
+
+    ~GzipXmlOutputStream() override {
+        flush();
+    }
+
+  private:
+    GzipStreambuf streambuf_;
+};
+
+/// @brief Input stream decompressing a gzip file. It is not seekable, so the XML parser reads it in chunks.
+class GzipXmlInputStream : public std::istream {
+  public:
+    explicit GzipXmlInputStream(const std::string& file_name)
+        : std::istream(nullptr)
+        , streambuf_(file_name, "rb") {
+        rdbuf(&streambuf_);
+        if (!streambuf_.is_open()) {
+            setstate(std::ios::failbit);
+        }
+    }
+
+  private:
+    GzipStreambuf streambuf_;
+};
+
+} // namespace
+
+bool is_gzip_rr_graph_xml_file(const std::string& file_name) {
+    const std::string extension = ".xml.gz";
+    return file_name.size() > extension.size() && file_name.compare(file_name.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+std::unique_ptr<std::ostream> open_rr_graph_xml_output(const std::string& file_name) {
+    std::unique_ptr<std::ostream> os;
+    if (is_gzip_rr_graph_xml_file(file_name)) {
+        os = std::make_unique<GzipXmlOutputStream>(file_name);
+    } else {
+        os = std::make_unique<BufferedXmlOutputStream>(file_name);
+    }
+
+    if (!*os) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to open RR graph file '%s' for writing\n", file_name.c_str());
+    }
+    os->precision(std::numeric_limits<float>::max_digits10);
+    return os;
+}
+
+std::unique_ptr<std::istream> open_rr_graph_xml_input(const std::string& file_name) {
+    std::unique_ptr<std::istream> is;
+    if (is_gzip_rr_graph_xml_file(file_name)) {
+        is = std::make_unique<GzipXmlInputStream>(file_name);
+    } else {
+        is = std::make_unique<std::ifstream>(file_name);
+    }
+
+    if (!*is) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to open RR graph file '%s' for reading\n", file_name.c_str());
+    }
+    return is;
+}
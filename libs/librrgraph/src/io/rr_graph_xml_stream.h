@@ -0,0 +1,29 @@
+#pragma once
+
+/**
+ * @file
+ * @brief The file streams the XML RR graphs are written to and read from.
+ *
+ * XML RR graphs of large devices are tens of GB, so they are written through a large buffer, and
+ * may be gzip compressed: a file name ending with '.xml.gz' is compressed (or decompressed) on the
+ * fly, one buffer at a time.
+ */
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+/** @brief Whether the file name is the one of a gzip compressed XML RR graph (i.e. ends with '.xml.gz') */
+bool is_gzip_rr_graph_xml_file(const std::string& file_name);
+
+/** @brief Opens the file an XML RR graph is written to (gzip compressed for a '.xml.gz' file). Errors out if it can not be opened. */
+std::unique_ptr<std::ostream> open_rr_graph_xml_output(const std::string& file_name);
+
+/**
+ * @brief Opens the file an XML RR graph is read from (gzip decompressed for a '.xml.gz' file). Errors out if it can not be opened.
+ *
+ * The compressed files are decompressed in chunks as the XML parser reads them, so the
+ * compressed file is never held in memory.
+ */
+std::unique_ptr<std::istream> open_rr_graph_xml_input(const std::string& file_name);
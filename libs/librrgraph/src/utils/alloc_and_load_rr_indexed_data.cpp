@@ -5,8 +5,15 @@
 #include <fstream>
 #include <iomanip>
 #include <numeric>
+#include <span>
 #include <sstream>
 
+#ifdef VPR_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif // VPR_USE_TBB
+
 #include "librrgraph_types.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -17,18 +24,70 @@
 #include "rr_graph_cost.h"
 #include "histogram.h"
 
+/******************* Types local to this module ************************/
+
+/// @brief Average electrical properties of the fan-in switches of a wire (see calculate_average_switch())
+struct t_wire_switch_stats {
+    double avg_switch_R = 0;
+    double avg_switch_T = 0;
+    double avg_switch_Cinternal = 0;
+    int num_switches = 0;
+    int num_shorts = 0;
+    short buffered = LIBRRGRAPH_UNDEFINED_VAL;
+};
+
+/// @brief Per cost index counts over the wires of the RR graph. Counts gathered over parts of the graph are summed.
+struct t_wire_counts {
+    /// @brief [seg][perp_seg]: the number of edges from CHANX/CHANY segment type seg (X first, then Y) to each perpendicular segment type
+    std::vector<std::vector<size_t>> dest_nodes_count;
+    /// @brief The number of CHANX/CHANY/CHANZ nodes of each cost index
+    std::vector<size_t> num_nodes_of_cost_index;
+
+    void add(const t_wire_counts& other);
+};
+
+/// @brief The statistics of the wires of the RR graph used to load the indexed data, gathered in a single pass over the graph
+struct t_wire_stats {
+    t_wire_counts counts;
+    /// @brief Fan-in switch statistics of each CHANX/CHANY/CHANZ node (default for the other nodes)
+    vtr::vector<RRNodeId, t_wire_switch_stats> switch_stats;
+};
+
 /******************* Subroutines local to this module ************************/
 
-static void load_rr_indexed_data_base_costs(const RRGraphView& rr_graph,
-                                            vtr::vector<RRIndexedDataId,
+/**
+ * @brief Gathers the statistics of all the wires (in parallel over the nodes).
+ *
+ * This replaces one pass over the graph for the orthogonal cost indices, one for the
+ * segment type counts, and one (with a per-node fan-in list) for the switch statistics.
+ */
+static t_wire_stats gather_wire_stats(const RRGraphView& rr_graph,
+                                      size_t num_cost_indices,
+                                      size_t num_segments_x,
+                                      size_t num_segments_y);
+
+/// @brief Adds the edges from a CHANX/CHANY node to the perpendicular wires to dest_nodes_count (see t_wire_counts)
+static void count_ortho_connections(const RRGraphView& rr_graph,
+                                    RRNodeId rr_node,
+                                    size_t num_segments_x,
+                                    std::vector<std::vector<size_t>>& dest_nodes_count);
+
+/// @brief Returns the most connected perpendicular cost index of each CHANX/CHANY segment type
+static std::vector<int> select_ortho_cost_indices(const std::vector<std::vector<size_t>>& dest_nodes_count,
+                                                  size_t num_segments_x);
+
+static void load_rr_indexed_data_base_costs(vtr::vector<RRIndexedDataId,
                                             t_rr_indexed_data>& rr_indexed_data,
                                             e_base_cost_type base_cost_type,
+                                            const std::vector<size_t>& num_nodes_of_cost_index,
                                             const bool echo_enabled,
                                             const char* echo_file_name);
 
 static float get_delay_normalization_fac(const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data, const bool echo_enabled, const char* echo_file_name);
 
-static void load_rr_indexed_data_T_values(const RRGraphView& rr_graph, vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data);
+static void load_rr_indexed_data_T_values(const RRGraphView& rr_graph,
+                                          const vtr::vector<RRNodeId, t_wire_switch_stats>& switch_stats,
+                                          vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data);
 
 /**
  * @brief Computes average R, Tdel, and Cinternal of fan-in switches for a given node.
@@ -43,18 +102,13 @@ static void load_rr_indexed_data_T_values(const RRGraphView& rr_graph, vtr::vect
  */
 static void calculate_average_switch(const RRGraphView& rr_graph,
                                      RRNodeId inode,
-                                     double& avg_switch_R,
-                                     double& avg_switch_T,
-                                     double& avg_switch_Cinternal,
-                                     int& num_switches,
-                                     int& num_shorts,
-                                     short& buffered,
-                                     vtr::vector<RRNodeId, std::vector<RREdgeId>>& fan_in_list);
+                                     std::span<const RREdgeId> fan_in_edges,
+                                     t_wire_switch_stats& stats);
 
 static void fixup_rr_indexed_data_T_values(vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data, size_t num_segment);
 
-static std::vector<size_t> count_rr_segment_types(const RRGraphView& rr_graph,
-                                                  const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data);
+static std::vector<size_t> count_rr_segment_types(const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
+                                                  const std::vector<size_t>& num_nodes_of_cost_index);
 
 static void print_rr_index_info(const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
                                 const char* fname,
@@ -111,7 +165,9 @@ void alloc_and_load_rr_indexed_data(const RRGraphView& rr_graph,
     //TODO: SM: IPIN t_linear assumes wire_to_ipin_switch which corresponds to within die switch connection
     rr_indexed_data[RRIndexedDataId(IPIN_COST_INDEX)].T_linear = rr_graph.rr_switch_inf(wire_to_ipin_switch).Tdel;
 
-    std::vector<int> ortho_costs = find_ortho_cost_index(rr_graph, segment_inf_x, segment_inf_y, e_parallel_axis::X_AXIS);
+    t_wire_stats wire_stats = gather_wire_stats(rr_graph, num_rr_indexed_data, segment_inf_x.size(), segment_inf_y.size());
+
+    std::vector<int> ortho_costs = select_ortho_cost_indices(wire_stats.counts.dest_nodes_count, segment_inf_x.size());
 
     /* AA: The code below should replace find_ortho_cost_index call once we deprecate the CLASSIC lookahead as it is the only lookahead
      * that actively uses the orthogonal cost indices. To avoid complicated dependencies with the rr_graph reader, regardless of the lookahead,
@@ -158,11 +214,11 @@ void alloc_and_load_rr_indexed_data(const RRGraphView& rr_graph,
         rr_indexed_data[index].seg_index = seg_ptr->seg_index;
     }
 
-    load_rr_indexed_data_T_values(rr_graph, rr_indexed_data);
+    load_rr_indexed_data_T_values(rr_graph, wire_stats.switch_stats, rr_indexed_data);
 
     fixup_rr_indexed_data_T_values(rr_indexed_data, total_num_segment);
 
-    load_rr_indexed_data_base_costs(rr_graph, rr_indexed_data, base_cost_type, echo_enabled, echo_file_name);
+    load_rr_indexed_data_base_costs(rr_indexed_data, base_cost_type, wire_stats.counts.num_nodes_of_cost_index, echo_enabled, echo_file_name);
 
     if (echo_enabled) {
         print_rr_index_info(rr_indexed_data,
@@ -202,39 +258,10 @@ std::vector<int> find_ortho_cost_index(const RRGraphView& rr_graph,
 
     // Go through all rr_Nodes. Look at the ones with CHAN type. Count all outgoing edges to CHAN typed nodes from each CHAN type node.
     for (const RRNodeId rr_node : rr_graph.nodes()) {
-        for (size_t iedge = 0; iedge < rr_graph.num_edges(rr_node); ++iedge) {
-            RRNodeId to_node = rr_graph.edge_sink_node(rr_node, iedge);
-            e_rr_type from_node_type = rr_graph.node_type(rr_node);
-            e_rr_type to_node_type = rr_graph.node_type(to_node);
-
-            size_t from_node_cost_index = (size_t)rr_graph.node_cost_index(rr_node);
-            size_t to_node_cost_index = (size_t)rr_graph.node_cost_index(to_node);
-
-            // if the type  is smaller than start index, means destination is not a CHAN type node.
-
-            if ((from_node_type == e_rr_type::CHANX && to_node_type == e_rr_type::CHANY) || (from_node_type == e_rr_type::CHANY && to_node_type == e_rr_type::CHANX)) {
-                if (to_node_type == e_rr_type::CHANY) {
-                    dest_nodes_count[from_node_cost_index - CHANX_COST_INDEX_START][to_node_cost_index - (CHANX_COST_INDEX_START + segment_inf_x.size())]++;
-                } else {
-                    dest_nodes_count[from_node_cost_index - CHANX_COST_INDEX_START][to_node_cost_index - CHANX_COST_INDEX_START]++;
-                }
-            }
-        }
+        count_ortho_connections(rr_graph, rr_node, segment_inf_x.size(), dest_nodes_count);
     }
 
-    std::vector<int> ortho_cost_indices(num_segments, 0);
-
-    for (size_t iseg = 0; iseg < segment_inf_x.size(); iseg++) {
-        ortho_cost_indices[iseg] = std::ranges::max_element(dest_nodes_count[iseg]) - dest_nodes_count[iseg].begin();
-        ortho_cost_indices[iseg] += CHANX_COST_INDEX_START + segment_inf_x.size();
-    }
-
-    for (size_t iseg = segment_inf_x.size(); iseg < num_segments; iseg++) {
-        ortho_cost_indices[iseg] = std::ranges::max_element(dest_nodes_count[iseg]) - dest_nodes_count[iseg].begin();
-        ortho_cost_indices[iseg] += CHANX_COST_INDEX_START;
-    }
-
-    return ortho_cost_indices;
+    return select_ortho_cost_indices(dest_nodes_count, segment_inf_x.size());
 
     /*Update seg_index */
 
@@ -345,9 +372,139 @@ std::vector<int> find_ortho_cost_index(const RRGraphView& rr_graph,
 #endif
 }
 
-static void load_rr_indexed_data_base_costs(const RRGraphView& rr_graph,
-                                            vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
+void t_wire_counts::add(const t_wire_counts& other) {
+    for (size_t iseg = 0; iseg < dest_nodes_count.size(); iseg++) {
+        for (size_t perp_seg = 0; perp_seg < dest_nodes_count[iseg].size(); perp_seg++) {
+            dest_nodes_count[iseg][perp_seg] += other.dest_nodes_count[iseg][perp_seg];
+        }
+    }
+    for (size_t cost_index = 0; cost_index < num_nodes_of_cost_index.size(); cost_index++) {
+        num_nodes_of_cost_index[cost_index] += other.num_nodes_of_cost_index[cost_index];
+    }
+}
+
+static t_wire_stats gather_wire_stats(const RRGraphView& rr_graph,
+                                      size_t num_cost_indices,
+                                      size_t num_segments_x,
+                                      size_t num_segments_y) {
+    const size_t num_nodes = rr_graph.num_nodes();
+
+    // The fan-in edges of each node, in edge order, stored contiguously: the edges
+    // of node i are fan_in_edges[fan_in_offsets[i]] to fan_in_edges[fan_in_offsets[i + 1] - 1]
+    std::vector<size_t> fan_in_offsets(num_nodes + 1, 0);
+    rr_graph.rr_nodes().for_each_edge(
+        [&](RREdgeId /*edge*/, RRNodeId /*src*/, RRNodeId sink) -> void {
+            fan_in_offsets[size_t(sink) + 1]++;
+        });
+    std::partial_sum(fan_in_offsets.begin(), fan_in_offsets.end(), fan_in_offsets.begin());
+
+    std::vector<RREdgeId> fan_in_edges(fan_in_offsets.back());
+    std::vector<size_t> next_fan_in(fan_in_offsets.begin(), fan_in_offsets.end() - 1);
+    rr_graph.rr_nodes().for_each_edge(
+        [&](RREdgeId edge, RRNodeId /*src*/, RRNodeId sink) -> void {
+            fan_in_edges[next_fan_in[size_t(sink)]++] = edge;
+        });
+    next_fan_in.clear();
+    next_fan_in.shrink_to_fit();
+
+    t_wire_counts zero_counts;
+    zero_counts.dest_nodes_count.resize(num_segments_x + num_segments_y);
+    for (size_t iseg = 0; iseg < num_segments_x + num_segments_y; iseg++) {
+        // x segments are perpendicular to y segments, and y segments to x segments
+        zero_counts.dest_nodes_count[iseg].resize(iseg < num_segments_x ? num_segments_y : num_segments_x, 0);
+    }
+    zero_counts.num_nodes_of_cost_index.resize(num_cost_indices, 0);
+
+    t_wire_stats stats;
+    stats.switch_stats.resize(num_nodes);
+
+    // Each node only writes its own switch statistics, and counts into counts of its own thread
+    auto gather_node_stats = [&](RRNodeId rr_node, t_wire_counts& counts) {
+        e_rr_type rr_type = rr_graph.node_type(rr_node);
+        if (!is_chanxy(rr_type) && !is_chanz(rr_type)) {
+            return;
+        }
+
+        count_ortho_connections(rr_graph, rr_node, num_segments_x, counts.dest_nodes_count);
+        counts.num_nodes_of_cost_index[size_t(rr_graph.node_cost_index(rr_node))]++;
+
+        size_t inode = size_t(rr_node);
+        std::span<const RREdgeId> node_fan_in_edges(fan_in_edges.data() + fan_in_offsets[inode],
+                                                    fan_in_offsets[inode + 1] - fan_in_offsets[inode]);
+        calculate_average_switch(rr_graph, rr_node, node_fan_in_edges, stats.switch_stats[rr_node]);
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::enumerable_thread_specific<t_wire_counts> thread_counts(zero_counts);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_nodes), [&](const tbb::blocked_range<size_t>& range) {
+        t_wire_counts& counts = thread_counts.local();
+        for (size_t inode = range.begin(); inode != range.end(); inode++) {
+            gather_node_stats(RRNodeId(inode), counts);
+        }
+    });
+
+    // Counts are integers, so the sum does not depend on how the nodes were split between threads
+    stats.counts = zero_counts;
+    for (const t_wire_counts& counts : thread_counts) {
+        stats.counts.add(counts);
+    }
+#else
+    stats.counts = zero_counts;
+    for (const RRNodeId rr_node : rr_graph.nodes()) {
+        gather_node_stats(rr_node, stats.counts);
+    }
+#endif // VPR_USE_TBB
+
+    return stats;
+}
+
+static void count_ortho_connections(const RRGraphView& rr_graph,
+                                    RRNodeId rr_node,
+                                    size_t num_segments_x,
+                                    std::vector<std::vector<size_t>>& dest_nodes_count) {
+    e_rr_type from_node_type = rr_graph.node_type(rr_node);
+    if (from_node_type != e_rr_type::CHANX && from_node_type != e_rr_type::CHANY) {
+        return;
+    }
+
+    size_t from_node_cost_index = (size_t)rr_graph.node_cost_index(rr_node);
+    for (size_t iedge = 0; iedge < rr_graph.num_edges(rr_node); ++iedge) {
+        RRNodeId to_node = rr_graph.edge_sink_node(rr_node, iedge);
+        e_rr_type to_node_type = rr_graph.node_type(to_node);
+
+        size_t to_node_cost_index = (size_t)rr_graph.node_cost_index(to_node);
+
+        if ((from_node_type == e_rr_type::CHANX && to_node_type == e_rr_type::CHANY) || (from_node_type == e_rr_type::CHANY && to_node_type == e_rr_type::CHANX)) {
+            if (to_node_type == e_rr_type::CHANY) {
+                dest_nodes_count[from_node_cost_index - CHANX_COST_INDEX_START][to_node_cost_index - (CHANX_COST_INDEX_START + num_segments_x)]++;
+            } else {
+                dest_nodes_count[from_node_cost_index - CHANX_COST_INDEX_START][to_node_cost_index - CHANX_COST_INDEX_START]++;
+            }
+        }
+    }
+}
+
+static std::vector<int> select_ortho_cost_indices(const std::vector<std::vector<size_t>>& dest_nodes_count,
+                                                  size_t num_segments_x) {
+    size_t num_segments = dest_nodes_count.size();
+    std::vector<int> ortho_cost_indices(num_segments, 0);
+
+    for (size_t iseg = 0; iseg < num_segments_x; iseg++) {
+        ortho_cost_indices[iseg] = std::ranges::max_element(dest_nodes_count[iseg]) - dest_nodes_count[iseg].begin();
+        ortho_cost_indices[iseg] += CHANX_COST_INDEX_START + num_segments_x;
+    }
+
+    for (size_t iseg = num_segments_x; iseg < num_segments; iseg++) {
+        ortho_cost_indices[iseg] = std::ranges::max_element(dest_nodes_count[iseg]) - dest_nodes_count[iseg].begin();
+        ortho_cost_indices[iseg] += CHANX_COST_INDEX_START;
+    }
+
+    return ortho_cost_indices;
+}
+
+static void load_rr_indexed_data_base_costs(vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
                                             e_base_cost_type base_cost_type,
+                                            const std::vector<size_t>& num_nodes_of_cost_index,
                                             const bool echo_enabled,
                                             const char* echo_file_name) {
     // Loads the base_cost member of rr_indexed_data according to the specified base_cost_type.
@@ -371,7 +528,7 @@ static void load_rr_indexed_data_base_costs(const RRGraphView& rr_graph,
     // .875 = 1/2 + 1/4 + 1/8 can be perfectly represented in a binary mantissa with only the first 3 bits set.
     rr_indexed_data[RRIndexedDataId(IPIN_COST_INDEX)].base_cost = 0.875 * delay_normalization_fac;
 
-    auto rr_segment_counts = count_rr_segment_types(rr_graph, rr_indexed_data);
+    auto rr_segment_counts = count_rr_segment_types(rr_indexed_data, num_nodes_of_cost_index);
     size_t total_segments = std::accumulate(rr_segment_counts.begin(), rr_segment_counts.end(), 0u);
 
     /* Load base costs for CHANX and CHANY segments */
@@ -436,19 +593,16 @@ static void load_rr_indexed_data_base_costs(const RRGraphView& rr_graph,
     }
 }
 
-static std::vector<size_t> count_rr_segment_types(const RRGraphView& rr_graph,
-                                                  const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data) {
+static std::vector<size_t> count_rr_segment_types(const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
+                                                  const std::vector<size_t>& num_nodes_of_cost_index) {
     std::vector<size_t> rr_segment_type_counts;
 
-    for (const RRNodeId id : rr_graph.nodes()) {
-        e_rr_type node_type = rr_graph.node_type(id);
-        if (!is_chanxy(node_type) && !is_chanz(node_type)) {
+    for (size_t cost_index = 0; cost_index < num_nodes_of_cost_index.size(); cost_index++) {
+        if (num_nodes_of_cost_index[cost_index] == 0) {
             continue;
         }
 
-        RRIndexedDataId cost_index = rr_graph.node_cost_index(id);
-
-        int seg_index = rr_indexed_data[cost_index].seg_index;
+        int seg_index = rr_indexed_data[RRIndexedDataId(cost_index)].seg_index;
 
         VTR_ASSERT(seg_index != LIBRRGRAPH_UNDEFINED_VAL);
 
@@ -457,7 +611,7 @@ static std::vector<size_t> count_rr_segment_types(const RRGraphView& rr_graph,
         }
         VTR_ASSERT(seg_index < int(rr_segment_type_counts.size()));
 
-        ++rr_segment_type_counts[seg_index];
+        rr_segment_type_counts[seg_index] += num_nodes_of_cost_index[cost_index];
     }
 
     return rr_segment_type_counts;
@@ -513,9 +667,8 @@ static float get_delay_normalization_fac(const vtr::vector<RRIndexedDataId, t_rr
  *      - Placement Delay Matrix computation
  */
 static void load_rr_indexed_data_T_values(const RRGraphView& rr_graph,
+                                          const vtr::vector<RRNodeId, t_wire_switch_stats>& switch_stats,
                                           vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data) {
-    vtr::vector<RRNodeId, std::vector<RREdgeId>> fan_in_list = get_fan_in_list(rr_graph);
-
     vtr::vector<RRIndexedDataId, int> num_nodes_of_index(rr_indexed_data.size(), 0);
     vtr::vector<RRIndexedDataId, std::vector<float>> C_total(rr_indexed_data.size());
     vtr::vector<RRIndexedDataId, std::vector<float>> R_total(rr_indexed_data.size());
@@ -543,14 +696,14 @@ static void load_rr_indexed_data_T_values(const RRGraphView& rr_graph,
 
         RRIndexedDataId cost_index = rr_graph.node_cost_index(rr_id);
 
-        // Get average switch parameters
-        double avg_switch_R = 0;
-        double avg_switch_T = 0;
-        double avg_switch_Cinternal = 0;
-        int num_switches = 0;
-        int num_shorts = 0;
-        short buffered = LIBRRGRAPH_UNDEFINED_VAL;
-        calculate_average_switch(rr_graph, rr_id, avg_switch_R, avg_switch_T, avg_switch_Cinternal, num_switches, num_shorts, buffered, fan_in_list);
+        // Get average switch parameters (computed by gather_wire_stats())
+        const t_wire_switch_stats& node_switch_stats = switch_stats[rr_id];
+        double avg_switch_R = node_switch_stats.avg_switch_R;
+        double avg_switch_T = node_switch_stats.avg_switch_T;
+        double avg_switch_Cinternal = node_switch_stats.avg_switch_Cinternal;
+        int num_switches = node_switch_stats.num_switches;
+        int num_shorts = node_switch_stats.num_shorts;
+        short buffered = node_switch_stats.buffered;
 
         if (num_switches == 0) {
             if (num_shorts == 0) {
@@ -644,13 +797,14 @@ static void load_rr_indexed_data_T_values(const RRGraphView& rr_graph,
 
 static void calculate_average_switch(const RRGraphView& rr_graph,
                                      RRNodeId inode,
-                                     double& avg_switch_R,
-                                     double& avg_switch_T,
-                                     double& avg_switch_Cinternal,
-                                     int& num_switches,
-                                     int& num_shorts,
-                                     short& buffered,
-                                     vtr::vector<RRNodeId, std::vector<RREdgeId>>& fan_in_list) {
+                                     std::span<const RREdgeId> fan_in_edges,
+                                     t_wire_switch_stats& stats) {
+    double& avg_switch_R = stats.avg_switch_R;
+    double& avg_switch_T = stats.avg_switch_T;
+    double& avg_switch_Cinternal = stats.avg_switch_Cinternal;
+    int& num_switches = stats.num_switches;
+    int& num_shorts = stats.num_shorts;
+    short& buffered = stats.buffered;
 
     avg_switch_R = 0;
     avg_switch_T = 0;
@@ -659,7 +813,7 @@ static void calculate_average_switch(const RRGraphView& rr_graph,
     num_shorts = 0;
     buffered = LIBRRGRAPH_UNDEFINED_VAL;
     
-    for (const RREdgeId edge : fan_in_list[inode]) {
+    for (const RREdgeId edge : fan_in_edges) {
         // Want to get C/R/Tdel/Cinternal of switches that connect this track segment to other track segments
         e_rr_type node_type = rr_graph.node_type(inode);
 
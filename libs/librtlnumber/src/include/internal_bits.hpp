@@ -395,11 +395,85 @@ class BitFields {
         return value;
     }
 
+    /**
+     * get/set all the real bits at once
+     */
+    T get_raw() {
+        return this->bits;
+    }
+
+    void set_raw(T value) {
+        this->bits = value;
+    }
+
     static size_t size() {
         return (sizeof(T) << 2); // 8 bit in a byte, 2 bits for a verilog bits = 4 bits in a byte, << 2 = sizeof x 4
     }
 };
 
+/**
+ * split the real bits of a bitfield in the value plane (bit 0 of each verilog bit)
+ * and the unknown plane (bit 1, set for x and z), and merge them back
+ */
+static_assert(sizeof(veri_internal_bits_t) == 2, "the planes are split 16 real bits at a time");
+
+inline uint64_t compact_plane(veri_internal_bits_t raw) {
+    uint64_t plane = raw & 0x5555;
+    plane = (plane | (plane >> 1)) & 0x3333;
+    plane = (plane | (plane >> 2)) & 0x0F0F;
+    plane = (plane | (plane >> 4)) & 0x00FF;
+    return plane;
+}
+
+inline veri_internal_bits_t spread_plane(uint64_t plane) {
+    plane &= 0x00FF;
+    plane = (plane | (plane << 4)) & 0x0F0F;
+    plane = (plane | (plane << 2)) & 0x3333;
+    plane = (plane | (plane << 1)) & 0x5555;
+    return static_cast<veri_internal_bits_t>(plane);
+}
+
+/**
+ * the 64 verilog bits of a word that are all of one value, as planes
+ */
+inline uint64_t fill_value_plane(bit_value_t value) {
+    return (value & 0x1) ? ~0x0ULL : 0x0ULL;
+}
+
+inline uint64_t fill_unknown_plane(bit_value_t value) {
+    return (value & 0x2) ? ~0x0ULL : 0x0ULL;
+}
+
+/**
+ * apply a truth table to whole words at once: every one of the 4 (or 4 x 4) input
+ * combinations selects the verilog bits it covers, and sets the planes of its result on them
+ */
+inline void word_lut(const bit_value_t lut[4], uint64_t value, uint64_t unknown, uint64_t& result_value, uint64_t& result_unknown) {
+    const uint64_t is_value[4] = {~value & ~unknown, value & ~unknown, ~value & unknown, value & unknown};
+
+    result_value = 0x0;
+    result_unknown = 0x0;
+    for (bit_value_t i = _0; i <= _z; i++) {
+        result_value |= is_value[i] & fill_value_plane(lut[i]);
+        result_unknown |= is_value[i] & fill_unknown_plane(lut[i]);
+    }
+}
+
+inline void word_lut(const bit_value_t lut[4][4], uint64_t value_a, uint64_t unknown_a, uint64_t value_b, uint64_t unknown_b, uint64_t& result_value, uint64_t& result_unknown) {
+    const uint64_t is_a[4] = {~value_a & ~unknown_a, value_a & ~unknown_a, ~value_a & unknown_a, value_a & unknown_a};
+    const uint64_t is_b[4] = {~value_b & ~unknown_b, value_b & ~unknown_b, ~value_b & unknown_b, value_b & unknown_b};
+
+    result_value = 0x0;
+    result_unknown = 0x0;
+    for (bit_value_t i = _0; i <= _z; i++) {
+        for (bit_value_t j = _0; j <= _z; j++) {
+            uint64_t selected = is_a[i] & is_b[j];
+            result_value |= selected & fill_value_plane(lut[i][j]);
+            result_unknown |= selected & fill_unknown_plane(lut[i][j]);
+        }
+    }
+}
+
 // #define DEBUG_V_BITS
 
 /*****
@@ -418,7 +492,16 @@ class VerilogBits {
         return this->bits.size();
     }
 
+    static size_t fields_per_word() {
+        return (word_size / BitFields<veri_internal_bits_t>::size());
+    }
+
   public:
+    /**
+     * the bits are also accessed 64 at a time as words split in a value plane and an unknown plane
+     * (see compact_plane()), so that the known values are processed as native integers
+     */
+    static constexpr size_t word_size = 64;
     VerilogBits() {
         this->bit_size = 0;
         this->bits = std::vector<BitSpace::BitFields<veri_internal_bits_t>>();
@@ -430,9 +513,7 @@ class VerilogBits {
 
         size_t bitfield_count = (this->bit_size / BitFields<veri_internal_bits_t>::size()) + 1;
 
-        for (size_t i = 0; i < bitfield_count; i++) {
-            this->bits.push_back(BitSpace::BitFields<veri_internal_bits_t>(value_in));
-        }
+        this->bits.assign(bitfield_count, BitSpace::BitFields<veri_internal_bits_t>(value_in));
     }
 
     VerilogBits(VerilogBits* other) {
@@ -480,6 +561,85 @@ class VerilogBits {
         (this->get_bitfield(to_index(address))->set_bit(address, value));
     }
 
+    size_t word_count() {
+        return ((this->bit_size + word_size - 1) / word_size);
+    }
+
+    /**
+     * mask of the bits of a word that are within the size
+     */
+    uint64_t word_mask(size_t word_index) {
+        size_t first_bit = word_index * word_size;
+        if (first_bit >= this->bit_size)
+            return 0x0;
+        else if (this->bit_size - first_bit >= word_size)
+            return ~0x0ULL;
+        else
+            return ((0x1ULL << (this->bit_size - first_bit)) - 1);
+    }
+
+    /**
+     * get the planes of a word, the bits past the size read as 0
+     */
+    uint64_t get_word(size_t word_index, uint64_t& unknown) {
+        uint64_t value = 0x0;
+        unknown = 0x0;
+
+        size_t first_field = word_index * fields_per_word();
+        for (size_t i = 0; i < fields_per_word() && (first_field + i) < this->list_size(); i++) {
+            veri_internal_bits_t raw = this->bits[first_field + i].get_raw();
+            size_t shift = i * BitFields<veri_internal_bits_t>::size();
+            value |= compact_plane(raw) << shift;
+            unknown |= compact_plane(static_cast<veri_internal_bits_t>(raw >> 1)) << shift;
+        }
+
+        uint64_t mask = this->word_mask(word_index);
+        unknown &= mask;
+        return (value & mask);
+    }
+
+    /**
+     * get the planes of the 64 bits from address up, the bits past the size read as pad
+     */
+    uint64_t get_bits(size_t address, bit_value_t pad, uint64_t& unknown) {
+        size_t word_index = address / word_size;
+        size_t offset = address % word_size;
+
+        uint64_t value = this->get_word(word_index, unknown);
+        uint64_t mask = this->word_mask(word_index);
+        value >>= offset;
+        unknown >>= offset;
+        mask >>= offset;
+
+        if (offset) {
+            uint64_t next_unknown = 0x0;
+            value |= this->get_word(word_index + 1, next_unknown) << (word_size - offset);
+            unknown |= next_unknown << (word_size - offset);
+            mask |= this->word_mask(word_index + 1) << (word_size - offset);
+        }
+
+        value |= ~mask & fill_value_plane(pad);
+        unknown |= ~mask & fill_unknown_plane(pad);
+        return value;
+    }
+
+    /**
+     * set the planes of a word, the bits past the size are left alone
+     */
+    void set_word(size_t word_index, uint64_t value, uint64_t unknown) {
+        uint64_t mask = this->word_mask(word_index);
+
+        size_t first_field = word_index * fields_per_word();
+        for (size_t i = 0; i < fields_per_word() && (first_field + i) < this->list_size(); i++) {
+            size_t shift = i * BitFields<veri_internal_bits_t>::size();
+            veri_internal_bits_t field_mask = static_cast<veri_internal_bits_t>(spread_plane(mask >> shift) * 0x3);
+            veri_internal_bits_t raw = static_cast<veri_internal_bits_t>(spread_plane(value >> shift) | (spread_plane(unknown >> shift) << 1));
+
+            BitFields<veri_internal_bits_t>& field = this->bits[first_field + i];
+            field.set_raw(static_cast<veri_internal_bits_t>((field.get_raw() & ~field_mask) | (raw & field_mask)));
+        }
+    }
+
     std::string to_printable() {
         std::string to_return = "";
 
@@ -496,8 +656,10 @@ class VerilogBits {
     }
 
     bool has_unknown() {
-        for (size_t address = 0x0; address < this->size(); address++) {
-            if (is_unk[this->get_bit(address)])
+        for (size_t word_index = 0; word_index < this->word_count(); word_index++) {
+            uint64_t unknown = 0x0;
+            this->get_word(word_index, unknown);
+            if (unknown)
                 return true;
         }
 
@@ -505,8 +667,10 @@ class VerilogBits {
     }
 
     bool is_only_z() {
-        for (size_t address = 0x0; address < this->size(); address++) {
-            if (!is_z_bit[this->get_bit(address)])
+        for (size_t word_index = 0; word_index < this->word_count(); word_index++) {
+            uint64_t unknown = 0x0;
+            uint64_t value = this->get_word(word_index, unknown);
+            if ((value & unknown) != this->word_mask(word_index))
                 return false;
         }
 
@@ -514,8 +678,10 @@ class VerilogBits {
     }
 
     bool is_only_x() {
-        for (size_t address = 0x0; address < this->size(); address++) {
-            if (!is_x_bit[this->get_bit(address)])
+        for (size_t word_index = 0; word_index < this->word_count(); word_index++) {
+            uint64_t unknown = 0x0;
+            uint64_t value = this->get_word(word_index, unknown);
+            if ((~value & unknown) != this->word_mask(word_index))
                 return false;
         }
 
@@ -523,8 +689,10 @@ class VerilogBits {
     }
 
     bool is_true() {
-        for (size_t address = 0x0; address < this->size(); address++) {
-            if (is_one_bit[this->get_bit(address)])
+        for (size_t word_index = 0; word_index < this->word_count(); word_index++) {
+            uint64_t unknown = 0x0;
+            uint64_t value = this->get_word(word_index, unknown);
+            if (value & ~unknown)
                 return true;
         }
 
@@ -532,8 +700,10 @@ class VerilogBits {
     }
 
     bool is_false() {
-        for (size_t address = 0x0; address < this->size(); address++) {
-            if (!is_zero_bit[this->get_bit(address)])
+        for (size_t word_index = 0; word_index < this->word_count(); word_index++) {
+            uint64_t unknown = 0x0;
+            uint64_t value = this->get_word(word_index, unknown);
+            if (value | unknown)
                 return false;
         }
 
@@ -559,8 +729,15 @@ class VerilogBits {
     VerilogBits bitwise(const bit_value_t lut[4]) {
         VerilogBits other(this->bit_size, _0);
 
-        for (size_t i = 0; i < this->size(); i++)
-            other.set_bit(i, lut[this->get_bit(i)]);
+        for (size_t word_index = 0; word_index < this->word_count(); word_index++) {
+            uint64_t unknown = 0x0;
+            uint64_t value = this->get_word(word_index, unknown);
+
+            uint64_t result_unknown = 0x0;
+            uint64_t result_value = 0x0;
+            word_lut(lut, value, unknown, result_value, result_unknown);
+            other.set_word(word_index, result_value, result_unknown);
+        }
 
         return other;
     }
@@ -568,6 +745,21 @@ class VerilogBits {
     VerilogBits twos_complement(BitSpace::bit_value_t previous_carry) {
         VerilogBits other(this->bit_size, _0);
 
+        if (!is_unk[previous_carry] && !this->has_unknown()) {
+            // invert and add the carry one word at a time
+            uint64_t carry = previous_carry;
+            for (size_t word_index = 0; word_index < this->word_count(); word_index++) {
+                uint64_t unknown = 0x0;
+                uint64_t value = ~this->get_word(word_index, unknown);
+
+                uint64_t sum = value + carry;
+                carry = (sum < value) ? 1 : 0;
+                other.set_word(word_index, sum, 0x0);
+            }
+
+            return other;
+        }
+
         for (size_t i = 0; i < this->size(); i++) {
             BitSpace::bit_value_t not_bit_i = BitSpace::l_not[this->get_bit(i)];
 
@@ -610,16 +802,10 @@ class VerilogBits {
 
         VerilogBits other(new_size, BitSpace::_0);
 
-        size_t i = 0;
-
-        while (i < this->size() && i < new_size) {
-            other.set_bit(i, this->get_bit(i));
-            i++;
-        }
-
-        while (i < new_size) {
-            other.set_bit(i, pad); /* <- ask Eve about it */
-            i++;
+        for (size_t word_index = 0; word_index < other.word_count(); word_index++) {
+            uint64_t unknown = 0x0;
+            uint64_t value = this->get_bits(word_index * word_size, pad, unknown); /* <- ask Eve about it */
+            other.set_word(word_index, value, unknown);
         }
 
         return other;
@@ -727,24 +913,13 @@ class VNumber {
         assert_Werr((!this->bitstring.has_unknown()),
                     "Invalid Number contains dont care values. number: " + this->to_verilog_bitstring());
 
-        size_t end = this->size();
-        if (end > integer_t_size) {
+        if (this->size() > integer_t_size) {
             printf(" === Warning: Returning a 64 bit integer from a larger bitstring (%zu). The bitstring will be truncated\n", bit_size);
-            end = bit_size;
-        }
-
-        integer_t result = 0;
-        BitSpace::bit_value_t pad = this->get_padding_bit();
-
-        for (size_t bit_index = 0; bit_index < end; bit_index++) {
-            integer_t current_bit = static_cast<integer_t>(pad);
-            if (bit_index < this->size())
-                current_bit = this->bitstring.get_bit(bit_index);
-
-            result |= (current_bit << bit_index);
         }
 
-        return result;
+        // the bits are not sign extended past the size
+        uint64_t unknown = 0x0;
+        return static_cast<integer_t>(this->get_bits_from_lsb(0, BitSpace::_0, unknown));
     }
 
     std::string to_string(bool big_endian, bool uppercase) {
@@ -967,7 +1142,16 @@ class VNumber {
     }
 
     void set_value(int64_t in) {
-        this->set_value(std::to_string(in));
+        if (in < 0) {
+            this->set_value(std::to_string(in));
+            return;
+        }
+
+        // same as the unsized decimal string of the value, without going through it
+        this->sign = true;
+        this->defined_size = false;
+        this->bitstring = BitSpace::VerilogBits(32, BitSpace::_0);
+        this->bitstring.set_word(0, static_cast<uint64_t>(in), 0x0);
     }
 
     size_t msb_index() {
@@ -997,6 +1181,25 @@ class VNumber {
         this->bitstring.set_bit(index, val);
     }
 
+    /****
+     * word functions, 64 bits at a time (see BitSpace::VerilogBits::get_word())
+     */
+    size_t word_count() {
+        return this->bitstring.word_count();
+    }
+
+    uint64_t get_bits_from_lsb(size_t index, BitSpace::bit_value_t pad, uint64_t& unknown) {
+        return this->bitstring.get_bits(index, pad, unknown);
+    }
+
+    uint64_t get_bits_from_lsb(size_t index, uint64_t& unknown) {
+        return this->get_bits_from_lsb(index, this->get_padding_bit(), unknown);
+    }
+
+    void set_word_from_lsb(size_t word_index, uint64_t value, uint64_t unknown) {
+        this->bitstring.set_word(word_index, value, unknown);
+    }
+
     /***
      *  other
      */
@@ -1077,16 +1280,19 @@ class VNumber {
 
         VNumber result(std_length, BitSpace::_x, false, this->is_defined_size() && b.is_defined_size());
 
-        for (size_t i = 0; i < result.size(); i++) {
-            BitSpace::bit_value_t bit_a = pad_a;
-            if (i < this->size())
-                bit_a = this->get_bit_from_lsb(i);
+        for (size_t word_index = 0; word_index < result.word_count(); word_index++) {
+            size_t index = word_index * BitSpace::VerilogBits::word_size;
+
+            uint64_t unknown_a = 0x0;
+            uint64_t value_a = this->get_bits_from_lsb(index, pad_a, unknown_a);
 
-            BitSpace::bit_value_t bit_b = pad_b;
-            if (i < b.size())
-                bit_b = b.get_bit_from_lsb(i);
+            uint64_t unknown_b = 0x0;
+            uint64_t value_b = b.get_bits_from_lsb(index, pad_b, unknown_b);
 
-            result.set_bit_from_lsb(i, lut[bit_a][bit_b]);
+            uint64_t result_unknown = 0x0;
+            uint64_t result_value = 0x0;
+            BitSpace::word_lut(lut, value_a, unknown_a, value_b, unknown_b, result_value, result_unknown);
+            result.set_word_from_lsb(word_index, result_value, result_unknown);
         }
 
         return result;
@@ -76,6 +76,31 @@ static compare_bit eval_op(VNumber& a_in, VNumber& b_in) {
     bit_value_t pad_a = a.get_padding_bit();
     bit_value_t pad_b = b.get_padding_bit();
 
+    if (!a.has_unknown() && !b.has_unknown()) {
+        // known values compare as unsigned words, from the most significant one
+        size_t word_count = (std_length + VerilogBits::word_size - 1) / VerilogBits::word_size;
+        uint64_t top_mask = ~0x0ULL >> (word_count * VerilogBits::word_size - std_length);
+
+        for (size_t word_index = word_count - 1; word_index < word_count; word_index--) {
+            uint64_t unknown = 0x0;
+            uint64_t word_a = a.get_bits_from_lsb(word_index * VerilogBits::word_size, pad_a, unknown);
+            uint64_t word_b = b.get_bits_from_lsb(word_index * VerilogBits::word_size, pad_b, unknown);
+
+            if (word_index == word_count - 1) {
+                word_a &= top_mask;
+                word_b &= top_mask;
+            }
+
+            if (word_a < word_b) {
+                return (!invert_result) ? LT_EVAL : GT_EVAL;
+            } else if (word_a > word_b) {
+                return (!invert_result) ? GT_EVAL : LT_EVAL;
+            }
+        }
+
+        return EQ_EVAL;
+    }
+
     for (size_t i = std_length - 1; i < std_length; i--) {
         bit_value_t bit_a = pad_a;
         if (i < a.size()) {
@@ -143,6 +168,26 @@ static VNumber sum_op(VNumber& a, VNumber& b, const bit_value_t& initial_carry,
     bit_value_t previous_carry = initial_carry;
     VNumber result(new_length, _0, is_addition_signed_operation, a.is_defined_size() && b.is_defined_size());
 
+    if (!is_unk[initial_carry] && !a.has_unknown() && !b.has_unknown()) {
+        // known values add as words, with the carry going from one word to the next
+        uint64_t carry = initial_carry;
+        for (size_t word_index = 0; word_index < result.word_count(); word_index++) {
+            uint64_t unknown = 0x0;
+            uint64_t word_a = a.get_bits_from_lsb(word_index * VerilogBits::word_size, pad_a, unknown);
+            uint64_t word_b = b.get_bits_from_lsb(word_index * VerilogBits::word_size, pad_b, unknown);
+
+            uint64_t sum = word_a + word_b;
+            uint64_t next_carry = (sum < word_a) ? 1 : 0;
+            sum += carry;
+            next_carry |= (sum < carry) ? 1 : 0;
+
+            result.set_word_from_lsb(word_index, sum, 0x0);
+            carry = next_carry;
+        }
+
+        return result;
+    }
+
     for (size_t i = 0; i < new_length; i++) {
         bit_value_t bit_a = pad_a;
         if (i < a.size()) {
@@ -172,15 +217,34 @@ static VNumber shift_op(VNumber& a, int64_t b, bool sign_shift) {
         size_t u_b = static_cast<size_t>(-b);
         bit_value_t pad = (sign_shift) ? a.get_padding_bit() : BitSpace::_0;
         to_return = VNumber(a.size(), pad, sign_shift, a.is_defined_size());
-        for (size_t i = 0; i < (a.size() - u_b); i++) {
-            to_return.set_bit_from_lsb(i, a.get_bit_from_lsb(i + u_b));
+        for (size_t word_index = 0; word_index < to_return.word_count(); word_index++) {
+            uint64_t unknown = 0x0;
+            uint64_t value = a.get_bits_from_lsb(word_index * VerilogBits::word_size + u_b, pad, unknown);
+            to_return.set_word_from_lsb(word_index, value, unknown);
         }
     } else {
         size_t u_b = static_cast<size_t>(b);
         bit_value_t pad = BitSpace::_0;
         to_return = VNumber((a.size() + u_b), pad, sign_shift, a.is_defined_size());
-        for (size_t i = 0; i < a.size(); i++) {
-            to_return.set_bit_from_lsb(i + u_b, a.get_bit_from_lsb(i));
+
+        // the words of the result take the bits of "a" from u_b below them up, the first ones are all 0
+        size_t word_shift = u_b / VerilogBits::word_size;
+        size_t bit_shift = u_b % VerilogBits::word_size;
+        for (size_t word_index = word_shift; word_index < to_return.word_count(); word_index++) {
+            size_t first_bit = (word_index - word_shift) * VerilogBits::word_size;
+
+            uint64_t unknown = 0x0;
+            uint64_t value = a.get_bits_from_lsb(first_bit, pad, unknown) << bit_shift;
+            unknown <<= bit_shift;
+
+            if (bit_shift && first_bit) {
+                uint64_t lower_mask = (0x1ULL << bit_shift) - 1;
+                uint64_t lower_unknown = 0x0;
+                value |= a.get_bits_from_lsb(first_bit - bit_shift, pad, lower_unknown) & lower_mask;
+                unknown |= lower_unknown & lower_mask;
+            }
+
+            to_return.set_word_from_lsb(word_index, value, unknown);
         }
     }
     return to_return;
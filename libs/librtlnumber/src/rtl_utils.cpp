@@ -9,6 +9,7 @@
 #include "rtl_utils.hpp"
 #include <algorithm>
 #include <iostream>
+#include <limits>
 
 static const char* base_10_digits = "0123456789";
 
@@ -263,6 +264,21 @@ std::string string_of_radix_to_bitstring(std::string orig_string, size_t radix)
             break;
     }
 
+    if (radix == 10 && orig_string.size() < std::numeric_limits<uint64_t>::digits10) {
+        // small decimals convert as native integers rather than by long division
+        uint64_t value = 0;
+        for (char current_digit : orig_string) {
+            value = (value * 10) + to_decimal(current_digit);
+        }
+
+        do {
+            result.insert(result.begin(), base_10_digits[value % 2]);
+            value /= 2;
+        } while (value);
+
+        orig_string = "";
+    }
+
     while (!orig_string.empty()) {
         switch (radix) {
             case 10: {
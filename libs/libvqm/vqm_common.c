@@ -119,6 +119,24 @@ void vqm_data_cleanup()
 		free(module_list);
 		module_list = NULL;
 	}
+	/* Free the pin hash table, its keys belong to the pins */
+	if (pin_hash != NULL)
+	{
+		size_t index;
+		for(index = 0; index < pin_hash->size; index++)
+		{
+			t_hash_elem *entry = pin_hash->table[index].next;
+			while (entry != NULL)
+			{
+				t_hash_elem *next = entry->next;
+				free(entry);
+				entry = next;
+			}
+		}
+		free(pin_hash->table);
+		free(pin_hash);
+		pin_hash = NULL;
+	}
 	/* Set other reference lists to NULL */
 	module_list = NULL;
 	assignment_list = NULL;
@@ -264,6 +282,9 @@ void add_module(char *name, t_array_ref **pins, t_array_ref **assignments, t_arr
 	t_array_ref *m_assig = *assignments;
 	t_array_ref *m_nodes = *nodes;
 
+	/* The last node of a streaming parse is complete */
+	flush_streamed_node(parse_info);
+
 	new_module = (t_module *) malloc(sizeof(t_module));
 
 	VTR_ASSERT(new_module != NULL);
@@ -357,7 +378,7 @@ t_pin_def *add_pin(char *name, int left, int right, t_pin_def_type type, t_parse
 
         //Allocate twice as many spaces in the hash table as is needed, this should prevent
         //the table from becoming too full.
-        pin_hash->table = (t_hash_elem*) malloc(2*parse_info->number_of_pins*sizeof(t_hash_elem));
+        pin_hash->table = (t_hash_elem*) calloc(2*parse_info->number_of_pins, sizeof(t_hash_elem));
         pin_hash->size = 2*parse_info->number_of_pins;
     }
 
@@ -442,8 +463,8 @@ void add_assignment(t_pin_def *source, int source_index, t_pin_def *target, int
 		target_index = target->left-1;
 	}
 
-	/* Create assignment statement list if not present already */
-	if (assignment_list == NULL)
+	/* Create assignment statement list if not present already, unless the assignments are streamed */
+	if (assignment_list == NULL && parse_info->callbacks == NULL)
 	{
 		assignment_list = (t_array_ref *) malloc(sizeof(t_array_ref));
 
@@ -469,7 +490,7 @@ void add_assignment(t_pin_def *source, int source_index, t_pin_def *target, int
 		assignment->inversion = invert;
 
 		/* Add this assignment statement to list of assignment statements */
-        append_array_element( (intptr_t) assignment, assignment_list);
+        store_assignment(assignment, parse_info);
 	}
 	else
 	{
@@ -506,7 +527,7 @@ void add_assignment(t_pin_def *source, int source_index, t_pin_def *target, int
 			assignment->inversion = invert;
 
 			/* Add this assignment statement to list of assignment statements */
-            append_array_element( (intptr_t) assignment, assignment_list);
+            store_assignment(assignment, parse_info);
 		}
 	}
 }
@@ -572,6 +593,17 @@ void add_node(char* type, char *name, t_array_ref **ports, t_parse_info* parse_i
 	my_node->array_of_ports = (t_node_port_association **) m_ports->pointer;
 	my_node->number_of_ports = m_ports->array_size;
 
+	if (parse_info->callbacks != NULL)
+	{
+		/* The previous node is complete, and this one is kept until its parameters are read */
+		flush_streamed_node(parse_info);
+		most_recently_used_node = my_node;
+
+		free(m_ports);
+		*ports = NULL;
+		return;
+	}
+
 	if (node_list == NULL)
 	{
 		node_list = (t_array_ref *)malloc(sizeof(t_array_ref));
@@ -595,6 +627,44 @@ void add_node(char* type, char *name, t_array_ref **ports, t_parse_info* parse_i
 }
 
 
+void store_assignment(t_assign *assignment, t_parse_info* parse_info)
+/* Add the assignment to the list of assignments, or pass it to the callback of a streaming parse and free it. */
+{
+	t_vqm_callbacks *callbacks = parse_info->callbacks;
+
+	if (callbacks == NULL)
+	{
+		append_array_element( (intptr_t) assignment, assignment_list);
+		return;
+	}
+
+	if (callbacks->on_assignment != NULL)
+	{
+		callbacks->on_assignment(assignment, callbacks->user_data);
+	}
+	free_assignment(assignment);
+}
+
+
+void flush_streamed_node(t_parse_info* parse_info)
+/* Pass the node being read by a streaming parse, if any, to the callback and free it. */
+{
+	t_vqm_callbacks *callbacks = parse_info->callbacks;
+
+	if (callbacks == NULL || most_recently_used_node == NULL)
+	{
+		return;
+	}
+
+	if (callbacks->on_node != NULL)
+	{
+		callbacks->on_node(most_recently_used_node, callbacks->user_data);
+	}
+	free_node(most_recently_used_node);
+	most_recently_used_node = NULL;
+}
+
+
 t_identifier_pass *allocate_identifier(char *name, t_boolean indexed, int index)
 /* Allocate memory for temporary identifier specification.
  */
@@ -1231,7 +1301,7 @@ void add_concatenation_assignments(t_array_ref *con_array, t_pin_def *target_pin
 }
 
 
-void define_instance_parameter(t_identifier_pass *identifier, char *parameter_name, char *string_value, int integer_value)
+void define_instance_parameter(t_identifier_pass *identifier, char *parameter_name, char *string_value, int integer_value, t_parse_info* parse_info)
 /* This function creates a parameter for an instance of a module. */
 {
 	/* To create a proper identifier name, append [<wire_index>] if
@@ -1264,6 +1334,12 @@ void define_instance_parameter(t_identifier_pass *identifier, char *parameter_na
 	{
 		local_node = most_recently_used_node;
 	}
+	else if (parse_info->callbacks != NULL)
+	{
+		/* The earlier nodes of a streaming parse are gone */
+		printf("ERROR: The parameter %s of node %s does not follow the node, which a streaming parse requires.\n", parameter_name, name);
+		exit(1);
+	}
 	else
 	{
 		/* If not then look for a node with the specified name */
@@ -64,13 +64,15 @@ t_pin_def			*add_pin(char *name, int left, int right, t_pin_def_type type, t_par
 void				add_assignment(t_pin_def *source, int source_index, t_pin_def *target, int target_index, t_boolean tristated,
 						   t_pin_def *tri_control, int tri_control_index, int constant, t_boolean invert, t_parse_info* parse_info);
 void				add_node(char* type, char *name, t_array_ref **ports, t_parse_info* parse_info);
+void				store_assignment(t_assign *assignment, t_parse_info* parse_info);
+void				flush_streamed_node(t_parse_info* parse_info);
 t_identifier_pass	*allocate_identifier(char *name, t_boolean indexed, int index);
 t_pin_def			*locate_net_by_name(char *name);
 t_array_ref			*associate_identifier_with_port_name(t_identifier_pass *identifier, char *port_name, int port_index);
 t_node				*locate_node_by_name(char *name);
 void				create_pins_from_list(t_array_ref **list_of_pins, int left, int right, t_pin_def_type type, t_boolean indexed, t_parse_info* parse_info);
 t_array_ref			*create_array_of_net_to_port_assignments(t_array_ref *con_array);
-void				define_instance_parameter(t_identifier_pass *identifier, char *parameter_name, char *string_value, int integer_value);
+void				define_instance_parameter(t_identifier_pass *identifier, char *parameter_name, char *string_value, int integer_value, t_parse_info* parse_info);
 void				add_concatenation_assignments(t_array_ref *con_array, t_pin_def *target_pin, t_boolean invert_wire, t_parse_info* parse_info);
 t_array_ref			*create_wire_port_connections(t_array_ref *concat_array, char *port_name);
 
@@ -42,8 +42,9 @@
 }*/
 
 
-VQM_DLL_API t_module *vqm_parse_file(char *filename)
-/* Parse a VQM file and return the module contained within it. Return NULL on failure. */
+static t_module *parse_vqm(char *filename, t_vqm_callbacks *callbacks)
+/* Parse a VQM file and return the module contained within it, streaming its assignments
+ * and nodes to the callbacks if any. Return NULL on failure. */
 {
 	t_module	*my_module = NULL;
     
@@ -56,6 +57,7 @@ VQM_DLL_API t_module *vqm_parse_file(char *filename)
     parse_info->number_of_assignments = 0;
     parse_info->number_of_nodes = 0;
     parse_info->number_of_modules = 0;
+    parse_info->callbacks = callbacks;
 
 	yyin = fopen(filename,"r");
 	if (yyin != NULL)
@@ -110,6 +112,20 @@ VQM_DLL_API t_module *vqm_parse_file(char *filename)
 	return my_module;
 }
 
+VQM_DLL_API t_module *vqm_parse_file(char *filename)
+/* Parse a VQM file and return the module contained within it. Return NULL on failure. */
+{
+	return parse_vqm(filename, NULL);
+}
+
+VQM_DLL_API t_module *vqm_parse_file_streaming(char *filename, t_vqm_callbacks *callbacks)
+/* Parse a VQM file, passing each of its assignments and nodes to the callbacks instead of
+ * keeping them, and return the module (with its pins only). Return NULL on failure. */
+{
+	assert(callbacks != NULL);
+	return parse_vqm(filename, callbacks);
+}
+
 VQM_DLL_API int vqm_get_error_message(char *message_buffer, int length)
 {
     int result = -1;
@@ -18,6 +18,14 @@
  * 3.		Free memory taken by the VQM data structures by calling the following function:
  *				vqm_data_cleanup();
  *
+ * Streaming parse:
+ * To avoid keeping every node and assignment of a large VQM file in memory, call
+ * vqm_parse_file_streaming(char *, t_vqm_callbacks *) instead of vqm_parse_file. Each assignment statement and
+ * each node (with its parameters) is then passed to a callback as soon as it is complete, and freed when the callback
+ * returns. The returned module only contains the pins, which the assignments and nodes point to and which remain
+ * valid until vqm_data_cleanup() is called. The parameters of a node must directly follow it in the file,
+ * as Quartus writes them.
+ *
  * Data structures:
  * The data structure returned by the vqm_parse_file function is a t_module structure. This structure consists of a module name,
  * an array of pins, an array of statements and an array of nodes. The array of pins contains a set of input, output and bidirectional
@@ -284,6 +292,16 @@ typedef struct s_rvalue {
  */
 typedef enum e_parsing_pass_type { COUNT_PASS = 0, ALLOCATE_PASS} t_parsing_pass_type;
 
+/*
+ * Callbacks of a streaming parse, called with the user_data pointer. Either may be NULL to ignore
+ * the assignments or the nodes. The structures passed are freed when the callback returns.
+ */
+typedef struct s_vqm_callbacks {
+    void (*on_assignment)(t_assign *assignment, void *user_data);
+    void (*on_node)(t_node *node, void *user_data);
+    void *user_data;
+} t_vqm_callbacks;
+
 /*
  * Structure used to count number of elements during counting pass
  */
@@ -293,6 +311,9 @@ typedef struct s_parse_info {
     int number_of_assignments;
     int number_of_nodes;
     int number_of_modules;
+
+    /* Callbacks of a streaming parse, NULL when the whole module is kept */
+    t_vqm_callbacks *callbacks;
 } t_parse_info;
 
 /*
@@ -326,11 +347,13 @@ typedef struct s_index_pass {
 #if !defined(TESTING_DLL_FUNCTIONS)
 VQM_DLL_API t_array_ref *vqm_get_module_list();
 VQM_DLL_API t_module *vqm_parse_file(char *filename);
+VQM_DLL_API t_module *vqm_parse_file_streaming(char *filename, t_vqm_callbacks *callbacks);
 VQM_DLL_API void vqm_data_cleanup();
 VQM_DLL_API int vqm_get_error_message(char *message_buffer, int length);
 #else
 t_array_ref *vqm_get_module_list();
 t_module *vqm_parse_file(char *filename);
+t_module *vqm_parse_file_streaming(char *filename, t_vqm_callbacks *callbacks);
 void vqm_data_cleanup();
 #endif
 
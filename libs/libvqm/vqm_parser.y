@@ -459,7 +459,7 @@ DefParamStatement:	TOKEN_DEFPARAM Identifier '.' TOKEN_REGULARID '=' stringConst
                             /* To create a proper identifier name, append [<wire_index>] if
                              * and only if the identifier is indexed. Ignore it otherwise. */
                             t_identifier_pass *identifier = (t_identifier_pass *) $2;
-                            define_instance_parameter(identifier, $4, $6, 0);
+                            define_instance_parameter(identifier, $4, $6, 0, parse_info);
                             free(identifier->name);
                             free(identifier);
                         }
@@ -472,7 +472,7 @@ DefParamStatement:	TOKEN_DEFPARAM Identifier '.' TOKEN_REGULARID '=' stringConst
                                 /* To create a proper identifier name, append [<wire_index>] if
                                  * and only if the identifier is indexed. Ignore it otherwise. */
                                 t_identifier_pass *identifier = (t_identifier_pass *) $2;
-                                define_instance_parameter(identifier, $4, NULL, $6);
+                                define_instance_parameter(identifier, $4, NULL, $6, parse_info);
                                 free(identifier->name);
                                 free(identifier);
                         }
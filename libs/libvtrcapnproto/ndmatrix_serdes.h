@@ -5,6 +5,8 @@
 // Functions:
 //  ToNdMatrix - Converts Matrix capnproto message to vtr::NdMatrix
 //  FromNdMatrix - Converts vtr::NdMatrix to Matrix capnproto
+//  AliasNdMatrix - Uses a RawMatrix capnproto message as the storage of vtr::NdMatrix
+//  FromNdMatrixRaw - Converts vtr::NdMatrix to RawMatrix capnproto
 //
 // Example:
 //
@@ -56,7 +58,11 @@
 //      ToNdMatrix<3, Test::Vec2, Vec2>(&mat_out, test.getVectors(), FromVec2);
 //  }
 
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include <functional>
+#include <memory>
 #include "vtr_ndmatrix.h"
 #include "vpr_error.h"
 #include "matrix.capnp.h"
@@ -137,3 +143,94 @@ void FromNdMatrix(
         copy_fun(&elem, m_in.get(i));
     }
 }
+
+// Returns true if this host stores integers least significant byte first.
+inline bool HostIsLittleEndian() {
+    const uint16_t one = 1;
+    uint8_t first_byte;
+    std::memcpy(&first_byte, &one, 1);
+    return first_byte == 1;
+}
+
+// Generic function to use a RawMatrix capnproto message as the (read-only)
+// storage of a vtr::NdMatrix, without copying it.
+//
+// Template arguments:
+//  N = Number of matrix dimensions, must be fixed.
+//  CType = Element type of vtr::NdMatrix, as written by FromNdMatrixRaw.
+//
+// Arguments:
+//  m_out = Target vtr::NdMatrix, which must not be modified after.
+//  m_in = Source capnproto message reader.
+//  owner = Owner of the message memory (e.g. the MmapFile it was read from),
+//          kept alive by m_out.
+template<size_t N, typename CType>
+void AliasNdMatrix(
+    vtr::NdMatrix<CType, N>* m_out,
+    const RawMatrix::Reader& m_in,
+    std::shared_ptr<const void> owner) {
+    static_assert(alignof(CType) <= sizeof(::capnp::word), "Elements must not be aligned beyond the capnp words");
+
+    const auto& dims = m_in.getDims();
+    if (N != dims.size()) {
+        VPR_THROW(VPR_ERROR_OTHER,
+                  "Wrong dimension of template N = %zu, m_in.getDims() = %zu",
+                  N, dims.size());
+    }
+    if (m_in.getElementSize() != sizeof(CType) || m_in.getLittleEndian() != HostIsLittleEndian()) {
+        VPR_THROW(VPR_ERROR_OTHER,
+                  "Matrix elements written by a host with a different layout (%u bytes, %s endian), regenerate the file on this host",
+                  m_in.getElementSize(), m_in.getLittleEndian() ? "little" : "big");
+    }
+
+    std::array<size_t, N> dim_sizes;
+    size_t required_elements = 1;
+    for (size_t i = 0; i < N; ++i) {
+        dim_sizes[i] = dims[i];
+        required_elements *= dims[i];
+    }
+
+    const auto& data = m_in.getData();
+    if (data.size() != required_elements * sizeof(CType)) {
+        VPR_THROW(VPR_ERROR_OTHER,
+                  "Wrong data size, expected %zu, actual %zu",
+                  required_elements * sizeof(CType), data.size());
+    }
+
+    if (required_elements == 0) {
+        m_out->resize(dim_sizes);
+        return;
+    }
+    m_out->alias(dim_sizes, reinterpret_cast<const CType*>(data.begin()), std::move(owner));
+}
+
+// Generic function to convert from vtr::NdMatrix to RawMatrix capnproto message
+// (the mirror function of AliasNdMatrix).
+//
+// Template arguments:
+//  N = Number of matrix dimensions, must be fixed.
+//  CType = Trivially copyable element type of vtr::NdMatrix.
+//
+// Arguments:
+//  m_out = Target capnproto message builder.
+//  m_in = Source vtr::NdMatrix.
+template<size_t N, typename CType>
+void FromNdMatrixRaw(
+    RawMatrix::Builder* m_out,
+    const vtr::NdMatrix<CType, N>& m_in) {
+    static_assert(std::is_trivially_copyable<CType>::value, "Only plain elements can be stored raw");
+
+    size_t elements = 1;
+    auto dims = m_out->initDims(N);
+    for (size_t i = 0; i < N; ++i) {
+        dims.set(i, m_in.dim_size(i));
+        elements *= dims[i];
+    }
+
+    m_out->setElementSize(sizeof(CType));
+    m_out->setLittleEndian(HostIsLittleEndian());
+    auto data = m_out->initData(elements * sizeof(CType));
+    if (elements > 0) {
+        std::memcpy(data.begin(), &m_in.get(0), elements * sizeof(CType));
+    }
+}
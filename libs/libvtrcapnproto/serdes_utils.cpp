@@ -1,10 +1,13 @@
 #include "serdes_utils.h"
 
 #include "capnp/serialize.h"
+#include <algorithm>
 #include <fcntl.h>
 #include <unistd.h>
+#include <zlib.h>
 
 #include "vtr_error.h"
+#include "vtr_util.h"
 #include "kj/filesystem.h"
 
 void writeMessageToFile(const std::string& file, ::capnp::MessageBuilder* builder) {
@@ -21,3 +24,40 @@ void writeMessageToFile(const std::string& file, ::capnp::MessageBuilder* builde
         throw vtr::VtrError(e.getDescription().cStr(), e.getFile(), e.getLine());
     }
 }
+
+std::vector<::capnp::word> readGzippedMessageFile(const std::string& file) {
+    gzFile gz_file = gzopen(file.c_str(), "rb");
+    if (gz_file == Z_NULL) {
+        throw vtr::VtrError(vtr::string_fmt("Unable to open '%s'", file.c_str()), __FILE__, __LINE__);
+    }
+    gzbuffer(gz_file, 1 << 20);
+
+    // Grow geometrically, reading each chunk in place
+    std::vector<::capnp::word> words(1 << 16);
+    size_t num_bytes = 0;
+    while (true) {
+        size_t capacity = words.size() * sizeof(::capnp::word);
+        if (num_bytes == capacity) {
+            words.resize(2 * words.size());
+            capacity *= 2;
+        }
+        size_t chunk = std::min<size_t>(capacity - num_bytes, 1 << 30);
+        int ret = gzread(gz_file, reinterpret_cast<char*>(words.data()) + num_bytes, chunk);
+        if (ret < 0) {
+            int error;
+            std::string message = gzerror(gz_file, &error);
+            gzclose(gz_file);
+            throw vtr::VtrError(vtr::string_fmt("Unable to decompress '%s': %s", file.c_str(), message.c_str()), __FILE__, __LINE__);
+        }
+        if (ret == 0) {
+            break;
+        }
+        num_bytes += ret;
+    }
+
+    if (gzclose(gz_file) != Z_OK || num_bytes % sizeof(::capnp::word) != 0) {
+        throw vtr::VtrError(vtr::string_fmt("'%s' is not a valid compressed message", file.c_str()), __FILE__, __LINE__);
+    }
+    words.resize(num_bytes / sizeof(::capnp::word));
+    return words;
+}
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <limits>
 #include <string>
+#include <vector>
 
 // Platform indepedent way to file message to a file on disk.
 void writeMessageToFile(const std::string& file,
@@ -16,3 +17,8 @@ inline ::capnp::ReaderOptions default_large_capnp_opts() {
     opts.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
     return opts;
 }
+
+// Decompresses a gzipped message file (e.g. an FPGA Interchange device or
+// netlist) straight into word-aligned memory, to be read in place with a
+// capnp::FlatArrayMessageReader.
+std::vector<::capnp::word> readGzippedMessageFile(const std::string& file);
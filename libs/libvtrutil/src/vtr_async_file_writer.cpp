@@ -0,0 +1,148 @@
+#include "vtr_async_file_writer.h"
+
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "vtr_assert.h"
+#include "vtr_error.h"
+
+namespace vtr {
+
+bool write_file(const std::string& file_name, const std::string& contents) {
+    FILE* fp = fopen(file_name.c_str(), "wb");
+    if (!fp) {
+        return false;
+    }
+    bool written = fwrite(contents.data(), 1, contents.size(), fp) == contents.size();
+    return fclose(fp) == 0 && written;
+}
+
+namespace {
+
+/// @brief The background thread writing the queued files, started with the first one.
+class AsyncFileWriter {
+  public:
+    ~AsyncFileWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        queued_cv_.notify_all();
+
+        // Flush the remaining writes (nothing is left to report errors to but stderr)
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (!error_.empty()) {
+            fprintf(stderr, "Error: %s\n", error_.c_str());
+        }
+    }
+
+    void write(const std::string& file_name, std::string contents) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.emplace_back(file_name, std::move(contents));
+            if (!thread_.joinable()) {
+                thread_ = std::thread([this]() { run(); });
+            }
+        }
+        queued_cv_.notify_one();
+    }
+
+    void wait() {
+        std::string error;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            written_cv_.wait(lock, [this]() { return queue_.empty() && !writing_; });
+            std::swap(error, error_);
+        }
+
+        if (!error.empty()) {
+            throw VtrError(error);
+        }
+    }
+
+  private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            queued_cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return; // Stopped
+            }
+
+            auto [file_name, contents] = std::move(queue_.front());
+            queue_.pop_front();
+            writing_ = true;
+
+            lock.unlock();
+            bool written = write_file(file_name, contents);
+            lock.lock();
+
+            writing_ = false;
+            if (!written && error_.empty()) {
+                error_ = "Failed to write file '" + file_name + "'";
+            }
+            if (queue_.empty()) {
+                written_cv_.notify_all();
+            }
+        }
+    }
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable queued_cv_;
+    std::condition_variable written_cv_;
+    std::deque<std::pair<std::string, std::string>> queue_;
+    bool writing_ = false;
+    bool stop_ = false;
+    /// The first error since the last wait()
+    std::string error_;
+};
+
+AsyncFileWriter& async_file_writer() {
+    static AsyncFileWriter writer;
+    return writer;
+}
+
+} // namespace
+
+void write_file_async(const std::string& file_name, std::string contents) {
+    async_file_writer().write(file_name, std::move(contents));
+}
+
+void wait_for_async_file_writes() {
+    async_file_writer().wait();
+}
+
+MemoryOutputFile::MemoryOutputFile() {
+    fp_ = open_memstream(&buffer_, &size_);
+    if (!fp_) {
+        throw VtrError("Failed to open an in-memory file");
+    }
+}
+
+MemoryOutputFile::~MemoryOutputFile() {
+    if (fp_) {
+        fclose(fp_);
+    }
+    free(buffer_);
+}
+
+std::string MemoryOutputFile::take_contents() {
+    VTR_ASSERT(fp_);
+    fclose(fp_);
+    fp_ = nullptr;
+
+    std::string contents(buffer_, size_);
+    free(buffer_);
+    buffer_ = nullptr;
+    size_ = 0;
+    return contents;
+}
+
+} // namespace vtr
@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Writing output files in the background.
+ *
+ * Writing large result files (e.g. on a network file system) takes long enough to hold up
+ * the next stage of a flow. Instead, the contents of a file are first written to memory (a
+ * snapshot of the data, which can then change freely), and a background thread writes them
+ * to the file while the flow goes on:
+ *
+ *      vtr::MemoryOutputFile file;
+ *      fprintf(file.fp(), ...);
+ *      vtr::write_file_async("result.txt", file.take_contents());
+ *      ...
+ *      vtr::wait_for_async_file_writes(); // Before reading the file back, and at exit
+ *
+ * The writes still pending at program exit are flushed before it ends.
+ */
+
+#include <cstdio>
+#include <string>
+
+namespace vtr {
+
+/**
+ * @brief Queues writing contents to the file file_name on the background writer thread.
+ *
+ * Files are written in the order they are queued (so a file queued twice ends up with its
+ * last contents). An error writing the file is reported by the next wait_for_async_file_writes().
+ */
+void write_file_async(const std::string& file_name, std::string contents);
+
+/**
+ * @brief Waits until all the queued files are written.
+ *
+ * Throws a VtrError if writing one of them failed (since the previous call).
+ */
+void wait_for_async_file_writes();
+
+/**
+ * @brief Writes contents to the file file_name right away, on the calling thread.
+ *
+ * Doesn't touch the background writer, so it is safe where the queued writes may never be
+ * flushed (e.g. just before std::quick_exit() in a signal handler).
+ *
+ * @return Whether the file was written
+ */
+bool write_file(const std::string& file_name, const std::string& contents);
+
+/**
+ * @brief A C file held in memory, for code writing its output with fprintf().
+ */
+class MemoryOutputFile {
+  public:
+    MemoryOutputFile();
+    ~MemoryOutputFile();
+
+    MemoryOutputFile(const MemoryOutputFile&) = delete;
+    MemoryOutputFile& operator=(const MemoryOutputFile&) = delete;
+
+    ///@brief The file to write to (until take_contents() is called)
+    FILE* fp() { return fp_; }
+
+    ///@brief Closes the file and returns what was written to it
+    std::string take_contents();
+
+  private:
+    FILE* fp_ = nullptr;
+    char* buffer_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace vtr
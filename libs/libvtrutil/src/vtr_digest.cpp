@@ -41,4 +41,12 @@ std::string secure_digest_stream(std::istream& is) {
     return "SHA256:" + picosha2::get_hash_hex_string(hasher);
 }
 
+std::string secure_digest_bytes(std::string_view bytes) {
+    picosha2::hash256_one_by_one hasher;
+    hasher.process(bytes.begin(), bytes.end());
+    hasher.finish();
+
+    return "SHA256:" + picosha2::get_hash_hex_string(hasher);
+}
+
 } // namespace vtr
@@ -2,6 +2,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <string_view>
 
 namespace vtr {
 
@@ -11,4 +12,7 @@ std::string secure_digest_file(const std::string& filepath);
 ///@brief Generate a secure hash of a stream
 std::string secure_digest_stream(std::istream& is);
 
+///@brief Generate a secure hash of a buffer (e.g. a file mapped into memory)
+std::string secure_digest_bytes(std::string_view bytes);
+
 } // namespace vtr
@@ -0,0 +1,536 @@
+#pragma once
+/**
+ * @file
+ * @brief Open-addressing hash map and set, mostly compatible with std::unordered_map/set
+ *
+ * flat_hash_map and flat_hash_set store their elements directly in one array of
+ * slots (no per-element allocation), next to an array of one-byte control values
+ * holding 7 bits of each element's hash. Look-ups probe linearly from the home slot,
+ * comparing the control bytes first, so a miss rarely touches the elements.
+ *
+ * They are typically much faster than std::unordered_map/set for small keys and
+ * values (ids, pointers, floats), which are the common case in VPR's hot loops.
+ *
+ * The containers deviate from std::unordered_map/set in the following important ways:
+ *    - Iterators and references are invalidated by any insertion (the slots may be rehashed)
+ *    - Erasing leaves a tombstone: erase() never invalidates the other iterators, and
+ *      erasing while iterating is safe, but the tombstones only go away on rehash or clear()
+ *    - Elements are stored as std::pair<K, V> (not std::pair<const K, V>): don't modify the keys
+ *    - There is no bucket interface, no node handles and no user provided allocator
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "vtr_assert.h"
+
+namespace vtr {
+
+namespace detail {
+
+/**
+ * @brief The open-addressing table behind flat_hash_map and flat_hash_set.
+ *
+ * Stores Value elements, identified by KeyOf()(element).
+ * The capacity is a power of two, and the table is rehashed before it gets 7/8 full
+ * (counting the tombstones).
+ */
+template<class Key, class Value, class KeyOf, class Hash, class KeyEqual>
+class flat_hash_table {
+  public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Hash hasher;
+    typedef KeyEqual key_equal;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+
+    template<bool Const>
+    class iterator_impl {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const Value*, Value*>;
+        using reference = std::conditional_t<Const, const Value&, Value&>;
+
+        iterator_impl() = default;
+
+        ///@brief Non-const to const iterator conversion
+        template<bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        iterator_impl(const iterator_impl<OtherConst>& other)
+            : ctrl_(other.ctrl_)
+            , ctrl_end_(other.ctrl_end_)
+            , slot_(other.slot_) {}
+
+        reference operator*() const { return *slot_; }
+        pointer operator->() const { return slot_; }
+
+        iterator_impl& operator++() {
+            ++ctrl_;
+            ++slot_;
+            skip_free_slots();
+            return *this;
+        }
+
+        iterator_impl operator++(int) {
+            iterator_impl prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        friend bool operator==(const iterator_impl& lhs, const iterator_impl& rhs) { return lhs.slot_ == rhs.slot_; }
+        friend bool operator!=(const iterator_impl& lhs, const iterator_impl& rhs) { return lhs.slot_ != rhs.slot_; }
+
+      private:
+        friend class flat_hash_table;
+        template<bool>
+        friend class iterator_impl;
+
+        iterator_impl(const uint8_t* ctrl, const uint8_t* ctrl_end, pointer slot)
+            : ctrl_(ctrl)
+            , ctrl_end_(ctrl_end)
+            , slot_(slot) {}
+
+        void skip_free_slots() {
+            while (ctrl_ != ctrl_end_ && !is_full(*ctrl_)) {
+                ++ctrl_;
+                ++slot_;
+            }
+        }
+
+        const uint8_t* ctrl_ = nullptr;
+        const uint8_t* ctrl_end_ = nullptr;
+        pointer slot_ = nullptr;
+    };
+
+    typedef iterator_impl<false> iterator;
+    typedef iterator_impl<true> const_iterator;
+
+  public: //Constructors
+    flat_hash_table() = default;
+
+    flat_hash_table(const flat_hash_table& other)
+        : hash_(other.hash_)
+        , equal_(other.equal_) {
+        if (other.size_ == 0) {
+            return;
+        }
+        allocate(other.capacity_);
+        // Same capacity and hash: every element keeps its slot
+        for (size_t i = 0; i < capacity_; i++) {
+            if (is_full(other.ctrl_[i])) {
+                ::new (static_cast<void*>(slots_ + i)) value_type(other.slots_[i]);
+            }
+            ctrl_[i] = other.ctrl_[i];
+        }
+        size_ = other.size_;
+        num_deleted_ = other.num_deleted_;
+    }
+
+    flat_hash_table(flat_hash_table&& other) noexcept {
+        swap(other);
+    }
+
+    flat_hash_table& operator=(flat_hash_table other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~flat_hash_table() {
+        destroy_elements();
+        deallocate();
+    }
+
+  public: //Accessors
+    iterator begin() { return make_begin<iterator>(slots_); }
+    const_iterator begin() const { return make_begin<const_iterator>(slots_); }
+    const_iterator cbegin() const { return begin(); }
+    iterator end() { return iterator(ctrl_ + capacity_, ctrl_ + capacity_, slots_ + capacity_); }
+    const_iterator end() const { return const_iterator(ctrl_ + capacity_, ctrl_ + capacity_, slots_ + capacity_); }
+    const_iterator cend() const { return end(); }
+
+    bool empty() const { return size_ == 0; }
+    size_type size() const { return size_; }
+    ///@brief Number of slots (elements fit until the table is 7/8 full)
+    size_type capacity() const { return capacity_; }
+
+    iterator find(const key_type& key) {
+        size_t islot = find_slot(key);
+        return islot == NOT_FOUND ? end() : iterator(ctrl_ + islot, ctrl_ + capacity_, slots_ + islot);
+    }
+
+    const_iterator find(const key_type& key) const {
+        size_t islot = find_slot(key);
+        return islot == NOT_FOUND ? end() : const_iterator(ctrl_ + islot, ctrl_ + capacity_, slots_ + islot);
+    }
+
+    size_type count(const key_type& key) const { return find_slot(key) == NOT_FOUND ? 0 : 1; }
+    bool contains(const key_type& key) const { return find_slot(key) != NOT_FOUND; }
+
+  public: //Mutators
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return emplace_key(KeyOf()(value), value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        const key_type& key = KeyOf()(value);
+        return emplace_key(key, std::move(value));
+    }
+
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+        return insert(std::move(value));
+    }
+
+    ///@brief Erases the element at pos, returning an iterator to the next element
+    iterator erase(const_iterator pos) {
+        size_t islot = pos.slot_ - slots_;
+        erase_slot(islot);
+        iterator next(ctrl_ + islot, ctrl_ + capacity_, slots_ + islot);
+        next.skip_free_slots();
+        return next;
+    }
+
+    ///@brief Erases the element with the key, if any. Returns the number of elements erased
+    size_type erase(const key_type& key) {
+        size_t islot = find_slot(key);
+        if (islot == NOT_FOUND) {
+            return 0;
+        }
+        erase_slot(islot);
+        return 1;
+    }
+
+    ///@brief Erases every element, keeping the slots allocated
+    void clear() {
+        destroy_elements();
+        if (capacity_ > 0) {
+            std::memset(ctrl_, EMPTY, capacity_);
+        }
+        size_ = 0;
+        num_deleted_ = 0;
+    }
+
+    ///@brief Makes room for n elements without rehashing
+    void reserve(size_type n) {
+        size_t capacity = capacity_for(n);
+        if (capacity > capacity_) {
+            rehash(capacity);
+        }
+    }
+
+    void swap(flat_hash_table& other) noexcept {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(shift_, other.shift_);
+        std::swap(size_, other.size_);
+        std::swap(num_deleted_, other.num_deleted_);
+        std::swap(hash_, other.hash_);
+        std::swap(equal_, other.equal_);
+    }
+
+    friend void swap(flat_hash_table& lhs, flat_hash_table& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+  protected:
+    /**
+     * @brief Finds the element with key, or constructs one from args.
+     *
+     * Returns the element and whether it was inserted. args must construct a value_type with the given key.
+     */
+    template<class... Args>
+    std::pair<iterator, bool> emplace_key(const key_type& key, Args&&... args) {
+        uint64_t hash = mix(hash_(key));
+        uint8_t tag = tag_of(hash);
+
+        size_t insert_slot = NOT_FOUND;
+        if (capacity_ > 0) {
+            size_t mask = capacity_ - 1;
+            for (size_t islot = home_slot(hash);; islot = (islot + 1) & mask) {
+                uint8_t ctrl = ctrl_[islot];
+                if (ctrl == tag && equal_(KeyOf()(slots_[islot]), key)) {
+                    return {iterator(ctrl_ + islot, ctrl_ + capacity_, slots_ + islot), false};
+                }
+                if (ctrl == DELETED && insert_slot == NOT_FOUND) {
+                    insert_slot = islot;
+                }
+                if (ctrl == EMPTY) {
+                    if (insert_slot == NOT_FOUND) {
+                        insert_slot = islot;
+                    }
+                    break;
+                }
+            }
+        }
+
+        // Reusing a tombstone never makes the table fuller
+        if (insert_slot == NOT_FOUND || (ctrl_[insert_slot] == EMPTY && 8 * (size_ + num_deleted_ + 1) > 7 * capacity_)) {
+            // Construct the element first: args may refer to an element of this table
+            value_type value(std::forward<Args>(args)...);
+            rehash(capacity_for(size_ + 1));
+            insert_slot = find_free_slot(hash);
+            ::new (static_cast<void*>(slots_ + insert_slot)) value_type(std::move(value));
+        } else {
+            ::new (static_cast<void*>(slots_ + insert_slot)) value_type(std::forward<Args>(args)...);
+            if (ctrl_[insert_slot] == DELETED) {
+                num_deleted_--;
+            }
+        }
+        ctrl_[insert_slot] = tag;
+        size_++;
+        return {iterator(ctrl_ + insert_slot, ctrl_ + capacity_, slots_ + insert_slot), true};
+    }
+
+  private:
+    static constexpr size_t NOT_FOUND = size_t(-1);
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    ///@brief Control bytes: free slots, tombstones and full slots (with the top bit set) holding 7 bits of the hash
+    static constexpr uint8_t EMPTY = 0;
+    static constexpr uint8_t DELETED = 1;
+    static bool is_full(uint8_t ctrl) { return ctrl & 0x80; }
+
+    ///@brief Spreads the bits of the user hash: std::hash is the identity for integers, and pointers have zero low bits
+    static uint64_t mix(size_t hash) { return uint64_t(hash) * 0x9E3779B97F4A7C15ull; }
+    size_t home_slot(uint64_t hash) const { return hash >> shift_; }
+    static uint8_t tag_of(uint64_t hash) { return 0x80 | ((hash >> 7) & 0x7f); }
+
+    ///@brief Smallest capacity holding n elements below the maximum load, with room to grow
+    static size_t capacity_for(size_t n) {
+        size_t capacity = MIN_CAPACITY;
+        while (7 * capacity < 16 * n) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    size_t find_slot(const key_type& key) const {
+        if (size_ == 0) {
+            return NOT_FOUND;
+        }
+
+        uint64_t hash = mix(hash_(key));
+        uint8_t tag = tag_of(hash);
+        size_t mask = capacity_ - 1;
+        for (size_t islot = home_slot(hash);; islot = (islot + 1) & mask) {
+            uint8_t ctrl = ctrl_[islot];
+            if (ctrl == tag && equal_(KeyOf()(slots_[islot]), key)) {
+                return islot;
+            }
+            if (ctrl == EMPTY) {
+                return NOT_FOUND;
+            }
+        }
+    }
+
+    ///@brief First free slot from the home slot of hash (the table must have no tombstones)
+    size_t find_free_slot(uint64_t hash) const {
+        size_t mask = capacity_ - 1;
+        size_t islot = home_slot(hash);
+        while (ctrl_[islot] != EMPTY) {
+            islot = (islot + 1) & mask;
+        }
+        return islot;
+    }
+
+    void erase_slot(size_t islot) {
+        VTR_ASSERT_SAFE(is_full(ctrl_[islot]));
+        slots_[islot].~value_type();
+        size_--;
+
+        // No probe sequence continues past an empty slot, so no tombstone is needed before one
+        if (ctrl_[(islot + 1) & (capacity_ - 1)] == EMPTY) {
+            ctrl_[islot] = EMPTY;
+        } else {
+            ctrl_[islot] = DELETED;
+            num_deleted_++;
+        }
+    }
+
+    ///@brief Moves the elements to a table with the given capacity (dropping the tombstones)
+    void rehash(size_t capacity) {
+        VTR_ASSERT(capacity >= MIN_CAPACITY && (capacity & (capacity - 1)) == 0);
+
+        uint8_t* old_ctrl = ctrl_;
+        value_type* old_slots = slots_;
+        size_t old_capacity = capacity_;
+
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        allocate(capacity);
+
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (is_full(old_ctrl[i])) {
+                size_t islot = find_free_slot(mix(hash_(KeyOf()(old_slots[i]))));
+                ::new (static_cast<void*>(slots_ + islot)) value_type(std::move(old_slots[i]));
+                ctrl_[islot] = old_ctrl[i];
+                old_slots[i].~value_type();
+            }
+        }
+        num_deleted_ = 0;
+
+        std::allocator<value_type>().deallocate(old_slots, old_capacity);
+        delete[] old_ctrl;
+    }
+
+    void allocate(size_t capacity) {
+        ctrl_ = new uint8_t[capacity];
+        std::memset(ctrl_, EMPTY, capacity);
+        slots_ = std::allocator<value_type>().allocate(capacity);
+        capacity_ = capacity;
+
+        shift_ = 64;
+        for (size_t c = capacity; c > 1; c >>= 1) {
+            shift_--;
+        }
+    }
+
+    void deallocate() {
+        if (capacity_ > 0) {
+            std::allocator<value_type>().deallocate(slots_, capacity_);
+            delete[] ctrl_;
+        }
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+    }
+
+    void destroy_elements() {
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (size_t i = 0; i < capacity_; i++) {
+                if (is_full(ctrl_[i])) {
+                    slots_[i].~value_type();
+                }
+            }
+        }
+    }
+
+    template<class It, class Slot>
+    It make_begin(Slot* slots) const {
+        It it(ctrl_, ctrl_ + capacity_, slots);
+        it.skip_free_slots();
+        return it;
+    }
+
+    uint8_t* ctrl_ = nullptr;
+    value_type* slots_ = nullptr;
+    size_t capacity_ = 0;
+    size_t shift_ = 64;
+    size_t size_ = 0;
+    size_t num_deleted_ = 0;
+    Hash hash_;
+    KeyEqual equal_;
+};
+
+template<class K, class V>
+struct flat_hash_map_key {
+    const K& operator()(const std::pair<K, V>& value) const { return value.first; }
+};
+
+template<class K>
+struct flat_hash_set_key {
+    const K& operator()(const K& value) const { return value; }
+};
+
+} // namespace detail
+
+/**
+ * @brief A (nearly) std::unordered_map compatible open-addressing hash map
+ *
+ * See the file description for the differences with std::unordered_map.
+ */
+template<class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class flat_hash_map : public detail::flat_hash_table<K, std::pair<K, V>, detail::flat_hash_map_key<K, V>, Hash, KeyEqual> {
+    typedef detail::flat_hash_table<K, std::pair<K, V>, detail::flat_hash_map_key<K, V>, Hash, KeyEqual> table;
+
+  public:
+    typedef V mapped_type;
+    typedef typename table::iterator iterator;
+    typedef typename table::const_iterator const_iterator;
+
+    flat_hash_map() = default;
+
+    flat_hash_map(std::initializer_list<std::pair<K, V>> init) {
+        this->reserve(init.size());
+        this->insert(init.begin(), init.end());
+    }
+
+    ///@brief Returns the value of key, inserting a default constructed value if missing
+    V& operator[](const K& key) {
+        return this->emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first->second;
+    }
+
+    ///@brief Returns the value of key (throws std::out_of_range if missing)
+    V& at(const K& key) {
+        auto iter = this->find(key);
+        if (iter == this->end()) {
+            throw std::out_of_range("Invalid key");
+        }
+        return iter->second;
+    }
+
+    ///@brief Returns the value of key (throws std::out_of_range if missing)
+    const V& at(const K& key) const {
+        auto iter = this->find(key);
+        if (iter == this->end()) {
+            throw std::out_of_range("Invalid key");
+        }
+        return iter->second;
+    }
+
+    ///@brief Inserts a value constructed from args if key is missing
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        return this->emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    ///@brief Inserts or overwrites the value of key
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+        auto result = try_emplace(key, std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief A (nearly) std::unordered_set compatible open-addressing hash set
+ *
+ * See the file description for the differences with std::unordered_set.
+ */
+template<class K, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class flat_hash_set : public detail::flat_hash_table<K, K, detail::flat_hash_set_key<K>, Hash, KeyEqual> {
+  public:
+    flat_hash_set() = default;
+
+    flat_hash_set(std::initializer_list<K> init) {
+        this->reserve(init.size());
+        this->insert(init.begin(), init.end());
+    }
+};
+
+} // namespace vtr
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 #include <math.h>
@@ -14,6 +16,10 @@
 #include <malloc.h>
 #endif
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 namespace vtr {
 
 #ifndef __GLIBC__
@@ -153,6 +159,149 @@ void* chunk_malloc(size_t size, t_chunk* chunk_info) {
     return tmp_ptr;
 }
 
+#ifdef VTR_ENABLE_ALLOCATION_COUNTING
+
+static std::atomic<size_t> f_num_allocations{0};
+static std::atomic<size_t> f_bytes_allocated{0};
+static std::atomic<size_t> f_bytes_in_use{0};
+static std::atomic<size_t> f_peak_bytes_in_use{0};
+
+bool allocation_counting_enabled() {
+    return true;
+}
+
+t_allocation_stats get_allocation_stats() {
+    t_allocation_stats stats;
+    stats.num_allocations = f_num_allocations.load(std::memory_order_relaxed);
+    stats.bytes_allocated = f_bytes_allocated.load(std::memory_order_relaxed);
+    stats.bytes_in_use = f_bytes_in_use.load(std::memory_order_relaxed);
+    stats.peak_bytes_in_use = f_peak_bytes_in_use.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void reset_peak_bytes_in_use() {
+    f_peak_bytes_in_use.store(f_bytes_in_use.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+/* Each counted allocation is preceded by a header holding its size and the size of the
+ * header (which is a multiple of the alignment), so that deallocations can be counted too */
+static constexpr size_t ALLOCATION_HEADER_SIZE = std::max(alignof(std::max_align_t), 2 * sizeof(size_t));
+
+static void* counted_allocate(size_t size, size_t align) {
+    size_t header_size = std::max(align, ALLOCATION_HEADER_SIZE);
+    void* block = nullptr;
+    if (vtr::memalign(&block, header_size, header_size + size) != 0) {
+        return nullptr;
+    }
+
+    f_num_allocations.fetch_add(1, std::memory_order_relaxed);
+    f_bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+    size_t in_use = f_bytes_in_use.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = f_peak_bytes_in_use.load(std::memory_order_relaxed);
+    while (in_use > peak && !f_peak_bytes_in_use.compare_exchange_weak(peak, in_use, std::memory_order_relaxed)) {
+    }
+
+    size_t* ptr = reinterpret_cast<size_t*>(static_cast<char*>(block) + header_size);
+    ptr[-1] = size;
+    ptr[-2] = header_size;
+    return ptr;
+}
+
+static void counted_deallocate(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    size_t size = static_cast<size_t*>(ptr)[-1];
+    size_t header_size = static_cast<size_t*>(ptr)[-2];
+    f_bytes_in_use.fetch_sub(size, std::memory_order_relaxed);
+
+    void* block = static_cast<char*>(ptr) - header_size;
+#ifdef _WIN32
+    _aligned_free(block);
+#else
+    std::free(block);
+#endif
+}
+
+static void* counted_new(size_t size, size_t align) {
+    void* ptr = counted_allocate(size, align);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+#else
+
+bool allocation_counting_enabled() {
+    return false;
+}
+
+t_allocation_stats get_allocation_stats() {
+    return t_allocation_stats();
+}
+
+void reset_peak_bytes_in_use() {}
+
+#endif
+
+static std::atomic<bool> f_huge_pages_enabled{true};
+
+void set_huge_pages_enabled(bool enabled) {
+    f_huge_pages_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool huge_pages_enabled() {
+    return f_huge_pages_enabled.load(std::memory_order_relaxed);
+}
+
+#ifdef VTR_ENABLE_ALLOCATION_COUNTING
+
+// Counted like the allocations of operator new (without huge pages)
+void* huge_page_allocate(size_t bytes, size_t align) {
+    return counted_new(bytes, align);
+}
+
+void huge_page_deallocate(void* ptr) {
+    counted_deallocate(ptr);
+}
+
+#else
+
+void* huge_page_allocate(size_t bytes, size_t align) {
+    align = std::max(align, alignof(std::max_align_t));
+
+    bool use_huge_pages = huge_pages_enabled() && bytes >= HUGE_PAGE_SIZE;
+    if (use_huge_pages) {
+        // Whole huge pages, so that the last one isn't shared with other allocations
+        align = std::max(align, HUGE_PAGE_SIZE);
+        bytes = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+
+    void* ptr = nullptr;
+    if (vtr::memalign(&ptr, align, std::max<size_t>(bytes, 1)) != 0) {
+        throw std::bad_alloc();
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (use_huge_pages) {
+        // Only a hint: fails harmlessly if transparent huge pages are disabled
+        madvise(ptr, bytes, MADV_HUGEPAGE);
+    }
+#endif
+    return ptr;
+}
+
+void huge_page_deallocate(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+#endif
+
 void free_chunk_memory(t_chunk* chunk_info) {
     /* Frees the memory allocated by a sequence of calls to my_chunk_malloc. */
 
@@ -175,3 +324,87 @@ void free_chunk_memory(t_chunk* chunk_info) {
 }
 
 } // namespace vtr
+
+#ifdef VTR_ENABLE_ALLOCATION_COUNTING
+/* Replacements of the global allocation functions, which count the allocations. */
+
+void* operator new(size_t size) {
+    return vtr::counted_new(size, 0);
+}
+
+void* operator new[](size_t size) {
+    return vtr::counted_new(size, 0);
+}
+
+void* operator new(size_t size, std::align_val_t align) {
+    return vtr::counted_new(size, static_cast<size_t>(align));
+}
+
+void* operator new[](size_t size, std::align_val_t align) {
+    return vtr::counted_new(size, static_cast<size_t>(align));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return vtr::counted_allocate(size, 0);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return vtr::counted_allocate(size, 0);
+}
+
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return vtr::counted_allocate(size, static_cast<size_t>(align));
+}
+
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return vtr::counted_allocate(size, static_cast<size_t>(align));
+}
+
+void operator delete(void* ptr) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    vtr::counted_deallocate(ptr);
+}
+#endif
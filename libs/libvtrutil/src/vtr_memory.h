@@ -69,6 +69,29 @@ void chunk_delete(T* obj, t_chunk* /*chunk_info*/) {
     }
 }
 
+///@brief Heap usage counted by the global operator new and delete
+struct t_allocation_stats {
+    size_t num_allocations = 0;   ///<Number of allocations so far
+    size_t bytes_allocated = 0;   ///<Total number of bytes allocated so far
+    size_t bytes_in_use = 0;      ///<Number of bytes allocated and not freed yet
+    size_t peak_bytes_in_use = 0; ///<Maximum of bytes_in_use since the start (or the last reset_peak_bytes_in_use())
+};
+
+/**
+ * @brief Returns true if the allocations are counted
+ *
+ * The global operator new and delete count the allocations when VTR is built with
+ * VTR_ENABLE_ALLOCATION_COUNTING (which slows down every allocation). Memory allocated
+ * with malloc() is not counted.
+ */
+bool allocation_counting_enabled();
+
+///@brief Returns the allocations counted so far (all zeros if they are not counted)
+t_allocation_stats get_allocation_stats();
+
+///@brief Restarts the tracking of the peak heap usage from the current usage
+void reset_peak_bytes_in_use();
+
 /**
  * @brief Cross platform wrapper around GNU's malloc_trim()
  *
@@ -146,4 +169,62 @@ bool operator==(const aligned_allocator<T>&, const aligned_allocator<T>&) {
     return true;
 }
 
+///@brief Size of a (x86-64/ARM64 Linux) huge page
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/**
+ * @brief Sets the huge page policy of huge_page_allocate() (enabled by default)
+ *
+ * When enabled, the allocations of at least HUGE_PAGE_SIZE bytes are aligned to
+ * HUGE_PAGE_SIZE and (on Linux) advised to be backed by transparent huge pages, which
+ * reduces the TLB misses of random accesses into large arrays (e.g. the router lookahead
+ * maps and the RR node data). Like all anonymous memory, their pages are placed on the
+ * NUMA node of the thread which first touches them.
+ */
+void set_huge_pages_enabled(bool enabled);
+
+///@brief Returns true if large allocations are advised to be backed by huge pages
+bool huge_pages_enabled();
+
+/**
+ * @brief Allocates the given number of bytes aligned to align (a power of two),
+ *        with huge pages if they are large enough and enabled (see set_huge_pages_enabled())
+ *
+ * Throws std::bad_alloc on failure. The memory must be freed with huge_page_deallocate().
+ */
+void* huge_page_allocate(size_t bytes, size_t align);
+
+///@brief Frees memory allocated by huge_page_allocate()
+void huge_page_deallocate(void* ptr);
+
+///@brief A STL allocator which backs large allocations with huge pages (see huge_page_allocate())
+template<class T>
+struct huge_page_allocator {
+    using value_type = T;
+
+    huge_page_allocator() = default;
+
+    template<class U>
+    huge_page_allocator(const huge_page_allocator<U>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(huge_page_allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    void deallocate(T* p, size_t /*n*/) {
+        huge_page_deallocate(p);
+    }
+};
+
+///@brief All huge_page_allocators are the same, since they have no state
+template<typename T, typename U>
+bool operator==(const huge_page_allocator<T>&, const huge_page_allocator<U>&) {
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const huge_page_allocator<T>&, const huge_page_allocator<U>&) {
+    return false;
+}
+
 } // namespace vtr
@@ -3,11 +3,33 @@
 #include <algorithm>
 #include <array>
 #include <memory>
+#include <type_traits>
 
 #include "vtr_assert.h"
+#include "vtr_memory.h"
 
 namespace vtr {
 
+///@brief Destroys and frees the elements of an NdMatrix, which are allocated with huge_page_allocate()
+template<typename T>
+struct NdMatrixDeleter {
+    size_t count = 0;
+    ///@brief Owner of the external elements of an aliased matrix (see NdMatrixBase::alias()), which are then not freed
+    std::shared_ptr<const void> owner;
+
+    void operator()(T* elements) const {
+        if (owner) {
+            return;
+        }
+        std::destroy_n(elements, count);
+        huge_page_deallocate(elements);
+    }
+};
+
+///@brief Storage of the elements of an NdMatrix
+template<typename T>
+using NdMatrixData = std::unique_ptr<T[], NdMatrixDeleter<T>>;
+
 /**
  * @brief Proxy class for a sub-matrix of a NdMatrix class.
  * 
@@ -34,7 +56,7 @@ class NdMatrixProxy {
      *    @param offset: The offset from the start that this sub-matrix starts at.
      *    @param start: Pointer to the start of the base NDMatrix of this proxy
      */
-    NdMatrixProxy(const size_t* dim_sizes, const size_t* dim_strides, size_t offset, const std::unique_ptr<T[]>& start)
+    NdMatrixProxy(const size_t* dim_sizes, const size_t* dim_strides, size_t offset, const NdMatrixData<T>& start)
         : dim_sizes_(dim_sizes)
         , dim_strides_(dim_strides)
         , offset_(offset)
@@ -77,7 +99,7 @@ class NdMatrixProxy {
     /// @brief The pointer to the start of the base NDMatrix data. Since the
     ///        base NDMatrix object owns the memory, we hold onto a reference
     ///        to its unique pointer. This is safer than passing a bare pointer.
-    const std::unique_ptr<T[]>& start_;
+    const NdMatrixData<T>& start_;
 };
 
 ///@brief Base case: 1-dimensional array
@@ -92,7 +114,7 @@ class NdMatrixProxy<T, 1> {
      *    @param offset: The offset from the start that this sub-matrix starts at.
      *    @param start: Pointer to the start of the base NDMatrix of this proxy
      */
-    NdMatrixProxy(const size_t* dim_sizes, const size_t* dim_stride, size_t offset, const std::unique_ptr<T[]>& start)
+    NdMatrixProxy(const size_t* dim_sizes, const size_t* dim_stride, size_t offset, const NdMatrixData<T>& start)
         : dim_sizes_(dim_sizes)
         , dim_strides_(dim_stride)
         , offset_(offset)
@@ -150,7 +172,7 @@ class NdMatrixProxy<T, 1> {
     /// @brief The pointer to the start of the base NDMatrix data. Since the
     ///        base NDMatrix object owns the memory, we hold onto a reference
     ///        to its unique pointer. This is safer than passing a bare pointer.
-    const std::unique_ptr<T[]>& start_;
+    const NdMatrixData<T>& start_;
 };
 
 /**
@@ -264,19 +286,31 @@ class NdMatrixBase {
         size_ = calc_size();
         alloc();
         fill(value);
-        if (size_ > 0) {
-            dim_strides_[0] = size_ / dim_sizes_[0];
-            for (size_t dim = 1; dim < N; ++dim) {
-                dim_strides_[dim] = dim_strides_[dim - 1] / dim_sizes_[dim];
-            }
-        } else {
-            dim_strides_.fill(0);
-        }
+        calc_strides();
+    }
+
+    /**
+     * @brief Use external elements, stored in row major order, instead of allocating them (e.g. from a memory mapped file)
+     *
+     * The elements are neither copied nor destroyed: `owner` keeps them alive until the matrix is resized, cleared or
+     * destroyed. They may be read-only, in which case the matrix must not be modified. Copies of the matrix allocate
+     * their own elements as usual.
+     */
+    void alias(std::array<size_t, N> dim_sizes, const T* elements, std::shared_ptr<const void> owner) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain elements can be aliased");
+        VTR_ASSERT(owner);
+        dim_sizes_ = dim_sizes;
+        size_ = calc_size();
+        NdMatrixDeleter<T> deleter;
+        deleter.count = size_;
+        deleter.owner = std::move(owner);
+        data_ = NdMatrixData<T>(const_cast<T*>(elements), std::move(deleter));
+        calc_strides();
     }
 
     ///@brief Reset the matrix to size zero
     void clear() {
-        data_.reset(nullptr);
+        data_ = NdMatrixData<T>();
         dim_sizes_.fill(0);
         dim_strides_.fill(0);
         size_ = 0;
@@ -315,9 +349,33 @@ class NdMatrixBase {
     }
 
   private:
-    ///@brief Allocate space for all the elements
+    ///@brief Allocate space for all the elements (large matrices are backed by huge pages, see vtr::huge_page_allocate())
     void alloc() {
-        data_ = std::make_unique<T[]>(size());
+        data_ = NdMatrixData<T>(); // Also drops the owner of aliased elements
+        if (size() == 0) {
+            return;
+        }
+
+        T* elements = static_cast<T*>(huge_page_allocate(size() * sizeof(T), alignof(T)));
+        try {
+            std::uninitialized_value_construct_n(elements, size());
+        } catch (...) {
+            huge_page_deallocate(elements);
+            throw;
+        }
+        data_ = NdMatrixData<T>(elements, NdMatrixDeleter<T>{size(), nullptr});
+    }
+
+    ///@brief Computes the strides of the dimensions from their sizes
+    void calc_strides() {
+        if (size_ > 0) {
+            dim_strides_[0] = size_ / dim_sizes_[0];
+            for (size_t dim = 1; dim < N; ++dim) {
+                dim_strides_[dim] = dim_strides_[dim - 1] / dim_sizes_[dim];
+            }
+        } else {
+            dim_strides_.fill(0);
+        }
     }
 
     ///@brief Returns the size of the matrix (number of elements) calculated from the current dimensions
@@ -334,7 +392,7 @@ class NdMatrixBase {
     size_t size_ = 0;
     std::array<size_t, N> dim_sizes_;
     std::array<size_t, N> dim_strides_;
-    std::unique_ptr<T[]> data_ = nullptr;
+    NdMatrixData<T> data_ = nullptr;
 };
 
 /**
@@ -0,0 +1,184 @@
+#include "vtr_numa.h"
+
+#include "vtr_assert.h"
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace vtr {
+namespace numa {
+
+namespace {
+
+///@brief The usable NUMA nodes, with their OS numbers and CPUs
+struct t_topology {
+    std::vector<int> os_nodes;
+    std::vector<std::vector<int>> cpus;
+};
+
+#ifdef __linux__
+///@brief Parses a sysfs CPU or node list (e.g. "0-3,8,10-11")
+std::vector<int> parse_list(const std::string& list) {
+    std::vector<int> values;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string range = list.substr(pos, end - pos);
+        size_t dash = range.find('-');
+        try {
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int value = first; value <= last; value++) {
+                values.push_back(value);
+            }
+        } catch (const std::exception&) {
+            // Skip malformed entries (e.g. the empty list)
+        }
+        pos = end + 1;
+    }
+    return values;
+}
+
+std::string read_line(const std::string& filename) {
+    std::ifstream file(filename);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+cpu_set_t process_cpus() {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (sched_getaffinity(0, sizeof(cpus), &cpus) != 0) {
+        CPU_ZERO(&cpus);
+    }
+    return cpus;
+}
+#endif
+
+t_topology load_topology() {
+    t_topology topology;
+
+#ifdef __linux__
+    cpu_set_t allowed = process_cpus();
+    for (int os_node : parse_list(read_line("/sys/devices/system/node/online"))) {
+        std::vector<int> cpus;
+        for (int cpu : parse_list(read_line("/sys/devices/system/node/node" + std::to_string(os_node) + "/cpulist"))) {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            topology.os_nodes.push_back(os_node);
+            topology.cpus.push_back(std::move(cpus));
+        }
+    }
+#endif
+
+    if (topology.os_nodes.empty()) {
+        // Unknown topology: a single node without CPU list (nothing gets pinned)
+        topology.os_nodes.push_back(0);
+        topology.cpus.emplace_back();
+    }
+    return topology;
+}
+
+const t_topology& topology() {
+    static const t_topology topology = load_topology();
+    return topology;
+}
+
+} // namespace
+
+size_t num_nodes() {
+    return topology().os_nodes.size();
+}
+
+const std::vector<int>& node_cpus(size_t node) {
+    VTR_ASSERT(node < num_nodes());
+    return topology().cpus[node];
+}
+
+bool pin_current_thread(size_t node) {
+#ifdef __linux__
+    const std::vector<int>& cpus = node_cpus(node);
+    if (cpus.empty()) {
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+bool unpin_current_thread() {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t node = 0; node < num_nodes(); node++) {
+        for (int cpu : node_cpus(node)) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return CPU_COUNT(&set) > 0 && sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+size_t page_size() {
+#ifdef __unix__
+    static const size_t size = sysconf(_SC_PAGESIZE);
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+bool bind_memory(void* addr, size_t bytes, size_t node) {
+    VTR_ASSERT(node < num_nodes());
+
+#if defined(__linux__) && defined(SYS_mbind)
+    size_t page = page_size();
+    uintptr_t begin = (reinterpret_cast<uintptr_t>(addr) + page - 1) / page * page;
+    uintptr_t end = (reinterpret_cast<uintptr_t>(addr) + bytes) / page * page;
+    if (begin >= end) {
+        return true;
+    }
+
+    constexpr size_t bits_per_mask = 8 * sizeof(unsigned long);
+    size_t os_node = topology().os_nodes[node];
+    std::vector<unsigned long> mask(os_node / bits_per_mask + 1, 0);
+    mask[os_node / bits_per_mask] = 1UL << (os_node % bits_per_mask);
+
+    // The kernel reads one bit less than maxnode
+    long result = syscall(SYS_mbind, begin, end - begin, MPOL_BIND, mask.data(), mask.size() * bits_per_mask + 1, MPOL_MF_MOVE);
+    return result == 0;
+#else
+    (void)addr;
+    (void)bytes;
+    return false;
+#endif
+}
+
+} // namespace numa
+} // namespace vtr
@@ -0,0 +1,44 @@
+#pragma once
+/**
+ * @file
+ * @brief Minimal NUMA support: the topology of the machine, thread pinning and page placement.
+ *
+ * The topology is read from sysfs (Linux only) and restricted to the CPUs the process may run on,
+ * so the nodes are numbered 0..num_nodes()-1 whatever their OS numbering is. On other platforms,
+ * or if the topology can't be read, the machine is a single node and the functions below do nothing.
+ *
+ * Memory is normally placed on the node of the thread touching it first. bind_memory() places
+ * (and moves, if already touched) the pages of a range on a given node explicitly.
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace vtr {
+namespace numa {
+
+///@brief Number of NUMA nodes with CPUs usable by this process (at least 1)
+size_t num_nodes();
+
+///@brief CPUs of the given NUMA node usable by this process
+const std::vector<int>& node_cpus(size_t node);
+
+///@brief Restricts the calling thread to the CPUs of the given NUMA node. Returns false if unsupported or on failure
+bool pin_current_thread(size_t node);
+
+///@brief Allows the calling thread to run on any CPU usable by this process. Returns false if unsupported or on failure
+bool unpin_current_thread();
+
+///@brief Size of the pages bind_memory() works with
+size_t page_size();
+
+/**
+ * @brief Places the whole pages in [addr, addr + bytes) on the given NUMA node, moving the pages
+ *        already touched. Partial pages at either end are left alone.
+ *
+ * Returns false if unsupported or on failure. The contents of the range are unchanged either way.
+ */
+bool bind_memory(void* addr, size_t bytes, size_t node);
+
+} // namespace numa
+} // namespace vtr
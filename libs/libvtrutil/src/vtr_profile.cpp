@@ -0,0 +1,196 @@
+#include "vtr_profile.h"
+
+#include "vtr_error.h"
+#include "vtr_log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+namespace vtr {
+namespace profile {
+
+namespace detail {
+std::atomic<bool> g_enabled{false};
+} // namespace detail
+
+namespace {
+
+///@brief A call of a zone
+struct t_zone_record {
+    const char* name;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    uint64_t self_ns;
+};
+
+///@brief The zones recorded by a thread
+struct t_thread_buffer {
+    size_t thread_index;
+
+    ///@brief Locked when the records are read (the owning thread is the only writer)
+    std::mutex mutex;
+    std::vector<t_zone_record> records;
+
+    ///@brief Time spent in the zones nested in each open zone, innermost last
+    std::vector<uint64_t> open_children_ns;
+};
+
+///@brief Every thread buffer, kept after their thread exits
+std::mutex g_buffers_mutex;
+std::vector<std::shared_ptr<t_thread_buffer>> g_buffers;
+
+///@brief Copies of the names of zones given as std::string
+std::mutex g_names_mutex;
+std::unordered_set<std::string> g_names;
+
+const std::chrono::steady_clock::time_point g_epoch = std::chrono::steady_clock::now();
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_epoch).count();
+}
+
+t_thread_buffer& thread_buffer() {
+    thread_local std::shared_ptr<t_thread_buffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<t_thread_buffer>();
+
+        std::lock_guard<std::mutex> lock(g_buffers_mutex);
+        buffer->thread_index = g_buffers.size();
+        g_buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+///@brief Calls fn on the records of every thread
+template<typename F>
+void for_each_record(F fn) {
+    std::lock_guard<std::mutex> lock(g_buffers_mutex);
+    for (const auto& buffer : g_buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        for (const t_zone_record& record : buffer->records) {
+            fn(*buffer, record);
+        }
+    }
+}
+
+void write_json_string(std::ostream& os, const char* str) {
+    os << '"';
+    for (const char* c = str; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            os << '\\' << *c;
+        } else if ((unsigned char)*c < 0x20) {
+            os << ' ';
+        } else {
+            os << *c;
+        }
+    }
+    os << '"';
+}
+
+} // namespace
+
+void enable(bool value) {
+    detail::g_enabled.store(value, std::memory_order_relaxed);
+}
+
+void Zone::begin(const char* name) {
+    name_ = name;
+    thread_buffer().open_children_ns.push_back(0);
+    start_ns_ = now_ns();
+}
+
+void Zone::end() {
+    uint64_t duration_ns = now_ns() - start_ns_;
+
+    t_thread_buffer& buffer = thread_buffer();
+    uint64_t children_ns = buffer.open_children_ns.back();
+    buffer.open_children_ns.pop_back();
+    if (!buffer.open_children_ns.empty()) {
+        buffer.open_children_ns.back() += duration_ns;
+    }
+
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.records.push_back({name_, start_ns_, duration_ns, duration_ns - std::min(children_ns, duration_ns)});
+}
+
+const char* Zone::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(g_names_mutex);
+    return g_names.insert(name).first->c_str();
+}
+
+std::vector<t_zone_summary> summary() {
+    std::map<std::string, t_zone_summary> summaries;
+    for_each_record([&](const t_thread_buffer&, const t_zone_record& record) {
+        t_zone_summary& zone = summaries[record.name];
+        zone.calls++;
+        zone.total_ns += record.duration_ns;
+        zone.self_ns += record.self_ns;
+    });
+
+    std::vector<t_zone_summary> zones;
+    for (auto& [name, zone] : summaries) {
+        zone.name = name;
+        zones.push_back(std::move(zone));
+    }
+    std::stable_sort(zones.begin(), zones.end(), [](const t_zone_summary& lhs, const t_zone_summary& rhs) {
+        return lhs.total_ns > rhs.total_ns;
+    });
+    return zones;
+}
+
+void print_summary() {
+    std::vector<t_zone_summary> zones = summary();
+    if (zones.empty()) {
+        return;
+    }
+
+    size_t name_width = 4;
+    for (const t_zone_summary& zone : zones) {
+        name_width = std::max(name_width, zone.name.size());
+    }
+
+    VTR_LOG("\nProfiling zones:\n");
+    VTR_LOG("%-*s %10s %12s %12s\n", (int)name_width, "Zone", "Calls", "Total (s)", "Self (s)");
+    for (const t_zone_summary& zone : zones) {
+        VTR_LOG("%-*s %10zu %12.4f %12.4f\n", (int)name_width, zone.name.c_str(), zone.calls, zone.total_ns * 1e-9, zone.self_ns * 1e-9);
+    }
+    VTR_LOG("\n");
+}
+
+void write_chrome_trace(const std::string& filename) {
+    std::ofstream os(filename);
+    if (!os) {
+        throw VtrError("Failed to open profile trace file", filename);
+    }
+
+    // Complete ('X') events, with times in microseconds
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for_each_record([&](const t_thread_buffer& buffer, const t_zone_record& record) {
+        os << (first ? "\n" : ",\n");
+        first = false;
+
+        os << "{\"name\":";
+        write_json_string(os, record.name);
+        os << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer.thread_index
+           << ",\"ts\":" << record.start_ns / 1000 << '.' << record.start_ns % 1000 / 100
+           << ",\"dur\":" << record.duration_ns / 1000 << '.' << record.duration_ns % 1000 / 100 << '}';
+    });
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void clear() {
+    std::lock_guard<std::mutex> lock(g_buffers_mutex);
+    for (const auto& buffer : g_buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->records.clear();
+    }
+}
+
+} // namespace profile
+} // namespace vtr
@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Lightweight hierarchical profiling zones.
+ *
+ * A profiling zone records the time spent in a scope, nested in the zones open on the same
+ * thread when it starts. Recording is off by default: a zone then costs a single relaxed
+ * atomic load. Once vtr::profile::enable() is called, zones record their start and duration
+ * (in nanoseconds) in a per-thread buffer, which can be dumped as:
+ *   - a Chrome trace (JSON), which can be opened with chrome://tracing or https://ui.perfetto.dev
+ *   - a flat summary of the number of calls, and total and self time of each zone.
+ *
+ * Every vtr::ScopedActionTimer (and so every ScopedStartFinishTimer) is also a zone.
+ *
+ * For example:
+ *
+ *      void route_iteration() {
+ *          VTR_PROFILE_ZONE("route_iteration");
+ *          ...
+ *      }
+ *
+ *      vtr::profile::enable(true);
+ *      ...
+ *      vtr::profile::write_chrome_trace("vpr.trace.json");
+ *      vtr::profile::print_summary();
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define VTR_PROFILE_CONCAT_IMPL(a, b) a##b
+#define VTR_PROFILE_CONCAT(a, b) VTR_PROFILE_CONCAT_IMPL(a, b)
+
+///@brief Profile the rest of the enclosing scope as a zone (name must be a string literal or a std::string)
+#define VTR_PROFILE_ZONE(name) vtr::profile::Zone VTR_PROFILE_CONCAT(vtr_profile_zone_, __LINE__)(name)
+
+namespace vtr {
+namespace profile {
+
+namespace detail {
+extern std::atomic<bool> g_enabled;
+} // namespace detail
+
+///@brief Turns the recording of zones on or off
+void enable(bool value);
+
+///@brief Returns true if zones are recorded
+inline bool enabled() {
+    return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+///@brief A profiling zone, which lasts until it is destructed
+class Zone {
+  public:
+    ///@brief The name must outlive the recorded data (e.g. a string literal)
+    explicit Zone(const char* name) {
+        if (enabled()) {
+            begin(name);
+        }
+    }
+
+    ///@brief The name is copied (only if the zone is recorded)
+    explicit Zone(const std::string& name) {
+        if (enabled()) {
+            begin(intern(name));
+        }
+    }
+
+    ~Zone() {
+        if (name_) {
+            end();
+        }
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+  private:
+    void begin(const char* name);
+    void end();
+    static const char* intern(const std::string& name);
+
+    const char* name_ = nullptr;
+    uint64_t start_ns_ = 0;
+};
+
+///@brief Time spent in all the calls of a zone (over all threads)
+struct t_zone_summary {
+    std::string name;
+    size_t calls = 0;
+    uint64_t total_ns = 0; ///<Time spent in the zone
+    uint64_t self_ns = 0;  ///<Time spent in the zone but not in the zones nested in it
+};
+
+///@brief Returns the summary of each recorded zone, in decreasing order of total time
+std::vector<t_zone_summary> summary();
+
+///@brief Logs the summary of the recorded zones as a table
+void print_summary();
+
+///@brief Writes the recorded zones as a Chrome trace (one complete event per call)
+void write_chrome_trace(const std::string& filename);
+
+///@brief Forgets the recorded zones
+void clear();
+
+} // namespace profile
+} // namespace vtr
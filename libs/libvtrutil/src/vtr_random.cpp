@@ -3,6 +3,7 @@
 #include "specrand.h"
 #include "vtr_util.h"
 #include "vtr_error.h"
+#include "vtr_assert.h"
 
 namespace vtr {
 
@@ -54,6 +55,57 @@ float RandomNumberGenerator::frand() {
     return fval;
 }
 
+PhiloxRandomNumberGenerator::counter_t PhiloxRandomNumberGenerator::philox4x32(counter_t counter, key_t key) {
+    // Multipliers and Weyl sequence constants of Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (SC'11)
+    constexpr uint32_t M0 = 0xD2511F53u;
+    constexpr uint32_t M1 = 0xCD9E8D57u;
+    constexpr uint32_t W0 = 0x9E3779B9u;
+    constexpr uint32_t W1 = 0xBB67AE85u;
+
+    for (int iround = 0; iround < 10; iround++) {
+        uint64_t p0 = uint64_t(M0) * counter[0];
+        uint64_t p1 = uint64_t(M1) * counter[2];
+        counter = {uint32_t(p1 >> 32) ^ counter[1] ^ key[0],
+                   uint32_t(p1),
+                   uint32_t(p0 >> 32) ^ counter[3] ^ key[1],
+                   uint32_t(p0)};
+        key[0] += W0;
+        key[1] += W1;
+    }
+    return counter;
+}
+
+PhiloxRandomNumberGenerator::PhiloxRandomNumberGenerator(int seed, uint32_t stage, uint64_t stream)
+    : key_{uint32_t(seed), stage}
+    , stream_(stream) {}
+
+void PhiloxRandomNumberGenerator::srandom(int seed) {
+    key_[0] = uint32_t(seed);
+    block_ = 0;
+    num_words_used_ = words_.size();
+}
+
+uint32_t PhiloxRandomNumberGenerator::next_word() {
+    if (num_words_used_ == words_.size()) {
+        words_ = philox4x32({uint32_t(block_), uint32_t(block_ >> 32), uint32_t(stream_), uint32_t(stream_ >> 32)}, key_);
+        block_++;
+        num_words_used_ = 0;
+    }
+    return words_[num_words_used_++];
+}
+
+int PhiloxRandomNumberGenerator::irand(int imax) {
+    // Scales the word to [0..imax] with a multiplication rather than a modulus (or floats), which is
+    // both faster and exact
+    VTR_ASSERT_SAFE(imax >= 0);
+    return int((uint64_t(next_word()) * (uint64_t(imax) + 1)) >> 32);
+}
+
+float PhiloxRandomNumberGenerator::frand() {
+    // The 24 high bits fit exactly in a float mantissa, so this is in [0, 1)
+    return float(next_word() >> 8) * (1.f / float(1u << 24));
+}
+
 RngContainer::RngContainer(int seed) {
     if constexpr (SPEC_CPU_CONSTEXPR) {
         rng_ = std::make_unique<SpecRandomNumberGenerator>(seed);
@@ -64,4 +116,11 @@ RngContainer::RngContainer(int seed) {
 
 RngContainer::RngContainer()
     : RngContainer(0) {}
+
+RngContainer::RngContainer(int seed, uint32_t stage, uint64_t stream)
+    : rng_(std::make_unique<PhiloxRandomNumberGenerator>(seed, stage, stream)) {}
+
+void RngContainer::seed_stream(int seed, uint32_t stage, uint64_t stream) {
+    rng_ = std::make_unique<PhiloxRandomNumberGenerator>(seed, stage, stream);
+}
 } // namespace vtr
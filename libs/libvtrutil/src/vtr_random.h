@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm> //For std::swap
+#include <array>
+#include <cstdint>
 #include <memory>
 
 #define CHECK_RAND
@@ -52,6 +54,56 @@ class RandomNumberGenerator : public RandomNumberGeneratorInterface {
     state_t random_state_ = 0;
 };
 
+/**
+ * @brief Counter-based (Philox4x32-10) random number generator
+ *
+ * Unlike RandomNumberGenerator, whose sequence only depends on its seed, the numbers generated
+ * here are a pure function of (seed, stage, stream, position in the stream). Parallel tasks can
+ * each draw from their own stream (e.g. stream = task id) and get statistically independent
+ * numbers which don't depend on the number of threads or on the order the tasks are run in,
+ * without consuming numbers from a shared generator.
+ *
+ * The streams are identical on all platforms and compilers.
+ */
+class PhiloxRandomNumberGenerator : public RandomNumberGeneratorInterface {
+  public:
+    typedef std::array<uint32_t, 4> counter_t;
+    typedef std::array<uint32_t, 2> key_t;
+
+    PhiloxRandomNumberGenerator(const PhiloxRandomNumberGenerator&) = delete;
+    PhiloxRandomNumberGenerator& operator=(PhiloxRandomNumberGenerator& other) = delete;
+
+    /**
+     * @brief Creates the generator of the given stream
+     *
+     * @param seed The user seed (e.g. the placer's --seed)
+     * @param stage Identifies the algorithm/stage drawing the numbers, so that different stages using
+     *              the same seed and stream ids get different numbers
+     * @param stream Identifies the task within the stage (e.g. a thread or region id)
+     */
+    PhiloxRandomNumberGenerator(int seed, uint32_t stage, uint64_t stream);
+
+    ///@brief Restarts the current stream (with the current stage) of the given seed
+    virtual void srandom(int seed) override;
+    virtual int irand(int imax) override;
+    virtual float frand() override;
+
+    ///@brief Returns the 4 random words of the given counter and key (the Philox4x32-10 bijection)
+    static counter_t philox4x32(counter_t counter, key_t key);
+
+  private:
+    ///@brief Returns the next 32 random bits of the stream
+    uint32_t next_word();
+
+    key_t key_;
+    uint64_t stream_;
+    ///Index of the next block of 4 words in the stream
+    uint64_t block_ = 0;
+    counter_t words_ = {0, 0, 0, 0};
+    ///Number of words of words_ already returned
+    size_t num_words_used_ = 4;
+};
+
 class RngContainer : public RandomNumberGeneratorInterface {
   public:
     RngContainer(const RngContainer&) = delete;
@@ -60,6 +112,12 @@ class RngContainer : public RandomNumberGeneratorInterface {
     RngContainer();
     explicit RngContainer(int seed);
 
+    ///@brief Contains the (counter-based) generator of the given stream, see PhiloxRandomNumberGenerator
+    RngContainer(int seed, uint32_t stage, uint64_t stream);
+
+    ///@brief Replaces the contained generator with the one of the given stream
+    void seed_stream(int seed, uint32_t stage, uint64_t stream);
+
     inline virtual void srandom(int seed) override { rng_->srandom(seed); }
     inline virtual int irand(int imax) override { return rng_->irand(imax); }
     inline virtual float frand() override { return rng_->frand(); }
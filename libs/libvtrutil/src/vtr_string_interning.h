@@ -40,6 +40,10 @@
  *     For reference, the reason that interned_string's does not have a
  *     reference back to the string_internment object is to keep their memory
  *     footprint lower.
+ *
+ *  string_internment is not thread safe.  concurrent_string_internment can be
+ *  used instead by several threads at once (e.g. parallel file readers): it
+ *  returns the same interned_string objects, which are used the same way.
  */
 #include <cstring>
 #include <string>
@@ -49,6 +53,9 @@
 #include <cstdint>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <string_view>
 
 #include "vtr_strong_id.h"
@@ -58,6 +65,7 @@
 namespace vtr {
 
 // Forward declare classes for pointers.
+class string_internment_base;
 class string_internment;
 class interned_string;
 class interned_string_less;
@@ -97,7 +105,7 @@ static_assert((1 << (CHAR_BIT * kSizeSize)) > kMaxParts, "Size of size data is t
  */
 class interned_string_iterator {
   public:
-    interned_string_iterator(const string_internment* internment, std::array<StringId, kMaxParts> intern_ids, size_t n);
+    interned_string_iterator(const string_internment_base* internment, std::array<StringId, kMaxParts> intern_ids, size_t n);
 
     interned_string_iterator() {
         clear();
@@ -136,7 +144,7 @@ class interned_string_iterator {
         view_ = std::string_view();
     }
 
-    const string_internment* internment_;
+    const string_internment_base* internment_;
     size_t num_parts_;
     std::array<StringId, kMaxParts> parts_;
     size_t part_idx_;
@@ -164,7 +172,7 @@ inline bool operator!=(const interned_string_iterator& lhs, const interned_strin
 class bound_interned_string {
   public:
     ///@brief constructor
-    bound_interned_string(const string_internment* internment, const interned_string* str)
+    bound_interned_string(const string_internment_base* internment, const interned_string* str)
         : internment_(internment)
         , str_(str) {}
 
@@ -174,7 +182,7 @@ class bound_interned_string {
     interned_string_iterator end() const;
 
   private:
-    const string_internment* internment_;
+    const string_internment_base* internment_;
     const interned_string* str_;
 };
 
@@ -201,14 +209,14 @@ class interned_string {
      *
      * internment must the object that generated this interned_string.
      */
-    void get(const string_internment* internment, std::string* output) const;
+    void get(const string_internment_base* internment, std::string* output) const;
 
     /**
      * @brief Returns the underlying string as a std::string.
      *
      * This method will allocated memory.
      */
-    std::string get(const string_internment* internment) const {
+    std::string get(const string_internment_base* internment) const {
         std::string result;
         get(internment, &result);
         return result;
@@ -222,12 +230,12 @@ class interned_string {
      * a reference this object, along with a reference to the internment
      * object.
      */
-    bound_interned_string bind(const string_internment* internment) const {
+    bound_interned_string bind(const string_internment_base* internment) const {
         return bound_interned_string(internment, this);
     }
 
     ///@brief begin() function
-    interned_string_iterator begin(const string_internment* internment) const {
+    interned_string_iterator begin(const string_internment_base* internment) const {
         size_t n = num_parts();
         std::array<StringId, kMaxParts> intern_ids;
 
@@ -337,17 +345,31 @@ inline bool operator<=(bound_interned_string lhs,
 }
 
 /**
- * @brief  Storage of interned string, and object capable of generating new interned_string objects.
+ * @brief Storage of interned string parts, as seen by interned_string.
+ *
+ * Implemented by string_internment and concurrent_string_internment.
  */
-class string_internment {
+class string_internment_base {
   public:
+    virtual ~string_internment_base() = default;
+
     /**
-     * @brief Intern a string, and return a unique identifier to that string.
+     * @brief Retrieve a string part based on id.
+     * This method should not generally be called directly.
+     */
+    virtual std::string_view get_string(StringId id) const = 0;
+
+    ///@brief Number of unique string parts stored.
+    virtual size_t unique_strings() const = 0;
+
+  protected:
+    /**
+     * @brief Split the string into its parts and intern each of them with intern_one.
      *
-     * If interned_string is ever called with two strings of the same value,
-     * the interned_string will be equal.
+     * intern_one is called with each part and returns its StringId.
      */
-    interned_string intern_string(std::string_view view) {
+    template<typename F>
+    static interned_string intern_parts(std::string_view view, F intern_one) {
         size_t num_parts = 1;
         for (const auto& c : view) {
             if (c == kSplitChar) {
@@ -358,7 +380,7 @@ class string_internment {
         std::array<StringId, kMaxParts> parts;
         if (num_parts == 1 || num_parts > kMaxParts) {
             // Intern entire string.
-            parts[0] = intern_one_string(view);
+            parts[0] = intern_one(view);
             return interned_string(parts, 1);
         } else {
             // Implements parts = [intern_one_string(s) for s in view.split(kSplitChar)]
@@ -367,7 +389,7 @@ class string_internment {
 
             for (size_t i = 0; i < view.size(); ++i) {
                 if (view[i] == kSplitChar) {
-                    parts[idx++] = intern_one_string(view.substr(start, i - start));
+                    parts[idx++] = intern_one(view.substr(start, i - start));
                     start = i + 1;
                     if (idx == num_parts - 1) {
                         break;
@@ -375,21 +397,39 @@ class string_internment {
                 }
             }
 
-            parts[idx++] = intern_one_string(view.substr(start));
+            parts[idx++] = intern_one(view.substr(start));
             return interned_string(parts, num_parts);
         }
     }
+};
+
+/**
+ * @brief  Storage of interned string, and object capable of generating new interned_string objects.
+ */
+class string_internment final : public string_internment_base {
+  public:
+    /**
+     * @brief Intern a string, and return a unique identifier to that string.
+     *
+     * If interned_string is ever called with two strings of the same value,
+     * the interned_string will be equal.
+     */
+    interned_string intern_string(std::string_view view) {
+        return intern_parts(view, [this](std::string_view part) {
+            return intern_one_string(part);
+        });
+    }
 
     /**
      * @brief Retrieve a string part based on id.
      * This method should not generally be called directly.
      */
-    std::string_view get_string(StringId id) const {
+    std::string_view get_string(StringId id) const override {
         return strings_[id];
     }
 
     ///@brief Number of unique string parts stored.
-    size_t unique_strings() const {
+    size_t unique_strings() const override {
         return strings_.size();
     }
 
@@ -414,12 +454,125 @@ class string_internment {
     std::unordered_map<std::string, StringId> string_to_id_;
 };
 
+/**
+ * @brief A string_internment which can be used by several threads at once.
+ *
+ * The string parts are spread over kNumShards shards by hash, each with its own
+ * lock, so threads interning different strings rarely wait for each other, and
+ * interning a string which is already stored only takes a shared lock.
+ *
+ * The parts are stored in fixed size chunks which never move, so looking up the
+ * string of an interned_string (get_string) takes no lock, and is safe while other
+ * threads intern new strings.  The strings are stored once: the shards only hold
+ * views of them.
+ *
+ * The StringIds (and so the interned_string objects) depend on the order in which
+ * the threads intern the strings, so only compare them for equality, as usual.
+ */
+class concurrent_string_internment final : public string_internment_base {
+  public:
+    concurrent_string_internment() = default;
+    concurrent_string_internment(const concurrent_string_internment&) = delete;
+    concurrent_string_internment& operator=(const concurrent_string_internment&) = delete;
+
+    ~concurrent_string_internment() override {
+        for (auto& chunk : chunks_) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Intern a string, and return a unique identifier to that string.
+     *
+     * Thread safe.  Equal strings give equal interned_string objects, whichever
+     * thread interned them.
+     */
+    interned_string intern_string(std::string_view view) {
+        return intern_parts(view, [this](std::string_view part) {
+            return intern_one_string(part);
+        });
+    }
+
+    /**
+     * @brief Retrieve a string part based on id.
+     * This method should not generally be called directly.  Lock free.
+     */
+    std::string_view get_string(StringId id) const override {
+        size_t index = (size_t)id;
+        return chunks_[index >> kChunkBits].load(std::memory_order_acquire)[index & kChunkMask];
+    }
+
+    ///@brief Number of unique string parts stored.
+    size_t unique_strings() const override {
+        return num_strings_.load(std::memory_order_acquire);
+    }
+
+  private:
+    StringId intern_one_string(std::string_view view) {
+        shard& part_shard = shards_[std::hash<std::string_view>()(view) % kNumShards];
+        {
+            std::shared_lock<std::shared_mutex> lock(part_shard.mutex);
+            auto iter = part_shard.string_to_id.find(view);
+            if (iter != part_shard.string_to_id.end()) {
+                return iter->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(part_shard.mutex);
+        // Another thread may have interned the string since the lookup
+        auto iter = part_shard.string_to_id.find(view);
+        if (iter != part_shard.string_to_id.end()) {
+            return iter->second;
+        }
+
+        size_t index = num_strings_.fetch_add(1, std::memory_order_acq_rel);
+        size_t ichunk = index >> kChunkBits;
+        if (ichunk >= kMaxChunks) {
+            throw std::runtime_error("Storage size exceeded.");
+        }
+
+        // The chunk may be allocated by any of the shards using it
+        std::string* chunk = chunks_[ichunk].load(std::memory_order_acquire);
+        if (chunk == nullptr) {
+            std::string* new_chunk = new std::string[kChunkSize];
+            if (chunks_[ichunk].compare_exchange_strong(chunk, new_chunk, std::memory_order_acq_rel)) {
+                chunk = new_chunk;
+            } else {
+                delete[] new_chunk;
+            }
+        }
+
+        std::string& stored = chunk[index & kChunkMask];
+        stored.assign(view.begin(), view.end());
+        StringId id(index);
+        part_shard.string_to_id.emplace(std::string_view(stored), id);
+        return id;
+    }
+
+    static constexpr size_t kChunkBits = 12;
+    static constexpr size_t kChunkSize = size_t(1) << kChunkBits;
+    static constexpr size_t kChunkMask = kChunkSize - 1;
+    ///@brief Enough chunks for every StringId (see kBytesPerId)
+    static constexpr size_t kMaxChunks = (size_t(1) << (kBytesPerId * CHAR_BIT)) >> kChunkBits;
+    static constexpr size_t kNumShards = 64;
+
+    ///@brief The parts with the same hash (modulo kNumShards), on their own cache lines
+    struct alignas(64) shard {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string_view, StringId> string_to_id;
+    };
+
+    std::array<std::atomic<std::string*>, kMaxChunks> chunks_{};
+    std::atomic<size_t> num_strings_{0};
+    std::array<shard, kNumShards> shards_;
+};
+
 /**
  * @brief Copy the underlying string into output.
  *
  * internment must the object that generated this interned_string.
  */
-inline void interned_string::get(const string_internment* internment, std::string* output) const {
+inline void interned_string::get(const string_internment_base* internment, std::string* output) const {
     // Implements
     // kSplitChar.join(interned_string->get_string(id(idx)) for idx in range(num_parts())));
     size_t parts = num_parts();
@@ -448,7 +601,7 @@ inline void interned_string::get(const string_internment* internment, std::strin
  * Do no construct this iterator directly.  Use either
  * bound_interned_string::begin/end or interned_string;:begin/end.
  */
-inline interned_string_iterator::interned_string_iterator(const string_internment* internment, std::array<StringId, kMaxParts> intern_ids, size_t n)
+inline interned_string_iterator::interned_string_iterator(const string_internment_base* internment, std::array<StringId, kMaxParts> intern_ids, size_t n)
     : internment_(internment)
     , num_parts_(n)
     , parts_(intern_ids)
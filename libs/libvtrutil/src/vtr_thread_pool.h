@@ -1,17 +1,23 @@
 #pragma once
 
-/** 
+/**
  * @file vtr_thread_pool.h
- * @brief A generic thread pool for parallel task execution
+ * @brief A generic work-stealing thread pool for parallel task execution
  */
 
 #include <thread>
-#include <queue>
+#include <deque>
+#include <array>
 #include <mutex>
 #include <condition_variable>
+#include <chrono>
+#include <exception>
+#include <future>
 #include <memory>
 #include <atomic>
 #include <functional>
+#include <type_traits>
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 #include "vtr_log.h"
@@ -19,10 +25,23 @@
 
 namespace vtr {
 
+/** Priority of a task: idle threads always take the highest priority task available */
+enum class e_task_priority {
+    HIGH = 0,
+    NORMAL,
+    LOW,
+    NUM_TASK_PRIORITIES
+};
+
 /**
- * A thread pool for parallel task execution. It is a naive
- * implementation which uses a queue for each thread and assigns
- * tasks in a round robin fashion.
+ * A work-stealing thread pool for parallel task execution.
+ *
+ * Each thread owns a double-ended task queue per priority. A task scheduled
+ * from one of the threads of the pool goes to the queue of that thread (so nested
+ * tasks stay on the thread which created them, while its data is in cache), and other
+ * tasks are distributed in a round robin fashion. A thread runs the newest task of its
+ * own queue first, and when it runs out of tasks it steals the oldest task of another
+ * thread (which is the root of the largest amount of remaining work).
  *
  * Example usage:
  *
@@ -31,112 +50,152 @@ namespace vtr {
  * pool.schedule_work([]{
  *     // Task body
  * });
- * pool.wait_for_all();  // There's no API to wait for a single task
+ * std::future<int> answer = pool.submit([]{ return 42; });
+ *
+ * vtr::thread_pool::task_group group(pool);
+ * group.run([]{ ... });
+ * group.run([]{ ... }, vtr::e_task_priority::HIGH);
+ * group.wait();  // Waits for (and helps with) the tasks of the group only
+ *
+ * pool.parallel_for(0, n, [&](size_t i){ ... });
+ *
+ * pool.wait_for_all();  // Waits for every task of the pool
  * ```
  */
 class thread_pool {
   private:
+    using Task = std::function<void()>;
+
+    static constexpr size_t NUM_PRIORITIES = (size_t)e_task_priority::NUM_TASK_PRIORITIES;
+
     /** Thread-local data */
     struct ThreadData {
         std::thread thread;
-        /** Per-thread task queue */
-        std::queue<std::function<void()>> task_queue;
-
-        /** Threads wait on cv for a stop signal or a new task
-         * queue_mutex is required for condition variable */
+        /** Per-thread task queue for each priority. The owner pushes and pops at
+         * the back, and other threads steal from the front */
+        std::array<std::deque<Task>, NUM_PRIORITIES> task_queues;
         std::mutex queue_mutex;
-        std::condition_variable cv;
-        bool stop = false;
     };
 
     /** Container for thread-local data */
     std::vector<std::unique_ptr<ThreadData>> threads;
     /** Used for round-robin scheduling */
     std::atomic<size_t> next_thread{0};
-    /** Used for wait_for_all */
+    /** Used for wait_for_all: tasks scheduled and not finished yet */
     std::atomic<size_t> active_tasks{0};
+    /** Tasks in the queues (counted before they are pushed, so it is never lower than the real count) */
+    std::atomic<size_t> queued_tasks{0};
+
+    /** Idle threads wait on wake_cv for a stop signal or a new task */
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    bool stop = false;
 
     /** Condition variable for wait_for_all */
     std::mutex completion_mutex;
     std::condition_variable completion_cv;
 
+    /** The pool and the index of the thread running the calling code, if it is a thread of a pool */
+    inline static thread_local thread_pool* current_pool = nullptr;
+    inline static thread_local size_t current_thread = 0;
+
   public:
+    class task_group;
+
     /** Create a thread pool with \p thread_count threads. */
     thread_pool(size_t thread_count) {
         threads.reserve(thread_count);
-
         for (size_t i = 0; i < thread_count; i++) {
-            auto thread_data = std::make_unique<ThreadData>();
+            threads.push_back(std::make_unique<ThreadData>());
+        }
 
-            thread_data->thread = std::thread([&]() {
-                ThreadData* td = thread_data.get();
+        /* Start the threads once all the queues exist, since they steal from each other */
+        for (size_t i = 0; i < thread_count; i++) {
+            threads[i]->thread = std::thread([this, i]() {
+                current_pool = this;
+                current_thread = i;
 
                 while (true) {
-                    std::function<void()> task;
-
-                    { /* Wait until a task is available or stop signal is received */
-                        std::unique_lock<std::mutex> lock(td->queue_mutex);
-
-                        td->cv.wait(lock, [td]() {
-                            return td->stop || !td->task_queue.empty();
-                        });
+                    if (run_one_task()) {
+                        continue;
+                    }
 
-                        if (td->stop && td->task_queue.empty()) {
-                            return;
-                        }
+                    /* Wait until a task is available or stop signal is received */
+                    std::unique_lock<std::mutex> lock(wake_mutex);
+                    wake_cv.wait(lock, [this]() {
+                        return stop || queued_tasks > 0;
+                    });
 
-                        /* Fetch a task from the queue */
-                        task = std::move(td->task_queue.front());
-                        td->task_queue.pop();
+                    if (stop && queued_tasks == 0) {
+                        return;
                     }
-
-                    vtr::Timer task_timer;
-                    task();
                 }
             });
-
-            threads.push_back(std::move(thread_data));
         }
     }
 
-    /** Schedule a function to be executed on one of the threads. */
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /** Number of threads of the pool */
+    size_t num_threads() const {
+        return threads.size();
+    }
+
+    /** Schedule a function to be executed on one of the threads.
+     * An exception escaping \p f is logged and terminates the program:
+     * use submit() or a task_group to get it back instead. */
     template<typename F>
-    void schedule_work(F&& f) {
+    void schedule_work(F&& f, e_task_priority priority = e_task_priority::NORMAL) {
         active_tasks++;
 
-        /* Round-robin thread assignment */
-        size_t thread_idx = (next_thread++) % threads.size();
-        auto thread_data = threads[thread_idx].get();
-
-        auto task = [this, f = std::forward<F>(f)]() {
+        auto task = [this, f = std::forward<F>(f)]() mutable {
             vtr::Timer task_timer;
 
             try {
                 f();
             } catch (const std::exception& e) {
                 VTR_LOG_ERROR("Thread %zu failed task with error: %s\n",
-                              std::this_thread::get_id(), e.what());
+                              std::hash<std::thread::id>()(std::this_thread::get_id()), e.what());
                 throw;
             } catch (...) {
                 VTR_LOG_ERROR("Thread %zu failed task with unknown error\n",
-                              std::this_thread::get_id());
+                              std::hash<std::thread::id>()(std::this_thread::get_id()));
                 throw;
             }
 
             size_t remaining = --active_tasks;
             if (remaining == 0) {
+                /* Lock so that the notification can't fall between the check and the wait of wait_for_all */
+                std::lock_guard<std::mutex> lock(completion_mutex);
                 completion_cv.notify_all();
             }
         };
 
-        /* Queue new task */
-        {
-            std::lock_guard<std::mutex> lock(thread_data->queue_mutex);
-            thread_data->task_queue.push(std::move(task));
-        }
-        thread_data->cv.notify_one();
+        push_task(std::move(task), priority);
     }
 
+    /** Schedule a function to be executed on one of the threads, and return
+     * a future for its result (or the exception it threw). */
+    template<typename F>
+    auto submit(F&& f, e_task_priority priority = e_task_priority::NORMAL) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+
+        /* std::function needs a copyable callable */
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+        std::future<R> result = task->get_future();
+        schedule_work([task]() { (*task)(); }, priority);
+        return result;
+    }
+
+    /**
+     * Run \p f(i) for every i in [\p begin, \p end), in chunks of \p grain_size
+     * indices (or about 4 chunks per thread when it is 0), and wait for all of them.
+     * The calling thread runs chunks too. The first exception thrown is rethrown here.
+     */
+    template<typename Index, typename F>
+    void parallel_for(Index begin, Index end, const F& f, size_t grain_size = 0);
+
     /** Wait until the work queue is empty.
      * Note that functions are allowed to schedule new functions. */
     void wait_for_all() {
@@ -146,13 +205,11 @@ class thread_pool {
 
     ~thread_pool() {
         /* Stop all threads */
-        for (auto& thread_data : threads) {
-            {
-                std::lock_guard<std::mutex> lock(thread_data->queue_mutex);
-                thread_data->stop = true;
-            }
-            thread_data->cv.notify_one();
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stop = true;
         }
+        wake_cv.notify_all();
 
         for (auto& thread_data : threads) {
             if (thread_data->thread.joinable()) {
@@ -160,6 +217,178 @@ class thread_pool {
             }
         }
     }
+
+  private:
+    /** Queue a task on the current thread if it belongs to this pool, or the next one in round-robin order */
+    void push_task(Task task, e_task_priority priority) {
+        size_t thread_idx = (current_pool == this) ? current_thread : (next_thread++) % threads.size();
+        ThreadData* thread_data = threads[thread_idx].get();
+
+        {
+            std::lock_guard<std::mutex> lock(thread_data->queue_mutex);
+            queued_tasks++;
+            thread_data->task_queues[(size_t)priority].push_back(std::move(task));
+        }
+
+        /* Lock so that the notification can't fall between the check and the wait of an idle thread */
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+        }
+        wake_cv.notify_one();
+    }
+
+    /** Take the next task for the current thread: the newest of its own queue, or the
+     * oldest of another thread, highest priority first. Returns false if there is none. */
+    bool pop_task(Task& task) {
+        if (queued_tasks == 0) {
+            return false;
+        }
+
+        /* Threads outside of the pool (helping in task_group::wait()) steal only */
+        bool in_pool = (current_pool == this);
+        size_t first = in_pool ? current_thread : (next_thread.load() % threads.size());
+
+        for (size_t priority = 0; priority < NUM_PRIORITIES; priority++) {
+            for (size_t offset = 0; offset < threads.size(); offset++) {
+                ThreadData* thread_data = threads[(first + offset) % threads.size()].get();
+                bool own = in_pool && offset == 0;
+
+                std::lock_guard<std::mutex> lock(thread_data->queue_mutex);
+                std::deque<Task>& queue = thread_data->task_queues[priority];
+                if (queue.empty()) {
+                    continue;
+                }
+
+                if (own) {
+                    task = std::move(queue.back());
+                    queue.pop_back();
+                } else {
+                    task = std::move(queue.front());
+                    queue.pop_front();
+                }
+                queued_tasks--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Run one queued task on the calling thread. Returns false if there was none. */
+    bool run_one_task() {
+        Task task;
+        if (!pop_task(task)) {
+            return false;
+        }
+        task();
+        return true;
+    }
+};
+
+/**
+ * A group of tasks running on a thread pool, which can be waited for
+ * independently of the other tasks of the pool.
+ *
+ * The tasks of a group may run more tasks in the same group, or wait
+ * for other groups: a waiting thread runs queued tasks in the meantime,
+ * so this does not deadlock even when every thread of the pool waits.
+ */
+class thread_pool::task_group {
+  public:
+    task_group(thread_pool& pool)
+        : pool_(pool) {}
+
+    task_group(const task_group&) = delete;
+    task_group& operator=(const task_group&) = delete;
+
+    /** Waits for the remaining tasks (ignoring their exceptions) */
+    ~task_group() {
+        try {
+            wait();
+        } catch (...) {
+        }
+    }
+
+    /** Run \p f on the pool as a task of this group */
+    template<typename F>
+    void run(F&& f, e_task_priority priority = e_task_priority::NORMAL) {
+        state_->pending++;
+
+        pool_.schedule_work([state = state_, f = std::forward<F>(f)]() mutable {
+            try {
+                f();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->exception) {
+                    state->exception = std::current_exception();
+                }
+            }
+
+            if (--state->pending == 0) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->cv.notify_all();
+            }
+        },
+                            priority);
+    }
+
+    /** Wait for every task of the group, running queued tasks of the pool in the
+     * meantime. Rethrows the first exception thrown by a task of the group. */
+    void wait() {
+        while (state_->pending > 0) {
+            if (pool_.run_one_task()) {
+                continue;
+            }
+
+            /* Nothing to help with: sleep until the group completes, but check back
+             * regularly since the remaining tasks may schedule more work */
+            std::unique_lock<std::mutex> lock(state_->mutex);
+            state_->cv.wait_for(lock, std::chrono::milliseconds(1), [this]() { return state_->pending == 0; });
+        }
+
+        std::exception_ptr exception;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            std::swap(exception, state_->exception);
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+  private:
+    /** Shared with the tasks, which may finish after the task_group is destroyed if wait() threw */
+    struct State {
+        std::atomic<size_t> pending{0};
+        std::exception_ptr exception;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+
+    thread_pool& pool_;
+    std::shared_ptr<State> state_ = std::make_shared<State>();
 };
 
+template<typename Index, typename F>
+void thread_pool::parallel_for(Index begin, Index end, const F& f, size_t grain_size) {
+    if (end <= begin) {
+        return;
+    }
+
+    size_t count = size_t(end - begin);
+    if (grain_size == 0) {
+        grain_size = std::max<size_t>(1, count / (4 * std::max<size_t>(1, threads.size())));
+    }
+
+    task_group group(*this);
+    for (size_t chunk_begin = 0; chunk_begin < count; chunk_begin += grain_size) {
+        size_t chunk_end = std::min(count, chunk_begin + grain_size);
+        group.run([&f, begin, chunk_begin, chunk_end]() {
+            for (size_t i = chunk_begin; i < chunk_end; i++) {
+                f(Index(begin + i));
+            }
+        });
+    }
+    group.wait();
+}
+
 } // namespace vtr
@@ -3,6 +3,8 @@
 #include <chrono>
 #include <string>
 
+#include "vtr_profile.h"
+
 namespace vtr {
 
 ///@brief Class for tracking time elapsed since construction
@@ -36,7 +38,7 @@ class Timer {
     constexpr static float BYTE_TO_MIB = 1024 * 1024;
 };
 
-///@brief Scoped time class which prints the time elapsed for the specified action
+///@brief Scoped time class which prints the time elapsed for the specified action (and profiles it as a zone, see vtr_profile.h)
 class ScopedActionTimer : public Timer {
   public:
     ScopedActionTimer(std::string action);
@@ -54,6 +56,7 @@ class ScopedActionTimer : public Timer {
     const std::string action_;
     bool quiet_ = false;
     int depth_;
+    profile::Zone zone_;
 };
 
 /**
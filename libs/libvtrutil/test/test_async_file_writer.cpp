@@ -0,0 +1,45 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_async_file_writer.h"
+#include "vtr_error.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+static std::string read_file(const std::string& file_name) {
+    std::ifstream is(file_name);
+    std::stringstream ss;
+    ss << is.rdbuf();
+    return ss.str();
+}
+
+TEST_CASE("MemoryOutputFile", "[vtr_async_file_writer]") {
+    vtr::MemoryOutputFile file;
+    fprintf(file.fp(), "%s %d\n", "block", 42);
+    for (int i = 0; i < 100000; i++) {
+        fputc('x', file.fp());
+    }
+
+    std::string contents = file.take_contents();
+    REQUIRE(contents.size() == 9 + 100000);
+    REQUIRE(contents.substr(0, 9) == "block 42\n");
+}
+
+TEST_CASE("write_file_async", "[vtr_async_file_writer]") {
+    const std::string file_name = "test_async_file_writer.txt";
+
+    // The last queued contents of a file win
+    vtr::write_file_async(file_name, "first");
+    vtr::write_file_async(file_name, std::string(1 << 20, 'y'));
+    vtr::write_file_async(file_name, "last\n");
+    vtr::wait_for_async_file_writes();
+    REQUIRE(read_file(file_name) == "last\n");
+    std::remove(file_name.c_str());
+
+    // Errors are reported once, by the next wait
+    vtr::write_file_async("non_existent_directory/file.txt", "contents");
+    REQUIRE_THROWS_AS(vtr::wait_for_async_file_writes(), vtr::VtrError);
+    vtr::wait_for_async_file_writes();
+}
@@ -0,0 +1,153 @@
+/**
+ * @file
+ * @brief   Test cases for the open-addressing hash map and set in vtr_flat_hash_map.
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_flat_hash_map.h"
+#include "vtr_log.h"
+#include "vtr_random.h"
+#include "vtr_strong_id.h"
+#include "vtr_time.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct test_tag;
+typedef vtr::StrongId<test_tag> TestId;
+
+TEST_CASE("flat_hash_map_basic", "[vtr_flat_hash_map]") {
+    vtr::flat_hash_map<TestId, float> map;
+    REQUIRE(map.empty());
+    REQUIRE(map.find(TestId(3)) == map.end());
+    REQUIRE(map.begin() == map.end());
+
+    map[TestId(3)] = 1.5;
+    map[TestId(4)] += 2;
+    REQUIRE(map.insert({TestId(5), 3.}).second);
+    REQUIRE(!map.insert({TestId(5), 4.}).second);
+    REQUIRE(map.try_emplace(TestId(6), 6.).second);
+    REQUIRE(!map.insert_or_assign(TestId(6), 7.).second);
+
+    REQUIRE(map.size() == 4);
+    REQUIRE(map.at(TestId(3)) == 1.5);
+    REQUIRE(map[TestId(4)] == 2);
+    REQUIRE(map.find(TestId(5))->second == 3.);
+    REQUIRE(map.at(TestId(6)) == 7.);
+    REQUIRE(map.count(TestId(7)) == 0);
+    REQUIRE_THROWS_AS(map.at(TestId(7)), std::out_of_range);
+
+    REQUIRE(map.erase(TestId(3)) == 1);
+    REQUIRE(map.erase(TestId(3)) == 0);
+    REQUIRE(!map.contains(TestId(3)));
+    REQUIRE(map.size() == 3);
+
+    // Copies are independent
+    vtr::flat_hash_map<TestId, float> copy = map;
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(copy.size() == 3);
+    REQUIRE(copy.at(TestId(5)) == 3.);
+
+    vtr::flat_hash_map<TestId, float> moved = std::move(copy);
+    REQUIRE(moved.size() == 3);
+    std::swap(map, moved);
+    REQUIRE(map.size() == 3);
+    REQUIRE(moved.empty());
+}
+
+TEST_CASE("flat_hash_map_against_std", "[vtr_flat_hash_map]") {
+    // Random inserts and erases (leaving many tombstones) with non-trivial keys and values
+    vtr::flat_hash_map<std::string, std::unique_ptr<int>> map;
+    std::map<std::string, int> ref;
+    vtr::RngContainer rng(7);
+    for (int i = 0; i < 20000; i++) {
+        std::string key = "key" + std::to_string(rng.irand(2000));
+        if (rng.irand(2) == 0) {
+            map[key] = std::make_unique<int>(i);
+            ref[key] = i;
+        } else {
+            REQUIRE(map.erase(key) == ref.erase(key));
+        }
+    }
+
+    REQUIRE(map.size() == ref.size());
+    size_t num_visited = 0;
+    for (const auto& [key, value] : map) {
+        REQUIRE(ref.at(key) == *value);
+        num_visited++;
+    }
+    REQUIRE(num_visited == ref.size());
+
+    // Erasing while iterating visits every element once
+    for (auto iter = map.begin(); iter != map.end();) {
+        if (*iter->second % 2 == 0) {
+            REQUIRE(ref.erase(iter->first) == 1);
+            iter = map.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    REQUIRE(map.size() == ref.size());
+    for (const auto& [key, value] : ref) {
+        REQUIRE(*map.at(key) == value);
+    }
+}
+
+TEST_CASE("flat_hash_set_basic", "[vtr_flat_hash_map]") {
+    int values[4];
+    vtr::flat_hash_set<const int*> set = {&values[0], &values[1]};
+    REQUIRE(set.insert(&values[2]).second);
+    REQUIRE(!set.insert(&values[0]).second);
+    REQUIRE(set.size() == 3);
+    REQUIRE(set.contains(&values[1]));
+    REQUIRE(!set.contains(&values[3]));
+
+    set.reserve(1000);
+    REQUIRE(set.capacity() >= 1000);
+    REQUIRE(set.size() == 3);
+    REQUIRE(set.erase(&values[1]) == 1);
+    REQUIRE(set.size() == 2);
+}
+
+/// Compares look-ups and inserts in flat_hash_map and std::unordered_map (run with the [benchmark] tag)
+TEST_CASE("flat_hash_map_benchmark", "[.][benchmark][vtr_flat_hash_map]") {
+    constexpr size_t num_keys = 1 << 20;
+    constexpr size_t num_lookups = 20 * 1000 * 1000;
+
+    std::vector<TestId> keys;
+    vtr::RngContainer rng(1);
+    for (size_t i = 0; i < num_keys; i++) {
+        keys.push_back(TestId(rng.irand(1 << 30)));
+    }
+
+    auto run = [&](auto& map, const char* name) {
+        vtr::Timer insert_timer;
+        for (TestId key : keys) {
+            map[key] += 1.f;
+        }
+        float insert_sec = insert_timer.elapsed_sec();
+
+        vtr::Timer lookup_timer;
+        float sum = 0;
+        for (size_t i = 0; i < num_lookups; i++) {
+            auto iter = map.find(keys[(i * 7919) % num_keys]);
+            sum += iter->second;
+        }
+        REQUIRE(sum > 0);
+        VTR_LOG("%s: inserts %.3f s, look-ups %.3f s\n", name, insert_sec, lookup_timer.elapsed_sec());
+    };
+
+    std::unordered_map<TestId, float> std_map;
+    run(std_map, "std::unordered_map");
+    vtr::flat_hash_map<TestId, float> flat_map;
+    run(flat_map, "vtr::flat_hash_map");
+}
+
+} // namespace
@@ -0,0 +1,120 @@
+/**
+ * @file
+ * @brief   Test cases for the huge page allocations in vtr_memory, and the matrices using them.
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_memory.h"
+#include "vtr_ndmatrix.h"
+#include "vtr_random.h"
+#include "vtr_time.h"
+#include "vtr_vector.h"
+#include "vtr_log.h"
+
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+
+TEST_CASE("huge_page_allocate", "[vtr_memory]") {
+    bool huge_pages = vtr::huge_pages_enabled();
+
+    // Large allocations are aligned to huge pages (unless the allocations are counted)
+    if (!vtr::allocation_counting_enabled()) {
+        vtr::set_huge_pages_enabled(true);
+        void* large = vtr::huge_page_allocate(3 * vtr::HUGE_PAGE_SIZE + 1, 8);
+        REQUIRE(reinterpret_cast<uintptr_t>(large) % vtr::HUGE_PAGE_SIZE == 0);
+        vtr::huge_page_deallocate(large);
+    }
+
+    // Other allocations honour the requested alignment
+    for (bool enabled : {true, false}) {
+        vtr::set_huge_pages_enabled(enabled);
+        for (size_t bytes : {size_t(0), size_t(24), vtr::HUGE_PAGE_SIZE}) {
+            void* ptr = vtr::huge_page_allocate(bytes, 64);
+            REQUIRE(ptr != nullptr);
+            REQUIRE(reinterpret_cast<uintptr_t>(ptr) % 64 == 0);
+            vtr::huge_page_deallocate(ptr);
+        }
+    }
+
+    vtr::set_huge_pages_enabled(huge_pages);
+}
+
+TEST_CASE("huge_page_matrices", "[vtr_memory]") {
+    // Elements which aren't trivially constructible and destructible
+    vtr::NdMatrix<std::string, 2> names({3, 4}, "x");
+    names[2][3] = "last";
+    vtr::NdMatrix<std::string, 2> copy = names;
+    names.clear();
+    REQUIRE(copy[0][0] == "x");
+    REQUIRE(copy[2][3] == "last");
+
+    // A matrix spanning several huge pages
+    vtr::NdMatrix<float, 3> large({4, 512, 512}, 1.5);
+    REQUIRE(large[3][511][511] == 1.5);
+    large.resize({2, 2, 2});
+    REQUIRE(large.size() == 8);
+    large.clear();
+    REQUIRE(large.empty());
+
+    vtr::vector<size_t, int, vtr::huge_page_allocator<int>> vec(vtr::HUGE_PAGE_SIZE, 7);
+    vec.push_back(8);
+    REQUIRE(vec[0] == 7);
+    REQUIRE(vec.back() == 8);
+}
+
+TEST_CASE("aliased_matrices", "[vtr_memory]") {
+    // External storage, e.g. a memory mapped file
+    auto storage = std::make_shared<std::vector<float>>(24);
+    std::iota(storage->begin(), storage->end(), 0.f);
+
+    vtr::NdMatrix<float, 3> matrix;
+    matrix.alias({2, 3, 4}, storage->data(), storage);
+    REQUIRE(storage.use_count() == 2);
+    REQUIRE(matrix.size() == 24);
+    REQUIRE(matrix[1][2][3] == 23.f);
+    REQUIRE(matrix[1][0][1] == 13.f);
+
+    // Copies own their elements
+    vtr::NdMatrix<float, 3> copy = matrix;
+    REQUIRE(&copy[0][0][0] != storage->data());
+    REQUIRE(copy[1][2][3] == 23.f);
+
+    // Moves keep the alias
+    vtr::NdMatrix<float, 3> moved = std::move(matrix);
+    REQUIRE(&moved[0][0][0] == storage->data());
+
+    // Resizing releases the external storage
+    moved.resize({2, 2, 2}, 1.f);
+    REQUIRE(storage.use_count() == 1);
+    REQUIRE((*storage)[0] == 0.f);
+}
+
+/// Compares random gathers in a large matrix with and without huge pages (run with the [benchmark] tag)
+TEST_CASE("huge_page_gather_benchmark", "[.][benchmark][vtr_memory]") {
+    bool huge_pages = vtr::huge_pages_enabled();
+    constexpr size_t num_elements = 64 * vtr::HUGE_PAGE_SIZE / sizeof(float);
+    constexpr size_t num_reads = 20 * 1000 * 1000;
+
+    for (bool enabled : {false, true}) {
+        vtr::set_huge_pages_enabled(enabled);
+        vtr::NdMatrix<float, 1> matrix({num_elements}, 1.f);
+
+        vtr::RngContainer rng(1);
+        vtr::Timer timer;
+        float sum = 0;
+        for (size_t i = 0; i < num_reads; i++) {
+            sum += matrix[rng.irand(num_elements - 1)];
+        }
+        REQUIRE(sum > 0);
+        VTR_LOG("Random reads %s huge pages: %.3f s\n", enabled ? "with" : "without", timer.elapsed_sec());
+    }
+
+    vtr::set_huge_pages_enabled(huge_pages);
+}
+
+} // namespace
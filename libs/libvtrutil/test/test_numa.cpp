@@ -0,0 +1,65 @@
+/**
+ * @file
+ * @brief   Test cases for the NUMA topology, thread pinning and page placement in vtr_numa.
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_memory.h"
+#include "vtr_numa.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+TEST_CASE("numa_topology", "[vtr_numa]") {
+    REQUIRE(vtr::numa::num_nodes() >= 1);
+    REQUIRE(vtr::numa::page_size() > 0);
+
+    // A CPU belongs to a single node
+    for (size_t node = 0; node < vtr::numa::num_nodes(); node++) {
+        for (size_t other = node + 1; other < vtr::numa::num_nodes(); other++) {
+            for (int cpu : vtr::numa::node_cpus(node)) {
+                for (int other_cpu : vtr::numa::node_cpus(other)) {
+                    REQUIRE(cpu != other_cpu);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("numa_pinning", "[vtr_numa]") {
+    // Pin a separate thread, so the affinity of the test runner is kept
+    std::thread thread([]() {
+        for (size_t node = 0; node < vtr::numa::num_nodes(); node++) {
+            bool pinned = vtr::numa::pin_current_thread(node);
+            REQUIRE(pinned == !vtr::numa::node_cpus(node).empty());
+        }
+        vtr::numa::unpin_current_thread();
+    });
+    thread.join();
+}
+
+TEST_CASE("numa_bind_memory", "[vtr_numa]") {
+    size_t page = vtr::numa::page_size();
+    size_t bytes = 8 * page;
+    void* ptr = nullptr;
+    REQUIRE(vtr::memalign(&ptr, page, bytes) == 0);
+    char* data = static_cast<char*>(ptr);
+    std::memset(data, 7, bytes);
+
+    // Binding (and possibly moving) the pages keeps their contents, whether or not it is supported
+    vtr::numa::bind_memory(data + page / 2, bytes - page, vtr::numa::num_nodes() - 1);
+    for (size_t i = 0; i < bytes; i++) {
+        REQUIRE(data[i] == 7);
+    }
+
+    // Nothing to do for ranges without whole pages
+    REQUIRE(vtr::numa::bind_memory(data + 1, page - 2, 0));
+
+    std::free(data);
+}
+
+} // namespace
@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @brief   Test cases for the profiling zones in vtr_util.
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_profile.h"
+#include "vtr_time.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const vtr::profile::t_zone_summary* find_zone(const std::vector<vtr::profile::t_zone_summary>& zones, const std::string& name) {
+    for (const auto& zone : zones) {
+        if (zone.name == name) {
+            return &zone;
+        }
+    }
+    return nullptr;
+}
+
+void busy_wait() {
+    vtr::Timer timer;
+    while (timer.elapsed_sec() < 0.002) {
+    }
+}
+
+TEST_CASE("profile_zones", "[vtr_profile]") {
+    vtr::profile::clear();
+
+    // Nothing is recorded while profiling is off
+    {
+        VTR_PROFILE_ZONE("off");
+    }
+    REQUIRE(vtr::profile::summary().empty());
+
+    vtr::profile::enable(true);
+    {
+        VTR_PROFILE_ZONE("outer");
+        busy_wait();
+        for (int i = 0; i < 3; i++) {
+            VTR_PROFILE_ZONE(std::string("inner"));
+            busy_wait();
+        }
+
+        // Zones of other threads are separate trees
+        std::thread thread([]() {
+            VTR_PROFILE_ZONE("inner");
+            busy_wait();
+        });
+        thread.join();
+
+        vtr::ScopedFinishTimer timer("timer");
+        timer.quiet(true);
+    }
+    vtr::profile::enable(false);
+
+    std::vector<vtr::profile::t_zone_summary> zones = vtr::profile::summary();
+    REQUIRE(zones.size() == 3);
+    REQUIRE(zones[0].name == "outer");
+
+    const auto* outer = find_zone(zones, "outer");
+    const auto* inner = find_zone(zones, "inner");
+    REQUIRE(outer->calls == 1);
+    REQUIRE(inner->calls == 4);
+    REQUIRE(find_zone(zones, "timer")->calls == 1);
+
+    // The self time of a zone excludes the zones nested in it on the same thread only
+    REQUIRE(inner->self_ns == inner->total_ns);
+    REQUIRE(outer->self_ns < outer->total_ns);
+    REQUIRE(outer->total_ns >= outer->self_ns + inner->total_ns * 3 / 4);
+    REQUIRE(outer->self_ns >= 2000000);
+
+    SECTION("chrome trace") {
+        const char* trace_file = "test_profile.trace.json";
+        vtr::profile::write_chrome_trace(trace_file);
+
+        std::ifstream file(trace_file);
+        std::stringstream trace;
+        trace << file.rdbuf();
+        REQUIRE(trace.str().rfind("{\"traceEvents\":[", 0) == 0);
+        REQUIRE(trace.str().find("{\"name\":\"outer\",\"ph\":\"X\"") != std::string::npos);
+        std::remove(trace_file);
+    }
+
+    vtr::profile::clear();
+    REQUIRE(vtr::profile::summary().empty());
+}
+
+} // namespace
@@ -14,3 +14,72 @@ TEST_CASE("shuffle", "[vtr_random/shuffle]") {
     std::vector<int> numbers_shuffled_1 = {5, 2, 4, 1, 3};
     REQUIRE(numbers == numbers_shuffled_1);
 }
+
+TEST_CASE("philox_known_answers", "[vtr_random/philox]") {
+    // Known answer tests of the Random123 library
+    using Philox = vtr::PhiloxRandomNumberGenerator;
+    const Philox::counter_t zeros = Philox::philox4x32({0, 0, 0, 0}, {0, 0});
+    const Philox::counter_t ones = Philox::philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff});
+    const Philox::counter_t pi = Philox::philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0});
+
+    const Philox::counter_t expected_zeros = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+    const Philox::counter_t expected_ones = {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+    const Philox::counter_t expected_pi = {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+    REQUIRE(zeros == expected_zeros);
+    REQUIRE(ones == expected_ones);
+    REQUIRE(pi == expected_pi);
+}
+
+TEST_CASE("philox_streams", "[vtr_random/philox]") {
+    auto draw = [](vtr::RngContainer& rng) {
+        std::vector<int> numbers;
+        for (int i = 0; i < 100; i++) {
+            numbers.push_back(rng.irand(1000));
+        }
+        return numbers;
+    };
+
+    vtr::RngContainer rng(1, 2, 3);
+    std::vector<int> numbers = draw(rng);
+
+    SECTION("same stream, same numbers") {
+        vtr::RngContainer same_rng(1, 2, 3);
+        REQUIRE(draw(same_rng) == numbers);
+
+        // Restarting a stream reproduces it
+        rng.seed_stream(1, 2, 3);
+        REQUIRE(draw(rng) == numbers);
+        rng.srandom(1);
+        REQUIRE(draw(rng) == numbers);
+    }
+
+    SECTION("different seeds, stages or streams give different numbers") {
+        vtr::RngContainer other_seed(2, 2, 3);
+        vtr::RngContainer other_stage(1, 3, 3);
+        vtr::RngContainer other_stream(1, 2, 4);
+        vtr::RngContainer other_high_stream(1, 2, 3 + (uint64_t(1) << 32));
+        REQUIRE(draw(other_seed) != numbers);
+        REQUIRE(draw(other_stage) != numbers);
+        REQUIRE(draw(other_stream) != numbers);
+        REQUIRE(draw(other_high_stream) != numbers);
+    }
+
+    SECTION("ranges") {
+        int num_max = 0;
+        for (int i = 0; i < 10000; i++) {
+            int ival = rng.irand(7);
+            REQUIRE(ival >= 0);
+            REQUIRE(ival <= 7);
+            num_max += (ival == 7);
+
+            float fval = rng.frand();
+            REQUIRE(fval >= 0.f);
+            REQUIRE(fval < 1.f);
+
+            REQUIRE(rng.irand(0) == 0);
+        }
+        // imax itself is drawn (about 1 time in 8)
+        REQUIRE(num_max > 1000);
+        REQUIRE(num_max < 1500);
+    }
+}
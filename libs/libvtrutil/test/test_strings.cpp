@@ -1,6 +1,9 @@
 #include "catch2/catch_test_macros.hpp"
 
+#include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 #include "vtr_string_interning.h"
 
 TEST_CASE("Basic string internment", "[vtr_string_interning/string_internment]") {
@@ -65,7 +68,7 @@ TEST_CASE("Basic string internment", "[vtr_string_interning/string_internment]")
     REQUIRE(f == b);
 }
 
-static void test_internment_retreval(const vtr::string_internment* internment, vtr::interned_string str, const char* expect) {
+static void test_internment_retreval(const vtr::string_internment_base* internment, vtr::interned_string str, const char* expect) {
     std::string copy;
     str.get(internment, &copy);
     REQUIRE(copy == expect);
@@ -149,3 +152,45 @@ TEST_CASE("Split string internment", "[vtr_string_interning/string_internment]")
     test_internment_retreval(&internment, q, "e..f");
     test_internment_retreval(&internment, r, "e.");
 }
+
+TEST_CASE("Concurrent string internment", "[vtr_string_interning/concurrent_string_internment]") {
+    vtr::concurrent_string_internment internment;
+
+    vtr::interned_string a = internment.intern_string("tile.clb.a");
+    REQUIRE(internment.unique_strings() == 3);
+    test_internment_retreval(&internment, a, "tile.clb.a");
+    REQUIRE(internment.intern_string("tile.clb.a") == a);
+
+    // Threads interning overlapping strings (enough to use several chunks) get the same interned strings
+    constexpr size_t num_threads = 4;
+    constexpr size_t num_strings = 10000;
+    std::vector<std::vector<vtr::interned_string>> thread_strings(num_threads);
+    std::vector<size_t> thread_mismatches(num_threads, 0);
+    std::vector<std::thread> threads;
+    for (size_t ithread = 0; ithread < num_threads; ithread++) {
+        threads.emplace_back([&, ithread]() {
+            for (size_t i = 0; i < num_strings; i++) {
+                size_t istring = (i + ithread * num_strings / num_threads) % num_strings;
+                vtr::interned_string str = internment.intern_string("blk" + std::to_string(istring) + ".out");
+                // Strings can be read while others are interned (Catch2 assertions aren't thread safe)
+                if (str.get(&internment) != "blk" + std::to_string(istring) + ".out") {
+                    thread_mismatches[ithread]++;
+                }
+                thread_strings[ithread].push_back(str);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(thread_mismatches == std::vector<size_t>(num_threads, 0));
+    REQUIRE(internment.unique_strings() == 3 + num_strings + 1);
+    for (size_t i = 0; i < num_strings; i++) {
+        vtr::interned_string str = internment.intern_string("blk" + std::to_string(i) + ".out");
+        for (size_t ithread = 0; ithread < num_threads; ithread++) {
+            REQUIRE(thread_strings[ithread][(i + num_strings - ithread * num_strings / num_threads) % num_strings] == str);
+        }
+        test_internment_retreval(&internment, str, ("blk" + std::to_string(i) + ".out").c_str());
+    }
+}
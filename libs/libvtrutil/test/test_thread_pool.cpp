@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @brief   Test cases for the work-stealing thread pool in vtr_util.
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_thread_pool.h"
+
+#include <atomic>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("schedule_work", "[vtr_thread_pool]") {
+    vtr::thread_pool pool(4);
+    std::atomic<int> count{0};
+
+    // Tasks may schedule more tasks, which wait_for_all waits for too.
+    for (int i = 0; i < 10; i++) {
+        pool.schedule_work([&]() {
+            for (int j = 0; j < 10; j++) {
+                pool.schedule_work([&]() { count++; }, vtr::e_task_priority::LOW);
+            }
+            count++;
+        });
+    }
+    pool.wait_for_all();
+
+    REQUIRE(count == 110);
+}
+
+TEST_CASE("submit", "[vtr_thread_pool]") {
+    vtr::thread_pool pool(2);
+
+    std::future<int> answer = pool.submit([]() { return 42; });
+    std::future<void> failure = pool.submit([]() { throw std::runtime_error("task failed"); });
+
+    REQUIRE(answer.get() == 42);
+    REQUIRE_THROWS_WITH(failure.get(), "task failed");
+}
+
+TEST_CASE("task_group", "[vtr_thread_pool]") {
+    vtr::thread_pool pool(2);
+
+    SECTION("nested groups") {
+        // Every thread of the pool ends up waiting on a group: the waiting threads
+        // must run the queued tasks instead of deadlocking.
+        std::atomic<int> count{0};
+        vtr::thread_pool::task_group outer(pool);
+        for (int i = 0; i < 8; i++) {
+            outer.run([&]() {
+                vtr::thread_pool::task_group inner(pool);
+                for (int j = 0; j < 8; j++) {
+                    inner.run([&]() { count++; }, vtr::e_task_priority::HIGH);
+                }
+                inner.wait();
+            });
+        }
+        outer.wait();
+
+        REQUIRE(count == 64);
+    }
+
+    SECTION("exceptions") {
+        std::atomic<int> count{0};
+        vtr::thread_pool::task_group group(pool);
+        for (int i = 0; i < 10; i++) {
+            group.run([&, i]() {
+                count++;
+                if (i == 5) {
+                    throw std::runtime_error("task 5 failed");
+                }
+            });
+        }
+
+        // The other tasks still run
+        REQUIRE_THROWS_WITH(group.wait(), "task 5 failed");
+        REQUIRE(count == 10);
+
+        // The exception is reported once
+        REQUIRE_NOTHROW(group.wait());
+    }
+}
+
+TEST_CASE("parallel_for", "[vtr_thread_pool]") {
+    vtr::thread_pool pool(3);
+
+    std::vector<int> vals(1000, 0);
+    pool.parallel_for(size_t(0), vals.size(), [&](size_t i) { vals[i] = int(i); });
+    REQUIRE(std::accumulate(vals.begin(), vals.end(), 0) == 999 * 1000 / 2);
+
+    // Explicit grain size, and an empty range
+    std::atomic<int> count{0};
+    pool.parallel_for(10, 27, [&](int i) { count += i; }, 5);
+    pool.parallel_for(5, 5, [&](int) { count = -1; });
+    REQUIRE(count == (10 + 26) * 17 / 2);
+
+    REQUIRE_THROWS_WITH(pool.parallel_for(0, 100, [](int i) { if (i == 50) throw std::runtime_error("index 50"); }), "index 50");
+}
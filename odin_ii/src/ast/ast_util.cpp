@@ -28,6 +28,7 @@
 #include <cstdlib>
 #include <ctype.h>
 #include <cmath>
+#include <atomic>
 
 #include "odin_globals.h"
 #include "odin_types.h"
@@ -125,7 +126,7 @@ void add_top_module_to_ast(ast_t* ast, ast_node_t* to_add) {
 ast_node_t* create_node_w_type(ids id, loc_t loc) {
     oassert(id != NO_ID);
 
-    static long unique_count = 0;
+    static std::atomic<long> unique_count(0);
 
     ast_node_t* new_node;
 
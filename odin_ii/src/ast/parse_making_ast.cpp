@@ -96,18 +96,10 @@ bool is_valid_identifier(char* str);
  * (function: parse_to_ast)
  *-------------------------------------------------------------------------------------------*/
 void parse_to_ast() {
-    extern void push_include(const char* file_name);
+    extern void push_input_files();
 
-    /* read all the files in the configuration file */
-    my_location.file = configuration.list_of_file_names.size() - 1;
-    int parse_counter = my_location.file;
-
-    while (parse_counter >= 0) {
-        push_include(configuration.list_of_file_names[parse_counter].c_str());
-        parse_counter--;
-    }
-
-    my_location.file = 0;
+    /* read all the files in the configuration file, in order */
+    push_input_files();
 
     /* parse all the files */
     yyparse();
@@ -168,6 +168,10 @@ static void techmap() {
         partial_map_top(syn_netlist);
         mixer->perform_optimizations(syn_netlist);
 
+        /* Merge the duplicate logic, which is then removed as unused */
+        if (global_args.structural_hashing)
+            merge_duplicate_logic(syn_netlist);
+
         /* Find any unused logic in the netlist and remove it */
         remove_unused_logic(syn_netlist);
     }
@@ -204,6 +208,7 @@ static void output() {
         deregister_hard_blocks();
         //cleanup netlist
         free_netlist(syn_netlist);
+        free_netlist_objects();
     }
 }
 
@@ -395,6 +400,7 @@ netlist_t* start_odin_ii(int argc, char** argv) {
 
 int terminate_odin_ii(netlist_t* odin_netlist) {
     free_netlist(odin_netlist);
+    free_netlist_objects();
 
     //Clean-up
     free_arch(&Arch);
@@ -522,10 +528,20 @@ void get_options(int argc, char** argv) {
         .default_value("false")
         .action(argparse::Action::STORE_TRUE);
 
+    other_grp.add_argument(global_args.structural_hashing, "--structural_hashing")
+        .help("Merge the structurally identical logic gates of the netlist after the partial mapping")
+        .default_value("false")
+        .action(argparse::Action::STORE_TRUE);
+
     other_grp.add_argument(global_args.top_level_module_name, "--top_module")
         .help("Allow to overwrite the top level module that odin would use")
         .metavar("TOP_LEVEL_MODULE_NAME");
 
+    other_grp.add_argument(global_args.elaboration_threads, "--elaboration_threads")
+        .help("Number of threads allowed for the elaboration of the modules")
+        .default_value("1")
+        .metavar("THREAD COUNT");
+
     auto& rand_sim_grp = parser.add_argument_group("random simulation options");
 
     rand_sim_grp.add_argument(global_args.sim_num_test_vectors, "-g")
@@ -579,6 +595,20 @@ void get_options(int argc, char** argv) {
         .action(argparse::Action::STORE_TRUE)
         .metavar("BATCH FLAG");
 
+    other_sim_grp.add_argument(global_args.sim_bit_parallel, "--bit_parallel")
+        .help(
+            "Simulate 64 vector streams at once using bitwise operations, for netlists of soft logic and flip-flops.\n"
+            "The first stream is the one written to the output vectors, the others are random and count towards coverage.")
+        .default_value("false")
+        .action(argparse::Action::STORE_TRUE);
+
+    other_sim_grp.add_argument(global_args.sim_compiled, "--compiled_sim")
+        .help(
+            "Simulate the netlist compiled into a flat list of operations after the first cycle, rather than walking it.\n"
+            "The memories, hard blocks and word-level operators are still interpreted.")
+        .default_value("false")
+        .action(argparse::Action::STORE_TRUE);
+
     other_sim_grp.add_argument(global_args.sim_directory, "--sim_dir")
         .help("Directory output for simulation")
         .default_value(DEFAULT_OUTPUT)
@@ -672,6 +702,8 @@ void get_options(int argc, char** argv) {
 
     global_args.parralelized_simulation.set(
         std::max(1, std::min(thread_requested, std::min((CONCURENCY_LIMIT - 1), max_thread))), argparse::Provenance::SPECIFIED);
+    global_args.elaboration_threads.set(
+        std::max(1, std::min(global_args.elaboration_threads.value(), max_thread)), argparse::Provenance::SPECIFIED);
 
     //Allow some config values to be overriden from command line
     if (!global_args.input_files.value().empty()) {
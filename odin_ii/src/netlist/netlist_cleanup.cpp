@@ -25,9 +25,15 @@
 
 #include <cstdio>
 #include <cmath>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "odin_types.h"
 #include "odin_globals.h"
+#include "netlist_utils.h"
 
 #include "vtr_util.h"
 #include "vtr_memory.h"
@@ -316,6 +322,121 @@ void report_removed_nodes(long long* node_list) {
     }
 }
 
+/* Structural hashing: the key of a logic node is its type and its input nets, in order
+ * unless the operation is commutative */
+struct strash_key_t {
+    operation_list type;
+    std::vector<nnet_t*> input_nets;
+
+    bool operator==(const strash_key_t& other) const {
+        return type == other.type && input_nets == other.input_nets;
+    }
+};
+
+struct strash_key_hash_t {
+    size_t operator()(const strash_key_t& key) const {
+        size_t seed = std::hash<int>()(key.type);
+        for (nnet_t* net : key.input_nets) {
+            seed ^= std::hash<nnet_t*>()(net) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+};
+
+/* Returns whether the node is a single output combinational gate that can be merged
+ * with the identical ones, and whether its inputs can be reordered */
+static bool is_strashable(nnode_t* node, bool* commutative) {
+    switch (node->type) {
+        case LOGICAL_OR:   //fallthrough
+        case LOGICAL_AND:  //fallthrough
+        case LOGICAL_NOR:  //fallthrough
+        case LOGICAL_NAND: //fallthrough
+        case LOGICAL_XOR:  //fallthrough
+        case LOGICAL_XNOR: //fallthrough
+            *commutative = true;
+            break;
+
+        case LOGICAL_NOT: //fallthrough
+        case BUF_NODE:    //fallthrough
+        case MUX_2:       //fallthrough
+        case SMUX_2:      //fallthrough
+            *commutative = false;
+            break;
+
+        default:
+            return false;
+    }
+
+    if (node->num_output_pins != 1 || !node->output_pins[0] || !node->output_pins[0]->net)
+        return false;
+
+    for (int i = 0; i < node->num_input_pins; i++) {
+        if (!node->input_pins[i] || !node->input_pins[i]->net)
+            return false;
+    }
+    return true;
+}
+
+/* Visits the drivers of the node before the node itself, and merges it into an identical node
+ * found before by moving its fanouts over to the output net of that node */
+static void strash_node(nnode_t* node, std::unordered_set<nnode_t*>& visited, std::unordered_map<strash_key_t, nnode_t*, strash_key_hash_t>& strash_table, long* num_merged) {
+    if (!visited.insert(node).second) return; // Already visited
+
+    for (int i = 0; i < node->num_input_pins; i++) {
+        if (!node->input_pins[i] || !node->input_pins[i]->net)
+            continue;
+        nnet_t* net = node->input_pins[i]->net;
+        for (int j = 0; j < net->num_driver_pins; j++) {
+            if (net->driver_pins[j] && net->driver_pins[j]->node)
+                strash_node(net->driver_pins[j]->node, visited, strash_table, num_merged);
+        }
+    }
+
+    bool commutative;
+    if (!is_strashable(node, &commutative))
+        return;
+
+    strash_key_t key;
+    key.type = node->type;
+    for (int i = 0; i < node->num_input_pins; i++) {
+        key.input_nets.push_back(node->input_pins[i]->net);
+    }
+    if (commutative)
+        std::sort(key.input_nets.begin(), key.input_nets.end());
+
+    auto inserted = strash_table.emplace(std::move(key), node);
+    if (inserted.second)
+        return;
+
+    nnet_t* net = node->output_pins[0]->net;
+    nnet_t* merged_net = inserted.first->second->output_pins[0]->net;
+    for (int j = 0; j < net->num_fanout_pins; j++) {
+        if (net->fanout_pins[j])
+            add_fanout_pin_to_net(merged_net, net->fanout_pins[j]);
+    }
+    net->fanout_pins = (npin_t**)vtr::free(net->fanout_pins);
+    net->num_fanout_pins = 0;
+    (*num_merged)++;
+}
+
+/* Merges the structurally identical logic gates, from the inputs towards the outputs so that
+ * the merges propagate. The merged nodes are left without fanout, for remove_unused_logic() */
+void merge_duplicate_logic(netlist_t* netlist) {
+    std::unordered_set<nnode_t*> visited;
+    std::unordered_map<strash_key_t, nnode_t*, strash_key_hash_t> strash_table;
+    long num_merged = 0;
+
+    for (int i = 0; i < netlist->num_top_output_nodes; i++) {
+        strash_node(netlist->top_output_nodes[i], visited, strash_table, &num_merged);
+    }
+    for (int i = 0; i < netlist->num_ff_nodes; i++) {
+        strash_node(netlist->ff_nodes[i], visited, strash_table, &num_merged);
+    }
+
+    if (global_args.all_warnings && num_merged)
+        printf("%-42s%ld\n", "Number of merged duplicate node(s): ", num_merged);
+}
+
 /* Perform the backwards and forward sweeps and remove the unused nodes */
 void remove_unused_logic(netlist_t* netlist) {
     mark_output_dependencies(netlist);
@@ -26,6 +26,7 @@
 #ifndef NETLIST_CLEANUP_H
 #define NETLIST_CLEANUP_H
 
+void merge_duplicate_logic(netlist_t* netlist);
 void remove_unused_logic(netlist_t* netlist);
 
 #endif
@@ -26,6 +26,9 @@
 #include <cstring>
 #include <cstdlib>
 #include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
 
 #include "odin_types.h"
 #include "odin_globals.h"
@@ -139,18 +142,32 @@ void create_netlist(ast_t* ast) {
      * be instance names.  There are a few implied nets as in Muxes for cases, signals
      * for flip-flops and memories */
 
-    /* define string cache lists for modules */
-    for (int i = 0; i < module_names_to_idx->free; i++) {
-        sc_hierarchy* local_ref = init_sc_hierarchy();
-        local_ref->local_symbol_table_sc = sc_new_string_cache();
-        create_symbol_table_for_scope(((ast_node_t*)module_names_to_idx->data[i])->children[1], local_ref);
-
-        ((ast_node_t*)module_names_to_idx->data[i])->types.hierarchy = local_ref;
-
-        if (((ast_node_t*)module_names_to_idx->data[i])->type == MODULE) {
-            local_ref->local_param_table_sc = ((ast_node_t*)module_names_to_idx->data[i])->types.scope->param_sc;
-            local_ref->local_defparam_table_sc = ((ast_node_t*)module_names_to_idx->data[i])->types.scope->defparam_sc;
+    /* define string cache lists for modules.
+     * Each module only touches its own items and string caches here, so the modules are split
+     * between the elaboration threads; the result does not depend on the number of threads */
+    int num_workers = std::max<long>(1, std::min<long>(global_args.elaboration_threads.value(), module_names_to_idx->free));
+    auto create_symbol_tables = [num_workers](int first) {
+        for (int i = first; i < module_names_to_idx->free; i += num_workers) {
+            sc_hierarchy* local_ref = init_sc_hierarchy();
+            local_ref->local_symbol_table_sc = sc_new_string_cache();
+            create_symbol_table_for_scope(((ast_node_t*)module_names_to_idx->data[i])->children[1], local_ref);
+
+            ((ast_node_t*)module_names_to_idx->data[i])->types.hierarchy = local_ref;
+
+            if (((ast_node_t*)module_names_to_idx->data[i])->type == MODULE) {
+                local_ref->local_param_table_sc = ((ast_node_t*)module_names_to_idx->data[i])->types.scope->param_sc;
+                local_ref->local_defparam_table_sc = ((ast_node_t*)module_names_to_idx->data[i])->types.scope->defparam_sc;
+            }
         }
+    };
+
+    std::vector<std::thread> workers;
+    for (int id = 1; id < num_workers; id++) {
+        workers.emplace_back(create_symbol_tables, id);
+    }
+    create_symbol_tables(0);
+    for (std::thread& worker : workers) {
+        worker.join();
     }
 
     /* we will find the top module */
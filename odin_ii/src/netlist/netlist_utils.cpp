@@ -25,6 +25,7 @@
 
 #include <cstring>
 #include <cstdlib>
+#include <vector>
 
 #include "odin_types.h"
 #include "odin_globals.h"
@@ -34,11 +35,48 @@
 #include "vtr_util.h"
 #include "vtr_memory.h"
 
+/* The nodes, pins and nets are allocated in chunks rather than one by one. The ones freed while
+ * building and mapping the netlist are reused, and they are all released at once by
+ * free_netlist_objects() */
+static vtr::t_chunk netlist_object_chunk;
+static std::vector<void*> free_nnodes;
+static std::vector<void*> free_npins;
+static std::vector<void*> free_nnets;
+
+static void* allocate_netlist_object(long bytes_to_alloc, std::vector<void*>& free_objects) {
+    void* allocated;
+    if (!free_objects.empty()) {
+        allocated = free_objects.back();
+        free_objects.pop_back();
+    } else {
+        allocated = vtr::chunk_malloc(bytes_to_alloc, &netlist_object_chunk);
+    }
+    return my_init_struct(allocated, bytes_to_alloc);
+}
+
+static void* free_netlist_object(void* to_free, std::vector<void*>& free_objects) {
+    if (to_free)
+        free_objects.push_back(to_free);
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: free_netlist_objects)
+ * 	Releases the memory of all the nodes, pins and nets, which must no longer be in use
+ *-------------------------------------------------------------------------------------------*/
+void free_netlist_objects() {
+    vtr::free_chunk_memory(&netlist_object_chunk);
+    free_nnodes.clear();
+    free_npins.clear();
+    free_nnets.clear();
+}
+
 /*---------------------------------------------------------------------------------------------
  * (function: allocate_nnode)
  *-------------------------------------------------------------------------------------------*/
 nnode_t* allocate_nnode(loc_t loc) {
-    nnode_t* new_node = (nnode_t*)my_malloc_struct(sizeof(nnode_t));
+    nnode_t* new_node = (nnode_t*)allocate_netlist_object(sizeof(nnode_t), free_nnodes);
 
     new_node->loc = loc;
     new_node->name = NULL;
@@ -102,7 +140,7 @@ nnode_t* free_nnode(nnode_t* to_free) {
                 vtr::free(to_free->input_pins[i]->name);
                 to_free->input_pins[i]->name = NULL;
             }
-            to_free->input_pins[i] = (npin_t*)vtr::free(to_free->input_pins[i]);
+            to_free->input_pins[i] = (npin_t*)free_netlist_object(to_free->input_pins[i], free_npins);
         }
 
         to_free->input_pins = (npin_t**)vtr::free(to_free->input_pins);
@@ -112,7 +150,7 @@ nnode_t* free_nnode(nnode_t* to_free) {
                 vtr::free(to_free->output_pins[i]->name);
                 to_free->output_pins[i]->name = NULL;
             }
-            to_free->output_pins[i] = (npin_t*)vtr::free(to_free->output_pins[i]);
+            to_free->output_pins[i] = (npin_t*)free_netlist_object(to_free->output_pins[i], free_npins);
         }
 
         to_free->output_pins = (npin_t**)vtr::free(to_free->output_pins);
@@ -130,7 +168,7 @@ nnode_t* free_nnode(nnode_t* to_free) {
 
         /* now free the node */
     }
-    return (nnode_t*)vtr::free(to_free);
+    return (nnode_t*)free_netlist_object(to_free, free_nnodes);
 }
 
 /*-------------------------------------------------------------------------
@@ -195,7 +233,7 @@ void add_input_port_information(nnode_t* node, int port_width) {
 npin_t* allocate_npin() {
     npin_t* new_pin;
 
-    new_pin = (npin_t*)my_malloc_struct(sizeof(npin_t));
+    new_pin = (npin_t*)allocate_netlist_object(sizeof(npin_t), free_npins);
 
     new_pin->name = NULL;
     new_pin->type = NO_ID;
@@ -232,7 +270,7 @@ npin_t* free_npin(npin_t* to_free) {
 
         /* now free the pin */
     }
-    return (npin_t*)vtr::free(to_free);
+    return (npin_t*)free_netlist_object(to_free, free_npins);
 }
 
 /*-------------------------------------------------------------------------
@@ -282,7 +320,7 @@ npin_t* copy_input_npin(npin_t* copy_pin) {
  * (function: allocate_nnet)
  *-------------------------------------------------------------------------------------------*/
 nnet_t* allocate_nnet() {
-    nnet_t* new_net = (nnet_t*)my_malloc_struct(sizeof(nnet_t));
+    nnet_t* new_net = (nnet_t*)allocate_netlist_object(sizeof(nnet_t), free_nnets);
 
     new_net->name = NULL;
     new_net->driver_pins = NULL;
@@ -314,7 +352,7 @@ nnet_t* free_nnet(nnet_t* to_free) {
 
         /* now free the net */
     }
-    return (nnet_t*)vtr::free(to_free);
+    return (nnet_t*)free_netlist_object(to_free, free_nnets);
 }
 
 /*---------------------------------------------------------------------------
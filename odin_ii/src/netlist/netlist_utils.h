@@ -91,6 +91,7 @@ void connect_nodes(nnode_t* out_node, int out_idx, nnode_t* in_node, int in_idx)
 
 netlist_t* allocate_netlist();
 void free_netlist(netlist_t* to_free);
+void free_netlist_objects();
 
 int get_output_pin_index_from_mapping(nnode_t* node, const char* name);
 int get_output_port_index_from_mapping(nnode_t* node, const char* name);
@@ -0,0 +1,526 @@
+/*
+ * Copyright 2023 CAS—Atlantic (University of New Brunswick, CASA)
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "bit_parallel_simulation.h"
+
+#include "odin_error.h"
+
+#define CLOCK_INITIAL_VALUE 1
+
+static const lane_word_t ALL_LANES = ~(lane_word_t)0;
+
+static inline lane_word_t known_one(lane_value_t a) {
+    return a.is_one;
+}
+
+static inline lane_word_t known_zero(lane_value_t a) {
+    return ~a.is_one & ~a.is_x;
+}
+
+static inline lane_value_t lane_not(lane_value_t a) {
+    return {known_zero(a), a.is_x};
+}
+
+/* Takes a where mask is set, and b elsewhere */
+static inline lane_value_t lane_select(lane_word_t mask, lane_value_t a, lane_value_t b) {
+    return {(mask & a.is_one) | (~mask & b.is_one), (mask & a.is_x) | (~mask & b.is_x)};
+}
+
+/* The lanes where the value differs from the previous one, which was known (a toggle) */
+static inline lane_word_t lane_toggles(lane_value_t cur, lane_value_t prev) {
+    return ((cur.is_x | (cur.is_one ^ prev.is_one)) & ~prev.is_x);
+}
+
+static inline bool is_clock(nnode_t* node) {
+    return (node->type == CLOCK_NODE) || (std::string(node->name) == "top^clk") || (std::string(node->name) == DEFAULT_CLOCK_NAME);
+}
+
+/* The value of the given lane */
+static inline BitSpace::bit_value_t lane_bit(lane_value_t value, int lane) {
+    if ((value.is_x >> lane) & 1)
+        return BitSpace::_x;
+    return ((value.is_one >> lane) & 1) ? BitSpace::_1 : BitSpace::_0;
+}
+
+bool bit_parallel_simulator::can_compile(nnode_t* node) {
+    if (is_clock(node))
+        return true;
+
+    switch (node->type) {
+        case INPUT_NODE:
+        case OUTPUT_NODE:
+        case GND_NODE:
+        case VCC_NODE:
+        case PAD_NODE:
+        case BUF_NODE:
+        case BITWISE_NOT:
+        case LOGICAL_AND:
+        case LOGICAL_OR:
+        case LOGICAL_NAND:
+        case LOGICAL_NOT:
+        case LOGICAL_NOR:
+        case LOGICAL_XOR:
+        case NOT_EQUAL:
+        case LOGICAL_XNOR:
+        case LOGICAL_EQUAL:
+        case LT:
+        case GT:
+        case ADDER_FUNC:
+        case CARRY_FUNC:
+        case GENERIC:
+        case MUX_2:
+        case SMUX_2:
+        case FF_NODE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool bit_parallel_simulator::supports(stages_t* stages) {
+    for (int i = 0; i < stages->count; i++) {
+        for (int j = 0; j < stages->counts[i]; j++) {
+            nnode_t* node = stages->stages[i][j];
+            if (node && !can_compile(node))
+                return false;
+        }
+    }
+    return true;
+}
+
+lane_value_t bit_parallel_simulator::broadcast(BitSpace::bit_value_t value) {
+    if (BitSpace::is_unk[value & 0x3])
+        return {0, ALL_LANES};
+    return {(value == BitSpace::_1) ? ALL_LANES : 0, 0};
+}
+
+int bit_parallel_simulator::get_signal(npin_t* pin) {
+    // Initializes the pin values if need be
+    get_pin_value(pin, 0);
+
+    auto found = signal_of.find(pin->values.get());
+    if (found != signal_of.end())
+        return found->second;
+
+    int signal = signal_pins.size();
+    signal_of[pin->values.get()] = signal;
+    signal_pins.push_back(pin);
+    return signal;
+}
+
+bit_parallel_simulator::bit_parallel_simulator(stages_t* stages, int start_cycle, int random_seed, bool interpret_unsupported)
+    : coverage_lanes(interpret_unsupported ? 1 : ALL_LANES)
+    , rng(random_seed) {
+    oassert(interpret_unsupported || supports(stages));
+
+    // The operation assigning each signal so far (in evaluation order), or -1
+    std::vector<int> driver_of;
+    auto mark_driven = [&](int signal) {
+        if ((int)driver_of.size() <= signal)
+            driver_of.resize(signal + 1, -1);
+        driver_of[signal] = operations.size();
+    };
+    auto driven = [&](int signal) {
+        return signal < (int)driver_of.size() && driver_of[signal] >= 0;
+    };
+
+    for (int i = 0; i < stages->count; i++) {
+        for (int j = 0; j < stages->counts[i]; j++) {
+            nnode_t* node = stages->stages[i][j];
+            if (!node)
+                continue;
+
+            operation_t op;
+            op.node = node;
+            op.type = is_clock(node) ? CLOCK_NODE : node->type;
+            op.first_input = inputs.size();
+            op.num_inputs = node->num_input_pins;
+            op.default_select = -1;
+            op.ternary = false;
+            op.clock_driven_later = false;
+            op.count_coverage = !(op.type == INPUT_NODE || op.type == CLOCK_NODE || op.type == GND_NODE || op.type == VCC_NODE || op.type == PAD_NODE);
+            op.interpreted = !can_compile(node);
+            op.first_output = outputs.size();
+            op.num_outputs = 0;
+            op.store_output = false;
+
+            for (int k = 0; k < node->num_input_pins; k++)
+                inputs.push_back(get_signal(node->input_pins[k]));
+
+            if (op.interpreted) {
+                op.output = -1;
+                for (int k = 0; k < node->num_output_pins; k++) {
+                    if (node->output_pins[k]) {
+                        outputs.push_back(get_signal(node->output_pins[k]));
+                        op.num_outputs++;
+                    }
+                }
+                for (int k = 0; k < op.num_outputs; k++)
+                    mark_driven(outputs[op.first_output + k]);
+
+                operations.push_back(op);
+                continue;
+            }
+
+            if (node->num_output_pins < 1) {
+                oassert(op.type == INPUT_NODE);
+                continue;
+            }
+            op.output = get_signal(node->output_pins[0]);
+
+            ast_node_t* ast_node = node->related_ast_node;
+            if (op.type == MUX_2 || op.type == SMUX_2) {
+                op.ternary = ast_node && ast_node->type == TERNARY_OPERATION;
+                bool has_default = ast_node && (ast_node->type == IF || ast_node->type == CASE);
+                if (op.type == MUX_2) {
+                    for (int k = 0; k < node->input_port_sizes[0]; k++)
+                        if (has_default && node->input_pins[k]->is_default)
+                            op.default_select = k;
+                } else if (has_default && node->input_pins[0]->is_default) {
+                    op.default_select = 1;
+                }
+            } else if (op.type == CLOCK_NODE && op.num_inputs > 0) {
+                op.clock_driven_later = !driven(inputs[op.first_input]);
+            }
+
+            // The primary inputs are assigned before the nodes are evaluated
+            mark_driven(op.output);
+            // Only the first output is simulated (the supported nodes have a single one)
+            oassert(op.type == INPUT_NODE || op.type == CLOCK_NODE || node->num_output_pins == 1);
+
+            operations.push_back(op);
+        }
+    }
+
+    // The compiled values read by the interpreter are stored in the pins as they are computed
+    for (const operation_t& op : operations) {
+        if (!op.interpreted)
+            continue;
+        for (int k = 0; k < op.num_inputs; k++) {
+            int signal = inputs[op.first_input + k];
+            if (driven(signal) && !operations[driver_of[signal]].interpreted)
+                operations[driver_of[signal]].store_output = true;
+        }
+    }
+
+    is_input_signal.resize(signal_pins.size(), false);
+    current.resize(signal_pins.size());
+    for (size_t signal = 0; signal < signal_pins.size(); signal++)
+        current[signal] = broadcast(get_pin_value(signal_pins[signal], start_cycle));
+    previous = current;
+}
+
+void bit_parallel_simulator::start_cycle() {
+    previous = current;
+}
+
+void bit_parallel_simulator::set_input(npin_t* pin, lane_value_t value) {
+    auto found = signal_of.find(pin->values.get());
+    if (found == signal_of.end())
+        return; // the input does not drive anything simulated
+
+    // keep the representation canonical: no 1 in the unknown lanes
+    current[found->second] = {value.is_one & ~value.is_x, value.is_x};
+    is_input_signal[found->second] = true;
+}
+
+BitSpace::bit_value_t bit_parallel_simulator::get_lane_value(npin_t* pin, int lane) const {
+    auto found = signal_of.find(pin->values.get());
+    if (found == signal_of.end())
+        return BitSpace::_x;
+
+    return lane_bit(current[found->second], lane);
+}
+
+void bit_parallel_simulator::evaluate(int cycle) {
+    for (const operation_t& op : operations) {
+        if (op.type == INPUT_NODE)
+            continue;
+
+        if (op.interpreted) {
+            interpret(op, cycle);
+            continue;
+        }
+
+        lane_value_t value = compute(op, cycle);
+        current[op.output] = value;
+
+        if (op.store_output)
+            update_pin_value(signal_pins[op.output], lane_bit(value, 0), cycle);
+
+        // Count the toggles for coverage estimation, as compute_and_store_value() does for each lane
+        if (op.count_coverage) {
+            npin_t* pin = op.node->output_pins[0];
+            lane_word_t toggles = lane_toggles(value, previous[op.output]) & coverage_lanes;
+            if (toggles) {
+                pin->coverage += __builtin_popcountll(toggles);
+                op.node->covered = (pin->coverage >= 2);
+            } else {
+                op.node->covered = true;
+            }
+        } else {
+            op.node->covered = true;
+        }
+    }
+}
+
+/*
+ * Runs the node through the interpreter, which reads its inputs from (and
+ * stores its outputs in) the pins, then takes its outputs in every lane.
+ */
+void bit_parallel_simulator::interpret(const operation_t& op, int cycle) {
+    compute_and_store_value(op.node, cycle);
+
+    for (int k = 0; k < op.num_outputs; k++) {
+        int signal = outputs[op.first_output + k];
+        current[signal] = broadcast(get_pin_value(signal_pins[signal], cycle));
+    }
+}
+
+lane_value_t bit_parallel_simulator::compute(const operation_t& op, int cycle) const {
+    switch (op.type) {
+        case GND_NODE:
+        case PAD_NODE:
+            return {0, 0};
+        case VCC_NODE:
+            return {ALL_LANES, 0};
+        case BUF_NODE:
+        case OUTPUT_NODE:
+            return input(op, 0);
+        case BITWISE_NOT:
+            return lane_not(input(op, 0));
+        case LOGICAL_AND:
+        case LOGICAL_NAND: {
+            lane_word_t all_one = ALL_LANES;
+            lane_word_t any_zero = 0;
+            for (int i = 0; i < op.num_inputs; i++) {
+                all_one &= known_one(input(op, i));
+                any_zero |= known_zero(input(op, i));
+            }
+            lane_value_t value = {all_one, ~all_one & ~any_zero};
+            return (op.type == LOGICAL_AND) ? value : lane_not(value);
+        }
+        case LOGICAL_OR:
+        case LOGICAL_NOT:
+        case LOGICAL_NOR: {
+            lane_word_t any_one = 0;
+            lane_word_t all_zero = ALL_LANES;
+            for (int i = 0; i < op.num_inputs; i++) {
+                any_one |= known_one(input(op, i));
+                all_zero &= known_zero(input(op, i));
+            }
+            lane_value_t value = {any_one, ~any_one & ~all_zero};
+            return (op.type == LOGICAL_OR) ? value : lane_not(value);
+        }
+        case ADDER_FUNC:
+        case NOT_EQUAL:
+        case LOGICAL_XOR:
+        case LOGICAL_EQUAL:
+        case LOGICAL_XNOR: {
+            lane_word_t parity = 0;
+            lane_word_t any_x = 0;
+            for (int i = 0; i < op.num_inputs; i++) {
+                parity ^= input(op, i).is_one;
+                any_x |= input(op, i).is_x;
+            }
+            lane_value_t value = {parity & ~any_x, any_x};
+            return (op.type == LOGICAL_EQUAL || op.type == LOGICAL_XNOR) ? lane_not(value) : value;
+        }
+        case CARRY_FUNC: {
+            // the majority of the known values, x if there is none
+            lane_value_t a = input(op, 0);
+            lane_value_t b = input(op, 1);
+            lane_value_t c = input(op, 2);
+            lane_word_t one = (known_one(a) & known_one(b)) | (known_one(a) & known_one(c)) | (known_one(b) & known_one(c));
+            lane_word_t zero = (known_zero(a) & known_zero(b)) | (known_zero(a) & known_zero(c)) | (known_zero(b) & known_zero(c));
+            return {one, ~one & ~zero};
+        }
+        case LT:
+        case GT: {
+            lane_value_t a = input(op, 0);
+            lane_value_t b = input(op, 1);
+            lane_value_t c = input(op, 2);
+            lane_word_t any_x = a.is_x | b.is_x | c.is_x;
+            lane_word_t one = (op.type == LT) ? (known_zero(a) & known_one(b) & known_zero(c))
+                                              : (known_one(a) & known_zero(b) & known_zero(c));
+            return {one & ~any_x, any_x};
+        }
+        case GENERIC:
+            return compute_generic(op);
+        case MUX_2:
+            return compute_mux(op, 0, op.node->input_port_sizes[0], op.node->input_port_sizes[0]);
+        case SMUX_2:
+            return compute_mux(op, 0, 1, 1);
+        case FF_NODE:
+            return compute_flipflop(op);
+        case CLOCK_NODE:
+            return compute_clock(op, cycle);
+        default:
+            error_message(SIMULATION, op.node->loc, "Node can not be simulated bit-parallel: %s", op.node->name);
+            return {0, ALL_LANES};
+    }
+}
+
+/*
+ * Matches the inputs against the cubes of the bit map in order, as
+ * compute_generic_node() does: a lane is x as soon as one of the inputs
+ * it checks is unknown.
+ */
+lane_value_t bit_parallel_simulator::compute_generic(const operation_t& op) const {
+    char** bit_map = op.node->bit_map;
+
+    int lut_size = 0;
+    while (bit_map[0][lut_size] != 0)
+        lut_size++;
+
+    lane_word_t pending = ALL_LANES;
+    lane_word_t found = 0;
+    lane_word_t unknown = 0;
+    for (int i = 0; i < op.node->bit_map_line_count && pending; i++) {
+        lane_word_t matching = pending;
+        for (int j = 0; j < lut_size && matching; j++) {
+            lane_value_t value = input(op, j);
+
+            lane_word_t unknown_hit = matching & value.is_x;
+            unknown |= unknown_hit;
+            pending &= ~unknown_hit;
+            matching &= ~unknown_hit;
+
+            if (bit_map[i][j] == '1')
+                matching &= value.is_one;
+            else if (bit_map[i][j] == '0')
+                matching &= ~value.is_one;
+        }
+        found |= matching;
+        pending &= ~matching;
+    }
+
+    lane_word_t one = (op.node->generic_output == BitSpace::_1) ? found : ~found;
+    return {one & ~unknown, unknown};
+}
+
+/*
+ * The first of the num_selects select inputs at 1 picks its data input, as
+ * compute_mux_2_node() does. SMUX_2 nodes have a single select input picking
+ * the first data input at 0, and the second one at 1.
+ */
+lane_value_t bit_parallel_simulator::compute_mux(const operation_t& op, int first_select, int num_selects, int first_data) const {
+    lane_word_t unknown = 0;
+    lane_word_t selected = 0;
+    lane_value_t value = {0, 0};
+
+    if (op.type == SMUX_2) {
+        lane_value_t select = input(op, first_select);
+        unknown = select.is_x;
+        selected = ~unknown;
+        value = lane_select(select.is_one, input(op, first_data + 1), input(op, first_data));
+    } else {
+        for (int i = 0; i < num_selects; i++) {
+            lane_value_t select = input(op, first_select + i);
+            unknown |= select.is_x;
+
+            lane_word_t picks = select.is_one & ~selected;
+            value = lane_select(picks, input(op, first_data + i), value);
+            selected |= picks;
+        }
+    }
+
+    // If no selection is made (all 0) we output x.
+    lane_word_t none = ~unknown & ~selected;
+    value = lane_select(none, {0, ALL_LANES}, value);
+
+    // If there are unknowns and there is a default clause, select it. Otherwise an unknown
+    // selection keeps the value from the previous cycle (or is x for the inline ifs).
+    lane_value_t unknown_value;
+    if (op.default_select >= 0) {
+        unknown_value = input(op, (op.type == SMUX_2) ? op.default_select : first_data + op.default_select);
+    } else if (op.ternary) {
+        unknown_value = {0, ALL_LANES};
+    } else {
+        unknown_value = previous[op.output];
+    }
+    return lane_select(unknown, unknown_value, value);
+}
+
+/*
+ * Takes the D input from the previous cycle on each lane where the clock
+ * (from this cycle) triggers, as ff_trigger() and get_edge_type() do.
+ */
+lane_value_t bit_parallel_simulator::compute_flipflop(const operation_t& op) const {
+    lane_value_t clk = input(op, 1);
+    lane_value_t prev_clk = previous_input(op, 1);
+
+    // prev != cur (with x and z alike)
+    lane_word_t changed = (clk.is_x ^ prev_clk.is_x) | (clk.is_one ^ prev_clk.is_one);
+    lane_word_t rising = changed & (known_zero(prev_clk) | known_one(clk));
+    lane_word_t falling = changed & ~rising & (known_one(prev_clk) | known_zero(clk));
+    lane_word_t high = known_one(clk) & ~(rising | falling);
+    lane_word_t low = known_zero(clk) & ~(rising | falling);
+
+    lane_word_t trigger = 0;
+    switch (op.node->attributes->clk_edge_type) {
+        case FALLING_EDGE_SENSITIVITY:
+            trigger = falling;
+            break;
+        case RISING_EDGE_SENSITIVITY:
+            trigger = rising;
+            break;
+        case ACTIVE_HIGH_SENSITIVITY:
+            trigger = high;
+            break;
+        case ACTIVE_LOW_SENSITIVITY:
+            trigger = low;
+            break;
+        case ASYNCHRONOUS_SENSITIVITY:
+            trigger = rising | falling;
+            break;
+        default:
+            break;
+    }
+
+    return lane_select(trigger, previous_input(op, 0), previous[op.output]);
+}
+
+lane_value_t bit_parallel_simulator::compute_clock(const operation_t& op, int cycle) const {
+    if (op.num_inputs > 0) {
+        return op.clock_driven_later ? previous_input(op, 0) : input(op, 0);
+    }
+
+    // Assigned as a primary input
+    if (is_input_signal[op.output])
+        return current[op.output];
+
+    // Internally driven clock: toggle according to ratio
+    int clk_ratio = get_clock_ratio(op.node);
+    if (clk_ratio == 0) {
+        error_message(SIMULATION, op.node->loc, "clock(%s) as a 0 valued ratio", op.node->name);
+    }
+
+    lane_value_t prev_value = previous[op.output];
+    lane_value_t initial = broadcast(BitSpace::l_not[CLOCK_INITIAL_VALUE]);
+    prev_value = lane_select(prev_value.is_x, initial, prev_value);
+
+    return (cycle % clk_ratio) ? prev_value : lane_not(prev_value);
+}
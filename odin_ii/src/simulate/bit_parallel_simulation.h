@@ -0,0 +1,153 @@
+/*
+ * Copyright 2023 CAS—Atlantic (University of New Brunswick, CASA)
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BIT_PARALLEL_SIMULATION_H
+#define BIT_PARALLEL_SIMULATION_H
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "odin_types.h"
+#include "simulate_blif.h"
+
+/*
+ * Each signal holds one bit per lane of a machine word: the lanes are
+ * independent vector streams, simulated at once with bitwise operations.
+ */
+#define BIT_PARALLEL_LANES 64
+
+typedef uint64_t lane_word_t;
+
+/*
+ * The value of a signal in every lane. is_x flags the unknown (x or z) lanes,
+ * and is_one the lanes at 1 (never set in the unknown ones).
+ */
+struct lane_value_t {
+    lane_word_t is_one;
+    lane_word_t is_x;
+};
+
+/*
+ * Simulates the netlist on BIT_PARALLEL_LANES vector streams at once, in the
+ * order of the stages found by the first (interpreted) cycle: the stages are
+ * compiled into a flat array of operations (type, input signals, output signal)
+ * evaluated in a single loop each cycle.
+ *
+ * It evaluates the soft logic (gates, LUTs, muxes, adder bits), the flip-flops
+ * and the clocks the same way compute_and_store_value() does in each lane.
+ * The other nodes (memories, hard blocks and word-level operators) can only be
+ * left to the interpreter, in which case a single vector stream is simulated:
+ * their inputs are stored in the pins before compute_and_store_value() runs
+ * them, and their outputs read back from the pins.
+ */
+class bit_parallel_simulator {
+  public:
+    /* Whether the node is evaluated by the compiled operations (rather than the interpreter) */
+    static bool can_compile(nnode_t* node);
+
+    /* Whether every node of the stages can be simulated bit-parallel */
+    static bool supports(stages_t* stages);
+
+    /*
+     * Compiles the stages. All the lanes start from the pin values of
+     * start_cycle, as computed by the interpreter.
+     *
+     * With interpret_unsupported, the nodes which can not be compiled are
+     * interpreted and only the first lane is simulated (every lane then holds
+     * the same values, set_input() is to be given the same value in every lane).
+     * Otherwise every node must be supported.
+     */
+    bit_parallel_simulator(stages_t* stages, int start_cycle, int random_seed, bool interpret_unsupported = false);
+
+    /* Whether the lanes are independent vector streams (no node is interpreted) */
+    bool is_bit_parallel() const { return coverage_lanes != 1; }
+
+    /* Makes the current values the previous cycle's, before assigning the inputs of a new cycle */
+    void start_cycle();
+
+    /* Assigns the value of a primary input (or clock) pin for the current cycle */
+    void set_input(npin_t* pin, lane_value_t value);
+
+    /* Evaluates every node for the cycle, updating the coverage of their output pins */
+    void evaluate(int cycle);
+
+    /* Returns the value of the pin in the given lane, or x if the pin is not simulated */
+    BitSpace::bit_value_t get_lane_value(npin_t* pin, int lane) const;
+
+    /* Returns one random bit per lane */
+    lane_word_t random_lanes() { return rng(); }
+
+    /* Returns a value with the same bit in every lane */
+    static lane_value_t broadcast(BitSpace::bit_value_t value);
+
+  private:
+    struct operation_t {
+        nnode_t* node;
+        operation_list type;
+        int output;      // signal index of the output pin
+        int first_input; // index of the first input signal in inputs
+        int num_inputs;
+        int default_select; // MUX_2/SMUX_2: the input favoured when the selection is unknown, or -1
+        bool ternary;       // MUX_2/SMUX_2: an unknown selection outputs x (instead of holding the output)
+        bool clock_driven_later; // CLOCK_NODE: its driver is evaluated after it, so it reads the previous cycle
+        bool count_coverage;
+        bool interpreted;   // run by compute_and_store_value(), its outputs are first_output.. in outputs
+        int first_output;
+        int num_outputs;
+        bool store_output; // the output is read by an interpreted node, so it is stored in the pins
+    };
+
+    int get_signal(npin_t* pin);
+    void interpret(const operation_t& op, int cycle);
+    lane_value_t compute(const operation_t& op, int cycle) const;
+    lane_value_t compute_generic(const operation_t& op) const;
+    lane_value_t compute_mux(const operation_t& op, int first_select, int num_selects, int first_data) const;
+    lane_value_t compute_flipflop(const operation_t& op) const;
+    lane_value_t compute_clock(const operation_t& op, int cycle) const;
+
+    lane_value_t input(const operation_t& op, int i) const { return current[inputs[op.first_input + i]]; }
+    lane_value_t previous_input(const operation_t& op, int i) const { return previous[inputs[op.first_input + i]]; }
+
+    std::vector<operation_t> operations;
+    std::vector<int> inputs;  // signal indices of the operation inputs
+    std::vector<int> outputs; // signal indices of the interpreted operation outputs
+
+    // The lanes counted towards coverage (all of them, or the first one when some nodes are interpreted)
+    lane_word_t coverage_lanes;
+
+    // The signal of each net (pins sharing their values)
+    std::unordered_map<const atomic_buffer*, int> signal_of;
+    std::vector<npin_t*> signal_pins;
+    std::vector<bool> is_input_signal; // assigned by set_input()
+
+    std::vector<lane_value_t> current;
+    std::vector<lane_value_t> previous;
+
+    std::mt19937_64 rng;
+};
+
+#endif
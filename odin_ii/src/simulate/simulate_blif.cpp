@@ -32,6 +32,7 @@
 #include <thread>
 
 #include "simulate_blif.h"
+#include "bit_parallel_simulation.h"
 #include "odin_buffer.h"
 #include "odin_util.h"
 
@@ -114,6 +115,8 @@ static inline bool is_clock_node(nnode_t* node) {
 }
 
 static void simulate_cycle(int cycle, stages_t* s);
+static void simulate_bit_parallel_cycle(sim_data_t* sim_data, int cycle);
+static bool contains_a_substr_of_name(std::vector<std::string> held, const char* name_in);
 static stages_t* simulate_first_cycle(netlist_t* netlist, int cycle, lines_t* output_lines);
 
 static stages_t* stage_ordered_nodes(nnode_t** ordered_nodes, int num_ordered_nodes);
@@ -126,14 +129,12 @@ static int is_node_complete(nnode_t* node, int cycle);
 
 static bool pin_is_driver(npin_t* pin, nnet_t* net);
 
-static bool compute_and_store_value(nnode_t* node, int cycle);
 static void compute_memory_node(nnode_t* node, int cycle);
 static void compute_hard_ip_node(nnode_t* node, int cycle);
 static void compute_generic_node(nnode_t* node, int cycle);
 static void compute_add_node(nnode_t* node, int cycle);
 static void compute_unary_sub_node(nnode_t* node, int cycle);
 
-static void update_pin_value(npin_t* pin, BitSpace::bit_value_t value, int cycle);
 static int get_pin_cycle(npin_t* pin);
 
 BitSpace::bit_value_t get_line_pin_value(line_t* line, int pin_num, int cycle);
@@ -324,6 +325,7 @@ sim_data_t* init_simulation(netlist_t* netlist) {
     sim_data->simulation_time = 0; // Does not include I/O
 
     sim_data->stages = 0;
+    sim_data->bit_parallel = NULL;
 
     if (!sim_data->num_vectors) {
         terminate_simulation(sim_data);
@@ -334,6 +336,7 @@ sim_data_t* init_simulation(netlist_t* netlist) {
 }
 
 sim_data_t* terminate_simulation(sim_data_t* sim_data) {
+    delete sim_data->bit_parallel;
     free_stages(sim_data->stages);
 
     fclose(sim_data->act_out);
@@ -446,6 +449,24 @@ int single_step(sim_data_t* sim_data, int cycle) {
         if (!verify_lines(sim_data->output_lines))
             error_message(SIMULATION, unknown_location, "%s\n",
                           "Problem detected with the output lines after the first cycle.");
+
+        // The following cycles are simulated bit-parallel if requested, and if the netlist allows it.
+        // Otherwise they may still be compiled, leaving the nodes which can not be to the interpreter.
+        bool bit_parallel = global_args.sim_bit_parallel && bit_parallel_simulator::supports(sim_data->stages);
+        if (global_args.sim_bit_parallel && !bit_parallel) {
+            warning_message(SIMULATION, unknown_location, "%s",
+                            "The netlist holds nodes which can not be simulated bit-parallel (memories, hard blocks or word-level operators), simulating a single vector stream");
+        }
+
+        if (bit_parallel) {
+            sim_data->bit_parallel = new bit_parallel_simulator(sim_data->stages, cycle, global_args.sim_random_seed);
+            printf("Simulating %d vector streams at once (bit-parallel)\n", BIT_PARALLEL_LANES);
+        } else if (global_args.sim_compiled) {
+            sim_data->bit_parallel = new bit_parallel_simulator(sim_data->stages, cycle, global_args.sim_random_seed, true);
+            printf("Simulating the compiled netlist\n");
+        }
+    } else if (sim_data->bit_parallel) {
+        simulate_bit_parallel_cycle(sim_data, cycle);
     } else {
         simulate_cycle(cycle, sim_data->stages);
     }
@@ -505,6 +526,50 @@ static void simulate_cycle(int cycle, stages_t* s) {
     }
 }
 
+/*
+ * Simulates a cycle on every lane of the bit-parallel simulator. The first lane
+ * gets the vector assigned to the input lines, and its output values are stored
+ * in the pins to be written as usual. The other lanes get random vectors, except
+ * for the clocks and the held inputs which are the same on every lane (and every
+ * lane gets the same vector when the netlist is only compiled, see --compiled_sim).
+ */
+static void simulate_bit_parallel_cycle(sim_data_t* sim_data, int cycle) {
+    bit_parallel_simulator* simulator = sim_data->bit_parallel;
+    simulator->start_cycle();
+
+    const lane_word_t first_lane = 1;
+    lines_t* input_lines = sim_data->input_lines;
+    for (int i = 0; i < input_lines->count; i++) {
+        line_t* line = input_lines->lines[i];
+        bool is_held = contains_a_substr_of_name(global_args.sim_hold_high.value(), line->name)
+                       || contains_a_substr_of_name(global_args.sim_hold_low.value(), line->name);
+
+        for (int j = 0; j < line->number_of_pins; j++) {
+            npin_t* pin = line->pins[j];
+            lane_value_t value = bit_parallel_simulator::broadcast(get_pin_value(pin, cycle));
+
+            if (simulator->is_bit_parallel() && !is_held && get_clock_ratio(pin->node) <= 0) {
+                lane_value_t random = {simulator->random_lanes(), 0};
+                if (global_args.sim_generate_three_valued_logic)
+                    random.is_x = simulator->random_lanes() & simulator->random_lanes();
+
+                value.is_one = (value.is_one & first_lane) | (random.is_one & ~random.is_x & ~first_lane);
+                value.is_x = (value.is_x & first_lane) | (random.is_x & ~first_lane);
+            }
+            simulator->set_input(pin, value);
+        }
+    }
+
+    simulator->evaluate(cycle);
+
+    lines_t* output_lines = sim_data->output_lines;
+    for (int i = 0; i < output_lines->count; i++) {
+        line_t* line = output_lines->lines[i];
+        for (int j = 0; j < line->number_of_pins; j++)
+            update_pin_value(line->pins[j], simulator->get_lane_value(line->pins[j], 0), cycle);
+    }
+}
+
 /*
  * Updates all pins which have been flagged as undriven
  * to X for the given cycle.
@@ -761,7 +826,7 @@ static VNumber get_value(nnode_t* node, int start, int size, int cycle) {
  * Given a node, this function will simulate that node's new outputs,
  * and updates those pins.
  */
-static bool compute_and_store_value(nnode_t* node, int cycle) {
+bool compute_and_store_value(nnode_t* node, int cycle) {
     //double computation_time = wall_time();
     is_node_ready(node, cycle);
     operation_list type = is_clock_node(node) ? CLOCK_NODE : node->type;
@@ -1380,7 +1445,7 @@ static void initialize_pin(npin_t* pin) {
  *
  * Initializes the pin if need be.
  */
-static void update_pin_value(npin_t* pin, BitSpace::bit_value_t value, int cycle) {
+void update_pin_value(npin_t* pin, BitSpace::bit_value_t value, int cycle) {
     if (pin->values == NULL)
         initialize_pin(pin);
     pin->values->update_value(value, cycle);
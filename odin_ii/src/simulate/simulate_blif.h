@@ -56,6 +56,8 @@
 
 #define DEFAULT_CLOCK_NAME "GLOBAL_SIM_BASE_CLK"
 
+class bit_parallel_simulator;
+
 struct line_t {
     int number_of_pins;
     int max_number_of_pins;
@@ -129,6 +131,10 @@ struct sim_data_t {
     //maria
     thread_node_distribution* thread_distribution; //nodes distributed to threads for parallel calculations
 
+    // Simulates the cycles after the first one from the compiled netlist, on many vector streams
+    // at once if it can (see the --bit_parallel and --compiled_sim options)
+    bit_parallel_simulator* bit_parallel;
+
     // Parse -L and -H options containing lists of pins to hold high or low during random vector generation.
     std::unordered_map<std::string, short> held_at;
 
@@ -149,6 +155,8 @@ nnode_t** get_children_of(nnode_t* node, int* count);
 nnode_t** get_children_of_nodepin(nnode_t* node, int* num_children, int output_pin);
 
 BitSpace::bit_value_t get_pin_value(npin_t* pin, int cycle);
+void update_pin_value(npin_t* pin, BitSpace::bit_value_t value, int cycle);
+bool compute_and_store_value(nnode_t* node, int cycle);
 
 int get_clock_ratio(nnode_t* node);
 void set_clock_ratio(int rat, nnode_t* node);
@@ -27,6 +27,7 @@
 #include <cstring>
 #include <cstdarg>
 #include <cstdlib>
+#include <mutex>
 
 #include "odin_error.h"
 #include "config_t.h"
@@ -36,6 +37,8 @@ std::vector<std::pair<std::string, int>> include_file_names;
 #define NUMBER_OF_LINES_DIGIT 5
 int delayed_errors = 0;
 const loc_t unknown_location = {-1, -1, -1};
+/* messages may be logged from the elaboration threads */
+static std::mutex log_mutex;
 
 const char* odin_error_STR[] = {
     "",
@@ -114,6 +117,7 @@ static void print_culprit_line_with_context(int column, int target_line, const c
 }
 
 void _log_message(odin_error error_type, loc_t loc, bool fatal_error, const char* function_file_name, int function_line, const char* function_name, const char* message, ...) {
+    std::lock_guard<std::mutex> lock(log_mutex);
     fflush(stdout);
 
     va_list ap;
@@ -107,6 +107,9 @@ struct global_args_t {
     // or generated using a dummy adder with both inputs set to gnd/vdd
     argparse::ArgValue<bool> adder_cin_global;
 
+    // merge the structurally identical logic gates before outputting the netlist
+    argparse::ArgValue<bool> structural_hashing;
+
     /////////////////////
     // For simulation.
     /////////////////////
@@ -136,6 +139,12 @@ struct global_args_t {
     argparse::ArgValue<bool> sim_achieve_best;
 
     argparse::ArgValue<int> parralelized_simulation;
+    // Number of threads allowed for the elaboration of the modules
+    argparse::ArgValue<int> elaboration_threads;
+    // Simulate many vector streams at once, one per bit of a machine word.
+    argparse::ArgValue<bool> sim_bit_parallel;
+    // Simulate the netlist compiled into a flat list of operations, interpreting the memories and hard blocks.
+    argparse::ArgValue<bool> sim_compiled;
     argparse::ArgValue<bool> parralelized_simulation_in_batch;
     // deprecated since this should be defined when compiled
     argparse::ArgValue<int> sim_initial_value;
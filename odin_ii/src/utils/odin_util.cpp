@@ -676,7 +676,14 @@ std::string make_simple_name(char* input, const char* flatten_string, char flatt
  * (function: my_malloc_struct )
  *-----------------------------------------------------------------*/
 void* my_malloc_struct(long bytes_to_alloc) {
-    void* allocated = vtr::calloc(1, bytes_to_alloc);
+    return my_init_struct(vtr::malloc(bytes_to_alloc), bytes_to_alloc);
+}
+
+/*-----------------------------------------------------------------------
+ * (function: my_init_struct )
+ * 	Zeroes the allocated structure and marks its unique_id
+ *-----------------------------------------------------------------*/
+void* my_init_struct(void* allocated, long bytes_to_alloc) {
     static long int m_id = 0;
 
     // ways to stop the execution at the point when a specific structure is built...note it needs to be m_id - 1 ... it's unique_id in most data structures
@@ -686,6 +693,7 @@ void* my_malloc_struct(long bytes_to_alloc) {
         fprintf(stderr, "MEMORY FAILURE\n");
         oassert(0);
     }
+    memset(allocated, 0, bytes_to_alloc);
 
     /* mark the unique_id */
     *((long int*)allocated) = m_id++;
@@ -17,6 +17,7 @@
  */
 #include "mixing_optimization.h"
 
+#include <algorithm>
 #include <stdint.h> // INT_MAX
 #include <vector>
 
@@ -85,41 +86,32 @@ void MultsOpt::assign_weights(netlist_t *netlist, std::vector<nnode_t *> nodes)
 
 void MultsOpt::perform(netlist_t *netlist, std::vector<nnode_t *> &weighted_nodes)
 {
-    size_t nodes_count = weighted_nodes.size();
-
-    // per optimization, instantiate hard logic
-    for (int i = 0; i < this->_blocks_count; i++) {
-        int maximal_cost = -1;
-        int index = -1;
-        for (size_t j = 0; j < nodes_count; j++) {
-            // if found a new maximal cost that is higher than a current maximum AND is not restricted by input
-            // params for minimal "hardenable" multiplier width
-            if (maximal_cost < weighted_nodes[j]->weight && this->hardenable(weighted_nodes[j])) {
-                maximal_cost = weighted_nodes[j]->weight;
-                index = j;
-            }
+    // the nodes that are not restricted by input params for minimal "hardenable" multiplier width,
+    // from the highest cost down; the sort is stable so that equal costs are hardened in the order
+    // the nodes were noted
+    std::vector<nnode_t *> candidates;
+    for (nnode_t *node : weighted_nodes) {
+        if (node->weight >= 0 && this->hardenable(node)) {
+            candidates.push_back(node);
         }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](nnode_t *a, nnode_t *b) { return a->weight > b->weight; });
 
-        // if there are no suitable nodes left, leave the loop to
-        // implement remaining nodes in soft logic
-        if (index < 0)
-            break;
-
-        // indicate for future iterations the node was hardened
-        weighted_nodes[index]->weight = -1;
+    // per optimization, instantiate hard logic. If there are no suitable nodes left,
+    // the remaining nodes are implemented in soft logic
+    for (size_t i = 0; i < candidates.size() && (long long)i < this->_blocks_count; i++) {
+        // indicate the node was hardened
+        candidates[i]->weight = -1;
 
         if (hard_multipliers) {
-            instantiate_hard_multiplier(weighted_nodes[index], this->cached_traverse_value, netlist);
+            instantiate_hard_multiplier(candidates[i], this->cached_traverse_value, netlist);
         }
     }
 
-    // From the end of the vector, remove all nodes that were implemented in hard logic. The remaining
+    // remove all nodes that were implemented in hard logic. The remaining
     // nodes will be instantiated in soft_map_remaining_nodes
-    for (int i = nodes_count - 1; i >= 0; i--) {
-        if (weighted_nodes[i]->weight == -1) {
-            weighted_nodes.erase(weighted_nodes.begin() + i);
-        }
-    }
+    weighted_nodes.erase(std::remove_if(weighted_nodes.begin(), weighted_nodes.end(), [](nnode_t *node) { return node->weight == -1; }),
+                         weighted_nodes.end());
 }
 
 void MixingOpt::set_blocks_needed(int new_count) { this->_blocks_count = new_count; }
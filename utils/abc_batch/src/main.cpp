@@ -0,0 +1,132 @@
+// Tool to run an ABC script on many circuits in one process.
+//
+// The VTR flow runs the abc binary once for each circuit, which dominates the
+// run time when there are thousands of small circuits. This tool starts ABC
+// once and, for each circuit, reads its BLIF, runs the script on the network
+// held in memory, and writes the result (with write_hie, as the flow does, so
+// that the black boxes of the input are kept).
+//
+// Usage:
+//   abc_batch <script file> <circuit list file>
+//
+// The script file holds ABC commands, one or more per line ('#' starts a
+// comment), e.g. the technology mapping script of the flow. Each line of the
+// circuit list file is '<input blif> <output blif>'. The exit code is the
+// number of circuits that failed.
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+// ABC Headers
+#include "base/abc/abc.h"
+#include "base/main/main.h"
+#include "base/cmd/cmd.h"
+
+struct t_batch_circuit {
+    std::string input_blif;
+    std::string output_blif;
+};
+
+static std::vector<std::string> read_script(const char* script_file);
+static std::vector<t_batch_circuit> read_circuit_list(const char* list_file);
+static bool run_script(Abc_Frame_t* abc, const std::vector<std::string>& script, const t_batch_circuit& circuit);
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        VTR_LOG_ERROR("Usage: %s <script file> <circuit list file>\n", argv[0]);
+        return 1;
+    }
+
+    vtr::ScopedFinishTimer t("ABC batch");
+
+    std::vector<std::string> script = read_script(argv[1]);
+    std::vector<t_batch_circuit> circuits = read_circuit_list(argv[2]);
+
+    Abc_Start();
+    Abc_Frame_t* abc = Abc_FrameGetGlobalFrame();
+
+    int num_failed = 0;
+    for (const t_batch_circuit& circuit : circuits) {
+        if (!run_script(abc, script, circuit)) {
+            VTR_LOG_ERROR("ABC failed on %s\n", circuit.input_blif.c_str());
+            num_failed++;
+        }
+    }
+
+    Abc_Stop();
+
+    VTR_LOG("Ran the script on %zu circuit(s), %d failed\n", circuits.size(), num_failed);
+    return num_failed;
+}
+
+/// Returns the non-empty lines of the script, without their comments
+static std::vector<std::string> read_script(const char* script_file) {
+    std::ifstream file(script_file);
+    if (!file) {
+        VTR_LOG_ERROR("Could not open the script file %s\n", script_file);
+        exit(1);
+    }
+
+    std::vector<std::string> script;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        if (line.find_first_not_of(" \t\r") != std::string::npos) {
+            script.push_back(line);
+        }
+    }
+    return script;
+}
+
+static std::vector<t_batch_circuit> read_circuit_list(const char* list_file) {
+    std::ifstream file(list_file);
+    if (!file) {
+        VTR_LOG_ERROR("Could not open the circuit list file %s\n", list_file);
+        exit(1);
+    }
+
+    std::vector<t_batch_circuit> circuits;
+    std::string line;
+    int line_num = 0;
+    while (std::getline(file, line)) {
+        line_num++;
+
+        std::istringstream tokens(line);
+        t_batch_circuit circuit;
+        if (!(tokens >> circuit.input_blif)) {
+            continue; //Empty line
+        }
+        if (!(tokens >> circuit.output_blif)) {
+            VTR_LOG_ERROR("%s:%d: expected '<input blif> <output blif>'\n", list_file, line_num);
+            exit(1);
+        }
+        circuits.push_back(circuit);
+    }
+    return circuits;
+}
+
+/// Reads the circuit, runs the script on it and writes the result, returns false if any command failed
+static bool run_script(Abc_Frame_t* abc, const std::vector<std::string>& script, const t_batch_circuit& circuit) {
+    std::vector<std::string> commands;
+    commands.push_back("read " + circuit.input_blif);
+    commands.insert(commands.end(), script.begin(), script.end());
+    commands.push_back("write_hie " + circuit.input_blif + " " + circuit.output_blif);
+
+    bool success = true;
+    for (const std::string& command : commands) {
+        if (Cmd_CommandExecute(abc, command.c_str())) {
+            VTR_LOG_ERROR("Command '%s' failed\n", command.c_str());
+            success = false;
+            break;
+        }
+    }
+
+    //The next circuit starts from an empty frame
+    Abc_FrameDeleteAllNetworks(abc);
+    return success;
+}
@@ -0,0 +1,125 @@
+#include "bench_design.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "router_delay_profiling.h"
+#include "vpr_api.h"
+#include "vpr_error.h"
+
+#include "vtr_random.h"
+
+namespace {
+
+constexpr const char kArchFile[] = VPR_BENCH_DATA_DIR "/test_post_verilog_arch.xml";
+constexpr const char kCircuitFile[] = "bench_vpr.blif";
+
+constexpr int kNumInputs = 32;
+constexpr int kNumLuts = 2000;
+constexpr int kLutSize = 4;
+///Most LUT inputs come from the last kFaninWindow signals, which gives the netlist some locality
+constexpr int kFaninWindow = 64;
+///One LUT in kRegisterPeriod is registered
+constexpr int kRegisterPeriod = 4;
+
+std::unique_ptr<t_bench_design> g_bench_design;
+
+/**
+ * @brief Writes a random combinational and sequential netlist of kNumLuts 4-LUTs to the given BLIF file.
+ *
+ * The netlist only depends on a fixed seed, so every run benchmarks the same design. Signals without
+ * fanout are made primary outputs so that nothing is swept away.
+ */
+void write_bench_circuit(const std::string& filename) {
+    vtr::RngContainer rng(1);
+
+    std::vector<std::string> signals;
+    for (int i = 0; i < kNumInputs; i++) {
+        signals.push_back("in" + std::to_string(i));
+    }
+    std::vector<int> fanouts(signals.size(), 0);
+
+    std::string logic;
+    for (int ilut = 0; ilut < kNumLuts; ilut++) {
+        std::vector<int> fanins;
+        while (fanins.size() < kLutSize) {
+            int num_signals = signals.size();
+            int isignal = rng.irand(3) == 0 ? rng.irand(num_signals - 1)
+                                            : num_signals - 1 - rng.irand(std::min(kFaninWindow, num_signals) - 1);
+            if (std::find(fanins.begin(), fanins.end(), isignal) == fanins.end()) {
+                fanins.push_back(isignal);
+            }
+        }
+
+        std::string lut_out = "n" + std::to_string(ilut);
+        logic += ".names";
+        for (int isignal : fanins) {
+            logic += " " + signals[isignal];
+            fanouts[isignal]++;
+        }
+        logic += " " + lut_out + "\n" + std::string(kLutSize, '1') + " 1\n";
+
+        if (ilut % kRegisterPeriod == 0) {
+            std::string reg_out = "q" + std::to_string(ilut);
+            logic += ".latch " + lut_out + " " + reg_out + " re clk 0\n";
+            lut_out = reg_out;
+        }
+        signals.push_back(lut_out);
+        fanouts.push_back(0);
+    }
+
+    std::ofstream blif(filename);
+    blif << ".model bench_vpr\n";
+    blif << ".inputs clk";
+    for (int i = 0; i < kNumInputs; i++) {
+        blif << " " << signals[i];
+    }
+    blif << "\n.outputs";
+    for (size_t isignal = kNumInputs; isignal < signals.size(); isignal++) {
+        if (fanouts[isignal] == 0) {
+            blif << " " << signals[isignal];
+        }
+    }
+    blif << "\n"
+         << logic << ".end\n";
+}
+
+} // namespace
+
+t_bench_design& bench_design() {
+    if (g_bench_design) {
+        return *g_bench_design;
+    }
+
+    write_bench_circuit(kCircuitFile);
+
+    g_bench_design = std::make_unique<t_bench_design>();
+    const char* argv[] = {
+        "bench_vpr",
+        kArchFile,
+        kCircuitFile,
+        "--route_chan_width", "100",
+        "--net_file", "bench_vpr.net",
+        "--place_file", "bench_vpr.place",
+        "--route_file", "bench_vpr.route"};
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &g_bench_design->options, &g_bench_design->vpr_setup, &g_bench_design->arch);
+
+    if (!vpr_flow(g_bench_design->vpr_setup, g_bench_design->arch)) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to implement the benchmark design");
+    }
+    return *g_bench_design;
+}
+
+void free_bench_design() {
+    if (!g_bench_design) {
+        return;
+    }
+
+    free_routing_structs();
+    vpr_free_all(g_bench_design->arch, g_bench_design->vpr_setup);
+    g_bench_design.reset();
+}
@@ -0,0 +1,27 @@
+#pragma once
+/**
+ * @file
+ * @brief The design the VPR micro-benchmarks run on.
+ *
+ * The benchmarks need realistic packer, placer, router and timing data structures, but none of the
+ * vtr_flow benchmark circuits. So a synthetic netlist (random 4-LUT logic with some registers) is
+ * generated, and implemented by the regular VPR flow on one of the unit test architectures.
+ * The implemented design is left in g_vpr_ctx for the benchmarks to use.
+ */
+
+#include "physical_types.h"
+#include "read_options.h"
+#include "vpr_types.h"
+
+/// @brief The architecture, options and setup the benchmark design was implemented with
+struct t_bench_design {
+    t_options options;
+    t_arch arch;
+    t_vpr_setup vpr_setup;
+};
+
+/// @brief Implements the benchmark design (pack, place and route) the first time it is called, and returns it
+t_bench_design& bench_design();
+
+/// @brief Frees the benchmark design and the VPR contexts, if the design was implemented
+void free_bench_design();
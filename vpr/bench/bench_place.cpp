@@ -0,0 +1,99 @@
+/**
+ * @file
+ * @brief Micro-benchmarks of the placer's incremental net cost evaluation.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "bench_design.h"
+#include "globals.h"
+#include "move_utils.h"
+#include "net_cost_handler.h"
+#include "placer_state.h"
+
+namespace {
+
+/**
+ * @brief Evaluates (and rejects) swaps of random pairs of blocks of the same type in the final
+ *        placement, which is what the annealer spends most of its time on late in the anneal.
+ *
+ * The bounding box cost is evaluated with the incremental (NORMAL) method; the timing cost isn't
+ * evaluated since it also depends on the delay model and criticalities.
+ */
+void BM_net_cost_handler_evaluate_swap(benchmark::State& state) {
+    t_bench_design& design = bench_design();
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& place_ctx = g_vpr_ctx.placement();
+
+    t_placer_opts placer_opts = design.vpr_setup.PlacerOpts;
+    placer_opts.place_algorithm = e_place_algorithm::BOUNDING_BOX_PLACE;
+
+    PlacerState placer_state(/*placement_is_timing_driven=*/false);
+    BlkLocRegistry& blk_loc_registry = placer_state.mutable_blk_loc_registry();
+    blk_loc_registry = place_ctx.blk_loc_registry();
+
+    NetCostHandler net_cost_handler(placer_opts, placer_state, place_ctx.cube_bb);
+    net_cost_handler.comp_bb_cost(e_cost_methods::NORMAL);
+
+    // The swaps are drawn up front, so that the loop only times their evaluation
+    std::vector<ClusterBlockId> blocks(cluster_ctx.clb_nlist.blocks().begin(), cluster_ctx.clb_nlist.blocks().end());
+    std::mt19937 rng(1);
+    std::vector<std::pair<ClusterBlockId, ClusterBlockId>> swaps;
+    while (swaps.size() < 4096) {
+        ClusterBlockId b_from = blocks[rng() % blocks.size()];
+        ClusterBlockId b_to = blocks[rng() % blocks.size()];
+        if (b_from != b_to && cluster_ctx.clb_nlist.block_type(b_from) == cluster_ctx.clb_nlist.block_type(b_to)) {
+            swaps.emplace_back(b_from, b_to);
+        }
+    }
+
+    const PlaceMacros& place_macros = *place_ctx.place_macros;
+    t_pl_blocks_to_be_moved blocks_affected(blocks.size());
+    size_t iswap = 0;
+    size_t num_evaluated = 0;
+    for (auto _ : state) {
+        const auto& [b_from, b_to] = swaps[iswap++ % swaps.size()];
+        t_pl_loc to = blk_loc_registry.block_locs()[b_to].loc;
+        if (create_move(blocks_affected, b_from, to, blk_loc_registry, place_macros) == e_create_move::VALID) {
+            blk_loc_registry.apply_move_blocks(blocks_affected);
+
+            double bb_delta_c = 0.;
+            double timing_delta_c = 0.;
+            net_cost_handler.find_affected_nets_and_update_costs(nullptr, nullptr, blocks_affected, bb_delta_c, timing_delta_c);
+            benchmark::DoNotOptimize(bb_delta_c);
+
+            net_cost_handler.reset_move_nets();
+            blk_loc_registry.revert_move_blocks(blocks_affected);
+            num_evaluated++;
+        }
+        blocks_affected.clear_move_blocks();
+    }
+    state.SetItemsProcessed(num_evaluated);
+}
+BENCHMARK(BM_net_cost_handler_evaluate_swap);
+
+///@brief Computes the bounding boxes and cost of every net from scratch, as done after the initial placement
+void BM_net_cost_handler_comp_bb_cost(benchmark::State& state) {
+    t_bench_design& design = bench_design();
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& place_ctx = g_vpr_ctx.placement();
+
+    t_placer_opts placer_opts = design.vpr_setup.PlacerOpts;
+    placer_opts.place_algorithm = e_place_algorithm::BOUNDING_BOX_PLACE;
+
+    PlacerState placer_state(/*placement_is_timing_driven=*/false);
+    placer_state.mutable_blk_loc_registry() = place_ctx.blk_loc_registry();
+    NetCostHandler net_cost_handler(placer_opts, placer_state, place_ctx.cube_bb);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(net_cost_handler.comp_bb_cost(e_cost_methods::NORMAL));
+    }
+    state.SetItemsProcessed(state.iterations() * cluster_ctx.clb_nlist.nets().size());
+}
+BENCHMARK(BM_net_cost_handler_comp_bb_cost);
+
+} // namespace
@@ -0,0 +1,163 @@
+/**
+ * @file
+ * @brief Micro-benchmarks of the router kernels: the heaps, the router lookahead and RR graph edge iteration.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "bench_design.h"
+#include "connection_router_interface.h"
+#include "d_ary_heap.h"
+#include "globals.h"
+#include "multi_queue_d_ary_heap.h"
+#include "router_lookahead.h"
+
+namespace {
+
+///@brief Cost increases of the neighbours pushed by the heap benchmarks (the same for every run)
+std::vector<float> make_cost_increments(size_t num_increments) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(0.f, 1e-9f);
+    std::vector<float> increments(num_increments);
+    for (float& increment : increments) {
+        increment = dist(rng);
+    }
+    return increments;
+}
+
+/**
+ * @brief Mimics a wavefront expansion: pops num_pops nodes, pushing 3 neighbours with
+ *        higher costs for each of them, then pops the remaining nodes.
+ */
+template<class Heap>
+void expand_wavefront(Heap& heap, size_t num_pops, const std::vector<float>& increments) {
+    size_t iincrement = 0;
+    heap.add_to_heap({0.f, RRNodeId(0)});
+
+    HeapNode heap_node;
+    for (size_t ipop = 0; ipop < num_pops && heap.try_pop(heap_node); ipop++) {
+        for (int ineighbour = 0; ineighbour < 3; ineighbour++) {
+            float prio = heap_node.prio + increments[iincrement++ % increments.size()];
+            heap.add_to_heap({prio, RRNodeId(ipop * 3 + ineighbour)});
+        }
+    }
+    while (heap.try_pop(heap_node)) {
+    }
+    heap.empty_heap();
+}
+
+void BM_d_ary_heap_push_pop(benchmark::State& state) {
+    std::vector<float> increments = make_cost_increments(4096);
+    FourAryHeap heap;
+    for (auto _ : state) {
+        expand_wavefront(heap, state.range(0), increments);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_d_ary_heap_push_pop)->Arg(1 << 10)->Arg(1 << 16);
+
+void BM_multi_queue_d_ary_heap_push_pop(benchmark::State& state) {
+    std::vector<float> increments = make_cost_increments(4096);
+    MultiQueueDAryHeap<4> heap(1, state.range(1));
+    for (auto _ : state) {
+        expand_wavefront(heap, state.range(0), increments);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_multi_queue_d_ary_heap_push_pop)->Args({1 << 10, 2})->Args({1 << 16, 2})->Args({1 << 16, 8});
+
+const RouterLookahead& bench_router_lookahead() {
+    t_vpr_setup& vpr_setup = bench_design().vpr_setup;
+    const t_router_opts& router_opts = vpr_setup.RouterOpts;
+    return *get_cached_router_lookahead(vpr_setup.RoutingArch,
+                                        router_opts.lookahead_type,
+                                        router_opts.write_router_lookahead,
+                                        router_opts.read_router_lookahead,
+                                        vpr_setup.Segments,
+                                        /*is_flat=*/false,
+                                        router_opts.route_verbosity,
+                                        /*setup_cache_dir=*/"",
+                                        router_opts.lookahead_lazy,
+                                        router_opts.lookahead_quantized);
+}
+
+///@brief Look-ups from wire nodes to sinks, the bulk of the router's lookahead queries
+void BM_router_lookahead_get_expected_cost(benchmark::State& state) {
+    const RouterLookahead& router_lookahead = bench_router_lookahead();
+    const RRGraphView& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    std::vector<RRNodeId> wires;
+    std::vector<RRNodeId> sinks;
+    for (RRNodeId node : rr_graph.nodes()) {
+        e_rr_type type = rr_graph.node_type(node);
+        if (type == e_rr_type::CHANX || type == e_rr_type::CHANY) {
+            wires.push_back(node);
+        } else if (type == e_rr_type::SINK) {
+            sinks.push_back(node);
+        }
+    }
+
+    std::mt19937 rng(1);
+    std::vector<std::pair<RRNodeId, RRNodeId>> queries(4096);
+    for (auto& [from_node, to_node] : queries) {
+        from_node = wires[rng() % wires.size()];
+        to_node = sinks[rng() % sinks.size()];
+    }
+
+    t_conn_cost_params cost_params;
+    cost_params.criticality = 0.5;
+    size_t iquery = 0;
+    for (auto _ : state) {
+        const auto& [from_node, to_node] = queries[iquery++ % queries.size()];
+        benchmark::DoNotOptimize(router_lookahead.get_expected_cost(from_node, to_node, cost_params, 0.f));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_router_lookahead_get_expected_cost);
+
+///@brief Visits every edge of the RR graph through the node-relative edge API of RRGraphView
+void BM_rr_graph_edge_iteration(benchmark::State& state) {
+    bench_design();
+    const RRGraphView& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    size_t num_edges = 0;
+    for (auto _ : state) {
+        size_t checksum = 0;
+        num_edges = 0;
+        for (RRNodeId node : rr_graph.nodes()) {
+            for (t_edge_size iedge : rr_graph.edges(node)) {
+                checksum += size_t(rr_graph.edge_sink_node(node, iedge)) + rr_graph.edge_switch(node, iedge);
+                num_edges++;
+            }
+        }
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges);
+}
+BENCHMARK(BM_rr_graph_edge_iteration);
+
+///@brief Visits every edge of the RR graph through the edge ranges of the RR graph storage, like the connection router
+void BM_rr_graph_storage_edge_iteration(benchmark::State& state) {
+    bench_design();
+    const t_rr_graph_storage& rr_nodes = g_vpr_ctx.device().rr_graph.rr_nodes();
+
+    size_t num_edges = 0;
+    for (auto _ : state) {
+        size_t checksum = 0;
+        num_edges = 0;
+        for (size_t inode = 0; inode < rr_nodes.size(); inode++) {
+            for (RREdgeId edge : rr_nodes.edge_range(RRNodeId(inode))) {
+                checksum += size_t(rr_nodes.edge_sink_node(edge)) + rr_nodes.edge_switch(edge);
+                num_edges++;
+            }
+        }
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges);
+}
+BENCHMARK(BM_rr_graph_storage_edge_iteration);
+
+} // namespace
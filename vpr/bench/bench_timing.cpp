@@ -0,0 +1,92 @@
+/**
+ * @file
+ * @brief Micro-benchmarks of tatum's full and incremental setup analyses on VPR's timing graph.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "bench_design.h"
+#include "globals.h"
+
+#include "tatum/analyzer_factory.hpp"
+#include "tatum/delay_calc/FixedDelayCalculator.hpp"
+#include "tatum/TimingGraph.hpp"
+
+namespace {
+
+/**
+ * @brief Returns a delay calculator with random (but repeatable) delays on every edge of the timing graph.
+ *
+ * The analyses only depend on the graph and the delay values, so this times the same traversals as VPR's
+ * own delay calculators, without the cost of computing the delays.
+ */
+tatum::FixedDelayCalculator make_delay_calculator(const tatum::TimingGraph& timing_graph) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(1e-11f, 1e-9f);
+
+    tatum::util::linear_map<tatum::EdgeId, tatum::Time> delays(timing_graph.edges().size());
+    tatum::util::linear_map<tatum::EdgeId, tatum::Time> setup_times(timing_graph.edges().size());
+    for (tatum::EdgeId edge : timing_graph.edges()) {
+        delays[edge] = tatum::Time(dist(rng));
+        setup_times[edge] = tatum::Time(dist(rng) / 10);
+    }
+    return tatum::FixedDelayCalculator(delays, setup_times);
+}
+
+template<class GraphWalker>
+void BM_tatum_full_setup_analysis(benchmark::State& state) {
+    bench_design();
+    const auto& timing_ctx = g_vpr_ctx.timing();
+    tatum::FixedDelayCalculator delay_calc = make_delay_calculator(*timing_ctx.graph);
+    auto analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, GraphWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, delay_calc);
+
+    for (auto _ : state) {
+        analyzer->update_timing();
+    }
+    state.SetItemsProcessed(state.iterations() * timing_ctx.graph->nodes().size());
+}
+BENCHMARK_TEMPLATE(BM_tatum_full_setup_analysis, tatum::SerialWalker);
+BENCHMARK_TEMPLATE(BM_tatum_full_setup_analysis, tatum::ParallelWalker);
+
+/**
+ * @brief Changes the delays of state.range(0) random interconnect edges between analyses, the way
+ *        the placer invalidates the connections of the moved blocks.
+ */
+template<class GraphWalker>
+void BM_tatum_incremental_setup_analysis(benchmark::State& state) {
+    bench_design();
+    const auto& timing_ctx = g_vpr_ctx.timing();
+    const tatum::TimingGraph& timing_graph = *timing_ctx.graph;
+    tatum::FixedDelayCalculator delay_calc = make_delay_calculator(timing_graph);
+    auto analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, GraphWalker>::make(timing_graph, *timing_ctx.constraints, delay_calc);
+    analyzer->update_timing();
+
+    std::vector<tatum::EdgeId> net_edges;
+    for (tatum::EdgeId edge : timing_graph.edges()) {
+        if (timing_graph.edge_type(edge) == tatum::EdgeType::INTERCONNECT) {
+            net_edges.push_back(edge);
+        }
+    }
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(1e-11f, 1e-9f);
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int64_t i = 0; i < state.range(0); i++) {
+            tatum::EdgeId edge = net_edges[rng() % net_edges.size()];
+            delay_calc.set_max_edge_delay(timing_graph, edge, tatum::Time(dist(rng)));
+            analyzer->invalidate_edge(edge);
+        }
+        state.ResumeTiming();
+
+        analyzer->update_timing();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_tatum_incremental_setup_analysis, tatum::SerialIncrWalker)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_tatum_incremental_setup_analysis, tatum::ParallelIncrWalker)->Arg(16)->Arg(256);
+
+} // namespace
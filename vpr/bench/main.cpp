@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+
+#include "bench_design.h"
+#include "vpr_api.h"
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    vpr_initialize_logging();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    // The design is only implemented if a benchmark needed it
+    free_bench_design();
+    return 0;
+}
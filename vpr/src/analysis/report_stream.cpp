@@ -0,0 +1,126 @@
+/**
+ * @file
+ * @brief Implementation of the report output streams.
+ */
+
+#include "report_stream.h"
+
+#include <fstream>
+#include <streambuf>
+#include <vector>
+#include <zlib.h>
+
+#include "vpr_error.h"
+
+namespace {
+
+/// @brief Size of the buffer the reports are written through.
+constexpr size_t REPORT_BUFFER_SIZE = 1 << 20;
+
+/// @brief File stream writing through a large buffer.
+class BufferedReportStream : public std::ofstream {
+  public:
+    explicit BufferedReportStream(const std::string& filename)
+        : buffer_(REPORT_BUFFER_SIZE) {
+        //The buffer must be set before the file is opened
+        rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+        open(filename);
+    }
+
+    ~BufferedReportStream() override {
+        //Flush while the buffer is still alive
+        close();
+    }
+
+  private:
+    std::vector<char> buffer_;
+};
+
+/// @brief Stream buffer gzip compressing what is written to it into a file.
+class GzipStreambuf : public std::streambuf {
+  public:
+    explicit GzipStreambuf(const std::string& filename)
+        : buffer_(REPORT_BUFFER_SIZE)
+        , file_(gzopen(filename.c_str(), "wb")) {
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+    }
+
+    ~GzipStreambuf() override {
+        flush_buffer();
+        if (file_) {
+            gzclose(file_);
+        }
+    }
+
+    bool is_open() const { return file_ != nullptr; }
+
+  protected:
+    int_type overflow(int_type ch) override {
+        if (!flush_buffer()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override {
+        return flush_buffer() ? 0 : -1;
+    }
+
+  private:
+    ///@brief Compresses the buffered data, returns false on error.
+    bool flush_buffer() {
+        int num_bytes = int(pptr() - pbase());
+        if (num_bytes > 0) {
+            if (!file_ || gzwrite(file_, pbase(), num_bytes) != num_bytes) {
+                return false;
+            }
+            pbump(-num_bytes);
+        }
+        return true;
+    }
+
+    std::vector<char> buffer_;
+    gzFile file_;
+};
+
+/// @brief Output stream gzip compressing into a file.
+class GzipReportStream : public std::ostream {
+  public:
+    explicit GzipReportStream(const std::string& filename)
+        : std::ostream(nullptr)
+        , streambuf_(filename) {
+        rdbuf(&streambuf_);
+        if (!streambuf_.is_open()) {
+            setstate(std::ios::failbit);
+        }
+    }
+
+    ~GzipReportStream() override {
+        flush();
+    }
+
+  private:
+    GzipStreambuf streambuf_;
+};
+
+} // namespace
+
+std::unique_ptr<std::ostream> open_report_stream(const std::string& filename, bool compress) {
+    std::unique_ptr<std::ostream> os;
+    std::string report_filename = filename;
+    if (compress) {
+        report_filename += ".gz";
+        os = std::make_unique<GzipReportStream>(report_filename);
+    } else {
+        os = std::make_unique<BufferedReportStream>(report_filename);
+    }
+
+    if (!*os) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to open report file '%s' for writing\n", report_filename.c_str());
+    }
+    return os;
+}
@@ -0,0 +1,24 @@
+#pragma once
+/**
+ * @file
+ * @brief Output streams for (potentially very large) report files.
+ *
+ * Reports like the timing reports are written as many small formatted writes.
+ * The streams opened here write through a large buffer, and can optionally
+ * gzip compress the report on the fly (see --timing_report_compress).
+ */
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Opens a buffered output stream to the report file.
+ *
+ *   @param filename  Name of the report file
+ *   @param compress  Gzip compress the report, which is then written to
+ *                    '<filename>.gz'
+ *
+ * Errors out if the report file can not be opened.
+ */
+std::unique_ptr<std::ostream> open_report_stream(const std::string& filename, bool compress);
@@ -1,8 +1,6 @@
 #include "timing_reports.h"
 
-#include <fstream>
-
-#include "timing_reports.h"
+#include "report_stream.h"
 
 #include "tatum/TimingReporter.hpp"
 
@@ -142,13 +140,15 @@ void generate_setup_timing_stats(const std::string& prefix,
 
     tatum::TimingReporter timing_reporter(resolver, *timing_ctx.graph, *timing_ctx.constraints);
 
-    timing_reporter.report_timing_setup(prefix + "report_timing.setup.rpt", *timing_info.setup_analyzer(), analysis_opts.timing_report_npaths);
+    bool compress = analysis_opts.timing_report_compress;
+
+    timing_reporter.report_timing_setup(*open_report_stream(prefix + "report_timing.setup.rpt", compress), *timing_info.setup_analyzer(), analysis_opts.timing_report_npaths);
 
     if (analysis_opts.timing_report_skew) {
-        timing_reporter.report_skew_setup(prefix + "report_skew.setup.rpt", *timing_info.setup_analyzer(), analysis_opts.timing_report_npaths);
+        timing_reporter.report_skew_setup(*open_report_stream(prefix + "report_skew.setup.rpt", compress), *timing_info.setup_analyzer(), analysis_opts.timing_report_npaths);
     }
 
-    timing_reporter.report_unconstrained_setup(prefix + "report_unconstrained_timing.setup.rpt", *timing_info.setup_analyzer());
+    timing_reporter.report_unconstrained_setup(*open_report_stream(prefix + "report_unconstrained_timing.setup.rpt", compress), *timing_info.setup_analyzer());
 }
 
 void generate_hold_timing_stats(const std::string& prefix,
@@ -168,19 +168,23 @@ void generate_hold_timing_stats(const std::string& prefix,
 
     tatum::TimingReporter timing_reporter(resolver, *timing_ctx.graph, *timing_ctx.constraints);
 
-    timing_reporter.report_timing_hold(prefix + "report_timing.hold.rpt", *timing_info.hold_analyzer(), analysis_opts.timing_report_npaths);
+    bool compress = analysis_opts.timing_report_compress;
+
+    timing_reporter.report_timing_hold(*open_report_stream(prefix + "report_timing.hold.rpt", compress), *timing_info.hold_analyzer(), analysis_opts.timing_report_npaths);
 
     if (analysis_opts.timing_report_skew) {
-        timing_reporter.report_skew_hold(prefix + "report_skew.hold.rpt", *timing_info.hold_analyzer(), analysis_opts.timing_report_npaths);
+        timing_reporter.report_skew_hold(*open_report_stream(prefix + "report_skew.hold.rpt", compress), *timing_info.hold_analyzer(), analysis_opts.timing_report_npaths);
     }
 
-    timing_reporter.report_unconstrained_hold(prefix + "report_unconstrained_timing.hold.rpt", *timing_info.hold_analyzer());
+    timing_reporter.report_unconstrained_hold(*open_report_stream(prefix + "report_unconstrained_timing.hold.rpt", compress), *timing_info.hold_analyzer());
 }
 
 void generate_net_timing_report(const std::string& prefix,
                                 const SetupHoldTimingInfo& timing_info,
-                                const AnalysisDelayCalculator& delay_calc) {
-    std::ofstream os(prefix + "report_net_timing.csv");
+                                const AnalysisDelayCalculator& delay_calc,
+                                bool compress) {
+    std::unique_ptr<std::ostream> report_os = open_report_stream(prefix + "report_net_timing.csv", compress);
+    std::ostream& os = *report_os;
     const auto& atom_netlist = g_vpr_ctx.atom().netlist();
     const auto& atom_lookup = g_vpr_ctx.atom().lookup();
     const auto& timing_ctx = g_vpr_ctx.timing();
@@ -189,7 +193,7 @@ void generate_net_timing_report(const std::string& prefix,
     // Write CSV header
     os << "netname,Fanout,bb_xmin,bb_ymin,bb_layer_min,"
        << "bb_xmax,bb_ymax,bb_layer_max,"
-       << "src_pin_name,src_pin_slack,sinks" << std::endl;
+       << "src_pin_name,src_pin_slack,sinks\n";
 
     for (const auto& net : atom_netlist.nets()) {
         const auto& net_name = atom_netlist.net_name(net);
@@ -225,6 +229,6 @@ void generate_net_timing_report(const std::string& prefix,
             os << pin_name << "," << pin_setup_slack << "," << pin_delay;
             if (i != fanout - 1) os << ";";
         }
-        os << "\"" << std::endl; // Close quoted sinks field and finish the row
+        os << "\"\n"; // Close quoted sinks field and finish the row
     }
 }
@@ -40,7 +40,9 @@ void generate_hold_timing_stats(const std::string& prefix,
  * @param prefix       Prefix for the output file name (report will be saved as <prefix>report_net_timing.csv)
  * @param timing_info  Timing analysis results (slacks)
  * @param delay_calc   Delay calculator used to extract delay between nodes
+ * @param compress     Gzip compress the report (saved as <prefix>report_net_timing.csv.gz)
  */
 void generate_net_timing_report(const std::string& prefix,
                                 const SetupHoldTimingInfo& timing_info,
-                                const AnalysisDelayCalculator& delay_calc);
+                                const AnalysisDelayCalculator& delay_calc,
+                                bool compress = false);
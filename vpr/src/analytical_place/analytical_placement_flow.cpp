@@ -22,6 +22,7 @@
 #include "netlist_fwd.h"
 #include "partial_legalizer.h"
 #include "partial_placement.h"
+#include "partial_placement_checkpoint.h"
 #include "physical_types.h"
 #include "place_delay_model.h"
 #include "prepack.h"
@@ -159,8 +160,9 @@ static void convert_flat_to_partial_placement(const FlatPlacementInfo& flat_plac
 }
 
 /**
- * @brief If a flat placement is provided, skips the Global Placer and
- * converts it to a partial placement. Otherwise, runs the Global Placer.
+ * @brief If a partial placement checkpoint or a flat placement is provided,
+ * skips the Global Placer and loads / converts it to a partial placement.
+ * Otherwise, runs the Global Placer.
  */
 static PartialPlacement run_global_placer(const t_ap_opts& ap_opts,
                                           const AtomNetlist& atom_nlist,
@@ -169,7 +171,14 @@ static PartialPlacement run_global_placer(const t_ap_opts& ap_opts,
                                           PreClusterTimingManager& pre_cluster_timing_manager,
                                           std::shared_ptr<PlaceDelayModel> place_delay_model,
                                           const DeviceContext& device_ctx) {
-    if (g_vpr_ctx.atom().flat_placement_info().valid) {
+    if (!ap_opts.read_partial_placement_file.empty()) {
+        VTR_LOG("Partial placement checkpoint is provided in the AP flow, skipping the Global Placement.\n");
+        PartialPlacement p_placement(ap_netlist);
+        read_partial_placement_checkpoint(ap_opts.read_partial_placement_file,
+                                          p_placement,
+                                          ap_netlist);
+        return p_placement;
+    } else if (g_vpr_ctx.atom().flat_placement_info().valid) {
         VTR_LOG("Flat Placement is provided in the AP flow, skipping the Global Placement.\n");
         PartialPlacement p_placement(ap_netlist);
         convert_flat_to_partial_placement(g_vpr_ctx.atom().flat_placement_info(),
@@ -179,7 +188,8 @@ static PartialPlacement run_global_placer(const t_ap_opts& ap_opts,
         return p_placement;
     } else {
         // Run the Global Placer
-        std::unique_ptr<GlobalPlacer> global_placer = make_global_placer(ap_opts.analytical_solver_type,
+        std::unique_ptr<GlobalPlacer> global_placer = make_global_placer(ap_opts.global_placer_type,
+                                                                         ap_opts.analytical_solver_type,
                                                                          ap_opts.partial_legalizer_type,
                                                                          ap_netlist,
                                                                          prepacker,
@@ -255,6 +265,14 @@ void run_analytical_placement_flow(t_vpr_setup& vpr_setup) {
                                                      place_delay_model,
                                                      device_ctx);
 
+    // Save the result of global placement if requested, so the later stages
+    // can be re-run from it.
+    if (!ap_opts.write_partial_placement_file.empty()) {
+        write_partial_placement_checkpoint(ap_opts.write_partial_placement_file,
+                                           p_placement,
+                                           ap_netlist);
+    }
+
     // Verify that the partial placement is valid before running the full
     // legalizer.
     const size_t device_width = device_ctx.grid.width();
@@ -7,6 +7,7 @@
  */
 
 #include "analytical_solver.h"
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <limits>
@@ -29,6 +30,11 @@
 #include "vtr_time.h"
 #include "vtr_vector.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_invoke.h>
+#endif
+
 #ifdef EIGEN_INSTALLED
 // The eigen library contains a warning in GCC13 for a null dereference. This
 // causes the CI build to fail due to the warning. Ignoring the warning for
@@ -47,6 +53,22 @@
 #pragma GCC diagnostic pop
 #endif // EIGEN_INSTALLED
 
+/**
+ * @brief Solves the x and y dimensions of a linear system.
+ *
+ * The two dimensions are independent, so they are solved at the same time
+ * if VPR is built with TBB.
+ */
+template<typename SolveXFunc, typename SolveYFunc>
+static void solve_x_and_y(const SolveXFunc& solve_x, const SolveYFunc& solve_y) {
+#ifdef VPR_USE_TBB
+    tbb::parallel_invoke(solve_x, solve_y);
+#else
+    solve_x();
+    solve_y();
+#endif
+}
+
 std::unique_ptr<AnalyticalSolver> make_analytical_solver(e_ap_analytical_solver solver_type,
                                                          const APNetlist& netlist,
                                                          const DeviceGrid& device_grid,
@@ -308,6 +330,12 @@ void QPHybridSolver::init_linear_system() {
     //       space, but be within a constant factor.
     tripletList.reserve(num_nets);
 
+    // Make sure that every moveable block has an entry on the diagonal of the
+    // coefficient matrix. The anchors are added onto these entries in place.
+    for (size_t row_id_idx = 0; row_id_idx < num_moveable_blocks_; row_id_idx++) {
+        tripletList.emplace_back(row_id_idx, row_id_idx, 0.0);
+    }
+
     // Create the connections using a hybrid connection model of the star and
     // clique connnection models.
     size_t star_node_offset = 0;
@@ -372,6 +400,24 @@ void QPHybridSolver::init_linear_system() {
 
     // Populate the A_sparse matrix using the triplets.
     A_sparse.setFromTriplets(tripletList.begin(), tripletList.end());
+
+    // Find where the diagonal entry of each moveable block is stored in the
+    // (compressed) coefficient matrix.
+    diag_value_indices_.resize(num_moveable_blocks_);
+    for (size_t row_id_idx = 0; row_id_idx < num_moveable_blocks_; row_id_idx++) {
+        using StorageIndex = Eigen::SparseMatrix<double>::StorageIndex;
+        const StorageIndex* col_begin = A_sparse.innerIndexPtr() + A_sparse.outerIndexPtr()[row_id_idx];
+        const StorageIndex* col_end = A_sparse.innerIndexPtr() + A_sparse.outerIndexPtr()[row_id_idx + 1];
+        const StorageIndex* diag = std::lower_bound(col_begin, col_end, StorageIndex(row_id_idx));
+        VTR_ASSERT_SAFE(diag != col_end && *diag == StorageIndex(row_id_idx));
+        diag_value_indices_[row_id_idx] = diag - A_sparse.innerIndexPtr();
+    }
+
+    // The anchored linear system has the same sparsity pattern; allocate it
+    // once here and only update its values each iteration.
+    A_sparse_anchored_ = A_sparse;
+    b_x_anchored_ = b_x;
+    b_y_anchored_ = b_y;
 }
 
 void QPHybridSolver::update_linear_system_with_anchors(
@@ -386,7 +432,7 @@ void QPHybridSolver::update_linear_system_with_anchors(
         APRowId row_id = APRowId(row_id_idx);
         APBlockId blk_id = row_id_to_blk_id_[row_id];
         double pseudo_w = coeff_pseudo_anchor;
-        A_sparse_diff.coeffRef(row_id_idx, row_id_idx) += pseudo_w;
+        A_sparse_diff.valuePtr()[diag_value_indices_[row_id_idx]] += pseudo_w;
         b_x_diff(row_id_idx) += pseudo_w * p_placement.block_x_locs[blk_id];
         b_y_diff(row_id_idx) += pseudo_w * p_placement.block_y_locs[blk_id];
     }
@@ -449,11 +495,16 @@ void QPHybridSolver::solve(unsigned iteration, PartialPlacement& p_placement) {
         return;
     }
 
-    // Create a temporary linear system which will contain the original linear
-    // system which may be updated to include the anchor points.
-    Eigen::SparseMatrix<double> A_sparse_diff = Eigen::SparseMatrix<double>(A_sparse);
-    Eigen::VectorXd b_x_diff = Eigen::VectorXd(b_x);
-    Eigen::VectorXd b_y_diff = Eigen::VectorXd(b_y);
+    // Reset the anchored linear system to the original linear system, which
+    // may then be updated to include the anchor points. The anchors only
+    // change the diagonal, so the sparsity pattern is kept from the previous
+    // iteration and only the values are copied over.
+    Eigen::SparseMatrix<double>& A_sparse_diff = A_sparse_anchored_;
+    Eigen::VectorXd& b_x_diff = b_x_anchored_;
+    Eigen::VectorXd& b_y_diff = b_y_anchored_;
+    std::copy_n(A_sparse.valuePtr(), A_sparse.nonZeros(), A_sparse_diff.valuePtr());
+    b_x_diff = b_x;
+    b_y_diff = b_y;
     // In the first iteration, the orginal linear system is used.
     // In any other iteration, use the moveable APBlocks current placement as
     //                         anchor-points (fixed block positions).
@@ -470,16 +521,23 @@ void QPHybridSolver::solve(unsigned iteration, PartialPlacement& p_placement) {
     //  - This tolerance may need to be a function of the number of nets.
     //  - Instead of normalizing the fixed blocks, the tolerance can be scaled
     //    by the size of the device.
-    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> cg;
-    cg.compute(A_sparse_diff);
-    VTR_ASSERT(cg.info() == Eigen::Success && "Conjugate Gradient failed at compute!");
+    // NOTE: Using both the lower and upper triangle of the matrix lets Eigen
+    //       multithread the matrix-vector products of the (Jacobi preconditioned)
+    //       CG, using the number of threads from make_analytical_solver.
+    // NOTE: The solver objects keep the statistics of their last solve, so
+    //       each dimension, which may be solved concurrently, has its own.
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> cg_x;
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> cg_y;
+    cg_x.compute(A_sparse_diff);
+    cg_y.compute(A_sparse_diff);
+    VTR_ASSERT(cg_x.info() == Eigen::Success && cg_y.info() == Eigen::Success && "Conjugate Gradient failed at compute!");
     // Use the solver to solve for x and y using the constant vectors
-    Eigen::VectorXd x = cg.solveWithGuess(b_x_diff, guess_x);
-    total_num_cg_iters_ += cg.iterations();
-    VTR_ASSERT(cg.info() == Eigen::Success && "Conjugate Gradient failed at solving b_x!");
-    Eigen::VectorXd y = cg.solveWithGuess(b_y_diff, guess_y);
-    total_num_cg_iters_ += cg.iterations();
-    VTR_ASSERT(cg.info() == Eigen::Success && "Conjugate Gradient failed at solving b_y!");
+    Eigen::VectorXd x, y;
+    solve_x_and_y([&]() { x = cg_x.solveWithGuess(b_x_diff, guess_x); },
+                  [&]() { y = cg_y.solveWithGuess(b_y_diff, guess_y); });
+    total_num_cg_iters_ += cg_x.iterations() + cg_y.iterations();
+    VTR_ASSERT(cg_x.info() == Eigen::Success && "Conjugate Gradient failed at solving b_x!");
+    VTR_ASSERT(cg_y.info() == Eigen::Success && "Conjugate Gradient failed at solving b_y!");
 
     // Write the results back into the partial placement object.
     store_solution_into_placement(x, y, p_placement);
@@ -694,8 +752,6 @@ void B2BSolver::b2b_solve_loop(unsigned iteration, PartialPlacement& p_placement
         // Set up the linear system, including anchor points.
         float build_linear_system_start_time = runtime_timer.elapsed_sec();
         init_linear_system(p_placement, iteration);
-        if (iteration != 0)
-            update_linear_system_with_anchors(iteration);
         total_time_spent_building_linear_system_ += runtime_timer.elapsed_sec() - build_linear_system_start_time;
         VTR_ASSERT_SAFE_MSG(!b_x.hasNaN(), "b_x has NaN!");
         VTR_ASSERT_SAFE_MSG(!b_y.hasNaN(), "b_y has NaN!");
@@ -716,14 +772,11 @@ void B2BSolver::b2b_solve_loop(unsigned iteration, PartialPlacement& p_placement
         cg_x.setMaxIterations(max_cg_iterations_);
         cg_y.setMaxIterations(max_cg_iterations_);
 
-        // Solve the x dimension.
-        x = cg_x.solveWithGuess(b_x, x_guess);
-        total_num_cg_iters_ += cg_x.iterations();
+        // Solve the x and y dimensions (concurrently if possible).
+        solve_x_and_y([&]() { x = cg_x.solveWithGuess(b_x, x_guess); },
+                      [&]() { y = cg_y.solveWithGuess(b_y, y_guess); });
+        total_num_cg_iters_ += cg_x.iterations() + cg_y.iterations();
         VTR_LOGV(log_verbosity_ >= 20, "\t\tNum CG-x iter: %zu\n", cg_x.iterations());
-
-        // Solve the y dimension.
-        y = cg_y.solveWithGuess(b_y, y_guess);
-        total_num_cg_iters_ += cg_y.iterations();
         VTR_LOGV(log_verbosity_ >= 20, "\t\tNum CG-y iter: %zu\n", cg_y.iterations());
 
         total_time_spent_solving_linear_system_ += runtime_timer.elapsed_sec() - solve_linear_system_start_time;
@@ -861,7 +914,7 @@ void B2BSolver::add_connection_to_system(APBlockId first_blk_id,
                                          double net_w,
                                          const vtr::vector<APBlockId, double>& blk_locs,
                                          std::vector<Eigen::Triplet<double>>& triplet_list,
-                                         Eigen::VectorXd& b) {
+                                         std::vector<std::pair<size_t, double>>& b_entries) {
     // To make the code below simpler, we assume that the first block is always
     // moveable.
     if (netlist_.block_mobility(first_blk_id) != APBlockMobility::MOVEABLE) {
@@ -894,7 +947,7 @@ void B2BSolver::add_connection_to_system(APBlockId first_blk_id,
         triplet_list.emplace_back(second_row_id, first_row_id, -w);
     } else {
         triplet_list.emplace_back(first_row_id, first_row_id, w);
-        b(first_row_id) += w * blk_locs[second_blk_id];
+        b_entries.emplace_back(first_row_id, w * blk_locs[second_blk_id]);
     }
 }
 
@@ -1080,6 +1133,112 @@ std::pair<double, double> B2BSolver::get_delay_normalization_facs(APBlockId driv
     return std::make_pair(1.0 / norm_fac_inv_x, 1.0 / norm_fac_inv_y);
 }
 
+void B2BSolver::add_net_to_linear_system(APNetId net_id,
+                                         const PartialPlacement& p_placement,
+                                         unsigned iteration,
+                                         LinearSystemPart& system_part) {
+    if (netlist_.net_is_ignored(net_id))
+        return;
+    size_t num_pins = netlist_.net_pins(net_id).size();
+    VTR_ASSERT_SAFE_MSG(num_pins > 1, "net must have at least 2 pins");
+
+    // ====================================================================
+    // Wirelength Connections
+    // ====================================================================
+    // In the objective there is are wirelength connections and timing
+    // connections, trade-off between the weight of each type of connection.
+    double wl_net_w = (1.0f - ap_timing_tradeoff_) * net_weights_[net_id];
+
+    // Find the bounding blocks
+    APNetBounds net_bounds = get_unique_net_bounds(net_id, p_placement, netlist_);
+
+    // Add an edge from every block to their bounds (ignoring the bounds
+    // themselves for now).
+    // FIXME: If one block has multiple pins, it may connect to the bounds
+    //        multiple times. Should investigate the effect of this.
+    for (APPinId pin_id : netlist_.net_pins(net_id)) {
+        APBlockId blk_id = netlist_.pin_block(pin_id);
+        if (blk_id != net_bounds.max_x_blk && blk_id != net_bounds.min_x_blk) {
+            add_connection_to_system(blk_id, net_bounds.max_x_blk, num_pins, wl_net_w, p_placement.block_x_locs, system_part.triplet_list_x, system_part.b_entries_x);
+            add_connection_to_system(blk_id, net_bounds.min_x_blk, num_pins, wl_net_w, p_placement.block_x_locs, system_part.triplet_list_x, system_part.b_entries_x);
+        }
+        if (blk_id != net_bounds.max_y_blk && blk_id != net_bounds.min_y_blk) {
+            add_connection_to_system(blk_id, net_bounds.max_y_blk, num_pins, wl_net_w, p_placement.block_y_locs, system_part.triplet_list_y, system_part.b_entries_y);
+            add_connection_to_system(blk_id, net_bounds.min_y_blk, num_pins, wl_net_w, p_placement.block_y_locs, system_part.triplet_list_y, system_part.b_entries_y);
+        }
+    }
+
+    // Connect the bounds to each other. Its just easier to put these here
+    // instead of in the for loop above.
+    add_connection_to_system(net_bounds.max_x_blk, net_bounds.min_x_blk, num_pins, wl_net_w, p_placement.block_x_locs, system_part.triplet_list_x, system_part.b_entries_x);
+    add_connection_to_system(net_bounds.max_y_blk, net_bounds.min_y_blk, num_pins, wl_net_w, p_placement.block_y_locs, system_part.triplet_list_y, system_part.b_entries_y);
+
+    // ====================================================================
+    // Timing Connections
+    // ====================================================================
+    // Only add timing connection if timing analysis is on and we are not
+    // in the first iteration. The current timing flow needs legalized
+    // positions to compute the delay derivative, which do not exist until
+    // the next iteration. Its fine to do one wirelength driven iteration first.
+    if (pre_cluster_timing_manager_.is_valid() && iteration != 0) {
+        // Create connections from each driver pin to each of it's sink pins.
+        // This will incentivize shrinking the distance from drivers to sinks
+        // of connections which would improve the timing.
+        APPinId driver_pin = netlist_.net_driver(net_id);
+        APBlockId driver_blk = netlist_.pin_block(driver_pin);
+        for (APPinId sink_pin : netlist_.net_sinks(net_id)) {
+            APBlockId sink_blk = netlist_.pin_block(sink_pin);
+
+            // Get the instantaneous derivative of delay at the given distance
+            // from driver to sink. This will provide a value which is higher
+            // if the tradeoff between delay and wirelength is better, and
+            // lower when the tradeoff between delay and wirelength is worse.
+            auto [d_delay_x, d_delay_y] = get_delay_derivative(driver_blk,
+                                                               sink_blk,
+                                                               p_placement);
+
+            // Since the delay between two blocks may not monotonically increase
+            // (it may go down with distance due to different length wires), it
+            // is possible for the derivative of delay to be negative. The weight
+            // terms in this formulation should not be negative to prevent infinite
+            // answers. To prevent this, clamp the derivative to 0.
+            // TODO: If this is negative, it means that the sink should try to move
+            //       away from the driver. Perhaps add an anchor point to pull the
+            //       sink away.
+            d_delay_x = std::max(d_delay_x, 0.0);
+            d_delay_y = std::max(d_delay_y, 0.0);
+
+            // The units for delay are in seconds; however the units for
+            // the wirelength term are in tiles. To ensure the units match,
+            // we need to normalize away the time units. Get normalization
+            // factors to remove the time units.
+            auto [delay_x_norm, delay_y_norm] = get_delay_normalization_facs(driver_blk);
+
+            // Get the criticality of this timing edge from driver to sink.
+            double crit = pre_cluster_timing_manager_.get_timing_info().setup_pin_criticality(netlist_.pin_atom_pin(sink_pin));
+
+            // Set the weight of the connection from driver to sink equal to:
+            //      weight_tradeoff_terms * (1 + crit) * d_delay * delay_norm
+            // The intuition is that we want the solver to shrink the distance
+            // from drivers to sinks (which would improve timing) for edges
+            // with the best tradeoff between delay and wire, with a focus
+            // on the more critical edges.
+            // The ap_timing_tradeoff serves to trade-off between the wirelength
+            // and timing net weights. The net weights are the general net weights
+            // based on prior knowledge about the nets.
+            double timing_net_w = ap_timing_tradeoff_ * net_weights_[net_id] * timing_slope_fac_ * (1.0 + crit);
+
+            add_connection_to_system(driver_blk, sink_blk,
+                                     2 /*num_pins*/, timing_net_w * d_delay_x * delay_x_norm,
+                                     p_placement.block_x_locs, system_part.triplet_list_x, system_part.b_entries_x);
+
+            add_connection_to_system(driver_blk, sink_blk,
+                                     2 /*num_pins*/, timing_net_w * d_delay_y * delay_y_norm,
+                                     p_placement.block_y_locs, system_part.triplet_list_y, system_part.b_entries_y);
+        }
+    }
+}
+
 void B2BSolver::init_linear_system(PartialPlacement& p_placement, unsigned iteration) {
     // Reset the linear system
     A_sparse_x = Eigen::SparseMatrix<double>(num_moveable_blocks_, num_moveable_blocks_);
@@ -1087,120 +1246,69 @@ void B2BSolver::init_linear_system(PartialPlacement& p_placement, unsigned itera
     b_x = Eigen::VectorXd::Zero(num_moveable_blocks_);
     b_y = Eigen::VectorXd::Zero(num_moveable_blocks_);
 
-    // Create triplet lists to store the sparse positions to update and reserve
-    // space for them.
-    size_t total_num_pins_in_netlist = netlist_.pins().size();
-    std::vector<Eigen::Triplet<double>> triplet_list_x;
-    triplet_list_x.reserve(total_num_pins_in_netlist);
-    std::vector<Eigen::Triplet<double>> triplet_list_y;
-    triplet_list_y.reserve(total_num_pins_in_netlist);
-
-    for (APNetId net_id : netlist_.nets()) {
-        if (netlist_.net_is_ignored(net_id))
-            continue;
-        size_t num_pins = netlist_.net_pins(net_id).size();
-        VTR_ASSERT_SAFE_MSG(num_pins > 1, "net must have at least 2 pins");
-
-        // ====================================================================
-        // Wirelength Connections
-        // ====================================================================
-        // In the objective there is are wirelength connections and timing
-        // connections, trade-off between the weight of each type of connection.
-        double wl_net_w = (1.0f - ap_timing_tradeoff_) * net_weights_[net_id];
-
-        // Find the bounding blocks
-        APNetBounds net_bounds = get_unique_net_bounds(net_id, p_placement, netlist_);
-
-        // Add an edge from every block to their bounds (ignoring the bounds
-        // themselves for now).
-        // FIXME: If one block has multiple pins, it may connect to the bounds
-        //        multiple times. Should investigate the effect of this.
-        for (APPinId pin_id : netlist_.net_pins(net_id)) {
-            APBlockId blk_id = netlist_.pin_block(pin_id);
-            if (blk_id != net_bounds.max_x_blk && blk_id != net_bounds.min_x_blk) {
-                add_connection_to_system(blk_id, net_bounds.max_x_blk, num_pins, wl_net_w, p_placement.block_x_locs, triplet_list_x, b_x);
-                add_connection_to_system(blk_id, net_bounds.min_x_blk, num_pins, wl_net_w, p_placement.block_x_locs, triplet_list_x, b_x);
-            }
-            if (blk_id != net_bounds.max_y_blk && blk_id != net_bounds.min_y_blk) {
-                add_connection_to_system(blk_id, net_bounds.max_y_blk, num_pins, wl_net_w, p_placement.block_y_locs, triplet_list_y, b_y);
-                add_connection_to_system(blk_id, net_bounds.min_y_blk, num_pins, wl_net_w, p_placement.block_y_locs, triplet_list_y, b_y);
-            }
-        }
-
-        // Connect the bounds to each other. Its just easier to put these here
-        // instead of in the for loop above.
-        add_connection_to_system(net_bounds.max_x_blk, net_bounds.min_x_blk, num_pins, wl_net_w, p_placement.block_x_locs, triplet_list_x, b_x);
-        add_connection_to_system(net_bounds.max_y_blk, net_bounds.min_y_blk, num_pins, wl_net_w, p_placement.block_y_locs, triplet_list_y, b_y);
-
-        // ====================================================================
-        // Timing Connections
-        // ====================================================================
-        // Only add timing connection if timing analysis is on and we are not
-        // in the first iteration. The current timing flow needs legalized
-        // positions to compute the delay derivative, which do not exist until
-        // the next iteration. Its fine to do one wirelength driven iteration first.
-        if (pre_cluster_timing_manager_.is_valid() && iteration != 0) {
-            // Create connections from each driver pin to each of it's sink pins.
-            // This will incentivize shrinking the distance from drivers to sinks
-            // of connections which would improve the timing.
-            APPinId driver_pin = netlist_.net_driver(net_id);
-            APBlockId driver_blk = netlist_.pin_block(driver_pin);
-            for (APPinId sink_pin : netlist_.net_sinks(net_id)) {
-                APBlockId sink_blk = netlist_.pin_block(sink_pin);
-
-                // Get the instantaneous derivative of delay at the given distance
-                // from driver to sink. This will provide a value which is higher
-                // if the tradeoff between delay and wirelength is better, and
-                // lower when the tradeoff between delay and wirelength is worse.
-                auto [d_delay_x, d_delay_y] = get_delay_derivative(driver_blk,
-                                                                   sink_blk,
-                                                                   p_placement);
-
-                // Since the delay between two blocks may not monotonically increase
-                // (it may go down with distance due to different length wires), it
-                // is possible for the derivative of delay to be negative. The weight
-                // terms in this formulation should not be negative to prevent infinite
-                // answers. To prevent this, clamp the derivative to 0.
-                // TODO: If this is negative, it means that the sink should try to move
-                //       away from the driver. Perhaps add an anchor point to pull the
-                //       sink away.
-                d_delay_x = std::max(d_delay_x, 0.0);
-                d_delay_y = std::max(d_delay_y, 0.0);
-
-                // The units for delay are in seconds; however the units for
-                // the wirelength term are in tiles. To ensure the units match,
-                // we need to normalize away the time units. Get normalization
-                // factors to remove the time units.
-                auto [delay_x_norm, delay_y_norm] = get_delay_normalization_facs(driver_blk);
-
-                // Get the criticality of this timing edge from driver to sink.
-                double crit = pre_cluster_timing_manager_.get_timing_info().setup_pin_criticality(netlist_.pin_atom_pin(sink_pin));
-
-                // Set the weight of the connection from driver to sink equal to:
-                //      weight_tradeoff_terms * (1 + crit) * d_delay * delay_norm
-                // The intuition is that we want the solver to shrink the distance
-                // from drivers to sinks (which would improve timing) for edges
-                // with the best tradeoff between delay and wire, with a focus
-                // on the more critical edges.
-                // The ap_timing_tradeoff serves to trade-off between the wirelength
-                // and timing net weights. The net weights are the general net weights
-                // based on prior knowledge about the nets.
-                double timing_net_w = ap_timing_tradeoff_ * net_weights_[net_id] * timing_slope_fac_ * (1.0 + crit);
-
-                add_connection_to_system(driver_blk, sink_blk,
-                                         2 /*num_pins*/, timing_net_w * d_delay_x * delay_x_norm,
-                                         p_placement.block_x_locs, triplet_list_x, b_x);
-
-                add_connection_to_system(driver_blk, sink_blk,
-                                         2 /*num_pins*/, timing_net_w * d_delay_y * delay_y_norm,
-                                         p_placement.block_y_locs, triplet_list_y, b_y);
-            }
+    // Build the connections of the nets in parts of consecutive nets. Each
+    // part is independent of the others, so they can be built in parallel.
+    size_t num_nets = netlist_.nets().size();
+    size_t num_parts = (num_nets + num_nets_per_linear_system_part_ - 1) / num_nets_per_linear_system_part_;
+    // NOTE: The parts and triplet lists are kept between calls, so their
+    //       memory is reused by every system built by this solver.
+    std::vector<LinearSystemPart>& system_parts = linear_system_parts_;
+    system_parts.resize(num_parts);
+    auto build_system_part = [&](size_t part_idx) {
+        LinearSystemPart& system_part = system_parts[part_idx];
+        system_part.triplet_list_x.clear();
+        system_part.triplet_list_y.clear();
+        system_part.b_entries_x.clear();
+        system_part.b_entries_y.clear();
+        size_t first_net_idx = part_idx * num_nets_per_linear_system_part_;
+        size_t last_net_idx = std::min(first_net_idx + num_nets_per_linear_system_part_, num_nets);
+        for (size_t net_idx = first_net_idx; net_idx < last_net_idx; net_idx++) {
+            APNetId net_id = *(netlist_.nets().begin() + net_idx);
+            add_net_to_linear_system(net_id, p_placement, iteration, system_part);
         }
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num_parts, build_system_part);
+#else
+    for (size_t part_idx = 0; part_idx < num_parts; part_idx++)
+        build_system_part(part_idx);
+#endif
+
+    // Merge the parts in order. This adds up the entries at the same positions
+    // in the same order regardless of how the parts were built.
+    size_t num_triplets_x = 0;
+    size_t num_triplets_y = 0;
+    for (const LinearSystemPart& system_part : system_parts) {
+        num_triplets_x += system_part.triplet_list_x.size();
+        num_triplets_y += system_part.triplet_list_y.size();
     }
+    // Leave room for the anchors.
+    if (iteration != 0) {
+        num_triplets_x += num_moveable_blocks_;
+        num_triplets_y += num_moveable_blocks_;
+    }
+    triplet_list_x_.clear();
+    triplet_list_x_.reserve(num_triplets_x);
+    triplet_list_y_.clear();
+    triplet_list_y_.reserve(num_triplets_y);
+    for (const LinearSystemPart& system_part : system_parts) {
+        triplet_list_x_.insert(triplet_list_x_.end(), system_part.triplet_list_x.begin(), system_part.triplet_list_x.end());
+        triplet_list_y_.insert(triplet_list_y_.end(), system_part.triplet_list_y.begin(), system_part.triplet_list_y.end());
+        for (const auto& [row_id, value] : system_part.b_entries_x)
+            b_x(row_id) += value;
+        for (const auto& [row_id, value] : system_part.b_entries_y)
+            b_y(row_id) += value;
+    }
+
+    // Add the anchor points. These are added as triplets as well, which adds
+    // them onto the diagonal while the matrices are built instead of looking
+    // up (or inserting) the diagonal entries afterwards.
+    if (iteration != 0)
+        update_linear_system_with_anchors(iteration);
 
     // Build the sparse connectivity matrices from the triplets.
-    A_sparse_x.setFromTriplets(triplet_list_x.begin(), triplet_list_x.end());
-    A_sparse_y.setFromTriplets(triplet_list_y.begin(), triplet_list_y.end());
+    A_sparse_x.setFromTriplets(triplet_list_x_.begin(), triplet_list_x_.end());
+    A_sparse_y.setFromTriplets(triplet_list_y_.begin(), triplet_list_y_.end());
 }
 
 // This function adds anchors for legalized solution. Anchors are treated as fixed node,
@@ -1219,8 +1327,8 @@ void B2BSolver::update_linear_system_with_anchors(unsigned iteration) {
         APBlockId blk_id = row_id_to_blk_id_[row_id];
         double pseudo_w_x = coeff_pseudo_anchor * 2.0;
         double pseudo_w_y = coeff_pseudo_anchor * 2.0;
-        A_sparse_x.coeffRef(row_id_idx, row_id_idx) += pseudo_w_x;
-        A_sparse_y.coeffRef(row_id_idx, row_id_idx) += pseudo_w_y;
+        triplet_list_x_.emplace_back(row_id_idx, row_id_idx, pseudo_w_x);
+        triplet_list_y_.emplace_back(row_id_idx, row_id_idx, pseudo_w_y);
         b_x(row_id_idx) += pseudo_w_x * block_x_locs_legalized[blk_id];
         b_y(row_id_idx) += pseudo_w_y * block_y_locs_legalized[blk_id];
     }
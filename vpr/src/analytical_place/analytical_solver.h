@@ -8,6 +8,8 @@
  */
 
 #include <memory>
+#include <utility>
+#include <vector>
 #include "ap_flow_enums.h"
 #include "ap_netlist.h"
 #include "device_grid.h"
@@ -313,6 +315,8 @@ class QPHybridSolver : public AnalyticalSolver {
      *
      * This is basically a fast way of adding a connection between all moveable
      * blocks in the netlist and their target fixed placement location.
+     * The diagonal entries are updated in place (see diag_value_indices_),
+     * so the coefficient matrix must have the sparsity pattern of A_sparse.
      *
      * See add_connection_to_system.
      *
@@ -354,11 +358,26 @@ class QPHybridSolver : public AnalyticalSolver {
     Eigen::VectorXd b_x;
     /// @brief The constant vector in the y dimension for the linear system.
     Eigen::VectorXd b_y;
+    /// @brief The position of the diagonal entry of each moveable block (by
+    ///        row) in the value array of A_sparse (and A_sparse_anchored_).
+    std::vector<Eigen::Index> diag_value_indices_;
     /// @brief The number of variables in the solver. This is the sum of the
     ///        number of moveable blocks in the netlist and the number of star
     ///        nodes that exist.
     size_t num_variables_ = 0;
 
+    // The following variables hold the linear system with the anchor-points
+    // of the current iteration. The coefficient matrix has the sparsity
+    // pattern of A_sparse (with all diagonal entries present), so it is only
+    // allocated once and its values are updated in place each iteration.
+
+    /// @brief The coefficient matrix for the anchored linear system.
+    Eigen::SparseMatrix<double> A_sparse_anchored_;
+    /// @brief The constant vector in the x dimension for the anchored system.
+    Eigen::VectorXd b_x_anchored_;
+    /// @brief The constant vector in the y dimension for the anchored system.
+    Eigen::VectorXd b_y_anchored_;
+
     /// @brief The current guess for the x positions of the blocks.
     Eigen::VectorXd guess_x;
     /// @brief The current guess for the y positions of the blocks.
@@ -511,6 +530,25 @@ class B2BSolver : public AnalyticalSolver {
     // TODO: Should this be a proportion of the design size?
     static constexpr unsigned max_cg_iterations_ = 100;
 
+    /// @brief The number of nets whose connections are built together as one
+    ///        part of the linear system. The parts are built in parallel (if
+    ///        VPR is built with TBB) and then merged in order, so the linear
+    ///        system does not depend on the number of threads.
+    static constexpr size_t num_nets_per_linear_system_part_ = 1024;
+
+    /**
+     * @brief The connections added to the linear systems by some of the nets.
+     *
+     * The constant vector entries are stored as (row, value) pairs which are
+     * accumulated into the constant vectors when the parts are merged.
+     */
+    struct LinearSystemPart {
+        std::vector<Eigen::Triplet<double>> triplet_list_x;
+        std::vector<Eigen::Triplet<double>> triplet_list_y;
+        std::vector<std::pair<size_t, double>> b_entries_x;
+        std::vector<std::pair<size_t, double>> b_entries_y;
+    };
+
     // The following constants are used to configure the anchor weighting.
     // The weights of anchors grow exponentially each iteration by the following
     // function:
@@ -635,8 +673,8 @@ class B2BSolver : public AnalyticalSolver {
      *  @param triplet_list
      *      The triplet list which will be used to construct the connectivity
      *      matrix for this dimension.
-     *  @param b
-     *      The constant vector for this dimension.
+     *  @param b_entries
+     *      The entries of the constant vector for this dimension.
      */
     void add_connection_to_system(APBlockId first_blk_id,
                                   APBlockId second_blk_id,
@@ -644,7 +682,19 @@ class B2BSolver : public AnalyticalSolver {
                                   double net_w,
                                   const vtr::vector<APBlockId, double>& blk_locs,
                                   std::vector<Eigen::Triplet<double>>& triplet_list,
-                                  Eigen::VectorXd& b);
+                                  std::vector<std::pair<size_t, double>>& b_entries);
+
+    /**
+     * @brief Add the wirelength and timing connections of the given net to
+     *        the given part of the linear system.
+     *
+     * This only reads the state of the solver, so it may be called on
+     * different nets concurrently.
+     */
+    void add_net_to_linear_system(APNetId net_id,
+                                  const PartialPlacement& p_placement,
+                                  unsigned iteration,
+                                  LinearSystemPart& system_part);
 
     /**
      * @brief Get the instantaneous derivative of delay for the given driver
@@ -688,13 +738,18 @@ class B2BSolver : public AnalyticalSolver {
      * approximates a linear equation.
      *
      * This will set the connectivity matrices (A) and constant vectors (b) to
-     * be solved by B2B.
+     * be solved by B2B, including the anchor-blocks if the iteration is not
+     * the first. The nets are added in parts, which are built in parallel if
+     * VPR is built with TBB.
      */
     void init_linear_system(PartialPlacement& p_placement, unsigned iteration);
 
     /**
      * @brief Updates the linear system with anchor-blocks from the legalized
      *        solution.
+     *
+     * The anchors are added to the triplet lists, so this must be called
+     * before the connectivity matrices are built from them.
      */
     void update_linear_system_with_anchors(unsigned iteration);
 
@@ -725,6 +780,17 @@ class B2BSolver : public AnalyticalSolver {
     /// @brief The constant vector in the y dimension.
     Eigen::VectorXd b_y;
 
+    // The following hold the entries of the linear systems while they are
+    // built. They are kept between the bound updates and the iterations so
+    // that their memory is reused; the systems are rebuilt quite often.
+
+    /// @brief The parts of the linear system built by init_linear_system.
+    std::vector<LinearSystemPart> linear_system_parts_;
+    /// @brief The entries of the connectivity matrix for the x dimension.
+    std::vector<Eigen::Triplet<double>> triplet_list_x_;
+    /// @brief The entries of the connectivity matrix for the y dimension.
+    std::vector<Eigen::Triplet<double>> triplet_list_y_;
+
     // The following is the solution of the previous iteration of this solver.
     // They are updated at the end of solve() and are used as the starting point
     // for the next call to solve.
@@ -6,6 +6,17 @@
  * @brief   Enumerations used by the Analytical Placement Flow.
  */
 
+/**
+ * @brief The type of a Global Placer.
+ *
+ * The Global Placer creates the flat placement of the AP netlist. This enum can
+ * select between the different Global Placers.
+ */
+enum class e_ap_global_placer {
+    SimPL,        ///< Global Placer which iterates between an analytical solver (lower-bound) and a partial legalizer (upper-bound).
+    Electrostatic ///< Global Placer which spreads blocks with an electrostatic density penalty (ePlace), optimized with Nesterov's method.
+};
+
 /**
  * @brief The type of an Analytical Solver.
  *
@@ -52,5 +63,6 @@ enum class e_ap_full_legalizer {
  */
 enum class e_ap_detailed_placer {
     Identity, ///< The Identity Detailed Placer, which does not perform any optimizations on the legalized placement. Needed as a placeholder.
-    Annealer  ///< The Annealer Detailed Placer, which runs the annealer found in the Place part of the VPR flow (using the same options as the Placement stage).
+    Annealer,      ///< The Annealer Detailed Placer, which runs the annealer found in the Place part of the VPR flow (using the same options as the Placement stage).
+    RefineAnnealer ///< The Annealer Detailed Placer tuned to refine a good AP placement: starts at a low temperature and anneals non-overlapping regions of the device in parallel.
 };
@@ -0,0 +1,502 @@
+/**
+ * @file
+ * @brief   CUDA implementation of the electrostatic global placer kernels.
+ *
+ * Double precision atomicAdd requires a device of compute capability 6.0 or
+ * newer.
+ */
+
+#include "ap_gpu_kernels.h"
+
+#include <cmath>
+#include <utility>
+#include <cuda_runtime.h>
+#include "vpr_error.h"
+#include "vtr_assert.h"
+
+namespace {
+
+/// @brief The number of threads of each block of the 1D kernels.
+constexpr int THREADS_PER_BLOCK = 256;
+
+/// @brief The width (and height) of the thread blocks of the 2D kernels.
+constexpr int TILE_DIM = 16;
+
+/**
+ * @brief Errors out if the given CUDA call failed.
+ */
+void check_cuda(cudaError_t status, const char* what) {
+    if (status != cudaSuccess) {
+        VPR_FATAL_ERROR(VPR_ERROR_AP,
+                        "CUDA error in %s: %s\n",
+                        what, cudaGetErrorString(status));
+    }
+}
+
+unsigned num_blocks_for(size_t num_threads) {
+    return static_cast<unsigned>((num_threads + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK);
+}
+
+dim3 grid_for(size_t rows, size_t cols) {
+    return dim3(static_cast<unsigned>((cols + TILE_DIM - 1) / TILE_DIM),
+                static_cast<unsigned>((rows + TILE_DIM - 1) / TILE_DIM));
+}
+
+/**
+ * @brief An array in device memory.
+ */
+template<typename T>
+class DeviceArray {
+  public:
+    DeviceArray() = default;
+
+    explicit DeviceArray(size_t size)
+        : size_(size) {
+        if (size_ > 0)
+            check_cuda(cudaMalloc(&ptr_, size_ * sizeof(T)), "cudaMalloc");
+    }
+
+    explicit DeviceArray(const std::vector<T>& host)
+        : DeviceArray(host.size()) {
+        upload(host.data());
+    }
+
+    ~DeviceArray() {
+        if (ptr_)
+            cudaFree(ptr_);
+    }
+
+    DeviceArray(const DeviceArray&) = delete;
+    DeviceArray& operator=(const DeviceArray&) = delete;
+
+    DeviceArray(DeviceArray&& other) noexcept
+        : ptr_(other.ptr_)
+        , size_(other.size_) {
+        other.ptr_ = nullptr;
+        other.size_ = 0;
+    }
+
+    DeviceArray& operator=(DeviceArray&& other) noexcept {
+        std::swap(ptr_, other.ptr_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    void upload(const T* host) {
+        if (size_ > 0)
+            check_cuda(cudaMemcpy(ptr_, host, size_ * sizeof(T), cudaMemcpyHostToDevice), "cudaMemcpy (to device)");
+    }
+
+    void download(T* host) const {
+        if (size_ > 0)
+            check_cuda(cudaMemcpy(host, ptr_, size_ * sizeof(T), cudaMemcpyDeviceToHost), "cudaMemcpy (to host)");
+    }
+
+    void zero() {
+        if (size_ > 0)
+            check_cuda(cudaMemset(ptr_, 0, size_ * sizeof(T)), "cudaMemset");
+    }
+
+    T* get() { return ptr_; }
+    const T* get() const { return ptr_; }
+    size_t size() const { return size_; }
+
+  private:
+    T* ptr_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Builds the table of cos(w * c) (or sin) for every frequency w (row)
+ *        and bin center c (column) of a dimension with num_bins bins.
+ */
+std::vector<double> make_basis_table(size_t num_bins, bool is_sine) {
+    std::vector<double> table(num_bins * num_bins);
+    for (size_t freq = 0; freq < num_bins; freq++) {
+        double w = M_PI * static_cast<double>(freq) / static_cast<double>(num_bins);
+        for (size_t bin = 0; bin < num_bins; bin++) {
+            double arg = w * (static_cast<double>(bin) + 0.5);
+            table[freq * num_bins + bin] = is_sine ? std::sin(arg) : std::cos(arg);
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Computes the WA wirelength gradient of every pin of a net (one
+ *        thread per net) and adds it to the gradient of the pin's block.
+ *
+ * See compute_net_wa_gradient in global_placer.cpp for the CPU version.
+ */
+__global__ void wa_gradient_kernel(int num_nets,
+                                   const int* net_pin_offsets,
+                                   const int* pin_blocks,
+                                   const double* net_weights,
+                                   const double* blk_locs,
+                                   double gamma,
+                                   double* blk_grad) {
+    int net = blockIdx.x * blockDim.x + threadIdx.x;
+    if (net >= num_nets)
+        return;
+    int begin = net_pin_offsets[net];
+    int end = net_pin_offsets[net + 1];
+    if (end - begin < 2)
+        return;
+
+    double max_loc = -INFINITY;
+    double min_loc = INFINITY;
+    for (int pin = begin; pin < end; pin++) {
+        double loc = blk_locs[pin_blocks[pin]];
+        max_loc = fmax(max_loc, loc);
+        min_loc = fmin(min_loc, loc);
+    }
+
+    double sum_max_exp = 0.0, sum_max_exp_loc = 0.0;
+    double sum_min_exp = 0.0, sum_min_exp_loc = 0.0;
+    for (int pin = begin; pin < end; pin++) {
+        double loc = blk_locs[pin_blocks[pin]];
+        double max_exp = exp((loc - max_loc) / gamma);
+        double min_exp = exp((min_loc - loc) / gamma);
+        sum_max_exp += max_exp;
+        sum_max_exp_loc += loc * max_exp;
+        sum_min_exp += min_exp;
+        sum_min_exp_loc += loc * min_exp;
+    }
+    double wa_max = sum_max_exp_loc / sum_max_exp;
+    double wa_min = sum_min_exp_loc / sum_min_exp;
+
+    double net_weight = net_weights[net];
+    for (int pin = begin; pin < end; pin++) {
+        int blk = pin_blocks[pin];
+        double loc = blk_locs[blk];
+        double max_exp = exp((loc - max_loc) / gamma);
+        double min_exp = exp((min_loc - loc) / gamma);
+        double max_grad = max_exp * (1.0 + (loc - wa_max) / gamma) / sum_max_exp;
+        double min_grad = min_exp * (1.0 - (loc - wa_min) / gamma) / sum_min_exp;
+        atomicAdd(&blk_grad[blk], net_weight * (max_grad - min_grad));
+    }
+}
+
+/**
+ * @brief Zeroes the gradients of the fixed blocks.
+ */
+__global__ void mask_fixed_kernel(int num_blocks,
+                                  const char* block_is_moveable,
+                                  double* grad_x,
+                                  double* grad_y) {
+    int blk = blockIdx.x * blockDim.x + threadIdx.x;
+    if (blk >= num_blocks || block_is_moveable[blk])
+        return;
+    grad_x[blk] = 0.0;
+    grad_y[blk] = 0.0;
+}
+
+/**
+ * @brief The (up to) four unit bins whose centers surround a location, and
+ *        their bilinear interpolation weights.
+ *
+ * Matches for_each_bilinear_bin in global_placer.cpp.
+ */
+struct BilinearBins {
+    int x, y, next_x, next_y;
+    double frac_x, frac_y;
+};
+
+__device__ BilinearBins get_bilinear_bins(double loc_x, double loc_y, int width, int height) {
+    BilinearBins bins;
+    double offset_x = fmin(fmax(loc_x - 0.5, 0.0), static_cast<double>(width - 1));
+    double offset_y = fmin(fmax(loc_y - 0.5, 0.0), static_cast<double>(height - 1));
+    bins.x = min(static_cast<int>(offset_x), width - 1);
+    bins.y = min(static_cast<int>(offset_y), height - 1);
+    bins.next_x = min(bins.x + 1, width - 1);
+    bins.next_y = min(bins.y + 1, height - 1);
+    bins.frac_x = offset_x - static_cast<double>(bins.x);
+    bins.frac_y = offset_y - static_cast<double>(bins.y);
+    return bins;
+}
+
+/**
+ * @brief Spreads the charge of each block (one thread per block) over the
+ *        bins around it.
+ */
+__global__ void splat_kernel(int num_blocks,
+                             const double* blk_x,
+                             const double* blk_y,
+                             const double* charges,
+                             int width,
+                             int height,
+                             double* density) {
+    int blk = blockIdx.x * blockDim.x + threadIdx.x;
+    if (blk >= num_blocks)
+        return;
+    double charge = charges[blk];
+    if (charge == 0.0)
+        return;
+    BilinearBins b = get_bilinear_bins(blk_x[blk], blk_y[blk], width, height);
+    atomicAdd(&density[b.x * height + b.y], (1.0 - b.frac_x) * (1.0 - b.frac_y) * charge);
+    atomicAdd(&density[b.next_x * height + b.y], b.frac_x * (1.0 - b.frac_y) * charge);
+    atomicAdd(&density[b.x * height + b.next_y], (1.0 - b.frac_x) * b.frac_y * charge);
+    atomicAdd(&density[b.next_x * height + b.next_y], b.frac_x * b.frac_y * charge);
+}
+
+/**
+ * @brief Computes out(i, j) = SUM_k(A(i, k) * B(k, j)) for row-major matrices,
+ *        where A (I x K) and B (K x J) may be given transposed.
+ */
+__global__ void matmul_kernel(const double* a,
+                              bool trans_a,
+                              const double* b,
+                              bool trans_b,
+                              int num_i,
+                              int num_k,
+                              int num_j,
+                              double* out) {
+    int i = blockIdx.y * blockDim.y + threadIdx.y;
+    int j = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= num_i || j >= num_j)
+        return;
+    double sum = 0.0;
+    for (int k = 0; k < num_k; k++) {
+        double a_ik = trans_a ? a[k * num_i + i] : a[i * num_k + k];
+        double b_kj = trans_b ? b[j * num_k + k] : b[k * num_j + j];
+        sum += a_ik * b_kj;
+    }
+    out[i * num_j + j] = sum;
+}
+
+/**
+ * @brief Computes the cosine coefficients of the field from the (unscaled)
+ *        cosine coefficients of the density.
+ */
+__global__ void field_coeffs_kernel(const double* density_coeffs,
+                                    int width,
+                                    int height,
+                                    double* field_x_coeffs,
+                                    double* field_y_coeffs) {
+    int u = blockIdx.y * blockDim.y + threadIdx.y;
+    int v = blockIdx.x * blockDim.x + threadIdx.x;
+    if (u >= width || v >= height)
+        return;
+    int idx = u * height + v;
+    // The average density has no potential.
+    if (u == 0 && v == 0) {
+        field_x_coeffs[idx] = 0.0;
+        field_y_coeffs[idx] = 0.0;
+        return;
+    }
+    double norm = 1.0 / (static_cast<double>(width) * static_cast<double>(height));
+    double c_u = (u == 0) ? 1.0 : 2.0;
+    double c_v = (v == 0) ? 1.0 : 2.0;
+    double coeff = density_coeffs[idx] * c_u * c_v * norm;
+    double w_u = M_PI * static_cast<double>(u) / static_cast<double>(width);
+    double w_v = M_PI * static_cast<double>(v) / static_cast<double>(height);
+    double inv_w2 = 1.0 / (w_u * w_u + w_v * w_v);
+    field_x_coeffs[idx] = coeff * w_u * inv_w2;
+    field_y_coeffs[idx] = coeff * w_v * inv_w2;
+}
+
+/**
+ * @brief Computes the gradient of the potential energy of each block (one
+ *        thread per block): its charge times the negative of the field,
+ *        interpolated at its location.
+ */
+__global__ void interpolate_field_kernel(int num_blocks,
+                                         const double* blk_x,
+                                         const double* blk_y,
+                                         const double* charges,
+                                         const double* field_x,
+                                         const double* field_y,
+                                         int width,
+                                         int height,
+                                         double* grad_x,
+                                         double* grad_y) {
+    int blk = blockIdx.x * blockDim.x + threadIdx.x;
+    if (blk >= num_blocks)
+        return;
+    double charge = charges[blk];
+    if (charge == 0.0) {
+        grad_x[blk] = 0.0;
+        grad_y[blk] = 0.0;
+        return;
+    }
+    BilinearBins b = get_bilinear_bins(blk_x[blk], blk_y[blk], width, height);
+    int bins[4] = {b.x * height + b.y,
+                   b.next_x * height + b.y,
+                   b.x * height + b.next_y,
+                   b.next_x * height + b.next_y};
+    double weights[4] = {(1.0 - b.frac_x) * (1.0 - b.frac_y),
+                         b.frac_x * (1.0 - b.frac_y),
+                         (1.0 - b.frac_x) * b.frac_y,
+                         b.frac_x * b.frac_y};
+    double blk_field_x = 0.0;
+    double blk_field_y = 0.0;
+    for (int i = 0; i < 4; i++) {
+        blk_field_x += weights[i] * field_x[bins[i]];
+        blk_field_y += weights[i] * field_y[bins[i]];
+    }
+    grad_x[blk] = -charge * blk_field_x;
+    grad_y[blk] = -charge * blk_field_y;
+}
+
+} // namespace
+
+struct APGpuKernels::DeviceData {
+    int num_nets = 0;
+    int num_blocks = 0;
+    int width = 0;
+    int height = 0;
+
+    // The netlist.
+    DeviceArray<int> net_pin_offsets;
+    DeviceArray<int> pin_blocks;
+    DeviceArray<double> net_weights;
+    DeviceArray<double> block_charges;
+    DeviceArray<char> block_is_moveable;
+
+    // The block locations and gradients.
+    DeviceArray<double> blk_x;
+    DeviceArray<double> blk_y;
+    DeviceArray<double> grad_x;
+    DeviceArray<double> grad_y;
+
+    // The basis tables of the transforms, indexed [frequency][bin].
+    DeviceArray<double> cos_x;
+    DeviceArray<double> sin_x;
+    DeviceArray<double> cos_y;
+    DeviceArray<double> sin_y;
+
+    // The bin grids, indexed [x][y] (or [u][v] for the coefficients).
+    DeviceArray<double> density;
+    DeviceArray<double> partial;
+    DeviceArray<double> density_coeffs;
+    DeviceArray<double> field_x_coeffs;
+    DeviceArray<double> field_y_coeffs;
+    DeviceArray<double> field_x;
+    DeviceArray<double> field_y;
+
+    /// @brief Launches out = A * B on the bin grids.
+    void matmul(const DeviceArray<double>& a, bool trans_a,
+                const DeviceArray<double>& b, bool trans_b,
+                int num_i, int num_k, int num_j,
+                DeviceArray<double>& out) {
+        matmul_kernel<<<grid_for(num_i, num_j), dim3(TILE_DIM, TILE_DIM)>>>(
+            a.get(), trans_a, b.get(), trans_b, num_i, num_k, num_j, out.get());
+        check_cuda(cudaGetLastError(), "matmul_kernel");
+    }
+};
+
+APGpuKernels::APGpuKernels(const std::vector<int>& net_pin_offsets,
+                           const std::vector<int>& pin_blocks,
+                           const std::vector<double>& block_charges,
+                           const std::vector<char>& block_is_moveable,
+                           size_t grid_width,
+                           size_t grid_height)
+    : data_(std::make_unique<DeviceData>()) {
+    VTR_ASSERT(!net_pin_offsets.empty());
+    VTR_ASSERT(block_charges.size() == block_is_moveable.size());
+    VTR_ASSERT(grid_width > 0 && grid_height > 0);
+
+    DeviceData& d = *data_;
+    d.num_nets = static_cast<int>(net_pin_offsets.size() - 1);
+    d.num_blocks = static_cast<int>(block_charges.size());
+    d.width = static_cast<int>(grid_width);
+    d.height = static_cast<int>(grid_height);
+
+    d.net_pin_offsets = DeviceArray<int>(net_pin_offsets);
+    d.pin_blocks = DeviceArray<int>(pin_blocks);
+    d.net_weights = DeviceArray<double>(d.num_nets);
+    d.block_charges = DeviceArray<double>(block_charges);
+    d.block_is_moveable = DeviceArray<char>(block_is_moveable);
+
+    d.blk_x = DeviceArray<double>(d.num_blocks);
+    d.blk_y = DeviceArray<double>(d.num_blocks);
+    d.grad_x = DeviceArray<double>(d.num_blocks);
+    d.grad_y = DeviceArray<double>(d.num_blocks);
+
+    d.cos_x = DeviceArray<double>(make_basis_table(grid_width, false));
+    d.sin_x = DeviceArray<double>(make_basis_table(grid_width, true));
+    d.cos_y = DeviceArray<double>(make_basis_table(grid_height, false));
+    d.sin_y = DeviceArray<double>(make_basis_table(grid_height, true));
+
+    size_t num_bins = grid_width * grid_height;
+    d.density = DeviceArray<double>(num_bins);
+    d.partial = DeviceArray<double>(num_bins);
+    d.density_coeffs = DeviceArray<double>(num_bins);
+    d.field_x_coeffs = DeviceArray<double>(num_bins);
+    d.field_y_coeffs = DeviceArray<double>(num_bins);
+    d.field_x = DeviceArray<double>(num_bins);
+    d.field_y = DeviceArray<double>(num_bins);
+}
+
+APGpuKernels::~APGpuKernels() = default;
+
+void APGpuKernels::set_block_locs(const double* block_x_locs, const double* block_y_locs) {
+    data_->blk_x.upload(block_x_locs);
+    data_->blk_y.upload(block_y_locs);
+}
+
+void APGpuKernels::compute_wirelength_gradient(const double* net_weights,
+                                               double gamma,
+                                               double* grad_x,
+                                               double* grad_y) {
+    DeviceData& d = *data_;
+    d.net_weights.upload(net_weights);
+    d.grad_x.zero();
+    d.grad_y.zero();
+
+    unsigned net_blocks = num_blocks_for(d.num_nets);
+    wa_gradient_kernel<<<net_blocks, THREADS_PER_BLOCK>>>(d.num_nets, d.net_pin_offsets.get(), d.pin_blocks.get(),
+                                                         d.net_weights.get(), d.blk_x.get(), gamma, d.grad_x.get());
+    check_cuda(cudaGetLastError(), "wa_gradient_kernel (x)");
+    wa_gradient_kernel<<<net_blocks, THREADS_PER_BLOCK>>>(d.num_nets, d.net_pin_offsets.get(), d.pin_blocks.get(),
+                                                         d.net_weights.get(), d.blk_y.get(), gamma, d.grad_y.get());
+    check_cuda(cudaGetLastError(), "wa_gradient_kernel (y)");
+    mask_fixed_kernel<<<num_blocks_for(d.num_blocks), THREADS_PER_BLOCK>>>(d.num_blocks, d.block_is_moveable.get(),
+                                                                          d.grad_x.get(), d.grad_y.get());
+    check_cuda(cudaGetLastError(), "mask_fixed_kernel");
+
+    d.grad_x.download(grad_x);
+    d.grad_y.download(grad_y);
+}
+
+void APGpuKernels::compute_bin_density(double* density) {
+    DeviceData& d = *data_;
+    d.density.zero();
+    splat_kernel<<<num_blocks_for(d.num_blocks), THREADS_PER_BLOCK>>>(d.num_blocks, d.blk_x.get(), d.blk_y.get(),
+                                                                     d.block_charges.get(), d.width, d.height,
+                                                                     d.density.get());
+    check_cuda(cudaGetLastError(), "splat_kernel");
+    d.density.download(density);
+}
+
+void APGpuKernels::compute_density_gradient(const double* density,
+                                            double* grad_x,
+                                            double* grad_y) {
+    DeviceData& d = *data_;
+    const int w = d.width;
+    const int h = d.height;
+    d.density.upload(density);
+
+    // Forward transform: partial[u][y] = SUM_x(cos_x[u][x] * density[x][y]),
+    // then density_coeffs[u][v] = SUM_y(partial[u][y] * cos_y[v][y]).
+    d.matmul(d.cos_x, false, d.density, false, w, w, h, d.partial);
+    d.matmul(d.partial, false, d.cos_y, true, w, h, h, d.density_coeffs);
+
+    field_coeffs_kernel<<<grid_for(w, h), dim3(TILE_DIM, TILE_DIM)>>>(d.density_coeffs.get(), w, h,
+                                                                      d.field_x_coeffs.get(), d.field_y_coeffs.get());
+    check_cuda(cudaGetLastError(), "field_coeffs_kernel");
+
+    // Inverse transforms: out[x][y] = SUM_uv(coeffs[u][v] * basis_x[u][x] * basis_y[v][y]).
+    d.matmul(d.sin_x, true, d.field_x_coeffs, false, w, w, h, d.partial);
+    d.matmul(d.partial, false, d.cos_y, false, w, h, h, d.field_x);
+    d.matmul(d.cos_x, true, d.field_y_coeffs, false, w, w, h, d.partial);
+    d.matmul(d.partial, false, d.sin_y, false, w, h, h, d.field_y);
+
+    interpolate_field_kernel<<<num_blocks_for(d.num_blocks), THREADS_PER_BLOCK>>>(
+        d.num_blocks, d.blk_x.get(), d.blk_y.get(), d.block_charges.get(),
+        d.field_x.get(), d.field_y.get(), w, h, d.grad_x.get(), d.grad_y.get());
+    check_cuda(cudaGetLastError(), "interpolate_field_kernel");
+
+    d.grad_x.download(grad_x);
+    d.grad_y.download(grad_y);
+}
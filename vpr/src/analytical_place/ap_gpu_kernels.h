@@ -0,0 +1,104 @@
+#pragma once
+/**
+ * @file
+ * @brief   GPU (CUDA) implementations of the hot kernels of the electrostatic
+ *          global placer.
+ *
+ * These kernels are only built when VPR is configured with -DVPR_USE_CUDA=ON,
+ * in which case VPR_USE_CUDA is defined. Otherwise the CPU implementations in
+ * global_placer.cpp and electrostatic_field.cpp are used.
+ *
+ * The netlist and the bin grid are uploaded to the GPU once, when the kernels
+ * are constructed. Every iteration, only the block locations are uploaded, and
+ * only the (small) bin grids and the block gradients are copied back.
+ */
+
+#ifdef VPR_USE_CUDA
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief The electrostatic global placer kernels, run on a CUDA device.
+ *
+ * All arrays are indexed by the (compressed) ids of the AP netlist, and the
+ * bin grids are stored row-major, indexed [x][y] (the layout of
+ * vtr::NdMatrix<double, 2>).
+ */
+class APGpuKernels {
+  public:
+    /**
+     * @brief Upload the netlist and build the bin grid on the GPU.
+     *
+     *  @param net_pin_offsets  The pins of net i are the pins in
+     *                          [net_pin_offsets[i], net_pin_offsets[i + 1]).
+     *                          Ignored nets have no pins.
+     *  @param pin_blocks       The block of each of these pins.
+     *  @param block_charges    The charge of each block (zero for fixed
+     *                          blocks).
+     *  @param block_is_moveable
+     *                          Non-zero for the moveable blocks, whose
+     *                          gradients are computed.
+     *  @param grid_width       The number of unit bins in the x dimension.
+     *  @param grid_height      The number of unit bins in the y dimension.
+     */
+    APGpuKernels(const std::vector<int>& net_pin_offsets,
+                 const std::vector<int>& pin_blocks,
+                 const std::vector<double>& block_charges,
+                 const std::vector<char>& block_is_moveable,
+                 size_t grid_width,
+                 size_t grid_height);
+
+    ~APGpuKernels();
+
+    APGpuKernels(const APGpuKernels&) = delete;
+    APGpuKernels& operator=(const APGpuKernels&) = delete;
+
+    /**
+     * @brief Upload the locations of the blocks used by the next kernels.
+     */
+    void set_block_locs(const double* block_x_locs, const double* block_y_locs);
+
+    /**
+     * @brief Compute the gradient of the weighted WA wirelength of the nets
+     *        with respect to the location of each block.
+     *
+     *  @param net_weights  The weight of each net.
+     *  @param gamma        The smoothing parameter of the WA model.
+     *  @param grad_x       Output gradient of each block in x.
+     *  @param grad_y       Output gradient of each block in y.
+     */
+    void compute_wirelength_gradient(const double* net_weights,
+                                     double gamma,
+                                     double* grad_x,
+                                     double* grad_y);
+
+    /**
+     * @brief Spread the charge of each block over the (up to) four bins
+     *        around it, using bilinear interpolation.
+     *
+     *  @param density  Output charge of each bin.
+     */
+    void compute_bin_density(double* density);
+
+    /**
+     * @brief Solve the electric field of the given charge density (see
+     *        ElectrostaticFieldSolver) and compute the gradient of the
+     *        potential energy of each block in it.
+     *
+     *  @param density  The charge density of each bin.
+     *  @param grad_x   Output gradient of each block in x.
+     *  @param grad_y   Output gradient of each block in y.
+     */
+    void compute_density_gradient(const double* density,
+                                  double* grad_x,
+                                  double* grad_y);
+
+  private:
+    /// @brief The device buffers, defined in the CUDA translation unit.
+    struct DeviceData;
+    std::unique_ptr<DeviceData> data_;
+};
+
+#endif /* VPR_USE_CUDA */
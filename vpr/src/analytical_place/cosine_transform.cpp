@@ -0,0 +1,216 @@
+/**
+ * @file
+ * @brief   Implementation of the fast cosine and sine transforms.
+ */
+
+#include "cosine_transform.h"
+#include <cmath>
+#include <utility>
+#include "vtr_assert.h"
+
+/**
+ * @brief The product of two complex numbers, without the checks for infinite
+ *        and NaN parts of std::complex's operator* (which is not inlined).
+ */
+static inline std::complex<double> mul(const std::complex<double>& a, const std::complex<double>& b) {
+    return {a.real() * b.real() - a.imag() * b.imag(),
+            a.real() * b.imag() + a.imag() * b.real()};
+}
+
+CosineTransform::CosineTransform(size_t size)
+    : size_(size) {
+    VTR_ASSERT(size > 0);
+
+    bool is_power_of_two = (size_ & (size_ - 1)) == 0;
+    if (!is_power_of_two && size_ <= MAX_DIRECT_SIZE) {
+        cos_table_.resize(size_ * size_);
+        for (size_t k = 0; k < size_; k++) {
+            double w = M_PI * static_cast<double>(k) / static_cast<double>(size_);
+            for (size_t n = 0; n < size_; n++)
+                cos_table_[k * size_ + n] = std::cos(w * (static_cast<double>(n) + 0.5));
+        }
+        return;
+    }
+
+    shift_.resize(size_);
+    for (size_t k = 0; k < size_; k++) {
+        shift_[k] = std::polar(1.0, -M_PI * static_cast<double>(k) / static_cast<double>(2 * size_));
+    }
+
+    fft_size_ = 1;
+    while (fft_size_ < (is_power_of_two ? size_ : 2 * size_ - 1))
+        fft_size_ <<= 1;
+
+    twiddles_.resize(fft_size_ / 2);
+    for (size_t k = 0; k < twiddles_.size(); k++) {
+        twiddles_[k] = std::polar(1.0, -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(fft_size_));
+    }
+
+    if (is_power_of_two)
+        return;
+
+    // n^2 is reduced modulo 2N, so the angle stays accurate for large n.
+    chirp_.resize(size_);
+    for (size_t n = 0; n < size_; n++) {
+        size_t n2 = (n * n) % (2 * size_);
+        chirp_[n] = std::polar(1.0, -M_PI * static_cast<double>(n2) / static_cast<double>(size_));
+    }
+    chirp_filter_fft_.assign(fft_size_, 0.0);
+    chirp_filter_fft_[0] = std::conj(chirp_[0]);
+    for (size_t n = 1; n < size_; n++) {
+        chirp_filter_fft_[n] = std::conj(chirp_[n]);
+        chirp_filter_fft_[fft_size_ - n] = std::conj(chirp_[n]);
+    }
+    radix2_fft(chirp_filter_fft_.data(), false);
+}
+
+void CosineTransform::forward_cosine(const double* in, double* out, t_scratch& scratch) const {
+    if (!cos_table_.empty()) {
+        for (size_t k = 0; k < size_; k++) {
+            const double* basis = &cos_table_[k * size_];
+            double sum = 0.0;
+            for (size_t n = 0; n < size_; n++)
+                sum += basis[n] * in[n];
+            out[k] = sum;
+        }
+        return;
+    }
+
+    scratch.resize(size_ + (chirp_.empty() ? 0 : fft_size_));
+
+    // Makhoul's reordering: the even values in order, then the odd values
+    // reversed.
+    for (size_t n = 0; 2 * n < size_; n++)
+        scratch[n] = in[2 * n];
+    for (size_t n = 0; 2 * n + 1 < size_; n++)
+        scratch[size_ - 1 - n] = in[2 * n + 1];
+
+    dft(scratch.data(), false, scratch);
+
+    for (size_t k = 0; k < size_; k++)
+        out[k] = shift_[k].real() * scratch[k].real() - shift_[k].imag() * scratch[k].imag();
+}
+
+void CosineTransform::inverse_cosine_to_scratch(const double* in, t_scratch& scratch) const {
+    scratch.resize(size_ + (chirp_.empty() ? 0 : fft_size_));
+
+    // The cosine series is N times the inverse of forward_cosine applied to
+    // the coefficients, with all but the first one halved. Undo the shift of
+    // forward_cosine, using the conjugate symmetry of the DFT of a real
+    // sequence to recover the imaginary parts.
+    scratch[0] = in[0];
+    for (size_t k = 1; k < size_; k++)
+        scratch[k] = mul(std::conj(shift_[k]), {0.5 * in[k], -0.5 * in[size_ - k]});
+
+    dft(scratch.data(), true, scratch);
+}
+
+void CosineTransform::inverse_cosine(const double* in, double* out, t_scratch& scratch) const {
+    if (!cos_table_.empty()) {
+        for (size_t n = 0; n < size_; n++)
+            out[n] = 0.0;
+        for (size_t k = 0; k < size_; k++) {
+            const double* basis = &cos_table_[k * size_];
+            for (size_t n = 0; n < size_; n++)
+                out[n] += in[k] * basis[n];
+        }
+        return;
+    }
+
+    inverse_cosine_to_scratch(in, scratch);
+
+    // Undo Makhoul's reordering.
+    for (size_t n = 0; 2 * n < size_; n++)
+        out[2 * n] = scratch[n].real();
+    for (size_t n = 0; 2 * n + 1 < size_; n++)
+        out[2 * n + 1] = scratch[size_ - 1 - n].real();
+}
+
+void CosineTransform::inverse_sine(const double* in, double* out, t_scratch& scratch) const {
+    // sin(w_k * (n + 0.5)) = (-1)^n * cos(w_(N-k) * (n + 0.5)), so the sine
+    // series is the cosine series of the reversed coefficients, with every
+    // other value negated.
+    if (!cos_table_.empty()) {
+        for (size_t n = 0; n < size_; n++)
+            out[n] = 0.0;
+        for (size_t k = 1; k < size_; k++) {
+            const double* basis = &cos_table_[k * size_];
+            for (size_t n = 0; n < size_; n++)
+                out[n] += in[size_ - k] * basis[n];
+        }
+        for (size_t n = 1; n < size_; n += 2)
+            out[n] = -out[n];
+        return;
+    }
+
+    // out holds the reversed coefficients meanwhile.
+    out[0] = 0.0;
+    for (size_t k = 1; k < size_; k++)
+        out[k] = in[size_ - k];
+    inverse_cosine_to_scratch(out, scratch);
+
+    for (size_t n = 0; 2 * n < size_; n++)
+        out[2 * n] = scratch[n].real();
+    for (size_t n = 0; 2 * n + 1 < size_; n++)
+        out[2 * n + 1] = -scratch[size_ - 1 - n].real();
+}
+
+void CosineTransform::dft(std::complex<double>* data, bool inverse, t_scratch& scratch) const {
+    if (chirp_.empty()) {
+        radix2_fft(data, inverse);
+        return;
+    }
+
+    // The inverse DFT is the conjugate of the DFT of the conjugate.
+    if (inverse) {
+        for (size_t n = 0; n < size_; n++)
+            data[n] = std::conj(data[n]);
+    }
+
+    // Bluestein's algorithm: X[k] = chirp[k] * SUM_n(x[n] * chirp[n] * conj(chirp[k - n])),
+    // a circular convolution of fft_size_ points.
+    std::complex<double>* conv = scratch.data() + size_;
+    for (size_t n = 0; n < size_; n++)
+        conv[n] = mul(data[n], chirp_[n]);
+    for (size_t n = size_; n < fft_size_; n++)
+        conv[n] = 0.0;
+    radix2_fft(conv, false);
+    for (size_t k = 0; k < fft_size_; k++)
+        conv[k] = mul(conv[k], chirp_filter_fft_[k]);
+    radix2_fft(conv, true);
+
+    double norm = 1.0 / static_cast<double>(fft_size_);
+    for (size_t k = 0; k < size_; k++) {
+        data[k] = mul(chirp_[k], conv[k]) * norm;
+        if (inverse)
+            data[k] = std::conj(data[k]);
+    }
+}
+
+void CosineTransform::radix2_fft(std::complex<double>* data, bool inverse) const {
+    const size_t n = fft_size_;
+
+    // Bit reversal permutation.
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(data[i], data[j]);
+    }
+
+    // Butterflies, doubling the length of the transforms at each stage.
+    for (size_t len = 2; len <= n; len <<= 1) {
+        size_t half = len / 2;
+        size_t twiddle_step = n / len;
+        for (size_t start = 0; start < n; start += len) {
+            for (size_t i = 0; i < half; i++) {
+                const std::complex<double>& w = twiddles_[i * twiddle_step];
+                std::complex<double> odd = mul(inverse ? std::conj(w) : w, data[start + i + half]);
+                data[start + i + half] = data[start + i] - odd;
+                data[start + i] += odd;
+            }
+        }
+    }
+}
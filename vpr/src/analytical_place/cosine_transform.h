@@ -0,0 +1,96 @@
+#pragma once
+/**
+ * @file
+ * @brief   Fast cosine and sine transforms of real sequences of any length, used
+ *          by the electrostatic field solver.
+ *
+ * The transforms are computed with a complex FFT of the same length using
+ * Makhoul's method (https://doi.org/10.1109/TASSP.1980.1163351), in
+ * O(N log(N)). The FFT is radix-2 if N is a power of two, and otherwise uses
+ * Bluestein's algorithm over a radix-2 FFT of at least 2N - 1 points. Short
+ * lengths which aren't a power of two are computed as O(N^2) sums instead,
+ * which are faster than Bluestein's algorithm below a couple hundred points.
+ */
+
+#include <complex>
+#include <vector>
+
+/**
+ * @brief The cosine / sine transforms of length N, sampled at the centers of
+ *        N unit bins:
+ *      forward_cosine: out[k] = SUM_n(in[n] * cos(w_k * (n + 0.5)))
+ *      inverse_cosine: out[n] = SUM_k(in[k] * cos(w_k * (n + 0.5)))
+ *      inverse_sine:   out[n] = SUM_k(in[k] * sin(w_k * (n + 0.5)))
+ * Where w_k = pi * k / N. No normalization is applied.
+ *
+ * The tables are built once; the transforms are const, so may run on several
+ * threads at once, as long as each thread passes its own scratch vector.
+ */
+class CosineTransform {
+  public:
+    typedef std::vector<std::complex<double>> t_scratch;
+
+    /**
+     * @brief Constructor of the transforms.
+     *
+     *  @param size     The length N of the sequences. Must be positive.
+     */
+    explicit CosineTransform(size_t size);
+
+    size_t size() const { return size_; }
+
+    /// @brief The cosine coefficients of in. in and out hold N values and
+    ///        must not overlap.
+    void forward_cosine(const double* in, double* out, t_scratch& scratch) const;
+
+    /// @brief The cosine series with coefficients in. in and out hold N values
+    ///        and must not overlap.
+    void inverse_cosine(const double* in, double* out, t_scratch& scratch) const;
+
+    /// @brief The sine series with coefficients in (in[0] is unused). in and
+    ///        out hold N values and must not overlap.
+    void inverse_sine(const double* in, double* out, t_scratch& scratch) const;
+
+  private:
+    /// @brief The longest length, which isn't a power of two, computed as
+    ///        sums over cos_table_.
+    static constexpr size_t MAX_DIRECT_SIZE = 192;
+
+    /**
+     * @brief In place DFT of the N values of data (exp(-2*pi*i*n*k/N) kernel),
+     *        or unnormalized inverse DFT if inverse is set.
+     */
+    void dft(std::complex<double>* data, bool inverse, t_scratch& scratch) const;
+
+    /**
+     * @brief In place radix-2 DFT of the fft_size_ values of data, or
+     *        unnormalized inverse DFT if inverse is set.
+     */
+    void radix2_fft(std::complex<double>* data, bool inverse) const;
+
+    /// @brief Inverse cosine series of in, leaving it in the real part of
+    ///        scratch[0, N).
+    void inverse_cosine_to_scratch(const double* in, t_scratch& scratch) const;
+
+    /// @brief The length N of the transforms.
+    size_t size_;
+
+    /// @brief cos(w_k * (n + 0.5)) at [k * N + n], if the transforms are
+    ///        computed as sums (empty otherwise).
+    std::vector<double> cos_table_;
+
+    /// @brief exp(-i * pi * k / (2N)), for k in [0, N).
+    std::vector<std::complex<double>> shift_;
+
+    /// @brief The length of the radix-2 FFT: N if it is a power of two, the
+    ///        Bluestein convolution length otherwise.
+    size_t fft_size_ = 0;
+    /// @brief exp(-2 * pi * i * k / fft_size_), for k in [0, fft_size_ / 2).
+    std::vector<std::complex<double>> twiddles_;
+
+    // Bluestein's algorithm (empty if N is a power of two): the chirp
+    // exp(-i * pi * n^2 / N) for n in [0, N), and the FFT of its conjugate
+    // wrapped around fft_size_ points.
+    std::vector<std::complex<double>> chirp_;
+    std::vector<std::complex<double>> chirp_filter_fft_;
+};
@@ -6,6 +6,7 @@
  */
 
 #include "detailed_placer.h"
+#include <algorithm>
 #include <memory>
 #include "PlacementDelayModelCreator.h"
 #include "ap_flow_enums.h"
@@ -22,6 +23,7 @@
 #include "vpr_error.h"
 #include "vpr_types.h"
 #include "vpr_utils.h"
+#include "vtr_log.h"
 #include "vtr_time.h"
 
 std::unique_ptr<DetailedPlacer> make_detailed_placer(e_ap_detailed_placer detailed_placer_type,
@@ -38,7 +40,15 @@ std::unique_ptr<DetailedPlacer> make_detailed_placer(e_ap_detailed_placer detail
                                                             atom_netlist,
                                                             clustered_netlist,
                                                             vpr_setup,
-                                                            arch);
+                                                            arch,
+                                                            false /*refine*/);
+        case e_ap_detailed_placer::RefineAnnealer:
+            return std::make_unique<AnnealerDetailedPlacer>(curr_clustered_placement,
+                                                            atom_netlist,
+                                                            clustered_netlist,
+                                                            vpr_setup,
+                                                            arch,
+                                                            true /*refine*/);
         default:
             VPR_FATAL_ERROR(VPR_ERROR_AP,
                             "Unrecognized detailed placer type");
@@ -49,8 +59,10 @@ AnnealerDetailedPlacer::AnnealerDetailedPlacer(const BlkLocRegistry& curr_cluste
                                                const AtomNetlist& atom_netlist,
                                                const ClusteredNetlist& clustered_netlist,
                                                t_vpr_setup& vpr_setup,
-                                               const t_arch& arch)
+                                               const t_arch& arch,
+                                               bool refine)
     : DetailedPlacer()
+    , placer_opts_(vpr_setup.PlacerOpts)
     // TODO: These two variables needed to be stored in the class since
     //       the Placer stores a reference to these objects. These
     //       should really be initialized and stored into the Placer
@@ -75,16 +87,31 @@ AnnealerDetailedPlacer::AnnealerDetailedPlacer(const BlkLocRegistry& curr_cluste
         }
     }
 
+    // When refining, the placement coming out of AP is already good. Start
+    // the anneal cold, so that it only locally improves the placement, and
+    // anneal non-overlapping regions of the device in parallel.
+    float init_t_scale = vpr_setup.PlacerOpts.place_auto_init_t_scale;
+    if (refine) {
+        init_t_scale *= REFINE_INIT_T_SCALE;
+        // Region moves can not be combined with speculative moves.
+        if (placer_opts_.speculative_moves <= 1) {
+            placer_opts_.parallel_regions = std::max(placer_opts_.parallel_regions,
+                                                     REFINE_MIN_PARALLEL_REGIONS);
+        }
+        VTR_LOG("AP Detailed Placer refining with an initial temperature scale of %g and %d parallel regions per dimension\n",
+                init_t_scale, placer_opts_.parallel_regions);
+    }
+
     placer_ = std::make_unique<Placer>((const Netlist<>&)clustered_netlist,
                                        curr_clustered_placement,
-                                       vpr_setup.PlacerOpts,
+                                       placer_opts_,
                                        vpr_setup.AnalysisOpts,
                                        vpr_setup.NocOpts,
                                        pb_gpin_lookup_,
                                        netlist_pin_lookup_,
                                        FlatPlacementInfo(),
                                        place_delay_model,
-                                       vpr_setup.PlacerOpts.place_auto_init_t_scale,
+                                       init_t_scale,
                                        g_vpr_ctx.placement().cube_bb,
                                        false /*is_flat*/,
                                        false /*quiet*/);
@@ -66,6 +66,13 @@ class IdentityDetailedPlacer : public DetailedPlacer {
  *
  * This Detailed Placer reuses the options from the Placer stage of VPR for this
  * stage. So options passed to the Placer will be used in here.
+ *
+ * In refine mode, the annealer is tuned for the good starting point produced
+ * by AP: the initial temperature is scaled down by REFINE_INIT_T_SCALE so that
+ * the anneal only makes local improvements, and the device is split into
+ * (at least) REFINE_MIN_PARALLEL_REGIONS x REFINE_MIN_PARALLEL_REGIONS
+ * non-overlapping regions which are annealed in parallel (see
+ * --place_parallel_regions).
  */
 class AnnealerDetailedPlacer : public DetailedPlacer {
   public:
@@ -83,12 +90,16 @@ class AnnealerDetailedPlacer : public DetailedPlacer {
      *      The setup variables, used to get the params from the user.
      *  @param arch
      *      The FPGA architecture to optimize onto.
+     *  @param refine
+     *      Anneal at a low temperature, in parallel regions, to refine the
+     *      AP placement.
      */
     AnnealerDetailedPlacer(const BlkLocRegistry& curr_clustered_placement,
                            const AtomNetlist& atom_netlist,
                            const ClusteredNetlist& clustered_netlist,
                            t_vpr_setup& vpr_setup,
-                           const t_arch& arch);
+                           const t_arch& arch,
+                           bool refine);
 
     /**
      * @brief Run the annealer.
@@ -96,6 +107,18 @@ class AnnealerDetailedPlacer : public DetailedPlacer {
     void optimize_placement() final;
 
   private:
+    /// @brief The scale applied to the initial temperature in refine mode.
+    static constexpr float REFINE_INIT_T_SCALE = 0.01f;
+
+    /// @brief The minimum number of regions along each dimension of the
+    ///        device which are annealed in parallel in refine mode.
+    static constexpr int REFINE_MIN_PARALLEL_REGIONS = 4;
+
+    /// @brief The options of the annealer. These are the options of the
+    ///        Placer stage, possibly tuned for refinement. Stored in the class
+    ///        since the Placer keeps a reference to them.
+    t_placer_opts placer_opts_;
+
     /// @brief The placer class, which contains the annealer.
     std::unique_ptr<Placer> placer_;
 
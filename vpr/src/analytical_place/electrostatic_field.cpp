@@ -0,0 +1,119 @@
+/**
+ * @file
+ * @brief   Implementation of the electrostatic field solver.
+ */
+
+#include "electrostatic_field.h"
+#include <cmath>
+#include <vector>
+#include "vtr_assert.h"
+
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+/**
+ * @brief Calls func(i) for every i in [0, num), in parallel if VPR is built
+ *        with TBB.
+ */
+template<typename Func>
+static void for_each_index(size_t num, const Func& func) {
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num, func);
+#else
+    for (size_t i = 0; i < num; i++)
+        func(i);
+#endif
+}
+
+ElectrostaticFieldSolver::ElectrostaticFieldSolver(size_t width, size_t height)
+    : width_(width)
+    , height_(height)
+    , transform_x_(width)
+    , transform_y_(height)
+    , partial_({width, height}, 0.0)
+    , density_coeffs_({width, height}, 0.0)
+    , potential_coeffs_({width, height}, 0.0)
+    , field_x_coeffs_({width, height}, 0.0)
+    , field_y_coeffs_({width, height}, 0.0)
+    , potential_({width, height}, 0.0)
+    , field_x_({width, height}, 0.0)
+    , field_y_({width, height}, 0.0) {
+    VTR_ASSERT(width > 0 && height > 0);
+}
+
+void ElectrostaticFieldSolver::solve(const vtr::NdMatrix<double, 2>& density) {
+    VTR_ASSERT(density.dim_size(0) == width_ && density.dim_size(1) == height_);
+
+    // Forward transform in the y dimension: partial[x][v].
+    for_each_index(width_, [&](size_t x) {
+        CosineTransform::t_scratch scratch;
+        transform_y_.forward_cosine(&density[x][0], &partial_[x][0], scratch);
+    });
+
+    // Forward transform in the x dimension, and the coefficients of the
+    // potential and field from the coefficients of the density.
+    double norm = 1.0 / static_cast<double>(width_ * height_);
+    for_each_index(height_, [&](size_t v) {
+        CosineTransform::t_scratch scratch;
+        std::vector<double> column(width_);
+        std::vector<double> coeffs(width_);
+        for (size_t x = 0; x < width_; x++)
+            column[x] = partial_[x][v];
+        transform_x_.forward_cosine(column.data(), coeffs.data(), scratch);
+
+        double w_v = M_PI * static_cast<double>(v) / static_cast<double>(height_);
+        double c_v = (v == 0) ? 1.0 : 2.0;
+        for (size_t u = 0; u < width_; u++) {
+            double c_u = (u == 0) ? 1.0 : 2.0;
+            double coeff = coeffs[u] * c_u * c_v * norm;
+            density_coeffs_[u][v] = coeff;
+
+            // The average density has no potential.
+            if (u == 0 && v == 0) {
+                potential_coeffs_[u][v] = 0.0;
+                field_x_coeffs_[u][v] = 0.0;
+                field_y_coeffs_[u][v] = 0.0;
+                continue;
+            }
+            double w_u = M_PI * static_cast<double>(u) / static_cast<double>(width_);
+            double inv_w2 = 1.0 / (w_u * w_u + w_v * w_v);
+            potential_coeffs_[u][v] = coeff * inv_w2;
+            field_x_coeffs_[u][v] = coeff * w_u * inv_w2;
+            field_y_coeffs_[u][v] = coeff * w_v * inv_w2;
+        }
+    });
+
+    inverse_transform(potential_coeffs_, e_basis::COSINE, e_basis::COSINE, potential_);
+    inverse_transform(field_x_coeffs_, e_basis::SINE, e_basis::COSINE, field_x_);
+    inverse_transform(field_y_coeffs_, e_basis::COSINE, e_basis::SINE, field_y_);
+}
+
+void ElectrostaticFieldSolver::inverse_transform(const vtr::NdMatrix<double, 2>& coeffs,
+                                                 e_basis basis_x,
+                                                 e_basis basis_y,
+                                                 vtr::NdMatrix<double, 2>& out) {
+    // Inverse transform in the x dimension: partial[x][v].
+    for_each_index(height_, [&](size_t v) {
+        CosineTransform::t_scratch scratch;
+        std::vector<double> column(width_);
+        std::vector<double> series(width_);
+        for (size_t u = 0; u < width_; u++)
+            column[u] = coeffs[u][v];
+        if (basis_x == e_basis::COSINE)
+            transform_x_.inverse_cosine(column.data(), series.data(), scratch);
+        else
+            transform_x_.inverse_sine(column.data(), series.data(), scratch);
+        for (size_t x = 0; x < width_; x++)
+            partial_[x][v] = series[x];
+    });
+
+    // Inverse transform in the y dimension.
+    for_each_index(width_, [&](size_t x) {
+        CosineTransform::t_scratch scratch;
+        if (basis_y == e_basis::COSINE)
+            transform_y_.inverse_cosine(&partial_[x][0], &out[x][0], scratch);
+        else
+            transform_y_.inverse_sine(&partial_[x][0], &out[x][0], scratch);
+    });
+}
@@ -0,0 +1,107 @@
+#pragma once
+/**
+ * @file
+ * @brief   Solver for the electrostatic field of a placement density, used by
+ *          the electrostatic global placer.
+ *
+ * In the electrostatic analogy (ePlace, https://doi.org/10.1145/2699873), the
+ * blocks of a placement are positive charges and the density of a grid of bins
+ * is the charge density rho. The potential psi of the system is the solution of
+ * Poisson's equation:
+ *      laplacian(psi) = -rho
+ * with a zero gradient on the boundary of the grid. The electric field,
+ * xi = -grad(psi), pushes the blocks away from the dense regions, and the
+ * potential energy of the blocks is used as the density penalty.
+ *
+ * With these boundary conditions, the solution is a cosine series whose
+ * coefficients are the discrete cosine transform (DCT) of the density:
+ *      a_uv   = c_u*c_v/(W*H) * SUM(rho(x, y) * cos(w_u * x) * cos(w_v * y))
+ *      psi    = SUM(a_uv / (w_u^2 + w_v^2) * cos(w_u * x) * cos(w_v * y))
+ *      xi_x   = SUM(a_uv * w_u / (w_u^2 + w_v^2) * sin(w_u * x) * cos(w_v * y))
+ *      xi_y   = SUM(a_uv * w_v / (w_u^2 + w_v^2) * cos(w_u * x) * sin(w_v * y))
+ * Where w_u = pi * u / W, w_v = pi * v / H, c_0 = 1, c_u = 2 otherwise, and
+ * (x, y) is the center of a bin.
+ * The (0, 0) coefficient (the average density) is dropped, which makes the
+ * solution exist.
+ */
+
+#include "cosine_transform.h"
+#include "vtr_ndmatrix.h"
+
+/**
+ * @brief Solves the potential and electric field of a density over a W x H
+ *        grid of unit bins.
+ *
+ * The transforms are separable: they are computed one dimension at a time
+ * with fast cosine / sine transforms (see cosine_transform.h), in parallel over
+ * the rows (or columns) of the grid if VPR is built with TBB. A solve takes
+ * O(W*H*log(W*H)).
+ */
+class ElectrostaticFieldSolver {
+  public:
+    /**
+     * @brief Constructor of the solver.
+     *
+     *  @param width    The number of bins in the x dimension.
+     *  @param height   The number of bins in the y dimension.
+     */
+    ElectrostaticFieldSolver(size_t width, size_t height);
+
+    /**
+     * @brief Solve the potential and electric field of the given density.
+     *
+     *  @param density  The charge density of each bin, indexed [x][y]. Must
+     *                  be width x height.
+     */
+    void solve(const vtr::NdMatrix<double, 2>& density);
+
+    /// @brief The potential of each bin, from the last solve.
+    const vtr::NdMatrix<double, 2>& potential() const { return potential_; }
+
+    /// @brief The x component of the electric field of each bin, from the
+    ///        last solve.
+    const vtr::NdMatrix<double, 2>& field_x() const { return field_x_; }
+
+    /// @brief The y component of the electric field of each bin, from the
+    ///        last solve.
+    const vtr::NdMatrix<double, 2>& field_y() const { return field_y_; }
+
+  private:
+    /// @brief The basis of a series, in one dimension.
+    enum class e_basis {
+        COSINE, ///< cos(w * c)
+        SINE    ///< sin(w * c)
+    };
+
+    /**
+     * @brief Computes out[x][y] = SUM(coeffs[u][v] * basis_x(w_u * x) * basis_y(w_v * y))
+     *        over all u and v.
+     */
+    void inverse_transform(const vtr::NdMatrix<double, 2>& coeffs,
+                           e_basis basis_x,
+                           e_basis basis_y,
+                           vtr::NdMatrix<double, 2>& out);
+
+    /// @brief The number of bins in the x dimension.
+    size_t width_;
+    /// @brief The number of bins in the y dimension.
+    size_t height_;
+
+    /// @brief The transforms of the x dimension.
+    CosineTransform transform_x_;
+    /// @brief The transforms of the y dimension.
+    CosineTransform transform_y_;
+
+    /// @brief Scratch matrix holding the partial (one dimension) transforms.
+    vtr::NdMatrix<double, 2> partial_;
+
+    // The cosine coefficients of the density, the potential and the field.
+    vtr::NdMatrix<double, 2> density_coeffs_;
+    vtr::NdMatrix<double, 2> potential_coeffs_;
+    vtr::NdMatrix<double, 2> field_x_coeffs_;
+    vtr::NdMatrix<double, 2> field_y_coeffs_;
+
+    vtr::NdMatrix<double, 2> potential_;
+    vtr::NdMatrix<double, 2> field_x_;
+    vtr::NdMatrix<double, 2> field_y_;
+};
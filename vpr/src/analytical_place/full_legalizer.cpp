@@ -59,6 +59,11 @@
 
 #include "setup_grid.h"
 #include "stats.h"
+
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #ifndef NO_GRAPHICS
 #include "draw_global.h"
 #endif
@@ -332,10 +337,13 @@ FlatRecon::sort_and_group_blocks_by_tile(const PartialPlacement& p_placement) {
         t_physical_tile_loc tile_loc;
     };
 
-    // Collect the sorting information and tile information.
-    std::vector<BlockInformation> sorted_blocks;
-    sorted_blocks.reserve(ap_netlist_.blocks().size());
-    for (APBlockId blk_id : ap_netlist_.blocks()) {
+    // Collect the sorting information and tile information. Computing the
+    // molecule stats walks the nets of every atom, and each block only reads
+    // the netlists, so the blocks are processed in parallel.
+    size_t num_blocks = ap_netlist_.blocks().size();
+    std::vector<BlockInformation> sorted_blocks(num_blocks);
+    auto collect_block_information = [&](size_t blk_idx) {
+        APBlockId blk_id = *(ap_netlist_.blocks().begin() + blk_idx);
         PackMoleculeId mol_id = ap_netlist_.block_molecule(blk_id);
         const auto& mol = prepacker_.get_molecule(mol_id);
 
@@ -343,8 +351,14 @@ FlatRecon::sort_and_group_blocks_by_tile(const PartialPlacement& p_placement) {
         bool long_chain = mol.is_chain() && prepacker_.get_molecule_chain_info(mol.chain_id).is_long_chain;
         t_physical_tile_loc tile_loc = p_placement.get_containing_tile_loc(blk_id);
 
-        sorted_blocks.push_back({mol_id, num_ext_inputs, long_chain, tile_loc});
-    }
+        sorted_blocks[blk_idx] = {mol_id, num_ext_inputs, long_chain, tile_loc};
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num_blocks, collect_block_information);
+#else
+    for (size_t blk_idx = 0; blk_idx < num_blocks; blk_idx++)
+        collect_block_information(blk_idx);
+#endif
 
     // Sort the blocks so that:
     // 1) Long carry-chain molecules are placed first. They have strict placement
@@ -992,7 +1006,7 @@ void FlatRecon::legalize(const PartialPlacement& p_placement) {
     create_clusters(cluster_legalizer, p_placement);
 
     // Verify that the clustering created by the full legalizer is valid.
-    unsigned num_clustering_errors = verify_clustering(g_vpr_ctx);
+    unsigned num_clustering_errors = verify_clustering(get_current_vpr_context());
     if (num_clustering_errors == 0) {
         VTR_LOG("Completed clustering consistency check successfully.\n");
     } else {
@@ -1181,7 +1195,7 @@ void NaiveFullLegalizer::legalize(const PartialPlacement& p_placement) {
     // Pack the atoms into clusters based on the partial placement.
     create_clusters(p_placement);
     // Verify that the clustering created by the full legalizer is valid.
-    unsigned num_clustering_errors = verify_clustering(g_vpr_ctx);
+    unsigned num_clustering_errors = verify_clustering(get_current_vpr_context());
     if (num_clustering_errors == 0) {
         VTR_LOG("Completed clustering consistency check successfully.\n");
     } else {
@@ -1207,7 +1221,7 @@ void NaiveFullLegalizer::legalize(const PartialPlacement& p_placement) {
     place_clusters(clb_nlist, place_macros, p_placement);
 
     // Verify that the placement created by the full legalizer is valid.
-    unsigned num_placement_errors = verify_placement(g_vpr_ctx);
+    unsigned num_placement_errors = verify_placement(get_current_vpr_context());
     if (num_placement_errors == 0) {
         VTR_LOG("Completed placement consistency check successfully.\n");
     } else {
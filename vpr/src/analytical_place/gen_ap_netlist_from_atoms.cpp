@@ -19,9 +19,93 @@
 #include "vtr_assert.h"
 #include "vtr_geometry.h"
 #include "vtr_time.h"
-#include <unordered_set>
+#include "vtr_vector.h"
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+namespace {
+
+/**
+ * @brief How an atom net should be annotated in the AP netlist, decided from
+ *        the atom netlist alone.
+ */
+enum class e_ap_net_filter : uint8_t {
+    KEEP,    ///< The net is kept for AP (it may still be ignored later).
+    IGNORED, ///< The net is ignored by AP.
+    GLOBAL   ///< The net is global (and ignored by AP).
+};
+
+/**
+ * @brief Calls func(i) for every i in [0, num), in parallel if VPR is built
+ *        with TBB.
+ */
+template<typename Func>
+void for_each_index(size_t num, const Func& func) {
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num, func);
+#else
+    for (size_t i = 0; i < num; i++)
+        func(i);
+#endif
+}
+
+/**
+ * @brief Decides how each atom net should be annotated in the AP netlist.
+ *
+ * Nets are filtered if they are:
+ *  - ignored for placement
+ *  - a global net
+ *  - having fanout higher than threshold
+ * Every AP net has the same pins as its atom net, so the fanout of the atom
+ * net is the fanout of the AP net.
+ */
+vtr::vector<AtomNetId, e_ap_net_filter> filter_atom_nets(const AtomNetlist& atom_netlist,
+                                                         int high_fanout_threshold) {
+    vtr::vector<AtomNetId, e_ap_net_filter> net_filter(atom_netlist.nets().size(), e_ap_net_filter::KEEP);
+    for_each_index(atom_netlist.nets().size(), [&](size_t i) {
+        AtomNetId atom_net_id = *(atom_netlist.nets().begin() + i);
+        // Is the net ignored for placement, if so mark as ignored for AP.
+        if (atom_netlist.net_is_ignored(atom_net_id)) {
+            net_filter[atom_net_id] = e_ap_net_filter::IGNORED;
+            return;
+        }
+
+        // Is the net global, if so mark as global for AP (also ignored)
+        if (atom_netlist.net_is_global(atom_net_id)) {
+            net_filter[atom_net_id] = e_ap_net_filter::GLOBAL;
+            return;
+        }
+
+        // Prior to AP, it is likely that the nets in the Atom Netlist have not
+        // been annotated with being global or ignored. To get around this, we
+        // annotate the AP Netlist speculatively.
+        // We label a net as being global if one of its pin connect to a clock
+        // port or a non-clock global model port.
+        for (AtomPinId pin_id : atom_netlist.net_pins(atom_net_id)) {
+            AtomPortId port_id = atom_netlist.pin_port(pin_id);
+            if (atom_netlist.port_type(port_id) == PortType::CLOCK
+                || atom_netlist.port_model(port_id)->is_non_clock_global) {
+                net_filter[atom_net_id] = e_ap_net_filter::GLOBAL;
+                return;
+            }
+        }
+
+        // If fanout number of the net is higher than the threshold, mark as ignored for AP.
+        size_t num_pins = atom_netlist.net_pins(atom_net_id).size();
+        if (num_pins > 1 && num_pins - 1 > static_cast<size_t>(high_fanout_threshold)) {
+            net_filter[atom_net_id] = e_ap_net_filter::IGNORED;
+        }
+    });
+    return net_filter;
+}
+
+} // namespace
+
 APNetlist gen_ap_netlist_from_atoms(const AtomNetlist& atom_netlist,
                                     const Prepacker& prepacker,
                                     const UserPlaceConstraints& constraints,
@@ -33,6 +117,14 @@ APNetlist gen_ap_netlist_from_atoms(const AtomNetlist& atom_netlist,
     //        using empty strings.
     APNetlist ap_netlist;
 
+    // Filter the nets up front (in parallel), so they can be annotated as
+    // they are created.
+    vtr::vector<AtomNetId, e_ap_net_filter> net_filter = filter_atom_nets(atom_netlist,
+                                                                          high_fanout_threshold);
+    // The AP net created for each atom net, which saves looking the nets up
+    // by name.
+    vtr::vector<AtomNetId, APNetId> atom_net_to_ap_net(atom_netlist.nets().size());
+
     // Add the APBlocks based on the atom block molecules. This essentially
     // creates supernodes.
     // Each AP block has the name of the first atom block in the molecule.
@@ -60,8 +152,20 @@ APNetlist gen_ap_netlist_from_atoms(const AtomNetlist& atom_netlist,
                 PinType pin_type = atom_netlist.pin_type(atom_pin_id);
                 bool pin_is_const = atom_netlist.pin_is_constant(atom_pin_id);
                 AtomNetId pin_atom_net_id = atom_netlist.pin_net(atom_pin_id);
-                const std::string& pin_atom_net_name = atom_netlist.net_name(pin_atom_net_id);
-                APNetId pin_ap_net_id = ap_netlist.create_net(pin_atom_net_name, pin_atom_net_id);
+                APNetId pin_ap_net_id = atom_net_to_ap_net[pin_atom_net_id];
+                if (!pin_ap_net_id.is_valid()) {
+                    const std::string& pin_atom_net_name = atom_netlist.net_name(pin_atom_net_id);
+                    pin_ap_net_id = ap_netlist.create_net(pin_atom_net_name, pin_atom_net_id);
+                    atom_net_to_ap_net[pin_atom_net_id] = pin_ap_net_id;
+                    // Annotate the net as it is created.
+                    if (net_filter[pin_atom_net_id] == e_ap_net_filter::GLOBAL) {
+                        ap_netlist.set_net_is_global(pin_ap_net_id, true);
+                        // Global nets are also ignored by the AP flow.
+                        ap_netlist.set_net_is_ignored(pin_ap_net_id, true);
+                    } else if (net_filter[pin_atom_net_id] == e_ap_net_filter::IGNORED) {
+                        ap_netlist.set_net_is_ignored(pin_ap_net_id, true);
+                    }
+                }
                 ap_netlist.create_pin(ap_port_id, port_bit, pin_ap_net_id, pin_type, atom_pin_id, pin_is_const);
             }
         }
@@ -110,83 +214,41 @@ APNetlist gen_ap_netlist_from_atoms(const AtomNetlist& atom_netlist,
         }
     }
 
-    // Cleanup the netlist by marking undesirable nets.
-    // Currently undesirable nets are nets that are:
-    //  - ignored for placement
-    //  - a global net
+    // Cleanup the netlist by marking the remaining undesirable nets. The nets
+    // filtered from the atom netlist were annotated when they were created.
+    // The remaining undesirable nets are nets that are:
     //  - connected to 1 or fewer unique blocks
     //  - connected to only fixed blocks
-    //  - having fanout higher than threshold
-    for (APNetId ap_net_id : ap_netlist.nets()) {
-        // Is the net ignored for placement, if so mark as ignored for AP.
-        const std::string& net_name = ap_netlist.net_name(ap_net_id);
-        AtomNetId atom_net_id = atom_netlist.find_net(net_name);
-        VTR_ASSERT(atom_net_id.is_valid());
-        if (atom_netlist.net_is_ignored(atom_net_id)) {
-            ap_netlist.set_net_is_ignored(ap_net_id, true);
-            continue;
-        }
-
-        // Is the net global, if so mark as global for AP (also ignored)
-        if (atom_netlist.net_is_global(atom_net_id)) {
-            ap_netlist.set_net_is_global(ap_net_id, true);
-            // Global nets are also ignored by the AP flow.
-            ap_netlist.set_net_is_ignored(ap_net_id, true);
-            continue;
-        }
-
-        // Prior to AP, it is likely that the nets in the Atom Netlist have not
-        // been annotated with being global or ignored. To get around this, we
-        // annotate the AP Netlist speculatively.
-        // We label a net as being global if one of its pin connect to a clock
-        // port or a non-clock global model port.
-        bool is_global = false;
-        for (AtomPinId pin_id : atom_netlist.net_pins(atom_net_id)) {
-            AtomPortId port_id = atom_netlist.pin_port(pin_id);
-            if (atom_netlist.port_type(port_id) == PortType::CLOCK) {
-                is_global = true;
-                break;
-            }
-            if (atom_netlist.port_model(port_id)->is_non_clock_global) {
-                is_global = true;
-                break;
-            }
-        }
-        if (is_global) {
-            ap_netlist.set_net_is_global(ap_net_id, true);
-            // Global nets are also ignored in the AP flow.
-            ap_netlist.set_net_is_ignored(ap_net_id, true);
-        }
+    // The nets are checked in parallel, and marked afterwards.
+    std::vector<uint8_t> net_is_undesirable(ap_netlist.nets().size(), 0);
+    for_each_index(ap_netlist.nets().size(), [&](size_t i) {
+        APNetId ap_net_id = *(ap_netlist.nets().begin() + i);
+        if (ap_netlist.net_is_ignored(ap_net_id))
+            return;
 
         // Get the unique blocks connectioned to this net
-        std::unordered_set<APBlockId> net_blocks;
+        std::vector<APBlockId> net_blocks;
+        net_blocks.reserve(ap_netlist.net_pins(ap_net_id).size());
         for (APPinId ap_pin_id : ap_netlist.net_pins(ap_net_id)) {
-            net_blocks.insert(ap_netlist.pin_block(ap_pin_id));
+            net_blocks.push_back(ap_netlist.pin_block(ap_pin_id));
         }
+        std::sort(net_blocks.begin(), net_blocks.end());
+        net_blocks.erase(std::unique(net_blocks.begin(), net_blocks.end()), net_blocks.end());
         // If connected to 1 or fewer unique blocks, mark as ignored for AP.
         if (net_blocks.size() <= 1) {
-            ap_netlist.set_net_is_ignored(ap_net_id, true);
-            continue;
+            net_is_undesirable[i] = 1;
+            return;
         }
         // If all the connected blocks are fixed, mark as ignored for AP.
-        bool is_all_fixed = true;
-        for (APBlockId ap_blk_id : net_blocks) {
-            if (ap_netlist.block_mobility(ap_blk_id) == APBlockMobility::MOVEABLE) {
-                is_all_fixed = false;
-                break;
-            }
-        }
-        if (is_all_fixed) {
-            ap_netlist.set_net_is_ignored(ap_net_id, true);
-            continue;
-        }
-        // If fanout number of the net is higher than the threshold, mark as ignored for AP.
-        size_t num_pins = ap_netlist.net_pins(ap_net_id).size();
-        VTR_ASSERT_DEBUG(num_pins > 1);
-        if (num_pins - 1 > static_cast<size_t>(high_fanout_threshold)) {
-            ap_netlist.set_net_is_ignored(ap_net_id, true);
-            continue;
-        }
+        bool is_all_fixed = std::none_of(net_blocks.begin(), net_blocks.end(), [&](APBlockId ap_blk_id) {
+            return ap_netlist.block_mobility(ap_blk_id) == APBlockMobility::MOVEABLE;
+        });
+        if (is_all_fixed)
+            net_is_undesirable[i] = 1;
+    });
+    for (size_t i = 0; i < net_is_undesirable.size(); i++) {
+        if (net_is_undesirable[i])
+            ap_netlist.set_net_is_ignored(*(ap_netlist.nets().begin() + i), true);
     }
     ap_netlist.compress();
 
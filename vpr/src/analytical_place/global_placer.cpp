@@ -7,9 +7,12 @@
  */
 
 #include "global_placer.h"
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <limits>
 #include <memory>
+#include <tuple>
 #include <vector>
 #include "ap_draw_manager.h"
 #include "PreClusterTimingManager.h"
@@ -29,10 +32,16 @@
 #include "place_delay_model.h"
 #include "primitive_vector.h"
 #include "timing_info.h"
+#include "vpr_error.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
-std::unique_ptr<GlobalPlacer> make_global_placer(e_ap_analytical_solver analytical_solver_type,
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for_each.h>
+#endif
+
+std::unique_ptr<GlobalPlacer> make_global_placer(e_ap_global_placer global_placer_type,
+                                                 e_ap_analytical_solver analytical_solver_type,
                                                  e_ap_partial_legalizer partial_legalizer_type,
                                                  const APNetlist& ap_netlist,
                                                  const Prepacker& prepacker,
@@ -48,22 +57,47 @@ std::unique_ptr<GlobalPlacer> make_global_placer(e_ap_analytical_solver analytic
                                                  const std::vector<std::string>& target_density_arg_strs,
                                                  unsigned num_threads,
                                                  int log_verbosity) {
-    return std::make_unique<SimPLGlobalPlacer>(analytical_solver_type,
-                                               partial_legalizer_type,
-                                               ap_netlist,
-                                               prepacker,
-                                               atom_netlist,
-                                               device_grid,
-                                               logical_block_types,
-                                               physical_tile_types,
-                                               models,
-                                               pre_cluster_timing_manager,
-                                               place_delay_model,
-                                               ap_timing_tradeoff,
-                                               generate_mass_report,
-                                               target_density_arg_strs,
-                                               num_threads,
-                                               log_verbosity);
+    switch (global_placer_type) {
+        case e_ap_global_placer::SimPL:
+            return std::make_unique<SimPLGlobalPlacer>(analytical_solver_type,
+                                                       partial_legalizer_type,
+                                                       ap_netlist,
+                                                       prepacker,
+                                                       atom_netlist,
+                                                       device_grid,
+                                                       logical_block_types,
+                                                       physical_tile_types,
+                                                       models,
+                                                       pre_cluster_timing_manager,
+                                                       place_delay_model,
+                                                       ap_timing_tradeoff,
+                                                       generate_mass_report,
+                                                       target_density_arg_strs,
+                                                       num_threads,
+                                                       log_verbosity);
+        case e_ap_global_placer::Electrostatic:
+            return std::make_unique<ElectrostaticGlobalPlacer>(analytical_solver_type,
+                                                               partial_legalizer_type,
+                                                               ap_netlist,
+                                                               prepacker,
+                                                               atom_netlist,
+                                                               device_grid,
+                                                               logical_block_types,
+                                                               physical_tile_types,
+                                                               models,
+                                                               pre_cluster_timing_manager,
+                                                               place_delay_model,
+                                                               ap_timing_tradeoff,
+                                                               generate_mass_report,
+                                                               target_density_arg_strs,
+                                                               num_threads,
+                                                               log_verbosity);
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_AP,
+                            "Unrecognized global placer type");
+            break;
+    }
+    return nullptr;
 }
 
 SimPLGlobalPlacer::SimPLGlobalPlacer(e_ap_analytical_solver analytical_solver_type,
@@ -323,7 +357,8 @@ static void update_timing_info_with_gp_placement(PreClusterTimingManager& pre_cl
     }
 
     // Update the timing info. This will run STA to recompute the slacks and
-    // the criticalities of all timing arcs.
+    // the criticalities of the timing arcs affected by the delays which
+    // changed since the previous iteration.
     pre_cluster_timing_manager.update_timing_info();
 
     // Do not warn again about unconstrained nodes during placement.
@@ -464,3 +499,554 @@ PartialPlacement SimPLGlobalPlacer::place() {
     // Return the placement from the final iteration.
     return best_p_placement;
 }
+
+ElectrostaticGlobalPlacer::ElectrostaticGlobalPlacer(e_ap_analytical_solver analytical_solver_type,
+                                                     e_ap_partial_legalizer partial_legalizer_type,
+                                                     const APNetlist& ap_netlist,
+                                                     const Prepacker& prepacker,
+                                                     const AtomNetlist& atom_netlist,
+                                                     const DeviceGrid& device_grid,
+                                                     const std::vector<t_logical_block_type>& logical_block_types,
+                                                     const std::vector<t_physical_tile_type>& physical_tile_types,
+                                                     const LogicalModels& models,
+                                                     PreClusterTimingManager& pre_cluster_timing_manager,
+                                                     std::shared_ptr<PlaceDelayModel> place_delay_model,
+                                                     float ap_timing_tradeoff,
+                                                     bool generate_mass_report,
+                                                     const std::vector<std::string>& target_density_arg_strs,
+                                                     unsigned num_threads,
+                                                     int log_verbosity)
+    : GlobalPlacer(ap_netlist, log_verbosity)
+    , atom_netlist_(atom_netlist)
+    , pre_cluster_timing_manager_(pre_cluster_timing_manager)
+    , place_delay_model_(place_delay_model)
+    , ap_timing_tradeoff_(ap_timing_tradeoff)
+    , net_weights_(ap_netlist.nets().size(), 1.0) {
+    vtr::ScopedStartFinishTimer global_placer_building_timer("Constructing Global Placer");
+
+    // Build the solver, which is only used for the initial placement.
+    VTR_LOGV(log_verbosity_ >= 10, "\tBuilding the solver...\n");
+    solver_ = make_analytical_solver(analytical_solver_type,
+                                     ap_netlist_,
+                                     device_grid,
+                                     atom_netlist,
+                                     pre_cluster_timing_manager_,
+                                     place_delay_model_,
+                                     ap_timing_tradeoff,
+                                     num_threads,
+                                     log_verbosity_);
+
+    // Build the density manager, which gives the masses of the blocks and the
+    // capacities of the device.
+    VTR_LOGV(log_verbosity_ >= 10, "\tBuilding the density manager...\n");
+    density_manager_ = std::make_shared<FlatPlacementDensityManager>(ap_netlist_,
+                                                                     prepacker,
+                                                                     atom_netlist,
+                                                                     device_grid,
+                                                                     logical_block_types,
+                                                                     physical_tile_types,
+                                                                     models,
+                                                                     target_density_arg_strs,
+                                                                     log_verbosity_);
+    if (generate_mass_report)
+        density_manager_->generate_mass_report();
+
+    // Build the partial legalizer
+    VTR_LOGV(log_verbosity_ >= 10, "\tBuilding the partial legalizer...\n");
+    partial_legalizer_ = make_partial_legalizer(partial_legalizer_type,
+                                                ap_netlist_,
+                                                density_manager_,
+                                                prepacker,
+                                                models,
+                                                log_verbosity_);
+
+    // Build the field solver over a grid of unit bins covering the placeable
+    // region.
+    // TODO: Only the first layer is modeled. Investigate 3D devices.
+    VTR_LOGV(log_verbosity_ >= 10, "\tBuilding the field solver...\n");
+    double region_width, region_height;
+    std::tie(region_width, region_height, std::ignore) = density_manager_->get_overall_placeable_region_size();
+    grid_width_ = std::max<size_t>(1, static_cast<size_t>(std::ceil(region_width)));
+    grid_height_ = std::max<size_t>(1, static_cast<size_t>(std::ceil(region_height)));
+    field_solver_ = std::make_unique<ElectrostaticFieldSolver>(grid_width_, grid_height_);
+    bin_density_.resize({grid_width_, grid_height_}, 0.0);
+
+    init_charges_and_supply();
+
+#ifdef VPR_USE_CUDA
+    init_gpu_kernels();
+#endif
+}
+
+void ElectrostaticGlobalPlacer::init_charges_and_supply() {
+    const FlatPlacementBins& bins = density_manager_->flat_placement_bins();
+
+    // The capacity per unit area of each dimension, in the bin where it is the
+    // densest. The charges and capacities are measured relative to it.
+    PrimitiveVector max_unit_capacity;
+    for (FlatPlacementBinId bin_id : bins.bins()) {
+        const vtr::Rect<double>& bin_region = bins.bin_region(bin_id);
+        double bin_area = bin_region.width() * bin_region.height();
+        const PrimitiveVector& capacity = density_manager_->get_bin_capacity(bin_id);
+        for (PrimitiveVectorDim dim : capacity.get_non_zero_dims()) {
+            float unit_capacity = capacity.get_dim_val(dim) / bin_area;
+            if (unit_capacity > max_unit_capacity.get_dim_val(dim))
+                max_unit_capacity.set_dim_val(dim, unit_capacity);
+        }
+    }
+    auto get_relative_size = [&](const PrimitiveVector& vec) {
+        double relative_size = 0.0;
+        for (PrimitiveVectorDim dim : vec.get_non_zero_dims()) {
+            float unit_capacity = max_unit_capacity.get_dim_val(dim);
+            if (unit_capacity > 0.0f)
+                relative_size = std::max(relative_size, static_cast<double>(vec.get_dim_val(dim) / unit_capacity));
+        }
+        return relative_size;
+    };
+
+    // The charge of each moveable block.
+    block_charge_.resize(ap_netlist_.blocks().size(), 0.0);
+    total_charge_ = 0.0;
+    for (APBlockId blk_id : ap_netlist_.blocks()) {
+        if (ap_netlist_.block_mobility(blk_id) == APBlockMobility::FIXED)
+            continue;
+        block_charge_[blk_id] = get_relative_size(density_manager_->mass_calculator().get_block_mass(blk_id));
+        total_charge_ += block_charge_[blk_id];
+    }
+
+    // The capacity of each unit bin, as a fraction of the densest capacity.
+    bin_supply_.resize({grid_width_, grid_height_}, 0.0);
+    double total_supply = 0.0;
+    for (size_t x = 0; x < grid_width_; x++) {
+        for (size_t y = 0; y < grid_height_; y++) {
+            FlatPlacementBinId bin_id = density_manager_->get_bin(x + 0.5, y + 0.5, 0);
+            if (!bin_id.is_valid())
+                continue;
+            const vtr::Rect<double>& bin_region = bins.bin_region(bin_id);
+            double bin_area = bin_region.width() * bin_region.height();
+            bin_supply_[x][y] = density_manager_->get_bin_target_density(bin_id)
+                                * get_relative_size(density_manager_->get_bin_capacity(bin_id))
+                                / bin_area;
+            total_supply += bin_supply_[x][y];
+        }
+    }
+
+    // The field only depends on the differences in density. When there is
+    // more capacity than charge, the capacity is scaled down such that the
+    // charge is spread out over the whole device.
+    supply_scale_ = 1.0;
+    if (total_supply > total_charge_ && total_supply > 0.0)
+        supply_scale_ = total_charge_ / total_supply;
+}
+
+#ifdef VPR_USE_CUDA
+void ElectrostaticGlobalPlacer::init_gpu_kernels() {
+    VTR_LOGV(log_verbosity_ >= 10, "\tUploading the netlist to the GPU...\n");
+    // The pins of each (non-ignored) net, in compressed sparse row form.
+    std::vector<int> net_pin_offsets;
+    std::vector<int> pin_blocks;
+    net_pin_offsets.reserve(ap_netlist_.nets().size() + 1);
+    pin_blocks.reserve(ap_netlist_.pins().size());
+    net_pin_offsets.push_back(0);
+    for (APNetId net_id : ap_netlist_.nets()) {
+        if (!ap_netlist_.net_is_ignored(net_id)) {
+            for (APPinId pin_id : ap_netlist_.net_pins(net_id))
+                pin_blocks.push_back(static_cast<int>(size_t(ap_netlist_.pin_block(pin_id))));
+        }
+        net_pin_offsets.push_back(static_cast<int>(pin_blocks.size()));
+    }
+
+    std::vector<double> block_charges(block_charge_.begin(), block_charge_.end());
+    std::vector<char> block_is_moveable;
+    block_is_moveable.reserve(ap_netlist_.blocks().size());
+    for (APBlockId blk_id : ap_netlist_.blocks())
+        block_is_moveable.push_back(ap_netlist_.block_mobility(blk_id) == APBlockMobility::MOVEABLE);
+
+    gpu_kernels_ = std::make_unique<APGpuKernels>(net_pin_offsets,
+                                                  pin_blocks,
+                                                  block_charges,
+                                                  block_is_moveable,
+                                                  grid_width_,
+                                                  grid_height_);
+}
+#endif
+
+void ElectrostaticGlobalPlacer::update_net_weights() {
+    // If timing analysis is off, all of the nets keep a weight of 1.
+    if (!pre_cluster_timing_manager_.is_valid())
+        return;
+
+    for (APNetId net_id : ap_netlist_.nets()) {
+        if (ap_netlist_.net_is_ignored(net_id))
+            continue;
+        AtomNetId atom_net_id = ap_netlist_.net_atom_net(net_id);
+        VTR_ASSERT_SAFE(atom_net_id.is_valid());
+        float crit = pre_cluster_timing_manager_.calc_net_setup_criticality(atom_net_id, atom_netlist_);
+        net_weights_[net_id] = ap_timing_tradeoff_ * crit + (1.0f - ap_timing_tradeoff_);
+    }
+}
+
+/**
+ * @brief Computes the gradient of the WA wirelength of the given net in one
+ *        dimension, with respect to the location of each of its pins.
+ *
+ * The WA wirelength is the difference of a smooth maximum and a smooth
+ * minimum of the pin locations:
+ *      WA = SUM(x_i * exp(x_i / gamma)) / SUM(exp(x_i / gamma))
+ *         - SUM(x_i * exp(-x_i / gamma)) / SUM(exp(-x_i / gamma))
+ * The exponentials are shifted by the maximum (minimum) location so that they
+ * do not overflow.
+ */
+static void compute_net_wa_gradient(const APNetlist& ap_netlist,
+                                    APNetId net_id,
+                                    const vtr::vector<APBlockId, double>& blk_locs,
+                                    double gamma,
+                                    double net_weight,
+                                    vtr::vector<APPinId, double>& pin_grad) {
+    double max_loc = std::numeric_limits<double>::lowest();
+    double min_loc = std::numeric_limits<double>::max();
+    for (APPinId pin_id : ap_netlist.net_pins(net_id)) {
+        double loc = blk_locs[ap_netlist.pin_block(pin_id)];
+        max_loc = std::max(max_loc, loc);
+        min_loc = std::min(min_loc, loc);
+    }
+
+    double sum_max_exp = 0.0, sum_max_exp_loc = 0.0;
+    double sum_min_exp = 0.0, sum_min_exp_loc = 0.0;
+    for (APPinId pin_id : ap_netlist.net_pins(net_id)) {
+        double loc = blk_locs[ap_netlist.pin_block(pin_id)];
+        double max_exp = std::exp((loc - max_loc) / gamma);
+        double min_exp = std::exp((min_loc - loc) / gamma);
+        sum_max_exp += max_exp;
+        sum_max_exp_loc += loc * max_exp;
+        sum_min_exp += min_exp;
+        sum_min_exp_loc += loc * min_exp;
+    }
+    double wa_max = sum_max_exp_loc / sum_max_exp;
+    double wa_min = sum_min_exp_loc / sum_min_exp;
+
+    for (APPinId pin_id : ap_netlist.net_pins(net_id)) {
+        double loc = blk_locs[ap_netlist.pin_block(pin_id)];
+        double max_exp = std::exp((loc - max_loc) / gamma);
+        double min_exp = std::exp((min_loc - loc) / gamma);
+        double max_grad = max_exp * (1.0 + (loc - wa_max) / gamma) / sum_max_exp;
+        double min_grad = min_exp * (1.0 - (loc - wa_min) / gamma) / sum_min_exp;
+        pin_grad[pin_id] = net_weight * (max_grad - min_grad);
+    }
+}
+
+void ElectrostaticGlobalPlacer::compute_wirelength_gradient(const PartialPlacement& p_placement,
+                                                            double gamma,
+                                                            vtr::vector<APBlockId, double>& grad_x,
+                                                            vtr::vector<APBlockId, double>& grad_y) const {
+#ifdef VPR_USE_CUDA
+    gpu_kernels_->set_block_locs(p_placement.block_x_locs.data(), p_placement.block_y_locs.data());
+    gpu_kernels_->compute_wirelength_gradient(net_weights_.data(), gamma, grad_x.data(), grad_y.data());
+#else
+    // Compute the gradient of each pin. Every pin belongs to a single net, so
+    // the nets can be computed in parallel.
+    vtr::vector<APPinId, double> pin_grad_x(ap_netlist_.pins().size(), 0.0);
+    vtr::vector<APPinId, double> pin_grad_y(ap_netlist_.pins().size(), 0.0);
+    auto compute_net_gradient = [&](APNetId net_id) {
+        if (ap_netlist_.net_is_ignored(net_id))
+            return;
+        compute_net_wa_gradient(ap_netlist_, net_id, p_placement.block_x_locs, gamma, net_weights_[net_id], pin_grad_x);
+        compute_net_wa_gradient(ap_netlist_, net_id, p_placement.block_y_locs, gamma, net_weights_[net_id], pin_grad_y);
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(ap_netlist_.nets().begin(), ap_netlist_.nets().end(), compute_net_gradient);
+#else
+    for (APNetId net_id : ap_netlist_.nets())
+        compute_net_gradient(net_id);
+#endif
+
+    // The gradient of a block is the sum of the gradients of its pins.
+    for (APBlockId blk_id : ap_netlist_.blocks()) {
+        grad_x[blk_id] = 0.0;
+        grad_y[blk_id] = 0.0;
+        if (ap_netlist_.block_mobility(blk_id) == APBlockMobility::FIXED)
+            continue;
+        for (APPinId pin_id : ap_netlist_.block_pins(blk_id)) {
+            grad_x[blk_id] += pin_grad_x[pin_id];
+            grad_y[blk_id] += pin_grad_y[pin_id];
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Calls func(x, y, weight) for the (up to) four unit bins whose centers
+ *        surround the given location, with the bilinear interpolation weight
+ *        of each bin.
+ */
+template<typename Func>
+static void for_each_bilinear_bin(double loc_x, double loc_y, size_t width, size_t height, const Func& func) {
+    // Bin centers are at (x + 0.5, y + 0.5).
+    double offset_x = std::clamp(loc_x - 0.5, 0.0, static_cast<double>(width - 1));
+    double offset_y = std::clamp(loc_y - 0.5, 0.0, static_cast<double>(height - 1));
+    size_t x = std::min(static_cast<size_t>(offset_x), width - 1);
+    size_t y = std::min(static_cast<size_t>(offset_y), height - 1);
+    size_t next_x = std::min(x + 1, width - 1);
+    size_t next_y = std::min(y + 1, height - 1);
+    double frac_x = offset_x - static_cast<double>(x);
+    double frac_y = offset_y - static_cast<double>(y);
+    func(x, y, (1.0 - frac_x) * (1.0 - frac_y));
+    func(next_x, y, frac_x * (1.0 - frac_y));
+    func(x, next_y, (1.0 - frac_x) * frac_y);
+    func(next_x, next_y, frac_x * frac_y);
+}
+
+double ElectrostaticGlobalPlacer::compute_density_gradient(const PartialPlacement& p_placement,
+                                                           vtr::vector<APBlockId, double>& grad_x,
+                                                           vtr::vector<APBlockId, double>& grad_y) {
+#ifdef VPR_USE_CUDA
+    gpu_kernels_->set_block_locs(p_placement.block_x_locs.data(), p_placement.block_y_locs.data());
+    gpu_kernels_->compute_bin_density(&bin_density_[0][0]);
+#else
+    // Spread the charge of each block over the bins around it.
+    bin_density_.fill(0.0);
+    for (APBlockId blk_id : ap_netlist_.blocks()) {
+        double charge = block_charge_[blk_id];
+        if (charge == 0.0)
+            continue;
+        for_each_bilinear_bin(p_placement.block_x_locs[blk_id], p_placement.block_y_locs[blk_id],
+                              grid_width_, grid_height_,
+                              [&](size_t x, size_t y, double weight) {
+                                  bin_density_[x][y] += weight * charge;
+                              });
+    }
+#endif
+
+    // Compute the overflow, and turn the density into the charge density of
+    // the system: the blocks are positive charges and the capacity of the bins
+    // is a negative background charge.
+    double total_overflow = 0.0;
+    for (size_t x = 0; x < grid_width_; x++) {
+        for (size_t y = 0; y < grid_height_; y++) {
+            total_overflow += std::max(0.0, bin_density_[x][y] - bin_supply_[x][y]);
+            bin_density_[x][y] -= supply_scale_ * bin_supply_[x][y];
+        }
+    }
+
+#ifdef VPR_USE_CUDA
+    gpu_kernels_->compute_density_gradient(&bin_density_[0][0], grad_x.data(), grad_y.data());
+#else
+    field_solver_->solve(bin_density_);
+
+    // The gradient of the potential energy of a block is its charge times the
+    // potential gradient, which is the negative of the field.
+    const vtr::NdMatrix<double, 2>& field_x = field_solver_->field_x();
+    const vtr::NdMatrix<double, 2>& field_y = field_solver_->field_y();
+    for (APBlockId blk_id : ap_netlist_.blocks()) {
+        double charge = block_charge_[blk_id];
+        double blk_field_x = 0.0;
+        double blk_field_y = 0.0;
+        if (charge != 0.0) {
+            for_each_bilinear_bin(p_placement.block_x_locs[blk_id], p_placement.block_y_locs[blk_id],
+                                  grid_width_, grid_height_,
+                                  [&](size_t x, size_t y, double weight) {
+                                      blk_field_x += weight * field_x[x][y];
+                                      blk_field_y += weight * field_y[x][y];
+                                  });
+        }
+        grad_x[blk_id] = -charge * blk_field_x;
+        grad_y[blk_id] = -charge * blk_field_y;
+    }
+#endif
+
+    if (total_charge_ == 0.0)
+        return 0.0;
+    return total_overflow / total_charge_;
+}
+
+/**
+ * @brief Helper method to print the header of the per-iteration status updates
+ *        of the electrostatic global placer.
+ */
+static void print_electrostatic_status_header() {
+    VTR_LOG("----  ----------------  --------  --------------  ----------  ----------\n");
+    VTR_LOG("Iter              HPWL  Overflow  Density Weight        Step  Total Time\n");
+    VTR_LOG("                                                                  (sec)\n");
+    VTR_LOG("----  ----------------  --------  --------------  ----------  ----------\n");
+}
+
+PartialPlacement ElectrostaticGlobalPlacer::place() {
+    // Create a timer to time the entire global placement time.
+    vtr::ScopedStartFinishTimer global_placer_time("AP Global Placer");
+    vtr::Timer runtime_timer;
+
+    // The major solution of Nesterov's method (the reference solution is
+    // created from the initial placement below).
+    PartialPlacement p_placement(ap_netlist_);
+    APDrawManager draw_manager(p_placement);
+
+    // Use the analytical solver to get the initial placement.
+    solver_->solve(0, p_placement);
+    draw_manager.update_graphics(0, APDrawType::Solver);
+    float timing_update_start_time = runtime_timer.elapsed_sec();
+    update_timing_info_with_gp_placement(pre_cluster_timing_manager_,
+                                         *place_delay_model_.get(),
+                                         p_placement,
+                                         ap_netlist_);
+    update_net_weights();
+    float total_time_spent_updating_timing = runtime_timer.elapsed_sec() - timing_update_start_time;
+    PartialPlacement ref_placement = p_placement;
+    PartialPlacement prev_ref_placement = p_placement;
+
+    size_t num_blocks = ap_netlist_.blocks().size();
+    vtr::vector<APBlockId, double> wl_grad_x(num_blocks, 0.0), wl_grad_y(num_blocks, 0.0);
+    vtr::vector<APBlockId, double> density_grad_x(num_blocks, 0.0), density_grad_y(num_blocks, 0.0);
+    vtr::vector<APBlockId, double> grad_x(num_blocks, 0.0), grad_y(num_blocks, 0.0);
+    vtr::vector<APBlockId, double> prev_grad_x(num_blocks, 0.0), prev_grad_y(num_blocks, 0.0);
+
+    // The smoothing of the WA model is relaxed when the overflow is high and
+    // tightened as the placement spreads out.
+    auto get_wa_gamma = [](double overflow) {
+        return 8.0 * std::pow(10.0, (20.0 / 9.0) * overflow - 11.0 / 9.0);
+    };
+
+    // Computes the preconditioned gradient of the objective at the reference
+    // solution, returning the overflow.
+    double density_weight = 0.0;
+    double gamma = 0.0;
+    auto compute_gradient = [&](bool init_density_weight) {
+        double overflow = compute_density_gradient(ref_placement, density_grad_x, density_grad_y);
+        gamma = get_wa_gamma(overflow);
+        compute_wirelength_gradient(ref_placement, gamma, wl_grad_x, wl_grad_y);
+
+        // Initially, weigh the density such that its gradient is as strong
+        // as the gradient of the wirelength.
+        if (init_density_weight) {
+            double wl_grad_norm = 0.0;
+            double density_grad_norm = 0.0;
+            for (APBlockId blk_id : ap_netlist_.blocks()) {
+                wl_grad_norm += std::abs(wl_grad_x[blk_id]) + std::abs(wl_grad_y[blk_id]);
+                density_grad_norm += std::abs(density_grad_x[blk_id]) + std::abs(density_grad_y[blk_id]);
+            }
+            density_weight = (density_grad_norm > 0.0) ? wl_grad_norm / density_grad_norm : 1.0;
+        }
+
+        // Precondition the gradient with the (approximate) diagonal of the
+        // Hessian: the number of pins of the block plus its weighted charge.
+        for (APBlockId blk_id : ap_netlist_.blocks()) {
+            double precond = std::max(1.0, ap_netlist_.block_pins(blk_id).size() + density_weight * block_charge_[blk_id]);
+            grad_x[blk_id] = (wl_grad_x[blk_id] + density_weight * density_grad_x[blk_id]) / precond;
+            grad_y[blk_id] = (wl_grad_y[blk_id] + density_weight * density_grad_y[blk_id]) / precond;
+        }
+        return overflow;
+    };
+
+    double max_x = static_cast<double>(grid_width_) - 0.001;
+    double max_y = static_cast<double>(grid_height_) - 0.001;
+
+    if (log_verbosity_ >= 1)
+        print_electrostatic_status_header();
+    double overflow = compute_gradient(true);
+    double nesterov_a = 1.0;
+    size_t num_iterations = 0;
+    for (size_t i = 0; i < max_num_iterations_ && overflow > target_overflow_; i++) {
+        // Predict the step length from the Lipschitz constant of the gradient,
+        // approximated by the change in the gradient between the reference
+        // solutions. The first step moves any block by at most one bin.
+        double step = 0.0;
+        if (i == 0) {
+            double max_grad = 0.0;
+            for (APBlockId blk_id : ap_netlist_.blocks())
+                max_grad = std::max({max_grad, std::abs(grad_x[blk_id]), std::abs(grad_y[blk_id])});
+            step = (max_grad > 0.0) ? 1.0 / max_grad : 1.0;
+        } else {
+            double ref_dist = 0.0;
+            double grad_dist = 0.0;
+            for (APBlockId blk_id : ap_netlist_.blocks()) {
+                double dx = ref_placement.block_x_locs[blk_id] - prev_ref_placement.block_x_locs[blk_id];
+                double dy = ref_placement.block_y_locs[blk_id] - prev_ref_placement.block_y_locs[blk_id];
+                double dgx = grad_x[blk_id] - prev_grad_x[blk_id];
+                double dgy = grad_y[blk_id] - prev_grad_y[blk_id];
+                ref_dist += dx * dx + dy * dy;
+                grad_dist += dgx * dgx + dgy * dgy;
+            }
+            if (grad_dist == 0.0)
+                break;
+            step = std::sqrt(ref_dist / grad_dist);
+        }
+
+        // Nesterov's update of the major and reference solutions.
+        double next_nesterov_a = (1.0 + std::sqrt(4.0 * nesterov_a * nesterov_a + 1.0)) / 2.0;
+        double momentum = (nesterov_a - 1.0) / next_nesterov_a;
+        prev_ref_placement = ref_placement;
+        for (APBlockId blk_id : ap_netlist_.blocks()) {
+            if (ap_netlist_.block_mobility(blk_id) == APBlockMobility::FIXED)
+                continue;
+            double new_x = std::clamp(prev_ref_placement.block_x_locs[blk_id] - step * grad_x[blk_id], 0.0, max_x);
+            double new_y = std::clamp(prev_ref_placement.block_y_locs[blk_id] - step * grad_y[blk_id], 0.0, max_y);
+            ref_placement.block_x_locs[blk_id] = std::clamp(new_x + momentum * (new_x - p_placement.block_x_locs[blk_id]), 0.0, max_x);
+            ref_placement.block_y_locs[blk_id] = std::clamp(new_y + momentum * (new_y - p_placement.block_y_locs[blk_id]), 0.0, max_y);
+            p_placement.block_x_locs[blk_id] = new_x;
+            p_placement.block_y_locs[blk_id] = new_y;
+        }
+        nesterov_a = next_nesterov_a;
+        num_iterations++;
+
+        // Periodically update the timing and the net weights.
+        if ((i + 1) % timing_update_interval_ == 0) {
+            timing_update_start_time = runtime_timer.elapsed_sec();
+            update_timing_info_with_gp_placement(pre_cluster_timing_manager_,
+                                                 *place_delay_model_.get(),
+                                                 p_placement,
+                                                 ap_netlist_);
+            update_net_weights();
+            total_time_spent_updating_timing += runtime_timer.elapsed_sec() - timing_update_start_time;
+            draw_manager.update_graphics(i + 1, APDrawType::Solver);
+        }
+
+        // Compute the gradient at the new reference solution.
+        prev_grad_x = grad_x;
+        prev_grad_y = grad_y;
+        density_weight *= density_weight_growth_;
+        overflow = compute_gradient(false);
+
+        if (log_verbosity_ >= 1 && (i % 10 == 0 || overflow <= target_overflow_)) {
+            VTR_LOG("%4zu  %16.2f  %8.4f  %14g  %10g  %10.3f\n",
+                    i,
+                    p_placement.get_hpwl(ap_netlist_),
+                    overflow,
+                    density_weight,
+                    step,
+                    runtime_timer.elapsed_sec());
+            fflush(stdout);
+        }
+    }
+    double lb_hpwl = p_placement.get_hpwl(ap_netlist_);
+
+    // Move the blocks into bins they are compatible with.
+    float legalizer_start_time = runtime_timer.elapsed_sec();
+    partial_legalizer_->legalize(p_placement);
+    float total_time_spent_in_legalizer = runtime_timer.elapsed_sec() - legalizer_start_time;
+    draw_manager.update_graphics(num_iterations, APDrawType::Legalizer);
+
+    timing_update_start_time = runtime_timer.elapsed_sec();
+    update_timing_info_with_gp_placement(pre_cluster_timing_manager_,
+                                         *place_delay_model_.get(),
+                                         p_placement,
+                                         ap_netlist_);
+    total_time_spent_updating_timing += runtime_timer.elapsed_sec() - timing_update_start_time;
+
+    // Print statistics on the partial legalizer used.
+    partial_legalizer_->print_statistics();
+
+    VTR_LOG("Global Placer Statistics:\n");
+    VTR_LOG("\tNumber of Nesterov iterations: %zu\n", num_iterations);
+    VTR_LOG("\tFinal overflow: %f\n", overflow);
+    VTR_LOG("\tHPWL before legalization: %f\n", lb_hpwl);
+    VTR_LOG("\tTime spent in legalizer: %g seconds\n", total_time_spent_in_legalizer);
+    VTR_LOG("\tTime spent updating timing: %g seconds\n", total_time_spent_updating_timing);
+
+    // Print some statistics on the final placement.
+    VTR_LOG("Placement after Global Placement:\n");
+    print_placement_stats(p_placement,
+                          ap_netlist_,
+                          *density_manager_,
+                          pre_cluster_timing_manager_);
+
+    return p_placement;
+}
@@ -15,8 +15,12 @@
 
 #include <memory>
 #include "ap_flow_enums.h"
+#include "ap_gpu_kernels.h"
+#include "electrostatic_field.h"
 #include "flat_placement_density_manager.h"
 #include "partial_legalizer.h"
+#include "vtr_ndmatrix.h"
+#include "vtr_vector.h"
 
 // Forward declarations
 class APNetlist;
@@ -74,7 +78,8 @@ class GlobalPlacer {
 /**
  * @brief A factory method which creates a Global Placer of the given type.
  */
-std::unique_ptr<GlobalPlacer> make_global_placer(e_ap_analytical_solver analytical_solver_type,
+std::unique_ptr<GlobalPlacer> make_global_placer(e_ap_global_placer global_placer_type,
+                                                 e_ap_analytical_solver analytical_solver_type,
                                                  e_ap_partial_legalizer partial_legalizer_type,
                                                  const APNetlist& ap_netlist,
                                                  const Prepacker& prepacker,
@@ -177,3 +182,162 @@ class SimPLGlobalPlacer : public GlobalPlacer {
      */
     PartialPlacement place() final;
 };
+
+/**
+ * @brief A Global Placer based on the electrostatics analogy of ePlace.
+ *          https://doi.org/10.1145/2699873
+ *
+ * The blocks are modeled as positive charges, and the density of the blocks
+ * over a grid of unit bins (one per tile location) as a charge density. The
+ * potential energy of the blocks, computed by solving Poisson's equation with
+ * spectral (cosine) transforms, is a smooth density penalty whose gradient is
+ * the electric field pushing the blocks out of the dense regions.
+ *
+ * The objective is the weighted-average (WA) wirelength plus the density
+ * penalty, scaled by a weight which grows every iteration. This objective is
+ * minimized with Nesterov's method, using a step length predicted from the
+ * Lipschitz constant of the gradient and a diagonal preconditioner, until the
+ * density overflow is small enough.
+ *
+ * The density is scalar: the charge of a block is its mass relative to the
+ * densest capacity of the device for the primitives it uses, and the capacity
+ * of a bin is how full it may get. This spreads blocks quickly, but does not
+ * know which tiles blocks can be placed into; so the analytical solver gives
+ * the initial placement, and the partial legalizer is run on the final
+ * placement to move the blocks into compatible bins.
+ */
+class ElectrostaticGlobalPlacer : public GlobalPlacer {
+  private:
+    /// @brief The maximum number of Nesterov iterations the placer performs.
+    static constexpr size_t max_num_iterations_ = 1000;
+
+    /// @brief The overflow (the fraction of the charge over the capacity of
+    ///        the bins) at which the placer stops.
+    static constexpr double target_overflow_ = 0.1;
+
+    /// @brief The factor the density weight grows by every iteration.
+    static constexpr double density_weight_growth_ = 1.05;
+
+    /// @brief The number of iterations between the updates of the timing
+    ///        information (and the net weights derived from it).
+    static constexpr size_t timing_update_interval_ = 50;
+
+    /// @brief The solver which generates the initial placement.
+    std::unique_ptr<AnalyticalSolver> solver_;
+
+    /// @brief The density manager, which holds the capacity of the device.
+    std::shared_ptr<FlatPlacementDensityManager> density_manager_;
+
+    /// @brief The legalizer which moves the blocks into compatible bins at
+    ///        the end of global placement.
+    std::unique_ptr<PartialLegalizer> partial_legalizer_;
+
+    /// @brief The atom netlist the AP netlist was built from.
+    const AtomNetlist& atom_netlist_;
+
+    /// @brief The pre-cluster timing manager which manages how the timing of
+    ///        the netlist is computed.
+    PreClusterTimingManager& pre_cluster_timing_manager_;
+
+    /// @brief A placement delay model which is used to help compute the delays
+    ///        of connections in the AP netlist.
+    std::shared_ptr<PlaceDelayModel> place_delay_model_;
+
+    /// @brief Trade-off between wirelength and timing in the net weights.
+    float ap_timing_tradeoff_;
+
+    /// @brief The solver for the potential and field of the density.
+    std::unique_ptr<ElectrostaticFieldSolver> field_solver_;
+
+    /// @brief The number of unit bins in the x and y dimensions.
+    size_t grid_width_ = 0;
+    size_t grid_height_ = 0;
+
+    /// @brief The capacity of each unit bin, indexed [x][y].
+    vtr::NdMatrix<double, 2> bin_supply_;
+
+    /// @brief The charge density of each unit bin, indexed [x][y].
+    vtr::NdMatrix<double, 2> bin_density_;
+
+    /// @brief The charge of each moveable block (zero for fixed blocks).
+    vtr::vector<APBlockId, double> block_charge_;
+
+    /// @brief The total charge of the moveable blocks.
+    double total_charge_ = 0.0;
+
+    /// @brief The factor which scales the capacity of the bins down to the
+    ///        total charge, when there is more capacity than charge.
+    double supply_scale_ = 1.0;
+
+    /// @brief The weight of each net in the wirelength.
+    vtr::vector<APNetId, double> net_weights_;
+
+#ifdef VPR_USE_CUDA
+    /// @brief The GPU implementation of the wirelength and density kernels.
+    std::unique_ptr<APGpuKernels> gpu_kernels_;
+
+    /**
+     * @brief Uploads the netlist and the charges of the blocks to the GPU.
+     */
+    void init_gpu_kernels();
+#endif
+
+    /**
+     * @brief Computes the charge of every block and the capacity of every
+     *        unit bin from the masses and capacities of the density manager.
+     */
+    void init_charges_and_supply();
+
+    /**
+     * @brief Updates the weight of each net from its criticality.
+     */
+    void update_net_weights();
+
+    /**
+     * @brief Computes the gradient of the WA wirelength of the placement.
+     *
+     *  @param gamma    The smoothing parameter of the WA model.
+     */
+    void compute_wirelength_gradient(const PartialPlacement& p_placement,
+                                     double gamma,
+                                     vtr::vector<APBlockId, double>& grad_x,
+                                     vtr::vector<APBlockId, double>& grad_y) const;
+
+    /**
+     * @brief Computes the gradient of the density penalty of the placement
+     *        (the potential energy of the blocks).
+     *
+     *  @return The overflow of the placement.
+     */
+    double compute_density_gradient(const PartialPlacement& p_placement,
+                                    vtr::vector<APBlockId, double>& grad_x,
+                                    vtr::vector<APBlockId, double>& grad_y);
+
+  public:
+    /**
+     * @brief Constructor for the Electrostatic Global Placer
+     *
+     * Constructs the solver, density manager and partial legalizer.
+     */
+    ElectrostaticGlobalPlacer(e_ap_analytical_solver analytical_solver_type,
+                              e_ap_partial_legalizer partial_legalizer_type,
+                              const APNetlist& ap_netlist,
+                              const Prepacker& prepacker,
+                              const AtomNetlist& atom_netlist,
+                              const DeviceGrid& device_grid,
+                              const std::vector<t_logical_block_type>& logical_block_types,
+                              const std::vector<t_physical_tile_type>& physical_tile_types,
+                              const LogicalModels& models,
+                              PreClusterTimingManager& pre_cluster_timing_manager,
+                              std::shared_ptr<PlaceDelayModel> place_delay_model,
+                              float ap_timing_tradeoff,
+                              bool generate_mass_report,
+                              const std::vector<std::string>& target_density_arg_strs,
+                              unsigned num_threads,
+                              int log_verbosity);
+
+    /**
+     * @brief Run the electrostatic global placement algorithm.
+     */
+    PartialPlacement place() final;
+};
@@ -41,6 +41,11 @@
 #include "vtr_vector.h"
 #include "vtr_vector_map.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_invoke.h>
+#endif
+
 std::unique_ptr<PartialLegalizer> make_partial_legalizer(e_ap_partial_legalizer legalizer_type,
                                                          const APNetlist& netlist,
                                                          std::shared_ptr<FlatPlacementDensityManager> density_manager,
@@ -694,10 +699,13 @@ PerPrimitiveDimPrefixSum2D::PerPrimitiveDimPrefixSum2D(const FlatPlacementDensit
     size_t width, height, layers;
     std::tie(width, height, layers) = density_manager.get_overall_placeable_region_size();
 
-    // Create each of the prefix sums.
+    // Create each of the prefix sums. The prefix sums of the dims are
+    // independent, so they are built in parallel.
     const PrimitiveDimManager& dim_manager = density_manager.mass_calculator().get_dim_manager();
     dim_prefix_sum_.resize(dim_manager.dims().size());
-    for (PrimitiveVectorDim dim : density_manager.get_used_dims_mask().get_non_zero_dims()) {
+    std::vector<PrimitiveVectorDim> used_dims = density_manager.get_used_dims_mask().get_non_zero_dims();
+    auto build_dim_prefix_sum = [&](size_t dim_idx) {
+        PrimitiveVectorDim dim = used_dims[dim_idx];
         dim_prefix_sum_[dim] = vtr::PrefixSum2D<uint64_t>(
             width,
             height,
@@ -711,7 +719,13 @@ PerPrimitiveDimPrefixSum2D::PerPrimitiveDimPrefixSum2D(const FlatPlacementDensit
                                     "PerPrimitiveDimPrefixSum2D expected to only hold positive values");
                 return std::ceil(val * fractional_scale_);
             });
-    }
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), used_dims.size(), build_dim_prefix_sum);
+#else
+    for (size_t dim_idx = 0; dim_idx < used_dims.size(); dim_idx++)
+        build_dim_prefix_sum(dim_idx);
+#endif
 }
 
 float PerPrimitiveDimPrefixSum2D::get_dim_sum(PrimitiveVectorDim dim,
@@ -1404,61 +1418,35 @@ void BiPartitioningPartialLegalizer::spread_over_windows(std::vector<SpreadingWi
         }
     }
 
-    // Insert the windows into a queue for spreading.
-    std::queue<SpreadingWindow> window_queue;
-    for (SpreadingWindow& window : non_overlapping_windows) {
-        window_queue.push(std::move(window));
-    }
+    // Spread each of the windows. The windows do not overlap and do not share
+    // any blocks, so they are spread in parallel. Each window collects its own
+    // finished windows, which are then concatenated in order to keep the
+    // result deterministic.
+    size_t num_windows = non_overlapping_windows.size();
+    std::vector<std::vector<SpreadingWindow>> finished_windows_per_window(num_windows);
+    std::vector<unsigned> num_windows_partitioned(num_windows, 0);
+    std::vector<unsigned> num_blocks_partitioned(num_windows, 0);
+    auto spread_non_overlapping_window = [&](size_t window_idx) {
+        spread_window(non_overlapping_windows[window_idx],
+                      p_placement,
+                      group_id,
+                      finished_windows_per_window[window_idx],
+                      num_windows_partitioned[window_idx],
+                      num_blocks_partitioned[window_idx]);
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num_windows, spread_non_overlapping_window);
+#else
+    for (size_t window_idx = 0; window_idx < num_windows; window_idx++)
+        spread_non_overlapping_window(window_idx);
+#endif
 
-    // For each window in the queue:
-    //      1) If the window is small enough, do not partition further.
-    //      2) Partition the window
-    //      3) Partition the blocks into the window partitions
-    //      4) Insert the new windows into the queue
     std::vector<SpreadingWindow> finished_windows;
-    while (!window_queue.empty()) {
-        // Get a reference to the front of the queue but do not pop it yet. We
-        // can save time from having to copy the element out since these windows
-        // contain vectors.
-        SpreadingWindow& window = window_queue.front();
-
-        // Check if the window is empty. This can happen when there is odd
-        // numbers of blocks or when things do not perfectly fit.
-        if (window.contained_blocks.empty()) {
-            // If the window does not contain any blocks, pop it from the queue
-            // and do not put it in finished windows. There is no point
-            // operating on it further.
-            window_queue.pop();
-            continue;
-        }
-
-        // 1) Check if the window is small enough (one bin in size).
-        // TODO: Perhaps we can make this stopping criteria more intelligent.
-        //       Like stopping when we know there is only one bin within the
-        //       window.
-        double window_area = window.region.width() * window.region.height();
-        if (window_area <= 1.0) {
+    for (size_t window_idx = 0; window_idx < num_windows; window_idx++) {
+        for (SpreadingWindow& window : finished_windows_per_window[window_idx])
             finished_windows.emplace_back(std::move(window));
-            window_queue.pop();
-            continue;
-        }
-
-        num_windows_partitioned_++;
-        num_blocks_partitioned_ += window.contained_blocks.size();
-
-        // 2) Partition the window.
-        auto partitioned_window = partition_window(window, group_id);
-
-        // 3) Partition the blocks.
-        partition_blocks_in_window(window, partitioned_window, group_id, p_placement);
-
-        // 4) Enqueue the new windows.
-        window_queue.push(std::move(partitioned_window.lower_window));
-        window_queue.push(std::move(partitioned_window.upper_window));
-
-        // Pop the top element off the queue. This will invalidate the window
-        // object.
-        window_queue.pop();
+        num_windows_partitioned_ += num_windows_partitioned[window_idx];
+        num_blocks_partitioned_ += num_blocks_partitioned[window_idx];
     }
 
     if (log_verbosity_ >= 10) {
@@ -1494,6 +1482,75 @@ void BiPartitioningPartialLegalizer::spread_over_windows(std::vector<SpreadingWi
     VTR_ASSERT_SAFE(density_manager_->verify());
 }
 
+/// @brief The minimum number of blocks a window must contain for its
+///        sub-windows to be spread as parallel tasks. Smaller windows are
+///        spread serially since they are not worth the overhead of a task.
+static constexpr size_t MIN_NUM_BLOCKS_FOR_PARALLEL_SPREADING = 512;
+
+void BiPartitioningPartialLegalizer::spread_window(SpreadingWindow& window,
+                                                   const PartialPlacement& p_placement,
+                                                   PrimitiveGroupId group_id,
+                                                   std::vector<SpreadingWindow>& finished_windows,
+                                                   unsigned& num_windows_partitioned,
+                                                   unsigned& num_blocks_partitioned) {
+    // Check if the window is empty. This can happen when there is odd
+    // numbers of blocks or when things do not perfectly fit. There is no point
+    // operating on it further, so do not put it in finished windows.
+    if (window.contained_blocks.empty())
+        return;
+
+    // 1) Check if the window is small enough (one bin in size).
+    // TODO: Perhaps we can make this stopping criteria more intelligent.
+    //       Like stopping when we know there is only one bin within the
+    //       window.
+    double window_area = window.region.width() * window.region.height();
+    if (window_area <= 1.0) {
+        finished_windows.emplace_back(std::move(window));
+        return;
+    }
+
+    num_windows_partitioned++;
+    num_blocks_partitioned += window.contained_blocks.size();
+    size_t num_window_blocks = window.contained_blocks.size();
+
+    // 2) Partition the window.
+    auto partitioned_window = partition_window(window, group_id);
+
+    // 3) Partition the blocks.
+    partition_blocks_in_window(window, partitioned_window, group_id, p_placement);
+
+    // 4) Spread the two sub-windows. They do not share any blocks or bins, so
+    //    large windows are spread in parallel. The finished windows of the
+    //    upper window are appended after those of the lower window.
+#ifdef VPR_USE_TBB
+    if (num_window_blocks >= MIN_NUM_BLOCKS_FOR_PARALLEL_SPREADING) {
+        std::vector<SpreadingWindow> upper_finished_windows;
+        unsigned upper_num_windows_partitioned = 0;
+        unsigned upper_num_blocks_partitioned = 0;
+        tbb::parallel_invoke(
+            [&]() {
+                spread_window(partitioned_window.lower_window, p_placement, group_id,
+                              finished_windows, num_windows_partitioned, num_blocks_partitioned);
+            },
+            [&]() {
+                spread_window(partitioned_window.upper_window, p_placement, group_id,
+                              upper_finished_windows, upper_num_windows_partitioned, upper_num_blocks_partitioned);
+            });
+        for (SpreadingWindow& upper_finished_window : upper_finished_windows)
+            finished_windows.emplace_back(std::move(upper_finished_window));
+        num_windows_partitioned += upper_num_windows_partitioned;
+        num_blocks_partitioned += upper_num_blocks_partitioned;
+        return;
+    }
+#else
+    (void)num_window_blocks;
+#endif
+    spread_window(partitioned_window.lower_window, p_placement, group_id,
+                  finished_windows, num_windows_partitioned, num_blocks_partitioned);
+    spread_window(partitioned_window.upper_window, p_placement, group_id,
+                  finished_windows, num_windows_partitioned, num_blocks_partitioned);
+}
+
 PartitionedWindow BiPartitioningPartialLegalizer::partition_window(
     SpreadingWindow& window,
     PrimitiveGroupId group_id) {
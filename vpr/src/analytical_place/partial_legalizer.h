@@ -595,6 +595,22 @@ class BiPartitioningPartialLegalizer : public PartialLegalizer {
                              const PartialPlacement& p_placement,
                              PrimitiveGroupId group_id);
 
+    /**
+     * @brief Recursively partition the given window until its sub-windows are
+     *        small enough, appending them to finished_windows.
+     *
+     * The two sub-windows of a partition are independent, so large windows
+     * are spread in parallel when VPR is built with TBB. The number of windows
+     * and blocks partitioned are added to the given counters, since the
+     * members can not be updated from parallel tasks.
+     */
+    void spread_window(SpreadingWindow& window,
+                       const PartialPlacement& p_placement,
+                       PrimitiveGroupId group_id,
+                       std::vector<SpreadingWindow>& finished_windows,
+                       unsigned& num_windows_partitioned,
+                       unsigned& num_blocks_partitioned);
+
     /**
      * @brief Partition the given window into two sub-windows.
      *
@@ -0,0 +1,131 @@
+/**
+ * @file
+ * @brief   Implementation of the PartialPlacement checkpoint files.
+ */
+
+#include "partial_placement_checkpoint.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include "ap_netlist.h"
+#include "partial_placement.h"
+#include "vpr_error.h"
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/// @brief The magic bytes at the start of every checkpoint file. The last
+///        character is the version of the format.
+static constexpr char CHECKPOINT_MAGIC[8] = {'V', 'P', 'R', 'A', 'P', 'P', 'P', '1'};
+
+/**
+ * @brief Compute the fingerprint of the given netlist.
+ *
+ * This is the 64-bit FNV-1a hash of the names of the blocks, in order. This is
+ * stable across builds, unlike std::hash.
+ */
+static uint64_t compute_netlist_fingerprint(const APNetlist& ap_netlist) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto hash_byte = [&](unsigned char byte) {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    };
+    for (APBlockId blk_id : ap_netlist.blocks()) {
+        for (char c : ap_netlist.block_name(blk_id))
+            hash_byte(static_cast<unsigned char>(c));
+        // Separate the names such that ("ab", "c") and ("a", "bc") differ.
+        hash_byte(0);
+    }
+    return hash;
+}
+
+/**
+ * @brief Write the raw bytes of the given values to the stream.
+ */
+template<typename T>
+static void write_values(std::ofstream& os, const T* values, size_t num_values) {
+    os.write(reinterpret_cast<const char*>(values), sizeof(T) * num_values);
+}
+
+/**
+ * @brief Read the raw bytes of the given values from the stream.
+ */
+template<typename T>
+static void read_values(std::ifstream& is, T* values, size_t num_values) {
+    is.read(reinterpret_cast<char*>(values), sizeof(T) * num_values);
+}
+
+void write_partial_placement_checkpoint(const std::string& file_path,
+                                        const PartialPlacement& p_placement,
+                                        const APNetlist& ap_netlist) {
+    std::ofstream os(file_path, std::ios::binary);
+    if (!os) {
+        VPR_FATAL_ERROR(VPR_ERROR_AP,
+                        "Unable to open partial placement checkpoint file '%s' for writing.\n",
+                        file_path.c_str());
+    }
+
+    uint64_t num_blocks = ap_netlist.blocks().size();
+    uint64_t fingerprint = compute_netlist_fingerprint(ap_netlist);
+    os.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    write_values(os, &num_blocks, 1);
+    write_values(os, &fingerprint, 1);
+
+    write_values(os, p_placement.block_x_locs.data(), num_blocks);
+    write_values(os, p_placement.block_y_locs.data(), num_blocks);
+    write_values(os, p_placement.block_layer_nums.data(), num_blocks);
+    std::vector<int32_t> sub_tiles(p_placement.block_sub_tiles.begin(), p_placement.block_sub_tiles.end());
+    write_values(os, sub_tiles.data(), num_blocks);
+
+    os.close();
+    if (!os) {
+        VPR_FATAL_ERROR(VPR_ERROR_AP,
+                        "Failed to write partial placement checkpoint file '%s'.\n",
+                        file_path.c_str());
+    }
+    VTR_LOG("Wrote partial placement checkpoint '%s'.\n", file_path.c_str());
+}
+
+void read_partial_placement_checkpoint(const std::string& file_path,
+                                       PartialPlacement& p_placement,
+                                       const APNetlist& ap_netlist) {
+    std::ifstream is(file_path, std::ios::binary);
+    if (!is) {
+        VPR_FATAL_ERROR(VPR_ERROR_AP,
+                        "Unable to open partial placement checkpoint file '%s'.\n",
+                        file_path.c_str());
+    }
+
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    uint64_t num_blocks = 0;
+    uint64_t fingerprint = 0;
+    is.read(magic, sizeof(magic));
+    read_values(is, &num_blocks, 1);
+    read_values(is, &fingerprint, 1);
+    if (!is || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_AP,
+                        "'%s' is not a partial placement checkpoint file.\n",
+                        file_path.c_str());
+    }
+    if (num_blocks != ap_netlist.blocks().size() || fingerprint != compute_netlist_fingerprint(ap_netlist)) {
+        VPR_FATAL_ERROR(VPR_ERROR_AP,
+                        "Partial placement checkpoint file '%s' was created from a different netlist.\n",
+                        file_path.c_str());
+    }
+
+    VTR_ASSERT(p_placement.block_x_locs.size() == num_blocks);
+    read_values(is, p_placement.block_x_locs.data(), num_blocks);
+    read_values(is, p_placement.block_y_locs.data(), num_blocks);
+    read_values(is, p_placement.block_layer_nums.data(), num_blocks);
+    std::vector<int32_t> sub_tiles(num_blocks);
+    read_values(is, sub_tiles.data(), num_blocks);
+    if (!is) {
+        VPR_FATAL_ERROR(VPR_ERROR_AP,
+                        "Partial placement checkpoint file '%s' is truncated.\n",
+                        file_path.c_str());
+    }
+    for (size_t i = 0; i < num_blocks; i++)
+        p_placement.block_sub_tiles[APBlockId(i)] = sub_tiles[i];
+
+    VTR_LOG("Read partial placement checkpoint '%s'.\n", file_path.c_str());
+}
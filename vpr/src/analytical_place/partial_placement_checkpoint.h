@@ -0,0 +1,52 @@
+#pragma once
+/**
+ * @file
+ * @brief   Save and restore a PartialPlacement to / from a binary checkpoint
+ *          file.
+ *
+ * A checkpoint stores the placement of every APBlock after global placement,
+ * so the later stages of the AP flow (the full legalizer and the detailed
+ * placer) can be re-run from it without re-running global placement.
+ *
+ * The file is a small header followed by the locations of the blocks in the
+ * order of the APNetlist:
+ *      magic           8 bytes ("VPRAPPP1")
+ *      num_blocks      uint64
+ *      fingerprint     uint64, hash of the names of the blocks
+ *      x, y, layer     num_blocks doubles each
+ *      sub_tile        num_blocks int32
+ * The fingerprint is used to reject checkpoints created from a different
+ * netlist. The values are stored in the native byte order, so checkpoints are
+ * only meant to be read back on the same machine.
+ */
+
+#include <string>
+
+class APNetlist;
+struct PartialPlacement;
+
+/**
+ * @brief Write the given partial placement to a checkpoint file.
+ *
+ *  @param file_path    The file to write the checkpoint to.
+ *  @param p_placement  The placement to save.
+ *  @param ap_netlist   The APNetlist the placement is for.
+ */
+void write_partial_placement_checkpoint(const std::string& file_path,
+                                        const PartialPlacement& p_placement,
+                                        const APNetlist& ap_netlist);
+
+/**
+ * @brief Read a partial placement from a checkpoint file.
+ *
+ * Errors out if the file can not be read or was not created from the given
+ * APNetlist.
+ *
+ *  @param file_path    The checkpoint file to read.
+ *  @param p_placement  The placement to restore into. Must be constructed from
+ *                      ap_netlist.
+ *  @param ap_netlist   The APNetlist the placement is for.
+ */
+void read_partial_placement_checkpoint(const std::string& file_path,
+                                       PartialPlacement& p_placement,
+                                       const APNetlist& ap_netlist);
@@ -5,7 +5,7 @@
  * @date    October 2024
  * @brief   The declaration of the PrimitiveVector object.
  *
- * This object is designed to store a sparse M-dimensional vector which can be
+ * This object is designed to store an M-dimensional vector which can be
  * efficiently operated upon.
  *
  * Each dimensions of this vector is indexed using a PrimitiveVectorDim. These
@@ -17,17 +17,18 @@
  * available dims and lookups between the models and the dims.
  */
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <vector>
 #include "vtr_log.h"
-#include "vtr_vector.h"
 
 #include "primitive_vector_fwd.h"
 
 /**
- * @brief A sparse vector class to store an M-dimensional quantity of primitives
- *        in the context of a legalizer.
+ * @brief A vector class to store an M-dimensional quantity of primitives in the
+ *        context of a legalizer.
  *
  * This vector is used to represent the capacity of tiles for different
  * primitives in a closed form which can be manipulated with math operations.
@@ -40,18 +41,54 @@
  *
  * This class contains useful operations to operate and compare different
  * Primitive Vectors.
+ *
+ * The first dimensions are stored densely in a fixed-size array inside of the
+ * object, so copying a vector does not allocate and the operations on these
+ * dimensions are fixed-length loops which the compiler can vectorize. The
+ * mass calculator creates the dimensions it uses in order starting from 0,
+ * so for most architectures all dimensions fit in the array. Any dimensions
+ * past the array are stored in an overflow vector which only grows if they
+ * are used.
  */
 class PrimitiveVector {
   private:
-    /// @brief Storage container for the data of this primitive vector.
+    /// @brief The number of dimensions stored in the fixed-size array. 16
+    ///        floats fill one cache line.
+    static constexpr size_t num_inline_dims_ = 16;
+
+    /// @brief Storage for the first num_inline_dims_ dimensions of this
+    ///        primitive vector. Unused dimensions are zero.
+    std::array<float, num_inline_dims_> inline_data_ = {};
+
+    /// @brief Storage for the dimensions past the fixed-size array, indexed
+    ///        by the dimension minus num_inline_dims_.
     ///
-    /// Although it is assumed that the primitive vector will be quite sparse,
-    /// found that using an unordered map was slower than just directly using
-    /// a vector and leaving them empty. Instead, using a vector; but outside
-    /// of this class, we are careful to try and keep the most used information
-    /// in the early dimensions of this array so the vector can remain small in
-    /// length and only grow if it needs to.
-    vtr::vector<PrimitiveVectorDim, float> data_;
+    /// This is kept as small as possible and is only grown when a dimension
+    /// past its end is written to.
+    std::vector<float> overflow_data_;
+
+    /**
+     * @brief Get the value at the given index of the overflow data.
+     */
+    inline float get_overflow_val(size_t i) const {
+        if (i >= overflow_data_.size())
+            return 0.0f;
+        return overflow_data_[i];
+    }
+
+    /**
+     * @brief Get a reference to the value at the given dimension, growing the
+     *        overflow data if needed.
+     */
+    inline float& get_dim_ref(PrimitiveVectorDim dim) {
+        size_t i = (size_t)dim;
+        if (i < num_inline_dims_)
+            return inline_data_[i];
+        i -= num_inline_dims_;
+        if (i >= overflow_data_.size())
+            overflow_data_.resize(i + 1, 0.0f);
+        return overflow_data_[i];
+    }
 
   public:
     /**
@@ -60,36 +97,31 @@ class PrimitiveVector {
      * This is a common enough feature to use its own setter.
      */
     inline void add_val_to_dim(float val, PrimitiveVectorDim dim) {
-        if ((size_t)dim >= data_.size())
-            data_.resize((size_t)dim + 1, 0.0f);
-        data_[dim] += val;
+        get_dim_ref(dim) += val;
     }
 
     /**
      * @brief Subtract the value to the given dimension.
      */
     inline void subtract_val_from_dim(float val, PrimitiveVectorDim dim) {
-        if ((size_t)dim >= data_.size())
-            data_.resize((size_t)dim + 1, 0.0f);
-        data_[dim] -= val;
+        get_dim_ref(dim) -= val;
     }
 
     /**
      * @brief Get the value at the given dimension.
      */
     inline float get_dim_val(PrimitiveVectorDim dim) const {
-        if ((size_t)dim >= data_.size())
-            return 0.0f;
-        return data_[dim];
+        size_t i = (size_t)dim;
+        if (i < num_inline_dims_)
+            return inline_data_[i];
+        return get_overflow_val(i - num_inline_dims_);
     }
 
     /**
      * @brief Set the value at the given dimension.
      */
     inline void set_dim_val(PrimitiveVectorDim dim, float val) {
-        if ((size_t)dim >= data_.size())
-            data_.resize((size_t)dim + 1, 0.0f);
-        data_[dim] = val;
+        get_dim_ref(dim) = val;
     }
 
     /**
@@ -98,11 +130,14 @@ class PrimitiveVector {
      * Returns true if the dimensions of each vector are equal.
      */
     inline bool operator==(const PrimitiveVector& rhs) const {
-        size_t num_elem_to_check = std::max(rhs.data_.size(), data_.size());
-        // Check if every dim in rhs matches this.
+        bool is_different = false;
+        for (size_t i = 0; i < num_inline_dims_; i++)
+            is_different |= (inline_data_[i] != rhs.inline_data_[i]);
+        if (is_different)
+            return false;
+        size_t num_elem_to_check = std::max(rhs.overflow_data_.size(), overflow_data_.size());
         for (size_t i = 0; i < num_elem_to_check; i++) {
-            PrimitiveVectorDim dim = (PrimitiveVectorDim)i;
-            if (get_dim_val(dim) != rhs.get_dim_val(dim))
+            if (get_overflow_val(i) != rhs.get_overflow_val(i))
                 return false;
         }
         return true;
@@ -119,10 +154,12 @@ class PrimitiveVector {
      * @brief Element-wise accumulation of rhs into this.
      */
     inline PrimitiveVector& operator+=(const PrimitiveVector& rhs) {
-        for (size_t i = 0; i < rhs.data_.size(); i++) {
-            PrimitiveVectorDim dim = (PrimitiveVectorDim)i;
-            add_val_to_dim(rhs.get_dim_val(dim), dim);
-        }
+        for (size_t i = 0; i < num_inline_dims_; i++)
+            inline_data_[i] += rhs.inline_data_[i];
+        if (rhs.overflow_data_.size() > overflow_data_.size())
+            overflow_data_.resize(rhs.overflow_data_.size(), 0.0f);
+        for (size_t i = 0; i < rhs.overflow_data_.size(); i++)
+            overflow_data_[i] += rhs.overflow_data_[i];
         return *this;
     }
 
@@ -139,10 +176,12 @@ class PrimitiveVector {
      * @brief Element-wise de-accumulation of rhs into this.
      */
     inline PrimitiveVector& operator-=(const PrimitiveVector& rhs) {
-        for (size_t i = 0; i < rhs.data_.size(); i++) {
-            PrimitiveVectorDim dim = (PrimitiveVectorDim)i;
-            subtract_val_from_dim(rhs.get_dim_val(dim), dim);
-        }
+        for (size_t i = 0; i < num_inline_dims_; i++)
+            inline_data_[i] -= rhs.inline_data_[i];
+        if (rhs.overflow_data_.size() > overflow_data_.size())
+            overflow_data_.resize(rhs.overflow_data_.size(), 0.0f);
+        for (size_t i = 0; i < rhs.overflow_data_.size(); i++)
+            overflow_data_[i] -= rhs.overflow_data_[i];
         return *this;
     }
 
@@ -159,7 +198,10 @@ class PrimitiveVector {
      * @brief Element-wise multiplication with a scalar.
      */
     inline PrimitiveVector& operator*=(float rhs) {
-        for (auto& p : data_) {
+        for (float& p : inline_data_) {
+            p *= rhs;
+        }
+        for (float& p : overflow_data_) {
             p *= rhs;
         }
         return *this;
@@ -169,7 +211,10 @@ class PrimitiveVector {
      * @brief Element-wise division with a scalar.
      */
     inline PrimitiveVector& operator/=(float rhs) {
-        for (auto& p : data_) {
+        for (float& p : inline_data_) {
+            p /= rhs;
+        }
+        for (float& p : overflow_data_) {
             p /= rhs;
         }
         return *this;
@@ -190,10 +235,14 @@ class PrimitiveVector {
      */
     inline bool operator<(const PrimitiveVector& rhs) const {
         // Check for any element of this < rhs
-        size_t num_elem_to_check = std::max(rhs.data_.size(), data_.size());
+        bool is_less = false;
+        for (size_t i = 0; i < num_inline_dims_; i++)
+            is_less |= (inline_data_[i] < rhs.inline_data_[i]);
+        if (is_less)
+            return true;
+        size_t num_elem_to_check = std::max(rhs.overflow_data_.size(), overflow_data_.size());
         for (size_t i = 0; i < num_elem_to_check; i++) {
-            PrimitiveVectorDim dim = (PrimitiveVectorDim)i;
-            if (get_dim_val(dim) < rhs.get_dim_val(dim))
+            if (get_overflow_val(i) < rhs.get_overflow_val(i))
                 return true;
         }
         return false;
@@ -206,9 +255,11 @@ class PrimitiveVector {
      * is positive, it will not change.
      */
     inline void relu() {
-        for (float& val : data_) {
-            if (val < 0.0f)
-                val = 0.0f;
+        for (float& val : inline_data_) {
+            val = std::max(val, 0.0f);
+        }
+        for (float& val : overflow_data_) {
+            val = std::max(val, 0.0f);
         }
     }
 
@@ -216,9 +267,12 @@ class PrimitiveVector {
      * @brief Returns true if all dimensions of this vector are zero.
      */
     inline bool is_zero() const {
-        // NOTE: This can be made cheaper by storing this information at
-        //       creation and updating it if values are added or removed.
-        for (float p : data_) {
+        bool is_non_zero = false;
+        for (float p : inline_data_)
+            is_non_zero |= (p != 0.f);
+        if (is_non_zero)
+            return false;
+        for (float p : overflow_data_) {
             if (p != 0.f)
                 return false;
         }
@@ -236,7 +290,12 @@ class PrimitiveVector {
      * @brief Returns true if all dimensions of this vector are non-negative.
      */
     inline bool is_non_negative() const {
-        for (float p : data_) {
+        bool is_negative = false;
+        for (float p : inline_data_)
+            is_negative |= (p < 0.f);
+        if (is_negative)
+            return false;
+        for (float p : overflow_data_) {
             if (p < 0.f)
                 return false;
         }
@@ -249,11 +308,11 @@ class PrimitiveVector {
      * This is the sum of the absolute value of all dimensions.
      */
     inline float manhattan_norm() const {
-        // NOTE: This can be made much cheaper by storing the magnitude as part
-        //       of the class and updating it whenever something is added or
-        //       removed.
         float mag = 0.f;
-        for (float p : data_) {
+        for (float p : inline_data_) {
+            mag += std::abs(p);
+        }
+        for (float p : overflow_data_) {
             mag += std::abs(p);
         }
         return mag;
@@ -267,7 +326,10 @@ class PrimitiveVector {
      */
     inline float sum() const {
         float sum = 0.f;
-        for (float p : data_) {
+        for (float p : inline_data_) {
+            sum += p;
+        }
+        for (float p : overflow_data_) {
             sum += p;
         }
         return sum;
@@ -284,17 +346,20 @@ class PrimitiveVector {
     inline void project(const PrimitiveVector& dir) {
         // For each dimension of this vector, if that dimension is zero in dir
         // set the dimension to zero.
-        size_t last_non_zero_dim = 0;
-        for (size_t i = 0; i < data_.size(); i++) {
-            PrimitiveVectorDim dim = (PrimitiveVectorDim)i;
-            if (dir.get_dim_val(dim) == 0.0f)
-                data_[dim] = 0.0f;
+        for (size_t i = 0; i < num_inline_dims_; i++) {
+            if (dir.inline_data_[i] == 0.0f)
+                inline_data_[i] = 0.0f;
+        }
+        size_t num_overflow_dims = 0;
+        for (size_t i = 0; i < overflow_data_.size(); i++) {
+            if (dir.get_overflow_val(i) == 0.0f)
+                overflow_data_[i] = 0.0f;
             else
-                last_non_zero_dim = i;
+                num_overflow_dims = i + 1;
         }
-        // Resize the vector to the last non-zero dim. This can improve performance
-        // by keeping the size of vectors as small as possible.
-        data_.resize(last_non_zero_dim + 1);
+        // Shrink the overflow data to the last dim in dir. This can improve
+        // performance by keeping the size of vectors as small as possible.
+        overflow_data_.resize(num_overflow_dims);
     }
 
     /**
@@ -302,10 +367,13 @@ class PrimitiveVector {
      */
     inline std::vector<PrimitiveVectorDim> get_non_zero_dims() const {
         std::vector<PrimitiveVectorDim> non_zero_dims;
-        for (size_t i = 0; i < data_.size(); i++) {
-            PrimitiveVectorDim dim = (PrimitiveVectorDim)i;
-            if (data_[dim] != 0.0f)
-                non_zero_dims.push_back(dim);
+        for (size_t i = 0; i < num_inline_dims_; i++) {
+            if (inline_data_[i] != 0.0f)
+                non_zero_dims.push_back((PrimitiveVectorDim)i);
+        }
+        for (size_t i = 0; i < overflow_data_.size(); i++) {
+            if (overflow_data_[i] != 0.0f)
+                non_zero_dims.push_back((PrimitiveVectorDim)(i + num_inline_dims_));
         }
         return non_zero_dims;
     }
@@ -314,12 +382,16 @@ class PrimitiveVector {
      * @brief Returns true if this and other do not share any non-zero dimensions.
      */
     inline bool are_dims_disjoint(const PrimitiveVector& other) const {
-        size_t dims_to_check = std::min(data_.size(), other.data_.size());
+        // If this and other both have a shared dimension, then they are not
+        // perpendicular.
+        bool shares_dim = false;
+        for (size_t i = 0; i < num_inline_dims_; i++)
+            shares_dim |= (inline_data_[i] != 0.0f && other.inline_data_[i] != 0.0f);
+        if (shares_dim)
+            return false;
+        size_t dims_to_check = std::min(overflow_data_.size(), other.overflow_data_.size());
         for (size_t i = 0; i < dims_to_check; i++) {
-            PrimitiveVectorDim dim = (PrimitiveVectorDim)i;
-            // If this and other both have a shared dimension, then they are not
-            // perpendicular.
-            if (other.get_dim_val(dim) != 0.0f && get_dim_val(dim) != 0.0f) {
+            if (other.overflow_data_[i] != 0.0f && overflow_data_[i] != 0.0f) {
                 return false;
             }
         }
@@ -328,11 +400,12 @@ class PrimitiveVector {
     }
 
     /**
-     * @brief Clear the sparse vector, which is equivalent to setting it to be
-     *        the zero vector.
+     * @brief Clear the vector, which is equivalent to setting it to be the zero
+     *        vector.
      */
     inline void clear() {
-        data_.clear();
+        inline_data_.fill(0.0f);
+        overflow_data_.clear();
     }
 
     /**
@@ -341,22 +414,23 @@ class PrimitiveVector {
     static inline PrimitiveVector max(const PrimitiveVector& lhs,
                                       const PrimitiveVector& rhs) {
         PrimitiveVector res;
-        size_t num_dims = std::max(lhs.data_.size(), rhs.data_.size());
-        res.data_.resize(num_dims, 0.0f);
-        for (size_t i = 0; i < num_dims; i++) {
-            PrimitiveVectorDim dim = (PrimitiveVectorDim)i;
-            res.data_[dim] = std::max(lhs.get_dim_val(dim), rhs.get_dim_val(dim));
-        }
+        for (size_t i = 0; i < num_inline_dims_; i++)
+            res.inline_data_[i] = std::max(lhs.inline_data_[i], rhs.inline_data_[i]);
+        size_t num_overflow_dims = std::max(lhs.overflow_data_.size(), rhs.overflow_data_.size());
+        res.overflow_data_.resize(num_overflow_dims, 0.0f);
+        for (size_t i = 0; i < num_overflow_dims; i++)
+            res.overflow_data_[i] = std::max(lhs.get_overflow_val(i), rhs.get_overflow_val(i));
         return res;
     }
 
     /**
      * @brief Debug printing method.
+     *
+     * Only the non-zero dimensions are printed.
      */
     inline void print() const {
-        for (size_t i = 0; i < data_.size(); i++) {
-            PrimitiveVectorDim dim = (PrimitiveVectorDim)i;
-            VTR_LOG("(%zu, %f)\n", i, get_dim_val(dim));
+        for (PrimitiveVectorDim dim : get_non_zero_dims()) {
+            VTR_LOG("(%zu, %f)\n", (size_t)dim, get_dim_val(dim));
         }
     }
 };
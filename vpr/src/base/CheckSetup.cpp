@@ -136,6 +136,10 @@ void CheckSetup(const t_packer_opts& packer_opts,
         VPR_FATAL_ERROR(VPR_ERROR_OTHER,
                         "Routing channel width must be positive.\n");
     }
+    if (router_opts.global_route_prepass && router_opts.global_route_gcell_size < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "Global routing cell size must be at least 1.\n");
+    }
 
     if (UNI_DIRECTIONAL == routing_arch.directionality) {
         if ((router_opts.fixed_channel_width != NO_FIXED_CHANNEL_WIDTH)
@@ -5,6 +5,7 @@
 #include "globals.h"
 #include "physical_types.h"
 #include "physical_types_util.h"
+#include "read_netlist.h"
 #include "vpr_error.h"
 #include "vpr_types.h"
 #include "vtr_assert.h"
@@ -28,8 +29,17 @@ void ShowSetup(const t_vpr_setup& vpr_setup) {
     VTR_LOG("Timing analysis: %s\n", (vpr_setup.TimingEnabled ? "ON" : "OFF"));
 
     VTR_LOG("Circuit netlist file: %s\n", vpr_setup.FileNameOpts.NetFile.c_str());
+    if (vpr_setup.FileNameOpts.binary_net_file) {
+        VTR_LOG("Circuit binary netlist file: %s\n", get_binary_net_file_name(vpr_setup.FileNameOpts.NetFile).c_str());
+    }
     VTR_LOG("Circuit placement file: %s\n", vpr_setup.FileNameOpts.PlaceFile.c_str());
     VTR_LOG("Circuit routing file: %s\n", vpr_setup.FileNameOpts.RouteFile.c_str());
+    if (!vpr_setup.FileNameOpts.write_place_file.empty()) {
+        VTR_LOG("Placement copy file: %s\n", vpr_setup.FileNameOpts.write_place_file.c_str());
+    }
+    if (!vpr_setup.FileNameOpts.write_route_file.empty()) {
+        VTR_LOG("Routing copy file: %s\n", vpr_setup.FileNameOpts.write_route_file.c_str());
+    }
     VTR_LOG("Circuit SDC file: %s\n", vpr_setup.Timing.SDCFile.c_str());
     if (vpr_setup.FileNameOpts.read_vpr_constraints_file.empty()) {
         VTR_LOG("Vpr floorplanning constraints file: not specified\n");
@@ -262,6 +272,12 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
         case PARALLEL_DECOMP:
             VTR_LOG("PARALLEL_DECOMP\n");
             break;
+        case DISTRIBUTED:
+            VTR_LOG("DISTRIBUTED\n");
+            break;
+        case GPU_BATCH:
+            VTR_LOG("GPU_BATCH\n");
+            break;
         case TIMING_DRIVEN:
             VTR_LOG("TIMING_DRIVEN\n");
             break;
@@ -372,11 +388,30 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
     VTR_LOG("RouterOpts.min_incremental_reroute_fanout: %d\n", RouterOpts.min_incremental_reroute_fanout);
     VTR_LOG("RouterOpts.initial_acc_cost_chan_congestion_threshold: %f\n", RouterOpts.initial_acc_cost_chan_congestion_threshold);
     VTR_LOG("RouterOpts.initial_acc_cost_chan_congestion_weight: %f\n", RouterOpts.initial_acc_cost_chan_congestion_weight);
+    VTR_LOG("RouterOpts.global_route_prepass: %s\n", RouterOpts.global_route_prepass ? "true" : "false");
+    VTR_LOG("RouterOpts.global_route_gcell_size: %d\n", RouterOpts.global_route_gcell_size);
+    VTR_LOG("RouterOpts.bidirectional_search: %s\n", RouterOpts.bidirectional_search ? "true" : "false");
+    if (RouterOpts.bidirectional_search) {
+        VTR_LOG("RouterOpts.bidirectional_search_min_distance: %d\n", RouterOpts.bidirectional_search_min_distance);
+        VTR_LOG("RouterOpts.bidirectional_search_max_criticality: %g\n", RouterOpts.bidirectional_search_max_criticality);
+    }
+    if (RouterOpts.router_algorithm == GPU_BATCH) {
+        VTR_LOG("RouterOpts.batch_max_criticality: %g\n", RouterOpts.batch_max_criticality);
+    }
+    VTR_LOG("RouterOpts.clock_tree_routing: %s\n", RouterOpts.clock_tree_routing ? "true" : "false");
     VTR_LOG("RouterOpts.do_check_rr_graph: %s\n", RouterOpts.do_check_rr_graph ? "true" : "false");
+    VTR_LOG("RouterOpts.check_rr_graph_trusted_digest: %s\n", RouterOpts.check_rr_graph_trusted_digest ? "true" : "false");
+    VTR_LOG("RouterOpts.masked_chan_width_search: %s\n", RouterOpts.masked_chan_width_search ? "true" : "false");
     VTR_LOG("RouterOpts.verify_binary_search: %s\n", RouterOpts.verify_binary_search ? "true" : "false");
+    VTR_LOG("RouterOpts.chan_width_search_jobs: %d\n", RouterOpts.chan_width_search_jobs);
     VTR_LOG("RouterOpts.min_channel_width_hint: %d\n", RouterOpts.min_channel_width_hint);
     VTR_LOG("RouterOpts.read_rr_edge_metadata: %s\n", RouterOpts.read_rr_edge_metadata ? "true" : "false");
+    VTR_LOG("RouterOpts.compress_rr_graph_edges: %s\n", RouterOpts.compress_rr_graph_edges ? "true" : "false");
+    VTR_LOG("RouterOpts.setup_cache_dir: %s\n", RouterOpts.setup_cache_dir.empty() ? "(none)" : RouterOpts.setup_cache_dir.c_str());
     VTR_LOG("RouterOpts.exit_after_first_routing_iteration: %s\n", RouterOpts.exit_after_first_routing_iteration ? "true" : "false");
+    VTR_LOG("RouterOpts.router_partition_node_batching: %s\n", RouterOpts.router_partition_node_batching ? "true" : "false");
+    VTR_LOG("RouterOpts.router_deterministic_parallel: %s\n", RouterOpts.router_deterministic_parallel ? "true" : "false");
+    VTR_LOG("RouterOpts.numa_aware_threads: %s\n", RouterOpts.numa_aware_threads ? "true" : "false");
 
     if (TIMING_DRIVEN == RouterOpts.router_algorithm) {
         VTR_LOG("RouterOpts.astar_fac: %f\n", RouterOpts.astar_fac);
@@ -388,6 +423,8 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
         VTR_LOG("RouterOpts.multi_queue_num_threads: %d\n", RouterOpts.multi_queue_num_threads);
         VTR_LOG("RouterOpts.multi_queue_num_queues: %d\n", RouterOpts.multi_queue_num_queues);
         VTR_LOG("RouterOpts.multi_queue_direct_draining: %s\n", RouterOpts.multi_queue_direct_draining ? "true" : "false");
+        VTR_LOG("RouterOpts.multi_queue_stickiness: %d\n", RouterOpts.multi_queue_stickiness);
+        VTR_LOG("RouterOpts.multi_queue_pop_batch_size: %d\n", RouterOpts.multi_queue_pop_batch_size);
         VTR_LOG("RouterOpts.criticality_exp: %f\n", RouterOpts.criticality_exp);
         VTR_LOG("RouterOpts.max_criticality: %f\n", RouterOpts.max_criticality);
         VTR_LOG("RouterOpts.init_wirelength_abort_threshold: %f\n", RouterOpts.init_wirelength_abort_threshold);
@@ -400,8 +437,14 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
         }
 
         VTR_LOG("RouterOpts.save_routing_per_iteration: %s\n", RouterOpts.save_routing_per_iteration ? "true" : "false");
+        VTR_LOG("RouterOpts.route_checkpoint_file: %s\n", RouterOpts.route_checkpoint_file.c_str());
+        VTR_LOG("RouterOpts.route_checkpoint_interval: %d\n", RouterOpts.route_checkpoint_interval);
+        VTR_LOG("RouterOpts.resume_routing: %s\n", RouterOpts.resume_routing ? "true" : "false");
+        VTR_LOG("RouterOpts.eco_route_file: %s\n", RouterOpts.eco_route_file.empty() ? "<none>" : RouterOpts.eco_route_file.c_str());
         VTR_LOG("RouterOpts.congested_routing_iteration_threshold_frac: %f\n", RouterOpts.congested_routing_iteration_threshold_frac);
         VTR_LOG("RouterOpts.high_fanout_threshold: %d\n", RouterOpts.high_fanout_threshold);
+        VTR_LOG("RouterOpts.high_fanout_skeleton: %s\n", RouterOpts.high_fanout_skeleton ? "true" : "false");
+        VTR_LOG("RouterOpts.net_profile_file: %s\n", RouterOpts.net_profile_file.c_str());
         VTR_LOG("RouterOpts.router_debug_net: %d\n", RouterOpts.router_debug_net);
         VTR_LOG("RouterOpts.router_debug_sink_rr: %d\n", RouterOpts.router_debug_sink_rr);
         VTR_LOG("RouterOpts.router_debug_iteration: %d\n", RouterOpts.router_debug_iteration);
@@ -446,6 +489,10 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
                 VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown lookahead_type\n");
         }
 
+        VTR_LOG("RouterOpts.lookahead_lazy: %s\n", RouterOpts.lookahead_lazy ? "true" : "false");
+        VTR_LOG("RouterOpts.lookahead_quantized: %s\n", RouterOpts.lookahead_quantized ? "true" : "false");
+        VTR_LOG("RouterOpts.lookahead_cache_entries: %d\n", RouterOpts.lookahead_cache_entries);
+
         VTR_LOG("RouterOpts.initial_timing: ");
         switch (RouterOpts.initial_timing) {
             case e_router_initial_timing::ALL_CRITICAL:
@@ -469,6 +516,12 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
             case e_heap_type::FOUR_ARY_HEAP:
                 VTR_LOG("FOUR_ARY_HEAP\n");
                 break;
+            case e_heap_type::BUCKET_HEAP:
+                VTR_LOG("BUCKET_HEAP\n");
+                break;
+            case e_heap_type::AUTO_HEAP:
+                VTR_LOG("AUTO_HEAP\n");
+                break;
             default:
                 VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown router_heap\n");
         }
@@ -479,6 +532,8 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
             VTR_LOG("RouterOpts.routing_failure_predictor = SAFE\n");
         else if (RouterOpts.routing_failure_predictor == AGGRESSIVE)
             VTR_LOG("RouterOpts.routing_failure_predictor = AGGRESSIVE\n");
+        else if (RouterOpts.routing_failure_predictor == PRODUCTION)
+            VTR_LOG("RouterOpts.routing_failure_predictor = PRODUCTION\n");
         else if (RouterOpts.routing_failure_predictor == OFF)
             VTR_LOG("RouterOpts.routing_failure_predictor = OFF\n");
 
@@ -572,10 +627,19 @@ static void ShowPlacerOpts(const t_placer_opts& PlacerOpts) {
             if ((size_t)PlacerOpts.delay_model_type > 2)
                 VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown delay_model_type\n");
             VTR_LOG("PlacerOpts.delay_model_type: %s\n", place_delay_model_strings[(size_t)PlacerOpts.delay_model_type].c_str());
+            VTR_LOG("PlacerOpts.place_delay_model_background: %s\n", (PlacerOpts.place_delay_model_background ? "true" : "false"));
         }
 
         VTR_LOG("PlacerOpts.rlim_escape_fraction: %f\n", PlacerOpts.rlim_escape_fraction);
+        VTR_LOG("PlacerOpts.speculative_moves: %d\n", PlacerOpts.speculative_moves);
+        VTR_LOG("PlacerOpts.parallel_regions: %d\n", PlacerOpts.parallel_regions);
+        VTR_LOG("PlacerOpts.num_seeds: %d\n", PlacerOpts.num_seeds);
+        VTR_LOG("PlacerOpts.seed_stop_ratio: %f\n", PlacerOpts.seed_stop_ratio);
+        VTR_LOG("PlacerOpts.anneal_convergence_threshold: %g\n", PlacerOpts.anneal_convergence_threshold);
+        VTR_LOG("PlacerOpts.eco_place_file: %s\n", PlacerOpts.eco_place_file.empty() ? "<none>" : PlacerOpts.eco_place_file.c_str());
+        VTR_LOG("PlacerOpts.eco_window: %d\n", PlacerOpts.eco_window);
         VTR_LOG("PlacerOpts.move_stats_file: %s\n", PlacerOpts.move_stats_file.c_str());
+        VTR_LOG("PlacerOpts.move_profile_file: %s\n", PlacerOpts.move_profile_file.c_str());
         VTR_LOG("PlacerOpts.placement_saves_per_temperature: %d\n", PlacerOpts.placement_saves_per_temperature);
 
         VTR_LOG("PlacerOpts.effort_scaling: ");
@@ -610,6 +674,18 @@ static void ShowPlacerOpts(const t_placer_opts& PlacerOpts) {
 }
 
 static void ShowAnalyticalPlacerOpts(const t_ap_opts& APOpts) {
+    VTR_LOG("AnalyticalPlacerOpts.global_placer_type: ");
+    switch (APOpts.global_placer_type) {
+        case e_ap_global_placer::SimPL:
+            VTR_LOG("simpl\n");
+            break;
+        case e_ap_global_placer::Electrostatic:
+            VTR_LOG("electrostatic\n");
+            break;
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown global_placer_type\n");
+    }
+
     VTR_LOG("AnalyticalPlacerOpts.analytical_solver_type: ");
     switch (APOpts.analytical_solver_type) {
         case e_ap_analytical_solver::Identity:
@@ -663,6 +739,9 @@ static void ShowAnalyticalPlacerOpts(const t_ap_opts& APOpts) {
         case e_ap_detailed_placer::Annealer:
             VTR_LOG("annealer\n");
             break;
+        case e_ap_detailed_placer::RefineAnnealer:
+            VTR_LOG("refine-annealer\n");
+            break;
         default:
             VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown detailed_placer_type\n");
     }
@@ -670,6 +749,10 @@ static void ShowAnalyticalPlacerOpts(const t_ap_opts& APOpts) {
     VTR_LOG("AnalyticalPlacerOpts.ap_timing_tradeoff: %f\n", APOpts.ap_timing_tradeoff);
     VTR_LOG("AnalyticalPlacerOpts.ap_high_fanout_threshold: %d\n", APOpts.ap_high_fanout_threshold);
     VTR_LOG("AnalyticalPlacerOpts.log_verbosity: %d\n", APOpts.log_verbosity);
+    if (!APOpts.write_partial_placement_file.empty())
+        VTR_LOG("AnalyticalPlacerOpts.write_partial_placement_file: %s\n", APOpts.write_partial_placement_file.c_str());
+    if (!APOpts.read_partial_placement_file.empty())
+        VTR_LOG("AnalyticalPlacerOpts.read_partial_placement_file: %s\n", APOpts.read_partial_placement_file.c_str());
 }
 
 static void ShowNetlistOpts(const t_netlist_opts& NetlistOpts) {
@@ -679,6 +762,7 @@ static void ShowNetlistOpts(const t_netlist_opts& NetlistOpts) {
     VTR_LOG("NetlistOpts.sweep_dangling_blocks         : %s\n", (NetlistOpts.sweep_dangling_blocks) ? "true" : "false");
     VTR_LOG("NetlistOpts.sweep_constant_primary_outputs: %s\n", (NetlistOpts.sweep_constant_primary_outputs) ? "true" : "false");
     VTR_LOG("NetlistOpts.netlist_verbosity             : %d\n", NetlistOpts.netlist_verbosity);
+    VTR_LOG("NetlistOpts.mmap_blif_parser              : %s\n", (NetlistOpts.mmap_blif_parser) ? "true" : "false");
 
     std::string const_gen_inference_strings[3] = {"NONE", "COMB", "COMB_SEQ"};
     if ((size_t)NetlistOpts.const_gen_inference > 3)
@@ -694,6 +778,7 @@ static void ShowAnalysisOpts(const t_analysis_opts& AnalysisOpts) {
     VTR_LOG("AnalysisOpts.gen_post_implementation_sdc: %s\n", AnalysisOpts.gen_post_implementation_sdc ? "true" : "false");
     VTR_LOG("AnalysisOpts.timing_report_npaths: %d\n", AnalysisOpts.timing_report_npaths);
     VTR_LOG("AnalysisOpts.timing_report_skew: %s\n", AnalysisOpts.timing_report_skew ? "true" : "false");
+    VTR_LOG("AnalysisOpts.timing_report_compress: %s\n", AnalysisOpts.timing_report_compress ? "true" : "false");
     VTR_LOG("AnalysisOpts.echo_dot_timing_graph_node: %s\n", AnalysisOpts.echo_dot_timing_graph_node.c_str());
 
     VTR_LOG("AnalysisOpts.timing_report_detail: ");
@@ -782,6 +867,10 @@ static void ShowPackerOpts(const t_packer_opts& PackerOpts) {
     VTR_LOG("PackerOpts.timing_driven: %s", (PackerOpts.timing_driven ? "true\n" : "false\n"));
     VTR_LOG("PackerOpts.target_external_pin_util: %s", vtr::join(PackerOpts.target_external_pin_util, " ").c_str());
     VTR_LOG("\n");
+    VTR_LOG("PackerOpts.num_partitions: %d\n", PackerOpts.num_partitions);
+    VTR_LOG("PackerOpts.speculative_candidates: %d\n", PackerOpts.speculative_candidates);
+    VTR_LOG("PackerOpts.profile: %s", (PackerOpts.profile ? "true\n" : "false\n"));
+    VTR_LOG("PackerOpts.eco_net_file: %s\n", PackerOpts.eco_net_file.empty() ? "<none>" : PackerOpts.eco_net_file.c_str());
     VTR_LOG("\n");
 }
 
@@ -794,10 +883,15 @@ static void ShowNocOpts(const t_noc_opts& NocOpts) {
     VTR_LOG("NocOpts.noc_latency_weighting: %f\n", NocOpts.noc_latency_weighting);
     VTR_LOG("NocOpts.noc_congestion_weighting: %f\n", NocOpts.noc_congestion_weighting);
     VTR_LOG("NocOpts.noc_swap_percentage: %d%%\n", NocOpts.noc_swap_percentage);
+    VTR_LOG("NocOpts.noc_initial_placement_speculative_moves: %d\n", NocOpts.noc_initial_placement_speculative_moves);
     VTR_LOG("NocOpts.noc_sat_routing_bandwidth_resolution: %d\n", NocOpts.noc_sat_routing_bandwidth_resolution);
     VTR_LOG("NocOpts.noc_sat_routing_latency_overrun_weighting: %d\n", NocOpts.noc_sat_routing_latency_overrun_weighting);
     VTR_LOG("NocOpts.noc_sat_routing_congestion_weighting: %d\n", NocOpts.noc_sat_routing_congestion_weighting);
     VTR_LOG("NocOpts.noc_sat_routing_num_workers: %d\n", NocOpts.noc_sat_routing_num_workers);
+    VTR_LOG("NocOpts.noc_sat_routing_time_limit: %g\n", NocOpts.noc_sat_routing_time_limit);
+    VTR_LOG("NocOpts.noc_simulation: %s\n", NocOpts.noc_simulation ? "on" : "off");
+    VTR_LOG("NocOpts.noc_simulation_cycles: %d\n", NocOpts.noc_simulation_cycles);
+    VTR_LOG("NocOpts.noc_simulation_packet_size: %g\n", NocOpts.noc_simulation_packet_size);
     VTR_LOG("NocOpts.noc_routing_algorithm: %s\n", NocOpts.noc_placement_file_name.c_str());
     VTR_LOG("\n");
 }
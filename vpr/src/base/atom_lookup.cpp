@@ -140,3 +140,9 @@ void AtomLookup::set_atom_pin_tnode(const AtomPinId pin, const tatum::NodeId nod
     //Each tnode maps to precisely one pin at any point in time
     tnode_atom_pin_[node] = pin;
 }
+
+void AtomLookup::clear_atom_pin_tnodes() {
+    atom_pin_tnode_external_.clear();
+    atom_pin_tnode_internal_.clear();
+    tnode_atom_pin_.clear();
+}
@@ -129,6 +129,9 @@ class AtomLookup {
     ///@brief Sets the bi-directional mapping between an atom netlist pin and timing graph node
     void set_atom_pin_tnode(const AtomPinId pin, const tatum::NodeId node, BlockTnode block_tnode_type);
 
+    ///@brief Removes all the mappings between atom netlist pins and timing graph nodes
+    void clear_atom_pin_tnodes();
+
   private: //Types
   private:
     /**
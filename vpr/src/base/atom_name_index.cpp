@@ -0,0 +1,96 @@
+#include "atom_name_index.h"
+
+#include <algorithm>
+
+#include "atom_netlist.h"
+#include "vtr_assert.h"
+
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
+AtomNameIndex::AtomNameIndex(const AtomNetlist& atom_nlist) {
+    names_.reserve(atom_nlist.blocks().size());
+    for (AtomBlockId blk_id : atom_nlist.blocks()) {
+        names_.emplace_back(atom_nlist.block_name(blk_id), blk_id);
+    }
+
+    sorted_names_ = names_;
+    std::sort(sorted_names_.begin(), sorted_names_.end());
+}
+
+std::vector<AtomBlockId> AtomNameIndex::find_matching_atoms(const std::string& pattern, const std::regex& regex) const {
+    auto [prefix, anchored] = literal_prefix(pattern);
+
+    std::vector<AtomBlockId> atoms;
+    auto matches = [&](std::string_view name) {
+        return std::regex_search(name.begin(), name.end(), regex);
+    };
+
+    if (anchored && !prefix.empty()) {
+        // Only the names starting with the prefix can match: they are contiguous in sorted_names_
+        auto it = std::lower_bound(sorted_names_.begin(), sorted_names_.end(), std::string_view(prefix),
+                                   [](const std::pair<std::string_view, AtomBlockId>& entry, std::string_view value) {
+                                       return entry.first < value;
+                                   });
+        for (; it != sorted_names_.end() && it->first.substr(0, prefix.size()) == prefix; ++it) {
+            if (matches(it->first)) {
+                atoms.push_back(it->second);
+            }
+        }
+        std::sort(atoms.begin(), atoms.end());
+    } else {
+        for (const auto& [name, blk_id] : names_) {
+            if (!prefix.empty() && name.find(prefix) == std::string_view::npos) {
+                continue;
+            }
+            if (matches(name)) {
+                atoms.push_back(blk_id);
+            }
+        }
+    }
+
+    return atoms;
+}
+
+std::vector<std::vector<AtomBlockId>> AtomNameIndex::find_matching_atoms(const std::vector<std::string>& patterns,
+                                                                         const std::vector<std::regex>& regexes) const {
+    VTR_ASSERT(patterns.size() == regexes.size());
+
+    std::vector<std::vector<AtomBlockId>> atoms(patterns.size());
+    auto find_pattern_atoms = [&](size_t ipattern) {
+        atoms[ipattern] = find_matching_atoms(patterns[ipattern], regexes[ipattern]);
+    };
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), patterns.size(), find_pattern_atoms);
+#else
+    for (size_t ipattern = 0; ipattern < patterns.size(); ipattern++) {
+        find_pattern_atoms(ipattern);
+    }
+#endif
+
+    return atoms;
+}
+
+std::pair<std::string, bool> AtomNameIndex::literal_prefix(const std::string& pattern) {
+    // With an alternative, a match may contain none of the pattern's literal text
+    if (pattern.find('|') != std::string::npos) {
+        return {"", false};
+    }
+
+    bool anchored = !pattern.empty() && pattern[0] == '^';
+    std::string prefix;
+    for (size_t i = anchored ? 1 : 0; i < pattern.size(); i++) {
+        char c = pattern[i];
+        if (std::string_view(".[]{}()\\*+?^$").find(c) != std::string_view::npos) {
+            // The last literal character may be optional or repeated
+            if (!prefix.empty() && (c == '*' || c == '?' || c == '{')) {
+                prefix.pop_back();
+            }
+            break;
+        }
+        prefix.push_back(c);
+    }
+
+    return {prefix, anchored};
+}
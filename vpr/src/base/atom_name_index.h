@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Index of the names of the atom blocks, to find the atoms matching the regular expressions
+ *        of a constraints file without running every regex against every atom.
+ *
+ * Exact names are found with AtomNetlist::find_block(), which is already a hash lookup. A regex
+ * is only run on the atoms which can match it: most constraint regexes start with a literal part
+ * (e.g. "top.core0.alu.*"), which any match contains, and which anchored regexes ("^top.core0")
+ * start with. The atoms starting with a string are found by binary search in the sorted names and
+ * the atoms containing it by a plain substring search, both far cheaper than std::regex_search().
+ */
+
+#include <regex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "atom_netlist_fwd.h"
+
+class AtomNameIndex {
+  public:
+    /** The index refers to the block names of \p atom_nlist, which must outlive it and stay unchanged */
+    explicit AtomNameIndex(const AtomNetlist& atom_nlist);
+
+    /**
+     * @brief Returns the atoms whose names match \p regex (as std::regex_search() does), in block order.
+     *
+     *   @param pattern     The source of \p regex, used to narrow down the atoms to check
+     *   @param regex       The compiled \p pattern (ECMAScript syntax)
+     */
+    std::vector<AtomBlockId> find_matching_atoms(const std::string& pattern, const std::regex& regex) const;
+
+    /** Same as find_matching_atoms() for each pattern, in parallel if VPR is built with TBB */
+    std::vector<std::vector<AtomBlockId>> find_matching_atoms(const std::vector<std::string>& patterns,
+                                                              const std::vector<std::regex>& regexes) const;
+
+    /**
+     * @brief Returns the literal text any match of \p pattern contains (empty if unknown), and whether
+     *        the matches start with it (i.e. the pattern is anchored with '^').
+     */
+    static std::pair<std::string, bool> literal_prefix(const std::string& pattern);
+
+  private:
+    std::vector<std::pair<std::string_view, AtomBlockId>> names_;        ///<Atom names, in block order
+    std::vector<std::pair<std::string_view, AtomBlockId>> sorted_names_; ///<Atom names, sorted by name
+};
@@ -959,7 +959,7 @@ bool is_removable_output(const AtomNetlist& netlist, const AtomBlockId blk_id, s
 }
 
 size_t sweep_constant_primary_outputs(AtomNetlist& netlist, int verbosity) {
-    size_t removed_count = 0;
+    std::vector<AtomBlockId> outputs_to_remove;
     for (AtomBlockId blk_id : netlist.blocks()) {
         if (!blk_id) continue;
 
@@ -980,12 +980,13 @@ size_t sweep_constant_primary_outputs(AtomNetlist& netlist, int verbosity) {
             if (all_inputs_are_const) {
                 //All inputs are constant, so we should remove this output
                 VTR_LOGV_WARN(verbosity > 2, "Sweeping constant primary output '%s'\n", netlist.block_name(blk_id).c_str());
-                netlist.remove_block(blk_id);
-                removed_count++;
+                outputs_to_remove.push_back(blk_id);
             }
         }
     }
-    return removed_count;
+
+    netlist.remove_blocks(outputs_to_remove);
+    return outputs_to_remove.size();
 }
 
 size_t sweep_iterative(AtomNetlist& netlist,
@@ -1090,9 +1091,7 @@ size_t sweep_blocks(AtomNetlist& netlist, const LogicalModels& models, int verbo
     }
 
     //Remove them
-    for (auto blk_id : blocks_to_remove) {
-        netlist.remove_block(blk_id);
-    }
+    netlist.remove_blocks(std::vector<AtomBlockId>(blocks_to_remove.begin(), blocks_to_remove.end()));
 
     return blocks_to_remove.size();
 }
@@ -1112,9 +1111,7 @@ size_t sweep_inputs(AtomNetlist& netlist, const LogicalModels& models, int verbo
     }
 
     //Remove them
-    for (auto blk_id : inputs_to_remove) {
-        netlist.remove_block(blk_id);
-    }
+    netlist.remove_blocks(std::vector<AtomBlockId>(inputs_to_remove.begin(), inputs_to_remove.end()));
 
     return inputs_to_remove.size();
 }
@@ -1133,9 +1130,7 @@ size_t sweep_outputs(AtomNetlist& netlist, int verbosity) {
     }
 
     //Remove them
-    for (auto blk_id : outputs_to_remove) {
-        netlist.remove_block(blk_id);
-    }
+    netlist.remove_blocks(std::vector<AtomBlockId>(outputs_to_remove.begin(), outputs_to_remove.end()));
 
     return outputs_to_remove.size();
 }
@@ -0,0 +1,741 @@
+#include "blif_mmap_parser.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#endif
+
+#include "blifparse.hpp"
+#include "vpr_error.h"
+#include "vtr_assert.h"
+#include "vtr_util.h"
+
+namespace {
+
+/// The types of BLIF statements.
+enum class e_blif_statement {
+    MODEL,
+    INPUTS,
+    OUTPUTS,
+    NAMES,
+    LATCH,
+    SUBCKT,
+    BLACKBOX,
+    END,
+    CONN,
+    CNAME,
+    ATTR,
+    PARAM
+};
+
+/// A BLIF statement, whose tokens and cover values are stored in its chunk.
+struct t_blif_statement {
+    e_blif_statement type;
+    /// The line the statement starts at, relative to the first line of the chunk (0-based).
+    int line;
+    /// The arguments of the statement are the chunk tokens [first_token, first_token + num_tokens).
+    /// For a .subckt, they are the model name followed by the (port, net) pairs.
+    size_t first_token;
+    size_t num_tokens;
+    /// The single-output cover of a .names: num_cover_rows rows of num_tokens values each,
+    /// starting at the chunk cover value first_cover_value.
+    size_t first_cover_value = 0;
+    size_t num_cover_rows = 0;
+};
+
+/// The statement records of a chunk of the file.
+struct t_blif_chunk {
+    std::vector<t_blif_statement> statements;
+    std::vector<std::string_view> tokens;
+    std::vector<blifparse::LogicValue> cover_values;
+    /// The number of lines in the chunk.
+    int num_lines = 0;
+
+    /// The first error found in the chunk, if any. The statements after the error are not parsed.
+    bool has_error = false;
+    int error_line = 0;
+    std::string error_near_text;
+    std::string error_msg;
+
+    void clear() {
+        statements.clear();
+        tokens.clear();
+        cover_values.clear();
+        num_lines = 0;
+        has_error = false;
+        error_line = 0;
+        error_near_text.clear();
+        error_msg.clear();
+    }
+
+    void set_error(int line, std::string_view near_text, std::string msg) {
+        has_error = true;
+        error_line = line;
+        error_near_text = near_text;
+        error_msg = std::move(msg);
+    }
+};
+
+/**
+ * @brief Splits a range of the file into logical lines (joining continued
+ * lines and skipping comments and blank lines), and the logical lines into
+ * tokens.
+ *
+ * The tokens are the ones of the libblifparse lexer: unquoted strings (which
+ * may contain, but not end with, a backslash), quoted strings (including their
+ * quotes) and '='.
+ */
+class BlifLineTokenizer {
+  public:
+    BlifLineTokenizer(const char* begin, const char* end)
+        : curr_(begin)
+        , end_(end) {}
+
+    /**
+     * @brief Reads the tokens of the next non-empty logical line.
+     *
+     * @return False at the end of the range, or if an unexpected character
+     * was found (see has_error()).
+     */
+    bool next_line(std::vector<std::string_view>& tokens) {
+        tokens.clear();
+        while (curr_ != end_) {
+            const char c = *curr_;
+            if (c == ' ' || c == '\t') {
+                ++curr_;
+            } else if (c == '\n' || c == '\r') {
+                if (!consume_eol()) {
+                    return false;
+                }
+                if (!tokens.empty()) {
+                    return true;
+                }
+            } else if (c == '#') {
+                // comment until the end of the line
+                curr_ = std::find(curr_, end_, '\n');
+            } else if (c == '\\' && curr_ + 1 != end_ && (curr_[1] == '\n' || curr_[1] == '\r')) {
+                // line continuation
+                ++curr_;
+                if (!consume_eol()) {
+                    return false;
+                }
+
+                // a continuation followed by a blank line ends the logical line
+                const char* next = curr_;
+                while (next != end_ && (*next == ' ' || *next == '\t')) {
+                    ++next;
+                }
+                if (next != end_ && (*next == '\n' || *next == '\r')) {
+                    curr_ = next;
+                    if (!consume_eol()) {
+                        return false;
+                    }
+                    if (!tokens.empty()) {
+                        return true;
+                    }
+                }
+            } else if (c == '"') {
+                // quoted string, on a single line
+                const char* closing_quote = curr_ + 1;
+                while (closing_quote != end_ && *closing_quote != '"' && *closing_quote != '\n' && *closing_quote != '\r') {
+                    ++closing_quote;
+                }
+                if (closing_quote == end_ || *closing_quote != '"') {
+                    return set_error("\"");
+                }
+                add_token(tokens, curr_, closing_quote + 1);
+            } else if (c == '=') {
+                add_token(tokens, curr_, curr_ + 1);
+            } else {
+                // unquoted string, which cannot end with a backslash (it may be a line continuation)
+                const char* token_end = curr_;
+                while (token_end != end_ && is_unquoted_string_char(*token_end)) {
+                    ++token_end;
+                }
+                while (token_end != curr_ && token_end[-1] == '\\') {
+                    --token_end;
+                }
+                if (token_end == curr_) {
+                    return set_error(std::string_view(curr_, 1));
+                }
+                add_token(tokens, curr_, token_end);
+            }
+        }
+
+        return !tokens.empty();
+    }
+
+    /// The line (0-based, relative to the start of the range) the last logical line started at.
+    int line_start() const { return line_start_; }
+
+    /// The number of lines read so far.
+    int num_lines() const { return line_; }
+
+    bool has_error() const { return has_error_; }
+    int error_line() const { return line_; }
+    std::string_view error_near_text() const { return error_near_text_; }
+
+  private:
+    static bool is_unquoted_string_char(char c) {
+        return c != ' ' && c != '\t' && c != '\r' && c != '\n' && c != '=' && c != '"';
+    }
+
+    void add_token(std::vector<std::string_view>& tokens, const char* token_begin, const char* token_end) {
+        if (tokens.empty()) {
+            line_start_ = line_;
+        }
+        tokens.emplace_back(token_begin, token_end - token_begin);
+        curr_ = token_end;
+    }
+
+    /// Consumes an end of line (\n, \n\r or \r\n). A lone \r is an error.
+    bool consume_eol() {
+        if (*curr_ == '\n') {
+            ++curr_;
+            if (curr_ != end_ && *curr_ == '\r') {
+                ++curr_;
+            }
+        } else if (curr_ + 1 != end_ && curr_[1] == '\n') {
+            curr_ += 2;
+        } else {
+            return set_error("\r");
+        }
+        ++line_;
+        return true;
+    }
+
+    bool set_error(std::string_view near_text) {
+        has_error_ = true;
+        error_near_text_ = near_text;
+        return false;
+    }
+
+    const char* curr_;
+    const char* end_;
+    int line_ = 0;
+    int line_start_ = 0;
+
+    bool has_error_ = false;
+    std::string_view error_near_text_;
+};
+
+bool is_latch_type(std::string_view token) {
+    return token == "fe" || token == "re" || token == "ah" || token == "al" || token == "as";
+}
+
+bool is_latch_init(std::string_view token) {
+    return token == "0" || token == "1" || token == "2" || token == "3";
+}
+
+blifparse::LatchType to_latch_type(std::string_view token) {
+    if (token == "fe") return blifparse::LatchType::FALLING_EDGE;
+    if (token == "re") return blifparse::LatchType::RISING_EDGE;
+    if (token == "ah") return blifparse::LatchType::ACTIVE_HIGH;
+    if (token == "al") return blifparse::LatchType::ACTIVE_LOW;
+    VTR_ASSERT(token == "as");
+    return blifparse::LatchType::ASYNCHRONOUS;
+}
+
+blifparse::LogicValue to_latch_init(std::string_view token) {
+    if (token == "0") return blifparse::LogicValue::FALSE;
+    if (token == "1") return blifparse::LogicValue::TRUE;
+    if (token == "2") return blifparse::LogicValue::DONT_CARE;
+    VTR_ASSERT(token == "3");
+    return blifparse::LogicValue::UNKOWN;
+}
+
+/**
+ * @brief Returns the type of the statement starting with the given keyword,
+ * or false if the keyword is unknown.
+ */
+bool get_statement_type(std::string_view keyword, e_blif_statement& type) {
+    static const std::pair<std::string_view, e_blif_statement> keywords[] = {
+        {".names", e_blif_statement::NAMES},
+        {".subckt", e_blif_statement::SUBCKT},
+        {".latch", e_blif_statement::LATCH},
+        {".conn", e_blif_statement::CONN},
+        {".cname", e_blif_statement::CNAME},
+        {".attr", e_blif_statement::ATTR},
+        {".param", e_blif_statement::PARAM},
+        {".inputs", e_blif_statement::INPUTS},
+        {".outputs", e_blif_statement::OUTPUTS},
+        {".model", e_blif_statement::MODEL},
+        {".blackbox", e_blif_statement::BLACKBOX},
+        {".end", e_blif_statement::END}};
+
+    for (const auto& [statement_keyword, statement_type] : keywords) {
+        if (keyword == statement_keyword) {
+            type = statement_type;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Checks the number and the kind of the arguments of a statement
+ * (the tokens of its line, without the keyword).
+ */
+bool has_valid_arguments(e_blif_statement type, const std::vector<std::string_view>& args) {
+    if (type == e_blif_statement::SUBCKT) {
+        // model (port = net)*
+        if (args.empty() || args[0] == "=" || (args.size() - 1) % 3 != 0) {
+            return false;
+        }
+        for (size_t i = 1; i < args.size(); i += 3) {
+            if (args[i] == "=" || args[i + 1] != "=" || args[i + 2] == "=") {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // '=' is only valid in .subckt
+    if (std::find(args.begin(), args.end(), "=") != args.end()) {
+        return false;
+    }
+
+    switch (type) {
+        case e_blif_statement::INPUTS:
+        case e_blif_statement::OUTPUTS:
+        case e_blif_statement::NAMES:
+            return true;
+        case e_blif_statement::MODEL:
+        case e_blif_statement::CNAME:
+            return args.size() == 1;
+        case e_blif_statement::BLACKBOX:
+        case e_blif_statement::END:
+            return args.empty();
+        case e_blif_statement::CONN:
+            return args.size() == 2;
+        case e_blif_statement::ATTR:
+        case e_blif_statement::PARAM:
+            return args.size() == 1 || args.size() == 2;
+        case e_blif_statement::LATCH:
+            // input output [type control] [init]
+            if (args.size() == 2) {
+                return true;
+            } else if (args.size() == 3) {
+                return is_latch_init(args[2]);
+            } else if (args.size() == 4) {
+                return is_latch_type(args[2]);
+            } else if (args.size() == 5) {
+                return is_latch_type(args[2]) && is_latch_init(args[4]);
+            }
+            return false;
+        default:
+            VTR_ASSERT_MSG(false, "Unknown BLIF statement");
+            return false;
+    }
+}
+
+/**
+ * @brief Tokenizes the statements in [begin, end) into the given chunk.
+ *
+ * The range must start at the beginning of a statement.
+ */
+void parse_chunk(const char* begin, const char* end, t_blif_chunk& chunk) {
+    chunk.clear();
+
+    BlifLineTokenizer tokenizer(begin, end);
+    std::vector<std::string_view> line_tokens;
+    std::vector<std::string_view> args;
+    // the index of the .names statement whose cover rows are being read, if any
+    size_t names_statement_idx = std::string::npos;
+
+    while (tokenizer.next_line(line_tokens)) {
+        const int line = tokenizer.line_start();
+        const std::string_view keyword = line_tokens[0];
+
+        if (keyword[0] != '.') {
+            // a single-output cover row of the current .names
+            if (names_statement_idx == std::string::npos) {
+                chunk.set_error(line, keyword, "syntax error");
+                return;
+            }
+
+            t_blif_statement& names = chunk.statements[names_statement_idx];
+            size_t num_values = 0;
+            for (std::string_view token : line_tokens) {
+                for (char c : token) {
+                    if (c == '0') {
+                        chunk.cover_values.push_back(blifparse::LogicValue::FALSE);
+                    } else if (c == '1') {
+                        chunk.cover_values.push_back(blifparse::LogicValue::TRUE);
+                    } else if (c == '-') {
+                        chunk.cover_values.push_back(blifparse::LogicValue::DONT_CARE);
+                    } else {
+                        chunk.set_error(line, std::string_view(&c, 1), "Unrecognized character");
+                        return;
+                    }
+                    num_values++;
+                }
+            }
+
+            if (num_values != names.num_tokens) {
+                chunk.set_error(line, keyword,
+                                vtr::string_fmt("Mismatched .names single-output cover row."
+                                                " names connected to %zu net(s), but cover row has %zu element(s)",
+                                                names.num_tokens, num_values));
+                return;
+            }
+            names.num_cover_rows++;
+            continue;
+        }
+
+        names_statement_idx = std::string::npos;
+
+        e_blif_statement type;
+        if (!get_statement_type(keyword, type)) {
+            chunk.set_error(line, keyword, "syntax error");
+            return;
+        }
+
+        args.assign(line_tokens.begin() + 1, line_tokens.end());
+        if (!has_valid_arguments(type, args)) {
+            chunk.set_error(line, keyword, "syntax error");
+            return;
+        }
+
+        t_blif_statement statement;
+        statement.type = type;
+        statement.line = line;
+        statement.first_token = chunk.tokens.size();
+        if (type == e_blif_statement::SUBCKT) {
+            // drop the '=' between the ports and the nets
+            chunk.tokens.push_back(args[0]);
+            for (size_t i = 1; i < args.size(); i += 3) {
+                chunk.tokens.push_back(args[i]);
+                chunk.tokens.push_back(args[i + 2]);
+            }
+        } else {
+            chunk.tokens.insert(chunk.tokens.end(), args.begin(), args.end());
+        }
+        statement.num_tokens = chunk.tokens.size() - statement.first_token;
+
+        if (type == e_blif_statement::NAMES) {
+            statement.first_cover_value = chunk.cover_values.size();
+            names_statement_idx = chunk.statements.size();
+        }
+        chunk.statements.push_back(statement);
+    }
+
+    if (tokenizer.has_error()) {
+        chunk.set_error(tokenizer.error_line(), tokenizer.error_near_text(), "Unrecognized character");
+        return;
+    }
+
+    chunk.num_lines = tokenizer.num_lines();
+}
+
+/**
+ * @brief Passes the statements of a chunk to the callback, in order.
+ *
+ * @param first_line The (1-based) line number of the first line of the chunk.
+ * @return False if the chunk has an error, which has been reported to the callback.
+ */
+bool dispatch_chunk(const t_blif_chunk& chunk, int first_line, blifparse::Callback& callback) {
+    auto get_strings = [&chunk](size_t first_token, size_t num_tokens) {
+        std::vector<std::string> strings;
+        strings.reserve(num_tokens);
+        for (size_t i = first_token; i < first_token + num_tokens; i++) {
+            strings.emplace_back(chunk.tokens[i]);
+        }
+        return strings;
+    };
+
+    for (const t_blif_statement& statement : chunk.statements) {
+        const std::string_view* args = chunk.tokens.data() + statement.first_token;
+        callback.lineno(first_line + statement.line);
+
+        switch (statement.type) {
+            case e_blif_statement::MODEL:
+                callback.begin_model(std::string(args[0]));
+                break;
+            case e_blif_statement::INPUTS:
+                callback.inputs(get_strings(statement.first_token, statement.num_tokens));
+                break;
+            case e_blif_statement::OUTPUTS:
+                callback.outputs(get_strings(statement.first_token, statement.num_tokens));
+                break;
+            case e_blif_statement::NAMES: {
+                std::vector<std::vector<blifparse::LogicValue>> so_cover(statement.num_cover_rows);
+                auto row_begin = chunk.cover_values.begin() + statement.first_cover_value;
+                for (auto& row : so_cover) {
+                    row.assign(row_begin, row_begin + statement.num_tokens);
+                    row_begin += statement.num_tokens;
+                }
+                callback.names(get_strings(statement.first_token, statement.num_tokens), std::move(so_cover));
+                break;
+            }
+            case e_blif_statement::LATCH: {
+                blifparse::LatchType latch_type = blifparse::LatchType::UNSPECIFIED;
+                std::string control;
+                blifparse::LogicValue init = blifparse::LogicValue::UNKOWN;
+                if (statement.num_tokens >= 4) {
+                    latch_type = to_latch_type(args[2]);
+                    if (args[3] != "NIL") {
+                        control = args[3];
+                    }
+                }
+                if (statement.num_tokens == 3 || statement.num_tokens == 5) {
+                    init = to_latch_init(args[statement.num_tokens - 1]);
+                }
+                callback.latch(std::string(args[0]), std::string(args[1]), latch_type, control, init);
+                break;
+            }
+            case e_blif_statement::SUBCKT: {
+                const size_t num_connections = (statement.num_tokens - 1) / 2;
+                std::vector<std::string> ports;
+                std::vector<std::string> nets;
+                ports.reserve(num_connections);
+                nets.reserve(num_connections);
+                for (size_t i = 0; i < num_connections; i++) {
+                    ports.emplace_back(args[1 + 2 * i]);
+                    nets.emplace_back(args[2 + 2 * i]);
+                }
+                callback.subckt(std::string(args[0]), std::move(ports), std::move(nets));
+                break;
+            }
+            case e_blif_statement::BLACKBOX:
+                callback.blackbox();
+                break;
+            case e_blif_statement::END:
+                callback.end_model();
+                break;
+            case e_blif_statement::CONN:
+                callback.conn(std::string(args[0]), std::string(args[1]));
+                break;
+            case e_blif_statement::CNAME:
+                callback.cname(std::string(args[0]));
+                break;
+            case e_blif_statement::ATTR:
+                callback.attr(std::string(args[0]), statement.num_tokens == 2 ? std::string(args[1]) : std::string());
+                break;
+            case e_blif_statement::PARAM:
+                callback.param(std::string(args[0]), statement.num_tokens == 2 ? std::string(args[1]) : std::string());
+                break;
+            default:
+                VTR_ASSERT_MSG(false, "Unknown BLIF statement");
+        }
+    }
+
+    if (chunk.has_error) {
+        callback.parse_error(first_line + chunk.error_line, chunk.error_near_text, chunk.error_msg);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the beginning of the first line at or after pos which starts
+ * a statement, or end if there is none.
+ *
+ * A line starts a statement if its first character (after white space) is a
+ * '.' and the previous line is not continued. Since single-output cover rows
+ * never start with a '.', such a line is never in the middle of a statement.
+ */
+const char* find_statement_start(const char* begin, const char* pos, const char* end) {
+    if (pos == begin) {
+        return begin;
+    }
+
+    // go to the beginning of a line
+    const char* line_begin = pos;
+    if (line_begin[-1] != '\n') {
+        line_begin = std::find(line_begin, end, '\n');
+        if (line_begin != end) {
+            ++line_begin;
+        }
+    }
+
+    while (line_begin != end) {
+        // the end of the previous line, without its '\r'
+        const char* prev_line_end = line_begin - 1;
+        if (prev_line_end != begin && prev_line_end[-1] == '\r') {
+            --prev_line_end;
+        }
+        const bool is_continued = (prev_line_end != begin && prev_line_end[-1] == '\\');
+
+        const char* first_char = line_begin;
+        while (first_char != end && (*first_char == ' ' || *first_char == '\t')) {
+            ++first_char;
+        }
+        if (!is_continued && first_char != end && *first_char == '.') {
+            return line_begin;
+        }
+
+        line_begin = std::find(line_begin, end, '\n');
+        if (line_begin != end) {
+            ++line_begin;
+        }
+    }
+
+    return end;
+}
+
+/**
+ * @brief Splits the file, from batch_begin, into (at most) num_chunks chunks
+ * and tokenizes them, in parallel if VPR is built with TBB.
+ *
+ * @return The end of the last chunk of the batch.
+ */
+const char* parse_batch(const char* begin,
+                        const char* batch_begin,
+                        const char* end,
+                        size_t num_chunks,
+                        std::vector<t_blif_chunk>& chunks) {
+    std::vector<std::pair<const char*, const char*>> chunk_ranges;
+    const char* chunk_begin = batch_begin;
+    while (chunk_begin != end && chunk_ranges.size() < num_chunks) {
+        const char* chunk_end = (size_t)(end - chunk_begin) <= BlifMmapParser::CHUNK_SIZE
+                                    ? end
+                                    : find_statement_start(begin, chunk_begin + BlifMmapParser::CHUNK_SIZE, end);
+        chunk_ranges.emplace_back(chunk_begin, chunk_end);
+        chunk_begin = chunk_end;
+    }
+
+    chunks.resize(chunk_ranges.size());
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), chunk_ranges.size(), [&](size_t ichunk) {
+        parse_chunk(chunk_ranges[ichunk].first, chunk_ranges[ichunk].second, chunks[ichunk]);
+    });
+#else
+    for (size_t ichunk = 0; ichunk < chunk_ranges.size(); ichunk++) {
+        parse_chunk(chunk_ranges[ichunk].first, chunk_ranges[ichunk].second, chunks[ichunk]);
+    }
+#endif
+
+    return chunk_begin;
+}
+
+} // namespace
+
+BlifMmapParser::BlifMmapParser(const std::string& filename)
+    : filename_(filename) {
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if (fd < 0 || fstat(fd, &file_stat) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        vpr_throw(VPR_ERROR_BLIF_F, filename.c_str(), 0, "Could not open file '%s'.\n", filename.c_str());
+    }
+
+    size_ = file_stat.st_size;
+    if (size_ > 0) {
+        void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            vpr_throw(VPR_ERROR_BLIF_F, filename.c_str(), 0, "Could not map file '%s' into memory.\n", filename.c_str());
+        }
+        // the file is read front to back
+        madvise(mapping, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(mapping);
+        is_mapped_ = true;
+    }
+    close(fd);
+#else
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+        vpr_throw(VPR_ERROR_BLIF_F, filename.c_str(), 0, "Could not open file '%s'.\n", filename.c_str());
+    }
+    size_ = file.tellg();
+    char* buffer = new char[size_];
+    file.seekg(0);
+    file.read(buffer, size_);
+    data_ = buffer;
+#endif
+}
+
+BlifMmapParser::~BlifMmapParser() {
+#ifndef _WIN32
+    if (is_mapped_) {
+        munmap(const_cast<char*>(data_), size_);
+        return;
+    }
+#endif
+    delete[] data_;
+}
+
+void BlifMmapParser::parse(blifparse::Callback& callback) const {
+    callback.start_parse();
+    callback.filename(filename_);
+
+    const char* begin = data_;
+    const char* end = data_ + size_;
+
+    // The file is parsed in batches of chunks. While the chunks of a batch are
+    // passed to the callback (which builds the netlist serially), the chunks of
+    // the next batch are tokenized in parallel. The chunks are always passed to
+    // the callback in file order, so the netlist does not depend on the number
+    // of threads.
+#ifdef VPR_USE_TBB
+    const size_t num_chunks_per_batch = std::max(1, tbb::this_task_arena::max_concurrency());
+#else
+    const size_t num_chunks_per_batch = 1;
+#endif
+
+    std::vector<t_blif_chunk> curr_chunks;
+    std::vector<t_blif_chunk> next_chunks;
+    const char* next_batch_begin = parse_batch(begin, begin, end, num_chunks_per_batch, curr_chunks);
+
+    int first_line = 1;
+    while (!curr_chunks.empty()) {
+        const char* next_next_batch_begin = next_batch_begin;
+        next_chunks.clear();
+#ifdef VPR_USE_TBB
+        tbb::task_group next_batch_group;
+        if (next_batch_begin != end) {
+            next_batch_group.run([&]() {
+                next_next_batch_begin = parse_batch(begin, next_batch_begin, end, num_chunks_per_batch, next_chunks);
+            });
+        }
+#endif
+
+        bool is_valid = true;
+        try {
+            for (const t_blif_chunk& chunk : curr_chunks) {
+                if (!dispatch_chunk(chunk, first_line, callback)) {
+                    is_valid = false;
+                    break;
+                }
+                first_line += chunk.num_lines;
+            }
+        } catch (...) {
+#ifdef VPR_USE_TBB
+            next_batch_group.wait();
+#endif
+            throw;
+        }
+
+#ifdef VPR_USE_TBB
+        next_batch_group.wait();
+#else
+        if (is_valid && next_batch_begin != end) {
+            next_next_batch_begin = parse_batch(begin, next_batch_begin, end, num_chunks_per_batch, next_chunks);
+        }
+#endif
+
+        if (!is_valid) {
+            break;
+        }
+        std::swap(curr_chunks, next_chunks);
+        next_batch_begin = next_next_batch_begin;
+    }
+
+    callback.finish_parse();
+}
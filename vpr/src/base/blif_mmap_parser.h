@@ -0,0 +1,76 @@
+#pragma once
+/**
+ * @file
+ * @brief A fast BLIF/EBLIF parser which reads the circuit file through a
+ * memory mapping.
+ *
+ * This parser is a drop-in replacement for blifparse::blif_parse_filename():
+ * it calls the same blifparse::Callback methods, in the same order, so the
+ * netlist is still built by the BLIF loader (see read_blif.cpp).
+ *
+ * Unlike libblifparse, which reads the file through a flex/bison pipeline and
+ * allocates a string for every token it sees, the file is mapped into memory
+ * and tokenized in place: tokens are views into the mapping, and a string is
+ * only created when a token is passed to the callback.
+ *
+ * The file is parsed in chunks which start at BLIF statements (e.g. .names,
+ * .subckt). Each chunk is first tokenized into statement records, which are
+ * then passed to the callback in file order. This bounds the memory used by
+ * the records, whatever the size of the file.
+ *
+ * If VPR is built with TBB, batches of chunks are tokenized in parallel, and
+ * the next batch is tokenized while the records of the current one are passed
+ * to the callback. Since the records are always passed in file order, the
+ * callback calls are the same whatever the number of threads.
+ *
+ * The parser accepts the BLIF constructs accepted by libblifparse (including
+ * comments, line continuations and quoted EBLIF strings), and reports the same
+ * errors through blifparse::Callback::parse_error().
+ */
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace blifparse {
+class Callback;
+}
+
+/**
+ * @brief A read-only memory mapping of a BLIF file, which can be parsed.
+ */
+class BlifMmapParser {
+  public:
+    BlifMmapParser() = delete;
+    BlifMmapParser(const BlifMmapParser&) = delete;
+    BlifMmapParser& operator=(const BlifMmapParser&) = delete;
+
+    /**
+     * @brief Maps the given file into memory.
+     *
+     * Throws a VPR_ERROR_BLIF_F error if the file cannot be opened.
+     */
+    explicit BlifMmapParser(const std::string& filename);
+
+    ~BlifMmapParser();
+
+    /**
+     * @brief Returns the contents of the file.
+     */
+    std::string_view data() const { return {data_, size_}; }
+
+    /**
+     * @brief Parses the file, calling the callback for each BLIF statement.
+     */
+    void parse(blifparse::Callback& callback) const;
+
+    /// The (approximate) number of bytes parsed per chunk.
+    static constexpr size_t CHUNK_SIZE = 4 * 1024 * 1024;
+
+  private:
+    std::string filename_;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    /// Whether data_ is a memory mapping (otherwise it is allocated with new[]).
+    bool is_mapped_ = false;
+};
@@ -9,7 +9,17 @@
 #include "vpr_utils.h"
 
 BlkLocRegistry::BlkLocRegistry()
-    : expected_transaction_(e_expected_transaction::APPLY) {}
+    : num_pending_moves_(0) {}
+
+BlkLocRegistry& BlkLocRegistry::operator=(const BlkLocRegistry& other) {
+    block_locs_ = other.block_locs_;
+    grid_blocks_ = other.grid_blocks_;
+    physical_pins_ = other.physical_pins_;
+    movable_blocks_ = other.movable_blocks_;
+    movable_blocks_per_type_ = other.movable_blocks_per_type_;
+    num_pending_moves_ = other.num_pending_moves_.load();
+    return *this;
+}
 
 void BlkLocRegistry::init() {
     const ClusteredNetlist& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
@@ -219,8 +229,6 @@ void BlkLocRegistry::place_sync_external_block_connections(ClusterBlockId iblk)
 void BlkLocRegistry::apply_move_blocks(const t_pl_blocks_to_be_moved& blocks_affected) {
     const auto& device_ctx = g_vpr_ctx.device();
 
-    VTR_ASSERT_DEBUG(expected_transaction_ == e_expected_transaction::APPLY);
-
     // Swap the blocks, but don't swap the nets or update place_ctx.grid_blocks
     // yet since we don't know whether the swap will be accepted
     for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
@@ -243,11 +251,11 @@ void BlkLocRegistry::apply_move_blocks(const t_pl_blocks_to_be_moved& blocks_aff
         }
     }
 
-    expected_transaction_ = e_expected_transaction::COMMIT_REVERT;
+    num_pending_moves_++;
 }
 
 void BlkLocRegistry::commit_move_blocks(const t_pl_blocks_to_be_moved& blocks_affected) {
-    VTR_ASSERT_DEBUG(expected_transaction_ == e_expected_transaction::COMMIT_REVERT);
+    VTR_ASSERT_DEBUG(num_pending_moves_ > 0);
 
     // Swap physical location
     for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
@@ -266,13 +274,13 @@ void BlkLocRegistry::commit_move_blocks(const t_pl_blocks_to_be_moved& blocks_af
 
     } // Finish updating clb for all blocks
 
-    expected_transaction_ = e_expected_transaction::APPLY;
+    num_pending_moves_--;
 }
 
 void BlkLocRegistry::revert_move_blocks(const t_pl_blocks_to_be_moved& blocks_affected) {
     const auto& device_ctx = g_vpr_ctx.device();
 
-    VTR_ASSERT_DEBUG(expected_transaction_ == e_expected_transaction::COMMIT_REVERT);
+    VTR_ASSERT_DEBUG(num_pending_moves_ > 0);
 
     // Swap the blocks back, nets not yet swapped they don't need to be changed
     for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
@@ -298,7 +306,7 @@ void BlkLocRegistry::revert_move_blocks(const t_pl_blocks_to_be_moved& blocks_af
                             "Grid blocks should only have been updated if swap committed (not reverted)");
     }
 
-    expected_transaction_ = e_expected_transaction::APPLY;
+    num_pending_moves_--;
 }
 
 t_physical_tile_loc BlkLocRegistry::get_coordinate_of_pin(ClusterPinId pin) const {
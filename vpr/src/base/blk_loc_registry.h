@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "clustered_netlist_fwd.h"
 #include "vtr_vector_map.h"
 #include "vpr_types.h"
@@ -22,7 +24,7 @@ class BlkLocRegistry {
     BlkLocRegistry();
     ~BlkLocRegistry() = default;
     BlkLocRegistry(const BlkLocRegistry&) = delete;
-    BlkLocRegistry& operator=(const BlkLocRegistry&) = default;
+    BlkLocRegistry& operator=(const BlkLocRegistry& other);
     BlkLocRegistry(BlkLocRegistry&&) = delete;
     BlkLocRegistry& operator=(BlkLocRegistry&&) = delete;
 
@@ -128,6 +130,8 @@ class BlkLocRegistry {
      * This method only updates `grid_blocks_` member variable and not `grid_blocks_`.
      * After this method is called, either commit_move_blocks() or revert_move_blocks()
      * must be called to either revert the new locations or commit them to `grid_block_`
+     * Several moves of disjoint sets of blocks and locations may be applied before they are
+     * committed or reverted.
      * @param blocks_affected Clustered blocks affected by a swap and their old and new locations.
      */
     void apply_move_blocks(const t_pl_blocks_to_be_moved& blocks_affected);
@@ -157,10 +161,7 @@ class BlkLocRegistry {
      */
     t_physical_tile_loc get_coordinate_of_pin(ClusterPinId pin) const;
 
-    enum class e_expected_transaction {
-        APPLY,
-        COMMIT_REVERT
-    };
-
-    e_expected_transaction expected_transaction_;
+    /// Number of applied moves that have not been committed or reverted yet. Atomic, since
+    /// moves touching disjoint parts of the placement may be applied concurrently.
+    std::atomic<size_t> num_pending_moves_;
 };
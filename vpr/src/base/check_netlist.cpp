@@ -10,12 +10,12 @@
 #include "logic_types.h"
 #include "physical_types_util.h"
 #include "vtr_assert.h"
+#include "vtr_flat_hash_map.h"
 #include "vtr_log.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
 #include "globals.h"
-#include "hash.h"
 #include "vpr_utils.h"
 #include "check_netlist.h"
 
@@ -36,7 +36,7 @@ static int check_clb_internal_nets(ClusterBlockId iblk, const IntraLbPbPinLookup
 void check_netlist(int verbosity) {
     int error = 0;
     int num_conn;
-    t_hash **net_hash_table, *h_net_ptr;
+    vtr::flat_hash_set<std::string> net_names;
 
     /* This routine checks that the netlist makes sense. */
     auto& cluster_ctx = g_vpr_ctx.mutable_clustering();
@@ -44,13 +44,10 @@ void check_netlist(int verbosity) {
     // Return internal netlist verification first.
     cluster_ctx.clb_nlist.verify();
 
-    net_hash_table = alloc_hash_table();
-
     /* Check that nets fanout and have a driver. */
     int global_to_non_global_connection_count = 0;
     for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-        h_net_ptr = insert_in_hash_table(net_hash_table, cluster_ctx.clb_nlist.net_name(net_id).c_str(), size_t(net_id));
-        if (h_net_ptr->count != 1) {
+        if (!net_names.insert(cluster_ctx.clb_nlist.net_name(net_id)).second) {
             VTR_LOG_ERROR("Net %s has multiple drivers.\n",
                           cluster_ctx.clb_nlist.net_name(net_id).c_str());
             error++;
@@ -61,7 +58,6 @@ void check_netlist(int verbosity) {
             VTR_LOG_ERROR("Too many errors in netlist, exiting.\n");
         }
     }
-    free_hash_table(net_hash_table);
     if (global_to_non_global_connection_count > 0) {
         VTR_LOG("Netlist contains %d global net to non-global architecture pin connections\n", global_to_non_global_connection_count);
     }
@@ -221,27 +217,18 @@ static int check_clb_internal_nets(ClusterBlockId iblk, const IntraLbPbPinLookup
 }
 
 static int check_for_duplicated_names() {
-    int error, clb_count;
-    t_hash **clb_hash_table, *clb_h_ptr;
+    int error = 0;
+    vtr::flat_hash_set<std::string> clb_names;
 
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
-    clb_hash_table = alloc_hash_table();
-
-    error = clb_count = 0;
-
     for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
-        clb_h_ptr = insert_in_hash_table(clb_hash_table, cluster_ctx.clb_nlist.block_name(blk_id).c_str(), clb_count);
-        if (clb_h_ptr->count > 1) {
+        if (!clb_names.insert(cluster_ctx.clb_nlist.block_name(blk_id)).second) {
             VTR_LOG_ERROR("Block %s has duplicated name.\n",
                           cluster_ctx.clb_nlist.block_name(blk_id).c_str());
             error++;
-        } else {
-            clb_count++;
         }
     }
 
-    free_hash_table(clb_hash_table);
-
     return error;
 }
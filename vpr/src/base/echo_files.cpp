@@ -1,17 +1,22 @@
 #include <cstdio>
 #include <cstring>
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "vtr_util.h"
 #include "vtr_memory.h"
+#include "vtr_token.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
 
-#include "hash.h"
 #include "echo_files.h"
 #include "globals.h"
 
 static bool EchoEnabled;
+static bool TimingGraphEchoAnonymized = false;
 
 static bool* echoFileEnabled = nullptr;
 static char** echoFileNames = nullptr;
@@ -49,6 +54,45 @@ void setEchoFileName(enum e_echo_files echo_option, const char* name) {
     strcpy(echoFileNames[(int)echo_option], name);
 }
 
+void setTimingGraphEchoStages(const std::string& stages) {
+    if (echoFileEnabled == nullptr) {
+        alloc_and_load_echo_file_info();
+    }
+
+    const std::vector<std::pair<std::string, e_echo_files>> stage_echo_files = {
+        {"pre_pack", E_ECHO_PRE_PACKING_TIMING_GRAPH},
+        {"place_initial", E_ECHO_INITIAL_PLACEMENT_TIMING_GRAPH},
+        {"place_final", E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH},
+        {"route_final", E_ECHO_FINAL_ROUTING_TIMING_GRAPH},
+        {"analysis", E_ECHO_ANALYSIS_TIMING_GRAPH}};
+
+    for (const std::string& stage : vtr::StringToken(stages).split(",")) {
+        if (stage == "off") {
+            continue;
+        }
+        bool found = false;
+        for (const auto& stage_echo_file : stage_echo_files) {
+            if (stage == "all" || stage == stage_echo_file.first) {
+                setEchoFileEnabled(stage_echo_file.second, true);
+                found = true;
+            }
+        }
+        if (!found) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "Unknown timing graph echo stage '%s' (expected pre_pack, place_initial, place_final, route_final, analysis or all)\n",
+                            stage.c_str());
+        }
+    }
+}
+
+bool getTimingGraphEchoAnonymized() {
+    return TimingGraphEchoAnonymized;
+}
+
+void setTimingGraphEchoAnonymized(bool anonymized) {
+    TimingGraphEchoAnonymized = anonymized;
+}
+
 bool isEchoFileEnabled(enum e_echo_files echo_option) {
     if (echoFileEnabled == nullptr) {
         return false;
@@ -91,6 +91,14 @@ void setEchoFileName(enum e_echo_files echo_option, const char* name);
 bool isEchoFileEnabled(enum e_echo_files echo_option);
 char* getEchoFileName(enum e_echo_files echo_option);
 
+/* Enables the timing graph echo files (which tatum_test replays) of a comma separated list of
+ * stages: pre_pack, place_initial, place_final, route_final, analysis, or all */
+void setTimingGraphEchoStages(const std::string& stages);
+
+/* Whether the clock domains of the timing graph echo files are named by number rather than by netlist name */
+bool getTimingGraphEchoAnonymized();
+void setTimingGraphEchoAnonymized(bool anonymized);
+
 void alloc_and_load_echo_file_info();
 void free_echo_file_info();
 
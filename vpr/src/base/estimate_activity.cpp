@@ -0,0 +1,376 @@
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "estimate_activity.h"
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_util.h"
+
+#include "vpr_error.h"
+
+#include "atom_netlist.h"
+#include "atom_netlist_utils.h"
+
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
+namespace {
+
+///@brief The value of a net on each of the vector streams (one bit per stream)
+typedef uint64_t t_lanes;
+
+constexpr size_t NUM_LANES = 64;
+
+///@brief The number of batches of NUM_LANES vector streams (simulated in parallel)
+constexpr size_t NUM_BATCHES = 8;
+
+///@brief The activities of the primary inputs (as assumed by ACE)
+constexpr double PI_STATIC_PROB = 0.5;
+constexpr double PI_SWITCH_PROB = 0.2;
+
+///@brief The activities of the clocks (as assigned by ACE)
+constexpr float CLOCK_STATIC_PROB = 0.5;
+constexpr float CLOCK_DENSITY = 2.;
+
+constexpr t_lanes ALL_LANES = ~t_lanes(0);
+
+constexpr int NO_NET = -1;
+
+///@brief A literal of a cube: the net (or NO_NET if unconnected) and whether it must be 1 (or 0)
+struct t_literal {
+    int net;
+    bool positive;
+};
+
+///@brief A LUT, as the cubes of its single output cover
+struct t_lut {
+    int out_net;
+    size_t cubes_begin; ///<Range of cube_literals_begin (cube i ends where cube i + 1 begins)
+    size_t cubes_end;
+    bool on_set; ///<Whether the cover encodes the on-set (or the off-set)
+};
+
+struct t_latch {
+    int d_net;
+    int q_net;
+    bool init_one;
+};
+
+///@brief The netlist compiled for simulation, shared (read-only) by all the batches
+struct t_sim_netlist {
+    size_t num_nets = 0;
+    std::vector<int> random_nets; ///<Primary inputs and outputs of the other primitives
+    std::vector<t_latch> latches;
+    std::vector<t_lut> luts; ///<In topological order
+
+    std::vector<size_t> cube_literals_begin; ///<Range of literals of each cube (plus the end of the last one)
+    std::vector<t_literal> literals;
+};
+
+///@brief The number of cycles at 1 and of switches of each net over all the streams
+struct t_activity_counts {
+    std::vector<uint64_t> ones;
+    std::vector<uint64_t> switches;
+};
+
+int net_index(AtomNetId net) {
+    return net ? int(size_t(net)) : NO_NET;
+}
+
+t_sim_netlist compile_netlist(const AtomNetlist& netlist, const std::set<AtomNetId>& clock_nets) {
+    t_sim_netlist sim;
+    for (AtomNetId net : netlist.nets()) {
+        sim.num_nets = std::max(sim.num_nets, size_t(net) + 1);
+    }
+
+    std::vector<AtomBlockId> lut_blocks;
+    for (AtomBlockId blk : netlist.blocks()) {
+        LogicalModelId model = netlist.block_model(blk);
+
+        if (netlist.block_type(blk) == AtomBlockType::OUTPAD) {
+            continue;
+        } else if (model == LogicalModels::MODEL_NAMES_ID) {
+            lut_blocks.push_back(blk);
+        } else if (model == LogicalModels::MODEL_LATCH_ID) {
+            t_latch latch{NO_NET, NO_NET, false};
+            for (AtomPinId pin : netlist.block_input_pins(blk)) {
+                latch.d_net = net_index(netlist.pin_net(pin));
+            }
+            for (AtomPinId pin : netlist.block_output_pins(blk)) {
+                latch.q_net = net_index(netlist.pin_net(pin));
+            }
+            //The initial value is stored as a single value in the truth table
+            const AtomNetlist::TruthTable& init = netlist.block_truth_table(blk);
+            latch.init_one = init.size() == 1 && init[0].size() == 1 && init[0][0] == vtr::LogicValue::TRUE;
+
+            if (latch.q_net != NO_NET) {
+                sim.latches.push_back(latch);
+            }
+        } else {
+            //Primary inputs, and the outputs of the other primitives
+            for (AtomPinId pin : netlist.block_output_pins(blk)) {
+                AtomNetId net = netlist.pin_net(pin);
+                if (net && !clock_nets.count(net)) {
+                    sim.random_nets.push_back(net_index(net));
+                }
+            }
+        }
+    }
+
+    //Order the LUTs topologically, each after the LUTs driving it
+    std::vector<int> lut_driving(sim.num_nets, NO_NET);
+    for (size_t ilut = 0; ilut < lut_blocks.size(); ilut++) {
+        for (AtomPinId pin : netlist.block_output_pins(lut_blocks[ilut])) {
+            if (netlist.pin_net(pin)) {
+                lut_driving[net_index(netlist.pin_net(pin))] = ilut;
+            }
+        }
+    }
+
+    std::vector<int> num_unordered_fanins(lut_blocks.size(), 0);
+    std::vector<std::vector<int>> lut_fanouts(lut_blocks.size());
+    for (size_t ilut = 0; ilut < lut_blocks.size(); ilut++) {
+        for (AtomPinId pin : netlist.block_input_pins(lut_blocks[ilut])) {
+            int net = net_index(netlist.pin_net(pin));
+            if (net != NO_NET && lut_driving[net] != NO_NET) {
+                num_unordered_fanins[ilut]++;
+                lut_fanouts[lut_driving[net]].push_back(ilut);
+            }
+        }
+    }
+
+    std::vector<int> lut_order;
+    std::queue<int> ready;
+    for (size_t ilut = 0; ilut < lut_blocks.size(); ilut++) {
+        if (num_unordered_fanins[ilut] == 0) {
+            ready.push(ilut);
+        }
+    }
+    while (!ready.empty()) {
+        int ilut = ready.front();
+        ready.pop();
+        lut_order.push_back(ilut);
+        for (int ifanout : lut_fanouts[ilut]) {
+            if (--num_unordered_fanins[ifanout] == 0) {
+                ready.push(ifanout);
+            }
+        }
+    }
+
+    if (lut_order.size() != lut_blocks.size()) {
+        //The LUTs on combinational loops read the values of the previous cycle
+        VTR_LOG_WARN("Activity estimation found %zu LUTs on combinational loops\n", lut_blocks.size() - lut_order.size());
+        for (size_t ilut = 0; ilut < lut_blocks.size(); ilut++) {
+            if (num_unordered_fanins[ilut] > 0) {
+                lut_order.push_back(ilut);
+            }
+        }
+    }
+
+    for (int ilut : lut_order) {
+        AtomBlockId blk = lut_blocks[ilut];
+
+        t_lut lut{NO_NET, 0, 0, true};
+        for (AtomPinId pin : netlist.block_output_pins(blk)) {
+            lut.out_net = net_index(netlist.pin_net(pin));
+        }
+        if (lut.out_net == NO_NET) {
+            continue;
+        }
+
+        //The net of each truth table column
+        const AtomNetlist::TruthTable& truth_table = netlist.block_truth_table(blk);
+        size_t num_columns = truth_table.empty() ? 0 : truth_table[0].size() - 1;
+        std::vector<int> column_nets(num_columns, NO_NET);
+        for (AtomPinId pin : netlist.block_input_pins(blk)) {
+            size_t column = netlist.pin_port_bit(pin);
+            if (column < num_columns) {
+                column_nets[column] = net_index(netlist.pin_net(pin));
+            }
+        }
+
+        lut.on_set = truth_table_encodes_on_set(truth_table);
+        lut.cubes_begin = sim.cube_literals_begin.size();
+        for (const std::vector<vtr::LogicValue>& row : truth_table) {
+            bool never_matches = false;
+            size_t literals_begin = sim.literals.size();
+            for (size_t column = 0; column < num_columns; column++) {
+                if (row[column] != vtr::LogicValue::TRUE && row[column] != vtr::LogicValue::FALSE) {
+                    continue; //Don't care
+                }
+                bool positive = row[column] == vtr::LogicValue::TRUE;
+                if (column_nets[column] == NO_NET) {
+                    //Unconnected inputs are 0
+                    never_matches |= positive;
+                    continue;
+                }
+                sim.literals.push_back({column_nets[column], positive});
+            }
+
+            if (never_matches) {
+                sim.literals.resize(literals_begin);
+            } else {
+                sim.cube_literals_begin.push_back(literals_begin);
+            }
+        }
+        lut.cubes_end = sim.cube_literals_begin.size();
+        sim.luts.push_back(lut);
+    }
+    sim.cube_literals_begin.push_back(sim.literals.size());
+
+    return sim;
+}
+
+///@brief Returns random lanes, each at 1 with probability prob (to 1/65536)
+t_lanes random_lanes(std::mt19937_64& rng, double prob) {
+    uint32_t fixed_prob = uint32_t(prob * 65536 + 0.5);
+    if (fixed_prob >= 65536) {
+        return ALL_LANES;
+    }
+
+    //Each bit of the fixed point probability (from its lsb) halves the probability of the
+    //lanes so far, adding 1/2 for the ones: after the msb, it is fixed_prob / 65536
+    t_lanes lanes = 0;
+    for (int ibit = 0; ibit < 16; ibit++) {
+        t_lanes coin = rng();
+        lanes = ((fixed_prob >> ibit) & 1) ? (lanes | coin) : (lanes & coin);
+    }
+    return lanes;
+}
+
+t_lanes evaluate_lut(const t_sim_netlist& sim, const t_lut& lut, const std::vector<t_lanes>& values) {
+    t_lanes covered = 0;
+    for (size_t icube = lut.cubes_begin; icube < lut.cubes_end; icube++) {
+        t_lanes matching = ALL_LANES;
+        for (size_t iliteral = sim.cube_literals_begin[icube]; iliteral < sim.cube_literals_begin[icube + 1]; iliteral++) {
+            const t_literal& literal = sim.literals[iliteral];
+            matching &= literal.positive ? values[literal.net] : ~values[literal.net];
+        }
+        covered |= matching;
+    }
+    return lut.on_set ? covered : ~covered;
+}
+
+///@brief Simulates a batch of NUM_LANES vector streams, from the initial latch values
+t_activity_counts simulate_batch(const t_sim_netlist& sim, int num_cycles, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+
+    t_activity_counts counts;
+    counts.ones.resize(sim.num_nets, 0);
+    counts.switches.resize(sim.num_nets, 0);
+
+    std::vector<t_lanes> values(sim.num_nets, 0);
+    std::vector<t_lanes> prev_values;
+    std::vector<t_lanes> next_latch_values(sim.latches.size());
+
+    for (const t_latch& latch : sim.latches) {
+        values[latch.q_net] = latch.init_one ? ALL_LANES : 0;
+    }
+    for (int net : sim.random_nets) {
+        values[net] = random_lanes(rng, PI_STATIC_PROB);
+    }
+
+    for (int cycle = 0; cycle < num_cycles; cycle++) {
+        if (cycle > 0) {
+            //The latches capture their inputs of the previous cycle
+            for (size_t ilatch = 0; ilatch < sim.latches.size(); ilatch++) {
+                int d_net = sim.latches[ilatch].d_net;
+                next_latch_values[ilatch] = (d_net != NO_NET) ? prev_values[d_net] : 0;
+            }
+            for (size_t ilatch = 0; ilatch < sim.latches.size(); ilatch++) {
+                values[sim.latches[ilatch].q_net] = next_latch_values[ilatch];
+            }
+
+            for (int net : sim.random_nets) {
+                values[net] ^= random_lanes(rng, PI_SWITCH_PROB);
+            }
+        }
+
+        for (const t_lut& lut : sim.luts) {
+            values[lut.out_net] = evaluate_lut(sim, lut, values);
+        }
+
+        for (size_t net = 0; net < sim.num_nets; net++) {
+            counts.ones[net] += __builtin_popcountll(values[net]);
+            if (cycle > 0) {
+                counts.switches[net] += __builtin_popcountll(values[net] ^ prev_values[net]);
+            }
+        }
+        prev_values = values;
+    }
+
+    return counts;
+}
+
+} // namespace
+
+std::unordered_map<AtomNetId, t_net_power> estimate_activity(const AtomNetlist& netlist,
+                                                             const LogicalModels& models,
+                                                             int num_cycles) {
+    VTR_ASSERT(num_cycles > 1);
+
+    std::set<AtomNetId> clock_nets = find_netlist_physical_clock_nets(netlist, models);
+    t_sim_netlist sim = compile_netlist(netlist, clock_nets);
+
+    //The batches are seeded by their index, so that the estimate does not depend on the thread scheduling
+    std::vector<t_activity_counts> batch_counts(NUM_BATCHES);
+    auto simulate = [&](size_t ibatch) {
+        batch_counts[ibatch] = simulate_batch(sim, num_cycles, ibatch + 1);
+    };
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), NUM_BATCHES, simulate);
+#else
+    for (size_t ibatch = 0; ibatch < NUM_BATCHES; ibatch++) {
+        simulate(ibatch);
+    }
+#endif
+
+    double num_samples = double(NUM_BATCHES * NUM_LANES) * num_cycles;
+    double num_transitions = double(NUM_BATCHES * NUM_LANES) * (num_cycles - 1);
+
+    std::unordered_map<AtomNetId, t_net_power> atom_net_power;
+    for (AtomNetId net : netlist.nets()) {
+        t_net_power& net_power = atom_net_power[net];
+        if (clock_nets.count(net)) {
+            net_power.probability = CLOCK_STATIC_PROB;
+            net_power.density = CLOCK_DENSITY;
+            continue;
+        }
+
+        uint64_t ones = 0;
+        uint64_t switches = 0;
+        for (const t_activity_counts& counts : batch_counts) {
+            ones += counts.ones[size_t(net)];
+            switches += counts.switches[size_t(net)];
+        }
+        net_power.probability = ones / num_samples;
+        net_power.density = switches / num_transitions;
+    }
+
+    return atom_net_power;
+}
+
+void write_activity(const AtomNetlist& netlist,
+                    const std::unordered_map<AtomNetId, t_net_power>& atom_net_power,
+                    const char* activity_file) {
+    FILE* act_file_hdl = vtr::fopen(activity_file, "w");
+    if (act_file_hdl == nullptr) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "Error: could not open activity file for writing: %s\n", activity_file);
+    }
+
+    for (AtomNetId net : netlist.nets()) {
+        auto net_power = atom_net_power.find(net);
+        if (net_power == atom_net_power.end()) {
+            continue;
+        }
+        fprintf(act_file_hdl, "%s %f %f\n", netlist.net_name(net).c_str(), net_power->second.probability, net_power->second.density);
+    }
+    fclose(act_file_hdl);
+}
@@ -0,0 +1,36 @@
+#pragma once
+/**
+ * @file
+ * @brief Estimates the signal activities of the (pre-packing) atom netlist by simulation,
+ *        as an alternative to reading them from an activity file produced by ACE.
+ *
+ * The netlist is simulated with random vectors on many independent vector streams at once:
+ * each net holds one bit per stream in a machine word, and the LUTs and latches are evaluated
+ * with bitwise operations. Batches of streams are simulated in parallel (with TBB).
+ *
+ * As with ACE, the primary inputs have a static probability of 0.5 and switch with a probability
+ * of 0.2 each cycle, and the clock nets have a static probability of 0.5 and switch twice per
+ * cycle. The outputs of the other primitives (hard blocks) are treated as primary inputs.
+ */
+
+#include <unordered_map>
+
+#include "atom_netlist_fwd.h"
+#include "logic_types.h"
+#include "vpr_types.h"
+
+/**
+ * @brief Returns the static probability and switching density of every net of the netlist,
+ *        from num_cycles cycles of simulation of each vector stream.
+ */
+std::unordered_map<AtomNetId, t_net_power> estimate_activity(const AtomNetlist& netlist,
+                                                             const LogicalModels& models,
+                                                             int num_cycles);
+
+/**
+ * @brief Writes the activities in the format of an activity file (see read_activity()):
+ *        one '<net name> <static probability> <switching density>' line per net.
+ */
+void write_activity(const AtomNetlist& netlist,
+                    const std::unordered_map<AtomNetId, t_net_power>& atom_net_power,
+                    const char* activity_file);
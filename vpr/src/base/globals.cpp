@@ -1,4 +1,8 @@
 #include "globals.h"
 #include "route_common.h"
 
-VprContext g_vpr_ctx;
+VprContext g_vpr_process_ctx;
+
+thread_local VprContext* g_vpr_thread_ctx = nullptr;
+
+const CurrentVprContext g_vpr_ctx;
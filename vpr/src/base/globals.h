@@ -6,4 +6,90 @@
 
 #include "vpr_context.h"
 
-extern VprContext g_vpr_ctx;
+/// @brief The context of the flow of the process (the default one)
+extern VprContext g_vpr_process_ctx;
+
+/// @brief The context of the flow the calling thread works for, if not the default one (see ScopedVprContext)
+extern thread_local VprContext* g_vpr_thread_ctx;
+
+/// @brief The context of the flow the calling thread works for
+inline VprContext& get_current_vpr_context() {
+    return g_vpr_thread_ctx ? *g_vpr_thread_ctx : g_vpr_process_ctx;
+}
+
+/**
+ * @brief Makes the calling thread work on another flow's context (until destroyed).
+ *
+ * This is how several flows can run in the same process (e.g. on different circuits):
+ *
+ *      VprContext flow_ctx(g_vpr_process_ctx.shared_device());
+ *      {
+ *          ScopedVprContext scope(flow_ctx);
+ *          ... // g_vpr_ctx is flow_ctx on this thread
+ *      }
+ *
+ * The worker threads running a flow's parallel tasks must use its context too (as vpr_flow() does).
+ */
+class ScopedVprContext {
+  public:
+    explicit ScopedVprContext(VprContext& ctx)
+        : prev_ctx_(g_vpr_thread_ctx) {
+        g_vpr_thread_ctx = &ctx;
+    }
+
+    ~ScopedVprContext() {
+        g_vpr_thread_ctx = prev_ctx_;
+    }
+
+    ScopedVprContext(const ScopedVprContext&) = delete;
+    ScopedVprContext& operator=(const ScopedVprContext&) = delete;
+
+  private:
+    VprContext* prev_ctx_;
+};
+
+/**
+ * @brief Accesses the sub-contexts of the flow of the calling thread, as a VprContext does.
+ *
+ * Functions taking the whole context are passed get_current_vpr_context().
+ */
+class CurrentVprContext {
+  public:
+    const AtomContext& atom() const { return get_current_vpr_context().atom(); }
+    AtomContext& mutable_atom() const { return get_current_vpr_context().mutable_atom(); }
+
+    const DeviceContext& device() const { return get_current_vpr_context().device(); }
+    DeviceContext& mutable_device() const { return get_current_vpr_context().mutable_device(); }
+
+    const TimingContext& timing() const { return get_current_vpr_context().timing(); }
+    TimingContext& mutable_timing() const { return get_current_vpr_context().mutable_timing(); }
+
+    const PowerContext& power() const { return get_current_vpr_context().power(); }
+    PowerContext& mutable_power() const { return get_current_vpr_context().mutable_power(); }
+
+    const ClusteringContext& clustering() const { return get_current_vpr_context().clustering(); }
+    ClusteringContext& mutable_clustering() const { return get_current_vpr_context().mutable_clustering(); }
+
+    const PlacementContext& placement() const { return get_current_vpr_context().placement(); }
+    PlacementContext& mutable_placement() const { return get_current_vpr_context().mutable_placement(); }
+
+    const RoutingContext& routing() const { return get_current_vpr_context().routing(); }
+    RoutingContext& mutable_routing() const { return get_current_vpr_context().mutable_routing(); }
+
+    const FloorplanningContext& floorplanning() const { return get_current_vpr_context().floorplanning(); }
+    FloorplanningContext& mutable_floorplanning() const { return get_current_vpr_context().mutable_floorplanning(); }
+
+    const NocContext& noc() const { return get_current_vpr_context().noc(); }
+    NocContext& mutable_noc() const { return get_current_vpr_context().mutable_noc(); }
+
+    const PackingMultithreadingContext& packing_multithreading() const { return get_current_vpr_context().packing_multithreading(); }
+    PackingMultithreadingContext& mutable_packing_multithreading() const { return get_current_vpr_context().mutable_packing_multithreading(); }
+
+#ifndef NO_SERVER
+    const ServerContext& server() const { return get_current_vpr_context().server(); }
+    ServerContext& mutable_server() const { return get_current_vpr_context().mutable_server(); }
+#endif /* NO_SERVER */
+};
+
+/// @brief VPR's state: the context of the flow of the calling thread
+extern const CurrentVprContext g_vpr_ctx;
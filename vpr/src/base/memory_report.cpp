@@ -0,0 +1,136 @@
+#include "memory_report.h"
+
+#include "vpr_context.h"
+#include "route_common.h"
+#include "route_tree.h"
+#include "router_lookahead.h"
+#include "tatum/TimingGraph.hpp"
+
+#include "vtr_log.h"
+#include "vtr_memory.h"
+#include "vtr_rusage.h"
+
+constexpr float BYTE_TO_MIB = 1024 * 1024;
+
+///@brief Estimated size of the entries of a hash map or set (each entry is a separate allocation with a next pointer and a hash)
+template<typename T>
+static size_t hash_entries_bytes(size_t num_entries) {
+    return num_entries * (sizeof(T) + 2 * sizeof(void*));
+}
+
+///@brief Estimated size of a vtr::flat_hash_map or set (one slot and control byte per entry, at most 7/8 full)
+template<typename T>
+static size_t flat_hash_bytes(size_t num_entries) {
+    return num_entries * (sizeof(T) + 1) * 8 / 7;
+}
+
+///@brief Bytes held by a vector of vectors
+template<typename Outer>
+static size_t nested_vector_bytes(const Outer& outer) {
+    size_t bytes = outer.capacity() * sizeof(typename Outer::value_type);
+    for (const auto& inner : outer) {
+        bytes += inner.capacity() * sizeof(typename Outer::value_type::value_type);
+    }
+    return bytes;
+}
+
+static void measure_device_context(const DeviceContext& device_ctx, std::vector<t_memory_usage>& usages) {
+    const DeviceGrid& grid = device_ctx.grid;
+    usages.push_back({"Device", "Grid", grid.get_num_layers() * grid.width() * grid.height() * sizeof(t_grid_tile)});
+    usages.push_back({"Device", "RR graph", device_ctx.rr_graph_builder.memory_used()});
+    usages.push_back({"Device", "RR indexed data", device_ctx.rr_indexed_data.capacity() * sizeof(t_rr_indexed_data)});
+    usages.push_back({"Device", "RR RC data", device_ctx.rr_rc_data.capacity() * sizeof(t_rr_rc_data)});
+    usages.push_back({"Device", "Non-configurable node sets", nested_vector_bytes(device_ctx.rr_non_config_node_sets)
+                                                                   + hash_entries_bytes<std::pair<RRNodeId, int>>(device_ctx.rr_node_to_non_config_node_set.size())});
+}
+
+static void measure_timing_context(const TimingContext& timing_ctx, std::vector<t_memory_usage>& usages) {
+    if (!timing_ctx.graph) {
+        return;
+    }
+
+    // Per node: its id, type, level, in/out edge lists and entry in its level.
+    // Per edge: its id, type, source, sink, disabled flag, and entries in the in/out edge lists.
+    const tatum::TimingGraph& graph = *timing_ctx.graph;
+    size_t node_bytes = 2 * sizeof(tatum::NodeId) + sizeof(tatum::NodeType) + sizeof(tatum::LevelId) + 2 * sizeof(std::vector<tatum::EdgeId>);
+    size_t edge_bytes = 3 * sizeof(tatum::EdgeId) + sizeof(tatum::EdgeType) + 2 * sizeof(tatum::NodeId) + sizeof(bool);
+    usages.push_back({"Timing", "Timing graph", graph.nodes().size() * node_bytes + graph.edges().size() * edge_bytes});
+}
+
+static void measure_placement_context(const PlacementContext& place_ctx, const DeviceGrid& grid, std::vector<t_memory_usage>& usages) {
+    usages.push_back({"Placement", "Block locations", place_ctx.block_locs().capacity() * sizeof(t_block_loc)});
+
+    const GridBlock& grid_blocks = place_ctx.grid_blocks();
+    size_t grid_blocks_bytes = 0;
+    for (const t_physical_tile_loc& loc : grid.all_locations()) {
+        grid_blocks_bytes += sizeof(t_grid_blocks) + grid_blocks.num_blocks_at_location(loc) * sizeof(ClusterBlockId);
+    }
+    usages.push_back({"Placement", "Grid blocks", grid_blocks_bytes});
+}
+
+static void measure_routing_context(const RoutingContext& route_ctx, std::vector<t_memory_usage>& usages) {
+    // The nodes of each route tree are allocated by its node pool, and the nodes in the tree are also held by its node look-up
+    size_t num_route_tree_nodes = 0;
+    size_t num_allocated_route_tree_nodes = 0;
+    for (const vtr::optional<RouteTree>& tree : route_ctx.route_trees) {
+        if (tree) {
+            for (const RouteTreeNode& node : tree->all_nodes()) {
+                (void)node;
+                num_route_tree_nodes++;
+            }
+            num_allocated_route_tree_nodes += tree->num_allocated_nodes();
+        }
+    }
+    usages.push_back({"Routing", "Route trees", route_ctx.route_trees.capacity() * sizeof(vtr::optional<RouteTree>)
+                                                    + num_allocated_route_tree_nodes * sizeof(RouteTreeNode)
+                                                    + flat_hash_bytes<std::pair<RRNodeId, RouteTreeNode*>>(num_route_tree_nodes)});
+
+    usages.push_back({"Routing", "RR node route info", route_ctx.rr_node_route_inf.capacity() * sizeof(t_rr_node_route_inf)});
+    usages.push_back({"Routing", "Net terminals", nested_vector_bytes(route_ctx.net_rr_terminals) + nested_vector_bytes(route_ctx.rr_blk_source)});
+    usages.push_back({"Routing", "Net bounding boxes", route_ctx.route_bb.capacity() * sizeof(t_bb)});
+
+    const RouterLookahead* lookahead = route_ctx.cached_router_lookahead_.get(route_ctx.router_lookahead_cache_key_);
+    if (lookahead) {
+        usages.push_back({"Routing", "Router lookahead", lookahead->memory_used()});
+    }
+}
+
+std::vector<t_memory_usage> measure_memory_usage(const VprContext& ctx) {
+    std::vector<t_memory_usage> usages;
+    measure_device_context(ctx.device(), usages);
+    measure_timing_context(ctx.timing(), usages);
+    if (!ctx.placement().block_locs().empty()) {
+        measure_placement_context(ctx.placement(), ctx.device().grid, usages);
+    }
+    measure_routing_context(ctx.routing(), usages);
+
+    std::vector<t_memory_usage> non_empty;
+    for (t_memory_usage& usage : usages) {
+        if (usage.bytes > 0) {
+            non_empty.push_back(std::move(usage));
+        }
+    }
+    return non_empty;
+}
+
+void report_memory_usage(const VprContext& ctx, const std::string& stage) {
+    std::vector<t_memory_usage> usages = measure_memory_usage(ctx);
+
+    VTR_LOG("\nMemory usage after %s:\n", stage.c_str());
+    VTR_LOG("  %-10s %-28s %12s\n", "Context", "Structure", "Size (MiB)");
+    size_t total_bytes = 0;
+    for (const t_memory_usage& usage : usages) {
+        VTR_LOG("  %-10s %-28s %12.1f\n", usage.context.c_str(), usage.structure.c_str(), usage.bytes / BYTE_TO_MIB);
+        total_bytes += usage.bytes;
+    }
+    VTR_LOG("  %-39s %12.1f\n", "Total", total_bytes / BYTE_TO_MIB);
+    VTR_LOG("  Peak resident set size: %.1f MiB\n", vtr::get_max_rss() / BYTE_TO_MIB);
+
+    if (vtr::allocation_counting_enabled()) {
+        vtr::t_allocation_stats stats = vtr::get_allocation_stats();
+        VTR_LOG("  Heap in use: %.1f MiB, peak since the previous report: %.1f MiB (%zu allocations so far)\n",
+                stats.bytes_in_use / BYTE_TO_MIB, stats.peak_bytes_in_use / BYTE_TO_MIB, stats.num_allocations);
+        vtr::reset_peak_bytes_in_use();
+    }
+    VTR_LOG("\n");
+}
@@ -0,0 +1,31 @@
+#pragma once
+/**
+ * @file
+ * @brief Accounting of the memory held by the major data structures of the VPR contexts.
+ *
+ * The sizes are computed from the capacities of the containers, so they miss the allocator
+ * overheads (and are estimates for node-based containers), but they show which structure
+ * dominates the memory footprint after each stage.
+ */
+
+#include <string>
+#include <vector>
+
+class VprContext;
+
+///@brief Memory held by one data structure
+struct t_memory_usage {
+    std::string context;   ///<Context holding the structure (e.g. "Device")
+    std::string structure; ///<Name of the structure (e.g. "RR graph")
+    size_t bytes;
+};
+
+///@brief Returns the memory held by the major data structures of the contexts (empty structures are skipped)
+std::vector<t_memory_usage> measure_memory_usage(const VprContext& ctx);
+
+/**
+ * @brief Logs the memory held by each major data structure after the given stage,
+ *        with the peak resident set size and (if counted, see vtr::allocation_counting_enabled())
+ *        the heap usage and peak heap usage since the previous report.
+ */
+void report_memory_usage(const VprContext& ctx, const std::string& stage);
@@ -281,6 +281,10 @@
  * a remove_*() function, and instead batch up calls to remove_*() and call compress() only after a set of
  * modifications have been applied.
  *
+ * Similarly, when removing many blocks or pins at once prefer remove_blocks() and remove_pins(): each net
+ * losing pins is then updated in a single pass, rather than searched once for every removed pin (which is
+ * quadratic in the fanout of the net).
+ *
  * Verifying the netlist
  * ---------------------
  * Particularly after construction and/or modification it is a good idea to check that the netlist is in
@@ -555,6 +559,14 @@ class Netlist {
      */
     void remove_block(const BlockId blk_id);
 
+    /**
+     * @brief Removes several blocks from the netlist, with their ports and pins.
+     *
+     * Same as calling remove_block() on each block, but each net losing pins is updated only once.
+     *   @param blk_ids  The (distinct) blocks to be removed
+     */
+    void remove_blocks(const std::vector<BlockId>& blk_ids);
+
     /*
      * Ports
      */
@@ -638,6 +650,14 @@ class Netlist {
      */
     void remove_pin(const PinId pin_id);
 
+    /**
+     * @brief Removes several pins from the netlist.
+     *
+     * Same as calling remove_pin() on each pin, but each net losing pins is updated only once.
+     *   @param pin_ids  The (distinct) pins to be removed
+     */
+    void remove_pins(const std::vector<PinId>& pin_ids);
+
     /*
      * Nets
      */
@@ -5,6 +5,11 @@
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vpr_error.h"
+
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_invoke.h>
+#endif
+
 /*
  *
  * NetlistIdRemapper class implementation
@@ -988,6 +993,45 @@ void Netlist<BlockId, PortId, PinId, NetId>::remove_block(const BlockId blk_id)
     dirty_ = true;
 }
 
+template<typename BlockId, typename PortId, typename PinId, typename NetId>
+void Netlist<BlockId, PortId, PinId, NetId>::remove_blocks(const std::vector<BlockId>& blk_ids) {
+    //Remove the pins of all the blocks together
+    std::vector<PinId> pin_ids;
+    for (BlockId blk_id : blk_ids) {
+        VTR_ASSERT(valid_block_id(blk_id));
+        for (PortId block_port : block_ports(blk_id)) {
+            VTR_ASSERT(valid_port_id(block_port));
+            for (PinId pin : port_pins(block_port)) {
+                if (valid_pin_id(pin)) {
+                    pin_ids.push_back(pin);
+                }
+            }
+        }
+    }
+    remove_pins(pin_ids);
+
+    for (BlockId blk_id : blk_ids) {
+        //Remove the (now empty) ports
+        for (PortId block_port : block_ports(blk_id)) {
+            port_ids_[block_port] = PortId::INVALID();
+            remove_port_impl(block_port);
+        }
+
+        //Invalidate look-up
+        StringId name_id = block_names_[blk_id];
+        block_name_to_block_id_.insert(name_id, BlockId::INVALID());
+
+        //Call derived class' remove()
+        remove_block_impl(blk_id);
+
+        //Mark as invalid
+        block_ids_[blk_id] = BlockId::INVALID();
+
+        //Mark netlist dirty
+        dirty_ = true;
+    }
+}
+
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
 void Netlist<BlockId, PortId, PinId, NetId>::remove_port(const PortId port_id) {
     VTR_ASSERT(valid_port_id(port_id));
@@ -1029,6 +1073,56 @@ void Netlist<BlockId, PortId, PinId, NetId>::remove_pin(const PinId pin_id) {
     dirty_ = true;
 }
 
+template<typename BlockId, typename PortId, typename PinId, typename NetId>
+void Netlist<BlockId, PortId, PinId, NetId>::remove_pins(const std::vector<PinId>& pin_ids) {
+    //Mark the pins invalid, and find the nets they are removed from
+    std::vector<NetId> nets;
+    for (PinId pin_id : pin_ids) {
+        VTR_ASSERT(valid_pin_id(pin_id));
+
+        NetId net = pin_nets_[pin_id];
+        if (valid_net_id(net)) {
+            nets.push_back(net);
+        }
+
+        pin_ids_[pin_id] = PinId::INVALID();
+        pin_nets_[pin_id] = NetId::INVALID();
+        pin_net_indices_[pin_id] = INVALID_INDEX;
+    }
+
+    //Drop the removed pins from each net in a single pass
+    auto is_removed = [&](PinId pin) {
+        return pin && !pin_ids_[pin];
+    };
+    std::sort(nets.begin(), nets.end());
+    nets.erase(std::unique(nets.begin(), nets.end()), nets.end());
+    for (NetId net : nets) {
+        std::vector<PinId>& pins = net_pins_[net];
+        VTR_ASSERT(!pins.empty());
+
+        if (is_removed(pins[NET_DRIVER_INDEX])) {
+            //Mark no driver
+            pins[NET_DRIVER_INDEX] = PinId::INVALID();
+        }
+        pins.erase(std::remove_if(pins.begin() + NET_DRIVER_INDEX + 1, pins.end(), is_removed), pins.end());
+
+        //Unlike remove_net_pin(), keep the net indices of the remaining pins up to date
+        for (size_t i = 0; i < pins.size(); i++) {
+            if (pins[i]) {
+                pin_net_indices_[pins[i]] = i;
+            }
+        }
+    }
+
+    for (PinId pin_id : pin_ids) {
+        //Call derived class' remove()
+        remove_pin_impl(pin_id);
+
+        //Mark netlist dirty
+        dirty_ = true;
+    }
+}
+
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
 void Netlist<BlockId, PortId, PinId, NetId>::remove_net(const NetId net_id) {
     VTR_ASSERT(valid_net_id(net_id));
@@ -1109,24 +1203,42 @@ typename Netlist<BlockId, PortId, PinId, NetId>::IdRemapper Netlist<BlockId, Por
     // e.g. block_id_map[old_id] == new_id
     IdRemapper id_remapper = build_id_maps();
 
-    clean_nets(id_remapper.net_id_map_);
-    clean_pins(id_remapper.pin_id_map_);
-    clean_ports(id_remapper.port_id_map_);
-    clean_blocks(id_remapper.block_id_map_);
+    //Each kind of netlist component is cleaned independently of the others,
+    //so they are cleaned in parallel (when built with TBB)
+    auto clean_net_data = [&]() { clean_nets(id_remapper.net_id_map_); };
+    auto clean_pin_data = [&]() { clean_pins(id_remapper.pin_id_map_); };
+    auto clean_port_data = [&]() { clean_ports(id_remapper.port_id_map_); };
+    auto clean_block_data = [&]() { clean_blocks(id_remapper.block_id_map_); };
     //TODO: clean strings
     //TODO: iterative cleaning?
 
     //Now we re-build all the cross references
     // Note: net references must be rebuilt (to remove pins) before
     //       the pin references can be rebuilt (to account for index changes
-    //       due to pins being removed from the net)
-    rebuild_block_refs(id_remapper.pin_id_map_, id_remapper.port_id_map_);
-    rebuild_port_refs(id_remapper.block_id_map_, id_remapper.pin_id_map_);
-    rebuild_net_refs(id_remapper.pin_id_map_);
-    rebuild_pin_refs(id_remapper.port_id_map_, id_remapper.net_id_map_);
-
-    //Re-build the lookups
-    rebuild_lookups();
+    //       due to pins being removed from the net). The other references,
+    //       and the lookups, only depend on the cleaned data.
+    auto rebuild_block_data = [&]() { rebuild_block_refs(id_remapper.pin_id_map_, id_remapper.port_id_map_); };
+    auto rebuild_port_data = [&]() { rebuild_port_refs(id_remapper.block_id_map_, id_remapper.pin_id_map_); };
+    auto rebuild_net_and_pin_data = [&]() {
+        rebuild_net_refs(id_remapper.pin_id_map_);
+        rebuild_pin_refs(id_remapper.port_id_map_, id_remapper.net_id_map_);
+    };
+    auto rebuild_lookup_data = [&]() { rebuild_lookups(); };
+
+#if defined(VPR_USE_TBB)
+    tbb::parallel_invoke(clean_net_data, clean_pin_data, clean_port_data, clean_block_data);
+    tbb::parallel_invoke(rebuild_block_data, rebuild_port_data, rebuild_net_and_pin_data, rebuild_lookup_data);
+#else
+    clean_net_data();
+    clean_pin_data();
+    clean_port_data();
+    clean_block_data();
+
+    rebuild_block_data();
+    rebuild_port_data();
+    rebuild_net_and_pin_data();
+    rebuild_lookup_data();
+#endif
 
     //Resize containers to exact size
     shrink_to_fit();
@@ -1304,7 +1416,7 @@ template<typename BlockId, typename PortId, typename PinId, typename NetId>
 void Netlist<BlockId, PortId, PinId, NetId>::rebuild_block_refs(const vtr::vector_map<PinId, PinId>& pin_id_map,
                                                                 const vtr::vector_map<PortId, PortId>& port_id_map) {
     //Update the pin id references held by blocks
-    for (auto blk_id : blocks()) {
+    parallel_for_ids(blocks(), [&](BlockId blk_id) {
         //Before update the references, we need to know how many are valid,
         //so we can also update the numbers of input/output/clock pins
 
@@ -1339,7 +1451,7 @@ void Netlist<BlockId, PortId, PinId, NetId>::rebuild_block_refs(const vtr::vecto
 
         VTR_ASSERT_SAFE_MSG(all_valid(blk_ports), "All Ids should be valid");
         VTR_ASSERT(blk_ports.size() == size_t(block_num_input_ports_[blk_id] + block_num_output_ports_[blk_id] + block_num_clock_ports_[blk_id]));
-    }
+    });
 
     rebuild_block_refs_impl(pin_id_map, port_id_map);
 
@@ -1355,10 +1467,11 @@ void Netlist<BlockId, PortId, PinId, NetId>::rebuild_port_refs(const vtr::vector
 
     VTR_ASSERT(port_blocks_.size() == port_ids_.size());
 
-    for (auto& pin_collection : port_pins_) {
+    parallel_for_ids(ports(), [&](PortId port_id) {
+        std::vector<PinId>& pin_collection = port_pins_[port_id];
         pin_collection = update_valid_refs(pin_collection, pin_id_map);
         VTR_ASSERT_SAFE_MSG(all_valid(pin_collection), "All Ids should be valid");
-    }
+    });
 
     rebuild_port_refs_impl(block_id_map, pin_id_map);
 
@@ -1383,13 +1496,19 @@ void Netlist<BlockId, PortId, PinId, NetId>::rebuild_pin_refs(const vtr::vector_
     //were removed)
     //
     //Note that for this to work correctly, the net references must have already been re-built!
-    for (auto net : nets()) {
+    //
+    //Each pin belongs to a single net, so the nets can be processed in parallel
+    //
+    //The driver of an undriven net is INVALID, and has no index to update
+    parallel_for_ids(nets(), [&](NetId net) {
         int i = 0;
         for (auto pin : net_pins(net)) {
-            pin_net_indices_[pin] = i;
+            if (pin) {
+                pin_net_indices_[pin] = i;
+            }
             ++i;
         }
-    }
+    });
 
     rebuild_pin_refs_impl(port_id_map, net_id_map);
 
@@ -1399,13 +1518,16 @@ void Netlist<BlockId, PortId, PinId, NetId>::rebuild_pin_refs(const vtr::vector_
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
 void Netlist<BlockId, PortId, PinId, NetId>::rebuild_net_refs(const vtr::vector_map<PinId, PinId>& pin_id_map) {
     //Update pin references held by nets
-    for (auto& pin_collection : net_pins_) {
-        //We take special care to preserve the driver index, since an INVALID id is used
-        //to indicate an undriven net it should not be dropped during the update
-        pin_collection = update_valid_refs(pin_collection, pin_id_map, {NET_DRIVER_INDEX});
-
-        VTR_ASSERT_SAFE_MSG(all_valid(pin_collection), "All sinks should be valid");
-    }
+    //
+    //We take special care to preserve the driver index, since an INVALID id is used
+    //to indicate an undriven net it should not be dropped during the update
+    const std::set<size_t> preserved_indices = {NET_DRIVER_INDEX};
+    parallel_for_ids(nets(), [&](NetId net) {
+        std::vector<PinId>& pin_collection = net_pins_[net];
+        pin_collection = update_valid_refs(pin_collection, pin_id_map, preserved_indices);
+
+        VTR_ASSERT_SAFE_MSG(all_valid(vtr::make_range(pin_collection.begin() + NET_DRIVER_INDEX + 1, pin_collection.end())), "All sinks should be valid");
+    });
 
     rebuild_net_refs_impl(pin_id_map);
 
@@ -3,6 +3,10 @@
 #include "vtr_vector_map.h"
 #include <set>
 
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
 /*
  *
  * Templated utility functions for cleaning and reordering IdMaps
@@ -175,3 +179,21 @@ Container update_valid_refs(const Container& values,
     }
     return updated;
 }
+
+/**
+ * @brief Calls body(id) for each id in the range, in parallel if VPR is built with TBB
+ *
+ * The calls must be independent of each other (e.g. each only updates the data of its own id).
+ */
+template<typename Range, typename Body>
+void parallel_for_ids(const Range& ids, const Body& body) {
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), ids.size(), [&](size_t i) {
+        body(ids.begin()[i]);
+    });
+#else
+    for (auto id : ids) {
+        body(id);
+    }
+#endif
+}
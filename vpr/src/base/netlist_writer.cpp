@@ -32,6 +32,10 @@
  * methods setting up file-level global information (I/Os, net declarations etc.) and then ask each Instance to
  * print itself in the appropriate format to the appropriate file.
  *
+ * If VPR is built with TBB, the cell instances are printed in parallel (see print_cell_instances()):
+ * batches of instances are printed to separate buffers, which are then written in order. The output
+ * is the same as the serial output, whatever the number of threads.
+ *
  * Name Escaping
  * =============
  * One of the challenges in generating netlists is producing consistent naming of netlist elements.
@@ -83,10 +87,16 @@
 #include "vpr_error.h"
 #include "vpr_types.h"
 #include "vtr_assert.h"
+#include "vtr_async_file_writer.h"
 #include "vtr_log.h"
 #include "vtr_logic.h"
 #include "vtr_version.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
 /* Enable for extra output while calculating LUT masks */
 //#define DEBUG_LUT_MASK
 
@@ -953,6 +963,78 @@ class Assignment {
     std::string rval_;
 };
 
+/**
+ * @brief Prints the cell instances in order, and returns the number of unconnected nets created
+ *        while printing them.
+ *
+ * Calls print_instance(inst, os, unconn_count) for each instance, which prints the instance and
+ * uniquifies its unconnected nets by incrementing unconn_count.
+ *
+ * With TBB, the instances are split into chunks printed in parallel to separate buffers, each
+ * starting from an unconnected net count of zero. Once the count of every chunk is known, the
+ * chunks which create unconnected nets are printed again from their actual starting count (so
+ * the net names match the serial output), and the buffers are written in order. The chunks are
+ * processed in batches, bounding the memory held by the buffers.
+ */
+template<typename PrintInstance>
+size_t print_cell_instances(std::ostream& os,
+                            const std::vector<std::shared_ptr<Instance>>& cell_instances,
+                            const PrintInstance& print_instance) {
+    size_t unconn_count = 0;
+
+#ifdef VPR_USE_TBB
+    constexpr size_t CHUNK_SIZE = 256;
+    const size_t num_chunks = (cell_instances.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const size_t num_chunks_per_batch = 16 * std::max(1, tbb::this_task_arena::max_concurrency());
+
+    std::vector<std::string> chunk_buffers;
+    std::vector<size_t> chunk_unconn_counts;
+    for (size_t batch_begin = 0; batch_begin < num_chunks; batch_begin += num_chunks_per_batch) {
+        const size_t batch_size = std::min(num_chunks_per_batch, num_chunks - batch_begin);
+        chunk_buffers.assign(batch_size, std::string());
+        chunk_unconn_counts.assign(batch_size, 0);
+
+        auto print_chunk = [&](size_t ichunk, size_t chunk_unconn_count) {
+            std::ostringstream chunk_os;
+            size_t inst_begin = (batch_begin + ichunk) * CHUNK_SIZE;
+            size_t inst_end = std::min(inst_begin + CHUNK_SIZE, cell_instances.size());
+            for (size_t iinst = inst_begin; iinst < inst_end; ++iinst) {
+                print_instance(*cell_instances[iinst], chunk_os, chunk_unconn_count);
+            }
+            chunk_buffers[ichunk] = chunk_os.str();
+            return chunk_unconn_count;
+        };
+
+        tbb::parallel_for(size_t(0), batch_size, [&](size_t ichunk) {
+            chunk_unconn_counts[ichunk] = print_chunk(ichunk, 0);
+        });
+
+        // Starting unconnected net count of each chunk
+        std::vector<size_t> chunk_unconn_offsets(batch_size);
+        for (size_t ichunk = 0; ichunk < batch_size; ++ichunk) {
+            chunk_unconn_offsets[ichunk] = unconn_count;
+            unconn_count += chunk_unconn_counts[ichunk];
+        }
+
+        tbb::parallel_for(size_t(0), batch_size, [&](size_t ichunk) {
+            if (chunk_unconn_counts[ichunk] > 0 && chunk_unconn_offsets[ichunk] > 0) {
+                print_chunk(ichunk, chunk_unconn_offsets[ichunk]);
+            }
+        });
+
+        for (const std::string& chunk_buffer : chunk_buffers) {
+            os << chunk_buffer;
+        }
+    }
+#else
+    for (const auto& inst : cell_instances) {
+        print_instance(*inst, os, unconn_count);
+    }
+#endif
+
+    return unconn_count;
+}
+
 /**
  * @brief A class which writes post-synthesis netlists (Verilog and BLIF) and the SDF
  *
@@ -1113,10 +1195,9 @@ class NetlistWriterVisitor : public NetlistVisitor {
         //All the cell instances (to an internal buffer for now)
         std::stringstream instances_ss;
 
-        size_t unconn_count = 0;
-        for (auto& inst : cell_instances_) {
-            inst->print_verilog(instances_ss, unconn_count, depth + 1);
-        }
+        size_t unconn_count = print_cell_instances(instances_ss, cell_instances_, [depth](Instance& inst, std::ostream& os, size_t& inst_unconn_count) {
+            inst.print_verilog(os, inst_unconn_count, depth + 1);
+        });
 
         //Unconnected wires declarations
         if (unconn_count) {
@@ -1182,10 +1263,9 @@ class NetlistWriterVisitor : public NetlistVisitor {
         //The cells
         blif_os_ << "\n";
         blif_os_ << indent(depth) << "#Cell instances\n";
-        size_t unconn_count = 0;
-        for (auto& inst : cell_instances_) {
-            inst->print_blif(blif_os_, unconn_count);
-        }
+        print_cell_instances(blif_os_, cell_instances_, [](Instance& inst, std::ostream& os, size_t& inst_unconn_count) {
+            inst.print_blif(os, inst_unconn_count);
+        });
 
         blif_os_ << "\n";
         blif_os_ << indent(depth) << ".end\n";
@@ -1232,9 +1312,9 @@ class NetlistWriterVisitor : public NetlistVisitor {
         }
 
         //Cells
-        for (const auto& inst : cell_instances_) {
-            inst->print_sdf(sdf_os_, depth + 1);
-        }
+        print_cell_instances(sdf_os_, cell_instances_, [depth](Instance& inst, std::ostream& os, size_t& /*inst_unconn_count*/) {
+            inst.print_sdf(os, depth + 1);
+        });
 
         sdf_os_ << indent(depth) << ")\n";
     }
@@ -3062,9 +3142,10 @@ void netlist_writer(const std::string basename,
     VTR_LOG("Writing Implementation Netlist: %s\n", verilog_filename.c_str());
     VTR_LOG("Writing Implementation Netlist: %s\n", blif_filename.c_str());
     VTR_LOG("Writing Implementation SDF    : %s\n", sdf_filename.c_str());
-    std::ofstream verilog_os(verilog_filename);
-    std::ofstream blif_os(blif_filename);
-    std::ofstream sdf_os(sdf_filename);
+    // The netlists are written in the background, once complete in memory
+    std::ostringstream verilog_os;
+    std::ostringstream blif_os;
+    std::ostringstream sdf_os;
 
     NetlistWriterVisitor visitor(verilog_os, blif_os, sdf_os, delay_calc, models, opts);
 
@@ -3072,6 +3153,10 @@ void netlist_writer(const std::string basename,
 
     nl_walker.walk();
 
+    vtr::write_file_async(verilog_filename, std::move(verilog_os).str());
+    vtr::write_file_async(blif_filename, std::move(blif_os).str());
+    vtr::write_file_async(sdf_filename, std::move(sdf_os).str());
+
     if (opts.gen_post_implementation_sdc) {
         std::string sdc_filename = basename + "_post_synthesis.sdc";
 
@@ -3088,7 +3173,7 @@ void merged_netlist_writer(const std::string basename, std::shared_ptr<const Ana
 
     VTR_LOG("Writing Merged Implementation Netlist: %s\n", verilog_filename.c_str());
 
-    std::ofstream verilog_os(verilog_filename);
+    std::ostringstream verilog_os;
     // Don't write blif and sdf, pass dummy streams
     std::ofstream blif_os;
     std::ofstream sdf_os;
@@ -3098,4 +3183,6 @@ void merged_netlist_writer(const std::string basename, std::shared_ptr<const Ana
     NetlistWalker nl_walker(visitor);
 
     nl_walker.walk();
+
+    vtr::write_file_async(verilog_filename, std::move(verilog_os).str());
 }
@@ -0,0 +1,39 @@
+#include "numa_threads.h"
+
+#ifdef VPR_USE_TBB
+
+#include "vtr_numa.h"
+
+#include <algorithm>
+
+NumaPinningObserver::NumaPinningObserver(tbb::task_arena& arena, size_t node)
+    : tbb::task_scheduler_observer(arena)
+    , _node(node) {
+    arena.initialize();
+    observe(true);
+}
+
+NumaPinningObserver::NumaPinningObserver(size_t max_concurrency)
+    : _max_concurrency(std::max<size_t>(max_concurrency, 1))
+    , _spread(true) {
+    observe(true);
+}
+
+NumaPinningObserver::~NumaPinningObserver() {
+    observe(false);
+}
+
+void NumaPinningObserver::on_scheduler_entry(bool is_worker) {
+    /* The main thread isn't ours to pin: it runs the serial parts of the flow */
+    if (!is_worker)
+        return;
+
+    size_t node = _node;
+    if (_spread) {
+        size_t slot = std::min<size_t>(tbb::this_task_arena::current_thread_index(), _max_concurrency - 1);
+        node = slot * vtr::numa::num_nodes() / _max_concurrency;
+    }
+    vtr::numa::pin_current_thread(node);
+}
+
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+/**
+ * @file
+ * @brief Keeps the TBB worker threads of VPR on NUMA nodes (see --numa_aware_threads).
+ *
+ * On machines with several NUMA nodes, a worker thread migrating across nodes loses its local
+ * memory: the heaps and per-thread state it touched first stay on the node it came from.
+ * A NumaPinningObserver pins workers to the CPUs of a node whenever they join an arena, either
+ * to a single node (for the per-node arenas of the parallel router) or spread over all
+ * nodes in blocks of consecutive arena slots (for the default arena).
+ */
+
+#ifdef VPR_USE_TBB
+
+#include <cstddef>
+
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+
+class NumaPinningObserver : public tbb::task_scheduler_observer {
+  public:
+    /** Pins the workers joining \p arena to the CPUs of NUMA \p node */
+    NumaPinningObserver(tbb::task_arena& arena, size_t node);
+
+    /** Pins the workers joining the arena of the calling thread (usually the default arena) to the
+     * NUMA nodes, spreading its \p max_concurrency slots over the nodes in blocks */
+    explicit NumaPinningObserver(size_t max_concurrency);
+
+    ~NumaPinningObserver() override;
+
+    void on_scheduler_entry(bool is_worker) override;
+
+  private:
+    /** NUMA node of the workers (single-node observer) */
+    size_t _node = 0;
+    /** Arena slots spread over the nodes (spreading observer) */
+    size_t _max_concurrency = 0;
+    bool _spread = false;
+};
+
+#endif
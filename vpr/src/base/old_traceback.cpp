@@ -25,15 +25,33 @@ vtr::optional<RouteTree> TracebackCompat::traceback_to_route_tree(t_trace* head)
     return tree;
 }
 
+/** Build a route tree of net inet from a traceback. Unlike the tree built by traceback_to_route_tree(t_trace*),
+ * this one knows about the sinks of the net, so routing can carry on from it */
+vtr::optional<RouteTree> TracebackCompat::traceback_to_route_tree(t_trace* head, ParentNetId inet) {
+    if (head == nullptr)
+        return vtr::nullopt;
+
+    RouteTree tree(inet);
+    VTR_ASSERT(tree._root->inode == RRNodeId(head->index));
+
+    if (head->next)
+        traceback_to_route_tree_x(head->next, tree, tree._root, RRSwitchId(head->iswitch));
+
+    tree.reload_timing();
+    return tree;
+}
+
 /* Add the path indicated by the trace to parent */
 void TracebackCompat::traceback_to_route_tree_x(t_trace* trace, RouteTree& tree, RouteTreeNode* parent, RRSwitchId parent_switch) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
     RRNodeId inode = RRNodeId(trace->index);
 
-    RouteTreeNode* new_node = new RouteTreeNode(inode, parent_switch, parent);
+    RouteTreeNode* new_node = tree._node_pool.create(inode, parent_switch, parent);
+    new_node->net_pin_index = trace->net_pin_index; // Before add_node, which files the sinks of net trees
     tree.add_node(parent, new_node);
-    new_node->net_pin_index = trace->net_pin_index;
+    if (tree._net_id.is_valid() && new_node->net_pin_index > 0)
+        tree._is_isink_reached.set(new_node->net_pin_index, true);
     new_node->R_upstream = std::numeric_limits<float>::quiet_NaN();
     new_node->C_downstream = std::numeric_limits<float>::quiet_NaN();
     new_node->Tdel = std::numeric_limits<float>::quiet_NaN();
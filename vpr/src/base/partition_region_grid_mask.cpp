@@ -0,0 +1,30 @@
+#include "partition_region_grid_mask.h"
+
+#include <algorithm>
+
+#include "device_grid.h"
+
+PartitionRegionGridMask::PartitionRegionGridMask(const PartitionRegion& pr, const DeviceGrid& grid)
+    : states_({(size_t)grid.get_num_layers(), grid.width(), grid.height()}, e_loc_state::OUTSIDE) {
+    for (const Region& region : pr.get_regions()) {
+        if (region.empty()) {
+            continue;
+        }
+
+        const vtr::Rect<int>& rect = region.get_rect();
+        const auto [layer_low, layer_high] = region.get_layer_range();
+        const e_loc_state region_state = (region.get_sub_tile() == NO_SUBTILE) ? e_loc_state::INSIDE : e_loc_state::SUB_TILE;
+
+        // Regions may extend past the grid
+        for (int layer = std::max(layer_low, 0); layer <= std::min(layer_high, (int)states_.dim_size(0) - 1); layer++) {
+            for (int x = std::max(rect.xmin(), 0); x <= std::min(rect.xmax(), (int)states_.dim_size(1) - 1); x++) {
+                for (int y = std::max(rect.ymin(), 0); y <= std::min(rect.ymax(), (int)states_.dim_size(2) - 1); y++) {
+                    e_loc_state& state = states_[layer][x][y];
+                    if (state != e_loc_state::INSIDE) {
+                        state = region_state;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+/**
+ * @file
+ * @brief This file defines the PartitionRegionGridMask class, which tells in constant time whether a grid
+ * location is inside a PartitionRegion.
+ *
+ * PartitionRegion::is_loc_in_part_reg() scans the regions of the PartitionRegion, which is slow for the
+ * floorplan constraints made of many regions the placer checks each move against.
+ */
+
+#include <cstdint>
+
+#include "partition_region.h"
+#include "vtr_ndmatrix.h"
+
+class DeviceGrid;
+
+class PartitionRegionGridMask {
+  public:
+    PartitionRegionGridMask() = default;
+
+    /**
+     * @brief Precomputes which locations of the grid are inside the PartitionRegion.
+     *
+     *   @param pr      The PartitionRegion
+     *   @param grid    The device grid
+     */
+    PartitionRegionGridMask(const PartitionRegion& pr, const DeviceGrid& grid);
+
+    /**
+     * @brief Check if the given location is within the PartitionRegion the mask was built from.
+     * Equivalent to pr.is_loc_in_part_reg(loc), which is only called for the locations covered by
+     * regions restricted to a sub-tile.
+     *
+     *   @param loc     The location to be checked, assumed to be on the grid
+     *   @param pr      The PartitionRegion the mask was built from
+     */
+    bool is_loc_in_part_reg(const t_pl_loc& loc, const PartitionRegion& pr) const {
+        switch (states_[loc.layer][loc.x][loc.y]) {
+            case e_loc_state::OUTSIDE:
+                return false;
+            case e_loc_state::INSIDE:
+                return true;
+            default:
+                return pr.is_loc_in_part_reg(loc);
+        }
+    }
+
+  private:
+    enum class e_loc_state : uint8_t {
+        OUTSIDE,   ///< No region covers the location
+        INSIDE,    ///< A region covers all the sub-tiles of the location
+        SUB_TILE   ///< Only regions restricted to a sub-tile cover the location
+    };
+
+    ///@brief [0..num_layers-1][0..width-1][0..height-1]
+    vtr::NdMatrix<e_loc_state, 3> states_;
+};
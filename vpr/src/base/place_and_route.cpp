@@ -1,6 +1,8 @@
 
+#include <cerrno>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
 #include <algorithm>
 
@@ -26,11 +28,49 @@
 
 #include "RoutingDelayCalculator.h"
 
+#ifndef NO_GRAPHICS
+#include "draw_global.h"
+#endif
+
+#ifdef VPR_USE_TBB
+#include <tbb/global_control.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define VPR_CAN_FORK
+#endif
+
 /******************* Subroutines local to this module ************************/
 
 static int compute_chan_width(int cfactor, t_chan chan_dist, float distance, float separation, e_graph_type graph_directionality);
 static float comp_width(t_chan* chan, float x, float separation);
 
+/* With the PRODUCTION routing failure predictor, the minimum channel width search treats the channel
+ * widths up to this fraction of the way from an unroutable width W to W * (peak channel utilization)
+ * as unroutable too, without trying them. The hottest channel of a hopeless routing would need that
+ * many more tracks, but only part of its excess demand survives once the congestion can spread out. */
+constexpr float PREDICTED_UNROUTABLE_WIDTH_FRAC = 0.5;
+
+static bool parallel_chan_width_search(const Netlist<>& router_net_list,
+                                       const t_placer_opts& placer_opts,
+                                       const t_router_opts& router_opts,
+                                       const t_analysis_opts& analysis_opts,
+                                       const t_arch* arch,
+                                       t_det_routing_arch& det_routing_arch,
+                                       std::vector<t_segment_inf>& segment_inf,
+                                       NetPinsMatrix<float>& net_delay,
+                                       const std::shared_ptr<SetupHoldTimingInfo>& timing_info,
+                                       const std::shared_ptr<RoutingDelayCalculator>& delay_calc,
+                                       bool is_flat,
+                                       int udsd_multiplier,
+                                       int current,
+                                       int& low,
+                                       int& high);
+
+static std::vector<int> chan_width_search_candidates(int current, int low, int high, int num_jobs, int udsd_multiplier, int Fs);
+
 /************************* Subroutine Definitions ****************************/
 
 /**
@@ -139,6 +179,16 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
 
     attempt_count = 0;
 
+    if (router_opts.chan_width_search_jobs > 1 && router_opts.fixed_channel_width == NO_FIXED_CHANNEL_WIDTH
+        && parallel_chan_width_search(router_net_list, placer_opts, router_opts, analysis_opts, arch,
+                                      det_routing_arch, segment_inf, net_delay, timing_info, delay_calc, is_flat,
+                                      udsd_multiplier, current, low, high)) {
+        // Route the minimum routable width found again, in this process, so we get its routing.
+        // It is then the final width, unless the router disagrees with its earlier run.
+        current = high;
+        high = -1;
+    }
+
     while (final == -1) {
         VTR_LOG("\n");
         VTR_LOG("Attempting to route at %d channels (binary search bounds: [%d, %d])\n", current, low, high);
@@ -181,6 +231,7 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
                       FlatPlacementInfo(), // Pass empty flat placement info.
                       /*is_flat=*/false);
         }
+        RoutingFailureEstimate failure_estimate;
         success = route(router_net_list,
                         current,
                         router_opts,
@@ -192,7 +243,8 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
                         arch->Chans,
                         arch->directs,
                         (attempt_count == 0) ? ScreenUpdatePriority::MAJOR : ScreenUpdatePriority::MINOR,
-                        is_flat);
+                        is_flat,
+                        &failure_estimate);
 
         attempt_count++;
         fflush(stdout);
@@ -254,6 +306,21 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
                 success = false;
             }
             low = current;
+
+            // Skip the widths just above a hopeless one, which are predicted to fail as well
+            if (router_opts.routing_failure_predictor == PRODUCTION && failure_estimate.predicted_unroutable) {
+                int predicted_low = current + (int)(PREDICTED_UNROUTABLE_WIDTH_FRAC * current * (failure_estimate.peak_channel_util - 1.));
+                predicted_low -= predicted_low % udsd_multiplier;
+                if (high != -1) {
+                    predicted_low = std::min(predicted_low, high - udsd_multiplier);
+                }
+                if (predicted_low > low) {
+                    VTR_LOG("Skipping channel widths up to %d, predicted to be unroutable (peak channel utilization %.2f)\n",
+                            predicted_low, failure_estimate.peak_channel_util);
+                    low = predicted_low;
+                }
+            }
+
             if (high != -1) {
                 if ((high - low) <= 1 * udsd_multiplier) { //No more steps
                     final = high;
@@ -407,6 +474,187 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
     return (final);
 }
 
+/**
+ * @brief Narrows the minimum channel width search down by routing several channel widths at once,
+ *        each in a forked copy of this process.
+ *
+ * Each round routes up to router_opts.chan_width_search_jobs widths: growing geometrically from
+ * current while no routable width is known, then evenly spaced between the bounds.
+ *
+ * A round in which no child completes (they all crashed, or couldn't be forked) ends the search,
+ * since the next round would try the same widths.
+ *
+ * @return False if the search can't run in parallel here, or found no routable width, leaving the
+ *         bounds untouched. Otherwise true, with high the smallest width known to route and low the
+ *         largest one below it known not to (or -1), at most udsd_multiplier apart unless a round
+ *         ended the search early.
+ */
+static bool parallel_chan_width_search(const Netlist<>& router_net_list,
+                                       const t_placer_opts& placer_opts,
+                                       const t_router_opts& router_opts,
+                                       const t_analysis_opts& analysis_opts,
+                                       const t_arch* arch,
+                                       t_det_routing_arch& det_routing_arch,
+                                       std::vector<t_segment_inf>& segment_inf,
+                                       NetPinsMatrix<float>& net_delay,
+                                       const std::shared_ptr<SetupHoldTimingInfo>& timing_info,
+                                       const std::shared_ptr<RoutingDelayCalculator>& delay_calc,
+                                       bool is_flat,
+                                       int udsd_multiplier,
+                                       int current,
+                                       int& low,
+                                       int& high) {
+#ifndef VPR_CAN_FORK
+    VTR_LOG_WARN("Routing several channel widths at once is not supported on this platform, searching one width at a time\n");
+    return false;
+#else
+    if (placer_opts.place_freq == PLACE_ALWAYS) {
+        VTR_LOG_WARN("Routing several channel widths at once requires a fixed placement, searching one width at a time\n");
+        return false;
+    }
+#ifndef NO_GRAPHICS
+    if (get_draw_state_vars()->show_graphics) {
+        VTR_LOG_WARN("Routing several channel widths at once is not supported with graphics, searching one width at a time\n");
+        return false;
+    }
+#endif
+#ifdef VPR_USE_TBB
+    // A forked child only gets the calling thread, so shut down the TBB worker threads first: the
+    // children (and this process) then lazily start a fresh TBB scheduler of their own
+    tbb::task_scheduler_handle tbb_handle{tbb::attach{}};
+    if (!tbb::finalize(tbb_handle, std::nothrow)) {
+        VTR_LOG_WARN("Could not stop the TBB worker threads to route several channel widths at once, searching one width at a time\n");
+        return false;
+    }
+#endif
+
+    const int initial_low = low;
+    while (high == -1 || high - std::max(low, 0) > udsd_multiplier) {
+        std::vector<int> widths = chan_width_search_candidates(current, low, high, router_opts.chan_width_search_jobs, udsd_multiplier, det_routing_arch.Fs);
+        if (widths.empty() && high != -1) {
+            break; // Nothing left worth routing in parallel
+        } else if (widths.empty()) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "This circuit requires a channel width above 1000, probably is not going to route.\n"
+                            "Aborting routing procedure.\n");
+        }
+
+        VTR_LOG("\n");
+        VTR_LOG("Attempting to route at %s channels in parallel (binary search bounds: [%d, %d])\n",
+                vtr::join(widths, ", ").c_str(), low, high);
+
+        // Don't let the children inherit (and print again) buffered output
+        fflush(nullptr);
+
+        std::vector<pid_t> jobs;
+        for (int width : widths) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                // Child: route this width with its own log, and report the outcome in the exit code
+                std::string log_filename = vtr::string_fmt("vpr_route_chan_width_%d.log", width);
+                vtr::set_log_file(log_filename.c_str());
+                if (!freopen("/dev/null", "w", stdout)) {
+                    _exit(2);
+                }
+
+                int exit_code = 2;
+                try {
+                    bool success = route(router_net_list, width, router_opts, analysis_opts,
+                                         det_routing_arch, segment_inf, net_delay, timing_info, delay_calc,
+                                         arch->Chans, arch->directs, ScreenUpdatePriority::MINOR, is_flat);
+                    exit_code = success ? 0 : 1;
+                } catch (const VprError& e) {
+                    VTR_LOG_ERROR("%s\n", e.what());
+                }
+                fflush(nullptr);
+                _exit(exit_code); // Skip the destructors and exit handlers of the parent's state
+            }
+
+            if (pid < 0) {
+                VTR_LOG_WARN("Could not fork a process to route at %d channels: %s\n", width, std::strerror(errno));
+            }
+            jobs.push_back(pid);
+        }
+
+        std::vector<bool> failed(jobs.size(), false);
+        bool any_result = false;
+        for (size_t ijob = 0; ijob < jobs.size(); ijob++) {
+            int width = widths[ijob];
+            if (jobs[ijob] < 0) {
+                continue; // Neither routable nor unroutable
+            }
+
+            int status = 0;
+            waitpid(jobs[ijob], &status, 0);
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+                VTR_LOG("Routing at %d channels succeeded\n", width);
+                any_result = true;
+                if (high == -1 || width < high) {
+                    high = width;
+                }
+            } else if (WIFEXITED(status) && WEXITSTATUS(status) == 1) {
+                VTR_LOG("Routing at %d channels failed\n", width);
+                failed[ijob] = true;
+                any_result = true;
+            } else {
+                VTR_LOG_WARN("Routing at %d channels did not complete, see vpr_route_chan_width_%d.log\n", width, width);
+            }
+        }
+
+        // Only the failures below the smallest routable width narrow the search: others are router flukes
+        for (size_t ijob = 0; ijob < jobs.size(); ijob++) {
+            if (failed[ijob] && (high == -1 || widths[ijob] < high)) {
+                low = std::max(low, widths[ijob]);
+            }
+        }
+
+        if (!any_result) {
+            // The same widths would be tried again: leave the rest of the search to this process
+            VTR_LOG_WARN("No channel width routed in parallel completed, searching one width at a time\n");
+            if (high == -1) {
+                low = initial_low;
+                return false;
+            }
+            break;
+        }
+
+        current = widths.back() * 2;
+    }
+
+    return true;
+#endif
+}
+
+/**
+ * @brief Returns the channel widths to try in the next round of the parallel minimum channel
+ *        width search, in increasing order.
+ */
+static std::vector<int> chan_width_search_candidates(int current, int low, int high, int num_jobs, int udsd_multiplier, int Fs) {
+    constexpr int MAX_CHAN_WIDTH = 1000;
+    int lower_bound = std::max(low, 0);
+
+    std::vector<int> widths;
+    for (int ijob = 0; ijob < num_jobs; ijob++) {
+        int width;
+        if (high == -1) {
+            // Haven't found an upper bound yet: double up from the current guess
+            width = current << ijob;
+        } else {
+            // Step to evenly spaced points between the bounds
+            width = lower_bound + (high - lower_bound) * (ijob + 1) / (num_jobs + 1);
+        }
+        width = (width + udsd_multiplier - 1) / udsd_multiplier * udsd_multiplier;
+
+        if (width <= lower_bound || (high != -1 && width >= high) || width > MAX_CHAN_WIDTH || width * 3 < Fs) {
+            continue;
+        }
+        widths.push_back(width);
+    }
+
+    widths.erase(std::unique(widths.begin(), widths.end()), widths.end());
+    return widths;
+}
+
 t_chan_width setup_chan_width(const t_router_opts& router_opts,
                               t_chan_width_dist chan_width_dist) {
     // we give plenty of tracks, this increases routability for the lookup table generation
@@ -6,8 +6,9 @@
  * hierarchical) netlist in Berkely Logic Interchange Format (BLIF) file, and
  * builds a netlist data structure (AtomNetlist) from it.
  *
- * BLIF text parsing is handled by the blifparse library, while this file is responsible
- * for creating the netlist data structure.
+ * BLIF text parsing is handled by the blifparse library (or by the faster BlifMmapParser,
+ * see blif_mmap_parser.h), while this file is responsible for creating the netlist data
+ * structure.
  *
  * The main object of interest is the BlifAllocCallback struct, which implements the
  * blifparse callback interface.  The callback methods are then called when basic blif
@@ -23,6 +24,7 @@
 #include <optional>
 
 #include "blifparse.hpp"
+#include "blif_mmap_parser.h"
 #include "atom_netlist.h"
 
 #include "logic_types.h"
@@ -34,7 +36,6 @@
 
 #include "vpr_error.h"
 #include "read_blif.h"
-#include "hash.h"
 
 vtr::LogicValue to_vtr_logic_value(blifparse::LogicValue);
 
@@ -717,12 +718,23 @@ bool is_real_param(const std::string& param) {
 
 AtomNetlist read_blif(e_circuit_format circuit_format,
                       const char* blif_file,
-                      const LogicalModels& models) {
+                      const LogicalModels& models,
+                      bool use_mmap_parser) {
     AtomNetlist netlist;
-    std::string netlist_id = vtr::secure_digest_file(blif_file);
 
-    BlifAllocCallback alloc_callback(circuit_format, netlist, netlist_id, models);
-    blifparse::blif_parse_filename(blif_file, alloc_callback);
+    if (use_mmap_parser) {
+        // The file is only read once: the digest is computed from its memory mapping
+        BlifMmapParser parser(blif_file);
+        std::string netlist_id = vtr::secure_digest_bytes(parser.data());
+
+        BlifAllocCallback alloc_callback(circuit_format, netlist, netlist_id, models);
+        parser.parse(alloc_callback);
+    } else {
+        std::string netlist_id = vtr::secure_digest_file(blif_file);
+
+        BlifAllocCallback alloc_callback(circuit_format, netlist, netlist_id, models);
+        blifparse::blif_parse_filename(blif_file, alloc_callback);
+    }
 
     return netlist;
 }
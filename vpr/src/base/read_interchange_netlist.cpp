@@ -15,14 +15,12 @@
 
 #include <cmath>
 #include <limits>
-#include <kj/std/iostream.h>
 #include <regex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
-#include <zlib.h>
 #include <iostream>
-#include <sstream>
+#include <vector>
 
 #include "LogicalNetlist.capnp.h"
 #include "capnp/serialize.h"
@@ -35,6 +33,19 @@
 
 #include "vpr_error.h"
 
+#include "serdes_utils.h"
+
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
+// Formats of the INIT parameter of the LUTs, built once (std::regex objects are costly to construct)
+static const std::regex VHEX_REGEX("[0-9]+'h([0-9A-Z]+)");
+static const std::regex VBIT_REGEX("[0-9]+'b([0-9]+)");
+static const std::regex CHEX_REGEX("0x([0-9A-Za-z]+)");
+static const std::regex CBIT_REGEX("0b([0-9]+)");
+static const std::regex BIT_REGEX("[0-1]+");
+
 struct NetlistReader {
   public:
     NetlistReader(AtomNetlist& main_netlist,
@@ -54,6 +65,7 @@ struct NetlistReader {
         auto str_list = nr_.getStrList();
         main_netlist_ = AtomNetlist(str_list[top_cell_instance_.getName()], netlist_id);
 
+        prepare_lut_cells();
         prepare_port_net_maps();
 
         VTR_LOG("Reading IOs...\n");
@@ -78,6 +90,28 @@ struct NetlistReader {
 
     std::unordered_map<size_t, std::unordered_map<std::pair<size_t, size_t>, std::string, vtr::hash_pair>> port_net_maps_;
 
+    /** @brief Whether a cell declaration is a LUT, its width and the name of its INIT parameter */
+    struct LutCellInfo {
+        bool is_lut = false;
+        int width = 0;
+        std::string init_param;
+    };
+
+    /** @brief LutCellInfo of each cell declaration, indexed like the cell declarations of the netlist */
+    std::vector<LutCellInfo> lut_cells_;
+
+    /** @brief Matches each cell declaration against the LUT cells of the architecture once, rather than for each instance */
+    void prepare_lut_cells() {
+        auto decl_list = nr_.getCellDecls();
+        auto str_list = nr_.getStrList();
+
+        lut_cells_.resize(decl_list.size());
+        for (size_t cell = 0; cell < decl_list.size(); cell++) {
+            LutCellInfo& info = lut_cells_[cell];
+            std::tie(info.is_lut, info.width, info.init_param) = is_lut_cell(str_list[decl_list[cell].getName()]);
+        }
+    }
+
     /** @brief Preprocesses the port net maps, populating the port_net_maps_ hash map to be later accessed for faster lookups */
     void prepare_port_net_maps() {
         auto inst_list = nr_.getInstList();
@@ -120,12 +154,7 @@ struct NetlistReader {
 
                 port_bit = start < end ? port_bit : bus_size - port_bit;
 
-                auto pair = std::make_pair(port_idx, port_bit);
-                std::unordered_map<std::pair<size_t, size_t>, std::string, vtr::hash_pair> map{{pair, net_name}};
-
-                auto result = port_net_maps_.emplace(inst, map);
-                if (!result.second)
-                    result.first->second.emplace(pair, net_name);
+                port_net_maps_[inst].emplace(std::make_pair(port_idx, port_bit), net_name);
             }
         }
     }
@@ -198,89 +227,30 @@ struct NetlistReader {
 
         std::vector<std::tuple<size_t, int, std::string>> insts;
         for (auto cell_inst : top_cell.getInsts()) {
-            auto cell = decl_list[inst_list[cell_inst].getCell()];
-
-            bool is_lut;
-            int width;
-            std::string init_param;
-            std::tie(is_lut, width, init_param) = is_lut_cell(str_list[cell.getName()]);
-
-            if (!is_lut)
-                continue;
-
-            insts.emplace_back(cell_inst, width, init_param);
+            const LutCellInfo& lut_info = lut_cells_[inst_list[cell_inst].getCell()];
+            if (lut_info.is_lut)
+                insts.emplace_back(cell_inst, lut_info.width, lut_info.init_param);
         }
 
-        for (auto inst : insts) {
-            size_t inst_idx;
-            int lut_width;
-            std::string init_param;
-            std::tie(inst_idx, lut_width, init_param) = inst;
+        // The INIT parameters of the LUTs are independent: decode them in parallel, then create the
+        // blocks serially, in netlist order, so that the netlist doesn't depend on the number of threads
+        std::vector<LutInit> lut_inits(insts.size());
+        auto decode_lut = [&](size_t i) {
+            lut_inits[i] = decode_lut_init(std::get<0>(insts[i]), std::get<1>(insts[i]), std::get<2>(insts[i]));
+        };
+#if defined(VPR_USE_TBB)
+        tbb::parallel_for(size_t(0), insts.size(), decode_lut);
+#else
+        for (size_t i = 0; i < insts.size(); i++)
+            decode_lut(i);
+#endif
+
+        for (size_t i = 0; i < insts.size(); i++) {
+            size_t inst_idx = std::get<0>(insts[i]);
+            const AtomNetlist::TruthTable& truth_table = lut_inits[i].truth_table;
 
             std::string inst_name = str_list[inst_list[inst_idx].getName()];
 
-            auto props = inst_list[inst_idx].getPropMap().getEntries();
-            std::vector<bool> init;
-            for (auto entry : props) {
-                if (str_list[entry.getKey()] != init_param)
-                    continue;
-
-                // TODO: export this to a library function to have generic parameter decoding
-                if (entry.which() == LogicalNetlist::Netlist::PropertyMap::Entry::TEXT_VALUE) {
-                    const std::regex vhex_regex("[0-9]+'h([0-9A-Z]+)");
-                    const std::regex vbit_regex("[0-9]+'b([0-9]+)");
-                    const std::regex chex_regex("0x([0-9A-Za-z]+)");
-                    const std::regex cbit_regex("0b([0-9]+)");
-                    const std::regex bit_regex("[0-1]+");
-                    std::string init_str = str_list[entry.getTextValue()];
-                    std::smatch regex_matches;
-
-                    // Fill the init vector
-                    if (std::regex_match(init_str, regex_matches, vhex_regex))
-                        for (const char& c : regex_matches[1].str()) {
-                            int value = std::stoi(std::string(1, c), 0, 16);
-                            for (int bit = 3; bit >= 0; bit--)
-                                init.push_back((value >> bit) & 1);
-                        }
-                    else if (std::regex_match(init_str, regex_matches, chex_regex))
-                        for (const char& c : regex_matches[1].str()) {
-                            int value = std::stoi(std::string(1, c), 0, 16);
-                            for (int bit = 3; bit >= 0; bit--)
-                                init.push_back((value >> bit) & 1);
-                        }
-                    else if (std::regex_match(init_str, regex_matches, vbit_regex))
-                        for (const char& c : regex_matches[1].str())
-                            init.push_back((bool)std::stoi(std::string(1, c), 0, 2));
-                    else if (std::regex_match(init_str, regex_matches, cbit_regex))
-                        for (const char& c : regex_matches[1].str())
-                            init.push_back((bool)std::stoi(std::string(1, c), 0, 2));
-                    else if (std::regex_match(init_str, regex_matches, bit_regex))
-                        for (const char& c : init_str)
-                            init.push_back((bool)std::stoi(std::string(1, c), 0, 2));
-                }
-            }
-
-            // Add proper LUT mapping function here based on LUT size and init value
-            AtomNetlist::TruthTable truth_table;
-            bool is_const = false;
-            for (int bit = 0; bit < (int)init.size(); bit++) {
-                bool bit_set = init[init.size() - bit - 1];
-
-                if (bit_set == 0)
-                    continue;
-
-                is_const = bit == 0;
-
-                truth_table.emplace_back();
-                for (int row_bit = lut_width - 1; row_bit >= 0; row_bit--) {
-                    bool row_bit_set = (bit >> row_bit) & 1;
-                    auto log_value = row_bit_set ? vtr::LogicValue::TRUE : vtr::LogicValue::FALSE;
-
-                    truth_table[truth_table.size() - 1].push_back(log_value);
-                }
-                truth_table[truth_table.size() - 1].push_back(vtr::LogicValue::TRUE);
-            }
-
             //Figure out if the output is a constant generator
             bool output_is_const = false;
             if (truth_table.empty()) {
@@ -299,7 +269,7 @@ struct NetlistReader {
                 //
                 output_is_const = true;
                 VTR_LOG("Found constant-zero generator '%s'\n", inst_name.c_str());
-            } else if (truth_table.size() == 1 && is_const) {
+            } else if (truth_table.size() == 1 && lut_inits[i].is_const) {
                 //A single-entry truth table with value '1' in BLIF corresponds to a constant-one
                 //  e.g.
                 //
@@ -317,7 +287,7 @@ struct NetlistReader {
             AtomPortId oport_id = main_netlist_.create_port(blk_id, blk_model.outputs);
 
             auto cell_lib = decl_list[inst_list[inst_idx].getCell()];
-            auto port_net_map = port_net_maps_.at(inst_idx);
+            const auto& port_net_map = port_net_maps_.at(inst_idx);
             int inum = 0;
             for (auto port : cell_lib.getPorts()) {
                 std::pair<size_t, size_t> pair{port, 0};
@@ -325,7 +295,7 @@ struct NetlistReader {
                 if (port_net_map.find(pair) == port_net_map.end())
                     continue;
 
-                auto net_name = port_net_map.at(pair);
+                const std::string& net_name = port_net_map.at(pair);
                 AtomNetId net_id = main_netlist_.create_net(net_name);
 
                 auto dir = port_list[port].getDir();
@@ -344,6 +314,77 @@ struct NetlistReader {
         }
     }
 
+    /** @brief Truth table decoded from the INIT parameter of a LUT instance */
+    struct LutInit {
+        AtomNetlist::TruthTable truth_table;
+        bool is_const = false; ///<Only the first row is set (a constant-one if it is the only row)
+    };
+
+    /** @brief Decodes the INIT parameter of a LUT instance. Thread safe: it only reads the netlist */
+    LutInit decode_lut_init(size_t inst_idx, int lut_width, const std::string& init_param) const {
+        auto inst_list = nr_.getInstList();
+        auto str_list = nr_.getStrList();
+
+        auto props = inst_list[inst_idx].getPropMap().getEntries();
+        std::vector<bool> init;
+        for (auto entry : props) {
+            if (str_list[entry.getKey()] != init_param)
+                continue;
+
+            // TODO: export this to a library function to have generic parameter decoding
+            if (entry.which() == LogicalNetlist::Netlist::PropertyMap::Entry::TEXT_VALUE) {
+                std::string init_str = str_list[entry.getTextValue()];
+                std::smatch regex_matches;
+
+                // Fill the init vector
+                if (std::regex_match(init_str, regex_matches, VHEX_REGEX))
+                    for (const char& c : regex_matches[1].str()) {
+                        int value = std::stoi(std::string(1, c), 0, 16);
+                        for (int bit = 3; bit >= 0; bit--)
+                            init.push_back((value >> bit) & 1);
+                    }
+                else if (std::regex_match(init_str, regex_matches, CHEX_REGEX))
+                    for (const char& c : regex_matches[1].str()) {
+                        int value = std::stoi(std::string(1, c), 0, 16);
+                        for (int bit = 3; bit >= 0; bit--)
+                            init.push_back((value >> bit) & 1);
+                    }
+                else if (std::regex_match(init_str, regex_matches, VBIT_REGEX))
+                    for (const char& c : regex_matches[1].str())
+                        init.push_back((bool)std::stoi(std::string(1, c), 0, 2));
+                else if (std::regex_match(init_str, regex_matches, CBIT_REGEX))
+                    for (const char& c : regex_matches[1].str())
+                        init.push_back((bool)std::stoi(std::string(1, c), 0, 2));
+                else if (std::regex_match(init_str, regex_matches, BIT_REGEX))
+                    for (const char& c : init_str)
+                        init.push_back((bool)std::stoi(std::string(1, c), 0, 2));
+            }
+        }
+
+        // Add proper LUT mapping function here based on LUT size and init value
+        LutInit lut_init;
+        AtomNetlist::TruthTable& truth_table = lut_init.truth_table;
+        for (int bit = 0; bit < (int)init.size(); bit++) {
+            bool bit_set = init[init.size() - bit - 1];
+
+            if (bit_set == 0)
+                continue;
+
+            lut_init.is_const = bit == 0;
+
+            truth_table.emplace_back();
+            for (int row_bit = lut_width - 1; row_bit >= 0; row_bit--) {
+                bool row_bit_set = (bit >> row_bit) & 1;
+                auto log_value = row_bit_set ? vtr::LogicValue::TRUE : vtr::LogicValue::FALSE;
+
+                truth_table[truth_table.size() - 1].push_back(log_value);
+            }
+            truth_table[truth_table.size() - 1].push_back(vtr::LogicValue::TRUE);
+        }
+
+        return lut_init;
+    }
+
     void read_blocks() {
         auto top_cell = nr_.getCellList()[nr_.getTopInst().getCell()];
         auto decl_list = nr_.getCellDecls();
@@ -353,12 +394,7 @@ struct NetlistReader {
 
         std::vector<std::pair<size_t, size_t>> insts;
         for (auto cell_inst : top_cell.getInsts()) {
-            auto cell = decl_list[inst_list[cell_inst].getCell()];
-
-            bool is_lut;
-            std::tie(is_lut, std::ignore, std::ignore) = is_lut_cell(str_list[cell.getName()]);
-
-            if (!is_lut)
+            if (!lut_cells_[inst_list[cell_inst].getCell()].is_lut)
                 insts.emplace_back(cell_inst, inst_list[cell_inst].getCell());
         }
 
@@ -383,7 +419,7 @@ struct NetlistReader {
                           inst_name.c_str(), models_.get_model(conflicting_model).name, blk_model.name);
             }
 
-            auto port_net_map = port_net_maps_.at(inst_idx);
+            const auto& port_net_map = port_net_maps_.at(inst_idx);
 
             auto cell = decl_list[inst_list[inst_idx].getCell()];
             if (str_list[cell.getName()] == arch_.vcc_cell.first)
@@ -493,8 +529,8 @@ struct NetlistReader {
         return port_bit;
     }
 
-    std::tuple<bool, int, std::string> is_lut_cell(std::string cell_name) {
-        for (auto lut_cell : arch_.lut_cells) {
+    std::tuple<bool, int, std::string> is_lut_cell(const std::string& cell_name) const {
+        for (const auto& lut_cell : arch_.lut_cells) {
             if (cell_name == lut_cell.name) {
                 auto init_param = lut_cell.init_param;
 
@@ -518,39 +554,15 @@ AtomNetlist read_interchange_netlist(const char* ic_netlist_file,
     AtomNetlist netlist;
     std::string netlist_id = vtr::secure_digest_file(ic_netlist_file);
 
-    // Decompress GZipped capnproto device file
-    gzFile file = gzopen(ic_netlist_file, "r");
-    VTR_ASSERT(file != Z_NULL);
-
-    std::vector<uint8_t> output_data;
-    output_data.resize(4096);
-    std::stringstream sstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
-    while (true) {
-        int ret = gzread(file, output_data.data(), output_data.size());
-        VTR_ASSERT(ret >= 0);
-        if (ret > 0) {
-            sstream.write((const char*)output_data.data(), ret);
-            VTR_ASSERT(sstream);
-        } else {
-            VTR_ASSERT(ret == 0);
-            int error;
-            gzerror(file, &error);
-            VTR_ASSERT(error == Z_OK);
-            break;
-        }
-    }
-
-    VTR_ASSERT(gzclose(file) == Z_OK);
-
-    sstream.seekg(0);
-    kj::std::StdInputStream istream(sstream);
+    // Decompress GZipped capnproto netlist file, to be read in place
+    std::vector<capnp::word> message = readGzippedMessageFile(ic_netlist_file);
 
     // Reader options
     capnp::ReaderOptions reader_options;
     reader_options.nestingLimit = std::numeric_limits<int>::max();
     reader_options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
 
-    capnp::InputStreamMessageReader message_reader(istream, reader_options);
+    capnp::FlatArrayMessageReader message_reader(kj::arrayPtr(message.data(), message.size()), reader_options);
 
     auto netlist_reader = message_reader.getRoot<LogicalNetlist::Netlist>();
 
@@ -6,10 +6,13 @@
  * @brief Read a circuit netlist in XML format and populate the netlist data structures for VPR
  */
 
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <filesystem>
 #include <map>
+#include <unordered_map>
 
 #include "physical_types.h"
 #include "physical_types_util.h"
@@ -21,20 +24,50 @@
 #include "vtr_util.h"
 #include "vtr_log.h"
 #include "vtr_digest.h"
+#include "vtr_flat_hash_map.h"
 #include "vtr_token.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
 #include "vpr_utils.h"
 
-#include "hash.h"
 #include "globals.h"
 #include "atom_netlist.h"
 #include "read_netlist.h"
 #include "pb_type_graph.h"
 
+#ifdef VTR_ENABLE_CAPNPROTO
+#include "capnp/serialize.h"
+#include "packed_netlist.capnp.h"
+#include "mmap_file.h"
+#include "serdes_utils.h"
+#endif // VTR_ENABLE_CAPNPROTO
+
 static const char* netlist_file_name = nullptr;
 
+static ClusteredNetlist read_xml_netlist(const char* net_file,
+                                         const t_arch* arch,
+                                         bool verify_file_digests);
+
+static bool read_binary_netlist(const char* net_file,
+                                const std::string& binary_file,
+                                const t_arch* arch,
+                                bool verify_file_digests,
+                                ClusteredNetlist& clb_nlist);
+
+static void write_binary_netlist(const char* net_file,
+                                 const std::string& binary_file,
+                                 const ClusteredNetlist& clb_nlist,
+                                 const t_arch* arch);
+
+static void verify_netlist_file_ids(const std::string& arch_id,
+                                    const std::string& atom_nl_id,
+                                    const t_arch* arch,
+                                    bool verify_file_digests,
+                                    int line);
+
+static void create_cluster_ports(const ClusterBlockId index, const t_pb_type* pb_type, ClusteredNetlist* clb_nlist);
+
 static void processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route, const pugiutil::loc_data& loc_data);
 
 static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* pb, t_pb_routes& pb_route, int* num_primitives, const pugiutil::loc_data& loc_data, ClusteredNetlist* clb_nlist);
@@ -45,7 +78,7 @@ static void processComplexBlock(pugi::xml_node Parent,
                                 const pugiutil::loc_data& loc_data,
                                 ClusteredNetlist* clb_nlist);
 
-static int add_net_to_hash(t_hash** nhash, const char* net_name, int* ncount);
+static int add_net_to_hash(vtr::flat_hash_map<std::string, int>& nhash, const char* net_name, int* ncount);
 
 static void load_external_nets_and_cb(ClusteredNetlist& clb_nlist);
 
@@ -61,16 +94,111 @@ static t_pb_routes alloc_pb_route(t_pb_graph_node* pb_graph_node);
 
 static void load_atom_pin_mapping(const ClusteredNetlist& clb_nlist);
 
+static void load_net_file_cluster_atom_names(pugi::xml_node parent, std::vector<std::string>& atom_names);
+
 /**
  * @brief Initializes the clb_nlist with info from a netlist
  *
  *   @param net_file   Name of the netlist file to read
+ *   @param binary_net_file   Whether to load the binary copy of the netlist file if it is up to date,
+ *                            and to write it otherwise
  */
 ClusteredNetlist read_netlist(const char* net_file,
                               const t_arch* arch,
                               bool verify_file_digests,
+                              bool binary_net_file,
                               int verbosity) {
     clock_t begin = clock();
+
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+
+    /* Save netlist file's name in file-scoped variable */
+    netlist_file_name = net_file;
+
+    VTR_LOG("Begin loading packed FPGA netlist file.\n");
+
+    const std::string binary_file = get_binary_net_file_name(net_file);
+
+    ClusteredNetlist clb_nlist;
+    bool loaded_binary = false;
+    if (binary_net_file) {
+        loaded_binary = read_binary_netlist(net_file, binary_file, arch, verify_file_digests, clb_nlist);
+    }
+
+    if (!loaded_binary) {
+        /* Parse the file */
+        clb_nlist = read_xml_netlist(net_file, arch, verify_file_digests);
+    }
+
+    /* Error check */
+    for (auto blk_id : atom_ctx.netlist().blocks()) {
+        if (atom_ctx.lookup().atom_pb_bimap().atom_pb(blk_id) == nullptr) {
+            VPR_FATAL_ERROR(VPR_ERROR_NET_F,
+                            ".blif file and .net file do not match, .net file missing atom %s.\n",
+                            atom_ctx.netlist().block_name(blk_id).c_str());
+        }
+    }
+    /* TODO: Add additional check to make sure net connections match */
+    mark_constant_generators(clb_nlist, verbosity);
+
+    load_external_nets_and_cb(clb_nlist);
+
+    /* TODO: create this function later
+     * check_top_IO_matches_IO_blocks(circuit_inputs, circuit_outputs, circuit_clocks, blist, bcount); */
+
+    /* load mapping between external nets and all nets */
+    for (auto net_id : atom_ctx.netlist().nets()) {
+        atom_ctx.mutable_lookup().remove_atom_net(net_id);
+    }
+
+    //Save the mapping between clb and atom nets
+    for (auto clb_net_id : clb_nlist.nets()) {
+        AtomNetId net_id = atom_ctx.netlist().find_net(clb_nlist.net_name(clb_net_id));
+        VTR_ASSERT(net_id);
+        atom_ctx.mutable_lookup().add_atom_clb_net(net_id, clb_net_id);
+    }
+
+    // Mark ignored and global atom nets
+    /* We have to make set the following variables after the mapping between cluster nets and atom nets
+     * is created
+     */
+    const AtomNetlist atom_nlist = g_vpr_ctx.atom().netlist();
+    for (auto clb_net : clb_nlist.nets()) {
+        AtomNetId atom_net = atom_ctx.lookup().atom_net(clb_net);
+        VTR_ASSERT(atom_net != AtomNetId::INVALID());
+        if (clb_nlist.net_is_global(clb_net)) {
+            atom_ctx.mutable_netlist().set_net_is_global(atom_net, true);
+        }
+        if (clb_nlist.net_is_ignored(clb_net)) {
+            atom_ctx.mutable_netlist().set_net_is_ignored(atom_net, true);
+        }
+    }
+
+    /* load mapping between atom pins and pb_graph_pins */
+    load_atom_pin_mapping(clb_nlist);
+
+    //Keep the binary copy of the netlist up to date, so that later runs can load it instead
+    if (binary_net_file && !loaded_binary) {
+        write_binary_netlist(net_file, binary_file, clb_nlist, arch);
+    }
+
+    clock_t end = clock();
+
+    VTR_LOG("Finished loading packed FPGA netlist file (took %g seconds).\n", (float)(end - begin) / CLOCKS_PER_SEC);
+
+    return clb_nlist;
+}
+
+std::string get_binary_net_file_name(const std::string& net_file) {
+    return net_file + ".bin";
+}
+
+/**
+ * @brief Loads the clusters of an XML packed netlist file into a new clustered netlist
+ */
+static ClusteredNetlist read_xml_netlist(const char* net_file,
+                                         const t_arch* arch,
+                                         bool verify_file_digests) {
     size_t bcount = 0;
     std::vector<std::string> circuit_inputs, circuit_outputs, circuit_clocks;
 
@@ -78,9 +206,6 @@ ClusteredNetlist read_netlist(const char* net_file,
 
     int num_primitives = 0;
 
-    /* Parse the file */
-    VTR_LOG("Begin loading packed FPGA netlist file.\n");
-
     //Save an identifier for the netlist based on it's contents
     auto clb_nlist = ClusteredNetlist(net_file, vtr::secure_digest_file(net_file));
 
@@ -94,9 +219,6 @@ ClusteredNetlist read_netlist(const char* net_file,
     }
 
     try {
-        /* Save netlist file's name in file-scoped variable */
-        netlist_file_name = net_file;
-
         /* Root node should be block */
         auto top = doc.child("block");
         if (!top) {
@@ -122,47 +244,11 @@ ClusteredNetlist read_netlist(const char* net_file,
                       top_instance.value());
         }
 
-        auto architecture_id = top.attribute("architecture_id");
-        if (architecture_id) {
-            //Netlist file has an architecture id, make sure it is
-            //consistent with the loaded architecture file.
-            //
-            //Note that we currently don't require that the architecture_id exists,
-            //to remain compatible with old .net files
-            std::string arch_id = architecture_id.value();
-            if (arch_id != arch->architecture_id) {
-                auto msg = vtr::string_fmt(
-                    "Netlist was generated from a different architecture file"
-                    " (loaded architecture ID: %s, netlist file architecture ID: %s)",
-                    arch->architecture_id, arch_id.c_str());
-                if (verify_file_digests) {
-                    vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top), msg.c_str());
-                } else {
-                    VTR_LOGF_WARN(netlist_file_name, loc_data.line(top), "%s\n", msg.c_str());
-                }
-            }
-        }
-
-        auto atom_netlist_id = top.attribute("atom_netlist_id");
-        if (atom_netlist_id) {
-            //Netlist file has an_atom netlist_id, make sure it is
-            //consistent with the loaded atom netlist.
-            //
-            //Note that we currently don't require that the atom_netlist_id exists,
-            //to remain compatible with old .net files
-            std::string atom_nl_id = atom_netlist_id.value();
-            if (atom_nl_id != atom_ctx.netlist().netlist_id()) {
-                auto msg = vtr::string_fmt(
-                    "Netlist was generated from a different atom netlist file"
-                    " (loaded atom netlist ID: %s, packed netlist atom netlist ID: %s)",
-                    atom_nl_id.c_str(), atom_ctx.netlist().netlist_id().c_str());
-                if (verify_file_digests) {
-                    vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top), msg.c_str());
-                } else {
-                    VTR_LOGF_WARN(netlist_file_name, loc_data.line(top), "%s\n", msg.c_str());
-                }
-            }
-        }
+        //Note that we currently don't require that the architecture_id and atom_netlist_id
+        //exist, to remain compatible with old .net files
+        verify_netlist_file_ids(top.attribute("architecture_id").value(),
+                                top.attribute("atom_netlist_id").value(),
+                                arch, verify_file_digests, loc_data.line(top));
 
         //Collect top level I/Os
         auto top_inputs = pugiutil::get_single_child(top, "inputs", loc_data);
@@ -195,63 +281,105 @@ ClusteredNetlist read_netlist(const char* net_file,
         VTR_ASSERT(clb_nlist.blocks().size() == i);
         VTR_ASSERT(num_primitives >= 0);
         VTR_ASSERT(static_cast<size_t>(num_primitives) == atom_ctx.netlist().blocks().size());
-
-        /* Error check */
-        for (auto blk_id : atom_ctx.netlist().blocks()) {
-            if (atom_ctx.lookup().atom_pb_bimap().atom_pb(blk_id) == nullptr) {
-                VPR_FATAL_ERROR(VPR_ERROR_NET_F,
-                                ".blif file and .net file do not match, .net file missing atom %s.\n",
-                                atom_ctx.netlist().block_name(blk_id).c_str());
-            }
-        }
-        /* TODO: Add additional check to make sure net connections match */
-        mark_constant_generators(clb_nlist, verbosity);
-
-        load_external_nets_and_cb(clb_nlist);
     } catch (pugiutil::XmlError& e) {
         vpr_throw(VPR_ERROR_NET_F, e.filename_c_str(), e.line(),
                   "Error loading post-pack netlist (%s)", e.what());
     }
 
-    /* TODO: create this function later
-     * check_top_IO_matches_IO_blocks(circuit_inputs, circuit_outputs, circuit_clocks, blist, bcount); */
+    return clb_nlist;
+}
 
-    /* load mapping between external nets and all nets */
-    for (auto net_id : atom_ctx.netlist().nets()) {
-        atom_ctx.mutable_lookup().remove_atom_net(net_id);
-    }
+/**
+ * @brief Checks that the architecture and atom netlist a packed netlist file was generated
+ *        from are the loaded ones (unless their ids are empty, i.e. not recorded in the file)
+ */
+static void verify_netlist_file_ids(const std::string& arch_id,
+                                    const std::string& atom_nl_id,
+                                    const t_arch* arch,
+                                    bool verify_file_digests,
+                                    int line) {
+    auto& atom_ctx = g_vpr_ctx.atom();
 
-    //Save the mapping between clb and atom nets
-    for (auto clb_net_id : clb_nlist.nets()) {
-        AtomNetId net_id = atom_ctx.netlist().find_net(clb_nlist.net_name(clb_net_id));
-        VTR_ASSERT(net_id);
-        atom_ctx.mutable_lookup().add_atom_clb_net(net_id, clb_net_id);
+    if (!arch_id.empty() && arch_id != arch->architecture_id) {
+        auto msg = vtr::string_fmt(
+            "Netlist was generated from a different architecture file"
+            " (loaded architecture ID: %s, netlist file architecture ID: %s)",
+            arch->architecture_id, arch_id.c_str());
+        if (verify_file_digests) {
+            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, line, msg.c_str());
+        } else {
+            VTR_LOGF_WARN(netlist_file_name, line, "%s\n", msg.c_str());
+        }
     }
 
-    // Mark ignored and global atom nets
-    /* We have to make set the following variables after the mapping between cluster nets and atom nets
-     * is created
-     */
-    const AtomNetlist atom_nlist = g_vpr_ctx.atom().netlist();
-    for (auto clb_net : clb_nlist.nets()) {
-        AtomNetId atom_net = atom_ctx.lookup().atom_net(clb_net);
-        VTR_ASSERT(atom_net != AtomNetId::INVALID());
-        if (clb_nlist.net_is_global(clb_net)) {
-            atom_ctx.mutable_netlist().set_net_is_global(atom_net, true);
-        }
-        if (clb_nlist.net_is_ignored(clb_net)) {
-            atom_ctx.mutable_netlist().set_net_is_ignored(atom_net, true);
+    if (!atom_nl_id.empty() && atom_nl_id != atom_ctx.netlist().netlist_id()) {
+        auto msg = vtr::string_fmt(
+            "Netlist was generated from a different atom netlist file"
+            " (loaded atom netlist ID: %s, packed netlist atom netlist ID: %s)",
+            atom_nl_id.c_str(), atom_ctx.netlist().netlist_id().c_str());
+        if (verify_file_digests) {
+            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, line, msg.c_str());
+        } else {
+            VTR_LOGF_WARN(netlist_file_name, line, "%s\n", msg.c_str());
         }
     }
+}
+
+std::vector<t_net_file_cluster> read_netlist_clusters(const char* net_file) {
+    pugi::xml_document doc;
+    pugiutil::loc_data loc_data;
+    try {
+        loc_data = pugiutil::load_xml(doc, net_file);
+    } catch (pugiutil::XmlError& e) {
+        vpr_throw(VPR_ERROR_NET_F, net_file, 0,
+                  "Failed to load netlist file '%s' (%s).\n", net_file, e.what());
+    }
 
-    /* load mapping between atom pins and pb_graph_pins */
-    load_atom_pin_mapping(clb_nlist);
+    std::vector<t_net_file_cluster> clusters;
+    try {
+        auto top = doc.child("block");
+        if (!top) {
+            vpr_throw(VPR_ERROR_NET_F, net_file, loc_data.line(top),
+                      "Root element must be 'block'.\n");
+        }
 
-    clock_t end = clock();
+        for (auto clb_block = top.child("block"); clb_block; clb_block = clb_block.next_sibling("block")) {
+            t_net_file_cluster cluster;
+            cluster.name = pugiutil::get_attribute(clb_block, "name", loc_data).value();
+            cluster.mode_name = pugiutil::get_attribute(clb_block, "mode", loc_data).value();
 
-    VTR_LOG("Finished loading packed FPGA netlist file (took %g seconds).\n", (float)(end - begin) / CLOCKS_PER_SEC);
+            auto block_inst = pugiutil::get_attribute(clb_block, "instance", loc_data);
+            const Tokens tokens(block_inst.value());
+            if (tokens.size() != 4 || tokens[0].type != e_token_type::STRING) {
+                vpr_throw(VPR_ERROR_NET_F, net_file, loc_data.line(clb_block),
+                          "Unknown syntax for instance %s in %s. Expected pb_type[instance_number].\n",
+                          block_inst.value(), clb_block.name());
+            }
+            cluster.type_name = tokens[0].data;
 
-    return clb_nlist;
+            load_net_file_cluster_atom_names(clb_block, cluster.atom_names);
+            clusters.push_back(std::move(cluster));
+        }
+    } catch (pugiutil::XmlError& e) {
+        vpr_throw(VPR_ERROR_NET_F, e.filename_c_str(), e.line(),
+                  "Error loading post-pack netlist (%s)", e.what());
+    }
+
+    return clusters;
+}
+
+/**
+ * @brief Appends the names of the primitive blocks under the given block: the
+ *        blocks with no child blocks which are not open.
+ */
+static void load_net_file_cluster_atom_names(pugi::xml_node parent, std::vector<std::string>& atom_names) {
+    for (auto child = parent.child("block"); child; child = child.next_sibling("block")) {
+        if (child.child("block")) {
+            load_net_file_cluster_atom_names(child, atom_names);
+        } else if (strcmp(child.attribute("name").value(), "open") != 0) {
+            atom_names.push_back(child.attribute("name").value());
+        }
+    }
 }
 
 /**
@@ -393,34 +521,6 @@ static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* p
     auto clocks = pugiutil::get_single_child(Parent, "clocks", loc_data);
     processPorts(clocks, pb, pb_route, loc_data);
 
-    int num_in_ports = 0;
-    int begin_out_port;
-    int end_out_port;
-    int begin_clock_port;
-    int end_clock_port;
-
-    {
-        int num_out_ports = 0;
-        int num_clock_ports = 0;
-        for (i = 0; i < pb->pb_graph_node->pb_type->num_ports; i++) {
-            if (pb->pb_graph_node->pb_type->ports[i].is_clock
-                && pb->pb_graph_node->pb_type->ports[i].type == IN_PORT) {
-                num_clock_ports++;
-            } else if (!pb->pb_graph_node->pb_type->ports[i].is_clock
-                       && pb->pb_graph_node->pb_type->ports[i].type == IN_PORT) {
-                num_in_ports++;
-            } else {
-                VTR_ASSERT(pb->pb_graph_node->pb_type->ports[i].type == OUT_PORT);
-                num_out_ports++;
-            }
-        }
-
-        begin_out_port = num_in_ports;
-        end_out_port = begin_out_port + num_out_ports;
-        begin_clock_port = end_out_port;
-        end_clock_port = begin_clock_port + num_clock_ports;
-    }
-
     auto attrs = pugiutil::get_single_child(Parent, "attributes", loc_data, pugiutil::OPTIONAL);
     auto params = pugiutil::get_single_child(Parent, "parameters", loc_data, pugiutil::OPTIONAL);
 
@@ -428,17 +528,7 @@ static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* p
 
     //Create the ports in the clb_nlist for the top-level pb
     if (pb->is_root()) {
-        for (i = 0; i < num_in_ports; i++) {
-            clb_nlist->create_port(index, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::INPUT);
-        }
-        for (i = begin_out_port; i < end_out_port; i++) {
-            clb_nlist->create_port(index, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::OUTPUT);
-        }
-        for (i = begin_clock_port; i < end_clock_port; i++) {
-            clb_nlist->create_port(index, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::CLOCK);
-        }
-
-        VTR_ASSERT(clb_nlist->block_ports(index).size() == (unsigned)pb_type->num_ports);
+        create_cluster_ports(index, pb_type, clb_nlist);
     }
 
     if (pb_type->is_primitive()) {
@@ -570,25 +660,58 @@ static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* p
     }
 }
 
+/**
+ * @brief Creates the ports of a cluster in the clb_nlist, from the ports of its top-level pb_type
+ */
+static void create_cluster_ports(const ClusterBlockId index, const t_pb_type* pb_type, ClusteredNetlist* clb_nlist) {
+    int num_in_ports = 0;
+    int num_out_ports = 0;
+    int num_clock_ports = 0;
+    for (int i = 0; i < pb_type->num_ports; i++) {
+        if (pb_type->ports[i].is_clock && pb_type->ports[i].type == IN_PORT) {
+            num_clock_ports++;
+        } else if (!pb_type->ports[i].is_clock && pb_type->ports[i].type == IN_PORT) {
+            num_in_ports++;
+        } else {
+            VTR_ASSERT(pb_type->ports[i].type == OUT_PORT);
+            num_out_ports++;
+        }
+    }
+
+    int begin_out_port = num_in_ports;
+    int end_out_port = begin_out_port + num_out_ports;
+    int begin_clock_port = end_out_port;
+    int end_clock_port = begin_clock_port + num_clock_ports;
+
+    for (int i = 0; i < num_in_ports; i++) {
+        clb_nlist->create_port(index, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::INPUT);
+    }
+    for (int i = begin_out_port; i < end_out_port; i++) {
+        clb_nlist->create_port(index, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::OUTPUT);
+    }
+    for (int i = begin_clock_port; i < end_clock_port; i++) {
+        clb_nlist->create_port(index, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::CLOCK);
+    }
+
+    VTR_ASSERT(clb_nlist->block_ports(index).size() == (unsigned)pb_type->num_ports);
+}
+
 /**
  * @brief Adds net to hashtable of nets.
  *
  * If the net is "open", then this is a keyword so do not add it.
  * If the net already exists, increase the count on that net
  */
-static int add_net_to_hash(t_hash** nhash, const char* net_name, int* ncount) {
-    t_hash* hash_value;
-
+static int add_net_to_hash(vtr::flat_hash_map<std::string, int>& nhash, const char* net_name, int* ncount) {
     if (strcmp(net_name, "open") == 0) {
         return UNDEFINED;
     }
 
-    hash_value = insert_in_hash_table(nhash, net_name, *ncount);
-    if (hash_value->count == 1) {
-        VTR_ASSERT(*ncount == hash_value->index);
+    auto [iter, inserted] = nhash.try_emplace(net_name, *ncount);
+    if (inserted) {
         (*ncount)++;
     }
-    return hash_value->index;
+    return iter->second;
 }
 
 static void processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route, const pugiutil::loc_data& loc_data) {
@@ -877,14 +1000,12 @@ static void processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route,
 static void load_external_nets_and_cb(ClusteredNetlist& clb_nlist) {
     int j, k, ipin;
     int ext_ncount = 0;
-    t_hash** ext_nhash;
+    vtr::flat_hash_map<std::string, int> ext_nhash;
     t_pb_graph_pin* pb_graph_pin;
     ClusterNetId clb_net_id;
 
     auto& atom_ctx = g_vpr_ctx.atom();
 
-    ext_nhash = alloc_hash_table();
-
     t_logical_block_type_ptr block_type;
 
     /* Assumes that complex block pins are ordered inputs, outputs, globals */
@@ -1039,8 +1160,6 @@ static void load_external_nets_and_cb(ClusteredNetlist& clb_nlist) {
             }
         }
     }
-
-    free_hash_table(ext_nhash);
 }
 
 static void mark_constant_generators(const ClusteredNetlist& clb_nlist, int verbosity) {
@@ -1242,3 +1361,493 @@ void set_atom_pin_mapping(const ClusteredNetlist& clb_nlist, const AtomBlockId a
     //Save the mapping
     atom_ctx.mutable_lookup().set_atom_pin_pb_graph_pin(atom_pin, gpin);
 }
+
+/*
+ * Binary copy of the packed netlist
+ *
+ * The binary copy records the state read_xml_netlist() loads: the pb trees of the clusters, with
+ * their pin rotations, and the intra-cluster routing (pb_route) of the clusters. Loading it only
+ * needs a pass over the mapped file, rather than building and walking the XML DOM of the .net file
+ * (and looking up every pin and interconnect by name).
+ *
+ * The binary copy is tied to the .net file it was made from by the size and modification time of
+ * the .net file, and is only loaded while they are unchanged.
+ */
+#ifndef VTR_ENABLE_CAPNPROTO
+
+static bool read_binary_netlist(const char* /*net_file*/,
+                                const std::string& /*binary_file*/,
+                                const t_arch* /*arch*/,
+                                bool /*verify_file_digests*/,
+                                ClusteredNetlist& /*clb_nlist*/) {
+    VTR_LOG_WARN("Binary packed netlist ignored: it requires VPR to be built with VTR_ENABLE_CAPNPROTO\n");
+    return false;
+}
+
+static void write_binary_netlist(const char* /*net_file*/,
+                                 const std::string& /*binary_file*/,
+                                 const ClusteredNetlist& /*clb_nlist*/,
+                                 const t_arch* /*arch*/) {
+}
+
+#else // VTR_ENABLE_CAPNPROTO
+
+/**
+ * @brief Gets the size and modification time (in nanoseconds) of a file.
+ *
+ *   @return False if the file does not exist.
+ */
+static bool get_file_stamp(const std::string& file, uint64_t& size, int64_t& mod_time) {
+    std::error_code ec;
+    size = std::filesystem::file_size(file, ec);
+    if (ec) return false;
+
+    auto time = std::filesystem::last_write_time(file, ec);
+    if (ec) return false;
+
+    mod_time = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    return true;
+}
+
+/**
+ * @brief Checks that the attributes or parameters of a primitive recorded in the binary packed
+ *        netlist are the ones of its atom
+ */
+template<typename T>
+static void verify_binary_attrs_params(::capnp::List<VprPackedNetlistKeyValue>::Reader kvs,
+                                       const char* kind,
+                                       const T& atom_net_range) {
+    size_t num_atom_kvs = 0;
+    for (const auto& bitem : atom_net_range) {
+        bool found = false;
+        for (auto kv : kvs) {
+            if (bitem.first == kv.getName().cStr()) {
+                if (bitem.second != kv.getValue().cStr()) {
+                    vpr_throw(VPR_ERROR_NET_F, netlist_file_name, 0,
+                              ".net file and .blif file do not match, %s %s set to \"%s\" in .net file but \"%s\" in .blif file.\n",
+                              kind, bitem.first.c_str(), kv.getValue().cStr(), bitem.second.c_str());
+                }
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, 0,
+                      ".net file and .blif file do not match, %s %s missing in .net file.\n",
+                      kind, bitem.first.c_str());
+        }
+        num_atom_kvs++;
+    }
+
+    if (kvs.size() != num_atom_kvs) {
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, 0,
+                  ".net file and .blif file do not match, %s missing in .blif file.\n",
+                  kind);
+    }
+}
+
+/**
+ * @brief Returns the pb_graph_pin of the given cluster pin (i.e. pin_count_in_cluster)
+ */
+static const t_pb_graph_pin* get_binary_pb_gpin(t_logical_block_type_ptr type, const IntraLbPbPinLookup& pb_gpin_lookup, int pin) {
+    if (pin < 0 || pin >= type->pb_graph_head->total_pb_pins) {
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, 0,
+                  "Invalid pin %d in cluster of type %s.\n", pin, type->name.c_str());
+    }
+    return pb_gpin_lookup.pb_gpin(type->index, pin);
+}
+
+/**
+ * @brief Loads a pb (and its children) from the binary packed netlist, in the same way processPb() does from the .net file
+ */
+static void load_binary_pb(VprPackedNetlistPb::Reader pb_reader,
+                           const ClusterBlockId index,
+                           t_pb* pb,
+                           const IntraLbPbPinLookup& pb_gpin_lookup,
+                           int* num_primitives,
+                           ClusteredNetlist* clb_nlist) {
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+
+    const t_pb_type* pb_type = pb->pb_graph_node->pb_type;
+    t_logical_block_type_ptr type = clb_nlist->block_type(index);
+
+    //Create the ports in the clb_nlist for the top-level pb
+    if (pb->is_root()) {
+        create_cluster_ports(index, pb_type, clb_nlist);
+    }
+
+    if (pb_type->is_primitive()) {
+        /* A primitive type */
+        AtomBlockId blk_id = atom_ctx.netlist().find_block(pb->name);
+        if (!blk_id) {
+            VPR_FATAL_ERROR(VPR_ERROR_NET_F,
+                            ".net file and .blif file do not match, encountered unknown primitive %s in .net file.\n",
+                            pb->name);
+        }
+
+        //Update atom netlist mapping
+        atom_ctx.mutable_lookup().mutable_atom_pb_bimap().set_atom_pb(blk_id, pb);
+        atom_ctx.mutable_lookup().set_atom_clb(blk_id, index);
+
+        verify_binary_attrs_params(pb_reader.getAttributes(), "attribute", atom_ctx.netlist().block_attrs(blk_id));
+        verify_binary_attrs_params(pb_reader.getParameters(), "parameter", atom_ctx.netlist().block_params(blk_id));
+
+        for (auto rotation : pb_reader.getPinRotations()) {
+            pb->set_atom_pin_bit_index(get_binary_pb_gpin(type, pb_gpin_lookup, rotation.getPin()), rotation.getAtomPinBitIndex());
+        }
+
+        (*num_primitives)++;
+        return;
+    }
+
+    const t_mode& mode = pb_type->modes[pb->mode];
+
+    pb->child_pbs = new t_pb*[mode.num_pb_type_children];
+    for (int i = 0; i < mode.num_pb_type_children; i++) {
+        pb->child_pbs[i] = new t_pb[mode.pb_type_children[i].num_pb];
+    }
+
+    for (auto child : pb_reader.getChildren()) {
+        int i = child.getChildType();
+        int pb_index = child.getInstance();
+        if (i < 0 || i >= mode.num_pb_type_children || pb_index < 0 || pb_index >= mode.pb_type_children[i].num_pb) {
+            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, 0,
+                      "Unknown pb type %d[%d] in pb %s.\n", i, pb_index, pb->hierarchical_type_name().c_str());
+        }
+
+        t_pb* child_pb = &pb->child_pbs[i][pb_index];
+        if (child_pb->pb_graph_node != nullptr) {
+            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, 0,
+                      "node is used by two different blocks %s[%d] and %s.\n",
+                      mode.pb_type_children[i].name, pb_index, child_pb->name);
+        }
+        child_pb->pb_graph_node = &pb->pb_graph_node->child_pb_graph_nodes[pb->mode][i][pb_index];
+        child_pb->name = child.hasName() ? vtr::strdup(child.getName().cStr()) : nullptr;
+        atom_ctx.mutable_lookup().mutable_atom_pb_bimap().set_atom_pb(AtomBlockId::INVALID(), child_pb);
+
+        if (child.getExpanded()) {
+            const t_pb_type* child_pb_type = child_pb->pb_graph_node->pb_type;
+            child_pb->mode = child.getMode();
+            if (!child_pb_type->is_primitive() && (child_pb->mode < 0 || child_pb->mode >= child_pb_type->num_modes)) {
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, 0,
+                          "Unknown mode %d for cb %s #%d.\n", child_pb->mode, child_pb->name, pb_index);
+            }
+            child_pb->parent_pb = pb;
+
+            load_binary_pb(child, index, child_pb, pb_gpin_lookup, num_primitives, clb_nlist);
+        }
+    }
+}
+
+/**
+ * @brief Loads a cluster from the binary packed netlist, in the same way processComplexBlock() does from the .net file
+ */
+static void load_binary_cluster(VprPackedNetlistCluster::Reader cluster,
+                                const ClusterBlockId index,
+                                const std::vector<AtomNetId>& nets,
+                                const IntraLbPbPinLookup& pb_gpin_lookup,
+                                int* num_primitives,
+                                ClusteredNetlist* clb_nlist) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+
+    const char* block_name = cluster.getName().cStr();
+
+    t_logical_block_type_ptr type = nullptr;
+    for (const t_logical_block_type& logical_block_type : device_ctx.logical_block_types) {
+        if (logical_block_type.name == cluster.getType().cStr()) {
+            type = &logical_block_type;
+            break;
+        }
+    }
+    if (type == nullptr) {
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, 0,
+                  "Unknown cb type %s for cb %s #%lu.\n", cluster.getType().cStr(), block_name, size_t(index));
+    }
+
+    t_pb* pb = new t_pb;
+    pb->name = vtr::strdup(block_name);
+    clb_nlist->create_block(block_name, pb, type);
+
+    atom_ctx.mutable_lookup().mutable_atom_pb_bimap().set_atom_pb(AtomBlockId::INVALID(), pb);
+
+    pb->pb_graph_node = type->pb_graph_head;
+    pb->pb_route = alloc_pb_route(pb->pb_graph_node);
+
+    auto root = cluster.getRoot();
+    pb->mode = root.getMode();
+    if (pb->mode < 0 || pb->mode >= type->pb_type->num_modes) {
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, 0,
+                  "Unknown mode %d for cb %s #%lu.\n", pb->mode, block_name, size_t(index));
+    }
+
+    load_binary_pb(root, index, pb, pb_gpin_lookup, num_primitives, clb_nlist);
+
+    //The routes were recorded in pin order, so each one is appended to the pb_route
+    t_pb_routes& pb_route = pb->pb_route;
+    for (auto route : cluster.getRoutes()) {
+        int pin = route.getPin();
+        const t_pb_graph_pin* pb_gpin = get_binary_pb_gpin(type, pb_gpin_lookup, pin);
+
+        pb_route.insert(std::make_pair(pin, t_pb_route()));
+        pb_route[pin].pb_graph_pin = pb_gpin;
+
+        if (route.getNet() >= 0) {
+            if (size_t(route.getNet()) >= nets.size()) {
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, 0,
+                          "Invalid net %d on pin %d of cb %s.\n", route.getNet(), pin, block_name);
+            }
+            pb_route[pin].atom_net_id = nets[route.getNet()];
+        }
+
+        if (route.getDriverPin() >= 0) {
+            get_binary_pb_gpin(type, pb_gpin_lookup, route.getDriverPin()); //Check the driver pin exists
+            pb_route[pin].driver_pb_pin_id = route.getDriverPin();
+        }
+    }
+
+    load_internal_to_block_net_nums(type, pb_route);
+}
+
+static bool read_binary_netlist(const char* net_file,
+                                const std::string& binary_file,
+                                const t_arch* arch,
+                                bool verify_file_digests,
+                                ClusteredNetlist& clb_nlist) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+
+    uint64_t net_file_size = 0;
+    int64_t net_file_mod_time = 0;
+    std::error_code ec;
+    if (!std::filesystem::exists(binary_file, ec) || !get_file_stamp(net_file, net_file_size, net_file_mod_time)) {
+        return false;
+    }
+
+    try {
+        // MmapFile object creates an mmap of the specified path, and will munmap
+        // when the object leaves scope.
+        MmapFile f(binary_file);
+        ::capnp::FlatArrayMessageReader reader(f.getData(), default_large_capnp_opts());
+        auto netlist = reader.getRoot<VprPackedNetlist>();
+
+        if (netlist.getNetFileSize() != net_file_size || netlist.getNetFileModTime() != net_file_mod_time) {
+            VTR_LOG("Binary packed netlist '%s' is out of date, loading the packed netlist file.\n", binary_file.c_str());
+            return false;
+        }
+
+        VTR_LOG("Loading binary packed netlist '%s'.\n", binary_file.c_str());
+
+        //The netlist id is the digest of the .net file, as if it had been loaded
+        clb_nlist = ClusteredNetlist(net_file, netlist.getNetlistId().cStr());
+
+        verify_netlist_file_ids(netlist.getArchitectureId().cStr(),
+                                netlist.getAtomNetlistId().cStr(),
+                                arch, verify_file_digests, 0);
+
+        //Look up each atom net once
+        std::vector<AtomNetId> nets;
+        nets.reserve(netlist.getNets().size());
+        for (auto net_name : netlist.getNets()) {
+            AtomNetId net_id = atom_ctx.netlist().find_net(net_name.cStr());
+            if (!net_id) {
+                VPR_FATAL_ERROR(VPR_ERROR_NET_F,
+                                ".blif and .net do not match, unknown net %s found in .net file.\n",
+                                net_name.cStr());
+            }
+            nets.push_back(net_id);
+        }
+
+        //Reset atom/pb mapping (it is reloaded from the packed netlist file)
+        for (auto blk_id : atom_ctx.netlist().blocks())
+            atom_ctx.mutable_lookup().mutable_atom_pb_bimap().set_atom_pb(blk_id, nullptr);
+
+        if (netlist.getClusters().size() == 0)
+            VTR_LOG_WARN("Packed netlist contains no clustered blocks\n");
+
+        const IntraLbPbPinLookup pb_gpin_lookup(device_ctx.logical_block_types);
+
+        int num_primitives = 0;
+        unsigned i = 0;
+        for (auto cluster : netlist.getClusters()) {
+            load_binary_cluster(cluster, ClusterBlockId(i), nets, pb_gpin_lookup, &num_primitives, &clb_nlist);
+            i++;
+        }
+        VTR_ASSERT(clb_nlist.blocks().size() == i);
+        VTR_ASSERT(static_cast<size_t>(num_primitives) == atom_ctx.netlist().blocks().size());
+    } catch (kj::Exception& e) {
+        vpr_throw(VPR_ERROR_NET_F, binary_file.c_str(), 0,
+                  "Failed to load binary packed netlist '%s' (%s).\n", binary_file.c_str(), e.getDescription().cStr());
+    }
+
+    return true;
+}
+
+/**
+ * @brief Records a pb (and its children) in the binary packed netlist
+ */
+static void write_binary_pb(VprPackedNetlistPb::Builder pb_builder, const t_pb* pb) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    const t_pb_graph_node* gnode = pb->pb_graph_node;
+    const t_pb_type* pb_type = gnode->pb_type;
+
+    pb_builder.setExpanded(true);
+    pb_builder.setMode(pb->mode);
+
+    if (pb_type->is_primitive()) {
+        AtomBlockId blk_id = atom_ctx.netlist().find_block(pb->name);
+        VTR_ASSERT(blk_id);
+
+        //Only the pins which are not mapped to the atom pin of the same index need to be recorded
+        std::vector<std::pair<int, int>> pin_rotations;
+        auto add_pin_rotations = [&](t_pb_graph_pin** pins, int num_ports, const int* num_pins) {
+            for (int iport = 0; iport < num_ports; ++iport) {
+                for (int ipin = 0; ipin < num_pins[iport]; ++ipin) {
+                    const t_pb_graph_pin* gpin = &pins[iport][ipin];
+                    int atom_pin_bit_index = pb->atom_pin_bit_index(gpin);
+                    if (atom_pin_bit_index != gpin->pin_number) {
+                        pin_rotations.emplace_back(gpin->pin_count_in_cluster, atom_pin_bit_index);
+                    }
+                }
+            }
+        };
+        add_pin_rotations(gnode->input_pins, gnode->num_input_ports, gnode->num_input_pins);
+        add_pin_rotations(gnode->output_pins, gnode->num_output_ports, gnode->num_output_pins);
+        add_pin_rotations(gnode->clock_pins, gnode->num_clock_ports, gnode->num_clock_pins);
+
+        auto rotations = pb_builder.initPinRotations(pin_rotations.size());
+        for (size_t i = 0; i < pin_rotations.size(); i++) {
+            rotations[i].setPin(pin_rotations[i].first);
+            rotations[i].setAtomPinBitIndex(pin_rotations[i].second);
+        }
+
+        auto write_kvs = [](::capnp::List<VprPackedNetlistKeyValue>::Builder kvs, const auto& atom_net_range) {
+            size_t i = 0;
+            for (const auto& bitem : atom_net_range) {
+                kvs[i].setName(bitem.first.c_str());
+                kvs[i].setValue(bitem.second.c_str());
+                i++;
+            }
+        };
+        auto attrs = atom_ctx.netlist().block_attrs(blk_id);
+        write_kvs(pb_builder.initAttributes(attrs.size()), attrs);
+        auto params = atom_ctx.netlist().block_params(blk_id);
+        write_kvs(pb_builder.initParameters(params.size()), params);
+        return;
+    }
+
+    const t_mode& mode = pb_type->modes[pb->mode];
+
+    //Record the children which were loaded (open children included, as they may have routing)
+    size_t num_children = 0;
+    for (int i = 0; i < mode.num_pb_type_children; i++) {
+        for (int j = 0; j < mode.pb_type_children[i].num_pb; j++) {
+            if (pb->child_pbs[i][j].pb_graph_node != nullptr) {
+                num_children++;
+            }
+        }
+    }
+
+    auto children = pb_builder.initChildren(num_children);
+    size_t ichild = 0;
+    for (int i = 0; i < mode.num_pb_type_children; i++) {
+        for (int j = 0; j < mode.pb_type_children[i].num_pb; j++) {
+            const t_pb* child_pb = &pb->child_pbs[i][j];
+            if (child_pb->pb_graph_node == nullptr) continue;
+
+            auto child = children[ichild++];
+            child.setChildType(i);
+            child.setInstance(j);
+            if (child_pb->name != nullptr) {
+                child.setName(child_pb->name);
+            }
+
+            //Unused children with no routing are not loaded any further
+            if (child_pb->parent_pb != nullptr) {
+                write_binary_pb(child, child_pb);
+            }
+        }
+    }
+}
+
+static void write_binary_netlist(const char* net_file,
+                                 const std::string& binary_file,
+                                 const ClusteredNetlist& clb_nlist,
+                                 const t_arch* arch) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    uint64_t net_file_size = 0;
+    int64_t net_file_mod_time = 0;
+    if (!get_file_stamp(net_file, net_file_size, net_file_mod_time)) {
+        VTR_LOG_WARN("Failed to write binary packed netlist '%s': cannot stat '%s'\n", binary_file.c_str(), net_file);
+        return;
+    }
+
+    ::capnp::MallocMessageBuilder builder;
+    auto netlist = builder.initRoot<VprPackedNetlist>();
+
+    netlist.setNetlistId(clb_nlist.netlist_id().c_str());
+    netlist.setNetFileSize(net_file_size);
+    netlist.setNetFileModTime(net_file_mod_time);
+    netlist.setArchitectureId(arch->architecture_id);
+    netlist.setAtomNetlistId(atom_ctx.netlist().netlist_id().c_str());
+
+    //Number the atom nets of the pins with no driver in their cluster (the other pins get
+    //their net from their driver when loaded)
+    std::vector<AtomNetId> nets;
+    std::unordered_map<AtomNetId, int> net_indices;
+    for (ClusterBlockId blk_id : clb_nlist.blocks()) {
+        for (const auto& [pin, route] : clb_nlist.block_pb(blk_id)->pb_route) {
+            if (route.driver_pb_pin_id == UNDEFINED && route.atom_net_id) {
+                if (net_indices.emplace(route.atom_net_id, nets.size()).second) {
+                    nets.push_back(route.atom_net_id);
+                }
+            }
+        }
+    }
+
+    auto net_names = netlist.initNets(nets.size());
+    for (size_t inet = 0; inet < nets.size(); inet++) {
+        net_names.set(inet, atom_ctx.netlist().net_name(nets[inet]).c_str());
+    }
+
+    auto clusters = netlist.initClusters(clb_nlist.blocks().size());
+    size_t icluster = 0;
+    for (ClusterBlockId blk_id : clb_nlist.blocks()) {
+        const t_pb* pb = clb_nlist.block_pb(blk_id);
+
+        auto cluster = clusters[icluster++];
+        cluster.setName(clb_nlist.block_name(blk_id).c_str());
+        cluster.setType(clb_nlist.block_type(blk_id)->name.c_str());
+        write_binary_pb(cluster.initRoot(), pb);
+
+        auto routes = cluster.initRoutes(pb->pb_route.size());
+        size_t iroute = 0;
+        for (const auto& [pin, route] : pb->pb_route) {
+            auto route_builder = routes[iroute++];
+            route_builder.setPin(pin);
+            if (route.driver_pb_pin_id == UNDEFINED && route.atom_net_id) {
+                route_builder.setNet(net_indices.at(route.atom_net_id));
+            } else {
+                route_builder.setNet(-1);
+            }
+            route_builder.setDriverPin(route.driver_pb_pin_id);
+        }
+    }
+
+    //Write to a temporary file which is then renamed, so that a partially written binary
+    //packed netlist is never loaded
+    const std::string temp_file = binary_file + ".tmp";
+    try {
+        writeMessageToFile(temp_file, &builder);
+        std::filesystem::rename(temp_file, binary_file);
+        VTR_LOG("Wrote binary packed netlist '%s'.\n", binary_file.c_str());
+    } catch (const vtr::VtrError& e) {
+        VTR_LOG_WARN("Failed to write binary packed netlist '%s': %s\n", binary_file.c_str(), e.what());
+    } catch (const std::filesystem::filesystem_error& e) {
+        VTR_LOG_WARN("Failed to write binary packed netlist '%s': %s\n", binary_file.c_str(), e.what());
+    }
+}
+
+#endif // VTR_ENABLE_CAPNPROTO
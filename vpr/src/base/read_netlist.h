@@ -8,15 +8,56 @@
  *        the netlist data structures for VPR
  */
 
+#include <string>
+#include <vector>
+
 #include "atom_netlist_fwd.h"
 #include "clustered_netlist_fwd.h"
 #include "physical_types.h"
 
+/**
+ * @brief Loads a packed netlist file (.net).
+ *
+ * If binary_net_file is set, a binary (Cap'n Proto) copy of the packed
+ * netlist is kept next to the file (see get_binary_net_file_name()): it is
+ * loaded instead of the file while it is up to date with it (i.e. the file
+ * has not been modified since the copy was written), and is written after
+ * the file is loaded otherwise. Both load to the same netlist.
+ */
 ClusteredNetlist read_netlist(const char* net_file,
                               const t_arch* arch,
                               bool verify_file_digests,
+                              bool binary_net_file,
                               int verbosity);
 
+/**
+ * @brief Returns the name of the binary copy of a packed netlist file.
+ */
+std::string get_binary_net_file_name(const std::string& net_file);
+
+/**
+ * @brief A cluster (top-level block) of a packed netlist file, as recorded in
+ *        the file: by names only, since the file may belong to another version
+ *        of the netlist.
+ */
+struct t_net_file_cluster {
+    /// @brief Name of the cluster
+    std::string name;
+    /// @brief Name of the logical block type of the cluster
+    std::string type_name;
+    /// @brief Name of the mode of the cluster
+    std::string mode_name;
+    /// @brief Names of the atoms (primitive blocks) in the cluster, in file order
+    std::vector<std::string> atom_names;
+};
+
+/**
+ * @brief Reads the clustering of a packed netlist file, without loading it
+ *        into the netlist data structures (e.g. to reuse the clustering of a
+ *        previous version of the netlist).
+ */
+std::vector<t_net_file_cluster> read_netlist_clusters(const char* net_file);
+
 void set_atom_pin_mapping(const ClusteredNetlist& clb_nlist,
                           const AtomBlockId atom_blk,
                           const AtomPortId atom_port,
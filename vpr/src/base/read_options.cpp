@@ -4,6 +4,7 @@
 #include "vpr_error.h"
 
 #include "argparse.hpp"
+#include "tatum/Time.hpp"
 
 #include "ap_flow_enums.h"
 #include "vpr_types.h"
@@ -135,6 +136,41 @@ struct ParseCircuitFormat {
     }
 };
 
+struct ParseAPGlobalPlacer {
+    ConvertedValue<e_ap_global_placer> from_str(const std::string& str) {
+        ConvertedValue<e_ap_global_placer> conv_value;
+        if (str == "simpl")
+            conv_value.set_value(e_ap_global_placer::SimPL);
+        else if (str == "electrostatic")
+            conv_value.set_value(e_ap_global_placer::Electrostatic);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '" << str << "' to e_ap_global_placer (expected one of: " << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_ap_global_placer val) {
+        ConvertedValue<std::string> conv_value;
+        switch (val) {
+            case e_ap_global_placer::SimPL:
+                conv_value.set_value("simpl");
+                break;
+            case e_ap_global_placer::Electrostatic:
+                conv_value.set_value("electrostatic");
+                break;
+            default:
+                VTR_ASSERT(false);
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"simpl", "electrostatic"};
+    }
+};
+
 struct ParseAPAnalyticalSolver {
     ConvertedValue<e_ap_analytical_solver> from_str(const std::string& str) {
         ConvertedValue<e_ap_analytical_solver> conv_value;
@@ -261,6 +297,8 @@ struct ParseAPDetailedPlacer {
             conv_value.set_value(e_ap_detailed_placer::Identity);
         else if (str == "annealer")
             conv_value.set_value(e_ap_detailed_placer::Annealer);
+        else if (str == "refine-annealer")
+            conv_value.set_value(e_ap_detailed_placer::RefineAnnealer);
         else {
             std::stringstream msg;
             msg << "Invalid conversion from '" << str << "' to e_ap_detailed_placer (expected one of: " << argparse::join(default_choices(), ", ") << ")";
@@ -278,6 +316,9 @@ struct ParseAPDetailedPlacer {
             case e_ap_detailed_placer::Annealer:
                 conv_value.set_value("annealer");
                 break;
+            case e_ap_detailed_placer::RefineAnnealer:
+                conv_value.set_value("refine-annealer");
+                break;
             default:
                 VTR_ASSERT(false);
         }
@@ -285,7 +326,7 @@ struct ParseAPDetailedPlacer {
     }
 
     std::vector<std::string> default_choices() {
-        return {"none", "annealer"};
+        return {"none", "annealer", "refine-annealer"};
     }
 };
 
@@ -296,6 +337,8 @@ struct ParseRoutePredictor {
             conv_value.set_value(SAFE);
         else if (str == "aggressive")
             conv_value.set_value(AGGRESSIVE);
+        else if (str == "production")
+            conv_value.set_value(PRODUCTION);
         else if (str == "off")
             conv_value.set_value(OFF);
         else {
@@ -312,6 +355,8 @@ struct ParseRoutePredictor {
             conv_value.set_value("safe");
         else if (val == AGGRESSIVE)
             conv_value.set_value("aggressive");
+        else if (val == PRODUCTION)
+            conv_value.set_value("production");
         else {
             VTR_ASSERT(val == OFF);
             conv_value.set_value("off");
@@ -321,7 +366,7 @@ struct ParseRoutePredictor {
     }
 
     std::vector<std::string> default_choices() {
-        return {"safe", "aggressive", "off"};
+        return {"safe", "aggressive", "production", "off"};
     }
 };
 
@@ -334,6 +379,10 @@ struct ParseRouterAlgorithm {
             conv_value.set_value(PARALLEL);
         else if (str == "parallel_decomp")
             conv_value.set_value(PARALLEL_DECOMP);
+        else if (str == "distributed")
+            conv_value.set_value(DISTRIBUTED);
+        else if (str == "gpu_batch")
+            conv_value.set_value(GPU_BATCH);
         else if (str == "timing_driven")
             conv_value.set_value(TIMING_DRIVEN);
         else {
@@ -352,6 +401,10 @@ struct ParseRouterAlgorithm {
             conv_value.set_value("parallel");
         else if (val == PARALLEL_DECOMP)
             conv_value.set_value("parallel_decomp");
+        else if (val == DISTRIBUTED)
+            conv_value.set_value("distributed");
+        else if (val == GPU_BATCH)
+            conv_value.set_value("gpu_batch");
         else {
             VTR_ASSERT(val == TIMING_DRIVEN);
             conv_value.set_value("timing_driven");
@@ -373,6 +426,10 @@ struct ParseNodeReorderAlgorithm {
             conv_value.set_value(DEGREE_BFS);
         else if (str == "random_shuffle")
             conv_value.set_value(RANDOM_SHUFFLE);
+        else if (str == "hilbert_curve")
+            conv_value.set_value(HILBERT_CURVE);
+        else if (str == "reverse_cuthill_mckee")
+            conv_value.set_value(REVERSE_CUTHILL_MCKEE);
         else {
             std::stringstream msg;
             msg << "Invalid conversion from '" << str << "' to e_rr_node_reorder_algorithm (expected one of: " << argparse::join(default_choices(), ", ") << ")";
@@ -387,15 +444,19 @@ struct ParseNodeReorderAlgorithm {
             conv_value.set_value("none");
         else if (val == DEGREE_BFS)
             conv_value.set_value("degree_bfs");
-        else {
-            VTR_ASSERT(val == RANDOM_SHUFFLE);
+        else if (val == RANDOM_SHUFFLE)
             conv_value.set_value("random_shuffle");
+        else if (val == HILBERT_CURVE)
+            conv_value.set_value("hilbert_curve");
+        else {
+            VTR_ASSERT(val == REVERSE_CUTHILL_MCKEE);
+            conv_value.set_value("reverse_cuthill_mckee");
         }
         return conv_value;
     }
 
     std::vector<std::string> default_choices() {
-        return {"none", "degree_bfs", "random_shuffle"};
+        return {"none", "degree_bfs", "random_shuffle", "hilbert_curve", "reverse_cuthill_mckee"};
     }
 };
 
@@ -1268,6 +1329,10 @@ struct ParseRouterHeap {
             conv_value.set_value(e_heap_type::BINARY_HEAP);
         else if (str == "four_ary")
             conv_value.set_value(e_heap_type::FOUR_ARY_HEAP);
+        else if (str == "bucket")
+            conv_value.set_value(e_heap_type::BUCKET_HEAP);
+        else if (str == "auto")
+            conv_value.set_value(e_heap_type::AUTO_HEAP);
         else {
             std::stringstream msg;
             msg << "Invalid conversion from '" << str << "' to e_heap_type (expected one of: " << argparse::join(default_choices(), ", ") << ")";
@@ -1280,15 +1345,19 @@ struct ParseRouterHeap {
         ConvertedValue<std::string> conv_value;
         if (val == e_heap_type::BINARY_HEAP)
             conv_value.set_value("binary");
-        else {
-            VTR_ASSERT(val == e_heap_type::FOUR_ARY_HEAP);
+        else if (val == e_heap_type::FOUR_ARY_HEAP)
             conv_value.set_value("four_ary");
+        else if (val == e_heap_type::BUCKET_HEAP)
+            conv_value.set_value("bucket");
+        else {
+            VTR_ASSERT(val == e_heap_type::AUTO_HEAP);
+            conv_value.set_value("auto");
         }
         return conv_value;
     }
 
     std::vector<std::string> default_choices() {
-        return {"binary", "four_ary", "bucket"};
+        return {"binary", "four_ary", "bucket", "auto"};
     }
 };
 
@@ -1379,7 +1448,7 @@ struct ParseTimingUpdateType {
         ConvertedValue<std::string> conv_value;
         if (val == e_timing_update_type::AUTO)
             conv_value.set_value("auto");
-        if (val == e_timing_update_type::FULL)
+        else if (val == e_timing_update_type::FULL)
             conv_value.set_value("full");
         else {
             VTR_ASSERT(val == e_timing_update_type::INCREMENTAL);
@@ -1668,7 +1737,8 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
     gen_grp.add_argument<e_timing_update_type, ParseTimingUpdateType>(args.timing_update_type, "--timing_update_type")
         .help(
             "Controls how timing analysis updates are performed:\n"
-            " * auto: VPR decides\n"
+            " * auto: VPR decides (the placer uses incremental updates\n"
+            "         when it updates timing within each temperature)\n"
             " * full: Full timing updates are performed (may be faster \n"
             "         if circuit timing has changed significantly)\n"
             " * incr: Incremental timing updates are performed (may be \n"
@@ -1676,6 +1746,24 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("auto")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    gen_grp.add_argument(args.timing_corner_delay_scales, "--timing_corner_delay_scales")
+        .help(
+            "Delay scale factors of additional timing corners (e.g. '1.15 0.85' for slow and fast corners)"
+            " analyzed alongside the nominal architecture delays."
+            " All the corners are analyzed in the same timing graph traversal; the nominal (primary) corner"
+            " drives the timing optimizations, while the slacks of the others are reported."
+            " VPR must be built with room for the extra corners (the TATUM_TIME_VEC_WIDTH CMake option).")
+        .nargs('+')
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    gen_grp.add_argument<bool, ParseOnOff>(args.timing_graph_opt_layout, "--timing_graph_opt_layout")
+        .help(
+            "Renumbers the timing graph nodes and edges in level order once it is built, so that"
+            " the levelized traversals of the timing analyzer read the graph sequentially in memory."
+            " Turning it off keeps the construction order (mostly useful to debug or measure the layout).")
+        .default_value("on")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument<bool, ParseOnOff>(args.CreateEchoFile, "--echo_file")
         .help(
             "Generate echo files of key internal data structures."
@@ -1683,6 +1771,22 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    gen_grp.add_argument(args.write_timing_graph_echo, "--write_timing_graph_echo")
+        .help(
+            "Writes the timing graph, constraints and delays (timing_graph.<stage>.echo) at these stages,"
+            " without the other echo files."
+            " The files can be replayed by tatum_test to benchmark the timing analyzers in isolation."
+            " Comma separated list of: pre_pack, place_initial, place_final, route_final, analysis, all, off")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    gen_grp.add_argument<bool, ParseOnOff>(args.anonymize_timing_graph_echo, "--anonymize_timing_graph_echo")
+        .help(
+            "Name the clock domains of the timing graph echo files clk0, clk1, ..."
+            " so the files reveal nothing of the design but its timing graph structure and delays")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument<bool, ParseOnOff>(args.verify_file_digests, "--verify_file_digests")
         .help(
             "Verify that files loaded by VPR (e.g. architecture, netlist,"
@@ -1788,6 +1892,39 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             "VPR_FATAL_ERROR is called and processing ends.")
         .default_value("off");
 
+    gen_grp.add_argument(args.profile_trace_file, "--profile_trace")
+        .help(
+            "Records the time spent in the profiling zones of VPR (its stages and their main steps),\n"
+            "writes them to the specified file as a Chrome trace (which can be opened with chrome://tracing\n"
+            "or https://ui.perfetto.dev), and prints a summary of the time spent in each zone at the end of the flow.")
+        .metavar("TRACE_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    gen_grp.add_argument<bool, ParseOnOff>(args.report_memory_usage, "--report_memory_usage")
+        .help(
+            "Reports the memory held by the major data structures of VPR (device, placement, routing,\n"
+            "timing graph and router lookahead) after packing, placement and routing.\n"
+            "The heap usage is also reported if VTR is built with VTR_ENABLE_ALLOCATION_COUNTING.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    gen_grp.add_argument<bool, ParseOnOff>(args.huge_pages, "--huge_pages")
+        .help(
+            "Controls whether the large arrays (e.g. the RR node data and the router lookahead maps)\n"
+            "are aligned to 2 MiB and advised to be backed by transparent huge pages, which reduces\n"
+            "the TLB misses of their random accesses.")
+        .default_value("on")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    gen_grp.add_argument<bool, ParseOnOff>(args.numa_aware_threads, "--numa_aware_threads")
+        .help(
+            "On machines with several NUMA nodes, pins the worker threads to the CPUs of a node so they keep\n"
+            "their memory local. The parallel router also routes each node's regions of the partition tree\n"
+            "with the node's workers, and moves its per-node routing state to the node using it most.\n"
+            "The parallel placer keeps each region on the same worker. No effect on a single NUMA node.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& file_grp = parser.add_argument_group("file options");
 
     file_grp.add_argument<e_arch_format, ParseArchFormat>(args.arch_format, "--arch_format")
@@ -1820,6 +1957,15 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .help("Path to packed netlist file")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument<bool, ParseOnOff>(args.binary_net_file, "--binary_net_file")
+        .help(
+            "Keeps a binary (Cap'n Proto) copy of the packed netlist next to the packed netlist file"
+            " (<net_file>.bin), which is loaded instead of the packed netlist file while it is up to date."
+            " The binary copy is (re)written whenever the packed netlist file is loaded."
+            " Requires VPR to be built with VTR_ENABLE_CAPNPROTO.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.FlatPlaceFile, "--flat_place_file")
         .help("Path to input flat placement file")
         .show_in(argparse::ShowIn::HELP_ONLY);
@@ -1832,12 +1978,29 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .help("Path to routing file")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.write_place_file, "--write_place_file")
+        .help(
+            "Writes a copy of the loaded placement to the specified file, "
+            "which allows converting a placement file between the text format "
+            "and the binary format (used if the file name ends with '.bin'). "
+            "Routing files generated from the copy refer to it.")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.write_route_file, "--write_route_file")
+        .help(
+            "Writes a copy of the loaded routing to the specified file, "
+            "which allows converting a routing file between the text format "
+            "and the binary format (used if the file name ends with '.bin'). "
+            "When converting both the placement and the routing, use --write_place_file "
+            "as well so the copy refers to the converted placement.")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.SDCFile, "--sdc_file")
         .help("Path to timing constraints file in SDC format")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.read_rr_graph_file, "--read_rr_graph")
-        .help("The routing resource graph file to load. "
+        .help("The routing resource graph file to load (.xml, gzip compressed .xml.gz, or .bin). "
               "The loaded routing resource graph overrides any routing architecture specified in the architecture file.")
         .metavar("RR_GRAPH_FILE")
         .show_in(argparse::ShowIn::HELP_ONLY);
@@ -1851,7 +2014,7 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.write_rr_graph_file, "--write_rr_graph")
-        .help("Writes the routing resource graph to the specified file.")
+        .help("Writes the routing resource graph to the specified file (.xml, gzip compressed .xml.gz, or .bin).")
         .metavar("RR_GRAPH_FILE")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
@@ -1911,6 +2074,17 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .help("Writes the intra-cluster lookahead data to the specified file.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.setup_cache_dir, "--setup_cache_dir")
+        .help(
+            "Directory used to cache the router lookahead, intra-cluster lookahead and placement delay lookup."
+            " Each is stored under a name derived from the architecture, the RR graph and the options it depends on,"
+            " and is read back (instead of being recomputed) by later runs which match."
+            " Requires VPR to be built with Cap'n Proto support."
+            " The parsed architecture file is also cached (for the same build of VPR), without requiring Cap'n Proto."
+            " Empty (the default) disables caching.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.read_placement_delay_lookup, "--read_placement_delay_lookup")
         .help(
             "Reads the placement delay lookup from the specified file instead of computing it.")
@@ -1976,8 +2150,25 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("1")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    netlist_grp.add_argument<bool, ParseOnOff>(args.mmap_blif_parser, "--mmap_blif_parser")
+        .help(
+            "Controls whether BLIF/EBLIF circuit files are parsed by mapping them into memory and"
+            " tokenizing them in place (in parallel, if VPR is built with TBB), which is much"
+            " faster on large circuits."
+            " If off, the circuit is parsed with libblifparse.")
+        .default_value("on")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& ap_grp = parser.add_argument_group("analytical placement options");
 
+    ap_grp.add_argument<e_ap_global_placer, ParseAPGlobalPlacer>(args.ap_global_placer, "--ap_global_placer")
+        .help(
+            "Controls which Global Placer the AP Flow will use.\n"
+            " * simpl: Iterates between the Analytical Solver and the Partial Legalizer until the lower and upper bound placements converge.\n"
+            " * electrostatic: Spreads the solution of the Analytical Solver by minimizing the wirelength plus an electrostatic density penalty (ePlace) using Nesterov's method, then runs the Partial Legalizer once.")
+        .default_value("simpl")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     ap_grp.add_argument<e_ap_analytical_solver, ParseAPAnalyticalSolver>(args.ap_analytical_solver, "--ap_analytical_solver")
         .help(
             "Controls which Analytical Solver the Global Placer will use in the AP Flow.\n"
@@ -2009,7 +2200,8 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .help(
             "Controls which Detailed Placer to use in the AP Flow.\n"
             " * none: Do not perform any detailed placement. i.e. the output of the full legalizer will be produced by the AP flow without modification.\n"
-            " * annealer: Use the Annealer from the Placement stage as a Detailed Placer. This will use the same Placer Options from the Place stage to configure the annealer.")
+            " * annealer: Use the Annealer from the Placement stage as a Detailed Placer. This will use the same Placer Options from the Place stage to configure the annealer.\n"
+            " * refine-annealer: Use the Annealer as a refinement of the AP placement. The annealer starts at a low temperature and anneals non-overlapping regions of the device in parallel (at least 4 regions along each dimension, or --place_parallel_regions if larger). Falls back to serial moves when --place_speculative_moves is used.")
         .default_value("annealer")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
@@ -2113,6 +2305,21 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    ap_grp.add_argument(args.ap_write_partial_placement, "--ap_write_partial_placement")
+        .help(
+            "Writes the partial placement produced by the Global Placer of the "
+            "AP flow to the given binary checkpoint file.")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    ap_grp.add_argument(args.ap_read_partial_placement, "--ap_read_partial_placement")
+        .help(
+            "Reads the partial placement from the given binary checkpoint file "
+            "(see --ap_write_partial_placement) and skips the Global Placer of "
+            "the AP flow. The checkpoint must have been created from the same "
+            "netlist. This allows the Full Legalizer and Detailed Placer to be "
+            "re-run without re-running global placement.")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& pack_grp = parser.add_argument_group("packing options");
 
     pack_grp.add_argument<bool, ParseOnOff>(args.connection_driven_clustering, "--connection_driven_clustering")
@@ -2256,6 +2463,45 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("30")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    pack_grp.add_argument<int>(args.pack_num_partitions, "--pack_num_partitions")
+        .help(
+            "Number of partitions of the netlist the packer clusters in parallel (on up to --num_workers threads)."
+            " The netlist is partitioned by connectivity, or by flat placement location when one is given (APPack)."
+            " Each partition is clustered independently; the molecules at the partition boundaries are then"
+            " clustered serially. 1 clusters the whole netlist serially. Ignored once floorplan constraints"
+            " make the packer use attraction groups.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    pack_grp.add_argument<int>(args.pack_speculative_candidates, "--pack_speculative_candidates")
+        .help(
+            "Number of candidate molecules the packer tries in parallel (on up to --num_workers threads) when"
+            " legalizing a cluster with full intra-cluster routing. Each candidate is tried on a replica of the"
+            " cluster, and the best one which passed is then added to the cluster. The candidates after it are"
+            " only proposed again once the gains are updated, so the clustering may differ slightly from the"
+            " serial one."
+            " 1 tries the candidates one at a time.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    pack_grp.add_argument<bool, ParseOnOff>(args.pack_profile, "--pack_profile")
+        .help(
+            "Reports, for each packing iteration, the time spent in seed selection, candidate gain updates,"
+            " the pin feasibility filter and intra-cluster routing, and the outcome of the attempts to pack"
+            " molecules, broken down by logical block type")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    pack_grp.add_argument(args.pack_eco_net_file, "--pack_eco_net_file")
+        .help(
+            "Packed netlist (.net) of a previous version of the circuit to reuse the clustering of."
+            " The atoms are matched by name, and each cluster of the previous packing is rebuilt from"
+            " the molecules whose atoms are all still in it (and re-legalized, so changed connectivity"
+            " is caught). Only the molecules of new or changed logic, or of clusters which are no longer"
+            " legal, are clustered from scratch.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     pack_grp.add_argument<int>(args.pack_verbosity, "--pack_verbosity")
         .help("Controls how verbose clustering's output is. Higher values produce more output (useful for debugging architecture packing problems)")
         .default_value("2")
@@ -2312,6 +2558,17 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("1.0")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.anneal_convergence_threshold, "--anneal_convergence_threshold")
+        .help(
+            "Ends the anneal (going on to the quench) once it has converged: after each temperature,"
+            " the relative improvement of the placement cost the next temperature would bring is"
+            " predicted from the improvement per move of the last few temperatures, and the anneal"
+            " ends when it is below this fraction of the cost (e.g. 0.001). This skips the late"
+            " temperatures which barely improve the placement, at a small cost in quality."
+            " 0 disables it, following the annealing schedule to its exit criterion.")
+        .default_value("0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument<e_anneal_init_t_estimator, ParsePlaceInitTEstimator>(args.place_init_t_estimator, "--anneal_auto_init_t_estimator")
         .help(
             "Controls which estimation method is used when selecting the starting temperature "
@@ -2396,12 +2653,80 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("0.0")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_speculative_moves, "--place_speculative_moves")
+        .help(
+            "Number of moves the annealer proposes at once and evaluates concurrently."
+            " The moves of a batch move distinct blocks and affect distinct nets, and are"
+            " accepted or rejected in proposal order, so results are reproducible for a given"
+            " seed and value of this option. A value of 1 evaluates one move at a time."
+            " Not used with the slack_timing placement algorithm or NoC optimization.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_parallel_regions, "--place_parallel_regions")
+        .help(
+            "Splits the device into this number of regions along each of its x and y dimensions,"
+            " and anneals the blocks of each region in parallel. Blocks connected to blocks of"
+            " other regions stay in place, and the region boundaries are shifted between"
+            " temperatures so that every block can move. Regions are also split at the layer and"
+            " die (interposer cut) boundaries: the blocks connected to other dies or layers are"
+            " moved serially after the regions. Results are reproducible for a given"
+            " seed and value of this option. A value of 1 disables region partitioning."
+            " Not used with the slack_timing placement algorithm, NoC optimization or"
+            " --place_speculative_moves.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_num_seeds, "--place_num_seeds")
+        .help(
+            "Number of placements run concurrently with the seeds --seed, --seed + 1, ..., sharing"
+            " the device, netlist and placement delay model. The best placement (lowest bounding"
+            " box cost, times the critical path delay for timing-driven placement) is kept."
+            " Only the kept placement is reported. Not used with NoC optimization.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_seed_stop_ratio, "--place_seed_stop_ratio")
+        .help(
+            "With --place_num_seeds, a seed stops annealing when, after a temperature, its"
+            " placement is more than this factor worse than the best placement of the other seeds"
+            " after the same temperature. Which seeds are stopped may then depend on the thread"
+            " scheduling. 0 never stops a seed, which keeps the result reproducible.")
+        .default_value("1.2")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_eco_place_file, "--eco_place_file")
+        .help(
+            "Placement (.place) of a previous version of the circuit to place incrementally from"
+            " (e.g. after packing with --pack_eco_net_file). The blocks are matched by name and"
+            " start at their previous locations; the new or changed blocks are placed around them."
+            " Only the blocks within --eco_window of the blocks which did not get their previous"
+            " location are annealed, with moves limited to that window.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_eco_window, "--eco_window")
+        .help(
+            "Distance (in tiles) around the new or changed blocks within which the blocks of an"
+            " incremental placement (see --eco_place_file) can move. 0 only moves the new or"
+            " changed blocks.")
+        .default_value("4")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument(args.place_move_stats_file, "--place_move_stats")
         .help(
             "File to write detailed placer move statistics to")
         .default_value("")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_move_profile_file, "--place_move_profile")
+        .help(
+            "CSV file to write a profile of each move type to, at each temperature:"
+            " the number of proposed, accepted, rejected and aborted moves, the time spent"
+            " proposing and evaluating them (including timing analysis) and the moves per second.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument(args.placement_saves_per_temperature, "--save_placement_per_temperature")
         .help(
             "Controls how often VPR saves the current placement to a file per temperature (may be helpful for debugging)."
@@ -2479,6 +2804,15 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("0.05")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_agent_batch_size, "--place_agent_batch_size")
+        .help(
+            "Number of moves the softmax placement RL agent proposes from the same action probabilities. "
+            "The probabilities are recomputed from the agent's estimates once per batch, "
+            "while the estimates are still updated after each move. "
+            "Values > 1 reduce the agent's overhead at a small cost in how quickly it adapts.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument(args.place_dm_rlim, "--place_dm_rlim")
         .help(
             "The maximum range limit of any directed move other than the uniform move. "
@@ -2637,6 +2971,14 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("min")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_timing_grp.add_argument<bool, ParseOnOff>(args.place_delay_model_background, "--place_delay_model_background")
+        .help(
+            "Whether the placement delay model (and the router lookahead) is computed in the background"
+            " while the initial placement runs. This only happens when the routing resource graph is"
+            " already built for the placement channel width. The placement is unchanged.")
+        .default_value("on")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_timing_grp.add_argument(args.place_delay_offset, "--place_delay_offset")
         .help(
             "A constant offset (in seconds) applied to the placer's delay model.")
@@ -2777,15 +3119,53 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_grp.add_argument<int>(args.chan_width_search_jobs, "--chan_width_search_jobs")
+        .help(
+            "Number of channel widths the minimum channel width search routes at once, each in its own"
+            " (forked) process with its own RR graph; the log of each is written to"
+            " vpr_route_chan_width_<W>.log. Each attempt uses up to --num_workers threads and the"
+            " memory of a full routing. The minimum routable width found is routed again in the main"
+            " process. Requires a fixed placement (not --place_frequency always) and a POSIX system."
+            " 1 searches one width at a time.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_grp.add_argument<e_router_algorithm, ParseRouterAlgorithm>(args.RouterAlgorithm, "--router_algorithm")
         .help(
             "Specifies the router algorithm to use.\n"
             " * timing driven: focuses on routability and circuit speed [default]\n"
             " * parallel: timing_driven with nets in different regions of the chip routed in parallel\n"
             " * parallel_decomp: timing_driven with additional parallelism obtained by decomposing high-fanout nets, possibly reducing quality\n"
-            " * nested: parallel with parallelized path search\n")
+            " * nested: parallel with parallelized path search\n"
+            " * distributed: timing_driven with the nets of different regions routed by different MPI ranks"
+            " (e.g. on several machines: mpirun -n <ranks> vpr ...). Every rank runs the whole flow with the same"
+            " options, in its own directory. Requires VPR to be built with VPR_USE_MPI.\n"
+            " * gpu_batch: timing_driven with the paths of the low criticality nets (see --router_batch_max_criticality)"
+            " searched together, on a GPU if VPR is built with VPR_USE_CUDA (on CPU threads otherwise), then routed"
+            " along these paths unless they conflict with the routing so far. Experimental, not for flat routing.\n")
         .default_value("timing_driven")
-        .choices({"nested", "parallel", "parallel_decomp", "timing_driven"})
+        .choices({"nested", "parallel", "parallel_decomp", "distributed", "gpu_batch", "timing_driven"})
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_grp.add_argument<bool, ParseOnOff>(args.router_partition_node_batching, "--router_partition_node_batching")
+        .help(
+            "Controls whether the parallel router also routes nets inside a single partition tree node in parallel."
+            " Nets of a node are grouped into batches of nets with mutually disjoint bounding boxes, and the nets"
+            " of each batch are routed concurrently. This mainly helps the top levels of the partition tree, where"
+            " cutline-crossing nets would otherwise be routed by a single thread."
+            " Results are deterministic, but the net ordering differs from the default parallel router."
+            " This parameter has no effect unless --router_algorithm is parallel.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_grp.add_argument<bool, ParseOnOff>(args.router_deterministic_parallel, "--router_deterministic_parallel")
+        .help(
+            "Makes the results of the parallel routers independent of thread timing, so that runs with"
+            " the same inputs give identical routings. Nets of a partition tree node with the same fanout"
+            " are routed in net ID order, per-thread results are merged in net ID order and timing graph"
+            " invalidations are applied in a fixed order once all nets of an iteration are routed."
+            " This parameter has no effect unless --router_algorithm is parallel or parallel_decomp.")
+        .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     route_grp.add_argument(args.min_incremental_reroute_fanout, "--min_incremental_reroute_fanout")
@@ -2813,9 +3193,19 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             "Specifies the node reordering algorithm to use.\n"
             " * none: don't reorder nodes\n"
             " * degree_bfs: sort by degree and then by BFS\n"
-            " * random_shuffle: a random shuffle\n")
+            " * random_shuffle: a random shuffle\n"
+            " * hilbert_curve: sort by layer and then by position along a Hilbert curve over the device\n"
+            " * reverse_cuthill_mckee: reverse Cuthill-McKee (bandwidth reducing) ordering\n")
         .default_value("none")
-        .choices({"none", "degree_bfs", "random_shuffle"})
+        .choices({"none", "degree_bfs", "random_shuffle", "hilbert_curve", "reverse_cuthill_mckee"})
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_grp.add_argument<bool, ParseOnOff>(args.compress_rr_graph_edges, "--compress_rr_graph_edges")
+        .help(
+            "Drop the per-edge source node array once the RR graph is built, recovering edge sources"
+            " from the per-node edge ranges instead. Reduces RR graph edge memory by ~40%,"
+            " at the cost of slower edge source lookups.")
+        .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     route_grp.add_argument(args.reorder_rr_graph_nodes_threshold, "--reorder_rr_graph_nodes_threshold")
@@ -2879,7 +3269,9 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .help(
             "Controls whether the MultiQueue-based parallel connection router is used during a single connection"
             " routing. When enabled, the parallel connection router accelerates the path search for individual"
-            " source-sink connections using multi-threading without altering the net routing order.")
+            " source-sink connections using multi-threading without altering the net routing order."
+            " With --router_algorithm parallel, it is used for the nets at the top of the partition tree"
+            " (root nets and high fanout nets), while the other nets are routed serially in parallel.")
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
@@ -2935,6 +3327,25 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<int>(args.multi_queue_stickiness, "--multi_queue_stickiness")
+        .help(
+            "Controls how many consecutive pops a thread of the parallel connection router makes from the"
+            " same queue of the MultiQueue before picking new queues at random. Higher values reduce the"
+            " queue selection overhead and contention, but relax the priority order further (more wasted"
+            " expansions). 1 picks new queues for every pop."
+            " This parameter has no effect if --enable_parallel_connection_router is not set.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<int>(args.multi_queue_pop_batch_size, "--multi_queue_pop_batch_size")
+        .help(
+            "Controls how many nodes a thread of the parallel connection router pops from a queue of the"
+            " MultiQueue at once (locking it once), before expanding them. Like --multi_queue_stickiness,"
+            " this trades priority order for overhead. 1 pops nodes one at a time."
+            " This parameter has no effect if --enable_parallel_connection_router is not set.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument(args.max_criticality, "--max_criticality")
         .help(
             "Sets the maximum fraction of routing cost derived from delay (vs routability) for any net."
@@ -2969,9 +3380,12 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             " to find the minimum channel width.\n"
             " * safe: Only abort when it is extremely unlikely a routing will succeed\n"
             " * aggressive: Further reduce run-time by giving up earlier. This may increase the reported minimum channel width\n"
+            " * production: Like aggressive, but also give up when the number of overused resources stops"
+            " decreasing, and skip the channel widths which the peak channel utilization of a failed routing"
+            " predicts will fail during the minimum channel width search\n"
             " * off: Only abort when the maximum number of iterations is reached\n")
         .default_value("safe")
-        .choices({"safe", "aggressive", "off"})
+        .choices({"safe", "aggressive", "production", "off"})
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     route_timing_grp.add_argument<e_routing_budgets_algorithm, RouteBudgetsAlgorithm>(args.routing_budgets_algorithm, "--routing_budgets_algorithm")
@@ -2992,6 +3406,39 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument(args.route_checkpoint_file, "--route_checkpoint_file")
+        .help(
+            "Binary file to which the router periodically checkpoints its state (routing, accumulated"
+            " congestion costs, present congestion factor, iteration counters, ...), so that a long"
+            " route interrupted by a crash or preemption can be resumed with --resume_routing."
+            " Checkpoints are only written until the first legal routing is found."
+            " Checkpointing is disabled if not specified.")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<int>(args.route_checkpoint_interval, "--route_checkpoint_interval")
+        .help("Number of routing iterations between checkpoints written to --route_checkpoint_file.")
+        .default_value("5")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.resume_routing, "--resume_routing")
+        .help(
+            "Controls whether the router resumes from the checkpoint in --route_checkpoint_file, if it"
+            " exists and matches the channel width being routed, instead of starting from scratch."
+            " Since a missing checkpoint is not an error, an interrupted job can simply be re-run"
+            " with the same options.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument(args.eco_route_file, "--eco_route_file")
+        .help(
+            "Routing (.route) of a previous version of the circuit to route incrementally from"
+            " (e.g. after placing with --eco_place_file). The nets are matched by name and keep"
+            " the branches of their previous routing to the sinks which did not move; the other"
+            " nets and sinks, and the kept routing which conflicts with them, are routed by the"
+            " usual negotiated congestion iterations. Ignored when resuming from a checkpoint.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<float>(args.congested_routing_iteration_threshold_frac, "--congested_routing_iteration_threshold")
         .help(
             "Controls when the router enters a high effort mode to resolve lingering routing congestion."
@@ -3022,6 +3469,24 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("0.1")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_high_fanout_skeleton, "--router_high_fanout_skeleton")
+        .help(
+            "Controls the order in which the sinks of high fanout nets are routed."
+            " If on, the router first builds a skeleton of the net by routing one sink per region of the net"
+            " (closest to the source first), and then attaches the remaining sinks to the nearby skeleton,"
+            " which keeps their wave expansions local. Timing critical sinks are still routed first.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument(args.router_net_profile_file, "--router_net_profile_file")
+        .help(
+            "CSV file to which the router writes, after each routing iteration, the wall time, heap pushes,"
+            " heap pops and connections routed of each net it routed, and how many iterations the net was"
+            " routed in so far (most time consuming net first). Helps finding the nets worth constraining"
+            " or pre-routing. Holds the last routing if VPR routes more than once (e.g. when searching"
+            " for the minimum channel width). Disabled if not specified.")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<e_router_lookahead, ParseRouterLookahead>(args.router_lookahead_type, "--router_lookahead")
         .help(
             "Controls what lookahead the router uses to calculate cost of completing a connection.\n"
@@ -3041,6 +3506,35 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("map")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_lookahead_lazy, "--router_lookahead_lazy")
+        .help(
+            "Only applies to the extended_map lookahead."
+            " If on, the cost map of each wire type is computed the first time the router needs it,"
+            " instead of computing the cost maps of all wire types before routing."
+            " Wire types which are never used (e.g. by a small design on a large device) are never computed.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_lookahead_quantized, "--router_lookahead_quantized")
+        .help(
+            "Only applies to the compressed_map lookahead."
+            " If on, the router queries a 16-bit quantized copy of the wire cost map (a third of its size),"
+            " which trades a relative error below 0.05% in the estimated costs for fewer cache misses."
+            " The quantization error against the float map is reported after the lookahead is computed.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<int>(args.router_lookahead_cache_entries, "--router_lookahead_cache_entries")
+        .help(
+            "Number of lookahead costs (rounded up to a power of two) each serial connection router"
+            " memoizes, keyed by (node, sink), so the costs queried again within a search or for the"
+            " same connection in later iterations (at the same criticality) are not recomputed."
+            " Only applies to the lookaheads whose costs don't depend on the routing state"
+            " (map, extended_map and compressed_map). The hit rate is reported with the router"
+            " statistics. 0 disables the cache.")
+        .default_value("0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<bool, ParseOnOff>(args.generate_router_lookahead_report, "--generate_router_lookahead_report")
         .help("If turned on, generates a detailed report on the router lookahead: report_router_lookahead.rpt\n"
               "\n"
@@ -3065,6 +3559,59 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("0.5")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_global_route_prepass, "--router_global_route_prepass")
+        .help(
+            "If on, the nets are first routed on a coarse grid of cells (see --router_global_route_gcell_size),"
+            " whose capacities are the channel widths of the RR graph summed over each cell."
+            " The resulting per-net corridors tighten the routing bounding boxes, and the congestion map of"
+            " the global routing replaces the placement-based estimate used for the initial acc_cost"
+            " (see --router_initial_acc_cost_chan_congestion_threshold).")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument(args.router_global_route_gcell_size, "--router_global_route_gcell_size")
+        .help("Width and height (in grid tiles) of the cells of the --router_global_route_prepass routing grid.")
+        .default_value("4")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_bidirectional_search, "--router_bidirectional_search")
+        .help(
+            "If on, long connections with low criticality (see --router_bidirectional_search_min_distance and"
+            " --router_bidirectional_search_max_criticality) are routed with a bidirectional search: forward from"
+            " the route tree and backward from the sink, until the two searches meet."
+            " This expands fewer nodes than a forward search for long connections, but estimates the delay of"
+            " the backward part less accurately. Requires an index of the RR graph edges by sink node"
+            " (8 bytes per edge). Only used by the serial connection router.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument(args.router_bidirectional_search_min_distance, "--router_bidirectional_search_min_distance")
+        .help("Minimum Manhattan distance (in grid tiles) between the source and sink of a connection routed with --router_bidirectional_search.")
+        .default_value("20")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument(args.router_bidirectional_search_max_criticality, "--router_bidirectional_search_max_criticality")
+        .help("Maximum timing criticality of a connection routed with --router_bidirectional_search.")
+        .default_value("0.5")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument(args.router_batch_max_criticality, "--router_batch_max_criticality")
+        .help(
+            "Maximum timing criticality of a connection routed along the path found by the batch search of"
+            " --router_algorithm gpu_batch. The batch search only minimizes congestion: the more critical"
+            " connections are routed by the timing-driven connection router.")
+        .default_value("0.5")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_clock_tree_routing, "--router_clock_tree_routing")
+        .help(
+            "If on (and --two_stage_clock_routing is on), the sinks of a clock net on a dedicated clock network"
+            " are routed together by a single breadth-first walk of the clock network from its drive point"
+            " (reached by the first stage), instead of one timing-driven search per sink."
+            " Sinks which cannot be reached without overusing the clock network are routed by the regular router.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument(args.router_max_convergence_count, "--router_max_convergence_count")
         .help(
             "Controls how many times the router is allowed to converge to a legal routing before halting."
@@ -3105,10 +3652,11 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             "Controls what type of heap to use for timing driven router.\n"
             " * binary: A binary heap is used.\n"
             " * four_ary: A four_ary heap is used.\n"
-            " * bucket: A bucket heap approximation is used. The bucket heap\n"
-            " *         is faster because it is only a heap approximation.\n"
-            " *         Testing has shown the approximation results in\n"
-            " *         similar QoR with less CPU work.\n")
+            " * bucket: A bucket (radix) heap is used. Its pushes and pops take\n"
+            " *         amortized constant time, which pays off when the routing\n"
+            " *         wavefronts are large (big devices, high fanout nets).\n"
+            " * auto: Picks bucket on big devices, or on medium ones with very\n"
+            " *       high fanout nets, and four_ary otherwise.\n")
         .default_value("four_ary")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
@@ -3168,6 +3716,24 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("on")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.check_rr_graph_trusted_digest, "--check_rr_graph_trusted_digest")
+        .help(
+            "If on (with --check_rr_graph on and a --setup_cache_dir), the digest of each rr graph read from disk"
+            " which passes the check is recorded in the setup cache, and later runs reading an rr graph with a"
+            " recorded digest skip the check. Computing the digest is much faster than checking the rr graph.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_masked_chan_width_search, "--router_masked_chan_width_search")
+        .help(
+            "If on, routing at a channel width narrower than the one the rr graph was last built for reuses"
+            " that rr graph (and its router lookahead): the tracks above the channel width are masked off"
+            " instead of rebuilding the rr graph. This speeds up the minimum channel width search, but the"
+            " connection and switch block patterns are the ones of the wider rr graph, so the minimum channel"
+            " width found may differ slightly from the one found with rebuilt rr graphs.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& analysis_grp = parser.add_argument_group("analysis options");
 
     analysis_grp.add_argument<bool, ParseOnOff>(args.full_stats, "--full_stats")
@@ -3219,6 +3785,13 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    analysis_grp.add_argument<bool, ParseOnOff>(args.timing_report_compress, "--timing_report_compress")
+        .help(
+            "Controls whether the timing reports (and the net timing report) are gzip compressed\n"
+            "as they are written, in which case '.gz' is appended to their file names\n")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     analysis_grp.add_argument(args.echo_dot_timing_graph_node, "--echo_dot_timing_graph_node")
         .help(
             "Controls how the timing graph echo file in DOT/GraphViz format is created when\n"
@@ -3296,6 +3869,19 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .help("Signal activities file for all nets (see documentation).")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    power_grp.add_argument<bool, ParseOnOff>(args.estimate_activity, "--estimate_activity")
+        .help(
+            "Estimates the signal activities by simulating the netlist with random vectors (many vector streams at once,"
+            " in parallel), rather than reading them from the activity file. The estimated activities are written to"
+            " the activity file.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    power_grp.add_argument(args.activity_estimation_cycles, "--activity_estimation_cycles")
+        .help("Number of cycles simulated on each of the vector streams by --estimate_activity.")
+        .default_value("1000")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& noc_grp = parser.add_argument_group("noc options");
 
     noc_grp.add_argument<bool, ParseOnOff>(args.noc, "--noc")
@@ -3391,6 +3977,17 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("0")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    noc_grp.add_argument<int>(args.noc_initial_placement_speculative_moves, "--noc_initial_placement_speculative_moves")
+        .help(
+            "Number of router swaps the initial NoC placement anneal proposes at once and evaluates concurrently. "
+            "The swaps of a batch move distinct routers, and are accepted or rejected in proposal order; "
+            "a swap whose traffic flows or links were changed by an accepted swap of its batch is re-evaluated. "
+            "Results are reproducible for a given seed and value of this option. "
+            "Only used when the routing algorithm routes all the traffic flows between two routers the same way "
+            "and the NoC is small enough for its route table. A value of 1 evaluates one swap at a time.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     noc_grp.add_argument<int>(args.noc_sat_routing_bandwidth_resolution, "--noc_sat_routing_bandwidth_resolution")
         .help(
             "Specifies the resolution by which traffic flow bandwidths are converted into integers in SAT routing algorithm.\n"
@@ -3418,12 +4015,40 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             "specified by -j command line option.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    noc_grp.add_argument<double>(args.noc_sat_routing_time_limit, "--noc_sat_routing_time_limit")
+        .help(
+            "The time budget, in seconds, of one invocation of the SAT router. When the budget runs out, "
+            "the best routing found so far is used. 0 means no limit.")
+        .default_value("0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     noc_grp.add_argument<bool, ParseOnOff>(args.noc_sat_routing_log_search_progress, "--noc_sat_routing_log_search_progress")
         .help(
             "Print the detailed log of the SAT solver's search progress.")
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    noc_grp.add_argument<bool, ParseOnOff>(args.noc_simulation, "--noc_simulation")
+        .help(
+            "Simulate the placed NoC with its traffic flows after placement, and report the latency "
+            "distribution of the packets and the saturated links. Unlike the NoC placement cost, "
+            "the simulation models the queueing of packets in the NoC links.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    noc_grp.add_argument<int>(args.noc_simulation_cycles, "--noc_simulation_cycles")
+        .help(
+            "The number of cycles simulated by the NoC simulator. A cycle is the time needed to send "
+            "a packet over the fastest NoC link. The first 10% of the cycles are not measured.")
+        .default_value("100000")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    noc_grp.add_argument<double>(args.noc_simulation_packet_size, "--noc_simulation_packet_size")
+        .help(
+            "The size, in bits, of the packets simulated by the NoC simulator.")
+        .default_value("512")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     noc_grp.add_argument<std::string>(args.noc_placement_file_name, "--noc_placement_file_name")
         .help(
             "Name of the output file that contains the NoC placement information."
@@ -3446,6 +4071,18 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .show_in(argparse::ShowIn::HELP_ONLY);
 #endif /* NO_SERVER */
 
+    auto& daemon_grp = parser.add_argument_group("daemon options");
+
+    daemon_grp.add_argument(args.daemon_socket, "--daemon_socket")
+        .help(
+            "Run as a daemon implementing many circuits on the same device, listening for jobs on this"
+            " Unix domain socket. The architecture (and, for a fixed device and channel width, the RR graph"
+            " and router lookahead) is loaded once, and each job runs in its own process forked from the"
+            " daemon. A job is sent as lines: the working directory of the job, the circuit file and,"
+            " optionally, the SDC file. The job log is sent back, followed by its exit code.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     return parser;
 }
 
@@ -3664,6 +4301,146 @@ bool verify_args(const t_options& args) {
                         args.router_lookahead_type.argument_name().c_str());
     }
 
+    if (args.activity_estimation_cycles < 2) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 2 (got %d)\n",
+                        args.activity_estimation_cycles.argument_name().c_str(),
+                        args.activity_estimation_cycles.value());
+    }
+
+    if (args.pack_num_partitions < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 1 (got %d)\n",
+                        args.pack_num_partitions.argument_name().c_str(),
+                        args.pack_num_partitions.value());
+    }
+
+    if (args.pack_speculative_candidates < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 1 (got %d)\n",
+                        args.pack_speculative_candidates.argument_name().c_str(),
+                        args.pack_speculative_candidates.value());
+    }
+
+    if (args.place_speculative_moves < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 1 (got %d)\n",
+                        args.place_speculative_moves.argument_name().c_str(),
+                        args.place_speculative_moves.value());
+    }
+
+    if (args.noc_initial_placement_speculative_moves < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 1 (got %d)\n",
+                        args.noc_initial_placement_speculative_moves.argument_name().c_str(),
+                        args.noc_initial_placement_speculative_moves.value());
+    }
+
+    if (args.place_parallel_regions < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 1 (got %d)\n",
+                        args.place_parallel_regions.argument_name().c_str(),
+                        args.place_parallel_regions.value());
+    }
+
+    if (args.place_num_seeds < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 1 (got %d)\n",
+                        args.place_num_seeds.argument_name().c_str(),
+                        args.place_num_seeds.value());
+    }
+
+    if (args.place_seed_stop_ratio != 0. && args.place_seed_stop_ratio < 1.) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be 0 or at least 1 (got %g)\n",
+                        args.place_seed_stop_ratio.argument_name().c_str(),
+                        args.place_seed_stop_ratio.value());
+    }
+
+    if (args.place_agent_batch_size < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 1 (got %d)\n",
+                        args.place_agent_batch_size.argument_name().c_str(),
+                        args.place_agent_batch_size.value());
+    }
+
+    if (args.anneal_convergence_threshold < 0.) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 0 (got %g)\n",
+                        args.anneal_convergence_threshold.argument_name().c_str(),
+                        args.anneal_convergence_threshold.value());
+    }
+
+    if (args.place_num_seeds > 1 && args.noc) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s and %s can not be used together\n",
+                        args.place_num_seeds.argument_name().c_str(),
+                        args.noc.argument_name().c_str());
+    }
+
+    if (args.place_parallel_regions > 1 && args.place_speculative_moves > 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s and %s can not be used together\n",
+                        args.place_parallel_regions.argument_name().c_str(),
+                        args.place_speculative_moves.argument_name().c_str());
+    }
+
+    if (args.place_eco_window < 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 0 (got %d)\n",
+                        args.place_eco_window.argument_name().c_str(),
+                        args.place_eco_window.value());
+    }
+
+    if (!args.place_eco_place_file.value().empty() && args.read_initial_place_file.provenance() == Provenance::SPECIFIED) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s and %s can not be used together\n",
+                        args.place_eco_place_file.argument_name().c_str(),
+                        args.read_initial_place_file.argument_name().c_str());
+    }
+
+    if (args.multi_queue_stickiness < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 1 (got %d)\n",
+                        args.multi_queue_stickiness.argument_name().c_str(),
+                        args.multi_queue_stickiness.value());
+    }
+
+    if (args.multi_queue_pop_batch_size < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 1 (got %d)\n",
+                        args.multi_queue_pop_batch_size.argument_name().c_str(),
+                        args.multi_queue_pop_batch_size.value());
+    }
+
+    if (args.chan_width_search_jobs < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 1 (got %d)\n",
+                        args.chan_width_search_jobs.argument_name().c_str(),
+                        args.chan_width_search_jobs.value());
+    }
+
+    if (args.route_checkpoint_interval < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 1 (got %d)\n",
+                        args.route_checkpoint_interval.argument_name().c_str(),
+                        args.route_checkpoint_interval.value());
+    }
+
+    if (args.router_lookahead_cache_entries < 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be at least 0 (got %d)\n",
+                        args.router_lookahead_cache_entries.argument_name().c_str(),
+                        args.router_lookahead_cache_entries.value());
+    }
+
+    if (args.resume_routing && args.route_checkpoint_file.value().empty()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s requires %s\n",
+                        args.resume_routing.argument_name().c_str(),
+                        args.route_checkpoint_file.argument_name().c_str());
+    }
+
     /**
      * @brief If the user provided the "--noc" command line option, then there
      * must be a NoC in the FPGA and the netlist must include NoC routers.
@@ -3678,5 +4455,21 @@ bool verify_args(const t_options& args) {
                         "--noc_flows_file option must be specified if --noc is turned on.\n");
     }
 
+    if (args.timing_corner_delay_scales.value().size() > tatum::Time::num_corners() - 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s specifies %zu additional timing corners, but VPR was built with support for at most %zu (see TATUM_TIME_VEC_WIDTH)\n",
+                        args.timing_corner_delay_scales.argument_name().c_str(),
+                        args.timing_corner_delay_scales.value().size(),
+                        tatum::Time::num_corners() - 1);
+    }
+    for (float scale : args.timing_corner_delay_scales.value()) {
+        if (!(scale > 0.)) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "%s must be positive (got %g)\n",
+                            args.timing_corner_delay_scales.argument_name().c_str(),
+                            scale);
+        }
+    }
+
     return true;
 }
@@ -16,11 +16,14 @@ struct t_options {
     argparse::ArgValue<std::string> FlatPlaceFile;
     argparse::ArgValue<std::string> PlaceFile;
     argparse::ArgValue<std::string> RouteFile;
+    argparse::ArgValue<std::string> write_place_file;
+    argparse::ArgValue<std::string> write_route_file;
     argparse::ArgValue<std::string> CircuitFile;
     argparse::ArgValue<std::string> ActFile;
     argparse::ArgValue<std::string> PowerFile;
     argparse::ArgValue<std::string> CmosTechFile;
     argparse::ArgValue<std::string> SDCFile;
+    argparse::ArgValue<bool> binary_net_file;
 
     argparse::ArgValue<e_arch_format> arch_format;
     argparse::ArgValue<e_circuit_format> circuit_format;
@@ -48,6 +51,8 @@ struct t_options {
     argparse::ArgValue<std::string> write_intra_cluster_router_lookahead;
     argparse::ArgValue<std::string> read_intra_cluster_router_lookahead;
 
+    argparse::ArgValue<std::string> setup_cache_dir;
+
     argparse::ArgValue<std::string> write_block_usage;
 
     /* Stage Options */
@@ -58,6 +63,8 @@ struct t_options {
     argparse::ArgValue<bool> do_routing;
     argparse::ArgValue<bool> do_analysis;
     argparse::ArgValue<bool> do_power;
+    argparse::ArgValue<bool> estimate_activity;
+    argparse::ArgValue<int> activity_estimation_cycles;
 
     /* Graphics Options */
     argparse::ArgValue<bool> show_graphics; ///<Enable argparse::ArgValue<int>eractive graphics?
@@ -72,7 +79,11 @@ struct t_options {
     argparse::ArgValue<size_t> num_workers;
     argparse::ArgValue<bool> timing_analysis;
     argparse::ArgValue<e_timing_update_type> timing_update_type;
+    argparse::ArgValue<std::vector<float>> timing_corner_delay_scales;
+    argparse::ArgValue<bool> timing_graph_opt_layout;
     argparse::ArgValue<bool> CreateEchoFile;
+    argparse::ArgValue<std::string> write_timing_graph_echo;
+    argparse::ArgValue<bool> anonymize_timing_graph_echo;
     argparse::ArgValue<bool> verify_file_digests;
     argparse::ArgValue<bool> verify_route_file_switch_id;
     argparse::ArgValue<std::string> device_layout;
@@ -86,11 +97,18 @@ struct t_options {
     argparse::ArgValue<std::string> suppress_warnings;
     argparse::ArgValue<bool> allow_dangling_combinational_nodes;
     argparse::ArgValue<bool> terminate_if_timing_fails;
+    argparse::ArgValue<std::string> profile_trace_file;
+    argparse::ArgValue<bool> report_memory_usage;
+    argparse::ArgValue<bool> huge_pages;
+    argparse::ArgValue<bool> numa_aware_threads;
 
     /* Server options */
     argparse::ArgValue<bool> is_server_mode_enabled;
     argparse::ArgValue<int> server_port_num;
 
+    /* Daemon options */
+    argparse::ArgValue<std::string> daemon_socket;
+
     /* Atom netlist options */
     argparse::ArgValue<bool> absorb_buffer_luts;
     argparse::ArgValue<e_const_gen_inference> const_gen_inference;
@@ -99,8 +117,10 @@ struct t_options {
     argparse::ArgValue<bool> sweep_dangling_blocks;
     argparse::ArgValue<bool> sweep_constant_primary_outputs;
     argparse::ArgValue<int> netlist_verbosity;
+    argparse::ArgValue<bool> mmap_blif_parser;
 
     /* Analytical Placement options */
+    argparse::ArgValue<e_ap_global_placer> ap_global_placer;
     argparse::ArgValue<e_ap_analytical_solver> ap_analytical_solver;
     argparse::ArgValue<e_ap_partial_legalizer> ap_partial_legalizer;
     argparse::ArgValue<e_ap_full_legalizer> ap_full_legalizer;
@@ -112,6 +132,8 @@ struct t_options {
     argparse::ArgValue<float> ap_timing_tradeoff;
     argparse::ArgValue<int> ap_high_fanout_threshold;
     argparse::ArgValue<bool> ap_generate_mass_report;
+    argparse::ArgValue<std::string> ap_write_partial_placement;
+    argparse::ArgValue<std::string> ap_read_partial_placement;
 
     /* Clustering options */
     argparse::ArgValue<bool> connection_driven_clustering;
@@ -126,6 +148,10 @@ struct t_options {
     argparse::ArgValue<bool> pack_prioritize_transitive_connectivity;
     argparse::ArgValue<int> pack_transitive_fanout_threshold;
     argparse::ArgValue<int> pack_feasible_block_array_size;
+    argparse::ArgValue<int> pack_num_partitions;
+    argparse::ArgValue<int> pack_speculative_candidates;
+    argparse::ArgValue<bool> pack_profile;
+    argparse::ArgValue<std::string> pack_eco_net_file;
     argparse::ArgValue<std::vector<std::string>> pack_high_fanout_threshold;
     argparse::ArgValue<int> pack_verbosity;
     /* Placement options */
@@ -143,7 +169,15 @@ struct t_options {
     argparse::ArgValue<e_pad_loc_type> pad_loc_type;
     argparse::ArgValue<int> PlaceChanWidth;
     argparse::ArgValue<float> place_rlim_escape_fraction;
+    argparse::ArgValue<int> place_speculative_moves;
+    argparse::ArgValue<int> place_parallel_regions;
+    argparse::ArgValue<int> place_num_seeds;
+    argparse::ArgValue<float> place_seed_stop_ratio;
+    argparse::ArgValue<float> anneal_convergence_threshold;
+    argparse::ArgValue<std::string> place_eco_place_file;
+    argparse::ArgValue<int> place_eco_window;
     argparse::ArgValue<std::string> place_move_stats_file;
+    argparse::ArgValue<std::string> place_move_profile_file;
     argparse::ArgValue<int> placement_saves_per_temperature;
     argparse::ArgValue<e_place_effort_scaling> place_effort_scaling;
     argparse::ArgValue<e_place_delta_delay_algorithm> place_delta_delay_matrix_calculation_method;
@@ -156,6 +190,7 @@ struct t_options {
     argparse::ArgValue<bool> place_checkpointing;
     argparse::ArgValue<float> place_agent_epsilon;
     argparse::ArgValue<float> place_agent_gamma;
+    argparse::ArgValue<int> place_agent_batch_size;
     argparse::ArgValue<float> place_dm_rlim;
     argparse::ArgValue<e_agent_space> place_agent_space;
     argparse::ArgValue<e_agent_algorithm> place_agent_algorithm;
@@ -181,11 +216,16 @@ struct t_options {
     argparse::ArgValue<double> noc_congestion_weighting;
     argparse::ArgValue<double> noc_centroid_weight;
     argparse::ArgValue<double> noc_swap_percentage;
+    argparse::ArgValue<int> noc_initial_placement_speculative_moves;
     argparse::ArgValue<int> noc_sat_routing_bandwidth_resolution;
     argparse::ArgValue<int> noc_sat_routing_latency_overrun_weighting_factor;
     argparse::ArgValue<int> noc_sat_routing_congestion_weighting_factor;
     argparse::ArgValue<int> noc_sat_routing_num_workers;
+    argparse::ArgValue<double> noc_sat_routing_time_limit;
     argparse::ArgValue<bool> noc_sat_routing_log_search_progress;
+    argparse::ArgValue<bool> noc_simulation;
+    argparse::ArgValue<int> noc_simulation_cycles;
+    argparse::ArgValue<double> noc_simulation_packet_size;
     argparse::ArgValue<std::string> noc_placement_file_name;
 
     /* Timing-driven placement options only */
@@ -203,10 +243,13 @@ struct t_options {
     argparse::ArgValue<std::string> post_place_timing_report_file;
     argparse::ArgValue<PlaceDelayModelType> place_delay_model;
     argparse::ArgValue<e_reducer> place_delay_model_reducer;
+    argparse::ArgValue<bool> place_delay_model_background;
     argparse::ArgValue<std::string> allowed_tiles_for_delay_model;
 
     /* Router Options */
     argparse::ArgValue<bool> check_rr_graph;
+    argparse::ArgValue<bool> check_rr_graph_trusted_digest;
+    argparse::ArgValue<bool> router_masked_chan_width_search;
     argparse::ArgValue<int> max_router_iterations;
     argparse::ArgValue<float> first_iter_pres_fac;
     argparse::ArgValue<float> initial_pres_fac;
@@ -220,6 +263,7 @@ struct t_options {
     argparse::ArgValue<int> RouteChanWidth;
     argparse::ArgValue<int> min_route_chan_width_hint; ///<Hint to binary search router about what the min chan width is
     argparse::ArgValue<bool> verify_binary_search;
+    argparse::ArgValue<int> chan_width_search_jobs;
     argparse::ArgValue<e_router_algorithm> RouterAlgorithm;
     argparse::ArgValue<int> min_incremental_reroute_fanout;
     argparse::ArgValue<bool> read_rr_edge_metadata;
@@ -230,6 +274,7 @@ struct t_options {
     argparse::ArgValue<e_rr_node_reorder_algorithm> reorder_rr_graph_nodes_algorithm;
     argparse::ArgValue<int> reorder_rr_graph_nodes_threshold;
     argparse::ArgValue<int> reorder_rr_graph_nodes_seed;
+    argparse::ArgValue<bool> compress_rr_graph_edges;
     argparse::ArgValue<bool> flat_routing;
     argparse::ArgValue<bool> router_opt_choke_points;
     argparse::ArgValue<int> route_verbosity;
@@ -244,6 +289,10 @@ struct t_options {
     argparse::ArgValue<int> multi_queue_num_threads;
     argparse::ArgValue<int> multi_queue_num_queues;
     argparse::ArgValue<bool> multi_queue_direct_draining;
+    argparse::ArgValue<int> multi_queue_stickiness;
+    argparse::ArgValue<int> multi_queue_pop_batch_size;
+    argparse::ArgValue<bool> router_partition_node_batching;
+    argparse::ArgValue<bool> router_deterministic_parallel;
     argparse::ArgValue<float> max_criticality;
     argparse::ArgValue<float> criticality_exp;
     argparse::ArgValue<float> router_init_wirelength_abort_threshold;
@@ -251,17 +300,33 @@ struct t_options {
     argparse::ArgValue<e_routing_failure_predictor> routing_failure_predictor;
     argparse::ArgValue<e_routing_budgets_algorithm> routing_budgets_algorithm;
     argparse::ArgValue<bool> save_routing_per_iteration;
+    argparse::ArgValue<std::string> route_checkpoint_file;
+    argparse::ArgValue<int> route_checkpoint_interval;
+    argparse::ArgValue<bool> resume_routing;
+    argparse::ArgValue<std::string> eco_route_file;
     argparse::ArgValue<float> congested_routing_iteration_threshold_frac;
     argparse::ArgValue<e_route_bb_update> route_bb_update;
     argparse::ArgValue<int> router_high_fanout_threshold;
     argparse::ArgValue<float> router_high_fanout_max_slope;
+    argparse::ArgValue<bool> router_high_fanout_skeleton;
+    argparse::ArgValue<std::string> router_net_profile_file;
     argparse::ArgValue<int> router_debug_net;
     argparse::ArgValue<int> router_debug_sink_rr;
     argparse::ArgValue<int> router_debug_iteration;
     argparse::ArgValue<e_router_lookahead> router_lookahead_type;
+    argparse::ArgValue<bool> router_lookahead_lazy;
+    argparse::ArgValue<bool> router_lookahead_quantized;
+    argparse::ArgValue<int> router_lookahead_cache_entries;
     argparse::ArgValue<bool> generate_router_lookahead_report;
     argparse::ArgValue<double> router_initial_acc_cost_chan_congestion_threshold;
     argparse::ArgValue<double> router_initial_acc_cost_chan_congestion_weight;
+    argparse::ArgValue<bool> router_global_route_prepass;
+    argparse::ArgValue<int> router_global_route_gcell_size;
+    argparse::ArgValue<bool> router_bidirectional_search;
+    argparse::ArgValue<int> router_bidirectional_search_min_distance;
+    argparse::ArgValue<float> router_bidirectional_search_max_criticality;
+    argparse::ArgValue<float> router_batch_max_criticality;
+    argparse::ArgValue<bool> router_clock_tree_routing;
     argparse::ArgValue<int> router_max_convergence_count;
     argparse::ArgValue<float> router_reconvergence_cpd_threshold;
     argparse::ArgValue<bool> router_update_lower_bound_delays;
@@ -277,6 +342,7 @@ struct t_options {
     argparse::ArgValue<int> timing_report_npaths;
     argparse::ArgValue<e_timing_report_detail> timing_report_detail;
     argparse::ArgValue<bool> timing_report_skew;
+    argparse::ArgValue<bool> timing_report_compress;
     argparse::ArgValue<std::string> echo_dot_timing_graph_node;
     argparse::ArgValue<e_post_synth_netlist_unconn_handling> post_synth_netlist_unconn_input_handling;
     argparse::ArgValue<e_post_synth_netlist_unconn_handling> post_synth_netlist_unconn_output_handling;
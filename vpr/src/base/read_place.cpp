@@ -5,16 +5,23 @@
 #include "vtr_util.h"
 #include "vtr_log.h"
 #include "vtr_digest.h"
+#include "vtr_async_file_writer.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
 
 #include "globals.h"
-#include "hash.h"
 #include "read_place.h"
 #include "read_xml_arch_file.h"
 #include "place_util.h"
 
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "place_route.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif
+
 static void read_place_header(std::ifstream& placement_file,
                               const char* net_file,
                               const char* place_file,
@@ -26,11 +33,26 @@ static std::string read_place_body(std::ifstream& placement_file,
                                    const char* place_file,
                                    bool is_place_file);
 
+static std::string read_binary_place(const char* net_file,
+                                     const char* place_file,
+                                     BlkLocRegistry& blk_loc_registry,
+                                     bool verify_file_digests,
+                                     const DeviceGrid& grid);
+
+static void write_binary_place(const char* net_file,
+                               const char* net_id,
+                               const char* place_file,
+                               const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs);
+
 std::string read_place(const char* net_file,
                        const char* place_file,
                        BlkLocRegistry& blk_loc_registry,
                        bool verify_file_digests,
                        const DeviceGrid& grid) {
+    if (vtr::check_file_name_extension(place_file, ".bin")) {
+        return read_binary_place(net_file, place_file, blk_loc_registry, verify_file_digests, grid);
+    }
+
     std::ifstream fstream(place_file);
     if (!fstream) {
         VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
@@ -72,6 +94,57 @@ void read_constraints(const char* constraints_file,
     VTR_LOG("\n");
 }
 
+std::unordered_map<std::string, t_pl_loc> read_place_block_locs(const char* place_file) {
+    std::ifstream placement_file(place_file);
+    if (!placement_file) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                        "'%s' - Cannot open place file.\n",
+                        place_file);
+    }
+
+    std::unordered_map<std::string, t_pl_loc> block_locs;
+
+    std::string line;
+    int lineno = 0;
+    while (std::getline(placement_file, line)) { //Parse line-by-line
+        ++lineno;
+
+        std::vector<std::string> tokens = vtr::StringToken(line).split(" \t\n");
+
+        if (tokens.empty()) {
+            continue; //Skip blank lines
+
+        } else if (tokens[0][0] == '#') {
+            continue; //Skip commented lines
+
+        } else if (tokens[0] == "Netlist_File:" || tokens[0] == "Array") {
+            continue; //Skip the header, the netlist and device may have changed
+
+        } else if ((tokens.size() == 4 || (tokens.size() > 4 && tokens[4][0] == '#'))
+                   || (tokens.size() == 5 || (tokens.size() > 5 && tokens[5][0] == '#'))) {
+            //Load the block location (the layer is only given for 3D architectures)
+            t_pl_loc loc;
+            loc.x = vtr::atoi(tokens[1]);
+            loc.y = vtr::atoi(tokens[2]);
+            loc.sub_tile = vtr::atoi(tokens[3]);
+            if (tokens.size() == 4 || (tokens.size() > 4 && tokens[4][0] == '#')) {
+                loc.layer = 0;
+            } else {
+                loc.layer = vtr::atoi(tokens[4]);
+            }
+            block_locs[tokens[0]] = loc;
+
+        } else {
+            //Unrecognized
+            vpr_throw(VPR_ERROR_PLACE_F, place_file, lineno,
+                      "Invalid line '%s' in file",
+                      line.c_str());
+        }
+    }
+
+    return block_locs;
+}
+
 /**
  * This function reads the header (first two lines) of a placement file.
  * The header consists of two lines that specify the netlist file and grid size that were used when generating placement.
@@ -359,13 +432,19 @@ std::string print_place(const char* net_file,
                         const char* net_id,
                         const char* place_file,
                         const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
-                        bool is_place_file) {
-    FILE* fp;
+                        bool is_place_file,
+                        bool write_sync) {
+    if (is_place_file && vtr::check_file_name_extension(place_file, ".bin")) {
+        write_binary_place(net_file, net_id, place_file, block_locs);
+        return vtr::secure_digest_file(place_file);
+    }
 
     auto& device_ctx = g_vpr_ctx.device();
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
-    fp = fopen(place_file, "w");
+    // The file is written in the background, from a snapshot in memory
+    vtr::MemoryOutputFile file;
+    FILE* fp = file.fp();
 
     if (is_place_file) {
         fprintf(fp, "Netlist_File: %s Netlist_ID: %s\n",
@@ -394,8 +473,153 @@ std::string print_place(const char* net_file,
             fprintf(fp, "\t#%zu\n", size_t(blk_id));
         }
     }
-    fclose(fp);
+    std::string contents = file.take_contents();
 
     //Calculate the ID of the placement
+    std::string placement_id = vtr::secure_digest_bytes(contents);
+    if (write_sync) {
+        if (!vtr::write_file(place_file, contents)) {
+            VTR_LOG_ERROR("Failed to write placement file '%s'\n", place_file);
+        }
+    } else {
+        vtr::write_file_async(place_file, std::move(contents));
+    }
+    return placement_id;
+}
+
+/**
+ * @brief Reads a binary placement file (see place_route.capnp), with the same checks as read_place_header()
+ *        and read_place_body() on a text placement file.
+ */
+static std::string read_binary_place(const char* net_file,
+                                     const char* place_file,
+                                     BlkLocRegistry& blk_loc_registry,
+                                     bool verify_file_digests,
+                                     const DeviceGrid& grid) {
+#ifdef VTR_ENABLE_CAPNPROTO
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& block_locs = blk_loc_registry.block_locs();
+
+    VTR_LOG("Reading binary placement %s.\n", place_file);
+    VTR_LOG("\n");
+
+    // MmapFile object creates an mmap of the specified path, and will munmap
+    // when the object leaves scope.
+    MmapFile f(place_file);
+    ::capnp::FlatArrayMessageReader reader(f.getData(), default_large_capnp_opts());
+    auto placement = reader.getRoot<VprPlacement>();
+
+    if (placement.getNetlistId().cStr() != cluster_ctx.clb_nlist.netlist_id()) {
+        auto msg = vtr::string_fmt(
+            "The packed netlist file that generated placement (File: '%s' ID: '%s')"
+            " does not match current netlist (File: '%s' ID: '%s')",
+            placement.getNetlistFile().cStr(), placement.getNetlistId().cStr(),
+            net_file ? net_file : "", cluster_ctx.clb_nlist.netlist_id().c_str());
+        if (verify_file_digests) {
+            msg += " To ignore the packed netlist mismatch, use '--verify_file_digests off' command line option.";
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE_F, "'%s' - %s\n", place_file, msg.c_str());
+        } else {
+            VTR_LOG_WARN("'%s' - %s\n", place_file, msg.c_str());
+            VTR_LOG_WARN("The packed netlist mismatch is ignored because"
+                         "--verify_file_digests command line option is off.\n");
+        }
+    }
+
+    if (grid.width() != placement.getGridWidth() || grid.height() != placement.getGridHeight()) {
+        auto msg = vtr::string_fmt(
+            "Current FPGA size (%zu x %zu) is different from size when placement generated (%u x %u)",
+            grid.width(), grid.height(), placement.getGridWidth(), placement.getGridHeight());
+        if (verify_file_digests) {
+            msg += " To ignore this size mismatch, use '--verify_file_digests off' command line option.";
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE_F, "'%s' - %s\n", place_file, msg.c_str());
+        } else {
+            VTR_LOG_WARN("'%s' - %s\n", place_file, msg.c_str());
+            VTR_LOG_WARN("The FPGA size mismatch is ignored because"
+                         "--verify_file_digests command line option is off.\n");
+        }
+    }
+
+    // The blocks are identified by their index, so all of them must be there
+    size_t num_blocks = cluster_ctx.clb_nlist.blocks().size();
+    auto xs = placement.getX();
+    auto ys = placement.getY();
+    auto sub_tiles = placement.getSubTile();
+    auto layers = placement.getLayer();
+    if (xs.size() != num_blocks || ys.size() != num_blocks || sub_tiles.size() != num_blocks || layers.size() != num_blocks) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                        "'%s' - The placement has %u blocks, but the netlist has %zu blocks.\n",
+                        place_file, xs.size(), num_blocks);
+    }
+
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        size_t iblk = size_t(blk_id);
+        t_pl_loc loc(xs[iblk], ys[iblk], sub_tiles[iblk], layers[iblk]);
+
+        if (block_locs[blk_id].is_fixed && loc != block_locs[blk_id].loc) {
+            const t_pl_loc& constraint_loc = block_locs[blk_id].loc;
+            VPR_THROW(VPR_ERROR_PLACE,
+                      "The new location assigned to cluster #%d is (%d,%d,%d,%d), which is inconsistent with the location specified in the constraint file (%d,%d,%d,%d).",
+                      blk_id, loc.x, loc.y, loc.layer, loc.sub_tile, constraint_loc.x, constraint_loc.y, constraint_loc.layer, constraint_loc.sub_tile);
+        }
+        blk_loc_registry.set_block_location(blk_id, loc);
+    }
+
+    VTR_LOG("Successfully read %s.\n", place_file);
+    VTR_LOG("\n");
+
     return vtr::secure_digest_file(place_file);
+#else
+    (void)net_file;
+    (void)blk_loc_registry;
+    (void)verify_file_digests;
+    (void)grid;
+    VPR_THROW(VPR_ERROR_PLACE_F,
+              "Reading binary placement file '%s' is disabled because VTR_ENABLE_CAPNPROTO=OFF. "
+              "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable.",
+              place_file);
+#endif
+}
+
+/**
+ * @brief Writes a binary placement file (see place_route.capnp).
+ */
+static void write_binary_place(const char* net_file,
+                               const char* net_id,
+                               const char* place_file,
+                               const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs) {
+#ifdef VTR_ENABLE_CAPNPROTO
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    ::capnp::MallocMessageBuilder builder;
+    auto placement = builder.initRoot<VprPlacement>();
+
+    placement.setNetlistFile(net_file ? net_file : "");
+    placement.setNetlistId(net_id ? net_id : "");
+    placement.setGridWidth(device_ctx.grid.width());
+    placement.setGridHeight(device_ctx.grid.height());
+
+    size_t num_blocks = block_locs.empty() ? 0 : cluster_ctx.clb_nlist.blocks().size();
+    auto xs = placement.initX(num_blocks);
+    auto ys = placement.initY(num_blocks);
+    auto sub_tiles = placement.initSubTile(num_blocks);
+    auto layers = placement.initLayer(num_blocks);
+    for (size_t iblk = 0; iblk < num_blocks; iblk++) {
+        const t_pl_loc& loc = block_locs[ClusterBlockId(iblk)].loc;
+        xs.set(iblk, loc.x);
+        ys.set(iblk, loc.y);
+        sub_tiles.set(iblk, loc.sub_tile);
+        layers.set(iblk, loc.layer);
+    }
+
+    writeMessageToFile(place_file, &builder);
+#else
+    (void)net_file;
+    (void)net_id;
+    (void)block_locs;
+    VPR_THROW(VPR_ERROR_PLACE_F,
+              "Writing binary placement file '%s' is disabled because VTR_ENABLE_CAPNPROTO=OFF. "
+              "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable.",
+              place_file);
+#endif
 }
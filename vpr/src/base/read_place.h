@@ -1,8 +1,10 @@
 #pragma once
 
 #include "vtr_vector_map.h"
+#include "vpr_types.h"
 
 #include <string>
+#include <unordered_map>
 
 class PlacerState;
 class BlkLocRegistry;
@@ -27,6 +29,13 @@ std::string read_place(const char* net_file,
 void read_constraints(const char* constraints_file,
                       BlkLocRegistry& blk_loc_registry);
 
+/**
+ * This function reads the block locations of a place file by block name, without applying them
+ * and without requiring the blocks to match the current netlist (e.g. the placement of a previous
+ * version of the netlist, see --eco_place_file).
+ */
+std::unordered_map<std::string, t_pl_loc> read_place_block_locs(const char* place_file);
+
 /**
  * This function prints out a place file.
  * @param is_place_file: defaults to true. If false, does not print file header; this is useful if
@@ -36,9 +45,14 @@ void read_constraints(const char* constraints_file,
  *                       placement coordinates (e.g. orphan clusters created during legalization
  *                       will not be included; this file is used as a placement constraints
  *                       file when running placement in order to place orphan clusters.
+ * @param write_sync: if true, writes the file before returning instead of queuing it on the
+ *                    background file writer (for a file that must exist even if VPR exits
+ *                    right after, e.g. a checkpoint written by the signal handler). A failure
+ *                    to write it is then logged rather than thrown.
  */
 std::string print_place(const char* net_file,
                         const char* net_id,
                         const char* place_file,
                         const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
-                        bool is_place_file = true);
+                        bool is_place_file = true,
+                        bool write_sync = false);
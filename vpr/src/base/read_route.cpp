@@ -11,6 +11,10 @@
  * in (x,y) format. Appropriate error messages are displayed when
  * formats are incorrect or when the routing file does not match
  * other file's information
+ *
+ * A routing file whose name ends with '.bin' is instead a binary routing
+ * file (see place_route.capnp), which records the traceback of each routed
+ * net with delta encoded RR node ids.
  */
 
 #include <fstream>
@@ -18,10 +22,12 @@
 #include <sstream>
 #include <string>
 #include <stack>
+#include <unordered_map>
 
 #include "physical_types_util.h"
 #include "vtr_assert.h"
 #include "vtr_digest.h"
+#include "vtr_async_file_writer.h"
 #include "vtr_util.h"
 #include "vtr_log.h"
 #include "check_route.h"
@@ -36,9 +42,17 @@
 #include "route_tree.h"
 #include "read_route.h"
 #include "d_ary_heap.h"
+#include "setup_cache.h"
 
 #include "old_traceback.h"
 
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "place_route.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif
+
 /*************Functions local to this module*************/
 
 /**
@@ -126,10 +140,62 @@ static std::string format_name(std::string name);
 static bool check_rr_graph_connectivity(RRNodeId prev_node,
                                         RRNodeId node);
 
+/**
+ * @brief Set up the routing state (locally used opins, occupancy and costs) from the loaded
+ *        routing trees, and check the routing.
+ *
+ * @return Whether the loaded routing is feasible.
+ */
+static bool finish_read_route(const Netlist<>& router_net_list,
+                              const t_router_opts& router_opts);
+
 void print_route(const Netlist<>& net_list,
                  FILE* fp,
                  bool is_flat);
 
+/**
+ * @brief Read a binary routing file, with the same checks as the header of a text routing file,
+ *        and create the routing tree for each net.
+ *
+ * @param net_list The netlist to process.
+ * @param route_file The name of the file to read from.
+ * @param router_opts The router options, used to allocate the routing structures.
+ * @param verify_file_digests Whether to give an error (rather than a warning) if the routing does not match the current placement and RR graph.
+ */
+static void read_binary_route(const Netlist<>& net_list,
+                              const char* route_file,
+                              const t_router_opts& router_opts,
+                              bool verify_file_digests);
+
+/**
+ * @brief Write the routing of each net to a binary routing file.
+ */
+static void write_binary_route(const Netlist<>& net_list,
+                               const char* placement_file,
+                               const char* route_file,
+                               bool is_flat);
+
+/**
+ * @brief Check a node line of a previous routing file against the current RR graph.
+ *
+ * @return The RR node of the line, or an invalid ID if it does not exist (with the same type,
+ *         coordinates and ptc) anymore.
+ */
+static RRNodeId match_eco_route_node(const std::vector<std::string>& tokens,
+                                     const char* filename,
+                                     int lineno);
+
+/**
+ * @brief Build the route tree of net_id from the part of its previous routing (the RR nodes of
+ *        its traceback) which still reaches its current sinks.
+ *
+ * @param is_partial Set if some sinks of the net are not reached by the kept routing.
+ * @return The route tree, or nothing if no part of the previous routing can be kept.
+ */
+static vtr::optional<RouteTree> build_eco_route_tree(ParentNetId net_id,
+                                                     const std::vector<RRNodeId>& trace,
+                                                     bool& is_partial);
+
 /*************Global Functions****************************/
 
 /**
@@ -148,6 +214,12 @@ bool read_route(const char* route_file,
     /* Begin parsing the file */
     VTR_LOG("Begin loading FPGA routing file.\n");
 
+    if (vtr::check_file_name_extension(route_file, ".bin")) {
+        const Netlist<>& router_net_list = (flat_router) ? (const Netlist<>&)g_vpr_ctx.atom().netlist() : (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
+        read_binary_route(router_net_list, route_file, router_opts, verify_file_digests);
+        return finish_read_route(router_net_list, router_opts);
+    }
+
     std::string header_str;
 
     std::ifstream fp;
@@ -200,6 +272,14 @@ bool read_route(const char* route_file,
 
     fp.close();
 
+    return finish_read_route(router_net_list, router_opts);
+}
+
+static bool finish_read_route(const Netlist<>& router_net_list,
+                              const t_router_opts& router_opts) {
+    auto& device_ctx = g_vpr_ctx.device();
+    bool flat_router = router_opts.flat_routing;
+
     /*Correctly set up the clb opins*/
     FourAryHeap small_heap;
     small_heap.init_heap(device_ctx.grid);
@@ -228,6 +308,278 @@ bool read_route(const char* route_file,
     return is_feasible;
 }
 
+size_t read_eco_route(const char* route_file,
+                      const Netlist<>& net_list,
+                      bool is_flat) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    if (vtr::check_file_name_extension(route_file, ".bin")) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "Incremental routing needs a text routing file ('%s' is a binary one)\n", route_file);
+    }
+
+    std::ifstream fp(route_file);
+    int lineno = 0;
+    if (!fp.is_open()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, lineno,
+                  "Cannot open %s routing file", route_file);
+    }
+
+    size_t num_kept = 0;
+    size_t num_partial = 0;
+    size_t num_dropped = 0;
+
+    // The net being read, invalid if its previous routing can not be kept
+    ParentNetId net_id = ParentNetId::INVALID();
+    std::vector<RRNodeId> trace;
+    auto finish_net = [&]() {
+        if (!net_id) {
+            return;
+        }
+        bool is_partial = false;
+        vtr::optional<RouteTree> tree = build_eco_route_tree(net_id, trace, is_partial);
+        if (!tree) {
+            num_dropped++;
+        } else {
+            // The kept routing may go beyond the bounding box of the net's new placement
+            t_bb& bb = route_ctx.route_bb[net_id];
+            for (const RouteTreeNode& rt_node : tree->all_nodes()) {
+                bb.xmin = std::min<int>(bb.xmin, device_ctx.rr_graph.node_xlow(rt_node.inode));
+                bb.xmax = std::max<int>(bb.xmax, device_ctx.rr_graph.node_xhigh(rt_node.inode));
+                bb.ymin = std::min<int>(bb.ymin, device_ctx.rr_graph.node_ylow(rt_node.inode));
+                bb.ymax = std::max<int>(bb.ymax, device_ctx.rr_graph.node_yhigh(rt_node.inode));
+                bb.layer_min = std::min<int>(bb.layer_min, device_ctx.rr_graph.node_layer_low(rt_node.inode));
+                bb.layer_max = std::max<int>(bb.layer_max, device_ctx.rr_graph.node_layer_high(rt_node.inode));
+            }
+            route_ctx.route_trees[net_id] = std::move(tree);
+            (is_partial ? num_partial : num_kept)++;
+        }
+        net_id = ParentNetId::INVALID();
+        trace.clear();
+    };
+
+    std::string input;
+    while (std::getline(fp, input)) {
+        ++lineno;
+        std::vector<std::string> tokens = vtr::StringToken(input).split(" \t\n");
+        if (tokens.empty() || tokens[0][0] == '#') {
+            continue;
+        } else if (tokens[0] == "Array" && tokens.size() > 4 && tokens[1] == "size:"
+                   && (vtr::atou(tokens[2].c_str()) != device_ctx.grid.width() || vtr::atou(tokens[4].c_str()) != device_ctx.grid.height())) {
+            VTR_LOG_WARN("Device dimensions %sx%s of the previous routing '%s' do not match the current %zux%zu: routing from scratch\n",
+                         tokens[2].c_str(), tokens[4].c_str(), route_file, device_ctx.grid.width(), device_ctx.grid.height());
+            return 0;
+        } else if (tokens[0] == "Net" && tokens.size() > 2) {
+            finish_net();
+            // Global nets (which have a trailing "global net connecting:") are not routed
+            if (tokens.size() == 3) {
+                ParentNetId new_net_id = net_list.find_net(format_name(tokens[2]));
+                if (new_net_id && !net_list.net_is_ignored(new_net_id) && !net_list.net_sinks(new_net_id).empty()) {
+                    net_id = new_net_id;
+                }
+            }
+        } else if (tokens[0] == "Node:" && net_id) {
+            RRNodeId inode = match_eco_route_node(tokens, route_file, lineno);
+            if (inode) {
+                trace.push_back(inode);
+            } else {
+                // The RR graph changed under the net: route it from scratch
+                num_dropped++;
+                net_id = ParentNetId::INVALID();
+                trace.clear();
+            }
+        }
+    }
+    finish_net();
+
+    // The occupancies follow from the kept routing
+    recompute_occupancy_from_scratch(net_list, is_flat);
+
+    VTR_LOG("Incremental routing from '%s': kept the routing of %zu nets, part of the routing of %zu nets (%zu nets to route from scratch)\n",
+            route_file, num_kept, num_partial, net_list.nets().size() - num_kept - num_partial);
+    VTR_LOGV(num_dropped > 0, "%zu nets of the previous routing changed too much to be kept\n", num_dropped);
+    return num_kept + num_partial;
+}
+
+static RRNodeId match_eco_route_node(const std::vector<std::string>& tokens,
+                                     const char* filename,
+                                     int lineno) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    if (tokens.size() < 6) {
+        return RRNodeId::INVALID();
+    }
+    int node = atoi(tokens[1].c_str());
+    if (node < 0 || size_t(node) >= rr_graph.num_nodes()) {
+        return RRNodeId::INVALID();
+    }
+    RRNodeId inode(node);
+    if (tokens[2] != rr_graph.node_type_string(inode)) {
+        return RRNodeId::INVALID();
+    }
+
+    int layer_num, x, y;
+    format_coordinates(layer_num, x, y, tokens[3], ClusterNetId::INVALID(), filename, lineno);
+    int layer_num2 = layer_num, x2 = x, y2 = y;
+    int offset = 0;
+    if (tokens[4] == "to") {
+        if (tokens.size() < 8) {
+            return RRNodeId::INVALID();
+        }
+        format_coordinates(layer_num2, x2, y2, tokens[5], ClusterNetId::INVALID(), filename, lineno);
+        offset = 2;
+    }
+    if (rr_graph.node_xlow(inode) != x || rr_graph.node_ylow(inode) != y || rr_graph.node_layer_low(inode) != layer_num
+        || rr_graph.node_xhigh(inode) != x2 || rr_graph.node_yhigh(inode) != y2 || rr_graph.node_layer_high(inode) != layer_num2) {
+        return RRNodeId::INVALID();
+    }
+
+    if (rr_graph.node_ptc_num(inode) != atoi(tokens[5 + offset].c_str())) {
+        return RRNodeId::INVALID();
+    }
+    return inode;
+}
+
+static vtr::optional<RouteTree> build_eco_route_tree(ParentNetId net_id,
+                                                     const std::vector<RRNodeId>& trace,
+                                                     bool& is_partial) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& terminals = g_vpr_ctx.routing().net_rr_terminals[net_id];
+
+    // The routing has to start at the (unmoved) driver of the net
+    if (trace.empty() || trace[0] != terminals[0]) {
+        return vtr::nullopt;
+    }
+
+    // Rebuild the tree of the traceback. Each branch ends at a SINK and the next one starts at a node
+    // already in the tree; a node comes after its parent, so children have larger indices.
+    struct t_eco_node {
+        RRNodeId inode;
+        int parent;
+        RRSwitchId parent_switch;
+        int net_pin_index;
+        bool kept;
+    };
+    std::vector<t_eco_node> nodes = {{trace[0], -1, RRSwitchId::INVALID(), UNDEFINED, true}};
+    std::unordered_map<RRNodeId, int> node_index = {{trace[0], 0}};
+    int parent = 0;
+    bool after_sink = false;
+    for (size_t i = 1; i < trace.size(); i++) {
+        RRNodeId inode = trace[i];
+        if (after_sink) {
+            auto it = node_index.find(inode);
+            if (it == node_index.end()) {
+                return vtr::nullopt;
+            }
+            parent = it->second;
+            after_sink = false;
+            continue;
+        }
+
+        // The switch comes from the current RR graph, which may have changed since
+        RRNodeId parent_inode = nodes[parent].inode;
+        RRSwitchId parent_switch = RRSwitchId::INVALID();
+        for (t_edge_size iedge = 0; iedge < rr_graph.num_edges(parent_inode); ++iedge) {
+            if (rr_graph.edge_sink_node(parent_inode, iedge) == inode) {
+                parent_switch = RRSwitchId(rr_graph.edge_switch(parent_inode, iedge));
+                break;
+            }
+        }
+        bool is_sink = rr_graph.node_type(inode) == e_rr_type::SINK;
+        if (!parent_switch || (!is_sink && node_index.count(inode))) {
+            return vtr::nullopt;
+        }
+
+        nodes.push_back({inode, parent, parent_switch, UNDEFINED, false});
+        node_index[inode] = nodes.size() - 1;
+        if (is_sink) {
+            after_sink = true;
+        } else {
+            parent = nodes.size() - 1;
+        }
+    }
+    if (trace.size() > 1 && !after_sink) {
+        return vtr::nullopt;
+    }
+
+    // Give the SINKs the pins of the net they reach now (several pins may share a SINK)
+    std::unordered_map<RRNodeId, std::vector<int>> sink_pins;
+    for (int ipin = terminals.size() - 1; ipin > 0; ipin--) {
+        sink_pins[terminals[ipin]].push_back(ipin);
+    }
+    size_t num_reached = 0;
+    for (t_eco_node& node : nodes) {
+        if (rr_graph.node_type(node.inode) != e_rr_type::SINK) {
+            continue;
+        }
+        auto it = sink_pins.find(node.inode);
+        if (it != sink_pins.end() && !it->second.empty()) {
+            node.net_pin_index = it->second.back();
+            it->second.pop_back();
+            node.kept = true;
+            num_reached++;
+        }
+    }
+    if (num_reached == 0) {
+        return vtr::nullopt;
+    }
+    is_partial = num_reached < terminals.size() - 1;
+
+    // Keep the branches leading to the reached SINKs
+    for (size_t i = nodes.size() - 1; i > 0; i--) {
+        if (nodes[i].kept) {
+            nodes[nodes[i].parent].kept = true;
+        }
+    }
+    std::vector<std::vector<int>> children(nodes.size());
+    for (size_t i = 1; i < nodes.size(); i++) {
+        if (nodes[i].kept) {
+            children[nodes[i].parent].push_back(i);
+        } else if (nodes[nodes[i].parent].kept && !rr_graph.rr_switch_inf(nodes[i].parent_switch).configurable()) {
+            // A non-configurable connection can not be cut
+            return vtr::nullopt;
+        }
+    }
+
+    // Back to a traceback of the kept branches, in the same order
+    t_trace* head = nullptr;
+    t_trace* tail = nullptr;
+    auto append = [&](int i, RRSwitchId iswitch) {
+        t_trace* tptr = alloc_trace_data();
+        tptr->index = size_t(nodes[i].inode);
+        tptr->net_pin_index = nodes[i].net_pin_index;
+        tptr->iswitch = iswitch ? int(size_t(iswitch)) : UNDEFINED;
+        tptr->next = nullptr;
+        if (tail) {
+            tail->next = tptr;
+        } else {
+            head = tptr;
+        }
+        tail = tptr;
+    };
+    std::stack<std::pair<int, size_t>> stack; // (node, next child)
+    stack.push({0, 0});
+    while (!stack.empty()) {
+        auto& [i, ichild] = stack.top();
+        if (children[i].empty()) {
+            append(i, RRSwitchId::INVALID());
+            stack.pop();
+        } else if (ichild < children[i].size()) {
+            int child = children[i][ichild++];
+            append(i, nodes[child].parent_switch);
+            stack.push({child, 0});
+        } else {
+            stack.pop();
+        }
+    }
+
+    vtr::optional<RouteTree> tree = TracebackCompat::traceback_to_route_tree(head, net_id);
+    free_traceback(head);
+    return tree;
+}
+
 static void process_route(const Netlist<>& net_list,
                           std::ifstream& fp,
                           const char* filename,
@@ -801,14 +1153,24 @@ void print_route(const Netlist<>& net_list,
 void print_route(const Netlist<>& net_list,
                  const char* placement_file,
                  const char* route_file,
-                 bool is_flat) {
-    FILE* fp;
+                 bool is_flat,
+                 bool write_sync) {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    if (vtr::check_file_name_extension(route_file, ".bin")) {
+        write_binary_route(net_list, placement_file, route_file, is_flat);
+
+        //Save the digest of the route file
+        route_ctx.routing_id = vtr::secure_digest_file(route_file);
+        return;
+    }
 
-    fp = fopen(route_file, "w");
+    // The file is written in the background, from a snapshot in memory
+    vtr::MemoryOutputFile file;
+    FILE* fp = file.fp();
 
     auto& place_ctx = g_vpr_ctx.placement();
     auto& device_ctx = g_vpr_ctx.device();
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
 
     fprintf(fp, "Placement_File: %s Placement_ID: %s\n", placement_file, place_ctx.placement_id.c_str());
 
@@ -817,8 +1179,270 @@ void print_route(const Netlist<>& net_list,
 
     print_route(net_list, fp, is_flat);
 
-    fclose(fp);
+    std::string contents = file.take_contents();
 
     //Save the digest of the route file
-    route_ctx.routing_id = vtr::secure_digest_file(route_file);
+    route_ctx.routing_id = vtr::secure_digest_bytes(contents);
+    if (write_sync) {
+        if (!vtr::write_file(route_file, contents)) {
+            VTR_LOG_ERROR("Failed to write routing file '%s'\n", route_file);
+        }
+    } else {
+        vtr::write_file_async(route_file, std::move(contents));
+    }
+}
+
+#ifdef VTR_ENABLE_CAPNPROTO
+///@brief Append value to bytes as an LEB128 varint
+static void append_varint(std::vector<uint8_t>& bytes, uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    bytes.push_back(uint8_t(value));
+}
+
+///@brief Read an LEB128 varint from [it, end), returns false if it is truncated
+static bool read_varint(const uint8_t*& it, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; it != end && shift < 64; shift += 7) {
+        uint8_t byte = *it++;
+        value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint64_t zigzag_encode(int64_t value) {
+    return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+static int64_t zigzag_decode(uint64_t value) {
+    return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
+#endif
+
+static void read_binary_route(const Netlist<>& net_list,
+                              const char* route_file,
+                              const t_router_opts& router_opts,
+                              bool verify_file_digests) {
+#ifdef VTR_ENABLE_CAPNPROTO
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+    const auto& place_ctx = g_vpr_ctx.placement();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    bool flat_router = router_opts.flat_routing;
+
+    // MmapFile object creates an mmap of the specified path, and will munmap
+    // when the object leaves scope.
+    MmapFile f(route_file);
+    ::capnp::FlatArrayMessageReader reader(f.getData(), default_large_capnp_opts());
+    auto routing = reader.getRoot<VprRouting>();
+
+    if (routing.getPlacementId().cStr() != place_ctx.placement_id) {
+        auto msg = vtr::string_fmt(
+            "Placement file %s specified in the routing file"
+            " does not match the loaded placement (ID %s != %s)",
+            routing.getPlacementFile().cStr(), routing.getPlacementId().cStr(), place_ctx.placement_id.c_str());
+        if (verify_file_digests) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "'%s' - %s\n", route_file, msg.c_str());
+        } else {
+            VTR_LOG_WARN("'%s' - %s\n", route_file, msg.c_str());
+        }
+    }
+
+    if (routing.getGridWidth() != device_ctx.grid.width() || routing.getGridHeight() != device_ctx.grid.height()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "'%s' - Device dimensions %ux%u specified in the routing file does not match given %zux%zu\n",
+                        route_file, routing.getGridWidth(), routing.getGridHeight(), device_ctx.grid.width(), device_ctx.grid.height());
+    }
+
+    if (routing.getIsFlat() != flat_router || routing.getNumNets() != net_list.nets().size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "'%s' - The routing (of %u nets, %s flat routing) does not match the netlist (of %zu nets, %s flat routing)\n",
+                        route_file, routing.getNumNets(), routing.getIsFlat() ? "with" : "without",
+                        net_list.nets().size(), flat_router ? "with" : "without");
+    }
+
+    //The RR node ids are only meaningful for the RR graph the routing was generated with
+    if (routing.getRrGraphDigest().cStr() != get_rr_graph_digest()) {
+        std::string msg = "The RR graph used to generate the routing does not match the current RR graph.";
+        if (verify_file_digests) {
+            msg += " To ignore the RR graph mismatch, use '--verify_file_digests off' command line option.";
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "'%s' - %s\n", route_file, msg.c_str());
+        } else {
+            VTR_LOG_WARN("'%s' - %s\n", route_file, msg.c_str());
+        }
+    }
+
+    /*Allocate necessary routing structures*/
+    alloc_and_load_rr_node_route_structs(router_opts);
+    init_route_structs(net_list,
+                       router_opts.bb_factor,
+                       router_opts.has_choke_point,
+                       flat_router);
+
+    for (auto routed_net : routing.getNets()) {
+        ParentNetId net_id(routed_net.getNet());
+        if (size_t(net_id) >= net_list.nets().size()) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "'%s' - Invalid net %zu in routing file\n", route_file, size_t(net_id));
+        }
+
+        if (net_list.net_name(net_id) != routed_net.getName().cStr()) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "'%s' - Net name %s for net number %zu specified in the routing file does not match given %s\n",
+                            route_file, routed_net.getName().cStr(), size_t(net_id), net_list.net_name(net_id).c_str());
+        }
+
+        if (net_list.net_is_ignored(net_id)) {
+            VTR_LOG_WARN("Net %zu (%s) is marked as global in the netlist, but is non-global in the .route file\n", size_t(net_id), net_list.net_name(net_id).c_str());
+        }
+
+        auto nodes = routed_net.getNodes();
+        const uint8_t* it = nodes.begin();
+        const uint8_t* end = nodes.end();
+
+        t_trace* head = nullptr;
+        t_trace* tail = nullptr;
+        auto throw_invalid_routing = [&](const char* reason) {
+            free_traceback(head);
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "'%s' - Invalid routing of net %zu (%s): %s\n",
+                            route_file, size_t(net_id), net_list.net_name(net_id).c_str(), reason);
+        };
+
+        int64_t inode = 0;
+        RRNodeId prev_node(-1);
+        for (uint32_t ielement = 0; ielement < routed_net.getNumNodes(); ielement++) {
+            uint64_t node_delta, switch_id, net_pin_index = 0;
+            if (!read_varint(it, end, node_delta) || !read_varint(it, end, switch_id)) {
+                throw_invalid_routing("truncated traceback");
+            }
+
+            inode += zigzag_decode(node_delta);
+            if (inode < 0 || size_t(inode) >= rr_graph.num_nodes()) {
+                throw_invalid_routing("RR node out of range");
+            }
+            RRNodeId rr_node(inode);
+
+            /*First node needs to be source. It is isolated to correctly set heap head.*/
+            if (ielement == 0 && rr_graph.node_type(rr_node) != e_rr_type::SOURCE) {
+                throw_invalid_routing("first node in routing has to be a source type");
+            }
+
+            /* Check for connectivity, this catches dangling nets before the traceback is validated */
+            if (!check_rr_graph_connectivity(prev_node, rr_node)) {
+                throw_invalid_routing("dangling branch");
+            }
+            prev_node = rr_node;
+
+            if (rr_graph.node_type(rr_node) == e_rr_type::SINK && !read_varint(it, end, net_pin_index)) {
+                throw_invalid_routing("truncated traceback");
+            }
+
+            t_trace* tptr = alloc_trace_data();
+            tptr->index = int(inode);
+            tptr->iswitch = short(int64_t(switch_id) - 1);
+            tptr->net_pin_index = (rr_graph.node_type(rr_node) == e_rr_type::SINK) ? int(net_pin_index) : UNDEFINED;
+            tptr->next = nullptr;
+            if (tail) {
+                tail->next = tptr;
+            } else {
+                head = tptr;
+            }
+            tail = tptr;
+        }
+
+        if (it != end) {
+            throw_invalid_routing("unexpected data after the traceback");
+        }
+
+        if (head && !validate_and_update_traceback(head, router_opts.verify_route_file_switch_id)) {
+            throw_invalid_routing("invalid traceback");
+        }
+
+        /* Convert to route_tree after reading */
+        route_ctx.route_trees[net_id] = TracebackCompat::traceback_to_route_tree(head);
+        free_traceback(head);
+    }
+#else
+    (void)net_list;
+    (void)router_opts;
+    (void)verify_file_digests;
+    VPR_THROW(VPR_ERROR_ROUTE,
+              "Reading binary routing file '%s' is disabled because VTR_ENABLE_CAPNPROTO=OFF. "
+              "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable.",
+              route_file);
+#endif
+}
+
+static void write_binary_route(const Netlist<>& net_list,
+                               const char* placement_file,
+                               const char* route_file,
+                               bool is_flat) {
+#ifdef VTR_ENABLE_CAPNPROTO
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+    const auto& place_ctx = g_vpr_ctx.placement();
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    ::capnp::MallocMessageBuilder builder;
+    auto routing = builder.initRoot<VprRouting>();
+
+    routing.setPlacementFile(placement_file ? placement_file : "");
+    routing.setPlacementId(place_ctx.placement_id);
+    routing.setGridWidth(device_ctx.grid.width());
+    routing.setGridHeight(device_ctx.grid.height());
+    routing.setRrGraphDigest(get_rr_graph_digest());
+    routing.setIsFlat(is_flat);
+    routing.setNumNets(net_list.nets().size());
+
+    //Only the nets print_route() records the nodes of
+    std::vector<ParentNetId> routed_nets;
+    if (!route_ctx.route_trees.empty()) {
+        for (ParentNetId net_id : net_list.nets()) {
+            if (!net_list.net_is_ignored(net_id) && !net_list.net_sinks(net_id).empty() && route_ctx.route_trees[net_id]) {
+                routed_nets.push_back(net_id);
+            }
+        }
+    }
+
+    auto nets = routing.initNets(routed_nets.size());
+    std::vector<uint8_t> bytes;
+    for (size_t inet = 0; inet < routed_nets.size(); inet++) {
+        ParentNetId net_id = routed_nets[inet];
+        auto routed_net = nets[inet];
+        routed_net.setNet(size_t(net_id));
+        routed_net.setName(net_list.net_name(net_id));
+
+        bytes.clear();
+        uint32_t num_nodes = 0;
+        int64_t prev_inode = 0;
+        t_trace* head = TracebackCompat::traceback_from_route_tree(route_ctx.route_trees[net_id].value());
+        for (t_trace* tptr = head; tptr != nullptr; tptr = tptr->next) {
+            append_varint(bytes, zigzag_encode(int64_t(tptr->index) - prev_inode));
+            append_varint(bytes, uint64_t(int64_t(tptr->iswitch) + 1));
+            if (rr_graph.node_type(RRNodeId(tptr->index)) == e_rr_type::SINK) {
+                append_varint(bytes, uint64_t(tptr->net_pin_index));
+            }
+            prev_inode = tptr->index;
+            num_nodes++;
+        }
+        free_traceback(head);
+
+        routed_net.setNumNodes(num_nodes);
+        routed_net.setNodes(kj::arrayPtr(bytes.data(), bytes.size()));
+    }
+
+    writeMessageToFile(route_file, &builder);
+#else
+    (void)net_list;
+    (void)placement_file;
+    (void)is_flat;
+    VPR_THROW(VPR_ERROR_ROUTE,
+              "Writing binary routing file '%s' is disabled because VTR_ENABLE_CAPNPROTO=OFF. "
+              "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable.",
+              route_file);
+#endif
 }
@@ -14,7 +14,30 @@ bool read_route(const char* route_file,
                 bool verify_file_digests,
                 bool is_flat);
 
+/**
+ * @brief Seeds the routing with the routing of the nets in a previous .route file, e.g. of a previous
+ *        version of the circuit (see --eco_route_file), for an incremental routing.
+ *
+ * The nets are matched by name. A net keeps the branches of its previous routing to the sinks which
+ * are still at the same RR nodes, if its driver did not move and the RR nodes and edges of its routing
+ * are still in the RR graph. The other nets (and sinks) are left unrouted. The occupancy of the RR
+ * nodes is updated with the kept routing.
+ *
+ * @return The number of nets which kept (part of) their routing.
+ */
+size_t read_eco_route(const char* route_file,
+                      const Netlist<>& net_list,
+                      bool is_flat);
+
+/**
+ * @brief Prints the routing to route_file (in the binary format if it ends with .bin).
+ *
+ * The text file is queued on the background file writer, unless write_sync is set: then it is
+ * written before returning (for a file that must exist even if VPR exits right after, e.g. a
+ * checkpoint written by the signal handler), and a failure to write it is logged rather than thrown.
+ */
 void print_route(const Netlist<>& net_list,
                  const char* placement_file,
                  const char* route_file,
-                 bool is_flat);
+                 bool is_flat,
+                 bool write_sync = false);
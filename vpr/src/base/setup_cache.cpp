@@ -0,0 +1,236 @@
+#include "setup_cache.h"
+
+#include <chrono>
+#include <type_traits>
+#include <filesystem>
+#include <random>
+#include <system_error>
+#include <vector>
+
+#include "globals.h"
+#include "picosha2.h"
+#include "vpr_error.h"
+#include "vtr_digest.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vtr_version.h"
+
+/// @brief Digest of the current RR graph, or empty if not computed yet
+static std::string f_rr_graph_digest;
+
+namespace {
+
+/// @brief Feeds plain values to a SHA-256 hasher through a buffer
+class DigestBuilder {
+  public:
+    template<typename T>
+    void add(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be hashed");
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+        if (buffer_.size() >= BUFFER_SIZE) {
+            flush();
+        }
+    }
+
+    void add(const char*) = delete;
+
+    void add(const std::string& str) {
+        add(str.size());
+        buffer_.insert(buffer_.end(), str.begin(), str.end());
+    }
+
+    std::string hex_digest() {
+        flush();
+        hasher_.finish();
+        return picosha2::get_hash_hex_string(hasher_);
+    }
+
+  private:
+    void flush() {
+        hasher_.process(buffer_.begin(), buffer_.end());
+        buffer_.clear();
+    }
+
+    static constexpr size_t BUFFER_SIZE = 1 << 16;
+    std::vector<uint8_t> buffer_;
+    picosha2::hash256_one_by_one hasher_;
+};
+
+/// @brief Creates the cache directory, returns false (with a warning) on failure
+bool create_setup_cache_dir(const std::string& cache_dir, const std::string& artifact_name) {
+    std::error_code ec;
+    std::filesystem::create_directories(cache_dir, ec);
+    if (ec) {
+        VTR_LOG_WARN("Unable to create setup cache directory '%s' (%s), %s will not be cached\n",
+                     cache_dir.c_str(), ec.message().c_str(), artifact_name.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+const std::string& get_rr_graph_digest() {
+    if (!f_rr_graph_digest.empty()) {
+        return f_rr_graph_digest;
+    }
+
+    vtr::ScopedStartFinishTimer timer("Computing RR graph digest");
+
+    const DeviceContext& device_ctx = g_vpr_ctx.device();
+    const RRGraphView& rr_graph = device_ctx.rr_graph;
+
+    DigestBuilder digest;
+
+    digest.add(rr_graph.num_nodes());
+    for (RRNodeId node : rr_graph.nodes()) {
+        e_rr_type type = rr_graph.node_type(node);
+        digest.add(type);
+        digest.add(rr_graph.node_xlow(node));
+        digest.add(rr_graph.node_ylow(node));
+        digest.add(rr_graph.node_xhigh(node));
+        digest.add(rr_graph.node_yhigh(node));
+        digest.add(rr_graph.node_layer_low(node));
+        digest.add(rr_graph.node_layer_high(node));
+        digest.add(rr_graph.node_ptc_num(node));
+        digest.add(rr_graph.node_capacity(node));
+        digest.add(rr_graph.node_rc_index(node));
+        digest.add(size_t(rr_graph.node_cost_index(node)));
+        if (type == e_rr_type::CHANX || type == e_rr_type::CHANY || type == e_rr_type::CHANZ) {
+            digest.add(rr_graph.node_direction(node));
+        } else if (type == e_rr_type::IPIN || type == e_rr_type::OPIN) {
+            for (e_side side : TOTAL_2D_SIDES) {
+                digest.add(rr_graph.is_node_on_specific_side(node, side));
+            }
+        }
+
+        digest.add(rr_graph.num_edges(node));
+        for (RREdgeId edge : rr_graph.edge_range(node)) {
+            digest.add(size_t(rr_graph.edge_sink_node(edge)));
+            digest.add(rr_graph.edge_switch(edge));
+        }
+    }
+
+    digest.add(rr_graph.num_rr_switches());
+    for (const t_rr_switch_inf& rr_switch : rr_graph.rr_switch()) {
+        digest.add(rr_switch.type());
+        digest.add(rr_switch.R);
+        digest.add(rr_switch.Cin);
+        digest.add(rr_switch.Cout);
+        digest.add(rr_switch.Cinternal);
+        digest.add(rr_switch.Tdel);
+    }
+
+    digest.add(device_ctx.rr_rc_data.size());
+    for (const t_rr_rc_data& rc_data : device_ctx.rr_rc_data) {
+        digest.add(rc_data.R);
+        digest.add(rc_data.C);
+    }
+
+    digest.add(device_ctx.rr_indexed_data.size());
+    for (const t_rr_indexed_data& indexed_data : device_ctx.rr_indexed_data) {
+        digest.add(indexed_data.base_cost);
+        digest.add(indexed_data.ortho_cost_index);
+        digest.add(indexed_data.seg_index);
+        digest.add(indexed_data.inv_length);
+        digest.add(indexed_data.T_linear);
+        digest.add(indexed_data.T_quadratic);
+        digest.add(indexed_data.C_load);
+    }
+
+    f_rr_graph_digest = digest.hex_digest();
+    return f_rr_graph_digest;
+}
+
+void invalidate_rr_graph_digest() {
+    f_rr_graph_digest.clear();
+}
+
+std::string get_setup_cache_file(const std::string& cache_dir,
+                                 const std::string& artifact_name,
+                                 const std::string& options_key) {
+#ifndef VTR_ENABLE_CAPNPROTO
+    static bool warned = false;
+    if (!warned) {
+        VTR_LOG_WARN("Setup cache directory '%s' ignored: caching requires VPR to be built with VTR_ENABLE_CAPNPROTO\n", cache_dir.c_str());
+        warned = true;
+    }
+    (void)artifact_name;
+    (void)options_key;
+    return std::string();
+#else
+    if (!create_setup_cache_dir(cache_dir, artifact_name)) {
+        return std::string();
+    }
+
+    const DeviceContext& device_ctx = g_vpr_ctx.device();
+
+    DigestBuilder key;
+    key.add(artifact_name);
+    key.add(std::string(device_ctx.arch->architecture_id ? device_ctx.arch->architecture_id : ""));
+    key.add(get_rr_graph_digest());
+    key.add(options_key);
+
+    std::filesystem::path cache_file = std::filesystem::path(cache_dir) / (key.hex_digest() + "." + artifact_name + ".capnp");
+    return cache_file.string();
+#endif
+}
+
+std::string get_arch_cache_file(const std::string& cache_dir,
+                                const std::string& arch_file,
+                                const std::string& options_key) {
+    const std::string artifact_name = "arch";
+    if (!create_setup_cache_dir(cache_dir, artifact_name)) {
+        return std::string();
+    }
+
+    DigestBuilder key;
+    key.add(artifact_name);
+    key.add(vtr::secure_digest_file(arch_file));
+    key.add(options_key);
+    // The binary architecture records the in-memory data structures of this build
+    key.add(std::string(vtr::VCS_REVISION));
+    key.add(std::string(vtr::BUILD_TIMESTAMP));
+    key.add(std::string(vtr::BUILD_INFO));
+
+    std::filesystem::path cache_file = std::filesystem::path(cache_dir) / (key.hex_digest() + "." + artifact_name + ".bin");
+    return cache_file.string();
+}
+
+bool setup_cache_file_exists(const std::string& cache_file) {
+    std::error_code ec;
+    return !cache_file.empty() && std::filesystem::is_regular_file(cache_file, ec);
+}
+
+void write_setup_cache_file(const std::string& cache_file,
+                            const std::function<void(const std::string&)>& write_artifact) {
+    if (cache_file.empty()) {
+        return;
+    }
+
+    // Unique temporary name, so concurrent runs don't write to the same file. The extension is kept,
+    // since the writers pick the file format from it.
+    std::random_device rd;
+    std::filesystem::path cache_path(cache_file);
+    std::string tmp_file = (cache_path.parent_path() / (cache_path.stem().string() + ".tmp" + std::to_string(rd()) + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + cache_path.extension().string())).string();
+
+    try {
+        write_artifact(tmp_file);
+    } catch (const vtr::VtrError& e) {
+        VTR_LOG_WARN("Unable to write setup cache file '%s': %s\n", cache_file.c_str(), e.what());
+        std::error_code ec;
+        std::filesystem::remove(tmp_file, ec);
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_file, cache_file, ec);
+    if (ec) {
+        VTR_LOG_WARN("Unable to store setup cache file '%s' (%s)\n", cache_file.c_str(), ec.message().c_str());
+        std::filesystem::remove(tmp_file, ec);
+        return;
+    }
+
+    VTR_LOG("Stored '%s' in the setup cache\n", cache_file.c_str());
+}
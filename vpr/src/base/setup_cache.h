@@ -0,0 +1,72 @@
+#pragma once
+/**
+ * @file
+ * @brief An on-disk cache for the expensive, device dependent setup artifacts:
+ *        the router lookahead, the intra-cluster router lookahead and the
+ *        placement delay model.
+ *
+ * When a cache directory is specified (--setup_cache_dir), each artifact is stored in
+ * that directory under a name derived from a SHA-256 digest of everything it depends on:
+ * the architecture, the RR graph and the options used to compute it. Later runs on the
+ * same device with the same options read the stored file instead of recomputing it.
+ *
+ * Files are written to a temporary name and then renamed, so concurrent runs sharing a
+ * cache directory never see a partially written artifact.
+ *
+ * The artifacts are Cap'n Proto files, so caching is only available when VPR is built
+ * with VTR_ENABLE_CAPNPROTO. The exception is the architecture itself (the data structures
+ * loaded from the architecture file), which is stored in a plain binary format specific to
+ * the VPR build (see binary_arch_file.h).
+ */
+
+#include <functional>
+#include <string>
+
+/**
+ * @brief Returns the digest of the current RR graph (nodes, edges, switches, RC and cost data).
+ *
+ * Computed once per RR graph: invalidate_rr_graph_digest() must be called whenever the RR graph is
+ * rebuilt or modified.
+ */
+const std::string& get_rr_graph_digest();
+
+/// @brief Forget the digest computed by get_rr_graph_digest().
+void invalidate_rr_graph_digest();
+
+/**
+ * @brief Returns the cache file of an artifact.
+ *
+ *   @param cache_dir The cache directory. Created if needed.
+ *   @param artifact_name Kind of artifact (e.g. "router_lookahead"), used in the file name.
+ *   @param options_key The options (and anything else besides the architecture and RR graph) the artifact depends on.
+ *
+ *   @return The path of the cache file (which may not exist yet), or an empty string if caching is unavailable.
+ */
+std::string get_setup_cache_file(const std::string& cache_dir,
+                                 const std::string& artifact_name,
+                                 const std::string& options_key);
+
+/**
+ * @brief Returns the cache file of the architecture loaded from an architecture file.
+ *
+ *   @param cache_dir The cache directory. Created if needed.
+ *   @param arch_file The architecture file, whose contents are part of the key.
+ *   @param options_key The options the architecture is loaded with (e.g. whether timing and power analysis are enabled).
+ *
+ *   @return The path of the cache file (which may not exist yet), or an empty string if caching is unavailable.
+ */
+std::string get_arch_cache_file(const std::string& cache_dir,
+                                const std::string& arch_file,
+                                const std::string& options_key);
+
+/// @brief Returns true if the given cache file has been stored.
+bool setup_cache_file_exists(const std::string& cache_file);
+
+/**
+ * @brief Stores an artifact in the cache.
+ *
+ * Calls write_artifact() with a temporary file name, then moves the file to cache_file.
+ * Failures are reported as warnings, since the cache is only an optimization.
+ */
+void write_setup_cache_file(const std::string& cache_file,
+                            const std::function<void(const std::string&)>& write_artifact);
@@ -14,6 +14,7 @@
 
 #include "globals.h"
 #include "read_xml_arch_file.h"
+#include "binary_arch_file.h"
 #include "read_fpga_interchange_arch.h"
 #include "pb_type_graph.h"
 #include "pack_types.h"
@@ -25,6 +26,7 @@
 #include "ShowSetup.h"
 
 #include "setup_vib_utils.h"
+#include "setup_cache.h"
 
 static void setup_netlist_opts(const t_options& Options, t_netlist_opts& NetlistOpts);
 static void setup_ap_opts(const t_options& options,
@@ -50,6 +52,8 @@ static void setup_switches(const t_arch& Arch,
 static void setup_analysis_opts(const t_options& Options, t_analysis_opts& analysis_opts);
 static void setup_power_opts(const t_options& Options, t_power_opts* power_opts, t_arch* Arch);
 
+static void read_arch(const t_options& options, bool timing_enabled, t_arch* arch);
+
 /**
  * @brief Identify which switch must be used for *track* to *IPIN* connections based on architecture file specification.
  * @param Arch Architecture file specification
@@ -132,6 +136,8 @@ void SetupVPR(const t_options* options,
     fileNameOpts->FlatPlaceFile = options->FlatPlaceFile;
     fileNameOpts->PlaceFile = options->PlaceFile;
     fileNameOpts->RouteFile = options->RouteFile;
+    fileNameOpts->write_place_file = options->write_place_file;
+    fileNameOpts->write_route_file = options->write_route_file;
     fileNameOpts->ActFile = options->ActFile;
     fileNameOpts->PowerFile = options->PowerFile;
     fileNameOpts->CmosTechFile = options->CmosTechFile;
@@ -145,6 +151,7 @@ void SetupVPR(const t_options* options,
     fileNameOpts->write_block_usage = options->write_block_usage;
 
     fileNameOpts->verify_file_digests = options->verify_file_digests;
+    fileNameOpts->binary_net_file = options->binary_net_file;
 
     setup_netlist_opts(*options, *netlistOpts);
     setup_placer_opts(*options, placerOpts);
@@ -160,25 +167,7 @@ void SetupVPR(const t_options* options,
 
     if (readArchFile) {
         vtr::ScopedStartFinishTimer t("Loading Architecture Description");
-        switch (options->arch_format) {
-            case e_arch_format::VTR:
-                xml_read_arch(options->ArchFile.value().c_str(),
-                              timingenabled,
-                              arch,
-                              device_ctx.physical_tile_types,
-                              device_ctx.logical_block_types);
-                break;
-            case e_arch_format::FPGAInterchange:
-                VTR_LOG("Use FPGA Interchange device\n");
-                FPGAInterchangeReadArch(options->ArchFile.value().c_str(),
-                                        timingenabled,
-                                        arch,
-                                        device_ctx.physical_tile_types,
-                                        device_ctx.logical_block_types);
-                break;
-            default:
-                VPR_FATAL_ERROR(VPR_ERROR_ARCH, "Invalid architecture format!");
-        }
+        read_arch(*options, timingenabled, arch);
     }
     VTR_LOG("\n");
 
@@ -448,6 +437,8 @@ static void setup_routing_arch(const t_arch& Arch,
 
 static void setup_router_opts(const t_options& Options, t_router_opts* RouterOpts) {
     RouterOpts->do_check_rr_graph = Options.check_rr_graph;
+    RouterOpts->check_rr_graph_trusted_digest = Options.check_rr_graph_trusted_digest;
+    RouterOpts->masked_chan_width_search = Options.router_masked_chan_width_search;
     RouterOpts->astar_fac = Options.astar_fac;
     RouterOpts->astar_offset = Options.astar_offset;
     RouterOpts->router_profiler_astar_fac = Options.router_profiler_astar_fac;
@@ -457,6 +448,11 @@ static void setup_router_opts(const t_options& Options, t_router_opts* RouterOpt
     RouterOpts->multi_queue_num_threads = Options.multi_queue_num_threads;
     RouterOpts->multi_queue_num_queues = Options.multi_queue_num_queues;
     RouterOpts->multi_queue_direct_draining = Options.multi_queue_direct_draining;
+    RouterOpts->multi_queue_stickiness = Options.multi_queue_stickiness;
+    RouterOpts->multi_queue_pop_batch_size = Options.multi_queue_pop_batch_size;
+    RouterOpts->router_partition_node_batching = Options.router_partition_node_batching;
+    RouterOpts->router_deterministic_parallel = Options.router_deterministic_parallel;
+    RouterOpts->numa_aware_threads = Options.numa_aware_threads;
     RouterOpts->bb_factor = Options.bb_factor;
     RouterOpts->criticality_exp = Options.criticality_exp;
     RouterOpts->max_criticality = Options.max_criticality;
@@ -477,6 +473,7 @@ static void setup_router_opts(const t_options& Options, t_router_opts* RouterOpt
     RouterOpts->switch_usage_analysis = Options.full_stats;
 
     RouterOpts->verify_binary_search = Options.verify_binary_search;
+    RouterOpts->chan_width_search_jobs = Options.chan_width_search_jobs;
     RouterOpts->router_algorithm = Options.RouterAlgorithm;
     RouterOpts->fixed_channel_width = Options.RouteChanWidth;
     RouterOpts->min_channel_width_hint = Options.min_route_chan_width_hint;
@@ -485,6 +482,7 @@ static void setup_router_opts(const t_options& Options, t_router_opts* RouterOpt
     RouterOpts->reorder_rr_graph_nodes_algorithm = Options.reorder_rr_graph_nodes_algorithm;
     RouterOpts->reorder_rr_graph_nodes_threshold = Options.reorder_rr_graph_nodes_threshold;
     RouterOpts->reorder_rr_graph_nodes_seed = Options.reorder_rr_graph_nodes_seed;
+    RouterOpts->compress_rr_graph_edges = Options.compress_rr_graph_edges;
 
     RouterOpts->initial_pres_fac = Options.initial_pres_fac;
     RouterOpts->base_cost_type = Options.base_cost_type;
@@ -497,18 +495,34 @@ static void setup_router_opts(const t_options& Options, t_router_opts* RouterOpt
     RouterOpts->routing_failure_predictor = Options.routing_failure_predictor;
     RouterOpts->routing_budgets_algorithm = Options.routing_budgets_algorithm;
     RouterOpts->save_routing_per_iteration = Options.save_routing_per_iteration;
+    RouterOpts->route_checkpoint_file = Options.route_checkpoint_file;
+    RouterOpts->route_checkpoint_interval = Options.route_checkpoint_interval;
+    RouterOpts->resume_routing = Options.resume_routing;
+    RouterOpts->eco_route_file = Options.eco_route_file;
     RouterOpts->congested_routing_iteration_threshold_frac = Options.congested_routing_iteration_threshold_frac;
     RouterOpts->route_bb_update = Options.route_bb_update;
     RouterOpts->clock_modeling = Options.clock_modeling;
     RouterOpts->two_stage_clock_routing = Options.two_stage_clock_routing;
     RouterOpts->high_fanout_threshold = Options.router_high_fanout_threshold;
     RouterOpts->high_fanout_max_slope = Options.router_high_fanout_max_slope;
+    RouterOpts->high_fanout_skeleton = Options.router_high_fanout_skeleton;
+    RouterOpts->net_profile_file = Options.router_net_profile_file;
     RouterOpts->router_debug_net = Options.router_debug_net;
     RouterOpts->router_debug_sink_rr = Options.router_debug_sink_rr;
     RouterOpts->router_debug_iteration = Options.router_debug_iteration;
     RouterOpts->lookahead_type = Options.router_lookahead_type;
+    RouterOpts->lookahead_lazy = Options.router_lookahead_lazy;
+    RouterOpts->lookahead_quantized = Options.router_lookahead_quantized;
+    RouterOpts->lookahead_cache_entries = Options.router_lookahead_cache_entries;
     RouterOpts->initial_acc_cost_chan_congestion_threshold = Options.router_initial_acc_cost_chan_congestion_threshold;
     RouterOpts->initial_acc_cost_chan_congestion_weight = Options.router_initial_acc_cost_chan_congestion_weight;
+    RouterOpts->global_route_prepass = Options.router_global_route_prepass;
+    RouterOpts->global_route_gcell_size = Options.router_global_route_gcell_size;
+    RouterOpts->bidirectional_search = Options.router_bidirectional_search;
+    RouterOpts->bidirectional_search_min_distance = Options.router_bidirectional_search_min_distance;
+    RouterOpts->bidirectional_search_max_criticality = Options.router_bidirectional_search_max_criticality;
+    RouterOpts->batch_max_criticality = Options.router_batch_max_criticality;
+    RouterOpts->clock_tree_routing = Options.router_clock_tree_routing;
 
     RouterOpts->max_convergence_count = Options.router_max_convergence_count;
     RouterOpts->reconvergence_cpd_threshold = Options.router_reconvergence_cpd_threshold;
@@ -523,6 +537,8 @@ static void setup_router_opts(const t_options& Options, t_router_opts* RouterOpt
     RouterOpts->write_intra_cluster_router_lookahead = Options.write_intra_cluster_router_lookahead;
     RouterOpts->read_intra_cluster_router_lookahead = Options.read_intra_cluster_router_lookahead;
 
+    RouterOpts->setup_cache_dir = Options.setup_cache_dir;
+
     RouterOpts->router_heap = Options.router_heap;
     RouterOpts->exit_after_first_routing_iteration = Options.exit_after_first_routing_iteration;
 
@@ -578,6 +594,7 @@ static void setup_anneal_sched(const t_options& Options,
  */
 void setup_ap_opts(const t_options& options,
                    t_ap_opts& apOpts) {
+    apOpts.global_placer_type = options.ap_global_placer.value();
     apOpts.analytical_solver_type = options.ap_analytical_solver.value();
     apOpts.partial_legalizer_type = options.ap_partial_legalizer.value();
     apOpts.full_legalizer_type = options.ap_full_legalizer.value();
@@ -590,6 +607,8 @@ void setup_ap_opts(const t_options& options,
     apOpts.num_threads = options.num_workers.value();
     apOpts.log_verbosity = options.ap_verbosity.value();
     apOpts.generate_mass_report = options.ap_generate_mass_report.value();
+    apOpts.write_partial_placement_file = options.ap_write_partial_placement.value();
+    apOpts.read_partial_placement_file = options.ap_read_partial_placement.value();
 }
 
 /**
@@ -624,6 +643,10 @@ void setup_packer_opts(const t_options& Options,
     PackerOpts->high_fanout_threshold = Options.pack_high_fanout_threshold;
     PackerOpts->transitive_fanout_threshold = Options.pack_transitive_fanout_threshold;
     PackerOpts->feasible_block_array_size = Options.pack_feasible_block_array_size;
+    PackerOpts->num_partitions = Options.pack_num_partitions;
+    PackerOpts->speculative_candidates = Options.pack_speculative_candidates;
+    PackerOpts->profile = Options.pack_profile;
+    PackerOpts->eco_net_file = Options.pack_eco_net_file;
 
     PackerOpts->device_layout = Options.device_layout;
 
@@ -638,6 +661,7 @@ static void setup_netlist_opts(const t_options& Options, t_netlist_opts& Netlist
     NetlistOpts.sweep_dangling_blocks = Options.sweep_dangling_blocks;
     NetlistOpts.sweep_constant_primary_outputs = Options.sweep_constant_primary_outputs;
     NetlistOpts.netlist_verbosity = Options.netlist_verbosity;
+    NetlistOpts.mmap_blif_parser = Options.mmap_blif_parser;
 }
 
 /**
@@ -683,13 +707,23 @@ static void setup_placer_opts(const t_options& Options, t_placer_opts* PlacerOpt
     PlacerOpts->tsu_abs_margin = Options.place_tsu_abs_margin;
     PlacerOpts->delay_model_type = Options.place_delay_model;
     PlacerOpts->delay_model_reducer = Options.place_delay_model_reducer;
+    PlacerOpts->place_delay_model_background = Options.place_delay_model_background;
 
     PlacerOpts->place_freq = PLACE_ONCE; /* DEFAULT */
 
     PlacerOpts->post_place_timing_report_file = Options.post_place_timing_report_file;
 
     PlacerOpts->rlim_escape_fraction = Options.place_rlim_escape_fraction;
+    PlacerOpts->speculative_moves = Options.place_speculative_moves;
+    PlacerOpts->parallel_regions = Options.place_parallel_regions;
+    PlacerOpts->num_seeds = Options.place_num_seeds;
+    PlacerOpts->seed_stop_ratio = Options.place_seed_stop_ratio;
+    PlacerOpts->anneal_convergence_threshold = Options.anneal_convergence_threshold;
+    PlacerOpts->numa_aware_threads = Options.numa_aware_threads;
+    PlacerOpts->eco_place_file = Options.place_eco_place_file;
+    PlacerOpts->eco_window = Options.place_eco_window;
     PlacerOpts->move_stats_file = Options.place_move_stats_file;
+    PlacerOpts->move_profile_file = Options.place_move_profile_file;
     PlacerOpts->placement_saves_per_temperature = Options.placement_saves_per_temperature;
     PlacerOpts->place_delta_delay_matrix_calculation_method = Options.place_delta_delay_matrix_calculation_method;
 
@@ -711,6 +745,7 @@ static void setup_placer_opts(const t_options& Options, t_placer_opts* PlacerOpt
     PlacerOpts->place_checkpointing = Options.place_checkpointing;
     PlacerOpts->place_agent_epsilon = Options.place_agent_epsilon;
     PlacerOpts->place_agent_gamma = Options.place_agent_gamma;
+    PlacerOpts->place_agent_batch_size = Options.place_agent_batch_size;
     PlacerOpts->place_dm_rlim = Options.place_dm_rlim;
     PlacerOpts->place_agent_space = Options.place_agent_space;
     PlacerOpts->place_reward_fun = Options.place_reward_fun;
@@ -743,6 +778,7 @@ static void setup_analysis_opts(const t_options& Options, t_analysis_opts& analy
     analysis_opts.timing_report_npaths = Options.timing_report_npaths;
     analysis_opts.timing_report_detail = Options.timing_report_detail;
     analysis_opts.timing_report_skew = Options.timing_report_skew;
+    analysis_opts.timing_report_compress = Options.timing_report_compress;
     analysis_opts.echo_dot_timing_graph_node = Options.echo_dot_timing_graph_node;
 
     analysis_opts.post_synth_netlist_unconn_input_handling = Options.post_synth_netlist_unconn_input_handling;
@@ -759,6 +795,8 @@ static void setup_power_opts(const t_options& Options, t_power_opts* power_opts,
     DeviceContext& device_ctx = g_vpr_ctx.mutable_device();
 
     power_opts->do_power = Options.do_power;
+    power_opts->estimate_activity = Options.estimate_activity;
+    power_opts->activity_estimation_cycles = Options.activity_estimation_cycles;
 
     if (power_opts->do_power) {
         if (!Arch->power)
@@ -780,6 +818,69 @@ static void setup_power_opts(const t_options& Options, t_power_opts* power_opts,
 /*
  * Go through all the NoC options supplied by the user and store them internally.
  */
+/**
+ * @brief Loads the architecture file (VTR XML or FPGA Interchange device), through the setup cache if a
+ * cache directory is specified.
+ *
+ * The cached architecture is the state after xml_read_arch() or FPGAInterchangeReadArch(), so the key
+ * covers the options the architecture file is parsed with: its format, timing and power analysis (which
+ * allocates arch->power and arch->clocks in setup_power_opts()) and the device layout. Interchange devices
+ * benefit the most: decompressing and converting a large device takes much longer than reading it back.
+ */
+static void read_arch(const t_options& options, bool timing_enabled, t_arch* arch) {
+    DeviceContext& device_ctx = g_vpr_ctx.mutable_device();
+    const std::string& arch_file = options.ArchFile.value();
+
+    if (options.arch_format != e_arch_format::VTR && options.arch_format != e_arch_format::FPGAInterchange) {
+        VPR_FATAL_ERROR(VPR_ERROR_ARCH, "Invalid architecture format!");
+    }
+
+    std::string cache_file;
+    if (!options.setup_cache_dir.value().empty()) {
+        std::string options_key = std::to_string(int(options.arch_format.value()))
+                                  + " " + std::to_string(timing_enabled)
+                                  + " " + std::to_string(arch->power != nullptr)
+                                  + " " + std::to_string(arch->clocks != nullptr)
+                                  + " " + arch->device_layout;
+        cache_file = get_arch_cache_file(options.setup_cache_dir, arch_file, options_key);
+    }
+
+    if (setup_cache_file_exists(cache_file)) {
+        VTR_LOG("Loading architecture from setup cache file '%s'\n", cache_file.c_str());
+        read_binary_arch_file(cache_file,
+                              arch_file.c_str(),
+                              arch,
+                              device_ctx.physical_tile_types,
+                              device_ctx.logical_block_types);
+        return;
+    }
+
+    if (options.arch_format == e_arch_format::FPGAInterchange) {
+        VTR_LOG("Use FPGA Interchange device\n");
+        FPGAInterchangeReadArch(arch_file.c_str(),
+                                timing_enabled,
+                                arch,
+                                device_ctx.physical_tile_types,
+                                device_ctx.logical_block_types);
+    } else {
+        xml_read_arch(arch_file.c_str(),
+                      timing_enabled,
+                      arch,
+                      device_ctx.physical_tile_types,
+                      device_ctx.logical_block_types);
+    }
+
+    if (!cache_file.empty()) {
+        if (binary_arch_file_supported(*arch)) {
+            write_setup_cache_file(cache_file, [&](const std::string& file) {
+                write_binary_arch_file(file, *arch, device_ctx.physical_tile_types, device_ctx.logical_block_types);
+            });
+        } else {
+            VTR_LOG("Architecture not cached: architectures with VIBs are not supported by the setup cache\n");
+        }
+    }
+}
+
 static void setup_noc_opts(const t_options& Options, t_noc_opts* NocOpts) {
     // assign the noc specific options from the command line
     NocOpts->noc = Options.noc;
@@ -792,6 +893,7 @@ static void setup_noc_opts(const t_options& Options, t_noc_opts* NocOpts) {
     NocOpts->noc_congestion_weighting = Options.noc_congestion_weighting;
     NocOpts->noc_centroid_weight = Options.noc_centroid_weight;
     NocOpts->noc_swap_percentage = Options.noc_swap_percentage;
+    NocOpts->noc_initial_placement_speculative_moves = Options.noc_initial_placement_speculative_moves;
     NocOpts->noc_sat_routing_bandwidth_resolution = Options.noc_sat_routing_bandwidth_resolution;
     NocOpts->noc_sat_routing_latency_overrun_weighting = Options.noc_sat_routing_latency_overrun_weighting_factor;
     NocOpts->noc_sat_routing_congestion_weighting = Options.noc_sat_routing_congestion_weighting_factor;
@@ -800,7 +902,11 @@ static void setup_noc_opts(const t_options& Options, t_noc_opts* NocOpts) {
     } else {
         NocOpts->noc_sat_routing_num_workers = (int)Options.num_workers;
     }
+    NocOpts->noc_sat_routing_time_limit = Options.noc_sat_routing_time_limit;
     NocOpts->noc_sat_routing_log_search_progress = Options.noc_sat_routing_log_search_progress;
+    NocOpts->noc_simulation = Options.noc_simulation;
+    NocOpts->noc_simulation_cycles = Options.noc_simulation_cycles;
+    NocOpts->noc_simulation_packet_size = Options.noc_simulation_packet_size;
     NocOpts->noc_placement_file_name = Options.noc_placement_file_name;
 }
 
@@ -23,6 +23,11 @@
 #include "segment_stats.h"
 #include "channel_stats.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/combinable.h>
+#include <tbb/parallel_for_each.h>
+#endif
+
 /********************** Subroutines local to this module *********************/
 
 /**
@@ -137,11 +142,34 @@ void length_and_bends_stats(const Netlist<>& net_list, bool is_flat) {
     int num_clb_opins_reserved = 0;
     int num_absorbed_nets = 0;
 
+    /* Measure the routing of the nets first (independently of each other), then sum them up in net order */
+    struct t_net_stats {
+        int bends = 0;
+        int length = 0;
+        int segments = 0;
+        bool is_absorbed = false;
+    };
+    vtr::vector<ParentNetId, t_net_stats> net_stats(net_list.nets().size());
+    auto measure_net = [&](ParentNetId net_id) {
+        if (!net_list.net_is_ignored(net_id) && net_list.net_sinks(net_id).size() != 0) {
+            t_net_stats& stats = net_stats[net_id];
+            get_num_bends_and_length(net_id, &stats.bends, &stats.length, &stats.segments, &stats.is_absorbed);
+        }
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(net_list.nets().begin(), net_list.nets().end(), measure_net);
+#else
+    for (auto net_id : net_list.nets()) {
+        measure_net(net_id);
+    }
+#endif
+
     for (auto net_id : net_list.nets()) {
         if (!net_list.net_is_ignored(net_id) && net_list.net_sinks(net_id).size() != 0) { /* Globals don't count. */
-            int bends, length, segments;
-            bool is_absorbed;
-            get_num_bends_and_length(net_id, &bends, &length, &segments, &is_absorbed);
+            int bends = net_stats[net_id].bends;
+            int length = net_stats[net_id].length;
+            int segments = net_stats[net_id].segments;
+            bool is_absorbed = net_stats[net_id].is_absorbed;
 
             total_bends += bends;
             max_bends = std::max(bends, max_bends);
@@ -328,16 +356,16 @@ static void load_channel_occupancies(const Netlist<>& net_list,
     chanx_occ.fill(0);
     chany_occ.fill(0);
 
-    // Now go through each net and count the tracks and pins used everywhere
-    for (ParentNetId net_id : net_list.nets()) {
+    // Count the tracks used by a net into (chanx, chany)
+    auto count_net = [&](ParentNetId net_id, vtr::NdMatrix<int, 3>& net_chanx_occ, vtr::NdMatrix<int, 3>& net_chany_occ) {
         // Skip global and empty nets.
         if (net_list.net_is_ignored(net_id) && net_list.net_sinks(net_id).size() != 0) {
-            continue;
+            return;
         }
 
         const vtr::optional<RouteTree>& tree = route_ctx.route_trees[net_id];
         if (!tree) {
-            continue;
+            return;
         }
 
         for (const RouteTreeNode& rt_node : tree.value().all_nodes()) {
@@ -348,15 +376,40 @@ static void load_channel_occupancies(const Netlist<>& net_list,
                 int j = rr_graph.node_ylow(inode);
                 int layer = rr_graph.node_layer_low(inode);
                 for (int i = rr_graph.node_xlow(inode); i <= rr_graph.node_xhigh(inode); i++)
-                    chanx_occ[layer][i][j]++;
+                    net_chanx_occ[layer][i][j]++;
             } else if (rr_type == e_rr_type::CHANY) {
                 int i = rr_graph.node_xlow(inode);
                 int layer = rr_graph.node_layer_low(inode);
                 for (int j = rr_graph.node_ylow(inode); j <= rr_graph.node_yhigh(inode); j++)
-                    chany_occ[layer][i][j]++;
+                    net_chany_occ[layer][i][j]++;
             }
         }
+    };
+
+    // Now go through each net and count the tracks and pins used everywhere
+#ifdef VPR_USE_TBB
+    // Each thread counts into its own copy of the occupancies, which are summed up at the end
+    using t_occupancies = std::pair<vtr::NdMatrix<int, 3>, vtr::NdMatrix<int, 3>>;
+    tbb::combinable<t_occupancies> thread_occ([&]() {
+        return t_occupancies(chanx_occ, chany_occ);
+    });
+    tbb::parallel_for_each(net_list.nets().begin(), net_list.nets().end(), [&](ParentNetId net_id) {
+        t_occupancies& occ = thread_occ.local();
+        count_net(net_id, occ.first, occ.second);
+    });
+    thread_occ.combine_each([&](const t_occupancies& occ) {
+        for (size_t i = 0; i < chanx_occ.size(); i++) {
+            chanx_occ.get(i) += occ.first.get(i);
+        }
+        for (size_t i = 0; i < chany_occ.size(); i++) {
+            chany_occ.get(i) += occ.second.get(i);
+        }
+    });
+#else
+    for (ParentNetId net_id : net_list.nets()) {
+        count_net(net_id, chanx_occ, chany_occ);
     }
+#endif
 }
 
 /**
@@ -25,9 +25,13 @@
 #include "verify_placement.h"
 #include "vpr_context.h"
 #include "vtr_assert.h"
+#include "vtr_async_file_writer.h"
 #include "vtr_log.h"
 #include "vtr_version.h"
 #include "vtr_time.h"
+#include "vtr_profile.h"
+#include "vtr_memory.h"
+#include "vtr_numa.h"
 
 #include "vpr_types.h"
 #include "vpr_utils.h"
@@ -63,6 +67,8 @@
 #include "pack_types.h"
 #include "lb_type_rr_graph.h"
 #include "read_activity.h"
+#include "estimate_activity.h"
+#include "memory_report.h"
 #include "net_delay.h"
 #include "concrete_timing_info.h"
 #include "netlist_writer.h"
@@ -74,6 +80,7 @@
 #include "vpr_constraints_reader.h"
 #include "place_util.h"
 #include "timing_fail_error.h"
+#include "timing_util.h"
 #include "analytical_placement_flow.h"
 #include "verify_clustering.h"
 
@@ -100,6 +107,8 @@
 #define TBB_PREVIEW_GLOBAL_CONTROL 1 /* Needed for compatibility with old TBB versions */
 #include <tbb/task_arena.h>
 #include <tbb/global_control.h>
+#include "numa_threads.h"
+#include "vpr_context_observer.h"
 #endif
 
 #ifndef NO_SERVER
@@ -247,6 +256,11 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
     vpr_setup->two_stage_clock_routing = options->two_stage_clock_routing;
     vpr_setup->exit_before_pack = options->exit_before_pack;
     vpr_setup->num_workers = num_workers;
+    vpr_setup->profile_trace_file = options->profile_trace_file;
+    vpr_setup->report_memory_usage = options->report_memory_usage;
+    vpr_setup->numa_aware_threads = options->numa_aware_threads;
+    vtr::set_huge_pages_enabled(options->huge_pages);
+    vtr::profile::enable(!vpr_setup->profile_trace_file.empty());
 
     VTR_LOG("\n");
     VTR_LOG("Architecture file: %s\n", options->ArchFile.value().c_str());
@@ -255,6 +269,8 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
 
     /* Determine whether echo is on or off */
     setEchoEnabled(options->CreateEchoFile);
+    setTimingGraphEchoStages(options->write_timing_graph_echo);
+    setTimingGraphEchoAnonymized(options->anonymize_timing_graph_echo);
 
     /*
      * Initialize the functions names for which VPR_ERRORs
@@ -324,11 +340,31 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
     /* flush any messages to user still in stdout that hasn't gotten displayed */
     fflush(stdout);
 
+    vpr_load_circuit(options, vpr_setup, arch);
+
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+    device_ctx.pad_loc_type = vpr_setup->PlacerOpts.pad_loc_type;
+}
+
+/**
+ * @brief Load the circuit with the options (once the architecture is loaded)
+ *
+ * 1. Read Circuit
+ * 2. Build the timing graph and load the timing constraints
+ * 3. Load the floorplanning and routing constraints
+ */
+void vpr_load_circuit(const t_options* options, t_vpr_setup* vpr_setup, t_arch* arch) {
     /* Read blif file and sweep unused components */
     auto& atom_ctx = g_vpr_ctx.mutable_atom();
     atom_ctx.mutable_netlist() = read_and_process_circuit(options->circuit_format, *vpr_setup, *arch);
 
-    if (vpr_setup->PowerOpts.do_power) {
+    if (vpr_setup->PowerOpts.do_power && vpr_setup->PowerOpts.estimate_activity) {
+        //Estimate the net activities for power estimation, and save them as the activity file
+        vtr::ScopedStartFinishTimer t("Estimate Activity");
+        auto& power_ctx = g_vpr_ctx.mutable_power();
+        power_ctx.atom_net_power = estimate_activity(atom_ctx.netlist(), arch->models, vpr_setup->PowerOpts.activity_estimation_cycles);
+        write_activity(atom_ctx.netlist(), power_ctx.atom_net_power, vpr_setup->FileNameOpts.ActFile.c_str());
+    } else if (vpr_setup->PowerOpts.do_power) {
         //Load the net activity file for power estimation
         vtr::ScopedStartFinishTimer t("Load Activity File");
         auto& power_ctx = g_vpr_ctx.mutable_power();
@@ -340,7 +376,8 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
         auto& timing_ctx = g_vpr_ctx.mutable_timing();
         {
             vtr::ScopedStartFinishTimer t("Build Timing Graph");
-            timing_ctx.graph = TimingGraphBuilder(atom_ctx.netlist(), atom_ctx.mutable_lookup(), arch->models).timing_graph(options->allow_dangling_combinational_nodes);
+            timing_ctx.graph = TimingGraphBuilder(atom_ctx.netlist(), atom_ctx.mutable_lookup(), arch->models).timing_graph(options->allow_dangling_combinational_nodes,
+                                                                                                                                   options->timing_graph_opt_layout);
             VTR_LOG("  Timing Graph Nodes: %zu\n", timing_ctx.graph->nodes().size());
             VTR_LOG("  Timing Graph Edges: %zu\n", timing_ctx.graph->edges().size());
             VTR_LOG("  Timing Graph Levels: %zu\n", timing_ctx.graph->levels().size());
@@ -354,6 +391,9 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
         }
         {
             set_terminate_if_timing_fails(options->terminate_if_timing_fails);
+            if (options->timing_corner_delay_scales.provenance() == argparse::Provenance::SPECIFIED) {
+                set_timing_corner_delay_scales(options->timing_corner_delay_scales.value());
+            }
         }
     }
 
@@ -370,9 +410,6 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
     }
 
     fflush(stdout);
-
-    auto& device_ctx = g_vpr_ctx.mutable_device();
-    device_ctx.pad_loc_type = vpr_setup->PlacerOpts.pad_loc_type;
 }
 
 /** Port equivalence does not make sense during flat routing.
@@ -446,14 +483,52 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
     /* Set this here, because tbb::global_control doesn't control anything once it's out of scope
      * (contrary to the name). */
     tbb::global_control c(tbb::global_control::max_allowed_parallelism, vpr_setup.num_workers);
+
+    /* Keep the workers of the default arena on their NUMA nodes */
+    std::unique_ptr<NumaPinningObserver> numa_observer;
+    if (vpr_setup.numa_aware_threads && vtr::numa::num_nodes() > 1) {
+        numa_observer = std::make_unique<NumaPinningObserver>(vpr_setup.num_workers);
+        VTR_LOG("Pinning the worker threads to %zu NUMA nodes\n", vtr::numa::num_nodes());
+    }
 #endif
 
+    /* Dump the profiling zones however the flow ends */
+    struct ProfileWriter {
+        const std::string& trace_file;
+        ~ProfileWriter() {
+            if (!trace_file.empty()) {
+                vtr::profile::print_summary();
+                try {
+                    vtr::profile::write_chrome_trace(trace_file);
+                } catch (const vtr::VtrError& e) {
+                    VTR_LOG_WARN("%s: %s\n", e.what(), e.filename_c_str());
+                }
+            }
+        }
+    } profile_writer{vpr_setup.profile_trace_file};
+    VTR_PROFILE_ZONE("VPR flow");
+
+    /* Finish writing the output files written in the background however the flow ends */
+    struct AsyncFileWritesWaiter {
+        ~AsyncFileWritesWaiter() {
+            try {
+                vtr::wait_for_async_file_writes();
+            } catch (const vtr::VtrError& e) {
+                VTR_LOG_ERROR("%s\n", e.what());
+            }
+        }
+    } async_file_writes_waiter;
+
     { //Pack
         bool pack_success = vpr_pack_flow(vpr_setup, arch);
 
         if (!pack_success) {
             return false; //Unimplementable
         }
+
+        if (vpr_setup.report_memory_usage) {
+            report_memory_usage(get_current_vpr_context(), "packing");
+        }
     }
 
     vpr_create_device(vpr_setup, arch);
@@ -480,6 +555,10 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
         if (!place_success) {
             return false; //Unimplementable
         }
+
+        if (vpr_setup.report_memory_usage) {
+            report_memory_usage(get_current_vpr_context(), "placement");
+        }
     }
 
     { // Analytical Place
@@ -521,6 +600,10 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
     RouteStatus route_status;
     { //Route
         route_status = vpr_route_flow(router_net_list, vpr_setup, arch, is_flat);
+
+        if (vpr_setup.report_memory_usage) {
+            report_memory_usage(get_current_vpr_context(), "routing");
+        }
     }
     { //Analysis
         vpr_analysis_flow(router_net_list, vpr_setup, arch, route_status, is_flat);
@@ -529,9 +612,27 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
     //close the graphics
     vpr_close_graphics(vpr_setup);
 
+    // Report an output file which could not be written as an error of the flow
+    vtr::wait_for_async_file_writes();
+
     return route_status.success();
 }
 
+bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch, VprContext& ctx) {
+    ScopedVprContext ctx_scope(ctx);
+
+#ifdef VPR_USE_TBB
+    /* The parallel tasks of the flow run in its own arena, whose workers work on its context */
+    tbb::task_arena arena(vpr_setup.num_workers);
+    VprContextObserver ctx_observer(arena, ctx);
+    return arena.execute([&]() {
+        return vpr_flow(vpr_setup, arch);
+    });
+#else
+    return vpr_flow(vpr_setup, arch);
+#endif
+}
+
 void vpr_create_device(t_vpr_setup& vpr_setup, const t_arch& arch) {
     vtr::ScopedStartFinishTimer timer("Create Device");
     vpr_create_device_grid(vpr_setup, arch);
@@ -638,6 +739,12 @@ void vpr_setup_noc_routing_algorithm(const std::string& noc_routing_algorithm_na
 
     noc_ctx.noc_flows_router = NocRoutingAlgorithmCreator::create_routing_algorithm(noc_routing_algorithm_name,
                                                                                     noc_ctx.noc_model);
+
+    // When the routes only depend on the source and sink routers, route every
+    // pair of routers once, so the routes can be looked up during placement.
+    if (!noc_ctx.noc_flows_router->route_depends_on_traffic_flow()) {
+        noc_ctx.noc_model.build_route_table(*noc_ctx.noc_flows_router);
+    }
 }
 
 bool vpr_pack_flow(t_vpr_setup& vpr_setup, const t_arch& arch) {
@@ -733,6 +840,7 @@ void vpr_load_packing(const t_vpr_setup& vpr_setup, const t_arch& arch) {
     cluster_ctx.clb_nlist = read_netlist(vpr_setup.FileNameOpts.NetFile.c_str(),
                                          &arch,
                                          vpr_setup.FileNameOpts.verify_file_digests,
+                                         vpr_setup.FileNameOpts.binary_net_file,
                                          vpr_setup.PackerOpts.pack_verbosity);
 
     /* Load the mapping between clusters and their atoms */
@@ -744,9 +852,11 @@ void vpr_load_packing(const t_vpr_setup& vpr_setup, const t_arch& arch) {
                           vpr_setup.constant_net_method,
                           vpr_setup.PackerOpts.pack_verbosity);
 
+    cluster_ctx.clb_net_pins = ClbNetPinsCsr(cluster_ctx.clb_nlist);
+
     {
         std::ofstream ofs("packing_pin_util.rpt");
-        report_packing_pin_usage(ofs, g_vpr_ctx);
+        report_packing_pin_usage(ofs, get_current_vpr_context());
     }
 
     // Ater the clustered netlist has been loaded, update the floorplanning
@@ -758,7 +868,7 @@ void vpr_load_packing(const t_vpr_setup& vpr_setup, const t_arch& arch) {
 
     // Independently verify the clusterings to ensure the clustering can be
     // used for the rest of the VPR flow.
-    unsigned num_errors = verify_clustering(g_vpr_ctx);
+    unsigned num_errors = verify_clustering(get_current_vpr_context());
     if (num_errors == 0) {
         VTR_LOG("Completed clustering consistency check successfully.\n");
     } else {
@@ -855,9 +965,10 @@ void vpr_place(const Netlist<>& net_list,
                t_vpr_setup& vpr_setup,
                const t_arch& arch) {
     bool is_flat = false;
-    if (vpr_setup.PlacerOpts.place_algorithm.is_timing_driven()) {
+    if (vpr_setup.PlacerOpts.place_algorithm.is_timing_driven() && !vpr_setup.PlacerOpts.place_delay_model_background) {
         // Prime lookahead cache to avoid adding lookahead computation cost to
-        // the placer timer.
+        // the placer timer (with background delay model computation, it is
+        // computed along with the delay model, overlapping the initial placement).
         // Flat_routing is disabled in placement
         get_cached_router_lookahead(
             vpr_setup.RoutingArch,
@@ -866,7 +977,10 @@ void vpr_place(const Netlist<>& net_list,
             vpr_setup.RouterOpts.read_router_lookahead,
             vpr_setup.Segments,
             is_flat,
-            vpr_setup.RouterOpts.route_verbosity);
+            vpr_setup.RouterOpts.route_verbosity,
+            vpr_setup.RouterOpts.setup_cache_dir,
+            vpr_setup.RouterOpts.lookahead_lazy,
+            vpr_setup.RouterOpts.lookahead_quantized);
     }
 
     // Read in the flat placement if a flat placement file is provided and it
@@ -918,13 +1032,14 @@ void vpr_load_placement(t_vpr_setup& vpr_setup,
                                                            g_vpr_ctx.atom().netlist(),
                                                            g_vpr_ctx.atom().lookup());
 
-    // Load an existing placement from a file
+    // Load an existing placement from a file (which may still be being written)
+    vtr::wait_for_async_file_writes();
     place_ctx.placement_id = read_place(filename_opts.NetFile.c_str(), filename_opts.PlaceFile.c_str(),
                                         blk_loc_registry,
                                         filename_opts.verify_file_digests, device_ctx.grid);
 
     // Verify that the placement invariants are met after reading the placement from a file.
-    unsigned num_errors = verify_placement(g_vpr_ctx);
+    unsigned num_errors = verify_placement(get_current_vpr_context());
     if (num_errors == 0) {
         VTR_LOG("Completed placement consistency check successfully.\n");
     } else {
@@ -933,6 +1048,14 @@ void vpr_load_placement(t_vpr_setup& vpr_setup,
                   "Aborting program.\n",
                   num_errors);
     }
+
+    // Write a copy of the placement (e.g. to convert it to/from the binary format)
+    if (!filename_opts.write_place_file.empty()) {
+        place_ctx.placement_id = print_place(filename_opts.NetFile.c_str(),
+                                             g_vpr_ctx.clustering().clb_nlist.netlist_id().c_str(),
+                                             filename_opts.write_place_file.c_str(),
+                                             blk_loc_registry.block_locs());
+    }
 }
 
 RouteStatus vpr_route_flow(const Netlist<>& net_list,
@@ -973,6 +1096,7 @@ RouteStatus vpr_route_flow(const Netlist<>& net_list,
             if (g_vpr_ctx.server().gate_io.is_running()) {
                 g_vpr_ctx.mutable_server().timing_info = timing_info;
                 g_vpr_ctx.mutable_server().routing_delay_calc = routing_delay_calc;
+                g_vpr_ctx.mutable_server().timing_path_cache = std::make_shared<tatum::TimingPathCache>(*g_vpr_ctx.timing().graph);
             }
 #endif /* NO_SERVER */
         } else {
@@ -1050,7 +1174,7 @@ RouteStatus vpr_route_flow(const Netlist<>& net_list,
             if (isEchoFileEnabled(E_ECHO_FINAL_ROUTING_TIMING_GRAPH)) {
                 auto& timing_ctx = g_vpr_ctx.timing();
                 tatum::write_echo(getEchoFileName(E_ECHO_FINAL_ROUTING_TIMING_GRAPH),
-                                  *timing_ctx.graph, *timing_ctx.constraints, *routing_delay_calc, timing_info->analyzer());
+                                  *timing_ctx.graph, *timing_ctx.constraints, *routing_delay_calc, timing_info->analyzer(), getTimingGraphEchoAnonymized());
             }
 
             if (isEchoFileEnabled(E_ECHO_ROUTING_SINK_DELAYS)) {
@@ -1084,7 +1208,10 @@ RouteStatus vpr_route_fixed_W(const Netlist<>& net_list,
         vpr_setup.RouterOpts.read_router_lookahead,
         vpr_setup.Segments,
         is_flat,
-        vpr_setup.RouterOpts.route_verbosity);
+        vpr_setup.RouterOpts.route_verbosity,
+        vpr_setup.RouterOpts.setup_cache_dir,
+        vpr_setup.RouterOpts.lookahead_lazy,
+        vpr_setup.RouterOpts.lookahead_quantized);
 
     vtr::ScopedStartFinishTimer timer("Routing");
 
@@ -1157,12 +1284,22 @@ RouteStatus vpr_load_routing(t_vpr_setup& vpr_setup,
 
     auto& filename_opts = vpr_setup.FileNameOpts;
 
-    //Load the routing from a file
+    //Load the routing from a file (which may still be being written)
+    vtr::wait_for_async_file_writes();
     bool is_legal = read_route(filename_opts.RouteFile.c_str(),
                                vpr_setup.RouterOpts,
                                filename_opts.verify_file_digests,
                                is_flat);
     const Netlist<>& router_net_list = is_flat ? (const Netlist<>&)g_vpr_ctx.atom().netlist() : (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
+
+    // Write a copy of the routing (e.g. to convert it to/from the binary format)
+    if (!filename_opts.write_route_file.empty()) {
+        const std::string& placement_file = filename_opts.write_place_file.empty() ? filename_opts.PlaceFile : filename_opts.write_place_file;
+        print_route(router_net_list,
+                    placement_file.c_str(),
+                    filename_opts.write_route_file.c_str(),
+                    is_flat);
+    }
     if (vpr_setup.Timing.timing_analysis_enabled) {
         //Update timing info
         load_net_delay_from_routing(router_net_list,
@@ -1196,6 +1333,13 @@ void vpr_create_rr_graph(t_vpr_setup& vpr_setup, const t_arch& arch, int chan_wi
 
     int warnings = 0;
 
+    // The jobs of a daemon start with the RR graph of the device already built
+    if (vpr_setup.reuse_rr_graph && !device_ctx.rr_graph.empty() && device_ctx.chan_width == chan_width && device_ctx.rr_graph_is_flat == is_flat) {
+        VTR_LOG("Reusing the RR graph already built for the device\n");
+        init_draw_coords(chan_width_fac, g_vpr_ctx.placement().blk_loc_registry());
+        return;
+    }
+
     //Clean-up any previous RR graph
     free_rr_graph();
 
@@ -1274,6 +1418,7 @@ void free_circuit() {
     }
 
     cluster_ctx.clb_nlist = ClusteredNetlist();
+    cluster_ctx.clb_net_pins = ClbNetPinsCsr();
 }
 
 static void free_atoms() {
@@ -1320,6 +1465,10 @@ void vpr_free_vpr_data_structures(t_arch& Arch,
 
 void vpr_free_all(t_arch& Arch,
                   t_vpr_setup& vpr_setup) {
+#ifndef NO_SERVER
+    // the server tasks still executed read the data structures freed below
+    g_vpr_ctx.mutable_server().task_resolver.stop();
+#endif /* NO_SERVER */
     free_rr_graph();
     if (vpr_setup.RouterOpts.doRouting != e_stage_action::SKIP) {
         free_route_structs();
@@ -1517,7 +1666,7 @@ void vpr_analysis(const Netlist<>& net_list,
         if (isEchoFileEnabled(E_ECHO_ANALYSIS_TIMING_GRAPH)) {
             auto& timing_ctx = g_vpr_ctx.timing();
             tatum::write_echo(getEchoFileName(E_ECHO_ANALYSIS_TIMING_GRAPH),
-                              *timing_ctx.graph, *timing_ctx.constraints, *analysis_delay_calc, timing_info->analyzer());
+                              *timing_ctx.graph, *timing_ctx.constraints, *analysis_delay_calc, timing_info->analyzer(), getTimingGraphEchoAnonymized());
         }
 
         //Timing stats
@@ -1542,7 +1691,7 @@ void vpr_analysis(const Netlist<>& net_list,
         }
 
         if (vpr_setup.AnalysisOpts.generate_net_timing_report) {
-            generate_net_timing_report(/*prefix=*/"", *timing_info, *analysis_delay_calc);
+            generate_net_timing_report(/*prefix=*/"", *timing_info, *analysis_delay_calc, vpr_setup.AnalysisOpts.timing_report_compress);
         }
 
         //Do power analysis
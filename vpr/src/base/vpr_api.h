@@ -41,9 +41,20 @@
 void vpr_init(const int argc, const char** argv, t_options* options, t_vpr_setup* vpr_setup, t_arch* arch);
 void vpr_initialize_logging();
 void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_arch* arch);
+void vpr_load_circuit(const t_options* options, t_vpr_setup* vpr_setup, t_arch* arch);
 
 bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch); //Run the VPR CAD flow
 
+/**
+ * @brief Runs the VPR CAD flow in the context ctx rather than the default one (g_vpr_process_ctx).
+ *
+ * Flows in different contexts can run concurrently (e.g. on the circuits loaded in each context,
+ * with vpr_load_circuit() under a ScopedVprContext), sharing a fully built device which none of them
+ * modifies (i.e. with the RR graph already built for the channel width they route at). Some state is
+ * still per process: the echo files, the graphics and the output file name prefix.
+ */
+bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch, VprContext& ctx);
+
 /*
  * Stage operations
  */
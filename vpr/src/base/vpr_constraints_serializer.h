@@ -38,6 +38,7 @@
  */
 
 #include <regex>
+#include "atom_name_index.h"
 #include "region.h"
 #include "vpr_constraints.h"
 #include "partition.h"
@@ -131,40 +132,30 @@ class VprConstraintsSerializer final : public uxsd::VprConstraintsBase<VprConstr
 
     virtual inline void set_add_atom_name_pattern(const char* name_pattern, void*& /*ctx*/) final {
         auto& atom_ctx = g_vpr_ctx.atom();
-        std::string atom_name = name_pattern;
-
-        auto atom_name_regex = std::regex(atom_name);
-
-        atoms_.clear();
 
         atom_id_ = atom_ctx.netlist().find_block(name_pattern);
 
         /* The constraints file may either provide a specific atom name or a regex.
          * If the a valid atom ID is found for the atom name, then a specific atom name
-         * must have been read in from the file. The if condition checks for this case.
-         * The else statement checks for atoms that may match a regex.
-         * This code may get slow if many regexes are given in the file.
+         * must have been read in from the file.
+         * Otherwise the name might be a regular expression: it is compiled now, but matched
+         * against the atom names in finish_load(), together with all the other regexes of the
+         * file, so the atoms are only indexed once and the regexes can be matched in parallel.
          */
-        if (atom_id_ != AtomBlockId::INVALID()) {
-            atoms_.push_back(atom_id_);
-        } else {
-            /*If the atom name returns an invalid ID, it might be a regular expression, so loop through the atoms blocks
-             * and see if any block names match atom_name_regex.
-             */
-            for (auto block_id : atom_ctx.netlist().blocks()) {
-                auto block_name = atom_ctx.netlist().block_name(block_id);
-
-                if (std::regex_search(block_name, atom_name_regex)) {
-                    atoms_.push_back(block_id);
+        atom_pattern_index_ = -1;
+        if (atom_id_ == AtomBlockId::INVALID()) {
+            try {
+                atom_regexes_.emplace_back(name_pattern);
+            } catch (const std::regex_error& e) {
+                std::string msg = "Atom name pattern '" + std::string(name_pattern) + "' is not a valid regular expression: " + e.what();
+                if (report_error_ == nullptr) {
+                    VPR_ERROR(VPR_ERROR_PLACE, "\n%s\n", msg.c_str());
+                } else {
+                    report_error_->operator()(msg.c_str());
                 }
             }
-        }
-
-        /*If the atoms_ vector is empty by this point, no atoms were found that matched the name,
-         * so the name is invalid.
-         */
-        if (atoms_.empty()) {
-            VTR_LOG_WARN("Atom %s was not found, skipping atom.\n", name_pattern);
+            atom_patterns_.emplace_back(name_pattern);
+            atom_pattern_index_ = atom_patterns_.size() - 1;
         }
     }
 
@@ -247,11 +238,8 @@ class VprConstraintsSerializer final : public uxsd::VprConstraintsBase<VprConstr
     }
 
     virtual inline void finish_partition_add_atom(void*& /*ctx*/) final {
-        PartitionId part_id(num_partitions_);
-
-        for (auto atom : atoms_) {
-            constraints_.mutable_place_constraints().add_constrained_atom(atom, part_id);
-        }
+        // The atoms are constrained in finish_load(), in the order of the file
+        loaded_atoms_.push_back({PartitionId(num_partitions_), atom_id_, atom_pattern_index_});
     }
 
     virtual inline size_t num_partition_add_atom(partition_info& part_info) final {
@@ -492,6 +480,34 @@ class VprConstraintsSerializer final : public uxsd::VprConstraintsBase<VprConstr
             return false;
     }
     virtual void finish_load() final {
+        std::vector<std::vector<AtomBlockId>> pattern_atoms;
+        if (!atom_patterns_.empty()) {
+            AtomNameIndex atom_name_index(g_vpr_ctx.atom().netlist());
+            pattern_atoms = atom_name_index.find_matching_atoms(atom_patterns_, atom_regexes_);
+        }
+
+        UserPlaceConstraints& place_constraints = constraints_.mutable_place_constraints();
+        for (const t_loaded_atom& loaded_atom : loaded_atoms_) {
+            if (loaded_atom.pattern_index < 0) {
+                place_constraints.add_constrained_atom(loaded_atom.atom_id, loaded_atom.part_id);
+                continue;
+            }
+
+            /*If the atoms vector is empty, no atoms were found that matched the name,
+             * so the name is invalid.
+             */
+            const std::vector<AtomBlockId>& atoms = pattern_atoms[loaded_atom.pattern_index];
+            if (atoms.empty()) {
+                VTR_LOG_WARN("Atom %s was not found, skipping atom.\n", atom_patterns_[loaded_atom.pattern_index].c_str());
+            }
+            for (AtomBlockId atom : atoms) {
+                place_constraints.add_constrained_atom(atom, loaded_atom.part_id);
+            }
+        }
+
+        loaded_atoms_.clear();
+        atom_patterns_.clear();
+        atom_regexes_.clear();
     }
 
     //temp data for writes
@@ -522,5 +538,15 @@ class VprConstraintsSerializer final : public uxsd::VprConstraintsBase<VprConstr
 
     //used when reading in atom names and regular expressions for atoms
     AtomBlockId atom_id_;
-    std::vector<AtomBlockId> atoms_;
+    int atom_pattern_index_ = -1;
+
+    //an add_atom of a partition: either an atom found by name, or the index of a regex in atom_patterns_
+    struct t_loaded_atom {
+        PartitionId part_id;
+        AtomBlockId atom_id;
+        int pattern_index;
+    };
+    std::vector<t_loaded_atom> loaded_atoms_;
+    std::vector<std::string> atom_patterns_;
+    std::vector<std::regex> atom_regexes_;
 };
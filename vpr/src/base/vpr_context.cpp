@@ -13,6 +13,7 @@
 #include "physical_types.h"
 #include "place_constraints.h"
 #include "place_macro.h"
+#include "route_common.h"
 #include "rr_graph_utils.h"
 #include "vpr_types.h"
 #include "vtr_memory.h"
@@ -27,10 +28,20 @@
 static bool is_cube_bb(const e_place_bounding_box_mode place_bb_mode,
                        const RRGraphView& rr_graph);
 
+VprContext::VprContext()
+    : device_(std::make_shared<DeviceContext>()) {}
+
+VprContext::VprContext(std::shared_ptr<DeviceContext> device)
+    : device_(std::move(device)) {}
+
 void FloorplanningContext::update_floorplanning_context_post_pack() {
     // Initialize the cluster_constraints using the constraints loaded from the
     // user and clustering generated from packing.
     load_cluster_constraints();
+
+    // The grid masks of the previous cluster constraints (if any) are stale.
+    vtr::release_memory(cluster_constraint_masks);
+    vtr::release_memory(cluster_constraint_mask_ids);
 }
 
 void FloorplanningContext::update_floorplanning_context_pre_place(const PlaceMacros& place_macros) {
@@ -40,6 +51,9 @@ void FloorplanningContext::update_floorplanning_context_pre_place(const PlaceMac
 
     // Compute and store compressed floorplanning constraints.
     alloc_and_load_compressed_cluster_constraints();
+
+    // Precompute the grid masks of the floorplanning constraints.
+    alloc_and_load_cluster_constraint_masks();
 }
 
 void FloorplanningContext::clean_floorplanning_context_post_place() {
@@ -50,6 +64,9 @@ void FloorplanningContext::clean_floorplanning_context_post_place() {
     // The compressed cluster constraints are loaded in alloc_and_load_compressed
     // cluster_constraints and are not used outside of placement.
     vtr::release_memory(compressed_cluster_constraints);
+
+    vtr::release_memory(cluster_constraint_masks);
+    vtr::release_memory(cluster_constraint_mask_ids);
 }
 
 void PlacementContext::init_placement_context(const t_placer_opts& placer_opts,
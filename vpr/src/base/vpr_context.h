@@ -9,6 +9,7 @@
 #include "physical_types.h"
 #include "place_macro.h"
 #include "user_place_constraints.h"
+#include "partition_region_grid_mask.h"
 #include "user_route_constraints.h"
 #include "vpr_types.h"
 #include "vtr_cache.h"
@@ -17,6 +18,7 @@
 #include "vtr_vector_map.h"
 #include "atom_netlist.h"
 #include "clustered_netlist.h"
+#include "net_pins_csr.h"
 #include "rr_graph_view.h"
 #include "rr_graph_builder.h"
 #include "rr_node.h"
@@ -34,6 +36,7 @@
 #include "noc_traffic_flows.h"
 #include "noc_routing.h"
 #include "tatum/report/TimingPath.hpp"
+#include "tatum/report/TimingPathCache.hpp"
 #include "blk_loc_registry.h"
 
 #ifndef NO_SERVER
@@ -143,8 +146,24 @@ struct TimingContext : public Context {
 
     t_timing_analysis_profile_info stats;
 
+    ///@brief Protects stats, which the placers of a multi-seed placement update concurrently
+    mutable std::mutex stats_mutex;
+
     /* Represents whether or not VPR should fail if timing constraints aren't met. */
     bool terminate_if_timing_fails = false;
+
+    /**
+     * @brief The delay scale factor of each timing corner (see --timing_corner_delay_scales).
+     *
+     * The delay calculators scale each delay by these factors, so that every corner
+     * of the tatum::Time values propagated by the timing analyzers holds the timing
+     * of one corner. Corner 0 is the primary corner (nominal delays, scale 1) which
+     * is used by the optimizations.
+     */
+    tatum::Time corner_delay_scales = tatum::Time(1.);
+
+    ///@brief The number of timing corners analyzed (at most tatum::Time::num_corners())
+    size_t num_timing_corners = 1;
 };
 
 namespace std {
@@ -275,6 +294,13 @@ struct DeviceContext : public Context {
 
     bool rr_graph_is_flat = false;
 
+    /**
+     * @brief The channel widths the RR graph was built for, when its tracks above chan_width are masked off
+     *        (see mask_rr_graph_tracks()), and the original capacities of the masked tracks.
+     */
+    vtr::optional<t_chan_width> rr_graph_built_chan_width;
+    std::vector<std::pair<RRNodeId, short>> masked_rr_node_capacities;
+
     /*
      * Clock Networks
      */
@@ -368,6 +394,10 @@ struct ClusteringContext : public Context {
     ///        clustered block [0 .. num_clustered_blocks-1]
     /// This is populated when the packing is loaded.
     vtr::vector<ClusterBlockId, std::unordered_set<AtomBlockId>> atoms_lookup;
+
+    /// @brief Flat snapshot of the pins (and their blocks) of the nets of clb_nlist, shared by the
+    ///        placer and the router. Rebuilt whenever the nets or pins of clb_nlist change.
+    ClbNetPinsCsr clb_net_pins;
 };
 
 /**
@@ -674,6 +704,17 @@ struct FloorplanningContext : public Context {
      *
      */
     std::vector<vtr::vector<ClusterBlockId, PartitionRegion>> compressed_cluster_constraints;
+
+    /**
+     * @brief Grid masks of the distinct cluster constraints, for constant time floorplan legality checks.
+     *
+     * Many clusters share the PartitionRegion of their partition, so a mask is only built per distinct
+     * PartitionRegion. Empty if the masks would use too much memory.
+     */
+    std::vector<PartitionRegionGridMask> cluster_constraint_masks;
+
+    ///@brief [0..numClusters-1] Index of the mask of each cluster constraint in cluster_constraint_masks (-1 if unconstrained)
+    vtr::vector<ClusterBlockId, int> cluster_constraint_mask_ids;
 };
 
 /**
@@ -769,6 +810,14 @@ struct ServerContext : public Context {
      * @brief Reference to the PostClusterDelayCalculator calculated during the routing stage.
      */
     std::shared_ptr<PostClusterDelayCalculator> routing_delay_calc;
+
+    /**
+     * @brief Caches the worst timing paths of timing_info.
+     *
+     * Repeated path list requests (e.g. for a growing number of paths) then only trace the
+     * paths not requested before, until the timing analysis is updated.
+     */
+    std::shared_ptr<tatum::TimingPathCache> timing_path_cache;
 };
 #endif /* NO_SERVER */
 
@@ -778,6 +827,9 @@ struct ServerContext : public Context {
  * There is typically a single instance which is
  * accessed via the global variable g_vpr_ctx (see globals.h/.cpp).
  *
+ * Several flows can run in the same process, each in its own VprContext (see ScopedVprContext
+ * in globals.h). They can share the same (fully built) device, which none of them may modify.
+ *
  * It is divided up into separate sub-contexts of logically related data structures.
  *
  * Each sub-context can be accessed via member functions which return a reference to the sub-context:
@@ -822,11 +874,19 @@ struct ServerContext : public Context {
  */
 class VprContext : public Context {
   public:
+    VprContext();
+
+    ///@brief A context sharing the device of another one (e.g. VprContext(other.shared_device()))
+    explicit VprContext(std::shared_ptr<DeviceContext> device);
+
+    ///@brief The device, to share it with another context
+    std::shared_ptr<DeviceContext> shared_device() const { return device_; }
+
     const AtomContext& atom() const { return atom_; }
     AtomContext& mutable_atom() { return atom_; }
 
-    const DeviceContext& device() const { return device_; }
-    DeviceContext& mutable_device() { return device_; }
+    const DeviceContext& device() const { return *device_; }
+    DeviceContext& mutable_device() { return *device_; }
 
     const TimingContext& timing() const { return timing_; }
     TimingContext& mutable_timing() { return timing_; }
@@ -858,7 +918,7 @@ class VprContext : public Context {
 #endif /* NO_SERVER */
 
   private:
-    DeviceContext device_;
+    std::shared_ptr<DeviceContext> device_;
 
     AtomContext atom_;
 
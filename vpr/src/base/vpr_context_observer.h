@@ -0,0 +1,46 @@
+#pragma once
+/**
+ * @file
+ * @brief Makes the TBB worker threads of an arena work on a flow's context (see ScopedVprContext).
+ *
+ * A flow running in its own context (rather than the default one of the process) runs its parallel
+ * tasks in arenas whose workers must access the same context through g_vpr_ctx.
+ */
+
+#ifdef VPR_USE_TBB
+
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+
+#include "globals.h"
+
+class VprContextObserver : public tbb::task_scheduler_observer {
+  public:
+    /** The workers joining \p arena work on \p ctx */
+    VprContextObserver(tbb::task_arena& arena, VprContext& ctx)
+        : tbb::task_scheduler_observer(arena)
+        , _ctx(ctx) {
+        observe(true);
+    }
+
+    ~VprContextObserver() override {
+        observe(false);
+    }
+
+    void on_scheduler_entry(bool is_worker) override {
+        if (is_worker) {
+            g_vpr_thread_ctx = &_ctx;
+        }
+    }
+
+    void on_scheduler_exit(bool is_worker) override {
+        if (is_worker) {
+            g_vpr_thread_ctx = nullptr;
+        }
+    }
+
+  private:
+    VprContext& _ctx;
+};
+
+#endif
@@ -0,0 +1,275 @@
+#include "vpr_daemon.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__)
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef VPR_USE_TBB
+#include <new>
+#include <tbb/global_control.h>
+#endif
+
+#include "vtr_log.h"
+#include "vtr_error.h"
+#include "vtr_time.h"
+
+#include "tatum/error.hpp"
+
+#include "echo_files.h"
+#include "router_lookahead.h"
+#include "vpr_api.h"
+#include "vpr_error.h"
+#include "vpr_exit_codes.h"
+#include "vpr_tatum_error.h"
+
+#if defined(__unix__)
+
+/// @brief Longest job description accepted
+constexpr size_t MAX_DAEMON_JOB_SIZE = 1 << 16;
+
+/// @brief A job sent to the daemon
+struct t_daemon_job {
+    std::string working_dir;
+    std::string circuit_file;
+    std::string sdc_file; ///<Inferred from the circuit name if empty
+};
+
+/// @brief Builds the RR graph and the router lookahead, if they are the same for all the circuits.
+static void preload_device(t_vpr_setup& vpr_setup, const t_arch& arch) {
+    if (vpr_setup.device_layout == "auto" || vpr_setup.PlacerOpts.place_chan_width == NO_FIXED_CHANNEL_WIDTH
+        || vpr_setup.clock_modeling == DEDICATED_NETWORK || vpr_setup.NocOpts.noc) {
+        VTR_LOG("The RR graph depends on the circuits (no fixed device and channel width): each job builds its own\n");
+        return;
+    }
+
+    vtr::ScopedStartFinishTimer timer("Load the device for the daemon jobs");
+
+    vpr_create_device_grid(vpr_setup, arch);
+    vpr_create_rr_graph(vpr_setup, arch, vpr_setup.PlacerOpts.place_chan_width, false);
+
+    // The placer and the router start with the cached lookahead (flat routing is disabled in placement)
+    get_cached_router_lookahead(vpr_setup.RoutingArch,
+                                vpr_setup.RouterOpts.lookahead_type,
+                                vpr_setup.RouterOpts.write_router_lookahead,
+                                vpr_setup.RouterOpts.read_router_lookahead,
+                                vpr_setup.Segments,
+                                /*is_flat=*/false,
+                                vpr_setup.RouterOpts.route_verbosity,
+                                vpr_setup.RouterOpts.setup_cache_dir,
+                                vpr_setup.RouterOpts.lookahead_lazy,
+                                vpr_setup.RouterOpts.lookahead_quantized);
+
+    vpr_setup.reuse_rr_graph = true;
+}
+
+/// @brief Opens the socket the daemon listens on, replacing a stale one.
+static int open_daemon_socket(const std::string& socket_path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Daemon socket path '%s' is too long\n", socket_path.c_str());
+    }
+    strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+    int socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_fd < 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to create the daemon socket: %s\n", strerror(errno));
+    }
+
+    unlink(socket_path.c_str());
+    if (bind(socket_fd, (const sockaddr*)&address, sizeof(address)) != 0 || listen(socket_fd, SOMAXCONN) != 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to listen on the daemon socket '%s': %s\n", socket_path.c_str(), strerror(errno));
+    }
+    return socket_fd;
+}
+
+/// @brief Reads a job from a client connection. Returns false (with the reason in error) if it is not valid.
+static bool read_daemon_job(int connection_fd, t_daemon_job& job, std::string& error) {
+    std::string message;
+    char buffer[4096];
+    while (message.size() <= MAX_DAEMON_JOB_SIZE) {
+        ssize_t num_read = read(connection_fd, buffer, sizeof(buffer));
+        if (num_read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (num_read <= 0) {
+            break;
+        }
+        message.append(buffer, num_read);
+    }
+    if (message.size() > MAX_DAEMON_JOB_SIZE) {
+        error = "Job description too long";
+        return false;
+    }
+
+    // One non-empty line per field (a path may contain spaces, not surrounding ones)
+    std::vector<std::string> lines;
+    std::istringstream message_stream(message);
+    for (std::string line; std::getline(message_stream, line);) {
+        size_t begin = line.find_first_not_of(" \t\r");
+        if (begin != std::string::npos) {
+            lines.push_back(line.substr(begin, line.find_last_not_of(" \t\r") - begin + 1));
+        }
+    }
+    if (lines.size() < 2 || lines.size() > 3) {
+        error = "Expected the working directory, the circuit file and optionally the SDC file, one per line";
+        return false;
+    }
+
+    job.working_dir = lines[0];
+    job.circuit_file = lines[1];
+    job.sdc_file = lines.size() > 2 ? lines[2] : std::string();
+    return true;
+}
+
+/// @brief Points the options and the set up to the files of the job (named after its circuit, as for a VPR run).
+static void set_job_file_names(const t_daemon_job& job, t_options& options, t_vpr_setup& vpr_setup) {
+    using argparse::Provenance;
+
+    options.CircuitName.set(job.circuit_file, Provenance::SPECIFIED);
+    // The file names of the daemon's own circuit are not reused, even if they were specified
+    for (argparse::ArgValue<std::string>* file : {&options.CircuitFile, &options.SDCFile, &options.NetFile,
+                                                  &options.PlaceFile, &options.RouteFile, &options.FlatPlaceFile,
+                                                  &options.ActFile, &options.PowerFile}) {
+        file->set(std::string(), Provenance::DEFAULT);
+    }
+    if (!job.sdc_file.empty()) {
+        options.SDCFile.set(job.sdc_file, Provenance::SPECIFIED);
+    }
+    set_conditional_defaults(options);
+
+    t_file_name_opts& file_name_opts = vpr_setup.FileNameOpts;
+    file_name_opts.CircuitName = options.CircuitName;
+    file_name_opts.CircuitFile = options.CircuitFile;
+    file_name_opts.NetFile = options.NetFile;
+    file_name_opts.FlatPlaceFile = options.FlatPlaceFile;
+    file_name_opts.PlaceFile = options.PlaceFile;
+    file_name_opts.RouteFile = options.RouteFile;
+    file_name_opts.ActFile = options.ActFile;
+    file_name_opts.PowerFile = options.PowerFile;
+    vpr_setup.Timing.SDCFile = options.SDCFile;
+    vpr_setup.PackerOpts.output_file = options.NetFile;
+    vpr_setup.PackerOpts.circuit_file_name = options.CircuitFile;
+
+    free_output_file_names();
+    alloc_and_load_output_file_names(options.CircuitName);
+}
+
+/// @brief Runs a job in the (forked) job process, and returns its exit code.
+static int run_daemon_job(const t_daemon_job& job, t_options& options, t_vpr_setup& vpr_setup, t_arch& arch) {
+    try {
+        if (chdir(job.working_dir.c_str()) != 0) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to enter the job directory '%s': %s\n", job.working_dir.c_str(), strerror(errno));
+        }
+        // The log file goes to the job directory
+        vpr_initialize_logging();
+
+        VTR_LOG("VPR daemon job: circuit %s in %s\n", job.circuit_file.c_str(), job.working_dir.c_str());
+        set_job_file_names(job, options, vpr_setup);
+        vpr_load_circuit(&options, &vpr_setup, &arch);
+
+        if (!vpr_flow(vpr_setup, arch)) {
+            VTR_LOG("VPR failed to implement circuit\n");
+            return UNIMPLEMENTABLE_EXIT_CODE;
+        }
+        VTR_LOG("VPR succeeded\n");
+        return SUCCESS_EXIT_CODE;
+
+    } catch (const tatum::Error& tatum_error) {
+        VTR_LOG_ERROR("%s\n", format_tatum_error(tatum_error).c_str());
+    } catch (const VprError& vpr_error) {
+        vpr_print_error(vpr_error);
+    } catch (const vtr::VtrError& vtr_error) {
+        VTR_LOG_ERROR("%s:%d %s\n", vtr_error.filename_c_str(), vtr_error.line(), vtr_error.what());
+    }
+    return ERROR_EXIT_CODE;
+}
+
+void vpr_daemon(const t_options& options, t_vpr_setup& vpr_setup, t_arch& arch) {
+    preload_device(vpr_setup, arch);
+
+#ifdef VPR_USE_TBB
+    // The worker threads are not forked with the daemon: they must be stopped for the jobs
+    // to start their own (the daemon does not use them anymore).
+    tbb::task_scheduler_handle tbb_handle(tbb::attach{});
+    if (!tbb::finalize(tbb_handle, std::nothrow)) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to stop the worker threads before serving the daemon jobs\n");
+    }
+#endif
+
+    int socket_fd = open_daemon_socket(options.daemon_socket);
+
+    // The job processes are reaped by the system
+    signal(SIGCHLD, SIG_IGN);
+
+    VTR_LOG("VPR daemon listening on '%s'\n", options.daemon_socket.value().c_str());
+    while (true) {
+        int connection_fd = accept(socket_fd, nullptr, nullptr);
+        if (connection_fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to accept a daemon job: %s\n", strerror(errno));
+        }
+
+        t_daemon_job job;
+        std::string error;
+        if (!read_daemon_job(connection_fd, job, error)) {
+            VTR_LOG_WARN("Rejected a daemon job: %s\n", error.c_str());
+            std::string reply = "Error: " + error + "\nVPR daemon job exit code: " + std::to_string(ERROR_EXIT_CODE) + "\n";
+            (void)!write(connection_fd, reply.data(), reply.size());
+            close(connection_fd);
+            continue;
+        }
+
+        // Nothing buffered is to be written again by the job
+        fflush(stdout);
+        fflush(stderr);
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            // The job process: its output goes to the client
+            close(socket_fd);
+            signal(SIGCHLD, SIG_DFL);
+            signal(SIGPIPE, SIG_IGN); // The job still completes if the client goes away
+            dup2(connection_fd, STDOUT_FILENO);
+            dup2(connection_fd, STDERR_FILENO);
+            close(connection_fd);
+            setvbuf(stdout, nullptr, _IOLBF, 0);
+
+            // The options of the daemon, with the file names of the job
+            t_options job_options = options;
+            int exit_code = run_daemon_job(job, job_options, vpr_setup, arch);
+
+            printf("VPR daemon job exit code: %d\n", exit_code);
+            exit(exit_code);
+        }
+
+        if (pid < 0) {
+            VTR_LOG_WARN("Failed to start a process for the daemon job '%s': %s\n", job.circuit_file.c_str(), strerror(errno));
+        } else {
+            VTR_LOG("Started daemon job %d: %s in %s\n", (int)pid, job.circuit_file.c_str(), job.working_dir.c_str());
+        }
+        close(connection_fd);
+    }
+}
+
+#else
+
+void vpr_daemon(const t_options& /*options*/, t_vpr_setup& /*vpr_setup*/, t_arch& /*arch*/) {
+    VPR_FATAL_ERROR(VPR_ERROR_OTHER, "The daemon mode (--daemon_socket) is only supported on POSIX systems\n");
+}
+
+#endif
@@ -0,0 +1,36 @@
+#pragma once
+
+/**
+ * @file
+ * @brief A daemon implementing many circuits on the same device.
+ *
+ * Loading the architecture, building the RR graph and computing the router lookahead can take
+ * longer than implementing a small circuit. With --daemon_socket, VPR loads them once and then
+ * serves jobs sent over a Unix domain socket, each one implementing a circuit with the options
+ * the daemon was started with.
+ *
+ * Each job runs in a process forked from the daemon: it starts from a copy of the loaded device,
+ * and its changes to the (global) contexts never leak into the daemon or the other jobs.
+ *
+ * A job is sent as lines of text, after which the client shuts down its side of the connection:
+ *
+ *      <working directory of the job>
+ *      <circuit file>
+ *      [<SDC file>]
+ *
+ * e.g. `printf '%s\n%s\n' "$PWD" design.blif | nc -NU vpr.sock`. The output files are named
+ * after the circuit and written to the working directory. The log of the job is sent back,
+ * ending with a line 'VPR daemon job exit code: <code>'.
+ */
+
+#include "physical_types.h"
+#include "read_options.h"
+#include "vpr_types.h"
+
+/**
+ * @brief Serves the jobs sent to the socket options.daemon_socket, which never returns.
+ *
+ * The RR graph and the router lookahead are built before serving if they do not depend on the
+ * circuits: with a fixed device layout (--device) and channel width (--route_chan_width).
+ */
+void vpr_daemon(const t_options& options, t_vpr_setup& vpr_setup, t_arch& arch);
@@ -84,15 +84,16 @@ void vpr_signal_handler(int /*signal*/) {
 #endif
 
 void checkpoint() {
-    //Dump the current placement and routing state
+    //Dump the current placement and routing state. The files are written synchronously: VPR may
+    //exit right after, and the background writer may be held by the interrupted thread.
     vtr::ScopedStartFinishTimer timer("Checkpointing");
 
     safe_write("Attempting to checkpoint current placement to file: placer_checkpoint.place\n");
-    print_place(nullptr, nullptr, "placer_checkpoint.place", g_vpr_ctx.placement().block_locs());
+    print_place(nullptr, nullptr, "placer_checkpoint.place", g_vpr_ctx.placement().block_locs(), true, true);
 
     bool is_flat = g_vpr_ctx.routing().is_flat;
     const Netlist<>& router_net_list = is_flat ? (const Netlist<>&)g_vpr_ctx.atom().netlist() : (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
 
     safe_write("Attempting to checkpoint current routing to file: router_checkpoint.route\n");
-    print_route(router_net_list, nullptr, "router_checkpoint.route", is_flat);
+    print_route(router_net_list, nullptr, "router_checkpoint.route", is_flat, true);
 }
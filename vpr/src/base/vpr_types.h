@@ -668,6 +668,9 @@ struct t_file_name_opts {
     std::string FlatPlaceFile;
     std::string PlaceFile;
     std::string RouteFile;
+    ///@brief Copies of the loaded placement/routing to write, in the binary format if the name ends with '.bin'
+    std::string write_place_file;
+    std::string write_route_file;
     std::string FPGAInterchangePhysicalFile;
     std::string ActFile;
     std::string PowerFile;
@@ -681,6 +684,8 @@ struct t_file_name_opts {
     std::string write_legalized_flat_place_file;
     std::string write_block_usage;
     bool verify_file_digests;
+    ///@brief Whether a binary copy of the packed netlist is kept next to the .net file (see read_netlist())
+    bool binary_net_file;
 };
 
 ///@brief Options for netlist loading
@@ -692,7 +697,8 @@ struct t_netlist_opts {
     bool sweep_dangling_nets = true;
     bool sweep_constant_primary_outputs = false;
 
-    int netlist_verbosity = 1; ///<Verbose output during netlist cleaning
+    int netlist_verbosity = 1;    ///<Verbose output during netlist cleaning
+    bool mmap_blif_parser = true; ///<Whether BLIF files are parsed with the memory-mapped parser (otherwise libblifparse)
 };
 
 /**
@@ -800,6 +806,10 @@ struct t_packer_opts {
     std::vector<std::string> high_fanout_threshold;
     int transitive_fanout_threshold;
     int feasible_block_array_size;
+    int num_partitions;         ///<Number of netlist partitions clustered in parallel
+    int speculative_candidates; ///<Number of candidate molecules tried in parallel on replicas of a cluster
+    bool profile;               ///<Report the time spent in each phase of the clustering, by logical block type
+    std::string eco_net_file;   ///<Packed netlist of a previous version of the circuit whose clustering is reused ("" for none)
     e_stage_action doPacking;
     std::string device_layout;
     e_timing_update_type timing_update_type;
@@ -1057,13 +1067,23 @@ struct t_placer_opts {
     float td_place_exp_last;
     e_stage_action doPlacement;
     float rlim_escape_fraction;
+    int speculative_moves; ///<Number of moves proposed and evaluated concurrently by the annealer
+    int parallel_regions;  ///<Number of regions along each device dimension annealed in parallel
+    int num_seeds;         ///<Number of placements with different seeds run concurrently, the best one being kept
+    float seed_stop_ratio; ///<A seed stops annealing when its quality is this factor worse than the best one at the same temperature (0 for never)
+    float anneal_convergence_threshold; ///<The anneal ends when the predicted relative cost improvement of the next temperature is below this (0 for never)
+    bool numa_aware_threads; ///<Keep each parallel region on the same (NUMA-pinned) worker
+    std::string eco_place_file; ///<Placement of a previous version of the circuit to place incrementally from ("" for none)
+    int eco_window;             ///<Distance (in tiles) around the changed blocks within which blocks move in an incremental placement
     std::string move_stats_file;
+    std::string move_profile_file; ///<CSV file to write the per temperature profile of each move type to
     int placement_saves_per_temperature;
     e_place_effort_scaling effort_scaling;
     e_timing_update_type timing_update_type;
 
     PlaceDelayModelType delay_model_type;
     e_reducer delay_model_reducer;
+    bool place_delay_model_background; ///<Compute the placement delay model while the initial placement runs
 
     float delay_offset;
     int delay_ramp_delta_threshold;
@@ -1086,6 +1106,7 @@ struct t_placer_opts {
     e_agent_algorithm place_agent_algorithm;
     float place_agent_epsilon;
     float place_agent_gamma;
+    int place_agent_batch_size; ///<Number of moves the softmax agent proposes from the same action probabilities
     float place_dm_rlim;
     e_agent_space place_agent_space;
     std::string place_reward_fun;
@@ -1124,6 +1145,8 @@ struct t_placer_opts {
  *   @param doAnalyticalPlacement
  *              True if analytical placement is supposed to be done in the CAD
  *              flow. False if otherwise.
+ *   @param global_placer_type
+ *              The type of Global Placer the AP flow will use.
  *   @param analytical_solver_type
  *              The type of analytical solver the Global Placer in the AP flow
  *              will use.
@@ -1156,10 +1179,19 @@ struct t_placer_opts {
  *              values leading to more verbose messages.
  *   @param generate_mass_report
  *              Whether to generate a mass report during global placement or not.
+ *   @param write_partial_placement_file
+ *              The checkpoint file to write the partial placement to after
+ *              global placement. Empty if no checkpoint should be written.
+ *   @param read_partial_placement_file
+ *              The checkpoint file to read the partial placement from instead
+ *              of running global placement. Empty if global placement should
+ *              be run.
  */
 struct t_ap_opts {
     e_stage_action doAP;
 
+    e_ap_global_placer global_placer_type;
+
     e_ap_analytical_solver analytical_solver_type;
 
     e_ap_partial_legalizer partial_legalizer_type;
@@ -1183,6 +1215,10 @@ struct t_ap_opts {
     int log_verbosity;
 
     bool generate_mass_report;
+
+    std::string write_partial_placement_file;
+
+    std::string read_partial_placement_file;
 };
 
 /******************************************************************
@@ -1243,13 +1279,16 @@ enum e_router_algorithm {
     NESTED,
     PARALLEL,
     PARALLEL_DECOMP,
+    DISTRIBUTED,
+    GPU_BATCH,
     TIMING_DRIVEN,
 };
 
 enum e_routing_failure_predictor {
     OFF,
     SAFE,
-    AGGRESSIVE
+    AGGRESSIVE,
+    PRODUCTION ///<AGGRESSIVE, plus aborting stalled routings and skipping channel widths predicted to fail
 };
 
 // How to allocate budgets, and if RCV should be enabled
@@ -1301,6 +1340,8 @@ constexpr int NO_FIXED_CHANNEL_WIDTH = -1;
 struct t_router_opts {
     bool read_rr_edge_metadata = false;
     bool do_check_rr_graph = true;
+    bool check_rr_graph_trusted_digest = false; ///<Skip checking a loaded RR graph identical to one checked before (see setup_cache_dir)
+    bool masked_chan_width_search = false;      ///<Reuse the RR graph built for a wider channel width by masking off its extra tracks
     float first_iter_pres_fac;
     float initial_pres_fac;
     float pres_fac_mult;
@@ -1325,10 +1366,16 @@ struct t_router_opts {
     int multi_queue_num_threads;
     int multi_queue_num_queues;
     bool multi_queue_direct_draining;
+    int multi_queue_stickiness;     ///<Consecutive pops a parallel connection router thread makes from the same queue
+    int multi_queue_pop_batch_size; ///<Nodes a parallel connection router thread pops from a queue at once
+    bool router_partition_node_batching; ///<Route disjoint nets inside a partition tree node in parallel (parallel router only)
+    bool router_deterministic_parallel;  ///<Make the parallel routers' results independent of thread timing
+    bool numa_aware_threads;             ///<Route each NUMA node's partition tree regions on its own pinned workers (parallel router only)
     float max_criticality;
     float criticality_exp;
     float init_wirelength_abort_threshold;
     bool verify_binary_search;
+    int chan_width_search_jobs; ///<Number of channel widths the minimum channel width search routes concurrently
     bool full_stats;
     bool congestion_analysis;
     bool fanout_analysis;
@@ -1337,18 +1384,34 @@ struct t_router_opts {
     enum e_routing_failure_predictor routing_failure_predictor;
     enum e_routing_budgets_algorithm routing_budgets_algorithm;
     bool save_routing_per_iteration;
+    std::string route_checkpoint_file; ///<File the router checkpoints its state to (none if empty)
+    int route_checkpoint_interval;     ///<Number of routing iterations between checkpoints
+    bool resume_routing;               ///<Whether to resume routing from route_checkpoint_file
+    std::string eco_route_file;        ///<Routing of a previous version of the circuit to route incrementally from ("" for none)
     float congested_routing_iteration_threshold_frac;
     e_route_bb_update route_bb_update;
     enum e_clock_modeling clock_modeling; ///<How clock pins and nets should be handled
     bool two_stage_clock_routing;         ///<How clock nets on dedicated networks should be routed
     int high_fanout_threshold;
     float high_fanout_max_slope;
+    bool high_fanout_skeleton; ///<Whether high fanout nets are routed skeleton first (see skeleton_first_order())
+    std::string net_profile_file; ///<CSV file the per-net routing profile is written to (none if empty)
     int router_debug_net;
     int router_debug_sink_rr;
     int router_debug_iteration;
     e_router_lookahead lookahead_type;
+    bool lookahead_lazy;         ///<Compute the cost maps of the extended map lookahead on demand
+    bool lookahead_quantized;    ///<Query the compressed map lookahead from 16-bit quantized cost maps
+    int lookahead_cache_entries; ///<Number of lookahead costs memoized by each serial connection router (0 for none)
     double initial_acc_cost_chan_congestion_threshold;
     double initial_acc_cost_chan_congestion_weight;
+    bool global_route_prepass;   ///<Run a coarse-grid global routing before PathFinder to set the net bounding boxes and initial acc_cost
+    int global_route_gcell_size; ///<Width and height (in grid tiles) of the cells of the global routing grid
+    bool bidirectional_search;                 ///<Route long, non-critical connections with a bidirectional (forward and reverse) search
+    int bidirectional_search_min_distance;     ///<Minimum source to sink distance (in tiles) of the connections routed bidirectionally
+    float bidirectional_search_max_criticality; ///<Maximum criticality of the connections routed bidirectionally
+    bool clock_tree_routing;                   ///<Route the sinks of two-stage routed clock nets by walking the dedicated clock network
+    float batch_max_criticality;               ///<Maximum criticality of the connections routed along the paths of the gpu_batch router's batch search
     int max_convergence_count;
     int route_verbosity;
     float reconvergence_cpd_threshold;
@@ -1364,6 +1427,9 @@ struct t_router_opts {
     std::string write_intra_cluster_router_lookahead;
     std::string read_intra_cluster_router_lookahead;
 
+    ///@brief Directory of the on-disk cache of router lookaheads and placement delay models (empty to disable)
+    std::string setup_cache_dir;
+
     e_heap_type router_heap;
     bool exit_after_first_routing_iteration;
 
@@ -1386,6 +1452,9 @@ struct t_router_opts {
     int reorder_rr_graph_nodes_threshold = 0;
     int reorder_rr_graph_nodes_seed = 1;
 
+    /// Drop the per-edge source node array of the RR graph to save memory
+    bool compress_rr_graph_edges = false;
+
     bool generate_router_lookahead_report;
 };
 
@@ -1402,6 +1471,7 @@ struct t_analysis_opts {
     int timing_report_npaths;
     e_timing_report_detail timing_report_detail;
     bool timing_report_skew;
+    bool timing_report_compress;
     std::string echo_dot_timing_graph_node;
     std::string write_timing_summary;
     bool generate_net_timing_report;
@@ -1422,11 +1492,16 @@ struct t_noc_opts {
     double noc_congestion_weighting;               ///<controls the significance of the link congestions relative to the other NoC placement costs range:[0-inf)
     double noc_centroid_weight;                    ///<controls how much the centroid location is adjusted towards NoC routers in NoC-biased centroid move:[0, 1]
     int noc_swap_percentage;                       ///<controls the number of NoC router block swap attempts relative to the total number of swaps attempted by the placer range:[0-100]
+    int noc_initial_placement_speculative_moves;   ///<the number of router swaps proposed and evaluated concurrently by the initial NoC placement anneal
     int noc_sat_routing_bandwidth_resolution;      ///<if this number is N, the SAT formulation models link utilization in increments of 1/N
     int noc_sat_routing_latency_overrun_weighting; ///<controls the importance of reducing traffic flow latency overrun in SAT routing [0-inf)
     int noc_sat_routing_congestion_weighting;      ///<controls the importance of reducing the number of congested NoC links in SAT routing [0-inf)
     int noc_sat_routing_num_workers;               ///<the number of parallel worker threads that the SAT solver can use to explore the solution space
+    double noc_sat_routing_time_limit;             ///<the time budget (in seconds) of one SAT routing invocation. 0 means no limit
     bool noc_sat_routing_log_search_progress;      ///<indicates whether the detailed log of the SAT solver's search progress in printed
+    bool noc_simulation;                           ///<indicates whether the placed NoC is simulated to report packet latencies and link saturation
+    int noc_simulation_cycles;                     ///<the number of cycles simulated by the NoC simulator
+    double noc_simulation_packet_size;             ///<the size (in bits) of the packets simulated by the NoC simulator
     std::string noc_placement_file_name;           ///<is the name of the output file that contains the NoC placement information
 };
 
@@ -1590,7 +1665,9 @@ struct t_non_configurable_rr_sets {
 
 ///@brief Power estimation options
 struct t_power_opts {
-    bool do_power; ///<Perform power estimation?
+    bool do_power;                  ///<Perform power estimation?
+    bool estimate_activity;         ///<Estimate the signal activities by simulation (rather than reading the activity file)?
+    int activity_estimation_cycles; ///<Number of cycles simulated per vector stream when estimating the activities
 };
 
 /** @brief Channel width data
@@ -1641,6 +1718,10 @@ struct t_vpr_setup {
     bool two_stage_clock_routing;              ///<How clocks should be routed in the presence of a dedicated clock network
     bool exit_before_pack;                     ///<Exits early before starting packing (useful for collecting statistics without running/loading any stages)
     unsigned int num_workers;                  ///Maximum number of worker threads (determined from an env var or cmdline option)
+    std::string profile_trace_file;            ///<File to write the profiling zones to (profiling is off if empty)
+    bool report_memory_usage;                  ///<Report the memory held by the major data structures after each stage
+    bool numa_aware_threads;                   ///<Pin the worker threads to NUMA nodes
+    bool reuse_rr_graph = false;               ///<Reuse the RR graph already built for the device (set for the jobs of a daemon)
 };
 
 class RouteStatus {
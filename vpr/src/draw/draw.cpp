@@ -95,6 +95,7 @@ static void set_block_text(GtkWidget* widget, gint /*response_id*/, gpointer /*d
 static void set_draw_partitions(GtkWidget* widget, gint /*response_id*/, gpointer /*data*/);
 static void clip_routing_util(GtkWidget* widget, gint /*response_id*/, gpointer /*data*/);
 static void run_graphics_commands(const std::string& commands);
+static void request_draw_routing_snapshot();
 
 /************************** File Scope Variables ****************************/
 
@@ -137,6 +138,11 @@ ezgl::point2d point_1(0, 0);
 ezgl::rectangle initial_world;
 std::string rr_highlight_message;
 
+/* The routing draw data prepared off the render callback (see update_screen()), and the rr node
+ * properties they are prepared from (gathered once per rr graph) */
+static DrawRoutingSnapshotPreparer routing_snapshot_preparer;
+static std::shared_ptr<const vtr::vector<RRNodeId, t_draw_rr_node_info>> routing_snapshot_rr_nodes;
+
 #endif // NO_GRAPHICS
 
 /********************** Subroutine definitions ******************************/
@@ -347,6 +353,13 @@ void update_screen(ScreenUpdatePriority priority,
     //the user won't need to click manually.
     draw_state->auto_proceed = (state_change && !should_pause);
 
+    //The routing draw data is prepared in the background, from a copy of the routing state: the
+    //router does not wait for it, and the screen is refreshed with the latest complete one. When
+    //pausing for user interaction, the data of this update is waited for.
+    if (draw_state->show_graphics && draw_state->pic_on_screen == e_pic_type::ROUTING) {
+        request_draw_routing_snapshot();
+    }
+
     if (state_change                   //Must update buttons
         || should_pause                //The priority means graphics should pause for user interaction
         || draw_state->forced_pause) { //The user asked to pause
@@ -356,6 +369,7 @@ void update_screen(ScreenUpdatePriority priority,
             draw_state->forced_pause = false; //Reset pause flag
         }
 
+        routing_snapshot_preparer.wait();
         application.run(on_stage_change_setup, act_on_mouse_press, act_on_mouse_move,
                         act_on_key_press);
 
@@ -450,6 +464,9 @@ void free_draw_structs() {
         vtr::release_memory(draw_coords->tile_y);
     }
 
+    routing_snapshot_preparer.clear();
+    routing_snapshot_rr_nodes.reset();
+
 #else
     ;
 #endif /* NO_GRAPHICS */
@@ -482,6 +499,9 @@ void init_draw_coords(float clb_width, const BlkLocRegistry& blk_loc_registry) {
             draw_state->draw_rr_node[inode].node_highlighted = false;
         }
     }
+    draw_state->rr_spatial_index.clear();
+    routing_snapshot_preparer.clear();
+    routing_snapshot_rr_nodes.reset();
 
     draw_coords->set_tile_width(clb_width);
     draw_coords->pin_size = 0.3;
@@ -827,6 +847,66 @@ ezgl::color to_ezgl_color(vtr::Color<float> color) {
     return ezgl::color(color.r * 255, color.g * 255, color.b * 255);
 }
 
+/* Hands a copy of the rr node occupancies over to the routing snapshot preparation */
+static void request_draw_routing_snapshot() {
+    const DeviceContext& device_ctx = g_vpr_ctx.device();
+    const RRGraphView& rr_graph = device_ctx.rr_graph;
+    const RoutingContext& route_ctx = g_vpr_ctx.routing();
+
+    if (rr_graph.num_nodes() == 0 || route_ctx.rr_node_route_inf.size() != rr_graph.num_nodes()) {
+        return; //Routing not allocated
+    }
+
+    if (!routing_snapshot_rr_nodes) {
+        auto rr_nodes = std::make_shared<vtr::vector<RRNodeId, t_draw_rr_node_info>>(rr_graph.num_nodes());
+        for (RRNodeId inode : rr_graph.nodes()) {
+            (*rr_nodes)[inode] = {rr_graph.node_type(inode),
+                                  (short)rr_graph.node_xlow(inode),
+                                  (short)rr_graph.node_xhigh(inode),
+                                  (short)rr_graph.node_ylow(inode),
+                                  (short)rr_graph.node_yhigh(inode),
+                                  (short)rr_graph.node_layer_low(inode),
+                                  rr_graph.node_capacity(inode)};
+        }
+        routing_snapshot_rr_nodes = std::move(rr_nodes);
+    }
+
+    t_draw_routing_inputs inputs;
+    inputs.rr_nodes = routing_snapshot_rr_nodes;
+    inputs.grid_width = device_ctx.grid.width();
+    inputs.grid_height = device_ctx.grid.height();
+    inputs.num_layers = device_ctx.grid.get_num_layers();
+    inputs.occ.resize(rr_graph.num_nodes());
+    for (RRNodeId inode : rr_graph.nodes()) {
+        inputs.occ[inode] = route_ctx.rr_node_route_inf[inode].occ();
+    }
+
+    routing_snapshot_preparer.request(std::move(inputs));
+}
+
+std::shared_ptr<const t_draw_routing_snapshot> get_draw_routing_snapshot() {
+    if (!routing_snapshot_preparer.has_requests()) {
+        request_draw_routing_snapshot();
+    }
+
+    std::shared_ptr<const t_draw_routing_snapshot> snapshot = routing_snapshot_preparer.latest();
+    if (!snapshot) {
+        routing_snapshot_preparer.wait();
+        snapshot = routing_snapshot_preparer.latest();
+    }
+    return snapshot;
+}
+
+std::vector<bool> get_draw_layer_visibility() {
+    t_draw_state* draw_state = get_draw_state_vars();
+
+    std::vector<bool> visible_layers;
+    for (const t_draw_layer_display& layer_display : draw_state->draw_layer_display) {
+        visible_layers.push_back(layer_display.visible);
+    }
+    return visible_layers;
+}
+
 static float get_router_expansion_cost(const t_rr_node_route_inf& node_inf,
                                        e_draw_router_expansion_cost draw_router_expansion_cost) {
     if (draw_router_expansion_cost == DRAW_ROUTER_EXPANSION_COST_TOTAL
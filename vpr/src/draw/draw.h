@@ -27,6 +27,7 @@
 
 #ifndef NO_GRAPHICS
 
+#include "draw_routing_snapshot.h"
 #include "draw_types.h"
 #include "ezgl/application.hpp"
 #include "ezgl/point.hpp"
@@ -108,6 +109,14 @@ ezgl::point2d tnode_draw_coord(tatum::NodeId node);
 /* Converts a vtr Color to a ezgl Color. */
 ezgl::color to_ezgl_color(vtr::Color<float> color);
 
+/* Returns the latest routing draw data (channel utilization and congestion), prepared in the
+ * background since the last screen update. It is prepared on the spot if there is none yet,
+ * and is nullptr if the routing is not allocated. */
+std::shared_ptr<const t_draw_routing_snapshot> get_draw_routing_snapshot();
+
+/* Returns the visibility of each layer, as used by t_draw_routing_snapshot::channel_usage() */
+std::vector<bool> get_draw_layer_visibility();
+
 /* This helper function determines whether a net has been highlighted. The highlighting
  * could be caused by the user clicking on a routing resource, toggled, or
  * fan-in/fan-out of a highlighted node. */
@@ -297,22 +297,20 @@ void draw_congestion(ezgl::renderer* g) {
         return;
     }
 
+    //The congested nodes come sorted in ascending order of congestion, so that high valued nodes are
+    //not overdrawn by lower value ones (e.g-> when zoomed-out far)
+    std::shared_ptr<const t_draw_routing_snapshot> routing_snapshot = get_draw_routing_snapshot();
+    if (!routing_snapshot) {
+        return;
+    }
+
     const DeviceContext& device_ctx = g_vpr_ctx.device();
     const RRGraphView& rr_graph = device_ctx.rr_graph;
-    const RoutingContext& route_ctx = g_vpr_ctx.routing();
 
     //Record min/max congestion
     float min_congestion_ratio = 1.;
-    float max_congestion_ratio = min_congestion_ratio;
-    std::vector<RRNodeId> congested_rr_nodes = collect_congested_rr_nodes();
-    for (RRNodeId inode : congested_rr_nodes) {
-        short occ = route_ctx.rr_node_route_inf[inode].occ();
-        short capacity = rr_graph.node_capacity(inode);
-
-        float congestion_ratio = float(occ) / capacity;
-
-        max_congestion_ratio = std::max(max_congestion_ratio, congestion_ratio);
-    }
+    float max_congestion_ratio = routing_snapshot->max_congestion_ratio;
+    const std::vector<RRNodeId>& congested_rr_nodes = routing_snapshot->congested_rr_nodes;
 
     char msg[vtr::bufsize];
     if (draw_state->show_congestion == DRAW_CONGESTED) {
@@ -325,22 +323,6 @@ void draw_congestion(ezgl::renderer* g) {
 
     std::shared_ptr<vtr::ColorMap> cmap = std::make_shared<vtr::PlasmaColorMap>(min_congestion_ratio, max_congestion_ratio);
 
-    //Sort the nodes in ascending order of value for drawing, this ensures high
-    //valued nodes are not overdrawn by lower value ones (e.g-> when zoomed-out far)
-    auto cmp_ascending_acc_cost = [&](RRNodeId lhs_node, RRNodeId rhs_node) {
-        short lhs_occ = route_ctx.rr_node_route_inf[lhs_node].occ();
-        short lhs_capacity = rr_graph.node_capacity(lhs_node);
-
-        short rhs_occ = route_ctx.rr_node_route_inf[rhs_node].occ();
-        short rhs_capacity = rr_graph.node_capacity(rhs_node);
-
-        float lhs_cong_ratio = float(lhs_occ) / lhs_capacity;
-        float rhs_cong_ratio = float(rhs_occ) / rhs_capacity;
-
-        return lhs_cong_ratio < rhs_cong_ratio;
-    };
-    std::stable_sort(congested_rr_nodes.begin(), congested_rr_nodes.end(), cmp_ascending_acc_cost);
-
     if (draw_state->show_congestion == DRAW_CONGESTED_WITH_NETS) {
         auto rr_node_nets = collect_rr_node_nets();
 
@@ -364,18 +346,15 @@ void draw_congestion(ezgl::renderer* g) {
     }
 
     //Draw each congested node
-    for (RRNodeId inode : congested_rr_nodes) {
+    for (size_t icongested = 0; icongested < congested_rr_nodes.size(); icongested++) {
+        RRNodeId inode = congested_rr_nodes[icongested];
         int layer_num = rr_graph.node_layer_low(inode);
         int transparency_factor = get_rr_node_transparency(inode);
         if (!draw_state->draw_layer_display[layer_num].visible)
             continue;
-        short occ = route_ctx.rr_node_route_inf[inode].occ();
-        short capacity = rr_graph.node_capacity(inode);
 
-        float congestion_ratio = float(occ) / capacity;
-
-        bool node_congested = (occ > capacity);
-        VTR_ASSERT(node_congested);
+        float congestion_ratio = routing_snapshot->congestion_ratios[icongested];
+        VTR_ASSERT(congestion_ratio > 1.);
 
         ezgl::color color = to_ezgl_color(cmap->color(congestion_ratio));
         color.alpha = transparency_factor;
@@ -785,14 +764,20 @@ void draw_routing_util(ezgl::renderer* g) {
         return;
     }
 
+    std::shared_ptr<const t_draw_routing_snapshot> routing_snapshot = get_draw_routing_snapshot();
+    if (!routing_snapshot) {
+        return;
+    }
+
     t_draw_coords* draw_coords = get_draw_coords_vars();
     const DeviceContext& device_ctx = g_vpr_ctx.device();
 
-    auto chanx_usage = calculate_routing_usage(e_rr_type::CHANX, draw_state->is_flat, false);
-    auto chany_usage = calculate_routing_usage(e_rr_type::CHANY, draw_state->is_flat, false);
+    std::vector<bool> visible_layers = get_draw_layer_visibility();
+    auto chanx_usage = routing_snapshot->channel_usage(e_rr_type::CHANX, visible_layers);
+    auto chany_usage = routing_snapshot->channel_usage(e_rr_type::CHANY, visible_layers);
 
-    auto chanx_avail = calculate_routing_avail(e_rr_type::CHANX);
-    auto chany_avail = calculate_routing_avail(e_rr_type::CHANY);
+    const auto& chanx_avail = routing_snapshot->chanx_avail;
+    const auto& chany_avail = routing_snapshot->chany_avail;
 
     float min_util = 0.;
     float max_util = -std::numeric_limits<float>::infinity();
@@ -0,0 +1,118 @@
+#include "draw_routing_snapshot.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "vtr_assert.h"
+
+vtr::Matrix<float> t_draw_routing_snapshot::channel_usage(e_rr_type rr_type, const std::vector<bool>& visible_layers) const {
+    VTR_ASSERT(rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY);
+    const vtr::NdMatrix<float, 3>& layer_usage = (rr_type == e_rr_type::CHANX) ? chanx_usage : chany_usage;
+
+    vtr::Matrix<float> usage({{layer_usage.dim_size(1), layer_usage.dim_size(2)}}, 0.);
+    for (size_t layer = 0; layer < layer_usage.dim_size(0); layer++) {
+        if (layer < visible_layers.size() && !visible_layers[layer]) {
+            continue; // don't count usage if layer is not visible
+        }
+        for (size_t x = 0; x < layer_usage.dim_size(1); x++) {
+            for (size_t y = 0; y < layer_usage.dim_size(2); y++) {
+                usage[x][y] += layer_usage[layer][x][y];
+            }
+        }
+    }
+    return usage;
+}
+
+t_draw_routing_snapshot prepare_draw_routing_snapshot(const t_draw_routing_inputs& inputs) {
+    VTR_ASSERT(inputs.rr_nodes);
+    const vtr::vector<RRNodeId, t_draw_rr_node_info>& rr_nodes = *inputs.rr_nodes;
+    VTR_ASSERT(inputs.occ.size() == rr_nodes.size());
+
+    t_draw_routing_snapshot snapshot;
+    snapshot.chanx_usage.resize({inputs.num_layers, inputs.grid_width, inputs.grid_height}, 0.);
+    snapshot.chany_usage.resize({inputs.num_layers, inputs.grid_width, inputs.grid_height}, 0.);
+    snapshot.chanx_avail.resize({inputs.grid_width, inputs.grid_height}, 0.);
+    snapshot.chany_avail.resize({inputs.grid_width, inputs.grid_height}, 0.);
+
+    for (size_t inode = 0; inode < rr_nodes.size(); inode++) {
+        const t_draw_rr_node_info& node = rr_nodes[RRNodeId(inode)];
+        short occ = inputs.occ[RRNodeId(inode)];
+
+        if (node.type == e_rr_type::CHANX) {
+            VTR_ASSERT(node.ylow == node.yhigh);
+            for (int x = node.xlow; x <= node.xhigh; ++x) {
+                snapshot.chanx_avail[x][node.ylow] += node.capacity;
+                snapshot.chanx_usage[node.layer][x][node.ylow] += occ;
+            }
+        } else if (node.type == e_rr_type::CHANY) {
+            VTR_ASSERT(node.xlow == node.xhigh);
+            for (int y = node.ylow; y <= node.yhigh; ++y) {
+                snapshot.chany_avail[node.xlow][y] += node.capacity;
+                snapshot.chany_usage[node.layer][node.xlow][y] += occ;
+            }
+        }
+
+        if (occ > node.capacity) {
+            snapshot.congested_rr_nodes.push_back(RRNodeId(inode));
+        }
+    }
+
+    //Sort the nodes in ascending order of congestion, as draw_congestion() draws them
+    auto congestion_ratio = [&](RRNodeId inode) {
+        return float(inputs.occ[inode]) / rr_nodes[inode].capacity;
+    };
+    std::stable_sort(snapshot.congested_rr_nodes.begin(), snapshot.congested_rr_nodes.end(),
+                     [&](RRNodeId lhs, RRNodeId rhs) { return congestion_ratio(lhs) < congestion_ratio(rhs); });
+
+    for (RRNodeId inode : snapshot.congested_rr_nodes) {
+        snapshot.congestion_ratios.push_back(congestion_ratio(inode));
+        snapshot.max_congestion_ratio = std::max(snapshot.max_congestion_ratio, snapshot.congestion_ratios.back());
+    }
+
+    return snapshot;
+}
+
+DrawRoutingSnapshotPreparer::~DrawRoutingSnapshotPreparer() {
+    clear();
+}
+
+void DrawRoutingSnapshotPreparer::request(t_draw_routing_inputs&& inputs) {
+    pending_ = std::move(inputs);
+    collect(false);
+}
+
+std::shared_ptr<const t_draw_routing_snapshot> DrawRoutingSnapshotPreparer::latest() {
+    collect(false);
+    return latest_;
+}
+
+void DrawRoutingSnapshotPreparer::wait() {
+    while (in_flight_.valid() || pending_) {
+        collect(true);
+    }
+}
+
+void DrawRoutingSnapshotPreparer::clear() {
+    pending_.reset();
+    if (in_flight_.valid()) {
+        in_flight_.wait();
+        in_flight_ = {};
+    }
+    latest_.reset();
+}
+
+void DrawRoutingSnapshotPreparer::collect(bool block) {
+    if (in_flight_.valid()) {
+        if (!block && in_flight_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
+        }
+        latest_ = in_flight_.get();
+    }
+
+    if (pending_) {
+        in_flight_ = std::async(std::launch::async, [inputs = std::move(*pending_)]() {
+            return std::shared_ptr<const t_draw_routing_snapshot>(std::make_shared<t_draw_routing_snapshot>(prepare_draw_routing_snapshot(inputs)));
+        });
+        pending_.reset();
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+/**
+ * @file draw_routing_snapshot.h
+ *
+ * @brief The draw data derived from the routing (channel utilization and congestion), prepared
+ *        in a worker thread so that the graphics updates do not stall the router.
+ *
+ * The router only hands over a copy of the rr node occupancies (see t_draw_routing_inputs) when it
+ * updates the screen, and the render callback draws the latest complete snapshot. The preparation
+ * only reads its inputs, so the routing state (and even the rr graph) may change while it runs.
+ *
+ * It does not depend on the graphics library.
+ */
+
+#include <future>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "rr_graph_fwd.h"
+#include "rr_node_types.h"
+#include "vtr_ndmatrix.h"
+#include "vtr_vector.h"
+
+/// @brief The (fixed) properties of an rr node used to prepare the snapshots
+struct t_draw_rr_node_info {
+    e_rr_type type;
+    short xlow;
+    short xhigh;
+    short ylow;
+    short yhigh;
+    short layer;
+    short capacity;
+};
+
+/// @brief The state of the routing a snapshot is prepared from
+struct t_draw_routing_inputs {
+    /// The rr nodes, shared by all the snapshots of the same rr graph
+    std::shared_ptr<const vtr::vector<RRNodeId, t_draw_rr_node_info>> rr_nodes;
+    size_t grid_width = 0;
+    size_t grid_height = 0;
+    size_t num_layers = 0;
+    /// The occupancy of each rr node
+    vtr::vector<RRNodeId, short> occ;
+};
+
+/// @brief The draw data derived from the routing
+struct t_draw_routing_snapshot {
+    /// The occupancy of the channel wires at each [layer][x][y] location
+    vtr::NdMatrix<float, 3> chanx_usage;
+    vtr::NdMatrix<float, 3> chany_usage;
+
+    /// The capacity of the channel wires at each [x][y] location, over all the layers
+    vtr::Matrix<float> chanx_avail;
+    vtr::Matrix<float> chany_avail;
+
+    /// The overused rr nodes, in increasing order of congestion ratio (occupancy / capacity),
+    /// so that the most congested ones are drawn last
+    std::vector<RRNodeId> congested_rr_nodes;
+    std::vector<float> congestion_ratios;
+    float max_congestion_ratio = 1.;
+
+    /**
+     * @brief Returns the occupancy of the CHANX or CHANY wires at each [x][y] location, over the
+     *        visible layers. Matches calculate_routing_usage().
+     */
+    vtr::Matrix<float> channel_usage(e_rr_type rr_type, const std::vector<bool>& visible_layers) const;
+};
+
+/// @brief Prepares the snapshot of @p inputs (on the calling thread)
+t_draw_routing_snapshot prepare_draw_routing_snapshot(const t_draw_routing_inputs& inputs);
+
+/**
+ * @brief Prepares the snapshots in a worker thread, one at a time.
+ *
+ * Requests made while a snapshot is being prepared replace each other, so that only the most
+ * recent routing state is prepared next. All the methods are to be called from the same (main)
+ * thread.
+ */
+class DrawRoutingSnapshotPreparer {
+  public:
+    ~DrawRoutingSnapshotPreparer();
+
+    /// @brief Requests a snapshot of @p inputs, prepared in the background
+    void request(t_draw_routing_inputs&& inputs);
+
+    /// @brief Returns the most recent complete snapshot (without waiting), or nullptr if there is none yet
+    std::shared_ptr<const t_draw_routing_snapshot> latest();
+
+    /// @brief Waits until the snapshots of all the requests have been prepared
+    void wait();
+
+    /// @brief Whether a snapshot has been requested since the last clear()
+    bool has_requests() const { return latest_ || in_flight_.valid() || pending_.has_value(); }
+
+    /// @brief Waits for the snapshot in progress, and forgets all the snapshots and requests
+    void clear();
+
+  private:
+    /// Collects the snapshot in progress (blocking if @p block), and starts the pending request
+    void collect(bool block);
+
+    std::future<std::shared_ptr<const t_draw_routing_snapshot>> in_flight_;
+    std::optional<t_draw_routing_inputs> pending_;
+    std::shared_ptr<const t_draw_routing_snapshot> latest_;
+};
@@ -4,6 +4,8 @@
 #include <cstdio>
 #include <cmath>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #include "rr_graph_fwd.h"
 #include "vtr_assert.h"
@@ -23,6 +25,7 @@
 #include "draw_mux.h"
 #include "draw_global.h"
 #include "search_bar.h"
+#include "route_utilization.h"
 
 //To process key presses we need the X11 keysym definitions,
 //which are unavailable when building with MINGW
@@ -37,6 +40,14 @@
 constexpr float SB_EDGE_TURN_ARROW_POSITION = 0.2;
 constexpr float SB_EDGE_STRAIGHT_ARROW_POSITION = 0.95;
 
+//Below this many screen pixels per tile, the individual routing resources are no longer drawn
+//(only the highlighted ones), and the channel utilization is drawn instead
+constexpr float RR_DETAIL_MIN_TILE_PIXELS = 30.;
+
+static void build_rr_spatial_index();
+static vtr::Rect<float> get_rr_node_draw_bbox(RRNodeId inode);
+static void draw_rr_channel_utilization(const ezgl::rectangle& view, ezgl::renderer* g);
+
 /* Draws the routing resources that exist in the FPGA, if the user wants
  * them drawn.
  */
@@ -62,12 +73,29 @@ void draw_rr(ezgl::renderer* g) {
                                                                                               DEFAULT_RR_NODE_COLOR,
                                                                                               DEFAULT_RR_NODE_COLOR};
 
+    // Only the routing resources within the visible world are drawn
+    if (draw_state->rr_spatial_index.empty()) {
+        build_rr_spatial_index();
+    }
+    ezgl::rectangle view = g->get_visible_world();
+    std::vector<RRNodeId> visible_nodes = draw_state->rr_spatial_index.query(vtr::Rect<float>(std::min(view.left(), view.right()), std::min(view.bottom(), view.top()),
+                                                                                              std::max(view.left(), view.right()), std::max(view.bottom(), view.top())));
+
+    // When zoomed out, the individual wires and switches can't be told apart: the channel utilization is drawn
+    // instead, along with the highlighted nodes and edges only.
+    bool draw_details = g->get_visible_screen().width() / view.width() * get_draw_coords_vars()->get_tile_width() >= RR_DETAIL_MIN_TILE_PIXELS;
+    if (!draw_details) {
+        draw_rr_channel_utilization(view, g);
+    }
+
     // Draw edges first, then nodes, so that nodes (and their muxes) are rendered on top of edges.
-    for (const RRNodeId inode : device_ctx.rr_graph.nodes()) {
-        draw_rr_edges(inode, g);
+    for (const RRNodeId inode : visible_nodes) {
+        if (draw_details || (draw_state->highlight_rr_edges && draw_state->hit_nodes.count(inode))) {
+            draw_rr_edges(inode, g);
+        }
     }
 
-    for (const RRNodeId inode : device_ctx.rr_graph.nodes()) {
+    for (const RRNodeId inode : visible_nodes) {
         e_rr_type node_type = rr_graph.node_type(inode);
         bool inter_cluster_node = is_inter_cluster_node(rr_graph, inode);
         bool node_highlighted = draw_state->draw_rr_node[inode].node_highlighted;
@@ -78,6 +106,10 @@ void draw_rr(ezgl::renderer* g) {
         }
 
         if (!node_highlighted) {
+            if (!draw_details) {
+                continue;
+            }
+
             // Draw channel nodes if enabled
             if ((node_type == e_rr_type::CHANX || node_type == e_rr_type::CHANY) && !draw_state->draw_channel_nodes) {
                 continue;
@@ -804,4 +836,102 @@ int get_rr_node_transparency(RRNodeId rr_node) {
 
     return draw_state->draw_layer_display[layer_num].alpha;
 }
+
+/* Returns the region of the world the rr node is drawn into: the tiles it spans, along with the
+ * channels above and to the right of them. */
+static vtr::Rect<float> get_rr_node_draw_bbox(RRNodeId inode) {
+    t_draw_coords* draw_coords = get_draw_coords_vars();
+    const DeviceContext& device_ctx = g_vpr_ctx.device();
+    const RRGraphView& rr_graph = device_ctx.rr_graph;
+
+    size_t xhigh = std::min<size_t>(rr_graph.node_xhigh(inode) + 1, device_ctx.grid.width() - 1);
+    size_t yhigh = std::min<size_t>(rr_graph.node_yhigh(inode) + 1, device_ctx.grid.height() - 1);
+
+    return vtr::Rect<float>(draw_coords->tile_x[rr_graph.node_xlow(inode)],
+                            draw_coords->tile_y[rr_graph.node_ylow(inode)],
+                            draw_coords->tile_x[xhigh] + draw_coords->get_tile_width(),
+                            draw_coords->tile_y[yhigh] + draw_coords->get_tile_width());
+}
+
+/* Indexes the rr nodes drawn by draw_rr() by the region covered by the node and its edges, which
+ * are drawn along with it. */
+static void build_rr_spatial_index() {
+    t_draw_state* draw_state = get_draw_state_vars();
+    const RRGraphView& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    std::vector<std::pair<RRNodeId, vtr::Rect<float>>> node_bboxes;
+    node_bboxes.reserve(rr_graph.num_nodes());
+    for (const RRNodeId inode : rr_graph.nodes()) {
+        e_rr_type node_type = rr_graph.node_type(inode);
+        if (node_type == e_rr_type::SOURCE || node_type == e_rr_type::SINK) {
+            continue;
+        }
+
+        vtr::Rect<float> bbox = get_rr_node_draw_bbox(inode);
+        for (t_edge_size iedge = 0, l = rr_graph.num_edges(inode); iedge < l; iedge++) {
+            RRNodeId to_node = rr_graph.edge_sink_node(inode, iedge);
+            e_rr_type to_type = rr_graph.node_type(to_node);
+            if (to_type == e_rr_type::SOURCE || to_type == e_rr_type::SINK) {
+                continue;
+            }
+            vtr::Rect<float> to_bbox = get_rr_node_draw_bbox(to_node);
+            bbox = vtr::Rect<float>(std::min(bbox.xmin(), to_bbox.xmin()), std::min(bbox.ymin(), to_bbox.ymin()),
+                                    std::max(bbox.xmax(), to_bbox.xmax()), std::max(bbox.ymax(), to_bbox.ymax()));
+        }
+        node_bboxes.emplace_back(inode, bbox);
+    }
+
+    draw_state->rr_spatial_index.build(std::move(node_bboxes));
+}
+
+/* Fills the visible channels by their (clipped) utilization, as draw_routing_util() does, unless
+ * the routing utilization is already being drawn. */
+static void draw_rr_channel_utilization(const ezgl::rectangle& view, ezgl::renderer* g) {
+    t_draw_state* draw_state = get_draw_state_vars();
+    if (draw_state->show_routing_util != DRAW_NO_ROUTING_UTIL) {
+        return;
+    }
+
+    std::shared_ptr<const t_draw_routing_snapshot> routing_snapshot = get_draw_routing_snapshot();
+    if (!routing_snapshot) {
+        return;
+    }
+
+    t_draw_coords* draw_coords = get_draw_coords_vars();
+    const DeviceContext& device_ctx = g_vpr_ctx.device();
+
+    std::vector<bool> visible_layers = get_draw_layer_visibility();
+    vtr::Matrix<float> chanx_usage = routing_snapshot->channel_usage(e_rr_type::CHANX, visible_layers);
+    vtr::Matrix<float> chany_usage = routing_snapshot->channel_usage(e_rr_type::CHANY, visible_layers);
+    const vtr::Matrix<float>& chanx_avail = routing_snapshot->chanx_avail;
+    const vtr::Matrix<float>& chany_avail = routing_snapshot->chany_avail;
+
+    vtr::PlasmaColorMap cmap(0., 1.);
+    float tile_width = draw_coords->get_tile_width();
+    float tile_height = draw_coords->get_tile_height();
+
+    auto fill_channel = [&](const ezgl::rectangle& bb, float util) {
+        if (bb.right() < std::min(view.left(), view.right()) || bb.left() > std::max(view.left(), view.right())
+            || bb.top() < std::min(view.bottom(), view.top()) || bb.bottom() > std::max(view.bottom(), view.top())) {
+            return;
+        }
+        g->set_color(to_ezgl_color(cmap.color(std::min(util, 1.f))));
+        g->fill_rectangle(bb);
+    };
+
+    for (size_t x = 0; x < device_ctx.grid.width() - 1; ++x) {
+        for (size_t y = 0; y < device_ctx.grid.height() - 1; ++y) {
+            if (x > 0) {
+                fill_channel(ezgl::rectangle({draw_coords->tile_x[x], draw_coords->tile_y[y] + tile_height},
+                                             {draw_coords->tile_x[x] + tile_width, draw_coords->tile_y[y + 1]}),
+                             routing_util(chanx_usage[x][y], chanx_avail[x][y]));
+            }
+            if (y > 0) {
+                fill_channel(ezgl::rectangle({draw_coords->tile_x[x] + tile_width, draw_coords->tile_y[y]},
+                                             {draw_coords->tile_x[x + 1], draw_coords->tile_y[y] + tile_height}),
+                             routing_util(chany_usage[x][y], chany_avail[x][y]));
+            }
+        }
+    }
+}
 #endif
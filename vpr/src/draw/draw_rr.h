@@ -20,6 +20,10 @@
 /** 
  * @brief Draws the routing resources that exist in the FPGA, if the user wants
  * them drawn. 
+ *
+ * Only the nodes within the visible world are visited (through the rr spatial index of the
+ * draw state). When zoomed out too far for the individual wires to be told apart, the channel
+ * utilization is drawn instead, along with the highlighted nodes.
  */
 void draw_rr(ezgl::renderer* g);
 
@@ -27,6 +27,7 @@
 #include "vtr_vector.h"
 #include "breakpoint.h"
 #include "manual_moves.h"
+#include "rr_spatial_index.h"
 
 #include "ezgl/rectangle.hpp"
 #include "ezgl/color.hpp"
@@ -287,6 +288,14 @@ struct t_draw_state {
      */
     vtr::vector<RRNodeId, t_draw_rr_node> draw_rr_node;
 
+    /**
+     * @brief The drawn extent of the routing resources (the nodes and their fan-out edges),
+     * to draw only the ones within the visible world.
+     *
+     * Built by draw_rr() on first use, and cleared when the draw coordinates change.
+     */
+    RRSpatialIndex rr_spatial_index;
+
     std::shared_ptr<const SetupTimingInfo> setup_timing_info;
 
     ///@brief pointer to architecture info. const
@@ -0,0 +1,131 @@
+#include "rr_spatial_index.h"
+
+#include <algorithm>
+
+#include "vtr_assert.h"
+
+namespace {
+
+/// Quads with more nodes than this are split further, up to MAX_QUAD_DEPTH
+constexpr size_t MAX_QUAD_ITEMS = 32;
+constexpr int MAX_QUAD_DEPTH = 16;
+
+/// Whether the regions overlap, including their edges (so that lines and points may overlap)
+bool touches(const vtr::Rect<float>& lhs, const vtr::Rect<float>& rhs) {
+    return lhs.xmin() <= rhs.xmax() && rhs.xmin() <= lhs.xmax()
+           && lhs.ymin() <= rhs.ymax() && rhs.ymin() <= lhs.ymax();
+}
+
+/// Whether @p inner lies within @p outer, including its edges
+bool fits_in(const vtr::Rect<float>& inner, const vtr::Rect<float>& outer) {
+    return outer.xmin() <= inner.xmin() && inner.xmax() <= outer.xmax()
+           && outer.ymin() <= inner.ymin() && inner.ymax() <= outer.ymax();
+}
+
+} // namespace
+
+void RRSpatialIndex::build(std::vector<std::pair<RRNodeId, vtr::Rect<float>>> node_bboxes) {
+    clear();
+
+    if (node_bboxes.empty()) {
+        return;
+    }
+
+    vtr::Rect<float> world = node_bboxes.front().second;
+    for (const auto& [inode, bbox] : node_bboxes) {
+        world = vtr::Rect<float>(std::min(world.xmin(), bbox.xmin()), std::min(world.ymin(), bbox.ymin()),
+                                 std::max(world.xmax(), bbox.xmax()), std::max(world.ymax(), bbox.ymax()));
+    }
+
+    items_.reserve(node_bboxes.size());
+    quads_.emplace_back();
+    quads_[0].region = world;
+    build_quad(0, std::move(node_bboxes), 0);
+}
+
+void RRSpatialIndex::clear() {
+    quads_.clear();
+    items_.clear();
+}
+
+void RRSpatialIndex::build_quad(int iquad, std::vector<std::pair<RRNodeId, vtr::Rect<float>>>&& quad_items, int depth) {
+    const vtr::Rect<float> region = quads_[iquad].region;
+
+    std::vector<std::pair<RRNodeId, vtr::Rect<float>>> child_items[4];
+    vtr::Rect<float> child_regions[4];
+
+    bool split = quad_items.size() > MAX_QUAD_ITEMS && depth < MAX_QUAD_DEPTH;
+    if (split) {
+        float xmid = (region.xmin() + region.xmax()) / 2;
+        float ymid = (region.ymin() + region.ymax()) / 2;
+        child_regions[0] = vtr::Rect<float>(region.xmin(), region.ymin(), xmid, ymid);
+        child_regions[1] = vtr::Rect<float>(xmid, region.ymin(), region.xmax(), ymid);
+        child_regions[2] = vtr::Rect<float>(region.xmin(), ymid, xmid, region.ymax());
+        child_regions[3] = vtr::Rect<float>(xmid, ymid, region.xmax(), region.ymax());
+
+        // The nodes which straddle the children stay in this quad
+        std::vector<std::pair<RRNodeId, vtr::Rect<float>>> own_items;
+        for (auto& item : quad_items) {
+            auto child = std::find_if(std::begin(child_regions), std::end(child_regions),
+                                      [&](const vtr::Rect<float>& child_region) { return fits_in(item.second, child_region); });
+            if (child != std::end(child_regions)) {
+                child_items[child - std::begin(child_regions)].push_back(item);
+            } else {
+                own_items.push_back(item);
+            }
+        }
+        quad_items = std::move(own_items);
+        split = std::any_of(std::begin(child_items), std::end(child_items), [](const auto& items) { return !items.empty(); });
+    }
+
+    quads_[iquad].items_begin = items_.size();
+    items_.insert(items_.end(), quad_items.begin(), quad_items.end());
+    quads_[iquad].items_end = items_.size();
+
+    if (!split) {
+        return;
+    }
+
+    int first_child = quads_.size();
+    quads_[iquad].first_child = first_child;
+    quads_.resize(quads_.size() + 4);
+    for (int ichild = 0; ichild < 4; ichild++) {
+        quads_[first_child + ichild].region = child_regions[ichild];
+        build_quad(first_child + ichild, std::move(child_items[ichild]), depth + 1);
+    }
+}
+
+std::vector<RRNodeId> RRSpatialIndex::query(const vtr::Rect<float>& region) const {
+    std::vector<RRNodeId> nodes;
+
+    if (quads_.empty()) {
+        return nodes;
+    }
+
+    std::vector<int> quads_to_visit{0};
+    while (!quads_to_visit.empty()) {
+        const t_quad& quad = quads_[quads_to_visit.back()];
+        quads_to_visit.pop_back();
+
+        if (!touches(quad.region, region)) {
+            continue;
+        }
+
+        bool whole_quad = fits_in(quad.region, region);
+        for (size_t iitem = quad.items_begin; iitem < quad.items_end; iitem++) {
+            if (whole_quad || touches(items_[iitem].second, region)) {
+                nodes.push_back(items_[iitem].first);
+            }
+        }
+
+        if (quad.first_child >= 0) {
+            for (int ichild = 0; ichild < 4; ichild++) {
+                quads_to_visit.push_back(quad.first_child + ichild);
+            }
+        }
+    }
+
+    std::sort(nodes.begin(), nodes.end());
+    VTR_ASSERT_DEBUG(std::adjacent_find(nodes.begin(), nodes.end()) == nodes.end());
+    return nodes;
+}
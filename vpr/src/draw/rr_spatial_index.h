@@ -0,0 +1,52 @@
+#pragma once
+/**
+ * @file rr_spatial_index.h
+ *
+ * @brief A quadtree over the drawn extent of the routing resources, so that the graphics only visit
+ *        the rr nodes within the visible part of the device.
+ *
+ * It only depends on the node bounding boxes (in world coordinates), and not on the graphics library.
+ */
+
+#include <utility>
+#include <vector>
+
+#include "rr_graph_fwd.h"
+#include "vtr_geometry.h"
+
+class RRSpatialIndex {
+  public:
+    /**
+     * @brief Builds the index.
+     *
+     * @param node_bboxes The rr nodes to index, with the region they are drawn into. A region
+     *                    may be a point or a line (e.g. a wire).
+     */
+    void build(std::vector<std::pair<RRNodeId, vtr::Rect<float>>> node_bboxes);
+
+    /// @brief Empties the index, which then needs to be built again.
+    void clear();
+
+    /// @brief Whether the index has been built (with at least one node).
+    bool empty() const { return quads_.empty(); }
+
+    /**
+     * @brief Returns the indexed nodes whose region overlaps (or touches) @p region, in increasing
+     *        id order (the order in which the whole rr graph is drawn).
+     */
+    std::vector<RRNodeId> query(const vtr::Rect<float>& region) const;
+
+  private:
+    /// @brief A square of the quadtree, holding the nodes which fit in it but in none of its children
+    struct t_quad {
+        vtr::Rect<float> region;
+        int first_child = -1; ///< Index of the first of the four children, or -1 for a leaf
+        size_t items_begin = 0;
+        size_t items_end = 0;
+    };
+
+    void build_quad(int iquad, std::vector<std::pair<RRNodeId, vtr::Rect<float>>>&& quad_items, int depth);
+
+    std::vector<t_quad> quads_;                                ///< quads_[0] is the root
+    std::vector<std::pair<RRNodeId, vtr::Rect<float>>> items_; ///< The nodes, grouped per quad
+};
@@ -24,6 +24,7 @@
 #include "vpr_exit_codes.h"
 #include "vpr_error.h"
 #include "vpr_api.h"
+#include "vpr_daemon.h"
 #include "vpr_signal_handler.h"
 #include "vpr_tatum_error.h"
 
@@ -64,6 +65,11 @@ int main(int argc, const char** argv) {
             return SUCCESS_EXIT_CODE;
         }
 
+        if (!Options.daemon_socket.value().empty()) {
+            // Serves the jobs until killed
+            vpr_daemon(Options, vpr_setup, Arch);
+        }
+
         bool flow_succeeded = vpr_flow(vpr_setup, Arch);
         if (!flow_succeeded) {
             VTR_LOG("VPR failed to implement circuit\n");
@@ -2,12 +2,25 @@
 #include "channel_dependency_graph.h"
 #include "vtr_assert.h"
 
-#include <stack>
+#include <algorithm>
+
+ChannelDependencyGraph::ChannelDependencyGraph(size_t n_links)
+    : n_links_(n_links)
+    , successors_(n_links)
+    , predecessors_(n_links)
+    , order_(n_links)
+    , visited_(n_links, false) {
+    // any order is topological when there is no edge
+    for (NocLinkId link_id : order_.keys()) {
+        order_[link_id] = (int)(size_t)link_id;
+    }
+}
 
 ChannelDependencyGraph::ChannelDependencyGraph(const NocStorage& noc_model,
                                                const NocTrafficFlows& traffic_flow_storage,
                                                const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& traffic_flow_routes,
-                                               const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs) {
+                                               const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs)
+    : ChannelDependencyGraph(noc_model.get_noc_links().size()) {
     VTR_ASSERT((size_t)traffic_flow_storage.get_number_of_traffic_flows() == traffic_flow_routes.size());
 
     for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
@@ -34,13 +47,6 @@ ChannelDependencyGraph::ChannelDependencyGraph(const NocStorage& noc_model,
         }
     }
 
-    const size_t n_links = noc_model.get_noc_links().size();
-
-    adjacency_list_.clear();
-    // In channel dependency graph, vertices represent NoC links.
-    // reserve enough space so that all vertices can store their outgoing neighbors
-    adjacency_list_.resize(n_links);
-
     /*
      * A traffic flow travels through some NoC links. In channel dependency graph (CDG),
      * consecutive NoC links travelled by the flow are connected using an edge.
@@ -52,77 +58,182 @@ ChannelDependencyGraph::ChannelDependencyGraph(const NocStorage& noc_model,
 
     // iterate over all traffic flows and populate the channel dependency graph
     for (const auto& traffic_flow_route : traffic_flow_routes) {
-        auto prev_link_id = NocLinkId::INVALID();
-        for (auto cur_link_id : traffic_flow_route) {
-            VTR_ASSERT(prev_link_id != cur_link_id);
-            if (prev_link_id != NocLinkId::INVALID()) {
-                adjacency_list_[prev_link_id].push_back(cur_link_id);
-            }
-            prev_link_id = cur_link_id;
-        }
+        add_route(traffic_flow_route);
+    }
+}
+
+bool ChannelDependencyGraph::has_cycles() const {
+    // the edges that are not in cyclic_edges_ form a DAG, and each edge in
+    // cyclic_edges_ closes a cycle with the edges of the DAG
+    return !cyclic_edges_.empty();
+}
+
+void ChannelDependencyGraph::add_route(const std::vector<NocLinkId>& route) {
+    for (size_t i = 1; i < route.size(); i++) {
+        add_dependency(route[i - 1], route[i]);
+    }
+}
+
+void ChannelDependencyGraph::remove_route(const std::vector<NocLinkId>& route) {
+    for (size_t i = 1; i < route.size(); i++) {
+        remove_dependency(route[i - 1], route[i]);
+    }
+}
+
+void ChannelDependencyGraph::clear() {
+    dependency_use_counts_.clear();
+    cyclic_edges_.clear();
+    for (NocLinkId link_id : order_.keys()) {
+        successors_[link_id].clear();
+        predecessors_[link_id].clear();
+        order_[link_id] = (int)(size_t)link_id;
     }
+}
 
-    // remove repetitive neighbors
-    for (auto& neighboring_nodes : adjacency_list_) {
-        // sort neighbors so that repetitive nodes are put beside each other
-        std::sort(neighboring_nodes.begin(), neighboring_nodes.end());
+void ChannelDependencyGraph::add_dependency(NocLinkId from, NocLinkId to) {
+    VTR_ASSERT(from != to);
 
-        // remove consecutive duplicates
-        auto it = std::unique(neighboring_nodes.begin(), neighboring_nodes.end());
+    // the dependency is already in the graph
+    if (dependency_use_counts_[dependency_key(from, to)]++ > 0) {
+        return;
+    }
 
-        // erase the elements from the iterator to the end
-        neighboring_nodes.erase(it, neighboring_nodes.end());
+    if (reorder_for_edge(from, to)) {
+        successors_[from].push_back(to);
+        predecessors_[to].push_back(from);
+    } else {
+        cyclic_edges_.emplace_back(from, to);
     }
 }
 
-bool ChannelDependencyGraph::has_cycles() {
-    // get the number vertices in CDG
-    const size_t n_vertices = adjacency_list_.size();
-
-    // indicates whether a node (NoC link) in CDG is visited during DFS
-    vtr::vector<NocLinkId, bool> visited(n_vertices, false);
-    // indicates whether a node (NoC links) is currently in stack
-    vtr::vector<NocLinkId, bool> on_stack(n_vertices, false);
-    // the stack used to perform graph traversal (DFS). Contains to-be-visited vertices
-    std::stack<NocLinkId> stack;
-
-    // iterate over all vertices (NoC links)
-    for (NocLinkId noc_link_id : adjacency_list_.keys()) {
-        // the node (NoC link) has already been visited
-        if (visited[noc_link_id]) {
-            continue;
+void ChannelDependencyGraph::remove_dependency(NocLinkId from, NocLinkId to) {
+    auto it = dependency_use_counts_.find(dependency_key(from, to));
+    VTR_ASSERT(it != dependency_use_counts_.end());
+
+    // other routes still use the dependency
+    if (--it->second > 0) {
+        return;
+    }
+    dependency_use_counts_.erase(it);
+
+    // the removed edge may be closing a cycle, in which case the DAG does not change
+    auto cyclic_it = std::find(cyclic_edges_.begin(), cyclic_edges_.end(), std::make_pair(from, to));
+    if (cyclic_it != cyclic_edges_.end()) {
+        *cyclic_it = cyclic_edges_.back();
+        cyclic_edges_.pop_back();
+        return;
+    }
+
+    auto remove_from = [](std::vector<NocLinkId>& links, NocLinkId link_id) {
+        auto link_it = std::find(links.begin(), links.end(), link_id);
+        VTR_ASSERT_SAFE(link_it != links.end());
+        *link_it = links.back();
+        links.pop_back();
+    };
+    remove_from(successors_[from], to);
+    remove_from(predecessors_[to], from);
+
+    /* Removing an edge keeps the order topological, but it may break the
+     * cycles that kept some edges out of the DAG. Try to insert them again.*/
+    for (size_t i = 0; i < cyclic_edges_.size();) {
+        auto [cyclic_from, cyclic_to] = cyclic_edges_[i];
+        if (reorder_for_edge(cyclic_from, cyclic_to)) {
+            successors_[cyclic_from].push_back(cyclic_to);
+            predecessors_[cyclic_to].push_back(cyclic_from);
+            cyclic_edges_[i] = cyclic_edges_.back();
+            cyclic_edges_.pop_back();
+        } else {
+            i++;
         }
+    }
+}
 
-        // An un-visited node is found. Add to the stack
-        stack.push(noc_link_id);
+bool ChannelDependencyGraph::reorder_for_edge(NocLinkId from, NocLinkId to) {
+    const int lower_bound = order_[to];
+    const int upper_bound = order_[from];
 
-        // continue the traversal until the stack is empty
-        while (!stack.empty()) {
-            auto current_vertex_id = stack.top();
+    // the order is already consistent with the new edge
+    if (lower_bound > upper_bound) {
+        return true;
+    }
 
-            if (!visited[current_vertex_id]) {
-                on_stack[current_vertex_id] = true;
-                visited[current_vertex_id] = true;
-            } else { // the neighboring vertices have already been processed
-                // remove it from the stack
-                stack.pop();
-                on_stack[current_vertex_id] = false;
+    /* Only the vertices whose order is in [lower_bound, upper_bound] may need
+     * to move: the ones reachable from "to" (forward_visited_) must be moved
+     * after the ones that reach "from" (backward_visited_).*/
+    auto reset_visited = [this]() {
+        for (NocLinkId link_id : forward_visited_) {
+            visited_[link_id] = false;
+        }
+        for (NocLinkId link_id : backward_visited_) {
+            visited_[link_id] = false;
+        }
+    };
+
+    forward_visited_.clear();
+    backward_visited_.clear();
+
+    // forward search from "to"; reaching "from" means the edge closes a cycle
+    search_stack_.assign(1, to);
+    visited_[to] = true;
+    forward_visited_.push_back(to);
+    while (!search_stack_.empty()) {
+        NocLinkId link_id = search_stack_.back();
+        search_stack_.pop_back();
+        for (NocLinkId successor_id : successors_[link_id]) {
+            if (successor_id == from) {
+                reset_visited();
+                return false;
             }
+            if (!visited_[successor_id] && order_[successor_id] < upper_bound) {
+                visited_[successor_id] = true;
+                forward_visited_.push_back(successor_id);
+                search_stack_.push_back(successor_id);
+            }
+        }
+    }
 
-            // get the outgoing edges of the current vertex
-            const auto& neighbor_ids = adjacency_list_[current_vertex_id];
-
-            // iterate over all outgoing neighbors
-            for (auto& neighbor_id : neighbor_ids) {
-                if (!visited[neighbor_id]) {
-                    stack.push(neighbor_id);
-                } else if (on_stack[neighbor_id]) { // the current vertex is pointing to one of its ancestors
-                    return true;
-                }
+    // backward search from "from"
+    search_stack_.assign(1, from);
+    visited_[from] = true;
+    backward_visited_.push_back(from);
+    while (!search_stack_.empty()) {
+        NocLinkId link_id = search_stack_.back();
+        search_stack_.pop_back();
+        for (NocLinkId predecessor_id : predecessors_[link_id]) {
+            if (!visited_[predecessor_id] && order_[predecessor_id] > lower_bound) {
+                visited_[predecessor_id] = true;
+                backward_visited_.push_back(predecessor_id);
+                search_stack_.push_back(predecessor_id);
             }
         }
     }
 
-    // if no vertex in the graph points to at least one of its ancestors, the graph does not have any cycles
-    return false;
+    reset_visited();
+
+    // reassign the positions of the visited vertices: the backward set first, then
+    // the forward set, each keeping its relative order
+    auto by_order = [this](NocLinkId a, NocLinkId b) {
+        return order_[a] < order_[b];
+    };
+    std::sort(forward_visited_.begin(), forward_visited_.end(), by_order);
+    std::sort(backward_visited_.begin(), backward_visited_.end(), by_order);
+
+    order_pool_.clear();
+    for (NocLinkId link_id : backward_visited_) {
+        order_pool_.push_back(order_[link_id]);
+    }
+    for (NocLinkId link_id : forward_visited_) {
+        order_pool_.push_back(order_[link_id]);
+    }
+    std::sort(order_pool_.begin(), order_pool_.end());
+
+    size_t pool_index = 0;
+    for (NocLinkId link_id : backward_visited_) {
+        order_[link_id] = order_pool_[pool_index++];
+    }
+    for (NocLinkId link_id : forward_visited_) {
+        order_[link_id] = order_pool_[pool_index++];
+    }
+
+    return true;
 }
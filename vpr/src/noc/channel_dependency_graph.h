@@ -13,6 +13,16 @@
  * Vi to Vj, where Vi and Vj are nodes in CDG that are associated with Li and Lj.
  * Absence of cycles in the formed CDG guarantees deadlock freedom.
  *
+ * The CDG is maintained incrementally: routes can be added and removed as
+ * traffic flows are re-routed, and a topological order of its vertices is
+ * kept up to date with the Pearce-Kelly algorithm (Pearce, D. J., & Kelly,
+ * P. H. J. (2007). A dynamic topological sort algorithm for directed acyclic
+ * graphs. ACM Journal of Experimental Algorithmics, 11). An edge whose
+ * insertion would close a cycle is kept aside until an edge removal breaks
+ * that cycle. The CDG has a cycle if and only if such an edge exists, so
+ * checking for deadlocks costs O(1), and adding or removing a route only
+ * visits the part of the graph whose order has to change.
+ *
  * To learn more about channel dependency graph, refer to the following papers:
  * 1) Glass, C. J., & Ni, L. M. (1992). The turn model for adaptive routing.
  * ACM SIGARCH Computer Architecture News, 20(2), 278-287.
@@ -20,6 +30,9 @@
  * interconnection networks. IEEE Transactions on computers, 100(5), 547-553.
  */
 
+#include <unordered_map>
+#include <vector>
+
 #include "vtr_vector.h"
 #include "noc_data_types.h"
 #include "noc_storage.h"
@@ -30,11 +43,21 @@ class ChannelDependencyGraph {
     ChannelDependencyGraph() = delete;
 
     /**
-     * @brief Constructor
+     * @brief Constructs a CDG without any dependency. Routes are
+     * added with add_route().
      *
      * @param n_links The total number of NoC links.
+     */
+    explicit ChannelDependencyGraph(size_t n_links);
+
+    /**
+     * @brief Constructs the CDG of the given traffic flow routes.
+     *
+     * @param noc_model Used to get the NoC links and routers.
+     * @param traffic_flow_storage Used to get the source and sink of each traffic flow.
      * @param traffic_flow_routes The route of each traffic flow generated
      * by a routing algorithm.
+     * @param block_locs Contains the location where each clustered block is placed at.
      */
     ChannelDependencyGraph(const NocStorage& noc_model,
                            const NocTrafficFlows& traffic_flow_storage,
@@ -48,9 +71,77 @@ class ChannelDependencyGraph {
      *
      * @return True if the CDG has any cycles, otherwise false is returned.
      */
-    bool has_cycles();
+    bool has_cycles() const;
+
+    /**
+     * @brief Adds the dependencies between the consecutive links of a
+     * traffic flow route.
+     *
+     * @param route The links traversed by a traffic flow, in traversal order.
+     */
+    void add_route(const std::vector<NocLinkId>& route);
+
+    /**
+     * @brief Removes the dependencies added by add_route() for the same route.
+     * A dependency is only removed from the graph when no route uses it anymore.
+     *
+     * @param route A route that was previously added, in traversal order.
+     */
+    void remove_route(const std::vector<NocLinkId>& route);
+
+    /**
+     * @brief Removes all the dependencies.
+     */
+    void clear();
 
   private:
-    /** An adjacency list used to represent channel dependency graph.*/
-    vtr::vector<NocLinkId, std::vector<NocLinkId>> adjacency_list_;
+    /**
+     * @brief Increments the number of routes using the dependency (from, to),
+     * and inserts it into the graph if it was not used.
+     */
+    void add_dependency(NocLinkId from, NocLinkId to);
+
+    /**
+     * @brief Decrements the number of routes using the dependency (from, to),
+     * and removes it from the graph if it is not used anymore.
+     */
+    void remove_dependency(NocLinkId from, NocLinkId to);
+
+    /**
+     * @brief Updates the topological order so that from comes before to.
+     *
+     * @return False if the order cannot be updated because there is a path
+     * from to to from, i.e. the edge (from, to) would close a cycle. The
+     * order is left unchanged in this case.
+     */
+    bool reorder_for_edge(NocLinkId from, NocLinkId to);
+
+    /// @brief The key of the dependency (from, to) in dependency_use_counts_.
+    size_t dependency_key(NocLinkId from, NocLinkId to) const {
+        return (size_t)from * n_links_ + (size_t)to;
+    }
+
+    /// The total number of NoC links, i.e. vertices in the CDG.
+    size_t n_links_;
+
+    /// The number of routes that use each dependency, keyed by dependency_key().
+    std::unordered_map<size_t, int> dependency_use_counts_;
+
+    /** The outgoing and incoming edges of each vertex, excluding the edges in
+     *  cyclic_edges_. These edges form a DAG that is consistent with order_.*/
+    vtr::vector<NocLinkId, std::vector<NocLinkId>> successors_;
+    vtr::vector<NocLinkId, std::vector<NocLinkId>> predecessors_;
+
+    /// The position of each vertex in the topological order of the DAG.
+    vtr::vector<NocLinkId, int> order_;
+
+    /// The edges that would close a cycle in the DAG if they were inserted.
+    std::vector<std::pair<NocLinkId, NocLinkId>> cyclic_edges_;
+
+    // Scratch data used by reorder_for_edge().
+    vtr::vector<NocLinkId, bool> visited_;
+    std::vector<NocLinkId> forward_visited_;
+    std::vector<NocLinkId> backward_visited_;
+    std::vector<NocLinkId> search_stack_;
+    std::vector<int> order_pool_;
 };
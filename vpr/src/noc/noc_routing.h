@@ -59,4 +59,12 @@ class NocRouting {
                             NocTrafficFlowId traffic_flow_id,
                             std::vector<NocLinkId>& flow_route,
                             const NocStorage& noc_model) = 0;
+
+    /**
+     * @brief Whether the route found by route_flow() depends on the traffic
+     * flow being routed, and not only on its source and sink routers. When
+     * it does not, routes can be reused for all the traffic flows between the
+     * same pair of routers.
+     */
+    virtual bool route_depends_on_traffic_flow() const { return false; }
 };
@@ -0,0 +1,329 @@
+#include "noc_simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <numeric>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_random.h"
+#include "vtr_time.h"
+
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+namespace {
+
+/// A packet in flight in the NoC.
+struct t_noc_sim_packet {
+    /// The traffic flow the packet belongs to.
+    NocTrafficFlowId traffic_flow_id;
+    /// The index, in the route of its traffic flow, of the link the packet is queued at.
+    size_t hop;
+    /// The cycle at which the packet was injected.
+    size_t injection_cycle;
+};
+
+/**
+ * @brief Returns the value at the given fraction (in [0, 1]) of a
+ * distribution, given as (value, count) pairs sorted by value.
+ */
+double get_percentile(const std::vector<std::pair<double, size_t>>& distribution,
+                      size_t total_count,
+                      double fraction) {
+    VTR_ASSERT_SAFE(!distribution.empty());
+    const auto rank = (size_t)std::ceil(fraction * (double)total_count);
+    size_t count = 0;
+    for (const auto& [value, value_count] : distribution) {
+        count += value_count;
+        if (count >= rank) {
+            return value;
+        }
+    }
+    return distribution.back().first;
+}
+
+} // namespace
+
+NocSimulator::NocSimulator(const NocStorage& noc_model,
+                           const NocTrafficFlows& traffic_flow_storage,
+                           const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& traffic_flow_routes,
+                           double packet_size)
+    : noc_model_(noc_model)
+    , traffic_flow_storage_(traffic_flow_storage)
+    , traffic_flow_routes_(traffic_flow_routes) {
+    VTR_ASSERT(packet_size > 0.0);
+    VTR_ASSERT((size_t)traffic_flow_storage.get_number_of_traffic_flows() == traffic_flow_routes.size());
+
+    const auto& noc_links = noc_model.get_noc_links();
+
+    // a cycle is the time needed to send one packet over the fastest link
+    double max_link_bandwidth = 0.0;
+    for (const NocLink& link : noc_links) {
+        max_link_bandwidth = std::max(max_link_bandwidth, link.get_bandwidth());
+    }
+    VTR_ASSERT(noc_links.empty() || max_link_bandwidth > 0.0);
+    cycle_time_ = noc_links.empty() ? 0.0 : packet_size / max_link_bandwidth;
+
+    link_rates_.resize(noc_links.size());
+    for (const NocLink& link : noc_links) {
+        link_rates_[link.get_link_id()] = link.get_bandwidth() / max_link_bandwidth;
+    }
+
+    injection_rates_.resize(traffic_flow_routes.size(), 0.0);
+    zero_load_latencies_.resize(traffic_flow_routes.size(), 0.0);
+    for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
+        const auto& route = traffic_flow_routes[traffic_flow_id];
+        if (route.empty()) {
+            continue;
+        }
+
+        const t_noc_traffic_flow& traffic_flow = traffic_flow_storage.get_single_noc_traffic_flow(traffic_flow_id);
+        injection_rates_[traffic_flow_id] = traffic_flow.traffic_flow_bandwidth * cycle_time_ / packet_size;
+
+        // the zero-load latency is the latency of the source router, and of each link and its sink router
+        double latency = noc_model.get_detailed_router_latency()
+                             ? noc_model.get_single_noc_router(noc_model.get_single_noc_link(route.front()).get_source_router()).get_latency()
+                             : noc_model.get_noc_router_latency();
+        for (const NocLink& link : noc_model.get_noc_links(route)) {
+            latency += noc_model.get_detailed_link_latency() ? link.get_latency() : noc_model.get_noc_link_latency();
+            latency += noc_model.get_detailed_router_latency() ? noc_model.get_single_noc_router(link.get_sink_router()).get_latency()
+                                                               : noc_model.get_noc_router_latency();
+        }
+        zero_load_latencies_[traffic_flow_id] = latency;
+    }
+}
+
+t_noc_sim_results NocSimulator::run(size_t num_cycles, size_t num_warmup_cycles, int seed) const {
+    vtr::ScopedStartFinishTimer timer("NoC Simulation");
+
+    VTR_ASSERT(num_warmup_cycles < num_cycles);
+
+    const size_t num_routers = noc_model_.get_noc_routers().size();
+    const size_t num_links = noc_model_.get_noc_links().size();
+    const size_t num_traffic_flows = traffic_flow_routes_.size();
+
+    vtr::RngContainer rng(seed);
+
+    // the packets waiting to be sent over each link, and the number of packets each link can still send
+    vtr::vector<NocLinkId, std::deque<t_noc_sim_packet>> link_queues(num_links);
+    vtr::vector<NocLinkId, double> link_credits(num_links, 0.0);
+    vtr::vector<NocLinkId, size_t> link_num_sent_packets(num_links, 0);
+
+    // the packets each router sent to the next link of their route or delivered in the current cycle
+    vtr::vector<NocRouterId, std::vector<t_noc_sim_packet>> forwarded_packets(num_routers);
+    vtr::vector<NocRouterId, std::vector<t_noc_sim_packet>> delivered_packets(num_routers);
+
+    // the number of delivered packets of each traffic flow per queueing delay (in cycles)
+    vtr::vector<NocTrafficFlowId, std::vector<size_t>> queueing_delay_histograms(num_traffic_flows);
+
+    t_noc_sim_results results;
+    results.cycle_time = cycle_time_;
+    results.num_cycles = num_cycles;
+    results.num_warmup_cycles = num_warmup_cycles;
+    results.link_stats.resize(num_links);
+    results.traffic_flow_stats.resize(num_traffic_flows);
+
+    // sends the packets queued at the outgoing links of a router
+    auto update_router = [&](NocRouterId router_id, size_t cycle) {
+        auto& forwarded = forwarded_packets[router_id];
+        auto& delivered = delivered_packets[router_id];
+        forwarded.clear();
+        delivered.clear();
+
+        for (NocLinkId link_id : noc_model_.get_noc_router_outgoing_links(router_id)) {
+            auto& queue = link_queues[link_id];
+            double& credits = link_credits[link_id];
+            credits += link_rates_[link_id];
+
+            auto& link_stats = results.link_stats[link_id];
+            link_stats.max_queue_length = std::max(link_stats.max_queue_length, queue.size());
+
+            while (credits >= 1.0 && !queue.empty()) {
+                t_noc_sim_packet packet = queue.front();
+                queue.pop_front();
+                credits -= 1.0;
+                if (cycle >= num_warmup_cycles) {
+                    link_num_sent_packets[link_id]++;
+                }
+
+                if (packet.hop + 1 == traffic_flow_routes_[packet.traffic_flow_id].size()) {
+                    delivered.push_back(packet);
+                } else {
+                    packet.hop++;
+                    forwarded.push_back(packet);
+                }
+            }
+
+            // unused bandwidth cannot be saved up, an idle link can send at most one packet in the next cycle
+            if (queue.empty()) {
+                credits = std::min(credits, 1.0 - link_rates_[link_id]);
+            }
+        }
+    };
+
+    for (size_t cycle = 0; cycle < num_cycles; cycle++) {
+        // inject the new packets
+        for (size_t i = 0; i < num_traffic_flows; i++) {
+            NocTrafficFlowId traffic_flow_id(i);
+            const double rate = injection_rates_[traffic_flow_id];
+            if (rate <= 0.0) {
+                continue;
+            }
+
+            double num_packets = std::floor(rate);
+            if (rng.frand() < rate - num_packets) {
+                num_packets += 1.0;
+            }
+
+            auto& queue = link_queues[traffic_flow_routes_[traffic_flow_id].front()];
+            for (int ipacket = 0; ipacket < (int)num_packets; ipacket++) {
+                queue.push_back({traffic_flow_id, 0, cycle});
+            }
+        }
+
+        // each router only touches its outgoing links and its own packet lists
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(size_t(0), num_routers, [&](size_t irouter) {
+            update_router(NocRouterId(irouter), cycle);
+        });
+#else
+        for (size_t irouter = 0; irouter < num_routers; irouter++) {
+            update_router(NocRouterId(irouter), cycle);
+        }
+#endif
+
+        // move the packets to their next link (in router order to be deterministic) and record the delivered ones
+        for (size_t irouter = 0; irouter < num_routers; irouter++) {
+            NocRouterId router_id(irouter);
+            for (const t_noc_sim_packet& packet : forwarded_packets[router_id]) {
+                link_queues[traffic_flow_routes_[packet.traffic_flow_id][packet.hop]].push_back(packet);
+            }
+
+            for (const t_noc_sim_packet& packet : delivered_packets[router_id]) {
+                if (packet.injection_cycle < num_warmup_cycles) {
+                    continue;
+                }
+                // without queueing, a packet is sent over one link per cycle
+                const size_t route_length = traffic_flow_routes_[packet.traffic_flow_id].size();
+                const size_t queueing_delay = cycle - packet.injection_cycle - (route_length - 1);
+                auto& histogram = queueing_delay_histograms[packet.traffic_flow_id];
+                if (histogram.size() <= queueing_delay) {
+                    histogram.resize(queueing_delay + 1, 0);
+                }
+                histogram[queueing_delay]++;
+            }
+        }
+    }
+
+    // the measured packets still in the NoC
+    for (const auto& queue : link_queues) {
+        for (const t_noc_sim_packet& packet : queue) {
+            if (packet.injection_cycle >= num_warmup_cycles) {
+                results.num_undelivered_packets++;
+            }
+        }
+    }
+
+    // link statistics
+    const auto num_measured_cycles = (double)(num_cycles - num_warmup_cycles);
+    for (auto traffic_flow_id : traffic_flow_storage_.get_all_traffic_flow_id()) {
+        const double bandwidth = traffic_flow_storage_.get_single_noc_traffic_flow(traffic_flow_id).traffic_flow_bandwidth;
+        for (NocLinkId link_id : traffic_flow_routes_[traffic_flow_id]) {
+            results.link_stats[link_id].offered_load += bandwidth / noc_model_.get_single_noc_link(link_id).get_bandwidth();
+        }
+    }
+    for (const NocLink& link : noc_model_.get_noc_links()) {
+        NocLinkId link_id = link.get_link_id();
+        auto& link_stats = results.link_stats[link_id];
+        link_stats.utilization = (double)link_num_sent_packets[link_id] / (num_measured_cycles * link_rates_[link_id]);
+        link_stats.saturated = link_stats.utilization >= SATURATION_UTILIZATION;
+        if (link_stats.saturated) {
+            results.num_saturated_links++;
+        }
+    }
+
+    // traffic flow and overall latency statistics
+    std::vector<std::pair<double, size_t>> latency_distribution;
+    double latency_sum = 0.0;
+    for (auto traffic_flow_id : traffic_flow_storage_.get_all_traffic_flow_id()) {
+        const auto& histogram = queueing_delay_histograms[traffic_flow_id];
+        auto& flow_stats = results.traffic_flow_stats[traffic_flow_id];
+        const double max_latency_constraint = traffic_flow_storage_.get_single_noc_traffic_flow(traffic_flow_id).max_traffic_flow_latency;
+
+        std::vector<std::pair<double, size_t>> flow_latency_distribution;
+        double flow_latency_sum = 0.0;
+        for (size_t delay = 0; delay < histogram.size(); delay++) {
+            if (histogram[delay] == 0) {
+                continue;
+            }
+            double latency = zero_load_latencies_[traffic_flow_id] + (double)delay * cycle_time_;
+            flow_latency_distribution.emplace_back(latency, histogram[delay]);
+            flow_stats.num_delivered_packets += histogram[delay];
+            flow_latency_sum += latency * (double)histogram[delay];
+        }
+
+        if (flow_stats.num_delivered_packets > 0) {
+            flow_stats.mean_latency = flow_latency_sum / (double)flow_stats.num_delivered_packets;
+            flow_stats.p99_latency = get_percentile(flow_latency_distribution, flow_stats.num_delivered_packets, 0.99);
+            flow_stats.max_latency = flow_latency_distribution.back().first;
+            flow_stats.meets_latency_constraint = flow_stats.p99_latency <= max_latency_constraint;
+        } else {
+            // a flow with traffic that delivered nothing within the simulation is stuck behind saturated links
+            flow_stats.meets_latency_constraint = injection_rates_[traffic_flow_id] <= 0.0;
+        }
+        if (flow_stats.meets_latency_constraint) {
+            results.num_traffic_flows_meeting_latency++;
+        }
+
+        results.num_delivered_packets += flow_stats.num_delivered_packets;
+        latency_sum += flow_latency_sum;
+        latency_distribution.insert(latency_distribution.end(), flow_latency_distribution.begin(), flow_latency_distribution.end());
+    }
+
+    if (results.num_delivered_packets > 0) {
+        std::sort(latency_distribution.begin(), latency_distribution.end());
+        results.mean_latency = latency_sum / (double)results.num_delivered_packets;
+        results.p50_latency = get_percentile(latency_distribution, results.num_delivered_packets, 0.50);
+        results.p90_latency = get_percentile(latency_distribution, results.num_delivered_packets, 0.90);
+        results.p99_latency = get_percentile(latency_distribution, results.num_delivered_packets, 0.99);
+        results.max_latency = latency_distribution.back().first;
+    }
+
+    return results;
+}
+
+void print_noc_simulation_results(const t_noc_sim_results& results,
+                                  const NocStorage& noc_model,
+                                  int num_top_links) {
+    VTR_LOG("\nNoC simulation: %zu cycles (%zu warm-up) of %g s. Measured packets delivered: %zu, still in the NoC: %zu\n",
+            results.num_cycles, results.num_warmup_cycles, results.cycle_time,
+            results.num_delivered_packets, results.num_undelivered_packets);
+    VTR_LOG("NoC simulation packet latency (s): mean %g, p50 %g, p90 %g, p99 %g, max %g\n",
+            results.mean_latency, results.p50_latency, results.p90_latency, results.p99_latency, results.max_latency);
+    VTR_LOG("NoC simulation traffic flows meeting their latency constraint (p99): %d of %zu\n",
+            results.num_traffic_flows_meeting_latency, results.traffic_flow_stats.size());
+    VTR_LOG("NoC simulation saturated links: %d of %zu\n",
+            results.num_saturated_links, results.link_stats.size());
+
+    // print the most utilized links
+    std::vector<NocLinkId> link_ids(results.link_stats.keys().begin(), results.link_stats.keys().end());
+    const size_t num_links_to_print = std::min(link_ids.size(), (size_t)std::max(num_top_links, 0));
+    std::partial_sort(link_ids.begin(), link_ids.begin() + num_links_to_print, link_ids.end(),
+                      [&results](NocLinkId a, NocLinkId b) {
+                          return results.link_stats[a].utilization > results.link_stats[b].utilization;
+                      });
+    for (size_t i = 0; i < num_links_to_print; i++) {
+        NocLinkId link_id = link_ids[i];
+        const NocLink& link = noc_model.get_single_noc_link(link_id);
+        const auto& link_stats = results.link_stats[link_id];
+        VTR_LOG("\tLink %zu (router %d -> router %d): utilization %g, offered load %g, max queue length %zu%s\n",
+                (size_t)link_id,
+                noc_model.get_single_noc_router(link.get_source_router()).get_router_user_id(),
+                noc_model.get_single_noc_router(link.get_sink_router()).get_router_user_id(),
+                link_stats.utilization, link_stats.offered_load, link_stats.max_queue_length,
+                link_stats.saturated ? " (saturated)" : "");
+    }
+}
@@ -0,0 +1,165 @@
+#pragma once
+/**
+ * @file
+ * @brief This file declares the NocSimulator class, a fast cycle-approximate
+ * simulator used to validate a NoC placement under load.
+ *
+ * Overview
+ * ========
+ * The NoC placement cost is computed analytically from the traffic flow
+ * bandwidths: it does not model the queueing of packets in the NoC. The
+ * simulator replays the traffic flows over their routes to measure the
+ * latency that packets actually experience and how busy each link is.
+ *
+ * Model
+ * =====
+ * Traffic is made of fixed-size packets. Time is divided into cycles, a cycle
+ * being the time needed to send one packet over the fastest NoC link. In each
+ * cycle:
+ *  - Every traffic flow injects packets into the first link of its route. The
+ *    number of packets injected per cycle is random, with a mean that matches
+ *    the bandwidth of the traffic flow.
+ *  - Every link sends the packets in its (FIFO) queue to the next link of
+ *    their route, at a rate given by the bandwidth of the link. Unused
+ *    bandwidth cannot be saved up for later cycles.
+ *
+ * The latency of a packet is the zero-load latency of its traffic flow (the
+ * latency of the routers and links on its route, as used by the NoC cost)
+ * plus the number of cycles it waited in the queues.
+ *
+ * The links are owned by their source router, and the links of each router
+ * are updated in parallel (if VPR is built with TBB). The packets that move
+ * from one router to the next are then merged serially, in router order, so
+ * the results do not depend on the number of threads. Links without queued
+ * packets are only given their new bandwidth credit.
+ */
+
+#include <vector>
+
+#include "noc_data_types.h"
+#include "noc_storage.h"
+#include "noc_traffic_flows.h"
+#include "vtr_vector.h"
+
+/**
+ * @brief The statistics of one traffic flow, measured by the simulator.
+ */
+struct t_noc_sim_traffic_flow_stats {
+    /// The number of packets of this flow that were delivered.
+    size_t num_delivered_packets = 0;
+    /// The average latency of the delivered packets (in seconds).
+    double mean_latency = 0.0;
+    /// The 99th percentile latency of the delivered packets (in seconds).
+    double p99_latency = 0.0;
+    /// The maximum latency of the delivered packets (in seconds).
+    double max_latency = 0.0;
+    /// Whether the 99th percentile latency meets the latency constraint of the flow.
+    bool meets_latency_constraint = true;
+};
+
+/**
+ * @brief The statistics of one link, measured by the simulator.
+ */
+struct t_noc_sim_link_stats {
+    /// The fraction of the link bandwidth used to send packets.
+    double utilization = 0.0;
+    /// The bandwidth of the traffic flows routed through this link, divided by the link bandwidth.
+    double offered_load = 0.0;
+    /// The longest queue of packets waiting to be sent over the link.
+    size_t max_queue_length = 0;
+    /// Whether the link could not keep up with its traffic (see NocSimulator::SATURATION_UTILIZATION).
+    bool saturated = false;
+};
+
+/**
+ * @brief The results of a NoC simulation.
+ */
+struct t_noc_sim_results {
+    /// The duration of a simulated cycle (in seconds).
+    double cycle_time = 0.0;
+    /// The number of simulated cycles, and the number of these cycles used to warm the NoC up.
+    size_t num_cycles = 0;
+    size_t num_warmup_cycles = 0;
+
+    /// The number of measured packets that were delivered, and that were still in the NoC at the end.
+    size_t num_delivered_packets = 0;
+    size_t num_undelivered_packets = 0;
+
+    /// The distribution of the latency of all the delivered packets (in seconds).
+    double mean_latency = 0.0;
+    double p50_latency = 0.0;
+    double p90_latency = 0.0;
+    double p99_latency = 0.0;
+    double max_latency = 0.0;
+
+    vtr::vector<NocTrafficFlowId, t_noc_sim_traffic_flow_stats> traffic_flow_stats;
+    vtr::vector<NocLinkId, t_noc_sim_link_stats> link_stats;
+
+    /// The number of traffic flows that meet their latency constraint.
+    int num_traffic_flows_meeting_latency = 0;
+    /// The number of saturated links.
+    int num_saturated_links = 0;
+};
+
+class NocSimulator {
+  public:
+    NocSimulator() = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param noc_model The NoC whose links are simulated.
+     * @param traffic_flow_storage The traffic flows sent over the NoC.
+     * @param traffic_flow_routes The route of each traffic flow. Traffic flows
+     * with an empty route (between blocks on the same router) are not simulated.
+     * @param packet_size The size of a packet (in bits).
+     */
+    NocSimulator(const NocStorage& noc_model,
+                 const NocTrafficFlows& traffic_flow_storage,
+                 const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& traffic_flow_routes,
+                 double packet_size);
+
+    /**
+     * @brief Simulates the NoC.
+     *
+     * @param num_cycles The number of cycles to simulate.
+     * @param num_warmup_cycles The packets injected during the first
+     * num_warmup_cycles cycles are not measured, so that the queues of the
+     * NoC get to their steady state before the statistics are collected.
+     * @param seed The seed of the random packet injection.
+     * @return The measured statistics.
+     */
+    t_noc_sim_results run(size_t num_cycles, size_t num_warmup_cycles, int seed) const;
+
+    /**
+     * @brief A link whose utilization is at least SATURATION_UTILIZATION is
+     * considered saturated: its queue keeps growing, or would with a little
+     * more traffic.
+     */
+    static constexpr double SATURATION_UTILIZATION = 0.98;
+
+  private:
+    const NocStorage& noc_model_;
+    const NocTrafficFlows& traffic_flow_storage_;
+    const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& traffic_flow_routes_;
+
+    /// The duration of a cycle (in seconds).
+    double cycle_time_;
+    /// The average number of packets each traffic flow injects per cycle.
+    vtr::vector<NocTrafficFlowId, double> injection_rates_;
+    /// The average number of packets each link can send per cycle (at most 1).
+    vtr::vector<NocLinkId, double> link_rates_;
+    /// The zero-load latency of each traffic flow (in seconds).
+    vtr::vector<NocTrafficFlowId, double> zero_load_latencies_;
+};
+
+/**
+ * @brief Prints the results of a NoC simulation.
+ *
+ * @param results The results to print.
+ * @param noc_model Used to print the routers of the most utilized links.
+ * @param num_top_links The number of most utilized links to print.
+ */
+void print_noc_simulation_results(const t_noc_sim_results& results,
+                                  const NocStorage& noc_model,
+                                  int num_top_links = 5);
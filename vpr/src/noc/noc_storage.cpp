@@ -1,5 +1,6 @@
 
 #include "noc_storage.h"
+#include "noc_routing.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vpr_error.h"
@@ -260,10 +261,70 @@ void NocStorage::clear_noc() {
     router_incoming_links_list.clear();
     router_id_conversion_table.clear();
     grid_location_to_router_id.clear();
+    route_table_links.clear();
+    route_table_offsets.clear();
+    route_table_route_found.clear();
 
     built_noc = false;
 }
 
+void NocStorage::build_route_table(NocRouting& noc_routing_algorithm) {
+    VTR_ASSERT_MSG(built_noc, "The NoC must be built before its route table.");
+    VTR_ASSERT(!noc_routing_algorithm.route_depends_on_traffic_flow());
+
+    route_table_links.clear();
+    route_table_offsets.clear();
+    route_table_route_found.clear();
+
+    const size_t num_routers = router_storage.size();
+    if (num_routers == 0 || num_routers > MAX_NUM_ROUTERS_FOR_ROUTE_TABLE) {
+        return;
+    }
+
+    route_table_offsets.reserve(num_routers * num_routers + 1);
+    route_table_route_found.reserve(num_routers * num_routers);
+    route_table_offsets.push_back(0);
+
+    std::vector<NocLinkId> route;
+    for (size_t src = 0; src < num_routers; src++) {
+        for (size_t sink = 0; sink < num_routers; sink++) {
+            // the routing algorithms error out when there is no route between two routers
+            bool route_found = true;
+            try {
+                noc_routing_algorithm.route_flow(NocRouterId(src), NocRouterId(sink), NocTrafficFlowId::INVALID(), route, *this);
+            } catch (const VprError&) {
+                route_found = false;
+            }
+
+            if (route_found) {
+                route_table_links.insert(route_table_links.end(), route.begin(), route.end());
+            }
+            route_table_route_found.push_back(route_found);
+            route_table_offsets.push_back(route_table_links.size());
+        }
+    }
+    route_table_links.shrink_to_fit();
+}
+
+bool NocStorage::has_route_table() const {
+    return !route_table_offsets.empty();
+}
+
+bool NocStorage::get_route_from_table(NocRouterId src_router_id,
+                                      NocRouterId sink_router_id,
+                                      std::vector<NocLinkId>& flow_route) const {
+    VTR_ASSERT_SAFE(has_route_table());
+
+    const size_t key = size_t(src_router_id) * router_storage.size() + size_t(sink_router_id);
+    if (!route_table_route_found[key]) {
+        return false;
+    }
+
+    flow_route.assign(route_table_links.begin() + route_table_offsets[key],
+                      route_table_links.begin() + route_table_offsets[key + 1]);
+    return true;
+}
+
 NocRouterId NocStorage::convert_router_id(int id) const {
     auto result = router_id_conversion_table.find(id);
 
@@ -41,6 +41,9 @@
 #include "noc_router.h"
 #include "noc_link.h"
 
+// forward declaration of the routing algorithm interface
+class NocRouting;
+
 class NocStorage {
   private:
     /** Contains all the routers in the NoC*/
@@ -144,6 +147,24 @@ class NocStorage {
      */
     bool multi_layer_noc_;
 
+    /**
+     * @brief Stores the route between every pair of routers in the NoC, found
+     * by a routing algorithm whose routes only depend on the source and sink
+     * routers (see build_route_table()). The routes are stored contiguously:
+     * the route from router src to router sink is made of the links
+     * route_table_links[route_table_offsets[key], route_table_offsets[key + 1]),
+     * where key = src * number of routers + sink.
+     * Empty if the route table was not built.
+     */
+    std::vector<NocLinkId> route_table_links;
+    std::vector<uint32_t> route_table_offsets;
+
+    /**
+     * @brief Indicates, for each pair of routers (indexed by the same key as
+     * route_table_offsets), whether the routing algorithm found a route.
+     */
+    std::vector<bool> route_table_route_found;
+
     /**
      * @brief A constant reference to this vector is returned by get_noc_links(...).
      * This is used to avoid memory allocation whenever get_noc_links(...) is called.
@@ -466,6 +487,51 @@ class NocStorage {
      */
     void finished_building_noc();
 
+    /**
+     * @brief The largest number of routers for which build_route_table()
+     * builds the all-pairs route table. The table grows with the square of
+     * the number of routers.
+     */
+    static constexpr int MAX_NUM_ROUTERS_FOR_ROUTE_TABLE = 256;
+
+    /**
+     * @brief Routes every pair of routers in the NoC with the given routing
+     * algorithm and stores the routes, so that they can later be looked up
+     * in constant time with get_route_from_table(). The routing algorithm
+     * must find the same route for all the traffic flows between a pair of
+     * routers (see NocRouting::route_depends_on_traffic_flow()). This
+     * should be called after the NoC is built.
+     *
+     * The table is not built if the NoC has more than
+     * MAX_NUM_ROUTERS_FOR_ROUTE_TABLE routers.
+     *
+     * @param noc_routing_algorithm The routing algorithm used to find the
+     * routes.
+     */
+    void build_route_table(NocRouting& noc_routing_algorithm);
+
+    /**
+     * @brief Indicates whether the all-pairs route table was built.
+     */
+    bool has_route_table() const;
+
+    /**
+     * @brief Looks up the route between two routers in the all-pairs route
+     * table. The route table must have been built.
+     *
+     * @param src_router_id The source router of the route.
+     * @param sink_router_id The sink router of the route.
+     * @param flow_route Stores the route found in the table. Any previously
+     * stored route is cleared.
+     * @return true The routing algorithm found a route between the two
+     * routers, which was stored in flow_route.
+     * @return false The routing algorithm could not find a route between the
+     * two routers.
+     */
+    bool get_route_from_table(NocRouterId src_router_id,
+                              NocRouterId sink_router_id,
+                              std::vector<NocLinkId>& flow_route) const;
+
     /**
      * @brief Resets the NoC by clearing all internal data structures.
      * This includes deleting all routers and links. Also all internal
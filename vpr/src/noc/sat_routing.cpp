@@ -6,7 +6,9 @@
 #include "globals.h"
 #include "vtr_time.h"
 
+#include <numeric>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "ortools/sat/cp_model.h"
 #include "ortools/sat/cp_model.pb.h"
@@ -21,6 +23,69 @@ namespace orsat = operations_research::sat;
  */
 typedef std::unordered_map<std::pair<NocTrafficFlowId, NocLinkId>, orsat::BoolVar> t_flow_link_var_map;
 
+/**
+ * The minimum time budget (in seconds) given to each traffic flow group when a
+ * time limit is set, so that the solver always gets a chance to return the hint.
+ */
+static constexpr double MIN_GROUP_TIME_LIMIT = 0.1;
+
+/**
+ * A group of traffic flows that are routed together in one CP-SAT model.
+ * Traffic flows in different groups cannot share any NoC link, so each group
+ * is an independent (and much smaller) SAT problem.
+ */
+struct t_flow_group {
+    /// The traffic flows in this group.
+    std::vector<NocTrafficFlowId> traffic_flow_ids;
+    /// The NoC links that at least one traffic flow in this group may traverse.
+    std::vector<NocLinkId> noc_link_ids;
+};
+
+/**
+ * @brief Returns the NoC routers where the source and sink logical routers of
+ * the given traffic flow are placed.
+ */
+static std::pair<NocRouterId, NocRouterId> get_traffic_flow_routers(NocTrafficFlowId traffic_flow_id);
+
+/**
+ * @brief Finds the NoC links that the given traffic flow may traverse.
+ *
+ * A link may be part of the route of a traffic flow only if its source router
+ * is reachable from the traffic flow's source router and the traffic flow's
+ * sink router is reachable from its sink router. No variable is created for
+ * the other (traffic flow, link) pairs.
+ *
+ * @param traffic_flow_id The traffic flow whose candidate links are returned.
+ * @return The candidate NoC links, sorted by ID.
+ */
+static std::vector<NocLinkId> find_candidate_links(NocTrafficFlowId traffic_flow_id);
+
+/**
+ * @brief Partitions the traffic flows into groups that do not share any
+ * candidate link. Groups are independent and are solved one after another.
+ *
+ * @param candidate_links The candidate links of each traffic flow.
+ * @return The independent traffic flow groups.
+ */
+static std::vector<t_flow_group> find_independent_flow_groups(const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& candidate_links);
+
+/**
+ * @brief Builds and solves the CP-SAT model of one traffic flow group. The
+ * found routes of the group's traffic flows are written into routes.
+ * The solver is stopped after time_limit seconds (if positive), and starts
+ * from warm_start_routes (if not empty).
+ *
+ * @return True if a feasible routing was found for the group.
+ */
+static bool solve_flow_group(const t_flow_group& flow_group,
+                             const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& candidate_links,
+                             bool minimize_aggregate_bandwidth,
+                             const t_noc_opts& noc_opts,
+                             int seed,
+                             double time_limit,
+                             const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& warm_start_routes,
+                             vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& routes);
+
 /**
  * @brief  Creates a boolean variable for each (traffic flow, link) pair.
  * It also create integer variables for latency-constrained traffic flows.
@@ -33,10 +98,14 @@ typedef std::unordered_map<std::pair<NocTrafficFlowId, NocLinkId>, orsat::BoolVa
  * @param latency_overrun_vars The created integer variables for latency-constrained
  * traffic flows are added to this container for future use, e.g. adding constraints
  * and defining objective functions.
+ * @param traffic_flow_ids The traffic flows in the model.
+ * @param candidate_links The links for which a variable is created for each traffic flow.
  */
 static void create_flow_link_vars(orsat::CpModelBuilder& cp_model,
                                   t_flow_link_var_map& flow_link_vars,
-                                  std::map<NocTrafficFlowId, orsat::IntVar>& latency_overrun_vars);
+                                  std::map<NocTrafficFlowId, orsat::IntVar>& latency_overrun_vars,
+                                  const std::vector<NocTrafficFlowId>& traffic_flow_ids,
+                                  const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& candidate_links);
 
 /**
  * @brief Translates a latency constraint for a traffic flow to the maximum number
@@ -95,9 +164,11 @@ static void constrain_latency_overrun_vars(orsat::CpModelBuilder& cp_model,
  * @param flow_link_vars Boolean variable container for (traffic flow, link) pairs.
  * @param cp_model The CP model builder object. New constraints are added
  * to this model builder object.
+ * @param traffic_flow_ids The traffic flows in the model.
  */
 static void forbid_illegal_turns(t_flow_link_var_map& flow_link_vars,
-                                 orsat::CpModelBuilder& cp_model);
+                                 orsat::CpModelBuilder& cp_model,
+                                 const std::vector<NocTrafficFlowId>& traffic_flow_ids);
 
 /**
  * @brief Creates a boolean variable for each link to indicate
@@ -115,11 +186,14 @@ static void forbid_illegal_turns(t_flow_link_var_map& flow_link_vars,
  * to this model builder object. Constraints are also added to this object.
  * @param bandwidth_resolution Specifies the resolution by which bandwidth
  * values are quantized.
+ * @param flow_group The traffic flows in the model and their candidate links.
+ * A variable is only created for the candidate links.
  */
-static void create_congested_link_vars(vtr::vector<NocLinkId, orsat::BoolVar>& congested_link_vars,
+static void create_congested_link_vars(std::vector<orsat::BoolVar>& congested_link_vars,
                                        t_flow_link_var_map& flow_link_vars,
                                        orsat::CpModelBuilder& cp_model,
-                                       int bandwidth_resolution);
+                                       int bandwidth_resolution,
+                                       const t_flow_group& flow_group);
 
 /**
  * @brief Quantize traffic flow bandwidths. The maximum NoC link bandwidth is
@@ -140,9 +214,11 @@ static vtr::vector<NocTrafficFlowId, int> quantize_traffic_flow_bandwidths(int b
  * @param flow_link_vars Boolean variable container for (traffic flow, link) pairs.
  * @param cp_model The CP model builder object. New constraints are added
  * to this model builder object.
+ * @param traffic_flow_ids The traffic flows in the model.
  */
 static void add_continuity_constraints(t_flow_link_var_map& flow_link_vars,
-                                       orsat::CpModelBuilder& cp_model);
+                                       orsat::CpModelBuilder& cp_model,
+                                       const std::vector<NocTrafficFlowId>& traffic_flow_ids);
 
 /**
  * @brief Creates a linear expression to be minimized by the SAT solver.
@@ -164,6 +240,9 @@ static void add_continuity_constraints(t_flow_link_var_map& flow_link_vars,
  * @param congestion_weight Specifies the importance of avoiding congestion in links.
  * @param minimize_aggregate_bandwidth Specifies whether the objective includes an
  * aggregate bandwidth term.
+ * @param traffic_flow_ids The traffic flows in the model.
+ * @param warm_start_routes The current route of each traffic flow, given to
+ * the solver as a (complete) hint. Empty to solve without a hint.
  *
  * @return A linear expression including latency overrun, the number of congested links,
  * and the aggregate bandwidth;
@@ -171,11 +250,13 @@ static void add_continuity_constraints(t_flow_link_var_map& flow_link_vars,
 static orsat::LinearExpr create_objective(orsat::CpModelBuilder& cp_model,
                                           t_flow_link_var_map& flow_link_vars,
                                           std::map<NocTrafficFlowId, orsat::IntVar>& latency_overrun_vars,
-                                          vtr::vector<NocLinkId, orsat::BoolVar>& congested_link_vars,
+                                          std::vector<orsat::BoolVar>& congested_link_vars,
                                           int bandwidth_resolution,
                                           int latency_overrun_weight,
                                           int congestion_weight,
-                                          bool minimize_aggregate_bandwidth);
+                                          bool minimize_aggregate_bandwidth,
+                                          const std::vector<NocTrafficFlowId>& traffic_flow_ids,
+                                          const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& warm_start_routes);
 
 /**
  * @brief Converts the activated (traffic flow, link) boolean variables to
@@ -189,10 +270,12 @@ static orsat::LinearExpr create_objective(orsat::CpModelBuilder& cp_model,
  * @param flow_link_vars Boolean variable container for (traffic flow, link) pairs.
  * @param response The SAT solver's response. This object is used to query the values
  * of (traffic flow, link) variables.
- * @return Traffic flow routes. NoC links may not be stored in the route traversal order.
+ * @param routes The routes of the traffic flows in flow_link_vars are replaced
+ * with the routes found by the solver. NoC links are sorted in the route traversal order.
  */
-static vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> convert_vars_to_routes(t_flow_link_var_map& flow_link_vars,
-                                                                                    const orsat::CpSolverResponse& response);
+static void convert_vars_to_routes(t_flow_link_var_map& flow_link_vars,
+                                   const orsat::CpSolverResponse& response,
+                                   vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& routes);
 
 /**
  * @brief Sorts the given NoC links so that they can traversed one after another.
@@ -226,9 +309,9 @@ static std::vector<orsat::BoolVar> get_flow_link_vars(const t_flow_link_var_map&
 }
 
 static void forbid_illegal_turns(t_flow_link_var_map& flow_link_vars,
-                                 orsat::CpModelBuilder& cp_model) {
+                                 orsat::CpModelBuilder& cp_model,
+                                 const std::vector<NocTrafficFlowId>& traffic_flow_ids) {
     const auto& noc_ctx = g_vpr_ctx.noc();
-    const auto& traffic_flow_storage = noc_ctx.noc_traffic_flows_storage;
 
     auto noc_routing_alg = dynamic_cast<const TurnModelRouting*>(noc_ctx.noc_flows_router.get());
     // ensure that the routing algorithm is a turn model algorithm
@@ -237,11 +320,15 @@ static void forbid_illegal_turns(t_flow_link_var_map& flow_link_vars,
     // forbid illegal turns based on the routing algorithm
     // this includes 180 degree turns
     for (const auto& [link1, link2] : noc_routing_alg->get_all_illegal_turns(noc_ctx.noc_model)) {
-        for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
-            auto& first_var = flow_link_vars[{traffic_flow_id, link1}];
-            auto& second_var = flow_link_vars[{traffic_flow_id, link2}];
+        for (auto traffic_flow_id : traffic_flow_ids) {
+            auto first_it = flow_link_vars.find({traffic_flow_id, link1});
+            auto second_it = flow_link_vars.find({traffic_flow_id, link2});
+            // the turn cannot be taken if one of its links is not a candidate link
+            if (first_it == flow_link_vars.end() || second_it == flow_link_vars.end()) {
+                continue;
+            }
             // at most one of two consecutive links that form a turn can be activated
-            cp_model.AddBoolOr({first_var.Not(), second_var.Not()});
+            cp_model.AddBoolOr({first_it->second.Not(), second_it->second.Not()});
         }
     }
 }
@@ -281,25 +368,24 @@ static vtr::vector<NocTrafficFlowId, int> quantize_traffic_flow_bandwidths(int b
     return rescaled_traffic_flow_bandwidths;
 }
 
-static void create_congested_link_vars(vtr::vector<NocLinkId, orsat::BoolVar>& congested_link_vars,
+static void create_congested_link_vars(std::vector<orsat::BoolVar>& congested_link_vars,
                                        t_flow_link_var_map& flow_link_vars,
                                        orsat::CpModelBuilder& cp_model,
-                                       int bandwidth_resolution) {
-    const auto& noc_ctx = g_vpr_ctx.noc();
-    const auto& traffic_flow_storage = noc_ctx.noc_traffic_flows_storage;
-
+                                       int bandwidth_resolution,
+                                       const t_flow_group& flow_group) {
     // quantize traffic flow bandwidth
     vtr::vector<NocTrafficFlowId, int> rescaled_traffic_flow_bandwidths = quantize_traffic_flow_bandwidths(bandwidth_resolution);
 
-    // go over all NoC links and create a boolean variable for each one to indicate if it is congested
-    for (const auto& noc_link : noc_ctx.noc_model.get_noc_links()) {
-        const NocLinkId noc_link_id = noc_link.get_link_id();
+    // go over the candidate NoC links and create a boolean variable for each one to indicate if it is congested
+    for (const NocLinkId noc_link_id : flow_group.noc_link_ids) {
         orsat::LinearExpr bandwidth_load;
 
         // compute the total bandwidth routed through this link
-        for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
-            orsat::BoolVar binary_var = flow_link_vars[{traffic_flow_id, noc_link_id}];
-            bandwidth_load += orsat::LinearExpr::Term(binary_var, rescaled_traffic_flow_bandwidths[traffic_flow_id]);
+        for (auto traffic_flow_id : flow_group.traffic_flow_ids) {
+            auto it = flow_link_vars.find({traffic_flow_id, noc_link_id});
+            if (it != flow_link_vars.end()) {
+                bandwidth_load += orsat::LinearExpr::Term(it->second, rescaled_traffic_flow_bandwidths[traffic_flow_id]);
+            }
         }
 
         orsat::BoolVar congested = cp_model.NewBoolVar();
@@ -310,23 +396,15 @@ static void create_congested_link_vars(vtr::vector<NocLinkId, orsat::BoolVar>& c
 }
 
 static void add_continuity_constraints(t_flow_link_var_map& flow_link_vars,
-                                       orsat::CpModelBuilder& cp_model) {
+                                       orsat::CpModelBuilder& cp_model,
+                                       const std::vector<NocTrafficFlowId>& traffic_flow_ids) {
     const auto& noc_ctx = g_vpr_ctx.noc();
-    const auto& traffic_flow_storage = noc_ctx.noc_traffic_flows_storage;
-    const auto& place_ctx = g_vpr_ctx.placement();
 
     // constrain the links that can be activated for each traffic flow in a way that they
     // form a continuous route
-    for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
-        const auto& traffic_flow = traffic_flow_storage.get_single_noc_traffic_flow(traffic_flow_id);
-
-        // get the source and destination logical router blocks in the current traffic flow
-        ClusterBlockId logical_source_router_block_id = traffic_flow.source_router_cluster_id;
-        ClusterBlockId logical_sink_router_block_id = traffic_flow.sink_router_cluster_id;
-
+    for (auto traffic_flow_id : traffic_flow_ids) {
         // get the ids of the hard router blocks where the logical router cluster blocks have been placed
-        NocRouterId source_router_id = noc_ctx.noc_model.get_router_at_grid_location(place_ctx.block_locs[logical_source_router_block_id].loc);
-        NocRouterId sink_router_id = noc_ctx.noc_model.get_router_at_grid_location(place_ctx.block_locs[logical_sink_router_block_id].loc);
+        auto [source_router_id, sink_router_id] = get_traffic_flow_routers(traffic_flow_id);
 
         // exactly one outgoing link of the source must be selected
         const auto& src_outgoing_link_ids = noc_ctx.noc_model.get_noc_router_outgoing_links(source_router_id);
@@ -417,36 +495,34 @@ static std::vector<NocLinkId> sort_noc_links_in_chain_order(const std::vector<No
     return route;
 }
 
-static vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> convert_vars_to_routes(t_flow_link_var_map& flow_link_vars,
-                                                                                    const orsat::CpSolverResponse& response) {
-    const auto& noc_ctx = g_vpr_ctx.noc();
-    const auto& traffic_flow_storage = noc_ctx.noc_traffic_flows_storage;
-
+static void convert_vars_to_routes(t_flow_link_var_map& flow_link_vars,
+                                   const orsat::CpSolverResponse& response,
+                                   vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& routes) {
     VTR_ASSERT(response.status() == orsat::CpSolverStatus::FEASIBLE || response.status() == orsat::CpSolverStatus::OPTIMAL);
 
-    vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> routes;
-    routes.resize(traffic_flow_storage.get_number_of_traffic_flows());
-
+    std::unordered_set<NocTrafficFlowId> solved_traffic_flows;
     for (auto& [key, var] : flow_link_vars) {
         auto [traffic_flow_id, noc_link_id] = key;
+        if (solved_traffic_flows.insert(traffic_flow_id).second) {
+            routes[traffic_flow_id].clear();
+        }
         bool value = orsat::SolutionBooleanValue(response, var);
         if (value) {
             routes[traffic_flow_id].push_back(noc_link_id);
         }
     }
 
-    for (auto& route : routes) {
-        route = sort_noc_links_in_chain_order(route);
+    for (auto traffic_flow_id : solved_traffic_flows) {
+        routes[traffic_flow_id] = sort_noc_links_in_chain_order(routes[traffic_flow_id]);
     }
-
-    return routes;
 }
 
 static void create_flow_link_vars(orsat::CpModelBuilder& cp_model,
                                   t_flow_link_var_map& flow_link_vars,
-                                  std::map<NocTrafficFlowId, orsat::IntVar>& latency_overrun_vars) {
+                                  std::map<NocTrafficFlowId, orsat::IntVar>& latency_overrun_vars,
+                                  const std::vector<NocTrafficFlowId>& traffic_flow_ids,
+                                  const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& candidate_links) {
     const auto& noc_ctx = g_vpr_ctx.noc();
-    const auto& noc_model = noc_ctx.noc_model;
     const auto& traffic_flow_storage = noc_ctx.noc_traffic_flows_storage;
     // used to access NoC compressed grid
     const auto& place_ctx = g_vpr_ctx.placement();
@@ -480,7 +556,7 @@ static void create_flow_link_vars(orsat::CpModelBuilder& cp_model,
 
     // create boolean variables for each traffic flow and link pair
     // create integer variables for traffic flows with constrained latency
-    for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
+    for (auto traffic_flow_id : traffic_flow_ids) {
         const auto& traffic_flow = traffic_flow_storage.get_single_noc_traffic_flow(traffic_flow_id);
 
         // create an integer variable for each latency-constrained traffic flow
@@ -488,9 +564,8 @@ static void create_flow_link_vars(orsat::CpModelBuilder& cp_model,
             latency_overrun_vars[traffic_flow_id] = cp_model.NewIntVar(latency_overrun_domain);
         }
 
-        // create (traffic flow, NoC link) pair boolean variables
-        for (const auto& noc_link : noc_model.get_noc_links()) {
-            const NocLinkId noc_link_id = noc_link.get_link_id();
+        // create (traffic flow, NoC link) pair boolean variables for the links this traffic flow may traverse
+        for (const NocLinkId noc_link_id : candidate_links[traffic_flow_id]) {
             flow_link_vars[{traffic_flow_id, noc_link_id}] = cp_model.NewBoolVar();
         }
     }
@@ -567,19 +642,27 @@ static void constrain_latency_overrun_vars(orsat::CpModelBuilder& cp_model,
 static orsat::LinearExpr create_objective(orsat::CpModelBuilder& cp_model,
                                           t_flow_link_var_map& flow_link_vars,
                                           std::map<NocTrafficFlowId, orsat::IntVar>& latency_overrun_vars,
-                                          vtr::vector<NocLinkId, orsat::BoolVar>& congested_link_vars,
+                                          std::vector<orsat::BoolVar>& congested_link_vars,
                                           int bandwidth_resolution,
                                           int latency_overrun_weight,
                                           int congestion_weight,
-                                          bool minimize_aggregate_bandwidth) {
-    const auto& noc_ctx = g_vpr_ctx.noc();
-    const auto& traffic_flow_storage = noc_ctx.noc_traffic_flows_storage;
-
+                                          bool minimize_aggregate_bandwidth,
+                                          const std::vector<NocTrafficFlowId>& traffic_flow_ids,
+                                          const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& warm_start_routes) {
     // use the current routing solution as a hint for the SAT solver
-    // This will help the solver by giving a good starting point and tighter initial lower bound on the objective function
-    for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
-        for (auto route_link_id : traffic_flow_storage.get_traffic_flow_route(traffic_flow_id)) {
-            cp_model.AddHint(flow_link_vars[{traffic_flow_id, route_link_id}], true);
+    // This will help the solver by giving a good starting point and tighter initial lower bound on the objective function.
+    // Every (traffic flow, link) variable is hinted, so that the hint is a complete assignment which the solver
+    // can use as its first solution instead of having to repair it.
+    if (!warm_start_routes.empty()) {
+        std::unordered_set<std::pair<NocTrafficFlowId, NocLinkId>> current_route_links;
+        for (auto traffic_flow_id : traffic_flow_ids) {
+            for (auto route_link_id : warm_start_routes[traffic_flow_id]) {
+                current_route_links.insert(std::make_pair(traffic_flow_id, route_link_id));
+            }
+        }
+
+        for (auto& [key, var] : flow_link_vars) {
+            cp_model.AddHint(var, current_route_links.count(key) != 0);
         }
     }
 
@@ -607,11 +690,119 @@ static orsat::LinearExpr create_objective(orsat::CpModelBuilder& cp_model,
     return objective;
 }
 
-vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimize_aggregate_bandwidth,
-                                                                    const t_noc_opts& noc_opts,
-                                                                    int seed) {
-    vtr::ScopedStartFinishTimer timer("NoC SAT Routing");
+static std::pair<NocRouterId, NocRouterId> get_traffic_flow_routers(NocTrafficFlowId traffic_flow_id) {
+    const auto& noc_ctx = g_vpr_ctx.noc();
+    const auto& place_ctx = g_vpr_ctx.placement();
+    const auto& traffic_flow = noc_ctx.noc_traffic_flows_storage.get_single_noc_traffic_flow(traffic_flow_id);
+
+    // get the source and destination logical router blocks in the traffic flow
+    ClusterBlockId logical_source_router_block_id = traffic_flow.source_router_cluster_id;
+    ClusterBlockId logical_sink_router_block_id = traffic_flow.sink_router_cluster_id;
+
+    NocRouterId source_router_id = noc_ctx.noc_model.get_router_at_grid_location(place_ctx.block_locs()[logical_source_router_block_id].loc);
+    NocRouterId sink_router_id = noc_ctx.noc_model.get_router_at_grid_location(place_ctx.block_locs()[logical_sink_router_block_id].loc);
+
+    return {source_router_id, sink_router_id};
+}
 
+static std::vector<NocLinkId> find_candidate_links(NocTrafficFlowId traffic_flow_id) {
+    const auto& noc_model = g_vpr_ctx.noc().noc_model;
+    const size_t num_routers = noc_model.get_noc_routers().size();
+
+    auto [source_router_id, sink_router_id] = get_traffic_flow_routers(traffic_flow_id);
+
+    // marks the routers reachable from start_router_id, following the links forward or backward
+    auto mark_reachable_routers = [&](NocRouterId start_router_id, bool forward) {
+        vtr::vector<NocRouterId, bool> reachable(num_routers, false);
+        std::vector<NocRouterId> stack{start_router_id};
+        reachable[start_router_id] = true;
+        while (!stack.empty()) {
+            NocRouterId router_id = stack.back();
+            stack.pop_back();
+            const auto& links = forward ? noc_model.get_noc_router_outgoing_links(router_id)
+                                        : noc_model.get_noc_router_incoming_links(router_id);
+            for (NocLinkId link_id : links) {
+                const NocLink& link = noc_model.get_single_noc_link(link_id);
+                NocRouterId next_router_id = forward ? link.get_sink_router() : link.get_source_router();
+                if (!reachable[next_router_id]) {
+                    reachable[next_router_id] = true;
+                    stack.push_back(next_router_id);
+                }
+            }
+        }
+        return reachable;
+    };
+
+    const auto reachable_from_source = mark_reachable_routers(source_router_id, true);
+    const auto reaches_sink = mark_reachable_routers(sink_router_id, false);
+
+    std::vector<NocLinkId> candidate_links;
+    for (const auto& noc_link : noc_model.get_noc_links()) {
+        if (reachable_from_source[noc_link.get_source_router()] && reaches_sink[noc_link.get_sink_router()]) {
+            candidate_links.push_back(noc_link.get_link_id());
+        }
+    }
+
+    return candidate_links;
+}
+
+static std::vector<t_flow_group> find_independent_flow_groups(const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& candidate_links) {
+    const auto& noc_ctx = g_vpr_ctx.noc();
+    const auto& traffic_flow_storage = noc_ctx.noc_traffic_flows_storage;
+    const size_t num_traffic_flows = traffic_flow_storage.get_number_of_traffic_flows();
+
+    // union-find over traffic flows, two traffic flows are in the same group if they share a candidate link
+    std::vector<size_t> parent(num_traffic_flows);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find_root = [&parent](size_t flow_index) {
+        while (parent[flow_index] != flow_index) {
+            parent[flow_index] = parent[parent[flow_index]];
+            flow_index = parent[flow_index];
+        }
+        return flow_index;
+    };
+
+    // the first traffic flow that may traverse each link
+    vtr::vector<NocLinkId, NocTrafficFlowId> link_first_flow(noc_ctx.noc_model.get_noc_links().size(), NocTrafficFlowId::INVALID());
+    for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
+        for (NocLinkId link_id : candidate_links[traffic_flow_id]) {
+            if (!link_first_flow[link_id]) {
+                link_first_flow[link_id] = traffic_flow_id;
+            } else {
+                parent[find_root((size_t)traffic_flow_id)] = find_root((size_t)link_first_flow[link_id]);
+            }
+        }
+    }
+
+    std::vector<t_flow_group> flow_groups;
+    std::vector<int> root_to_group(num_traffic_flows, -1);
+    for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
+        size_t root = find_root((size_t)traffic_flow_id);
+        if (root_to_group[root] == -1) {
+            root_to_group[root] = (int)flow_groups.size();
+            flow_groups.emplace_back();
+        }
+        flow_groups[root_to_group[root]].traffic_flow_ids.push_back(traffic_flow_id);
+    }
+
+    for (auto link_id : noc_ctx.noc_model.get_noc_links().keys()) {
+        if (link_first_flow[link_id]) {
+            size_t root = find_root((size_t)link_first_flow[link_id]);
+            flow_groups[root_to_group[root]].noc_link_ids.push_back(link_id);
+        }
+    }
+
+    return flow_groups;
+}
+
+static bool solve_flow_group(const t_flow_group& flow_group,
+                             const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& candidate_links,
+                             bool minimize_aggregate_bandwidth,
+                             const t_noc_opts& noc_opts,
+                             int seed,
+                             double time_limit,
+                             const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& warm_start_routes,
+                             vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& routes) {
     // Used to add variables and constraints to a CP-SAT model
     orsat::CpModelBuilder cp_model;
 
@@ -620,9 +811,9 @@ vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimiz
      * it means that t is routed through l.*/
     t_flow_link_var_map flow_link_vars;
 
-    /* A boolean variable is associated with each NoC link to indicate
+    /* A boolean variable is associated with each candidate NoC link to indicate
      * whether it is congested.*/
-    vtr::vector<NocLinkId, orsat::BoolVar> link_congested_vars;
+    std::vector<orsat::BoolVar> link_congested_vars;
 
     /* Each traffic flow latency constraint is translated to how many NoC links
      * the traffic flow can traverse without violating the constraint.
@@ -631,21 +822,23 @@ vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimiz
      */
     std::map<NocTrafficFlowId, orsat::IntVar> latency_overrun_vars;
 
-    create_flow_link_vars(cp_model, flow_link_vars, latency_overrun_vars);
+    create_flow_link_vars(cp_model, flow_link_vars, latency_overrun_vars, flow_group.traffic_flow_ids, candidate_links);
 
     constrain_latency_overrun_vars(cp_model, flow_link_vars, latency_overrun_vars);
 
-    forbid_illegal_turns(flow_link_vars, cp_model);
+    forbid_illegal_turns(flow_link_vars, cp_model, flow_group.traffic_flow_ids);
 
-    create_congested_link_vars(link_congested_vars, flow_link_vars, cp_model, noc_opts.noc_sat_routing_bandwidth_resolution);
+    create_congested_link_vars(link_congested_vars, flow_link_vars, cp_model, noc_opts.noc_sat_routing_bandwidth_resolution, flow_group);
 
-    add_continuity_constraints(flow_link_vars, cp_model);
+    add_continuity_constraints(flow_link_vars, cp_model, flow_group.traffic_flow_ids);
 
     auto objective = create_objective(cp_model, flow_link_vars, latency_overrun_vars, link_congested_vars,
                                       noc_opts.noc_sat_routing_bandwidth_resolution,
                                       noc_opts.noc_sat_routing_latency_overrun_weighting,
                                       noc_opts.noc_sat_routing_congestion_weighting,
-                                      minimize_aggregate_bandwidth);
+                                      minimize_aggregate_bandwidth,
+                                      flow_group.traffic_flow_ids,
+                                      warm_start_routes);
 
     cp_model.Minimize(objective);
 
@@ -653,6 +846,9 @@ vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimiz
     if (noc_opts.noc_sat_routing_num_workers > 0) {
         sat_params.set_num_workers(noc_opts.noc_sat_routing_num_workers);
     }
+    if (time_limit > 0.) {
+        sat_params.set_max_time_in_seconds(time_limit);
+    }
     sat_params.set_random_seed(seed);
     sat_params.set_log_search_progress(noc_opts.noc_sat_routing_log_search_progress);
 
@@ -662,12 +858,54 @@ vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimiz
     orsat::CpSolverResponse response = orsat::SolveCpModel(cp_model.Build(), &model);
 
     if (response.status() == orsat::CpSolverStatus::FEASIBLE || response.status() == orsat::CpSolverStatus::OPTIMAL) {
-        auto routes = convert_vars_to_routes(flow_link_vars, response);
-        return routes;
+        convert_vars_to_routes(flow_link_vars, response, routes);
+        return true;
+    }
+
+    return false;
+}
+
+vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimize_aggregate_bandwidth,
+                                                                    const t_noc_opts& noc_opts,
+                                                                    int seed,
+                                                                    const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& warm_start_routes) {
+    vtr::ScopedStartFinishTimer timer("NoC SAT Routing");
+
+    const auto& traffic_flow_storage = g_vpr_ctx.noc().noc_traffic_flows_storage;
+
+    // find the links that each traffic flow may traverse
+    vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> candidate_links(traffic_flow_storage.get_number_of_traffic_flows());
+    for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
+        candidate_links[traffic_flow_id] = find_candidate_links(traffic_flow_id);
+    }
+
+    /* Traffic flows that cannot share any link do not interact through
+     * congestion, so each group of them is solved as a separate model.*/
+    std::vector<t_flow_group> flow_groups = find_independent_flow_groups(candidate_links);
+    if (flow_groups.size() > 1) {
+        VTR_LOG("NoC SAT routing: %zu independent traffic flow groups\n", flow_groups.size());
+    }
+
+    vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> routes(traffic_flow_storage.get_number_of_traffic_flows());
+
+    for (size_t group_index = 0; group_index < flow_groups.size(); group_index++) {
+        // split what is left of the time budget evenly between the remaining groups
+        double group_time_limit = 0.;
+        if (noc_opts.noc_sat_routing_time_limit > 0.) {
+            double remaining_time = std::max(noc_opts.noc_sat_routing_time_limit - timer.elapsed_sec(), 0.);
+            group_time_limit = std::max(remaining_time / (flow_groups.size() - group_index), MIN_GROUP_TIME_LIMIT);
+        }
+
+        bool found = solve_flow_group(flow_groups[group_index], candidate_links, minimize_aggregate_bandwidth,
+                                      noc_opts, seed, group_time_limit, warm_start_routes, routes);
+
+        // when no feasible solution was found, return an empty vector
+        if (!found) {
+            return {};
+        }
     }
 
-    // when no feasible solution was found, return an empty vector
-    return {};
+    return routes;
 }
 
 #endif //ENABLE_NOC_SAT_ROUTING
@@ -32,16 +32,25 @@
  * routing with the minimum aggregate bandwidth while meeting
  * traffic flow latency constraints.
  *
+ * Groups of traffic flows that cannot share any NoC link are solved as
+ * separate (smaller) models, one after another, each using up to
+ * noc_opts.noc_sat_routing_num_workers workers. The whole call is bounded by
+ * noc_opts.noc_sat_routing_time_limit, if set.
+ *
  * @param minimize_aggregate_bandwidth Indicates whether the SAT solver
  * should minimize the aggregate bandwidth or not. A congestion-free
  * and deadlock-free solution can be found faster if the solver does not
  * need to minimize the aggregate bandwidth.
  * @param seed An integer seed to initialize the SAT solver.
+ * @param warm_start_routes The current routes of the traffic flows. They are
+ * given to the solver as a starting solution, which makes re-routing an already
+ * routed NoC much faster. Empty to solve from scratch.
  * @return The generated routes for all traffic flows.
  */
 vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimize_aggregate_bandwidth,
                                                                     const t_noc_opts& noc_opts,
-                                                                    int seed);
+                                                                    int seed,
+                                                                    const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& warm_start_routes = {});
 
 namespace std {
 
@@ -89,6 +89,13 @@ class TurnModelRouting : public NocRouting {
                     std::vector<NocLinkId>& flow_route,
                     const NocStorage& noc_model) override;
 
+    /**
+     * @brief Turn model routing algorithms select between legal directions
+     * using a hash of the traffic flow, so flows between the same pair of
+     * routers may take different routes.
+     */
+    bool route_depends_on_traffic_flow() const override { return true; }
+
     /**
      * @brief Turn model algorithms forbid specific turns in the mesh topology
      * to guarantee deadlock-freedom. This function finds all illegal turns
@@ -89,6 +89,9 @@ class XYRouting : public TurnModelRouting {
   public:
     ~XYRouting() override;
 
+    /// @brief There is only one legal direction at each step of XY routing.
+    bool route_depends_on_traffic_flow() const override { return false; }
+
   private:
     const std::vector<TurnModelRouting::Direction>& get_legal_directions(NocRouterId src_router_id,
                                                                          NocRouterId curr_router_id,
@@ -9,7 +9,7 @@
 
 #include "atom_pb_bimap.h"
 
-AtomPBBimap::AtomPBBimap(const vtr::bimap<AtomBlockId, const t_pb*, vtr::linear_map, std::unordered_map>& atom_to_pb) {
+AtomPBBimap::AtomPBBimap(const vtr::bimap<AtomBlockId, const t_pb*, vtr::linear_map, vtr::flat_hash_map>& atom_to_pb) {
     atom_to_pb_ = atom_to_pb;
 }
 
@@ -10,6 +10,7 @@
  */
 
 #include "vpr_types.h"
+#include "vtr_flat_hash_map.h"
 
 // Forward declaration
 class t_pb_graph_node;
@@ -24,7 +25,7 @@ class t_pb_graph_node;
 class AtomPBBimap {
   public:
     AtomPBBimap() = default;
-    AtomPBBimap(const vtr::bimap<AtomBlockId, const t_pb*, vtr::linear_map, std::unordered_map>& atom_to_pb);
+    AtomPBBimap(const vtr::bimap<AtomBlockId, const t_pb*, vtr::linear_map, vtr::flat_hash_map>& atom_to_pb);
 
     /**
      * @brief Returns the leaf pb associated with the atom blk_id
@@ -53,5 +54,5 @@ class AtomPBBimap {
 
   private:
     /// @brief Two way map between AtomBlockIds and t_pb
-    vtr::bimap<AtomBlockId, const t_pb*, vtr::linear_map, std::unordered_map> atom_to_pb_;
+    vtr::bimap<AtomBlockId, const t_pb*, vtr::linear_map, vtr::flat_hash_map> atom_to_pb_;
 };
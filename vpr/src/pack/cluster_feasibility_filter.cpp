@@ -33,7 +33,6 @@
 #include "vtr_log.h"
 #include "vpr_types.h"
 
-#include "hash.h"
 #include "cluster_feasibility_filter.h"
 
 /* header functions that identify pin classes */
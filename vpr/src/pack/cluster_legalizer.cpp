@@ -12,6 +12,7 @@
 
 #include "cluster_legalizer.h"
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -38,6 +39,10 @@
 #include "vtr_vector.h"
 #include "vtr_vector_map.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 /*
  * @brief Allocates the stats stored within the pb of a cluster.
  *
@@ -965,7 +970,8 @@ void ClusterLegalizer::reset_molecule_info(PackMoleculeId mol_id) {
 static void revert_place_atom_block(const AtomBlockId blk_id,
                                     t_lb_router_data* router_data,
                                     vtr::vector_map<AtomBlockId, LegalizationClusterId>& atom_cluster,
-                                    AtomPBBimap& atom_to_pb) {
+                                    AtomPBBimap& atom_to_pb,
+                                    bool clear_atom_clb) {
     //We cast away const here since we may free the pb, and it is
     //being removed from the active mapping.
     //
@@ -979,7 +985,7 @@ static void revert_place_atom_block(const AtomBlockId blk_id,
          */
 
         t_pb* next = pb->parent_pb;
-        free_pb(pb, atom_to_pb);
+        free_pb(pb, atom_to_pb, clear_atom_clb);
         pb = next;
 
         while (pb != nullptr) {
@@ -995,7 +1001,7 @@ static void revert_place_atom_block(const AtomBlockId blk_id,
                     /* If the code gets here, then that means that placing the initial seed molecule
                      * failed, don't free the actual complex block itself as the seed needs to find
                      * another placement */
-                    free_pb(pb, atom_to_pb);
+                    free_pb(pb, atom_to_pb, clear_atom_clb);
                 }
             }
             pb = next;
@@ -1115,7 +1121,8 @@ static bool cleanup_pb(t_pb* pb) {
 e_block_pack_status ClusterLegalizer::try_pack_molecule(PackMoleculeId molecule_id,
                                                         LegalizationCluster& cluster,
                                                         LegalizationClusterId cluster_id,
-                                                        const t_ext_pin_util& max_external_pin_util) {
+                                                        const t_ext_pin_util& max_external_pin_util,
+                                                        bool dry_run) {
     // Try to pack the molecule into a cluster with this pb type.
 
     // Safety debugs.
@@ -1195,7 +1202,7 @@ e_block_pack_status ClusterLegalizer::try_pack_molecule(PackMoleculeId molecule_
 
         bool block_pack_noc_grp_status = check_cluster_noc_group(atom_blk_id,
                                                                  new_cluster_noc_grp_id,
-                                                                 atom_noc_grp_id_,
+                                                                 noc_router_distance_index_->atom_noc_groups(),
                                                                  log_verbosity_);
         if (!block_pack_noc_grp_status) {
             return e_block_pack_status::BLK_FAILED_NOC_GROUP;
@@ -1204,6 +1211,7 @@ e_block_pack_status ClusterLegalizer::try_pack_molecule(PackMoleculeId molecule_
 
     std::vector<t_pb_graph_node*> primitives_list(max_molecule_size_, nullptr);
     e_block_pack_status block_pack_status = e_block_pack_status::BLK_STATUS_UNDEFINED;
+    bool is_dry_run_pass = false;
     while (block_pack_status != e_block_pack_status::BLK_PASSED) {
         if (!get_next_primitive_list(cluster.placement_stats,
                                      molecule_id,
@@ -1241,6 +1249,7 @@ e_block_pack_status ClusterLegalizer::try_pack_molecule(PackMoleculeId molecule_
 
         if (enable_pin_feasibility_filter_ && block_pack_status == e_block_pack_status::BLK_PASSED) {
             // Check if pin usage is feasible for the current packing assignment
+            PackPhaseTimer filter_timer(pack_profiler_, e_pack_phase::FEASIBILITY_FILTER, cluster.type);
             reset_lookahead_pins_used(cluster.pb);
             try_update_lookahead_pins_used(cluster.pb, atom_cluster_, atom_pb_lookup());
             if (!check_lookahead_pins_used(cluster.pb, max_external_pin_util)) {
@@ -1285,6 +1294,7 @@ e_block_pack_status ClusterLegalizer::try_pack_molecule(PackMoleculeId molecule_
             bool is_routed = false;
             bool do_detailed_routing_stage = (cluster_legalization_strategy_ == ClusterLegalizationStrategy::FULL);
             if (do_detailed_routing_stage) {
+                PackPhaseTimer route_timer(pack_profiler_, e_pack_phase::INTRA_LB_ROUTING, cluster.type);
                 do {
                     reset_intra_lb_route(cluster.router_data);
                     is_routed = try_intra_lb_route(cluster.router_data, log_verbosity_, &mode_status);
@@ -1295,6 +1305,9 @@ e_block_pack_status ClusterLegalizer::try_pack_molecule(PackMoleculeId molecule_
                 /* Cannot pack */
                 VTR_LOGV(log_verbosity_ > 4, "\t\t\tFAILED Detailed Routing Legality\n");
                 block_pack_status = e_block_pack_status::BLK_FAILED_ROUTE;
+            } else if (dry_run) {
+                /* Pack would succeed, undo it below as if it had failed */
+                is_dry_run_pass = true;
             } else {
                 /* Pack successful, commit
                  * TODO: SW Engineering note - may want to update cluster stats here too instead of doing it outside
@@ -1363,8 +1376,8 @@ e_block_pack_status ClusterLegalizer::try_pack_molecule(PackMoleculeId molecule_
             }
         }
 
-        if (block_pack_status != e_block_pack_status::BLK_PASSED) {
-            /* Pack unsuccessful, undo inserting molecule into cluster */
+        if (block_pack_status != e_block_pack_status::BLK_PASSED || is_dry_run_pass) {
+            /* Pack unsuccessful (or only tried), undo inserting molecule into cluster */
             for (size_t i = 0; i < failed_location; i++) {
                 AtomBlockId atom_blk_id = molecule.atom_block_ids[i];
                 if (atom_blk_id) {
@@ -1374,7 +1387,7 @@ e_block_pack_status ClusterLegalizer::try_pack_molecule(PackMoleculeId molecule_
             for (size_t i = 0; i < failed_location; i++) {
                 AtomBlockId atom_blk_id = molecule.atom_block_ids[i];
                 if (atom_blk_id) {
-                    revert_place_atom_block(atom_blk_id, cluster.router_data, atom_cluster_, mutable_atom_pb_lookup());
+                    revert_place_atom_block(atom_blk_id, cluster.router_data, atom_cluster_, mutable_atom_pb_lookup(), clears_global_atom_clb_);
                 }
             }
             reset_molecule_info(molecule_id);
@@ -1419,7 +1432,8 @@ ClusterLegalizer::start_new_cluster(PackMoleculeId molecule_id,
 
     // Allocate and load the LB router data
     t_lb_router_data* router_data = alloc_and_load_router_data(&lb_type_rr_graphs_[cluster_type->index],
-                                                               cluster_type);
+                                                               cluster_type,
+                                                               &intra_lb_route_cache_);
 
     // Allocate and load the cluster's placement stats
     t_intra_cluster_placement_stats* cluster_placement_stats = alloc_and_load_cluster_placement_stats(cluster_type, cluster_mode);
@@ -1441,7 +1455,9 @@ ClusterLegalizer::start_new_cluster(PackMoleculeId molecule_id,
     e_block_pack_status pack_status = try_pack_molecule(molecule_id,
                                                         new_cluster,
                                                         new_cluster_id,
-                                                        FULL_EXTERNAL_PIN_UTIL);
+                                                        FULL_EXTERNAL_PIN_UTIL,
+                                                        false);
+    pack_profiler_.add_pack_attempt(cluster_type, pack_status);
 
     if (pack_status == e_block_pack_status::BLK_PASSED) {
         // Give the new cluster pb a name. The current convention is to name the
@@ -1459,7 +1475,7 @@ ClusterLegalizer::start_new_cluster(PackMoleculeId molecule_id,
         molecule_cluster_[molecule_id] = new_cluster_id;
     } else {
         // Delete the new_cluster.
-        free_pb(new_cluster.pb, mutable_atom_pb_lookup());
+        free_pb(new_cluster.pb, mutable_atom_pb_lookup(), clears_global_atom_clb_);
         delete new_cluster.pb;
         free_router_data(new_cluster.router_data);
         free_cluster_placement_stats(new_cluster.placement_stats);
@@ -1489,7 +1505,9 @@ e_block_pack_status ClusterLegalizer::add_mol_to_cluster(PackMoleculeId molecule
     e_block_pack_status pack_status = try_pack_molecule(molecule_id,
                                                         cluster,
                                                         cluster_id,
-                                                        target_ext_pin_util);
+                                                        target_ext_pin_util,
+                                                        false);
+    pack_profiler_.add_pack_attempt(cluster.type, pack_status);
 
     // If the packing was successful, set the molecules' cluster to this one.
     if (pack_status == e_block_pack_status::BLK_PASSED)
@@ -1498,6 +1516,122 @@ e_block_pack_status ClusterLegalizer::add_mol_to_cluster(PackMoleculeId molecule
     return pack_status;
 }
 
+std::vector<e_block_pack_status>
+ClusterLegalizer::add_first_legal_mol_to_cluster(const std::vector<PackMoleculeId>& molecule_ids,
+                                                 LegalizationClusterId cluster_id) {
+    std::vector<e_block_pack_status> pack_statuses(molecule_ids.size(), e_block_pack_status::BLK_STATUS_UNDEFINED);
+
+#ifdef VPR_USE_TBB
+    if (cluster_legalization_strategy_ == ClusterLegalizationStrategy::FULL && !speculative_replicas_.empty()) {
+        LegalizationCluster& cluster = legalization_clusters_[cluster_id];
+        t_ext_pin_util target_ext_pin_util = target_external_pin_util_.get_pin_util(cluster.type->name);
+
+        // Try the candidates in rounds of one candidate per replica, until a
+        // round finds one which passed.
+        size_t num_replicas = speculative_replicas_.size();
+        for (size_t first = 0; first < molecule_ids.size(); first += num_replicas) {
+            size_t num_tries = std::min(num_replicas, molecule_ids.size() - first);
+            std::vector<e_block_pack_status> speculative_statuses(num_tries, e_block_pack_status::BLK_STATUS_UNDEFINED);
+            tbb::parallel_for(size_t(0), num_tries, [&](size_t itry) {
+                if (!sync_speculative_replica(itry, cluster_id))
+                    return;
+                SpeculativeReplica& replica = speculative_replicas_[itry];
+                ClusterLegalizer& replica_legalizer = *replica.legalizer;
+                speculative_statuses[itry] = replica_legalizer.try_pack_molecule(molecule_ids[first + itry],
+                                                                                 replica_legalizer.legalization_clusters_[replica.replica_cluster_id],
+                                                                                 replica.replica_cluster_id,
+                                                                                 target_ext_pin_util,
+                                                                                 true);
+            });
+
+            // Add the candidates which passed on their replica (or whose
+            // replica could not reproduce the cluster) in order, until one
+            // passes for real. The others keep the status of their replica.
+            for (size_t itry = 0; itry < num_tries; itry++) {
+                size_t imol = first + itry;
+                if (speculative_statuses[itry] == e_block_pack_status::BLK_PASSED
+                    || speculative_statuses[itry] == e_block_pack_status::BLK_STATUS_UNDEFINED) {
+                    pack_statuses[imol] = add_mol_to_cluster(molecule_ids[imol], cluster_id);
+                    if (pack_statuses[imol] == e_block_pack_status::BLK_PASSED)
+                        return pack_statuses;
+                } else {
+                    pack_statuses[imol] = speculative_statuses[itry];
+                    pack_profiler_.add_pack_attempt(cluster.type, pack_statuses[imol]);
+                }
+            }
+        }
+        return pack_statuses;
+    }
+#endif
+
+    for (size_t imol = 0; imol < molecule_ids.size(); imol++) {
+        pack_statuses[imol] = add_mol_to_cluster(molecule_ids[imol], cluster_id);
+        if (pack_statuses[imol] == e_block_pack_status::BLK_PASSED)
+            break;
+    }
+    return pack_statuses;
+}
+
+void ClusterLegalizer::set_speculative_replicas(std::vector<std::unique_ptr<ClusterLegalizer>>&& replicas) {
+    speculative_replicas_.clear();
+    speculative_replicas_.resize(replicas.size());
+    for (size_t ireplica = 0; ireplica < replicas.size(); ireplica++) {
+        ClusterLegalizer& replica_legalizer = *replicas[ireplica];
+        VTR_ASSERT(replica_legalizer.cluster_legalization_strategy_ == ClusterLegalizationStrategy::FULL);
+        VTR_ASSERT(replica_legalizer.clusters().empty());
+        // The replicas free their pbs concurrently: keep them off the atom context
+        replica_legalizer.clears_global_atom_clb_ = false;
+        for (const t_logical_block_type& block_type : g_vpr_ctx.device().logical_block_types) {
+            replica_legalizer.get_target_external_pin_util().set_block_pin_util(block_type.name,
+                                                                                target_external_pin_util_.get_pin_util(block_type.name));
+        }
+        speculative_replicas_[ireplica].legalizer = std::move(replicas[ireplica]);
+    }
+}
+
+bool ClusterLegalizer::sync_speculative_replica(size_t ireplica, LegalizationClusterId cluster_id) {
+    SpeculativeReplica& replica = speculative_replicas_[ireplica];
+    ClusterLegalizer& replica_legalizer = *replica.legalizer;
+    const LegalizationCluster& cluster = legalization_clusters_[cluster_id];
+
+    // The replica is still a prefix of the cluster if it replicates the same
+    // cluster and its molecules are the first ones of the cluster (cluster IDs
+    // may be reused after compressing, hence the check of the molecules).
+    bool is_prefix = (replica.cluster_id == cluster_id);
+    if (is_prefix) {
+        const LegalizationCluster& replica_cluster = replica_legalizer.legalization_clusters_[replica.replica_cluster_id];
+        is_prefix = replica_cluster.type == cluster.type
+                    && replica_cluster.molecules.size() <= cluster.molecules.size()
+                    && std::equal(replica_cluster.molecules.begin(), replica_cluster.molecules.end(), cluster.molecules.begin());
+    }
+
+    if (!is_prefix) {
+        replica_legalizer.reset();
+        replica.cluster_id = cluster_id;
+        replica.is_diverged = false;
+        e_block_pack_status pack_status;
+        std::tie(pack_status, replica.replica_cluster_id) = replica_legalizer.start_new_cluster(cluster.molecules.front(),
+                                                                                               cluster.type,
+                                                                                               cluster.pb->mode);
+        if (pack_status != e_block_pack_status::BLK_PASSED) {
+            replica.is_diverged = true;
+            return false;
+        }
+    } else if (replica.is_diverged) {
+        return false;
+    }
+
+    // Replay the molecules added to the cluster since.
+    const LegalizationCluster& replica_cluster = replica_legalizer.legalization_clusters_[replica.replica_cluster_id];
+    for (size_t imol = replica_cluster.molecules.size(); imol < cluster.molecules.size(); imol++) {
+        if (replica_legalizer.add_mol_to_cluster(cluster.molecules[imol], replica.replica_cluster_id) != e_block_pack_status::BLK_PASSED) {
+            replica.is_diverged = true;
+            return false;
+        }
+    }
+    return true;
+}
+
 void ClusterLegalizer::destroy_cluster(LegalizationClusterId cluster_id) {
     // Safety asserts to make sure the inputs are valid.
     VTR_ASSERT_SAFE(cluster_id.is_valid() && (size_t)cluster_id < legalization_clusters_.size());
@@ -1512,7 +1646,7 @@ void ClusterLegalizer::destroy_cluster(LegalizationClusterId cluster_id) {
         const t_pack_molecule& mol = prepacker_.get_molecule(mol_id);
         for (AtomBlockId atom_blk_id : mol.atom_block_ids) {
             if (atom_blk_id) {
-                revert_place_atom_block(atom_blk_id, cluster.router_data, atom_cluster_, mutable_atom_pb_lookup());
+                revert_place_atom_block(atom_blk_id, cluster.router_data, atom_cluster_, mutable_atom_pb_lookup(), clears_global_atom_clb_);
             }
         }
         reset_molecule_info(mol_id);
@@ -1521,7 +1655,7 @@ void ClusterLegalizer::destroy_cluster(LegalizationClusterId cluster_id) {
     cluster.molecules.clear();
     // Free the rest of the cluster data.
     //  Casting things to nullptr for safety just in case someone is trying to use it.
-    free_pb(cluster.pb, mutable_atom_pb_lookup());
+    free_pb(cluster.pb, mutable_atom_pb_lookup(), clears_global_atom_clb_);
     delete cluster.pb;
     cluster.pb = nullptr;
     free_router_data(cluster.router_data);
@@ -1592,6 +1726,7 @@ bool ClusterLegalizer::check_cluster_legality(LegalizationClusterId cluster_id)
     // route on the cluster. If it succeeds, the cluster is fully legal.
     t_mode_selection_status mode_status;
     LegalizationCluster& cluster = legalization_clusters_[cluster_id];
+    PackPhaseTimer route_timer(pack_profiler_, e_pack_phase::INTRA_LB_ROUTING, cluster.type);
     return try_intra_lb_route(cluster.router_data, log_verbosity_, &mode_status);
 }
 
@@ -1603,7 +1738,8 @@ ClusterLegalizer::ClusterLegalizer(const AtomNetlist& atom_netlist,
                                    ClusterLegalizationStrategy cluster_legalization_strategy,
                                    bool enable_pin_feasibility_filter,
                                    const LogicalModels& models,
-                                   int log_verbosity)
+                                   int log_verbosity,
+                                   std::shared_ptr<const NocRouterDistanceIndex> noc_router_distance_index)
     : prepacker_(prepacker) {
     // Verify that the inputs are valid.
     VTR_ASSERT_SAFE(lb_type_rr_graphs != nullptr);
@@ -1622,12 +1758,16 @@ ClusterLegalizer::ClusterLegalizer(const AtomNetlist& atom_netlist,
     max_molecule_size_ = prepacker.get_max_molecule_size();
     // Get a reference to the rr graphs.
     lb_type_rr_graphs_ = lb_type_rr_graphs;
-    // Find all NoC router atoms.
-    std::vector<AtomBlockId> noc_atoms = find_noc_router_atoms(atom_netlist, models);
-    update_noc_reachability_partitions(noc_atoms,
-                                       atom_netlist,
-                                       high_fanout_thresholds,
-                                       atom_noc_grp_id_);
+    // Find the NoC groups of the atoms, unless another legalizer already did.
+    if (noc_router_distance_index == nullptr) {
+        std::vector<AtomBlockId> noc_atoms = find_noc_router_atoms(atom_netlist, models);
+        noc_router_distance_index = std::make_shared<const NocRouterDistanceIndex>(
+            noc_atoms,
+            atom_netlist,
+            get_noc_group_high_fanout_threshold(high_fanout_thresholds));
+    }
+    VTR_ASSERT(noc_router_distance_index->atom_noc_groups().size() == atom_netlist.blocks().size());
+    noc_router_distance_index_ = std::move(noc_router_distance_index);
     // Copy the options passed by the user
     cluster_legalization_strategy_ = cluster_legalization_strategy;
     enable_pin_feasibility_filter_ = enable_pin_feasibility_filter;
@@ -1648,6 +1788,65 @@ void ClusterLegalizer::reset() {
     compress();
 }
 
+void ClusterLegalizer::restrict_to_molecules(const std::vector<PackMoleculeId>& molecule_ids) {
+    molecule_excluded_.clear();
+    molecule_excluded_.resize(prepacker_.molecules().size(), true);
+    atom_excluded_.clear();
+    atom_excluded_.resize(atom_cluster_.size(), true);
+    for (PackMoleculeId mol_id : molecule_ids) {
+        molecule_excluded_[mol_id] = false;
+        for (AtomBlockId atom_blk_id : prepacker_.get_molecule(mol_id).atom_block_ids) {
+            if (atom_blk_id)
+                atom_excluded_[atom_blk_id] = false;
+        }
+    }
+}
+
+LegalizationClusterId ClusterLegalizer::adopt_cluster(ClusterLegalizer& other,
+                                                      LegalizationClusterId other_cluster_id) {
+    VTR_ASSERT_SAFE(other_cluster_id.is_valid() && (size_t)other_cluster_id < other.legalization_clusters_.size());
+    VTR_ASSERT(other.legalization_cluster_ids_[other_cluster_id].is_valid() && "Cannot adopt a destroyed cluster");
+    LegalizationCluster& other_cluster = other.legalization_clusters_[other_cluster_id];
+    VTR_ASSERT(other_cluster.router_data == nullptr && other_cluster.placement_stats == nullptr
+               && "Can only adopt cleaned clusters!");
+
+    LegalizationClusterId cluster_id = LegalizationClusterId(legalization_cluster_ids_.size());
+    for (PackMoleculeId mol_id : other_cluster.molecules) {
+        VTR_ASSERT(!molecule_cluster_[mol_id].is_valid());
+        molecule_cluster_[mol_id] = cluster_id;
+        other.molecule_cluster_[mol_id] = LegalizationClusterId::INVALID();
+
+        const t_pack_molecule& mol = prepacker_.get_molecule(mol_id);
+        for (AtomBlockId atom_blk_id : mol.atom_block_ids) {
+            if (!atom_blk_id)
+                continue;
+            atom_cluster_[atom_blk_id] = cluster_id;
+            other.atom_cluster_[atom_blk_id] = LegalizationClusterId::INVALID();
+            atom_pb_lookup_.set_atom_pb(atom_blk_id, other.atom_pb_lookup_.atom_pb(atom_blk_id));
+            other.atom_pb_lookup_.set_atom_pb(atom_blk_id, nullptr);
+        }
+
+        // Long chains continuing in other clusters need to know where they
+        // were started.
+        if (mol.is_chain() && other.clustering_chain_info_[mol.chain_id].first_packed_molecule == mol_id) {
+            clustering_chain_info_[mol.chain_id] = other.clustering_chain_info_[mol.chain_id];
+            other.clustering_chain_info_[mol.chain_id] = t_clustering_chain_info();
+        }
+    }
+
+    legalization_cluster_ids_.push_back(cluster_id);
+    legalization_clusters_.push_back(std::move(other_cluster));
+
+    // The pb now belongs to this legalizer.
+    other_cluster = LegalizationCluster();
+    other_cluster.pb = nullptr;
+    other_cluster.router_data = nullptr;
+    other_cluster.placement_stats = nullptr;
+    other.legalization_cluster_ids_[other_cluster_id] = LegalizationClusterId::INVALID();
+
+    return cluster_id;
+}
+
 void ClusterLegalizer::verify() {
     std::unordered_set<AtomBlockId> atoms_checked;
     auto& atom_ctx = g_vpr_ctx.atom();
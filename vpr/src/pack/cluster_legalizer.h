@@ -11,9 +11,11 @@
  * externally to the Packer in VPR.
  */
 
+#include <memory>
 #include <string>
 #include <vector>
 #include "atom_netlist_fwd.h"
+#include "noc_aware_cluster_util.h"
 #include "noc_data_types.h"
 #include "partition_region.h"
 #include "prepack.h"
@@ -23,6 +25,8 @@
 #include "vtr_vector.h"
 #include "vtr_vector_map.h"
 #include "atom_pb_bimap.h"
+#include "pack_profiler.h"
+#include "pack_types.h"
 #include "vpr_utils.h"
 
 // Forward declarations
@@ -213,11 +217,24 @@ class ClusterLegalizer {
      *  @param cluster_id               The ID of the cluster.
      *  @param max_external_pin_util    The max external pin utilization for a
      *                                  cluster of this type.
+     *  @param dry_run                  If true, the molecule is removed again
+     *                                  once all the checks passed, leaving the
+     *                                  cluster as it was.
      */
     e_block_pack_status try_pack_molecule(PackMoleculeId molecule_id,
                                           LegalizationCluster& cluster,
                                           LegalizationClusterId cluster_id,
-                                          const t_ext_pin_util& max_external_pin_util);
+                                          const t_ext_pin_util& max_external_pin_util,
+                                          bool dry_run);
+
+    /*
+     * @brief Brings the given speculative replica up to date with the given
+     *        cluster of this legalizer, by replaying the molecules the replica
+     *        does not have yet.
+     *
+     *  @return False if the replica could not reproduce the cluster.
+     */
+    bool sync_speculative_replica(size_t ireplica, LegalizationClusterId cluster_id);
 
     /**
      * @brief This function takes a chain molecule, and the pb_graph_node that is
@@ -272,6 +289,10 @@ class ClusterLegalizer {
      *  @param models
      *  @param log_verbosity
      *          Controls how verbose the log messages will be within this class.
+     *  @param noc_router_distance_index
+     *          The NoC groups of the atoms, shared with other legalizers of
+     *          the same netlist and high fanout thresholds (see
+     *          noc_router_distance_index()). Computed if null.
      */
     ClusterLegalizer(const AtomNetlist& atom_netlist,
                      const Prepacker& prepacker,
@@ -281,7 +302,8 @@ class ClusterLegalizer {
                      ClusterLegalizationStrategy cluster_legalization_strategy,
                      bool enable_pin_feasibility_filter,
                      const LogicalModels& models,
-                     int log_verbosity);
+                     int log_verbosity,
+                     std::shared_ptr<const NocRouterDistanceIndex> noc_router_distance_index = nullptr);
 
     // This class allocates and deallocates memory within. This class should not
     // be copied or moved to prevent it from double freeing / losing pointers.
@@ -323,6 +345,41 @@ class ClusterLegalizer {
     e_block_pack_status add_mol_to_cluster(PackMoleculeId molecule_id,
                                            LegalizationClusterId cluster_id);
 
+    /*
+     * @brief Add the first of the given unclustered molecules (in order of
+     *        preference) which can legally be added to the given cluster.
+     *
+     * With speculative replicas (see set_speculative_replicas) and the FULL
+     * legalization strategy, the molecules are first tried in parallel, each on
+     * a replica of the cluster, and only the first which passed there is then
+     * added to the cluster (if that fails, the next one which passed is
+     * added, and so on). The replicas only screen the candidates: a molecule is
+     * only ever added by the same checks as add_mol_to_cluster. Otherwise, the
+     * molecules are simply added in turn until one passes.
+     *
+     *  @param molecule_ids     The candidate molecules, in order of preference.
+     *  @param cluster_id       The ID of the cluster to add a molecule to.
+     *
+     *  @return     The status of each candidate: BLK_PASSED for the molecule
+     *              added (if any), the reason of the failure for the molecules
+     *              before it, and BLK_STATUS_UNDEFINED for those after it.
+     */
+    std::vector<e_block_pack_status> add_first_legal_mol_to_cluster(const std::vector<PackMoleculeId>& molecule_ids,
+                                                                    LegalizationClusterId cluster_id);
+
+    /*
+     * @brief Gives this legalizer replicas to try candidate molecules on
+     *        speculatively (see add_first_legal_mol_to_cluster).
+     *
+     * The replicas must be empty legalizers over the same netlist and
+     * prepacker, using the FULL legalization strategy. Their target external
+     * pin utilizations are set to the ones of this legalizer.
+     */
+    void set_speculative_replicas(std::vector<std::unique_ptr<ClusterLegalizer>>&& replicas);
+
+    /// @brief The number of speculative replicas of this legalizer.
+    inline size_t num_speculative_replicas() const { return speculative_replicas_.size(); }
+
     /*
      * @brief Destroy the given cluster.
      *
@@ -412,6 +469,35 @@ class ClusterLegalizer {
      */
     void reset();
 
+    /*
+     * @brief Restricts the legalizer to the given molecules.
+     *
+     * All other molecules (and their atoms) are reported as clustered, so that
+     * a clusterer using this legalizer will neither select them as seeds nor
+     * as candidates. This allows separate legalizers to cluster disjoint parts
+     * of the netlist independently (see adopt_cluster).
+     *
+     *  @param molecule_ids The molecules this legalizer may cluster.
+     */
+    void restrict_to_molecules(const std::vector<PackMoleculeId>& molecule_ids);
+
+    /*
+     * @brief Moves a cleaned cluster from another legalizer into this one.
+     *
+     * The other legalizer must be over the same netlist and prepacker, and the
+     * molecules of the cluster must not be clustered in this legalizer. The
+     * cluster is destroyed in the other legalizer (without reverting the
+     * placement of its atoms, which now belong to this legalizer); the other
+     * legalizer must be compressed before being used to cluster again.
+     *
+     *  @param other            The legalizer the cluster was created in.
+     *  @param other_cluster_id The ID of the cluster in the other legalizer.
+     *
+     *  @return The ID of the cluster in this legalizer.
+     */
+    LegalizationClusterId adopt_cluster(ClusterLegalizer& other,
+                                        LegalizationClusterId other_cluster_id);
+
     /*
      * @brief Checks if the given molecule is compatible with the given cluster.
      *
@@ -483,7 +569,10 @@ class ClusterLegalizer {
     ///        cluster, false otherwise.
     inline bool is_atom_clustered(AtomBlockId blk_id) const {
         // Simply, if the atom is not in an invalid cluster, it has been clustered.
-        return get_atom_cluster(blk_id) != LegalizationClusterId::INVALID();
+        // Atoms outside of the molecules this legalizer is restricted to are
+        // clustered elsewhere.
+        return get_atom_cluster(blk_id) != LegalizationClusterId::INVALID()
+               || (!atom_excluded_.empty() && atom_excluded_[blk_id]);
     }
 
     /// @brief Returns true if the given molecule has been packed into a
@@ -492,7 +581,8 @@ class ClusterLegalizer {
         VTR_ASSERT_SAFE(mol_id.is_valid());
         // Check if the molecule has been assigned a cluster. It has not been
         // assigned a cluster if it is assigned to a valid cluster.
-        return molecule_cluster_[mol_id].is_valid();
+        return molecule_cluster_[mol_id].is_valid()
+               || (!molecule_excluded_.empty() && molecule_excluded_[mol_id]);
     }
 
     /// @brief Returns a reference to the target_external_pin_util object. This
@@ -536,6 +626,25 @@ class ClusterLegalizer {
 
     inline const IntraLbPbPinLookup& intra_lb_pb_pin_lookup() const { return intra_lb_pb_pin_lookup_; }
 
+    /// @brief The routing resource graphs internal to the cluster types used
+    ///        by this legalizer.
+    inline std::vector<t_lb_type_rr_node>* lb_type_rr_graphs() const { return lb_type_rr_graphs_; }
+
+    /// @brief Get the NoC groups of the atoms, to be shared with the other
+    ///        legalizers created for the same netlist.
+    inline const std::shared_ptr<const NocRouterDistanceIndex>& noc_router_distance_index() const {
+        return noc_router_distance_index_;
+    }
+
+    /// @brief The cache of intra-lb routing outcomes shared by the clusters
+    ///        of this legalizer.
+    inline const IntraLbRouteCache& intra_lb_route_cache() const { return intra_lb_route_cache_; }
+    inline IntraLbRouteCache& mutable_intra_lb_route_cache() { return intra_lb_route_cache_; }
+
+    /// @brief The profiler of the clustering done with this legalizer.
+    inline const PackProfiler& pack_profiler() const { return pack_profiler_; }
+    inline PackProfiler& mutable_pack_profiler() { return pack_profiler_; }
+
     /// @brief Destructor of the class. Frees allocated data.
     ~ClusterLegalizer();
 
@@ -556,13 +665,19 @@ class ClusterLegalizer {
     /// @brief A lookup-table for which cluster the given atom is packed into.
     vtr::vector_map<AtomBlockId, LegalizationClusterId> atom_cluster_;
 
+    /// @brief The molecules (and their atoms) outside of the molecules this
+    ///        legalizer is restricted to. Empty if it is not restricted (see
+    ///        restrict_to_molecules).
+    vtr::vector_map<PackMoleculeId, bool> molecule_excluded_;
+    vtr::vector<AtomBlockId, bool> atom_excluded_;
+
     /// @brief Stores the NoC group ID of each atom block. Atom blocks that
     ///        belong to different NoC groups can't be clustered with each other
     ///        into the same clustered block. Under some optimization settings
     ///        to improve placement locality / NoC usage. Atoms with different
     ///        NoC group IDs belong to logic that is disjoint except through
     ///        NoC traffic.
-    vtr::vector<AtomBlockId, NocGroupId> atom_noc_grp_id_;
+    std::shared_ptr<const NocRouterDistanceIndex> noc_router_distance_index_;
 
     /// @brief The maximum fractional utilization of cluster external
     ///        input/output pins during packing (between 0 and 1).
@@ -610,4 +725,34 @@ class ClusterLegalizer {
 
     /// @brief A lookup table for the pin mapping of the intra-lb pb pins.
     IntraLbPbPinLookup intra_lb_pb_pin_lookup_;
+
+    /// @brief The outcomes of the intra-lb routes tried so far. Kept across
+    ///        resets of the legalizer, since the packer iterations route many
+    ///        of the same clusters again.
+    IntraLbRouteCache intra_lb_route_cache_;
+
+    /// @brief Time and outcome statistics of the clustering (disabled unless
+    ///        profiling is turned on).
+    PackProfiler pack_profiler_;
+
+    /// @brief A legalizer replicating one cluster of this legalizer, to try
+    ///        candidate molecules on without touching the cluster.
+    struct SpeculativeReplica {
+        std::unique_ptr<ClusterLegalizer> legalizer;
+        /// @brief The cluster of this legalizer replicated, if any.
+        LegalizationClusterId cluster_id;
+        /// @brief The replica of the cluster in the replica legalizer.
+        LegalizationClusterId replica_cluster_id;
+        /// @brief Whether the replica failed to reproduce the cluster.
+        bool is_diverged = false;
+    };
+
+    /// @brief The speculative replicas (see add_first_legal_mol_to_cluster).
+    std::vector<SpeculativeReplica> speculative_replicas_;
+
+    /// @brief Whether freeing the pbs of this legalizer clears the atom to clb
+    ///        lookup of the atom context. Off for the speculative replicas,
+    ///        which hold copies of the clusters of another legalizer and run
+    ///        concurrently.
+    bool clears_global_atom_clb_ = true;
 };
@@ -18,7 +18,6 @@
  */
 
 #include "cluster_placement.h"
-#include "hash.h"
 #include "physical_types.h"
 #include "prepack.h"
 #include "vpr_utils.h"
@@ -84,27 +83,25 @@ void t_intra_cluster_placement_stats::move_primitive_to_inflight(int pb_type_ind
  * @note that valid status is not changed because if the primitive is not valid, it will get properly collected later
  */
 void t_intra_cluster_placement_stats::insert_primitive_in_valid_primitives(std::pair<int, t_cluster_placement_primitive*> cluster_placement_primitive) {
-    int i;
-    bool success = false;
-    int null_index = UNDEFINED;
-    t_cluster_placement_primitive* input_cluster_placement_primitive = cluster_placement_primitive.second;
-
-    for (i = 0; i < num_pb_types && !success; i++) {
-        if (valid_primitives[i].empty()) {
-            null_index = i;
-            continue;
-        }
-        t_cluster_placement_primitive* cur_cluster_placement_primitive = valid_primitives[i].begin()->second;
-        if (input_cluster_placement_primitive->pb_graph_node->pb_type
-            == cur_cluster_placement_primitive->pb_graph_node->pb_type) {
-            success = true;
-            valid_primitives[i].insert(cluster_placement_primitive);
-        }
-    }
-    if (!success) {
-        VTR_ASSERT(null_index != UNDEFINED);
-        valid_primitives[null_index].insert(cluster_placement_primitive);
+    const t_pb_type* pb_type = cluster_placement_primitive.second->pb_graph_node->pb_type;
+    auto type_index = pb_type_valid_primitives_index.find(pb_type);
+    VTR_ASSERT(type_index != pb_type_valid_primitives_index.end());
+    valid_primitives[type_index->second].insert(cluster_placement_primitive);
+}
+
+void t_intra_cluster_placement_stats::add_primitive(t_cluster_placement_primitive* placement_primitive) {
+    set_pb_graph_node_placement_primitive(placement_primitive->pb_graph_node, placement_primitive);
+
+    // The first primitive of a pb_type adds an (empty) map for the type to valid_primitives
+    auto [type_index, new_type] = pb_type_valid_primitives_index.emplace(placement_primitive->pb_graph_node->pb_type, num_pb_types);
+    if (new_type) {
+        valid_primitives.emplace_back();
+        num_pb_types++;
     }
+
+    // Each primitive has an index in its type (the key of the map) for easier lookup, insertion and deletion
+    std::unordered_map<int, t_cluster_placement_primitive*>& type_primitives = valid_primitives[type_index->second];
+    type_primitives.insert({type_primitives.size(), placement_primitive});
 }
 
 void t_intra_cluster_placement_stats::flush_queue(std::unordered_multimap<int, t_cluster_placement_primitive*>& queue) {
@@ -338,36 +335,10 @@ static void load_cluster_placement_stats_for_pb_graph_node(t_intra_cluster_place
         placement_primitive = new t_cluster_placement_primitive();
         placement_primitive->pb_graph_node = pb_graph_node;
         placement_primitive->valid = true;
-        cluster_placement_stats->set_pb_graph_node_placement_primitive(pb_graph_node, placement_primitive);
         placement_primitive->base_cost = compute_primitive_base_cost(pb_graph_node);
 
-        bool success = false;
-        /**
-         * Insert the cluster_placement_primitive in the corresponding valid_primitives location based on its pb_type
-         *
-         *  - Iterate over the elements of valid_prmitives
-         *  - There should be an element with index 0 (otherwise this element will not exist in the vector) --> find it
-         *  - Check the pb_type of this element with the pb_type of pb_graph_node
-         *      - if matched --> insert the primitive
-         */
-        for (auto& type_primitives : cluster_placement_stats->valid_primitives) {
-            auto first_elem = type_primitives.find(0);
-            if (first_elem != type_primitives.end() && first_elem->second->pb_graph_node->pb_type == pb_graph_node->pb_type) {
-                type_primitives.insert({type_primitives.size(), placement_primitive});
-                success = true;
-                break;
-            }
-        }
-
-        /**
-         * If the loop is done and we didn't find a match, push an empty map into valid_primitives for this new type
-         * and insert the placement primitive into the new map with index 0
-         */
-        if (!success) {
-            cluster_placement_stats->valid_primitives.emplace_back();
-            cluster_placement_stats->valid_primitives[cluster_placement_stats->valid_primitives.size() - 1].insert({0, placement_primitive});
-            cluster_placement_stats->num_pb_types++;
-        }
+        // Insert the cluster_placement_primitive in the valid_primitives location of its pb_type
+        cluster_placement_stats->add_primitive(placement_primitive);
 
     } else { // not a primitive, recursively call the function for all its children
         for (i = 0; i < pb_type->num_modes; i++) {
@@ -54,10 +54,20 @@ class t_intra_cluster_placement_stats {
     /**
      * @brief Add a primitive in its correct location in valid_primitives vector based on its pb_type
      *
+     * The location of each pb_type is looked up, so this is done in constant time
+     * (e.g. when rolling back the primitives tried for a molecule).
+     *
      * @param cluster_placement_primitive: a pair of the cluster_placement_primtive and its corresponding index(for reference in pb_graph_node)
      */
     void insert_primitive_in_valid_primitives(std::pair<int, t_cluster_placement_primitive*> cluster_placement_primitive);
 
+    /**
+     * @brief Add a new primitive of the cluster to the valid primitives of its pb_type
+     *        (adding the pb_type if it is the first primitive of this type), and
+     *        set it as the placement primitive of its pb_graph_node.
+     */
+    void add_primitive(t_cluster_placement_primitive* placement_primitive);
+
     /**
      * @brief Move all the primitives from (in_flight and tried) maps to valid primitives and clear (in_flight and tried)
      */
@@ -88,7 +98,12 @@ class t_intra_cluster_placement_stats {
                                                       t_cluster_placement_primitive* placement_primitive) {
         VTR_ASSERT_SAFE(pb_graph_node != nullptr);
         VTR_ASSERT_SAFE(placement_primitive != nullptr);
-        pb_graph_node_placement_primitive[pb_graph_node] = placement_primitive;
+        VTR_ASSERT(pb_graph_node->primitive_num >= 0);
+        size_t primitive_num = pb_graph_node->primitive_num;
+        if (primitive_num >= pb_graph_node_placement_primitive.size()) {
+            pb_graph_node_placement_primitive.resize(primitive_num + 1, nullptr);
+        }
+        pb_graph_node_placement_primitive[primitive_num] = placement_primitive;
     }
 
     /**
@@ -98,8 +113,9 @@ class t_intra_cluster_placement_stats {
      */
     inline t_cluster_placement_primitive* get_pb_graph_node_placement_primitive(const t_pb_graph_node* pb_graph_node) {
         VTR_ASSERT_SAFE(pb_graph_node != nullptr);
-        VTR_ASSERT(pb_graph_node_placement_primitive.count(pb_graph_node) != 0);
-        return pb_graph_node_placement_primitive[pb_graph_node];
+        VTR_ASSERT_SAFE(pb_graph_node->primitive_num >= 0 && size_t(pb_graph_node->primitive_num) < pb_graph_node_placement_primitive.size());
+        VTR_ASSERT_SAFE(pb_graph_node_placement_primitive[pb_graph_node->primitive_num] != nullptr);
+        return pb_graph_node_placement_primitive[pb_graph_node->primitive_num];
     }
 
     /**
@@ -112,11 +128,12 @@ class t_intra_cluster_placement_stats {
     std::unordered_multimap<int, t_cluster_placement_primitive*> tried;     ///<ptrs to primitives that are already tried but current logic block unable to pack to
     std::unordered_multimap<int, t_cluster_placement_primitive*> invalid;   ///<ptrs to primitives that are invalid (already occupied by another primitive in this cluster)
 
-    /// @brief A mapping between pb_graph_nodes and the cluster placement primitive.
-    ///
-    /// TODO: This could be stored more efficiently if each t_pb_graph_node had a
-    ///       unique ID per cluster.
-    std::unordered_map<const t_pb_graph_node*, t_cluster_placement_primitive*> pb_graph_node_placement_primitive;
+    /// @brief A mapping between pb_graph_nodes and the cluster placement primitive,
+    ///        indexed by the primitive number of the pb_graph_node (unique in the cluster).
+    std::vector<t_cluster_placement_primitive*> pb_graph_node_placement_primitive;
+
+    /// @brief The index in valid_primitives of the primitives of each pb_type.
+    std::unordered_map<const t_pb_type*, int> pb_type_valid_primitives_index;
 
     /**
      * @brief iterate over elements of a queue and move its elements to valid_primitives
@@ -12,8 +12,11 @@
  * Date: July 22, 2013
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <map>
 #include <queue>
@@ -34,6 +37,7 @@
 #include "lb_type_rr_graph.h"
 #include "cluster_router.h"
 #include "atom_pb_bimap.h"
+#include "d_ary_heap.tpp"
 
 /* #define PRINT_INTRA_LB_ROUTE */
 
@@ -44,34 +48,55 @@
 enum e_commit_remove { RT_COMMIT,
                        RT_REMOVE };
 
-// TODO: check if this hacky class memory reserve thing is still necessary, if not, then delete
-/* Packing uses a priority queue that requires a large number of elements.  This backdoor
- * allows me to use a priority queue where I can pre-allocate the # of elements in the underlying container
- * for efficiency reasons.  Note: Must use vector with this */
-template<class T, class U, class V>
-class reservable_pq : public std::priority_queue<T, U, V> {
-  public:
-    typedef typename std::priority_queue<T>::size_type size_type;
-    reservable_pq(size_type capacity = 0) {
-        reserve(capacity);
-        cur_cap = capacity;
-    }
-    void reserve(size_type capacity) {
-        this->c.reserve(capacity);
-        cur_cap = capacity;
-    }
-    void clear() {
-        this->c.clear();
-        this->c.reserve(cur_cap);
-    }
-
-  private:
-    size_type cur_cap;
+/* Expansion priority queue of the router: a 4-ary heap, as used by the main router, which is
+ * shallower and more cache friendly than the binary heap of std::priority_queue */
+typedef customized_d_ary_priority_queue<4, t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node> t_lb_expansion_pq;
+
+/* Scratch data of the intra-logic block router, reused by all the clusters a thread routes so that
+ * routing and creating clusters does not allocate:
+ *  - the expansion priority queue, which keeps its capacity between routes,
+ *  - the per lb rr node arrays of freed router data, pooled by lb rr graph size for the next
+ *    router data of the same size (there are only a few live router data per thread at a time),
+ *  - the freed router data themselves, with their (emptied) net and atom containers.
+ *
+ * The router data only hold this per-cluster mutable state: the lb rr graph of each block type is
+ * shared, read-only, by all the router data of the type (on all the threads). */
+struct t_lb_router_scratch {
+    t_lb_expansion_pq pq;
+
+    std::unordered_map<size_t, std::vector<std::unique_ptr<t_lb_rr_node_stats[]>>> free_lb_rr_node_stats;
+    std::unordered_map<size_t, std::vector<std::unique_ptr<t_explored_node_tb[]>>> free_explored_node_tbs;
+
+    std::vector<t_lb_router_data*> free_router_data;
+
+    ~t_lb_router_scratch() {
+        for (t_lb_router_data* router_data : free_router_data) {
+            delete router_data->intra_lb_nets;
+            delete router_data->atoms_added;
+            delete router_data;
+        }
+    }
 };
 
+static thread_local t_lb_router_scratch lb_router_scratch;
+
+/* Takes an array of size elements from pool (reset to their default value), or allocates it if the pool has none */
+template<class T>
+static T* take_pooled_array(std::unordered_map<size_t, std::vector<std::unique_ptr<T[]>>>& pool, size_t size) {
+    std::vector<std::unique_ptr<T[]>>& free_arrays = pool[size];
+    if (free_arrays.empty()) {
+        return new T[size];
+    }
+    T* array = free_arrays.back().release();
+    free_arrays.pop_back();
+    std::fill_n(array, size, T());
+    return array;
+}
+
 /*****************************************************************************************
  * Internal functions declarations
  ******************************************************************************************/
+static void clear_intra_lb_nets(std::vector<t_intra_lb_net>& lb_nets);
 static void free_lb_net_rt(t_lb_trace* lb_trace);
 static void free_lb_trace(t_lb_trace* lb_trace);
 static void add_pin_to_rt_terminals(t_lb_router_data* router_data, const AtomPinId pin_id, const AtomPBBimap& atom_to_pb);
@@ -82,12 +107,12 @@ static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data, const A
 static void commit_remove_rt(t_lb_trace* rt, t_lb_router_data* router_data, e_commit_remove op, std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status);
 static bool is_skip_route_net(t_lb_trace* rt, t_lb_router_data* router_data);
 static void add_source_to_rt(t_lb_router_data* router_data, int inet);
-static void expand_rt(t_lb_router_data* router_data, int inet, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net);
-static void expand_rt_rec(t_lb_trace* rt, int prev_index, t_explored_node_tb* explored_node_tb, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net, int explore_id_index);
+static void expand_rt(t_lb_router_data* router_data, int inet, t_lb_expansion_pq& pq, int irt_net);
+static void expand_rt_rec(t_lb_trace* rt, int prev_index, t_explored_node_tb* explored_node_tb, t_lb_expansion_pq& pq, int irt_net, int explore_id_index);
 static bool try_expand_nodes(t_lb_router_data* router_data,
                              t_intra_lb_net* lb_net,
                              t_expansion_node* exp_node,
-                             reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq,
+                             t_lb_expansion_pq& pq,
                              int itarget,
                              bool try_other_modes,
                              int verbosity);
@@ -97,16 +122,17 @@ static void expand_edges(t_lb_router_data* router_data,
                          int cur_inode,
                          float cur_cost,
                          int net_fanout,
-                         reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq);
+                         t_lb_expansion_pq& pq);
 
-static void expand_node(t_lb_router_data* router_data, t_expansion_node exp_node, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int net_fanout);
-static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_node exp_node, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int net_fanout);
+static void expand_node(t_lb_router_data* router_data, t_expansion_node exp_node, t_lb_expansion_pq& pq, int net_fanout);
+static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_node exp_node, t_lb_expansion_pq& pq, int net_fanout);
 
 static bool add_to_rt(t_lb_trace* rt, int node_index, t_lb_router_data* router_data, int irt_net);
 static bool is_route_success(t_lb_router_data* router_data);
 static t_lb_trace* find_node_in_rt(t_lb_trace* rt, int rt_index);
 static void reset_explored_node_tb(t_lb_router_data* router_data);
 static void save_and_reset_lb_route(t_lb_router_data* router_data);
+static std::vector<int> get_intra_lb_route_signature(const t_lb_router_data* router_data);
 
 /**
  * @brief Recurse through route tree trace to populate pb pin to atom net lookup array.
@@ -149,17 +175,33 @@ static void print_trace(FILE* fp, t_lb_trace* trace, t_lb_router_data* router_da
 /**
  * Build data structures used by intra-logic block router
  */
-t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_type_graph, t_logical_block_type_ptr type) {
-    t_lb_router_data* router_data = new t_lb_router_data;
+t_lb_router_data* alloc_and_load_router_data(const std::vector<t_lb_type_rr_node>* lb_type_graph, t_logical_block_type_ptr type, IntraLbRouteCache* route_cache) {
+    t_lb_router_data* router_data;
     int size;
 
+    /* Reuse router data freed by this thread if any (its net and atom containers are empty) */
+    std::vector<t_lb_router_data*>& free_router_data = lb_router_scratch.free_router_data;
+    if (free_router_data.empty()) {
+        router_data = new t_lb_router_data;
+        router_data->intra_lb_nets = new std::vector<t_intra_lb_net>;
+        router_data->atoms_added = new std::map<AtomBlockId, bool>;
+    } else {
+        router_data = free_router_data.back();
+        free_router_data.pop_back();
+
+        std::vector<t_intra_lb_net>* intra_lb_nets = router_data->intra_lb_nets;
+        std::map<AtomBlockId, bool>* atoms_added = router_data->atoms_added;
+        *router_data = t_lb_router_data();
+        router_data->intra_lb_nets = intra_lb_nets;
+        router_data->atoms_added = atoms_added;
+    }
+
     router_data->lb_type_graph = lb_type_graph;
     size = router_data->lb_type_graph->size();
-    router_data->lb_rr_node_stats = new t_lb_rr_node_stats[size];
-    router_data->explored_node_tb = new t_explored_node_tb[size];
-    router_data->intra_lb_nets = new std::vector<t_intra_lb_net>;
-    router_data->atoms_added = new std::map<AtomBlockId, bool>;
+    router_data->lb_rr_node_stats = take_pooled_array(lb_router_scratch.free_lb_rr_node_stats, size);
+    router_data->explored_node_tb = take_pooled_array(lb_router_scratch.free_explored_node_tbs, size);
     router_data->lb_type = type;
+    router_data->route_cache = route_cache;
 
     return router_data;
 }
@@ -167,22 +209,25 @@ t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_
 /* free data used by router */
 void free_router_data(t_lb_router_data* router_data) {
     if (router_data != nullptr && router_data->lb_type_graph != nullptr) {
-        delete[] router_data->lb_rr_node_stats;
+        /* Return the per lb rr node arrays to the pool of this thread */
+        size_t size = router_data->lb_type_graph->size();
+        lb_router_scratch.free_lb_rr_node_stats[size].emplace_back(router_data->lb_rr_node_stats);
         router_data->lb_rr_node_stats = nullptr;
-        delete[] router_data->explored_node_tb;
+        lb_router_scratch.free_explored_node_tbs[size].emplace_back(router_data->explored_node_tb);
         router_data->explored_node_tb = nullptr;
         router_data->lb_type_graph = nullptr;
-        delete router_data->atoms_added;
-        router_data->atoms_added = nullptr;
-        free_intra_lb_nets(router_data->intra_lb_nets);
         free_intra_lb_nets(router_data->saved_lb_nets);
-        router_data->intra_lb_nets = nullptr;
-        delete router_data;
+        router_data->saved_lb_nets = nullptr;
+
+        /* Keep the router data, and the memory of its nets, for the next cluster of this thread */
+        router_data->atoms_added->clear();
+        clear_intra_lb_nets(*router_data->intra_lb_nets);
+        lb_router_scratch.free_router_data.push_back(router_data);
     }
 }
 
 static bool route_has_conflict(t_lb_trace* rt, t_lb_router_data* router_data) {
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
 
     int cur_mode = -1;
     for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
@@ -359,7 +404,7 @@ void set_reset_pb_modes(t_lb_router_data* router_data, const t_pb* pb, const boo
 static bool try_expand_nodes(t_lb_router_data* router_data,
                              t_intra_lb_net* lb_net,
                              t_expansion_node* exp_node,
-                             reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq,
+                             t_lb_expansion_pq& pq,
                              int itarget,
                              bool try_other_modes,
                              int verbosity) {
@@ -420,17 +465,40 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
                         int verbosity,
                         t_mode_selection_status* mode_status) {
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
     bool is_routed = false;
     bool is_impossible = false;
 
     mode_status->is_mode_conflict = false;
     mode_status->try_expand_all_modes = false;
 
+    /* Reuse the outcome of routing these exact nets and modes before. When expanding all modes, the
+     * outcome also depends on the illegal modes, so do not use the cache */
+    IntraLbRouteCache* route_cache = router_data->route_cache;
+    bool use_route_cache = (route_cache != nullptr && !mode_status->expand_all_modes);
+    std::vector<int> route_signature;
+    if (use_route_cache) {
+        route_signature = get_intra_lb_route_signature(router_data);
+        const IntraLbRouteCache::Entry* cached_route = route_cache->find(route_signature);
+        if (cached_route != nullptr) {
+            for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
+                free_lb_net_rt(lb_nets[inet].rt_tree);
+                lb_nets[inet].rt_tree = nullptr;
+            }
+            if (cached_route->is_routed) {
+                for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
+                    lb_nets[inet].rt_tree = new t_lb_trace(cached_route->rt_trees[inet]);
+                }
+                save_and_reset_lb_route(router_data);
+            }
+            return cached_route->is_routed;
+        }
+    }
+
     t_expansion_node exp_node;
 
     /* Stores state info during route */
-    reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node> pq;
+    t_lb_expansion_pq& pq = lb_router_scratch.pq;
 
     reset_explored_node_tb(router_data);
 
@@ -529,6 +597,19 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
         router_data->pres_con_fac *= router_data->params.pres_fac_mult;
     }
 
+    if (use_route_cache && !mode_status->is_mode_issue()) {
+        IntraLbRouteCache::Entry cached_route;
+        cached_route.is_routed = is_routed;
+        if (is_routed) {
+            cached_route.rt_trees.reserve(lb_nets.size());
+            for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
+                VTR_ASSERT(lb_nets[inet].rt_tree != nullptr);
+                cached_route.rt_trees.push_back(*lb_nets[inet].rt_tree);
+            }
+        }
+        route_cache->insert(std::move(route_signature), std::move(cached_route));
+    }
+
     if (is_routed) {
         save_and_reset_lb_route(router_data);
     } else {
@@ -582,13 +663,18 @@ void free_intra_lb_nets(std::vector<t_intra_lb_net>* intra_lb_nets) {
     if (intra_lb_nets == nullptr) {
         return;
     }
-    std::vector<t_intra_lb_net>& lb_nets = *intra_lb_nets;
+    clear_intra_lb_nets(*intra_lb_nets);
+    delete intra_lb_nets;
+}
+
+/* Frees the route trees of the nets and removes them (keeping the memory of the vector) */
+static void clear_intra_lb_nets(std::vector<t_intra_lb_net>& lb_nets) {
     for (unsigned int i = 0; i < lb_nets.size(); i++) {
         lb_nets[i].terminals.clear();
         free_lb_net_rt(lb_nets[i].rt_tree);
         lb_nets[i].rt_tree = nullptr;
     }
-    delete intra_lb_nets;
+    lb_nets.clear();
 }
 
 /***************************************************************************
@@ -649,7 +735,7 @@ static void free_lb_trace(t_lb_trace* lb_trace) {
  */
 static void add_pin_to_rt_terminals(t_lb_router_data* router_data, const AtomPinId pin_id, const AtomPBBimap& atom_to_pb) {
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
     t_logical_block_type_ptr lb_type = router_data->lb_type;
     bool found = false;
     unsigned int ipos;
@@ -816,7 +902,7 @@ static void add_pin_to_rt_terminals(t_lb_router_data* router_data, const AtomPin
  */
 static void remove_pin_from_rt_terminals(t_lb_router_data* router_data, const AtomPinId pin_id, const AtomPBBimap& atom_to_pb) {
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
     t_logical_block_type_ptr lb_type = router_data->lb_type;
     bool found = false;
     unsigned int ipos;
@@ -942,7 +1028,7 @@ static void remove_pin_from_rt_terminals(t_lb_router_data* router_data, const At
 static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data, const AtomPBBimap& atom_to_pb) {
     auto& atom_ctx = g_vpr_ctx.atom();
 
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
 
     for (size_t ilb_net = 0; ilb_net < lb_nets.size(); ++ilb_net) {
@@ -997,7 +1083,7 @@ static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data, const A
 static void commit_remove_rt(t_lb_trace* rt, t_lb_router_data* router_data, e_commit_remove op, std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status) {
     t_lb_rr_node_stats* lb_rr_node_stats;
     t_explored_node_tb* explored_node_tb;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
     int inode;
     int incr;
 
@@ -1048,7 +1134,7 @@ static void commit_remove_rt(t_lb_trace* rt, t_lb_router_data* router_data, e_co
 /* Should net be skipped?  If the net does not conflict with another net, then skip routing this net */
 static bool is_skip_route_net(t_lb_trace* rt, t_lb_router_data* router_data) {
     t_lb_rr_node_stats* lb_rr_node_stats;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
     int inode;
 
     lb_rr_node_stats = router_data->lb_rr_node_stats;
@@ -1084,7 +1170,7 @@ static void add_source_to_rt(t_lb_router_data* router_data, int inet) {
 }
 
 /* Expand all nodes found in route tree into priority queue */
-static void expand_rt(t_lb_router_data* router_data, int inet, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net) {
+static void expand_rt(t_lb_router_data* router_data, int inet, t_lb_expansion_pq& pq, int irt_net) {
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
 
     VTR_ASSERT(pq.empty());
@@ -1093,7 +1179,7 @@ static void expand_rt(t_lb_router_data* router_data, int inet, reservable_pq<t_e
 }
 
 /* Expand all nodes found in route tree into priority queue recursively */
-static void expand_rt_rec(t_lb_trace* rt, int prev_index, t_explored_node_tb* explored_node_tb, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net, int explore_id_index) {
+static void expand_rt_rec(t_lb_trace* rt, int prev_index, t_explored_node_tb* explored_node_tb, t_lb_expansion_pq& pq, int irt_net, int explore_id_index) {
     t_expansion_node enode;
 
     /* Perhaps should use a cost other than zero */
@@ -1118,8 +1204,8 @@ static void expand_edges(t_lb_router_data* router_data,
                          int cur_inode,
                          float cur_cost,
                          int net_fanout,
-                         reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq) {
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+                         t_lb_expansion_pq& pq) {
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
     t_lb_rr_node_stats* lb_rr_node_stats = router_data->lb_rr_node_stats;
     t_lb_router_params params = router_data->params;
     t_expansion_node enode;
@@ -1171,7 +1257,7 @@ static void expand_edges(t_lb_router_data* router_data,
 }
 
 /* Expand all nodes found in route tree into priority queue */
-static void expand_node(t_lb_router_data* router_data, t_expansion_node exp_node, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int net_fanout) {
+static void expand_node(t_lb_router_data* router_data, t_expansion_node exp_node, t_lb_expansion_pq& pq, int net_fanout) {
     int cur_node;
     float cur_cost;
     int mode;
@@ -1189,8 +1275,8 @@ static void expand_node(t_lb_router_data* router_data, t_expansion_node exp_node
 }
 
 /* Expand all nodes using all possible modes found in route tree into priority queue */
-static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_node exp_node, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int net_fanout) {
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_node exp_node, t_lb_expansion_pq& pq, int net_fanout) {
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
     t_lb_rr_node_stats* lb_rr_node_stats = router_data->lb_rr_node_stats;
 
     int cur_inode = exp_node.node_index;
@@ -1262,7 +1348,7 @@ static bool add_to_rt(t_lb_trace* rt, int node_index, t_lb_router_data* router_d
 
 /* Determine if a completed route is valid.  A successful route has no congestion (ie. no routing resource is used by two nets). */
 static bool is_route_success(t_lb_router_data* router_data) {
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
 
     for (unsigned int inode = 0; inode < lb_type_graph.size(); inode++) {
         if (router_data->lb_rr_node_stats[inode].occ > lb_type_graph[inode].capacity) {
@@ -1293,7 +1379,7 @@ static t_lb_trace* find_node_in_rt(t_lb_trace* rt, int rt_index) {
 /* Debug routine, print out current intra logic block route */
 static void print_route(const char* filename, t_lb_router_data* router_data) {
     FILE* fp;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
 
     fp = fopen(filename, "w");
     for (unsigned int inode = 0; inode < lb_type_graph.size(); inode++) {
@@ -1340,7 +1426,7 @@ static void print_trace(FILE* fp, t_lb_trace* trace, t_lb_router_data* router_da
 }
 
 static void reset_explored_node_tb(t_lb_router_data* router_data) {
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
     for (unsigned int inode = 0; inode < lb_type_graph.size(); inode++) {
         router_data->explored_node_tb[inode].prev_index = UNDEFINED;
         router_data->explored_node_tb[inode].explored_id = UNDEFINED;
@@ -1378,6 +1464,30 @@ static void save_and_reset_lb_route(t_lb_router_data* router_data) {
     }
 }
 
+/* Builds the signature of the current routing problem for the route cache: the logic block type, the
+ * terminals of each net in routing order (the order matters to Pathfinder), and every lb rr node
+ * with a selected mode */
+static std::vector<int> get_intra_lb_route_signature(const t_lb_router_data* router_data) {
+    const std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
+    std::vector<int> signature;
+
+    signature.push_back(router_data->lb_type->index);
+    signature.push_back(lb_nets.size());
+    for (const t_intra_lb_net& lb_net : lb_nets) {
+        signature.push_back(lb_net.terminals.size());
+        signature.insert(signature.end(), lb_net.terminals.begin(), lb_net.terminals.end());
+    }
+    for (int inode = 0; inode < (int)router_data->lb_type_graph->size(); inode++) {
+        int mode = router_data->lb_rr_node_stats[inode].mode;
+        if (mode != -1) {
+            signature.push_back(inode);
+            signature.push_back(mode);
+        }
+    }
+
+    return signature;
+}
+
 static std::vector<int> find_congested_rr_nodes(const std::vector<t_lb_type_rr_node>& lb_type_graph,
                                                 const t_lb_rr_node_stats* lb_rr_node_stats) {
     std::vector<int> congested_rr_nodes;
@@ -14,7 +14,7 @@
 #include "vpr_utils.h"
 
 /* Constructors/Destructors */
-t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_type_graph, t_logical_block_type_ptr type);
+t_lb_router_data* alloc_and_load_router_data(const std::vector<t_lb_type_rr_node>* lb_type_graph, t_logical_block_type_ptr type, IntraLbRouteCache* route_cache);
 void free_router_data(t_lb_router_data* router_data);
 void free_intra_lb_nets(std::vector<t_intra_lb_net>* intra_lb_nets);
 
@@ -71,6 +71,18 @@ static void add_molecule_to_pb_stats_candidates(
     const AtomNetlist& atom_netlist,
     const APPackContext& appack_ctx);
 
+/**
+ * @brief Marks the total gain of blk_id as needing an update after one of its
+ *        partial gains changed.
+ *
+ * Only the marked blocks (the ones with a sharing gain) have their total gain
+ * maintained.
+ */
+static inline void mark_stale_gain(ClusterGainStats& cluster_gain_stats, AtomBlockId blk_id) {
+    if (cluster_gain_stats.sharing_gain.count(blk_id) != 0)
+        cluster_gain_stats.blocks_with_stale_gain.push_back(blk_id);
+}
+
 /**
  * @brief Get the flat placement position of the given molecule.
  */
@@ -339,10 +351,12 @@ void GreedyCandidateSelector::update_cluster_gain_stats_candidate_success(
 
         // TODO: For flat placement reconstruction, should we mark the molecules
         //       in the same tile as the seed of this cluster?
-
-        update_total_gain(cluster_gain_stats, attraction_groups);
     }
 
+    // The total gains only depend on the partial gains updated above, so they
+    // are updated once all the blocks of the molecule have been marked.
+    update_total_gain(cluster_gain_stats, attraction_groups);
+
     // if this molecule came from the transitive fanout candidates remove it
     cluster_gain_stats.transitive_fanout_candidates.erase(successful_mol.atom_block_ids[successful_mol.root]);
     cluster_gain_stats.explore_transitive_fanout = true;
@@ -419,6 +433,7 @@ void GreedyCandidateSelector::mark_and_update_partial_gain(
                     } else {
                         cluster_gain_stats.sharing_gain[blk_id]++;
                     }
+                    cluster_gain_stats.blocks_with_stale_gain.push_back(blk_id);
                 }
             }
         }
@@ -507,6 +522,7 @@ void GreedyCandidateSelector::update_connection_gain_values(
                     cluster_gain_stats.connection_gain[blk_id] -= 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 1 + 0.1);
                 }
                 cluster_gain_stats.connection_gain[blk_id] += 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 0.1);
+                mark_stale_gain(cluster_gain_stats, blk_id);
             }
         }
     }
@@ -526,6 +542,7 @@ void GreedyCandidateSelector::update_connection_gain_values(
                 cluster_gain_stats.connection_gain[blk_id] -= 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 0.1 + 1);
             }
             cluster_gain_stats.connection_gain[blk_id] += 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 0.1);
+            mark_stale_gain(cluster_gain_stats, blk_id);
         }
     }
 }
@@ -558,8 +575,10 @@ void GreedyCandidateSelector::update_timing_gain_values(
                 if (cluster_gain_stats.timing_gain.count(blk_id) == 0) {
                     cluster_gain_stats.timing_gain[blk_id] = 0;
                 }
-                if (timing_gain > cluster_gain_stats.timing_gain[blk_id])
+                if (timing_gain > cluster_gain_stats.timing_gain[blk_id]) {
                     cluster_gain_stats.timing_gain[blk_id] = timing_gain;
+                    mark_stale_gain(cluster_gain_stats, blk_id);
+                }
             }
         }
     }
@@ -578,8 +597,10 @@ void GreedyCandidateSelector::update_timing_gain_values(
                 if (cluster_gain_stats.timing_gain.count(new_blk_id) == 0) {
                     cluster_gain_stats.timing_gain[new_blk_id] = 0;
                 }
-                if (timing_gain > cluster_gain_stats.timing_gain[new_blk_id])
+                if (timing_gain > cluster_gain_stats.timing_gain[new_blk_id]) {
                     cluster_gain_stats.timing_gain[new_blk_id] = timing_gain;
+                    mark_stale_gain(cluster_gain_stats, new_blk_id);
+                }
             }
         }
     }
@@ -589,7 +610,7 @@ void GreedyCandidateSelector::update_total_gain(ClusterGainStats& cluster_gain_s
                                                 AttractionInfo& attraction_groups) {
     AttractGroupId cluster_att_grp_id = cluster_gain_stats.attraction_grp_id;
 
-    for (AtomBlockId blk_id : cluster_gain_stats.marked_blocks) {
+    for (AtomBlockId blk_id : cluster_gain_stats.blocks_with_stale_gain) {
         //Initialize connection_gain and sharing_gain if
         //they have not previously been updated for the block
         if (cluster_gain_stats.connection_gain.count(blk_id) == 0) {
@@ -636,6 +657,7 @@ void GreedyCandidateSelector::update_total_gain(ClusterGainStats& cluster_gain_s
                                               + (1.0 - packer_opts_.timing_gain_weight) * (float)cluster_gain_stats.gain[blk_id];
         }
     }
+    cluster_gain_stats.blocks_with_stale_gain.clear();
 }
 
 void GreedyCandidateSelector::update_cluster_gain_stats_candidate_failed(
@@ -791,7 +813,15 @@ void GreedyCandidateSelector::add_cluster_molecule_candidates_by_connectivity_an
     cluster_gain_stats.explore_transitive_fanout = true;                                  /* If no legal molecules found, enable exploration of molecules two hops away */
     cluster_gain_stats.candidates_propose_limit = packer_opts_.feasible_block_array_size; // set the limit of candidates to propose
 
+    // Blocks never get unclustered while the cluster grows, so drop the
+    // clustered ones from the marked blocks for the next searches (keeping the
+    // order of the others, which decides over candidates of equal gain).
+    size_t num_unclustered_marked_blocks = 0;
     for (AtomBlockId blk_id : cluster_gain_stats.marked_blocks) {
+        if (cluster_legalizer.is_atom_clustered(blk_id))
+            continue;
+        cluster_gain_stats.marked_blocks[num_unclustered_marked_blocks++] = blk_id;
+
         // Get the molecule that contains this block.
         PackMoleculeId molecule_id = prepacker_.get_atom_molecule(blk_id);
         // Add the molecule as a candidate if the molecule is not clustered and
@@ -806,6 +836,7 @@ void GreedyCandidateSelector::add_cluster_molecule_candidates_by_connectivity_an
                                                 appack_ctx_);
         }
     }
+    cluster_gain_stats.marked_blocks.resize(num_unclustered_marked_blocks);
 }
 
 void GreedyCandidateSelector::add_cluster_molecule_candidates_by_transitive_connectivity(
@@ -18,6 +18,7 @@
 #include "logic_types.h"
 #include "physical_types.h"
 #include "prepack.h"
+#include "vtr_flat_hash_map.h"
 #include "vtr_ndmatrix.h"
 #include "vtr_vector.h"
 #include "vtr_random.h"
@@ -50,31 +51,38 @@ struct ClusterGainStats {
     bool has_done_connectivity_and_timing = false;
 
     /// @brief Attraction (inverse of cost) function.
-    std::unordered_map<AtomBlockId, float> gain;
+    vtr::flat_hash_map<AtomBlockId, float> gain;
 
     /// @brief The timing criticality score of this atom.
     ///        Determined by the most critical atom net between this atom
     ///        and any atom in the current pb.
-    std::unordered_map<AtomBlockId, float> timing_gain;
+    vtr::flat_hash_map<AtomBlockId, float> timing_gain;
     /// @brief Weighted sum of connections to attraction function.
-    std::unordered_map<AtomBlockId, float> connection_gain;
+    vtr::flat_hash_map<AtomBlockId, float> connection_gain;
     /// @brief How many nets on an atom are already in the pb under
     ///        consideration.
-    std::unordered_map<AtomBlockId, float> sharing_gain;
+    vtr::flat_hash_map<AtomBlockId, float> sharing_gain;
 
     /// @brief Stores the number of times molecules have failed to be packed
     ///        into the cluster.
     ///
     /// key: molecule id, value: number of times the molecule has failed to be
     ///                          packed into the cluster.
-    std::unordered_map<PackMoleculeId, int> mol_failures;
+    vtr::flat_hash_map<PackMoleculeId, int> mol_failures;
 
     /// @brief List of nets with the num_pins_of_net_in_pb and gain entries
     ///        altered (i.e. have some gain-related connection to the current
     ///        cluster).
     std::vector<AtomNetId> marked_nets;
     /// @brief List of blocks with the num_pins_of_net_in_pb and gain entries altered.
+    ///        Blocks which have been clustered since they were marked are
+    ///        dropped from it when the candidates are collected.
     std::vector<AtomBlockId> marked_blocks;
+    /// @brief Marked blocks whose sharing, connection or timing gain changed
+    ///        since their total gain was last computed (may hold duplicates).
+    ///        Only these need their total gain updated when a molecule is
+    ///        added to the cluster.
+    std::vector<AtomBlockId> blocks_with_stale_gain;
 
     /// @brief If no marked candidate molecules, use this high fanout net to
     ///        determine the next candidate atom.
@@ -89,7 +97,7 @@ struct ClusterGainStats {
     std::map<AtomBlockId, PackMoleculeId> transitive_fanout_candidates;
 
     /// @brief How many pins of each atom net are contained in the currently open pb?
-    std::unordered_map<AtomNetId, int> num_pins_of_net_in_pb;
+    vtr::flat_hash_map<AtomNetId, int> num_pins_of_net_in_pb;
 
     /// @brief The attraction group associated with the cluster. Will be
     ///        AttractGroupId::INVALID() if no attraction group is associated
@@ -447,6 +455,9 @@ class GreedyCandidateSelector {
      *        between input sharing (sharing_gain) and path_length minimization
      *        (timing_gain) input each time a new molecule is added to the
      *        cluster.
+     *
+     * The total gain of a block only depends on its partial gains, so only the
+     * blocks_with_stale_gain are updated, instead of all the marked blocks.
      */
     void update_total_gain(ClusterGainStats& cluster_gain_stats,
                            AttractionInfo& attraction_groups);
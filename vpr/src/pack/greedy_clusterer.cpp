@@ -37,9 +37,14 @@
  */
 
 #include "greedy_clusterer.h"
+#include <algorithm>
 #include <cstdio>
+#include <limits>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 #include "appack_context.h"
 #include "setup_grid.h"
@@ -47,6 +52,7 @@
 #include "attraction_groups.h"
 #include "cluster_legalizer.h"
 #include "cluster_util.h"
+#include "globals.h"
 #include "greedy_candidate_selector.h"
 #include "greedy_seed_selector.h"
 #include "logic_types.h"
@@ -54,6 +60,11 @@
 #include "prepack.h"
 #include "vpr_context.h"
 #include "vtr_math.h"
+#include "vtr_time.h"
+
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
 
 namespace {
 
@@ -70,6 +81,158 @@ struct t_cluster_progress_stats {
     int mols_since_last_print = 0;
 };
 
+/**
+ * @brief Nets with more pins than this are ignored when partitioning the
+ *        netlist: they connect too many molecules to keep them in one
+ *        partition, and clustering along them gains little.
+ */
+constexpr size_t PARTITION_MAX_NET_PINS = 16;
+
+/**
+ * @brief Partitions the molecules into num_partitions parts of about the same
+ *        size, which can be clustered independently.
+ *
+ * With a flat placement (APPack), the molecules are cut into vertical stripes
+ * of the device by the location of their root atom. Otherwise, they are cut
+ * in the order a breadth-first traversal of the netlist (through the nets of
+ * at most PARTITION_MAX_NET_PINS pins) visits them, which keeps connected
+ * molecules together.
+ *
+ * The molecules of a chain are kept together. Molecules on a net cut by the
+ * partitioning are not put in any partition: they are left to the serial
+ * clustering, where they can join the molecules on the other side of the cut.
+ * Molecules already clustered (e.g. restored ECO clusters) are not put in any
+ * partition either, nor are the other molecules of their chains.
+ */
+std::vector<std::vector<PackMoleculeId>> partition_molecules(const AtomNetlist& atom_netlist,
+                                                             const Prepacker& prepacker,
+                                                             const std::unordered_set<AtomNetId>& is_clock,
+                                                             const std::unordered_set<AtomNetId>& is_global,
+                                                             const APPackContext& appack_ctx,
+                                                             const ClusterLegalizer& cluster_legalizer,
+                                                             size_t num_partitions) {
+    auto is_partition_net = [&](AtomNetId net_id) {
+        return atom_netlist.net_pins(net_id).size() <= PARTITION_MAX_NET_PINS
+               && is_clock.count(net_id) == 0
+               && is_global.count(net_id) == 0;
+    };
+
+    // Order the molecules so that the molecules close to each other end up
+    // in the same partition.
+    std::vector<PackMoleculeId> mol_order;
+    mol_order.reserve(prepacker.molecules().size());
+    if (appack_ctx.appack_options.use_appack) {
+        const FlatPlacementInfo& flat_placement_info = appack_ctx.flat_placement_info;
+        auto root_pos = [&](PackMoleculeId mol_id) {
+            const t_pack_molecule& mol = prepacker.get_molecule(mol_id);
+            AtomBlockId root_blk_id = mol.atom_block_ids[mol.root];
+            return std::make_pair(flat_placement_info.blk_x_pos[root_blk_id], flat_placement_info.blk_y_pos[root_blk_id]);
+        };
+        mol_order.assign(prepacker.molecules().begin(), prepacker.molecules().end());
+        std::stable_sort(mol_order.begin(), mol_order.end(), [&](PackMoleculeId lhs, PackMoleculeId rhs) {
+            return root_pos(lhs) < root_pos(rhs);
+        });
+    } else {
+        vtr::vector_map<PackMoleculeId, bool> mol_visited(prepacker.molecules().size(), false);
+        vtr::vector<AtomNetId, bool> net_visited(atom_netlist.nets().size(), false);
+        for (PackMoleculeId start_mol_id : prepacker.molecules()) {
+            if (mol_visited[start_mol_id])
+                continue;
+            mol_visited[start_mol_id] = true;
+            size_t head = mol_order.size();
+            mol_order.push_back(start_mol_id);
+            while (head < mol_order.size()) {
+                const t_pack_molecule& mol = prepacker.get_molecule(mol_order[head++]);
+                for (AtomBlockId blk_id : mol.atom_block_ids) {
+                    if (!blk_id)
+                        continue;
+                    for (AtomPinId pin_id : atom_netlist.block_pins(blk_id)) {
+                        AtomNetId net_id = atom_netlist.pin_net(pin_id);
+                        if (!net_id || net_visited[net_id] || !is_partition_net(net_id))
+                            continue;
+                        net_visited[net_id] = true;
+                        for (AtomPinId net_pin_id : atom_netlist.net_pins(net_id)) {
+                            PackMoleculeId next_mol_id = prepacker.get_atom_molecule(atom_netlist.pin_block(net_pin_id));
+                            if (!mol_visited[next_mol_id]) {
+                                mol_visited[next_mol_id] = true;
+                                mol_order.push_back(next_mol_id);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    vtr::vector_map<PackMoleculeId, size_t> mol_partition(prepacker.molecules().size());
+    for (size_t i = 0; i < mol_order.size(); i++) {
+        mol_partition[mol_order[i]] = i * num_partitions / mol_order.size();
+    }
+
+    // Keep each chain in the partition of its first molecule.
+    constexpr size_t NO_PARTITION = std::numeric_limits<size_t>::max();
+    vtr::vector_map<MoleculeChainId, size_t> chain_partition(prepacker.get_num_molecule_chains(), NO_PARTITION);
+    for (PackMoleculeId mol_id : mol_order) {
+        const t_pack_molecule& mol = prepacker.get_molecule(mol_id);
+        if (!mol.is_chain())
+            continue;
+        if (chain_partition[mol.chain_id] == NO_PARTITION)
+            chain_partition[mol.chain_id] = mol_partition[mol_id];
+        mol_partition[mol_id] = chain_partition[mol.chain_id];
+    }
+
+    // Leave the molecules on cut nets (and the chains they are part of) to
+    // the serial clustering.
+    vtr::vector_map<PackMoleculeId, bool> is_boundary_mol(prepacker.molecules().size(), false);
+    vtr::vector_map<MoleculeChainId, bool> is_boundary_chain(prepacker.get_num_molecule_chains(), false);
+    for (AtomNetId net_id : atom_netlist.nets()) {
+        if (!is_partition_net(net_id))
+            continue;
+        size_t net_partition = NO_PARTITION;
+        bool is_cut = false;
+        for (AtomPinId pin_id : atom_netlist.net_pins(net_id)) {
+            size_t pin_partition = mol_partition[prepacker.get_atom_molecule(atom_netlist.pin_block(pin_id))];
+            if (net_partition == NO_PARTITION)
+                net_partition = pin_partition;
+            is_cut |= (pin_partition != net_partition);
+        }
+        if (!is_cut)
+            continue;
+        for (AtomPinId pin_id : atom_netlist.net_pins(net_id)) {
+            PackMoleculeId mol_id = prepacker.get_atom_molecule(atom_netlist.pin_block(pin_id));
+            is_boundary_mol[mol_id] = true;
+            const t_pack_molecule& mol = prepacker.get_molecule(mol_id);
+            if (mol.is_chain())
+                is_boundary_chain[mol.chain_id] = true;
+        }
+    }
+    for (PackMoleculeId mol_id : mol_order) {
+        if (!cluster_legalizer.is_mol_clustered(mol_id))
+            continue;
+        is_boundary_mol[mol_id] = true;
+        const t_pack_molecule& mol = prepacker.get_molecule(mol_id);
+        if (mol.is_chain())
+            is_boundary_chain[mol.chain_id] = true;
+    }
+
+    std::vector<std::vector<PackMoleculeId>> partitions(num_partitions);
+    for (PackMoleculeId mol_id : mol_order) {
+        const t_pack_molecule& mol = prepacker.get_molecule(mol_id);
+        if (is_boundary_mol[mol_id] || (mol.is_chain() && is_boundary_chain[mol.chain_id]))
+            continue;
+        partitions[mol_partition[mol_id]].push_back(mol_id);
+    }
+    return partitions;
+}
+
+/// @brief Picks the next seed molecule, timing it as seed selection.
+PackMoleculeId get_next_seed(GreedySeedSelector& seed_selector,
+                             const ClusterLegalizer& cluster_legalizer,
+                             PackProfiler& pack_profiler) {
+    PackPhaseTimer seed_timer(pack_profiler, e_pack_phase::SEED_SELECTION, nullptr);
+    return seed_selector.get_next_seed(cluster_legalizer);
+}
+
 } // namespace
 
 GreedyClusterer::GreedyClusterer(const t_packer_opts& packer_opts,
@@ -90,6 +253,8 @@ GreedyClusterer::GreedyClusterer(const t_packer_opts& packer_opts,
     , is_global_(is_global)
     , pre_cluster_timing_manager_(pre_cluster_timing_manager)
     , appack_ctx_(appack_ctx)
+    , eco_clusters_(packer_opts.eco_net_file.empty() ? std::vector<t_net_file_cluster>()
+                                                     : read_netlist_clusters(packer_opts.eco_net_file.c_str()))
     , primitive_candidate_block_types_(identify_primitive_candidate_block_types())
     , log_verbosity_(packer_opts.pack_verbosity)
     , net_output_feeds_driving_block_input_(identify_net_output_feeds_driving_block_input(atom_netlist)) {
@@ -115,6 +280,31 @@ GreedyClusterer::do_clustering(ClusterLegalizer& cluster_legalizer,
     t_cluster_progress_stats clustering_stats;
     clustering_stats.num_molecules = prepacker.molecules().size();
 
+    // Profile this packing iteration on its own.
+    PackProfiler& pack_profiler = cluster_legalizer.mutable_pack_profiler();
+    pack_profiler.reset();
+
+#ifdef VPR_USE_TBB
+    // Create the replicas the candidates are tried on in parallel (with the
+    // target pin utilizations of this packing iteration).
+    if (packer_opts_.speculative_candidates > 1) {
+        std::vector<std::unique_ptr<ClusterLegalizer>> replicas;
+        for (int ireplica = 0; ireplica < packer_opts_.speculative_candidates; ireplica++) {
+            replicas.push_back(std::make_unique<ClusterLegalizer>(atom_netlist_,
+                                                                  prepacker,
+                                                                  cluster_legalizer.lb_type_rr_graphs(),
+                                                                  packer_opts_.target_external_pin_util,
+                                                                  high_fanout_thresholds_,
+                                                                  ClusterLegalizationStrategy::FULL,
+                                                                  packer_opts_.enable_pin_feasibility_filter,
+                                                                  arch_.models,
+                                                                  0,
+                                                                  cluster_legalizer.noc_router_distance_index()));
+        }
+        cluster_legalizer.set_speculative_replicas(std::move(replicas));
+    }
+#endif
+
     // Calculate the max molecule stats, which is used for gain calculation.
     const t_molecule_stats max_molecule_stats = prepacker.calc_max_molecule_stats(atom_netlist_, arch_.models);
 
@@ -143,13 +333,42 @@ GreedyClusterer::do_clustering(ClusterLegalizer& cluster_legalizer,
                                      arch_.models,
                                      pre_cluster_timing_manager_);
 
-    // Pick the first seed molecule.
-    PackMoleculeId seed_mol_id = seed_selector.get_next_seed(cluster_legalizer);
-
     /****************************************************************
      * Clustering
      *****************************************************************/
 
+    // Reuse the clusters of the previous packing first (ECO packing), so
+    // that only the molecules of the changed logic are clustered below.
+    if (!eco_clusters_.empty()) {
+        restore_eco_clusters(cluster_legalizer,
+                             prepacker,
+                             num_used_type_instances,
+                             mutable_device_ctx);
+    }
+
+    // Cluster the partitions of the netlist in parallel first. The serial
+    // clustering below then only has to cluster the boundary molecules.
+    // Attraction groups are shared by all the clusters, so they require
+    // serial clustering.
+    if (packer_opts_.num_partitions > 1 && attraction_groups.num_attraction_groups() == 0) {
+        cluster_partitions(cluster_legalizer,
+                           prepacker,
+                           allow_unrelated_clustering,
+                           balance_block_type_utilization,
+                           max_molecule_stats,
+                           attraction_groups,
+                           num_used_type_instances,
+                           mutable_device_ctx);
+    }
+
+    // Account for the molecules clustered so far.
+    for (LegalizationClusterId cluster_id : cluster_legalizer.clusters()) {
+        clustering_stats.num_molecules_processed += cluster_legalizer.get_num_molecules_in_cluster(cluster_id);
+    }
+
+    // Pick the first seed molecule.
+    PackMoleculeId seed_mol_id = get_next_seed(seed_selector, cluster_legalizer, pack_profiler);
+
     print_pack_status_header();
 
     // Continue clustering as long as a valid seed is returned from the seed
@@ -175,7 +394,8 @@ GreedyClusterer::do_clustering(ClusterLegalizer& cluster_legalizer,
                                                                 balance_block_type_utilization,
                                                                 attraction_groups,
                                                                 num_used_type_instances,
-                                                                mutable_device_ctx);
+                                                                mutable_device_ctx,
+                                                                true);
 
         if (!new_cluster_id.is_valid()) {
             // If the previous strategy failed, try to grow the cluster again,
@@ -189,7 +409,8 @@ GreedyClusterer::do_clustering(ClusterLegalizer& cluster_legalizer,
                                               balance_block_type_utilization,
                                               attraction_groups,
                                               num_used_type_instances,
-                                              mutable_device_ctx);
+                                              mutable_device_ctx,
+                                              true);
         }
 
         // Ensure that the seed was packed successfully.
@@ -212,12 +433,24 @@ GreedyClusterer::do_clustering(ClusterLegalizer& cluster_legalizer,
                           cluster_legalizer);
 
         // Pick new seed.
-        seed_mol_id = seed_selector.get_next_seed(cluster_legalizer);
+        seed_mol_id = get_next_seed(seed_selector, cluster_legalizer, pack_profiler);
     }
 
     // If this architecture has LE physical block, report its usage.
     report_le_physical_block_usage(cluster_legalizer);
 
+    const IntraLbRouteCache& route_cache = cluster_legalizer.intra_lb_route_cache();
+    size_t num_route_cache_hits = route_cache.num_feasible_hits() + route_cache.num_infeasible_hits();
+    VTR_LOG("Intra-LB route cache: %zu lookups, %zu hits (%.1f%%: %zu routable, %zu unroutable), %zu flushes\n",
+            route_cache.num_lookups(),
+            num_route_cache_hits,
+            route_cache.num_lookups() > 0 ? 100. * num_route_cache_hits / route_cache.num_lookups() : 0.,
+            route_cache.num_feasible_hits(),
+            route_cache.num_infeasible_hits(),
+            route_cache.num_flushes());
+
+    pack_profiler.print_report(mutable_device_ctx.logical_block_types);
+
     return num_used_type_instances;
 }
 
@@ -229,7 +462,8 @@ LegalizationClusterId GreedyClusterer::try_grow_cluster(PackMoleculeId seed_mol_
                                                         bool balance_block_type_utilization,
                                                         AttractionInfo& attraction_groups,
                                                         std::map<t_logical_block_type_ptr, size_t>& num_used_type_instances,
-                                                        DeviceContext& mutable_device_ctx) {
+                                                        DeviceContext& mutable_device_ctx,
+                                                        bool allow_device_resize) {
 
     // Check to ensure that this molecule is unclustered.
     VTR_ASSERT(!cluster_legalizer.is_mol_clustered(seed_mol_id));
@@ -243,7 +477,13 @@ LegalizationClusterId GreedyClusterer::try_grow_cluster(PackMoleculeId seed_mol_
                                                                       prepacker,
                                                                       balance_block_type_utilization,
                                                                       num_used_type_instances,
-                                                                      mutable_device_ctx);
+                                                                      mutable_device_ctx,
+                                                                      allow_device_resize);
+
+    PackProfiler& pack_profiler = cluster_legalizer.mutable_pack_profiler();
+    t_logical_block_type_ptr cluster_type = cluster_legalizer.get_cluster_type(legalization_cluster_id);
+    std::optional<PackPhaseTimer> gain_timer;
+    gain_timer.emplace(pack_profiler, e_pack_phase::CANDIDATE_GAIN, cluster_type);
 
     // Create the cluster gain stats. This updates the gains in the candidate
     // selector due to a new molecule being clustered.
@@ -258,6 +498,7 @@ LegalizationClusterId GreedyClusterer::try_grow_cluster(PackMoleculeId seed_mol_
         legalization_cluster_id,
         cluster_legalizer,
         attraction_groups);
+    gain_timer.reset();
 
     /*
      * When attraction groups are created, the purpose is to pack more densely by adding more molecules
@@ -276,12 +517,54 @@ LegalizationClusterId GreedyClusterer::try_grow_cluster(PackMoleculeId seed_mol_
     //  1) No candidate molecule is proposed.
     //  2) The same candidate was proposed multiple times.
     int num_repeated_molecules = 0;
+    // With full legalization, several candidates can be tried at once on
+    // replicas of the cluster (see --pack_speculative_candidates).
+    bool try_speculative_candidates = (strategy == ClusterLegalizationStrategy::FULL
+                                       && cluster_legalizer.num_speculative_replicas() > 0);
     while (candidate_mol_id.is_valid() && num_repeated_molecules < max_num_repeated_molecules) {
-        // Try to cluster the candidate molecule into the cluster.
-        bool success = try_add_candidate_mol_to_cluster(candidate_mol_id,
-                                                        legalization_cluster_id,
-                                                        cluster_legalizer,
-                                                        prepacker);
+        bool success;
+        if (try_speculative_candidates) {
+            // Propose more candidates, as if the previous ones failed, and add
+            // the first one which can legally be added.
+            std::vector<PackMoleculeId> candidate_mol_ids = {candidate_mol_id};
+            gain_timer.emplace(pack_profiler, e_pack_phase::CANDIDATE_GAIN, cluster_type);
+            while (candidate_mol_ids.size() < (size_t)packer_opts_.speculative_candidates) {
+                PackMoleculeId next_candidate_mol_id = candidate_selector.get_next_candidate_for_cluster(
+                    cluster_gain_stats,
+                    legalization_cluster_id,
+                    cluster_legalizer,
+                    attraction_groups);
+                if (!next_candidate_mol_id.is_valid()
+                    || std::find(candidate_mol_ids.begin(), candidate_mol_ids.end(), next_candidate_mol_id) != candidate_mol_ids.end())
+                    break;
+                candidate_mol_ids.push_back(next_candidate_mol_id);
+            }
+            gain_timer.reset();
+
+            std::vector<e_block_pack_status> pack_statuses = cluster_legalizer.add_first_legal_mol_to_cluster(candidate_mol_ids,
+                                                                                                              legalization_cluster_id);
+
+            // The candidates before the last one tried failed; the last one
+            // is handled below like a single candidate.
+            size_t num_tried = 0;
+            while (num_tried < pack_statuses.size() && pack_statuses[num_tried] != e_block_pack_status::BLK_STATUS_UNDEFINED)
+                num_tried++;
+            VTR_ASSERT(num_tried > 0);
+            for (size_t i = 0; i + 1 < num_tried; i++)
+                candidate_selector.update_cluster_gain_stats_candidate_failed(cluster_gain_stats, candidate_mol_ids[i]);
+            candidate_mol_id = candidate_mol_ids[num_tried - 1];
+            success = (pack_statuses[num_tried - 1] == e_block_pack_status::BLK_PASSED);
+        } else {
+            // Try to cluster the candidate molecule into the cluster.
+            success = try_add_candidate_mol_to_cluster(candidate_mol_id,
+                                                       legalization_cluster_id,
+                                                       cluster_legalizer,
+                                                       prepacker);
+        }
+
+        // The gain updates and candidate selection below are profiled as one
+        // phase.
+        gain_timer.emplace(pack_profiler, e_pack_phase::CANDIDATE_GAIN, cluster_type);
 
         // If the candidate molecule was clustered successfully, update
         // the cluster stats.
@@ -307,6 +590,7 @@ LegalizationClusterId GreedyClusterer::try_grow_cluster(PackMoleculeId seed_mol_
             legalization_cluster_id,
             cluster_legalizer,
             attraction_groups);
+        gain_timer.reset();
 
         // If the next candidate molecule is the same as the previous
         // candidate molecule, increment the number of repeated
@@ -340,8 +624,11 @@ LegalizationClusterId GreedyClusterer::try_grow_cluster(PackMoleculeId seed_mol_
 
     // After the cluster has been fully created, update internal structures
     // to improve the gain calculation.
-    candidate_selector.update_candidate_selector_finalize_cluster(cluster_gain_stats,
-                                                                  legalization_cluster_id);
+    {
+        PackPhaseTimer finalize_timer(pack_profiler, e_pack_phase::CANDIDATE_GAIN, cluster_type);
+        candidate_selector.update_candidate_selector_finalize_cluster(cluster_gain_stats,
+                                                                      legalization_cluster_id);
+    }
 
     // Since the cluster will no longer be added to beyond this point,
     // clean the cluster of any data not strictly necessary for
@@ -358,7 +645,8 @@ LegalizationClusterId GreedyClusterer::start_new_cluster(
     const Prepacker& prepacker,
     bool balance_block_type_utilization,
     std::map<t_logical_block_type_ptr, size_t>& num_used_type_instances,
-    DeviceContext& mutable_device_ctx) {
+    DeviceContext& mutable_device_ctx,
+    bool allow_device_resize) {
 
     VTR_ASSERT(seed_mol_id.is_valid());
     const t_pack_molecule& seed_mol = prepacker.get_molecule(seed_mol_id);
@@ -454,6 +742,9 @@ LegalizationClusterId GreedyClusterer::start_new_cluster(
     // Successfully created cluster
     num_used_type_instances[block_type]++;
 
+    if (!allow_device_resize)
+        return new_cluster_id;
+
     /* Expand FPGA size if needed */
     // Check used type instances against the possible equivalent physical locations
     unsigned int num_instances = 0;
@@ -471,6 +762,278 @@ LegalizationClusterId GreedyClusterer::start_new_cluster(
     return new_cluster_id;
 }
 
+void GreedyClusterer::restore_eco_clusters(ClusterLegalizer& cluster_legalizer,
+                                           const Prepacker& prepacker,
+                                           std::map<t_logical_block_type_ptr, size_t>& num_used_type_instances,
+                                           DeviceContext& mutable_device_ctx) {
+    vtr::ScopedStartFinishTimer timer("Restore ECO Clusters");
+
+    // Match the atoms of the previous clusters to the atoms of the netlist
+    // by name.
+    vtr::vector<AtomBlockId, int> atom_eco_cluster(atom_netlist_.blocks().size(), -1);
+    for (size_t icluster = 0; icluster < eco_clusters_.size(); icluster++) {
+        for (const std::string& atom_name : eco_clusters_[icluster].atom_names) {
+            AtomBlockId blk_id = atom_netlist_.find_block(atom_name);
+            if (blk_id.is_valid())
+                atom_eco_cluster[blk_id] = icluster;
+        }
+    }
+
+    // The previous clusters are rebuilt with full legalization, since the
+    // connectivity of their atoms may have changed.
+    cluster_legalizer.set_legalization_strategy(ClusterLegalizationStrategy::FULL);
+
+    size_t num_restored_clusters = 0;
+    size_t num_restored_molecules = 0;
+    size_t num_orphaned_molecules = 0;
+    for (size_t icluster = 0; icluster < eco_clusters_.size(); icluster++) {
+        const t_net_file_cluster& eco_cluster = eco_clusters_[icluster];
+
+        // Find the type and mode of the previous cluster.
+        t_logical_block_type_ptr block_type = nullptr;
+        for (const t_logical_block_type& type : mutable_device_ctx.logical_block_types) {
+            if (type.name == eco_cluster.type_name) {
+                block_type = &type;
+                break;
+            }
+        }
+        if (block_type == nullptr || block_type->pb_type == nullptr) {
+            VTR_LOGV(log_verbosity_ > 2, "Not restoring cluster '%s': unknown block type '%s'\n",
+                     eco_cluster.name.c_str(), eco_cluster.type_name.c_str());
+            continue;
+        }
+        int block_mode = -1;
+        for (int imode = 0; imode < block_type->pb_type->num_modes; imode++) {
+            if (eco_cluster.mode_name == block_type->pb_type->modes[imode].name) {
+                block_mode = imode;
+                break;
+            }
+        }
+        if (block_mode == -1) {
+            VTR_LOGV(log_verbosity_ > 2, "Not restoring cluster '%s': unknown mode '%s'\n",
+                     eco_cluster.name.c_str(), eco_cluster.mode_name.c_str());
+            continue;
+        }
+
+        // Collect the molecules whose atoms were all in the previous cluster.
+        std::vector<PackMoleculeId> cluster_molecules;
+        for (const std::string& atom_name : eco_cluster.atom_names) {
+            AtomBlockId blk_id = atom_netlist_.find_block(atom_name);
+            if (!blk_id.is_valid())
+                continue;
+            PackMoleculeId mol_id = prepacker.get_atom_molecule(blk_id);
+            if (cluster_legalizer.is_mol_clustered(mol_id)
+                || std::find(cluster_molecules.begin(), cluster_molecules.end(), mol_id) != cluster_molecules.end())
+                continue;
+            const t_pack_molecule& mol = prepacker.get_molecule(mol_id);
+            bool is_mol_in_cluster = std::all_of(mol.atom_block_ids.begin(), mol.atom_block_ids.end(), [&](AtomBlockId mol_blk_id) {
+                return !mol_blk_id.is_valid() || atom_eco_cluster[mol_blk_id] == (int)icluster;
+            });
+            if (is_mol_in_cluster)
+                cluster_molecules.push_back(mol_id);
+        }
+
+        // Rebuild the cluster. Its molecules which no longer fit in it are
+        // left to the greedy clustering.
+        LegalizationClusterId cluster_id;
+        size_t imol = 0;
+        for (; imol < cluster_molecules.size() && !cluster_id.is_valid(); imol++) {
+            e_block_pack_status pack_status;
+            std::tie(pack_status, cluster_id) = cluster_legalizer.start_new_cluster(cluster_molecules[imol],
+                                                                                    block_type,
+                                                                                    block_mode);
+        }
+        num_orphaned_molecules += imol - (cluster_id.is_valid() ? 1 : 0);
+        if (!cluster_id.is_valid())
+            continue;
+        for (; imol < cluster_molecules.size(); imol++) {
+            if (cluster_legalizer.add_mol_to_cluster(cluster_molecules[imol], cluster_id) != e_block_pack_status::BLK_PASSED)
+                num_orphaned_molecules++;
+        }
+        cluster_legalizer.clean_cluster(cluster_id);
+
+        num_used_type_instances[block_type]++;
+        num_restored_clusters++;
+        num_restored_molecules += cluster_legalizer.get_num_molecules_in_cluster(cluster_id);
+    }
+
+    // Expand the FPGA size if needed.
+    for (const auto& [block_type, num_used_instances] : num_used_type_instances) {
+        unsigned int num_instances = 0;
+        for (auto equivalent_tile : block_type->equivalent_tiles) {
+            num_instances += mutable_device_ctx.grid.num_instances(equivalent_tile, -1);
+        }
+        if (num_used_instances > num_instances) {
+            mutable_device_ctx.grid = create_device_grid(packer_opts_.device_layout,
+                                                         arch_.grid_layouts,
+                                                         num_used_type_instances,
+                                                         packer_opts_.target_device_utilization);
+            break;
+        }
+    }
+
+    VTR_LOG("Restored %zu of %zu previous clusters (%zu molecules); %zu molecules of the previous clusters no longer fit and %zu molecules are left to recluster\n",
+            num_restored_clusters, eco_clusters_.size(), num_restored_molecules, num_orphaned_molecules,
+            prepacker.molecules().size() - num_restored_molecules);
+}
+
+void GreedyClusterer::cluster_partitions(ClusterLegalizer& cluster_legalizer,
+                                         const Prepacker& prepacker,
+                                         bool allow_unrelated_clustering,
+                                         bool balance_block_type_utilization,
+                                         const t_molecule_stats& max_molecule_stats,
+                                         AttractionInfo& attraction_groups,
+                                         std::map<t_logical_block_type_ptr, size_t>& num_used_type_instances,
+                                         DeviceContext& mutable_device_ctx) {
+    vtr::Timer timer;
+
+    std::vector<std::vector<PackMoleculeId>> partitions = partition_molecules(atom_netlist_,
+                                                                              prepacker,
+                                                                              is_clock_,
+                                                                              is_global_,
+                                                                              appack_ctx_,
+                                                                              cluster_legalizer,
+                                                                              packer_opts_.num_partitions);
+    size_t num_partition_mols = 0;
+    for (const std::vector<PackMoleculeId>& partition : partitions)
+        num_partition_mols += partition.size();
+    size_t num_clustered_mols = 0;
+    for (PackMoleculeId mol_id : prepacker.molecules()) {
+        if (cluster_legalizer.is_mol_clustered(mol_id))
+            num_clustered_mols++;
+    }
+    VTR_LOG("Clustering %zu netlist partitions (%s) in parallel: %zu molecules in partitions, %zu boundary molecules left for serial clustering\n",
+            partitions.size(),
+            appack_ctx_.appack_options.use_appack ? "by flat placement" : "by connectivity",
+            num_partition_mols,
+            prepacker.molecules().size() - num_clustered_mols - num_partition_mols);
+
+    // Freeing the pb of a cluster clears the atom to clb lookup of its atoms.
+    // Make sure the lookup already covers all the atoms, so that concurrent
+    // updates of different atoms do not resize it.
+    if (!atom_netlist_.blocks().empty()) {
+        AtomBlockId last_blk_id = *(atom_netlist_.blocks().end() - 1);
+        g_vpr_ctx.mutable_atom().mutable_lookup().set_atom_clb(last_blk_id, ClusterBlockId::INVALID());
+    }
+
+    // Each partition is clustered with its own legalizer and selectors, which
+    // only see the molecules of the partition.
+    std::vector<std::unique_ptr<ClusterLegalizer>> partition_legalizers(partitions.size());
+    std::vector<std::map<t_logical_block_type_ptr, size_t>> partition_num_used_type_instances(partitions.size());
+    auto cluster_partition = [&](size_t ipart) {
+        partition_legalizers[ipart] = std::make_unique<ClusterLegalizer>(atom_netlist_,
+                                                                         prepacker,
+                                                                         cluster_legalizer.lb_type_rr_graphs(),
+                                                                         packer_opts_.target_external_pin_util,
+                                                                         high_fanout_thresholds_,
+                                                                         ClusterLegalizationStrategy::SKIP_INTRA_LB_ROUTE,
+                                                                         packer_opts_.enable_pin_feasibility_filter,
+                                                                         arch_.models,
+                                                                         log_verbosity_,
+                                                                         cluster_legalizer.noc_router_distance_index());
+        ClusterLegalizer& partition_legalizer = *partition_legalizers[ipart];
+        // The packer may have raised the target pin utilization of some block
+        // types since the options were parsed.
+        for (const t_logical_block_type& block_type : mutable_device_ctx.logical_block_types) {
+            partition_legalizer.get_target_external_pin_util().set_block_pin_util(block_type.name,
+                                                                                  cluster_legalizer.get_target_external_pin_util().get_pin_util(block_type.name));
+        }
+        partition_legalizer.restrict_to_molecules(partitions[ipart]);
+        partition_legalizer.mutable_pack_profiler().set_enabled(cluster_legalizer.pack_profiler().is_enabled());
+
+        GreedyCandidateSelector candidate_selector(atom_netlist_,
+                                                   prepacker,
+                                                   packer_opts_,
+                                                   allow_unrelated_clustering,
+                                                   max_molecule_stats,
+                                                   primitive_candidate_block_types_,
+                                                   high_fanout_thresholds_,
+                                                   is_clock_,
+                                                   is_global_,
+                                                   net_output_feeds_driving_block_input_,
+                                                   pre_cluster_timing_manager_,
+                                                   appack_ctx_,
+                                                   arch_.models,
+                                                   log_verbosity_);
+        GreedySeedSelector seed_selector(atom_netlist_,
+                                         prepacker,
+                                         packer_opts_.cluster_seed_type,
+                                         max_molecule_stats,
+                                         arch_.models,
+                                         pre_cluster_timing_manager_);
+
+        // Same as the serial clustering, except that the device is only
+        // resized once all the partitions are clustered.
+        PackMoleculeId seed_mol_id = get_next_seed(seed_selector, partition_legalizer, partition_legalizer.mutable_pack_profiler());
+        while (seed_mol_id.is_valid()) {
+            LegalizationClusterId new_cluster_id = try_grow_cluster(seed_mol_id,
+                                                                    candidate_selector,
+                                                                    ClusterLegalizationStrategy::SKIP_INTRA_LB_ROUTE,
+                                                                    partition_legalizer,
+                                                                    prepacker,
+                                                                    balance_block_type_utilization,
+                                                                    attraction_groups,
+                                                                    partition_num_used_type_instances[ipart],
+                                                                    mutable_device_ctx,
+                                                                    false);
+            if (!new_cluster_id.is_valid()) {
+                new_cluster_id = try_grow_cluster(seed_mol_id,
+                                                  candidate_selector,
+                                                  ClusterLegalizationStrategy::FULL,
+                                                  partition_legalizer,
+                                                  prepacker,
+                                                  balance_block_type_utilization,
+                                                  attraction_groups,
+                                                  partition_num_used_type_instances[ipart],
+                                                  mutable_device_ctx,
+                                                  false);
+            }
+            VTR_ASSERT(new_cluster_id.is_valid());
+            seed_mol_id = get_next_seed(seed_selector, partition_legalizer, partition_legalizer.mutable_pack_profiler());
+        }
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), partitions.size(), cluster_partition);
+#else
+    for (size_t ipart = 0; ipart < partitions.size(); ipart++) {
+        cluster_partition(ipart);
+    }
+#endif
+
+    // Gather the clusters of all the partitions, in partition order.
+    for (size_t ipart = 0; ipart < partitions.size(); ipart++) {
+        ClusterLegalizer& partition_legalizer = *partition_legalizers[ipart];
+        for (LegalizationClusterId cluster_id : partition_legalizer.clusters()) {
+            cluster_legalizer.adopt_cluster(partition_legalizer, cluster_id);
+        }
+        cluster_legalizer.mutable_intra_lb_route_cache().add_stats(partition_legalizer.intra_lb_route_cache());
+        cluster_legalizer.mutable_pack_profiler().merge(partition_legalizer.pack_profiler());
+        for (const auto& [block_type, num_instances] : partition_num_used_type_instances[ipart]) {
+            num_used_type_instances[block_type] += num_instances;
+        }
+        partition_legalizers[ipart].reset();
+    }
+
+    // Expand the FPGA size if needed.
+    for (const auto& [block_type, num_used_instances] : num_used_type_instances) {
+        unsigned int num_instances = 0;
+        for (auto equivalent_tile : block_type->equivalent_tiles) {
+            num_instances += mutable_device_ctx.grid.num_instances(equivalent_tile, -1);
+        }
+        if (num_used_instances > num_instances) {
+            mutable_device_ctx.grid = create_device_grid(packer_opts_.device_layout,
+                                                         arch_.grid_layouts,
+                                                         num_used_type_instances,
+                                                         packer_opts_.target_device_utilization);
+            break;
+        }
+    }
+
+    VTR_LOG("Clustered the netlist partitions into %zu clusters in %g seconds\n",
+            cluster_legalizer.clusters().size(), timer.elapsed_sec());
+}
+
 bool GreedyClusterer::try_add_candidate_mol_to_cluster(PackMoleculeId candidate_mol_id,
                                                        LegalizationClusterId legalization_cluster_id,
                                                        ClusterLegalizer& cluster_legalizer,
@@ -14,6 +14,7 @@
 #include "logic_types.h"
 #include "physical_types.h"
 #include "prepack.h"
+#include "read_netlist.h"
 #include "vtr_vector.h"
 
 // Forward declarations
@@ -158,6 +159,8 @@ class GreedyClusterer {
      * If the strategy is set to FULL, the cluster will grow using the full
      * legalizer for each molecule added. This cannot fail (assuming the seed
      * can exist in a cluster), so it will always return a valid cluster ID.
+     *
+     * allow_device_resize is passed to start_new_cluster.
      */
     LegalizationClusterId try_grow_cluster(PackMoleculeId seed_mol_id,
                                            GreedyCandidateSelector& candidate_selector,
@@ -167,7 +170,8 @@ class GreedyClusterer {
                                            bool balance_block_type_utilization,
                                            AttractionInfo& attraction_groups,
                                            std::map<t_logical_block_type_ptr, size_t>& num_used_type_instances,
-                                           DeviceContext& mutable_device_ctx);
+                                           DeviceContext& mutable_device_ctx,
+                                           bool allow_device_resize);
 
     /**
      * @brief Given a seed molecule, starts a new cluster by trying to find a
@@ -179,16 +183,56 @@ class GreedyClusterer {
      * to select less used logical block types if it has the option to in order
      * to balance logical block type utilization.
      *
-     * If the device is to be auto-sized, this method will try to grow the
-     * device grid if it find thats more clusters of specific logical block
-     * types have been created than the device can support.
+     * If the device is to be auto-sized and allow_device_resize is true, this
+     * method will try to grow the device grid if it find thats more clusters
+     * of specific logical block types have been created than the device can
+     * support. The clustering of the netlist partitions must not resize the
+     * shared device, so it resizes it once at the end instead.
      */
     LegalizationClusterId start_new_cluster(PackMoleculeId seed_mol_id,
                                             ClusterLegalizer& cluster_legalizer,
                                             const Prepacker& prepacker,
                                             bool balance_block_type_utilization,
                                             std::map<t_logical_block_type_ptr, size_t>& num_used_type_instances,
-                                            DeviceContext& mutable_device_ctx);
+                                            DeviceContext& mutable_device_ctx,
+                                            bool allow_device_resize);
+
+    /**
+     * @brief Partitions the netlist (see packer_opts.num_partitions) and
+     *        clusters each partition in parallel, with its own legalizer.
+     *
+     * The clusters of all the partitions are then moved to cluster_legalizer,
+     * and num_used_type_instances is updated. The molecules on the boundary
+     * of the partitions are left unclustered: the serial clustering which
+     * follows clusters them. Balancing of the block type utilization is only
+     * done within each partition.
+     */
+    void cluster_partitions(ClusterLegalizer& cluster_legalizer,
+                            const Prepacker& prepacker,
+                            bool allow_unrelated_clustering,
+                            bool balance_block_type_utilization,
+                            const t_molecule_stats& max_molecule_stats,
+                            AttractionInfo& attraction_groups,
+                            std::map<t_logical_block_type_ptr, size_t>& num_used_type_instances,
+                            DeviceContext& mutable_device_ctx);
+
+    /**
+     * @brief Rebuilds the clusters of the previous packing of the netlist (see
+     *        packer_opts.eco_net_file) before the greedy clustering.
+     *
+     * The atoms are matched by name. Each previous cluster is rebuilt, in the
+     * same logical block type and mode, from the molecules whose atoms were
+     * all in it; the molecules are legalized with full intra-lb routing, so
+     * a molecule which no longer fits (e.g. its connectivity changed) is left
+     * unclustered, as are the molecules of new or changed logic. The greedy
+     * clustering which follows clusters them.
+     *
+     * num_used_type_instances is updated and the device grown if needed.
+     */
+    void restore_eco_clusters(ClusterLegalizer& cluster_legalizer,
+                              const Prepacker& prepacker,
+                              std::map<t_logical_block_type_ptr, size_t>& num_used_type_instances,
+                              DeviceContext& mutable_device_ctx);
 
     /**
      * @brief Try to add the given candidate molecule to the given cluster.
@@ -247,6 +291,10 @@ class GreedyClusterer {
     ///        and propose better candidates based on a flat placement.
     const APPackContext& appack_ctx_;
 
+    /// @brief The clusters of the previous packing to reuse (ECO packing),
+    ///        read from packer_opts.eco_net_file. Empty if there is none.
+    const std::vector<t_net_file_cluster> eco_clusters_;
+
     /// @brief Pre-computed logical block types for each model in the architecture.
     const vtr::vector<LogicalModelId, std::vector<t_logical_block_type_ptr>> primitive_candidate_block_types_;
 
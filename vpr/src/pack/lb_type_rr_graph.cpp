@@ -18,8 +18,10 @@
  * Date: July 22, 2013
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <unordered_map>
 #include <vector>
 #include <cmath>
 
@@ -33,6 +35,18 @@
 #include "pack_types.h"
 #include "lb_type_rr_graph.h"
 
+/* Contiguous storage of the per-mode fanouts and edges of all the nodes of an lb_type_rr_node graph.
+ * The num_fanout and outedges arrays of the nodes point into it, in node order, so the intra-lb
+ * router walks a few dense arrays instead of three separate allocations per node. */
+struct t_lb_type_rr_graph_storage {
+    std::vector<short> num_fanout;
+    std::vector<t_lb_type_rr_node_edge*> outedges;
+    std::vector<t_lb_type_rr_node_edge> edges;
+};
+
+/* Storage of the graphs of each logic block type, by graph array returned by alloc_and_load_all_lb_type_rr_graph() */
+static std::unordered_map<const std::vector<t_lb_type_rr_node>*, std::vector<t_lb_type_rr_graph_storage>> lb_type_rr_graphs_storage;
+
 /*****************************************************************************************
  * Internal functions declarations
  ******************************************************************************************/
@@ -41,6 +55,8 @@ static void alloc_and_load_lb_type_rr_graph_for_type(const t_logical_block_type_
 static void alloc_and_load_lb_type_rr_graph_for_pb_graph_node(const t_pb_graph_node* pb_graph_node,
                                                               std::vector<t_lb_type_rr_node>& lb_type_rr_node_graph,
                                                               const int ext_rr_index);
+static void compact_lb_type_rr_graph(std::vector<t_lb_type_rr_node>& lb_type_rr_node_graph,
+                                     t_lb_type_rr_graph_storage& storage);
 static float get_cost_of_pb_edge(t_pb_graph_edge* edge);
 static void print_lb_type_rr_graph(FILE* fp, const std::vector<t_lb_type_rr_node>& lb_type_rr_graph);
 
@@ -55,6 +71,8 @@ std::vector<t_lb_type_rr_node>* alloc_and_load_all_lb_type_rr_graph() {
     auto& device_ctx = g_vpr_ctx.device();
 
     lb_type_rr_graphs = new std::vector<t_lb_type_rr_node>[device_ctx.logical_block_types.size()];
+    std::vector<t_lb_type_rr_graph_storage>& storage = lb_type_rr_graphs_storage[lb_type_rr_graphs];
+    storage.resize(device_ctx.logical_block_types.size());
 
     for (const auto& type : device_ctx.logical_block_types) {
         int itype = type.index;
@@ -64,6 +82,8 @@ std::vector<t_lb_type_rr_node>* alloc_and_load_all_lb_type_rr_graph() {
             /* Now that the data is loaded, reallocate to the precise amount of memory needed to prevent insidious bugs */
             /* I should be using shrinktofit() but as of 2013, C++ 11 is yet not well supported so I can't call this function in gcc */
             std::vector<t_lb_type_rr_node>(lb_type_rr_graphs[itype]).swap(lb_type_rr_graphs[itype]);
+
+            compact_lb_type_rr_graph(lb_type_rr_graphs[itype], storage[itype]);
         }
     }
     return lb_type_rr_graphs;
@@ -75,28 +95,8 @@ void free_all_lb_type_rr_graph(std::vector<t_lb_type_rr_node>* lb_type_rr_graphs
         return;
     }
 
-    auto& device_ctx = g_vpr_ctx.device();
-
-    for (const auto& type : device_ctx.logical_block_types) {
-        int itype = type.index;
-        if (!is_empty_type(&type)) {
-            int graph_size = lb_type_rr_graphs[itype].size();
-            for (int inode = 0; inode < graph_size; inode++) {
-                t_lb_type_rr_node* node = &lb_type_rr_graphs[itype][inode];
-                if (node->outedges != nullptr) {
-                    for (int imode = 0; imode < node->num_modes; imode++) {
-                        if (node->outedges[imode] != nullptr) {
-                            delete[] node->outedges[imode];
-                        }
-                    }
-                    delete[] node->outedges;
-                }
-                if (node->num_fanout != nullptr) {
-                    delete[] node->num_fanout;
-                }
-            }
-        }
-    }
+    /* The fanouts and edges of the nodes live in the storage of the graphs (see compact_lb_type_rr_graph) */
+    lb_type_rr_graphs_storage.erase(lb_type_rr_graphs);
     delete[] lb_type_rr_graphs;
 }
 
@@ -114,7 +114,7 @@ int get_lb_type_rr_graph_ext_sink_index(t_logical_block_type_ptr lb_type) {
     return lb_type->pb_graph_head->total_pb_pins + 1;
 }
 
-int get_lb_type_rr_graph_edge_mode(std::vector<t_lb_type_rr_node>& lb_type_rr_graph, int src_index, int dst_index) {
+int get_lb_type_rr_graph_edge_mode(const std::vector<t_lb_type_rr_node>& lb_type_rr_graph, int src_index, int dst_index) {
     auto& src = lb_type_rr_graph[src_index];
     for (int imode = 0; imode < src.num_modes; imode++) {
         for (int iedge = 0; iedge < src.num_fanout[imode]; iedge++) {
@@ -632,6 +632,66 @@ static void alloc_and_load_lb_type_rr_graph_for_pb_graph_node(const t_pb_graph_n
     }
 }
 
+/* Move the per-mode fanouts and edges of all the nodes of a graph, built node by node, into one
+ * contiguous storage (in node order) and point the nodes into it */
+static void compact_lb_type_rr_graph(std::vector<t_lb_type_rr_node>& lb_type_rr_node_graph,
+                                     t_lb_type_rr_graph_storage& storage) {
+    /* Sinks have a fanout array (of one, zero entry) but may have no modes */
+    auto num_fanout_entries = [](const t_lb_type_rr_node& node) {
+        return node.num_fanout == nullptr ? 0 : std::max(node.num_modes, 1);
+    };
+
+    size_t total_fanout_entries = 0;
+    size_t total_outedges_entries = 0;
+    size_t total_edges = 0;
+    for (const t_lb_type_rr_node& node : lb_type_rr_node_graph) {
+        total_fanout_entries += num_fanout_entries(node);
+        if (node.outedges != nullptr) {
+            total_outedges_entries += node.num_modes;
+            for (int imode = 0; imode < node.num_modes; imode++) {
+                if (node.outedges[imode] != nullptr)
+                    total_edges += node.num_fanout[imode];
+            }
+        }
+    }
+
+    /* Sized once so that the pointers into the storage remain valid */
+    storage.num_fanout.resize(total_fanout_entries);
+    storage.outedges.resize(total_outedges_entries);
+    storage.edges.resize(total_edges);
+
+    size_t ifanout = 0;
+    size_t ioutedges = 0;
+    size_t iedge = 0;
+    for (t_lb_type_rr_node& node : lb_type_rr_node_graph) {
+        if (node.outedges != nullptr) {
+            t_lb_type_rr_node_edge** outedges = storage.outedges.data() + ioutedges;
+            for (int imode = 0; imode < node.num_modes; imode++) {
+                outedges[imode] = nullptr;
+                if (node.outedges[imode] != nullptr) {
+                    outedges[imode] = storage.edges.data() + iedge;
+                    std::copy(node.outedges[imode], node.outedges[imode] + node.num_fanout[imode], outedges[imode]);
+                    iedge += node.num_fanout[imode];
+                    delete[] node.outedges[imode];
+                }
+            }
+            ioutedges += node.num_modes;
+            delete[] node.outedges;
+            node.outedges = outedges;
+        }
+
+        if (node.num_fanout != nullptr) {
+            int num_entries = num_fanout_entries(node);
+            short* num_fanout = storage.num_fanout.data() + ifanout;
+            std::copy(node.num_fanout, node.num_fanout + num_entries, num_fanout);
+            delete[] node.num_fanout;
+            node.num_fanout = num_fanout;
+            ifanout += num_entries;
+        }
+    }
+    VTR_ASSERT(ifanout == total_fanout_entries && ioutedges == total_outedges_entries && iedge == total_edges);
+}
+
 /* Determine intrinsic cost of an edge that joins two pb_graph_pins */
 static float get_cost_of_pb_edge(t_pb_graph_edge* /*edge*/) {
     return 1;
@@ -26,74 +26,113 @@ std::vector<AtomBlockId> find_noc_router_atoms(const AtomNetlist& atom_netlist,
     return noc_router_atoms;
 }
 
-void update_noc_reachability_partitions(const std::vector<AtomBlockId>& noc_atoms,
-                                        const AtomNetlist& atom_netlist,
-                                        const t_pack_high_fanout_thresholds& high_fanout_thresholds,
-                                        vtr::vector<AtomBlockId, NocGroupId>& atom_noc_grp_id) {
+size_t get_noc_group_high_fanout_threshold(const t_pack_high_fanout_thresholds& high_fanout_thresholds) {
     const auto& grid = g_vpr_ctx.device().grid;
 
     t_logical_block_type_ptr logic_block_type = infer_logic_block_type(grid);
     const char* logical_block_name = logic_block_type != nullptr ? logic_block_type->name.c_str() : "";
-    const size_t high_fanout_threshold = high_fanout_thresholds.get_threshold(logical_block_name);
+    return high_fanout_thresholds.get_threshold(logical_block_name);
+}
 
+NocRouterDistanceIndex::NocRouterDistanceIndex(const std::vector<AtomBlockId>& noc_atoms,
+                                               const AtomNetlist& atom_netlist,
+                                               size_t high_fanout_threshold) {
     // get the total number of atoms
     const size_t n_atoms = atom_netlist.blocks().size();
 
-    vtr::vector<AtomBlockId, bool> atom_visited(n_atoms, false);
-
-    atom_noc_grp_id.resize(n_atoms, NocGroupId::INVALID());
-
-    int noc_grp_id_cnt = 0;
+    atom_noc_grp_id_.resize(n_atoms, NocGroupId::INVALID());
+    closest_router_.resize(n_atoms, AtomBlockId::INVALID());
+    distance_.resize(n_atoms, UNREACHABLE);
 
     /*
      * Assume that the atom netlist is represented as an undirected graph
      * with all high fanout nets removed. In this graph, we want to find all
      * connected components that include at least one NoC router. We start a
-     * BFS from each NoC router and traverse all nets below the high_fanout_threshold,
-     * and mark each atom block with a NoC group ID.
+     * single BFS from all the NoC routers at once and traverse all nets below
+     * the high_fanout_threshold. Each atom block is reached first from its
+     * closest NoC router. When the searches started from two NoC routers meet,
+     * both routers are in the same connected component, so their groups are
+     * merged (with a union-find over the NoC routers).
      */
 
-    for (auto noc_atom_id : noc_atoms) {
-        // check if this NoC router has already been visited
-        if (atom_visited[noc_atom_id]) {
-            continue;
+    // the union-find parent of each NoC router, indexed like noc_atoms
+    std::vector<size_t> parent(noc_atoms.size());
+    vtr::vector<AtomBlockId, int> router_index(n_atoms, -1);
+    auto find_root = [&parent](size_t index) {
+        while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
         }
+        return index;
+    };
+
+    std::queue<AtomBlockId> q;
+    for (size_t i = 0; i < noc_atoms.size(); i++) {
+        AtomBlockId noc_atom_id = noc_atoms[i];
+        parent[i] = i;
+        router_index[noc_atom_id] = (int)i;
+        closest_router_[noc_atom_id] = noc_atom_id;
+        distance_[noc_atom_id] = 0;
+        q.push(noc_atom_id);
+    }
+
+    // visits an atom block adjacent to current_atom through a low fanout net
+    auto visit_neighbor = [&](AtomBlockId current_atom, AtomBlockId neighbor_atom) {
+        AtomBlockId current_router = closest_router_[current_atom];
+        AtomBlockId neighbor_router = closest_router_[neighbor_atom];
+        if (!neighbor_router.is_valid()) {
+            closest_router_[neighbor_atom] = current_router;
+            distance_[neighbor_atom] = distance_[current_atom] + 1;
+            q.push(neighbor_atom);
+        } else if (neighbor_router != current_router) {
+            parent[find_root(router_index[neighbor_router])] = find_root(router_index[current_router]);
+        }
+    };
 
-        auto noc_grp_id = (NocGroupId)noc_grp_id_cnt;
-        noc_grp_id_cnt++;
+    while (!q.empty()) {
+        AtomBlockId current_atom = q.front();
+        q.pop();
 
-        std::queue<AtomBlockId> q;
-        q.push(noc_atom_id);
-        atom_visited[noc_atom_id] = true;
-
-        while (!q.empty()) {
-            AtomBlockId current_atom = q.front();
-            q.pop();
-
-            atom_noc_grp_id[current_atom] = noc_grp_id;
-
-            for (auto pin : atom_netlist.block_pins(current_atom)) {
-                AtomNetId net_id = atom_netlist.pin_net(pin);
-                size_t net_fanout = atom_netlist.net_sinks(net_id).size();
-
-                if (net_fanout >= high_fanout_threshold) {
-                    continue;
-                }
-
-                AtomBlockId driver_atom_id = atom_netlist.net_driver_block(net_id);
-                if (!atom_visited[driver_atom_id]) {
-                    q.push(driver_atom_id);
-                    atom_visited[driver_atom_id] = true;
-                }
-
-                for (auto sink_pin : atom_netlist.net_sinks(net_id)) {
-                    AtomBlockId sink_atom_id = atom_netlist.pin_block(sink_pin);
-                    if (!atom_visited[sink_atom_id]) {
-                        q.push(sink_atom_id);
-                        atom_visited[sink_atom_id] = true;
-                    }
-                }
+        for (auto pin : atom_netlist.block_pins(current_atom)) {
+            AtomNetId net_id = atom_netlist.pin_net(pin);
+            size_t net_fanout = atom_netlist.net_sinks(net_id).size();
+
+            if (net_fanout >= high_fanout_threshold) {
+                continue;
             }
+
+            visit_neighbor(current_atom, atom_netlist.net_driver_block(net_id));
+
+            for (auto sink_pin : atom_netlist.net_sinks(net_id)) {
+                visit_neighbor(current_atom, atom_netlist.pin_block(sink_pin));
+            }
+        }
+    }
+
+    // number the NoC groups in the order of their first NoC router
+    std::vector<NocGroupId> root_noc_grp_id(noc_atoms.size(), NocGroupId::INVALID());
+    for (size_t i = 0; i < noc_atoms.size(); i++) {
+        size_t root = find_root(i);
+        if (!root_noc_grp_id[root].is_valid()) {
+            root_noc_grp_id[root] = (NocGroupId)num_noc_groups_;
+            num_noc_groups_++;
+        }
+    }
+
+    for (auto atom_id : atom_netlist.blocks()) {
+        AtomBlockId closest_router = closest_router_[atom_id];
+        if (closest_router.is_valid()) {
+            atom_noc_grp_id_[atom_id] = root_noc_grp_id[find_root(router_index[closest_router])];
         }
     }
 }
+
+void update_noc_reachability_partitions(const std::vector<AtomBlockId>& noc_atoms,
+                                        const AtomNetlist& atom_netlist,
+                                        const t_pack_high_fanout_thresholds& high_fanout_thresholds,
+                                        vtr::vector<AtomBlockId, NocGroupId>& atom_noc_grp_id) {
+    NocRouterDistanceIndex noc_distance_index(noc_atoms,
+                                              atom_netlist,
+                                              get_noc_group_high_fanout_threshold(high_fanout_thresholds));
+    atom_noc_grp_id = noc_distance_index.atom_noc_groups();
+}
@@ -10,19 +10,76 @@
  * being packed with each other, and helps with more localized placement of NoC-attached
  * modules around their corresponding NoC routers.
  *
+ * The NoC groups are found with a single multi-source BFS from all the NoC
+ * routers, which also records the distance (in low fanout nets) from each atom
+ * block to its closest NoC router. The result is stored in a
+ * NocRouterDistanceIndex that can be shared by all the users of the same atom
+ * netlist (e.g. the cluster legalizers created during packing and AP), instead
+ * of traversing the netlist again for each of them.
+ *
  * For more details refer to the following paper:
  * The Road Less Traveled: Congestion-Aware NoC Placement and Packet Routing for FPGAs
  */
 
 #include <vector>
+#include "atom_netlist_fwd.h"
 #include "noc_data_types.h"
 #include "vtr_vector.h"
 
 class AtomNetlist;
-class AtomBlockId;
 class LogicalModels;
 class t_pack_high_fanout_thresholds;
 
+/**
+ * @brief The NoC group of each atom block, and its distance to the closest
+ *        NoC router, found by a multi-source BFS over the low fanout nets of
+ *        the atom netlist.
+ */
+class NocRouterDistanceIndex {
+  public:
+    /// @brief The distance of the atom blocks that cannot reach a NoC router.
+    static constexpr int UNREACHABLE = -1;
+
+    /**
+     * @brief Runs the BFS from all the given NoC router atoms at once.
+     *
+     *  @param noc_atoms                The atom block IDs of the NoC router
+     *                                  blocks in the netlist.
+     *  @param atom_netlist             The netlist to traverse.
+     *  @param high_fanout_threshold    Nets with at least this many sinks are
+     *                                  not traversed.
+     */
+    NocRouterDistanceIndex(const std::vector<AtomBlockId>& noc_atoms,
+                           const AtomNetlist& atom_netlist,
+                           size_t high_fanout_threshold);
+
+    /**
+     * @brief The NoC group of each atom block. Atom blocks that cannot reach
+     *        a NoC router have an invalid NoC group.
+     */
+    inline const vtr::vector<AtomBlockId, NocGroupId>& atom_noc_groups() const { return atom_noc_grp_id_; }
+
+    /// @brief The NoC group of the given atom block.
+    inline NocGroupId atom_noc_group(AtomBlockId atom_blk_id) const { return atom_noc_grp_id_[atom_blk_id]; }
+
+    /// @brief The NoC router atom closest to the given atom block, or an
+    ///        invalid ID if it cannot reach a NoC router.
+    inline AtomBlockId closest_noc_router(AtomBlockId atom_blk_id) const { return closest_router_[atom_blk_id]; }
+
+    /// @brief The number of low fanout nets between the given atom block and
+    ///        its closest NoC router, or UNREACHABLE.
+    inline int distance_to_noc_router(AtomBlockId atom_blk_id) const { return distance_[atom_blk_id]; }
+
+    /// @brief The number of NoC groups.
+    inline size_t num_noc_groups() const { return num_noc_groups_; }
+
+  private:
+    vtr::vector<AtomBlockId, NocGroupId> atom_noc_grp_id_;
+    vtr::vector<AtomBlockId, AtomBlockId> closest_router_;
+    vtr::vector<AtomBlockId, int> distance_;
+    size_t num_noc_groups_ = 0;
+};
+
 /**
  * @brief Iterates over all atom blocks and check whether
  * their blif model is the same as a NoC routers.
@@ -31,12 +88,22 @@ class t_pack_high_fanout_thresholds;
  */
 std::vector<AtomBlockId> find_noc_router_atoms(const AtomNetlist& atom_netlist, const LogicalModels& models);
 
+/**
+ * @brief Returns the fanout at which a net is considered high fanout when
+ * finding the NoC groups, i.e. the high fanout threshold of the logic block
+ * type of the device.
+ */
+size_t get_noc_group_high_fanout_threshold(const t_pack_high_fanout_thresholds& high_fanout_thresholds);
+
 /**
  * @brief Runs BFS starting from NoC routers to find all connected
  * components that include a NoC router. Each connected component
  * containing a NoC router is marked as a NoC group. The NoC group ID
  * for each atom block is updated in the global state.
  *
+ * Prefer building a NocRouterDistanceIndex once and sharing it when the
+ * NoC groups are needed more than once.
+ *
  * @param noc_atoms The atom block IDs of the NoC router blocks in the netlist.
  */
 void update_noc_reachability_partitions(const std::vector<AtomBlockId>& noc_atoms,
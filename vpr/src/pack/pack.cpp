@@ -17,6 +17,7 @@
 #include "stats.h"
 #include "verify_flat_placement.h"
 #include "vpr_context.h"
+#include "vtr_profile.h"
 #include "vpr_error.h"
 #include "vpr_types.h"
 #include "vtr_assert.h"
@@ -322,6 +323,7 @@ bool try_pack(const t_packer_opts& packer_opts,
                                        packer_opts.enable_pin_feasibility_filter,
                                        arch.models,
                                        packer_opts.pack_verbosity);
+    cluster_legalizer.mutable_pack_profiler().set_enabled(packer_opts.profile);
 
     // Construct the APPack Context.
     APPackContext appack_ctx(flat_placement_info,
@@ -346,6 +348,8 @@ bool try_pack(const t_packer_opts& packer_opts,
     e_packer_state current_packer_state = e_packer_state::DEFAULT;
 
     while (current_packer_state != e_packer_state::SUCCESS && current_packer_state != e_packer_state::FAILURE) {
+        VTR_PROFILE_ZONE("Packing attempt");
+
         VTR_LOG("Packing with pin utilization targets: %s\n", cluster_legalizer.get_target_external_pin_util().to_string().c_str());
         VTR_LOG("Packing with high fanout thresholds: %s\n", high_fanout_thresholds.to_string().c_str());
         //Cluster the netlist
@@ -0,0 +1,96 @@
+/**
+ * @file
+ * @brief Implementation of the PackProfiler.
+ */
+
+#include "pack_profiler.h"
+
+#include "cluster_legalizer.h"
+#include "vtr_log.h"
+
+static_assert(size_t(e_block_pack_status::BLK_STATUS_UNDEFINED) + 1 == 6,
+              "PackProfiler::NUM_PACK_STATUSES must match e_block_pack_status");
+
+PackProfiler::TypeStats& PackProfiler::get_type_stats(t_logical_block_type_ptr type) {
+    size_t itype = (type == nullptr) ? 0 : type->index + 1;
+    if (itype >= type_stats_.size())
+        type_stats_.resize(itype + 1);
+    return type_stats_[itype];
+}
+
+void PackProfiler::add_phase_time(e_pack_phase phase, t_logical_block_type_ptr type, double sec) {
+    get_type_stats(type).phase_sec[size_t(phase)] += sec;
+}
+
+void PackProfiler::add_pack_attempt(t_logical_block_type_ptr type, e_block_pack_status status) {
+    if (enabled_)
+        get_type_stats(type).num_pack_attempts[size_t(status)]++;
+}
+
+void PackProfiler::merge(const PackProfiler& other) {
+    if (other.type_stats_.size() > type_stats_.size())
+        type_stats_.resize(other.type_stats_.size());
+    for (size_t itype = 0; itype < other.type_stats_.size(); itype++) {
+        for (size_t iphase = 0; iphase < NUM_PHASES; iphase++)
+            type_stats_[itype].phase_sec[iphase] += other.type_stats_[itype].phase_sec[iphase];
+        for (size_t istatus = 0; istatus < NUM_PACK_STATUSES; istatus++)
+            type_stats_[itype].num_pack_attempts[istatus] += other.type_stats_[itype].num_pack_attempts[istatus];
+    }
+}
+
+void PackProfiler::print_report(const std::vector<t_logical_block_type>& logical_block_types) const {
+    if (!enabled_)
+        return;
+
+    VTR_LOG("\n");
+    VTR_LOG("Packing profile:\n");
+    VTR_LOG("%-20s %10s %10s %10s %10s | %8s %8s %8s %8s %8s\n",
+            "Block Type", "Seed (s)", "Gain (s)", "Filter (s)", "Route (s)",
+            "Packed", "Feasible", "Route", "Floorpl.", "NoC");
+    VTR_LOG("%-20s %10s %10s %10s %10s | %8s %8s %8s %8s %8s\n",
+            "", "", "", "", "", "", "Fail", "Fail", "Fail", "Fail");
+
+    TypeStats total;
+    for (size_t itype = 0; itype < type_stats_.size(); itype++) {
+        const TypeStats& stats = type_stats_[itype];
+
+        size_t num_attempts = 0;
+        double sec = 0.;
+        for (size_t istatus = 0; istatus < NUM_PACK_STATUSES; istatus++) {
+            num_attempts += stats.num_pack_attempts[istatus];
+            total.num_pack_attempts[istatus] += stats.num_pack_attempts[istatus];
+        }
+        for (size_t iphase = 0; iphase < NUM_PHASES; iphase++) {
+            sec += stats.phase_sec[iphase];
+            total.phase_sec[iphase] += stats.phase_sec[iphase];
+        }
+        if (num_attempts == 0 && sec == 0.)
+            continue;
+
+        const char* type_name = (itype == 0) ? "<none>" : logical_block_types[itype - 1].name.c_str();
+        VTR_LOG("%-20s %10.3f %10.3f %10.3f %10.3f | %8zu %8zu %8zu %8zu %8zu\n",
+                type_name,
+                stats.phase_sec[size_t(e_pack_phase::SEED_SELECTION)],
+                stats.phase_sec[size_t(e_pack_phase::CANDIDATE_GAIN)],
+                stats.phase_sec[size_t(e_pack_phase::FEASIBILITY_FILTER)],
+                stats.phase_sec[size_t(e_pack_phase::INTRA_LB_ROUTING)],
+                stats.num_pack_attempts[size_t(e_block_pack_status::BLK_PASSED)],
+                stats.num_pack_attempts[size_t(e_block_pack_status::BLK_FAILED_FEASIBLE)],
+                stats.num_pack_attempts[size_t(e_block_pack_status::BLK_FAILED_ROUTE)],
+                stats.num_pack_attempts[size_t(e_block_pack_status::BLK_FAILED_FLOORPLANNING)],
+                stats.num_pack_attempts[size_t(e_block_pack_status::BLK_FAILED_NOC_GROUP)]);
+    }
+
+    VTR_LOG("%-20s %10.3f %10.3f %10.3f %10.3f | %8zu %8zu %8zu %8zu %8zu\n",
+            "Total",
+            total.phase_sec[size_t(e_pack_phase::SEED_SELECTION)],
+            total.phase_sec[size_t(e_pack_phase::CANDIDATE_GAIN)],
+            total.phase_sec[size_t(e_pack_phase::FEASIBILITY_FILTER)],
+            total.phase_sec[size_t(e_pack_phase::INTRA_LB_ROUTING)],
+            total.num_pack_attempts[size_t(e_block_pack_status::BLK_PASSED)],
+            total.num_pack_attempts[size_t(e_block_pack_status::BLK_FAILED_FEASIBLE)],
+            total.num_pack_attempts[size_t(e_block_pack_status::BLK_FAILED_ROUTE)],
+            total.num_pack_attempts[size_t(e_block_pack_status::BLK_FAILED_FLOORPLANNING)],
+            total.num_pack_attempts[size_t(e_block_pack_status::BLK_FAILED_NOC_GROUP)]);
+    VTR_LOG("\n");
+}
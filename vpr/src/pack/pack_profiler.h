@@ -0,0 +1,102 @@
+#pragma once
+/**
+ * @file
+ * @brief Profiling of the clustering: the time spent in its main phases and
+ *        the outcome of the attempts to pack molecules into clusters, broken
+ *        down by logical block type (see --pack_profile).
+ *
+ * The cluster legalizer owns a PackProfiler. The legalizer times the pin
+ * feasibility filter and the intra-lb routing of its clusters, and counts the
+ * attempts to pack molecules into them; the greedy clusterer times the seed
+ * selection and the candidate gain updates. The report is printed at the end
+ * of each packing iteration.
+ */
+
+#include <array>
+#include <chrono>
+#include <vector>
+#include "physical_types.h"
+
+enum class e_block_pack_status;
+
+/// @brief The phases of the clustering timed by the PackProfiler.
+enum class e_pack_phase {
+    SEED_SELECTION,     ///< Picking the seed molecule of the next cluster
+    CANDIDATE_GAIN,     ///< Updating the gains of, and selecting, the candidate molecules of a cluster
+    FEASIBILITY_FILTER, ///< Pin feasibility filter of the cluster legalizer
+    INTRA_LB_ROUTING,   ///< Intra-logic block routing of the cluster legalizer
+    NUM_PHASES
+};
+
+class PackProfiler {
+  public:
+    /// @brief Profiling is off (and costs nothing) until enabled.
+    void set_enabled(bool enabled) { enabled_ = enabled; }
+    bool is_enabled() const { return enabled_; }
+
+    /// @brief Clears the statistics gathered so far.
+    void reset() { type_stats_.clear(); }
+
+    /**
+     * @brief Adds time to a phase of the clustering of the given logical block
+     *        type (nullptr for phases which do not belong to a cluster yet,
+     *        like seed selection).
+     */
+    void add_phase_time(e_pack_phase phase, t_logical_block_type_ptr type, double sec);
+
+    /// @brief Counts an attempt to pack a molecule into a cluster of the given type.
+    void add_pack_attempt(t_logical_block_type_ptr type, e_block_pack_status status);
+
+    /// @brief Adds the statistics of other (e.g. another legalizer) to these ones.
+    void merge(const PackProfiler& other);
+
+    /// @brief Logs the statistics as a table with one row per logical block type used.
+    void print_report(const std::vector<t_logical_block_type>& logical_block_types) const;
+
+  private:
+    static constexpr size_t NUM_PHASES = size_t(e_pack_phase::NUM_PHASES);
+    static constexpr size_t NUM_PACK_STATUSES = 6;
+
+    struct TypeStats {
+        std::array<double, NUM_PHASES> phase_sec = {};
+        std::array<size_t, NUM_PACK_STATUSES> num_pack_attempts = {};
+    };
+
+    TypeStats& get_type_stats(t_logical_block_type_ptr type);
+
+    /// @brief Statistics of each logical block type, by type index + 1 (0 for no type).
+    std::vector<TypeStats> type_stats_;
+
+    bool enabled_ = false;
+};
+
+/**
+ * @brief Adds the time spent in its scope to a phase of a PackProfiler (does
+ *        not even read the clock if the profiler is disabled).
+ */
+class PackPhaseTimer {
+  public:
+    PackPhaseTimer(PackProfiler& profiler, e_pack_phase phase, t_logical_block_type_ptr type)
+        : profiler_(profiler)
+        , phase_(phase)
+        , type_(type) {
+        if (profiler_.is_enabled())
+            start_ = std::chrono::steady_clock::now();
+    }
+
+    ~PackPhaseTimer() {
+        if (profiler_.is_enabled()) {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+            profiler_.add_phase_time(phase_, type_, elapsed.count());
+        }
+    }
+
+    PackPhaseTimer(const PackPhaseTimer&) = delete;
+    PackPhaseTimer& operator=(const PackPhaseTimer&) = delete;
+
+  private:
+    PackProfiler& profiler_;
+    e_pack_phase phase_;
+    t_logical_block_type_ptr type_;
+    std::chrono::steady_clock::time_point start_;
+};
@@ -12,6 +12,7 @@
 #include "atom_netlist_fwd.h"
 #include "physical_types.h"
 #include "vpr_types.h"
+#include "vtr_hash.h"
 
 class t_pack_molecule;
 
@@ -158,7 +159,7 @@ struct t_expansion_node {
 
 class compare_expansion_node {
   public:
-    bool operator()(t_expansion_node& e1, t_expansion_node& e2) // Returns true if t1 is earlier than t2
+    bool operator()(const t_expansion_node& e1, const t_expansion_node& e2) const // Returns true if t1 is earlier than t2
     {
         if (e1.cost > e2.cost) {
             return true;
@@ -184,10 +185,93 @@ struct t_explored_node_tb {
     }
 };
 
+/**
+ * @brief Memoizes the outcome of the intra-logic block router (try_intra_lb_route).
+ *
+ * The clusterer routes the same cluster contents over and over: when a cluster is regrown with full
+ * legalization after its final route failed, when a candidate molecule is retried, and in every
+ * iteration of the packer. The result of the router only depends on the logic block type, the
+ * terminals of each intra-lb net (in order) and the modes selected on the lb rr nodes, so these form
+ * the signature of a routing problem (see get_intra_lb_route_signature in cluster_router.cpp). The
+ * cache maps signatures to whether they routed and, if they did, to the route tree of each net.
+ *
+ * Routing problems which ran into mode selection issues are never cached, since their outcome also
+ * depends on the modes marked illegal on the pb_graph_nodes.
+ */
+class IntraLbRouteCache {
+  public:
+    /** The outcome of routing one signature */
+    struct Entry {
+        bool is_routed = false;
+        ///@brief The route tree of each intra-lb net (empty if not routed)
+        std::vector<t_lb_trace> rt_trees;
+    };
+
+    /** @brief Returns the cached outcome of routing signature, or nullptr if it is not known */
+    const Entry* find(const std::vector<int>& signature) {
+        num_lookups_++;
+        auto it = entries_.find(signature);
+        if (it == entries_.end())
+            return nullptr;
+        if (it->second.is_routed)
+            num_feasible_hits_++;
+        else
+            num_infeasible_hits_++;
+        return &it->second;
+    }
+
+    /**
+     * @brief Records the outcome of routing signature.
+     *
+     * The cache is flushed when it holds MAX_ENTRIES signatures, to bound its memory.
+     */
+    void insert(std::vector<int>&& signature, Entry&& entry) {
+        if (entries_.size() >= MAX_ENTRIES) {
+            entries_.clear();
+            num_flushes_++;
+        }
+        entries_.emplace(std::move(signature), std::move(entry));
+    }
+
+    /** @brief Adds the statistics of other (e.g. the cache of another legalizer) to these ones */
+    void add_stats(const IntraLbRouteCache& other) {
+        num_lookups_ += other.num_lookups_;
+        num_feasible_hits_ += other.num_feasible_hits_;
+        num_infeasible_hits_ += other.num_infeasible_hits_;
+        num_flushes_ += other.num_flushes_;
+    }
+
+    size_t num_lookups() const { return num_lookups_; }
+    size_t num_feasible_hits() const { return num_feasible_hits_; }
+    size_t num_infeasible_hits() const { return num_infeasible_hits_; }
+    size_t num_flushes() const { return num_flushes_; }
+    size_t num_entries() const { return entries_.size(); }
+
+    static constexpr size_t MAX_ENTRIES = 10000;
+
+  private:
+    struct SignatureHash {
+        size_t operator()(const std::vector<int>& signature) const noexcept {
+            size_t seed = signature.size();
+            for (int value : signature) {
+                vtr::hash_combine(seed, value);
+            }
+            return seed;
+        }
+    };
+
+    std::unordered_map<std::vector<int>, Entry, SignatureHash> entries_;
+
+    size_t num_lookups_ = 0;
+    size_t num_feasible_hits_ = 0;
+    size_t num_infeasible_hits_ = 0;
+    size_t num_flushes_ = 0;
+};
+
 /* Stores all data needed by intra-logic cluster_ctx.blocks router */
 struct t_lb_router_data {
     /* Physical Architecture Info */
-    std::vector<t_lb_type_rr_node>* lb_type_graph; /* Pointer to physical intra-logic cluster_ctx.blocks type rr graph */
+    const std::vector<t_lb_type_rr_node>* lb_type_graph; /* Pointer to physical intra-logic cluster_ctx.blocks type rr graph (shared by all the clusters of the type, read-only) */
 
     /* Logical Netlist Info */
     std::vector<t_intra_lb_net>* intra_lb_nets; /* Pointer to vector of intra logic cluster_ctx.blocks nets and their connections */
@@ -214,6 +298,9 @@ struct t_lb_router_data {
     /* current congestion factor */
     float pres_con_fac;
 
+    /* Cache of the routing outcomes, shared with the other clusters of the legalizer (may be null) */
+    IntraLbRouteCache* route_cache;
+
     t_lb_router_data() {
         lb_type_graph = nullptr;
         lb_rr_node_stats = nullptr;
@@ -224,6 +311,7 @@ struct t_lb_router_data {
         atoms_added = nullptr;
         explored_node_tb = nullptr;
         explore_id_index = 1;
+        route_cache = nullptr;
 
         params.max_iterations = 50;
         params.pres_fac = 1;
@@ -18,6 +18,10 @@
 /* Include global variables of VPR */
 #include "globals.h"
 
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
 /********************************************************************
  * Give a given pin index, find the side where this pin is located
  * on the physical tile
@@ -45,14 +49,16 @@ static std::vector<e_side> find_physical_tile_pin_side(t_physical_tile_type_ptr
  *    - find a corresponding node in RRGraph object
  *    - find the net id for the node in routing context
  *    - find the net id for the node in clustering context
- *    - if the net id does not match, we update the clustering context
+ *    - if the net id does not match, we record the net of the routing results
+ *      in post_routing_pin_nets (the block's entry of post_routing_clb_pin_nets)
  *******************************************************************/
 static void update_cluster_pin_with_post_routing_results(const Netlist<>& net_list,
                                                          const DeviceContext& device_ctx,
-                                                         ClusteringContext& clustering_ctx,
+                                                         const ClusteringContext& clustering_ctx,
                                                          const vtr::vector<RRNodeId, ClusterNetId>& rr_node_nets,
                                                          const t_pl_loc& grid_coord,
                                                          const ClusterBlockId& blk_id,
+                                                         std::map<int, ClusterNetId>& post_routing_pin_nets,
                                                          size_t& num_mismatches,
                                                          const bool& verbose) {
     const int sub_tile_z = grid_coord.sub_tile;
@@ -217,8 +223,8 @@ static void update_cluster_pin_with_post_routing_results(const Netlist<>& net_li
             continue;
         }
 
-        /* Update the clustering context with net modification */
-        clustering_ctx.post_routing_clb_pin_nets[blk_id][pb_graph_pin->pin_count_in_cluster] = cluster_equivalent_net_id;
+        /* Record the net modification */
+        post_routing_pin_nets[pb_graph_pin->pin_count_in_cluster] = cluster_equivalent_net_id;
 
         std::string routing_net_name("unmapped");
         if (clustering_ctx.clb_nlist.valid_net_id(cluster_equivalent_net_id)) {
@@ -623,7 +629,7 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
         }
 
         /* Update only when there is a remapping! */
-        VTR_ASSERT_SAFE(remapped_result != clustering_ctx.post_routing_clb_pin_nets[blk_id].end());
+        VTR_ASSERT_SAFE(remapped_result != clustering_ctx.post_routing_clb_pin_nets.at(blk_id).end());
 
         /* Cache the remapped net id */
         AtomNetId remapped_net = atom_ctx.lookup().atom_net(remapped_result->second);
@@ -668,7 +674,7 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
                                                                     verbose);
 
         /* Record the previous pin mapping for finding the correct pin index during timing analysis */
-        clustering_ctx.pre_routing_net_pin_mapping[blk_id][pb_graph_pin->pin_count_in_cluster] = pb_route_id;
+        clustering_ctx.pre_routing_net_pin_mapping.at(blk_id)[pb_graph_pin->pin_count_in_cluster] = pb_route_id;
 
         /* Remove the old pb_route and insert the new one */
         new_pb_routes.insert(std::make_pair(pb_graph_pin->pin_count_in_cluster, t_pb_route()));
@@ -923,7 +929,7 @@ static void update_cluster_global_routing_traces_with_post_routing_results(const
         }
 
         /* Update only when there is a remapping! */
-        VTR_ASSERT_SAFE(remapped_result != clustering_ctx.post_routing_clb_pin_nets[blk_id].end());
+        VTR_ASSERT_SAFE(remapped_result != clustering_ctx.post_routing_clb_pin_nets.at(blk_id).end());
 
         VTR_LOGV(verbose,
                  "Remapping clustered block '%s' global net '%s' to unused pin as %s\r",
@@ -953,8 +959,8 @@ static void update_cluster_global_routing_traces_with_post_routing_results(const
         }
 
         /* Update the remapping nets for this global net */
-        clustering_ctx.post_routing_clb_pin_nets[blk_id][unused_pb_graph_pin->pin_count_in_cluster] = global_net_id;
-        clustering_ctx.pre_routing_net_pin_mapping[blk_id][unused_pb_graph_pin->pin_count_in_cluster] = pb_route_id;
+        clustering_ctx.post_routing_clb_pin_nets.at(blk_id)[unused_pb_graph_pin->pin_count_in_cluster] = global_net_id;
+        clustering_ctx.pre_routing_net_pin_mapping.at(blk_id)[unused_pb_graph_pin->pin_count_in_cluster] = pb_route_id;
 
         VTR_LOGV(verbose,
                  "Remap clustered block '%s' global net '%s' to pin '%s'\n",
@@ -975,6 +981,10 @@ static void update_cluster_global_routing_traces_with_post_routing_results(const
  * Note:
  *   - This function should be called AFTER the function
  *       update_cluster_pin_with_post_routing_results()
+ *   - The entries of the block in post_routing_clb_pin_nets and
+ *     pre_routing_net_pin_mapping must already exist: only the block's
+ *     own entries (and the atom pins of the block) are modified, so
+ *     different blocks can be updated concurrently
  *******************************************************************/
 static void update_cluster_routing_traces_with_post_routing_results(AtomContext& atom_ctx,
                                                                     const IntraLbPbPinLookup& intra_lb_pb_pin_lookup,
@@ -1043,33 +1053,75 @@ void sync_netlists_to_routing(const Netlist<>& net_list,
     size_t num_mismatches = 0;
     size_t num_fixup = 0;
 
+    /* Update the core logic (center blocks of the FPGA) */
+    std::vector<ClusterBlockId> clb_blk_ids;
     std::unordered_set<ClusterBlockId> seen_block_ids;
     seen_block_ids.reserve(clustering_ctx.clb_nlist.blocks().size());
-    /* Update the core logic (center blocks of the FPGA) */
     for (const ParentBlockId& blk_id : net_list.blocks()) {
-        /* We know the entrance to grid info and mapping results, do the fix-up for this block */
         ClusterBlockId clb_blk_id = convert_to_cluster_block_id(blk_id);
         VTR_ASSERT(clb_blk_id != ClusterBlockId::INVALID());
 
         if (seen_block_ids.insert(clb_blk_id).second) {
-            update_cluster_pin_with_post_routing_results(net_list,
-                                                         device_ctx,
-                                                         clustering_ctx,
-                                                         rr_node_nets,
-                                                         placement_ctx.block_locs()[clb_blk_id].loc,
-                                                         clb_blk_id,
-                                                         num_mismatches,
-                                                         verbose);
-
-            update_cluster_routing_traces_with_post_routing_results(atom_ctx,
-                                                                    intra_lb_pb_pin_lookup,
-                                                                    clustering_ctx,
-                                                                    clb_blk_id,
-                                                                    num_fixup,
-                                                                    verbose);
+            clb_blk_ids.push_back(clb_blk_id);
+        }
+    }
+
+    /* The blocks are fixed up independently, so they are processed in parallel.
+     * The verbose messages of different blocks would interleave, so they are kept serial in verbose mode. */
+    auto for_each_block = [&](const auto& fixup_block) {
+#if defined(VPR_USE_TBB)
+        if (!verbose) {
+            tbb::parallel_for(size_t(0), clb_blk_ids.size(), fixup_block);
+            return;
+        }
+#endif
+        for (size_t iblk = 0; iblk < clb_blk_ids.size(); iblk++) {
+            fixup_block(iblk);
+        }
+    };
+
+    /* Find the pins whose net differs from the routing results */
+    std::vector<std::map<int, ClusterNetId>> post_routing_pin_nets(clb_blk_ids.size());
+    std::vector<size_t> block_num_mismatches(clb_blk_ids.size(), 0);
+    for_each_block([&](size_t iblk) {
+        /* We know the entrance to grid info and mapping results, do the fix-up for this block */
+        ClusterBlockId clb_blk_id = clb_blk_ids[iblk];
+        update_cluster_pin_with_post_routing_results(net_list,
+                                                     device_ctx,
+                                                     clustering_ctx,
+                                                     rr_node_nets,
+                                                     placement_ctx.block_locs()[clb_blk_id].loc,
+                                                     clb_blk_id,
+                                                     post_routing_pin_nets[iblk],
+                                                     block_num_mismatches[iblk],
+                                                     verbose);
+    });
+
+    /* Create the entries of the remapped blocks up front, so that fixing up the routing traces
+     * of a block only modifies the existing entry of that block */
+    for (size_t iblk = 0; iblk < clb_blk_ids.size(); iblk++) {
+        num_mismatches += block_num_mismatches[iblk];
+        if (!post_routing_pin_nets[iblk].empty()) {
+            clustering_ctx.post_routing_clb_pin_nets[clb_blk_ids[iblk]] = std::move(post_routing_pin_nets[iblk]);
+            clustering_ctx.pre_routing_net_pin_mapping[clb_blk_ids[iblk]];
         }
     }
 
+    /* Fix up the routing traces. The atom pins remapped belong to the block (and are
+     * already in the atom pin look-up), so the blocks do not modify the same look-up entries. */
+    std::vector<size_t> block_num_fixup(clb_blk_ids.size(), 0);
+    for_each_block([&](size_t iblk) {
+        update_cluster_routing_traces_with_post_routing_results(atom_ctx,
+                                                                intra_lb_pb_pin_lookup,
+                                                                clustering_ctx,
+                                                                clb_blk_ids[iblk],
+                                                                block_num_fixup[iblk],
+                                                                verbose);
+    });
+    for (size_t block_fixup : block_num_fixup) {
+        num_fixup += block_fixup;
+    }
+
     /* Print a short summary */
     VTR_LOG("Found %lu mismatches between routing and packing results.\n",
             num_mismatches);
@@ -12,9 +12,11 @@
 
 #include "prepack.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <map>
+#include <memory>
 #include <queue>
 #include <utility>
 #include <vector>
@@ -32,9 +34,25 @@
 #include "vtr_util.h"
 #include "vtr_vector.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 /*****************************************/
 /*Local Function Declaration			 */
 /*****************************************/
+
+#ifdef VPR_USE_TBB
+/// @brief The match of a pack pattern from an atom block, made against the
+///        molecules of the previous pack patterns only.
+struct t_molecule_match {
+    bool is_matched = false;
+    AtomBlockId root_blk_id;
+    t_pack_molecule molecule;
+    /// @brief The atom blocks whose molecules were looked up by the match.
+    std::vector<AtomBlockId> queried_atoms;
+};
+#endif
 static std::vector<t_pack_patterns> alloc_and_load_pack_patterns(const std::vector<t_logical_block_type>& logical_block_types);
 
 static void free_list_of_pack_patterns(std::vector<t_pack_patterns>& list_of_pack_patterns);
@@ -68,10 +86,19 @@ static int compare_pack_pattern(const t_pack_patterns* pattern_a, const t_pack_p
 
 static void free_pack_pattern_block(t_pack_pattern_block* pattern_block, t_pack_pattern_block** pattern_block_list);
 
+static bool try_match_molecule(t_pack_patterns* pack_pattern,
+                               AtomBlockId blk_id,
+                               const std::multimap<AtomBlockId, PackMoleculeId>& atom_molecules,
+                               const AtomNetlist& atom_nlist,
+                               t_pack_molecule& molecule,
+                               AtomBlockId& root_blk_id,
+                               std::vector<AtomBlockId>* queried_atoms);
+
 static bool try_expand_molecule(t_pack_molecule& molecule,
                                 const AtomBlockId blk_id,
                                 const std::multimap<AtomBlockId, PackMoleculeId>& atom_molecules,
-                                const AtomNetlist& atom_nlist);
+                                const AtomNetlist& atom_nlist,
+                                std::vector<AtomBlockId>* queried_atoms);
 
 static void print_pack_molecules(const char* fname,
                                  const std::vector<t_pack_patterns>& list_of_pack_patterns,
@@ -87,7 +114,8 @@ static t_pb_graph_node* get_expected_lowest_cost_primitive_for_atom_block_in_pb_
 static AtomBlockId find_new_root_atom_for_chain(const AtomBlockId blk_id,
                                                 const t_pack_patterns* list_of_pack_patterns,
                                                 const std::multimap<AtomBlockId, PackMoleculeId>& atom_molecules,
-                                                const AtomNetlist& atom_nlist);
+                                                const AtomNetlist& atom_nlist,
+                                                std::vector<AtomBlockId>* queried_atoms);
 
 static std::vector<t_pb_graph_pin*> find_end_of_path(t_pb_graph_pin* input_pin, int pattern_index);
 
@@ -804,6 +832,10 @@ void Prepacker::alloc_and_load_pack_molecules(std::multimap<AtomBlockId, PackMol
      * TODO: Need to investigate better mapping strategies than first-fit
      */
     size_t num_packing_patterns = list_of_pack_patterns.size();
+#ifdef VPR_USE_TBB
+    std::vector<std::unique_ptr<t_molecule_match>> matches;
+    std::vector<bool> is_claimed;
+#endif
     for (size_t i = 0; i < num_packing_patterns; i++) {
         /* Skip pack patterns for modes that are disabled for packing,
          * Ensure no resources in unpackable modes will be mapped during pre-packing stage 
@@ -825,9 +857,62 @@ void Prepacker::alloc_and_load_pack_molecules(std::multimap<AtomBlockId, PackMol
         is_used[best_pattern] = true;
 
         auto blocks = atom_nlist.blocks();
+#ifdef VPR_USE_TBB
+        // Match the pattern from every block in parallel, against the
+        // molecules of the previous patterns only. The blocks are then visited
+        // in order as in the serial version below, and a match is only used if
+        // none of the atoms it looked up has been claimed by a molecule of this
+        // pattern in the meantime; otherwise it is redone. This forms exactly
+        // the same molecules as the serial version.
+        matches.clear();
+        matches.resize(blocks.size());
+        t_pack_patterns* pack_pattern = &list_of_pack_patterns[best_pattern];
+        tbb::parallel_for(size_t(0), blocks.size(), [&](size_t iblk) {
+            auto match = std::make_unique<t_molecule_match>();
+            match->is_matched = try_match_molecule(pack_pattern, AtomBlockId(iblk), atom_molecules_multimap, atom_nlist,
+                                                   match->molecule, match->root_blk_id, &match->queried_atoms);
+            // A failed match which looked up no atoms fails whatever the other
+            // molecules are; leave it out.
+            if (match->is_matched || !match->queried_atoms.empty())
+                matches[iblk] = std::move(match);
+        });
+        is_claimed.assign(blocks.size(), false);
+#endif
         for (auto blk_iter = blocks.begin(); blk_iter != blocks.end(); ++blk_iter) {
             auto blk_id = *blk_iter;
 
+#ifdef VPR_USE_TBB
+            const std::unique_ptr<t_molecule_match>& match = matches[size_t(blk_id)];
+            if (!match)
+                continue;
+
+            bool is_stale = std::any_of(match->queried_atoms.begin(), match->queried_atoms.end(),
+                                        [&](AtomBlockId queried_blk_id) { return is_claimed[size_t(queried_blk_id)]; });
+
+            PackMoleculeId cur_molecule_id;
+            if (is_stale) {
+                cur_molecule_id = try_create_molecule(best_pattern,
+                                                      blk_id,
+                                                      atom_molecules_multimap,
+                                                      atom_nlist);
+            } else if (match->is_matched) {
+                // Committing the match claims the atoms it looked up, leaving
+                // it stale for any retry of this block.
+                cur_molecule_id = commit_molecule(std::move(match->molecule),
+                                                  match->root_blk_id,
+                                                  atom_molecules_multimap,
+                                                  atom_nlist);
+            }
+
+            // If the molecule could not be created, move to the next block.
+            if (!cur_molecule_id.is_valid())
+                continue;
+
+            for (AtomBlockId mol_blk_id : pack_molecules_[cur_molecule_id].atom_block_ids) {
+                if (mol_blk_id)
+                    is_claimed[size_t(mol_blk_id)] = true;
+            }
+#else
             PackMoleculeId cur_molecule_id = try_create_molecule(best_pattern,
                                                                  blk_id,
                                                                  atom_molecules_multimap,
@@ -836,6 +921,7 @@ void Prepacker::alloc_and_load_pack_molecules(std::multimap<AtomBlockId, PackMol
             // If the molecule could not be created, move to the next block.
             if (!cur_molecule_id.is_valid())
                 continue;
+#endif
 
             /* In the event of multiple molecules with the same atom block pattern,
              * bias to use the molecule with less costly physical resources first */
@@ -941,22 +1027,47 @@ PackMoleculeId Prepacker::try_create_molecule(const int pack_pattern_index,
                                               AtomBlockId blk_id,
                                               std::multimap<AtomBlockId, PackMoleculeId>& atom_molecules_multimap,
                                               const AtomNetlist& atom_nlist) {
-    auto pack_pattern = &list_of_pack_patterns[pack_pattern_index];
+    t_pack_molecule molecule;
+    AtomBlockId root_blk_id;
+    if (!try_match_molecule(&list_of_pack_patterns[pack_pattern_index], blk_id, atom_molecules_multimap, atom_nlist,
+                            molecule, root_blk_id, nullptr)) {
+        // Failed to create molecule
+        return PackMoleculeId::INVALID();
+    }
+
+    return commit_molecule(std::move(molecule), root_blk_id, atom_molecules_multimap, atom_nlist);
+}
 
+/**
+ * Matches a pattern from the given atom block without creating the molecule
+ * (see Prepacker::try_create_molecule). On success, molecule holds the matched
+ * atoms and root_blk_id the atom the match was expanded from, which for chains
+ * is the furthest unmapped atom up the chain.
+ *
+ * This only reads atom_molecules and the netlist, so matches can run in
+ * parallel. If queried_atoms is not null, the atom blocks whose molecules were
+ * looked up are appended to it: the match is a function of whether those atoms
+ * are in a molecule.
+ */
+static bool try_match_molecule(t_pack_patterns* pack_pattern,
+                               AtomBlockId blk_id,
+                               const std::multimap<AtomBlockId, PackMoleculeId>& atom_molecules,
+                               const AtomNetlist& atom_nlist,
+                               t_pack_molecule& molecule,
+                               AtomBlockId& root_blk_id,
+                               std::vector<AtomBlockId>* queried_atoms) {
     // Check pack pattern validity
     if (pack_pattern == nullptr || pack_pattern->num_blocks == 0 || pack_pattern->root_block == nullptr) {
-        return PackMoleculeId::INVALID();
+        return false;
     }
 
     // If a chain pattern extends beyond a single logic block, we must find
     // the furthest blk_id up the chain that is not mapped to a molecule yet.
     if (pack_pattern->is_chain) {
-        blk_id = find_new_root_atom_for_chain(blk_id, pack_pattern, atom_molecules_multimap, atom_nlist);
-        if (!blk_id) return PackMoleculeId::INVALID();
+        blk_id = find_new_root_atom_for_chain(blk_id, pack_pattern, atom_molecules, atom_nlist, queried_atoms);
+        if (!blk_id) return false;
     }
 
-    PackMoleculeId new_molecule_id = PackMoleculeId(pack_molecules_.size());
-    t_pack_molecule molecule;
     molecule.base_gain = 0.f;
     molecule.type = e_pack_pattern_molecule_type::MOLECULE_FORCED_PACK;
     molecule.pack_pattern = pack_pattern;
@@ -964,12 +1075,19 @@ PackMoleculeId Prepacker::try_create_molecule(const int pack_pattern_index,
     molecule.root = pack_pattern->root_block->block_id;
     molecule.chain_id = MoleculeChainId::INVALID();
 
-    if (!try_expand_molecule(molecule, blk_id, atom_molecules_multimap, atom_nlist)) {
-        // Failed to create molecule
-        return PackMoleculeId::INVALID();
+    if (!try_expand_molecule(molecule, blk_id, atom_molecules, atom_nlist, queried_atoms)) {
+        return false;
     }
 
-    // Success! commit molecule
+    root_blk_id = blk_id;
+    return true;
+}
+
+PackMoleculeId Prepacker::commit_molecule(t_pack_molecule&& molecule,
+                                          AtomBlockId blk_id,
+                                          std::multimap<AtomBlockId, PackMoleculeId>& atom_molecules_multimap,
+                                          const AtomNetlist& atom_nlist) {
+    PackMoleculeId new_molecule_id = PackMoleculeId(pack_molecules_.size());
 
     // update chain info for chain molecules
     if (molecule.pack_pattern->is_chain) {
@@ -1004,11 +1122,13 @@ PackMoleculeId Prepacker::try_create_molecule(const int pack_pattern_index,
  *      molecule       : the molecule we are trying to expand
  *      atom_molecules : map of atom block ids that are assigned a molecule and a pointer to this molecule
  *      blk_id         : chosen to be the root of this molecule and the code is expanding from
+ *      queried_atoms  : if not null, the atom blocks looked up in atom_molecules are appended to it
  */
 static bool try_expand_molecule(t_pack_molecule& molecule,
                                 const AtomBlockId blk_id,
                                 const std::multimap<AtomBlockId, PackMoleculeId>& atom_molecules,
-                                const AtomNetlist& atom_nlist) {
+                                const AtomNetlist& atom_nlist,
+                                std::vector<AtomBlockId>* queried_atoms) {
     // root block of the pack pattern, which is the starting point of this pattern
     const auto pattern_root_block = molecule.pack_pattern->root_block;
     // bool array indicating whether a position in a pack pattern is optional or should
@@ -1040,6 +1160,12 @@ static bool try_expand_molecule(t_pack_molecule& molecule,
             continue;
         }
 
+        // The outcome below may depend on whether this block is already in a
+        // molecule (a few blocks recorded needlessly only cost a conservative
+        // re-match, see alloc_and_load_pack_molecules).
+        if (queried_atoms && block_id)
+            queried_atoms->push_back(block_id);
+
         if (!block_id || !primitive_type_feasible(block_id, pattern_block->pb_type) || (molecule_atom_block_id && molecule_atom_block_id != block_id) || atom_molecules.find(block_id) != atom_molecules.end()) {
             // Stopping conditions, if:
             // 1) this is an invalid atom block (nothing)
@@ -1382,7 +1508,8 @@ static int compare_pack_pattern(const t_pack_patterns* pattern_a, const t_pack_p
 static AtomBlockId find_new_root_atom_for_chain(const AtomBlockId blk_id,
                                                 const t_pack_patterns* list_of_pack_patterns,
                                                 const std::multimap<AtomBlockId, PackMoleculeId>& atom_molecules,
-                                                const AtomNetlist& atom_nlist) {
+                                                const AtomNetlist& atom_nlist,
+                                                std::vector<AtomBlockId>* queried_atoms) {
     AtomBlockId new_root_blk_id;
     t_pb_graph_pin* root_ipin;
     t_pb_graph_node* root_pb_graph_node;
@@ -1409,6 +1536,8 @@ static AtomBlockId find_new_root_atom_for_chain(const AtomBlockId blk_id,
         return blk_id;
     }
     // check if driver atom is already packed
+    if (queried_atoms)
+        queried_atoms->push_back(driver_blk_id);
     auto rng = atom_molecules.equal_range(driver_blk_id);
     bool rng_empty = (rng.first == rng.second);
     if (!rng_empty) {
@@ -1417,7 +1546,7 @@ static AtomBlockId find_new_root_atom_for_chain(const AtomBlockId blk_id,
     }
 
     // didn't find furthest atom up the chain, keep searching further up the chain
-    new_root_blk_id = find_new_root_atom_for_chain(driver_blk_id, list_of_pack_patterns, atom_molecules, atom_nlist);
+    new_root_blk_id = find_new_root_atom_for_chain(driver_blk_id, list_of_pack_patterns, atom_molecules, atom_nlist, queried_atoms);
 
     if (!new_root_blk_id) {
         return blk_id;
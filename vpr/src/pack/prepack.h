@@ -326,6 +326,15 @@ class Prepacker {
                                        std::multimap<AtomBlockId, PackMoleculeId>& atom_molecules_multimap,
                                        const AtomNetlist& atom_nlist);
 
+    /**
+     * Creates a molecule matched by try_match_molecule from blk_id (the atom
+     * the match was expanded from) and links its atoms to it.
+     */
+    PackMoleculeId commit_molecule(t_pack_molecule&& molecule,
+                                   AtomBlockId blk_id,
+                                   std::multimap<AtomBlockId, PackMoleculeId>& atom_molecules_multimap,
+                                   const AtomNetlist& atom_nlist);
+
   private:
     /**
      * @brief Collection of all molecule IDs. If an entry in this map is invalid
@@ -18,8 +18,25 @@
 #include "sync_netlists_to_routing_flat.h"
 #include <deque>
 
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
 /* Static function decls (file-scope) */
 
+/** An intra-cluster connection of a net to restore in the pb_routes of a cluster */
+struct t_intra_cluster_conn {
+    ClusterBlockId clb;
+    const t_pb_graph_pin* source_pin;
+    const t_pb_graph_pin* sink_pin;
+    AtomNetId net_id;
+};
+
+/** Calls \p func(i) for each i in [0, \p num_items), in parallel if VPR is built with TBB.
+ * The calls for different items must be independent. */
+template<typename Func>
+static void for_each_index_in_parallel(size_t num_items, const Func& func);
+
 /** Get intra-cluster connections from a given RouteTree. Output <source, sink> pairs to \p out_connections . */
 static void get_intra_cluster_connections(const RouteTree& tree, std::vector<std::pair<RRNodeId, RRNodeId>>& out_connections);
 
@@ -43,6 +60,17 @@ static void fixup_atom_pb_graph_pin_mapping(void);
 
 /* Function definitions */
 
+template<typename Func>
+static void for_each_index_in_parallel(size_t num_items, const Func& func) {
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), num_items, func);
+#else
+    for (size_t i = 0; i < num_items; i++) {
+        func(i);
+    }
+#endif
+}
+
 /** Get the ClusterBlockId for a given RRNodeId. */
 inline ClusterBlockId get_cluster_block_from_rr_node(RRNodeId inode) {
     auto& device_ctx = g_vpr_ctx.device();
@@ -169,8 +197,15 @@ static void sync_pb_routes_to_routing(void) {
     auto& route_ctx = g_vpr_ctx.routing();
     auto& rr_graph = device_ctx.rr_graph;
 
+    /* The clusters (and the nets, when looking for intra-cluster connections) are independent,
+     * so each step is done in parallel over them */
+    auto clb_blocks = cluster_ctx.clb_nlist.blocks();
+    auto nets = atom_ctx.netlist().nets();
+
     /* Clear out existing pb_routes: they were made by the intra cluster router and are invalid now */
-    for (ClusterBlockId clb_blk_id : cluster_ctx.clb_nlist.blocks()) {
+    for_each_index_in_parallel(clb_blocks.size(), [&](size_t iblk) {
+        ClusterBlockId clb_blk_id = *(clb_blocks.begin() + iblk);
+
         /* Don't erase entries for nets without routing in place (clocks, globals...) */
         std::vector<int> pins_to_erase;
         t_pb_routes& pb_routes = cluster_ctx.clb_nlist.block_pb(clb_blk_id)->pb_route;
@@ -190,13 +225,15 @@ static void sync_pb_routes_to_routing(void) {
         for (int pin : pins_to_erase) {
             pb_routes.erase(pin);
         }
-    }
+    });
 
-    /* Go through each route tree and rebuild the pb_routes */
-    for (ParentNetId net_id : atom_ctx.netlist().nets()) {
+    /* Go through each route tree and find the intra-cluster connections to restore */
+    std::vector<std::vector<t_intra_cluster_conn>> net_conns(nets.size());
+    for_each_index_in_parallel(nets.size(), [&](size_t inet) {
+        ParentNetId net_id = *(nets.begin() + inet);
         auto& tree = route_ctx.route_trees[net_id];
         if (!tree)
-            continue; /* No routing at this ParentNetId */
+            return; /* No routing at this ParentNetId */
 
         /* Get all intrablock connections */
         std::vector<std::pair<RRNodeId, RRNodeId>> conns_to_restore; /* (source, sink) */
@@ -224,12 +261,27 @@ static void sync_pb_routes_to_routing(void) {
                 source_pb_graph_pin = get_pb_pin_from_pin_physical_num(physical_tile, source_pin);
             }
 
-            t_pb* pb = cluster_ctx.clb_nlist.block_pb(clb);
+            net_conns[inet].push_back({clb, source_pb_graph_pin, sink_pb_graph_pin, convert_to_atom_net_id(net_id)});
+        }
+    });
 
-            /* Route between the pins */
-            route_intra_cluster_conn(source_pb_graph_pin, sink_pb_graph_pin, convert_to_atom_net_id(net_id), pb);
+    /* Group the connections by cluster, keeping the net order so the pb_routes match a serial rebuild */
+    vtr::vector<ClusterBlockId, std::vector<t_intra_cluster_conn>> clb_conns(clb_blocks.size());
+    for (std::vector<t_intra_cluster_conn>& conns : net_conns) {
+        for (const t_intra_cluster_conn& conn : conns) {
+            clb_conns[conn.clb].push_back(conn);
         }
+        vtr::release_memory(conns);
     }
+
+    /* Route between the pins: only the pb_routes of the cluster are modified */
+    for_each_index_in_parallel(clb_blocks.size(), [&](size_t iblk) {
+        ClusterBlockId clb = *(clb_blocks.begin() + iblk);
+        t_pb* pb = cluster_ctx.clb_nlist.block_pb(clb);
+        for (const t_intra_cluster_conn& conn : clb_conns[clb]) {
+            route_intra_cluster_conn(conn.source_pin, conn.sink_pin, conn.net_id, pb);
+        }
+    });
 }
 
 /** Rebuild the ClusterNetId <-> AtomNetId lookup after compressing the ClusterNetlist.
@@ -303,9 +355,7 @@ static void sync_clustered_netlist_to_routing(void) {
         clb_netlist.remove_net(net_id);
         atom_ctx.mutable_lookup().remove_clb_net(net_id);
     }
-    for (auto pin_id : pins_to_remove) {
-        clb_netlist.remove_pin(pin_id);
-    }
+    clb_netlist.remove_pins(pins_to_remove);
     for (auto port_id : ports_to_remove) {
         clb_netlist.remove_port(port_id);
     }
@@ -383,6 +433,7 @@ static void sync_clustered_netlist_to_routing(void) {
     /* 4. Rebuild internal cluster netlist lookups */
     remapped = clb_netlist.compress();
     rebuild_atom_nets_lookup(remapped);
+    cluster_ctx.clb_net_pins = ClbNetPinsCsr(clb_netlist);
     /* 5. Rebuild place_ctx.physical_pins lookup
      * TODO: maybe we don't need this fn and pin_index is enough? */
     auto& blk_loc_registry = place_ctx.mutable_blk_loc_registry();
@@ -397,7 +448,13 @@ static void fixup_atom_pb_graph_pin_mapping(void) {
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& atom_ctx = g_vpr_ctx.mutable_atom();
 
-    for (ClusterBlockId clb : cluster_ctx.clb_nlist.blocks()) {
+    /* The clusters are fixed up in parallel. The pin rotations are stored in the pbs of the cluster,
+     * but the atom pin look-up is shared: its updates are recorded, then applied in cluster order. */
+    auto clb_blocks = cluster_ctx.clb_nlist.blocks();
+    std::vector<std::vector<std::pair<AtomPinId, const t_pb_graph_pin*>>> clb_atom_pin_pb_graph_pins(clb_blocks.size());
+    for_each_index_in_parallel(clb_blocks.size(), [&](size_t iblk) {
+        ClusterBlockId clb = *(clb_blocks.begin() + iblk);
+
         /* Collect all innermost pb routes */
         std::vector<int> sink_pb_route_ids;
         t_pb* clb_pb = cluster_ctx.clb_nlist.block_pb(clb);
@@ -426,11 +483,17 @@ static void fixup_atom_pb_graph_pin_mapping(void) {
             for (AtomPinId atom_pin : atom_ctx.netlist().port_pins(atom_port)) {
                 /* Match net IDs from pb_route and atom netlist and connect in lookup */
                 if (pb_route.atom_net_id == atom_ctx.netlist().pin_net(atom_pin)) {
-                    atom_ctx.mutable_lookup().set_atom_pin_pb_graph_pin(atom_pin, atom_pbg_pin);
+                    clb_atom_pin_pb_graph_pins[iblk].emplace_back(atom_pin, atom_pbg_pin);
                     atom_pb->set_atom_pin_bit_index(atom_pbg_pin, atom_ctx.netlist().pin_port_bit(atom_pin));
                 }
             }
         }
+    });
+
+    for (const auto& atom_pin_pb_graph_pins : clb_atom_pin_pb_graph_pins) {
+        for (const auto& [atom_pin, atom_pbg_pin] : atom_pin_pb_graph_pins) {
+            atom_ctx.mutable_lookup().set_atom_pin_pb_graph_pin(atom_pin, atom_pbg_pin);
+        }
     }
 }
 
@@ -15,6 +15,7 @@
 #include "atom_netlist.h"
 #include "clustered_netlist.h"
 #include "clustered_netlist_fwd.h"
+#include "parallel_verifier.h"
 #include "partition.h"
 #include "physical_types.h"
 #include "region.h"
@@ -46,55 +47,55 @@ static unsigned check_clustering_atom_consistency(const ClusteredNetlist& clb_nl
                                                   const AtomNetlist& atom_nlist,
                                                   const AtomLookup& atom_lookup,
                                                   const vtr::vector<ClusterBlockId, std::unordered_set<AtomBlockId>>& clb_atoms) {
-    unsigned num_errors = 0;
+    const auto& atoms = atom_nlist.blocks();
+    const auto& clbs = clb_nlist.blocks();
     // Make sure that every atom is in a cluster.
-    for (AtomBlockId atom_blk_id : atom_nlist.blocks()) {
+    unsigned num_errors = parallel_verify(atoms.size(), [&](size_t iatom, VerifierErrors& errors) {
+        AtomBlockId atom_blk_id = *(atoms.begin() + iatom);
         // Check that the atom_lookup has a clb for this atom.
         ClusterBlockId atom_clb_blk_id = atom_lookup.atom_clb(atom_blk_id);
         if (!atom_clb_blk_id.is_valid()) {
-            VTR_LOG_ERROR(
-                "Atom block %zu does not have a clb in the atom_lookup.\n",
-                size_t(atom_blk_id));
-            num_errors++;
+            VERIFIER_LOG_ERROR(errors,
+                               "Atom block %zu does not have a clb in the atom_lookup.\n",
+                               size_t(atom_blk_id));
+            // There are no atoms in the clb_atoms of an invalid cluster to check against.
+            return;
         }
         // Check that this atom is in the cluster according to clb_atoms
         const std::unordered_set<AtomBlockId>& atoms_in_clb = clb_atoms[atom_clb_blk_id];
         if (atoms_in_clb.find(atom_blk_id) == atoms_in_clb.end()) {
-            VTR_LOG_ERROR(
-                "Atom block %zu is in clb %zu according to the atom lookup, "
-                "howeever it is not in the cluster according to the cluster.\n",
-                size_t(atom_blk_id), size_t(atom_clb_blk_id));
-            num_errors++;
+            VERIFIER_LOG_ERROR(errors,
+                               "Atom block %zu is in clb %zu according to the atom lookup, "
+                               "howeever it is not in the cluster according to the cluster.\n",
+                               size_t(atom_blk_id), size_t(atom_clb_blk_id));
         }
-    }
+    });
     // Check that every cluster is being used. Clusters with no atoms in them
     // do not make sense.
-    for (ClusterBlockId clb_blk_id : clb_nlist.blocks()) {
+    num_errors += parallel_verify(clbs.size(), [&](size_t iclb, VerifierErrors& errors) {
+        ClusterBlockId clb_blk_id = *(clbs.begin() + iclb);
         const std::unordered_set<AtomBlockId>& atoms_in_clb = clb_atoms[clb_blk_id];
         if (atoms_in_clb.size() == 0) {
-            VTR_LOG_ERROR(
-                "Cluster block %zu found to be empty (has no atoms in it).\n",
-                size_t(clb_blk_id));
-            num_errors++;
+            VERIFIER_LOG_ERROR(errors,
+                               "Cluster block %zu found to be empty (has no atoms in it).\n",
+                               size_t(clb_blk_id));
         }
         for (AtomBlockId atom_blk_id : atoms_in_clb) {
             if (!atom_blk_id.is_valid()) {
-                VTR_LOG_ERROR(
-                    "Cluster block %zu has an invalid block in it.\n",
-                    size_t(clb_blk_id));
-                num_errors++;
+                VERIFIER_LOG_ERROR(errors,
+                                   "Cluster block %zu has an invalid block in it.\n",
+                                   size_t(clb_blk_id));
             }
             // Check that there are no duplicates (an atom block in multiple
             // clusters).
             if (atom_lookup.atom_clb(atom_blk_id) != clb_blk_id) {
-                VTR_LOG_ERROR(
-                    "Cluster block %zu constains atom block %zu which does "
-                    "not appear to be in it according to the atom lookup.\n",
-                    size_t(clb_blk_id), size_t(atom_blk_id));
-                num_errors++;
+                VERIFIER_LOG_ERROR(errors,
+                                   "Cluster block %zu constains atom block %zu which does "
+                                   "not appear to be in it according to the atom lookup.\n",
+                                   size_t(clb_blk_id), size_t(atom_blk_id));
             }
         }
-    }
+    });
     return num_errors;
 }
 
@@ -140,80 +141,76 @@ static unsigned check_clustering_pb_consistency(const ClusteredNetlist& clb_nlis
                                                 const AtomNetlist& atom_nlist,
                                                 const AtomLookup& atom_lookup) {
 
-    unsigned num_errors = 0;
+    const auto& clbs = clb_nlist.blocks();
+    const auto& atoms = atom_nlist.blocks();
     // Make sure that every cluster has a root pb.
-    for (ClusterBlockId clb_blk_id : clb_nlist.blocks()) {
+    unsigned num_errors = parallel_verify(clbs.size(), [&](size_t iclb, VerifierErrors& errors) {
+        ClusterBlockId clb_blk_id = *(clbs.begin() + iclb);
         const t_pb* clb_pb = clb_nlist.block_pb(clb_blk_id);
         if (clb_pb == nullptr) {
-            VTR_LOG_ERROR(
-                "Cluster block %zu does not have a pb.\n",
-                size_t(clb_blk_id));
-            num_errors++;
-            continue;
+            VERIFIER_LOG_ERROR(errors,
+                               "Cluster block %zu does not have a pb.\n",
+                               size_t(clb_blk_id));
+            return;
         }
         if (!clb_pb->is_root()) {
-            VTR_LOG_ERROR(
-                "Cluster block %zu has a pb which is not a root pb.\n",
-                size_t(clb_blk_id));
-            num_errors++;
+            VERIFIER_LOG_ERROR(errors,
+                               "Cluster block %zu has a pb which is not a root pb.\n",
+                               size_t(clb_blk_id));
         }
         // Make sure that every cluster pb's block type matches the pb. We can
         // check this by seeing if the pb_graph_node of the pb matches the pb
         // graph head of the type.
         t_logical_block_type_ptr clb_blk_type = clb_nlist.block_type(clb_blk_id);
         if (clb_blk_type->pb_graph_head != clb_pb->pb_graph_node) {
-            VTR_LOG_ERROR(
-                "Cluster block %zu has a pb whose graph node does not match "
-                "the pb_graph_head of its block type: %s.\n",
-                size_t(clb_blk_id), clb_blk_type->name.c_str());
-            num_errors++;
+            VERIFIER_LOG_ERROR(errors,
+                               "Cluster block %zu has a pb whose graph node does not match "
+                               "the pb_graph_head of its block type: %s.\n",
+                               size_t(clb_blk_id), clb_blk_type->name.c_str());
         }
         // TODO: Should check the pb_route. Tried checking that the pb_route
         //       always exists, but there appear to be cases when it does not
         //       exist (which may be ok).
-    }
+    });
     // Make sure that every atom is a primitive pb and is in its cluster's pb.
-    for (AtomBlockId atom_blk_id : atom_nlist.blocks()) {
+    num_errors += parallel_verify(atoms.size(), [&](size_t iatom, VerifierErrors& errors) {
+        AtomBlockId atom_blk_id = *(atoms.begin() + iatom);
         // If this atom is not in a cluster, another error will be produced
         // elsewhere. Cannot get the pb of NULL, so skip this atom.
         ClusterBlockId atom_clb_blk_id = atom_lookup.atom_clb(atom_blk_id);
         if (!atom_clb_blk_id.is_valid())
-            continue;
+            return;
         const t_pb* atom_pb = atom_lookup.atom_pb_bimap().atom_pb(atom_blk_id);
         // Make sure the atom's pb exists
         if (atom_pb == nullptr) {
-            VTR_LOG_ERROR(
-                "Atom block %zu in cluster block %zu does not have a pb.\n",
-                size_t(atom_blk_id), size_t(atom_clb_blk_id));
-            num_errors++;
+            VERIFIER_LOG_ERROR(errors,
+                               "Atom block %zu in cluster block %zu does not have a pb.\n",
+                               size_t(atom_blk_id), size_t(atom_clb_blk_id));
         } else {
             // Sanity check: atom_pb == pb_atom
             if (atom_lookup.atom_pb_bimap().pb_atom(atom_pb) != atom_blk_id) {
-                VTR_LOG_ERROR(
-                    "Atom block %zu in cluster block %zu has a pb which "
-                    "belongs to another atom.\n",
-                    size_t(atom_blk_id), size_t(atom_clb_blk_id));
-                num_errors++;
+                VERIFIER_LOG_ERROR(errors,
+                                   "Atom block %zu in cluster block %zu has a pb which "
+                                   "belongs to another atom.\n",
+                                   size_t(atom_blk_id), size_t(atom_clb_blk_id));
             }
             // Make sure it is a primitve
             if (!atom_pb->is_primitive()) {
-                VTR_LOG_ERROR(
-                    "Atom block %zu in cluster block %zu has a pb which is not "
-                    "a primitive pb.\n",
-                    size_t(atom_blk_id), size_t(atom_clb_blk_id));
-                num_errors++;
+                VERIFIER_LOG_ERROR(errors,
+                                   "Atom block %zu in cluster block %zu has a pb which is not "
+                                   "a primitive pb.\n",
+                                   size_t(atom_blk_id), size_t(atom_clb_blk_id));
             }
             // Check that the atom's primitive pb is in its cluster's pb.
             if (!is_atom_pb_in_cluster_pb(atom_blk_id, atom_clb_blk_id,
                                           atom_lookup, clb_nlist)) {
-                VTR_LOG_ERROR(
-                    "Atom block %zu in cluster block  %zu is not in its "
-                    "cluster's pb.\n",
-                    size_t(atom_blk_id), size_t(atom_clb_blk_id));
-                num_errors++;
+                VERIFIER_LOG_ERROR(errors,
+                                   "Atom block %zu in cluster block  %zu is not in its "
+                                   "cluster's pb.\n",
+                                   size_t(atom_blk_id), size_t(atom_clb_blk_id));
             }
         }
-    }
+    });
     return num_errors;
 }
 
@@ -258,7 +255,9 @@ static unsigned check_clustering_floorplanning_consistency(
         return num_errors;
     }
     // Make sure that every atom in each cluster can be placed in that cluster.
-    for (ClusterBlockId clb_blk_id : clb_nlist.blocks()) {
+    const auto& clbs = clb_nlist.blocks();
+    num_errors += parallel_verify(clbs.size(), [&](size_t iclb, VerifierErrors& errors) {
+        ClusterBlockId clb_blk_id = *(clbs.begin() + iclb);
         const PartitionRegion& cluster_pr = cluster_constraints[clb_blk_id];
         const std::unordered_set<AtomBlockId>& atoms_in_clb = clb_atoms[clb_blk_id];
         if (cluster_pr.empty()) {
@@ -267,11 +266,10 @@ static unsigned check_clustering_floorplanning_consistency(
             for (AtomBlockId atom_blk_id : atoms_in_clb) {
                 PartitionId atom_part_id = constraints.get_atom_partition(atom_blk_id);
                 if (atom_part_id.is_valid()) {
-                    VTR_LOG_ERROR(
-                        "Cluster block %zu is unconstrained but contains "
-                        "constrained atom block %zu.\n",
-                        size_t(clb_blk_id), size_t(atom_blk_id));
-                    num_errors++;
+                    VERIFIER_LOG_ERROR(errors,
+                                       "Cluster block %zu is unconstrained but contains "
+                                       "constrained atom block %zu.\n",
+                                       size_t(clb_blk_id), size_t(atom_blk_id));
                 }
             }
         } else {
@@ -286,11 +284,10 @@ static unsigned check_clustering_floorplanning_consistency(
                 }
             }
             if (!an_atom_is_constrained) {
-                VTR_LOG_ERROR(
-                    "Cluster block %zu is constrained but does not contain any "
-                    "constrained atoms.\n",
-                    size_t(clb_blk_id));
-                num_errors++;
+                VERIFIER_LOG_ERROR(errors,
+                                   "Cluster block %zu is constrained but does not contain any "
+                                   "constrained atoms.\n",
+                                   size_t(clb_blk_id));
             }
             // Check that the intersection of each atom's PR with the cluster
             // is non-empty. This implies that a placement could theoretically
@@ -316,11 +313,10 @@ static unsigned check_clustering_floorplanning_consistency(
                         break;
                 }
                 if (!intersection_exists) {
-                    VTR_LOG_ERROR(
-                        "Cluster block %zu contains the atom block %zu which "
-                        "cannot be placed within its placement constraints.\n",
-                        size_t(clb_blk_id), size_t(atom_blk_id));
-                    num_errors++;
+                    VERIFIER_LOG_ERROR(errors,
+                                       "Cluster block %zu contains the atom block %zu which "
+                                       "cannot be placed within its placement constraints.\n",
+                                       size_t(clb_blk_id), size_t(atom_blk_id));
                 }
             }
             // Compute the intersection of all the atom PRs in the cluster.
@@ -351,11 +347,10 @@ static unsigned check_clustering_floorplanning_consistency(
             // If the calculated cluster pr is empty, then the atoms' PRs
             // conflict with each other and cannot be in the same cluster.
             if (calc_cluster_pr.empty()) {
-                VTR_LOG_ERROR(
-                    "Cluster block %zu contains constrained atoms whose "
-                    "constraints conflict.\n",
-                    size_t(clb_blk_id));
-                num_errors++;
+                VERIFIER_LOG_ERROR(errors,
+                                   "Cluster block %zu contains constrained atoms whose "
+                                   "constraints conflict.\n",
+                                   size_t(clb_blk_id));
             }
             // Check that the calculate cluster PR matches the actual cluster
             // PR.
@@ -377,16 +372,15 @@ static unsigned check_clustering_floorplanning_consistency(
                     }
                 }
                 if (!found_region) {
-                    VTR_LOG_ERROR(
-                        "Cluster block %zu cluster constraint does not match "
-                        "the intersection of all constrained blocks in it\n",
-                        size_t(clb_blk_id));
-                    num_errors++;
+                    VERIFIER_LOG_ERROR(errors,
+                                       "Cluster block %zu cluster constraint does not match "
+                                       "the intersection of all constrained blocks in it\n",
+                                       size_t(clb_blk_id));
                     break;
                 }
             }
         }
-    }
+    });
     return num_errors;
 }
 
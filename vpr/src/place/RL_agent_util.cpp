@@ -130,6 +130,7 @@ std::pair<std::unique_ptr<MoveGenerator>, std::unique_ptr<MoveGenerator>> create
                                                                       num_movable_blocks_per_type);
             }
             karmed_bandit_agent1->set_step(placer_opts.place_agent_gamma, move_lim);
+            karmed_bandit_agent1->set_batch_size(placer_opts.place_agent_batch_size);
             move_generators.first = std::make_unique<SimpleRLMoveGenerator>(placer_state,
                                                                             place_macros,
                                                                             net_cost_handler,
@@ -144,6 +145,7 @@ std::pair<std::unique_ptr<MoveGenerator>, std::unique_ptr<MoveGenerator>> create
                                                                   rng,
                                                                   num_movable_blocks_per_type);
             karmed_bandit_agent2->set_step(placer_opts.place_agent_gamma, move_lim);
+            karmed_bandit_agent2->set_batch_size(placer_opts.place_agent_batch_size);
             move_generators.second = std::make_unique<SimpleRLMoveGenerator>(placer_state,
                                                                              place_macros,
                                                                              net_cost_handler,
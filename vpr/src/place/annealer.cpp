@@ -6,6 +6,7 @@
 #include <limits>
 
 #include "globals.h"
+#include "place_constraints.h"
 #include "place_macro.h"
 #include "vpr_context.h"
 #include "vpr_error.h"
@@ -22,6 +23,11 @@
 #include "PlacerSetupSlacks.h"
 #include "PlacerCriticalities.h"
 #include "vtr_expr_eval.h"
+#include "vtr_profile.h"
+
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
 
 #ifndef NO_GRAPHICS
 #include "draw_global.h"
@@ -115,9 +121,10 @@ t_annealing_state::t_annealing_state(float first_t,
     /* Store this inverse value for speed when updating crit_exponent. */
     INVERSE_DELTA_RLIM = 1 / (first_rlim - FINAL_RLIM);
 
-    /* The range limit cannot exceed the largest grid size. */
+    /* The range limit cannot exceed the largest grid size, nor the first range limit
+     * if it is smaller (e.g. an incremental placement, which only anneals locally). */
     const auto& grid = g_vpr_ctx.device().grid;
-    UPPER_RLIM = std::max(grid.width() - 1, grid.height() - 1);
+    UPPER_RLIM = std::min<float>(std::max(grid.width() - 1, grid.height() - 1), first_rlim);
 }
 
 bool t_annealing_state::outer_loop_update(float success_rate,
@@ -175,6 +182,25 @@ bool t_annealing_state::outer_loop_update(float success_rate,
     return true;
 }
 
+int t_annealing_state::estimate_remaining_temps(const t_placer_costs& costs,
+                                                const t_placer_opts& placer_opts) const {
+    float t_exit;
+    float cooling_rate;
+    if (placer_opts.anneal_sched.type == e_sched_type::USER_SCHED) {
+        t_exit = placer_opts.anneal_sched.exit_t;
+        cooling_rate = placer_opts.anneal_sched.alpha_t;
+    } else {
+        // Same exit temperature as outer_loop_update()
+        t_exit = 0.005 * costs.cost / g_vpr_ctx.clustering().clb_nlist.nets().size();
+        cooling_rate = alpha;
+    }
+
+    if (!(t > t_exit) || !(t_exit > 0.) || cooling_rate <= 0. || cooling_rate >= 1.) {
+        return 0;
+    }
+    return (int)std::ceil(std::log(t_exit / t) / std::log(cooling_rate));
+}
+
 void t_annealing_state::update_rlim(float success_rate) {
     rlim *= (1. - 0.44 + success_rate);
     rlim = std::min(rlim, UPPER_RLIM);
@@ -229,6 +255,7 @@ PlacementAnnealer::PlacementAnnealer(const t_placer_opts& placer_opts,
     , timing_info_(timing_info)
     , pin_timing_invalidator_(pin_timing_invalidator)
     , move_stats_file_(nullptr, vtr::fclose)
+    , move_profiler_(placer_opts.move_profile_file)
     , outer_crit_iter_count_(1)
     , blocks_affected_(placer_state.block_locs().size())
     , quench_started_(false) {
@@ -241,7 +268,12 @@ PlacementAnnealer::PlacementAnnealer(const t_placer_opts& placer_opts,
         first_crit_exponent = 0.f;
     }
 
-    int first_move_lim = get_place_inner_loop_num_move(placer_opts, placer_opts_.anneal_sched);
+    // An incremental placement only anneals the (movable) blocks around the
+    // changed logic, so its effort and range limit are scaled to them.
+    const bool is_eco_placement = !placer_opts.eco_place_file.empty();
+    size_t num_annealed_blocks = is_eco_placement ? placer_state.blk_loc_registry().movable_blocks().size()
+                                                  : g_vpr_ctx.clustering().clb_nlist.blocks().size();
+    int first_move_lim = get_place_inner_loop_num_move(placer_opts, placer_opts_.anneal_sched, num_annealed_blocks);
 
     VTR_LOG("Moves per temperature: %d\n", first_move_lim);
 
@@ -266,6 +298,10 @@ PlacementAnnealer::PlacementAnnealer(const t_placer_opts& placer_opts,
 
     // Get the first range limiter
     MoveGenerator::first_rlim = (float)std::max(device_ctx.grid.width() - 1, device_ctx.grid.height() - 1);
+    if (is_eco_placement) {
+        // At least 2, as the range limit shrinks down to FINAL_RLIM (1).
+        MoveGenerator::first_rlim = std::min(MoveGenerator::first_rlim, (float)std::max(placer_opts.eco_window, 2));
+    }
 
     // In automatic schedule we do a number of random moves before starting the main annealer
     // to get an estimate for the initial temperature. We set this temperature low
@@ -291,6 +327,9 @@ PlacementAnnealer::PlacementAnnealer(const t_placer_opts& placer_opts,
     // Update the starting temperature for placement annealing to a more appropriate value
     VTR_ASSERT_SAFE_MSG(auto_init_t_scale >= 0, "Initial temperature scale cannot be negative.");
     annealing_state_.t = estimate_starting_temperature_() * auto_init_t_scale;
+
+    // Don't profile the moves made to find the starting temperature as part of the first temperature
+    move_profiler_.discard();
 }
 
 float PlacementAnnealer::estimate_starting_temperature_() {
@@ -523,6 +562,8 @@ t_swap_result PlacementAnnealer::try_swap_(MoveGenerator& move_generator,
 
     e_create_move create_move_outcome = e_create_move::ABORT;
 
+    const MoveProfiler::clock::time_point move_start = move_profiler_.now();
+
     // Determine whether we need to force swap two NoC router blocks
     bool router_block_move = false;
     if (noc_opts_.noc) {
@@ -547,6 +588,8 @@ t_swap_result PlacementAnnealer::try_swap_(MoveGenerator& move_generator,
 
     move_type_stats_.incr_blk_type_moves(proposed_action);
 
+    const MoveProfiler::clock::time_point move_proposed = move_profiler_.now();
+
     if constexpr (VTR_ENABLE_DEBUG_LOGGING_CONST_EXPR) LOG_MOVE_STATS_PROPOSED();
 
     VTR_LOGV_DEBUG(g_vpr_ctx.placement().f_placer_debug,
@@ -634,8 +677,12 @@ t_swap_result PlacementAnnealer::try_swap_(MoveGenerator& move_generator,
              * we need to revert block moves and restore the timing values. */
             criticalities_->disable_update();
             setup_slacks_->enable_update();
+            const MoveProfiler::clock::time_point timing_start = move_profiler_.now();
             update_timing_classes(crit_params, timing_info_, criticalities_,
                                   setup_slacks_, pin_timing_invalidator_);
+            if (move_profiler_.enabled()) {
+                move_profiler_.record_move_timing_update(proposed_action.move_type, move_profiler_.now() - timing_start);
+            }
 
             /* Get the setup slack analysis cost */
             //TODO: calculate a weighted average of the slack cost and wiring cost
@@ -660,7 +707,7 @@ t_swap_result PlacementAnnealer::try_swap_(MoveGenerator& move_generator,
         }
 
         // determine whether the move is accepted or rejected
-        move_outcome = assess_swap_(delta_c, annealing_state_.t);
+        move_outcome = assess_swap_(delta_c, annealing_state_.t, rng_);
 
         //Updates the manual_move_state members and displays costs to the user to decide whether to ACCEPT/REJECT manual move.
 #ifndef NO_GRAPHICS
@@ -738,8 +785,12 @@ t_swap_result PlacementAnnealer::try_swap_(MoveGenerator& move_generator,
                 pin_timing_invalidator_->invalidate_affected_connections(blocks_affected_);
 
                 // Revert the timing update
+                const MoveProfiler::clock::time_point timing_start = move_profiler_.now();
                 update_timing_classes(crit_params, timing_info_, criticalities_,
                                       setup_slacks_, pin_timing_invalidator_);
+                if (move_profiler_.enabled()) {
+                    move_profiler_.record_move_timing_update(proposed_action.move_type, move_profiler_.now() - timing_start);
+                }
 
                 VTR_ASSERT_SAFE_MSG(
                     verify_connection_setup_slacks(setup_slacks_, placer_state_),
@@ -782,6 +833,12 @@ t_swap_result PlacementAnnealer::try_swap_(MoveGenerator& move_generator,
     // Clear the data structure containing block move info
     blocks_affected_.clear_move_blocks();
 
+    // Manual moves wait for the user, which says nothing about the cost of a move
+    if (move_profiler_.enabled() && !manual_move_enabled) {
+        move_profiler_.record_move(proposed_action.move_type, move_outcome,
+                                   move_proposed - move_start, move_profiler_.now() - move_proposed);
+    }
+
     VTR_LOGV_DEBUG(g_vpr_ctx.placement().f_placer_debug,
                    "\t\tAfter move Place cost %e, bb_cost %e, timing cost %e\n",
                    costs_.cost, costs_.bb_cost, costs_.timing_cost);
@@ -792,6 +849,548 @@ t_swap_result PlacementAnnealer::try_swap_(MoveGenerator& move_generator,
     return swap_result;
 }
 
+/// @brief Exchanges the proposed moves recorded in two move transactions (but not their abortion loggers)
+static void swap_proposed_moves(t_pl_blocks_to_be_moved& lhs, t_pl_blocks_to_be_moved& rhs) {
+    std::swap(lhs.moved_blocks, rhs.moved_blocks);
+    std::swap(lhs.moved_from, rhs.moved_from);
+    std::swap(lhs.moved_to, rhs.moved_to);
+    std::swap(lhs.affected_pins, rhs.affected_pins);
+}
+
+bool PlacementAnnealer::reserve_speculative_move_(const t_pl_blocks_to_be_moved& blocks_affected) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+
+    for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+        if (speculative_blocks_[moved_block.block_num]
+            || speculative_locs_.count(moved_block.old_loc)
+            || speculative_locs_.count(moved_block.new_loc)) {
+            return false;
+        }
+        for (ClusterPinId pin : clb_nlist.block_pins(moved_block.block_num)) {
+            ClusterNetId net = clb_nlist.pin_net(pin);
+            if (!clb_nlist.net_is_ignored(net) && speculative_nets_[net]) {
+                return false;
+            }
+        }
+    }
+
+    for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+        speculative_blocks_[moved_block.block_num] = true;
+        speculative_locs_.insert(moved_block.old_loc);
+        speculative_locs_.insert(moved_block.new_loc);
+        for (ClusterPinId pin : clb_nlist.block_pins(moved_block.block_num)) {
+            speculative_nets_[clb_nlist.pin_net(pin)] = true;
+        }
+    }
+
+    return true;
+}
+
+void PlacementAnnealer::try_swap_batch_(MoveGenerator& move_generator,
+                                        const t_place_algorithm& place_algorithm,
+                                        int num_moves) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    auto& blk_loc_registry = placer_state_.mutable_blk_loc_registry();
+
+    VTR_ASSERT_SAFE(place_algorithm == e_place_algorithm::CRITICALITY_TIMING_PLACE
+                    || place_algorithm == e_place_algorithm::BOUNDING_BOX_PLACE);
+
+    while (speculative_moves_.size() < size_t(num_moves)) {
+        speculative_moves_.push_back(std::make_unique<t_speculative_move>(placer_state_.block_locs().size()));
+    }
+    if (speculative_blocks_.empty()) {
+        speculative_blocks_.resize(clb_nlist.blocks().size(), false);
+        speculative_nets_.resize(clb_nlist.nets().size(), false);
+    }
+
+    // Propose all the moves against the current placement. Nothing is applied until the whole
+    // batch is proposed, so that the move generators see a consistent placement.
+    for (int imove = 0; imove < num_moves; imove++) {
+        t_speculative_move& move = *speculative_moves_[imove];
+        swap_stats_.num_ts_called++;
+
+        float rlim;
+        if (placer_opts_.rlim_escape_fraction > 0. && rng_.frand() < placer_opts_.rlim_escape_fraction) {
+            rlim = std::numeric_limits<float>::infinity();
+        } else {
+            rlim = annealing_state_.rlim;
+        }
+
+        move.proposed_action = {e_move_type::UNIFORM, -1};
+        const MoveProfiler::clock::time_point move_start = move_profiler_.now();
+        e_create_move create_move_outcome = move_generator.propose_move(blocks_affected_, move.proposed_action, rlim, placer_opts_, criticalities_);
+        move.propose_time = move_profiler_.now() - move_start;
+        move.agent_action = move_generator.last_proposed_action();
+        move_type_stats_.incr_blk_type_moves(move.proposed_action);
+
+        move.valid = (create_move_outcome == e_create_move::VALID);
+        if (move.valid && !reserve_speculative_move_(blocks_affected_)) {
+            blocks_affected_.move_abortion_logger.log_move_abort("conflict with a concurrent speculative move");
+            move.valid = false;
+        }
+
+        swap_proposed_moves(blocks_affected_, move.blocks_affected);
+        blocks_affected_.clear_move_blocks();
+    }
+
+    const MoveProfiler::clock::time_point eval_start = move_profiler_.now();
+
+    for (int imove = 0; imove < num_moves; imove++) {
+        t_speculative_move& move = *speculative_moves_[imove];
+        if (move.valid) {
+            blk_loc_registry.apply_move_blocks(move.blocks_affected);
+        }
+    }
+
+    // Evaluate the moves. They affect disjoint sets of nets and connections, so they
+    // only touch disjoint parts of the net cost and timing data structures.
+    auto evaluate_move = [&](size_t imove) {
+        t_speculative_move& move = *speculative_moves_[imove];
+        move.bb_delta_c = 0.;
+        move.timing_delta_c = 0.;
+        if (move.valid) {
+            net_cost_handler_.find_affected_nets_and_update_costs(delay_model_, criticalities_, move.blocks_affected,
+                                                                  move.bb_delta_c, move.timing_delta_c, move.affected_nets);
+        }
+    };
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), size_t(num_moves), evaluate_move);
+#else
+    for (int imove = 0; imove < num_moves; imove++) {
+        evaluate_move(imove);
+    }
+#endif
+
+    // The moves are evaluated together, so they share the evaluation time equally
+    const MoveProfiler::clock::duration eval_time = (move_profiler_.now() - eval_start) / num_moves;
+
+    // Accept or reject the moves in proposal order
+    for (int imove = 0; imove < num_moves; imove++) {
+        t_speculative_move& move = *speculative_moves_[imove];
+        swap_proposed_moves(blocks_affected_, move.blocks_affected);
+
+        for (const t_pl_moved_block& moved_block : blocks_affected_.moved_blocks) {
+            speculative_blocks_[moved_block.block_num] = false;
+            for (ClusterPinId pin : clb_nlist.block_pins(moved_block.block_num)) {
+                speculative_nets_[clb_nlist.pin_net(pin)] = false;
+            }
+        }
+
+        MoveOutcomeStats move_outcome_stats;
+        e_move_result move_outcome = e_move_result::ABORTED;
+        double delta_c = 0.;
+
+        if (move.valid) {
+            if (place_algorithm == e_place_algorithm::CRITICALITY_TIMING_PLACE) {
+                delta_c = (1 - placer_opts_.timing_tradeoff) * move.bb_delta_c * costs_.bb_cost_norm
+                          + placer_opts_.timing_tradeoff * move.timing_delta_c * costs_.timing_cost_norm;
+            } else {
+                delta_c = move.bb_delta_c * costs_.bb_cost_norm;
+            }
+
+            move_outcome = assess_swap_(delta_c, annealing_state_.t, rng_);
+
+            if (move_outcome == e_move_result::ACCEPTED) {
+                costs_.cost += delta_c;
+                costs_.bb_cost += move.bb_delta_c;
+
+                if (place_algorithm == e_place_algorithm::CRITICALITY_TIMING_PLACE) {
+                    costs_.timing_cost += move.timing_delta_c;
+                    pin_timing_invalidator_->invalidate_affected_connections(blocks_affected_);
+                    placer_state_.mutable_timing().commit_td_cost(blocks_affected_);
+                }
+
+                net_cost_handler_.update_move_nets(move.affected_nets);
+                blk_loc_registry.commit_move_blocks(blocks_affected_);
+            } else {
+                net_cost_handler_.reset_move_nets(move.affected_nets);
+                blk_loc_registry.revert_move_blocks(blocks_affected_);
+
+                if (place_algorithm == e_place_algorithm::CRITICALITY_TIMING_PLACE) {
+                    placer_state_.mutable_timing().revert_td_cost(blocks_affected_);
+                }
+            }
+
+            move_type_stats_.incr_accept_reject(move.proposed_action, move_outcome);
+
+            move_outcome_stats.delta_cost_norm = delta_c;
+            move_outcome_stats.delta_bb_cost_norm = move.bb_delta_c * costs_.bb_cost_norm;
+            move_outcome_stats.delta_timing_cost_norm = move.timing_delta_c * costs_.timing_cost_norm;
+            move_outcome_stats.delta_bb_cost_abs = move.bb_delta_c;
+            move_outcome_stats.delta_timing_cost_abs = move.timing_delta_c;
+        }
+        move_outcome_stats.outcome = move_outcome;
+
+        move_generator.set_last_proposed_action(move.agent_action);
+        move_generator.calculate_reward_and_process_outcome(move_outcome_stats, delta_c, REWARD_BB_TIMING_RELATIVE_WEIGHT);
+
+#ifndef NO_GRAPHICS
+        stop_placement_and_check_breakpoints(blocks_affected_, move_outcome, delta_c, move.bb_delta_c, move.timing_delta_c);
+#endif
+
+        blocks_affected_.clear_move_blocks();
+
+        if (move_profiler_.enabled()) {
+            move_profiler_.record_move(move.proposed_action.move_type, move_outcome, move.propose_time, eval_time);
+        }
+
+        record_swap_result_({move_outcome, delta_c});
+    }
+
+    speculative_locs_.clear();
+}
+
+void PlacementAnnealer::record_swap_result_(const t_swap_result& swap_result) {
+    if (swap_result.move_result == e_move_result::ACCEPTED) {
+        // Move was accepted.  Update statistics that are useful for the annealing schedule.
+        placer_stats_.single_swap_update(costs_);
+        swap_stats_.num_swap_accepted++;
+    } else if (swap_result.move_result == e_move_result::ABORTED) {
+        swap_stats_.num_swap_aborted++;
+    } else { // swap_result == REJECTED
+        swap_stats_.num_swap_rejected++;
+    }
+}
+
+void PlacementAnnealer::partition_anneal_regions_() {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const DeviceGrid& grid = g_vpr_ctx.device().grid;
+    const auto& block_locs = placer_state_.block_locs();
+
+    const int num_splits = placer_opts_.parallel_regions;
+    const int grid_width = grid.width();
+    const int grid_height = grid.height();
+
+    t_region_partition& partition = region_partition_;
+    if (partition.die_col_at_x.empty()) {
+        // The dies of each layer are delimited by its interposer cuts: a cut at loc is between loc and loc + 1
+        const std::vector<std::vector<int>>& vertical_cuts = grid.get_vertical_interposer_cuts();
+        const std::vector<std::vector<int>>& horizontal_cuts = grid.get_horizontal_interposer_cuts();
+        const int num_layers = grid.get_num_layers();
+        partition.die_col_at_x.assign(num_layers, std::vector<int>(grid_width, 0));
+        partition.die_row_at_y.assign(num_layers, std::vector<int>(grid_height, 0));
+        for (int layer = 0; layer < num_layers; layer++) {
+            if (layer < (int)vertical_cuts.size()) {
+                for (int cut_x : vertical_cuts[layer]) {
+                    for (int x = std::max(0, cut_x + 1); x < grid_width; x++) {
+                        partition.die_col_at_x[layer][x]++;
+                    }
+                }
+            }
+            if (layer < (int)horizontal_cuts.size()) {
+                for (int cut_y : horizontal_cuts[layer]) {
+                    for (int y = std::max(0, cut_y + 1); y < grid_height; y++) {
+                        partition.die_row_at_y[layer][y]++;
+                    }
+                }
+            }
+            partition.num_die_cols = std::max(partition.num_die_cols, partition.die_col_at_x[layer].back() + 1);
+            partition.num_die_rows = std::max(partition.num_die_rows, partition.die_row_at_y[layer].back() + 1);
+        }
+        partition.num_dies = num_layers * partition.num_die_rows * partition.num_die_cols;
+    }
+
+    partition.width = std::max(1, (grid_width + num_splits - 1) / num_splits);
+    partition.height = std::max(1, (grid_height + num_splits - 1) / num_splits);
+
+    // Shift the boundaries by half a region every other temperature, so that the blocks
+    // kept in place by a boundary at one temperature can move at the next one
+    const bool shifted = (annealing_state_.num_temps % 2 == 1);
+    partition.x_offset = shifted ? partition.width / 2 : 0;
+    partition.y_offset = shifted ? partition.height / 2 : 0;
+    partition.num_cols = (grid_width - 1 + partition.x_offset) / partition.width + 1;
+    partition.num_rows = (grid_height - 1 + partition.y_offset) / partition.height + 1;
+
+    // Only the regions holding movable blocks are allocated (there is one per die of each layer)
+    const size_t num_regions = partition.num_dies * partition.num_cols * partition.num_rows;
+    if (anneal_regions_.size() < num_regions) {
+        anneal_regions_.resize(num_regions);
+    }
+
+    // Blocks in macros are kept in place, since their moves may involve other regions
+    block_anneal_region_.resize(clb_nlist.blocks().size());
+    for (ClusterBlockId blk : clb_nlist.blocks()) {
+        const t_block_loc& blk_loc = block_locs[blk];
+        if (blk_loc.is_fixed || place_macros_.get_imacro_from_iblk(blk) != -1) {
+            block_anneal_region_[blk] = -1;
+        } else {
+            const int iregion = partition.region_at(blk_loc.loc.x, blk_loc.loc.y, blk_loc.loc.layer);
+            block_anneal_region_[blk] = iregion;
+            if (!anneal_regions_[iregion]) {
+                anneal_regions_[iregion] = std::make_unique<t_anneal_region>(block_locs.size());
+            }
+        }
+    }
+
+    // Keep the blocks of nets spanning several regions in place, and count the movable blocks
+    // kept in place by a net between dies or layers: they move in the serial phase
+    vtr::vector<ClusterBlockId, bool> is_interdie_block(clb_nlist.blocks().size(), false);
+    for (ClusterNetId net : clb_nlist.nets()) {
+        if (clb_nlist.net_is_ignored(net)) {
+            continue;
+        }
+
+        const t_pl_loc& driver_loc = block_locs[clb_nlist.net_driver_block(net)].loc;
+        const int net_region = partition.region_at(driver_loc.x, driver_loc.y, driver_loc.layer);
+        const int net_die = partition.die_at(driver_loc.x, driver_loc.y, driver_loc.layer);
+
+        bool spans_regions = false;
+        bool spans_dies = false;
+        for (ClusterPinId pin : clb_nlist.net_sinks(net)) {
+            const t_pl_loc& sink_loc = block_locs[clb_nlist.pin_block(pin)].loc;
+            if (partition.region_at(sink_loc.x, sink_loc.y, sink_loc.layer) != net_region) {
+                spans_regions = true;
+                if (partition.die_at(sink_loc.x, sink_loc.y, sink_loc.layer) != net_die) {
+                    spans_dies = true;
+                    break;
+                }
+            }
+        }
+
+        if (spans_regions) {
+            for (ClusterPinId pin : clb_nlist.net_pins(net)) {
+                ClusterBlockId blk = clb_nlist.pin_block(pin);
+                block_anneal_region_[blk] = -1;
+                is_interdie_block[blk] = is_interdie_block[blk] || spans_dies;
+            }
+        }
+    }
+    partition.num_interdie_blocks = 0;
+    for (ClusterBlockId blk : clb_nlist.blocks()) {
+        const t_block_loc& blk_loc = block_locs[blk];
+        if (is_interdie_block[blk] && !blk_loc.is_fixed && place_macros_.get_imacro_from_iblk(blk) == -1) {
+            partition.num_interdie_blocks++;
+        }
+    }
+
+    partition.regions.clear();
+    for (size_t iregion = 0; iregion < num_regions; iregion++) {
+        if (anneal_regions_[iregion]) {
+            anneal_regions_[iregion]->movable_blocks.clear();
+            anneal_regions_[iregion]->bb = partition.region_bb(iregion);
+            partition.regions.push_back(iregion);
+        }
+    }
+    for (ClusterBlockId blk : clb_nlist.blocks()) {
+        if (block_anneal_region_[blk] >= 0) {
+            anneal_regions_[block_anneal_region_[blk]]->movable_blocks.push_back(blk);
+        }
+    }
+}
+
+t_bb PlacementAnnealer::t_region_partition::region_bb(int iregion) const {
+    const int col = iregion % num_cols;
+    const int row = (iregion / num_cols) % num_rows;
+    const int die = iregion / (num_cols * num_rows);
+    const int die_col = die % num_die_cols;
+    const int die_row = (die / num_die_cols) % num_die_rows;
+    const int layer = die / (num_die_cols * num_die_rows);
+
+    // The dies are contiguous ranges of columns and rows
+    const std::vector<int>& layer_die_cols = die_col_at_x[layer];
+    const std::vector<int>& layer_die_rows = die_row_at_y[layer];
+    const int die_xmin = std::lower_bound(layer_die_cols.begin(), layer_die_cols.end(), die_col) - layer_die_cols.begin();
+    const int die_xmax = std::upper_bound(layer_die_cols.begin(), layer_die_cols.end(), die_col) - layer_die_cols.begin() - 1;
+    const int die_ymin = std::lower_bound(layer_die_rows.begin(), layer_die_rows.end(), die_row) - layer_die_rows.begin();
+    const int die_ymax = std::upper_bound(layer_die_rows.begin(), layer_die_rows.end(), die_row) - layer_die_rows.begin() - 1;
+
+    t_bb bb;
+    bb.xmin = std::max(die_xmin, col * width - x_offset);
+    bb.xmax = std::min(die_xmax, (col + 1) * width - x_offset - 1);
+    bb.ymin = std::max(die_ymin, row * height - y_offset);
+    bb.ymax = std::min(die_ymax, (row + 1) * height - y_offset - 1);
+    bb.layer_min = layer;
+    bb.layer_max = layer;
+    return bb;
+}
+
+void PlacementAnnealer::try_swap_regions_(MoveGenerator& move_generator, const t_place_algorithm& place_algorithm, int num_moves) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    auto& blk_loc_registry = placer_state_.mutable_blk_loc_registry();
+
+    VTR_ASSERT_SAFE(place_algorithm == e_place_algorithm::CRITICALITY_TIMING_PLACE
+                    || place_algorithm == e_place_algorithm::BOUNDING_BOX_PLACE);
+
+    partition_anneal_regions_();
+    const std::vector<size_t>& regions = region_partition_.regions;
+    const size_t num_regions = regions.size();
+
+    // Split the swap attempts between the regions in proportion to the number of blocks they can move,
+    // and give the share of the blocks kept in place by a die or layer boundary to the serial phase
+    size_t num_movable_blocks = 0;
+    for (size_t iregion : regions) {
+        num_movable_blocks += anneal_regions_[iregion]->movable_blocks.size();
+    }
+    const size_t num_interdie_blocks = region_partition_.num_interdie_blocks;
+    int num_serial_moves = 0;
+    if (num_interdie_blocks > 0) {
+        num_serial_moves = int(int64_t(num_moves) * num_interdie_blocks / (num_movable_blocks + num_interdie_blocks));
+    }
+    const int num_region_moves = num_moves - num_serial_moves;
+
+    int num_assigned_moves = 0;
+    for (size_t iregion : regions) {
+        t_anneal_region& region = *anneal_regions_[iregion];
+        region.num_moves = 0;
+        if (num_movable_blocks > 0) {
+            region.num_moves = int(int64_t(num_region_moves) * region.movable_blocks.size() / num_movable_blocks);
+        }
+        num_assigned_moves += region.num_moves;
+    }
+    for (size_t i = 0; num_movable_blocks > 0 && num_assigned_moves < num_region_moves; i = (i + 1) % num_regions) {
+        t_anneal_region& region = *anneal_regions_[regions[i]];
+        if (!region.movable_blocks.empty()) {
+            region.num_moves++;
+            num_assigned_moves++;
+        }
+    }
+
+    // Swap attempts left over when no block can move are aborted
+    swap_stats_.num_ts_called += num_region_moves - num_assigned_moves;
+    swap_stats_.num_swap_aborted += num_region_moves - num_assigned_moves;
+
+    // Each region draws from its own counter-based stream, so the moves of a region don't depend on
+    // the other regions, on the number of threads or on the main random number stream.
+    for (size_t iregion : regions) {
+        t_anneal_region& region = *anneal_regions_[iregion];
+        region.rng.seed_stream(placer_opts_.seed, REGION_ANNEAL_RNG_STAGE, (uint64_t(num_region_anneals_) << 32) | iregion);
+        region.swap_stats = t_swap_stats();
+        region.placer_stats.reset();
+        region.costs = costs_;
+        region.delta_c = 0.;
+        region.bb_delta_c = 0.;
+        region.timing_delta_c = 0.;
+        region.changed_pins.clear();
+    }
+    num_region_anneals_++;
+
+    // Moves are limited to a region anyway, so a larger range limit would only cause aborted moves
+    const float rlim = std::min<float>(annealing_state_.rlim, std::max(region_partition_.width, region_partition_.height));
+
+    auto anneal_region = [&](size_t i) {
+        const size_t iregion = regions[i];
+        t_anneal_region& region = *anneal_regions_[iregion];
+        t_pl_blocks_to_be_moved& blocks_affected = region.blocks_affected;
+        const int num_region_blocks = region.movable_blocks.size();
+
+        for (int imove = 0; imove < region.num_moves; imove++) {
+            region.swap_stats.num_ts_called++;
+
+            ClusterBlockId b_from = region.movable_blocks[region.rng.irand(num_region_blocks - 1)];
+            const t_pl_loc from = blk_loc_registry.block_locs()[b_from].loc;
+            t_pl_loc to;
+            // Only the locations of the region are searched, since the other regions are changing theirs
+            bool valid = find_to_loc_uniform(clb_nlist.block_type(b_from), rlim, from, to, b_from, blk_loc_registry, region.rng, &region.bb);
+
+            // The block at the destination (if any) must also be movable by the region
+            VTR_ASSERT_DEBUG(!valid || region_partition_.region_at(to.x, to.y, to.layer) == int(iregion));
+            if (valid) {
+                ClusterBlockId b_to = blk_loc_registry.grid_blocks().block_at_location(to);
+                valid = !b_to || block_anneal_region_[b_to] == int(iregion);
+            }
+
+            valid = valid
+                    && create_move(blocks_affected, b_from, to, blk_loc_registry, place_macros_) == e_create_move::VALID
+                    && floorplan_legal(blocks_affected);
+
+            if (!valid) {
+                region.swap_stats.num_swap_aborted++;
+                blocks_affected.clear_move_blocks();
+                continue;
+            }
+
+            blk_loc_registry.apply_move_blocks(blocks_affected);
+
+            double bb_delta_c = 0.;
+            double timing_delta_c = 0.;
+            net_cost_handler_.find_affected_nets_and_update_costs(delay_model_, criticalities_, blocks_affected,
+                                                                  bb_delta_c, timing_delta_c, region.affected_nets);
+
+            double delta_c;
+            if (place_algorithm == e_place_algorithm::CRITICALITY_TIMING_PLACE) {
+                delta_c = (1 - placer_opts_.timing_tradeoff) * bb_delta_c * costs_.bb_cost_norm
+                          + placer_opts_.timing_tradeoff * timing_delta_c * costs_.timing_cost_norm;
+            } else {
+                delta_c = bb_delta_c * costs_.bb_cost_norm;
+            }
+
+            if (assess_swap_(delta_c, annealing_state_.t, region.rng) == e_move_result::ACCEPTED) {
+                region.costs.cost += delta_c;
+                region.costs.bb_cost += bb_delta_c;
+                region.delta_c += delta_c;
+                region.bb_delta_c += bb_delta_c;
+
+                if (place_algorithm == e_place_algorithm::CRITICALITY_TIMING_PLACE) {
+                    region.costs.timing_cost += timing_delta_c;
+                    region.timing_delta_c += timing_delta_c;
+
+                    // The timing graph is shared by all regions, its edges are invalidated after the regions are done
+                    region.changed_pins.insert(region.changed_pins.end(), blocks_affected.affected_pins.begin(), blocks_affected.affected_pins.end());
+                    placer_state_.mutable_timing().commit_td_cost(blocks_affected);
+                }
+
+                net_cost_handler_.update_move_nets(region.affected_nets);
+                blk_loc_registry.commit_move_blocks(blocks_affected);
+
+                region.placer_stats.single_swap_update(region.costs);
+                region.swap_stats.num_swap_accepted++;
+            } else {
+                net_cost_handler_.reset_move_nets(region.affected_nets);
+                blk_loc_registry.revert_move_blocks(blocks_affected);
+
+                if (place_algorithm == e_place_algorithm::CRITICALITY_TIMING_PLACE) {
+                    placer_state_.mutable_timing().revert_td_cost(blocks_affected);
+                }
+
+                region.swap_stats.num_swap_rejected++;
+            }
+
+            blocks_affected.clear_move_blocks();
+        }
+    };
+
+#if defined(VPR_USE_TBB)
+    if (placer_opts_.numa_aware_threads) {
+        // Each region runs on the same pinned worker every time, so its state stays in that worker's memory
+        tbb::parallel_for(size_t(0), num_regions, anneal_region, tbb::static_partitioner());
+    } else {
+        tbb::parallel_for(size_t(0), num_regions, anneal_region);
+    }
+#else
+    for (size_t i = 0; i < num_regions; i++) {
+        anneal_region(i);
+    }
+#endif
+
+    // Merge the results of the regions in a fixed order
+    for (size_t iregion : regions) {
+        const t_anneal_region& region = *anneal_regions_[iregion];
+
+        costs_.cost += region.delta_c;
+        costs_.bb_cost += region.bb_delta_c;
+        costs_.timing_cost += region.timing_delta_c;
+
+        for (ClusterPinId pin : region.changed_pins) {
+            pin_timing_invalidator_->invalidate_connection(pin);
+        }
+
+        // Each region recorded its accepted swaps with its own view of the placement cost
+        // (the cost before the regions started plus the changes it made)
+        placer_stats_.merge(region.placer_stats);
+
+        swap_stats_.num_ts_called += region.swap_stats.num_ts_called;
+        swap_stats_.num_swap_accepted += region.swap_stats.num_swap_accepted;
+        swap_stats_.num_swap_rejected += region.swap_stats.num_swap_rejected;
+        swap_stats_.num_swap_aborted += region.swap_stats.num_swap_aborted;
+    }
+
+    // Serial phase: the moves the regions can't make, of the blocks connected to other dies or layers
+    for (int imove = 0; imove < num_serial_moves; imove++) {
+        t_swap_result swap_result = try_swap_(move_generator, place_algorithm, false);
+        record_swap_result_(swap_result);
+    }
+}
+
 void PlacementAnnealer::outer_loop_update_timing_info() {
     if (placer_opts_.place_algorithm.is_timing_driven()) {
         /* At each temperature change we update these values to be used
@@ -802,8 +1401,12 @@ void PlacementAnnealer::outer_loop_update_timing_info() {
                                         placer_opts_.place_crit_limit};
 
             // Update all timing related classes
+            const MoveProfiler::clock::time_point timing_start = move_profiler_.now();
             perform_full_timing_update(crit_params, delay_model_, criticalities_, setup_slacks_,
                                        pin_timing_invalidator_, timing_info_, &costs_, placer_state_);
+            if (move_profiler_.enabled()) {
+                move_profiler_.record_timing_update(move_profiler_.now() - timing_start);
+            }
 
             outer_crit_iter_count_ = 0;
         }
@@ -818,6 +1421,8 @@ void PlacementAnnealer::outer_loop_update_timing_info() {
 }
 
 void PlacementAnnealer::placement_inner_loop() {
+    VTR_PROFILE_ZONE("Placement temperature");
+
     // How many times have we dumped placement to a file this temperature?
     int inner_placement_save_count = 0;
 
@@ -828,8 +1433,15 @@ void PlacementAnnealer::placement_inner_loop() {
     MoveGenerator& move_generator = select_move_generator(move_generator_1_, move_generator_2_, agent_state_,
                                                           placer_opts_, quench_started_);
 
+    // Moves can be evaluated in parallel unless a move's cost depends on a timing
+    // analysis (slack_timing) or on the NoC, whose costs are shared by all the moves
+    const bool parallel_moves = placer_opts_.place_algorithm != e_place_algorithm::SLACK_TIMING_PLACE
+                                && !noc_opts_.noc;
+    const bool speculative_moves = parallel_moves && placer_opts_.speculative_moves > 1;
+    const bool region_moves = parallel_moves && placer_opts_.parallel_regions > 1;
+
     // Inner loop begins
-    for (int inner_iter = 0, inner_crit_iter_count = 1; inner_iter < annealing_state_.move_lim; inner_iter++) {
+    for (int inner_iter = 0, inner_crit_iter_count = 1; inner_iter < annealing_state_.move_lim;) {
 #ifndef NO_GRAPHICS
         // Checks manual move flag for manual move feature
         t_draw_state* draw_state = get_draw_state_vars();
@@ -838,74 +1450,89 @@ void PlacementAnnealer::placement_inner_loop() {
         }
 #endif /*NO_GRAPHICS*/
 
-        t_swap_result swap_result = try_swap_(move_generator, placer_opts_.place_algorithm, manual_move_enabled);
-
-        if (swap_result.move_result == e_move_result::ACCEPTED) {
-            // Move was accepted.  Update statistics that are useful for the annealing schedule.
-            placer_stats_.single_swap_update(costs_);
-            swap_stats_.num_swap_accepted++;
-        } else if (swap_result.move_result == e_move_result::ABORTED) {
-            swap_stats_.num_swap_aborted++;
-        } else { // swap_result == REJECTED
-            swap_stats_.num_swap_rejected++;
+        int num_moves = 1;
+        if (speculative_moves && !manual_move_enabled) {
+            num_moves = std::min(placer_opts_.speculative_moves, annealing_state_.move_lim - inner_iter);
+            try_swap_batch_(move_generator, placer_opts_.place_algorithm, num_moves);
+        } else if (region_moves && !manual_move_enabled) {
+            num_moves = annealing_state_.move_lim - inner_iter;
+            if (placer_opts_.place_algorithm.is_timing_driven()) {
+                // Stop at the next timing update, so that criticalities are as up to date as in serial annealing
+                const int recompute_limit = quench_started_ ? quench_recompute_limit_ : inner_recompute_limit_;
+                num_moves = std::min(num_moves, std::max(1, recompute_limit - inner_crit_iter_count + 1));
+            }
+            try_swap_regions_(move_generator, placer_opts_.place_algorithm, num_moves);
+        } else {
+            t_swap_result swap_result = try_swap_(move_generator, placer_opts_.place_algorithm, manual_move_enabled);
+            record_swap_result_(swap_result);
         }
 
-        if (placer_opts_.place_algorithm.is_timing_driven()) {
-            /* Do we want to re-timing analyze the circuit to get updated slack and criticality values?
-             * We do this only once in a while, since it is expensive.
-             */
-            const int recompute_limit = quench_started_ ? quench_recompute_limit_ : inner_recompute_limit_;
-            // on last iteration don't recompute
-            if (inner_crit_iter_count >= recompute_limit && inner_iter != annealing_state_.move_lim - 1) {
+        for (int imove = 0; imove < num_moves; imove++, inner_iter++) {
+            if (placer_opts_.place_algorithm.is_timing_driven()) {
+                /* Do we want to re-timing analyze the circuit to get updated slack and criticality values?
+                 * We do this only once in a while, since it is expensive.
+                 */
+                const int recompute_limit = quench_started_ ? quench_recompute_limit_ : inner_recompute_limit_;
+                // on last iteration don't recompute
+                if (inner_crit_iter_count >= recompute_limit && inner_iter != annealing_state_.move_lim - 1) {
+
+                    inner_crit_iter_count = 0;
+
+                    PlaceCritParams crit_params{annealing_state_.crit_exponent,
+                                                placer_opts_.place_crit_limit};
+
+                    // Update all timing related classes
+                    const MoveProfiler::clock::time_point timing_start = move_profiler_.now();
+                    perform_full_timing_update(crit_params, delay_model_, criticalities_,
+                                               setup_slacks_, pin_timing_invalidator_,
+                                               timing_info_, &costs_, placer_state_);
+                    if (move_profiler_.enabled()) {
+                        move_profiler_.record_timing_update(move_profiler_.now() - timing_start);
+                    }
+                }
+                inner_crit_iter_count++;
+            }
 
-                inner_crit_iter_count = 0;
+            /* Lines below prevent too much round-off error from accumulating
+             * in the cost over many iterations (due to incremental updates).
+             * This round-off can lead to error checks failing because the cost
+             * is different from what you get when you recompute from scratch.
+             */
+            moves_since_cost_recompute_++;
+            if (moves_since_cost_recompute_ > MAX_MOVES_BEFORE_RECOMPUTE) {
+                net_cost_handler_.recompute_costs_from_scratch(delay_model_, criticalities_, costs_);
 
-                PlaceCritParams crit_params{annealing_state_.crit_exponent,
-                                            placer_opts_.place_crit_limit};
+                if (noc_cost_handler_.has_value()) {
+                    noc_cost_handler_->recompute_costs_from_scratch(noc_opts_, costs_);
+                }
 
-                // Update all timing related classes
-                perform_full_timing_update(crit_params, delay_model_, criticalities_,
-                                           setup_slacks_, pin_timing_invalidator_,
-                                           timing_info_, &costs_, placer_state_);
+                moves_since_cost_recompute_ = 0;
             }
-            inner_crit_iter_count++;
-        }
-
-        /* Lines below prevent too much round-off error from accumulating
-         * in the cost over many iterations (due to incremental updates).
-         * This round-off can lead to error checks failing because the cost
-         * is different from what you get when you recompute from scratch.
-         */
-        moves_since_cost_recompute_++;
-        if (moves_since_cost_recompute_ > MAX_MOVES_BEFORE_RECOMPUTE) {
-            net_cost_handler_.recompute_costs_from_scratch(delay_model_, criticalities_, costs_);
 
-            if (noc_cost_handler_.has_value()) {
-                noc_cost_handler_->recompute_costs_from_scratch(noc_opts_, costs_);
+            if (placer_opts_.placement_saves_per_temperature >= 1 && inner_iter > 0
+                && (inner_iter + 1) % (annealing_state_.move_lim / placer_opts_.placement_saves_per_temperature) == 0) {
+                std::string filename = vtr::string_fmt("placement_%03d_%03d.place",
+                                                       annealing_state_.num_temps + 1, inner_placement_save_count);
+                VTR_LOG("Saving placement to file at temperature move %d / %d: %s\n",
+                        inner_iter, annealing_state_.move_lim, filename.c_str());
+                print_place(nullptr, nullptr, filename.c_str(), placer_state_.block_locs());
+                ++inner_placement_save_count;
             }
-
-            moves_since_cost_recompute_ = 0;
-        }
-
-        if (placer_opts_.placement_saves_per_temperature >= 1 && inner_iter > 0
-            && (inner_iter + 1) % (annealing_state_.move_lim / placer_opts_.placement_saves_per_temperature) == 0) {
-            std::string filename = vtr::string_fmt("placement_%03d_%03d.place",
-                                                   annealing_state_.num_temps + 1, inner_placement_save_count);
-            VTR_LOG("Saving placement to file at temperature move %d / %d: %s\n",
-                    inner_iter, annealing_state_.move_lim, filename.c_str());
-            print_place(nullptr, nullptr, filename.c_str(), placer_state_.block_locs());
-            ++inner_placement_save_count;
         }
     }
 
 #ifdef VPR_USE_SIGACTION
-    // Save the block locations after each inner loop for checkpointing.
-    g_vpr_ctx.mutable_placement().mutable_block_locs() = placer_state_.block_locs();
+    // Save the block locations after each inner loop for checkpointing (the placers of a multi-seed placement do not share them).
+    if (placer_opts_.num_seeds <= 1) {
+        g_vpr_ctx.mutable_placement().mutable_block_locs() = placer_state_.block_locs();
+    }
 #endif
 
     // Calculate the success_rate and std_dev of the costs.
     placer_stats_.calc_iteration_stats(costs_, annealing_state_.move_lim);
 
+    move_profiler_.end_temperature(annealing_state_.num_temps + 1, annealing_state_.t, annealing_state_.rlim);
+
     // update the RL agent's state
     if (!quench_started_) {
         if (placer_opts_.place_algorithm.is_timing_driven() && placer_opts_.place_agent_multistate && agent_state_ == e_agent_state::EARLY_IN_THE_ANNEAL) {
@@ -1011,7 +1638,7 @@ void PlacementAnnealer::LOG_MOVE_STATS_OUTCOME(double delta_cost, double delta_b
     }
 }
 
-e_move_result PlacementAnnealer::assess_swap_(double delta_c, double t) {
+e_move_result PlacementAnnealer::assess_swap_(double delta_c, double t, vtr::RngContainer& rng) {
     /* Returns: 1 -> move accepted, 0 -> rejected. */
     VTR_LOGV_DEBUG(g_vpr_ctx.placement().f_placer_debug, "\tTemperature is: %e delta_c is %e\n", t, delta_c);
     if (delta_c <= 0) {
@@ -1024,7 +1651,7 @@ e_move_result PlacementAnnealer::assess_swap_(double delta_c, double t) {
         return e_move_result::REJECTED;
     }
 
-    float fnum = rng_.frand();
+    float fnum = rng.frand();
     float prob_fac = std::exp(-delta_c / t);
     if (prob_fac > fnum) {
         VTR_LOGV_DEBUG(g_vpr_ctx.placement().f_placer_debug, "\t\tMove is accepted(hill climbing)\n");
@@ -5,10 +5,14 @@
 #include "move_generator.h" // movestats
 #include "net_cost_handler.h"
 #include "manual_move_generator.h"
+#include "move_profiler.h"
 #include "vtr_random.h"
 
+#include <memory>
 #include <optional>
 #include <tuple>
+#include <unordered_set>
+#include <vector>
 
 class PlaceMacros;
 class PlacerState;
@@ -108,6 +112,14 @@ class t_annealing_state {
                            const t_placer_costs& costs,
                            const t_placer_opts& placer_opts);
 
+  public: //Accessor
+    /**
+     * @brief Estimates the number of temperatures left before the exit criterion of the
+     * annealing schedule is met, assuming the current cooling rate is kept.
+     */
+    int estimate_remaining_temps(const t_placer_costs& costs,
+                                 const t_placer_opts& placer_opts) const;
+
   private: //Mutator
     /**
      * @brief Update the range limiter to keep acceptance prob. near 0.44.
@@ -263,6 +275,58 @@ class PlacementAnnealer {
                             const t_place_algorithm& place_algorithm,
                             bool manual_move_enabled);
 
+    /**
+     * @brief Speculative parallel counterpart of try_swap_(): makes num_moves swap attempts at once.
+     *
+     * All the moves are proposed against the current placement, and kept only if they move
+     * different blocks, use different locations and affect different nets than the moves
+     * proposed before them in the batch (conflicting ones are aborted). The kept moves are
+     * applied and their cost changes evaluated concurrently. They are then accepted or rejected
+     * one after the other in proposal order. As the moves of a batch don't share any net, the
+     * cost change of each move is the same as if it was evaluated after the previous ones.
+     *
+     * Only supports the bounding_box and criticality_timing algorithms, without NoC costs or
+     * manual moves. The outcome of each swap attempt is recorded with record_swap_result_().
+     */
+    void try_swap_batch_(MoveGenerator& move_generator,
+                         const t_place_algorithm& place_algorithm,
+                         int num_moves);
+
+    /**
+     * @brief Returns true and reserves the blocks, locations and nets of the proposed move if
+     * none of them is used by a move already in the current speculative batch.
+     */
+    bool reserve_speculative_move_(const t_pl_blocks_to_be_moved& blocks_affected);
+
+    /// @brief Updates the swap statistics with the outcome of a swap attempt.
+    void record_swap_result_(const t_swap_result& swap_result);
+
+    /**
+     * @brief Region partitioned parallel counterpart of try_swap_(): makes num_moves swap attempts
+     * spread over the regions of a partition of the device.
+     *
+     * Each region moves its own blocks to locations inside the region, with uniform moves and its
+     * own random number generator, in parallel with the other regions. A block is only moved by
+     * its region if all the blocks it is connected to are in the same region, so the regions never
+     * update the same nets. The swap attempts of each region are made one after the other, and
+     * the regions are seeded and merged in a fixed order, so results don't depend on the number
+     * of threads. The region boundaries are shifted at every temperature.
+     *
+     * Regions never span several dies or layers. The nets between dies and layers are handled in a
+     * separate, serial phase after the regions: the share of the swap attempts of the blocks kept in
+     * place by them is made with try_swap_() and \p move_generator.
+     *
+     * Only supports the bounding_box and criticality_timing algorithms, without NoC costs or
+     * manual moves.
+     */
+    void try_swap_regions_(MoveGenerator& move_generator, const t_place_algorithm& place_algorithm, int num_moves);
+
+    /**
+     * @brief Partitions each die of the device into placer_opts_.parallel_regions^2 regions (offset
+     * according to the current temperature), and finds the blocks each region can move.
+     */
+    void partition_anneal_regions_();
+
     /**
      * @brief Determines whether a move should be accepted or not.
      * Moves with negative delta cost are always accepted, but
@@ -270,9 +334,10 @@ class PlacementAnnealer {
      * probability that diminishes as the temperature decreases.
      * @param delta_c The cost difference if the move is accepted.
      * @param t The annealer's temperature.
+     * @param rng Random number generator used for hill climbing moves.
      * @return Whether the move is accepted or not.
      */
-    e_move_result assess_swap_(double delta_c, double t);
+    e_move_result assess_swap_(double delta_c, double t, vtr::RngContainer& rng);
 
     /// @brief Find the starting temperature for the annealing loop.
     float estimate_starting_temperature_();
@@ -315,6 +380,8 @@ class PlacementAnnealer {
     SetupTimingInfo* timing_info_;
     NetPinTimingInvalidator* pin_timing_invalidator_;
     std::unique_ptr<FILE, decltype(&vtr::fclose)> move_stats_file_;
+    /// Times the moves of each move type, if requested (--place_move_profile)
+    MoveProfiler move_profiler_;
     int outer_crit_iter_count_;
 
     t_annealing_state annealing_state_;
@@ -326,7 +393,106 @@ class PlacementAnnealer {
     /// Keep record of moved blocks and affected pins in a swap
     t_pl_blocks_to_be_moved blocks_affected_;
 
+    /// A move of a speculative batch, see try_swap_batch_()
+    struct t_speculative_move {
+        explicit t_speculative_move(size_t max_blocks)
+            : blocks_affected(max_blocks) {}
+
+        t_pl_blocks_to_be_moved blocks_affected;
+        std::vector<ClusterNetId> affected_nets;
+        t_propose_action proposed_action;
+        /// Time spent proposing the move, when profiling moves
+        MoveProfiler::clock::duration propose_time{};
+        /// Move generator action which proposed the move
+        size_t agent_action = 0;
+        /// False if the move was aborted
+        bool valid = false;
+        double bb_delta_c = 0.;
+        double timing_delta_c = 0.;
+    };
+
+    /// Moves of the current speculative batch
+    std::vector<std::unique_ptr<t_speculative_move>> speculative_moves_;
+    /// Blocks, locations and nets used by the moves of the current speculative batch
+    vtr::vector<ClusterBlockId, bool> speculative_blocks_;
+    std::unordered_set<t_pl_loc> speculative_locs_;
+    vtr::vector<ClusterNetId, bool> speculative_nets_;
+
+    /// A region of the device annealed by try_swap_regions_()
+    struct t_anneal_region {
+        explicit t_anneal_region(size_t max_blocks)
+            : blocks_affected(max_blocks) {}
+
+        t_pl_blocks_to_be_moved blocks_affected;
+        std::vector<ClusterNetId> affected_nets;
+        /// Blocks the region can move, i.e. blocks only connected to blocks of the same region
+        std::vector<ClusterBlockId> movable_blocks;
+        /// Grid locations of the region: the swaps of its blocks only look for destinations in there
+        t_bb bb;
+        /// Sink pins whose connection delay was changed by the accepted moves
+        std::vector<ClusterPinId> changed_pins;
+        vtr::RngContainer rng;
+        /// Number of swap attempts in the current call to try_swap_regions_()
+        int num_moves = 0;
+        t_swap_stats swap_stats;
+        t_placer_statistics placer_stats;
+        /// Placement costs, updated by the accepted moves of the region only
+        t_placer_costs costs;
+        /// Sum of the cost changes of the accepted moves
+        double delta_c = 0.;
+        double bb_delta_c = 0.;
+        double timing_delta_c = 0.;
+    };
+
+    /**
+     * @brief Bounds of the regions of the current partition: region (col, row) starts at x = col * width - x_offset.
+     *
+     * The regions are also split at the layer and die (interposer cut) boundaries, which don't move between
+     * temperatures: each (col, row) region has one part per die of each layer.
+     */
+    struct t_region_partition {
+        int width = 1;
+        int height = 1;
+        int x_offset = 0;
+        int y_offset = 0;
+        int num_cols = 0;
+        int num_rows = 0;
+        /// Number of dies of the device, over all its layers
+        int num_dies = 1;
+        /// Die of each location: [layer][x] is the die column, and [layer][y] the die row, of the locations of the layer
+        std::vector<std::vector<int>> die_col_at_x;
+        std::vector<std::vector<int>> die_row_at_y;
+        /// Die columns and rows of each layer (the largest numbers over the layers)
+        int num_die_cols = 1;
+        int num_die_rows = 1;
+        /// Movable blocks kept in place because they connect to another die or layer
+        size_t num_interdie_blocks = 0;
+        /// Indices of the regions of anneal_regions_ which exist (hold or held blocks), in increasing order
+        std::vector<size_t> regions;
+
+        int die_at(int x, int y, int layer) const {
+            return (layer * num_die_rows + die_row_at_y[layer][y]) * num_die_cols + die_col_at_x[layer][x];
+        }
+
+        int region_at(int x, int y, int layer) const {
+            return (die_at(x, y, layer) * num_rows + (y + y_offset) / height) * num_cols + (x + x_offset) / width;
+        }
+
+        /// Grid locations of region iregion, the inverse of region_at()
+        t_bb region_bb(int iregion) const;
+    };
+
+    std::vector<std::unique_ptr<t_anneal_region>> anneal_regions_;
+    t_region_partition region_partition_;
+    /// Number of calls to try_swap_regions_(), which (with the region index) identifies the random stream of each region
+    uint32_t num_region_anneals_ = 0;
+    /// Index of the region which can move each block, or -1 if the block stays in place
+    vtr::vector<ClusterBlockId, int> block_anneal_region_;
+
   private:
+    /// Stage id of the per-region random number streams (see vtr::PhiloxRandomNumberGenerator)
+    static constexpr uint32_t REGION_ANNEAL_RNG_STAGE = 1;
+
     /**
      * @brief The maximum number of swap attempts before invoking the
      * once-in-a-while placement legality check as well as floating point
@@ -0,0 +1,50 @@
+#include "annealing_convergence_monitor.h"
+
+AnnealingConvergenceMonitor::AnnealingConvergenceMonitor(float threshold, int window)
+    : threshold_(threshold)
+    , window_(window) {}
+
+void AnnealingConvergenceMonitor::add_temperature(double start_cost, double end_cost, int num_moves, float elapsed_sec) {
+    double gain = start_cost > 0. ? (start_cost - end_cost) / start_cost : 0.;
+    if (gain >= threshold_) {
+        improving_ = true;
+    }
+
+    temperatures_.push_back({gain, num_moves, elapsed_sec});
+    if ((int)temperatures_.size() > window_) {
+        temperatures_.pop_front();
+    }
+}
+
+double AnnealingConvergenceMonitor::predicted_gain(int num_moves) const {
+    double total_gain = 0.;
+    long total_moves = 0;
+    for (const t_temperature_gain& temperature : temperatures_) {
+        total_gain += temperature.gain;
+        total_moves += temperature.num_moves;
+    }
+
+    if (total_moves == 0) {
+        return 0.;
+    }
+    // The gains per move of the recent temperatures, scaled to the moves of the next one
+    return total_gain / total_moves * num_moves;
+}
+
+bool AnnealingConvergenceMonitor::converged(int num_moves) const {
+    return improving_
+           && (int)temperatures_.size() == window_
+           && predicted_gain(num_moves) < threshold_;
+}
+
+float AnnealingConvergenceMonitor::average_temperature_time() const {
+    if (temperatures_.empty()) {
+        return 0.;
+    }
+
+    float total_time = 0.;
+    for (const t_temperature_gain& temperature : temperatures_) {
+        total_time += temperature.elapsed_sec;
+    }
+    return total_time / temperatures_.size();
+}
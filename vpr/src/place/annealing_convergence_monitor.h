@@ -0,0 +1,63 @@
+#pragma once
+/**
+ * @file annealing_convergence_monitor.h
+ * @brief Declares the AnnealingConvergenceMonitor class, which ends the anneal once it stops improving the placement.
+ *
+ * Late in the anneal, the temperatures still evaluate as many moves as the earlier ones while
+ * improving the placement very little. With --anneal_convergence_threshold, the placer records
+ * how much each temperature improved the placement cost, predicts the improvement of the next
+ * temperature from the recent ones, and goes on to the quench when it falls below the threshold.
+ */
+
+#include <deque>
+
+class AnnealingConvergenceMonitor {
+  public:
+    /// The number of recent temperatures the improvement of the next one is predicted from
+    static constexpr int DEFAULT_WINDOW = 3;
+
+    /**
+     * @param threshold The anneal has converged when the predicted relative cost improvement
+     * of the next temperature is below this fraction of the cost.
+     * @param window The number of recent temperatures the prediction is made from.
+     */
+    explicit AnnealingConvergenceMonitor(float threshold, int window = DEFAULT_WINDOW);
+
+    /**
+     * @brief Records a temperature of the anneal.
+     * @param start_cost The placement cost before the temperature's moves.
+     * @param end_cost The placement cost after them (with the same normalization).
+     * @param num_moves The number of moves evaluated.
+     * @param elapsed_sec The wall time of the temperature.
+     */
+    void add_temperature(double start_cost, double end_cost, int num_moves, float elapsed_sec);
+
+    /// @brief Predicts the relative cost improvement of a next temperature of num_moves moves from the recent temperatures.
+    double predicted_gain(int num_moves) const;
+
+    /**
+     * @brief Whether the anneal has converged, i.e. the predicted improvement of a next temperature of
+     * num_moves moves is below the threshold.
+     *
+     * @details Hot temperatures accept most moves and usually make the placement worse, so the anneal
+     * only converges once a temperature has improved the placement by at least the threshold.
+     */
+    bool converged(int num_moves) const;
+
+    /// @brief The average wall time of the recent temperatures.
+    float average_temperature_time() const;
+
+  private:
+    struct t_temperature_gain {
+        double gain; ///<Relative cost improvement
+        int num_moves;
+        float elapsed_sec;
+    };
+
+    const float threshold_;
+    const int window_;
+    /// The recent temperatures (at most window_)
+    std::deque<t_temperature_gain> temperatures_;
+    /// Whether a temperature has improved the placement by at least the threshold
+    bool improving_ = false;
+};
@@ -37,6 +37,9 @@ std::vector<t_compressed_block_grid> create_compressed_block_grids() {
         block_locations[block_type.index].resize(num_layers);
     }
 
+    // The logical block types each physical tile type found in the grid can implement (computed once per tile type)
+    std::unordered_map<t_physical_tile_type_ptr, std::vector<int>> tile_block_types;
+
     for (int layer_num = 0; layer_num < num_layers; layer_num++) {
         for (int x = 0; x < (int)grid.width(); ++x) {
             for (int y = 0; y < (int)grid.height(); ++y) {
@@ -45,11 +48,16 @@ std::vector<t_compressed_block_grid> create_compressed_block_grids() {
 
                 if (width_offset == 0 && height_offset == 0) { // the bottom left corner of a tile
                     const auto& type = grid.get_physical_type({x, y, layer_num});
-                    auto equivalent_sites = get_equivalent_sites_set(type);
+                    auto [type_itr, inserted] = tile_block_types.try_emplace(type);
+                    if (inserted) {
+                        for (t_logical_block_type_ptr block_type : get_equivalent_sites_set(type)) {
+                            type_itr->second.push_back(block_type->index);
+                        }
+                    }
 
-                    for (t_logical_block_type_ptr block_type : equivalent_sites) {
+                    for (int block_type_index : type_itr->second) {
                         //Only record at block root location
-                        block_locations[block_type->index][layer_num].emplace_back(x, y);
+                        block_locations[block_type_index][layer_num].emplace_back(x, y);
                     }
                 }
             }
@@ -82,7 +90,7 @@ std::vector<t_compressed_block_grid> create_compressed_block_grids() {
             compressed_block_grid.compatible_sub_tiles_for_tile.insert({physical_tile->index, compatible_sub_tiles});
         }
 
-        compressed_type_grids[logical_block.index] = compressed_block_grid;
+        compressed_type_grids[logical_block.index] = std::move(compressed_block_grid);
     }
 
     return compressed_type_grids;
@@ -111,10 +119,10 @@ static t_compressed_block_grid create_compressed_block_grid(const std::vector<st
             }
 
             //Uniquify x/y locations
-            std::stable_sort(layer_x_locs.begin(), layer_x_locs.end());
+            std::sort(layer_x_locs.begin(), layer_x_locs.end());
             layer_x_locs.erase(unique(layer_x_locs.begin(), layer_x_locs.end()), layer_x_locs.end());
 
-            std::stable_sort(layer_y_locs.begin(), layer_y_locs.end());
+            std::sort(layer_y_locs.begin(), layer_y_locs.end());
             layer_y_locs.erase(unique(layer_y_locs.begin(), layer_y_locs.end()), layer_y_locs.end());
 
             //The index of an x-position in x_locs corresponds to it's compressed
@@ -122,6 +130,8 @@ static t_compressed_block_grid create_compressed_block_grid(const std::vector<st
             if (!layer_x_locs.empty()) {
                 compressed_grid.compressed_to_grid_layer.push_back(layer_num);
             }
+            compressed_grid.grid_x_ranks.emplace_back(layer_x_locs);
+            compressed_grid.grid_y_ranks.emplace_back(layer_y_locs);
             compressed_grid.compressed_to_grid_x[layer_num] = std::move(layer_x_locs);
             compressed_grid.compressed_to_grid_y[layer_num] = std::move(layer_y_locs);
 
@@ -130,47 +140,68 @@ static t_compressed_block_grid create_compressed_block_grid(const std::vector<st
         }
     }
 
-    compressed_grid.grid.resize(num_layers);
+    compressed_grid.column_starts.resize(num_layers);
+    compressed_grid.column_rows.resize(num_layers);
     for (int layer_num = 0; layer_num < num_layers; layer_num++) {
-        auto& layer_compressed_grid = compressed_grid.grid[layer_num];
+        auto& column_starts = compressed_grid.column_starts[layer_num];
+        auto& column_rows = compressed_grid.column_rows[layer_num];
         const auto& layer_compressed_x_locs = compressed_grid.compressed_to_grid_x[layer_num];
-        const auto& layer_compressed_y_locs = compressed_grid.compressed_to_grid_y[layer_num];
         //
         //Build the compressed grid
         //
 
         //Create a full/dense x-dimension (since there must be at least one
-        //block per x location)
-        layer_compressed_grid.resize(layer_compressed_x_locs.size());
+        //block per x location): count the blocks of each column, then
+        //place each column's rows after the ones of the previous columns
+        column_starts.assign(layer_compressed_x_locs.size() + 1, 0);
+        for (auto point : locations[layer_num]) {
+            column_starts[compressed_grid.grid_x_ranks[layer_num].rank(point.x()) + 1]++;
+        }
+        for (size_t cx = 0; cx < layer_compressed_x_locs.size(); cx++) {
+            column_starts[cx + 1] += column_starts[cx];
+        }
 
         //Fill-in the y-dimensions
         //
-        //Note that we build the y-dimension sparsely (using a flat map), since
-        //there may not be full columns of blocks at each x location, this makes
-        //it efficient to find the non-empty blocks in the y dimension
+        //Note that we build the y-dimension sparsely, since there may not be
+        //full columns of blocks at each x location, this makes it efficient
+        //to find the non-empty blocks in the y dimension
+        column_rows.resize(locations[layer_num].size());
+        std::vector<int> column_ends(column_starts.begin(), column_starts.end() - 1);
         for (auto point : locations[layer_num]) {
             //Determine the compressed indices in the x & y dimensions
-            auto x_itr = std::lower_bound(layer_compressed_x_locs.begin(), layer_compressed_x_locs.end(), point.x());
-            int cx = std::distance(layer_compressed_x_locs.begin(), x_itr);
-
-            auto y_itr = std::lower_bound(layer_compressed_y_locs.begin(), layer_compressed_y_locs.end(), point.y());
-            int cy = std::distance(layer_compressed_y_locs.begin(), y_itr);
-
-            VTR_ASSERT(cx >= 0 && cx < (int)layer_compressed_x_locs.size());
-            VTR_ASSERT(cy >= 0 && cy < (int)layer_compressed_y_locs.size());
-
-            VTR_ASSERT(layer_compressed_x_locs[cx] == point.x());
-            VTR_ASSERT(layer_compressed_y_locs[cy] == point.y());
-
-            auto result = layer_compressed_grid[cx].insert(std::make_pair(cy, t_physical_tile_loc(point.x(), point.y(), layer_num)));
+            t_physical_tile_loc compressed_loc = compressed_grid.grid_loc_to_compressed_loc({point.x(), point.y(), layer_num});
+            column_rows[column_ends[compressed_loc.x]++] = compressed_loc.y;
+        }
 
-            VTR_ASSERT_MSG(result.second, "Duplicates should not exist in compressed grid space");
+        for (size_t cx = 0; cx < layer_compressed_x_locs.size(); cx++) {
+            auto column_begin = column_rows.begin() + column_starts[cx];
+            auto column_end = column_rows.begin() + column_starts[cx + 1];
+            std::sort(column_begin, column_end);
+            VTR_ASSERT_MSG(std::adjacent_find(column_begin, column_end) == column_end, "Duplicates should not exist in compressed grid space");
         }
     }
 
     return compressed_grid;
 }
 
+t_compressed_axis_rank::t_compressed_axis_rank(const std::vector<int>& sorted_coords)
+    : num_bits_(sorted_coords.empty() ? 0 : sorted_coords.back() + 1)
+    , num_coords_(sorted_coords.size()) {
+    bits_.resize((num_bits_ + 63) / 64, 0);
+    for (int coord : sorted_coords) {
+        VTR_ASSERT(coord >= 0);
+        bits_[coord / 64] |= uint64_t(1) << (coord % 64);
+    }
+
+    word_ranks_.resize(bits_.size());
+    int rank = 0;
+    for (size_t word = 0; word < bits_.size(); word++) {
+        word_ranks_[word] = rank;
+        rank += std::popcount(bits_[word]);
+    }
+}
+
 /*Print the contents of the compressed grids to an echo file*/
 void echo_compressed_grids(const char* filename, const std::vector<t_compressed_block_grid>& comp_grids) {
     FILE* fp;
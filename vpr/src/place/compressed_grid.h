@@ -1,12 +1,78 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
+#include <cstdint>
 #include "physical_types.h"
 
 #include "vtr_assert.h"
-#include "vtr_flat_map.h"
 #include "vpr_types.h"
 
+/**
+ * @brief Rank bitmap of the sorted grid coordinates along one axis (x or y) of a layer of a compressed grid.
+ *
+ * rank(coord) is the number of coordinates lower than coord, i.e. the index std::lower_bound() would find in
+ * the sorted coordinates, computed in constant time from one bit per grid coordinate (and a running count per
+ * 64 coordinates).
+ */
+class t_compressed_axis_rank {
+  public:
+    t_compressed_axis_rank() = default;
+
+    ///@brief Builds the bitmap of the given sorted (and unique) non-negative coordinates
+    explicit t_compressed_axis_rank(const std::vector<int>& sorted_coords);
+
+    inline int rank(int coord) const {
+        if (coord <= 0) {
+            return 0;
+        }
+        if (coord >= num_bits_) {
+            return num_coords_;
+        }
+        size_t word = coord / 64;
+        uint64_t lower_bits = bits_[word] & ((uint64_t(1) << (coord % 64)) - 1);
+        return word_ranks_[word] + std::popcount(lower_bits);
+    }
+
+  private:
+    std::vector<uint64_t> bits_;  ///<Bit i is set if i is one of the coordinates
+    std::vector<int> word_ranks_; ///<The number of coordinates in the words before each word of bits_
+    int num_bits_ = 0;
+    int num_coords_ = 0;
+};
+
+/**
+ * @brief The sorted compressed y coordinates (rows) a block type is found at in a column of a compressed grid.
+ *
+ * It is a view into the storage of the compressed grid, which stores the rows of all its columns contiguously.
+ */
+class t_compressed_column {
+  public:
+    typedef const int* const_iterator;
+
+    t_compressed_column(const_iterator begin, const_iterator end)
+        : begin_(begin)
+        , end_(end) {}
+
+    inline const_iterator begin() const { return begin_; }
+    inline const_iterator end() const { return end_; }
+    inline size_t size() const { return end_ - begin_; }
+    inline bool empty() const { return begin_ == end_; }
+
+    ///@brief The first row not lower than cy
+    inline const_iterator lower_bound(int cy) const { return std::lower_bound(begin_, end_, cy); }
+
+    ///@brief The first row greater than cy
+    inline const_iterator upper_bound(int cy) const { return std::upper_bound(begin_, end_, cy); }
+
+    ///@brief 1 if the block type is found at row cy of the column, 0 otherwise
+    inline size_t count(int cy) const { return std::binary_search(begin_, end_, cy) ? 1 : 0; }
+
+  private:
+    const_iterator begin_;
+    const_iterator end_;
+};
+
 struct t_compressed_block_grid {
     // The compressed grid of a block type stores only the coordinates that are occupied by that particular block type.
     // For instance, if a DSP block exists only in the 2nd, 3rd, and 5th columns, the compressed grid of X axis will solely store the values 2, 3, and 5.
@@ -20,11 +86,18 @@ struct t_compressed_block_grid {
     std::vector<std::vector<int>> compressed_to_grid_y; // [0...num_layers-1][0...num_rows-1] -> uncompressed y
     std::vector<int> compressed_to_grid_layer;          // [0...num_layers-1] -> uncompressed layer
 
+    //The inverse of compressed_to_grid_x/y: converts uncompressed x/y to compressed indices
+    std::vector<t_compressed_axis_rank> grid_x_ranks; // [0...num_layers-1]
+    std::vector<t_compressed_axis_rank> grid_y_ranks; // [0...num_layers-1]
+
     //The grid is stored with a full/dense x-dimension (since only
     //x values which exist are considered), while the y-dimension is
     //stored sparsely, since we may not have full columns of blocks.
-    //This makes it easy to check whether there exist
-    std::vector<std::vector<vtr::flat_map2<int, t_physical_tile_loc>>> grid;
+    //The rows of all the columns of a layer are stored contiguously (sorted
+    //within each column): the rows of column cx are
+    //column_rows[layer][column_starts[layer][cx]...column_starts[layer][cx+1]-1].
+    std::vector<std::vector<int>> column_starts; // [0...num_layers-1][0...num_columns]
+    std::vector<std::vector<int>> column_rows;   // [0...num_layers-1][0...num_blocks_on_layer-1] -> compressed y
 
     //The sub type compatibility for a given physical tile and a compressed block grid
     //corresponding to the possible placement location for a given logical block
@@ -41,17 +114,13 @@ struct t_compressed_block_grid {
     }
 
     inline t_physical_tile_loc grid_loc_to_compressed_loc(t_physical_tile_loc grid_loc) const {
-        int cx = UNDEFINED;
-        int cy = UNDEFINED;
         int layer_num = grid_loc.layer_num;
 
-        auto itr_x = std::lower_bound(compressed_to_grid_x[layer_num].begin(), compressed_to_grid_x[layer_num].end(), grid_loc.x);
-        VTR_ASSERT(*itr_x == grid_loc.x);
-        cx = std::distance(compressed_to_grid_x[layer_num].begin(), itr_x);
+        int cx = grid_x_ranks[layer_num].rank(grid_loc.x);
+        VTR_ASSERT(cx < (int)compressed_to_grid_x[layer_num].size() && compressed_to_grid_x[layer_num][cx] == grid_loc.x);
 
-        auto itr_y = std::lower_bound(compressed_to_grid_y[layer_num].begin(), compressed_to_grid_y[layer_num].end(), grid_loc.y);
-        VTR_ASSERT(*itr_y == grid_loc.y);
-        cy = std::distance(compressed_to_grid_y[layer_num].begin(), itr_y);
+        int cy = grid_y_ranks[layer_num].rank(grid_loc.y);
+        VTR_ASSERT(cy < (int)compressed_to_grid_y[layer_num].size() && compressed_to_grid_y[layer_num][cy] == grid_loc.y);
 
         return {cx, cy, layer_num};
     }
@@ -67,21 +136,21 @@ struct t_compressed_block_grid {
      * @return The corresponding compressed location with the same layer number.
      */
     inline t_physical_tile_loc grid_loc_to_compressed_loc_approx_round_up(t_physical_tile_loc grid_loc) const {
-        auto find_compressed_index = [](const std::vector<int>& compressed, int value) -> int {
+        auto find_compressed_index = [](const std::vector<int>& compressed, const t_compressed_axis_rank& ranks, int value) -> int {
             // Get the first element that is not less than the value
-            auto itr = std::lower_bound(compressed.begin(), compressed.end(), value);
-            if (itr == compressed.end()) {
+            int index = ranks.rank(value);
+            if (index == (int)compressed.size()) {
                 // If all the compressed locations are less than the grid location, return the last compressed location
                 return compressed.size() - 1;
             } else {
                 // Return the index of the first element that is not less than the value
-                return std::distance(compressed.begin(), itr);
+                return index;
             }
         };
 
         int layer_num = grid_loc.layer_num;
-        int cx = find_compressed_index(compressed_to_grid_x[layer_num], grid_loc.x);
-        int cy = find_compressed_index(compressed_to_grid_y[layer_num], grid_loc.y);
+        int cx = find_compressed_index(compressed_to_grid_x[layer_num], grid_x_ranks[layer_num], grid_loc.x);
+        int cy = find_compressed_index(compressed_to_grid_y[layer_num], grid_y_ranks[layer_num], grid_loc.y);
 
         return {cx, cy, layer_num};
     }
@@ -97,21 +166,21 @@ struct t_compressed_block_grid {
      * @return The corresponding compressed location with the same layer number.
      */
     inline t_physical_tile_loc grid_loc_to_compressed_loc_approx_round_down(t_physical_tile_loc grid_loc) const {
-        auto find_compressed_index = [](const std::vector<int>& compressed, int value) -> int {
+        auto find_compressed_index = [](const t_compressed_axis_rank& ranks, int value) -> int {
             // Get the first element that is strictly bigger than the value
-            auto itr = std::upper_bound(compressed.begin(), compressed.end(), value);
-            if (itr == compressed.begin()) {
+            int index = ranks.rank(value + 1);
+            if (index == 0) {
                 // If all the compressed locations are bigger than the grid location, return the first compressed location
                 return 0;
             } else {
                 // Return the index of the first element that is less than or equal to the value
-                return std::distance(compressed.begin(), itr - 1);
+                return index - 1;
             }
         };
 
         int layer_num = grid_loc.layer_num;
-        int cx = find_compressed_index(compressed_to_grid_x[layer_num], grid_loc.x);
-        int cy = find_compressed_index(compressed_to_grid_y[layer_num], grid_loc.y);
+        int cx = find_compressed_index(grid_x_ranks[layer_num], grid_loc.x);
+        int cy = find_compressed_index(grid_y_ranks[layer_num], grid_loc.y);
 
         return {cx, cy, layer_num};
     }
@@ -126,7 +195,7 @@ struct t_compressed_block_grid {
      *           or OPEN if a location does not exist.
      */
     inline t_physical_tile_loc grid_loc_to_compressed_loc_approx(t_physical_tile_loc grid_loc) const {
-        auto find_closest_compressed_point = [](int loc, const std::vector<int>& compressed_grid_dim) -> int {
+        auto find_closest_compressed_point = [](int loc, const std::vector<int>& compressed_grid_dim, const t_compressed_axis_rank& ranks) -> int {
             // If the compressed grid dim's size is 0, this means that there are
             // no compatible locations for a block of the given type. Returns OPEN
             // in that case.
@@ -135,26 +204,26 @@ struct t_compressed_block_grid {
             }
 
             // Find the first element not less than loc
-            auto itr = std::lower_bound(compressed_grid_dim.begin(), compressed_grid_dim.end(), loc);
+            int index = ranks.rank(loc);
 
-            if (itr == compressed_grid_dim.begin()) {
+            if (index == 0) {
                 // If all the compressed locations are bigger that or equal to loc, return the first compressed location
                 return 0;
-            } else if (itr == compressed_grid_dim.end()) {
+            } else if (index == (int)compressed_grid_dim.size()) {
                 // If all the compressed locations are less than loc, return the last compressed location
                 return compressed_grid_dim.size() - 1;
             } else {
                 // Find the nearest compressed location.
-                int dist_prev = loc - *(itr - 1);
-                int dist_next = *itr - loc;
+                int dist_prev = loc - compressed_grid_dim[index - 1];
+                int dist_next = compressed_grid_dim[index] - loc;
                 VTR_ASSERT_DEBUG(dist_prev >= 0 && dist_next >= 0);
-                return (dist_prev <= dist_next) ? (std::distance(compressed_grid_dim.begin(), itr - 1)) : (std::distance(compressed_grid_dim.begin(), itr));
+                return (dist_prev <= dist_next) ? index - 1 : index;
             }
         };
 
         const int layer_num = grid_loc.layer_num;
-        const int cx = find_closest_compressed_point(grid_loc.x, compressed_to_grid_x[layer_num]);
-        const int cy = find_closest_compressed_point(grid_loc.y, compressed_to_grid_y[layer_num]);
+        const int cx = find_closest_compressed_point(grid_loc.x, compressed_to_grid_x[layer_num], grid_x_ranks[layer_num]);
+        const int cy = find_closest_compressed_point(grid_loc.y, compressed_to_grid_y[layer_num], grid_y_ranks[layer_num]);
 
         return {cx, cy, layer_num};
     }
@@ -168,10 +237,12 @@ struct t_compressed_block_grid {
         return compatible_sub_tiles_for_tile.at(physical_type_index);
     }
 
-    inline const vtr::flat_map2<int, t_physical_tile_loc>& get_column_block_map(int cx, int layer_num) const {
-        VTR_ASSERT_SAFE(layer_num < (int)grid.size());
-        VTR_ASSERT_SAFE(cx < (int)grid[layer_num].size());
-        return grid[layer_num][cx];
+    ///@brief The compressed rows the block type is found at in compressed column cx of the layer
+    inline t_compressed_column get_column_rows(int cx, int layer_num) const {
+        VTR_ASSERT_SAFE(layer_num < (int)column_starts.size());
+        VTR_ASSERT_SAFE(cx + 1 < (int)column_starts[layer_num].size());
+        const int* rows = column_rows[layer_num].data();
+        return t_compressed_column(rows + column_starts[layer_num][cx], rows + column_starts[layer_num][cx + 1]);
     }
 
     inline const std::vector<int>& get_layer_nums() const {
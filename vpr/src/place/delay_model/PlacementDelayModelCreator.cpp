@@ -10,6 +10,7 @@
 #include "vtr_time.h"
 #include "physical_types.h"
 #include "place_and_route.h"
+#include "setup_cache.h"
 
 static int get_longest_segment_length(const std::vector<t_segment_inf>& segment_inf) {
     int length = 0;
@@ -23,6 +24,38 @@ static int get_longest_segment_length(const std::vector<t_segment_inf>& segment_
     return length;
 }
 
+/// @brief Returns the setup cache file of the placement delay model, or an empty string if it isn't cached.
+static std::string get_delay_model_cache_file(const t_placer_opts& placer_opts,
+                                              const t_router_opts& router_opts,
+                                              const std::vector<t_segment_inf>& segment_inf,
+                                              bool is_flat) {
+    if (router_opts.setup_cache_dir.empty() || !placer_opts.read_placement_delay_lookup.empty()) {
+        return std::string();
+    }
+
+    // Everything the delay profiling depends on, besides the RR graph
+    std::string options_key = std::to_string(int(placer_opts.delay_model_type))
+                              + ";" + std::to_string(int(placer_opts.delay_model_reducer))
+                              + ";" + std::to_string(int(placer_opts.place_delta_delay_matrix_calculation_method))
+                              + ";" + placer_opts.allowed_tiles_for_delay_model
+                              + ";" + std::to_string(router_opts.astar_fac)
+                              + ";" + std::to_string(router_opts.astar_offset)
+                              + ";" + std::to_string(router_opts.router_profiler_astar_fac)
+                              + ";" + std::to_string(router_opts.bend_cost)
+                              + ";" + std::to_string(router_opts.post_target_prune_fac)
+                              + ";" + std::to_string(router_opts.post_target_prune_offset)
+                              + ";" + std::to_string(int(router_opts.route_type))
+                              + ";" + std::to_string(int(router_opts.lookahead_type))
+                              + ";" + std::to_string(router_opts.lookahead_lazy)
+                              + ";" + std::to_string(router_opts.lookahead_quantized)
+                              + ";" + std::to_string(is_flat);
+    for (const t_segment_inf& seg : segment_inf) {
+        options_key += ";" + seg.name + ":" + std::to_string(seg.length) + ":" + std::to_string(seg.frequency);
+    }
+
+    return get_setup_cache_file(router_opts.setup_cache_dir, "place_delay_model", options_key);
+}
+
 std::unique_ptr<PlaceDelayModel>
 PlacementDelayModelCreator::create_delay_model(const t_placer_opts& placer_opts,
                                                const t_router_opts& router_opts,
@@ -44,7 +77,10 @@ PlacementDelayModelCreator::create_delay_model(const t_placer_opts& placer_opts,
                                                                           router_opts.read_router_lookahead,
                                                                           segment_inf,
                                                                           is_flat,
-                                                                          router_opts.route_verbosity);
+                                                                          router_opts.route_verbosity,
+                                                                          router_opts.setup_cache_dir,
+                                                                          router_opts.lookahead_lazy,
+                                                                          router_opts.lookahead_quantized);
 
     RouterDelayProfiler route_profiler(net_list, router_lookahead, is_flat);
 
@@ -64,10 +100,18 @@ PlacementDelayModelCreator::create_delay_model(const t_placer_opts& placer_opts,
         VTR_ASSERT_MSG(false, "Invalid placer delay model");
     }
 
-    if (placer_opts.read_placement_delay_lookup.empty()) {
-        place_delay_model->compute(route_profiler, placer_opts, router_opts, longest_length);
-    } else {
+    std::string cache_file = get_delay_model_cache_file(placer_opts, router_opts, segment_inf, is_flat);
+
+    if (!placer_opts.read_placement_delay_lookup.empty()) {
         place_delay_model->read(placer_opts.read_placement_delay_lookup);
+    } else if (setup_cache_file_exists(cache_file)) {
+        VTR_LOG("Reading placement delay lookup from the setup cache '%s'\n", cache_file.c_str());
+        place_delay_model->read(cache_file);
+    } else {
+        place_delay_model->compute(route_profiler, placer_opts, router_opts, longest_length);
+        write_setup_cache_file(cache_file, [&](const std::string& file) {
+            place_delay_model->write(file);
+        });
     }
 
     if (!placer_opts.write_placement_delay_lookup.empty()) {
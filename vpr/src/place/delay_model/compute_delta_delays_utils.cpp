@@ -430,20 +430,47 @@ static void generic_compute_matrix_iterative_astar(RouterDelayProfiler& route_pr
                                                    bool /*is_flat*/) {
     const auto& device_ctx = g_vpr_ctx.device();
 
+    t_physical_tile_type_ptr src_type = device_ctx.grid.get_physical_type({source_x, source_y, from_layer_num});
+    bool is_allowed_type = allowed_types.empty() || allowed_types.find(src_type->name) != allowed_types.end();
+
+    auto is_valid_sample = [&](int sink_x, int sink_y) {
+        t_physical_tile_type_ptr sink_type = device_ctx.grid.get_physical_type({sink_x, sink_y, to_layer_num});
+        return src_type != device_ctx.EMPTY_PHYSICAL_TILE_TYPE
+               && sink_type != device_ctx.EMPTY_PHYSICAL_TILE_TYPE
+               && is_allowed_type;
+    };
+
+    // Route all the valid samples first (in parallel when possible), then add them to the matrix
+    // in the order of a serial run, so the resulting delays do not depend on the thread count.
+    std::vector<t_physical_tile_loc> sample_sinks;
+    for (int sink_x = start_x; sink_x <= end_x; sink_x++) {
+        for (int sink_y = start_y; sink_y <= end_y; sink_y++) {
+            if (is_valid_sample(sink_x, sink_y)) {
+                sample_sinks.push_back({sink_x, sink_y, to_layer_num});
+            }
+        }
+    }
+
+    std::vector<float> sample_delays(sample_sinks.size());
+    route_profiler.for_each_parallel(sample_sinks.size(), [&](size_t isample, RouterDelayProfiler& profiler) {
+        sample_delays[isample] = route_connection_delay(profiler,
+                                                        source_x,
+                                                        source_y,
+                                                        from_layer_num,
+                                                        sample_sinks[isample].x,
+                                                        sample_sinks[isample].y,
+                                                        to_layer_num,
+                                                        router_opts,
+                                                        measure_directconnect);
+    });
+
+    size_t isample = 0;
     for (int sink_x = start_x; sink_x <= end_x; sink_x++) {
         for (int sink_y = start_y; sink_y <= end_y; sink_y++) {
             const int delta_x = abs(sink_x - source_x);
             const int delta_y = abs(sink_y - source_y);
 
-            t_physical_tile_type_ptr src_type = device_ctx.grid.get_physical_type({source_x, source_y, from_layer_num});
-            t_physical_tile_type_ptr sink_type = device_ctx.grid.get_physical_type({sink_x, sink_y, to_layer_num});
-
-            bool src_or_target_empty = (src_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE
-                                        || sink_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE);
-
-            bool is_allowed_type = allowed_types.empty() || allowed_types.find(src_type->name) != allowed_types.end();
-
-            if (src_or_target_empty || !is_allowed_type) {
+            if (!is_valid_sample(sink_x, sink_y)) {
                 if (matrix[delta_x][delta_y].empty()) {
                     // Only set empty target if we don't already have a valid delta delay
                     matrix[delta_x][delta_y].push_back(EMPTY_DELTA);
@@ -457,15 +484,7 @@ static void generic_compute_matrix_iterative_astar(RouterDelayProfiler& route_pr
                 }
             } else {
                 // Valid start/end
-                float delay = route_connection_delay(route_profiler,
-                                                     source_x,
-                                                     source_y,
-                                                     from_layer_num,
-                                                     sink_x,
-                                                     sink_y,
-                                                     to_layer_num,
-                                                     router_opts,
-                                                     measure_directconnect);
+                float delay = sample_delays[isample++];
 
 #ifdef VERBOSE
                 VTR_LOG("Computed delay: %12g delta: %d,%d (src: %d,%d sink: %d,%d)\n",
@@ -484,6 +503,7 @@ static void generic_compute_matrix_iterative_astar(RouterDelayProfiler& route_pr
             }
         }
     }
+    VTR_ASSERT(isample == sample_sinks.size());
 }
 
 static void generic_compute_matrix_dijkstra_expansion(RouterDelayProfiler& /*route_profiler*/,
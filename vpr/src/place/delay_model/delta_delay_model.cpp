@@ -30,6 +30,29 @@ float DeltaDelayModel::delay(const t_physical_tile_loc& from_loc, int /*from_pin
     return delays_[from_loc.layer_num][to_loc.layer_num][delta_x][delta_y];
 }
 
+void DeltaDelayModel::delays(const t_delay_batch& batch, float* delays) const {
+    const size_t num_connections = batch.size();
+    const size_t num_to_layers = delays_.dim_size(1);
+    const size_t size_x = delays_.dim_size(2);
+    const size_t size_y = delays_.dim_size(3);
+
+    // Row-major index of [from_layer][to_layer][dx][dy], then a gather: no loop-carried dependencies or
+    // per-dimension proxies, so the compiler vectorizes it (the delay model is shared, so no scratch here)
+    const int* from_x = batch.from_x.data();
+    const int* from_y = batch.from_y.data();
+    const int* from_layer = batch.from_layer.data();
+    const int* to_x = batch.to_x.data();
+    const int* to_y = batch.to_y.data();
+    const int* to_layer = batch.to_layer.data();
+    for (size_t i = 0; i < num_connections; i++) {
+        size_t delta_x = std::abs(from_x[i] - to_x[i]);
+        size_t delta_y = std::abs(from_y[i] - to_y[i]);
+        size_t index = ((size_t(from_layer[i]) * num_to_layers + to_layer[i]) * size_x + delta_x) * size_y + delta_y;
+        VTR_ASSERT_SAFE(index < delays_.size());
+        delays[i] = delays_.get(index);
+    }
+}
+
 void DeltaDelayModel::dump_echo(std::string filepath) const {
     FILE* f = vtr::fopen(filepath.c_str(), "w");
     fprintf(f, "         ");
@@ -62,15 +85,16 @@ void DeltaDelayModel::read(const std::string& file) {
 #else
 
     // MmapFile object creates an mmap of the specified path, and will munmap
-    // when the object leaves scope.
-    MmapFile f(file);
+    // when the object leaves scope (here, when the last matrix using it as storage
+    // is destroyed).
+    auto f = std::make_shared<MmapFile>(file);
 
     /* Increase reader limit to 1G words to allow for large files. */
     ::capnp::ReaderOptions opts = default_large_capnp_opts();
 
     // FlatArrayMessageReader is used to read the message from the data array
     // provided by MmapFile.
-    ::capnp::FlatArrayMessageReader reader(f.getData(), opts);
+    ::capnp::FlatArrayMessageReader reader(f->getData(), opts);
 
     // When reading capnproto files the Reader object to use is named
     // <schema name>::Reader.
@@ -100,7 +124,15 @@ void DeltaDelayModel::read(const std::string& file) {
     //
     // The second argument should be of type Matrix<X>::Reader where X is the
     // capnproto element type.
-    ToNdMatrix<4, VprFloatEntry, float>(&delays_, model.getDelays(), toFloat);
+    //
+    // Files written since rawDelays was added are instead used in place: the delays
+    // are read straight from the mapped file, which concurrent VPR processes on the
+    // same host share through the page cache.
+    if (model.hasRawDelays()) {
+        AliasNdMatrix<4, float>(&delays_, model.getRawDelays(), f);
+    } else {
+        ToNdMatrix<4, VprFloatEntry, float>(&delays_, model.getDelays(), toFloat);
+    }
 #endif
 }
 
@@ -120,15 +152,11 @@ void DeltaDelayModel::write(const std::string& file) const {
     // fields in the message.
     auto model = builder.initRoot<VprDeltaDelayModel>();
 
-    auto fromFloat = [](VprFloatEntry::Builder* out, const float& in) -> void {
-        out->setValue(in);
-    };
-
-    // FromNdMatrix is a generic function for converting a vtr::NdMatrix to a
-    // Matrix message.  It is the mirror function of ToNdMatrix described in
+    // FromNdMatrixRaw is a generic function for converting a vtr::NdMatrix to a
+    // RawMatrix message.  It is the mirror function of AliasNdMatrix described in
     // read above.
-    auto delay_values = model.getDelays();
-    FromNdMatrix<4, VprFloatEntry, float>(&delay_values, delays_, fromFloat);
+    auto delay_values = model.initRawDelays();
+    FromNdMatrixRaw<4, float>(&delay_values, delays_);
 
     // writeMessageToFile writes message to the specified file.
     writeMessageToFile(file, &builder);
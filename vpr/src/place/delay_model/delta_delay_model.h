@@ -28,6 +28,9 @@ class DeltaDelayModel : public PlaceDelayModel {
 
     float delay(const t_physical_tile_loc& from_loc, int /*from_pin*/, const t_physical_tile_loc& to_loc, int /*to_pin*/) const override;
 
+    ///@brief Computes the flat indices into the delay table with straight-line arithmetic over the batch arrays, which vectorizes.
+    void delays(const t_delay_batch& batch, float* delays) const override;
+
     void dump_echo(std::string filepath) const override;
 
     void read(const std::string& file) override;
@@ -208,11 +208,11 @@ void OverrideDelayModel::read(const std::string& file) {
               "OverrideDelayModel::read is disabled because VTR_ENABLE_CAPNPROTO=OFF. "
               "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable.");
 #else
-    MmapFile f(file);
+    auto f = std::make_shared<MmapFile>(file);
 
     /* Increase reader limit to 1G words to allow for large files. */
     ::capnp::ReaderOptions opts = default_large_capnp_opts();
-    ::capnp::FlatArrayMessageReader reader(f.getData(), opts);
+    ::capnp::FlatArrayMessageReader reader(f->getData(), opts);
 
     auto toFloat = [](float* out, const VprFloatEntry::Reader& in) -> void {
         *out = in.getValue();
@@ -220,9 +220,14 @@ void OverrideDelayModel::read(const std::string& file) {
 
     vtr::NdMatrix<float, 4> delays;
     auto model = reader.getRoot<VprOverrideDelayModel>();
-    ToNdMatrix<4, VprFloatEntry, float>(&delays, model.getDelays(), toFloat);
+    if (model.hasRawDelays()) {
+        // Used in place, see DeltaDelayModel::read()
+        AliasNdMatrix<4, float>(&delays, model.getRawDelays(), f);
+    } else {
+        ToNdMatrix<4, VprFloatEntry, float>(&delays, model.getDelays(), toFloat);
+    }
 
-    base_delay_model_ = std::make_unique<DeltaDelayModel>(cross_layer_delay_, delays, is_flat_);
+    base_delay_model_ = std::make_unique<DeltaDelayModel>(cross_layer_delay_, std::move(delays), is_flat_);
 
     // Reading non-scalar capnproto fields is roughly equivalent to using
     // a std::vector of the field type.  Actual type is capnp::List<X>::Reader.
@@ -254,12 +259,8 @@ void OverrideDelayModel::write(const std::string& file) const {
     ::capnp::MallocMessageBuilder builder;
     auto model = builder.initRoot<VprOverrideDelayModel>();
 
-    auto fromFloat = [](VprFloatEntry::Builder* out, const float& in) -> void {
-        out->setValue(in);
-    };
-
-    auto delays = model.getDelays();
-    FromNdMatrix<4, VprFloatEntry, float>(&delays, base_delay_model_->delays(), fromFloat);
+    auto delays = model.initRawDelays();
+    FromNdMatrixRaw<4, float>(&delays, base_delay_model_->delays());
 
     // Non-scalar capnproto fields should be first initialized with
     // init<field  name>(count), and then accessed from the returned
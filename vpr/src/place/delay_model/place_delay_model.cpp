@@ -62,6 +62,50 @@ float comp_td_single_connection_delay(const PlaceDelayModel* delay_model,
     return (delay_source_to_sink);
 }
 
+void PlaceDelayModel::delays(const t_delay_batch& batch, float* delays) const {
+    for (size_t i = 0; i < batch.size(); i++) {
+        delays[i] = delay({batch.from_x[i], batch.from_y[i], batch.from_layer[i]}, batch.from_pin[i],
+                          {batch.to_x[i], batch.to_y[i], batch.to_layer[i]}, batch.to_pin[i]);
+    }
+}
+
+void comp_td_net_connection_delays(const PlaceDelayModel* delay_model,
+                                   const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
+                                   ClusterNetId net_id,
+                                   t_delay_batch& batch,
+                                   std::vector<float>& delays) {
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& clb_nlist = cluster_ctx.clb_nlist;
+    const ClbNetPinsCsr& net_pins = cluster_ctx.clb_net_pins;
+
+    const vtr::array_view<const ClusterPinId> pins = net_pins.net_pins(net_id);
+    const vtr::array_view<const ClusterBlockId> blocks = net_pins.net_pin_blocks(net_id);
+    size_t num_pins = pins.size();
+    delays.assign(num_pins, 0.);
+    if (clb_nlist.net_is_ignored(net_id)) {
+        return;
+    }
+
+    t_pl_loc source_block_loc = block_locs[blocks[0]].loc;
+    t_physical_tile_loc source_loc(source_block_loc.x, source_block_loc.y, source_block_loc.layer);
+    int source_block_ipin = clb_nlist.pin_logical_index(pins[0]);
+
+    batch.clear();
+    for (size_t ipin = 1; ipin < num_pins; ipin++) {
+        t_pl_loc sink_block_loc = block_locs[blocks[ipin]].loc;
+        batch.add(source_loc, source_block_ipin,
+                  {sink_block_loc.x, sink_block_loc.y, sink_block_loc.layer}, clb_nlist.pin_logical_index(pins[ipin]));
+    }
+    delay_model->delays(batch, delays.data() + 1);
+
+    for (size_t ipin = 1; ipin < num_pins; ipin++) {
+        if (delays[ipin] < 0) {
+            //Report it the same way as a single connection
+            comp_td_single_connection_delay(delay_model, block_locs, net_id, ipin);
+        }
+    }
+}
+
 ///@brief Recompute all point to point delays, updating `connection_delay` matrix.
 void comp_td_connection_delays(const PlaceDelayModel* delay_model,
                                PlacerState& placer_state) {
@@ -70,9 +114,12 @@ void comp_td_connection_delays(const PlaceDelayModel* delay_model,
     auto& block_locs = placer_state.block_locs();
     auto& connection_delay = p_timing_ctx.connection_delay;
 
+    t_delay_batch batch;
+    std::vector<float> delays;
     for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
-        for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ++ipin) {
-            connection_delay[net_id][ipin] = comp_td_single_connection_delay(delay_model, block_locs, net_id, ipin);
+        comp_td_net_connection_delays(delay_model, block_locs, net_id, batch, delays);
+        for (size_t ipin = 1; ipin < delays.size(); ++ipin) {
+            connection_delay[net_id][ipin] = delays[ipin];
         }
     }
 }
@@ -5,6 +5,8 @@
  *        the placer delay model. For implementations, see place_delay_model.cpp.
  */
 
+#include <vector>
+
 #include "vpr_types.h"
 #include "router_delay_profiling.h"
 
@@ -26,12 +28,53 @@
 class PlaceDelayModel;
 class PlacerState;
 
+/**
+ * @brief Connections whose delays are looked up together (see PlaceDelayModel::delays()).
+ *
+ * Stored as a structure of arrays, so that the index computations of the table based models vectorize.
+ */
+struct t_delay_batch {
+    std::vector<int> from_x, from_y, from_layer, from_pin;
+    std::vector<int> to_x, to_y, to_layer, to_pin;
+
+    size_t size() const { return from_x.size(); }
+
+    void clear() {
+        for (std::vector<int>* v : {&from_x, &from_y, &from_layer, &from_pin, &to_x, &to_y, &to_layer, &to_pin}) {
+            v->clear();
+        }
+    }
+
+    void add(const t_physical_tile_loc& from_loc, int from_pin_, const t_physical_tile_loc& to_loc, int to_pin_) {
+        from_x.push_back(from_loc.x);
+        from_y.push_back(from_loc.y);
+        from_layer.push_back(from_loc.layer_num);
+        from_pin.push_back(from_pin_);
+        to_x.push_back(to_loc.x);
+        to_y.push_back(to_loc.y);
+        to_layer.push_back(to_loc.layer_num);
+        to_pin.push_back(to_pin_);
+    }
+};
+
 ///@brief Returns the delay of one point to point connection.
 float comp_td_single_connection_delay(const PlaceDelayModel* delay_model,
                                       const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
                                       ClusterNetId net_id,
                                       int ipin);
 
+/**
+ * @brief Computes the delays of all the sink connections of a net in one batch.
+ *
+ * Same as comp_td_single_connection_delay() for ipin in [1..num_pins-1], stored in `delays[ipin]` (`delays[0]` is unused).
+ * `batch` is scratch space, kept by the caller to avoid allocations.
+ */
+void comp_td_net_connection_delays(const PlaceDelayModel* delay_model,
+                                   const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
+                                   ClusterNetId net_id,
+                                   t_delay_batch& batch,
+                                   std::vector<float>& delays);
+
 ///@brief Recompute all point to point delays, updating `connection_delay` matrix.
 void comp_td_connection_delays(const PlaceDelayModel* delay_model,
                                PlacerState& placer_state);
@@ -54,6 +97,13 @@ class PlaceDelayModel {
      */
     virtual float delay(const t_physical_tile_loc& from_loc, int from_pin, const t_physical_tile_loc& to_loc, int to_pin) const = 0;
 
+    /**
+     * @brief Returns the delay estimates of all the connections of `batch` in `delays[0..batch.size()-1]`.
+     *
+     * The same as calling delay() for each connection, which the default implementation does.
+     */
+    virtual void delays(const t_delay_batch& batch, float* delays) const;
+
     ///@brief Dumps the delay model to an echo file.
     virtual void dump_echo(std::string filename) const = 0;
 
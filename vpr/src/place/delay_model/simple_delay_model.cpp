@@ -59,15 +59,16 @@ void SimpleDelayModel::read(const std::string& file) {
               "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable.");
 #else
     // MmapFile object creates an mmap of the specified path, and will munmap
-    // when the object leaves scope.
-    MmapFile f(file);
+    // when the object leaves scope (here, when the last matrix using it as storage
+    // is destroyed).
+    auto f = std::make_shared<MmapFile>(file);
 
     /* Increase reader limit to 1G words to allow for large files. */
     ::capnp::ReaderOptions opts = default_large_capnp_opts();
 
     // FlatArrayMessageReader is used to read the message from the data array
     // provided by MmapFile.
-    ::capnp::FlatArrayMessageReader reader(f.getData(), opts);
+    ::capnp::FlatArrayMessageReader reader(f->getData(), opts);
 
     // When reading capnproto files the Reader object to use is named
     // <schema name>::Reader.
@@ -97,7 +98,15 @@ void SimpleDelayModel::read(const std::string& file) {
     //
     // The second argument should be of type Matrix<X>::Reader where X is the
     // capnproto element type.
-    ToNdMatrix<5, VprFloatEntry, float>(&delays_, model.getDelays(), toFloat);
+    //
+    // Files written since rawDelays was added are instead used in place: the delays
+    // are read straight from the mapped file, which concurrent VPR processes on the
+    // same host share through the page cache.
+    if (model.hasRawDelays()) {
+        AliasNdMatrix<5, float>(&delays_, model.getRawDelays(), f);
+    } else {
+        ToNdMatrix<5, VprFloatEntry, float>(&delays_, model.getDelays(), toFloat);
+    }
 #endif
 }
 
@@ -116,15 +125,11 @@ void SimpleDelayModel::write(const std::string& file) const {
     // fields in the message.
     auto model = builder.initRoot<VprDeltaDelayModel>();
 
-    auto fromFloat = [](VprFloatEntry::Builder* out, const float& in) -> void {
-        out->setValue(in);
-    };
-
-    // FromNdMatrix is a generic function for converting a vtr::NdMatrix to a
-    // Matrix message.  It is the mirror function of ToNdMatrix described in
+    // FromNdMatrixRaw is a generic function for converting a vtr::NdMatrix to a
+    // RawMatrix message.  It is the mirror function of AliasNdMatrix described in
     // read above.
-    auto delay_values = model.getDelays();
-    FromNdMatrix<5, VprFloatEntry, float>(&delay_values, delays_, fromFloat);
+    auto delay_values = model.initRawDelays();
+    FromNdMatrixRaw<5, float>(&delay_values, delays_);
 
     // writeMessageToFile writes message to the specified file.
     writeMessageToFile(file, &builder);
@@ -11,6 +11,33 @@
 #include "vtr_random.h"
 #include "vtr_time.h"
 
+#include <algorithm>
+#include <memory>
+
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
+/**
+ * @brief A router swap of a batch of swaps that noc_routers_anneal() proposes
+ * at once and evaluates concurrently (see --noc_initial_placement_speculative_moves).
+ */
+struct t_noc_speculative_move {
+    t_noc_speculative_move()
+        : blocks_affected(2) {}
+
+    /// The moved routers, at most two
+    t_pl_blocks_to_be_moved blocks_affected;
+    /// Whether the swap was proposed and moves no router of an earlier swap of its batch
+    bool valid = false;
+    /// Whether noc_delta_c was estimated against the placement at the start of the batch
+    bool estimated = false;
+    NocCostTerms noc_delta_c;
+    /// The traffic flows re-routed and the links whose bandwidth usage changes by this swap
+    std::vector<NocTrafficFlowId> traffic_flows;
+    std::vector<NocLinkId> links;
+};
+
 /**
  * @brief Evaluates whether a NoC router swap should be accepted or not.
  * If delta cost is non-positive, the move is always accepted. If the cost
@@ -27,6 +54,21 @@
  */
 static bool accept_noc_swap(double delta_cost, double prob, vtr::RngContainer& rng);
 
+/**
+ * @brief Checks that a swap of a speculative batch moves no router which, and
+ * uses no location which, an earlier swap of the batch moves or uses. If so,
+ * the routers and locations of the swap are reserved.
+ *
+ *   @param blocks_affected The proposed swap.
+ *   @param reserved_blocks The routers moved by the earlier swaps of the batch.
+ *   @param reserved_locs The locations used by the earlier swaps of the batch.
+ *
+ * @return true if the swap is independent of the earlier swaps of its batch.
+ */
+static bool reserve_noc_speculative_move(const t_pl_blocks_to_be_moved& blocks_affected,
+                                         std::vector<ClusterBlockId>& reserved_blocks,
+                                         std::vector<t_pl_loc>& reserved_locs);
+
 /**
  * @brief Places a constrained NoC router within its partition region.
  *
@@ -104,6 +146,25 @@ static bool accept_noc_swap(double delta_cost, double prob, vtr::RngContainer& r
     }
 }
 
+static bool reserve_noc_speculative_move(const t_pl_blocks_to_be_moved& blocks_affected,
+                                         std::vector<ClusterBlockId>& reserved_blocks,
+                                         std::vector<t_pl_loc>& reserved_locs) {
+    for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+        if (std::find(reserved_blocks.begin(), reserved_blocks.end(), moved_block.block_num) != reserved_blocks.end()
+            || std::find(reserved_locs.begin(), reserved_locs.end(), moved_block.old_loc) != reserved_locs.end()
+            || std::find(reserved_locs.begin(), reserved_locs.end(), moved_block.new_loc) != reserved_locs.end()) {
+            return false;
+        }
+    }
+
+    for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+        reserved_blocks.push_back(moved_block.block_num);
+        reserved_locs.push_back(moved_block.old_loc);
+        reserved_locs.push_back(moved_block.new_loc);
+    }
+    return true;
+}
+
 static void place_constrained_noc_router(ClusterBlockId router_blk_id,
                                          BlkLocRegistry& blk_loc_registry,
                                          vtr::RngContainer& rng) {
@@ -267,6 +328,138 @@ static void noc_routers_anneal(const t_noc_opts& noc_opts,
      * NoC routers are swapped only with their neighbors as the range limit approaches 1.
      */
 
+    // Accepts a router swap whose NoC cost terms have been updated
+    auto accept_move = [&](const NocCostTerms& noc_delta_c, double delta_cost, const t_pl_blocks_to_be_moved& blocks) {
+        costs.cost += delta_cost;
+        blk_loc_registry.commit_move_blocks(blocks);
+        noc_cost_handler.commit_noc_costs();
+        costs += noc_delta_c;
+        // check if the current placement is better than the stored checkpoint
+        if (costs.cost < checkpoint.get_cost() || !checkpoint.is_valid()) {
+            checkpoint.save_checkpoint(costs.cost, block_locs);
+        }
+    };
+
+    /* Several swaps can only be evaluated at once if their costs can be estimated without
+     * applying them, i.e. if the traffic flow routes can be looked up in the route table.
+     */
+    const int num_speculative_moves = noc_cost_handler.can_estimate_noc_cost_change() ? noc_opts.noc_initial_placement_speculative_moves : 1;
+    if (num_speculative_moves > 1) {
+        std::vector<std::unique_ptr<t_noc_speculative_move>> speculative_moves;
+        for (int imove = 0; imove < num_speculative_moves; imove++) {
+            speculative_moves.push_back(std::make_unique<t_noc_speculative_move>());
+        }
+        std::vector<ClusterBlockId> reserved_blocks;
+        std::vector<t_pl_loc> reserved_locs;
+        vtr::vector<NocTrafficFlowId, bool> changed_traffic_flows(noc_ctx.noc_traffic_flows_storage.get_number_of_traffic_flows(), false);
+        vtr::vector<NocLinkId, bool> changed_links(noc_ctx.noc_model.get_number_of_noc_links(), false);
+
+        /* Same algorithm as below, except that a batch of swaps is proposed against the same placement,
+         * and their cost changes are estimated concurrently. The swaps are then accepted or rejected
+         * in proposal order. A swap whose traffic flows or links were changed by an accepted swap of
+         * its batch is re-evaluated against the current placement before it is accepted or rejected.
+         */
+        for (int i_move = 0; i_move < N_MOVES; i_move += num_speculative_moves) {
+            const int num_moves = std::min(num_speculative_moves, N_MOVES - i_move);
+
+            reserved_blocks.clear();
+            reserved_locs.clear();
+            for (int imove = 0; imove < num_moves; imove++) {
+                t_noc_speculative_move& move = *speculative_moves[imove];
+                move.blocks_affected.clear_move_blocks();
+                // Shrink the range limit over time
+                float r_lim_decayed = 1.0f + (N_MOVES - (i_move + imove)) * (max_r_lim / N_MOVES);
+                e_create_move create_move_outcome = propose_router_swap(move.blocks_affected,
+                                                                        r_lim_decayed,
+                                                                        blk_loc_registry,
+                                                                        place_macros,
+                                                                        rng);
+                move.valid = create_move_outcome != e_create_move::ABORT
+                             && reserve_noc_speculative_move(move.blocks_affected, reserved_blocks, reserved_locs);
+            }
+
+            auto estimate_move = [&](size_t imove) {
+                t_noc_speculative_move& move = *speculative_moves[imove];
+                move.estimated = move.valid
+                                 && noc_cost_handler.estimate_noc_cost_change(move.blocks_affected, move.noc_delta_c,
+                                                                              move.traffic_flows, move.links);
+            };
+#if defined(VPR_USE_TBB)
+            tbb::parallel_for(size_t(0), size_t(num_moves), estimate_move);
+#else
+            for (int imove = 0; imove < num_moves; imove++) {
+                estimate_move(imove);
+            }
+#endif
+
+            // Whether a swap whose traffic flows and links are unknown was accepted
+            bool unknown_changes = false;
+            std::vector<NocTrafficFlowId> batch_changed_traffic_flows;
+            std::vector<NocLinkId> batch_changed_links;
+            for (int imove = 0; imove < num_moves; imove++) {
+                t_noc_speculative_move& move = *speculative_moves[imove];
+                if (!move.valid) {
+                    continue;
+                }
+
+                bool stale = !move.estimated || unknown_changes
+                             || std::any_of(move.traffic_flows.begin(), move.traffic_flows.end(), [&](NocTrafficFlowId id) { return changed_traffic_flows[id]; })
+                             || std::any_of(move.links.begin(), move.links.end(), [&](NocLinkId id) { return changed_links[id]; });
+
+                NocCostTerms noc_delta_c;
+                double delta_cost;
+                if (stale) {
+                    blk_loc_registry.apply_move_blocks(move.blocks_affected);
+                    noc_cost_handler.find_affected_noc_routers_and_update_noc_costs(move.blocks_affected, noc_delta_c);
+                    delta_cost = calculate_noc_cost(noc_delta_c, costs.noc_cost_norm_factors, noc_opts);
+                } else {
+                    delta_cost = calculate_noc_cost(move.noc_delta_c, costs.noc_cost_norm_factors, noc_opts);
+                }
+
+                double prob = starting_prob - (i_move + imove) * prob_step;
+                bool move_accepted = accept_noc_swap(delta_cost, prob, rng);
+
+                if (move_accepted) {
+                    if (!stale) {
+                        // Apply the swap, which computes the same cost change as the estimate
+                        blk_loc_registry.apply_move_blocks(move.blocks_affected);
+                        noc_cost_handler.find_affected_noc_routers_and_update_noc_costs(move.blocks_affected, noc_delta_c);
+                        delta_cost = calculate_noc_cost(noc_delta_c, costs.noc_cost_norm_factors, noc_opts);
+                    }
+                    accept_move(noc_delta_c, delta_cost, move.blocks_affected);
+
+                    if (stale) {
+                        unknown_changes = true;
+                    } else {
+                        for (NocTrafficFlowId traffic_flow_id : move.traffic_flows) {
+                            changed_traffic_flows[traffic_flow_id] = true;
+                            batch_changed_traffic_flows.push_back(traffic_flow_id);
+                        }
+                        for (NocLinkId link_id : move.links) {
+                            changed_links[link_id] = true;
+                            batch_changed_links.push_back(link_id);
+                        }
+                    }
+                } else if (stale) { // The proposed move is rejected
+                    blk_loc_registry.revert_move_blocks(move.blocks_affected);
+                    noc_cost_handler.revert_noc_traffic_flow_routes(move.blocks_affected);
+                }
+            }
+
+            for (NocTrafficFlowId traffic_flow_id : batch_changed_traffic_flows) {
+                changed_traffic_flows[traffic_flow_id] = false;
+            }
+            for (NocLinkId link_id : batch_changed_links) {
+                changed_links[link_id] = false;
+            }
+        }
+
+        if (checkpoint.get_cost() < costs.cost) {
+            checkpoint.restore_checkpoint(costs, blk_loc_registry);
+        }
+        return;
+    }
+
     // Generate and evaluate router moves
     for (int i_move = 0; i_move < N_MOVES; i_move++) {
         blocks_affected.clear_move_blocks();
@@ -289,14 +482,7 @@ static void noc_routers_anneal(const t_noc_opts& noc_opts,
             bool move_accepted = accept_noc_swap(delta_cost, prob, rng);
 
             if (move_accepted) {
-                costs.cost += delta_cost;
-                blk_loc_registry.commit_move_blocks(blocks_affected);
-                noc_cost_handler.commit_noc_costs();
-                costs += noc_delta_c;
-                // check if the current placement is better than the stored checkpoint
-                if (costs.cost < checkpoint.get_cost() || !checkpoint.is_valid()) {
-                    checkpoint.save_checkpoint(costs.cost, block_locs);
-                }
+                accept_move(noc_delta_c, delta_cost, blocks_affected);
             } else { // The proposed move is rejected
                 blk_loc_registry.revert_move_blocks(blocks_affected);
                 noc_cost_handler.revert_noc_traffic_flow_routes(blocks_affected);
@@ -30,8 +30,16 @@
 #include <limits>
 #include <optional>
 #include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#if defined(VPR_USE_TBB)
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
 #ifdef VERBOSE
 void print_clb_placement(const char* fname);
 #endif
@@ -180,6 +188,27 @@ static bool find_subtile_in_location(t_pl_loc& centroid,
                                      const PartitionRegion& pr,
                                      vtr::RngContainer& rng);
 
+/**
+ * @brief Finds the first location (lowest row, then lowest subtile) of a compressed column of a region
+ *        the macro can be placed at, without placing it. Only reads the placement, so columns can be
+ *        searched concurrently.
+ *
+ *   @param pl_macro The macro to be placed.
+ *   @param region The region of the macro's PartitionRegion the column is in.
+ *   @param block_type Logical block type of the macro blocks.
+ *   @param cx The compressed column.
+ *   @param layer_num The layer of the column.
+ *   @param blk_loc_registry Placement block location information.
+ *
+ * @return The location of the macro head, if there is one.
+ */
+static std::optional<t_pl_loc> find_first_free_loc_in_column(const t_pl_macro& pl_macro,
+                                                             const Region& region,
+                                                             t_logical_block_type_ptr block_type,
+                                                             int cx,
+                                                             int layer_num,
+                                                             const BlkLocRegistry& blk_loc_registry);
+
 /**
  * @brief Calculates a centroid location for a block based on its placed connections.
  *
@@ -286,6 +315,37 @@ static void place_all_blocks(const t_placer_opts& placer_opts,
  */
 static void check_initial_placement_legality(const BlkLocRegistry& blk_loc_registry);
 
+/**
+ * @brief Places the blocks of an incremental placement at their location in the previous
+ * placement (see placer_opts.eco_place_file), matched by name. A macro is only restored if
+ * all of its blocks keep their relative positions. Blocks whose previous location is no longer
+ * legal or free are left unplaced.
+ *
+ *   @param eco_block_locs The locations of the previous placement, by block name.
+ *   @param blk_loc_registry Placement block location information.
+ *   @param place_macros The placement macros of the netlist.
+ *
+ * @return The number of blocks placed at their previous location.
+ */
+static size_t place_eco_blocks(const std::unordered_map<std::string, t_pl_loc>& eco_block_locs,
+                               BlkLocRegistry& blk_loc_registry,
+                               const PlaceMacros& place_macros);
+
+/**
+ * @brief Fixes the blocks of an incremental placement which are at their previous location and
+ * farther than eco_window tiles from all the other (new or changed) blocks, so that the anneal
+ * only moves the blocks around the changed logic.
+ *
+ *   @param eco_block_locs The locations of the previous placement, by block name.
+ *   @param eco_window The distance (in tiles) around the changed blocks within which blocks stay movable.
+ *   @param blk_loc_registry Placement block location information.
+ *   @param place_macros The placement macros of the netlist.
+ */
+static void fix_eco_blocks_outside_window(const std::unordered_map<std::string, t_pl_loc>& eco_block_locs,
+                                          int eco_window,
+                                          BlkLocRegistry& blk_loc_registry,
+                                          const PlaceMacros& place_macros);
+
 static void check_initial_placement_legality(const BlkLocRegistry& blk_loc_registry) {
     const auto& cluster_ctx = g_vpr_ctx.clustering();
     const auto& device_ctx = g_vpr_ctx.device();
@@ -799,8 +859,8 @@ static inline t_pl_loc find_nearest_compatible_loc(const t_flat_pl_loc& src_flat
         // (i.e. no tile exists there). This is fine, we just need to check for
         // them to ensure we never try to put a cluster there.
         bool is_valid_compressed_loc = false;
-        const auto& compressed_col_blk_map = compressed_block_grid.get_column_block_map(loc.x, loc.layer_num);
-        if (compressed_col_blk_map.count(loc.y) != 0)
+        const t_compressed_column compressed_col_rows = compressed_block_grid.get_column_rows(loc.x, loc.layer_num);
+        if (compressed_col_rows.count(loc.y) != 0)
             is_valid_compressed_loc = true;
 
         // If this distance is better than the best we have seen so far, try
@@ -1031,8 +1091,8 @@ static std::vector<t_grid_empty_locs_block_type> init_blk_types_empty_locations(
         //traverse all column and store their empty locations in block_type_empty_locs
         for (int x_loc = min_cx; x_loc <= max_cx; x_loc++) {
             t_grid_empty_locs_block_type empty_loc;
-            const auto& block_rows = compressed_block_grid.get_column_block_map(x_loc, layer_num);
-            auto first_avail_loc = block_rows.begin()->second;
+            const t_compressed_column block_rows = compressed_block_grid.get_column_rows(x_loc, layer_num);
+            auto first_avail_loc = compressed_block_grid.compressed_loc_to_grid_loc({x_loc, *block_rows.begin(), layer_num});
             empty_loc.first_avail_loc.x = first_avail_loc.x;
             empty_loc.first_avail_loc.y = first_avail_loc.y;
             empty_loc.first_avail_loc.layer = first_avail_loc.layer_num;
@@ -1148,6 +1208,51 @@ bool try_place_macro_randomly(const t_pl_macro& pl_macro,
     return legal;
 }
 
+static std::optional<t_pl_loc> find_first_free_loc_in_column(const t_pl_macro& pl_macro,
+                                                             const Region& region,
+                                                             t_logical_block_type_ptr block_type,
+                                                             int cx,
+                                                             int layer_num,
+                                                             const BlkLocRegistry& blk_loc_registry) {
+    const auto& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[block_type->index];
+    const auto& grid = g_vpr_ctx.device().grid;
+    const GridBlock& grid_blocks = blk_loc_registry.grid_blocks();
+
+    // Whether the macro can be placed with its head at the location (as checked by try_place_macro())
+    auto can_place_at = [&](const t_pl_loc& loc) {
+        return !grid_blocks.block_at_location(loc)
+               && macro_can_be_placed(pl_macro, loc, /*check_all_legality=*/true, blk_loc_registry);
+    };
+
+    for (int cy : compressed_block_grid.get_column_rows(cx, layer_num)) {
+        auto grid_loc = compressed_block_grid.compressed_loc_to_grid_loc({cx, cy, layer_num});
+        t_pl_loc to_loc(grid_loc.x, grid_loc.y, /*sub_tile=*/0, grid_loc.layer_num);
+
+        if (region.get_sub_tile() != NO_SUBTILE) {
+            to_loc.sub_tile = region.get_sub_tile();
+            if (can_place_at(to_loc)) {
+                return to_loc;
+            }
+            continue;
+        }
+
+        auto tile_type = grid.get_physical_type({to_loc.x, to_loc.y, layer_num});
+        for (const auto& sub_tile : tile_type->sub_tiles) {
+            if (!is_sub_tile_compatible(tile_type, block_type, sub_tile.capacity.low)) {
+                continue;
+            }
+            for (int st = sub_tile.capacity.low; st <= sub_tile.capacity.high; st++) {
+                to_loc.sub_tile = st;
+                if (can_place_at(to_loc)) {
+                    return to_loc;
+                }
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
 bool try_place_macro_exhaustively(const t_pl_macro& pl_macro,
                                   const PartitionRegion& pr,
                                   t_logical_block_type_ptr block_type,
@@ -1155,17 +1260,12 @@ bool try_place_macro_exhaustively(const t_pl_macro& pl_macro,
                                   BlkLocRegistry& blk_loc_registry) {
     const auto& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[block_type->index];
     auto& block_locs = blk_loc_registry.mutable_block_locs();
-    const GridBlock& grid_blocks = blk_loc_registry.grid_blocks();
 
     const std::vector<Region>& regions = pr.get_regions();
 
-    bool placed = false;
-
-    t_pl_loc to_loc;
-
-    for (unsigned int reg = 0; reg < regions.size() && !placed; reg++) {
-        const vtr::Rect<int> reg_rect = regions[reg].get_rect();
-        const auto [layer_low, layer_high] = regions[reg].get_layer_range();
+    for (const Region& region : regions) {
+        const vtr::Rect<int> reg_rect = region.get_rect();
+        const auto [layer_low, layer_high] = region.get_layer_range();
 
         for (int layer_num = layer_low; layer_num <= layer_high; layer_num++) {
             int min_cx = compressed_block_grid.grid_loc_to_compressed_loc_approx({reg_rect.xmin(), UNDEFINED, layer_num}).x;
@@ -1177,65 +1277,44 @@ bool try_place_macro_exhaustively(const t_pl_macro& pl_macro,
                 continue;
             }
 
-            for (int cx = min_cx; cx <= max_cx && !placed; cx++) {
-                const auto& block_rows = compressed_block_grid.get_column_block_map(cx, layer_num);
-                auto y_lower_iter = block_rows.begin();
-                auto y_upper_iter = block_rows.end();
-
-                int y_range = std::distance(y_lower_iter, y_upper_iter);
-
-                VTR_ASSERT(y_range >= 0);
-
-                for (int dy = 0; dy < y_range && !placed; dy++) {
-                    int cy = (y_lower_iter + dy)->first;
-
-                    auto grid_loc = compressed_block_grid.compressed_loc_to_grid_loc({cx, cy, layer_num});
-                    to_loc.x = grid_loc.x;
-                    to_loc.y = grid_loc.y;
-                    to_loc.layer = grid_loc.layer_num;
-
-                    auto& grid = g_vpr_ctx.device().grid;
-                    auto tile_type = grid.get_physical_type({to_loc.x, to_loc.y, layer_num});
-
-                    if (regions[reg].get_sub_tile() != NO_SUBTILE) {
-                        int subtile = regions[reg].get_sub_tile();
-
-                        to_loc.sub_tile = subtile;
-                        if (grid_blocks.block_at_location(to_loc) == ClusterBlockId::INVALID()) {
-                            placed = try_place_macro(pl_macro, to_loc, blk_loc_registry);
-
-                            if (placed) {
-                                fix_IO_block_types(pl_macro, to_loc, pad_loc_type, block_locs);
-                            }
-                        }
-                    } else {
-                        for (const auto& sub_tile : tile_type->sub_tiles) {
-                            if (is_sub_tile_compatible(tile_type, block_type, sub_tile.capacity.low)) {
-                                int st_low = sub_tile.capacity.low;
-                                int st_high = sub_tile.capacity.high;
-
-                                for (int st = st_low; st <= st_high && !placed; st++) {
-                                    to_loc.sub_tile = st;
-                                    if (grid_blocks.block_at_location(to_loc) == ClusterBlockId::INVALID()) {
-                                        placed = try_place_macro(pl_macro, to_loc, blk_loc_registry);
-                                        if (placed) {
-                                            fix_IO_block_types(pl_macro, to_loc, pad_loc_type, block_locs);
-                                        }
-                                    }
-                                }
-                            }
-
-                            if (placed) {
-                                break;
-                            }
+            // The columns of heavily filled regions are searched concurrently (read-only), and the macro is
+            // placed at the free location of the lowest column, i.e. the one a serial search would find first.
+            std::optional<t_pl_loc> to_loc;
+#if defined(VPR_USE_TBB)
+            using t_column_loc = std::pair<int, t_pl_loc>;
+            const t_column_loc no_loc(max_cx + 1, t_pl_loc());
+            t_column_loc first_loc = tbb::parallel_reduce(
+                tbb::blocked_range<int>(min_cx, max_cx + 1), no_loc,
+                [&](const tbb::blocked_range<int>& range, t_column_loc found) {
+                    for (int cx = range.begin(); cx < range.end() && cx < found.first; cx++) {
+                        if (auto loc = find_first_free_loc_in_column(pl_macro, region, block_type, cx, layer_num, blk_loc_registry)) {
+                            found = {cx, *loc};
                         }
                     }
-                }
+                    return found;
+                },
+                [](const t_column_loc& lhs, const t_column_loc& rhs) {
+                    return lhs.first <= rhs.first ? lhs : rhs;
+                });
+            if (first_loc.first <= max_cx) {
+                to_loc = first_loc.second;
+            }
+#else
+            for (int cx = min_cx; cx <= max_cx && !to_loc; cx++) {
+                to_loc = find_first_free_loc_in_column(pl_macro, region, block_type, cx, layer_num, blk_loc_registry);
+            }
+#endif
+
+            if (to_loc) {
+                bool placed = try_place_macro(pl_macro, *to_loc, blk_loc_registry);
+                VTR_ASSERT(placed);
+                fix_IO_block_types(pl_macro, *to_loc, pad_loc_type, block_locs);
+                return true;
             }
         }
     }
 
-    return placed;
+    return false;
 }
 
 static bool try_dense_placement(const t_pl_macro& pl_macro,
@@ -1550,6 +1629,114 @@ static inline t_pl_macro get_or_create_macro(ClusterBlockId blk_id,
     return pl_macro;
 }
 
+static size_t place_eco_blocks(const std::unordered_map<std::string, t_pl_loc>& eco_block_locs,
+                               BlkLocRegistry& blk_loc_registry,
+                               const PlaceMacros& place_macros) {
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& grid = g_vpr_ctx.device().grid;
+
+    size_t num_restored_blocks = 0;
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        if (is_block_placed(blk_id, blk_loc_registry.block_locs())) {
+            continue;
+        }
+
+        // Macros are placed from their head block
+        int imacro = place_macros.get_imacro_from_iblk(blk_id);
+        if (imacro != -1 && place_macros[imacro].members[0].blk_index != blk_id) {
+            continue;
+        }
+        t_pl_macro pl_macro = get_or_create_macro(blk_id, place_macros);
+
+        auto head_it = eco_block_locs.find(cluster_ctx.clb_nlist.block_name(blk_id));
+        if (head_it == eco_block_locs.end()) {
+            continue;
+        }
+        const t_pl_loc& head_pos = head_it->second;
+
+        bool is_macro_unchanged = true;
+        for (const t_pl_macro_member& pl_macro_member : pl_macro.members) {
+            t_pl_loc member_pos = head_pos + pl_macro_member.offset;
+            auto member_it = eco_block_locs.find(cluster_ctx.clb_nlist.block_name(pl_macro_member.blk_index));
+            if (member_it == eco_block_locs.end()
+                || member_it->second != member_pos
+                || !is_loc_on_chip({member_pos.x, member_pos.y, member_pos.layer})
+                || member_pos.sub_tile < 0
+                || member_pos.sub_tile >= grid.get_physical_type({member_pos.x, member_pos.y, member_pos.layer})->capacity) {
+                is_macro_unchanged = false;
+                break;
+            }
+        }
+
+        if (is_macro_unchanged && try_place_macro(pl_macro, head_pos, blk_loc_registry)) {
+            num_restored_blocks += pl_macro.members.size();
+        }
+    }
+
+    return num_restored_blocks;
+}
+
+static void fix_eco_blocks_outside_window(const std::unordered_map<std::string, t_pl_loc>& eco_block_locs,
+                                          int eco_window,
+                                          BlkLocRegistry& blk_loc_registry,
+                                          const PlaceMacros& place_macros) {
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& grid = g_vpr_ctx.device().grid;
+    auto& block_locs = blk_loc_registry.mutable_block_locs();
+
+    auto is_block_unchanged = [&](ClusterBlockId blk_id) {
+        auto it = eco_block_locs.find(cluster_ctx.clb_nlist.block_name(blk_id));
+        return it != eco_block_locs.end() && it->second == block_locs[blk_id].loc;
+    };
+
+    // Mark the tiles within the window of the new or changed blocks
+    vtr::NdMatrix<bool, 2> is_in_window({grid.width(), grid.height()}, false);
+    size_t num_changed_blocks = 0;
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        if (is_block_unchanged(blk_id)) {
+            continue;
+        }
+        num_changed_blocks++;
+        const t_pl_loc& loc = block_locs[blk_id].loc;
+        for (int x = std::max(loc.x - eco_window, 0); x <= std::min<int>(loc.x + eco_window, grid.width() - 1); x++) {
+            for (int y = std::max(loc.y - eco_window, 0); y <= std::min<int>(loc.y + eco_window, grid.height() - 1); y++) {
+                is_in_window[x][y] = true;
+            }
+        }
+    }
+
+    // Nothing changed: leave the blocks movable rather than annealing nothing
+    // (the range limit still keeps the moves local).
+    if (num_changed_blocks == 0) {
+        VTR_LOG("Incremental placement: all blocks kept their previous location\n");
+        return;
+    }
+
+    // Fix the unchanged blocks outside the window, a whole macro at a time
+    size_t num_fixed_blocks = 0;
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        int imacro = place_macros.get_imacro_from_iblk(blk_id);
+        if (block_locs[blk_id].is_fixed || (imacro != -1 && place_macros[imacro].members[0].blk_index != blk_id)) {
+            continue;
+        }
+        t_pl_macro pl_macro = get_or_create_macro(blk_id, place_macros);
+
+        bool is_macro_outside_window = std::all_of(pl_macro.members.begin(), pl_macro.members.end(), [&](const t_pl_macro_member& pl_macro_member) {
+            const t_pl_loc& loc = block_locs[pl_macro_member.blk_index].loc;
+            return is_block_unchanged(pl_macro_member.blk_index) && !is_in_window[loc.x][loc.y];
+        });
+        if (is_macro_outside_window) {
+            for (const t_pl_macro_member& pl_macro_member : pl_macro.members) {
+                block_locs[pl_macro_member.blk_index].is_fixed = true;
+            }
+            num_fixed_blocks += pl_macro.members.size();
+        }
+    }
+
+    VTR_LOG("Incremental placement: %zu new or changed blocks, %zu blocks fixed outside of %d tiles around them\n",
+            num_changed_blocks, num_fixed_blocks, eco_window);
+}
+
 bool place_one_block(const ClusterBlockId blk_id,
                      enum e_pad_loc_type pad_loc_type,
                      std::vector<t_grid_empty_locs_block_type>* blk_types_empty_locs_in_grid,
@@ -2047,14 +2234,28 @@ void initial_placement(const t_placer_opts& placer_opts,
         read_constraints(constraints_file, blk_loc_registry);
     }
 
+    std::unordered_map<std::string, t_pl_loc> eco_block_locs;
+    if (!placer_opts.eco_place_file.empty()) {
+        eco_block_locs = read_place_block_locs(placer_opts.eco_place_file.c_str());
+    }
+
     if (!placer_opts.read_initial_place_file.empty()) {
         const auto& grid = g_vpr_ctx.device().grid;
         read_place(nullptr, placer_opts.read_initial_place_file.c_str(), blk_loc_registry, false, grid);
     } else {
+        // Start the blocks of an incremental placement at their previous location.
+        if (!eco_block_locs.empty()) {
+            size_t num_restored_blocks = place_eco_blocks(eco_block_locs, blk_loc_registry, place_macros);
+            VTR_LOG("Incremental placement: restored the location of %zu of %zu blocks from '%s'\n",
+                    num_restored_blocks, g_vpr_ctx.clustering().clb_nlist.blocks().size(),
+                    placer_opts.eco_place_file.c_str());
+        }
+
         if (noc_opts.noc) {
             // NoC routers are placed before other blocks
             initial_noc_placement(noc_opts, blk_loc_registry, place_macros, noc_cost_handler.value(), rng);
             propagate_place_constraints(place_macros);
+            alloc_and_load_cluster_constraint_masks();
         }
 
         //Place all blocks
@@ -2089,6 +2290,11 @@ void initial_placement(const t_placer_opts& placer_opts,
         }
     }
 
+    // Only anneal the blocks around the changed logic of an incremental placement.
+    if (!eco_block_locs.empty()) {
+        fix_eco_blocks_outside_window(eco_block_locs, placer_opts.eco_window, blk_loc_registry, place_macros);
+    }
+
     // Update the movable blocks vectors in the block loc registry.
     blk_loc_registry.alloc_and_load_movable_blocks();
 
@@ -98,6 +98,8 @@ class MoveGenerator {
      * @param reward_function Specifies the reward function to update q-tables
      * of the RL agent.
      * @param rng A random number generator to be used for block and location selection.
+     * Move generators proposing moves concurrently must each be given their own stream
+     * (see vtr::RngContainer::seed_stream()), so that the placement stays reproducible.
      */
     MoveGenerator(PlacerState& placer_state,
                   const PlaceMacros& place_macros,
@@ -146,6 +148,18 @@ class MoveGenerator {
      */
     virtual void process_outcome(double /*reward*/, e_reward_function /*reward_fun*/) {}
 
+    /**
+     * @brief Returns an identifier of the action behind the most recently proposed move
+     *
+     * Callers that propose several moves before reporting their outcomes pass it back to
+     * set_last_proposed_action() before reporting the outcome of that move, so it is credited
+     * to the right action. Move generators without an agent ignore it.
+     */
+    virtual size_t last_proposed_action() const { return 0; }
+
+    /// @brief Makes the next process_outcome() call refer to the given (previously proposed) action
+    virtual void set_last_proposed_action(size_t /*action*/) {}
+
     /**
      * @brief Calculates the agent's reward and the total process outcome
      *
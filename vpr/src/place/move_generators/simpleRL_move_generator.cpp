@@ -31,6 +31,14 @@ void SimpleRLMoveGenerator::process_outcome(double reward, e_reward_function rew
     karmed_bandit_agent->process_outcome(reward, reward_fun);
 }
 
+size_t SimpleRLMoveGenerator::last_proposed_action() const {
+    return karmed_bandit_agent->last_action();
+}
+
+void SimpleRLMoveGenerator::set_last_proposed_action(size_t action) {
+    karmed_bandit_agent->set_last_action(action);
+}
+
 /*                                        *
  *                                        *
  *  K-Armed bandit agent implementation   *
@@ -139,6 +147,7 @@ void KArmedBanditAgent::process_outcome(double reward, e_reward_function reward_
 
     //Update the estimated value of the last action
     q_[last_action_] += delta_q;
+    q_updated_(last_action_, delta_q);
 
     //write agent internal q-table and actions into a file for debugging purposes
     //agent_info_file_ variable is a NULL pointer by default
@@ -212,6 +221,7 @@ void EpsilonGreedyAgent::init_q_scores_() {
     q_ = std::vector<float>(num_available_actions_, 0.);
     num_action_chosen_ = std::vector<size_t>(num_available_actions_, 0);
     cumm_epsilon_action_prob_ = std::vector<float>(num_available_actions_, 1.0 / (num_available_actions_));
+    greedy_action_ = 0;
 
     //agent_info_file_ = vtr::fopen("agent_info.txt", "w");
     //write agent internal q-table and actions into file for debugging purposes
@@ -261,11 +271,9 @@ t_propose_action EpsilonGreedyAgent::propose_action() {
     } else {
         /* Greedy (Exploit)
          * For probability 1-epsilon, choose the greedy move_type */
-        auto itr = std::max_element(q_.begin(), q_.end());
-        VTR_ASSERT(itr != q_.end());
-        auto action_type_q_pos = itr - q_.begin();
+        VTR_ASSERT_SAFE(greedy_action_ == size_t(std::max_element(q_.begin(), q_.end()) - q_.begin()));
         //Mark the q_table location that agent used to update its value after processing the move outcome
-        last_action_ = action_type_q_pos;
+        last_action_ = greedy_action_;
     }
 
     t_propose_action proposed_action{action_to_move_type_(last_action_),
@@ -277,6 +285,18 @@ t_propose_action EpsilonGreedyAgent::propose_action() {
     return proposed_action;
 }
 
+void EpsilonGreedyAgent::q_updated_(size_t action_idx, float delta_q) {
+    if (action_idx == greedy_action_) {
+        if (delta_q < 0) {
+            // Another action may now have the highest value
+            greedy_action_ = std::max_element(q_.begin(), q_.end()) - q_.begin();
+        }
+    } else if (q_[action_idx] > q_[greedy_action_]
+               || (q_[action_idx] == q_[greedy_action_] && action_idx < greedy_action_)) {
+        greedy_action_ = action_idx;
+    }
+}
+
 void EpsilonGreedyAgent::set_epsilon(float epsilon) {
     VTR_LOG("Setting egreedy epsilon: %g\n", epsilon);
     epsilon_ = epsilon;
@@ -312,7 +332,7 @@ SoftmaxAgent::~SoftmaxAgent() {
 
 void SoftmaxAgent::init_q_scores_(const std::vector<int>& num_movable_blocks_per_type) {
     q_ = std::vector<float>(num_available_actions_, 0.);
-    exp_q_ = std::vector<float>(num_available_actions_, 0.);
+    exp_q_ = std::vector<float>(num_available_actions_, scaled_clipped_exp(0.));
     num_action_chosen_ = std::vector<size_t>(num_available_actions_, 0);
     action_prob_ = std::vector<float>(num_available_actions_, 0.);
     block_type_ratio_ = std::vector<float>(num_available_types_, 0.);
@@ -337,7 +357,10 @@ void SoftmaxAgent::init_q_scores_(const std::vector<int>& num_movable_blocks_per
 }
 
 t_propose_action SoftmaxAgent::propose_action() {
-    set_action_prob_();
+    if (num_batch_proposals_ == 0) {
+        set_action_prob_();
+    }
+    num_batch_proposals_ = (num_batch_proposals_ + 1) % batch_size_;
 
     float p = rng_.frand();
     auto itr = std::lower_bound(cumm_action_prob_.begin(), cumm_action_prob_.end(), p);
@@ -354,6 +377,16 @@ t_propose_action SoftmaxAgent::propose_action() {
     return proposed_action;
 }
 
+void SoftmaxAgent::set_batch_size(int batch_size) {
+    VTR_ASSERT(batch_size >= 1);
+    batch_size_ = batch_size;
+    num_batch_proposals_ = 0;
+}
+
+void SoftmaxAgent::q_updated_(size_t action_idx, float /*delta_q*/) {
+    exp_q_[action_idx] = scaled_clipped_exp(q_[action_idx]);
+}
+
 void SoftmaxAgent::set_block_ratio_(const std::vector<int>& num_movable_blocks_per_type) {
     size_t num_movable_total_blocks = std::max(1, std::accumulate(num_movable_blocks_per_type.begin(), num_movable_blocks_per_type.end(), 0));
 
@@ -374,8 +407,8 @@ void SoftmaxAgent::set_block_ratio_(const std::vector<int>& num_movable_blocks_p
 }
 
 void SoftmaxAgent::set_action_prob_() {
-    //calculate the scaled and clipped exponential function for the estimated q value for each action
-    std::transform(q_.begin(), q_.end(), exp_q_.begin(), scaled_clipped_exp);
+    //the scaled and clipped exponential function of the estimated q value of each action is kept up to date by q_updated_()
+    VTR_ASSERT_SAFE(exp_q_.size() == q_.size());
 
     //calculate the sum of all scaled clipped exponential q values
     float sum_q = std::accumulate(exp_q_.begin(), exp_q_.end(), 0.0);
@@ -55,6 +55,12 @@ class KArmedBanditAgent {
      */
     void set_step(float gamma, int move_lim);
 
+    /// @brief Returns the last action proposed by the agent
+    size_t last_action() const { return last_action_; }
+
+    /// @brief Makes the next process_outcome() call update the given action
+    void set_last_action(size_t action) { last_action_ = action; }
+
   protected:
     /**
      * @brief Converts an action index to a move type.
@@ -88,6 +94,15 @@ class KArmedBanditAgent {
      */
     inline int agent_to_phy_blk_type(int idx);
 
+    /**
+     * @brief Called by process_outcome() after the estimated value of an action changed,
+     * so that the derived agents update what they derive from the Q-table incrementally.
+     *
+     *   @param action_idx The action whose estimated value changed.
+     *   @param delta_q The change of its estimated value.
+     */
+    virtual void q_updated_(size_t /*action_idx*/, float /*delta_q*/) {}
+
   protected:
     float exp_alpha_ = -1;                     //Step size for q_ updates (< 0 implies use incremental average)
     std::vector<e_move_type> available_moves_; //All available moves from which the agent can choose
@@ -158,8 +173,15 @@ class EpsilonGreedyAgent : public KArmedBanditAgent {
      */
     void init_q_scores_();
 
+    /**
+     * @brief Keeps greedy_action_ the first action with the highest estimated value (as std::max_element()
+     * would find), only searching the Q-table again when the value of the greedy action decreases.
+     */
+    void q_updated_(size_t action_idx, float delta_q) override;
+
   private:
     float epsilon_ = 0.1;                         //How often to perform a non-greedy exploration action
+    size_t greedy_action_ = 0;                    //The action with the highest estimated value
     std::vector<float> cumm_epsilon_action_prob_; //The accumulative probability of choosing each action
 };
 
@@ -180,6 +202,16 @@ class SoftmaxAgent : public KArmedBanditAgent {
 
     t_propose_action propose_action() override; //Returns the type of the next action as well as the block type the agent wishes to perform
 
+  public:
+    /**
+     * @brief Set the number of actions proposed from the same action probabilities
+     *
+     *   @param batch_size The action probabilities are recomputed from the Q-table once every batch_size
+     *   proposals, can be specified by the command-line option "--place_agent_batch_size". The Q-table
+     *   itself is still updated after each move. Batch size default value is 1.
+     */
+    void set_batch_size(int batch_size);
+
   private:
     /**
      * @brief Initialize agent's Q-table and internal variable to zero (RL-agent learns everything throughout the placement run and has no prior knowledge)
@@ -204,7 +236,12 @@ class SoftmaxAgent : public KArmedBanditAgent {
      */
     void set_action_prob_();
 
+    /// @brief Updates the exponential of the estimated value of the action
+    void q_updated_(size_t action_idx, float delta_q) override;
+
   private:
+    int batch_size_ = 1;                  //Number of actions proposed from the same action probabilities
+    int num_batch_proposals_ = 0;         //Number of actions proposed since the action probabilities were computed
     std::vector<float> exp_q_;            //The clipped and scaled exponential of the estimated Q value for each action
     std::vector<float> action_prob_;      //The probability of choosing each action
     std::vector<float> cumm_action_prob_; //The accumulative probability of choosing each action
@@ -252,6 +289,9 @@ class SimpleRLMoveGenerator : public MoveGenerator {
 
     // Receives feedback about the outcome of the previously proposed move
     void process_outcome(double reward, e_reward_function reward_fun) override;
+
+    size_t last_proposed_action() const override;
+    void set_last_proposed_action(size_t action) override;
 };
 
 template<class T, class>
@@ -0,0 +1,108 @@
+#include "move_profiler.h"
+
+#include "vtr_assert.h"
+
+/// @brief Converts a clock duration to seconds
+static double to_sec(MoveProfiler::clock::duration time) {
+    return std::chrono::duration<double>(time).count();
+}
+
+MoveProfiler::MoveProfiler(const std::string& profile_file)
+    : profile_file_(nullptr, vtr::fclose) {
+    if (!profile_file.empty()) {
+        profile_file_ = std::unique_ptr<FILE, decltype(&vtr::fclose)>(vtr::fopen(profile_file.c_str(), "w"),
+                                                                      vtr::fclose);
+        fprintf(profile_file_.get(),
+                "temp_num,temp,rlim,move_type,"
+                "proposed,accepted,rejected,aborted,"
+                "propose_time,eval_time,timing_updates,timing_update_time,"
+                "time_per_proposal,moves_per_sec\n");
+    }
+}
+
+void MoveProfiler::record_move(e_move_type move_type, e_move_result outcome,
+                               clock::duration propose_time, clock::duration eval_time) {
+    VTR_ASSERT_SAFE(enabled());
+    VTR_ASSERT_SAFE(move_type < e_move_type::NUMBER_OF_AUTO_MOVES);
+
+    t_move_type_profile& profile = move_type_profiles_[(size_t)move_type];
+    profile.proposed++;
+    if (outcome == e_move_result::ACCEPTED) {
+        profile.accepted++;
+    } else if (outcome == e_move_result::REJECTED) {
+        profile.rejected++;
+    } else {
+        VTR_ASSERT_SAFE(outcome == e_move_result::ABORTED);
+        profile.aborted++;
+    }
+    profile.propose_time += to_sec(propose_time);
+    profile.eval_time += to_sec(eval_time);
+}
+
+void MoveProfiler::record_move_timing_update(e_move_type move_type, clock::duration time) {
+    VTR_ASSERT_SAFE(enabled());
+
+    t_move_type_profile& profile = move_type_profiles_[(size_t)move_type];
+    profile.timing_updates++;
+    profile.timing_update_time += to_sec(time);
+}
+
+void MoveProfiler::record_timing_update(clock::duration time) {
+    VTR_ASSERT_SAFE(enabled());
+
+    timing_update_profile_.timing_updates++;
+    timing_update_profile_.timing_update_time += to_sec(time);
+}
+
+void MoveProfiler::discard() {
+    move_type_profiles_.fill(t_move_type_profile());
+    timing_update_profile_ = t_move_type_profile();
+}
+
+void MoveProfiler::end_temperature(int temp_num, float t, float rlim) {
+    if (!enabled()) {
+        return;
+    }
+
+    t_move_type_profile total = timing_update_profile_;
+    for (size_t imove = 0; imove < move_type_profiles_.size(); imove++) {
+        const t_move_type_profile& profile = move_type_profiles_[imove];
+        if (profile.proposed == 0) {
+            continue;
+        }
+
+        print_profile_(temp_num, t, rlim, move_type_to_string(e_move_type(imove)).c_str(), profile, 0.);
+
+        total.proposed += profile.proposed;
+        total.accepted += profile.accepted;
+        total.rejected += profile.rejected;
+        total.aborted += profile.aborted;
+        total.propose_time += profile.propose_time;
+        total.eval_time += profile.eval_time;
+        total.timing_updates += profile.timing_updates;
+        total.timing_update_time += profile.timing_update_time;
+    }
+
+    // The total also includes the timing analyses done between moves, which take
+    // time that isn't part of any move's evaluation
+    print_profile_(temp_num, t, rlim, "Total", total, timing_update_profile_.timing_update_time);
+    fflush(profile_file_.get());
+
+    discard();
+}
+
+void MoveProfiler::print_profile_(int temp_num, float t, float rlim, const char* move_name,
+                                  const t_move_type_profile& profile, double other_time) {
+    double total_time = profile.propose_time + profile.eval_time + other_time;
+
+    fprintf(profile_file_.get(),
+            "%d,%g,%g,%s,"
+            "%d,%d,%d,%d,"
+            "%g,%g,%d,%g,"
+            "%g,%g\n",
+            temp_num, t, rlim, move_name,
+            profile.proposed, profile.accepted, profile.rejected, profile.aborted,
+            profile.propose_time, profile.eval_time, profile.timing_updates, profile.timing_update_time,
+            profile.proposed > 0 ? profile.propose_time / profile.proposed : 0.,
+            total_time > 0. ? profile.proposed / total_time : 0.);
+}
@@ -0,0 +1,89 @@
+#pragma once
+/**
+ * @file move_profiler.h
+ * @brief Declares the MoveProfiler class, which measures the cost of each move type during annealing.
+ *
+ * When a profile file is specified (--place_move_profile), the annealer times the proposal and the
+ * evaluation of every move, and the timing analyses it runs, and writes one CSV line per move type
+ * and temperature: the number of proposed, accepted, rejected and aborted moves, the time spent
+ * proposing and evaluating them, and the resulting moves per second. A last line per temperature
+ * gives the totals, including the timing analyses done between moves.
+ *
+ * With speculative moves (--place_speculative_moves) a batch's evaluation time is shared equally by
+ * its moves. Moves made by region partitioned annealing (--place_parallel_regions) are not profiled.
+ *
+ * Unlike --place_move_stats, the profile doesn't need VTR_ENABLE_DEBUG_LOGGING, and the overhead
+ * of collecting it is a few clock reads per move.
+ */
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "move_utils.h"
+#include "vtr_util.h"
+
+class MoveProfiler {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    ///@brief Opens the profile file and writes its header. Does nothing if the file name is empty.
+    explicit MoveProfiler(const std::string& profile_file);
+
+    ///@brief Returns true if moves are being profiled.
+    bool enabled() const { return bool(profile_file_); }
+
+    ///@brief Returns the current time if profiling, or the clock's epoch otherwise (without reading the clock).
+    clock::time_point now() const { return enabled() ? clock::now() : clock::time_point(); }
+
+    ///@brief Records a move of the given type, and the time spent proposing and evaluating it.
+    void record_move(e_move_type move_type, e_move_result outcome,
+                     clock::duration propose_time, clock::duration eval_time);
+
+    ///@brief Records a timing analysis done while evaluating a move of the given type (slack timing placement).
+    void record_move_timing_update(e_move_type move_type, clock::duration time);
+
+    ///@brief Records a timing analysis done between moves (e.g. a periodic criticality update).
+    void record_timing_update(clock::duration time);
+
+    ///@brief Forgets everything recorded since the last temperature (e.g. moves made to find the starting temperature).
+    void discard();
+
+    /**
+     * @brief Writes the profile of the temperature that just ended, and starts a new one.
+     *
+     *   @param temp_num The index of the temperature.
+     *   @param t The temperature.
+     *   @param rlim The range limit used at this temperature.
+     */
+    void end_temperature(int temp_num, float t, float rlim);
+
+  private:
+    struct t_move_type_profile {
+        int proposed = 0;
+        int accepted = 0;
+        int rejected = 0;
+        int aborted = 0;
+        double propose_time = 0.;
+        double eval_time = 0.;
+        ///@brief Part of the time (of eval_time, for moves) spent in timing analysis
+        double timing_update_time = 0.;
+        int timing_updates = 0;
+    };
+
+    /**
+     * @brief Writes a line of the profile.
+     *
+     *   @param other_time Time spent outside of the profiled moves, counted in the moves per second.
+     */
+    void print_profile_(int temp_num, float t, float rlim, const char* move_name,
+                        const t_move_type_profile& profile, double other_time);
+
+    std::unique_ptr<FILE, decltype(&vtr::fclose)> profile_file_;
+
+    ///@brief The profile of each move type at the current temperature
+    std::array<t_move_type_profile, (size_t)e_move_type::NUMBER_OF_AUTO_MOVES> move_type_profiles_;
+    ///@brief Timing analyses done between moves at the current temperature
+    t_move_type_profile timing_update_profile_;
+};
@@ -656,7 +656,8 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
                          t_pl_loc& to,
                          ClusterBlockId b_from,
                          const BlkLocRegistry& blk_loc_registry,
-                         vtr::RngContainer& rng) {
+                         vtr::RngContainer& rng,
+                         const t_bb* grid_limit) {
     //Finds a legal swap to location for the given type, starting from 'from.x' and 'from.y'
     //
     //Note that the range limit (rlim) is applied in a logical sense (i.e. 'compressed' grid space consisting
@@ -682,6 +683,30 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
     t_bb search_range = get_compressed_grid_target_search_range(compressed_block_grid,
                                                                 compressed_locs[to_layer_num],
                                                                 rlim);
+
+    if (grid_limit) {
+        if (to_layer_num < grid_limit->layer_min || to_layer_num > grid_limit->layer_max) {
+            return false;
+        }
+
+        //Keep the compressed columns and rows which fall inside the limit
+        t_physical_tile_loc limit_min = compressed_block_grid.grid_loc_to_compressed_loc_approx_round_up({grid_limit->xmin, grid_limit->ymin, to_layer_num});
+        t_physical_tile_loc limit_max = compressed_block_grid.grid_loc_to_compressed_loc_approx_round_down({grid_limit->xmax, grid_limit->ymax, to_layer_num});
+        t_physical_tile_loc grid_min = compressed_block_grid.compressed_loc_to_grid_loc(limit_min);
+        t_physical_tile_loc grid_max = compressed_block_grid.compressed_loc_to_grid_loc(limit_max);
+        if (grid_min.x < grid_limit->xmin || grid_min.y < grid_limit->ymin
+            || grid_max.x > grid_limit->xmax || grid_max.y > grid_limit->ymax) {
+            return false; //No column or no row of the type inside the limit
+        }
+
+        search_range.xmin = std::max(search_range.xmin, limit_min.x);
+        search_range.xmax = std::min(search_range.xmax, limit_max.x);
+        search_range.ymin = std::max(search_range.ymin, limit_min.y);
+        search_range.ymax = std::min(search_range.ymax, limit_max.y);
+        if (search_range.xmin > search_range.xmax || search_range.ymin > search_range.ymax) {
+            return false;
+        }
+    }
     int delta_cx = search_range.xmax - search_range.xmin;
 
     bool block_constrained = is_cluster_constrained(b_from);
@@ -1033,9 +1058,9 @@ bool find_compatible_compressed_loc_in_range(t_logical_block_type_ptr type,
         //We are careful here to consider that there may be a sparse
         //set of candidate blocks in the y-axis at this x location.
         //
-        //The candidates are stored in a flat_map so we can efficiently find the set of valid
+        //The candidates are stored sorted so we can efficiently find the set of valid
         //candidates with upper/lower bound.
-        const auto& block_rows = compressed_block_grid.get_column_block_map(to_loc.x, to_layer_num);
+        const t_compressed_column block_rows = compressed_block_grid.get_column_rows(to_loc.x, to_layer_num);
         adjust_search_range(type,
                             to_loc.x,
                             to_layer_num,
@@ -1065,7 +1090,7 @@ bool find_compatible_compressed_loc_in_range(t_logical_block_type_ptr type,
             }
 
             //Key in the y-dimension is the compressed index location
-            to_loc.y = (y_lower_iter + dy)->first;
+            to_loc.y = *(y_lower_iter + dy);
 
             VTR_ASSERT(to_loc.y >= search_range.ymin);
             VTR_ASSERT(to_loc.y <= search_range.ymax);
@@ -1236,7 +1261,7 @@ static void adjust_search_range(t_logical_block_type_ptr block_type,
 
     const auto& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[block_type->index];
 
-    size_t num_blocks_in_column = compressed_block_grid.get_column_block_map(compressed_column_num, to_layer_num).size();
+    size_t num_blocks_in_column = compressed_block_grid.get_column_rows(compressed_column_num, to_layer_num).size();
 
     if (num_blocks_in_column < MIN_NUM_BLOCKS_IN_COLUMN && !is_range_fixed) {
         search_range.ymin = 0;
@@ -221,13 +221,21 @@ ClusterBlockId pick_from_highly_critical_block(ClusterNetId& net_from,
                                                const PlacerCriticalities& placer_criticalities,
                                                vtr::RngContainer& rng);
 
+/**
+ * @brief Find a random swap to location for a block of the given type, within rlim of from
+ *        in the compressed grid of the type.
+ *
+ * @param grid_limit If given, only the grid locations inside it (on its layers) are considered,
+ * e.g. to keep the search of a parallel region annealer out of the other regions.
+ */
 bool find_to_loc_uniform(t_logical_block_type_ptr type,
                          float rlim,
                          const t_pl_loc& from,
                          t_pl_loc& to,
                          ClusterBlockId b_from,
                          const BlkLocRegistry& blk_loc_registry,
-                         vtr::RngContainer& rng);
+                         vtr::RngContainer& rng,
+                         const t_bb* grid_limit = nullptr);
 
 // Accessor f_placer_breakpoint_reached
 // return true when a placer breakpoint is reached
@@ -35,6 +35,7 @@
 #include "vtr_prefix_sum.h"
 #include "stats.h"
 
+#include <algorithm>
 #include <array>
 
 static constexpr int MAX_FANOUT_CROSSING_COUNT = 50;
@@ -90,7 +91,8 @@ NetCostHandler::NetCostHandler(const t_placer_opts& placer_opts,
                                bool cube_bb)
     : cube_bb_(cube_bb)
     , placer_state_(placer_state)
-    , placer_opts_(placer_opts) {
+    , placer_opts_(placer_opts)
+    , net_pins_(g_vpr_ctx.clustering().clb_net_pins) {
     const int num_layers = g_vpr_ctx.device().grid.get_num_layers();
     const size_t num_nets = g_vpr_ctx.clustering().clb_nlist.nets().size();
 
@@ -134,6 +136,25 @@ NetCostHandler::NetCostHandler(const t_placer_opts& placer_opts,
      * been recomputed. */
     bb_update_status_.resize(num_nets, NetUpdateState::NOT_UPDATED_YET);
 
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    VTR_ASSERT(net_pins_.is_current(clb_nlist));
+    pin_locs_.resize(net_pins_.num_pins());
+    ts_moved_pins_.resize(num_nets);
+
+    net_pin_histogram_index_.resize(num_nets, -1);
+    if (cube_bb_) {
+        const DeviceGrid& grid = g_vpr_ctx.device().grid;
+        for (ClusterNetId net_id : clb_nlist.nets()) {
+            if (!clb_nlist.net_is_ignored(net_id) && clb_nlist.net_sinks(net_id).size() >= HIGH_FANOUT_NET_HISTOGRAM_SINKS) {
+                net_pin_histogram_index_[net_id] = net_pin_histograms_.size();
+                t_net_pin_histogram& histogram = net_pin_histograms_.emplace_back();
+                histogram.x_counts.resize(grid.width(), 0);
+                histogram.y_counts.resize(grid.height(), 0);
+                histogram.layer_counts.resize(num_layers, 0);
+            }
+        }
+    }
+
     alloc_and_load_chan_w_factors_for_place_cost_();
 }
 
@@ -229,9 +250,23 @@ void NetCostHandler::alloc_and_load_for_fast_vertical_cost_update_() {
 }
 
 std::pair<double, double> NetCostHandler::comp_bb_cost(e_cost_methods method) {
+    load_pin_locs_();
     return comp_bb_cost_functor_(method);
 }
 
+void NetCostHandler::load_pin_locs_() {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& blk_loc_registry = placer_state_.blk_loc_registry();
+
+    for (ClusterNetId net_id : clb_nlist.nets()) {
+        size_t ipin = net_pins_.net_pin_offset(net_id);
+        for (ClusterPinId pin_id : net_pins_.net_pins(net_id)) {
+            pin_locs_[ipin++] = blk_loc_registry.get_coordinate_of_pin(pin_id);
+        }
+        ts_moved_pins_[net_id].clear();
+    }
+}
+
 std::pair<double, double> NetCostHandler::comp_cube_bb_cost_(e_cost_methods method) {
     const auto& cluster_ctx = g_vpr_ctx.clustering();
 
@@ -244,6 +279,9 @@ std::pair<double, double> NetCostHandler::comp_cube_bb_cost_(e_cost_methods meth
              * so they can use a fast bounding box calculator.                    */
             if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET && method == e_cost_methods::NORMAL) {
                 get_bb_from_scratch_(net_id, /*use_ts=*/false);
+                if (net_pin_histogram_index_[net_id] >= 0) {
+                    load_net_pin_histogram_(net_id);
+                }
             } else {
                 get_non_updatable_cube_bb_(net_id, /*use_ts=*/false);
             }
@@ -290,11 +328,8 @@ std::pair<double, double> NetCostHandler::comp_per_layer_bb_cost_(e_cost_methods
 }
 
 void NetCostHandler::update_net_bb_(const ClusterNetId net,
-                                    const ClusterBlockId blk,
-                                    const ClusterPinId blk_pin,
-                                    const t_pl_moved_block& pl_moved_block) {
+                                    const ClusterPinId blk_pin) {
     const auto& cluster_ctx = g_vpr_ctx.clustering();
-    const auto& block_locs = placer_state_.block_locs();
 
     if (cluster_ctx.clb_nlist.net_sinks(net).size() < SMALL_NET) {
         //For small nets brute-force bounding box update is faster
@@ -304,23 +339,16 @@ void NetCostHandler::update_net_bb_(const ClusterNetId net,
         }
     } else {
         //For large nets, update bounding box incrementally
-        int iblk_pin = placer_state_.blk_loc_registry().tile_pin_index(blk_pin);
-
-        t_pl_loc block_loc = block_locs[blk].loc;
-        t_physical_tile_type_ptr blk_type = physical_tile_type(block_loc);
-        int pin_width_offset = blk_type->pin_width_offset[iblk_pin];
-        int pin_height_offset = blk_type->pin_height_offset[iblk_pin];
+        const size_t ipin = net_pins_.net_pin_offset(net) + cluster_ctx.clb_nlist.pin_net_index(blk_pin);
         bool is_driver = cluster_ctx.clb_nlist.pin_type(blk_pin) == PinType::DRIVER;
 
+        // The pin has been recorded as moved before any bounding box is updated
+        auto moved_pin = std::find_if(ts_moved_pins_[net].begin(), ts_moved_pins_[net].end(),
+                                      [ipin](const std::pair<size_t, t_physical_tile_loc>& p) { return p.first == ipin; });
+        VTR_ASSERT_SAFE(moved_pin != ts_moved_pins_[net].end());
+
         //Incremental bounding box update
-        update_bb_functor_(net,
-                           {pl_moved_block.old_loc.x + pin_width_offset,
-                            pl_moved_block.old_loc.y + pin_height_offset,
-                            pl_moved_block.old_loc.layer},
-                           {pl_moved_block.new_loc.x + pin_width_offset,
-                            pl_moved_block.new_loc.y + pin_height_offset,
-                            pl_moved_block.new_loc.layer},
-                           is_driver);
+        update_bb_functor_(net, moved_pin->second, pin_locs_[ipin], is_driver);
     }
 }
 
@@ -367,8 +395,15 @@ void NetCostHandler::update_td_delta_costs_(const PlaceDelayModel* delay_model,
     if (cluster_ctx.clb_nlist.pin_type(pin) == PinType::DRIVER) {
         /* This pin is a net driver on a moved block. */
         /* Recompute all point to point connection delays for the net sinks. */
-        for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net).size(); ipin++) {
-            float temp_delay = comp_td_single_connection_delay(delay_model, block_locs, net, ipin);
+#ifdef VPR_USE_TBB
+        t_delay_scratch& delay_scratch = ts_delay_scratch_.local();
+#else
+        t_delay_scratch& delay_scratch = ts_delay_scratch_;
+#endif
+        comp_td_net_connection_delays(delay_model, block_locs, net, delay_scratch.batch, delay_scratch.net_delays);
+        const vtr::array_view<const ClusterPinId> net_pins = net_pins_.net_pins(net);
+        for (size_t ipin = 1; ipin < net_pins.size(); ipin++) {
+            float temp_delay = delay_scratch.net_delays[ipin];
             /* If the delay hasn't changed, do not mark this pin as affected */
             if (temp_delay == connection_delay[net][ipin]) {
                 continue;
@@ -381,8 +416,7 @@ void NetCostHandler::update_td_delta_costs_(const PlaceDelayModel* delay_model,
             delta_timing_cost += proposed_connection_timing_cost[net][ipin] - connection_timing_cost[net][ipin];
 
             /* Record this connection in blocks_affected.affected_pins */
-            ClusterPinId sink_pin = cluster_ctx.clb_nlist.net_pin(net, ipin);
-            affected_pins.push_back(sink_pin);
+            affected_pins.push_back(net_pins[ipin]);
         }
     } else {
         /* This pin is a net sink on a moved block */
@@ -412,12 +446,11 @@ void NetCostHandler::update_td_delta_costs_(const PlaceDelayModel* delay_model,
 }
 
 ///@brief Record effected nets.
-void NetCostHandler::record_affected_net_(const ClusterNetId net) {
+void NetCostHandler::record_affected_net_(const ClusterNetId net, std::vector<ClusterNetId>& affected_nets) {
     /* Record effected nets. */
     if (proposed_net_cost_[net] < 0.) {
         /* Net not marked yet. */
-        VTR_ASSERT_SAFE(ts_nets_to_update_.size() < ts_nets_to_update_.capacity());
-        ts_nets_to_update_.push_back(net);
+        affected_nets.push_back(net);
 
         /* Flag to say we've marked this net. */
         proposed_net_cost_[net] = 1.;
@@ -427,10 +460,10 @@ void NetCostHandler::record_affected_net_(const ClusterNetId net) {
 void NetCostHandler::update_net_info_on_pin_move_(const PlaceDelayModel* delay_model,
                                                   const PlacerCriticalities* criticalities,
                                                   const ClusterPinId pin_id,
-                                                  const t_pl_moved_block& moving_blk_inf,
                                                   std::vector<ClusterPinId>& affected_pins,
                                                   double& timing_delta_c,
-                                                  bool is_src_moving) {
+                                                  bool is_src_moving,
+                                                  std::vector<ClusterNetId>& affected_nets) {
     const auto& cluster_ctx = g_vpr_ctx.clustering();
 
     const ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(pin_id);
@@ -444,11 +477,10 @@ void NetCostHandler::update_net_info_on_pin_move_(const PlaceDelayModel* delay_m
     }
 
     // Record effected nets
-    record_affected_net_(net_id);
+    record_affected_net_(net_id, affected_nets);
 
-    ClusterBlockId blk_id = moving_blk_inf.block_num;
     // Update the net bounding boxes.
-    update_net_bb_(net_id, blk_id, pin_id, moving_blk_inf);
+    update_net_bb_(net_id, pin_id);
 
     if (placer_opts_.place_algorithm.is_timing_driven()) {
         // Determine the change in connection delay and timing cost.
@@ -464,9 +496,7 @@ void NetCostHandler::update_net_info_on_pin_move_(const PlaceDelayModel* delay_m
 
 void NetCostHandler::get_non_updatable_cube_bb_(ClusterNetId net_id, bool use_ts) {
     //TODO: account for multiple physical pin instances per logical pin
-    const auto& cluster_ctx = g_vpr_ctx.clustering();
     const auto& device_ctx = g_vpr_ctx.device();
-    const auto& blk_loc_registry = placer_state_.blk_loc_registry();
 
     // the bounding box coordinates that is going to be updated by this function
     t_bb& bb_coord_new = use_ts ? ts_bb_coord_new_[net_id] : bb_coords_[net_id];
@@ -474,8 +504,8 @@ void NetCostHandler::get_non_updatable_cube_bb_(ClusterNetId net_id, bool use_ts
     vtr::NdMatrixProxy<int, 1> num_sink_pin_layer = use_ts ? ts_layer_sink_pin_count_[size_t(net_id)] : num_sink_pin_layer_[size_t(net_id)];
 
     // get the source pin's location
-    ClusterPinId source_pin_id = cluster_ctx.clb_nlist.net_pin(net_id, 0);
-    t_physical_tile_loc source_pin_loc = blk_loc_registry.get_coordinate_of_pin(source_pin_id);
+    const vtr::array_view<const t_physical_tile_loc> pin_locs = net_pin_locs_(net_id);
+    const t_physical_tile_loc& source_pin_loc = pin_locs[0];
 
     // initialize the bounding box coordinates with the source pin's coordinates
     bb_coord_new.xmin = source_pin_loc.x;
@@ -489,8 +519,8 @@ void NetCostHandler::get_non_updatable_cube_bb_(ClusterNetId net_id, bool use_ts
         num_sink_pin_layer[layer_num] = 0;
     }
 
-    for (ClusterPinId pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        t_physical_tile_loc pin_loc = blk_loc_registry.get_coordinate_of_pin(pin_id);
+    for (size_t ipin = 1; ipin < pin_locs.size(); ipin++) {
+        const t_physical_tile_loc& pin_loc = pin_locs[ipin];
 
         if (pin_loc.x < bb_coord_new.xmin) {
             bb_coord_new.xmin = pin_loc.x;
@@ -517,8 +547,6 @@ void NetCostHandler::get_non_updatable_cube_bb_(ClusterNetId net_id, bool use_ts
 void NetCostHandler::get_non_updatable_per_layer_bb_(ClusterNetId net_id, bool use_ts) {
     //TODO: account for multiple physical pin instances per logical pin
     const auto& device_ctx = g_vpr_ctx.device();
-    const auto& cluster_ctx = g_vpr_ctx.clustering();
-    const auto& blk_loc_registry = placer_state_.blk_loc_registry();
 
     std::vector<t_2D_bb>& bb_coord_new = use_ts ? layer_ts_bb_coord_new_[net_id] : layer_bb_coords_[net_id];
     vtr::NdMatrixProxy<int, 1> num_sink_layer = use_ts ? ts_layer_sink_pin_count_[size_t(net_id)] : num_sink_pin_layer_[size_t(net_id)];
@@ -527,16 +555,16 @@ void NetCostHandler::get_non_updatable_per_layer_bb_(ClusterNetId net_id, bool u
     VTR_ASSERT_DEBUG(bb_coord_new.size() == (size_t)num_layers);
 
     // get the source pin's location
-    ClusterPinId source_pin_id = cluster_ctx.clb_nlist.net_pin(net_id, 0);
-    t_physical_tile_loc source_pin_loc = blk_loc_registry.get_coordinate_of_pin(source_pin_id);
+    const vtr::array_view<const t_physical_tile_loc> pin_locs = net_pin_locs_(net_id);
+    const t_physical_tile_loc& source_pin_loc = pin_locs[0];
 
     for (int layer_num = 0; layer_num < num_layers; layer_num++) {
         bb_coord_new[layer_num] = t_2D_bb{source_pin_loc.x, source_pin_loc.x, source_pin_loc.y, source_pin_loc.y, source_pin_loc.layer_num};
         num_sink_layer[layer_num] = 0;
     }
 
-    for (ClusterPinId pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        t_physical_tile_loc pin_loc = blk_loc_registry.get_coordinate_of_pin(pin_id);
+    for (size_t ipin = 1; ipin < pin_locs.size(); ipin++) {
+        const t_physical_tile_loc& pin_loc = pin_locs[ipin];
         num_sink_layer[pin_loc.layer_num]++;
 
         if (pin_loc.x < bb_coord_new[pin_loc.layer_num].xmin) {
@@ -577,6 +605,11 @@ void NetCostHandler::update_bb_(ClusterNetId net_id,
         return;
     }
 
+    if (net_pin_histogram_index_[net_id] >= 0) {
+        update_bb_from_histogram_(net_id, pin_old_loc, pin_new_loc, src_pin);
+        return;
+    }
+
     vtr::NdMatrixProxy<int, 1> curr_num_sink_pin_layer = (bb_update_status_[net_id] == NetUpdateState::NOT_UPDATED_YET) ? num_sink_pin_layer_[size_t(net_id)] : num_sink_pin_layer_new;
 
     if (bb_update_status_[net_id] == NetUpdateState::NOT_UPDATED_YET) {
@@ -821,6 +854,69 @@ void NetCostHandler::update_bb_(ClusterNetId net_id,
     }
 }
 
+void NetCostHandler::update_bb_from_histogram_(ClusterNetId net_id,
+                                               t_physical_tile_loc pin_old_loc,
+                                               t_physical_tile_loc pin_new_loc,
+                                               bool src_pin) {
+    t_net_pin_histogram& histogram = net_pin_histograms_[net_pin_histogram_index_[net_id]];
+
+    t_bb& bb_edge_new = ts_bb_edge_new_[net_id];
+    t_bb& bb_coord_new = ts_bb_coord_new_[net_id];
+    vtr::NdMatrixProxy<int, 1> num_sink_pin_layer_new = ts_layer_sink_pin_count_[size_t(net_id)];
+
+    if (bb_update_status_[net_id] == NetUpdateState::NOT_UPDATED_YET) {
+        bb_coord_new = bb_coords_[net_id];
+        for (size_t layer_num = 0; layer_num < g_vpr_ctx.device().grid.get_num_layers(); layer_num++) {
+            num_sink_pin_layer_new[layer_num] = num_sink_pin_layer_[size_t(net_id)][layer_num];
+        }
+        bb_update_status_[net_id] = NetUpdateState::UPDATED_ONCE;
+    }
+
+    if (!src_pin) {
+        num_sink_pin_layer_new[pin_old_loc.layer_num]--;
+        num_sink_pin_layer_new[pin_new_loc.layer_num]++;
+    }
+
+    histogram.x_counts[pin_old_loc.x]--;
+    histogram.y_counts[pin_old_loc.y]--;
+    histogram.layer_counts[pin_old_loc.layer_num]--;
+    histogram.x_counts[pin_new_loc.x]++;
+    histogram.y_counts[pin_new_loc.y]++;
+    histogram.layer_counts[pin_new_loc.layer_num]++;
+
+    // Grow the bounding box to the new pin location, then shrink each edge left without pins
+    // to the next occupied coordinate. The new pin guarantees that the scans terminate.
+    auto update_range = [](const std::vector<int>& counts, int new_coord, int& min, int& max, int& min_edge, int& max_edge) {
+        min = std::min(min, new_coord);
+        max = std::max(max, new_coord);
+        while (counts[min] == 0) {
+            min++;
+        }
+        while (counts[max] == 0) {
+            max--;
+        }
+        min_edge = counts[min];
+        max_edge = counts[max];
+    };
+
+    update_range(histogram.x_counts, pin_new_loc.x, bb_coord_new.xmin, bb_coord_new.xmax, bb_edge_new.xmin, bb_edge_new.xmax);
+    update_range(histogram.y_counts, pin_new_loc.y, bb_coord_new.ymin, bb_coord_new.ymax, bb_edge_new.ymin, bb_edge_new.ymax);
+    update_range(histogram.layer_counts, pin_new_loc.layer_num, bb_coord_new.layer_min, bb_coord_new.layer_max, bb_edge_new.layer_min, bb_edge_new.layer_max);
+}
+
+void NetCostHandler::load_net_pin_histogram_(ClusterNetId net_id) {
+    t_net_pin_histogram& histogram = net_pin_histograms_[net_pin_histogram_index_[net_id]];
+    std::fill(histogram.x_counts.begin(), histogram.x_counts.end(), 0);
+    std::fill(histogram.y_counts.begin(), histogram.y_counts.end(), 0);
+    std::fill(histogram.layer_counts.begin(), histogram.layer_counts.end(), 0);
+
+    for (const t_physical_tile_loc& pin_loc : net_pin_locs_(net_id)) {
+        histogram.x_counts[pin_loc.x]++;
+        histogram.y_counts[pin_loc.y]++;
+        histogram.layer_counts[pin_loc.layer_num]++;
+    }
+}
+
 void NetCostHandler::update_layer_bb_(ClusterNetId net_id,
                                       t_physical_tile_loc pin_old_loc,
                                       t_physical_tile_loc pin_new_loc,
@@ -1163,18 +1259,16 @@ static void add_block_to_bb(const t_physical_tile_loc& new_pin_loc,
 }
 
 void NetCostHandler::get_bb_from_scratch_(ClusterNetId net_id, bool use_ts) {
-    const auto& cluster_ctx = g_vpr_ctx.clustering();
     const auto& device_ctx = g_vpr_ctx.device();
     const auto& grid = device_ctx.grid;
-    const auto& blk_loc_registry = placer_state_.blk_loc_registry();
 
     t_bb& coords = use_ts ? ts_bb_coord_new_[net_id] : bb_coords_[net_id];
     t_bb& num_on_edges = use_ts ? ts_bb_edge_new_[net_id] : bb_num_on_edges_[net_id];
     vtr::NdMatrixProxy<int, 1> num_sink_pin_layer = use_ts ? ts_layer_sink_pin_count_[(size_t)net_id] : num_sink_pin_layer_[(size_t)net_id];
 
     // get the source pin's location
-    ClusterPinId source_pin_id = cluster_ctx.clb_nlist.net_pin(net_id, 0);
-    t_physical_tile_loc source_pin_loc = blk_loc_registry.get_coordinate_of_pin(source_pin_id);
+    const vtr::array_view<const t_physical_tile_loc> pin_locs = net_pin_locs_(net_id);
+    const t_physical_tile_loc& source_pin_loc = pin_locs[0];
 
     int xmin = source_pin_loc.x;
     int ymin = source_pin_loc.y;
@@ -1194,8 +1288,8 @@ void NetCostHandler::get_bb_from_scratch_(ClusterNetId net_id, bool use_ts) {
         num_sink_pin_layer[layer_num] = 0;
     }
 
-    for (ClusterPinId pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        t_physical_tile_loc pin_loc = blk_loc_registry.get_coordinate_of_pin(pin_id);
+    for (size_t ipin = 1; ipin < pin_locs.size(); ipin++) {
+        const t_physical_tile_loc& pin_loc = pin_locs[ipin];
 
         if (pin_loc.x == xmin) {
             xmin_edge++;
@@ -1262,16 +1356,14 @@ void NetCostHandler::get_layer_bb_from_scratch_(ClusterNetId net_id,
                                                 std::vector<t_2D_bb>& coords,
                                                 vtr::NdMatrixProxy<int, 1> layer_pin_sink_count) {
     const auto& device_ctx = g_vpr_ctx.device();
-    const auto& cluster_ctx = g_vpr_ctx.clustering();
-    const auto& blk_loc_registry = placer_state_.blk_loc_registry();
 
     const int num_layers = device_ctx.grid.get_num_layers();
     VTR_ASSERT_DEBUG(coords.size() == (size_t)num_layers);
     VTR_ASSERT_DEBUG(num_on_edges.size() == (size_t)num_layers);
 
     // get the source pin's location
-    ClusterPinId source_pin_id = cluster_ctx.clb_nlist.net_pin(net_id, 0);
-    t_physical_tile_loc source_pin_loc = blk_loc_registry.get_coordinate_of_pin(source_pin_id);
+    const vtr::array_view<const t_physical_tile_loc> pin_locs = net_pin_locs_(net_id);
+    const t_physical_tile_loc& source_pin_loc = pin_locs[0];
 
     // TODO: Currently we are assuming that crossing can only happen from OPIN. Because of that,
     // when per-layer bounding box is used, we want the bounding box on each layer to also include
@@ -1282,8 +1374,8 @@ void NetCostHandler::get_layer_bb_from_scratch_(ClusterNetId net_id,
         layer_pin_sink_count[layer_num] = 0;
     }
 
-    for (ClusterPinId pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        t_physical_tile_loc pin_loc = blk_loc_registry.get_coordinate_of_pin(pin_id);
+    for (size_t ipin = 1; ipin < pin_locs.size(); ipin++) {
+        const t_physical_tile_loc& pin_loc = pin_locs[ipin];
         VTR_ASSERT_SAFE(pin_loc.layer_num >= 0 && pin_loc.layer_num < num_layers);
         layer_pin_sink_count[pin_loc.layer_num]++;
 
@@ -1485,8 +1577,8 @@ double wirelength_crossing_count(size_t fanout) {
     }
 }
 
-void NetCostHandler::set_bb_delta_cost_(double& bb_delta_c) {
-    for (const ClusterNetId ts_net : ts_nets_to_update_) {
+void NetCostHandler::set_bb_delta_cost_(double& bb_delta_c, const std::vector<ClusterNetId>& affected_nets) {
+    for (const ClusterNetId ts_net : affected_nets) {
         ClusterNetId net_id = ts_net;
 
         proposed_net_cost_[net_id] = get_net_bb_cost_functor_(net_id);
@@ -1500,11 +1592,36 @@ void NetCostHandler::find_affected_nets_and_update_costs(const PlaceDelayModel*
                                                          t_pl_blocks_to_be_moved& blocks_affected,
                                                          double& bb_delta_c,
                                                          double& timing_delta_c) {
+    find_affected_nets_and_update_costs(delay_model, criticalities, blocks_affected,
+                                        bb_delta_c, timing_delta_c, ts_nets_to_update_);
+}
+
+void NetCostHandler::find_affected_nets_and_update_costs(const PlaceDelayModel* delay_model,
+                                                         const PlacerCriticalities* criticalities,
+                                                         t_pl_blocks_to_be_moved& blocks_affected,
+                                                         double& bb_delta_c,
+                                                         double& timing_delta_c,
+                                                         std::vector<ClusterNetId>& affected_nets) {
     VTR_ASSERT_SAFE(bb_delta_c == 0.);
     VTR_ASSERT_SAFE(timing_delta_c == 0.);
     auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
 
-    ts_nets_to_update_.resize(0);
+    affected_nets.resize(0);
+
+    // Move the pins of the moved blocks in pin_locs_ first, since the bounding boxes computed from
+    // scratch need the new locations of all of them
+    const auto& blk_loc_registry = placer_state_.blk_loc_registry();
+    for (const t_pl_moved_block& moving_block : blocks_affected.moved_blocks) {
+        for (ClusterPinId blk_pin : clb_nlist.block_pins(moving_block.block_num)) {
+            ClusterNetId net_id = clb_nlist.pin_net(blk_pin);
+            if (clb_nlist.net_is_ignored(net_id)) {
+                continue;
+            }
+            const size_t ipin = net_pins_.net_pin_offset(net_id) + clb_nlist.pin_net_index(blk_pin);
+            ts_moved_pins_[net_id].emplace_back(ipin, pin_locs_[ipin]);
+            pin_locs_[ipin] = blk_loc_registry.get_coordinate_of_pin(blk_pin);
+        }
+    }
 
     /* Go through all the blocks moved. */
     for (const t_pl_moved_block& moving_block : blocks_affected.moved_blocks) {
@@ -1521,23 +1638,27 @@ void NetCostHandler::find_affected_nets_and_update_costs(const PlaceDelayModel*
             update_net_info_on_pin_move_(delay_model,
                                          criticalities,
                                          blk_pin,
-                                         moving_block,
                                          affected_pins,
                                          timing_delta_c,
-                                         is_src_moving);
+                                         is_src_moving,
+                                         affected_nets);
         }
     }
 
     /* Now update the bounding box costs (since the net bounding     *
      * boxes are up-to-date). The cost is only updated once per net. */
-    set_bb_delta_cost_(bb_delta_c);
+    set_bb_delta_cost_(bb_delta_c, affected_nets);
 }
 
 void NetCostHandler::update_move_nets() {
+    update_move_nets(ts_nets_to_update_);
+}
+
+void NetCostHandler::update_move_nets(const std::vector<ClusterNetId>& affected_nets) {
     /* update net cost functions and reset flags. */
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
-    for (const ClusterNetId ts_net : ts_nets_to_update_) {
+    for (const ClusterNetId ts_net : affected_nets) {
         ClusterNetId net_id = ts_net;
 
         set_ts_bb_coord_(net_id);
@@ -1552,6 +1673,8 @@ void NetCostHandler::update_move_nets() {
 
         net_cost_[net_id] = proposed_net_cost_[net_id];
 
+        ts_moved_pins_[net_id].clear();
+
         /* negative proposed_net_cost value is acting as a flag to mean not computed yet. */
         proposed_net_cost_[net_id] = -1;
         bb_update_status_[net_id] = NetUpdateState::NOT_UPDATED_YET;
@@ -1559,11 +1682,31 @@ void NetCostHandler::update_move_nets() {
 }
 
 void NetCostHandler::reset_move_nets() {
+    reset_move_nets(ts_nets_to_update_);
+}
+
+void NetCostHandler::reset_move_nets(const std::vector<ClusterNetId>& affected_nets) {
     /* Reset the net cost function flags first. */
-    for (const ClusterNetId ts_net : ts_nets_to_update_) {
+    for (const ClusterNetId ts_net : affected_nets) {
         ClusterNetId net_id = ts_net;
         proposed_net_cost_[net_id] = -1;
         bb_update_status_[net_id] = NetUpdateState::NOT_UPDATED_YET;
+
+        // Move the pins of the rejected move back (and in the net's histogram, if it has one)
+        t_net_pin_histogram* histogram = net_pin_histogram_index_[net_id] >= 0 ? &net_pin_histograms_[net_pin_histogram_index_[net_id]] : nullptr;
+        for (const auto& [ipin, pin_old_loc] : ts_moved_pins_[net_id]) {
+            if (histogram) {
+                const t_physical_tile_loc& pin_new_loc = pin_locs_[ipin];
+                histogram->x_counts[pin_new_loc.x]--;
+                histogram->y_counts[pin_new_loc.y]--;
+                histogram->layer_counts[pin_new_loc.layer_num]--;
+                histogram->x_counts[pin_old_loc.x]++;
+                histogram->y_counts[pin_old_loc.y]++;
+                histogram->layer_counts[pin_old_loc.layer_num]++;
+            }
+            pin_locs_[ipin] = pin_old_loc;
+        }
+        ts_moved_pins_[net_id].clear();
     }
 }
 
@@ -7,11 +7,17 @@
 
 #include "place_delay_model.h"
 #include "move_transactions.h"
+#include "net_pins_csr.h"
 #include "place_util.h"
 #include "vtr_prefix_sum.h"
+#include "vtr_array_view.h"
 
 #include <functional>
 
+#ifdef VPR_USE_TBB
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
 class PlacerState;
 class PlacerCriticalities;
 
@@ -99,11 +105,28 @@ class NetCostHandler {
                                              double& bb_delta_c,
                                              double& timing_delta_c);
 
+    /**
+     * @brief Same as above, but records the affected nets in affected_nets instead of ts_nets_to_update.
+     *
+     * All the per-move state is kept per net, so several moves can be evaluated concurrently as long as
+     * they affect disjoint sets of nets and each has its own affected_nets list. The move must then be
+     * finished with the reset_move_nets() or update_move_nets() overloads taking the same list.
+     */
+    void find_affected_nets_and_update_costs(const PlaceDelayModel* delay_model,
+                                             const PlacerCriticalities* criticalities,
+                                             t_pl_blocks_to_be_moved& blocks_affected,
+                                             double& bb_delta_c,
+                                             double& timing_delta_c,
+                                             std::vector<ClusterNetId>& affected_nets);
+
     /**
      * @brief Reset the net cost function flags (proposed_net_cost and bb_updated_before)
      */
     void reset_move_nets();
 
+    /// @brief Reset the net cost function flags of the given affected nets.
+    void reset_move_nets(const std::vector<ClusterNetId>& affected_nets);
+
     /**
      * @brief Update net cost data structures (in placer context and net_cost in .cpp file)
      * and reset flags (proposed_net_cost and bb_updated_before).
@@ -112,6 +135,9 @@ class NetCostHandler {
      */
     void update_move_nets();
 
+    /// @brief Update the net cost data structures of the given affected nets and reset their flags.
+    void update_move_nets(const std::vector<ClusterNetId>& affected_nets);
+
     /**
      * @brief Re-calculates different terms of the cost function (wire-length, timing, NoC)
      * and update "costs" accordingly. It is important to note that in this function bounding box
@@ -194,6 +220,17 @@ class NetCostHandler {
     vtr::Matrix<int> ts_layer_sink_pin_count_;
     /* [0...num_affected_nets] -> net_id of the affected nets */
     std::vector<ClusterNetId> ts_nets_to_update_;
+    /* Scratch for the delays of the sinks of a moved driver, looked up in one batch. Per thread, since the
+     * moves of try_swap_batch_() and try_swap_regions_() are evaluated concurrently. */
+    struct t_delay_scratch {
+        t_delay_batch batch;
+        std::vector<float> net_delays;
+    };
+#ifdef VPR_USE_TBB
+    tbb::enumerable_thread_specific<t_delay_scratch> ts_delay_scratch_;
+#else
+    t_delay_scratch ts_delay_scratch_;
+#endif
 
     // [0..cluster_ctx.clb_nlist.nets().size()-1]. Store the number of blocks on each of a net's bounding box (to allow efficient updates)
     vtr::vector<ClusterNetId, t_bb> bb_num_on_edges_;
@@ -232,6 +269,42 @@ class NetCostHandler {
     vtr::vector<ClusterNetId, double> proposed_net_cost_;
     vtr::vector<ClusterNetId, NetUpdateState> bb_update_status_;
 
+    /**
+     * @brief Coordinates of the pins of all nets, stored contiguously net after net (driver first), so that
+     * bounding boxes are computed by walking a flat array instead of the netlist and block locations.
+     *
+     * The pins of net `n` are at the same indices as in net_pins_ (ClusteringContext::clb_net_pins), in the order
+     * of ClusteredNetlist::net_pins(). The coordinates follow the proposed move: find_affected_nets_and_update_costs()
+     * moves the pins of the moved blocks, and reset_move_nets() moves them back.
+     */
+    std::vector<t_physical_tile_loc> pin_locs_;
+    const ClbNetPinsCsr& net_pins_;
+    /// Index in pin_locs_ and old coordinates of the pins of each net moved by the current move
+    vtr::vector<ClusterNetId, std::vector<std::pair<size_t, t_physical_tile_loc>>> ts_moved_pins_;
+
+    /**
+     * @brief Number of pins of a high fanout net at each x, y and layer coordinate.
+     *
+     * When a pin leaves a bounding box edge it was alone on, the new edge is found by scanning the
+     * histogram inwards from the old one, instead of computing the bounding box from scratch. With
+     * many pins the next occupied coordinate is close, so the update cost no longer grows with
+     * the fanout.
+     *
+     * Like pin_locs_, the histograms count the pins at their proposed locations.
+     */
+    struct t_net_pin_histogram {
+        std::vector<int> x_counts;
+        std::vector<int> y_counts;
+        std::vector<int> layer_counts;
+    };
+
+    /// Nets with at least this many sinks keep a pin histogram (3D bounding boxes only)
+    static constexpr size_t HIGH_FANOUT_NET_HISTOGRAM_SINKS = 64;
+
+    /// Index of each net's histogram in net_pin_histograms_, or -1 if it has none
+    vtr::vector<ClusterNetId, int> net_pin_histogram_index_;
+    std::vector<t_net_pin_histogram> net_pin_histograms_;
+
     /**
      * @brief Matrices below are used to precompute the inverse of the average
      * number of tracks per channel between [subhigh] and [sublow].  Access
@@ -257,13 +330,11 @@ class NetCostHandler {
   private:
     /**
      * @brief Update the bounding box (3D) of the net connected to blk_pin. The old and new locations of the pin are
-     * stored in pl_moved_block. The updated bounding box will be stored in ts data structures. Do not update the net
-     * cost here since it should only be updated once per net, not once per pin.
+     * taken from ts_moved_pins_ and pin_locs_. The updated bounding box will be stored in ts data structures. Do not
+     * update the net cost here since it should only be updated once per net, not once per pin.
      */
     void update_net_bb_(const ClusterNetId net,
-                        const ClusterBlockId blk,
-                        const ClusterPinId blk_pin,
-                        const t_pl_moved_block& pl_moved_block);
+                        const ClusterPinId blk_pin);
 
     /**
      * @brief Call suitable function based on the bounding box type to update the bounding box of the net connected to pin_id. Also,
@@ -271,25 +342,26 @@ class NetCostHandler {
      * @param delay_model Timing delay model used by placer
      * @param criticalities Connections timing criticalities
      * @param pin_id Pin ID of the moving pin
-     * @param moving_blk_inf Data structure that holds information, e.g., old location and new location, about all moving blocks
      * @param affected_pins Netlist pins which are affected, in terms placement cost, by the proposed move.
      * @param timing_delta_c Timing cost change based on the proposed move
      * @param is_src_moving Is the moving pin the source of a net.
+     * @param affected_nets Nets affected by the move so far.
      */
     void update_net_info_on_pin_move_(const PlaceDelayModel* delay_model,
                                       const PlacerCriticalities* criticalities,
                                       const ClusterPinId pin_id,
-                                      const t_pl_moved_block& moving_blk_inf,
                                       std::vector<ClusterPinId>& affected_pins,
                                       double& timing_delta_c,
-                                      bool is_src_moving);
+                                      bool is_src_moving,
+                                      std::vector<ClusterNetId>& affected_nets);
 
     /**
      * @brief Calculates and returns the total bb (wirelength) cost change that would result from moving the blocks
      * indicated in the blocks_affected data structure.
      * @param bb_delta_c Cost difference after and before moving the block
+     * @param affected_nets Nets affected by the move.
      */
-    void set_bb_delta_cost_(double& bb_delta_c);
+    void set_bb_delta_cost_(double& bb_delta_c, const std::vector<ClusterNetId>& affected_nets);
 
     /**
      * @brief Allocates and loads the chanx_place_cost_fac and chany_place_cost_fac arrays with the inverse of
@@ -406,6 +478,27 @@ class NetCostHandler {
                     t_physical_tile_loc pin_new_loc,
                     bool src_pin);
 
+    /**
+     * @brief Counterpart of update_bb_() for nets with a pin histogram: updates the histogram with
+     * the pin move, and the 3D bounding box and its edge pin counts from the histogram.
+     */
+    void update_bb_from_histogram_(ClusterNetId net_id,
+                                   t_physical_tile_loc pin_old_loc,
+                                   t_physical_tile_loc pin_new_loc,
+                                   bool src_pin);
+
+    /// @brief Recounts the pins of a net with a pin histogram from pin_locs_.
+    void load_net_pin_histogram_(ClusterNetId net_id);
+
+    /// @brief Loads pin_locs_ from the block locations.
+    void load_pin_locs_();
+
+    /// @brief Returns the current coordinates of the pins of a net, driver first.
+    vtr::array_view<const t_physical_tile_loc> net_pin_locs_(ClusterNetId net_id) const {
+        return vtr::array_view<const t_physical_tile_loc>(pin_locs_.data() + net_pins_.net_pin_offset(net_id),
+                                                          net_pins_.net_pins(net_id).size());
+    }
+
     /**
      * @brief Update the per-layer bounding box of "net_id" incrementally based on the old and new locations of a pin on that net
      * @details Updates the bounding box of a net by storing its coordinates in the bb_coord_new data structure and
@@ -513,10 +606,11 @@ class NetCostHandler {
     std::pair<double, double> comp_cube_bb_cost_(e_cost_methods method);
 
     /**
-     * @brief if "net" is not already stored as an affected net, add it in ts_nets_to_update.
+     * @brief if "net" is not already stored as an affected net, add it in affected_nets.
      * @param net ID of a net affected by a move
+     * @param affected_nets Nets affected by the move so far.
      */
-    void record_affected_net_(const ClusterNetId net);
+    void record_affected_net_(const ClusterNetId net, std::vector<ClusterNetId>& affected_nets);
 
     /**
      * @brief To mitigate round-off errors, every once in a while, the costs of nets are summed up from scratch.
@@ -9,7 +9,6 @@
 #include "vtr_random.h"
 #include "vtr_math.h"
 
-#include "channel_dependency_graph.h"
 #include "noc_routing_algorithm_creator.h"
 #include "noc_routing.h"
 #include "place_constraints.h"
@@ -47,11 +46,9 @@ static bool select_random_router_cluster(ClusterBlockId& b_from,
  *
  * @return Unique links that appear only in one of the given routes
  */
-static std::vector<NocLinkId> find_affected_links_by_flow_reroute(std::vector<NocLinkId>& prev_links,
-                                                                  std::vector<NocLinkId>& curr_links);
-
 NocCostHandler::NocCostHandler(const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs)
-    : block_locs_ref(block_locs) {
+    : block_locs_ref(block_locs)
+    , channel_dependency_graph(g_vpr_ctx.noc().noc_model.get_number_of_noc_links()) {
     const auto& noc_ctx = g_vpr_ctx.noc();
 
     int number_of_traffic_flows = noc_ctx.noc_traffic_flows_storage.get_number_of_traffic_flows();
@@ -105,6 +102,8 @@ void NocCostHandler::initial_noc_routing(const vtr::vector<NocTrafficFlowId, std
 
         // update the links used in the found traffic flow route, links' bandwidth should be incremented since the traffic flow is routed
         update_traffic_flow_link_usage(curr_traffic_flow_route, 1, curr_traffic_flow.traffic_flow_bandwidth);
+
+        channel_dependency_graph.add_route(curr_traffic_flow_route);
     }
 }
 
@@ -119,6 +118,9 @@ void NocCostHandler::reinitialize_noc_routing(t_placer_costs& costs,
     // Zero out bandwidth usage for all links
     std::fill(link_bandwidth_usages.begin(), link_bandwidth_usages.end(), 0.0);
 
+    // Remove the dependencies of the old routes
+    channel_dependency_graph.clear();
+
     // Route traffic flows and update link bandwidth usage
     initial_noc_routing(new_traffic_flow_routes);
 
@@ -188,6 +190,94 @@ void NocCostHandler::find_affected_noc_routers_and_update_noc_costs(const t_pl_b
     }
 }
 
+bool NocCostHandler::can_estimate_noc_cost_change() const {
+    const auto& noc_ctx = g_vpr_ctx.noc();
+    return noc_ctx.noc_model.has_route_table() && !noc_ctx.noc_flows_router->route_depends_on_traffic_flow();
+}
+
+bool NocCostHandler::estimate_noc_cost_change(const t_pl_blocks_to_be_moved& blocks_affected,
+                                              NocCostTerms& delta_c,
+                                              std::vector<NocTrafficFlowId>& traffic_flows,
+                                              std::vector<NocLinkId>& links) const {
+    VTR_ASSERT_SAFE(can_estimate_noc_cost_change());
+
+    const auto& noc_ctx = g_vpr_ctx.noc();
+    const NocStorage& noc_model = noc_ctx.noc_model;
+    const NocTrafficFlows& noc_traffic_flows_storage = noc_ctx.noc_traffic_flows_storage;
+
+    delta_c = NocCostTerms{0.0, 0.0, 0.0, 0.0};
+    traffic_flows.clear();
+    links.clear();
+
+    // the traffic flows of the moved routers, each once
+    for (const t_pl_moved_block& block : blocks_affected.moved_blocks) {
+        if (noc_traffic_flows_storage.check_if_cluster_block_has_traffic_flows(block.block_num)) {
+            for (NocTrafficFlowId traffic_flow_id : noc_traffic_flows_storage.get_traffic_flows_associated_to_router_block(block.block_num)) {
+                if (std::find(traffic_flows.begin(), traffic_flows.end(), traffic_flow_id) == traffic_flows.end()) {
+                    traffic_flows.push_back(traffic_flow_id);
+                }
+            }
+        }
+    }
+
+    // where a router cluster would be placed after the move
+    auto proposed_loc = [&](ClusterBlockId blk_id) -> const t_pl_loc& {
+        for (const t_pl_moved_block& block : blocks_affected.moved_blocks) {
+            if (block.block_num == blk_id) {
+                return block.new_loc;
+            }
+        }
+        return block_locs_ref[blk_id].loc;
+    };
+
+    // change in bandwidth usage of the links in 'links'
+    std::vector<double> link_bandwidth_deltas;
+    auto add_link_bandwidth = [&](NocLinkId link_id, double bandwidth) {
+        auto it = std::find(links.begin(), links.end(), link_id);
+        if (it == links.end()) {
+            links.push_back(link_id);
+            link_bandwidth_deltas.push_back(bandwidth);
+        } else {
+            link_bandwidth_deltas[it - links.begin()] += bandwidth;
+        }
+    };
+
+    std::vector<NocLinkId> new_route;
+    for (NocTrafficFlowId traffic_flow_id : traffic_flows) {
+        const t_noc_traffic_flow& curr_traffic_flow = noc_traffic_flows_storage.get_single_noc_traffic_flow(traffic_flow_id);
+
+        NocRouterId source_router_id = noc_model.get_router_at_grid_location(proposed_loc(curr_traffic_flow.source_router_cluster_id));
+        NocRouterId sink_router_id = noc_model.get_router_at_grid_location(proposed_loc(curr_traffic_flow.sink_router_cluster_id));
+        if (!noc_model.get_route_from_table(source_router_id, sink_router_id, new_route)) {
+            return false;
+        }
+
+        TrafficFlowPlaceCost new_cost;
+        new_cost.aggregate_bandwidth = calculate_traffic_flow_aggregate_bandwidth_cost(new_route, curr_traffic_flow);
+        std::tie(new_cost.latency, new_cost.latency_overrun) = calculate_traffic_flow_latency_cost(new_route, noc_model, curr_traffic_flow);
+
+        delta_c.aggregate_bandwidth += new_cost.aggregate_bandwidth - traffic_flow_costs[traffic_flow_id].aggregate_bandwidth;
+        delta_c.latency += new_cost.latency - traffic_flow_costs[traffic_flow_id].latency;
+        delta_c.latency_overrun += new_cost.latency_overrun - traffic_flow_costs[traffic_flow_id].latency_overrun;
+
+        const double bandwidth = curr_traffic_flow.traffic_flow_bandwidth;
+        for (NocLinkId link_id : traffic_flow_routes[traffic_flow_id]) {
+            add_link_bandwidth(link_id, -bandwidth);
+        }
+        for (NocLinkId link_id : new_route) {
+            add_link_bandwidth(link_id, bandwidth);
+        }
+    }
+
+    for (size_t ilink = 0; ilink < links.size(); ilink++) {
+        const NocLink& link = noc_model.get_single_noc_link(links[ilink]);
+        double proposed_bandwidth_usage = link_bandwidth_usages[link] + link_bandwidth_deltas[ilink];
+        delta_c.congestion += calculate_link_congestion_cost(link, proposed_bandwidth_usage) - link_congestion_costs[link];
+    }
+
+    return true;
+}
+
 void NocCostHandler::commit_noc_costs() {
     // used to access NoC links
     const auto& noc_ctx = g_vpr_ctx.noc();
@@ -228,8 +318,27 @@ std::vector<NocLinkId>& NocCostHandler::route_traffic_flow(NocTrafficFlowId traf
     NocRouterId source_router_block_id = noc_model.get_router_at_grid_location(block_locs_ref[logical_source_router_block_id].loc);
     NocRouterId sink_router_block_id = noc_model.get_router_at_grid_location(block_locs_ref[logical_sink_router_block_id].loc);
 
-    // route the current traffic flow
     std::vector<NocLinkId>& curr_traffic_flow_route = traffic_flow_routes[traffic_flow_id];
+
+    // if the route only depends on the source and sink routers, reuse the route of this router pair
+    if (!noc_flows_router.route_depends_on_traffic_flow()) {
+        // look the route up in the all-pairs route table of the NoC, if it was built
+        if (noc_model.has_route_table() && noc_model.get_route_from_table(source_router_block_id, sink_router_block_id, curr_traffic_flow_route)) {
+            return curr_traffic_flow_route;
+        }
+
+        size_t router_pair_key = size_t(source_router_block_id) * noc_model.get_number_of_noc_routers() + size_t(sink_router_block_id);
+        auto cached_route_it = router_pair_routes.find(router_pair_key);
+        if (cached_route_it == router_pair_routes.end()) {
+            noc_flows_router.route_flow(source_router_block_id, sink_router_block_id, traffic_flow_id, curr_traffic_flow_route, noc_model);
+            router_pair_routes.emplace(router_pair_key, curr_traffic_flow_route);
+        } else {
+            curr_traffic_flow_route = cached_route_it->second;
+        }
+        return curr_traffic_flow_route;
+    }
+
+    // route the current traffic flow
     noc_flows_router.route_flow(source_router_block_id, sink_router_block_id, traffic_flow_id, curr_traffic_flow_route, noc_model);
 
     return curr_traffic_flow_route;
@@ -262,25 +371,13 @@ void NocCostHandler::re_route_associated_traffic_flows(ClusterBlockId moved_bloc
     for (NocTrafficFlowId traffic_flow_id : assoc_traffic_flows) {
         // first check to see whether we have already re-routed the current traffic flow and only re-route it if we haven't already.
         if (updated_traffic_flows.find(traffic_flow_id) == updated_traffic_flows.end()) {
-            // copy all links for this flow route before it is rerouted
-            std::vector<NocLinkId> prev_traffic_flow_links = traffic_flow_routes[traffic_flow_id];
-
             // now update the current traffic flow by re-routing it based on the new locations of its src and destination routers
+            // this also remembers which links were affected by router swap
             re_route_traffic_flow(traffic_flow_id, noc_traffic_flows_storage, noc_model, noc_flows_router);
 
             // now make sure we don't update this traffic flow a second time by adding it to the group of updated traffic flows
             updated_traffic_flows.insert(traffic_flow_id);
 
-            // get all links for this flow route after it is rerouted
-            std::vector<NocLinkId> curr_traffic_flow_links = traffic_flow_routes[traffic_flow_id];
-
-            // find links that appear in the old route or the new one, but not both of them
-            // these are the links whose bandwidth utilization is affected by rerouting
-            std::vector<NocLinkId> unique_links = find_affected_links_by_flow_reroute(prev_traffic_flow_links, curr_traffic_flow_links);
-
-            // update the static data structure to remember which links were affected by router swap
-            affected_noc_links.insert(unique_links.begin(), unique_links.end());
-
             // update global data structures to indicate that the current traffic flow was affected due to router cluster blocks being swapped
             affected_traffic_flows.push_back(traffic_flow_id);
         }
@@ -317,6 +414,10 @@ void NocCostHandler::revert_noc_traffic_flow_routes(const t_pl_blocks_to_be_move
                     // increase the bandwidth utilization of the links in the backup route
                     update_traffic_flow_link_usage(traffic_flow_routes_backup[traffic_flow_id], +1, traffic_flow.traffic_flow_bandwidth);
 
+                    // replace the dependencies of the current route with the ones of the backup route
+                    channel_dependency_graph.remove_route(traffic_flow_routes[traffic_flow_id]);
+                    channel_dependency_graph.add_route(traffic_flow_routes_backup[traffic_flow_id]);
+
                     // Revert the traffic flow route by restoring the backup
                     std::swap(traffic_flow_routes[traffic_flow_id], traffic_flow_routes_backup[traffic_flow_id]);
 
@@ -335,20 +436,51 @@ void NocCostHandler::re_route_traffic_flow(NocTrafficFlowId traffic_flow_id,
     // get the current traffic flow info
     const t_noc_traffic_flow& curr_traffic_flow = noc_traffic_flows_storage.get_single_noc_traffic_flow(traffic_flow_id);
 
-    /* since the current traffic flow route will be
-     * changed, first we need to decrement the bandwidth
-     * usage of all links that are part of
-     * the existing traffic flow route
-     */
-    const std::vector<NocLinkId>& curr_traffic_flow_route = traffic_flow_routes[traffic_flow_id];
-    update_traffic_flow_link_usage(curr_traffic_flow_route, -1, curr_traffic_flow.traffic_flow_bandwidth);
-
     // move the current route to a backup container in case it needs to be reverted
     std::swap(traffic_flow_routes[traffic_flow_id], traffic_flow_routes_backup[traffic_flow_id]);
+    const std::vector<NocLinkId>& prev_traffic_flow_route = traffic_flow_routes_backup[traffic_flow_id];
 
-    // now get the re-routed traffic flow route and increment all the link usages with this reverted route
-    std::vector<NocLinkId>& re_routed_traffic_flow_route = route_traffic_flow(traffic_flow_id, noc_model, noc_traffic_flows_storage, noc_flows_router);
-    update_traffic_flow_link_usage(re_routed_traffic_flow_route, 1, curr_traffic_flow.traffic_flow_bandwidth);
+    // now get the re-routed traffic flow route
+    const std::vector<NocLinkId>& re_routed_traffic_flow_route = route_traffic_flow(traffic_flow_id, noc_model, noc_traffic_flows_storage, noc_flows_router);
+
+    /* The bandwidth usage of the links found in both routes does not change.
+     * Sort copies of both routes (the order of the links in a route matters)
+     * to find the links that appear in only one of them. The bandwidth usage of
+     * the links only in the old route is decremented, and the bandwidth usage
+     * of the links only in the new route is incremented.
+     */
+    prev_route_links.assign(prev_traffic_flow_route.begin(), prev_traffic_flow_route.end());
+    curr_route_links.assign(re_routed_traffic_flow_route.begin(), re_routed_traffic_flow_route.end());
+    std::sort(prev_route_links.begin(), prev_route_links.end());
+    std::sort(curr_route_links.begin(), curr_route_links.end());
+
+    const double bandwidth = curr_traffic_flow.traffic_flow_bandwidth;
+    auto prev_it = prev_route_links.begin();
+    auto curr_it = curr_route_links.begin();
+    while (prev_it != prev_route_links.end() || curr_it != curr_route_links.end()) {
+        if (curr_it == curr_route_links.end() || (prev_it != prev_route_links.end() && *prev_it < *curr_it)) {
+            // only in the old route
+            link_bandwidth_usages[*prev_it] -= bandwidth;
+            VTR_ASSERT_SAFE(link_bandwidth_usages[*prev_it] >= 0.0);
+            affected_noc_links.insert(*prev_it);
+            ++prev_it;
+        } else if (prev_it == prev_route_links.end() || *curr_it < *prev_it) {
+            // only in the new route
+            link_bandwidth_usages[*curr_it] += bandwidth;
+            affected_noc_links.insert(*curr_it);
+            ++curr_it;
+        } else {
+            // in both routes
+            ++prev_it;
+            ++curr_it;
+        }
+    }
+
+    // the dependencies of a route also depend on the order of its links
+    if (prev_traffic_flow_route != re_routed_traffic_flow_route) {
+        channel_dependency_graph.remove_route(prev_traffic_flow_route);
+        channel_dependency_graph.add_route(re_routed_traffic_flow_route);
+    }
 }
 
 NocCostTerms NocCostHandler::recompute_noc_costs() const {
@@ -675,8 +807,11 @@ std::pair<double, double> calculate_traffic_flow_latency_cost(const std::vector<
 }
 
 double NocCostHandler::get_link_congestion_cost(const NocLink& link) const {
+    return calculate_link_congestion_cost(link, link_bandwidth_usages[link]);
+}
+
+double NocCostHandler::calculate_link_congestion_cost(const NocLink& link, double bandwidth_usage) {
     double bandwidth = link.get_bandwidth();
-    double bandwidth_usage = link_bandwidth_usages[link];
 
     double congested_bandwidth = std::max(bandwidth_usage - bandwidth, 0.0);
     double congested_bw_ratio = congested_bandwidth / bandwidth;
@@ -957,7 +1092,8 @@ void write_noc_placement_file(const std::string& file_name,
 }
 
 bool NocCostHandler::noc_routing_has_cycle() const {
-    bool has_cycle = ::noc_routing_has_cycle(traffic_flow_routes, block_locs_ref);
+    bool has_cycle = channel_dependency_graph.has_cycles();
+    VTR_ASSERT_DEBUG(has_cycle == ::noc_routing_has_cycle(traffic_flow_routes, block_locs_ref));
 
     return has_cycle;
 }
@@ -1019,25 +1155,3 @@ void NocCostHandler::print_noc_costs(std::string_view header,
             get_total_congestion_bandwidth_ratio(),
             get_number_of_congested_noc_links());
 }
-
-static std::vector<NocLinkId> find_affected_links_by_flow_reroute(std::vector<NocLinkId>& prev_links,
-                                                                  std::vector<NocLinkId>& curr_links) {
-    // Sort both link containers
-    std::stable_sort(prev_links.begin(), prev_links.end());
-    std::stable_sort(curr_links.begin(), curr_links.end());
-
-    // stores links that appear either in prev_links or curr_links but not both of them
-    std::vector<NocLinkId> unique_links;
-
-    // find links that are unique to prev_links
-    std::set_difference(prev_links.begin(), prev_links.end(),
-                        curr_links.begin(), curr_links.end(),
-                        std::back_inserter(unique_links));
-
-    // find links that are unique to curr_links
-    std::set_difference(curr_links.begin(), curr_links.end(),
-                        prev_links.begin(), prev_links.end(),
-                        std::back_inserter(unique_links));
-
-    return unique_links;
-}
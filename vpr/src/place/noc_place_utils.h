@@ -1,8 +1,10 @@
 #pragma once
 
 #include <string_view>
+#include <unordered_map>
 #include "move_utils.h"
 #include "place_util.h"
+#include "channel_dependency_graph.h"
 
 class PlaceMacros;
 
@@ -117,6 +119,32 @@ class NocCostHandler {
     void find_affected_noc_routers_and_update_noc_costs(const t_pl_blocks_to_be_moved& blocks_affected,
                                                         NocCostTerms& delta_c);
 
+    /**
+     * @brief Whether estimate_noc_cost_change() can be used, i.e. whether the
+     * traffic flow routes only depend on their source and sink routers and
+     * can be looked up in the route table of the NoC (see NocStorage::build_route_table()).
+     */
+    bool can_estimate_noc_cost_change() const;
+
+    /**
+     * @brief Computes how much the NoC cost terms would change if the blocks in
+     * blocks_affected were moved, like find_affected_noc_routers_and_update_noc_costs(),
+     * but without applying the move or changing the state of the cost handler.
+     * Several moves can therefore be estimated concurrently against the same placement.
+     *
+     * @param blocks_affected The proposed move. The moved blocks must still be at their
+     * old locations in the placement.
+     * @param delta_c The change in the NoC cost terms is stored here.
+     * @param traffic_flows The traffic flows that would be re-routed are stored here.
+     * @param links The links whose bandwidth usage would change are stored here.
+     * @return false if one of the re-routed traffic flows has no route in the route table,
+     * in which case delta_c and links are incomplete.
+     */
+    bool estimate_noc_cost_change(const t_pl_blocks_to_be_moved& blocks_affected,
+                                  NocCostTerms& delta_c,
+                                  std::vector<NocTrafficFlowId>& traffic_flows,
+                                  std::vector<NocLinkId>& links) const;
+
     /**
      * @brief Updates static data structures found in 'noc_place_utils.cpp'
      * which keep track of the aggregate bandwidth and latency costs of all
@@ -325,6 +353,11 @@ class NocCostHandler {
      */
     const vtr::vector<NocLinkId, double>& get_link_bandwidth_usages() const;
 
+    /**
+     * @brief Returns the current route of each traffic flow.
+     */
+    const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& get_traffic_flow_routes() const { return traffic_flow_routes; }
+
     /**
      * @brief Determines the congestion cost a NoC link. The cost
      * is calculating by measuring how much the current bandwidth
@@ -343,9 +376,9 @@ class NocCostHandler {
      * as it contain a subset of its edges. If such a graph contains a cycle, we can argue
      * that deadlock is possible.
      *
-     * This functions performs a DFS over the mentioned graph and tries to find out whether
-     * the graph has any back edges, i.e. whether a node points to one of its ancestors
-     * during depth-first search traversal.
+     * The channel dependency graph of the current routes is updated incrementally
+     * whenever a traffic flow is re-routed, so this check is cheap enough to be
+     * done during the anneal.
      *
      * @return bool Indicates whether NoC traffic flow routes form a cycle.
      */
@@ -363,6 +396,12 @@ class NocCostHandler {
                          const t_noc_opts& noc_opts) const;
 
   private:
+    /**
+     * @brief Congestion cost of a NoC link (see get_link_congestion_cost())
+     * if the given bandwidth went through it.
+     */
+    static double calculate_link_congestion_cost(const NocLink& link, double bandwidth_usage);
+
     /**
      * @brief Routes a given traffic flow within the NoC based on where the
      * logical cluster blocks in the traffic flow are currently placed. The
@@ -385,6 +424,11 @@ class NocCostHandler {
      * within the NoC. Used to get the current traffic flow information.
      * @param noc_flows_router The packet routing algorithm used to route traffic
      * flows within the NoC.
+     * If the routing algorithm finds the same route for all the traffic flows
+     * between a pair of routers, the route is looked up in the all-pairs route
+     * table of the NoC model. If the table was not built (the NoC is too
+     * large), the route of each pair is cached and reused.
+     *
      * @return std::vector<NocLinkId>& The found route for the traffic flow.
      */
     std::vector<NocLinkId>& route_traffic_flow(NocTrafficFlowId traffic_flow_id,
@@ -450,6 +494,10 @@ class NocCostHandler {
      * a new route for the traffic flow and updates the links in the new route to
      * indicate that the traffic flow uses them.
      *
+     * The bandwidth usage is only updated for the links found in either the old
+     * or the new route, but not in both. These links are added to
+     * 'affected_noc_links'.
+     *
      * @param traffic_flow_id The traffic flow to re-route.
      * @param noc_traffic_flows_storage Contains all the traffic flow information
      * within the NoC. Used to get the current traffic flow information.
@@ -557,6 +605,22 @@ class NocCostHandler {
 
     ///Represents the bandwidth of the data being transmitted on each link in the NoC. Units in bits-per-second(bps)
     vtr::vector<NocLinkId, double> link_bandwidth_usages;
+
+    /**
+     * @brief Caches the route between each pair of routers, keyed by
+     * (source router * number of routers + sink router).
+     * @details Only used when the routing algorithm finds the same route for
+     * all the traffic flows between two routers, and the NoC model has no
+     * all-pairs route table. The routes only depend on the
+     * NoC model, so the cache never needs to be invalidated.
+     */
+    std::unordered_map<size_t, std::vector<NocLinkId>> router_pair_routes;
+
+    /// Scratch containers holding the sorted links of a traffic flow route before and after it is re-routed
+    std::vector<NocLinkId> prev_route_links, curr_route_links;
+
+    /// The channel dependency graph of traffic_flow_routes, used to detect possible deadlocks
+    ChannelDependencyGraph channel_dependency_graph;
 };
 
 /**
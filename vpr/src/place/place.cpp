@@ -1,5 +1,7 @@
 
+#include <future>
 #include <memory>
+#include <vector>
 
 #include "flat_placement_types.h"
 #include "initial_placement.h"
@@ -17,14 +19,40 @@
 #include "annealer.h"
 #include "echo_files.h"
 #include "PlacementDelayModelCreator.h"
+#include "place_and_route.h"
 
+#include "partition_region.h"
+#include "placement_seed_race.h"
 #include "placer.h"
 
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
 /********************* Static subroutines local to place.c *******************/
 #ifdef VERBOSE
 void print_clb_placement(const char* fname);
 #endif
 
+/**
+ * @brief Runs placer_opts.num_seeds placers concurrently, with the seeds placer_opts.seed, placer_opts.seed + 1, ...,
+ * and copies the best placement to the global placement context.
+ *
+ * The placers share the (read-only) device, netlist and placement delay model. They are quiet, and the losing
+ * ones are stopped early by a PlacementSeedRace. Only the kept placement is reported.
+ */
+static void place_multiple_seeds(const Netlist<>& net_list,
+                                 const t_placer_opts& placer_opts,
+                                 const t_analysis_opts& analysis_opts,
+                                 const t_noc_opts& noc_opts,
+                                 const IntraLbPbPinLookup& pb_gpin_lookup,
+                                 const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                                 const FlatPlacementInfo& flat_placement_info,
+                                 const std::shared_ptr<PlaceDelayModel>& place_delay_model,
+                                 const std::shared_future<std::shared_ptr<PlaceDelayModel>>& pending_place_delay_model,
+                                 bool cube_bb,
+                                 bool is_flat);
+
 /*****************************************************************************/
 void try_place(const Netlist<>& net_list,
                const t_placer_opts& placer_opts,
@@ -78,20 +106,38 @@ void try_place(const Netlist<>& net_list,
      * multiple placers if we are performing parallel annealing.
      * So, it is created and initialized once. */
     std::shared_ptr<PlaceDelayModel> place_delay_model;
+    std::shared_future<std::shared_ptr<PlaceDelayModel>> pending_place_delay_model;
 
     if (placer_opts.place_algorithm.is_timing_driven()) {
-        /*do this before the initial placement to avoid messing up the initial placement */
-        place_delay_model = PlacementDelayModelCreator::create_delay_model(placer_opts,
-                                                                           router_opts,
-                                                                           net_list,
-                                                                           det_routing_arch,
-                                                                           segment_inf,
-                                                                           chan_width_dist,
-                                                                           directs,
-                                                                           is_flat);
-
-        if (isEchoFileEnabled(E_ECHO_PLACEMENT_DELTA_DELAY_MODEL)) {
-            place_delay_model->dump_echo(getEchoFileName(E_ECHO_PLACEMENT_DELTA_DELAY_MODEL));
+        auto create_place_delay_model = [&]() {
+            std::shared_ptr<PlaceDelayModel> delay_model = PlacementDelayModelCreator::create_delay_model(placer_opts,
+                                                                                                          router_opts,
+                                                                                                          net_list,
+                                                                                                          det_routing_arch,
+                                                                                                          segment_inf,
+                                                                                                          chan_width_dist,
+                                                                                                          directs,
+                                                                                                          is_flat);
+
+            if (isEchoFileEnabled(E_ECHO_PLACEMENT_DELTA_DELAY_MODEL)) {
+                delay_model->dump_echo(getEchoFileName(E_ECHO_PLACEMENT_DELTA_DELAY_MODEL));
+            }
+            return delay_model;
+        };
+
+        /* The delay model (and the router lookahead it profiles the routing with) only uses the device and
+         * routing contexts, so it is computed while the placers run their initial placement. This requires
+         * the RR graph to already be built for the placement channel width: otherwise the delay model
+         * (re)builds it, which must be done before the initial placement. */
+        bool rr_graph_built = !device_ctx.rr_graph.empty() && device_ctx.chan_width == setup_chan_width(router_opts, chan_width_dist);
+        if (placer_opts.place_delay_model_background && rr_graph_built) {
+            auto create_in_flow_ctx = [&flow_ctx = get_current_vpr_context(), create_place_delay_model]() {
+                ScopedVprContext ctx_scope(flow_ctx);
+                return create_place_delay_model();
+            };
+            pending_place_delay_model = std::async(std::launch::async, create_in_flow_ctx).share();
+        } else {
+            place_delay_model = create_place_delay_model();
         }
     }
 
@@ -111,17 +157,22 @@ void try_place(const Netlist<>& net_list,
     // Enables fast look-up of atom pins connect to CLB pins
     ClusteredPinAtomPinsLookup netlist_pin_lookup(cluster_ctx.clb_nlist, atom_ctx.netlist(), pb_gpin_lookup);
 
-    Placer placer(net_list, {}, placer_opts, analysis_opts, noc_opts, pb_gpin_lookup, netlist_pin_lookup,
-                  flat_placement_info, place_delay_model, placer_opts.place_auto_init_t_scale,
-                  mutable_placement.cube_bb, is_flat, /*quiet=*/false);
+    if (placer_opts.num_seeds > 1) {
+        place_multiple_seeds(net_list, placer_opts, analysis_opts, noc_opts, pb_gpin_lookup, netlist_pin_lookup,
+                             flat_placement_info, place_delay_model, pending_place_delay_model, mutable_placement.cube_bb, is_flat);
+    } else {
+        Placer placer(net_list, {}, placer_opts, analysis_opts, noc_opts, pb_gpin_lookup, netlist_pin_lookup,
+                      flat_placement_info, place_delay_model, placer_opts.place_auto_init_t_scale,
+                      mutable_placement.cube_bb, is_flat, /*quiet=*/false, pending_place_delay_model);
 
-    placer.place();
+        placer.place();
 
-    /* The placer object has its own copy of block locations and doesn't update
-     * the global context directly. We need to copy its internal data structures
-     * to the global placement context before it goes out of scope.
-     */
-    placer.update_global_state();
+        /* The placer object has its own copy of block locations and doesn't update
+         * the global context directly. We need to copy its internal data structures
+         * to the global placement context before it goes out of scope.
+         */
+        placer.update_global_state();
+    }
 
     // Clean the variables in the placement context. This will deallocate memory
     // used by variables which were allocated in the placement context and are
@@ -130,6 +181,73 @@ void try_place(const Netlist<>& net_list,
     mutable_floorplanning.clean_floorplanning_context_post_place();
 }
 
+static void place_multiple_seeds(const Netlist<>& net_list,
+                                 const t_placer_opts& placer_opts,
+                                 const t_analysis_opts& analysis_opts,
+                                 const t_noc_opts& noc_opts,
+                                 const IntraLbPbPinLookup& pb_gpin_lookup,
+                                 const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                                 const FlatPlacementInfo& flat_placement_info,
+                                 const std::shared_ptr<PlaceDelayModel>& place_delay_model,
+                                 const std::shared_future<std::shared_ptr<PlaceDelayModel>>& pending_place_delay_model,
+                                 bool cube_bb,
+                                 bool is_flat) {
+    const int num_seeds = placer_opts.num_seeds;
+    VTR_LOG("Placing with %d seeds concurrently (seeds %d to %d)\n", num_seeds, placer_opts.seed, placer_opts.seed + num_seeds - 1);
+
+    // The placers keep a reference to their options, which only differ by the seed. Files which
+    // the placers would all write to are not written.
+    std::vector<t_placer_opts> seed_placer_opts(num_seeds, placer_opts);
+    for (int iseed = 0; iseed < num_seeds; iseed++) {
+        t_placer_opts& opts = seed_placer_opts[iseed];
+        opts.seed = placer_opts.seed + iseed;
+        opts.write_initial_place_file.clear();
+        opts.move_stats_file.clear();
+        opts.move_profile_file.clear();
+        opts.placement_saves_per_temperature = 0;
+    }
+
+    // Lazily initialized on the first call, so it is initialized before the placers share it
+    get_device_partition_region();
+
+    PlacementSeedRace seed_race(placer_opts.seed_stop_ratio);
+    std::vector<std::unique_ptr<Placer>> placers(num_seeds);
+
+    auto place_seed = [&](int iseed) {
+        placers[iseed] = std::make_unique<Placer>(net_list, std::nullopt, seed_placer_opts[iseed], analysis_opts, noc_opts,
+                                                  pb_gpin_lookup, netlist_pin_lookup, flat_placement_info, place_delay_model,
+                                                  placer_opts.place_auto_init_t_scale, cube_bb, is_flat, /*quiet=*/true,
+                                                  pending_place_delay_model);
+        placers[iseed]->set_seed_race(&seed_race);
+        placers[iseed]->place();
+    };
+
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(0, num_seeds, place_seed);
+#else
+    for (int iseed = 0; iseed < num_seeds; iseed++) {
+        place_seed(iseed);
+    }
+#endif
+
+    // The best seed that completed its anneal (the first one on ties)
+    int best_seed = -1;
+    for (int iseed = 0; iseed < num_seeds; iseed++) {
+        const Placer& placer = *placers[iseed];
+        VTR_LOG("Placement seed %d: %s, quality %g\n", seed_placer_opts[iseed].seed,
+                placer.stopped_early() ? "stopped early" : "completed", placer.seed_race_quality());
+
+        if (!placer.stopped_early() && (best_seed < 0 || placer.seed_race_quality() < placers[best_seed]->seed_race_quality())) {
+            best_seed = iseed;
+        }
+    }
+    VTR_ASSERT(best_seed >= 0);
+    VTR_LOG("Keeping the placement of seed %d\n", seed_placer_opts[best_seed].seed);
+
+    placers[best_seed]->print_post_placement_stats();
+    placers[best_seed]->update_global_state();
+}
+
 #ifdef VERBOSE
 void print_clb_placement(const char* fname) {
     /* Prints out the clb placements to a file.  */
@@ -2,6 +2,7 @@
 #include "place_checkpoint.h"
 
 #include "noc_place_utils.h"
+#include "NetPinTimingInvalidator.h"
 #include "placer_state.h"
 #include "grid_block.h"
 #include "PlacerCriticalities.h"
@@ -64,6 +65,15 @@ void restore_best_placement(PlacerState& placer_state,
         placer_criticalities.get()->set_recompute_required();
         placer_setup_slacks.get()->set_recompute_required();
         comp_td_connection_delays(place_delay_model.get(), placer_state);
+
+        //any connection may have moved, so an incremental timing update must re-analyze all of them
+        const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+        for (ClusterNetId net_id : clb_nlist.nets()) {
+            for (ClusterPinId pin_id : clb_nlist.net_sinks(net_id)) {
+                pin_timing_invalidator->invalidate_connection(pin_id);
+            }
+        }
+
         perform_full_timing_update(crit_params,
                                    place_delay_model.get(),
                                    placer_criticalities.get(),
@@ -8,11 +8,14 @@
  *  the placement stage of VPR.
  */
 
+#include <unordered_map>
+
 #include "globals.h"
 #include "place_constraints.h"
 #include "physical_types_util.h"
 #include "place_util.h"
 #include "vpr_context.h"
+#include "vtr_memory.h"
 
 bool is_cluster_constrained(ClusterBlockId blk_id) {
     auto& floorplanning_ctx = g_vpr_ctx.floorplanning();
@@ -185,8 +188,15 @@ bool cluster_floorplanning_legal(ClusterBlockId blk_id, const t_pl_loc& loc) {
         //not constrained so will not have floorplanning issues
         floorplanning_good = true;
     } else {
-        PartitionRegion pr = floorplanning_ctx.cluster_constraints[blk_id];
-        bool in_pr = pr.is_loc_in_part_reg(loc);
+        const PartitionRegion& pr = floorplanning_ctx.cluster_constraints[blk_id];
+        //use the precomputed grid mask of the constraint if there is one
+        bool in_pr;
+        if (floorplanning_ctx.cluster_constraint_masks.empty()) {
+            in_pr = pr.is_loc_in_part_reg(loc);
+        } else {
+            int mask_id = floorplanning_ctx.cluster_constraint_mask_ids[blk_id];
+            in_pr = floorplanning_ctx.cluster_constraint_masks[mask_id].is_loc_in_part_reg(loc, pr);
+        }
 
         //if location is in partitionregion, floorplanning is respected
         //if not it is not
@@ -316,6 +326,37 @@ void alloc_and_load_compressed_cluster_constraints() {
     }
 }
 
+void alloc_and_load_cluster_constraint_masks() {
+    // Above this number of grid locations over all the masks, the regions are scanned instead
+    constexpr size_t MAX_CLUSTER_CONSTRAINT_MASK_LOCS = size_t(1) << 28;
+
+    auto& floorplanning_ctx = g_vpr_ctx.mutable_floorplanning();
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& grid = g_vpr_ctx.device().grid;
+
+    floorplanning_ctx.cluster_constraint_masks.clear();
+    floorplanning_ctx.cluster_constraint_mask_ids.assign(cluster_ctx.clb_nlist.blocks().size(), -1);
+
+    // The distinct constraints of the clusters, numbered in the order they are found
+    std::unordered_map<PartitionRegion, int> constraint_ids;
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        if (is_cluster_constrained(blk_id)) {
+            auto [it, _] = constraint_ids.emplace(floorplanning_ctx.cluster_constraints[blk_id], (int)constraint_ids.size());
+            floorplanning_ctx.cluster_constraint_mask_ids[blk_id] = it->second;
+        }
+    }
+
+    if (constraint_ids.empty() || constraint_ids.size() * grid.grid_size() > MAX_CLUSTER_CONSTRAINT_MASK_LOCS) {
+        vtr::release_memory(floorplanning_ctx.cluster_constraint_mask_ids);
+        return;
+    }
+
+    floorplanning_ctx.cluster_constraint_masks.resize(constraint_ids.size());
+    for (const auto& [pr, mask_id] : constraint_ids) {
+        floorplanning_ctx.cluster_constraint_masks[mask_id] = PartitionRegionGridMask(pr, grid);
+    }
+}
+
 /*
  * Returns 0, 1, or 2 depending on the number of tiles covered.
  * Will not return a value above 2 because as soon as num_tiles is above 1,
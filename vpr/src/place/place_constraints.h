@@ -137,6 +137,15 @@ void mark_fixed_blocks(BlkLocRegistry& blk_loc_registry);
  */
 void alloc_and_load_compressed_cluster_constraints();
 
+/**
+ * @brief Builds the grid masks of the distinct cluster floorplanning constraints
+ * and store them in FloorplanningContext, so that cluster_floorplanning_legal()
+ * does not scan the regions of the constraints.
+ *
+ * Must be called again whenever the cluster constraints change.
+ */
+void alloc_and_load_cluster_constraint_masks();
+
 /**
  * @brief Returns the number of tiles covered by a floorplan region.
  *
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <sstream>
 #include <map>
+#include <unordered_map>
 #include <string_view>
 
 #include "atom_lookup.h"
@@ -36,6 +37,21 @@ static bool is_constant_clb_net(ClusterNetId clb_net,
 static void validate_macros(const std::vector<t_pl_macro>& macros,
                             const ClusteredNetlist& clb_nlist);
 
+/// @brief A to_pin (RECEIVER) of a direct connection on a logical block, and the from_pins (DRIVER) of the same direct.
+struct t_direct_receiver_pins {
+    int to_iblk_pin;
+    int idirect;
+    std::vector<int> from_iblk_pins;
+};
+
+/**
+ * @brief Lists the logical pins of \p logical_block which could start a macro: its to_pins with a direct connection
+ * and, for each of them, the from_pins of the same direct, both in increasing pin order.
+ */
+static std::vector<t_direct_receiver_pins> find_direct_receiver_pins(t_logical_block_type_ptr logical_block,
+                                                                     const std::vector<std::vector<int>>& idirect_from_blk_pin,
+                                                                     const std::vector<std::vector<e_pin_type>>& direct_type_from_blk_pin);
+
 /**
  * @brief   Tries to combine two placement macros.
  * @details This function takes two placement macro ids which have a common cluster block
@@ -190,17 +206,27 @@ int PlaceMacros::find_all_the_macro_(const ClusteredNetlist& clb_nlist,
     // counts the total number of macros
     int num_macro = 0;
 
+    // The pins of each logical block type which could start a macro, found the first time a block of the type is seen,
+    // so that only these pins are visited for each block rather than every pair of pins.
+    std::vector<std::vector<t_direct_receiver_pins>> direct_receiver_pins_of_type;
+    std::vector<bool> direct_receiver_pins_found;
+
     for (ClusterBlockId blk_id : clb_nlist.blocks()) {
         t_logical_block_type_ptr logical_block = clb_nlist.block_type(blk_id);
-        t_physical_tile_type_ptr physical_tile = pick_physical_type(logical_block);
 
-        int num_blk_pins = clb_nlist.block_type(blk_id)->pb_type->num_pins;
-        for (int to_iblk_pin = 0; to_iblk_pin < num_blk_pins; to_iblk_pin++) {
-            int to_physical_pin = get_physical_pin(physical_tile, logical_block, to_iblk_pin);
+        size_t itype = logical_block->index;
+        if (itype >= direct_receiver_pins_found.size()) {
+            direct_receiver_pins_of_type.resize(itype + 1);
+            direct_receiver_pins_found.resize(itype + 1, false);
+        }
+        if (!direct_receiver_pins_found[itype]) {
+            direct_receiver_pins_of_type[itype] = find_direct_receiver_pins(logical_block, idirect_from_blk_pin_, direct_type_from_blk_pin_);
+            direct_receiver_pins_found[itype] = true;
+        }
 
-            ClusterNetId to_net_id = clb_nlist.block_net(blk_id, to_iblk_pin);
-            int to_idirect = idirect_from_blk_pin_[physical_tile->index][to_physical_pin];
-            e_pin_type to_src_or_sink = direct_type_from_blk_pin_[physical_tile->index][to_physical_pin];
+        for (const t_direct_receiver_pins& receiver_pins : direct_receiver_pins_of_type[itype]) {
+            ClusterNetId to_net_id = clb_nlist.block_net(blk_id, receiver_pins.to_iblk_pin);
+            int to_idirect = receiver_pins.idirect;
 
             // Identify potential macro head blocks (i.e. start of a macro)
             //
@@ -211,20 +237,16 @@ int PlaceMacros::find_all_the_macro_(const ClusteredNetlist& clb_nlist,
             // Note that the restriction that constant nets are not driven from another direct ensures that
             // blocks in the middle of a chain with internal constant signals are not detected as potential
             // head blocks.
-            if (to_src_or_sink == e_pin_type::RECEIVER && to_idirect != UNDEFINED
-                && (to_net_id == ClusterNetId::INVALID() || (is_constant_clb_net(to_net_id, atom_lookup, atom_nlist) && !net_is_driven_by_direct_(to_net_id, clb_nlist)))) {
-                for (int from_iblk_pin = 0; from_iblk_pin < num_blk_pins; from_iblk_pin++) {
-                    int from_physical_pin = get_physical_pin(physical_tile, logical_block, from_iblk_pin);
-
+            if (to_net_id == ClusterNetId::INVALID() || (is_constant_clb_net(to_net_id, atom_lookup, atom_nlist) && !net_is_driven_by_direct_(to_net_id, clb_nlist))) {
+                // The from_pins all belong to the same direct connection as the to_pin
+                for (int from_iblk_pin : receiver_pins.from_iblk_pins) {
                     ClusterNetId from_net_id = clb_nlist.block_net(blk_id, from_iblk_pin);
-                    int from_idirect = idirect_from_blk_pin_[physical_tile->index][from_physical_pin];
-                    e_pin_type from_src_or_sink = direct_type_from_blk_pin_[physical_tile->index][from_physical_pin];
 
                     // Confirm whether this is a head macro
                     //
                     // The output SOURCE (from_pin) of a true head macro will:
                     //  * drive another block with the same direct connection
-                    if (from_src_or_sink == e_pin_type::DRIVER && to_idirect == from_idirect && from_net_id != ClusterNetId::INVALID()) {
+                    if (from_net_id != ClusterNetId::INVALID()) {
                         // Mark down that this is the first block in the macro
                         pl_macro_member_blk_num_of_this_blk[0] = blk_id;
                         pl_macro_idirect[num_macro] = to_idirect;
@@ -248,8 +270,6 @@ int PlaceMacros::find_all_the_macro_(const ClusteredNetlist& clb_nlist,
                             next_blk_id = clb_nlist.net_pin_block(curr_net_id, 1);
 
                             // Assume that the from_iblk_pin index is the same for the next block
-                            VTR_ASSERT(idirect_from_blk_pin_[physical_tile->index][from_physical_pin] == from_idirect
-                                       && direct_type_from_blk_pin_[physical_tile->index][from_physical_pin] == e_pin_type::DRIVER);
                             next_net_id = clb_nlist.block_net(next_blk_id, from_iblk_pin);
 
                             // Mark down this block as a member of the macro
@@ -403,6 +423,43 @@ static bool try_combine_macros(std::vector<std::vector<ClusterBlockId>>& pl_macr
     return true;
 }
 
+static std::vector<t_direct_receiver_pins> find_direct_receiver_pins(t_logical_block_type_ptr logical_block,
+                                                                     const std::vector<std::vector<int>>& idirect_from_blk_pin,
+                                                                     const std::vector<std::vector<e_pin_type>>& direct_type_from_blk_pin) {
+    t_physical_tile_type_ptr physical_tile = pick_physical_type(logical_block);
+    const std::vector<int>& idirect_from_pin = idirect_from_blk_pin[physical_tile->index];
+    const std::vector<e_pin_type>& direct_type_from_pin = direct_type_from_blk_pin[physical_tile->index];
+
+    // The from_pins of each direct connection
+    std::unordered_map<int, std::vector<int>> from_iblk_pins_of_direct;
+    std::vector<std::pair<int, int>> to_iblk_pins; // (to_iblk_pin, idirect)
+
+    int num_blk_pins = logical_block->pb_type->num_pins;
+    for (int iblk_pin = 0; iblk_pin < num_blk_pins; iblk_pin++) {
+        int physical_pin = get_physical_pin(physical_tile, logical_block, iblk_pin);
+        int idirect = idirect_from_pin[physical_pin];
+        if (idirect == UNDEFINED) {
+            continue;
+        }
+
+        if (direct_type_from_pin[physical_pin] == e_pin_type::DRIVER) {
+            from_iblk_pins_of_direct[idirect].push_back(iblk_pin);
+        } else if (direct_type_from_pin[physical_pin] == e_pin_type::RECEIVER) {
+            to_iblk_pins.emplace_back(iblk_pin, idirect);
+        }
+    }
+
+    std::vector<t_direct_receiver_pins> receiver_pins;
+    for (auto [to_iblk_pin, idirect] : to_iblk_pins) {
+        auto it = from_iblk_pins_of_direct.find(idirect);
+        if (it != from_iblk_pins_of_direct.end()) {
+            receiver_pins.push_back({to_iblk_pin, idirect, it->second});
+        }
+    }
+
+    return receiver_pins;
+}
+
 int PlaceMacros::get_imacro_from_iblk(ClusterBlockId iblk) const {
     int imacro;
     if (iblk != ClusterBlockId::INVALID()) {
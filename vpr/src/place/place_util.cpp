@@ -50,12 +50,10 @@ t_placer_costs& t_placer_costs::operator+=(const NocCostTerms& noc_delta_cost) {
     return *this;
 }
 
-int get_place_inner_loop_num_move(const t_placer_opts& placer_opts, const t_annealing_sched& annealing_sched) {
+int get_place_inner_loop_num_move(const t_placer_opts& placer_opts, const t_annealing_sched& annealing_sched, size_t num_blocks) {
     const auto& device_ctx = g_vpr_ctx.device();
-    const auto& cluster_ctx = g_vpr_ctx.clustering();
 
     float device_size = device_ctx.grid.width() * device_ctx.grid.height();
-    size_t num_blocks = cluster_ctx.clb_nlist.blocks().size();
 
     int move_lim;
     if (placer_opts.effort_scaling == e_place_effort_scaling::CIRCUIT) {
@@ -91,6 +89,14 @@ void t_placer_statistics::single_swap_update(const t_placer_costs& costs) {
     sum_of_squares += (costs.cost) * (costs.cost);
 }
 
+void t_placer_statistics::merge(const t_placer_statistics& other) {
+    success_sum += other.success_sum;
+    av_cost += other.av_cost;
+    av_bb_cost += other.av_bb_cost;
+    av_timing_cost += other.av_timing_cost;
+    sum_of_squares += other.sum_of_squares;
+}
+
 ///@brief Update stats when a single swap move has been accepted.
 void t_placer_statistics::calc_iteration_stats(const t_placer_costs& costs, int move_lim) {
     if (success_sum == 0) {
@@ -188,6 +188,9 @@ class t_placer_statistics {
 
     ///@brief Calculate placer success rate and cost std_dev for this iteration.
     void single_swap_update(const t_placer_costs& costs);
+
+    ///@brief Adds the accepted swaps recorded by another instance.
+    void merge(const t_placer_statistics& other);
 };
 
 /**
@@ -204,8 +207,11 @@ class t_placer_statistics {
  * is highly utilized (device_size ~ num_blocks). For low utilization devices
  * (device_size >> num_blocks), the search space is larger, so the second method
  * performs more moves to ensure better optimization.
+ *
+ * num_blocks is the number of blocks annealed: all the clustered blocks, unless
+ * only part of the placement is annealed (e.g. an incremental placement).
  */
-int get_place_inner_loop_num_move(const t_placer_opts& placer_opts, const t_annealing_sched& annealing_sched);
+int get_place_inner_loop_num_move(const t_placer_opts& placer_opts, const t_annealing_sched& annealing_sched, size_t num_blocks);
 
 /**
  * @brief Returns the standard deviation of data set x.
@@ -15,6 +15,7 @@
 #include "draw.h"
 #include "read_place.h"
 #include "tatum/echo_writer.hpp"
+#include "noc_simulator.h"
 
 PlacementLogPrinter::PlacementLogPrinter(const Placer& placer, bool quiet)
     : placer_(placer)
@@ -249,7 +250,7 @@ void PlacementLogPrinter::print_post_placement_stats() const {
         if (isEchoFileEnabled(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH)) {
             tatum::write_echo(getEchoFileName(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH),
                               *timing_ctx.graph, *timing_ctx.constraints,
-                              *placer_.placement_delay_calc_, placer_.timing_info_->analyzer());
+                              *placer_.placement_delay_calc_, placer_.timing_info_->analyzer(), getTimingGraphEchoAnonymized());
 
             tatum::NodeId debug_tnode = id_or_pin_name_to_tnode(placer_.analysis_opts_.echo_dot_timing_graph_node);
             write_setup_timing_graph_dot(getEchoFileName(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH) + std::string(".dot"),
@@ -284,6 +285,18 @@ void PlacementLogPrinter::print_post_placement_stats() const {
             invoke_sat_router(costs, noc_opts, placer_opts.seed);
         }
 #endif //ENABLE_NOC_SAT_ROUTING
+
+        if (placer_.noc_opts_.noc_simulation) {
+            const auto& noc_ctx = g_vpr_ctx.noc();
+            NocSimulator noc_simulator(noc_ctx.noc_model,
+                                       noc_ctx.noc_traffic_flows_storage,
+                                       placer_.noc_cost_handler_->get_traffic_flow_routes(),
+                                       placer_.noc_opts_.noc_simulation_packet_size);
+
+            const size_t num_cycles = placer_.noc_opts_.noc_simulation_cycles;
+            t_noc_sim_results sim_results = noc_simulator.run(num_cycles, num_cycles / 10, placer_.placer_opts_.seed);
+            print_noc_simulation_results(sim_results, noc_ctx.noc_model);
+        }
     }
 
     // Print out swap statistics and resource utilization
@@ -306,6 +319,12 @@ void PlacementLogPrinter::print_post_placement_stats() const {
             p_runtime_ctx.f_update_td_costs_nets_elapsed_sec,
             p_runtime_ctx.f_update_td_costs_sum_nets_elapsed_sec,
             p_runtime_ctx.f_update_td_costs_total_elapsed_sec);
+    if (p_runtime_ctx.num_timing_updates > 0) {
+        VTR_LOG("Placement timing updates: %d, %g sec total, %g sec per update\n",
+                p_runtime_ctx.num_timing_updates,
+                p_runtime_ctx.f_timing_update_elapsed_sec,
+                p_runtime_ctx.f_timing_update_elapsed_sec / p_runtime_ctx.num_timing_updates);
+    }
 }
 
 void generate_post_place_timing_reports(const t_placer_opts& placer_opts,
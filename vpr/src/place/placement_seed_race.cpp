@@ -0,0 +1,19 @@
+#include "placement_seed_race.h"
+
+#include <algorithm>
+#include <limits>
+
+PlacementSeedRace::PlacementSeedRace(float stop_ratio)
+    : stop_ratio_(stop_ratio) {}
+
+bool PlacementSeedRace::keep_annealing(int temperature, double quality) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (temperature >= (int)best_quality_.size()) {
+        best_quality_.resize(temperature + 1, std::numeric_limits<double>::infinity());
+    }
+    double& best_quality = best_quality_[temperature];
+    best_quality = std::min(best_quality, quality);
+
+    return stop_ratio_ <= 0. || quality <= best_quality * stop_ratio_;
+}
@@ -0,0 +1,43 @@
+#pragma once
+/**
+ * @file placement_seed_race.h
+ * @brief Declares the PlacementSeedRace class, which stops the losing annealers of a multi-seed placement early.
+ *
+ * With --place_num_seeds, several Placer objects with different seeds anneal the same circuit
+ * concurrently, and the best placement is kept. After each temperature, each placer reports the
+ * quality of its placement to the shared PlacementSeedRace, which compares it to the best quality
+ * reported at the same temperature by the other placers. A placer that falls too far behind stops
+ * annealing, freeing its thread for the other seeds.
+ */
+
+#include <mutex>
+#include <vector>
+
+class PlacementSeedRace {
+  public:
+    /**
+     * @param stop_ratio A placer stops when its quality at a temperature is more than this factor
+     * worse than the best quality at that temperature. 0 never stops a placer.
+     */
+    explicit PlacementSeedRace(float stop_ratio);
+
+    /**
+     * @brief Records the quality of a placer after a temperature.
+     * @param temperature The number of temperatures the placer has completed.
+     * @param quality The quality of its placement (lower is better).
+     * @return Whether the placer keeps annealing.
+     *
+     * @details The placer with the best quality at a temperature always keeps annealing, so at least one
+     * placer goes through the whole anneal. Which other ones are stopped depends on the order they reach
+     * each temperature in.
+     */
+    bool keep_annealing(int temperature, double quality);
+
+  private:
+    /// The factor a quality can be worse than the best one at the same temperature by
+    const float stop_ratio_;
+    /// Protects best_quality_
+    std::mutex mutex_;
+    /// The best quality reported at each temperature so far
+    std::vector<double> best_quality_;
+};
@@ -2,6 +2,7 @@
 #include "placer.h"
 
 #include <functional>
+#include <mutex>
 #include <optional>
 #include <utility>
 
@@ -20,12 +21,43 @@
 #include "annealer.h"
 #include "RL_agent_util.h"
 #include "place_checkpoint.h"
+#include "placement_seed_race.h"
+#include "annealing_convergence_monitor.h"
 #include "tatum/echo_writer.hpp"
 
 #ifndef NO_GRAPHICS
 #include "draw_global.h"
 #endif // NO_GRAPHICS
 
+/// @brief Returns a copy of the timing analysis stats, which other placers may be updating.
+static t_timing_analysis_profile_info get_timing_stats() {
+    const auto& timing_ctx = g_vpr_ctx.timing();
+    std::lock_guard<std::mutex> stats_lock(timing_ctx.stats_mutex);
+    return timing_ctx.stats;
+}
+
+/**
+ * @brief Returns how the placer's timing analyses should be updated.
+ *
+ * For --timing_update_type auto, incremental updates are used when the annealer updates timing
+ * within a temperature (inner loop recomputes, or a slack timing driven quench, which updates timing
+ * after each move). Only the few connections changed since the last update are then re-analyzed,
+ * so these frequent updates cost much less than a full analysis.
+ */
+static e_timing_update_type get_placer_timing_update_type(const t_placer_opts& placer_opts) {
+    if (placer_opts.timing_update_type != e_timing_update_type::AUTO) {
+        return placer_opts.timing_update_type;
+    }
+
+    if (placer_opts.inner_loop_recompute_divider != 0
+        || placer_opts.quench_recompute_divider != 0
+        || placer_opts.place_quench_algorithm == e_place_algorithm::SLACK_TIMING_PLACE) {
+        return e_timing_update_type::INCREMENTAL;
+    }
+
+    return e_timing_update_type::FULL;
+}
+
 Placer::Placer(const Netlist<>& net_list,
                std::optional<std::reference_wrapper<const BlkLocRegistry>> init_place,
                const t_placer_opts& placer_opts,
@@ -38,7 +70,8 @@ Placer::Placer(const Netlist<>& net_list,
                float anneal_auto_init_t_scale,
                bool cube_bb,
                bool is_flat,
-               bool quiet)
+               bool quiet,
+               std::shared_future<std::shared_ptr<PlaceDelayModel>> pending_place_delay_model)
     : placer_opts_(placer_opts)
     , analysis_opts_(analysis_opts)
     , noc_opts_(noc_opts)
@@ -54,7 +87,7 @@ Placer::Placer(const Netlist<>& net_list,
     , is_flat_(is_flat) {
     const auto& cluster_ctx = g_vpr_ctx.clustering();
 
-    pre_place_timing_stats_ = g_vpr_ctx.timing().stats;
+    pre_place_timing_stats_ = get_timing_stats();
 
     const PlaceMacros& place_macros = *g_vpr_ctx.placement().place_macros;
 
@@ -86,6 +119,11 @@ Placer::Placer(const Netlist<>& net_list,
         }
     }
 
+    // The initial placement does not depend on the delay model, which may have been computed meanwhile
+    if (pending_place_delay_model.valid()) {
+        place_delay_model_ = pending_place_delay_model.get();
+    }
+
     const int move_lim = (int)(placer_opts.anneal_sched.inner_num * pow(net_list.blocks().size(), 1.3333));
     //create the move generator based on the chosen placement strategy
     auto [move_generator, move_generator2] = create_move_generators(placer_state_,
@@ -174,7 +212,11 @@ void Placer::alloc_and_init_timing_objects_(const Netlist<>& net_list,
     placement_delay_calc_->set_tsu_margin_relative(placer_opts_.tsu_rel_margin);
     placement_delay_calc_->set_tsu_margin_absolute(placer_opts_.tsu_abs_margin);
 
-    timing_info_ = make_setup_timing_info(placement_delay_calc_, placer_opts_.timing_update_type);
+    const e_timing_update_type timing_update_type = get_placer_timing_update_type(placer_opts_);
+    VTR_LOG("Placement timing update type: %s\n",
+            timing_update_type == e_timing_update_type::INCREMENTAL ? "incremental" : "full");
+
+    timing_info_ = make_setup_timing_info(placement_delay_calc_, timing_update_type);
 
     placer_setup_slacks_ = std::make_unique<PlacerSetupSlacks>(cluster_ctx.clb_nlist,
                                                                netlist_pin_lookup_,
@@ -184,7 +226,7 @@ void Placer::alloc_and_init_timing_objects_(const Netlist<>& net_list,
                                                                   netlist_pin_lookup_,
                                                                   timing_info_);
 
-    pin_timing_invalidator_ = make_net_pin_timing_invalidator(placer_opts_.timing_update_type,
+    pin_timing_invalidator_ = make_net_pin_timing_invalidator(timing_update_type,
                                                               net_list,
                                                               netlist_pin_lookup_,
                                                               atom_ctx.netlist(),
@@ -207,7 +249,7 @@ void Placer::alloc_and_init_timing_objects_(const Netlist<>& net_list,
     if (isEchoFileEnabled(E_ECHO_INITIAL_PLACEMENT_TIMING_GRAPH)) {
         tatum::write_echo(getEchoFileName(E_ECHO_INITIAL_PLACEMENT_TIMING_GRAPH),
                           *timing_ctx.graph, *timing_ctx.constraints,
-                          *placement_delay_calc_, timing_info_->analyzer());
+                          *placement_delay_calc_, timing_info_->analyzer(), getTimingGraphEchoAnonymized());
 
         tatum::NodeId debug_tnode = id_or_pin_name_to_tnode(analysis_opts.echo_dot_timing_graph_node);
 
@@ -278,7 +320,6 @@ int Placer::check_placement_costs_() {
 }
 
 void Placer::place() {
-    const auto& timing_ctx = g_vpr_ctx.timing();
     const auto& cluster_ctx = g_vpr_ctx.clustering();
     bool analytic_place_enabled = false;
 
@@ -286,11 +327,19 @@ void Placer::place() {
         // Table header
         log_printer_.print_place_status_header();
 
+        // Ends the anneal early once the temperatures stop improving the placement (if enabled)
+        std::optional<AnnealingConvergenceMonitor> convergence_monitor;
+        if (placer_opts_.anneal_convergence_threshold > 0.) {
+            convergence_monitor.emplace(placer_opts_.anneal_convergence_threshold);
+        }
+
         // Outer loop of the simulated annealing begins
         do {
             vtr::Timer temperature_timer;
 
             annealer_->outer_loop_update_timing_info();
+            // The cost normalization only changes between temperatures, so the costs before and after the moves compare
+            const double temperature_start_cost = costs_.cost;
 
             if (placer_opts_.place_algorithm.is_timing_driven()) {
                 critical_path_ = timing_info_->least_slack_critical_path();
@@ -308,6 +357,31 @@ void Placer::place() {
 
             log_printer_.print_place_status(temperature_timer.elapsed_sec());
 
+            // A losing seed of a multi-seed placement is not annealed (nor quenched) any further
+            if (seed_race_ && !seed_race_->keep_annealing(annealer_->get_annealing_state().num_temps, seed_race_quality())) {
+                stopped_early_ = true;
+                return;
+            }
+
+            if (convergence_monitor) {
+                const t_annealing_state& annealing_state = annealer_->get_annealing_state();
+                convergence_monitor->add_temperature(temperature_start_cost, costs_.cost,
+                                                     annealing_state.move_lim, temperature_timer.elapsed_sec());
+
+                if (convergence_monitor->converged(annealing_state.move_lim)) {
+                    int remaining_temps = annealing_state.estimate_remaining_temps(costs_, placer_opts_);
+                    VTR_LOGV(!log_printer_.quiet(),
+                             "Annealing converged after %d temperatures (predicted cost improvement of the next one %g < %g): "
+                             "skipping about %d temperatures, saving about %.2f seconds\n",
+                             annealing_state.num_temps + 1,
+                             convergence_monitor->predicted_gain(annealing_state.move_lim),
+                             placer_opts_.anneal_convergence_threshold,
+                             remaining_temps,
+                             remaining_temps * convergence_monitor->average_temperature_time());
+                    break;
+                }
+            }
+
             // Outer loop of the simulated annealing ends
         } while (annealer_->outer_loop_update_state());
     } // skip_anneal ends
@@ -315,7 +389,7 @@ void Placer::place() {
     // Start Quench
     annealer_->start_quench();
 
-    pre_quench_timing_stats_ = timing_ctx.stats;
+    pre_quench_timing_stats_ = get_timing_stats();
     { // Quench
         vtr::ScopedFinishTimer temperature_timer("Placement Quench");
 
@@ -331,7 +405,7 @@ void Placer::place() {
 
         log_printer_.print_place_status(temperature_timer.elapsed_sec());
     }
-    post_quench_timing_stats_ = timing_ctx.stats;
+    post_quench_timing_stats_ = get_timing_stats();
 
     // Final timing analysis
     const t_annealing_state& annealing_state = annealer_->get_annealing_state();
@@ -390,3 +464,14 @@ void Placer::update_global_state() {
     get_draw_state_vars()->set_graphics_blk_loc_registry_ref(global_blk_loc_registry);
 #endif
 }
+
+double Placer::seed_race_quality() const {
+    if (placer_opts_.place_algorithm.is_timing_driven()) {
+        return costs_.bb_cost * critical_path_.delay();
+    }
+    return costs_.bb_cost;
+}
+
+void Placer::print_post_placement_stats() const {
+    PlacementLogPrinter(*this, /*quiet=*/false).print_post_placement_stats();
+}
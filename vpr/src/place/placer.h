@@ -17,6 +17,7 @@
  */
 
 #include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 
@@ -34,12 +35,20 @@
 
 class BlkLocRegistry;
 class FlatPlacementInfo;
+class PlacementSeedRace;
 namespace vtr {
 class ScopedStartFinishTimer;
 }
 
 class Placer {
   public:
+    /**
+     * @brief Sets up the placer, running the initial placement (unless one is given).
+     *
+     * The placement delay model may still be under computation: it is then passed as
+     * pending_place_delay_model (with place_delay_model empty), and only waited for once
+     * the initial placement is done, so the two overlap.
+     */
     Placer(const Netlist<>& net_list,
            std::optional<std::reference_wrapper<const BlkLocRegistry>> init_place,
            const t_placer_opts& placer_opts,
@@ -52,7 +61,8 @@ class Placer {
            float anneal_auto_init_t_scale,
            bool cube_bb,
            bool is_flat,
-           bool quiet);
+           bool quiet,
+           std::shared_future<std::shared_ptr<PlaceDelayModel>> pending_place_delay_model = {});
 
     /**
      * @brief Executes the simulated annealing algorithm to optimize placement.
@@ -73,6 +83,24 @@ class Placer {
      */
     void update_global_state();
 
+    /**
+     * @brief Makes the annealer report to the seed race of a multi-seed placement after each temperature,
+     * and stop annealing when the seed race says so.
+     */
+    void set_seed_race(PlacementSeedRace* seed_race) { seed_race_ = seed_race; }
+
+    /// Returns whether place() stopped annealing because the seed race says this placer is losing.
+    bool stopped_early() const { return stopped_early_; }
+
+    /**
+     * @brief Returns the quality the seeds of a multi-seed placement are compared on (lower is better):
+     * the BB cost, times the critical path delay for timing-driven placements.
+     */
+    double seed_race_quality() const;
+
+    /// Prints final placement metrics and generates timing reports, even if this placer is quiet.
+    void print_post_placement_stats() const;
+
   private:
     /// Holds placement algorithm parameters
     const t_placer_opts& placer_opts_;
@@ -102,6 +130,10 @@ class Placer {
     const bool quench_only_;
     /// Indicates if flat routing resource graph and delay model is used. It should be false.
     const bool is_flat_;
+    /// The seed race of a multi-seed placement this placer takes part in (nullptr if none).
+    PlacementSeedRace* seed_race_ = nullptr;
+    /// Whether the seed race stopped the anneal early.
+    bool stopped_early_ = false;
 
     /// Stores a placement state as a retrievable checkpoint in case the placement quality deteriorates later.
     t_placement_checkpoint placement_checkpoint_;
@@ -109,6 +109,9 @@ struct PlacerRuntimeContext : public Context {
     float f_update_td_costs_nets_elapsed_sec;
     float f_update_td_costs_sum_nets_elapsed_sec;
     float f_update_td_costs_total_elapsed_sec;
+    /// Time spent in (and number of) the periodic timing updates, see perform_full_timing_update()
+    float f_timing_update_elapsed_sec = 0.f;
+    int num_timing_updates = 0;
 };
 
 /**
@@ -4,13 +4,18 @@
 #include "timing_info.h"
 #include "timing_util.h"
 
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
 PlacerCriticalities::PlacerCriticalities(const ClusteredNetlist& clb_nlist,
                                          const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
                                          std::shared_ptr<const SetupTimingInfo> timing_info)
     : clb_nlist_(clb_nlist)
     , pin_lookup_(netlist_pin_lookup)
     , timing_info_(std::move(timing_info))
-    , timing_place_crit_(make_net_pins_matrix(clb_nlist_, std::numeric_limits<float>::quiet_NaN())) {
+    , timing_place_crit_(make_net_pins_matrix(clb_nlist_, std::numeric_limits<float>::quiet_NaN()))
+    , raw_crit_(make_net_pins_matrix(clb_nlist_, std::numeric_limits<float>::quiet_NaN())) {
 }
 
 void PlacerCriticalities::update_criticalities(const PlaceCritParams& crit_params) {
@@ -21,11 +26,36 @@ void PlacerCriticalities::update_criticalities(const PlaceCritParams& crit_param
         return;
     }
 
-    // Determine what pins need updating
-    if (!recompute_required && crit_params.crit_exponent == last_crit_exponent_) {
+    // Determine what pins had their timing criticality modified
+    if (!recompute_required) {
         incr_update_criticalities();
     } else {
         recompute_criticalities();
+    }
+
+    // Only look up the timing criticalities of those pins from the timing info.
+    // Each cluster pin reduces its own atom pins into its own entry, so the pins are independent.
+    auto update_raw_crit = [&](ClusterPinId clb_pin) {
+        ClusterNetId clb_net = clb_nlist_.pin_net(clb_pin);
+        int pin_index_in_net = clb_nlist_.pin_net_index(clb_pin);
+
+        raw_crit_[clb_net][pin_index_in_net] = calculate_clb_net_pin_criticality(*timing_info_, pin_lookup_, ParentPinId(size_t(clb_pin)), /*is_flat=*/false);
+    };
+#if defined(VPR_USE_TBB)
+    auto modified_pins_begin = cluster_pins_with_modified_criticality_.begin();
+    tbb::parallel_for(size_t(0), cluster_pins_with_modified_criticality_.size(), [&](size_t ipin) {
+        update_raw_crit(*(modified_pins_begin + ipin));
+    });
+#else
+    for (ClusterPinId clb_pin : cluster_pins_with_modified_criticality_) {
+        update_raw_crit(clb_pin);
+    }
+#endif
+
+    // A new criticality exponent changes the sharpened criticality of every pin,
+    // but the other pins can be re-sharpened from their cached timing criticality
+    if (crit_params.crit_exponent != last_crit_exponent_) {
+        recompute_criticalities();
 
         // Record new criticality exponent
         last_crit_exponent_ = crit_params.crit_exponent;
@@ -36,24 +66,25 @@ void PlacerCriticalities::update_criticalities(const PlaceCritParams& crit_param
      * in that pin), timing_place_crit_ = criticality^(criticality exponent) */
 
     // Update the affected pins
+    bool removed_highly_crit_pins = false;
     for (ClusterPinId clb_pin : cluster_pins_with_modified_criticality_) {
         ClusterNetId clb_net = clb_nlist_.pin_net(clb_pin);
         int pin_index_in_net = clb_nlist_.pin_net_index(clb_pin);
 
-        float clb_pin_crit = calculate_clb_net_pin_criticality(*timing_info_, pin_lookup_, ParentPinId(size_t(clb_pin)), /*is_flat=*/false);
-        float new_crit = pow(clb_pin_crit, crit_params.crit_exponent);
+        float new_crit = pow(raw_crit_[clb_net][pin_index_in_net], crit_params.crit_exponent);
 
         /* Update the highly critical pins container
          *
          * If the old criticality < limit and the new criticality > limit --> add this pin to the highly critical pins
          * If the old criticality > limit and the new criticality < limit --> remove this pin from the highly critical pins
+         *
+         * The removals are batched into a single pass over the highly critical pins below.
          */
         if (!first_time_update_criticality) {
             if (new_crit > crit_params.crit_limit && timing_place_crit_[clb_net][pin_index_in_net] < crit_params.crit_limit) {
                 highly_crit_pins.emplace_back(clb_net, pin_index_in_net);
             } else if (new_crit < crit_params.crit_limit && timing_place_crit_[clb_net][pin_index_in_net] > crit_params.crit_limit) {
-                highly_crit_pins.erase(std::remove(highly_crit_pins.begin(), highly_crit_pins.end(), std::make_pair(clb_net, pin_index_in_net)),
-                                       highly_crit_pins.end());
+                removed_highly_crit_pins = true;
             }
         } else {
             if (new_crit > crit_params.crit_limit) {
@@ -67,6 +98,14 @@ void PlacerCriticalities::update_criticalities(const PlaceCritParams& crit_param
         timing_place_crit_[clb_net][pin_index_in_net] = new_crit;
     }
 
+    if (removed_highly_crit_pins) {
+        highly_crit_pins.erase(std::remove_if(highly_crit_pins.begin(), highly_crit_pins.end(),
+                                              [&](const std::pair<ClusterNetId, int>& pin) {
+                                                  return timing_place_crit_[pin.first][pin.second] < crit_params.crit_limit;
+                                              }),
+                               highly_crit_pins.end());
+    }
+
     /* Criticalities updated. In sync with timing info.
      * Can be incrementally updated on the next iteration */
     recompute_required = false;
@@ -55,8 +55,10 @@ struct PlaceCritParams {
  * ==============
  * To support incremental re-calculation, the class saves the last criticality exponent
  * passed to PlacerCriticalities::update_criticalites(). If the next update uses the same
- * exponent, criticalities can be incrementally updated. Otherwise, they must be re-calculated
- * from scratch, since a change in exponent changes *all* criticalities.
+ * exponent, criticalities can be incrementally updated. Otherwise, they must all be
+ * re-sharpened, since a change in exponent changes *all* criticalities. The (unsharpened)
+ * timing criticality of each connection is cached, so that only the connections modified
+ * by the last timing analysis are looked up from the timing info even then.
  *
  * Calculating criticalities:
  * All the raw setup slack values across a single clock domain are gathered
@@ -168,6 +170,14 @@ class PlacerCriticalities {
      */
     ClbNetPinsMatrix<float> timing_place_crit_;
 
+    /**
+     * @brief The matrix that caches the timing criticality of each connection
+     *        (i.e. before sharpening by the criticality exponent).
+     *
+     * Index range: [0..cluster_ctx.clb_nlist.nets().size()-1][1..num_pins-1]
+     */
+    ClbNetPinsMatrix<float> raw_crit_;
+
     /**
      * The criticality exponent when update_criticalites() was last called
      * (used to detect if incremental update can be used).
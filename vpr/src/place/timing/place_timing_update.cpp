@@ -48,7 +48,7 @@ void initialize_timing_info(const PlaceCritParams& crit_params,
     //invalidate all timing edges via the pin invalidator
     //by passing in all the clb sink pins
     for (ClusterNetId net_id : clb_nlist.nets()) {
-        for (ClusterPinId pin_id : clb_nlist.net_sinks(net_id)) {
+        for (ClusterPinId pin_id : cluster_ctx.clb_net_pins.net_sinks(net_id)) {
             pin_timing_invalidator->invalidate_connection(pin_id);
         }
     }
@@ -72,6 +72,8 @@ void initialize_timing_info(const PlaceCritParams& crit_params,
     p_runtime_ctx.f_update_td_costs_nets_elapsed_sec = 0.f;
     p_runtime_ctx.f_update_td_costs_sum_nets_elapsed_sec = 0.f;
     p_runtime_ctx.f_update_td_costs_total_elapsed_sec = 0.f;
+    p_runtime_ctx.f_timing_update_elapsed_sec = 0.f;
+    p_runtime_ctx.num_timing_updates = 0;
 }
 
 /**
@@ -91,6 +93,8 @@ void perform_full_timing_update(const PlaceCritParams& crit_params,
                                 SetupTimingInfo* timing_info,
                                 t_placer_costs* costs,
                                 PlacerState& placer_state) {
+    vtr::Timer timer;
+
     /* Update all timing related classes. */
     criticalities->enable_update();
     setup_slacks->enable_update();
@@ -108,6 +112,10 @@ void perform_full_timing_update(const PlaceCritParams& crit_params,
 
     /* Commit the setup slacks since they are updated. */
     commit_setup_slacks(setup_slacks, placer_state);
+
+    auto& p_runtime_ctx = placer_state.mutable_runtime();
+    p_runtime_ctx.f_timing_update_elapsed_sec += timer.elapsed_sec();
+    p_runtime_ctx.num_timing_updates++;
 }
 
 /**
@@ -169,11 +177,11 @@ void update_timing_cost(const PlaceDelayModel* delay_model,
                         const PlacerCriticalities* criticalities,
                         PlacerState& placer_state,
                         double* timing_cost) {
-#ifdef INCR_COMP_TD_COSTS
-    update_td_costs(delay_model, *criticalities, placer_state, timing_cost);
-#else
-    comp_td_costs(delay_model, *criticalities, placer_state, timing_cost);
-#endif
+    if constexpr (INCR_COMP_TD_COSTS) {
+        update_td_costs(delay_model, *criticalities, placer_state, timing_cost);
+    } else {
+        comp_td_costs(delay_model, *criticalities, placer_state, timing_cost);
+    }
 }
 
 /**
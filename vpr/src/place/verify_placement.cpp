@@ -12,10 +12,12 @@
  */
 
 #include "verify_placement.h"
+#include <atomic>
 #include <vector>
 #include "blk_loc_registry.h"
 #include "clustered_netlist.h"
 #include "device_grid.h"
+#include "parallel_verifier.h"
 #include "partition_region.h"
 #include "physical_types.h"
 #include "physical_types_util.h"
@@ -49,110 +51,109 @@ static unsigned check_block_placement_consistency(const BlkLocRegistry& blk_loc_
     const auto& block_locs = blk_loc_registry.block_locs();
     const auto& grid_blocks = blk_loc_registry.grid_blocks();
 
-    unsigned num_errors = 0;
-
-    vtr::vector<ClusterBlockId, int> bdone(clb_nlist.blocks().size(), 0);
-
-    /* Step through device grid and placement. Check it against blocks */
-    for (int layer_num = 0; layer_num < (int)device_grid.get_num_layers(); layer_num++) {
-        for (int i = 0; i < (int)device_grid.width(); i++) {
-            for (int j = 0; j < (int)device_grid.height(); j++) {
-                const t_physical_tile_loc tile_loc(i, j, layer_num);
-                const auto& type = device_grid.get_physical_type(tile_loc);
+    // Number of times each block is found in the grid, counted by the columns concurrently
+    std::vector<std::atomic<int>> bdone(clb_nlist.blocks().size());
 
-                // If this is not a root tile block, ensure that its usage is 0
-                // and that it has no valid clusters placed at this location.
-                // TODO: Eventually it should be made impossible to place blocks
-                //       at these locations.
-                if (device_grid.get_width_offset(tile_loc) != 0 || device_grid.get_height_offset(tile_loc) != 0) {
-                    // Usage must be 0
-                    if (grid_blocks.get_usage(tile_loc) != 0) {
-                        VTR_LOG_ERROR(
-                            "%d blocks were placed at non-root tile location "
-                            "(%d, %d, %d), but no blocks should be placed here.\n",
-                            grid_blocks.get_usage(tile_loc), i, j, layer_num);
-                        num_errors++;
-                    }
-                    // Check that all clusters at this tile location are invalid.
-                    for (int k = 0; k < type->capacity; k++) {
-                        ClusterBlockId bnum = grid_blocks.block_at_location({i, j, k, layer_num});
-                        if (bnum.is_valid()) {
-                            VTR_LOG_ERROR(
-                                "Block %zu was placed at non-root tile location "
-                                "(%d, %d, %d), but no blocks should be placed "
-                                "here.\n",
-                                size_t(bnum), i, j, layer_num);
-                            num_errors++;
-                        }
-                    }
-                }
+    /* Step through device grid and placement. Check it against blocks. Each
+     * column (of each layer) is checked independently. */
+    const size_t num_columns = device_grid.get_num_layers() * device_grid.width();
+    unsigned num_errors = parallel_verify(num_columns, [&](size_t icolumn, VerifierErrors& errors) {
+        const int layer_num = icolumn / device_grid.width();
+        const int i = icolumn % device_grid.width();
+        for (int j = 0; j < (int)device_grid.height(); j++) {
+            const t_physical_tile_loc tile_loc(i, j, layer_num);
+            const auto& type = device_grid.get_physical_type(tile_loc);
 
-                if (grid_blocks.get_usage(tile_loc) > type->capacity) {
-                    VTR_LOG_ERROR(
-                        "%d blocks were placed at grid location (%d,%d,%d), but location capacity is %d.\n",
-                        grid_blocks.get_usage(tile_loc), i, j, layer_num, type->capacity);
-                    num_errors++;
+            // If this is not a root tile block, ensure that its usage is 0
+            // and that it has no valid clusters placed at this location.
+            // TODO: Eventually it should be made impossible to place blocks
+            //       at these locations.
+            if (device_grid.get_width_offset(tile_loc) != 0 || device_grid.get_height_offset(tile_loc) != 0) {
+                // Usage must be 0
+                if (grid_blocks.get_usage(tile_loc) != 0) {
+                    VERIFIER_LOG_ERROR(errors,
+                                       "%d blocks were placed at non-root tile location "
+                                       "(%d, %d, %d), but no blocks should be placed here.\n",
+                                       grid_blocks.get_usage(tile_loc), i, j, layer_num);
                 }
-
-                int usage_check = 0;
+                // Check that all clusters at this tile location are invalid.
                 for (int k = 0; k < type->capacity; k++) {
                     ClusterBlockId bnum = grid_blocks.block_at_location({i, j, k, layer_num});
-                    if (bnum == ClusterBlockId::INVALID()) {
-                        continue;
+                    if (bnum.is_valid()) {
+                        VERIFIER_LOG_ERROR(errors,
+                                           "Block %zu was placed at non-root tile location "
+                                           "(%d, %d, %d), but no blocks should be placed "
+                                           "here.\n",
+                                           size_t(bnum), i, j, layer_num);
                     }
+                }
+            }
 
-                    auto logical_block = clb_nlist.block_type(bnum);
-                    auto physical_tile = type;
-                    t_pl_loc block_loc = block_locs[bnum].loc;
+            if (grid_blocks.get_usage(tile_loc) > type->capacity) {
+                VERIFIER_LOG_ERROR(errors,
+                                   "%d blocks were placed at grid location (%d,%d,%d), but location capacity is %d.\n",
+                                   grid_blocks.get_usage(tile_loc), i, j, layer_num, type->capacity);
+            }
 
-                    if (physical_tile_type(block_loc) != physical_tile) {
-                        VTR_LOG_ERROR(
-                            "Block %zu type (%s) does not match grid location (%zu,%zu, %d) type (%s).\n",
-                            size_t(bnum), logical_block->name.c_str(), i, j, layer_num, physical_tile->name.c_str());
-                        num_errors++;
-                    }
+            int usage_check = 0;
+            for (int k = 0; k < type->capacity; k++) {
+                ClusterBlockId bnum = grid_blocks.block_at_location({i, j, k, layer_num});
+                if (bnum == ClusterBlockId::INVALID()) {
+                    continue;
+                }
 
-                    auto& loc = block_locs[bnum].loc;
-                    if (loc.x != i || loc.y != j || loc.layer != layer_num
-                        || !is_sub_tile_compatible(physical_tile, logical_block,
-                                                   loc.sub_tile)) {
-                        VTR_LOG_ERROR(
-                            "Block %zu's location is (%d,%d,%d,%d) but found in grid at (%d,%d,%d,%d).\n",
-                            size_t(bnum),
-                            loc.x,
-                            loc.y,
-                            loc.sub_tile,
-                            loc.layer,
-                            i,
-                            j,
-                            k,
-                            layer_num);
-                        num_errors++;
-                    }
-                    ++usage_check;
-                    bdone[bnum]++;
+                auto logical_block = clb_nlist.block_type(bnum);
+                auto physical_tile = type;
+                t_pl_loc block_loc = block_locs[bnum].loc;
+
+                if (physical_tile_type(block_loc) != physical_tile) {
+                    VERIFIER_LOG_ERROR(errors,
+                                       "Block %zu type (%s) does not match grid location (%d,%d, %d) type (%s).\n",
+                                       size_t(bnum), logical_block->name.c_str(), i, j, layer_num, physical_tile->name.c_str());
                 }
-                if (usage_check != grid_blocks.get_usage(tile_loc)) {
-                    VTR_LOG_ERROR(
-                        "%d block(s) were placed at location (%d,%d,%d), but location contains %d block(s).\n",
-                        grid_blocks.get_usage(tile_loc),
-                        tile_loc.x,
-                        tile_loc.y,
-                        tile_loc.layer_num,
-                        usage_check);
-                    num_errors++;
+
+                auto& loc = block_locs[bnum].loc;
+                if (loc.x != i || loc.y != j || loc.layer != layer_num
+                    || !is_sub_tile_compatible(physical_tile, logical_block,
+                                               loc.sub_tile)) {
+                    VERIFIER_LOG_ERROR(errors,
+                                       "Block %zu's location is (%d,%d,%d,%d) but found in grid at (%d,%d,%d,%d).\n",
+                                       size_t(bnum),
+                                       loc.x,
+                                       loc.y,
+                                       loc.sub_tile,
+                                       loc.layer,
+                                       i,
+                                       j,
+                                       k,
+                                       layer_num);
                 }
+                ++usage_check;
+                bdone[size_t(bnum)].fetch_add(1, std::memory_order_relaxed);
+            }
+            if (usage_check != grid_blocks.get_usage(tile_loc)) {
+                VERIFIER_LOG_ERROR(errors,
+                                   "%d block(s) were placed at location (%d,%d,%d), but location contains %d block(s).\n",
+                                   grid_blocks.get_usage(tile_loc),
+                                   tile_loc.x,
+                                   tile_loc.y,
+                                   tile_loc.layer_num,
+                                   usage_check);
             }
         }
-    }
+    });
 
     /* Check that every block exists in the device_ctx.grid and cluster_ctx.blocks arrays somewhere. */
-    for (ClusterBlockId blk_id : clb_nlist.blocks())
-        if (bdone[blk_id] != 1) {
-            VTR_LOG_ERROR("Block %zu listed %d times in device context grid.\n",
-                          size_t(blk_id), bdone[blk_id]);
-            num_errors++;
+    const auto& blocks = clb_nlist.blocks();
+    num_errors += parallel_verify(blocks.size(), [&](size_t iblk, VerifierErrors& errors) {
+        ClusterBlockId blk_id = *(blocks.begin() + iblk);
+        int num_found = bdone[size_t(blk_id)].load(std::memory_order_relaxed);
+        if (num_found != 1) {
+            VERIFIER_LOG_ERROR(errors,
+                               "Block %zu listed %d times in device context grid.\n",
+                               size_t(blk_id), num_found);
         }
+    });
 
     return num_errors;
 }
@@ -176,10 +177,8 @@ static unsigned check_macro_placement_consistency(const BlkLocRegistry& blk_loc_
     const auto& block_locs = blk_loc_registry.block_locs();
     const auto& grid_blocks = blk_loc_registry.grid_blocks();
 
-    unsigned num_errors = 0;
-
     /* Check the pl_macro placement are legal - blocks are in the proper relative position. */
-    for (size_t imacro = 0; imacro < pl_macros.macros().size(); imacro++) {
+    return parallel_verify(pl_macros.macros().size(), [&](size_t imacro, VerifierErrors& errors) {
         auto head_iblk = pl_macros[imacro].members[0].blk_index;
 
         for (size_t imember = 0; imember < pl_macros[imacro].members.size(); imember++) {
@@ -190,23 +189,19 @@ static unsigned check_macro_placement_consistency(const BlkLocRegistry& blk_loc_
 
             // Check the blk_loc_registry.block_locs data structure first
             if (block_locs[member_iblk].loc != member_pos) {
-                VTR_LOG_ERROR(
-                    "Block %zu in pl_macro #%zu is not placed in the proper orientation.\n",
-                    size_t(member_iblk), imacro);
-                num_errors++;
+                VERIFIER_LOG_ERROR(errors,
+                                   "Block %zu in pl_macro #%zu is not placed in the proper orientation.\n",
+                                   size_t(member_iblk), imacro);
             }
 
             // Then check the blk_loc_registry.grid data structure
             if (grid_blocks.block_at_location(member_pos) != member_iblk) {
-                VTR_LOG_ERROR(
-                    "Block %zu in pl_macro #%zu is not placed in the proper orientation.\n",
-                    size_t(member_iblk), imacro);
-                num_errors++;
+                VERIFIER_LOG_ERROR(errors,
+                                   "Block %zu in pl_macro #%zu is not placed in the proper orientation.\n",
+                                   size_t(member_iblk), imacro);
             }
         } // Finish going through all the members
-    } // Finish going through all the macros
-
-    return num_errors;
+    }); // Finish going through all the macros
 }
 
 /**
@@ -228,22 +223,21 @@ static unsigned check_placement_floorplanning(const BlkLocRegistry& blk_loc_regi
                                               const ClusteredNetlist& clb_nlist) {
     const auto& block_locs = blk_loc_registry.block_locs();
 
-    unsigned num_errors = 0;
-    for (ClusterBlockId blk_id : clb_nlist.blocks()) {
+    const auto& blocks = clb_nlist.blocks();
+    return parallel_verify(blocks.size(), [&](size_t iblk, VerifierErrors& errors) {
+        ClusterBlockId blk_id = *(blocks.begin() + iblk);
         const PartitionRegion& blk_pr = cluster_constraints[blk_id];
         // If the cluster is not constrained, no need to check.
         if (blk_pr.empty())
-            continue;
+            return;
         // Check if the block is placed in its constrained partition region.
         const t_pl_loc& blk_loc = block_locs[blk_id].loc;
         if (!blk_pr.is_loc_in_part_reg(blk_loc)) {
-            VTR_LOG_ERROR(
-                "Block %zu is not in correct floorplanning region.\n",
-                size_t(blk_id));
-            num_errors++;
+            VERIFIER_LOG_ERROR(errors,
+                               "Block %zu is not in correct floorplanning region.\n",
+                               size_t(blk_id));
         }
-    }
-    return num_errors;
+    });
 }
 
 unsigned verify_placement(const BlkLocRegistry& blk_loc_registry,
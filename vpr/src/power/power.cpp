@@ -26,6 +26,7 @@
 #include <csignal>
 #include <ctime>
 #include <cmath>
+#include <algorithm>
 
 #include "physical_types_util.h"
 #include "vtr_util.h"
@@ -45,6 +46,11 @@
 #include "globals.h"
 #include "vpr_utils.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
 /************************* DEFINES **********************************/
 #define CONVERT_NM_PER_M 1000000000
 #define CONVERT_UM_PER_M 1000000
@@ -59,6 +65,48 @@ typedef enum {
     POWER_BREAKDOWN_ENTRY_TYPE_BUFS_WIRES
 } e_power_breakdown_entry_type;
 
+/************************* STRUCTS **********************************/
+/* Power usage and statistics of a set of routing resources. The rr nodes are
+ * accumulated separately, and then joined, to be processed in parallel. */
+struct t_routing_power_usage {
+    t_power_usage total;
+    t_power_usage components[POWER_COMPONENT_MAX_NUM];
+
+    /* Size of switch and connection box buffers */
+    int num_sb_buffers = 0;
+    float total_sb_buffer_size = 0.;
+    int num_cb_buffers = 0;
+    float total_cb_buffer_size = 0.;
+
+    void add(const t_rr_node_power_usage& node_usage) {
+        power_add_usage(&total, &node_usage.sb);
+        power_add_usage(&total, &node_usage.cb);
+        power_add_usage(&total, &node_usage.wire);
+        power_add_usage(&components[POWER_COMPONENT_ROUTE_SB], &node_usage.sb);
+        power_add_usage(&components[POWER_COMPONENT_ROUTE_CB], &node_usage.cb);
+        power_add_usage(&components[POWER_COMPONENT_ROUTE_GLB_WIRE], &node_usage.wire);
+        if (node_usage.has_sb_buffer) {
+            num_sb_buffers++;
+            total_sb_buffer_size += node_usage.sb_buffer_size;
+        }
+        if (node_usage.has_cb_buffer) {
+            num_cb_buffers++;
+            total_cb_buffer_size += node_usage.cb_buffer_size;
+        }
+    }
+
+    void join(const t_routing_power_usage& other) {
+        power_add_usage(&total, &other.total);
+        for (int component_idx = 0; component_idx < POWER_COMPONENT_MAX_NUM; component_idx++) {
+            power_add_usage(&components[component_idx], &other.components[component_idx]);
+        }
+        num_sb_buffers += other.num_sb_buffers;
+        total_sb_buffer_size += other.total_sb_buffer_size;
+        num_cb_buffers += other.num_cb_buffers;
+        total_cb_buffer_size += other.total_cb_buffer_size;
+    }
+};
+
 /************************* File Scope **********************************/
 static t_rr_node_power* rr_node_power;
 
@@ -67,6 +115,10 @@ static t_rr_node_power* rr_node_power;
 static void power_usage_routing(t_power_usage* power_usage,
                                 const t_det_routing_arch& routing_arch,
                                 bool is_flat);
+static void power_usage_rr_node(t_rr_node_power_usage* usage,
+                                RRNodeId rr_id,
+                                const t_det_routing_arch& routing_arch);
+static void power_update_net_activities();
 
 /* Tiles */
 static void power_usage_blocks(t_power_usage* power_usage);
@@ -784,12 +836,6 @@ static void power_usage_routing(t_power_usage* power_usage,
 
     power_zero_usage(power_usage);
 
-    /* Reset routing statistics */
-    power_ctx.commonly_used->num_sb_buffers = 0;
-    power_ctx.commonly_used->total_sb_buffer_size = 0.;
-    power_ctx.commonly_used->num_cb_buffers = 0;
-    power_ctx.commonly_used->total_cb_buffer_size = 0.;
-
     /* Reset rr graph net indices */
     for (const RRNodeId& rr_id : device_ctx.rr_graph.nodes()) {
         rr_node_power[(size_t)rr_id].net_num = ClusterNetId::INVALID();
@@ -832,8 +878,14 @@ static void power_usage_routing(t_power_usage* power_usage,
                             if (next_node_power->net_num == node_power->net_num) {
                                 next_node_power->selected_input = next_node_power->num_inputs;
                             }
-                            next_node_power->in_dens[next_node_power->num_inputs] = clb_net_density(node_power->net_num);
-                            next_node_power->in_prob[next_node_power->num_inputs] = clb_net_prob(node_power->net_num);
+                            float in_dens = clb_net_density(node_power->net_num);
+                            float in_prob = clb_net_prob(node_power->net_num);
+                            if (next_node_power->in_dens[next_node_power->num_inputs] != in_dens
+                                || next_node_power->in_prob[next_node_power->num_inputs] != in_prob) {
+                                next_node_power->in_dens[next_node_power->num_inputs] = in_dens;
+                                next_node_power->in_prob[next_node_power->num_inputs] = in_prob;
+                                next_node_power->usage_valid = false;
+                            }
                             next_node_power->num_inputs++;
                             const t_edge_size next_node_fan_in = rr_graph.node_fan_in(RRNodeId(next_node_id));
                             if (next_node_power->num_inputs > next_node_fan_in) {
@@ -853,175 +905,253 @@ static void power_usage_routing(t_power_usage* power_usage,
         }
     }
 
-    /* Calculate power of all routing entities */
-    for (const RRNodeId& rr_id : device_ctx.rr_graph.nodes()) {
-        t_power_usage sub_power_usage;
+    /* Clear the inputs left over from the previous estimation, and check which nodes
+     * still have the same inputs, to reuse their power (incremental estimation) */
+    for (const RRNodeId& rr_id : rr_graph.nodes()) {
         t_rr_node_power* node_power = &rr_node_power[(size_t)rr_id];
-        float C_wire;
-        float buffer_size;
-        int connectionbox_fanout;
-        int switchbox_fanout;
-        //float C_per_seg_split;
-        int wire_length;
-        const t_edge_size node_fan_in = rr_graph.node_fan_in(rr_id);
 
-        switch (rr_graph.node_type(rr_id)) {
-            case e_rr_type::SOURCE:
-            case e_rr_type::SINK:
-            case e_rr_type::OPIN:
-                /* No power usage for these types */
-                break;
-            case e_rr_type::IPIN:
-                /* This is part of the connectionbox.  The connection box is comprised of:
-                 *  - Driver (accounted for at end of CHANX/Y - see below)
-                 *  - Multiplexor */
-
-                if (node_fan_in) {
-                    VTR_ASSERT(node_power->in_dens);
-                    VTR_ASSERT(node_power->in_prob);
-
-                    /* Multiplexor */
-                    power_usage_mux_multilevel(&sub_power_usage,
-                                               power_get_mux_arch(node_fan_in,
-                                                                  power_ctx.arch->mux_transistor_size),
-                                               node_power->in_prob, node_power->in_dens,
-                                               node_power->selected_input, true,
-                                               power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_CB);
+        if (node_power->in_dens) {
+            for (t_edge_size input_idx = node_power->num_inputs; input_idx < rr_graph.node_fan_in(rr_id); input_idx++) {
+                if (node_power->in_dens[input_idx] != 0. || node_power->in_prob[input_idx] != 0.) {
+                    node_power->in_dens[input_idx] = 0.;
+                    node_power->in_prob[input_idx] = 0.;
+                    node_power->usage_valid = false;
                 }
-                break;
-            case e_rr_type::CHANX:
-            case e_rr_type::CHANY: {
-                /* This is a wire driven by a switchbox, which includes:
-                 * 	- The Multiplexor at the beginning of the wire
-                 * 	- A buffer, after the mux to drive the wire
-                 * 	- The wire itself
-                 * 	- A buffer at the end of the wire, going to switchbox/connectionbox */
+            }
+        }
+
+        if (node_power->usage_selected_input != node_power->selected_input
+            || node_power->usage_net_dens != clb_net_density(node_power->net_num)
+            || node_power->usage_T_crit != power_ctx.solution_inf.T_crit) {
+            node_power->usage_valid = false;
+        }
+    }
+
+    /* Calculate power of all routing entities */
+    t_routing_power_usage routing_usage;
+
+    auto add_rr_node_usage = [&](t_routing_power_usage* usage, RRNodeId rr_id) {
+        t_rr_node_power* node_power = &rr_node_power[(size_t)rr_id];
+        if (!node_power->usage_valid) {
+            power_usage_rr_node(&node_power->usage, rr_id, routing_arch);
+            node_power->usage_valid = true;
+            node_power->usage_selected_input = node_power->selected_input;
+            node_power->usage_net_dens = clb_net_density(node_power->net_num);
+            node_power->usage_T_crit = power_ctx.solution_inf.T_crit;
+        }
+        usage->add(node_power->usage);
+    };
+
+    /* The multiplexer architectures are built lazily, by power_get_mux_arch(). Build them in advance,
+     * up to the largest fan-in, so that they are only looked up while processing the nodes. */
+    t_edge_size max_fan_in = 0;
+    for (const RRNodeId& rr_id : rr_graph.nodes()) {
+        max_fan_in = std::max(max_fan_in, rr_graph.node_fan_in(rr_id));
+    }
+    if (max_fan_in > 0) {
+        power_get_mux_arch(max_fan_in, power_ctx.arch->mux_transistor_size);
+    }
+
+#ifdef VPR_USE_TBB
+    /* Each range of nodes is accumulated separately, and the ranges are joined in a fixed order,
+     * so the results do not depend on the thread scheduling */
+    routing_usage = tbb::parallel_deterministic_reduce(
+        tbb::blocked_range<size_t>(0, rr_graph.num_nodes(), 1024),
+        t_routing_power_usage(),
+        [&](const tbb::blocked_range<size_t>& range, t_routing_power_usage usage) {
+            for (size_t inode = range.begin(); inode != range.end(); inode++) {
+                add_rr_node_usage(&usage, RRNodeId(inode));
+            }
+            return usage;
+        },
+        [](t_routing_power_usage lhs, const t_routing_power_usage& rhs) {
+            lhs.join(rhs);
+            return lhs;
+        });
+#else
+    for (const RRNodeId& rr_id : rr_graph.nodes()) {
+        add_rr_node_usage(&routing_usage, rr_id);
+    }
+#endif
+
+    power_add_usage(power_usage, &routing_usage.total);
+    for (int component_idx = 0; component_idx < POWER_COMPONENT_MAX_NUM; component_idx++) {
+        power_component_add_usage(&routing_usage.components[component_idx], (e_power_component_type)component_idx);
+    }
+    power_ctx.commonly_used->num_sb_buffers = routing_usage.num_sb_buffers;
+    power_ctx.commonly_used->total_sb_buffer_size = routing_usage.total_sb_buffer_size;
+    power_ctx.commonly_used->num_cb_buffers = routing_usage.num_cb_buffers;
+    power_ctx.commonly_used->total_cb_buffer_size = routing_usage.total_cb_buffer_size;
+}
+
+/**
+ * Calculates the power of a single routing resource, from the activities of its inputs
+ * (set up by power_usage_routing).
+ * - usage: (Return value) The power usage and statistics of the node
+ */
+static void power_usage_rr_node(t_rr_node_power_usage* usage,
+                                RRNodeId rr_id,
+                                const t_det_routing_arch& routing_arch) {
+    auto& power_ctx = g_vpr_ctx.power();
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    *usage = t_rr_node_power_usage();
+
+    t_power_usage sub_power_usage;
+    const t_rr_node_power* node_power = &rr_node_power[(size_t)rr_id];
+    float C_wire;
+    float buffer_size;
+    int connectionbox_fanout;
+    int switchbox_fanout;
+    //float C_per_seg_split;
+    int wire_length;
+    const t_edge_size node_fan_in = rr_graph.node_fan_in(rr_id);
+
+    switch (rr_graph.node_type(rr_id)) {
+        case e_rr_type::SOURCE:
+        case e_rr_type::SINK:
+        case e_rr_type::OPIN:
+            /* No power usage for these types */
+            break;
+        case e_rr_type::IPIN:
+            /* This is part of the connectionbox.  The connection box is comprised of:
+             *  - Driver (accounted for at end of CHANX/Y - see below)
+             *  - Multiplexor */
+
+            if (node_fan_in) {
                 VTR_ASSERT(node_power->in_dens);
                 VTR_ASSERT(node_power->in_prob);
 
-                wire_length = 0;
-                if (rr_graph.node_type(rr_id) == e_rr_type::CHANX) {
-                    wire_length = rr_graph.node_xhigh(rr_id) - rr_graph.node_xlow(rr_id) + 1;
-                } else if (rr_graph.node_type(rr_id) == e_rr_type::CHANY) {
-                    wire_length = rr_graph.node_yhigh(rr_id) - rr_graph.node_ylow(rr_id) + 1;
-                }
-                int seg_index = device_ctx.rr_indexed_data[rr_graph.node_cost_index(rr_id)].seg_index;
-                C_wire = wire_length * rr_graph.rr_segments(RRSegmentId(seg_index)).Cmetal;
-                //(double)power_ctx.commonly_used->tile_length);
-                VTR_ASSERT(node_power->selected_input < node_fan_in);
-
                 /* Multiplexor */
                 power_usage_mux_multilevel(&sub_power_usage,
                                            power_get_mux_arch(node_fan_in,
                                                               power_ctx.arch->mux_transistor_size),
                                            node_power->in_prob, node_power->in_dens,
-                                           node_power->selected_input, true, power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
-                power_component_add_usage(&sub_power_usage,
-                                          POWER_COMPONENT_ROUTE_SB);
-
-                /* Buffer Size */
-                switch (rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).power_buffer_type) {
-                    case POWER_BUFFER_TYPE_AUTO:
-                        /*
-                         * C_per_seg_split = ((float) node->num_edges
-                         * power_ctx.commonly_used->INV_1X_C_in + C_wire);
-                         * // / (float) power_ctx.arch->seg_buffer_split;
-                         * buffer_size = power_buffer_size_from_logical_effort(
-                         * C_per_seg_split);
-                         * buffer_size = std::max(buffer_size, 1.0F);
-                         */
-                        buffer_size = power_calc_buffer_size_from_Cout(rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).Cout);
-                        break;
-                    case POWER_BUFFER_TYPE_ABSOLUTE_SIZE:
-                        buffer_size = rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).power_buffer_size;
-                        buffer_size = std::max(buffer_size, 1.0F);
-                        break;
-                    case POWER_BUFFER_TYPE_NONE:
-                        buffer_size = 0.;
-                        break;
-                    default:
-                        buffer_size = 0.;
-                        VTR_ASSERT(0);
-                        break;
-                }
+                                           node_power->selected_input, true,
+                                           power_ctx.solution_inf.T_crit);
+                power_add_usage(&usage->cb, &sub_power_usage);
+            }
+            break;
+        case e_rr_type::CHANX:
+        case e_rr_type::CHANY: {
+            /* This is a wire driven by a switchbox, which includes:
+             * 	- The Multiplexor at the beginning of the wire
+             * 	- A buffer, after the mux to drive the wire
+             * 	- The wire itself
+             * 	- A buffer at the end of the wire, going to switchbox/connectionbox */
+            VTR_ASSERT(node_power->in_dens);
+            VTR_ASSERT(node_power->in_prob);
+
+            wire_length = 0;
+            if (rr_graph.node_type(rr_id) == e_rr_type::CHANX) {
+                wire_length = rr_graph.node_xhigh(rr_id) - rr_graph.node_xlow(rr_id) + 1;
+            } else if (rr_graph.node_type(rr_id) == e_rr_type::CHANY) {
+                wire_length = rr_graph.node_yhigh(rr_id) - rr_graph.node_ylow(rr_id) + 1;
+            }
+            int seg_index = device_ctx.rr_indexed_data[rr_graph.node_cost_index(rr_id)].seg_index;
+            C_wire = wire_length * rr_graph.rr_segments(RRSegmentId(seg_index)).Cmetal;
+            //(double)power_ctx.commonly_used->tile_length);
+            VTR_ASSERT(node_power->selected_input < node_fan_in);
+
+            /* Multiplexor */
+            power_usage_mux_multilevel(&sub_power_usage,
+                                       power_get_mux_arch(node_fan_in,
+                                                          power_ctx.arch->mux_transistor_size),
+                                       node_power->in_prob, node_power->in_dens,
+                                       node_power->selected_input, true, power_ctx.solution_inf.T_crit);
+            power_add_usage(&usage->sb, &sub_power_usage);
+
+            /* Buffer Size */
+            switch (rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).power_buffer_type) {
+                case POWER_BUFFER_TYPE_AUTO:
+                    /*
+                     * C_per_seg_split = ((float) node->num_edges
+                     * power_ctx.commonly_used->INV_1X_C_in + C_wire);
+                     * // / (float) power_ctx.arch->seg_buffer_split;
+                     * buffer_size = power_buffer_size_from_logical_effort(
+                     * C_per_seg_split);
+                     * buffer_size = std::max(buffer_size, 1.0F);
+                     */
+                    buffer_size = power_calc_buffer_size_from_Cout(rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).Cout);
+                    break;
+                case POWER_BUFFER_TYPE_ABSOLUTE_SIZE:
+                    buffer_size = rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).power_buffer_size;
+                    buffer_size = std::max(buffer_size, 1.0F);
+                    break;
+                case POWER_BUFFER_TYPE_NONE:
+                    buffer_size = 0.;
+                    break;
+                default:
+                    buffer_size = 0.;
+                    VTR_ASSERT(0);
+                    break;
+            }
 
-                power_ctx.commonly_used->num_sb_buffers++;
-                power_ctx.commonly_used->total_sb_buffer_size += buffer_size;
+            usage->has_sb_buffer = true;
+            usage->sb_buffer_size = buffer_size;
 
-                /*
-                 * power_ctx.commonly_used->num_sb_buffers +=
-                 * power_ctx.arch->seg_buffer_split;
-                 * power_ctx.commonly_used->total_sb_buffer_size += buffer_size
-                 * power_ctx.arch->seg_buffer_split;
-                 */
+            /*
+             * power_ctx.commonly_used->num_sb_buffers +=
+             * power_ctx.arch->seg_buffer_split;
+             * power_ctx.commonly_used->total_sb_buffer_size += buffer_size
+             * power_ctx.arch->seg_buffer_split;
+             */
 
-                /* Buffer */
-                power_usage_buffer(&sub_power_usage, buffer_size,
-                                   node_power->in_prob[node_power->selected_input],
-                                   node_power->in_dens[node_power->selected_input], true,
-                                   power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
-                power_component_add_usage(&sub_power_usage,
-                                          POWER_COMPONENT_ROUTE_SB);
-
-                /* Wire Capacitance */
-                power_usage_wire(&sub_power_usage, C_wire,
-                                 clb_net_density(node_power->net_num), power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
-                power_component_add_usage(&sub_power_usage,
-                                          POWER_COMPONENT_ROUTE_GLB_WIRE);
-
-                /* Determine types of switches that this wire drives */
-                connectionbox_fanout = 0;
-                switchbox_fanout = 0;
-                for (t_edge_size iedge = 0; iedge < rr_graph.num_edges(rr_id); iedge++) {
-                    if ((RRSwitchId)rr_graph.edge_switch(rr_id, iedge) == routing_arch.wire_to_rr_ipin_switch) {
-                        connectionbox_fanout++;
-                    } else if (rr_graph.edge_switch(rr_id, iedge) == routing_arch.delayless_switch) {
-                        /* Do nothing */
-                    } else {
-                        switchbox_fanout++;
-                    }
+            /* Buffer */
+            power_usage_buffer(&sub_power_usage, buffer_size,
+                               node_power->in_prob[node_power->selected_input],
+                               node_power->in_dens[node_power->selected_input], true,
+                               power_ctx.solution_inf.T_crit);
+            power_add_usage(&usage->sb, &sub_power_usage);
+
+            /* Wire Capacitance */
+            power_usage_wire(&sub_power_usage, C_wire,
+                             clb_net_density(node_power->net_num), power_ctx.solution_inf.T_crit);
+            power_add_usage(&usage->wire, &sub_power_usage);
+
+            /* Determine types of switches that this wire drives */
+            connectionbox_fanout = 0;
+            switchbox_fanout = 0;
+            for (t_edge_size iedge = 0; iedge < rr_graph.num_edges(rr_id); iedge++) {
+                if ((RRSwitchId)rr_graph.edge_switch(rr_id, iedge) == routing_arch.wire_to_rr_ipin_switch) {
+                    connectionbox_fanout++;
+                } else if (rr_graph.edge_switch(rr_id, iedge) == routing_arch.delayless_switch) {
+                    /* Do nothing */
+                } else {
+                    switchbox_fanout++;
                 }
+            }
 
-                /* Buffer to next Switchbox */
-                if (switchbox_fanout) {
-                    buffer_size = power_buffer_size_from_logical_effort(switchbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
-                    power_usage_buffer(&sub_power_usage, buffer_size,
-                                       1 - node_power->in_prob[node_power->selected_input],
-                                       node_power->in_dens[node_power->selected_input], false,
-                                       power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_SB);
-                }
+            /* Buffer to next Switchbox */
+            if (switchbox_fanout) {
+                buffer_size = power_buffer_size_from_logical_effort(switchbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
+                power_usage_buffer(&sub_power_usage, buffer_size,
+                                   1 - node_power->in_prob[node_power->selected_input],
+                                   node_power->in_dens[node_power->selected_input], false,
+                                   power_ctx.solution_inf.T_crit);
+                power_add_usage(&usage->sb, &sub_power_usage);
+            }
 
-                /* Driver for ConnectionBox */
-                if (connectionbox_fanout) {
-                    buffer_size = power_buffer_size_from_logical_effort(connectionbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
+            /* Driver for ConnectionBox */
+            if (connectionbox_fanout) {
+                buffer_size = power_buffer_size_from_logical_effort(connectionbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
 
-                    power_usage_buffer(&sub_power_usage, buffer_size,
-                                       1 - node_power->in_prob[node_power->selected_input],
-                                       node_power->in_dens[node_power->selected_input],
-                                       false, power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_CB);
+                power_usage_buffer(&sub_power_usage, buffer_size,
+                                   1 - node_power->in_prob[node_power->selected_input],
+                                   node_power->in_dens[node_power->selected_input],
+                                   false, power_ctx.solution_inf.T_crit);
+                power_add_usage(&usage->cb, &sub_power_usage);
 
-                    power_ctx.commonly_used->num_cb_buffers++;
-                    power_ctx.commonly_used->total_cb_buffer_size += buffer_size;
-                }
-                break;
+                usage->has_cb_buffer = true;
+                usage->cb_buffer_size = buffer_size;
             }
-            default:
-                power_log_msg(POWER_LOG_WARNING,
-                              "The global routing-resource graph contains an unknown node type.");
-                break;
+            break;
         }
+        default:
+            power_log_msg(POWER_LOG_WARNING,
+                          "The global routing-resource graph contains an unknown node type.");
+            break;
     }
 }
 
@@ -1171,6 +1301,21 @@ void power_pb_pins_uninit() {
     }
 }
 
+/**
+ * Copies the probability/density values of the atom nets to the clustered nets
+ */
+static void power_update_net_activities() {
+    auto& power_ctx = g_vpr_ctx.mutable_power();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    power_ctx.clb_net_power.resize(cluster_ctx.clb_nlist.nets().size());
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        power_ctx.clb_net_power[net_id].probability = power_ctx.atom_net_power[atom_ctx.lookup().atom_net(net_id)].probability;
+        power_ctx.clb_net_power[net_id].density = power_ctx.atom_net_power[atom_ctx.lookup().atom_net(net_id)].density;
+    }
+}
+
 void power_routing_init(const t_det_routing_arch& routing_arch) {
     t_edge_size max_fanin;
     t_edge_size max_IPIN_fanin;
@@ -1179,17 +1324,8 @@ void power_routing_init(const t_det_routing_arch& routing_arch) {
     auto& power_ctx = g_vpr_ctx.mutable_power();
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
-    auto& cluster_ctx = g_vpr_ctx.clustering();
-    auto& atom_ctx = g_vpr_ctx.atom();
 
-    /* Copy probability/density values to new netlist */
-    if (power_ctx.clb_net_power.size() == 0) {
-        power_ctx.clb_net_power.resize(cluster_ctx.clb_nlist.nets().size());
-    }
-    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-        power_ctx.clb_net_power[net_id].probability = power_ctx.atom_net_power[atom_ctx.lookup().atom_net(net_id)].probability;
-        power_ctx.clb_net_power[net_id].density = power_ctx.atom_net_power[atom_ctx.lookup().atom_net(net_id)].density;
-    }
+    power_update_net_activities();
 
     /* Initialize RR Graph Structures */
     rr_node_power = new t_rr_node_power[rr_graph.num_nodes()];
@@ -1712,6 +1848,14 @@ e_power_ret_code power_total(float* run_time_s, const t_vpr_setup& vpr_setup, co
 
     power_zero_usage(&total_power);
 
+    /* The power may be estimated again, after incremental changes to the implementation
+     * or to the activities: the routing resources whose inputs are unchanged reuse their
+     * previous power (see power_usage_routing). */
+    for (int component_idx = 0; component_idx < POWER_COMPONENT_MAX_NUM; component_idx++) {
+        power_zero_usage(&power_ctx.by_component.components[component_idx]);
+    }
+    power_update_net_activities();
+
     if (routing_arch.directionality == BI_DIRECTIONAL) {
         power_log_msg(POWER_LOG_ERROR,
                       "Cannot calculate routing power for bi-directional architectures");
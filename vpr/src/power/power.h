@@ -263,6 +263,17 @@ struct t_power_commonly_used {
     float total_cb_buffer_size;
 };
 
+/* Power usage of a routing resource */
+struct t_rr_node_power_usage {
+    t_power_usage sb;          /* Switch box multiplexer and buffers */
+    t_power_usage cb;          /* Connection box multiplexer and driver */
+    t_power_usage wire;        /* Wire capacitance */
+    float sb_buffer_size = 0.; /* Size of the switch box buffer, if has_sb_buffer */
+    float cb_buffer_size = 0.; /* Size of the connection box driver, if has_cb_buffer */
+    bool has_sb_buffer = false;
+    bool has_cb_buffer = false;
+};
+
 /* 1-to-1 data structure with t_rr_node
  */
 struct t_rr_node_power {
@@ -273,6 +284,14 @@ struct t_rr_node_power {
     t_edge_size selected_input; /* Input index that is selected */
     short driver_switch_type;   /* Switch type that drives this resource */
     bool visited;               /* When traversing netlist, need to track whether the node has been processed */
+
+    /* Power usage from a previous estimation, reused while the node inputs, the density
+     * of its net and the critical path are unchanged (incremental estimation) */
+    t_rr_node_power_usage usage;
+    bool usage_valid;
+    t_edge_size usage_selected_input;
+    float usage_net_dens;
+    float usage_T_crit;
 };
 
 /* Architecture information for a multiplexer.
@@ -39,10 +39,12 @@
 #include "power_callibrate.h"
 
 /************************* FILE SCOPE **********************************/
-static t_transistor_inf* f_transistor_last_searched;
-static t_power_buffer_strength_inf* f_buffer_strength_last_searched;
-static t_power_mux_volt_inf* f_mux_volt_last_searched;
-static t_power_nmos_leakage_inf* f_power_searching_nmos_leakage_info;
+/* Records being searched by the bsearch comparison functions. They are thread local,
+ * as the routing power is estimated in parallel (see power_usage_routing) */
+static thread_local t_transistor_inf* f_transistor_last_searched;
+static thread_local t_power_buffer_strength_inf* f_buffer_strength_last_searched;
+static thread_local t_power_mux_volt_inf* f_mux_volt_last_searched;
+static thread_local t_power_nmos_leakage_inf* f_power_searching_nmos_leakage_info;
 
 /************************* FUNCTION DECLARATIONS ********************/
 
@@ -21,6 +21,10 @@
  */
 
 /************************* INCLUDES *********************************/
+#include <atomic>
+#include <map>
+#include <utility>
+
 #include "vtr_assert.h"
 
 #include "power_lowlevel.h"
@@ -28,7 +32,22 @@
 #include "power_cmos_tech.h"
 #include "globals.h"
 
+/************************* STRUCTS **********************************/
+/* Properties of a transistor of a given type and size */
+struct t_transistor_model {
+    float C_d = 0.;
+    float C_s = 0.;
+    float C_g = 0.;
+    float leakage_st = 0.;   /* Subthreshold leakage power, for V_ds = V_dd */
+    float leakage_gate = 0.; /* Gate leakage power */
+};
+
+/************************* FILE SCOPE **********************************/
+/* Incremented when the technology is (re)loaded, to drop the memoized transistor models */
+static std::atomic<unsigned> f_transistor_models_generation{0};
+
 /************************* FUNCTION DECLARATIONS ********************/
+static const t_transistor_model& power_get_transistor_model(e_tx_type transistor_type, float size);
 static float power_calc_node_switching_v(float capacitance, float density, float period, float voltage);
 static void power_calc_transistor_capacitance(float* C_d, float* C_s, float* C_g, e_tx_type transistor_type, float size);
 static float power_calc_leakage_st(e_tx_type transistor_type, float size);
@@ -47,6 +66,8 @@ void power_lowlevel_init() {
 
     auto& power_ctx = g_vpr_ctx.power();
 
+    f_transistor_models_generation++;
+
     power_calc_transistor_capacitance(&C_d, &C_s, &C_g, NMOS, 1.0);
     power_ctx.commonly_used->NMOS_1X_C_d = C_d;
     power_ctx.commonly_used->NMOS_1X_C_g = C_g;
@@ -228,52 +249,96 @@ void power_calc_inverter_with_input(t_power_usage * power_usage,
 #endif
 
 /**
- * Calculate the capacitance for a transistor
- * - C_d: (Return value) Drain capacitance
- * - C_s: (Return value) Source capacitance
- * - C_g: (Return value) Gate capacitance
+ * Returns the properties of a transistor, interpolated from the technology
+ * records of the closest sizes.
+ * The models are memoized, per transistor type and size, as the components are
+ * built from a handful of transistor sizes only.
  * - transistor_type: NMOS or PMOS
  * - size: (W/L) size of the transistor
  */
-static void power_calc_transistor_capacitance(float* C_d, float* C_s, float* C_g, e_tx_type transistor_type, float size) {
+static const t_transistor_model& power_get_transistor_model(e_tx_type transistor_type, float size) {
+    /* Each thread has its own models, as the routing power is estimated in
+     * parallel (see power_usage_routing). They are dropped when the technology
+     * is reloaded. */
+    static thread_local unsigned thread_models_generation = 0;
+    static thread_local std::map<std::pair<e_tx_type, float>, t_transistor_model> thread_models;
+
+    if (thread_models_generation != f_transistor_models_generation) {
+        thread_models.clear();
+        thread_models_generation = f_transistor_models_generation;
+    }
+
+    auto it = thread_models.find({transistor_type, size});
+    if (it != thread_models.end()) {
+        return it->second;
+    }
+
+    t_transistor_model& model = thread_models[{transistor_type, size}];
+
     t_transistor_size_inf* tx_info_lower;
     t_transistor_size_inf* tx_info_upper;
     bool error;
 
-    /* Initialize to 0 */
-    *C_d = 0.;
-    *C_s = 0.;
-    *C_g = 0.;
-
     error = power_find_transistor_info(&tx_info_lower, &tx_info_upper,
                                        transistor_type, size);
     if (error) {
-        return;
+        /* All zero */
+        return model;
     }
 
+    float leakage_subthreshold;
+    float leakage_gate;
     if (tx_info_lower == nullptr) {
         /* No lower bound */
-        *C_d = tx_info_upper->C_d;
-        *C_s = tx_info_upper->C_s;
-        *C_g = tx_info_upper->C_g;
+        model.C_d = tx_info_upper->C_d;
+        model.C_s = tx_info_upper->C_s;
+        model.C_g = tx_info_upper->C_g;
+        leakage_subthreshold = tx_info_upper->leakage_subthreshold;
+        leakage_gate = tx_info_upper->leakage_gate;
     } else if (tx_info_upper == nullptr) {
         /* No upper bound */
-        *C_d = tx_info_lower->C_d;
-        *C_s = tx_info_lower->C_s;
-        *C_g = tx_info_lower->C_g;
+        model.C_d = tx_info_lower->C_d;
+        model.C_s = tx_info_lower->C_s;
+        model.C_g = tx_info_lower->C_g;
+        leakage_subthreshold = tx_info_lower->leakage_subthreshold;
+        leakage_gate = tx_info_lower->leakage_gate;
     } else {
         /* Linear approximation between sizes */
         float percent_upper = (size - tx_info_lower->size)
                               / (tx_info_upper->size - tx_info_lower->size);
-        *C_d = (1 - percent_upper) * tx_info_lower->C_d
-               + percent_upper * tx_info_upper->C_d;
-        *C_s = (1 - percent_upper) * tx_info_lower->C_s
-               + percent_upper * tx_info_upper->C_s;
-        *C_g = (1 - percent_upper) * tx_info_lower->C_g
-               + percent_upper * tx_info_upper->C_g;
+        model.C_d = (1 - percent_upper) * tx_info_lower->C_d
+                    + percent_upper * tx_info_upper->C_d;
+        model.C_s = (1 - percent_upper) * tx_info_lower->C_s
+                    + percent_upper * tx_info_upper->C_s;
+        model.C_g = (1 - percent_upper) * tx_info_lower->C_g
+                    + percent_upper * tx_info_upper->C_g;
+        leakage_subthreshold = (1 - percent_upper) * tx_info_lower->leakage_subthreshold
+                               + percent_upper * tx_info_upper->leakage_subthreshold;
+        leakage_gate = (1 - percent_upper) * tx_info_lower->leakage_gate
+                       + percent_upper * tx_info_upper->leakage_gate;
     }
 
-    return;
+    auto& power_ctx = g_vpr_ctx.power();
+    model.leakage_st = leakage_subthreshold * power_ctx.tech->Vdd;
+    model.leakage_gate = leakage_gate * power_ctx.tech->Vdd;
+
+    return model;
+}
+
+/**
+ * Calculate the capacitance for a transistor
+ * - C_d: (Return value) Drain capacitance
+ * - C_s: (Return value) Source capacitance
+ * - C_g: (Return value) Gate capacitance
+ * - transistor_type: NMOS or PMOS
+ * - size: (W/L) size of the transistor
+ */
+static void power_calc_transistor_capacitance(float* C_d, float* C_s, float* C_g, e_tx_type transistor_type, float size) {
+    const t_transistor_model& model = power_get_transistor_model(transistor_type, size);
+
+    *C_d = model.C_d;
+    *C_s = model.C_s;
+    *C_g = model.C_g;
 }
 
 /**
@@ -283,34 +348,7 @@ static void power_calc_transistor_capacitance(float* C_d, float* C_s, float* C_g
  * - size: (W/L) of transistor
  */
 static float power_calc_leakage_st(e_tx_type transistor_type, float size) {
-    t_transistor_size_inf* tx_info_lower;
-    t_transistor_size_inf* tx_info_upper;
-    bool error;
-    float current;
-
-    error = power_find_transistor_info(&tx_info_lower, &tx_info_upper,
-                                       transistor_type, size);
-    if (error) {
-        return 0;
-    }
-
-    if (tx_info_lower == nullptr) {
-        /* No lower bound */
-        current = tx_info_upper->leakage_subthreshold;
-
-    } else if (tx_info_upper == nullptr) {
-        /* No upper bound */
-        current = tx_info_lower->leakage_subthreshold;
-    } else {
-        /* Linear approximation between sizes */
-        float percent_upper = (size - tx_info_lower->size)
-                              / (tx_info_upper->size - tx_info_lower->size);
-        current = (1 - percent_upper) * tx_info_lower->leakage_subthreshold
-                  + percent_upper * tx_info_upper->leakage_subthreshold;
-    }
-
-    auto& power_ctx = g_vpr_ctx.power();
-    return current * power_ctx.tech->Vdd;
+    return power_get_transistor_model(transistor_type, size).leakage_st;
 }
 
 /**
@@ -319,34 +357,7 @@ static float power_calc_leakage_st(e_tx_type transistor_type, float size) {
  * - size: (W/L) of transistor
  */
 static float power_calc_leakage_gate(e_tx_type transistor_type, float size) {
-    t_transistor_size_inf* tx_info_lower;
-    t_transistor_size_inf* tx_info_upper;
-    bool error;
-    float current;
-
-    error = power_find_transistor_info(&tx_info_lower, &tx_info_upper,
-                                       transistor_type, size);
-    if (error) {
-        return 0;
-    }
-
-    if (tx_info_lower == nullptr) {
-        /* No lower bound */
-        current = tx_info_upper->leakage_gate;
-
-    } else if (tx_info_upper == nullptr) {
-        /* No upper bound */
-        current = tx_info_lower->leakage_gate;
-    } else {
-        /* Linear approximation between sizes */
-        float percent_upper = (size - tx_info_lower->size)
-                              / (tx_info_upper->size - tx_info_lower->size);
-        current = (1 - percent_upper) * tx_info_lower->leakage_gate
-                  + percent_upper * tx_info_upper->leakage_gate;
-    }
-
-    auto& power_ctx = g_vpr_ctx.power();
-    return current * power_ctx.tech->Vdd;
+    return power_get_transistor_model(transistor_type, size).leakage_gate;
 }
 
 /**
@@ -561,6 +572,14 @@ void power_usage_mux_singlelevel_static(t_power_usage* power_usage,
                                       v_in_selected, in_prob_avg);
     }
 
+    /* The pass transistor leakage only depends on the drain/source voltage. It is computed
+     * once for the output, and once per run of equal input voltages (which are all Vdd
+     * for the first level of a mux). */
+    float leakage_v_out = power_calc_leakage_st_pass_transistor(transistor_size, *v_out);
+    float leakage_v_in = 0.;
+    float leakage_v_in_voltage = 0.;
+    bool leakage_v_in_valid = false;
+
     for (input_idx = 0; input_idx < num_inputs; input_idx++) {
         /* Leakage */
         /* The selected input will never leak */
@@ -570,13 +589,17 @@ void power_usage_mux_singlelevel_static(t_power_usage* power_usage,
 
         /* Output is high and this input is low */
         power_usage->leakage += (*out_prob) * (1 - in_prob[input_idx])
-                                * power_calc_leakage_st_pass_transistor(transistor_size,
-                                                                        *v_out);
+                                * leakage_v_out;
 
         /* Output is low and this input is high */
+        if (!leakage_v_in_valid || v_in[input_idx] != leakage_v_in_voltage) {
+            leakage_v_in = power_calc_leakage_st_pass_transistor(transistor_size,
+                                                                 v_in[input_idx]);
+            leakage_v_in_voltage = v_in[input_idx];
+            leakage_v_in_valid = true;
+        }
         power_usage->leakage += (1 - *out_prob) * in_prob[input_idx]
-                                * power_calc_leakage_st_pass_transistor(transistor_size,
-                                                                        v_in[input_idx]);
+                                * leakage_v_in;
     }
 
     /* Dynamic Power at Output */
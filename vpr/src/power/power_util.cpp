@@ -23,6 +23,7 @@
 #include <cstring>
 #include <cmath>
 #include <map>
+#include <mutex>
 #include <string>
 
 #include "vtr_assert.h"
@@ -68,6 +69,10 @@ float power_perc_dynamic(t_power_usage* power_usage) {
 }
 
 void power_log_msg(e_power_log_type log_type, const char* msg) {
+    /* Messages may be logged by several threads, while estimating the routing power */
+    static std::mutex log_mutex;
+    std::lock_guard<std::mutex> lock(log_mutex);
+
     auto& power_ctx = g_vpr_ctx.power();
     log_msg(&power_ctx.output->logs[log_type], msg);
 }
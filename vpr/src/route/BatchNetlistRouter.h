@@ -0,0 +1,102 @@
+#pragma once
+
+/** @file Batch case for \ref NetlistRouter: the paths of the low criticality nets are searched together,
+ * then all the nets are routed in turn, as by \ref SerialNetlistRouter.
+ *
+ * Each iteration, the nets to reroute whose connections are all no more critical than
+ * --router_batch_max_criticality are planned by a single batch search (see batch_path_search.h),
+ * against the congestion costs at the start of the iteration: on a GPU if VPR is built with
+ * VPR_USE_CUDA, on CPU threads otherwise. The nets are then routed one after the other with a
+ * BatchConnectionRouter, which routes a connection along its planned path unless it conflicts
+ * with the nets routed since the search (a node of the path is now full), and the critical and
+ * conflicting connections with a timing-driven connection router (the "fallback").
+ *
+ * The batch search only minimizes congestion, ignoring delays and the lookahead, so the planned
+ * nets may route with more wirelength than with the timing-driven router. Meant to be compared
+ * with \ref ParallelNetlistRouter on designs with many non-critical nets. Flat routing isn't
+ * supported (its route-throughs aren't modelled by the batch search): all the nets are routed by
+ * the connection router then. */
+
+#include "batch_connection_router.h"
+#include "batch_path_search.h"
+#include "netlist_routers.h"
+#include "serial_connection_router.h"
+
+template<typename HeapType>
+class BatchNetlistRouter : public NetlistRouter {
+  public:
+    BatchNetlistRouter(
+        const Netlist<>& net_list,
+        const RouterLookahead* router_lookahead,
+        const t_router_opts& router_opts,
+        CBRR& connections_inf,
+        NetPinsMatrix<float>& net_delay,
+        const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+        std::shared_ptr<SetupHoldTimingInfo> timing_info,
+        NetPinTimingInvalidator* pin_timing_invalidator,
+        route_budgets& budgeting_inf,
+        const RoutingPredictor& routing_predictor,
+        const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& choking_spots,
+        bool is_flat,
+        int route_verbosity);
+    ~BatchNetlistRouter() {}
+
+    RouteIterResults route_netlist(int itry, float pres_fac, float worst_neg_slack);
+    void handle_bb_updated_nets(const std::vector<ParentNetId>& nets);
+    void set_rcv_enabled(bool x);
+    void set_timing_info(std::shared_ptr<SetupHoldTimingInfo> timing_info);
+
+  private:
+    /** Device memory the search arrays of a batch of nets may use (about 9 bytes per RR node per net) */
+    static constexpr size_t GPU_MEMORY_BUDGET = size_t(1) << 30;
+
+    std::unique_ptr<BatchConnectionRouter> _make_router(const RouterLookahead* router_lookahead,
+                                                        const t_router_opts& router_opts,
+                                                        bool is_flat,
+                                                        int route_verbosity) {
+        auto& device_ctx = g_vpr_ctx.device();
+        auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+        auto router = std::make_unique<SerialConnectionRouter<HeapType>>(
+            device_ctx.grid,
+            *router_lookahead,
+            device_ctx.rr_graph.rr_nodes(),
+            &device_ctx.rr_graph,
+            device_ctx.rr_rc_data,
+            device_ctx.rr_graph.rr_switch(),
+            route_ctx.rr_node_route_inf,
+            is_flat,
+            route_verbosity);
+        router->set_lookahead_cache_size(router_opts.lookahead_cache_entries);
+        return std::make_unique<BatchConnectionRouter>(std::move(router), router_opts.batch_max_criticality);
+    }
+
+    /** Should the paths of \p net_id be planned by the batch search this iteration? */
+    bool is_batch_net(ParentNetId net_id, float worst_neg_slack);
+
+    /** Search the paths of \p nets, against the congestion costs with \p pres_fac */
+    std::vector<BatchNetPaths> find_paths(const std::vector<BatchNet>& nets, float pres_fac);
+
+    /* Context fields */
+    std::unique_ptr<BatchConnectionRouter> _router;
+    const Netlist<>& _net_list;
+    const t_router_opts& _router_opts;
+    CBRR& _connections_inf;
+    NetPinsMatrix<float>& _net_delay;
+    const ClusteredPinAtomPinsLookup& _netlist_pin_lookup;
+    std::shared_ptr<SetupHoldTimingInfo> _timing_info;
+    NetPinTimingInvalidator* _pin_timing_invalidator;
+    route_budgets& _budgeting_inf;
+    const RoutingPredictor& _routing_predictor;
+    const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& _choking_spots;
+    bool _is_flat;
+    int _route_verbosity;
+
+    /** The RR graph searched by the batch search (empty for flat routing) */
+    BatchRRGraph _batch_rr_graph;
+#ifdef VPR_USE_CUDA
+    std::unique_ptr<GpuBatchPathSearch> _gpu_search;
+#endif
+};
+
+#include "BatchNetlistRouter.tpp"
@@ -0,0 +1,220 @@
+#pragma once
+
+/** @file Templated implementations for BatchNetlistRouter */
+
+#include "BatchNetlistRouter.h"
+#include "partition_tree.h"
+#include "route_common.h"
+#include "route_net.h"
+#include "route_utils.h"
+#include "vtr_time.h"
+
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
+template<typename HeapType>
+BatchNetlistRouter<HeapType>::BatchNetlistRouter(
+    const Netlist<>& net_list,
+    const RouterLookahead* router_lookahead,
+    const t_router_opts& router_opts,
+    CBRR& connections_inf,
+    NetPinsMatrix<float>& net_delay,
+    const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+    std::shared_ptr<SetupHoldTimingInfo> timing_info,
+    NetPinTimingInvalidator* pin_timing_invalidator,
+    route_budgets& budgeting_inf,
+    const RoutingPredictor& routing_predictor,
+    const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& choking_spots,
+    bool is_flat,
+    int route_verbosity)
+    : _router(_make_router(router_lookahead, router_opts, is_flat, route_verbosity))
+    , _net_list(net_list)
+    , _router_opts(router_opts)
+    , _connections_inf(connections_inf)
+    , _net_delay(net_delay)
+    , _netlist_pin_lookup(netlist_pin_lookup)
+    , _timing_info(timing_info)
+    , _pin_timing_invalidator(pin_timing_invalidator)
+    , _budgeting_inf(budgeting_inf)
+    , _routing_predictor(routing_predictor)
+    , _choking_spots(choking_spots)
+    , _is_flat(is_flat)
+    , _route_verbosity(route_verbosity) {
+    if (is_flat) {
+        VTR_LOG_WARN("The gpu_batch router doesn't support flat routing: all the nets are routed by the timing-driven connection router\n");
+        return;
+    }
+
+    vtr::ScopedStartFinishTimer timer("Build the RR graph of the batch search");
+    _batch_rr_graph = build_batch_rr_graph(g_vpr_ctx.device().rr_graph);
+#ifdef VPR_USE_CUDA
+    _gpu_search = std::make_unique<GpuBatchPathSearch>(_batch_rr_graph, GPU_MEMORY_BUDGET);
+#endif
+}
+
+template<typename HeapType>
+inline RouteIterResults BatchNetlistRouter<HeapType>::route_netlist(int itry, float pres_fac, float worst_neg_slack) {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    RouteIterResults out;
+
+    vtr::Timer timer;
+
+    /* Sort so net with most sinks is routed first */
+    auto sorted_nets = std::vector<ParentNetId>(_net_list.nets().begin(), _net_list.nets().end());
+    std::stable_sort(sorted_nets.begin(), sorted_nets.end(), [&](ParentNetId id1, ParentNetId id2) -> bool {
+        return _net_list.net_sinks(id1).size() > _net_list.net_sinks(id2).size();
+    });
+
+    /* Plan the low criticality nets together */
+    std::vector<BatchNet> batch_nets;
+    vtr::vector<ParentNetId, int> net_batch_index(_net_list.nets().size(), -1);
+    if (!_is_flat) {
+        for (ParentNetId net_id : sorted_nets) {
+            if (!is_batch_net(net_id, worst_neg_slack))
+                continue;
+
+            const t_bb& bb = route_ctx.route_bb[net_id];
+            const std::vector<RRNodeId>& terminals = route_ctx.net_rr_terminals[net_id];
+            BatchNet net;
+            net.source = size_t(terminals[0]);
+            for (size_t ipin = 1; ipin < terminals.size(); ipin++) {
+                net.sinks.push_back(size_t(terminals[ipin]));
+            }
+            net.xmin = bb.xmin;
+            net.xmax = bb.xmax;
+            net.ymin = bb.ymin;
+            net.ymax = bb.ymax;
+            net.layer_min = bb.layer_min;
+            net.layer_max = bb.layer_max;
+
+            net_batch_index[net_id] = batch_nets.size();
+            batch_nets.push_back(std::move(net));
+        }
+    }
+    std::vector<BatchNetPaths> batch_paths = find_paths(batch_nets, pres_fac);
+    float search_time = timer.elapsed_sec();
+
+    _router->reset_stats();
+    for (size_t inet = 0; inet < sorted_nets.size(); inet++) {
+        ParentNetId net_id = sorted_nets[inet];
+        int ibatch = net_batch_index[net_id];
+        if (ibatch >= 0) {
+            _router->set_net_paths(&batch_nets[ibatch], &batch_paths[ibatch]);
+        } else {
+            _router->set_net_paths(nullptr, nullptr);
+        }
+
+        NetResultFlags flags = route_net(
+            *_router,
+            _net_list,
+            net_id,
+            itry,
+            pres_fac,
+            _router_opts,
+            _connections_inf,
+            out.stats,
+            _net_delay,
+            _netlist_pin_lookup,
+            _timing_info.get(),
+            _pin_timing_invalidator,
+            _budgeting_inf,
+            worst_neg_slack,
+            _routing_predictor,
+            _choking_spots[net_id],
+            _is_flat,
+            route_ctx.route_bb[net_id]);
+
+        if (!flags.success && !flags.retry_with_full_bb) {
+            /* Disconnected RRG and SerialConnectionRouter doesn't think growing the BB will work */
+            _router->set_net_paths(nullptr, nullptr);
+            out.is_routable = false;
+            return out;
+        }
+
+        if (flags.retry_with_full_bb) {
+            /* Grow the BB and retry this net right away, without its planned paths (searched in the old BB).
+             * We don't populate out.bb_updated_nets, since there is no partition tree to update. */
+            route_ctx.route_bb[net_id] = full_device_bb();
+            net_batch_index[net_id] = -1;
+            inet--;
+            continue;
+        }
+
+        if (flags.was_rerouted) {
+            out.rerouted_nets.push_back(net_id);
+#ifndef NO_GRAPHICS
+            update_router_info_and_check_bp(BP_NET_ID, size_t(net_id));
+#endif
+        }
+    }
+    _router->set_net_paths(nullptr, nullptr);
+
+    VTR_LOGV(_route_verbosity > 1,
+             "Batch router: %zu nets searched in %g s, %zu connections routed along their paths, %zu by the connection router\n",
+             batch_nets.size(), search_time, _router->num_batch_connections(), _router->num_fallback_connections());
+    PartitionTreeDebug::log("Routing all nets took " + std::to_string(timer.elapsed_sec()) + " s");
+    return out;
+}
+
+template<typename HeapType>
+bool BatchNetlistRouter<HeapType>::is_batch_net(ParentNetId net_id, float worst_neg_slack) {
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    if (_net_list.net_is_ignored(net_id) || _net_list.net_is_global(net_id) || route_ctx.is_clock_net[net_id])
+        return false;
+    if (!should_route_net(_net_list, net_id, _connections_inf, _budgeting_inf, worst_neg_slack, true))
+        return false;
+
+    for (ParentPinId pin_id : _net_list.net_sinks(net_id)) {
+        float criticality = get_net_pin_criticality(_timing_info.get(),
+                                                    _netlist_pin_lookup,
+                                                    _router_opts.max_criticality,
+                                                    _router_opts.criticality_exp,
+                                                    net_id,
+                                                    pin_id,
+                                                    _is_flat);
+        if (criticality > _router_opts.batch_max_criticality)
+            return false;
+    }
+    return true;
+}
+
+template<typename HeapType>
+std::vector<BatchNetPaths> BatchNetlistRouter<HeapType>::find_paths(const std::vector<BatchNet>& nets, float pres_fac) {
+    if (nets.empty())
+        return {};
+
+    /* Snapshot of the congestion costs */
+    std::vector<float> node_costs(_batch_rr_graph.num_nodes());
+    auto set_node_cost = [&](size_t inode) {
+        node_costs[inode] = get_single_rr_cong_cost(RRNodeId(inode), pres_fac);
+    };
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), node_costs.size(), set_node_cost);
+#else
+    for (size_t inode = 0; inode < node_costs.size(); inode++) {
+        set_node_cost(inode);
+    }
+#endif
+
+#ifdef VPR_USE_CUDA
+    return _gpu_search->find_paths(node_costs, nets);
+#else
+    return find_batch_paths(_batch_rr_graph, node_costs, nets);
+#endif
+}
+
+template<typename HeapType>
+void BatchNetlistRouter<HeapType>::handle_bb_updated_nets(const std::vector<ParentNetId>& /* nets */) {
+}
+
+template<typename HeapType>
+void BatchNetlistRouter<HeapType>::set_rcv_enabled(bool x) {
+    _router->set_rcv_enabled(x);
+}
+
+template<typename HeapType>
+void BatchNetlistRouter<HeapType>::set_timing_info(std::shared_ptr<SetupHoldTimingInfo> timing_info) {
+    _timing_info = timing_info;
+}
@@ -3,6 +3,8 @@
 /** @file Parallel and net-decomposing case for NetlistRouter. Works like
  * \see ParallelNetlistRouter, but tries to "decompose" nets and assign them to
  * the next level of the partition tree where possible.
+ * --router_deterministic_parallel makes its results independent of thread timing, like it does for
+ * \see ParallelNetlistRouter.
  * See "Parallel FPGA Routing with On-the-Fly Net Decomposition", FPT'24 */
 #include "netlist_routers.h"
 
@@ -22,6 +24,10 @@ const int MIN_DECOMP_SINKS = 8;
 /** Minimum # of fanouts of a virtual net to consider decomp. */
 const int MIN_DECOMP_SINKS_VNET = 8;
 
+/** Don't decompose nets when the threads were idle for less than this fraction of the last iteration:
+ * decomposition costs some QoR and there is little load balance to gain */
+const float MIN_DECOMP_IDLE_FRAC = 0.1;
+
 template<typename HeapType>
 class DecompNetlistRouter : public NetlistRouter {
   public:
@@ -39,21 +45,24 @@ class DecompNetlistRouter : public NetlistRouter {
         const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& choking_spots,
         bool is_flat,
         int route_verbosity)
-        : _routers_th(_make_router(router_lookahead, is_flat))
+        : _routers_th(_make_router(router_lookahead, router_opts, is_flat))
         , _net_list(net_list)
         , _router_opts(router_opts)
         , _connections_inf(connections_inf)
         , _net_delay(net_delay)
         , _netlist_pin_lookup(netlist_pin_lookup)
         , _timing_info(timing_info)
-        , _pin_timing_invalidator(pin_timing_invalidator)
+        , _pin_timing_invalidator(router_opts.router_deterministic_parallel ? &_deferred_invalidator : pin_timing_invalidator)
+        , _deferred_invalidator(pin_timing_invalidator)
         , _budgeting_inf(budgeting_inf)
         , _routing_predictor(routing_predictor)
         , _choking_spots(choking_spots)
         , _is_flat(is_flat)
         , _route_verbosity(route_verbosity)
         , _net_known_samples(net_list.nets().size())
-        , _is_decomp_disabled(net_list.nets().size()) {}
+        , _is_decomp_disabled(net_list.nets().size())
+        , _net_cost(net_list.nets().size(), 0)
+        , _is_decomp_picked(net_list.nets().size(), false) {}
     ~DecompNetlistRouter() {}
 
     /** Run a single iteration of netlist routing for this->_net_list. This usually means calling
@@ -70,6 +79,16 @@ class DecompNetlistRouter : public NetlistRouter {
   private:
     /** Should we decompose this net? */
     bool should_decompose_net(ParentNetId net_id, const PartitionTreeNode& node);
+    /** Pick the nets to decompose in this iteration (\ref _is_decomp_picked) from the routing effort of
+     * the nets and the thread idle time measured in the last one, if any. */
+    void plan_decomposition();
+    /** Pick the nets of the nodes under \p node which keep the threads waiting, given \p prefix_cost of
+     * routing the nodes above it and the \p ideal_cost of a perfectly balanced iteration.
+     * \p path_costs are the costs of the most expensive path from each node to a leaf. */
+    void pick_decomposed_nets(const PartitionTreeNode& node,
+                              size_t prefix_cost,
+                              size_t ideal_cost,
+                              const std::unordered_map<const PartitionTreeNode*, size_t>& path_costs);
     /** Get a bitset of sinks to route before net decomposition. Output bitset is 
      * [1..num_sinks] where the corresponding index is set to 1 if the sink needs to
      * be routed */
@@ -87,11 +106,12 @@ class DecompNetlistRouter : public NetlistRouter {
     /** A single task to route nets inside a PartitionTree node and add tasks for its child nodes to task group \p g. */
     void route_partition_tree_node(tbb::task_group& g, PartitionTreeNode& node);
 
-    SerialConnectionRouter<HeapType> _make_router(const RouterLookahead* router_lookahead, bool is_flat) {
+    /** The exemplar copied by each thread, so each thread gets its own lookahead cost cache */
+    SerialConnectionRouter<HeapType> _make_router(const RouterLookahead* router_lookahead, const t_router_opts& router_opts, bool is_flat) {
         auto& device_ctx = g_vpr_ctx.device();
         auto& route_ctx = g_vpr_ctx.mutable_routing();
 
-        return SerialConnectionRouter<HeapType>(
+        SerialConnectionRouter<HeapType> router(
             device_ctx.grid,
             *router_lookahead,
             device_ctx.rr_graph.rr_nodes(),
@@ -101,6 +121,8 @@ class DecompNetlistRouter : public NetlistRouter {
             route_ctx.rr_node_route_inf,
             is_flat,
             _route_verbosity);
+        router.set_lookahead_cache_size(router_opts.lookahead_cache_entries);
+        return router;
     }
 
     /* Context fields. Most of them will be forwarded to route_net (see route_net.tpp) */
@@ -114,7 +136,11 @@ class DecompNetlistRouter : public NetlistRouter {
     NetPinsMatrix<float>& _net_delay;
     const ClusteredPinAtomPinsLookup& _netlist_pin_lookup;
     std::shared_ptr<SetupHoldTimingInfo> _timing_info;
+    /** Invalidator given to route_net: \ref _deferred_invalidator in deterministic mode */
     NetPinTimingInvalidator* _pin_timing_invalidator;
+    /** Collects the invalidated connections in deterministic mode (--router_deterministic_parallel),
+     * to pass them on to the router's invalidator in a fixed order once all nets are routed */
+    DeferredNetPinTimingInvalidator _deferred_invalidator;
     route_budgets& _budgeting_inf;
     const RoutingPredictor& _routing_predictor;
     const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& _choking_spots;
@@ -135,6 +161,21 @@ class DecompNetlistRouter : public NetlistRouter {
 
     /** Is decomposition disabled for this net? [0.._net_list.size()-1] */
     vtr::vector<ParentNetId, bool> _is_decomp_disabled;
+
+    /** Routing effort (heap pops) of each net in the last iteration, including its virtual nets: 0 if it
+     * wasn't routed. [0.._net_list.size()-1] */
+    vtr::vector<ParentNetId, size_t> _net_cost;
+    /** Per-thread routing effort of the nets routed in this iteration */
+    tbb::enumerable_thread_specific<std::vector<std::pair<ParentNetId, size_t>>> _net_costs_th;
+    /** Per-thread time spent routing partition tree nodes in this iteration */
+    tbb::enumerable_thread_specific<float> _busy_time_th;
+    /** Fraction of the last iteration the threads spent waiting for partition tree nodes */
+    float _idle_frac = 1.0;
+    /** Are the nets to decompose picked from measurements (\ref plan_decomposition())? Otherwise the nets
+     * large enough are decomposed */
+    bool _has_decomp_plan = false;
+    /** Is this net picked for decomposition in this iteration? [0.._net_list.size()-1] */
+    vtr::vector<ParentNetId, bool> _is_decomp_picked;
 };
 
 #include "DecompNetlistRouter.tpp"
@@ -2,6 +2,8 @@
 
 /** @file Impls for DecompNetlistRouter */
 
+#include <functional>
+
 #include "DecompNetlistRouter.h"
 #include "globals.h"
 #include "netlist_routers.h"
@@ -16,6 +18,12 @@ inline RouteIterResults DecompNetlistRouter<HeapType>::route_netlist(int itry, f
     for (auto& results : _results_th) {
         results = RouteIterResults();
     }
+    for (auto& net_costs : _net_costs_th) {
+        net_costs.clear();
+    }
+    for (float& busy_time : _busy_time_th) {
+        busy_time = 0;
+    }
 
     /* Set the routing parameters: they won't change until the next call and that saves us the trouble of passing them around */
     _itry = itry;
@@ -36,12 +44,33 @@ inline RouteIterResults DecompNetlistRouter<HeapType>::route_netlist(int itry, f
      * due to bounding box updates, which invalidates virtual nets */
     _tree->clear_vnets();
 
+    plan_decomposition();
+
     /* Put the root node on the task queue, which will add its child nodes when it's finished. Wait until the entire tree gets routed. */
+    vtr::Timer route_timer;
     tbb::task_group group;
     route_partition_tree_node(group, _tree->root());
     group.wait();
     PartitionTreeDebug::log("Routing all nets took " + std::to_string(timer.elapsed_sec()) + " s");
 
+    /* Measure for the next iteration's decomposition: effort of each net and thread idle time */
+    _net_cost.assign(_net_list.nets().size(), 0);
+    for (const auto& net_costs : _net_costs_th) {
+        for (const auto& [net_id, cost] : net_costs) {
+            _net_cost[net_id] += cost;
+        }
+    }
+    float busy_time = 0;
+    for (float thread_busy_time : _busy_time_th) {
+        busy_time += thread_busy_time;
+    }
+    float wall_time = route_timer.elapsed_sec() * tbb::this_task_arena::max_concurrency();
+    _idle_frac = wall_time > 0 ? std::max(0.f, 1.f - busy_time / wall_time) : 0.f;
+
+    if (_router_opts.router_deterministic_parallel) {
+        _deferred_invalidator.flush();
+    }
+
     /* Combine results from threads */
     RouteIterResults out;
     for (auto& results : _results_th) {
@@ -51,6 +80,12 @@ inline RouteIterResults DecompNetlistRouter<HeapType>::route_netlist(int itry, f
         out.is_routable &= results.is_routable;
     }
 
+    /* Per-thread results depend on which thread routed which net */
+    if (_router_opts.router_deterministic_parallel) {
+        std::sort(out.rerouted_nets.begin(), out.rerouted_nets.end());
+        std::sort(out.bb_updated_nets.begin(), out.bb_updated_nets.end());
+    }
+
     return out;
 }
 
@@ -93,6 +128,9 @@ bool DecompNetlistRouter<HeapType>::should_decompose_net(ParentNetId net_id, con
     /* We're at a partition tree leaf: no more nodes to delegate newly created vnets to */
     if (!node.left || !node.right)
         return false;
+    /* Nets crossing a layer boundary are routed whole */
+    if (node.cutline_axis == Axis::LAYER)
+        return false;
     /* Clock net */
     if (_net_list.net_is_global(net_id) && _router_opts.two_stage_clock_routing)
         return false;
@@ -106,10 +144,98 @@ bool DecompNetlistRouter<HeapType>::should_decompose_net(ParentNetId net_id, con
     int num_sinks = _net_list.net_sinks(net_id).size();
     if (num_sinks < MIN_DECOMP_SINKS)
         return false;
+    /* Only decompose the nets which kept the threads waiting, if we know them */
+    if (_has_decomp_plan)
+        return _is_decomp_picked[net_id];
 
     return true;
 }
 
+template<typename HeapType>
+void DecompNetlistRouter<HeapType>::plan_decomposition() {
+    _has_decomp_plan = false;
+    _is_decomp_picked.assign(_net_list.nets().size(), false);
+
+    /* Nothing measured yet (first iteration): decompose with the fixed criteria */
+    size_t total_cost = 0;
+    for (size_t cost : _net_cost) {
+        total_cost += cost;
+    }
+    if (total_cost == 0)
+        return;
+    _has_decomp_plan = true;
+
+    /* Cost of the most expensive path from each node to a leaf: the nodes on a path are routed one after the other */
+    std::unordered_map<const PartitionTreeNode*, size_t> path_costs;
+    std::function<size_t(const PartitionTreeNode&)> get_path_cost = [&](const PartitionTreeNode& node) -> size_t {
+        size_t cost = 0;
+        for (ParentNetId net_id : node.nets) {
+            cost += _net_cost[net_id];
+        }
+        size_t child_cost = 0;
+        for (const PartitionTreeNode* child : {node.left.get(), node.right.get()}) {
+            if (child)
+                child_cost = std::max(child_cost, get_path_cost(*child));
+        }
+        path_costs[&node] = cost + child_cost;
+        return cost + child_cost;
+    };
+    get_path_cost(_tree->root());
+
+    /* The threads idle when a path is longer than their share of the work. In deterministic mode, the decisions can't
+     * depend on the measured time: estimate the idle fraction from the effort instead */
+    size_t num_threads = tbb::this_task_arena::max_concurrency();
+    size_t ideal_cost = total_cost / num_threads;
+    if (_router_opts.router_deterministic_parallel) {
+        size_t iter_cost = std::max(ideal_cost, path_costs[&_tree->root()]);
+        _idle_frac = 1.f - float(total_cost) / (float(iter_cost) * num_threads);
+    }
+    if (_idle_frac < MIN_DECOMP_IDLE_FRAC)
+        return;
+
+    pick_decomposed_nets(_tree->root(), 0, ideal_cost, path_costs);
+}
+
+template<typename HeapType>
+void DecompNetlistRouter<HeapType>::pick_decomposed_nets(const PartitionTreeNode& node,
+                                                         size_t prefix_cost,
+                                                         size_t ideal_cost,
+                                                         const std::unordered_map<const PartitionTreeNode*, size_t>& path_costs) {
+    if (!node.left || !node.right)
+        return;
+
+    size_t node_cost = 0;
+    std::vector<ParentNetId> nets;
+    for (ParentNetId net_id : node.nets) {
+        node_cost += _net_cost[net_id];
+        if (_net_cost[net_id] > 0 && _net_list.net_sinks(net_id).size() >= size_t(MIN_DECOMP_SINKS))
+            nets.push_back(net_id);
+    }
+
+    /* Decompose the most expensive nets until the paths through this node fit in the ideal time. A decomposed net
+     * is mostly routed by the child nodes, in parallel: that takes about half of its cost off the path */
+    size_t path_cost = prefix_cost + path_costs.at(&node);
+    if (path_cost > ideal_cost && node.cutline_axis != Axis::LAYER) {
+        std::sort(nets.begin(), nets.end(), [&](ParentNetId id1, ParentNetId id2) {
+            if (_net_cost[id1] != _net_cost[id2])
+                return _net_cost[id1] > _net_cost[id2];
+            return id1 < id2;
+        });
+        size_t excess = path_cost - ideal_cost;
+        for (ParentNetId net_id : nets) {
+            if (excess == 0)
+                break;
+            _is_decomp_picked[net_id] = true;
+            size_t saved = std::min(excess, _net_cost[net_id] / 2);
+            excess -= saved;
+            node_cost -= saved;
+        }
+    }
+
+    pick_decomposed_nets(*node.left, prefix_cost + node_cost, ideal_cost, path_costs);
+    pick_decomposed_nets(*node.right, prefix_cost + node_cost, ideal_cost, path_costs);
+}
+
 /** Should we decompose this virtual net? (see partition_tree.h) */
 inline bool should_decompose_vnet(const VirtualNet& vnet, const PartitionTreeNode& node) {
     /* We're at a partition tree leaf: no more nodes to delegate newly created vnets to */
@@ -120,6 +246,10 @@ inline bool should_decompose_vnet(const VirtualNet& vnet, const PartitionTreeNod
     if (vnet.times_decomposed >= MAX_DECOMP_DEPTH)
         return false;
 
+    /* Vnets crossing a layer boundary are routed whole */
+    if (node.cutline_axis == Axis::LAYER)
+        return false;
+
     /* Cutline doesn't go through vnet (a valid case: it wasn't there when partition tree was being built) */
     if (node.cutline_axis == Axis::X) {
         if (vnet.clipped_bb.xmin > node.cutline_pos || vnet.clipped_bb.xmax < node.cutline_pos)
@@ -149,16 +279,45 @@ void DecompNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g
      * We want to interleave virtual nets with regular ones, so sort an "index vector"
      * instead where indices >= node.nets.size() refer to node.vnets.
      * Virtual nets use their parent net's #fanouts in sorting while regular
-     * nets use their own #fanouts. */
+     * nets use their own #fanouts.
+     * In deterministic mode, ties are broken with regular nets first, in net ID order, since the order
+     * of node.nets depends on the order in which nets were moved between nodes. Virtual nets are already
+     * in a fixed order (the order their parent node created them in). */
+    const bool deterministic = _router_opts.router_deterministic_parallel;
     std::vector<size_t> order(node.nets.size() + node.vnets.size());
     std::iota(order.begin(), order.end(), 0);
     std::stable_sort(order.begin(), order.end(), [&](size_t i, size_t j) -> bool {
         ParentNetId id1 = i < node.nets.size() ? nets[i] : node.vnets[i - nets.size()].net_id;
         ParentNetId id2 = j < node.nets.size() ? nets[j] : node.vnets[j - nets.size()].net_id;
-        return _net_list.net_sinks(id1).size() > _net_list.net_sinks(id2).size();
+        size_t num_sinks1 = _net_list.net_sinks(id1).size();
+        size_t num_sinks2 = _net_list.net_sinks(id2).size();
+        if (num_sinks1 != num_sinks2)
+            return num_sinks1 > num_sinks2;
+        if (!deterministic)
+            return false;
+        bool is_vnet1 = i >= nets.size();
+        bool is_vnet2 = j >= nets.size();
+        if (is_vnet1 != is_vnet2)
+            return is_vnet2;
+        return is_vnet1 ? i < j : id1 < id2;
     });
 
+    /* Adds the heap pops made while routing a net (or vnet) to its cost, for the next iteration's decomposition */
+    struct NetCostRecorder {
+        ParentNetId net_id;
+        const RouterStats& stats;
+        std::vector<std::pair<ParentNetId, size_t>>& net_costs;
+        size_t start_heap_pops = stats.heap_pops;
+        ~NetCostRecorder() {
+            if (stats.heap_pops > start_heap_pops)
+                net_costs.emplace_back(net_id, stats.heap_pops - start_heap_pops);
+        }
+    };
+
     for (size_t i : order) {
+        NetCostRecorder cost_recorder{i < nets.size() ? nets[i] : node.vnets[i - nets.size()].net_id,
+                                      _results_th.local().stats,
+                                      _net_costs_th.local()};
         if (i < nets.size()) { /* Regular net (not decomposed) */
             ParentNetId net_id = nets[i];
             if (!should_route_net(_net_list, net_id, _connections_inf, _budgeting_inf, _worst_neg_slack, true))
@@ -260,6 +419,7 @@ void DecompNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g
                             + " nets and " + std::to_string(node.vnets.size())
                             + " virtual nets routed in " + std::to_string(timer.elapsed_sec())
                             + " s");
+    _busy_time_th.local() += timer.elapsed_sec();
 
     /* This node is finished: add left & right branches to the task queue */
     if (node.left && node.right) {
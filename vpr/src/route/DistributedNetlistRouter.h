@@ -0,0 +1,92 @@
+#pragma once
+
+/** @file Distributed case for \ref NetlistRouter: the nets are routed by several processes (MPI ranks),
+ * possibly on different machines, for designs too large for the threads of a single one.
+ *
+ * Every rank runs the whole VPR flow with the same inputs and options, and holds a full copy of the
+ * routing. The routing of each iteration is split over the ranks with a \ref PartitionTree, in waves:
+ *  - the nodes above the split depth (which grows with the number of ranks) are routed one level
+ *    per wave, the nodes of a level spread over the ranks (nets in nodes of the same level don't
+ *    overlap, like in \ref ParallelNetlistRouter),
+ *  - then the subtrees under the split depth are routed whole, balanced over the ranks by fanout.
+ *
+ * After each wave, the ranks exchange the routing of the nets they have just routed, and install the
+ * routing of the others' nets in their copy (see distributed_routing.h). Resources shared by nets of
+ * different ranks (e.g. long wires crossing a cutline) show up as overused once the routings are
+ * merged and are resolved by the next iterations. Every rank thus starts each wave, and ends the
+ * routing, with the same legal solution.
+ *
+ * Each rank routes its nets with a single thread: run a rank per core (e.g. mpirun -n 128 on two
+ * 64-core nodes). The ranks write the same output files, so run them in separate directories. */
+
+#include "netlist_routers.h"
+#include "serial_connection_router.h"
+#include "partition_tree.h"
+
+template<typename HeapType>
+class DistributedNetlistRouter : public NetlistRouter {
+  public:
+    DistributedNetlistRouter(
+        const Netlist<>& net_list,
+        const RouterLookahead* router_lookahead,
+        const t_router_opts& router_opts,
+        CBRR& connections_inf,
+        NetPinsMatrix<float>& net_delay,
+        const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+        std::shared_ptr<SetupHoldTimingInfo> timing_info,
+        NetPinTimingInvalidator* pin_timing_invalidator,
+        route_budgets& budgeting_inf,
+        const RoutingPredictor& routing_predictor,
+        const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& choking_spots,
+        bool is_flat,
+        int route_verbosity);
+    ~DistributedNetlistRouter() {}
+
+    RouteIterResults route_netlist(int itry, float pres_fac, float worst_neg_slack);
+    /** Inform the PartitionTree of the nets with updated bounding boxes (the same on all ranks) */
+    void handle_bb_updated_nets(const std::vector<ParentNetId>& nets);
+    void set_rcv_enabled(bool x);
+    void set_timing_info(std::shared_ptr<SetupHoldTimingInfo> timing_info);
+
+  private:
+    /** Nodes of the partition tree routed by this rank in a wave */
+    struct Wave {
+        std::vector<PartitionTreeNode*> nodes;
+        /** Route the subtrees under the nodes (rather than the nets of the nodes only) */
+        bool whole_subtrees = false;
+    };
+
+    /** Split the partition tree into waves (the same on all ranks) and keep the nodes of this rank */
+    std::vector<Wave> make_waves();
+    /** Pick the nodes of this rank among \p nodes, balancing their \p weights over the ranks */
+    std::vector<PartitionTreeNode*> assign_nodes(const std::vector<PartitionTreeNode*>& nodes, const std::vector<size_t>& weights) const;
+    /** Route the nets of \p node (and its subtree with \p whole_subtree), packing their routing into \p buffer.
+     * \return false if a net is impossible to route */
+    bool route_node(PartitionTreeNode& node, bool whole_subtree, RouteIterResults& results, std::vector<int>& buffer);
+
+    SerialConnectionRouter<HeapType> _router;
+    const Netlist<>& _net_list;
+    const t_router_opts& _router_opts;
+    CBRR& _connections_inf;
+    NetPinsMatrix<float>& _net_delay;
+    const ClusteredPinAtomPinsLookup& _netlist_pin_lookup;
+    std::shared_ptr<SetupHoldTimingInfo> _timing_info;
+    NetPinTimingInvalidator* _pin_timing_invalidator;
+    route_budgets& _budgeting_inf;
+    const RoutingPredictor& _routing_predictor;
+    const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& _choking_spots;
+    bool _is_flat;
+
+    /** Cached routing parameters for current iteration (inputs to \see route_netlist()) */
+    int _itry;
+    float _pres_fac;
+    float _worst_neg_slack;
+
+    size_t _rank = 0;
+    size_t _num_ranks = 1;
+
+    /** The partition tree. Holds the groups of nets for each partition */
+    vtr::optional<PartitionTree> _tree;
+};
+
+#include "DistributedNetlistRouter.tpp"
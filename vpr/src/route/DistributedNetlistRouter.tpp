@@ -0,0 +1,246 @@
+#pragma once
+
+/** @file Impls for DistributedNetlistRouter */
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "DistributedNetlistRouter.h"
+#include "distributed_routing.h"
+#include "globals.h"
+#include "route_net.h"
+#include "route_utils.h"
+#include "vtr_time.h"
+
+template<typename HeapType>
+DistributedNetlistRouter<HeapType>::DistributedNetlistRouter(
+    const Netlist<>& net_list,
+    const RouterLookahead* router_lookahead,
+    const t_router_opts& router_opts,
+    CBRR& connections_inf,
+    NetPinsMatrix<float>& net_delay,
+    const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+    std::shared_ptr<SetupHoldTimingInfo> timing_info,
+    NetPinTimingInvalidator* pin_timing_invalidator,
+    route_budgets& budgeting_inf,
+    const RoutingPredictor& routing_predictor,
+    const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& choking_spots,
+    bool is_flat,
+    int route_verbosity)
+    : _router(g_vpr_ctx.device().grid,
+              *router_lookahead,
+              g_vpr_ctx.device().rr_graph.rr_nodes(),
+              &g_vpr_ctx.device().rr_graph,
+              g_vpr_ctx.device().rr_rc_data,
+              g_vpr_ctx.device().rr_graph.rr_switch(),
+              g_vpr_ctx.mutable_routing().rr_node_route_inf,
+              is_flat,
+              route_verbosity)
+    , _net_list(net_list)
+    , _router_opts(router_opts)
+    , _connections_inf(connections_inf)
+    , _net_delay(net_delay)
+    , _netlist_pin_lookup(netlist_pin_lookup)
+    , _timing_info(timing_info)
+    , _pin_timing_invalidator(pin_timing_invalidator)
+    , _budgeting_inf(budgeting_inf)
+    , _routing_predictor(routing_predictor)
+    , _choking_spots(choking_spots)
+    , _is_flat(is_flat) {
+    _router.set_lookahead_cache_size(router_opts.lookahead_cache_entries);
+    init_distributed_routing();
+    _rank = distributed_rank();
+    _num_ranks = distributed_num_ranks();
+    check_distributed_routing_inputs(net_list);
+}
+
+template<typename HeapType>
+inline RouteIterResults DistributedNetlistRouter<HeapType>::route_netlist(int itry, float pres_fac, float worst_neg_slack) {
+    /* Set the routing parameters: they won't change until the next call and that saves us the trouble of passing them around */
+    _itry = itry;
+    _pres_fac = pres_fac;
+    _worst_neg_slack = worst_neg_slack;
+
+    vtr::Timer timer;
+    if (!_tree) {
+        _tree = PartitionTree(_net_list);
+    }
+
+    RouteIterResults out;
+    for (const Wave& wave : make_waves()) {
+        std::vector<int> buffer;
+        /* A rank with an unroutable net still takes part in the exchanges, or the others would wait forever */
+        if (out.is_routable) {
+            for (PartitionTreeNode* node : wave.nodes) {
+                if (!route_node(*node, wave.whole_subtrees, out, buffer)) {
+                    out.is_routable = false;
+                    break;
+                }
+            }
+        }
+
+        unpack_net_routings(exchange_net_routings(buffer),
+                            _net_list,
+                            _router_opts,
+                            _connections_inf,
+                            _net_delay,
+                            _timing_info.get(),
+                            _pin_timing_invalidator,
+                            out.rerouted_nets,
+                            out.bb_updated_nets);
+    }
+
+    out.is_routable = distributed_all_of(out.is_routable);
+    reduce_router_stats(out.stats);
+
+    /* The same on all ranks, whichever routed the nets */
+    std::sort(out.rerouted_nets.begin(), out.rerouted_nets.end());
+    std::sort(out.bb_updated_nets.begin(), out.bb_updated_nets.end());
+
+    PartitionTreeDebug::log("Routing all nets took " + std::to_string(timer.elapsed_sec()) + " s");
+    return out;
+}
+
+template<typename HeapType>
+std::vector<typename DistributedNetlistRouter<HeapType>::Wave> DistributedNetlistRouter<HeapType>::make_waves() {
+    auto sum_fanouts = [&](const PartitionTreeNode* node) {
+        size_t fanouts = 0;
+        for (ParentNetId net_id : node->nets) {
+            fanouts += _net_list.net_sinks(net_id).size();
+        }
+        return fanouts;
+    };
+
+    /* Deep enough for a few subtrees per rank, to balance them */
+    size_t split_depth = _num_ranks > 1 ? size_t(std::ceil(std::log2(_num_ranks))) + 1 : 0;
+
+    std::vector<Wave> waves;
+    std::vector<PartitionTreeNode*> level = {&_tree->root()};
+    std::vector<PartitionTreeNode*> subtrees;
+    for (size_t depth = 0; depth < split_depth && !level.empty(); depth++) {
+        std::vector<PartitionTreeNode*> branches;
+        std::vector<size_t> weights;
+        std::vector<PartitionTreeNode*> next_level;
+        for (PartitionTreeNode* node : level) {
+            if (!node->left && !node->right) { /* Leaf above the split depth: route it with the subtrees */
+                subtrees.push_back(node);
+                continue;
+            }
+            branches.push_back(node);
+            weights.push_back(sum_fanouts(node));
+            for (PartitionTreeNode* child : {node->left.get(), node->right.get()}) {
+                if (child) {
+                    next_level.push_back(child);
+                }
+            }
+        }
+        waves.push_back(Wave{assign_nodes(branches, weights), false});
+        level = std::move(next_level);
+    }
+    subtrees.insert(subtrees.end(), level.begin(), level.end());
+
+    std::vector<size_t> weights;
+    for (const PartitionTreeNode* node : subtrees) {
+        weights.push_back(node->subtree_fanouts);
+    }
+    waves.push_back(Wave{assign_nodes(subtrees, weights), true});
+    return waves;
+}
+
+template<typename HeapType>
+std::vector<PartitionTreeNode*> DistributedNetlistRouter<HeapType>::assign_nodes(const std::vector<PartitionTreeNode*>& nodes, const std::vector<size_t>& weights) const {
+    /* Heaviest first, each to the least loaded rank (ties broken by position, so all ranks agree) */
+    std::vector<size_t> order(nodes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t i, size_t j) {
+        return weights[i] > weights[j];
+    });
+
+    std::vector<size_t> loads(_num_ranks, 0);
+    std::vector<PartitionTreeNode*> mine;
+    for (size_t i : order) {
+        size_t rank = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        loads[rank] += weights[i];
+        if (rank == _rank) {
+            mine.push_back(nodes[i]);
+        }
+    }
+    return mine;
+}
+
+template<typename HeapType>
+bool DistributedNetlistRouter<HeapType>::route_node(PartitionTreeNode& node, bool whole_subtree, RouteIterResults& results, std::vector<int>& buffer) {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    /* Sort so net with most sinks is routed first. node.nets is an unordered set whose order depends on the
+     * order in which nets were moved between nodes: break ties by net ID */
+    std::vector<ParentNetId> nets(node.nets.begin(), node.nets.end());
+    std::sort(nets.begin(), nets.end(), [&](ParentNetId id1, ParentNetId id2) -> bool {
+        size_t num_sinks1 = _net_list.net_sinks(id1).size();
+        size_t num_sinks2 = _net_list.net_sinks(id2).size();
+        if (num_sinks1 != num_sinks2)
+            return num_sinks1 > num_sinks2;
+        return id1 < id2;
+    });
+
+    for (ParentNetId net_id : nets) {
+        NetResultFlags flags = route_net(
+            _router,
+            _net_list,
+            net_id,
+            _itry,
+            _pres_fac,
+            _router_opts,
+            _connections_inf,
+            results.stats,
+            _net_delay,
+            _netlist_pin_lookup,
+            _timing_info.get(),
+            _pin_timing_invalidator,
+            _budgeting_inf,
+            _worst_neg_slack,
+            _routing_predictor,
+            _choking_spots[net_id],
+            _is_flat,
+            route_ctx.route_bb[net_id]);
+
+        if (!flags.success && !flags.retry_with_full_bb) {
+            /* Disconnected RRG and SerialConnectionRouter doesn't think growing the BB will work */
+            return false;
+        }
+        if (flags.retry_with_full_bb) {
+            /* Grow the BB and leave this net unrouted for now: it moves up the partition tree for the next iteration */
+            route_ctx.route_bb[net_id] = full_device_bb();
+            results.bb_updated_nets.push_back(net_id);
+            pack_net_routing(buffer, net_id, DISTRIBUTED_NET_BB_UPDATED);
+        } else if (flags.was_rerouted) {
+            results.rerouted_nets.push_back(net_id);
+            pack_net_routing(buffer, net_id, DISTRIBUTED_NET_REROUTED);
+        }
+    }
+
+    if (whole_subtree) {
+        for (PartitionTreeNode* child : {node.left.get(), node.right.get()}) {
+            if (child && !route_node(*child, true, results, buffer))
+                return false;
+        }
+    }
+    return true;
+}
+
+template<typename HeapType>
+void DistributedNetlistRouter<HeapType>::handle_bb_updated_nets(const std::vector<ParentNetId>& nets) {
+    VTR_ASSERT(_tree);
+    _tree->update_nets(nets);
+}
+
+template<typename HeapType>
+void DistributedNetlistRouter<HeapType>::set_rcv_enabled(bool x) {
+    _router.set_rcv_enabled(x);
+}
+
+template<typename HeapType>
+void DistributedNetlistRouter<HeapType>::set_timing_info(std::shared_ptr<SetupHoldTimingInfo> timing_info) {
+    _timing_info = timing_info;
+}
@@ -4,6 +4,7 @@
 #include "netlist_routers.h"
 #include "partition_tree.h"
 #include "vtr_optional.h"
+#include "vtr_profile.h"
 #include "vtr_thread_pool.h"
 #include "serial_connection_router.h"
 #include "parallel_connection_router.h"
@@ -81,7 +82,7 @@ class NestedNetlistRouter : public NetlistRouter {
 
         if (!router_opts.enable_parallel_connection_router) {
             // Serial Connection Router
-            return std::make_unique<SerialConnectionRouter<HeapType>>(
+            auto router = std::make_unique<SerialConnectionRouter<HeapType>>(
                 device_ctx.grid,
                 *router_lookahead,
                 device_ctx.rr_graph.rr_nodes(),
@@ -91,6 +92,8 @@ class NestedNetlistRouter : public NetlistRouter {
                 route_ctx.rr_node_route_inf,
                 is_flat,
                 _route_verbosity);
+            router->set_lookahead_cache_size(router_opts.lookahead_cache_entries);
+            return router;
         } else {
             // Parallel Connection Router
             return std::make_unique<ParallelConnectionRouter<HeapType>>(
@@ -105,7 +108,9 @@ class NestedNetlistRouter : public NetlistRouter {
                 _route_verbosity,
                 router_opts.multi_queue_num_threads,
                 router_opts.multi_queue_num_queues,
-                router_opts.multi_queue_direct_draining);
+                router_opts.multi_queue_direct_draining,
+                router_opts.multi_queue_stickiness,
+                router_opts.multi_queue_pop_batch_size);
         }
     }
 
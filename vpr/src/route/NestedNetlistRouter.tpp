@@ -51,6 +51,7 @@ inline RouteIterResults NestedNetlistRouter<HeapType>::route_netlist(int itry, f
 
 template<typename HeapType>
 void NestedNetlistRouter<HeapType>::route_partition_tree_node(PartitionTreeNode& node) {
+    VTR_PROFILE_ZONE("Route partition");
     auto& route_ctx = g_vpr_ctx.mutable_routing();
 
     /* node.nets is an unordered set, copy into vector to sort */
@@ -5,15 +5,59 @@
  * its child nodes to the task queue. This approach is serially equivalent & deterministic,
  * but it can reduce QoR in congested cases [0].
  *
+ * When --router_partition_node_batching is on, the nets inside a single node are further
+ * grouped into batches of nets with mutually disjoint bounding boxes. Each batch is routed
+ * with tbb::parallel_for, so idle workers can pick up nets from the (usually large and
+ * serial) top levels of the tree as well.
+ *
+ * With --router_deterministic_parallel on, the results also don't depend on the order in which
+ * threads finish their nets: nets are ordered by net ID after fanout, the per-thread results are
+ * merged in net ID order and timing graph invalidations are applied in pin order after all nets
+ * are routed. A given thread count (and any other) then gives identical routings.
+ *
+ * With --enable_parallel_connection_router on, the router also parallelizes inside the nets where
+ * there is little inter-net parallelism (hybrid mode): nets in the root node and high fanout nets
+ * (--router_high_fanout_threshold) in the top levels of the tree are routed with a single, shared
+ * MultiQueue-based ParallelConnectionRouter using --multi_queue_num_threads threads. The thread
+ * budget is shared with the net-level tasks: a level only uses it if its nodes times the intra-net
+ * threads fit in the worker count, and a net only takes it if no other net is using it (otherwise
+ * it is routed serially, as usual). The other nets are routed serially in parallel.
+ *
+ * With --numa_aware_threads on (and more than one NUMA node), the tree is split into one region per
+ * NUMA node at the depth where it has enough subtrees. Each region is routed in a tbb::task_arena of
+ * workers pinned to its node, and the pages of the per-node routing state (rr_node_route_inf) are moved
+ * to the node whose region holds most of their RR nodes. The levels above stay in the default arena.
+ *
  * Note that the parallel router does not support graphical router breakpoints.
  *
  * [0]: "Parallel FPGA Routing with On-the-Fly Net Decomposition", FPT'24 */
 
 #include "netlist_routers.h"
+#include "numa_threads.h"
+#include "parallel_connection_router.h"
+#include "vpr_context_observer.h"
 #include "vtr_optional.h"
+#include "vtr_profile.h"
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
+#include <tbb/task_arena.h>
 #include <tbb/task_group.h>
 
+/** Per-thread utilization stats for one level of the \ref PartitionTree.
+ * Collected by the \ref ParallelNetlistRouter and reported at route_verbosity > 1. */
+struct PartitionTreeLevelStats {
+    /** Number of tree nodes routed by this thread in this level */
+    size_t nodes_routed = 0;
+    /** Number of nets routed by this thread in this level */
+    size_t nets_routed = 0;
+    /** Time spent by this thread routing nets in this level */
+    float busy_sec = 0.0;
+};
+
 /** Parallel impl for NetlistRouter.
  * Holds enough context members to glue together SerialConnectionRouter and net routing functions,
  * such as \ref route_net. Keeps the members in thread-local storage where needed,
@@ -36,19 +80,27 @@ class ParallelNetlistRouter : public NetlistRouter {
         const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& choking_spots,
         bool is_flat,
         int route_verbosity)
-        : _routers_th(_make_router(router_lookahead, is_flat))
+        : _routers_th(_make_router(router_lookahead, router_opts, is_flat))
         , _net_list(net_list)
         , _router_opts(router_opts)
         , _connections_inf(connections_inf)
         , _net_delay(net_delay)
         , _netlist_pin_lookup(netlist_pin_lookup)
         , _timing_info(timing_info)
-        , _pin_timing_invalidator(pin_timing_invalidator)
+        , _pin_timing_invalidator(router_opts.router_deterministic_parallel ? &_deferred_invalidator : pin_timing_invalidator)
+        , _deferred_invalidator(pin_timing_invalidator)
         , _budgeting_inf(budgeting_inf)
         , _routing_predictor(routing_predictor)
         , _choking_spots(choking_spots)
         , _is_flat(is_flat)
-        , _route_verbosity(route_verbosity) {}
+        , _route_verbosity(route_verbosity) {
+        if (router_opts.enable_parallel_connection_router) {
+            _make_intra_net_router(router_lookahead, is_flat);
+        }
+        if (router_opts.numa_aware_threads) {
+            _make_numa_arenas();
+        }
+    }
     ~ParallelNetlistRouter() {}
 
     /** Run a single iteration of netlist routing for this->_net_list. This usually means calling
@@ -61,14 +113,40 @@ class ParallelNetlistRouter : public NetlistRouter {
     void set_timing_info(std::shared_ptr<SetupHoldTimingInfo> timing_info);
 
   private:
-    /** A single task to route nets inside a PartitionTree node and add tasks for its child nodes to task group \p g. */
-    void route_partition_tree_node(tbb::task_group& g, PartitionTreeNode& node);
+    /** A single task to route nets inside a PartitionTree node and add tasks for its child nodes to task group \p g.
+     * \p level is the depth of \p node in the tree (root is 0) and is only used for stats. */
+    void route_partition_tree_node(tbb::task_group& g, PartitionTreeNode& node, size_t level);
+
+    /** Add a task routing the subtree under \p node (at depth \p level) to the NUMA arena of its region
+     * if it is one (see \ref _numa_regions), or to task group \p g otherwise */
+    void run_subtree(tbb::task_group& g, PartitionTreeNode& node, size_t level);
+
+    /** Route a single net in a PartitionTree node (at depth \p level) and update the thread-local results.
+     * The net is routed with \ref _intra_net_router if \p allow_intra_net, it qualifies for it
+     * (see \ref use_intra_net_router) and no other net is using it.
+     * \return false if the net is impossible to route (disconnected RR graph) */
+    bool route_net_in_node(ParentNetId net_id, size_t level, bool allow_intra_net);
+
+    /** Should \p net_id, in a node at depth \p level, be routed with the intra-net parallel router? */
+    bool use_intra_net_router(ParentNetId net_id, size_t level) const;
 
-    SerialConnectionRouter<HeapType> _make_router(const RouterLookahead* router_lookahead, bool is_flat) {
+    /** Route \p nets (already sorted by priority) in batches of nets with mutually disjoint
+     * bounding boxes. The nets of a batch are routed in parallel.
+     * \return false if any of the nets was impossible to route */
+    bool route_nets_batched(const std::vector<ParentNetId>& nets, size_t level);
+
+    /** Add to the calling thread's stats for \p level */
+    void log_level_stats(size_t level, size_t num_nodes, size_t num_nets, float busy_sec);
+
+    /** Sum up \ref _level_stats_th and print a per-level utilization summary */
+    void report_level_stats(int itry);
+
+    /** The exemplar copied by each thread, so each thread gets its own lookahead cost cache */
+    SerialConnectionRouter<HeapType> _make_router(const RouterLookahead* router_lookahead, const t_router_opts& router_opts, bool is_flat) {
         auto& device_ctx = g_vpr_ctx.device();
         auto& route_ctx = g_vpr_ctx.mutable_routing();
 
-        return SerialConnectionRouter<HeapType>(
+        SerialConnectionRouter<HeapType> router(
             device_ctx.grid,
             *router_lookahead,
             device_ctx.rr_graph.rr_nodes(),
@@ -78,8 +156,23 @@ class ParallelNetlistRouter : public NetlistRouter {
             route_ctx.rr_node_route_inf,
             is_flat,
             _route_verbosity);
+        router.set_lookahead_cache_size(router_opts.lookahead_cache_entries);
+        return router;
     }
 
+    /** Make \ref _intra_net_router and pick the tree levels allowed to use it (hybrid mode) */
+    void _make_intra_net_router(const RouterLookahead* router_lookahead, bool is_flat);
+
+    /** Make one arena per NUMA node, sharing the workers evenly (--numa_aware_threads) */
+    void _make_numa_arenas();
+
+    /** Find the subtrees at the depth where the tree has one or more per NUMA node, and
+     * assign them to the nodes from left to right. Called every iteration, since the tree changes */
+    void assign_numa_regions();
+
+    /** Move each page of rr_node_route_inf to the NUMA node whose region holds most of its RR nodes */
+    void place_route_inf_pages();
+
     /* Context fields. Most of them will be forwarded to route_net (see route_net.tpp) */
     /** Per-thread storage for ConnectionRouters. */
     tbb::enumerable_thread_specific<SerialConnectionRouter<HeapType>> _routers_th;
@@ -88,10 +181,16 @@ class ParallelNetlistRouter : public NetlistRouter {
     CBRR& _connections_inf;
     /** Per-thread storage for RouteIterResults. */
     tbb::enumerable_thread_specific<RouteIterResults> _results_th;
+    /** Per-thread PartitionTree level stats. Indexed by tree level */
+    tbb::enumerable_thread_specific<std::vector<PartitionTreeLevelStats>> _level_stats_th;
     NetPinsMatrix<float>& _net_delay;
     const ClusteredPinAtomPinsLookup& _netlist_pin_lookup;
     std::shared_ptr<SetupHoldTimingInfo> _timing_info;
+    /** Invalidator given to route_net: \ref _deferred_invalidator in deterministic mode */
     NetPinTimingInvalidator* _pin_timing_invalidator;
+    /** Collects the invalidated connections in deterministic mode (--router_deterministic_parallel),
+     * to pass them on to the router's invalidator in a fixed order once all nets are routed */
+    DeferredNetPinTimingInvalidator _deferred_invalidator;
     route_budgets& _budgeting_inf;
     const RoutingPredictor& _routing_predictor;
     const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& _choking_spots;
@@ -105,6 +204,35 @@ class ParallelNetlistRouter : public NetlistRouter {
 
     /** The partition tree. Holds the groups of nets for each partition */
     vtr::optional<PartitionTree> _tree;
+
+    /** Multi-threaded connection router for the nets at the top of the tree (hybrid mode only) */
+    std::unique_ptr<ParallelConnectionRouter<HeapType>> _intra_net_router;
+    /** Held by the thread routing a net with \ref _intra_net_router */
+    std::mutex _intra_net_router_lock;
+    /** Deepest tree level whose high fanout nets may use \ref _intra_net_router */
+    size_t _intra_net_max_level = 0;
+    /** The parallel connection router doesn't support RCV: route everything serially when it's on */
+    bool _rcv_enabled = false;
+
+    /** Arena of workers pinned to a NUMA node, with the tasks routing the node's regions
+     * (for the flow of the thread making it) */
+    struct NumaArena {
+        tbb::task_arena arena;
+        NumaPinningObserver observer;
+        VprContextObserver ctx_observer;
+        tbb::task_group group;
+
+        NumaArena(int max_concurrency, size_t node)
+            : arena(max_concurrency, 0)
+            , observer(arena, node)
+            , ctx_observer(arena, get_current_vpr_context()) {}
+    };
+    /** One arena per NUMA node. Empty unless --numa_aware_threads is on and there are several nodes */
+    std::vector<std::unique_ptr<NumaArena>> _numa_arenas;
+    /** Root of each region and its NUMA node (index into \ref _numa_arenas) */
+    std::vector<std::pair<const PartitionTreeNode*, size_t>> _numa_regions;
+    /** Has \ref place_route_inf_pages run? The routing state is only moved once */
+    bool _route_inf_pages_placed = false;
 };
 
 #include "ParallelNetlistRouter.tpp"
@@ -2,17 +2,27 @@
 
 /** @file Impls for ParallelNetlistRouter */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include "netlist_routers.h"
 #include "route_net.h"
+#include "vtr_numa.h"
 #include "vtr_time.h"
 
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 template<typename HeapType>
 inline RouteIterResults ParallelNetlistRouter<HeapType>::route_netlist(int itry, float pres_fac, float worst_neg_slack) {
     /* Reset results for each thread */
     for (auto& results : _results_th) {
         results = RouteIterResults();
     }
+    for (auto& level_stats : _level_stats_th) {
+        level_stats.clear();
+    }
 
     /* Set the routing parameters: they won't change until the next call and that saves us the trouble of passing them around */
     _itry = itry;
@@ -27,12 +37,32 @@ inline RouteIterResults ParallelNetlistRouter<HeapType>::route_netlist(int itry,
         PartitionTreeDebug::log("Iteration " + std::to_string(itry) + ": built partition tree in " + std::to_string(timer.elapsed_sec()) + " s");
     }
 
+    assign_numa_regions();
+    if (!_numa_regions.empty() && !_route_inf_pages_placed) {
+        place_route_inf_pages();
+        _route_inf_pages_placed = true;
+    }
+
     /* Put the root node on the task queue, which will add its child nodes when it's finished. Wait until the entire tree gets routed. */
     tbb::task_group group;
-    route_partition_tree_node(group, _tree->root());
+    route_partition_tree_node(group, _tree->root(), 0);
     group.wait();
+    /* The regions of the NUMA nodes are routed in their own arenas */
+    for (auto& numa : _numa_arenas) {
+        numa->arena.execute([&]() {
+            numa->group.wait();
+        });
+    }
     PartitionTreeDebug::log("Routing all nets took " + std::to_string(timer.elapsed_sec()) + " s");
 
+    if (_router_opts.router_deterministic_parallel) {
+        _deferred_invalidator.flush();
+    }
+
+    if (_route_verbosity > 1) {
+        report_level_stats(itry);
+    }
+
     /* Combine results from threads */
     RouteIterResults out;
     for (auto& results : _results_th) {
@@ -41,25 +71,32 @@ inline RouteIterResults ParallelNetlistRouter<HeapType>::route_netlist(int itry,
         out.bb_updated_nets.insert(out.bb_updated_nets.end(), results.bb_updated_nets.begin(), results.bb_updated_nets.end());
         out.is_routable &= results.is_routable;
     }
+
+    /* Per-thread results depend on which thread routed which net */
+    if (_router_opts.router_deterministic_parallel) {
+        std::sort(out.rerouted_nets.begin(), out.rerouted_nets.end());
+        std::sort(out.bb_updated_nets.begin(), out.bb_updated_nets.end());
+    }
     return out;
 }
 
 template<typename HeapType>
-void ParallelNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g, PartitionTreeNode& node) {
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
-
-    /* node.nets is an unordered set, copy into vector to sort */
-    std::vector<ParentNetId> nets(node.nets.begin(), node.nets.end());
+bool ParallelNetlistRouter<HeapType>::use_intra_net_router(ParentNetId net_id, size_t level) const {
+    if (!_intra_net_router || _rcv_enabled)
+        return false;
+    if (level == 0)
+        return true;
+    return level <= _intra_net_max_level
+           && is_high_fanout(_net_list.net_sinks(net_id).size(), _router_opts.high_fanout_threshold);
+}
 
-    /* Sort so net with most sinks is routed first. */
-    std::stable_sort(nets.begin(), nets.end(), [&](ParentNetId id1, ParentNetId id2) -> bool {
-        return _net_list.net_sinks(id1).size() > _net_list.net_sinks(id2).size();
-    });
+template<typename HeapType>
+bool ParallelNetlistRouter<HeapType>::route_net_in_node(ParentNetId net_id, size_t level, bool allow_intra_net) {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
 
-    vtr::Timer timer;
-    for (auto net_id : nets) {
-        auto flags = route_net(
-            _routers_th.local(),
+    auto route_with = [&](auto& router) {
+        return route_net(
+            router,
             _net_list,
             net_id,
             _itry,
@@ -77,21 +114,119 @@ void ParallelNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group&
             _choking_spots[net_id],
             _is_flat,
             route_ctx.route_bb[net_id]);
+    };
 
-        if (!flags.success && !flags.retry_with_full_bb) {
-            /* Disconnected RRG and SerialConnectionRouter doesn't think growing the BB will work */
-            _results_th.local().is_routable = false;
-            return;
+    NetResultFlags flags;
+    std::unique_lock<std::mutex> intra_net_lock;
+    if (allow_intra_net && use_intra_net_router(net_id, level)) {
+        /* Don't wait for the intra-net router: its threads are busy anyway */
+        intra_net_lock = std::unique_lock<std::mutex>(_intra_net_router_lock, std::try_to_lock);
+    }
+    if (intra_net_lock.owns_lock()) {
+        flags = route_with(*_intra_net_router);
+        intra_net_lock.unlock();
+    } else {
+        flags = route_with(_routers_th.local());
+    }
+
+    if (!flags.success && !flags.retry_with_full_bb) {
+        /* Disconnected RRG and SerialConnectionRouter doesn't think growing the BB will work */
+        _results_th.local().is_routable = false;
+        return false;
+    }
+    if (flags.retry_with_full_bb) {
+        /* SerialConnectionRouter thinks we should grow the BB. Do that and leave this net unrouted for now */
+        route_ctx.route_bb[net_id] = full_device_bb();
+        _results_th.local().bb_updated_nets.push_back(net_id);
+        return true;
+    }
+    if (flags.was_rerouted) {
+        _results_th.local().rerouted_nets.push_back(net_id);
+    }
+    return true;
+}
+
+/** Do two (inclusive) bounding boxes touch? Layers are ignored, like in \ref PartitionTree */
+inline bool bbs_overlap(const t_bb& a, const t_bb& b) {
+    return a.xmin <= b.xmax && b.xmin <= a.xmax && a.ymin <= b.ymax && b.ymin <= a.ymax;
+}
+
+template<typename HeapType>
+bool ParallelNetlistRouter<HeapType>::route_nets_batched(const std::vector<ParentNetId>& nets, size_t level) {
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    /* Greedy first-fit coloring in priority order: a net goes into the first batch which has
+     * no net overlapping it. This keeps the high-fanout nets in the early batches and is
+     * deterministic, since it only depends on the input order. Bounding boxes are copied here
+     * because routing a batch can grow them (see route_net_in_node) */
+    std::vector<std::vector<ParentNetId>> batches;
+    std::vector<std::vector<t_bb>> batch_bbs;
+    for (ParentNetId net_id : nets) {
+        const t_bb& bb = route_ctx.route_bb[net_id];
+        size_t batch = 0;
+        for (; batch < batches.size(); batch++) {
+            bool overlaps = std::any_of(batch_bbs[batch].begin(), batch_bbs[batch].end(), [&](const t_bb& other) {
+                return bbs_overlap(bb, other);
+            });
+            if (!overlaps)
+                break;
         }
-        if (flags.retry_with_full_bb) {
-            /* SerialConnectionRouter thinks we should grow the BB. Do that and leave this net unrouted for now */
-            route_ctx.route_bb[net_id] = full_device_bb();
-            _results_th.local().bb_updated_nets.push_back(net_id);
-            continue;
+        if (batch == batches.size()) {
+            batches.emplace_back();
+            batch_bbs.emplace_back();
         }
-        if (flags.was_rerouted) {
-            _results_th.local().rerouted_nets.push_back(net_id);
+        batches[batch].push_back(net_id);
+        batch_bbs[batch].push_back(bb);
+    }
+
+    PartitionTreeDebug::log("Split " + std::to_string(nets.size()) + " nets into " + std::to_string(batches.size()) + " batches");
+
+    /* Batches have to complete in order, since nets in different batches may share routing resources */
+    for (const auto& batch : batches) {
+        std::atomic<bool> is_routable = true;
+        tbb::parallel_for(size_t(0), batch.size(), [&](size_t i) {
+            vtr::Timer net_timer;
+            /* A batch of several nets already uses several threads */
+            if (!route_net_in_node(batch[i], level, batch.size() == 1))
+                is_routable = false;
+            log_level_stats(level, 0, 1, net_timer.elapsed_sec());
+        });
+        if (!is_routable)
+            return false;
+    }
+    return true;
+}
+
+template<typename HeapType>
+void ParallelNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g, PartitionTreeNode& node, size_t level) {
+    VTR_PROFILE_ZONE("Route partition");
+
+    /* node.nets is an unordered set, copy into vector to sort */
+    std::vector<ParentNetId> nets(node.nets.begin(), node.nets.end());
+
+    /* Sort so net with most sinks is routed first. The order of node.nets depends on the order in which
+     * nets were moved between nodes, so break ties by net ID in deterministic mode. */
+    const bool deterministic = _router_opts.router_deterministic_parallel;
+    std::stable_sort(nets.begin(), nets.end(), [&](ParentNetId id1, ParentNetId id2) -> bool {
+        size_t num_sinks1 = _net_list.net_sinks(id1).size();
+        size_t num_sinks2 = _net_list.net_sinks(id2).size();
+        if (num_sinks1 != num_sinks2)
+            return num_sinks1 > num_sinks2;
+        return deterministic && id1 < id2;
+    });
+
+    vtr::Timer timer;
+    if (_router_opts.router_partition_node_batching && nets.size() > 1) {
+        /* Per-net stats are logged by the workers picking up the nets */
+        log_level_stats(level, 1, 0, 0.0);
+        if (!route_nets_batched(nets, level))
+            return;
+    } else {
+        for (auto net_id : nets) {
+            if (!route_net_in_node(net_id, level, true))
+                return;
         }
+        log_level_stats(level, 1, nets.size(), timer.elapsed_sec());
     }
 
     PartitionTreeDebug::log("Node with " + std::to_string(node.nets.size())
@@ -101,17 +236,68 @@ void ParallelNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group&
 
     /* This node is finished: add left & right branches to the task queue */
     if (node.left && node.right) {
-        g.run([&]() {
-            route_partition_tree_node(g, *node.left);
-        });
-        g.run([&]() {
-            route_partition_tree_node(g, *node.right);
-        });
+        run_subtree(g, *node.left, level + 1);
+        run_subtree(g, *node.right, level + 1);
     } else {
         VTR_ASSERT(!node.left && !node.right); // there shouldn't be a node with a single branch
     }
 }
 
+template<typename HeapType>
+void ParallelNetlistRouter<HeapType>::run_subtree(tbb::task_group& g, PartitionTreeNode& node, size_t level) {
+    for (const auto& [region, inuma] : _numa_regions) {
+        if (region == &node) {
+            /* Enqueue rather than execute: an arena full of workers would block this thread */
+            NumaArena& numa = *_numa_arenas[inuma];
+            numa.arena.enqueue(numa.group.defer([&, level]() {
+                route_partition_tree_node(numa.group, node, level);
+            }));
+            return;
+        }
+    }
+
+    g.run([&, level]() {
+        route_partition_tree_node(g, node, level);
+    });
+}
+
+template<typename HeapType>
+void ParallelNetlistRouter<HeapType>::log_level_stats(size_t level, size_t num_nodes, size_t num_nets, float busy_sec) {
+    auto& level_stats = _level_stats_th.local();
+    if (level_stats.size() <= level)
+        level_stats.resize(level + 1);
+    level_stats[level].nodes_routed += num_nodes;
+    level_stats[level].nets_routed += num_nets;
+    level_stats[level].busy_sec += busy_sec;
+}
+
+template<typename HeapType>
+void ParallelNetlistRouter<HeapType>::report_level_stats(int itry) {
+    size_t num_levels = 0;
+    for (const auto& level_stats : _level_stats_th)
+        num_levels = std::max(num_levels, level_stats.size());
+
+    VTR_LOG("Partition tree utilization for iteration %d:\n", itry);
+    VTR_LOG("  %5s %7s %9s %8s %11s %11s\n", "Level", "Nodes", "Nets", "Threads", "Busy (s)", "Max thr (s)");
+    for (size_t level = 0; level < num_levels; level++) {
+        PartitionTreeLevelStats total;
+        size_t num_threads = 0;
+        float max_thread_sec = 0.0;
+        for (const auto& level_stats : _level_stats_th) {
+            if (level >= level_stats.size())
+                continue;
+            const PartitionTreeLevelStats& stats = level_stats[level];
+            if (stats.nets_routed > 0)
+                num_threads++;
+            total.nodes_routed += stats.nodes_routed;
+            total.nets_routed += stats.nets_routed;
+            total.busy_sec += stats.busy_sec;
+            max_thread_sec = std::max(max_thread_sec, stats.busy_sec);
+        }
+        VTR_LOG("  %5zu %7zu %9zu %8zu %11.3f %11.3f\n", level, total.nodes_routed, total.nets_routed, num_threads, total.busy_sec, max_thread_sec);
+    }
+}
+
 template<typename HeapType>
 void ParallelNetlistRouter<HeapType>::handle_bb_updated_nets(const std::vector<ParentNetId>& nets) {
     VTR_ASSERT(_tree);
@@ -123,6 +309,144 @@ void ParallelNetlistRouter<HeapType>::set_rcv_enabled(bool x) {
     for (auto& router : _routers_th) {
         router.set_rcv_enabled(x);
     }
+    _rcv_enabled = x;
+}
+
+template<typename HeapType>
+void ParallelNetlistRouter<HeapType>::_make_intra_net_router(const RouterLookahead* router_lookahead, bool is_flat) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    _intra_net_router = std::make_unique<ParallelConnectionRouter<HeapType>>(
+        device_ctx.grid,
+        *router_lookahead,
+        device_ctx.rr_graph.rr_nodes(),
+        &device_ctx.rr_graph,
+        device_ctx.rr_rc_data,
+        device_ctx.rr_graph.rr_switch(),
+        route_ctx.rr_node_route_inf,
+        is_flat,
+        _route_verbosity,
+        _router_opts.multi_queue_num_threads,
+        _router_opts.multi_queue_num_queues,
+        _router_opts.multi_queue_direct_draining,
+        _router_opts.multi_queue_stickiness,
+        _router_opts.multi_queue_pop_batch_size);
+
+    /* Level L of the tree has up to 2^L nodes routed at once: only let its nets use the
+     * intra-net router if that many nets could each get its threads */
+    size_t num_workers = tbb::this_task_arena::max_concurrency();
+    size_t num_intra_net_threads = _router_opts.multi_queue_num_threads;
+    if (num_intra_net_threads > num_workers) {
+        VTR_LOG_WARN("--multi_queue_num_threads (%zu) is larger than the number of workers (%zu): the root nets will oversubscribe the CPU\n",
+                     num_intra_net_threads, num_workers);
+    }
+    _intra_net_max_level = 0;
+    while ((size_t(2) << _intra_net_max_level) * num_intra_net_threads <= num_workers)
+        _intra_net_max_level++;
+
+    VTR_LOG("Hybrid parallel routing: root nets, and nets with at least %d sinks up to partition tree level %zu, use %zu threads each\n",
+            _router_opts.high_fanout_threshold, _intra_net_max_level, num_intra_net_threads);
+}
+
+template<typename HeapType>
+void ParallelNetlistRouter<HeapType>::_make_numa_arenas() {
+    size_t num_numa_nodes = vtr::numa::num_nodes();
+    if (num_numa_nodes < 2)
+        return;
+
+    /* The per-node arenas share the workers of the default arena (tbb::global_control still caps the total) */
+    int num_workers = tbb::this_task_arena::max_concurrency();
+    int workers_per_node = std::max(1, num_workers / int(num_numa_nodes));
+    for (size_t inuma = 0; inuma < num_numa_nodes; inuma++) {
+        _numa_arenas.push_back(std::make_unique<NumaArena>(workers_per_node, inuma));
+    }
+
+    VTR_LOG("NUMA-aware parallel routing: %zu NUMA nodes with %d workers each\n", num_numa_nodes, workers_per_node);
+}
+
+template<typename HeapType>
+void ParallelNetlistRouter<HeapType>::assign_numa_regions() {
+    _numa_regions.clear();
+    if (_numa_arenas.empty())
+        return;
+
+    size_t num_numa_nodes = _numa_arenas.size();
+    size_t depth = 0;
+    while ((size_t(1) << depth) < num_numa_nodes)
+        depth++;
+
+    /* Walk down to that depth, keeping each subtree's position in a complete tree to spread them evenly.
+     * Leaves above it are routed in the default arena */
+    std::vector<std::pair<const PartitionTreeNode*, size_t>> level_nodes = {{&_tree->root(), 0}};
+    for (size_t level = 0; level < depth; level++) {
+        std::vector<std::pair<const PartitionTreeNode*, size_t>> next_nodes;
+        for (const auto& [node, position] : level_nodes) {
+            if (node->left && node->right) {
+                next_nodes.emplace_back(node->left.get(), 2 * position);
+                next_nodes.emplace_back(node->right.get(), 2 * position + 1);
+            }
+        }
+        level_nodes = std::move(next_nodes);
+    }
+
+    for (const auto& [node, position] : level_nodes) {
+        _numa_regions.emplace_back(node, position * num_numa_nodes / (size_t(1) << depth));
+    }
+}
+
+template<typename HeapType>
+void ParallelNetlistRouter<HeapType>::place_route_inf_pages() {
+    auto& route_inf = g_vpr_ctx.mutable_routing().rr_node_route_inf;
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    if (route_inf.empty())
+        return;
+
+    /* Count the RR nodes of each page in each NUMA node's regions */
+    size_t num_numa_nodes = _numa_arenas.size();
+    size_t page = vtr::numa::page_size();
+    uintptr_t first_page = reinterpret_cast<uintptr_t>(route_inf.data()) / page * page;
+    size_t num_pages = (reinterpret_cast<uintptr_t>(route_inf.data() + route_inf.size()) - first_page + page - 1) / page;
+    std::vector<uint32_t> page_counts(num_pages * num_numa_nodes, 0);
+    for (RRNodeId inode : rr_graph.nodes()) {
+        size_t ipage = (reinterpret_cast<uintptr_t>(&route_inf[inode]) - first_page) / page;
+        for (const auto& [region, inuma] : _numa_regions) {
+            if (inside_bb(inode, region->bb)) {
+                page_counts[ipage * num_numa_nodes + inuma]++;
+                break;
+            }
+        }
+    }
+
+    /* Bind the runs of pages with the same majority node */
+    uintptr_t data_begin = reinterpret_cast<uintptr_t>(route_inf.data());
+    uintptr_t data_end = reinterpret_cast<uintptr_t>(route_inf.data() + route_inf.size());
+    size_t num_failed = 0;
+    size_t run_begin = 0;
+    size_t run_node = num_numa_nodes;
+    for (size_t ipage = 0; ipage <= num_pages; ipage++) {
+        size_t page_node = num_numa_nodes;
+        if (ipage < num_pages) {
+            const uint32_t* counts = &page_counts[ipage * num_numa_nodes];
+            size_t max_node = std::max_element(counts, counts + num_numa_nodes) - counts;
+            page_node = counts[max_node] > 0 ? max_node : num_numa_nodes;
+        }
+        if (page_node == run_node)
+            continue;
+
+        if (run_node < num_numa_nodes) {
+            uintptr_t begin = std::max(first_page + run_begin * page, data_begin);
+            uintptr_t end = std::min(first_page + ipage * page, data_end);
+            if (!vtr::numa::bind_memory(reinterpret_cast<void*>(begin), end - begin, run_node))
+                num_failed++;
+        }
+        run_begin = ipage;
+        run_node = page_node;
+    }
+
+    if (num_failed > 0) {
+        VTR_LOG_WARN("Failed to move %zu ranges of the routing state to their NUMA node\n", num_failed);
+    }
 }
 
 template<typename HeapType>
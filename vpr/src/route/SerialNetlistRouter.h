@@ -53,7 +53,7 @@ class SerialNetlistRouter : public NetlistRouter {
 
         if (!router_opts.enable_parallel_connection_router) {
             // Serial Connection Router
-            return std::make_unique<SerialConnectionRouter<HeapType>>(
+            auto router = std::make_unique<SerialConnectionRouter<HeapType>>(
                 device_ctx.grid,
                 *router_lookahead,
                 device_ctx.rr_graph.rr_nodes(),
@@ -63,6 +63,8 @@ class SerialNetlistRouter : public NetlistRouter {
                 route_ctx.rr_node_route_inf,
                 is_flat,
                 route_verbosity);
+            router->set_lookahead_cache_size(router_opts.lookahead_cache_entries);
+            return router;
         } else {
             // Parallel Connection Router
             return std::make_unique<ParallelConnectionRouter<HeapType>>(
@@ -77,7 +79,9 @@ class SerialNetlistRouter : public NetlistRouter {
                 route_verbosity,
                 router_opts.multi_queue_num_threads,
                 router_opts.multi_queue_num_queues,
-                router_opts.multi_queue_direct_draining);
+                router_opts.multi_queue_direct_draining,
+                router_opts.multi_queue_stickiness,
+                router_opts.multi_queue_pop_batch_size);
         }
     }
     /* Context fields */
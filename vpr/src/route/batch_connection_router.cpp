@@ -0,0 +1,99 @@
+#include "batch_connection_router.h"
+
+#include "globals.h"
+#include "route_common.h"
+
+void BatchConnectionRouter::set_net_paths(const BatchNet* net, const BatchNetPaths* paths) {
+    _net = net;
+    _paths = paths;
+    _sink_index.clear();
+    if (_net) {
+        for (size_t isink = 0; isink < _net->sinks.size(); isink++) {
+            _sink_index.emplace(RRNodeId(_net->sinks[isink]), isink);
+        }
+    }
+}
+
+std::tuple<bool, bool, RTExploredNode> BatchConnectionRouter::timing_driven_route_connection_from_route_tree(
+    const RouteTreeNode& rt_root,
+    RRNodeId sink_node,
+    const t_conn_cost_params& cost_params,
+    const t_bb& bounding_box,
+    RouterStats& router_stats,
+    const ConnectionParameters& conn_params) {
+    auto [installed, cheapest] = try_planned_path(sink_node, cost_params, conn_params);
+    if (installed) {
+        return {true, false, cheapest};
+    }
+    return _router->timing_driven_route_connection_from_route_tree(rt_root, sink_node, cost_params, bounding_box, router_stats, conn_params);
+}
+
+std::tuple<bool, bool, RTExploredNode> BatchConnectionRouter::timing_driven_route_connection_from_route_tree_high_fanout(
+    const RouteTreeNode& rt_root,
+    RRNodeId sink_node,
+    const t_conn_cost_params& cost_params,
+    const t_bb& bounding_box,
+    const SpatialRouteTreeLookup& spatial_rt_lookup,
+    RouterStats& router_stats,
+    const ConnectionParameters& conn_params) {
+    auto [installed, cheapest] = try_planned_path(sink_node, cost_params, conn_params);
+    if (installed) {
+        return {true, false, cheapest};
+    }
+    return _router->timing_driven_route_connection_from_route_tree_high_fanout(rt_root, sink_node, cost_params, bounding_box, spatial_rt_lookup, router_stats, conn_params);
+}
+
+std::pair<bool, RTExploredNode> BatchConnectionRouter::try_planned_path(RRNodeId sink_node,
+                                                                        const t_conn_cost_params& cost_params,
+                                                                        const ConnectionParameters& conn_params) {
+    if (!_net) {
+        return {false, RTExploredNode()};
+    }
+    // RCV needs the delays of the path search
+    if (_rcv_enabled || cost_params.delay_budget || cost_params.criticality > _max_criticality) {
+        _num_fallback_connections++;
+        return {false, RTExploredNode()};
+    }
+    auto it = _sink_index.find(sink_node);
+    if (it == _sink_index.end() || (*_paths)[it->second].empty()) {
+        _num_fallback_connections++;
+        return {false, RTExploredNode()};
+    }
+
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    const RouteTree& tree = route_ctx.route_trees[conn_params.net_id_].value();
+    const std::vector<int>& path = (*_paths)[it->second];
+
+    // The path joins the route tree at the last of its nodes in the tree (at least the source).
+    // The nodes after it are new: each must have room for the net.
+    int ijoin = path.size() - 1;
+    for (; ijoin >= 0; ijoin--) {
+        RRNodeId node = rr_graph.edge_sink_node(RREdgeId(path[ijoin]));
+        if (tree.find_by_rr_id(node)) {
+            break;
+        }
+        if (route_ctx.rr_node_route_inf[node].occ() >= rr_graph.node_capacity(node)) {
+            _num_fallback_connections++;
+            return {false, RTExploredNode()};
+        }
+    }
+    RRNodeId join_node = ijoin >= 0 ? rr_graph.edge_sink_node(RREdgeId(path[ijoin])) : rr_graph.edge_src_node(RREdgeId(path[0]));
+    auto join_rt_node = tree.find_by_rr_id(join_node);
+    if (!join_rt_node || !join_rt_node->re_expand || ijoin == int(path.size()) - 1) {
+        // The connection router wouldn't branch off this node (e.g. an IPIN or SINK)
+        _num_fallback_connections++;
+        return {false, RTExploredNode()};
+    }
+
+    for (size_t i = ijoin + 1; i < path.size(); i++) {
+        RREdgeId edge(path[i]);
+        route_ctx.rr_node_route_inf[rr_graph.edge_sink_node(edge)].prev_edge = edge;
+    }
+    _num_batch_connections++;
+
+    RTExploredNode cheapest;
+    cheapest.index = sink_node;
+    cheapest.prev_edge = RREdgeId(path.back());
+    return {true, cheapest};
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+/** @file A ConnectionRouterInterface which routes connections along paths planned in advance
+ * (see batch_path_search.h), and falls back to a CPU connection router for the others.
+ *
+ * A planned path is only used for a connection which isn't critical (criticality no higher than
+ * the limit, and no delay budget), and if it doesn't conflict with the routing so far: the nodes
+ * it adds to the route tree must not be in use up to their capacity. The path is installed where
+ * the connection router would leave it, i.e. in the prev_edge of the nodes of rr_node_route_inf,
+ * so that route_sink() adds it to the route tree as if it had been searched. */
+
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "batch_path_search.h"
+#include "connection_router_interface.h"
+#include "route_tree.h"
+
+class BatchConnectionRouter : public ConnectionRouterInterface {
+  public:
+    /**
+     *  @param router           The connection router of the connections without a usable path.
+     *  @param max_criticality  The highest criticality of a connection routed along its path.
+     */
+    BatchConnectionRouter(std::unique_ptr<ConnectionRouterInterface> router, float max_criticality)
+        : _router(std::move(router))
+        , _max_criticality(max_criticality) {}
+
+    /** Set the paths planned for the sinks of the next net to route (\p net and \p paths must outlive
+     * their use), or none (nullptr) to route it with the connection router only. */
+    void set_net_paths(const BatchNet* net, const BatchNetPaths* paths);
+
+    /** Number of connections routed along their planned path since the last reset_stats() */
+    size_t num_batch_connections() const { return _num_batch_connections; }
+    /** Number of connections with a planned path routed by the connection router since the last reset_stats() */
+    size_t num_fallback_connections() const { return _num_fallback_connections; }
+    void reset_stats() {
+        _num_batch_connections = 0;
+        _num_fallback_connections = 0;
+    }
+
+    void clear_modified_rr_node_info() final {
+        _router->clear_modified_rr_node_info();
+    }
+
+    void reset_path_costs() final {
+        _router->reset_path_costs();
+    }
+
+    std::tuple<bool, bool, RTExploredNode> timing_driven_route_connection_from_route_tree(
+        const RouteTreeNode& rt_root,
+        RRNodeId sink_node,
+        const t_conn_cost_params& cost_params,
+        const t_bb& bounding_box,
+        RouterStats& router_stats,
+        const ConnectionParameters& conn_params) final;
+
+    std::tuple<bool, bool, RTExploredNode> timing_driven_route_connection_from_route_tree_high_fanout(
+        const RouteTreeNode& rt_root,
+        RRNodeId sink_node,
+        const t_conn_cost_params& cost_params,
+        const t_bb& bounding_box,
+        const SpatialRouteTreeLookup& spatial_rt_lookup,
+        RouterStats& router_stats,
+        const ConnectionParameters& conn_params) final;
+
+    vtr::vector<RRNodeId, RTExploredNode> timing_driven_find_all_shortest_paths_from_route_tree(
+        const RouteTreeNode& rt_root,
+        const t_conn_cost_params& cost_params,
+        const t_bb& bounding_box,
+        RouterStats& router_stats,
+        const ConnectionParameters& conn_params) final {
+        return _router->timing_driven_find_all_shortest_paths_from_route_tree(rt_root, cost_params, bounding_box, router_stats, conn_params);
+    }
+
+    void set_router_debug(bool router_debug) final {
+        _router->set_router_debug(router_debug);
+    }
+
+    void empty_rcv_route_tree_set() final {
+        _router->empty_rcv_route_tree_set();
+    }
+
+    void set_rcv_enabled(bool enable) final {
+        _rcv_enabled = enable;
+        _router->set_rcv_enabled(enable);
+    }
+
+  private:
+    /** Install the planned path of the connection to \p sink_node if it can be used.
+     * \return Whether the path was installed, and the explored sink node to build the route tree from. */
+    std::pair<bool, RTExploredNode> try_planned_path(RRNodeId sink_node,
+                                                     const t_conn_cost_params& cost_params,
+                                                     const ConnectionParameters& conn_params);
+
+    std::unique_ptr<ConnectionRouterInterface> _router;
+    float _max_criticality;
+    bool _rcv_enabled = false;
+
+    const BatchNet* _net = nullptr;
+    const BatchNetPaths* _paths = nullptr;
+    /** Index in _net->sinks of each sink node */
+    std::unordered_map<RRNodeId, size_t> _sink_index;
+
+    size_t _num_batch_connections = 0;
+    size_t _num_fallback_connections = 0;
+};
@@ -0,0 +1,166 @@
+#include "batch_path_search.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "rr_graph_view.h"
+#include "vtr_assert.h"
+
+#if defined(VPR_USE_TBB)
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
+BatchRRGraph build_batch_rr_graph(const RRGraphView& rr_graph) {
+    BatchRRGraph graph;
+    const size_t num_nodes = rr_graph.num_nodes();
+
+    graph.edge_offsets.resize(num_nodes + 1, 0);
+    graph.node_x.resize(num_nodes);
+    graph.node_y.resize(num_nodes);
+    graph.node_layer.resize(num_nodes);
+    for (size_t i = 0; i < num_nodes; i++) {
+        RRNodeId node(i);
+        graph.edge_offsets[i] = size_t(rr_graph.node_first_edge(node));
+        graph.edge_offsets[i + 1] = size_t(rr_graph.node_last_edge(node));
+
+        if (rr_graph.node_direction(node) == Direction::DEC) {
+            graph.node_x[i] = rr_graph.node_xhigh(node);
+            graph.node_y[i] = rr_graph.node_yhigh(node);
+            graph.node_layer[i] = rr_graph.node_layer_high(node);
+        } else {
+            graph.node_x[i] = rr_graph.node_xlow(node);
+            graph.node_y[i] = rr_graph.node_ylow(node);
+            graph.node_layer[i] = rr_graph.node_layer_low(node);
+        }
+    }
+
+    const size_t num_edges = num_nodes > 0 ? graph.edge_offsets[num_nodes] : 0;
+    graph.edge_srcs.resize(num_edges);
+    graph.edge_sinks.resize(num_edges);
+    for (size_t i = 0; i < num_nodes; i++) {
+        for (int e = graph.edge_offsets[i]; e < graph.edge_offsets[i + 1]; e++) {
+            graph.edge_srcs[e] = i;
+            graph.edge_sinks[e] = size_t(rr_graph.edge_sink_node(RREdgeId(e)));
+        }
+    }
+
+    return graph;
+}
+
+namespace {
+
+/** Per-thread search arrays, kept across nets: only the entries a search touched are reset */
+struct SearchScratch {
+    std::vector<float> dist;
+    std::vector<int> pred_edge;
+    std::vector<int> num_unreached_sinks; ///<Number of pins of the net on each node (a sink may be used by several)
+    std::vector<int> touched;
+};
+
+inline bool inside_net_bb(const BatchRRGraph& graph, const BatchNet& net, int node) {
+    int x = graph.node_x[node], y = graph.node_y[node], layer = graph.node_layer[node];
+    return x >= net.xmin && x <= net.xmax && y >= net.ymin && y <= net.ymax && layer >= net.layer_min && layer <= net.layer_max;
+}
+
+/** Dijkstra's algorithm from the source of the net, until all its sinks are reached */
+BatchNetPaths search_net(const BatchRRGraph& graph,
+                         const std::vector<float>& node_costs,
+                         const BatchNet& net,
+                         SearchScratch& scratch) {
+    constexpr float INF = std::numeric_limits<float>::infinity();
+    if (scratch.dist.empty()) {
+        scratch.dist.assign(graph.num_nodes(), INF);
+        scratch.pred_edge.assign(graph.num_nodes(), -1);
+        scratch.num_unreached_sinks.assign(graph.num_nodes(), 0);
+    }
+
+    size_t num_unreached = net.sinks.size();
+    for (int sink : net.sinks) {
+        scratch.num_unreached_sinks[sink]++;
+    }
+
+    typedef std::pair<float, int> t_entry;
+    std::priority_queue<t_entry, std::vector<t_entry>, std::greater<t_entry>> heap;
+    scratch.dist[net.source] = 0.;
+    scratch.touched.push_back(net.source);
+    heap.emplace(0., net.source);
+    while (!heap.empty() && num_unreached > 0) {
+        auto [dist, node] = heap.top();
+        heap.pop();
+        if (dist > scratch.dist[node]) {
+            continue; // Stale entry
+        }
+
+        num_unreached -= scratch.num_unreached_sinks[node];
+        scratch.num_unreached_sinks[node] = 0;
+
+        for (int e = graph.edge_offsets[node]; e < graph.edge_offsets[node + 1]; e++) {
+            int to_node = graph.edge_sinks[e];
+            if (!inside_net_bb(graph, net, to_node)) {
+                continue;
+            }
+            float to_dist = dist + node_costs[to_node];
+            if (to_dist < scratch.dist[to_node]) {
+                if (scratch.dist[to_node] == INF) {
+                    scratch.touched.push_back(to_node);
+                }
+                scratch.dist[to_node] = to_dist;
+                scratch.pred_edge[to_node] = e;
+                heap.emplace(to_dist, to_node);
+            }
+        }
+    }
+
+    BatchNetPaths paths(net.sinks.size());
+    for (size_t isink = 0; isink < net.sinks.size(); isink++) {
+        int node = net.sinks[isink];
+        if (scratch.dist[node] == INF) {
+            continue;
+        }
+        std::vector<int>& path = paths[isink];
+        while (node != net.source) {
+            int e = scratch.pred_edge[node];
+            VTR_ASSERT_SAFE(e >= 0);
+            path.push_back(e);
+            node = graph.edge_srcs[e];
+        }
+        std::reverse(path.begin(), path.end());
+    }
+
+    for (int node : scratch.touched) {
+        scratch.dist[node] = INF;
+        scratch.pred_edge[node] = -1;
+    }
+    scratch.touched.clear();
+    for (int sink : net.sinks) {
+        scratch.num_unreached_sinks[sink] = 0;
+    }
+
+    return paths;
+}
+
+} // namespace
+
+std::vector<BatchNetPaths> find_batch_paths(const BatchRRGraph& graph,
+                                            const std::vector<float>& node_costs,
+                                            const std::vector<BatchNet>& nets) {
+    VTR_ASSERT(node_costs.size() == graph.num_nodes());
+
+    std::vector<BatchNetPaths> paths(nets.size());
+#if defined(VPR_USE_TBB)
+    tbb::enumerable_thread_specific<SearchScratch> thread_scratch;
+    tbb::parallel_for(size_t(0), nets.size(), [&](size_t inet) {
+        paths[inet] = search_net(graph, node_costs, nets[inet], thread_scratch.local());
+    });
+#else
+    SearchScratch scratch;
+    for (size_t inet = 0; inet < nets.size(); inet++) {
+        paths[inet] = search_net(graph, node_costs, nets[inet], scratch);
+    }
+#endif
+
+    return paths;
+}
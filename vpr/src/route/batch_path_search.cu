@@ -0,0 +1,433 @@
+/**
+ * @file
+ * @brief   CUDA implementation of the batch path search (see batch_path_search.h).
+ *
+ * 64-bit atomicMin requires a device of compute capability 3.5 or newer.
+ */
+
+#include "batch_path_search.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <cuda_runtime.h>
+#include "vpr_error.h"
+#include "vtr_assert.h"
+
+namespace {
+
+/// @brief The number of threads of each block of the kernels.
+constexpr int THREADS_PER_BLOCK = 256;
+
+/// @brief The packed state of a node not reached yet (larger than any reached state).
+constexpr unsigned long long UNREACHED = ~0ull;
+
+/// @brief The predecessor edge of the source of a net.
+constexpr unsigned NO_EDGE = ~0u;
+
+/// @brief delta of the delta-stepping, in multiples of the average node cost.
+constexpr float DELTA_NODE_COSTS = 8.f;
+
+/**
+ * @brief Errors out if the given CUDA call failed.
+ */
+void check_cuda(cudaError_t status, const char* what) {
+    if (status != cudaSuccess) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "CUDA error in %s: %s\n",
+                        what, cudaGetErrorString(status));
+    }
+}
+
+unsigned num_blocks_for(size_t num_threads) {
+    return static_cast<unsigned>((num_threads + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK);
+}
+
+/**
+ * @brief An array in device memory.
+ */
+template<typename T>
+class DeviceArray {
+  public:
+    DeviceArray() = default;
+
+    explicit DeviceArray(size_t size)
+        : size_(size) {
+        if (size_ > 0)
+            check_cuda(cudaMalloc(&ptr_, size_ * sizeof(T)), "cudaMalloc");
+    }
+
+    explicit DeviceArray(const std::vector<T>& host)
+        : DeviceArray(host.size()) {
+        upload(host.data());
+    }
+
+    ~DeviceArray() {
+        if (ptr_)
+            cudaFree(ptr_);
+    }
+
+    DeviceArray(const DeviceArray&) = delete;
+    DeviceArray& operator=(const DeviceArray&) = delete;
+
+    void upload(const T* host) {
+        if (size_ > 0)
+            check_cuda(cudaMemcpy(ptr_, host, size_ * sizeof(T), cudaMemcpyHostToDevice), "cudaMemcpy (to device)");
+    }
+
+    void download(T* host) const {
+        if (size_ > 0)
+            check_cuda(cudaMemcpy(host, ptr_, size_ * sizeof(T), cudaMemcpyDeviceToHost), "cudaMemcpy (to host)");
+    }
+
+    /** Sets the bytes of the first num_elements elements to value */
+    void fill_bytes(int value, size_t num_elements) {
+        if (num_elements > 0)
+            check_cuda(cudaMemset(ptr_, value, num_elements * sizeof(T)), "cudaMemset");
+    }
+
+    T* get() { return ptr_; }
+    const T* get() const { return ptr_; }
+    size_t size() const { return size_; }
+
+  private:
+    T* ptr_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Packs a (non-negative) distance and a predecessor edge: the packed states of a node
+ *        compare as their distances (the bits of non-negative floats compare as the floats).
+ */
+__device__ inline unsigned long long pack_state(float dist, unsigned edge) {
+    return (static_cast<unsigned long long>(__float_as_uint(dist)) << 32) | edge;
+}
+
+__device__ inline float state_dist(unsigned long long state) {
+    return __uint_as_float(static_cast<unsigned>(state >> 32));
+}
+
+__device__ inline unsigned state_edge(unsigned long long state) {
+    return static_cast<unsigned>(state & 0xffffffffull);
+}
+
+/**
+ * @brief Starts the search of each net (one thread per net) from its source.
+ */
+__global__ void start_kernel(int num_nets,
+                             size_t num_nodes,
+                             const int* net_sources,
+                             float delta,
+                             unsigned long long* state,
+                             unsigned char* active,
+                             float* thresholds,
+                             unsigned char* done) {
+    int net = blockIdx.x * blockDim.x + threadIdx.x;
+    if (net >= num_nets)
+        return;
+
+    size_t i = net * num_nodes + net_sources[net];
+    state[i] = pack_state(0.f, NO_EDGE);
+    active[i] = 1;
+    thresholds[net] = delta;
+    done[net] = 0;
+}
+
+/**
+ * @brief Relaxes the out edges of the active nodes closer than the threshold of
+ *        their net (one thread per node of each net), inside the bounding box of the net.
+ *
+ * Sets *changed if any node got closer.
+ */
+__global__ void relax_kernel(size_t num_items,
+                             size_t num_nodes,
+                             const int* edge_offsets,
+                             const int* edge_sinks,
+                             const int16_t* node_x,
+                             const int16_t* node_y,
+                             const int16_t* node_layer,
+                             const float* node_costs,
+                             const int* net_bbs,
+                             const float* thresholds,
+                             const unsigned char* done,
+                             unsigned long long* state,
+                             unsigned char* active,
+                             int* changed) {
+    size_t i = blockIdx.x * static_cast<size_t>(blockDim.x) + threadIdx.x;
+    if (i >= num_items || !active[i])
+        return;
+    int net = static_cast<int>(i / num_nodes);
+    if (done[net] || !(state_dist(state[i]) < thresholds[net]))
+        return; // Far node, left for a later threshold
+
+    // Clear the flag before reading the distance: a concurrent improvement sets it again
+    active[i] = 0;
+    __threadfence();
+    float dist = state_dist(*(volatile unsigned long long*)&state[i]);
+
+    int node = static_cast<int>(i - net * num_nodes);
+    const int* bb = net_bbs + 6 * net;
+    for (int e = edge_offsets[node]; e < edge_offsets[node + 1]; e++) {
+        int to_node = edge_sinks[e];
+        int x = node_x[to_node], y = node_y[to_node], layer = node_layer[to_node];
+        if (x < bb[0] || x > bb[1] || y < bb[2] || y > bb[3] || layer < bb[4] || layer > bb[5])
+            continue;
+
+        unsigned long long to_state = pack_state(dist + node_costs[to_node], e);
+        size_t j = net * num_nodes + to_node;
+        if (to_state < atomicMin(&state[j], to_state)) {
+            active[j] = 1;
+            *changed = 1;
+        }
+    }
+}
+
+/**
+ * @brief Finds the closest far node of each net (one thread per node of each net).
+ *
+ * min_far_dists holds the bits of the distances, which compare as the distances.
+ */
+__global__ void min_far_kernel(size_t num_items,
+                               size_t num_nodes,
+                               const unsigned char* done,
+                               const unsigned long long* state,
+                               const unsigned char* active,
+                               unsigned* min_far_dists) {
+    size_t i = blockIdx.x * static_cast<size_t>(blockDim.x) + threadIdx.x;
+    if (i >= num_items || !active[i])
+        return;
+    int net = static_cast<int>(i / num_nodes);
+    if (!done[net])
+        atomicMin(&min_far_dists[net], static_cast<unsigned>(state[i] >> 32));
+}
+
+/**
+ * @brief Once no node is closer than the threshold of its net: marks the nets whose
+ *        sinks are all final (or which have no node left to expand) as done, and moves
+ *        the threshold of the others past their closest far node (one thread per net).
+ *
+ * Sets *num_left to the number of nets not done.
+ */
+__global__ void advance_kernel(int num_nets,
+                               size_t num_nodes,
+                               const int* net_sink_offsets,
+                               const int* sink_nodes,
+                               const unsigned* min_far_dists,
+                               float delta,
+                               const unsigned long long* state,
+                               float* thresholds,
+                               unsigned char* done,
+                               int* num_left) {
+    int net = blockIdx.x * blockDim.x + threadIdx.x;
+    if (net >= num_nets || done[net])
+        return;
+
+    bool sinks_final = true;
+    for (int isink = net_sink_offsets[net]; isink < net_sink_offsets[net + 1]; isink++) {
+        unsigned long long sink_state = state[net * num_nodes + sink_nodes[isink]];
+        if (sink_state == UNREACHED || !(state_dist(sink_state) < thresholds[net])) {
+            sinks_final = false;
+            break;
+        }
+    }
+
+    if (sinks_final || min_far_dists[net] == ~0u) {
+        done[net] = 1;
+    } else {
+        thresholds[net] = __uint_as_float(min_far_dists[net]) + delta;
+        atomicAdd(num_left, 1);
+    }
+}
+
+/**
+ * @brief Traces the path of each sink back to the source of its net (one thread per sink).
+ *
+ * The edges are written from the sink back, and the length is -1 if the sink wasn't
+ * reached or the path has more than max_edges edges.
+ */
+__global__ void trace_kernel(int num_sinks,
+                             size_t num_nodes,
+                             const int* sink_nets,
+                             const int* sink_nodes,
+                             const int* net_sources,
+                             const int* edge_srcs,
+                             const unsigned long long* state,
+                             int max_edges,
+                             int* path_edges,
+                             int* path_lengths) {
+    int isink = blockIdx.x * blockDim.x + threadIdx.x;
+    if (isink >= num_sinks)
+        return;
+
+    int net = sink_nets[isink];
+    int node = sink_nodes[isink];
+    int length = 0;
+    while (node != net_sources[net]) {
+        unsigned long long node_state = state[net * num_nodes + node];
+        if (node_state == UNREACHED || state_edge(node_state) == NO_EDGE || length == max_edges) {
+            length = -1;
+            break;
+        }
+        int e = static_cast<int>(state_edge(node_state));
+        path_edges[static_cast<size_t>(isink) * max_edges + length] = e;
+        length++;
+        node = edge_srcs[e];
+    }
+    path_lengths[isink] = length;
+}
+
+} // namespace
+
+struct GpuBatchPathSearch::DeviceData {
+    size_t num_nodes;
+    /// Number of nets whose search arrays fit in the memory budget
+    size_t max_batch_nets;
+
+    DeviceArray<int> edge_offsets;
+    DeviceArray<int> edge_srcs;
+    DeviceArray<int> edge_sinks;
+    DeviceArray<int16_t> node_x;
+    DeviceArray<int16_t> node_y;
+    DeviceArray<int16_t> node_layer;
+    DeviceArray<float> node_costs;
+
+    /// [0..max_batch_nets-1][0..num_nodes-1] packed distance and predecessor edge
+    DeviceArray<unsigned long long> state;
+    /// [0..max_batch_nets-1][0..num_nodes-1] nodes whose edges are to be relaxed
+    DeviceArray<unsigned char> active;
+
+    DeviceData(const BatchRRGraph& graph, size_t memory_budget)
+        : num_nodes(graph.num_nodes())
+        , max_batch_nets(std::max<size_t>(1, memory_budget / std::max<size_t>(1, graph.num_nodes() * (sizeof(unsigned long long) + 1))))
+        , edge_offsets(graph.edge_offsets)
+        , edge_srcs(graph.edge_srcs)
+        , edge_sinks(graph.edge_sinks)
+        , node_x(graph.node_x)
+        , node_y(graph.node_y)
+        , node_layer(graph.node_layer)
+        , node_costs(graph.num_nodes())
+        , state(max_batch_nets * graph.num_nodes())
+        , active(max_batch_nets * graph.num_nodes()) {}
+};
+
+GpuBatchPathSearch::GpuBatchPathSearch(const BatchRRGraph& graph, size_t memory_budget)
+    : data_(std::make_unique<DeviceData>(graph, memory_budget)) {}
+
+GpuBatchPathSearch::~GpuBatchPathSearch() = default;
+
+std::vector<BatchNetPaths> GpuBatchPathSearch::find_paths(const std::vector<float>& node_costs,
+                                                          const std::vector<BatchNet>& nets) {
+    DeviceData& d = *data_;
+    VTR_ASSERT(node_costs.size() == d.num_nodes);
+    d.node_costs.upload(node_costs.data());
+
+    double total_cost = 0.;
+    for (float cost : node_costs)
+        total_cost += cost;
+    float delta = DELTA_NODE_COSTS * static_cast<float>(total_cost / std::max<size_t>(1, node_costs.size()));
+    if (!(delta > 0.f))
+        delta = 1.f;
+
+    std::vector<BatchNetPaths> paths(nets.size());
+    for (size_t first_net = 0; first_net < nets.size(); first_net += d.max_batch_nets) {
+        const int num_nets = static_cast<int>(std::min(d.max_batch_nets, nets.size() - first_net));
+        const size_t num_items = num_nets * d.num_nodes;
+
+        std::vector<int> net_sources(num_nets);
+        std::vector<int> net_bbs(6 * num_nets);
+        std::vector<int> net_sink_offsets(num_nets + 1, 0);
+        std::vector<int> sink_nets;
+        std::vector<int> sink_nodes;
+        for (int inet = 0; inet < num_nets; inet++) {
+            const BatchNet& net = nets[first_net + inet];
+            net_sources[inet] = net.source;
+            int* bb = &net_bbs[6 * inet];
+            bb[0] = net.xmin;
+            bb[1] = net.xmax;
+            bb[2] = net.ymin;
+            bb[3] = net.ymax;
+            bb[4] = net.layer_min;
+            bb[5] = net.layer_max;
+            for (int sink : net.sinks) {
+                sink_nets.push_back(inet);
+                sink_nodes.push_back(sink);
+            }
+            net_sink_offsets[inet + 1] = sink_nodes.size();
+        }
+        const int num_sinks = static_cast<int>(sink_nodes.size());
+
+        DeviceArray<int> d_net_sources(net_sources);
+        DeviceArray<int> d_net_bbs(net_bbs);
+        DeviceArray<int> d_net_sink_offsets(net_sink_offsets);
+        DeviceArray<int> d_sink_nets(sink_nets);
+        DeviceArray<int> d_sink_nodes(sink_nodes);
+        DeviceArray<float> d_thresholds(num_nets);
+        DeviceArray<unsigned char> d_done(num_nets);
+        DeviceArray<unsigned> d_min_far_dists(num_nets);
+        DeviceArray<int> d_counter(1);
+
+        d.state.fill_bytes(0xff, num_items); // UNREACHED
+        d.active.fill_bytes(0, num_items);
+        start_kernel<<<num_blocks_for(num_nets), THREADS_PER_BLOCK>>>(
+            num_nets, d.num_nodes, d_net_sources.get(), delta,
+            d.state.get(), d.active.get(), d_thresholds.get(), d_done.get());
+        check_cuda(cudaGetLastError(), "start_kernel");
+
+        while (true) {
+            int changed = 0;
+            d_counter.fill_bytes(0, 1);
+            relax_kernel<<<num_blocks_for(num_items), THREADS_PER_BLOCK>>>(
+                num_items, d.num_nodes,
+                d.edge_offsets.get(), d.edge_sinks.get(),
+                d.node_x.get(), d.node_y.get(), d.node_layer.get(),
+                d.node_costs.get(), d_net_bbs.get(), d_thresholds.get(), d_done.get(),
+                d.state.get(), d.active.get(), d_counter.get());
+            check_cuda(cudaGetLastError(), "relax_kernel");
+            d_counter.download(&changed);
+            if (changed)
+                continue;
+
+            // No node is closer than the thresholds: move on to the far nodes
+            int num_left = 0;
+            d_min_far_dists.fill_bytes(0xff, num_nets);
+            min_far_kernel<<<num_blocks_for(num_items), THREADS_PER_BLOCK>>>(
+                num_items, d.num_nodes, d_done.get(), d.state.get(), d.active.get(), d_min_far_dists.get());
+            check_cuda(cudaGetLastError(), "min_far_kernel");
+            d_counter.fill_bytes(0, 1);
+            advance_kernel<<<num_blocks_for(num_nets), THREADS_PER_BLOCK>>>(
+                num_nets, d.num_nodes, d_net_sink_offsets.get(), d_sink_nodes.get(), d_min_far_dists.get(),
+                delta, d.state.get(), d_thresholds.get(), d_done.get(), d_counter.get());
+            check_cuda(cudaGetLastError(), "advance_kernel");
+            d_counter.download(&num_left);
+            if (num_left == 0)
+                break;
+        }
+
+        DeviceArray<int> d_path_edges(static_cast<size_t>(num_sinks) * MAX_PATH_EDGES);
+        DeviceArray<int> d_path_lengths(num_sinks);
+        trace_kernel<<<num_blocks_for(num_sinks), THREADS_PER_BLOCK>>>(
+            num_sinks, d.num_nodes, d_sink_nets.get(), d_sink_nodes.get(), d_net_sources.get(),
+            d.edge_srcs.get(), d.state.get(), MAX_PATH_EDGES, d_path_edges.get(), d_path_lengths.get());
+        check_cuda(cudaGetLastError(), "trace_kernel");
+
+        std::vector<int> path_edges(d_path_edges.size());
+        std::vector<int> path_lengths(num_sinks);
+        d_path_edges.download(path_edges.data());
+        d_path_lengths.download(path_lengths.data());
+
+        for (int inet = 0; inet < num_nets; inet++) {
+            BatchNetPaths& net_paths = paths[first_net + inet];
+            net_paths.resize(net_sink_offsets[inet + 1] - net_sink_offsets[inet]);
+            for (int isink = net_sink_offsets[inet]; isink < net_sink_offsets[inet + 1]; isink++) {
+                if (path_lengths[isink] < 0)
+                    continue;
+                const int* edges = &path_edges[static_cast<size_t>(isink) * MAX_PATH_EDGES];
+                net_paths[isink - net_sink_offsets[inet]].assign(std::make_reverse_iterator(edges + path_lengths[isink]),
+                                                                 std::make_reverse_iterator(edges));
+            }
+        }
+    }
+
+    return paths;
+}
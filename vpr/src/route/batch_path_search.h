@@ -0,0 +1,115 @@
+#pragma once
+/**
+ * @file
+ * @brief Cheapest path search for a batch of independent nets, over a flat copy of the RR graph.
+ *
+ * Used by \ref BatchNetlistRouter to plan the routing of many low criticality nets at once. The
+ * search of each net is a single source shortest path search from the source of the net to all
+ * of its sinks, where entering a node costs its (congestion) cost and only the nodes inside the
+ * bounding box of the net are expanded. All the nets of a batch are searched against the same
+ * node costs, independently of each other: the paths of different nets may share (and overuse)
+ * nodes, which the router checks for when it uses the paths.
+ *
+ * find_batch_paths() searches the nets on the CPU, in parallel if VPR is built with TBB. When VPR
+ * is configured with -DVPR_USE_CUDA=ON, GpuBatchPathSearch searches them on a CUDA device, many
+ * nets at a time, with a delta-stepping variant of Dijkstra's algorithm.
+ *
+ * The RR graph, costs and paths are passed as plain integer and float arrays (indexed by size_t of
+ * RRNodeId and RREdgeId), so the CUDA sources need no VPR context.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class RRGraphView;
+
+/** A copy of the RR graph in compressed sparse row form, with the node locations used for the bounding box checks */
+struct BatchRRGraph {
+    /** The out edges of node i are the edges [edge_offsets[i], edge_offsets[i + 1]) (the RR graph stores the edges of a node contiguously) */
+    std::vector<int> edge_offsets;
+    /** The source node of each edge */
+    std::vector<int> edge_srcs;
+    /** The sink node of each edge */
+    std::vector<int> edge_sinks;
+    /** The location of each node checked against the bounding boxes (its high end for DEC wires, else its low end, as in inside_bb()) */
+    std::vector<int16_t> node_x;
+    std::vector<int16_t> node_y;
+    std::vector<int16_t> node_layer;
+
+    size_t num_nodes() const { return node_x.size(); }
+    size_t num_edges() const { return edge_sinks.size(); }
+};
+
+/** Copies \p rr_graph into a BatchRRGraph */
+BatchRRGraph build_batch_rr_graph(const RRGraphView& rr_graph);
+
+/** A net to search paths for */
+struct BatchNet {
+    int source;
+    std::vector<int> sinks;
+    /** Bounding box of the nodes the paths may use (inclusive) */
+    int xmin, xmax;
+    int ymin, ymax;
+    int layer_min, layer_max;
+};
+
+/** Paths of the sinks of a BatchNet, in the order of BatchNet::sinks: the edges from the source to the sink, empty if the sink wasn't reached */
+typedef std::vector<std::vector<int>> BatchNetPaths;
+
+/**
+ * @brief Finds the cheapest paths from the source of each net of \p nets to its sinks, on the CPU.
+ *
+ *  @param graph        The RR graph.
+ *  @param node_costs   The cost of entering each node (non-negative).
+ *  @param nets         The nets to search.
+ *  @return The paths of each net of \p nets.
+ */
+std::vector<BatchNetPaths> find_batch_paths(const BatchRRGraph& graph,
+                                            const std::vector<float>& node_costs,
+                                            const std::vector<BatchNet>& nets);
+
+#ifdef VPR_USE_CUDA
+
+/**
+ * @brief The batch path search run on a CUDA device.
+ *
+ * The RR graph is uploaded once, when the search is constructed. Every call to find_paths()
+ * uploads the node costs and searches the nets in batches, each net of a batch with its own
+ * distance array, as many at a time as fit in the memory budget.
+ *
+ * The distance and predecessor edge of a node are packed in a 64-bit word, so that a relaxation
+ * is a single atomicMin(). Each round relaxes the edges of the nodes closer than the threshold of
+ * their net in parallel; once no such node is left they are final, and the threshold moves up by
+ * delta to the next nodes (delta-stepping with a near/far split). A net is done once all of its
+ * sinks are final. The paths are then traced back on the device, up to MAX_PATH_EDGES edges: longer
+ * paths are reported as not found, and left to the CPU router.
+ */
+class GpuBatchPathSearch {
+  public:
+    /** Maximum number of edges of a path traced back on the device */
+    static constexpr int MAX_PATH_EDGES = 512;
+
+    /**
+     *  @param graph            The RR graph, uploaded to the device.
+     *  @param memory_budget    Bytes of device memory the per-net search arrays of a batch may use.
+     */
+    GpuBatchPathSearch(const BatchRRGraph& graph, size_t memory_budget);
+
+    ~GpuBatchPathSearch();
+
+    GpuBatchPathSearch(const GpuBatchPathSearch&) = delete;
+    GpuBatchPathSearch& operator=(const GpuBatchPathSearch&) = delete;
+
+    /** Same as find_batch_paths(), on the device */
+    std::vector<BatchNetPaths> find_paths(const std::vector<float>& node_costs,
+                                          const std::vector<BatchNet>& nets);
+
+  private:
+    /** The device arrays (defined in batch_path_search.cu) */
+    struct DeviceData;
+    std::unique_ptr<DeviceData> data_;
+};
+
+#endif /* VPR_USE_CUDA */
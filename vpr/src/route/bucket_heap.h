@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "device_grid.h"
+#include "heap_type.h"
+
+/**
+ * @brief Monotone priority queue which sorts heap nodes into buckets (a radix heap).
+ *
+ * @details
+ * Each priority is mapped to an unsigned 32-bit key with the same order. The nodes are kept in
+ * 33 buckets, by the position of the highest bit in which their key differs from the key of the
+ * last popped node (bucket 0 holds the nodes with exactly that key). Pushing a node only appends
+ * it to its bucket, and popping takes it from bucket 0, refilling bucket 0 when it is empty by
+ * redistributing the first non-empty bucket around its smallest key. Each node moves to a lower
+ * bucket at most 32 times, so push and pop take amortized constant time no matter how big the
+ * heap is, and get most of their memory accesses from the back of a few vectors.
+ *
+ * Radix heaps require the pushed priorities to never be smaller than the last popped one. This
+ * holds for Dijkstra, but not quite for A* with an inconsistent lookahead, so the occasional node
+ * pushed below the last popped priority goes to a small binary heap of "late" nodes instead, which
+ * is drained first. The order of the popped nodes is therefore exact, except between nodes with
+ * equal priorities.
+ *
+ * This pays off over the D-ary heaps when the wavefront is large: on big devices, and for high
+ * fanout nets, whose whole route tree is pushed onto the heap before routing each sink.
+ */
+class BucketHeap : public HeapInterface {
+  public:
+    ///@brief D of the MultiQueueDAryHeap used instead when the parallel connection router is enabled
+    static constexpr unsigned arg_D = 4;
+
+    BucketHeap() {}
+
+    void init_heap(const DeviceGrid& grid) {
+        size_t target_heap_size = (grid.width() - 1) * (grid.height() - 1);
+        // Most nodes sit in the top few buckets until the wavefront reaches them
+        buckets_[NUM_BUCKETS - 1].reserve(target_heap_size);
+    }
+
+    bool try_pop(HeapNode& heap_node) {
+        if (!late_nodes_.empty()) {
+            std::pop_heap(late_nodes_.begin(), late_nodes_.end(), HeapNodeComparator());
+            heap_node = late_nodes_.back();
+            late_nodes_.pop_back();
+            return true;
+        }
+
+        if (num_bucket_nodes_ == 0) {
+            return false;
+        }
+
+        if (buckets_[0].empty()) {
+            refill_first_bucket_();
+        }
+
+        heap_node = buckets_[0].back();
+        buckets_[0].pop_back();
+        num_bucket_nodes_--;
+        return true;
+    }
+
+    void add_to_heap(const HeapNode& heap_node) {
+        uint32_t key = to_key(heap_node.prio);
+        if (key < last_key_) {
+            late_nodes_.push_back(heap_node);
+            std::push_heap(late_nodes_.begin(), late_nodes_.end(), HeapNodeComparator());
+        } else {
+            buckets_[bucket_index_(key)].push_back(heap_node);
+            num_bucket_nodes_++;
+        }
+    }
+
+    void push_back(const HeapNode& heap_node) {
+        add_to_heap(heap_node); // Adding a node never breaks the bucket invariant
+    }
+
+    void build_heap() {
+        // Nothing to do: push_back already filed the nodes in their buckets
+    }
+
+    bool is_valid() const {
+        size_t num_nodes = 0;
+        for (size_t ibucket = 0; ibucket < NUM_BUCKETS; ibucket++) {
+            for (const HeapNode& heap_node : buckets_[ibucket]) {
+                uint32_t key = to_key(heap_node.prio);
+                if (key < last_key_ || bucket_index_(key) != ibucket) {
+                    return false;
+                }
+            }
+            num_nodes += buckets_[ibucket].size();
+        }
+
+        for (const HeapNode& heap_node : late_nodes_) {
+            if (to_key(heap_node.prio) >= last_key_) {
+                return false;
+            }
+        }
+
+        return num_nodes == num_bucket_nodes_
+               && std::is_heap(late_nodes_.begin(), late_nodes_.end(), HeapNodeComparator());
+    }
+
+    void empty_heap() {
+        for (std::vector<HeapNode>& bucket : buckets_) {
+            bucket.clear();
+        }
+        late_nodes_.clear();
+        num_bucket_nodes_ = 0;
+        last_key_ = 0;
+    }
+
+    bool is_empty_heap() const {
+        return num_bucket_nodes_ == 0 && late_nodes_.empty();
+    }
+
+    ///@brief Maps a priority to an unsigned key with the same order (negative priorities included).
+    static uint32_t to_key(HeapNodePriority prio) {
+        uint32_t bits = std::bit_cast<uint32_t>(prio);
+        // Flip all the bits of negative values and only the sign bit of positive ones
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+  private:
+    static constexpr size_t NUM_BUCKETS = 33;
+
+    size_t bucket_index_(uint32_t key) const {
+        return std::bit_width(key ^ last_key_);
+    }
+
+    /** Makes the smallest key in the first non-empty bucket the last popped key, and moves the
+     * nodes of that bucket to the (lower) buckets they now belong to. */
+    void refill_first_bucket_() {
+        size_t ibucket = 1;
+        while (buckets_[ibucket].empty()) {
+            ibucket++;
+        }
+
+        std::vector<HeapNode>& bucket = buckets_[ibucket];
+        last_key_ = to_key(bucket[0].prio);
+        for (const HeapNode& heap_node : bucket) {
+            last_key_ = std::min(last_key_, to_key(heap_node.prio));
+        }
+        for (const HeapNode& heap_node : bucket) {
+            buckets_[bucket_index_(to_key(heap_node.prio))].push_back(heap_node);
+        }
+        bucket.clear();
+    }
+
+    std::array<std::vector<HeapNode>, NUM_BUCKETS> buckets_;
+    ///@brief Number of nodes in buckets_
+    size_t num_bucket_nodes_ = 0;
+    ///@brief Key of the last popped node from buckets_ (no node in the buckets has a smaller key)
+    uint32_t last_key_ = 0;
+    ///@brief Min-heap of the nodes pushed with a key smaller than last_key_
+    std::vector<HeapNode> late_nodes_;
+};
@@ -18,6 +18,10 @@
 #include "check_rr_graph.h"
 #include "route_tree.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for_each.h>
+#endif // VPR_USE_TBB
+
 /******************** Subroutines local to this module **********************/
 static void check_node_and_range(RRNodeId inode,
                                  enum e_route_type route_type,
@@ -34,6 +38,18 @@ static void check_sink(const Netlist<>& net_list,
 
 static void check_switch(const RouteTreeNode& rt_node, size_t num_switch);
 
+/**
+ * @brief Checks that the routing of the net is a properly connected tree of legal RR nodes
+ *        and switches, which reaches all the pins of the net and has no stubs.
+ *
+ * Only reads the routing, so it can be called for several nets in parallel.
+ */
+static void check_net_route(const Netlist<>& net_list,
+                            ParentNetId net_id,
+                            enum e_route_type route_type,
+                            size_t num_switches,
+                            bool is_flat);
+
 /**
  * @brief Checks if two RR nodes are physically adjacent and legally connected.
  *
@@ -127,83 +143,97 @@ void check_route(const Netlist<>& net_list,
                                      is_flat);
     }
 
-    int max_pins = 0;
-    for (auto net_id : net_list.nets())
-        max_pins = std::max(max_pins, (int)net_list.net_pins(net_id).size());
+    /* Now check that all nets are indeed connected. The nets are independent (and only read the *
+     * routing), so they are checked in parallel.                                                  */
+    auto check_one_net = [&](ParentNetId net_id) {
+        check_net_route(net_list, net_id, route_type, num_switches, is_flat);
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(net_list.nets().begin(), net_list.nets().end(), check_one_net);
+#else
+    for (ParentNetId net_id : net_list.nets()) {
+        check_one_net(net_id);
+    }
+#endif // VPR_USE_TBB
 
-    auto pin_done = std::make_unique<bool[]>(max_pins);
+    if (check_route_option == e_check_route_option::FULL) {
+        check_all_non_configurable_edges(net_list, is_flat);
+    } else {
+        VTR_ASSERT(check_route_option == e_check_route_option::QUICK);
+    }
 
-    /* Now check that all nets are indeed connected. */
-    for (auto net_id : net_list.nets()) {
-        if (net_list.net_is_ignored(net_id) || net_list.net_sinks(net_id).size() == 0) /* Skip ignored nets. */
-            continue;
+    VTR_LOG("Completed routing consistency check successfully.\n");
+    VTR_LOG("\n");
+}
 
-        std::fill_n(pin_done.get(), net_list.net_pins(net_id).size(), false);
+static void check_net_route(const Netlist<>& net_list,
+                            ParentNetId net_id,
+                            enum e_route_type route_type,
+                            size_t num_switches,
+                            bool is_flat) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+    const auto& route_ctx = g_vpr_ctx.routing();
 
-        if (!route_ctx.route_trees[net_id]) {
-            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                            "in check_route: net %d has no routing.\n", size_t(net_id));
-        }
+    if (net_list.net_is_ignored(net_id) || net_list.net_sinks(net_id).size() == 0) /* Skip ignored nets. */
+        return;
 
-        /* Check the SOURCE of the net. */
-        RRNodeId source_inode = route_ctx.route_trees[net_id].value().root().inode;
-        check_node_and_range(source_inode, route_type, is_flat);
-        check_source(net_list, source_inode, net_id, is_flat);
-
-        pin_done[0] = true;
-
-        /* Check the rest of the net */
-        size_t num_sinks = 0;
-        for (const RouteTreeNode& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
-            RRNodeId inode = rt_node.inode;
-            int net_pin_index = rt_node.net_pin_index;
-            check_node_and_range(inode, route_type, is_flat);
-            check_switch(rt_node, num_switches);
-
-            if (rt_node.parent()) {
-                bool connects = check_adjacent(rt_node.parent()->inode, rt_node.inode, is_flat);
-                if (!connects) {
-                    VPR_ERROR(VPR_ERROR_ROUTE,
-                              "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
-                              "  %s\n"
-                              "  %s\n",
-                              size_t(net_id),
-                              describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, rt_node.parent()->inode, is_flat).c_str(),
-                              describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, inode, is_flat).c_str());
-                }
-            }
+    auto pin_done = std::make_unique<bool[]>(net_list.net_pins(net_id).size()); // All false
 
-            if (rr_graph.node_type(inode) == e_rr_type::SINK) {
-                check_sink(net_list, inode, net_pin_index, net_id, pin_done.get());
-                num_sinks += 1;
-            }
-        }
+    if (!route_ctx.route_trees[net_id]) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "in check_route: net %d has no routing.\n", size_t(net_id));
+    }
 
-        if (num_sinks != net_list.net_sinks(net_id).size()) {
-            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                            "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
-                            size_t(net_id), net_list.net_name(net_id).c_str(),
-                            num_sinks, net_list.net_sinks(net_id).size());
+    /* Check the SOURCE of the net. */
+    RRNodeId source_inode = route_ctx.route_trees[net_id].value().root().inode;
+    check_node_and_range(source_inode, route_type, is_flat);
+    check_source(net_list, source_inode, net_id, is_flat);
+
+    pin_done[0] = true;
+
+    /* Check the rest of the net */
+    size_t num_sinks = 0;
+    for (const RouteTreeNode& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
+        RRNodeId inode = rt_node.inode;
+        int net_pin_index = rt_node.net_pin_index;
+        check_node_and_range(inode, route_type, is_flat);
+        check_switch(rt_node, num_switches);
+
+        if (rt_node.parent()) {
+            bool connects = check_adjacent(rt_node.parent()->inode, rt_node.inode, is_flat);
+            if (!connects) {
+                VPR_ERROR(VPR_ERROR_ROUTE,
+                          "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
+                          "  %s\n"
+                          "  %s\n",
+                          size_t(net_id),
+                          describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, rt_node.parent()->inode, is_flat).c_str(),
+                          describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, inode, is_flat).c_str());
+            }
         }
 
-        for (size_t ipin = 0; ipin < net_list.net_pins(net_id).size(); ipin++) {
-            if (!pin_done[ipin]) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
-            }
+        if (rr_graph.node_type(inode) == e_rr_type::SINK) {
+            check_sink(net_list, inode, net_pin_index, net_id, pin_done.get());
+            num_sinks += 1;
         }
+    }
 
-        check_net_for_stubs(net_list, net_id, is_flat);
-    } /* End for each net */
+    if (num_sinks != net_list.net_sinks(net_id).size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
+                        size_t(net_id), net_list.net_name(net_id).c_str(),
+                        num_sinks, net_list.net_sinks(net_id).size());
+    }
 
-    if (check_route_option == e_check_route_option::FULL) {
-        check_all_non_configurable_edges(net_list, is_flat);
-    } else {
-        VTR_ASSERT(check_route_option == e_check_route_option::QUICK);
+    for (size_t ipin = 0; ipin < net_list.net_pins(net_id).size(); ipin++) {
+        if (!pin_done[ipin]) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
+        }
     }
 
-    VTR_LOG("Completed routing consistency check successfully.\n");
-    VTR_LOG("\n");
+    check_net_for_stubs(net_list, net_id, is_flat);
 }
 
 /* Checks that this SINK node is one of the terminals of inet, and marks   *
@@ -490,20 +520,28 @@ void recompute_occupancy_from_scratch(const Netlist<>& net_list, bool is_flat) {
     for (RRNodeId inode : device_ctx.rr_graph.nodes())
         route_ctx.rr_node_route_inf[inode].set_occ(0);
 
-    /* Now go through each net and count the tracks and pins used everywhere */
-
-    for (auto net_id : net_list.nets()) {
+    /* Now go through each net and count the tracks and pins used everywhere.  *
+     * The nets are counted in parallel: nets may share RR nodes (e.g. non-    *
+     * configurable sets, or overused nodes), so the occupancy is incremented  *
+     * atomically.                                                             */
+    auto add_net_occupancy = [&](ParentNetId net_id) {
         if (!route_ctx.route_trees[net_id])
-            continue;
+            return;
 
         if (net_list.net_is_ignored(net_id)) /* Skip ignored nets. */
-            continue;
+            return;
 
         for (auto& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
-            RRNodeId inode = rt_node.inode;
-            route_ctx.rr_node_route_inf[inode].set_occ(route_ctx.rr_node_route_inf[inode].occ() + 1);
+            route_ctx.rr_node_route_inf[rt_node.inode].atomic_add_occ(1);
         }
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(net_list.nets().begin(), net_list.nets().end(), add_net_occupancy);
+#else
+    for (ParentNetId net_id : net_list.nets()) {
+        add_net_occupancy(net_id);
     }
+#endif // VPR_USE_TBB
 
     /* We only need to reserve output pins if flat routing is not enabled */
     if (!is_flat) {
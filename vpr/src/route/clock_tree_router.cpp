@@ -0,0 +1,108 @@
+#include "clock_tree_router.h"
+
+#include <queue>
+#include <unordered_map>
+
+#include "globals.h"
+#include "route_common.h"
+#include "route_debug.h"
+#include "vtr_assert.h"
+
+size_t route_clock_net_on_clock_tree(ParentNetId net_id,
+                                     const Netlist<>& net_list,
+                                     RRNodeId virtual_clock_root,
+                                     const std::vector<size_t>& target_pins,
+                                     RouteTree& tree,
+                                     SpatialRouteTreeLookup* spatial_rt_lookup,
+                                     bool is_flat) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const t_rr_graph_storage& rr_nodes = rr_graph.rr_nodes();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    vtr::optional<const RouteTreeNode&> root_rt_node = tree.find_by_rr_id(virtual_clock_root);
+    if (!root_rt_node || !root_rt_node->parent()) {
+        return 0;
+    }
+    RRNodeId drive_node = root_rt_node->parent()->inode;
+
+    // The SINKs to reach. A SINK shared by several pins of the net is only routed for one of
+    // them here (the others are left to the connection router, which handles repeated SINKs).
+    std::unordered_map<RRNodeId, int> target_sink_pins;
+    for (size_t ipin : target_pins) {
+        target_sink_pins.emplace(route_ctx.net_rr_terminals[net_id][ipin], ipin);
+    }
+    size_t num_targets = target_sink_pins.size();
+
+    // Breadth-first walk of the clock network from its drive point, recording the edge each node
+    // was first reached by. The drive point and nodes already in the route tree have no such edge.
+    std::unordered_map<RRNodeId, RREdgeId> prev_edge;
+    std::vector<std::pair<RRNodeId, int>> reached_sinks;
+    std::queue<RRNodeId> queue;
+    prev_edge.emplace(drive_node, RREdgeId::INVALID());
+    queue.push(drive_node);
+
+    while (!queue.empty() && reached_sinks.size() < num_targets) {
+        RRNodeId from_node = queue.front();
+        queue.pop();
+
+        e_rr_type from_type = rr_graph.node_type(from_node);
+        if (from_type == e_rr_type::SINK) {
+            continue;
+        }
+
+        for (RREdgeId edge : rr_nodes.edge_range(from_node)) {
+            RRNodeId to_node = rr_nodes.edge_sink_node(edge);
+            if (prev_edge.count(to_node)) {
+                continue;
+            }
+
+            // Stay on the clock network: wires, then (from the clock network taps) the block pins
+            e_rr_type to_type = rr_graph.node_type(to_node);
+            if (to_type == e_rr_type::SINK) {
+                if (!target_sink_pins.count(to_node)) {
+                    continue; // Includes the virtual clock network roots
+                }
+            } else if (from_type == e_rr_type::IPIN && !is_flat) {
+                continue; // An IPIN only leads to its SINK
+            } else if (to_type != e_rr_type::CHANX && to_type != e_rr_type::CHANY && to_type != e_rr_type::IPIN) {
+                continue;
+            }
+
+            const t_rr_node_route_inf& to_route_inf = route_ctx.rr_node_route_inf[to_node];
+            if (!tree.find_by_rr_id(to_node) && to_route_inf.occ() >= rr_graph.node_capacity(to_node)) {
+                continue; // Would be overused
+            }
+
+            prev_edge.emplace(to_node, edge);
+            if (to_type == e_rr_type::SINK) {
+                reached_sinks.emplace_back(to_node, target_sink_pins.at(to_node));
+            }
+            queue.push(to_node);
+        }
+    }
+
+    // Commit the paths to the route tree (and the occupancy), one sink at a time. Each path is walked back
+    // through rr_node_route_inf[].prev_edge (as for the connection router) up to the first node in the tree.
+    for (const auto& [sink_node, ipin] : reached_sinks) {
+        for (RRNodeId node = sink_node; !tree.find_by_rr_id(node);) {
+            RREdgeId edge = prev_edge.at(node);
+            VTR_ASSERT(edge.is_valid());
+            route_ctx.rr_node_route_inf[node].prev_edge = edge;
+            node = rr_graph.edge_src_node(edge);
+        }
+
+        RTExploredNode sink_explored;
+        sink_explored.index = sink_node;
+        sink_explored.prev_edge = prev_edge.at(sink_node);
+
+        vtr::optional<const RouteTreeNode&> new_branch;
+        std::tie(new_branch, std::ignore) = tree.update_from_heap(&sink_explored, ipin, spatial_rt_lookup, is_flat);
+        VTR_ASSERT(new_branch);
+        pathfinder_update_cost_from_route_tree(new_branch.value(), 1);
+
+        VTR_LOGV_DEBUG(f_router_debug, "Routed net %zu (%s) pin %d on the clock network\n",
+                       size_t(net_id), net_list.net_name(net_id).c_str(), ipin);
+    }
+
+    return reached_sinks.size();
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Fast routing of the sinks of clock nets on a dedicated clock network.
+ *
+ * With two-stage clock routing, a clock net is first routed from its source to the virtual
+ * clock network root (see pre_route_to_clock_root()), which leaves the drive point of the clock
+ * network in the net's route tree. The clock network below the drive point is a tree of spines
+ * and ribs ending at the clock pins of the blocks, so the path to each sink is (almost) unique:
+ * instead of one timing-driven wavefront per sink, all the sinks are reached by a single
+ * breadth-first walk of the clock network from the drive point.
+ */
+
+#include <vector>
+
+#include "netlist.h"
+#include "route_tree.h"
+#include "spatial_route_tree_lookup.h"
+
+/**
+ * @brief Routes the target pins of a clock net from the drive point of the clock network
+ *        (the node driving the virtual clock network root) by walking the clock network.
+ *
+ * The walk only goes through wires, IPINs and SINKs, and never through a node which would
+ * become overused. The paths found are added to the route tree and to the RR node occupancy.
+ *
+ * @param net_id The clock net
+ * @param net_list The netlist being routed
+ * @param virtual_clock_root The virtual clock network root, already in the route tree
+ * @param target_pins The net pin indices to route
+ * @param tree The route tree of the net
+ * @param spatial_rt_lookup The spatial lookup of the route tree to update (or nullptr)
+ * @param is_flat Whether flat routing is on
+ * @return The number of target pins routed. The other ones are to be routed by the connection router.
+ */
+size_t route_clock_net_on_clock_tree(ParentNetId net_id,
+                                     const Netlist<>& net_list,
+                                     RRNodeId virtual_clock_root,
+                                     const std::vector<size_t>& target_pins,
+                                     RouteTree& tree,
+                                     SpatialRouteTreeLookup* spatial_rt_lookup,
+                                     bool is_flat);
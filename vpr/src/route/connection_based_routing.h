@@ -63,6 +63,8 @@ class Connection_based_routing_resources {
     //Updates the connection delay lower bound (if less than current best found)
     void update_lower_bound_connection_delay(ParentNetId net, int ipin, float delay);
 
+    float get_lower_bound_connection_delay(ParentNetId net, int ipin) const { return lower_bound_connection_delay[net][ipin]; }
+
     // get a handle on the resources
     float get_stable_critical_path_delay() const { return last_stable_critical_path_delay; }
 
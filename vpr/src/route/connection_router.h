@@ -22,6 +22,7 @@
 
 #include "connection_router_interface.h"
 #include "globals.h"
+#include "lookahead_cost_cache.h"
 #include "route_path_manager.h"
 #include "rr_graph_storage.h"
 #include "router_lookahead.h"
@@ -259,6 +260,42 @@ class ConnectionRouter : public ConnectionRouterInterface {
         RRNodeId from_node,
         RRNodeId target_node);
 
+    /**
+     * @brief First half of evaluate_timing_driven_node_costs(): updates the upstream
+     * resistance and the backward ("known") costs of reaching to_node. Doesn't query
+     * the router lookahead, so it is cheap enough to run before pre-heap pruning.
+     * @param to Neighbor node to calculate costs before being expanded
+     * @param cost_params Cost function parameters
+     * @param from_node Current node ID being explored
+     */
+    void evaluate_timing_driven_node_backward_costs(
+        RTExploredNode* to,
+        const t_conn_cost_params& cost_params,
+        RRNodeId from_node);
+
+    /**
+     * @brief Second half of evaluate_timing_driven_node_costs(): sets to->total_cost
+     * from the backward costs and the expected cost to the target.
+     * @param to Neighbor node with backward costs already evaluated
+     * @param cost_params Cost function parameters
+     * @param target_node Target node ID to route to
+     */
+    void evaluate_timing_driven_node_total_cost(
+        RTExploredNode* to,
+        const t_conn_cost_params& cost_params,
+        RRNodeId target_node);
+
+    /**
+     * @brief Expected cost from node to target_node, from the lookahead cost cache if it is enabled
+     */
+    inline float get_expected_cost(RRNodeId node, RRNodeId target_node, const t_conn_cost_params& cost_params, float R_upstream) {
+        if (!lookahead_cost_cache_.enabled())
+            return router_lookahead_.get_expected_cost(node, target_node, cost_params, R_upstream);
+        return lookahead_cost_cache_.get(node, target_node, cost_params.criticality, router_stats_, [&]() {
+            return router_lookahead_.get_expected_cost(node, target_node, cost_params, R_upstream);
+        });
+    }
+
     /**
      * @brief Evaluate node costs using the RCV algorithm
      * @param cost_params Cost function parameters
@@ -310,6 +347,9 @@ class ConnectionRouter : public ConnectionRouterInterface {
     /** Router lookahead */
     const RouterLookahead& router_lookahead_;
 
+    /** Memoized lookahead costs. Only enabled by the serial connection router (it isn't thread safe) */
+    LookaheadCostCache lookahead_cost_cache_;
+
     /** RR node data */
     const t_rr_graph_view rr_nodes_;
 
@@ -262,6 +262,14 @@ void ConnectionRouter<Heap>::evaluate_timing_driven_node_costs(RTExploredNode* t
                                                                const t_conn_cost_params& cost_params,
                                                                RRNodeId from_node,
                                                                RRNodeId target_node) {
+    evaluate_timing_driven_node_backward_costs(to, cost_params, from_node);
+    evaluate_timing_driven_node_total_cost(to, cost_params, target_node);
+}
+
+template<typename Heap>
+void ConnectionRouter<Heap>::evaluate_timing_driven_node_backward_costs(RTExploredNode* to,
+                                                                        const t_conn_cost_params& cost_params,
+                                                                        RRNodeId from_node) {
     /* new_costs.backward_cost: is the "known" part of the cost to this node -- the
      * congestion cost of all the routing resources back to the existing route
      * plus the known delay of the total path back to the source.
@@ -352,17 +360,24 @@ void ConnectionRouter<Heap>::evaluate_timing_driven_node_costs(RTExploredNode* t
         }
     }
 
-    float total_cost = 0.;
-
     if (rcv_path_manager.is_enabled() && to->path_data != nullptr) {
         to->path_data->backward_delay += cost_params.criticality * Tdel;
         to->path_data->backward_cong += (1. - cost_params.criticality) * get_rr_cong_cost(to->index, cost_params.pres_fac);
+    }
+}
 
+template<typename Heap>
+void ConnectionRouter<Heap>::evaluate_timing_driven_node_total_cost(RTExploredNode* to,
+                                                                    const t_conn_cost_params& cost_params,
+                                                                    RRNodeId target_node) {
+    float total_cost = 0.;
+
+    if (rcv_path_manager.is_enabled() && to->path_data != nullptr) {
         total_cost = compute_node_cost_using_rcv(cost_params, to->index, target_node, to->path_data->backward_delay, to->path_data->backward_cong, to->R_upstream);
     } else {
         const auto& device_ctx = g_vpr_ctx.device();
         //Update total cost
-        float expected_cost = router_lookahead_.get_expected_cost(to->index, target_node, cost_params, to->R_upstream);
+        float expected_cost = get_expected_cost(to->index, target_node, cost_params, to->R_upstream);
         VTR_LOGV_DEBUG(router_debug_ && !std::isfinite(expected_cost),
                        "        Lookahead from %s (%s) to %s (%s) is non-finite, expected_cost = %f, to->R_upstream = %f\n",
                        rr_node_arch_name(to->index, is_flat_).c_str(),
@@ -25,6 +25,8 @@ struct t_conn_cost_params {
     float bend_cost = 1.;
     float pres_fac = 1.;
     const t_conn_delay_budget* delay_budget = nullptr;
+    /** Route with a bidirectional search (see SerialConnectionRouter::timing_driven_find_single_shortest_path_bidirectional()) */
+    bool bidirectional_search = false;
 
     //TODO: Eventually once delay budgets are working, t_conn_delay_budget
     //should be factoured out, and the delay budget parameters integrated
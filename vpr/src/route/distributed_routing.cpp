@@ -0,0 +1,249 @@
+#ifdef VPR_USE_MPI
+
+#include "distributed_routing.h"
+
+#include <cstdint>
+#include <limits>
+
+#include <mpi.h>
+
+#include "globals.h"
+#include "old_traceback.h"
+#include "route_common.h"
+#include "route_net.h"
+#include "vpr_error.h"
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/** Number of ints before the traceback of a net in a buffer (see distributed_routing.h) */
+constexpr size_t NET_ROUTING_HEADER_SIZE = 9;
+
+/** Finalizes MPI at exit, if VPR started it */
+struct MpiFinalizer {
+    ~MpiFinalizer() {
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+        if (!finalized) {
+            MPI_Finalize();
+        }
+    }
+};
+
+void init_distributed_routing() {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized) {
+        return;
+    }
+
+    /* Only the main thread of VPR talks to the other ranks */
+    int provided = 0;
+    if (MPI_Init_thread(nullptr, nullptr, MPI_THREAD_FUNNELED, &provided) != MPI_SUCCESS) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to initialize MPI for the distributed router\n");
+    }
+    static MpiFinalizer finalizer;
+
+    VTR_LOG("Distributed router: rank %zu of %zu\n", distributed_rank(), distributed_num_ranks());
+}
+
+size_t distributed_rank() {
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    return rank;
+}
+
+size_t distributed_num_ranks() {
+    int num_ranks = 1;
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+    return num_ranks;
+}
+
+/** FNV-1a step */
+static void hash_combine(uint64_t& hash, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        hash ^= (value >> (8 * i)) & 0xff;
+        hash *= 0x100000001b3ULL;
+    }
+}
+
+void check_distributed_routing_inputs(const Netlist<>& net_list) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    /* The RR terminals of the nets depend on both the placement and the RR graph */
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    hash_combine(hash, device_ctx.rr_graph.num_nodes());
+    hash_combine(hash, net_list.nets().size());
+    for (ParentNetId net_id : net_list.nets()) {
+        for (RRNodeId terminal : route_ctx.net_rr_terminals[net_id]) {
+            hash_combine(hash, size_t(terminal));
+        }
+    }
+
+    unsigned long long min_hash = hash;
+    unsigned long long max_hash = hash;
+    MPI_Allreduce(MPI_IN_PLACE, &min_hash, 1, MPI_UNSIGNED_LONG_LONG, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, &max_hash, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+    if (min_hash != max_hash) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "Distributed router: the ranks have different placements or RR graphs"
+                        " (use the same inputs and options, and a deterministic placer)\n");
+    }
+}
+
+void pack_net_routing(std::vector<int>& buffer, ParentNetId net_id, int flags) {
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    if (route_ctx.net_status.is_routed(net_id)) {
+        flags |= DISTRIBUTED_NET_IS_ROUTED;
+    }
+    const t_bb& bb = route_ctx.route_bb[net_id];
+    buffer.insert(buffer.end(), {int(size_t(net_id)), flags, bb.xmin, bb.xmax, bb.ymin, bb.ymax, bb.layer_min, bb.layer_max});
+
+    /* Same flat form as the route checkpoints (see route_checkpoint.cpp) */
+    size_t num_elements_index = buffer.size();
+    buffer.push_back(0);
+    if (!route_ctx.route_trees[net_id]) {
+        return;
+    }
+    t_trace* head = TracebackCompat::traceback_from_route_tree(route_ctx.route_trees[net_id].value());
+    for (t_trace* tptr = head; tptr; tptr = tptr->next) {
+        buffer.insert(buffer.end(), {tptr->index, tptr->net_pin_index, int(tptr->iswitch)});
+        buffer[num_elements_index]++;
+    }
+    free_traceback(head);
+}
+
+std::vector<int> exchange_net_routings(const std::vector<int>& buffer) {
+    size_t num_ranks = distributed_num_ranks();
+    size_t rank = distributed_rank();
+
+    VTR_ASSERT(buffer.size() <= size_t(std::numeric_limits<int>::max()));
+    int size = buffer.size();
+    std::vector<int> sizes(num_ranks);
+    MPI_Allgather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+    std::vector<int> offsets(num_ranks);
+    size_t total_size = 0;
+    for (size_t irank = 0; irank < num_ranks; irank++) {
+        offsets[irank] = total_size;
+        total_size += sizes[irank];
+        VTR_ASSERT(total_size <= size_t(std::numeric_limits<int>::max()));
+    }
+
+    std::vector<int> all(total_size);
+    MPI_Allgatherv(buffer.data(), size, MPI_INT, all.data(), sizes.data(), offsets.data(), MPI_INT, MPI_COMM_WORLD);
+
+    /* Drop my own routings: they are installed already */
+    all.erase(all.begin() + offsets[rank], all.begin() + offsets[rank] + sizes[rank]);
+    return all;
+}
+
+void unpack_net_routings(const std::vector<int>& buffer,
+                         const Netlist<>& net_list,
+                         const t_router_opts& router_opts,
+                         CBRR& connections_inf,
+                         NetPinsMatrix<float>& net_delay,
+                         TimingInfo* timing_info,
+                         NetPinTimingInvalidator* pin_timing_invalidator,
+                         std::vector<ParentNetId>& rerouted_nets,
+                         std::vector<ParentNetId>& bb_updated_nets) {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    size_t pos = 0;
+    while (pos < buffer.size()) {
+        VTR_ASSERT(pos + NET_ROUTING_HEADER_SIZE <= buffer.size());
+        ParentNetId net_id(buffer[pos]);
+        int flags = buffer[pos + 1];
+        t_bb bb;
+        bb.xmin = buffer[pos + 2];
+        bb.xmax = buffer[pos + 3];
+        bb.ymin = buffer[pos + 4];
+        bb.ymax = buffer[pos + 5];
+        bb.layer_min = buffer[pos + 6];
+        bb.layer_max = buffer[pos + 7];
+        size_t num_elements = buffer[pos + 8];
+        pos += NET_ROUTING_HEADER_SIZE;
+        VTR_ASSERT(pos + 3 * num_elements <= buffer.size());
+
+        /* Rip up my copy of the routing and replace it with the one of the rank which routed the net */
+        vtr::optional<RouteTree>& tree = route_ctx.route_trees[net_id];
+        if (tree) {
+            pathfinder_update_cost_from_route_tree(tree.value().root(), -1);
+        }
+        tree = vtr::nullopt;
+
+        t_trace* head = nullptr;
+        t_trace* tail = nullptr;
+        for (size_t ielement = 0; ielement < num_elements; ielement++, pos += 3) {
+            t_trace* tptr = alloc_trace_data();
+            tptr->index = buffer[pos];
+            tptr->net_pin_index = buffer[pos + 1];
+            tptr->iswitch = buffer[pos + 2];
+            tptr->next = nullptr;
+            if (tail) {
+                tail->next = tptr;
+            } else {
+                head = tptr;
+            }
+            tail = tptr;
+        }
+        tree = TracebackCompat::traceback_to_route_tree(head, net_id);
+        free_traceback(head);
+
+        route_ctx.route_bb[net_id] = bb;
+        route_ctx.net_status.set_is_routed(net_id, flags & DISTRIBUTED_NET_IS_ROUTED);
+        if (tree) {
+            pathfinder_update_cost_from_route_tree(tree.value().root(), 1);
+
+            float* delays = net_delay[net_id].data();
+            update_net_delays_from_route_tree(delays, net_list, net_id, timing_info, pin_timing_invalidator);
+            if (router_opts.update_lower_bound_delays) {
+                for (int isink : tree.value().get_reached_isinks()) {
+                    connections_inf.update_lower_bound_connection_delay(net_id, isink, delays[isink]);
+                }
+            }
+        }
+
+        if (flags & DISTRIBUTED_NET_REROUTED) {
+            rerouted_nets.push_back(net_id);
+        }
+        if (flags & DISTRIBUTED_NET_BB_UPDATED) {
+            bb_updated_nets.push_back(net_id);
+        }
+    }
+}
+
+void reduce_router_stats(RouterStats& stats) {
+    std::vector<size_t*> counters = {&stats.connections_routed, &stats.connections_reused, &stats.nets_routed,
+                                     &stats.heap_pushes, &stats.heap_pops,
+                                     &stats.inter_cluster_node_pushes, &stats.inter_cluster_node_pops,
+                                     &stats.intra_cluster_node_pushes, &stats.intra_cluster_node_pops,
+                                     &stats.heap_stale_pops, &stats.wasted_expansions,
+                                     &stats.heap_lock_contention, &stats.node_lock_contention,
+                                     &stats.lookahead_cache_hits, &stats.lookahead_cache_misses};
+    for (e_rr_type rr_type : RR_TYPES) {
+        counters.push_back(&stats.inter_cluster_node_type_cnt_pushes[rr_type]);
+        counters.push_back(&stats.inter_cluster_node_type_cnt_pops[rr_type]);
+        counters.push_back(&stats.intra_cluster_node_type_cnt_pushes[rr_type]);
+        counters.push_back(&stats.intra_cluster_node_type_cnt_pops[rr_type]);
+        counters.push_back(&stats.rt_node_pushes[rr_type]);
+    }
+
+    std::vector<unsigned long long> values;
+    for (size_t* counter : counters) {
+        values.push_back(*counter);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(), MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+    for (size_t i = 0; i < counters.size(); i++) {
+        *counters[i] = values[i];
+    }
+}
+
+bool distributed_all_of(bool x) {
+    int value = x;
+    MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+    return value;
+}
+
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+/** @file Communication between the MPI ranks of the distributed router (see DistributedNetlistRouter.h).
+ *
+ * A rank sends the routing of the nets it routed in a wave as a flat buffer of ints. For each net:
+ *
+ *      net ID, flags (DistributedNetFlags), route bounding box (6 ints), number of traceback elements,
+ *      then (RR node, net pin index, switch) for each traceback element
+ *
+ * which every other rank installs in its own routing context in place of its (stale) routing of the net. */
+
+#ifdef VPR_USE_MPI
+
+#include <vector>
+
+#include "connection_based_routing.h"
+#include "netlist.h"
+#include "NetPinTimingInvalidator.h"
+#include "router_stats.h"
+#include "timing_info.h"
+#include "vpr_net_pins_matrix.h"
+
+/** What changed about a net sent to the other ranks */
+enum DistributedNetFlags {
+    DISTRIBUTED_NET_REROUTED = 1,   ///< The routing of the net changed
+    DISTRIBUTED_NET_BB_UPDATED = 2, ///< The route bounding box of the net grew
+    DISTRIBUTED_NET_IS_ROUTED = 4,  ///< The net is fully routed (see t_net_routing_status)
+};
+
+/** Starts MPI if it isn't running yet (it is then finalized at exit) */
+void init_distributed_routing();
+
+/** Rank of this process */
+size_t distributed_rank();
+
+/** Number of ranks routing together */
+size_t distributed_num_ranks();
+
+/** Fatal error unless every rank routes the same problem (placement, RR graph and nets): the ranks
+ * only exchange the routing of the nets, so everything else has to be the same already. */
+void check_distributed_routing_inputs(const Netlist<>& net_list);
+
+/** Appends the current routing of \p net_id (route tree, bounding box and status) to \p buffer */
+void pack_net_routing(std::vector<int>& buffer, ParentNetId net_id, int flags);
+
+/** Sends \p buffer to all the other ranks. \return their buffers, concatenated in rank order */
+std::vector<int> exchange_net_routings(const std::vector<int>& buffer);
+
+/** Installs the routings of nets packed by other ranks in \p buffer: updates the occupancy of the RR
+ * nodes, the route trees, the net delays (invalidating the timing of the changed connections) and the
+ * bounding boxes. The nets rerouted and with grown bounding boxes are added to \p rerouted_nets and
+ * \p bb_updated_nets. */
+void unpack_net_routings(const std::vector<int>& buffer,
+                         const Netlist<>& net_list,
+                         const t_router_opts& router_opts,
+                         CBRR& connections_inf,
+                         NetPinsMatrix<float>& net_delay,
+                         TimingInfo* timing_info,
+                         NetPinTimingInvalidator* pin_timing_invalidator,
+                         std::vector<ParentNetId>& rerouted_nets,
+                         std::vector<ParentNetId>& bb_updated_nets);
+
+/** Sums the stats of all ranks (except the net profiles, which stay on the rank which routed the net) */
+void reduce_router_stats(RouterStats& stats);
+
+/** \return Is \p x true on all ranks? */
+bool distributed_all_of(bool x);
+
+#endif
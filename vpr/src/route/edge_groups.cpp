@@ -1,14 +1,16 @@
 #include "edge_groups.h"
 
-#include <stack>
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
 #include "rr_graph_fwd.h"
 #include "vpr_context.h"
 
 // Adds non-configurable (undirected) edge to be grouped.
 //
-// Returns true if this is a new edge.
-bool EdgeGroups::add_non_config_edge(RRNodeId from_node, RRNodeId to_node) {
-    return graph_[from_node].edges.insert(to_node).second && graph_[to_node].edges.insert(from_node).second;
+// Duplicate edges are allowed: they are merged by create_sets.
+void EdgeGroups::add_non_config_edge(RRNodeId from_node, RRNodeId to_node) {
+    edges_.emplace_back(from_node, to_node);
 }
 
 // After add_non_config_edge has been called for all edges, create_sets
@@ -17,31 +19,56 @@ bool EdgeGroups::add_non_config_edge(RRNodeId from_node, RRNodeId to_node) {
 void EdgeGroups::create_sets() {
     rr_non_config_node_sets_.clear();
 
-    // https://en.wikipedia.org/wiki/Component_(graph_theory)#Algorithms
-    std::vector<size_t> group_size;
-    for (auto& node : graph_) {
-        if (node.second.set == UNDEFINED) {
-            node.second.set = group_size.size();
-            group_size.push_back(add_connected_group(node.second));
-        }
+    nodes_.clear();
+    nodes_.reserve(2 * edges_.size());
+    for (const auto& edge : edges_) {
+        nodes_.push_back(edge.first);
+        nodes_.push_back(edge.second);
     }
+    std::sort(nodes_.begin(), nodes_.end());
+    nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
 
-    // Sanity check the node sets.
-    for (const auto& node : graph_) {
-        VTR_ASSERT(node.second.set != UNDEFINED);
-        for (const auto& e : node.second.edges) {
-            int set = graph_[e].set;
-            VTR_ASSERT(set == node.second.set);
+    // Union by size with path halving
+    std::vector<size_t> parent(nodes_.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    std::vector<size_t> size(nodes_.size(), 1);
+    auto find_root = [&](size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    for (const auto& edge : edges_) {
+        size_t root1 = find_root(node_index(edge.first));
+        size_t root2 = find_root(node_index(edge.second));
+        if (root1 == root2) {
+            continue;
+        }
+        if (size[root1] < size[root2]) {
+            std::swap(root1, root2);
         }
+        parent[root2] = root1;
+        size[root1] += size[root2];
     }
 
-    // Create compact set of sets.
-    rr_non_config_node_sets_.resize(group_size.size());
-    for (size_t i = 0; i < group_size.size(); i++) {
-        rr_non_config_node_sets_[i].reserve(group_size[i]);
+    // Number the sets in order of their smallest node, so the sets don't depend on the order of the edges
+    std::vector<int> root_set(nodes_.size(), UNDEFINED);
+    node_sets_.assign(nodes_.size(), UNDEFINED);
+    for (size_t i = 0; i < nodes_.size(); i++) {
+        size_t root = find_root(i);
+        if (root_set[root] == UNDEFINED) {
+            root_set[root] = rr_non_config_node_sets_.size();
+            rr_non_config_node_sets_.emplace_back();
+            rr_non_config_node_sets_.back().reserve(size[root]);
+        }
+        node_sets_[i] = root_set[root];
+        rr_non_config_node_sets_[root_set[root]].push_back(nodes_[i]);
     }
-    for (const auto& node : graph_) {
-        rr_non_config_node_sets_[node.second.set].push_back(node.first);
+
+    // Sanity check the node sets.
+    for (const auto& edge : edges_) {
+        VTR_ASSERT(node_sets_[node_index(edge.first)] == node_sets_[node_index(edge.second)]);
     }
 }
 
@@ -49,18 +76,15 @@ void EdgeGroups::create_sets() {
 // NOTE: The stored graph is undirected, so this may generate reverse edges that don't exist.
 t_non_configurable_rr_sets EdgeGroups::output_sets() {
     t_non_configurable_rr_sets sets;
+    sets.edge_sets.resize(rr_non_config_node_sets_.size());
     for (const auto& nodes : rr_non_config_node_sets_) {
-        std::set<t_node_edge> edge_set;
-        std::set<RRNodeId> node_set(nodes.begin(), nodes.end());
-
-        for (const RRNodeId src : node_set) {
-            for (const RRNodeId dest : graph_[src].edges) {
-                edge_set.emplace(src, dest);
-            }
-        }
+        sets.node_sets.emplace_back(nodes.begin(), nodes.end());
+    }
 
-        sets.node_sets.emplace_back(std::move(node_set));
-        sets.edge_sets.emplace_back(std::move(edge_set));
+    for (const auto& edge : edges_) {
+        std::set<t_node_edge>& edge_set = sets.edge_sets[node_sets_[node_index(edge.first)]];
+        edge_set.emplace(edge.first, edge.second);
+        edge_set.emplace(edge.second, edge.first);
     }
 
     return sets;
@@ -68,42 +92,19 @@ t_non_configurable_rr_sets EdgeGroups::output_sets() {
 
 // Set device context structures for non-configurable node sets.
 void EdgeGroups::set_device_context(DeviceContext& device_ctx) {
-    std::vector<std::vector<RRNodeId>> rr_non_config_node_sets;
-    for (const auto& item : rr_non_config_node_sets_) {
-        rr_non_config_node_sets.emplace_back(std::move(item));
-    }
-
     std::unordered_map<RRNodeId, int> rr_node_to_non_config_node_set;
-    for (size_t set = 0; set < rr_non_config_node_sets.size(); ++set) {
-        for (const auto inode : rr_non_config_node_sets[set]) {
-            rr_node_to_non_config_node_set.insert(
-                std::make_pair(inode, set));
-        }
+    rr_node_to_non_config_node_set.reserve(nodes_.size());
+    for (size_t i = 0; i < nodes_.size(); i++) {
+        rr_node_to_non_config_node_set.emplace(nodes_[i], node_sets_[i]);
     }
 
-    device_ctx.rr_non_config_node_sets = std::move(rr_non_config_node_sets);
+    device_ctx.rr_non_config_node_sets = rr_non_config_node_sets_;
     device_ctx.rr_node_to_non_config_node_set = std::move(rr_node_to_non_config_node_set);
 }
 
-// Perform a DFS traversal marking everything reachable with the same set id
-size_t EdgeGroups::add_connected_group(const node_data& node) {
-    // stack contains nodes with edges to mark with node.set
-    // The set for each node must be set before pushing it onto the stack
-    std::stack<const node_data*> stack;
-    stack.push(&node);
-    size_t n = 1;
-    while (!stack.empty()) {
-        auto top = stack.top();
-        stack.pop();
-        for (auto e : top->edges) {
-            auto& next = graph_[e];
-            if (next.set != node.set) {
-                VTR_ASSERT(next.set == UNDEFINED);
-                n++;
-                next.set = node.set;
-                stack.push(&next);
-            }
-        }
-    }
-    return n;
+// Index of node in nodes_
+size_t EdgeGroups::node_index(RRNodeId node) const {
+    auto it = std::lower_bound(nodes_.begin(), nodes_.end(), node);
+    VTR_ASSERT_SAFE(it != nodes_.end() && *it == node);
+    return it - nodes_.begin();
 }
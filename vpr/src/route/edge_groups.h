@@ -1,8 +1,7 @@
 #pragma once
 
-#include <unordered_set>
-#include <unordered_map>
 #include <vector>
+#include <utility>
 #include <cstddef>
 
 #include "vpr_types.h"
@@ -18,15 +17,20 @@ struct DeviceContext;
 // non-configurable edges, because a connection to one node
 // must connect them all.
 //
+// The components are found with a union-find over the nodes
+// touched by the edges, so the cost is close to linear in the
+// number of non-configurable edges.
+//
 // https://en.wikipedia.org/wiki/Component_(graph_theory)
+// https://en.wikipedia.org/wiki/Disjoint-set_data_structure
 class EdgeGroups {
   public:
     EdgeGroups() {}
 
     // Adds non-configurable (undirected) edge to be grouped.
     //
-    // Returns true if this is a new edge.
-    bool add_non_config_edge(RRNodeId from_node, RRNodeId to_node);
+    // Duplicate edges are allowed: they are merged by create_sets.
+    void add_non_config_edge(RRNodeId from_node, RRNodeId to_node);
 
     // After add_non_config_edge has been called for all edges, create_sets
     // will form groups of nodes that are connected via non-configurable
@@ -41,18 +45,17 @@ class EdgeGroups {
     void set_device_context(DeviceContext& device_ctx);
 
   private:
-    struct node_data {
-        std::unordered_set<RRNodeId> edges; // Set of indices into graph_
-        int set = UNDEFINED;                // Index into rr_non_config_node_sets_
-    };
+    // Index of node in nodes_
+    size_t node_index(RRNodeId node) const;
 
-    // Perform a DFS traversal marking everything reachable with the same set id
-    size_t add_connected_group(const node_data& node);
+    // Non-configurable edges, as added.
+    std::vector<std::pair<RRNodeId, RRNodeId>> edges_;
 
-    // Set of non-configurable edges.
-    std::unordered_map<RRNodeId, node_data> graph_;
+    // Nodes touched by edges_, sorted, and the set of each (index into rr_non_config_node_sets_).
+    std::vector<RRNodeId> nodes_;
+    std::vector<int> node_sets_;
 
     // Connected components, representing nodes connected by non-configurable edges.
-    // Order is arbitrary.
+    // Ordered by smallest node, each sorted.
     std::vector<std::vector<RRNodeId>> rr_non_config_node_sets_;
 };
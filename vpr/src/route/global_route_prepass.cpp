@@ -0,0 +1,379 @@
+#include "global_route_prepass.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include "globals.h"
+#include "route_common.h"
+#include "route_utilization.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/** Number of negotiated congestion iterations of the global routing */
+static constexpr int GLOBAL_ROUTE_MAX_ITERATIONS = 6;
+/** Present congestion factor of the first iteration, and its multiplier between iterations */
+static constexpr float GLOBAL_ROUTE_INITIAL_PRES_FAC = 0.5;
+static constexpr float GLOBAL_ROUTE_PRES_FAC_MULT = 2.;
+/** Historical congestion cost added per unit of overuse after each iteration */
+static constexpr float GLOBAL_ROUTE_HIST_FAC = 0.5;
+/** The maze routing of a net is limited to its terminals' bounding box, expanded by this many GCells */
+static constexpr int GLOBAL_ROUTE_WINDOW_MARGIN = 2;
+/** The corridor of a net is its global route's bounding box, expanded by this many GCells */
+static constexpr int GLOBAL_ROUTE_CORRIDOR_MARGIN = 1;
+
+GlobalRoutePrepass::GlobalRoutePrepass(const Netlist<>& net_list, int gcell_size)
+    : net_list_(net_list)
+    , gcell_size_(gcell_size) {
+    const auto& grid = g_vpr_ctx.device().grid;
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    const int width = grid.width();
+    const int height = grid.height();
+    num_gcells_x_ = (width + gcell_size_ - 1) / gcell_size_;
+    num_gcells_y_ = (height + gcell_size_ - 1) / gcell_size_;
+    num_horizontal_edges_ = (num_gcells_x_ - 1) * num_gcells_y_;
+    const int num_edges = num_horizontal_edges_ + num_gcells_x_ * (num_gcells_y_ - 1);
+
+    // A track crosses the boundary between two GCells if it is present on both sides of it
+    vtr::Matrix<float> chanx_avail = calculate_routing_avail(e_rr_type::CHANX);
+    vtr::Matrix<float> chany_avail = calculate_routing_avail(e_rr_type::CHANY);
+
+    edge_capacity_.assign(num_edges, 0.);
+    for (int gy = 0; gy < num_gcells_y_; gy++) {
+        const int y_end = std::min((gy + 1) * gcell_size_, height);
+        for (int gx = 0; gx + 1 < num_gcells_x_; gx++) {
+            const int x = (gx + 1) * gcell_size_ - 1;
+            float capacity = 0.;
+            for (int y = gy * gcell_size_; y < y_end; y++) {
+                capacity += std::min(chanx_avail[x][y], chanx_avail[x + 1][y]);
+            }
+            edge_capacity_[horizontal_edge(gx, gy)] = capacity;
+        }
+    }
+    for (int gx = 0; gx < num_gcells_x_; gx++) {
+        const int x_end = std::min((gx + 1) * gcell_size_, width);
+        for (int gy = 0; gy + 1 < num_gcells_y_; gy++) {
+            const int y = (gy + 1) * gcell_size_ - 1;
+            float capacity = 0.;
+            for (int x = gx * gcell_size_; x < x_end; x++) {
+                capacity += std::min(chany_avail[x][y], chany_avail[x][y + 1]);
+            }
+            edge_capacity_[vertical_edge(gx, gy)] = capacity;
+        }
+    }
+    edge_demand_.assign(num_edges, 0);
+    edge_history_.assign(num_edges, 0.);
+
+    net_edges_.resize(net_list_.nets().size());
+    net_gcells_.resize(net_list_.nets().size());
+    net_is_routed_.resize(net_list_.nets().size(), false);
+    for (ParentNetId net_id : net_list_.nets()) {
+        net_is_routed_[net_id] = !net_list_.net_is_ignored(net_id) && !route_ctx.is_clock_net[net_id];
+    }
+
+    const size_t num_gcells = size_t(num_gcells_x_) * num_gcells_y_;
+    path_cost_.assign(num_gcells, std::numeric_limits<float>::infinity());
+    prev_edge_.assign(num_gcells, -1);
+    prev_gcell_.assign(num_gcells, -1);
+    in_tree_.assign(num_gcells, false);
+}
+
+int GlobalRoutePrepass::route(int max_iterations) {
+    float pres_fac = GLOBAL_ROUTE_INITIAL_PRES_FAC;
+    for (ParentNetId net_id : net_list_.nets()) {
+        if (net_is_routed_[net_id]) {
+            route_net(net_id, pres_fac);
+        }
+    }
+
+    int iteration = 1;
+    for (; iteration < max_iterations && num_overused_edges() > 0; iteration++) {
+        for (size_t edge = 0; edge < edge_demand_.size(); edge++) {
+            edge_history_[edge] += GLOBAL_ROUTE_HIST_FAC * std::max(0.f, edge_demand_[edge] - edge_capacity_[edge]);
+        }
+        pres_fac *= GLOBAL_ROUTE_PRES_FAC_MULT;
+
+        // Only the nets through overused edges are re-routed, the others already found uncongested routes
+        std::vector<ParentNetId> congested_nets;
+        for (ParentNetId net_id : net_list_.nets()) {
+            if (net_is_routed_[net_id] && net_uses_overused_edge(net_id)) {
+                congested_nets.push_back(net_id);
+            }
+        }
+        for (ParentNetId net_id : congested_nets) {
+            rip_up_net(net_id);
+            route_net(net_id, pres_fac);
+        }
+    }
+    return iteration;
+}
+
+size_t GlobalRoutePrepass::num_overused_edges() const {
+    size_t num_overused = 0;
+    for (size_t edge = 0; edge < edge_demand_.size(); edge++) {
+        num_overused += (edge_demand_[edge] > edge_capacity_[edge]);
+    }
+    return num_overused;
+}
+
+double GlobalRoutePrepass::average_edge_util() const {
+    double total_demand = 0.;
+    double total_capacity = 0.;
+    for (size_t edge = 0; edge < edge_demand_.size(); edge++) {
+        total_demand += edge_demand_[edge];
+        total_capacity += edge_capacity_[edge];
+    }
+    return total_capacity > 0. ? total_demand / total_capacity : 0.;
+}
+
+t_bb GlobalRoutePrepass::net_corridor(ParentNetId net_id) const {
+    const auto& grid = g_vpr_ctx.device().grid;
+
+    vtr::Rect<int> gcell_bb = net_terminal_gcell_bb(net_id);
+    for (int gcell : net_gcells_[net_id]) {
+        gcell_bb.expand_bounding_box({gcell_x(gcell), gcell_y(gcell), gcell_x(gcell), gcell_y(gcell)});
+    }
+
+    t_bb corridor;
+    corridor.xmin = std::max(gcell_bb.xmin() - GLOBAL_ROUTE_CORRIDOR_MARGIN, 0) * gcell_size_;
+    corridor.ymin = std::max(gcell_bb.ymin() - GLOBAL_ROUTE_CORRIDOR_MARGIN, 0) * gcell_size_;
+    corridor.xmax = std::min((gcell_bb.xmax() + GLOBAL_ROUTE_CORRIDOR_MARGIN + 1) * gcell_size_, int(grid.width())) - 1;
+    corridor.ymax = std::min((gcell_bb.ymax() + GLOBAL_ROUTE_CORRIDOR_MARGIN + 1) * gcell_size_, int(grid.height())) - 1;
+    corridor.layer_min = 0;
+    corridor.layer_max = grid.get_num_layers() - 1;
+    return corridor;
+}
+
+std::pair<vtr::NdMatrix<double, 3>, vtr::NdMatrix<double, 3>> GlobalRoutePrepass::estimate_routing_chan_util() const {
+    const auto& grid = g_vpr_ctx.device().grid;
+    const size_t num_layers = grid.get_num_layers();
+
+    auto chanx_util = vtr::NdMatrix<double, 3>({{num_layers, grid.width(), grid.height()}}, 0.);
+    auto chany_util = vtr::NdMatrix<double, 3>({{num_layers, grid.width(), grid.height()}}, 0.);
+
+    auto edge_util = [&](int edge) -> double {
+        if (edge_capacity_[edge] > 0.) {
+            return edge_demand_[edge] / edge_capacity_[edge];
+        }
+        return edge_demand_[edge]; // Any use of an edge without tracks is an overuse
+    };
+
+    for (int gx = 0; gx < num_gcells_x_; gx++) {
+        for (int gy = 0; gy < num_gcells_y_; gy++) {
+            // The utilization of a GCell in each direction is the average of its edges in that direction
+            double x_util = 0.;
+            int num_x_edges = 0;
+            if (gx > 0) {
+                x_util += edge_util(horizontal_edge(gx - 1, gy));
+                num_x_edges++;
+            }
+            if (gx + 1 < num_gcells_x_) {
+                x_util += edge_util(horizontal_edge(gx, gy));
+                num_x_edges++;
+            }
+            double y_util = 0.;
+            int num_y_edges = 0;
+            if (gy > 0) {
+                y_util += edge_util(vertical_edge(gx, gy - 1));
+                num_y_edges++;
+            }
+            if (gy + 1 < num_gcells_y_) {
+                y_util += edge_util(vertical_edge(gx, gy));
+                num_y_edges++;
+            }
+            x_util = num_x_edges > 0 ? x_util / num_x_edges : 0.;
+            y_util = num_y_edges > 0 ? y_util / num_y_edges : 0.;
+
+            const int x_end = std::min((gx + 1) * gcell_size_, int(grid.width()));
+            const int y_end = std::min((gy + 1) * gcell_size_, int(grid.height()));
+            for (size_t layer = 0; layer < num_layers; layer++) {
+                for (int x = gx * gcell_size_; x < x_end; x++) {
+                    for (int y = gy * gcell_size_; y < y_end; y++) {
+                        chanx_util[layer][x][y] = x_util;
+                        chany_util[layer][x][y] = y_util;
+                    }
+                }
+            }
+        }
+    }
+
+    return {chanx_util, chany_util};
+}
+
+int GlobalRoutePrepass::gcell_at(int x, int y) const {
+    return (y / gcell_size_) * num_gcells_x_ + x / gcell_size_;
+}
+
+float GlobalRoutePrepass::edge_cost(int edge, float pres_fac) const {
+    const float overuse = std::max(0.f, edge_demand_[edge] + 1 - edge_capacity_[edge]);
+    return (1.f + edge_history_[edge]) * (1.f + pres_fac * overuse);
+}
+
+vtr::Rect<int> GlobalRoutePrepass::net_terminal_gcell_bb(ParentNetId net_id) const {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& terminals = g_vpr_ctx.routing().net_rr_terminals[net_id];
+
+    // Start from the source, since an empty (default) Rect would contain the origin
+    int source = gcell_at(rr_graph.node_xlow(terminals[0]), rr_graph.node_ylow(terminals[0]));
+    vtr::Rect<int> gcell_bb(gcell_x(source), gcell_y(source), gcell_x(source), gcell_y(source));
+    for (RRNodeId terminal : terminals) {
+        int gcell = gcell_at(rr_graph.node_xlow(terminal), rr_graph.node_ylow(terminal));
+        gcell_bb.expand_bounding_box({gcell_x(gcell), gcell_y(gcell), gcell_x(gcell), gcell_y(gcell)});
+    }
+    return gcell_bb;
+}
+
+void GlobalRoutePrepass::route_net(ParentNetId net_id, float pres_fac) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& terminals = g_vpr_ctx.routing().net_rr_terminals[net_id];
+
+    std::vector<int>& net_gcells = net_gcells_[net_id];
+    VTR_ASSERT_SAFE(net_gcells.empty() && net_edges_[net_id].empty());
+
+    const int source = gcell_at(rr_graph.node_xlow(terminals[0]), rr_graph.node_ylow(terminals[0]));
+    net_gcells.push_back(source);
+    in_tree_[source] = true;
+
+    // Closest sinks first, so that the tree grows outwards from the source
+    auto distance_to_source = [&](int gcell) {
+        return std::abs(gcell_x(gcell) - gcell_x(source)) + std::abs(gcell_y(gcell) - gcell_y(source));
+    };
+    std::vector<int> sinks;
+    for (size_t ipin = 1; ipin < terminals.size(); ipin++) {
+        sinks.push_back(gcell_at(rr_graph.node_xlow(terminals[ipin]), rr_graph.node_ylow(terminals[ipin])));
+    }
+    std::sort(sinks.begin(), sinks.end(), [&](int lhs, int rhs) {
+        return std::make_pair(distance_to_source(lhs), lhs) < std::make_pair(distance_to_source(rhs), rhs);
+    });
+
+    vtr::Rect<int> window = net_terminal_gcell_bb(net_id);
+    window = vtr::Rect<int>(std::max(window.xmin() - GLOBAL_ROUTE_WINDOW_MARGIN, 0),
+                            std::max(window.ymin() - GLOBAL_ROUTE_WINDOW_MARGIN, 0),
+                            std::min(window.xmax() + GLOBAL_ROUTE_WINDOW_MARGIN, num_gcells_x_ - 1),
+                            std::min(window.ymax() + GLOBAL_ROUTE_WINDOW_MARGIN, num_gcells_y_ - 1));
+
+    for (int sink : sinks) {
+        if (!in_tree_[sink]) {
+            route_to_gcell(net_id, sink, window, pres_fac);
+        }
+    }
+
+    for (int gcell : net_gcells) {
+        in_tree_[gcell] = false;
+    }
+}
+
+void GlobalRoutePrepass::route_to_gcell(ParentNetId net_id, int target, const vtr::Rect<int>& window, float pres_fac) {
+    typedef std::pair<float, int> t_queue_entry; // (cost + expected cost to the target, gcell)
+    std::priority_queue<t_queue_entry, std::vector<t_queue_entry>, std::greater<t_queue_entry>> queue;
+
+    const int target_x = gcell_x(target);
+    const int target_y = gcell_y(target);
+    // Every edge costs at least 1, so the Manhattan distance never overestimates the remaining cost
+    auto expected_cost = [&](int gcell) {
+        return float(std::abs(gcell_x(gcell) - target_x) + std::abs(gcell_y(gcell) - target_y));
+    };
+
+    for (int gcell : net_gcells_[net_id]) {
+        path_cost_[gcell] = 0.;
+        prev_edge_[gcell] = -1;
+        touched_gcells_.push_back(gcell);
+        queue.push({expected_cost(gcell), gcell});
+    }
+
+    while (!queue.empty()) {
+        const auto [total_cost, gcell] = queue.top();
+        queue.pop();
+        if (gcell == target) {
+            break;
+        }
+        const float cost = path_cost_[gcell];
+        if (total_cost > cost + expected_cost(gcell)) {
+            continue; // Stale entry, the gcell was reached more cheaply since
+        }
+
+        const int gx = gcell_x(gcell);
+        const int gy = gcell_y(gcell);
+        auto expand = [&](int neighbour, int edge) {
+            float new_cost = cost + edge_cost(edge, pres_fac);
+            if (new_cost < path_cost_[neighbour]) {
+                if (std::isinf(path_cost_[neighbour])) {
+                    touched_gcells_.push_back(neighbour);
+                }
+                path_cost_[neighbour] = new_cost;
+                prev_edge_[neighbour] = edge;
+                prev_gcell_[neighbour] = gcell;
+                queue.push({new_cost + expected_cost(neighbour), neighbour});
+            }
+        };
+        if (gx > window.xmin()) expand(gcell - 1, horizontal_edge(gx - 1, gy));
+        if (gx < window.xmax()) expand(gcell + 1, horizontal_edge(gx, gy));
+        if (gy > window.ymin()) expand(gcell - num_gcells_x_, vertical_edge(gx, gy - 1));
+        if (gy < window.ymax()) expand(gcell + num_gcells_x_, vertical_edge(gx, gy));
+    }
+
+    // The window is connected and contains the tree and the target, so the target is always reached
+    VTR_ASSERT(!std::isinf(path_cost_[target]));
+    for (int gcell = target; !in_tree_[gcell]; gcell = prev_gcell_[gcell]) {
+        in_tree_[gcell] = true;
+        net_gcells_[net_id].push_back(gcell);
+        net_edges_[net_id].push_back(prev_edge_[gcell]);
+        edge_demand_[prev_edge_[gcell]]++;
+    }
+
+    for (int gcell : touched_gcells_) {
+        path_cost_[gcell] = std::numeric_limits<float>::infinity();
+    }
+    touched_gcells_.clear();
+}
+
+void GlobalRoutePrepass::rip_up_net(ParentNetId net_id) {
+    for (int edge : net_edges_[net_id]) {
+        edge_demand_[edge]--;
+    }
+    net_edges_[net_id].clear();
+    net_gcells_[net_id].clear();
+}
+
+bool GlobalRoutePrepass::net_uses_overused_edge(ParentNetId net_id) const {
+    return std::any_of(net_edges_[net_id].begin(), net_edges_[net_id].end(), [&](int edge) {
+        return edge_demand_[edge] > edge_capacity_[edge];
+    });
+}
+
+void run_global_route_prepass(const Netlist<>& net_list, const t_router_opts& router_opts) {
+    vtr::ScopedStartFinishTimer timer("Global routing pre-pass");
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    GlobalRoutePrepass global_route(net_list, router_opts.global_route_gcell_size);
+    int num_iterations = global_route.route(GLOBAL_ROUTE_MAX_ITERATIONS);
+    VTR_LOG("Global routing on %dx%d tile cells: %d iterations, %zu overused cell edges, average cell edge utilization %.3f\n",
+            router_opts.global_route_gcell_size, router_opts.global_route_gcell_size,
+            num_iterations, global_route.num_overused_edges(), global_route.average_edge_util());
+
+    // The corridor only tightens the bounding box, and always keeps the net's terminals
+    size_t num_tightened_bbs = 0;
+    for (ParentNetId net_id : net_list.nets()) {
+        if (net_list.net_is_ignored(net_id) || route_ctx.is_clock_net[net_id]) {
+            continue;
+        }
+        const t_bb corridor = global_route.net_corridor(net_id);
+        const t_bb terminal_bb = load_net_route_bb(net_list, net_id, 0);
+        t_bb& route_bb = route_ctx.route_bb[net_id];
+        const int prev_area = (route_bb.xmax - route_bb.xmin + 1) * (route_bb.ymax - route_bb.ymin + 1);
+
+        route_bb.xmin = std::max(route_bb.xmin, std::min(corridor.xmin, terminal_bb.xmin));
+        route_bb.ymin = std::max(route_bb.ymin, std::min(corridor.ymin, terminal_bb.ymin));
+        route_bb.xmax = std::min(route_bb.xmax, std::max(corridor.xmax, terminal_bb.xmax));
+        route_bb.ymax = std::min(route_bb.ymax, std::max(corridor.ymax, terminal_bb.ymax));
+
+        num_tightened_bbs += ((route_bb.xmax - route_bb.xmin + 1) * (route_bb.ymax - route_bb.ymin + 1) < prev_area);
+    }
+    VTR_LOG("Tightened the routing bounding boxes of %zu nets to their global routing corridor\n", num_tightened_bbs);
+
+    const auto [chanx_util, chany_util] = global_route.estimate_routing_chan_util();
+    load_initial_acc_cost(router_opts, chanx_util, chany_util);
+}
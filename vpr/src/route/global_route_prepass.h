@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+ * @file
+ * @brief A fast global routing of the nets on a coarse grid, run before the detailed (PathFinder) routing.
+ *
+ * The device grid is divided into square cells (GCells) of gcell_size x gcell_size tiles. Two adjacent
+ * GCells are connected by an edge whose capacity is the number of CHANX (or CHANY) tracks of the RR graph
+ * crossing their common boundary. Every net is routed as a tree of GCells connecting its terminals,
+ * with a few iterations of negotiated congestion (rip-up and re-route of the nets using overused edges).
+ *
+ * The global routing gives the detailed router:
+ *  - a corridor per net, i.e. the tiles covered by its global route (plus a margin), which is a
+ *    tighter bounding box than the bb_factor expansion of the net's terminals, and
+ *  - a channel utilization map (demand over capacity of the GCell edges), which replaces the
+ *    placement-based estimate used to seed the initial acc_cost of the congested channels.
+ */
+
+#include <utility>
+#include <vector>
+
+#include "netlist.h"
+#include "vpr_types.h"
+#include "vtr_ndmatrix.h"
+
+class GlobalRoutePrepass {
+  public:
+    /** Sets up the GCell grid (and edge capacities) of the current RR graph */
+    GlobalRoutePrepass(const Netlist<>& net_list, int gcell_size);
+
+    /**
+     * @brief Routes all the nets, then re-routes the nets using overused edges until there is
+     *        no overuse or max_iterations iterations were run.
+     * @return The number of iterations run
+     */
+    int route(int max_iterations);
+
+    /** Number of GCell edges whose demand exceeds their capacity */
+    size_t num_overused_edges() const;
+
+    /** Total demand of all the GCell edges over their total capacity */
+    double average_edge_util() const;
+
+    /**
+     * @brief Returns the bounding box (in grid tiles) of the global route of the net, expanded by
+     *        one GCell on each side. Nets which were not globally routed (ignored and clock nets,
+     *        and nets with all terminals in one GCell) return their terminals' GCells, expanded.
+     */
+    t_bb net_corridor(ParentNetId net_id) const;
+
+    /**
+     * @brief Returns the channel utilization estimated by the global routing, in the format of
+     *        RoutingChanUtilEstimator::estimate_routing_chan_util(): the [layer][x][y] CHANX and CHANY
+     *        utilization of each tile, which is the utilization of the edges of the tile's GCell.
+     */
+    std::pair<vtr::NdMatrix<double, 3>, vtr::NdMatrix<double, 3>> estimate_routing_chan_util() const;
+
+  private:
+    int gcell_at(int x, int y) const;
+    int gcell_x(int gcell) const { return gcell % num_gcells_x_; }
+    int gcell_y(int gcell) const { return gcell / num_gcells_x_; }
+
+    /** Edge between gcell (gx, gy) and (gx + 1, gy) */
+    int horizontal_edge(int gx, int gy) const { return gy * (num_gcells_x_ - 1) + gx; }
+    /** Edge between gcell (gx, gy) and (gx, gy + 1) */
+    int vertical_edge(int gx, int gy) const { return num_horizontal_edges_ + gy * num_gcells_x_ + gx; }
+
+    float edge_cost(int edge, float pres_fac) const;
+
+    void route_net(ParentNetId net_id, float pres_fac);
+    void rip_up_net(ParentNetId net_id);
+    bool net_uses_overused_edge(ParentNetId net_id) const;
+
+    /** Adds the cheapest path (within the search window) from the net's current tree to the target GCell to the tree */
+    void route_to_gcell(ParentNetId net_id, int target, const vtr::Rect<int>& window, float pres_fac);
+
+    /** Bounding box (in GCells) of the terminals of the net */
+    vtr::Rect<int> net_terminal_gcell_bb(ParentNetId net_id) const;
+
+    const Netlist<>& net_list_;
+    int gcell_size_;
+    int num_gcells_x_;
+    int num_gcells_y_;
+    int num_horizontal_edges_;
+
+    /* Per GCell edge */
+    std::vector<float> edge_capacity_;
+    std::vector<int> edge_demand_;
+    std::vector<float> edge_history_;
+
+    /* Per net: the GCell edges and the GCells of its global route */
+    vtr::vector<ParentNetId, std::vector<int>> net_edges_;
+    vtr::vector<ParentNetId, std::vector<int>> net_gcells_;
+    /** Whether the net is globally routed (i.e. not ignored and not a clock) */
+    vtr::vector<ParentNetId, bool> net_is_routed_;
+
+    /* Maze routing scratch space, per GCell */
+    std::vector<float> path_cost_;
+    std::vector<int> prev_edge_;
+    std::vector<int> prev_gcell_;
+    std::vector<bool> in_tree_;
+    std::vector<int> touched_gcells_;
+};
+
+/**
+ * @brief Runs the global routing pre-pass (if router_opts.global_route_prepass is on): tightens the
+ *        routing bounding boxes of the nets to their global routing corridor, and seeds the initial
+ *        acc_cost of the RR nodes from the global routing congestion.
+ *
+ * Must be called after the route bounding boxes and the RR node route structures are initialized
+ * (init_route_structs() and alloc_and_load_rr_node_route_structs()).
+ */
+void run_global_route_prepass(const Netlist<>& net_list, const t_router_opts& router_opts);
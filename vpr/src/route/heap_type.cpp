@@ -1,6 +1,7 @@
 #include "heap_type.h"
 
 #include "vpr_error.h"
+#include "bucket_heap.h"
 #include "d_ary_heap.h"
 
 std::unique_ptr<HeapInterface> make_heap(e_heap_type heap_type) {
@@ -9,7 +10,25 @@ std::unique_ptr<HeapInterface> make_heap(e_heap_type heap_type) {
             return std::make_unique<BinaryHeap>();
         case e_heap_type::FOUR_ARY_HEAP:
             return std::make_unique<FourAryHeap>();
+        case e_heap_type::BUCKET_HEAP:
+            return std::make_unique<BucketHeap>();
         default:
             VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap_type %d", heap_type);
     }
 }
+
+e_heap_type select_heap_type(const DeviceGrid& grid, size_t max_fanout) {
+    // Devices at least this big (in tiles) have wavefronts large enough for the bucket heap
+    constexpr size_t BUCKET_HEAP_MIN_TILES = 200 * 200;
+    // Nets with at least this many sinks span most of the device, so their route trees make
+    // large heaps on smaller devices too
+    constexpr size_t BUCKET_HEAP_MIN_FANOUT = 1000;
+    constexpr size_t BUCKET_HEAP_MIN_TILES_HIGH_FANOUT = BUCKET_HEAP_MIN_TILES / 4;
+
+    size_t num_tiles = grid.width() * grid.height();
+    if (num_tiles >= BUCKET_HEAP_MIN_TILES
+        || (max_fanout >= BUCKET_HEAP_MIN_FANOUT && num_tiles >= BUCKET_HEAP_MIN_TILES_HIGH_FANOUT)) {
+        return e_heap_type::BUCKET_HEAP;
+    }
+    return e_heap_type::FOUR_ARY_HEAP;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include "device_grid.h"
 #include "rr_graph_fwd.h"
 
@@ -109,9 +110,27 @@ enum class e_heap_type {
     INVALID_HEAP = 0,
     BINARY_HEAP,
     FOUR_ARY_HEAP,
+    BUCKET_HEAP,
+    ///@brief Pick one of the above for the netlist and device being routed (see select_heap_type)
+    AUTO_HEAP,
 };
 
 /**
  * @brief Heap factory.
  */
 std::unique_ptr<HeapInterface> make_heap(e_heap_type);
+
+/**
+ * @brief Picks the heap used by the connection router for e_heap_type::AUTO_HEAP.
+ *
+ * The cost of a D-ary heap operation grows with the log of the heap size, the wavefront of the
+ * connection being routed, while the bucket heap's doesn't but has a higher constant overhead.
+ * The wavefront is expected to be large on big devices, where connections are long, and for high
+ * fanout nets, whose route tree is pushed onto the heap for every sink, so the bucket heap is
+ * picked for those and the four-ary heap otherwise. The parallel connection router always uses
+ * a (MultiQueue) four-ary heap.
+ *
+ *   @param grid The FPGA device grid
+ *   @param max_fanout The largest fanout of the nets to route
+ */
+e_heap_type select_heap_type(const DeviceGrid& grid, size_t max_fanout);
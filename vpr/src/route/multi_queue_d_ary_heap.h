@@ -23,6 +23,7 @@
 #include "multi_queue_d_ary_heap.tpp"
 #include <tuple>
 #include <memory>
+#include <vector>
 
 // FIXME: Use unified heap node struct (HeapNodeId) and comparator (HeapNodeComparator)
 // defined in heap_type.h. Currently, the MQ_IO is not compatible with them. Need a lot
@@ -50,10 +51,19 @@ class MultiQueueDAryHeap {
 
     ~MultiQueueDAryHeap() {}
 
-    void set_num_threads_and_queues(size_t num_threads, size_t num_queues) {
+    /**
+     * @brief Sets the MultiQueue parameters (and empties it).
+     *
+     *   @param num_threads The number of threads popping from the heap
+     *   @param num_queues The number of queues (>= 2)
+     *   @param stickiness How many consecutive pops a thread makes from the same queue
+     *   @param pop_batch_size How many nodes try_pop_batch pops from a queue at once
+     */
+    void set_num_threads_and_queues(size_t num_threads, size_t num_queues, size_t stickiness = 1, size_t pop_batch_size = 1) {
         pq_.reset();
         // Note: BE AWARE that in MQ_IO interface, `num_queues` comes first, then `num_threads`!
-        pq_ = std::make_unique<MQ_IO>(num_queues, num_threads, 0 /*Dont care (batch size for only popBatch)*/);
+        pq_ = std::make_unique<MQ_IO>(num_queues, num_threads, pop_batch_size, stickiness);
+        pop_batch_size_ = pop_batch_size;
     }
 
     void init_heap(const DeviceGrid& grid) {
@@ -74,6 +84,30 @@ class MultiQueueDAryHeap {
         }
     }
 
+    /**
+     * @brief Pops up to pop_batch_size nodes from one of the queues into \p heap_nodes (the lowest
+     * priority first). Return false if the heap is empty.
+     */
+    bool try_pop_batch(std::vector<HeapNode>& heap_nodes) {
+        // Scratch space of the calling thread
+        static thread_local std::vector<MQHeapNode> batch;
+        batch.resize(pop_batch_size_);
+
+        heap_nodes.clear();
+        auto num_popped = pq_->tryPopBatch(batch.data());
+        if (!num_popped.has_value()) {
+            return false;
+        }
+        for (size_t i = 0; i < num_popped.value(); i++) {
+            heap_nodes.push_back({std::get<0>(batch[i]), RRNodeId(std::get<1>(batch[i]))});
+        }
+        return true;
+    }
+
+    size_t get_pop_batch_size() const {
+        return pop_batch_size_;
+    }
+
     void add_to_heap(const HeapNode& heap_node) {
         HeapNodePriority prio = heap_node.prio;
         uint32_t node = size_t(heap_node.node);
@@ -110,6 +144,11 @@ class MultiQueueDAryHeap {
         return pq_->getNumPops();
     }
 
+    ///@brief Returns the number of times a thread found the queue it picked locked by another thread.
+    uint64_t get_num_lock_fails() const {
+        return pq_->getNumLockFails();
+    }
+
     uint64_t get_heap_occupancy() const {
         return pq_->getQueueOccupancy();
     }
@@ -126,4 +165,5 @@ class MultiQueueDAryHeap {
 
   private:
     std::unique_ptr<MQ_IO> pq_;
+    size_t pop_batch_size_ = 1;
 };
@@ -51,6 +51,8 @@ class MultiQueueIO {
     struct PQContainer {
         uint64_t pushes = 0;
         uint64_t pops = 0;
+        // Failed attempts to lock this queue (by any thread)
+        std::atomic<uint64_t> lockFails{0};
         PQ pq;
         std::atomic_flag queueLock = ATOMIC_FLAG_INIT;
         std::atomic<PrioType> min{EMPTY_PRIO};
@@ -88,14 +90,20 @@ class MultiQueueIO {
 
     uint64_t batchSize;
 
+    // Number of consecutive pops a thread makes from the same queue before
+    // picking two new random queues (1: pick new queues for every pop)
+    uint64_t stickiness;
+
   public:
-    MultiQueueIO(uint64_t numQueues, uint64_t numThreads, uint64_t batch)
+    MultiQueueIO(uint64_t numQueues, uint64_t numThreads, uint64_t batch, uint64_t stick = 1)
         : queues(numQueues)
         , NUM_QUEUES(numQueues)
         , threadNum(numThreads)
         , numEmpty(numQueues)
-        , batchSize(batch) {
+        , batchSize(batch)
+        , stickiness(stick) {
         assert((numQueues >= 2) && "numQueues must be set >= 2");
+        assert((stickiness >= 1) && "stickiness must be set >= 1");
     }
 
 #ifdef PERF
@@ -106,12 +114,24 @@ class MultiQueueIO {
         // static thread_local std::mt19937_64 generator;
         // std::uniform_real_distribution<> distribution(min,max);
         // return distribution(generator);
-        static uint64_t modMask = NUM_QUEUES - 1;
         static thread_local uint64_t x = pthread_self();
         uint64_t z = (x += UINT64_C(0x9E3779B97F4A7C15));
         z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
         z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
-        return (z ^ (z >> 31)) & modMask;
+        z = z ^ (z >> 31);
+        // Map to [0, NUM_QUEUES) with a multiply-shift rather than a mask, so that the
+        // number of queues doesn't have to be a power of 2 (and can differ between
+        // MultiQueues, which a function-static mask couldn't)
+        return uint64_t((static_cast<unsigned __int128>(z) * NUM_QUEUES) >> 64);
+    }
+
+    // Locks the given queue, counting the failed attempts as contention
+    inline bool tryLockQueue(uint64_t queue) {
+        if (queues[queue].try_lock()) {
+            queues[queue].lockFails.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
     }
 
 #ifdef PERF
@@ -128,7 +148,7 @@ class MultiQueueIO {
         uint64_t queue;
         while (true) {
             queue = ThreadLocalRandom();
-            if (!queues[queue].try_lock()) break;
+            if (tryLockQueue(queue)) break;
         }
         auto& q = queues[queue];
         q.pushes++;
@@ -155,7 +175,7 @@ class MultiQueueIO {
         uint64_t queue;
         while (true) {
             queue = ThreadLocalRandom();
-            if (!queues[queue].try_lock()) break;
+            if (tryLockQueue(queue)) break;
         }
         auto& q = queues[queue];
         q.pushes += size;
@@ -215,6 +235,22 @@ class MultiQueueIO {
 #else
     inline std::optional<PQElement> pop() {
 #endif
+        // Queue stickiness: keep popping from the queue of the last pop, as long as
+        // it can be locked right away and isn't empty. Saves reading the minimums of
+        // two random queues (and their cache misses) at the cost of priority drift.
+        // Note: the sticky state is per thread, not per MultiQueue; at worst a stale
+        // queue index costs one pop the freshness of its two random choices.
+        static thread_local uint64_t stickyQueue = 0;
+        static thread_local uint64_t stickyPopsLeft = 0;
+        if (stickyPopsLeft > 0 && stickyQueue < NUM_QUEUES) {
+            stickyPopsLeft--;
+            if (queues[stickyQueue].min.load(std::memory_order_acquire) != EMPTY_PRIO && tryLockQueue(stickyQueue)) {
+                auto item = popLocked(queues[stickyQueue]);
+                if (item) return item;
+            }
+            stickyPopsLeft = 0;
+        }
+
         uint64_t poppingQueue = NUM_QUEUES;
         while (true) {
             // Pick the higher priority max of queue i and j
@@ -242,37 +278,47 @@ class MultiQueueIO {
             } else {
                 poppingQueue = j;
             }
-            if (queues[poppingQueue].try_lock()) continue;
-            auto& q = queues[poppingQueue];
-            if (!q.pq.empty()) {
+            if (!tryLockQueue(poppingQueue)) continue;
+            auto item = popLocked(queues[poppingQueue]);
+            if (item) {
+                stickyQueue = poppingQueue;
+                stickyPopsLeft = stickiness - 1;
+                return item;
+            }
+        }
+        return {};
+    }
+
+    // Pops the top of the given (locked) queue, or drains it if its top can't
+    // be better than the target, and unlocks it
+    inline std::optional<PQElement> popLocked(PQContainer& q) {
+        std::optional<PQElement> retItem;
+        if (!q.pq.empty()) {
 #ifdef MQ_IO_ENABLE_CLEAR_FOR_POP
-                PrioType minPrio = minPrioForPop.load(std::memory_order_acquire);
-                if (compare(q.pq.top(), {minPrio, 0})) {
-                    q.pq.clear();
-                    // do not add `q.pops` on purpose
-                    numEmpty.fetch_add(1, std::memory_order_relaxed);
-                    q.min.store(EMPTY_PRIO, std::memory_order_release);
-                } else {
+            PrioType minPrio = minPrioForPop.load(std::memory_order_acquire);
+            if (compare(q.pq.top(), {minPrio, 0})) {
+                q.pq.clear();
+                // do not add `q.pops` on purpose
+                numEmpty.fetch_add(1, std::memory_order_relaxed);
+                q.min.store(EMPTY_PRIO, std::memory_order_release);
+            } else {
 #endif
-                    PQElement retItem = q.pq.top();
-                    q.pq.pop();
-                    q.pops++;
-                    if (q.pq.empty())
-                        numEmpty.fetch_add(1, std::memory_order_relaxed);
-                    q.min.store(
-                        q.pq.size() > 0
-                            ? std::get<0>(q.pq.top())
-                            : EMPTY_PRIO,
-                        std::memory_order_release);
-                    q.unlock();
-                    return retItem;
+                retItem = q.pq.top();
+                q.pq.pop();
+                q.pops++;
+                if (q.pq.empty())
+                    numEmpty.fetch_add(1, std::memory_order_relaxed);
+                q.min.store(
+                    q.pq.size() > 0
+                        ? std::get<0>(q.pq.top())
+                        : EMPTY_PRIO,
+                    std::memory_order_release);
 #ifdef MQ_IO_ENABLE_CLEAR_FOR_POP
-                }
-#endif
             }
-            q.unlock();
+#endif
         }
-        return {};
+        q.unlock();
+        return retItem;
     }
 
 #ifdef PERF
@@ -338,7 +384,7 @@ class MultiQueueIO {
         } else {
             poppingQueue = j;
         }
-        if (queues[poppingQueue].try_lock()) continue;
+        if (!tryLockQueue(poppingQueue)) continue;
         auto& q = queues[poppingQueue];
         if (q.pq.empty()) {
             q.unlock();
@@ -348,6 +394,13 @@ class MultiQueueIO {
         uint64_t num = 0;
         for (num = 0; num < batchSize; num++) {
             if (q.pq.empty()) break;
+#ifdef MQ_IO_ENABLE_CLEAR_FOR_POP
+            // Drop the rest of the queue if it can't improve on the target
+            if (compare(q.pq.top(), {minPrioForPop.load(std::memory_order_acquire), 0})) {
+                q.pq.clear();
+                break;
+            }
+#endif
 #ifdef PERF
             popInt(poppingQueue, &ret[num]);
 #else
@@ -390,6 +443,16 @@ inline uint64_t getNumPushes() const {
     return totalPushes;
 }
 
+// Get the number of failed attempts to lock a queue, i.e. of times
+// a thread found the queue it picked locked by another thread.
+inline uint64_t getNumLockFails() const {
+    uint64_t totalLockFails = 0;
+    for (uint64_t i = 0; i < NUM_QUEUES; i++) {
+        totalLockFails += queues[i].lockFails.load(std::memory_order_relaxed);
+    }
+    return totalLockFails;
+}
+
 // Get the number of pops to all queues.
 // Note: this is not lock protected.
 inline uint64_t getNumPops() const {
@@ -426,6 +489,7 @@ inline void reset() {
                && "reset() assumes unlocked queues");
         queues[i].pushes = 0;
         queues[i].pops = 0;
+        queues[i].lockFails.store(0, std::memory_order_relaxed);
         queues[i].min.store(EMPTY_PRIO, std::memory_order_relaxed);
     }
     numIdle.store(0, std::memory_order_relaxed);
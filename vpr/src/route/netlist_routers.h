@@ -16,9 +16,11 @@
 
 #include <vector>
 #include "NetPinTimingInvalidator.h"
+#include "bucket_heap.h"
 #include "clustered_netlist_utils.h"
 #include "connection_based_routing_fwd.h"
 #include "d_ary_heap.h"
+#include "globals.h"
 #include "heap_type.h"
 #include "netlist_fwd.h"
 #include "routing_predictor.h"
@@ -68,10 +70,14 @@ class NetlistRouter {
 /* Include the derived classes here to get the HeapType-templated impls */
 #include "SerialNetlistRouter.h"
 #include "NestedNetlistRouter.h"
+#include "BatchNetlistRouter.h"
 #ifdef VPR_USE_TBB
 #include "ParallelNetlistRouter.h"
 #include "DecompNetlistRouter.h"
 #endif
+#ifdef VPR_USE_MPI
+#include "DistributedNetlistRouter.h"
+#endif
 
 template<typename HeapType>
 inline std::unique_ptr<NetlistRouter> make_netlist_router_with_heap(
@@ -156,12 +162,47 @@ inline std::unique_ptr<NetlistRouter> make_netlist_router_with_heap(
 #else
         VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "VPR isn't compiled with TBB support required for parallel routing");
 #endif
+    } else if (router_opts.router_algorithm == e_router_algorithm::DISTRIBUTED) {
+#ifdef VPR_USE_MPI
+        return std::make_unique<DistributedNetlistRouter<HeapType>>(
+            net_list,
+            router_lookahead,
+            router_opts,
+            connections_inf,
+            net_delay,
+            netlist_pin_lookup,
+            timing_info,
+            pin_timing_invalidator,
+            budgeting_inf,
+            routing_predictor,
+            choking_spots,
+            is_flat,
+            route_verbosity);
+#else
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "VPR isn't compiled with MPI support (VPR_USE_MPI) required for distributed routing");
+#endif
+    } else if (router_opts.router_algorithm == e_router_algorithm::GPU_BATCH) {
+        return std::make_unique<BatchNetlistRouter<HeapType>>(
+            net_list,
+            router_lookahead,
+            router_opts,
+            connections_inf,
+            net_delay,
+            netlist_pin_lookup,
+            timing_info,
+            pin_timing_invalidator,
+            budgeting_inf,
+            routing_predictor,
+            choking_spots,
+            is_flat,
+            route_verbosity);
     } else {
         VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown router algorithm %d", router_opts.router_algorithm);
     }
 }
 
-/** Make a NetlistRouter depending on router_algorithm and router_heap in \p router_opts. */
+/** Make a NetlistRouter depending on router_algorithm and router_heap in \p router_opts.
+ * With router_heap == AUTO_HEAP, the heap is picked by select_heap_type. */
 inline std::unique_ptr<NetlistRouter> make_netlist_router(
     const Netlist<>& net_list,
     const RouterLookahead* router_lookahead,
@@ -176,7 +217,19 @@ inline std::unique_ptr<NetlistRouter> make_netlist_router(
     const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& choking_spots,
     bool is_flat,
     int route_verbosity) {
-    if (router_opts.router_heap == e_heap_type::BINARY_HEAP) {
+    e_heap_type heap_type = router_opts.router_heap;
+    if (heap_type == e_heap_type::AUTO_HEAP) {
+        size_t max_fanout = 0;
+        for (ParentNetId net_id : net_list.nets()) {
+            max_fanout = std::max(max_fanout, net_list.net_sinks(net_id).size());
+        }
+
+        heap_type = select_heap_type(g_vpr_ctx.device().grid, max_fanout);
+        VTR_LOG("Router heap: %s (max net fanout %zu)\n",
+                heap_type == e_heap_type::BUCKET_HEAP ? "bucket" : "four_ary", max_fanout);
+    }
+
+    if (heap_type == e_heap_type::BINARY_HEAP) {
         return make_netlist_router_with_heap<BinaryHeap>(
             net_list,
             router_lookahead,
@@ -191,7 +244,7 @@ inline std::unique_ptr<NetlistRouter> make_netlist_router(
             choking_spots,
             is_flat,
             route_verbosity);
-    } else if (router_opts.router_heap == e_heap_type::FOUR_ARY_HEAP) {
+    } else if (heap_type == e_heap_type::FOUR_ARY_HEAP) {
         return make_netlist_router_with_heap<FourAryHeap>(
             net_list,
             router_lookahead,
@@ -206,7 +259,22 @@ inline std::unique_ptr<NetlistRouter> make_netlist_router(
             choking_spots,
             is_flat,
             route_verbosity);
+    } else if (heap_type == e_heap_type::BUCKET_HEAP) {
+        return make_netlist_router_with_heap<BucketHeap>(
+            net_list,
+            router_lookahead,
+            router_opts,
+            connections_inf,
+            net_delay,
+            netlist_pin_lookup,
+            timing_info,
+            pin_timing_invalidator,
+            budgeting_inf,
+            routing_predictor,
+            choking_spots,
+            is_flat,
+            route_verbosity);
     } else {
-        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap type %d", router_opts.router_heap);
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap type %d", heap_type);
     }
 }
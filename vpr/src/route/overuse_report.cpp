@@ -1,13 +1,19 @@
 #include "overuse_report.h"
 
+#include <algorithm>
 #include <fstream>
 #include "globals.h"
 #include "physical_types.h"
 #include "physical_types_util.h"
 #include "vpr_utils.h"
+#include "vtr_array_view.h"
 #include "vtr_log.h"
 #include "route_common.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 /**
  * @brief Definitions of global and helper routines related to printing RR node overuse info.
  *
@@ -15,13 +21,28 @@
  * The helper routines that are called by the global routine should stay local to this file.
  * They provide subroutine hierarchy to allow easier customization of the logfile/report format.
  */
-static void generate_node_to_net_lookup(const Netlist<>& net_list,
-                                        std::map<RRNodeId, std::set<ParentNetId>>& rr_node_to_net_map);
+
+/**
+ * @brief The nets passing through each RR node (in ascending order), i.e. the reverse of the route trees.
+ *
+ * Built once per report in flat arrays: the nets of node n are at [offsets[n]..offsets[n+1]-1] in nets.
+ */
+struct t_rr_node_nets {
+    std::vector<size_t> offsets;
+    std::vector<ParentNetId> nets;
+
+    vtr::array_view<const ParentNetId> node_nets(RRNodeId node_id) const {
+        return vtr::array_view<const ParentNetId>(nets.data() + offsets[size_t(node_id)],
+                                                  offsets[size_t(node_id) + 1] - offsets[size_t(node_id)]);
+    }
+};
+
+static t_rr_node_nets generate_node_to_net_lookup(const Netlist<>& net_list);
 
 ///@brief Print out information specific to IPIN/OPIN type rr nodes
 static void report_overused_ipin_opin(std::ostream& os,
                                       RRNodeId node_id,
-                                      const std::map<RRNodeId, std::set<ParentNetId>>& rr_node_to_net_map);
+                                      const t_rr_node_nets& rr_node_to_net_map);
 
 ///@brief Print out information specific to CHANX/CHANY type rr nodes
 static void report_overused_chanx_chany(std::ostream& os, RRNodeId node_id);
@@ -31,7 +52,7 @@ static void report_overused_source_sink(std::ostream& os, RRNodeId node_id);
 static void report_congested_nets(const Netlist<>& net_list,
                                   const AtomLookup& atom_lookup,
                                   std::ostream& os,
-                                  const std::set<ParentNetId>& congested_nets,
+                                  vtr::array_view<const ParentNetId> congested_nets,
                                   bool is_flat,
                                   int layer_num,
                                   int x,
@@ -57,7 +78,7 @@ static void print_block_pins_nets(std::ostream& os,
                                   t_physical_tile_type_ptr physical_type,
                                   const t_physical_tile_loc& root_loc,
                                   int pin_physical_num,
-                                  const std::map<RRNodeId, std::set<ParentNetId>>& rr_node_to_net_map);
+                                  const t_rr_node_nets& rr_node_to_net_map);
 /**
  * @brief Print out RR node overuse info in the VPR logfile.
  *
@@ -102,23 +123,26 @@ void report_overused_nodes(const Netlist<>& net_list,
                            bool is_flat) {
     const auto& route_ctx = g_vpr_ctx.routing();
 
-    /* Generate overuse info lookup table */
-    std::map<RRNodeId, std::set<ParentNetId>> over_used_nodes_to_nets_lookup;
-    std::map<RRNodeId, std::set<ParentNetId>> rr_node_to_net_map;
-    generate_overused_nodes_to_congested_net_lookup(net_list,
-                                                    over_used_nodes_to_nets_lookup);
-    generate_node_to_net_lookup(net_list, rr_node_to_net_map);
+    /* Generate overuse info lookup table: the overused nodes are those used by some net with
+     * more nets than their capacity */
+    t_rr_node_nets rr_node_to_net_map = generate_node_to_net_lookup(net_list);
+    std::vector<RRNodeId> over_used_nodes;
+    for (RRNodeId node_id : rr_graph.nodes()) {
+        if (rr_node_to_net_map.node_nets(node_id).size() > 0
+            && route_ctx.rr_node_route_inf[node_id].occ() > rr_graph.node_capacity(node_id)) {
+            over_used_nodes.push_back(node_id);
+        }
+    }
 
     /* Open the report file and print header info */
     std::ofstream os("report_overused_nodes.rpt");
     os << "Overused nodes information report on the final failed routing attempt" << '\n';
-    os << "Total number of overused nodes = " << over_used_nodes_to_nets_lookup.size() << '\n';
+    os << "Total number of overused nodes = " << over_used_nodes.size() << '\n';
 
     /* Go through each rr node and the nets that pass through it */
     size_t inode = 0;
-    for (const auto& lookup_pair : over_used_nodes_to_nets_lookup) {
-        const RRNodeId node_id = lookup_pair.first;
-        const std::set<ParentNetId>& congested_nets = lookup_pair.second;
+    for (const RRNodeId node_id : over_used_nodes) {
+        vtr::array_view<const ParentNetId> congested_nets = rr_node_to_net_map.node_nets(node_id);
 
         os << "************************************************\n\n"; //Separation line
 
@@ -197,41 +221,72 @@ void generate_overused_nodes_to_congested_net_lookup(const Netlist<>& net_list,
     const auto& rr_graph = device_ctx.rr_graph;
     const auto& route_ctx = g_vpr_ctx.routing();
 
-    //Create overused nodes to congested nets look up by
-    //traversing through the net trace backs linked lists
-    for (ParentNetId net_id : net_list.nets()) {
-        if (!route_ctx.route_trees[net_id])
-            continue;
-
-        for (auto& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
-            RRNodeId inode = rt_node.inode;
-            int overuse = route_ctx.rr_node_route_inf[inode].occ() - rr_graph.node_capacity(inode);
-            if (overuse > 0) {
+    t_rr_node_nets rr_node_to_net_map = generate_node_to_net_lookup(net_list);
+    for (RRNodeId inode : rr_graph.nodes()) {
+        int overuse = route_ctx.rr_node_route_inf[inode].occ() - rr_graph.node_capacity(inode);
+        if (overuse > 0) {
+            for (ParentNetId net_id : rr_node_to_net_map.node_nets(inode)) {
                 nodes_to_nets_lookup[inode].insert(net_id);
             }
         }
     }
 }
 
-static void generate_node_to_net_lookup(const Netlist<>& net_list,
-                                        std::map<RRNodeId, std::set<ParentNetId>>& rr_node_to_net_map) {
+/**
+ * @brief Generate the RR nodes to nets lookup table of all the routed nets.
+ *
+ * Collects the (unique) nodes of each route tree in parallel, then scatters the nets
+ * to their nodes net after net, so that the nets of each node come out sorted.
+ */
+static t_rr_node_nets generate_node_to_net_lookup(const Netlist<>& net_list) {
     const auto& route_ctx = g_vpr_ctx.routing();
+    const size_t num_rr_nodes = g_vpr_ctx.device().rr_graph.num_nodes();
 
-    //Create overused nodes to congested nets look up by
-    //traversing through the net trace backs linked lists
-    for (ParentNetId net_id : net_list.nets()) {
+    vtr::vector<ParentNetId, std::vector<RRNodeId>> net_nodes(net_list.nets().size());
+    auto collect_net_nodes = [&](size_t inet) {
+        ParentNetId net_id(inet);
         if (!route_ctx.route_trees[net_id])
-            continue;
+            return;
 
+        std::vector<RRNodeId>& nodes = net_nodes[net_id];
         for (const RouteTreeNode& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
-            rr_node_to_net_map[rt_node.inode].insert(net_id);
+            nodes.push_back(rt_node.inode);
+        }
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), net_nodes.size(), collect_net_nodes);
+#else
+    for (size_t inet = 0; inet < net_nodes.size(); inet++) {
+        collect_net_nodes(inet);
+    }
+#endif
+
+    t_rr_node_nets rr_node_to_net_map;
+    rr_node_to_net_map.offsets.assign(num_rr_nodes + 1, 0);
+    for (const std::vector<RRNodeId>& nodes : net_nodes) {
+        for (RRNodeId inode : nodes) {
+            rr_node_to_net_map.offsets[size_t(inode) + 1]++;
+        }
+    }
+    for (size_t inode = 0; inode < num_rr_nodes; inode++) {
+        rr_node_to_net_map.offsets[inode + 1] += rr_node_to_net_map.offsets[inode];
+    }
+
+    rr_node_to_net_map.nets.resize(rr_node_to_net_map.offsets.back());
+    std::vector<size_t> next(rr_node_to_net_map.offsets.begin(), rr_node_to_net_map.offsets.end() - 1);
+    for (size_t inet = 0; inet < net_nodes.size(); inet++) {
+        for (RRNodeId inode : net_nodes[ParentNetId(inet)]) {
+            rr_node_to_net_map.nets[next[size_t(inode)]++] = ParentNetId(inet);
         }
     }
+    return rr_node_to_net_map;
 }
 
 static void report_overused_ipin_opin(std::ostream& os,
                                       RRNodeId node_id,
-                                      const std::map<RRNodeId, std::set<ParentNetId>>& rr_node_to_net_map) {
+                                      const t_rr_node_nets& rr_node_to_net_map) {
     const auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
     const auto& place_ctx = g_vpr_ctx.placement();
@@ -322,7 +377,7 @@ static void report_overused_source_sink(std::ostream& os, RRNodeId node_id) {
 static void report_congested_nets(const Netlist<>& net_list,
                                   const AtomLookup& atom_lookup,
                                   std::ostream& os,
-                                  const std::set<ParentNetId>& congested_nets,
+                                  vtr::array_view<const ParentNetId> congested_nets,
                                   bool is_flat,
                                   int layer_num,
                                   int x,
@@ -460,7 +515,7 @@ static void print_block_pins_nets(std::ostream& os,
                                   t_physical_tile_type_ptr physical_type,
                                   const t_physical_tile_loc& root_loc,
                                   int pin_physical_num,
-                                  const std::map<RRNodeId, std::set<ParentNetId>>& rr_node_to_net_map) {
+                                  const t_rr_node_nets& rr_node_to_net_map) {
     const auto& rr_graph = g_vpr_ctx.device().rr_graph;
 
     t_pin_range pin_num_range;
@@ -494,7 +549,7 @@ static void print_block_pins_nets(std::ostream& os,
             continue;
         }
         VTR_ASSERT(node_id.is_valid());
-        auto search_result = rr_node_to_net_map.find(node_id);
+        vtr::array_view<const ParentNetId> nets = rr_node_to_net_map.node_nets(node_id);
         if (rr_type == e_rr_type::OPIN) {
             os << "  OPIN - ";
         } else {
@@ -503,8 +558,7 @@ static void print_block_pins_nets(std::ostream& os,
         }
         os << "RRNodeId: " << size_t(node_id) << " - Physical Num: " << pin << "\n";
         os << "  ";
-        if (search_result != rr_node_to_net_map.end()) {
-            auto nets = search_result->second;
+        if (nets.size() > 0) {
             for (auto net : nets) {
                 os << "  " << size_t(net);
             }
@@ -1,6 +1,7 @@
 #include "parallel_connection_router.h"
 
 #include <algorithm>
+#include "bucket_heap.h"
 #include "d_ary_heap.h"
 #include "route_tree.h"
 #include "rr_graph_fwd.h"
@@ -186,6 +187,13 @@ void ParallelConnectionRouter<Heap>::timing_driven_find_single_shortest_path_fro
     // Collect the number of heap pushes and pops
     this->router_stats_->heap_pushes += this->heap_.get_num_pushes();
     this->router_stats_->heap_pops += this->heap_.get_num_pops();
+    this->router_stats_->heap_lock_contention += this->heap_.get_num_lock_fails();
+    for (t_thread_stats& thread_stats : this->thread_stats_) {
+        this->router_stats_->heap_stale_pops += thread_stats.stale_pops;
+        this->router_stats_->wasted_expansions += thread_stats.wasted_expansions;
+        this->router_stats_->node_lock_contention += thread_stats.node_lock_contention;
+        thread_stats = t_thread_stats();
+    }
 
     // Reset the heap for the next connection
     this->heap_.reset();
@@ -215,43 +223,70 @@ void ParallelConnectionRouter<Heap>::timing_driven_find_single_shortest_path_fro
                                                                                                    const t_bb& bounding_box,
                                                                                                    const t_bb& target_bb,
                                                                                                    const size_t thread_idx) {
-    HeapNode cheapest;
-    while (this->heap_.try_pop(cheapest)) {
-        // Pop a new inode with the cheapest total cost in current route tree to be expanded on
-        const auto& [new_total_cost, inode] = cheapest;
-
-        // Check if we should explore the neighbors of this node
-        if (should_not_explore_neighbors(inode, new_total_cost, this->rr_node_route_inf_[inode].backward_path_cost, sink_node, this->rr_node_route_inf_, cost_params)) {
-            continue;
+    if (this->heap_.get_pop_batch_size() > 1) {
+        std::vector<HeapNode> batch;
+        batch.reserve(this->heap_.get_pop_batch_size());
+        while (this->heap_.try_pop_batch(batch)) {
+            for (const HeapNode& cheapest : batch) {
+                timing_driven_expand_popped_node(cheapest, cost_params, bounding_box, sink_node, target_bb, thread_idx);
+            }
         }
-
-        // Get the current RR node info within a critical section to prevent data races
-        obtainSpinLock(inode);
-
-        RTExploredNode current;
-        current.index = inode;
-        current.backward_path_cost = this->rr_node_route_inf_[inode].backward_path_cost;
-        current.prev_edge = this->rr_node_route_inf_[inode].prev_edge;
-        current.R_upstream = this->rr_node_route_inf_[inode].R_upstream;
-
-        releaseLock(inode);
-
-        // Double check now just to be sure that we should still explore neighbors
-        // NOTE: A good question is what happened to the uniqueness pruning. The idea
-        //       is that at this point it does not matter. Basically any duplicates
-        //       will act like they were the last one pushed in. This may create some
-        //       duplicates, but it is a simple way of handling this situation.
-        //       It may be worth investigating a better way to do this in the future.
-        // TODO: This is still doing post-target pruning. May want to investigate
-        //       if this is worth doing.
-        // TODO: should try testing without the pruning below and see if anything changes.
-        if (should_not_explore_neighbors(inode, new_total_cost, current.backward_path_cost, sink_node, this->rr_node_route_inf_, cost_params)) {
-            continue;
+    } else {
+        HeapNode cheapest;
+        while (this->heap_.try_pop(cheapest)) {
+            timing_driven_expand_popped_node(cheapest, cost_params, bounding_box, sink_node, target_bb, thread_idx);
         }
+    }
+}
+
+template<typename Heap>
+void ParallelConnectionRouter<Heap>::timing_driven_expand_popped_node(const HeapNode& cheapest,
+                                                                      const t_conn_cost_params& cost_params,
+                                                                      const t_bb& bounding_box,
+                                                                      RRNodeId sink_node,
+                                                                      const t_bb& target_bb,
+                                                                      size_t thread_idx) {
+    // The popped inode has the cheapest total cost in current route tree to be expanded on
+    const auto& [new_total_cost, inode] = cheapest;
+
+    // Check if we should explore the neighbors of this node
+    if (should_not_explore_neighbors(inode, new_total_cost, this->rr_node_route_inf_[inode].backward_path_cost, sink_node, this->rr_node_route_inf_, cost_params)) {
+        this->thread_stats_[thread_idx].stale_pops++;
+        return;
+    }
+
+    // Get the current RR node info within a critical section to prevent data races
+    obtainSpinLock(inode, thread_idx);
+
+    RTExploredNode current;
+    current.index = inode;
+    current.backward_path_cost = this->rr_node_route_inf_[inode].backward_path_cost;
+    current.prev_edge = this->rr_node_route_inf_[inode].prev_edge;
+    current.R_upstream = this->rr_node_route_inf_[inode].R_upstream;
+
+    releaseLock(inode);
+
+    // Double check now just to be sure that we should still explore neighbors
+    // NOTE: A good question is what happened to the uniqueness pruning. The idea
+    //       is that at this point it does not matter. Basically any duplicates
+    //       will act like they were the last one pushed in. This may create some
+    //       duplicates, but it is a simple way of handling this situation.
+    //       It may be worth investigating a better way to do this in the future.
+    // TODO: This is still doing post-target pruning. May want to investigate
+    //       if this is worth doing.
+    // TODO: should try testing without the pruning below and see if anything changes.
+    if (should_not_explore_neighbors(inode, new_total_cost, current.backward_path_cost, sink_node, this->rr_node_route_inf_, cost_params)) {
+        this->thread_stats_[thread_idx].stale_pops++;
+        return;
+    }
 
-        // Adding nodes to heap
-        timing_driven_expand_neighbours(current, cost_params, bounding_box, sink_node, target_bb, thread_idx);
+    // A node expanded again was expanded too early, through a path which turned out not to be its cheapest
+    if (this->is_expanded_[size_t(inode)].exchange(true, std::memory_order_relaxed)) {
+        this->thread_stats_[thread_idx].wasted_expansions++;
     }
+
+    // Adding nodes to heap
+    timing_driven_expand_neighbours(current, cost_params, bounding_box, sink_node, target_bb, thread_idx);
 }
 
 template<typename Heap>
@@ -383,7 +418,7 @@ void ParallelConnectionRouter<Heap>::timing_driven_add_to_heap(const t_conn_cost
         return;
     }
 
-    obtainSpinLock(to_node);
+    obtainSpinLock(to_node, thread_idx);
 
     if (prune_node(to_node, new_total_cost, new_back_cost, from_edge, target_node, this->rr_node_route_inf_, cost_params)) {
         releaseLock(to_node);
@@ -458,7 +493,9 @@ std::unique_ptr<ConnectionRouterInterface> make_parallel_connection_router(e_hea
                                                                            int route_verbosity,
                                                                            int multi_queue_num_threads,
                                                                            int multi_queue_num_queues,
-                                                                           bool multi_queue_direct_draining) {
+                                                                           bool multi_queue_direct_draining,
+                                                                           int multi_queue_stickiness,
+                                                                           int multi_queue_pop_batch_size) {
     switch (heap_type) {
         case e_heap_type::BINARY_HEAP:
             return std::make_unique<ParallelConnectionRouter<BinaryHeap>>(
@@ -473,7 +510,9 @@ std::unique_ptr<ConnectionRouterInterface> make_parallel_connection_router(e_hea
                 route_verbosity,
                 multi_queue_num_threads,
                 multi_queue_num_queues,
-                multi_queue_direct_draining);
+                multi_queue_direct_draining,
+                multi_queue_stickiness,
+                multi_queue_pop_batch_size);
         case e_heap_type::FOUR_ARY_HEAP:
             return std::make_unique<ParallelConnectionRouter<FourAryHeap>>(
                 grid,
@@ -487,7 +526,27 @@ std::unique_ptr<ConnectionRouterInterface> make_parallel_connection_router(e_hea
                 route_verbosity,
                 multi_queue_num_threads,
                 multi_queue_num_queues,
-                multi_queue_direct_draining);
+                multi_queue_direct_draining,
+                multi_queue_stickiness,
+                multi_queue_pop_batch_size);
+        case e_heap_type::BUCKET_HEAP:
+            // The MultiQueue can't use buckets: this is the four-ary MultiQueue heap, which
+            // only needs to be emitted for the (templated) netlist routers using BucketHeap
+            return std::make_unique<ParallelConnectionRouter<BucketHeap>>(
+                grid,
+                router_lookahead,
+                rr_nodes,
+                rr_graph,
+                rr_rc_data,
+                rr_switch_inf,
+                rr_node_route_inf,
+                is_flat,
+                route_verbosity,
+                multi_queue_num_threads,
+                multi_queue_num_queues,
+                multi_queue_direct_draining,
+                multi_queue_stickiness,
+                multi_queue_pop_batch_size);
         default:
             VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap_type %d",
                             heap_type);
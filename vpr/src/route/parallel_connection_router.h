@@ -25,10 +25,14 @@ class spin_lock_t {
   public:
     /**
      * @brief Acquires the spin lock, repeatedly attempting until successful
+     * @return True if the lock was held by another thread (i.e. had to be waited for)
      */
-    void acquire() {
+    bool acquire() {
+        if (!std::atomic_flag_test_and_set_explicit(&lock_, std::memory_order_acquire))
+            return false;
         while (std::atomic_flag_test_and_set_explicit(&lock_, std::memory_order_acquire))
             ;
+        return true;
     }
 
     /**
@@ -204,21 +208,30 @@ class ParallelConnectionRouter : public ConnectionRouter<MultiQueueDAryHeap<Heap
         int route_verbosity,
         int multi_queue_num_threads,
         int multi_queue_num_queues,
-        bool multi_queue_direct_draining)
+        bool multi_queue_direct_draining,
+        int multi_queue_stickiness,
+        int multi_queue_pop_batch_size)
         : ConnectionRouter<MultiQueueDAryHeap<HeapImplementation::arg_D>>(grid, router_lookahead, rr_nodes, rr_graph, rr_rc_data, rr_switch_inf, rr_node_route_inf, is_flat, route_verbosity)
         , modified_rr_node_inf_(multi_queue_num_threads)
         , thread_barrier_(multi_queue_num_threads)
         , is_router_destroying_(false)
         , locks_(rr_node_route_inf.size())
+        , is_expanded_(rr_node_route_inf.size())
+        , thread_stats_(multi_queue_num_threads)
         , multi_queue_direct_draining_(multi_queue_direct_draining) {
         // Set the MultiQueue parameters
-        this->heap_.set_num_threads_and_queues(multi_queue_num_threads, multi_queue_num_queues);
+        this->heap_.set_num_threads_and_queues(multi_queue_num_threads, multi_queue_num_queues,
+                                               multi_queue_stickiness, multi_queue_pop_batch_size);
         // Initialize the thread barrier
         this->thread_barrier_.init();
-        // Instantiate (multi_queue_num_threads - 1) helper threads
+        // Instantiate (multi_queue_num_threads - 1) helper threads, working on the flow of the calling thread
         this->sub_threads_.resize(multi_queue_num_threads - 1);
+        VprContext& flow_ctx = get_current_vpr_context();
         for (int i = 0; i < multi_queue_num_threads - 1; ++i) {
-            this->sub_threads_[i] = std::thread(&ParallelConnectionRouter::timing_driven_find_single_shortest_path_from_heap_sub_thread_wrapper, this, i + 1 /*0: main thread*/);
+            this->sub_threads_[i] = std::thread([this, &flow_ctx, i]() {
+                ScopedVprContext ctx_scope(flow_ctx);
+                this->timing_driven_find_single_shortest_path_from_heap_sub_thread_wrapper(i + 1 /*0: main thread*/);
+            });
         }
     }
 
@@ -264,6 +277,10 @@ class ParallelConnectionRouter : public ConnectionRouter<MultiQueueDAryHeap<Heap
         // Reset the node info stored in rr_node_route_inf variable
         for (const auto& thread_visited_rr_nodes : this->modified_rr_node_inf_) {
             ::reset_path_costs(thread_visited_rr_nodes);
+            // Every expanded node was pushed, so it is in the modified list
+            for (RRNodeId inode : thread_visited_rr_nodes) {
+                this->is_expanded_[size_t(inode)].store(false, std::memory_order_relaxed);
+            }
         }
     }
 
@@ -316,8 +333,10 @@ class ParallelConnectionRouter : public ConnectionRouter<MultiQueueDAryHeap<Heap
     /**
      * @brief Obtains the per-node spin locks for protecting node cost updates
      */
-    inline void obtainSpinLock(const RRNodeId& inode) {
-        this->locks_[size_t(inode)].acquire();
+    inline void obtainSpinLock(const RRNodeId& inode, size_t thread_idx) {
+        if (this->locks_[size_t(inode)].acquire()) {
+            this->thread_stats_[thread_idx].node_lock_contention++;
+        }
     }
 
     /**
@@ -340,6 +359,22 @@ class ParallelConnectionRouter : public ConnectionRouter<MultiQueueDAryHeap<Heap
                                                            const t_bb& bounding_box,
                                                            const t_bb& target_bb) final;
 
+    /**
+     * @brief Expands the node popped from the heap, unless it is stale or pruned
+     * @param cheapest Heap node popped from the heap
+     * @param cost_params Cost function parameters
+     * @param bounding_box Keep search confined to this bounding box
+     * @param sink_node Sink node ID to route to
+     * @param target_bb Prune IPINs that lead to blocks other than the target block
+     * @param thread_idx Thread ID (0 means main thread; 1 to #threads-1 means helper threads)
+     */
+    void timing_driven_expand_popped_node(const HeapNode& cheapest,
+                                          const t_conn_cost_params& cost_params,
+                                          const t_bb& bounding_box,
+                                          RRNodeId sink_node,
+                                          const t_bb& target_bb,
+                                          size_t thread_idx);
+
     /**
      * @brief Helper thread wrapper function, passed to std::thread instantiation and running a
      * while-loop to obtain and execute new helper thread tasks until the main thread signals the
@@ -463,6 +498,20 @@ class ParallelConnectionRouter : public ConnectionRouter<MultiQueueDAryHeap<Heap
     /** Fine-grained locks per RR node */
     std::vector<spin_lock_t> locks_;
 
+    /** Whether each RR node has been expanded in the current path search (to count wasted expansions) */
+    std::vector<std::atomic<bool>> is_expanded_;
+
+    /** Path search statistics of a thread, kept apart from the other threads' to avoid false sharing */
+    struct alignas(64) t_thread_stats {
+        /** Popped nodes which weren't expanded: superseded by a cheaper path, or pruned after reaching the target */
+        size_t stale_pops = 0;
+        /** Expansions of nodes which had already been expanded in the same path search */
+        size_t wasted_expansions = 0;
+        /** Node cost updates which had to wait for another thread's lock on the node */
+        size_t node_lock_contention = 0;
+    };
+    std::vector<t_thread_stats> thread_stats_;
+
     /** Is queue draining optimization enabled? */
     bool multi_queue_direct_draining_;
 
@@ -493,4 +542,6 @@ std::unique_ptr<ConnectionRouterInterface> make_parallel_connection_router(
     int route_verbosity,
     int multi_queue_num_threads,
     int multi_queue_num_queues,
-    bool multi_queue_direct_draining);
+    bool multi_queue_direct_draining,
+    int multi_queue_stickiness,
+    int multi_queue_pop_batch_size);
@@ -1,4 +1,5 @@
 #include "partition_tree.h"
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <stack>
@@ -10,165 +11,240 @@
  * and the task creation overhead outweighs the advantage of partitioning, so we should stop. */
 constexpr size_t MIN_NETS_TO_PARTITION = 256;
 
-PartitionTree::PartitionTree(const Netlist<>& netlist) {
+/** Rebuild a subtree if its imbalance grew by this factor since it was built. */
+constexpr float REBALANCE_IMBALANCE_FAC = 2.0;
+
+/** Don't bother rebalancing subtrees with less total fanout than this.
+ * Small subtrees route quickly anyway, so they aren't worth the rebuild. */
+constexpr size_t MIN_FANOUTS_TO_REBALANCE = 4 * MIN_NETS_TO_PARTITION;
+
+/** Imbalance of a branch node: how much heavier is the heavy side? */
+inline float get_imbalance(const PartitionTreeNode& node) {
+    if (!node.left || !node.right)
+        return 1.0;
+    size_t l = node.left->subtree_fanouts, r = node.right->subtree_fanouts;
+    return float(std::max(l, r)) / float(std::max<size_t>(std::min(l, r), 1));
+}
+
+PartitionTree::PartitionTree(const Netlist<>& netlist)
+    : _netlist(&netlist) {
     const auto& device_ctx = g_vpr_ctx.device();
 
     auto all_nets = std::unordered_set<ParentNetId>(netlist.nets().begin(), netlist.nets().end());
-    _root = build_helper(netlist, all_nets, 0, 0, device_ctx.grid.width() - 1, device_ctx.grid.height() - 1);
+    _root = build_helper(netlist, all_nets, 0, 0, device_ctx.grid.width() - 1, device_ctx.grid.height() - 1, 0, device_ctx.grid.get_num_layers() - 1);
+}
+
+/** Span of \p bb along \p axis (inclusive) */
+inline std::pair<int, int> bb_span(const t_bb& bb, Axis axis) {
+    if (axis == Axis::X)
+        return {bb.xmin, bb.xmax};
+    if (axis == Axis::Y)
+        return {bb.ymin, bb.ymax};
+    return {bb.layer_min, bb.layer_max};
+}
+
+/** Find the best cutline among the layer and die (interposer) boundaries inside the given box.
+ * A boundary is only used if it leaves nets on both of its sides.
+ * \return Whether such a boundary exists */
+static bool find_boundary_cutline(const Netlist<>& netlist, const std::unordered_set<ParentNetId>& nets, int x1, int y1, int x2, int y2, int layer1, int layer2, Axis& best_axis, float& best_pos) {
+    const auto& route_ctx = g_vpr_ctx.routing();
+    const auto& grid = g_vpr_ctx.device().grid;
+
+    /* Boundaries are between integral coordinates, like any other cutline */
+    std::vector<std::pair<Axis, float>> boundaries;
+    for (int layer = layer1; layer < layer2; layer++) {
+        boundaries.push_back({Axis::LAYER, layer + 0.5});
+    }
+    /* An interposer cut at loc is between loc and loc + 1 */
+    const auto& vertical_cuts = grid.get_vertical_interposer_cuts();
+    const auto& horizontal_cuts = grid.get_horizontal_interposer_cuts();
+    for (int layer = layer1; layer <= layer2; layer++) {
+        if ((size_t)layer < vertical_cuts.size()) {
+            for (int cut_x : vertical_cuts[layer]) {
+                if (cut_x >= x1 && cut_x < x2)
+                    boundaries.push_back({Axis::X, cut_x + 0.5});
+            }
+        }
+        if ((size_t)layer < horizontal_cuts.size()) {
+            for (int cut_y : horizontal_cuts[layer]) {
+                if (cut_y >= y1 && cut_y < y2)
+                    boundaries.push_back({Axis::Y, cut_y + 0.5});
+            }
+        }
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+    /* Same score as the other cutlines: work on cutline + max(work on sides) */
+    size_t best_score = std::numeric_limits<size_t>::max();
+    for (const auto& [axis, pos] : boundaries) {
+        size_t before = 0, after = 0, on = 0;
+        for (auto net_id : nets) {
+            auto [lo, hi] = bb_span(route_ctx.route_bb[net_id], axis);
+            size_t fanouts = netlist.net_sinks(net_id).size();
+            if (hi < pos)
+                before += fanouts;
+            else if (lo > pos)
+                after += fanouts;
+            else
+                on += fanouts;
+        }
+        if (before == 0 || after == 0)
+            continue;
+        size_t score = on + std::max(before, after);
+        if (score < best_score) {
+            best_score = score;
+            best_axis = axis;
+            best_pos = pos;
+        }
+    }
+
+    return best_score != std::numeric_limits<size_t>::max();
 }
 
 /** Build a branch of the PartitionTree given a set of \p nets and a bounding box.
  * Calls itself recursively with smaller and smaller bounding boxes until there are less
  * nets than \ref MIN_NETS_TO_PARTITION. */
-std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>& netlist, const std::unordered_set<ParentNetId>& nets, int x1, int y1, int x2, int y2) {
+std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>& netlist, const std::unordered_set<ParentNetId>& nets, int x1, int y1, int x2, int y2, int layer1, int layer2) {
     if (nets.empty())
         return nullptr;
 
     const auto& route_ctx = g_vpr_ctx.routing();
 
-    /* Only build this for 2 dimensions. Ignore the layers for now */
-    const auto& device_ctx = g_vpr_ctx.device();
-    int layer_max = device_ctx.grid.get_num_layers() - 1;
-
     auto out = std::make_unique<PartitionTreeNode>();
+    out->bb = {x1, x2, y1, y2, layer1, layer2};
 
-    if (nets.size() < MIN_NETS_TO_PARTITION) {
-        out->bb = {x1, x2, y1, y2, 0, layer_max};
+    /* Leaf node: small enough, or (below) no cutline leaves nets on both sides */
+    auto make_leaf = [&]() {
         out->nets = nets;
         /* Build net to ptree node lookup */
         for (auto net_id : nets) {
             _net_to_ptree_node[net_id] = out.get();
+            out->subtree_fanouts += netlist.net_sinks(net_id).size();
         }
-        return out;
-    }
+        return std::move(out);
+    };
 
-    /* Build ParaDRo-ish prefix sum lookup for each bin (coordinate) in the device.
-     * Do this for every step with only given nets, because each cutline takes some nets out
-     * of the game, so if we just built a global lookup it wouldn't yield accurate results.
-     *
-     * VPR's bounding boxes include the borders (see SerialConnectionRouter::timing_driven_expand_neighbour())
-     * so try to include x=bb.xmax, y=bb.ymax etc. when calculating things. */
-    int width = x2 - x1 + 1;
-    int height = y2 - y1 + 1;
-
-    VTR_ASSERT(width > 1 && height > 1);
-    /* Cutlines are placed between integral coordinates.
-     * For instance, x_total_before[0] assumes a cutline at x=0.5, so fanouts at x=0 are included but not
-     * x=1. It's similar for x_total_after[0], which excludes fanouts at x=0 and includes x=1.
-     * Note that we have W-1 possible cutlines for a W-wide box.
-     *
-     * Here, *_total_before holds total score of nets before the cutline and not intersecting it.
-     * In ParaDRo this would be total_before + total_on. (same for total_after)*/
-    std::vector<int> x_total_before(width - 1, 0), x_total_after(width - 1, 0), x_total_on(width - 1, 0);
-    std::vector<int> y_total_before(height - 1, 0), y_total_after(height - 1, 0), y_total_on(height - 1, 0);
+    if (nets.size() < MIN_NETS_TO_PARTITION)
+        return make_leaf();
 
-    for (auto net_id : nets) {
-        t_bb bb = route_ctx.route_bb[net_id];
-        size_t fanouts = netlist.net_sinks(net_id).size();
-
-        /* Inclusive start and end coords of the bbox relative to x1. Clamp to [x1, x2]. */
-        int x_start = std::max(x1, bb.xmin) - x1;
-        int x_end = std::min(bb.xmax, x2) - x1;
-        /* Fill in the lookups assuming a cutline at x + 0.5.
-         * This means total_before includes the max coord of the bbox but
-         * total_after does not include the min coord. */
-        for (int x = x_end; x < width - 1; x++) {
-            x_total_before[x] += fanouts;
-        }
-        for (int x = 0; x < x_start; x++) {
-            x_total_after[x] += fanouts;
-        }
-        for (int x = x_start; x < x_end; x++) {
-            x_total_on[x] += fanouts;
-        }
-        int y_start = std::max(y1, bb.ymin) - y1;
-        int y_end = std::min(bb.ymax, y2) - y1;
-        for (int y = y_end; y < height - 1; y++) {
-            y_total_before[y] += fanouts;
-        }
-        for (int y = 0; y < y_start; y++) {
-            y_total_after[y] += fanouts;
-        }
-        for (int y = y_start; y < y_end; y++) {
-            y_total_on[y] += fanouts;
-        }
-    }
-
-    int best_score = std::numeric_limits<int>::max();
     float best_pos = std::numeric_limits<double>::quiet_NaN();
     Axis best_axis = Axis::X;
 
-    for (int x = 0; x < width - 1; x++) {
-        int before = x_total_before[x];
-        int after = x_total_after[x];
-        if (before == 0 || after == 0) /* Cutting here would leave no nets to the left or right */
-            continue;
-        /* Now get a measure of "critical path": work on cutline + max(work on sides) */
-        int score = x_total_on[x] + std::max(x_total_before[x], x_total_after[x]);
-        // int score = std::abs(int(x_total_before[x]) - int(x_total_after[x]));
-        if (score < best_score) {
-            best_score = score;
-            best_pos = x1 + x + 0.5; /* Lookups are relative to (x1, y1) */
-            best_axis = Axis::X;
+    /* Layer and die boundaries come first. Otherwise, look for the best cutline anywhere */
+    if (!find_boundary_cutline(netlist, nets, x1, y1, x2, y2, layer1, layer2, best_axis, best_pos)) {
+        /* Build ParaDRo-ish prefix sum lookup for each bin (coordinate) in the device.
+         * Do this for every step with only given nets, because each cutline takes some nets out
+         * of the game, so if we just built a global lookup it wouldn't yield accurate results.
+         *
+         * VPR's bounding boxes include the borders (see SerialConnectionRouter::timing_driven_expand_neighbour())
+         * so try to include x=bb.xmax, y=bb.ymax etc. when calculating things. */
+        int width = x2 - x1 + 1;
+        int height = y2 - y1 + 1;
+
+        VTR_ASSERT(width > 1 && height > 1);
+        /* Cutlines are placed between integral coordinates.
+         * For instance, x_total_before[0] assumes a cutline at x=0.5, so fanouts at x=0 are included but not
+         * x=1. It's similar for x_total_after[0], which excludes fanouts at x=0 and includes x=1.
+         * Note that we have W-1 possible cutlines for a W-wide box.
+         *
+         * Here, *_total_before holds total score of nets before the cutline and not intersecting it.
+         * In ParaDRo this would be total_before + total_on. (same for total_after)*/
+        std::vector<int> x_total_before(width - 1, 0), x_total_after(width - 1, 0), x_total_on(width - 1, 0);
+        std::vector<int> y_total_before(height - 1, 0), y_total_after(height - 1, 0), y_total_on(height - 1, 0);
+
+        for (auto net_id : nets) {
+            t_bb bb = route_ctx.route_bb[net_id];
+            size_t fanouts = netlist.net_sinks(net_id).size();
+
+            /* Inclusive start and end coords of the bbox relative to x1. Clamp to [x1, x2]. */
+            int x_start = std::max(x1, bb.xmin) - x1;
+            int x_end = std::min(bb.xmax, x2) - x1;
+            /* Fill in the lookups assuming a cutline at x + 0.5.
+             * This means total_before includes the max coord of the bbox but
+             * total_after does not include the min coord. */
+            for (int x = x_end; x < width - 1; x++) {
+                x_total_before[x] += fanouts;
+            }
+            for (int x = 0; x < x_start; x++) {
+                x_total_after[x] += fanouts;
+            }
+            for (int x = x_start; x < x_end; x++) {
+                x_total_on[x] += fanouts;
+            }
+            int y_start = std::max(y1, bb.ymin) - y1;
+            int y_end = std::min(bb.ymax, y2) - y1;
+            for (int y = y_end; y < height - 1; y++) {
+                y_total_before[y] += fanouts;
+            }
+            for (int y = 0; y < y_start; y++) {
+                y_total_after[y] += fanouts;
+            }
+            for (int y = y_start; y < y_end; y++) {
+                y_total_on[y] += fanouts;
+            }
         }
-    }
 
-    for (int y = 0; y < height - 1; y++) {
-        int before = y_total_before[y];
-        int after = y_total_after[y];
-        if (before == 0 || after == 0) /* Cutting here would leave no nets to the left or right (sideways) */
-            continue;
-        int score = y_total_on[y] + std::max(y_total_before[y], y_total_after[y]);
-        // int score = std::abs(int(y_total_before[y]) - int(y_total_after[y]));
-        if (score < best_score) {
-            best_score = score;
-            best_pos = y1 + y + 0.5; /* Lookups are relative to (x1, y1) */
-            best_axis = Axis::Y;
+        int best_score = std::numeric_limits<int>::max();
+
+        for (int x = 0; x < width - 1; x++) {
+            int before = x_total_before[x];
+            int after = x_total_after[x];
+            if (before == 0 || after == 0) /* Cutting here would leave no nets to the left or right */
+                continue;
+            /* Now get a measure of "critical path": work on cutline + max(work on sides) */
+            int score = x_total_on[x] + std::max(x_total_before[x], x_total_after[x]);
+            // int score = std::abs(int(x_total_before[x]) - int(x_total_after[x]));
+            if (score < best_score) {
+                best_score = score;
+                best_pos = x1 + x + 0.5; /* Lookups are relative to (x1, y1) */
+                best_axis = Axis::X;
+            }
         }
-    }
 
-    /* Couldn't find a cutline: all cutlines result in a one-way cut */
-    if (std::isnan(best_pos)) {
-        out->bb = {x1, x2, y1, y2, 0, layer_max};
-        out->nets = nets;
-        /* Build net to ptree node lookup */
-        for (auto net_id : nets) {
-            _net_to_ptree_node[net_id] = out.get();
+        for (int y = 0; y < height - 1; y++) {
+            int before = y_total_before[y];
+            int after = y_total_after[y];
+            if (before == 0 || after == 0) /* Cutting here would leave no nets to the left or right (sideways) */
+                continue;
+            int score = y_total_on[y] + std::max(y_total_before[y], y_total_after[y]);
+            // int score = std::abs(int(y_total_before[y]) - int(y_total_after[y]));
+            if (score < best_score) {
+                best_score = score;
+                best_pos = y1 + y + 0.5; /* Lookups are relative to (x1, y1) */
+                best_axis = Axis::Y;
+            }
         }
     }
 
+    /* Couldn't find a cutline: all cutlines result in a one-way cut */
+    if (std::isnan(best_pos))
+        return make_leaf();
+
     /* Populate net IDs on each side and call next level of build_x */
     std::unordered_set<ParentNetId> left_nets, right_nets, my_nets;
 
-    if (best_axis == Axis::X) {
-        for (auto net_id : nets) {
-            t_bb bb = route_ctx.route_bb[net_id];
-            if (bb.xmax < best_pos) {
-                left_nets.insert(net_id);
-            } else if (bb.xmin > best_pos) {
-                right_nets.insert(net_id);
-            } else {
-                my_nets.insert(net_id);
-            }
+    for (auto net_id : nets) {
+        auto [lo, hi] = bb_span(route_ctx.route_bb[net_id], best_axis);
+        if (hi < best_pos) {
+            left_nets.insert(net_id);
+        } else if (lo > best_pos) {
+            right_nets.insert(net_id);
+        } else {
+            my_nets.insert(net_id);
         }
+    }
 
-        out->left = build_helper(netlist, left_nets, x1, y1, std::floor(best_pos), y2);
-        out->right = build_helper(netlist, right_nets, std::floor(best_pos + 1), y1, x2, y2);
+    if (best_axis == Axis::X) {
+        out->left = build_helper(netlist, left_nets, x1, y1, std::floor(best_pos), y2, layer1, layer2);
+        out->right = build_helper(netlist, right_nets, std::floor(best_pos + 1), y1, x2, y2, layer1, layer2);
+    } else if (best_axis == Axis::Y) {
+        out->left = build_helper(netlist, left_nets, x1, y1, x2, std::floor(best_pos), layer1, layer2);
+        out->right = build_helper(netlist, right_nets, x1, std::floor(best_pos + 1), x2, y2, layer1, layer2);
     } else {
-        VTR_ASSERT(best_axis == Axis::Y);
-        for (auto net_id : nets) {
-            t_bb bb = route_ctx.route_bb[net_id];
-            if (bb.ymax < best_pos) {
-                left_nets.insert(net_id);
-            } else if (bb.ymin > best_pos) {
-                right_nets.insert(net_id);
-            } else {
-                my_nets.insert(net_id);
-            }
-        }
-
-        out->left = build_helper(netlist, left_nets, x1, y1, x2, std::floor(best_pos));
-        out->right = build_helper(netlist, right_nets, x1, std::floor(best_pos + 1), x2, y2);
+        VTR_ASSERT(best_axis == Axis::LAYER);
+        out->left = build_helper(netlist, left_nets, x1, y1, x2, y2, layer1, std::floor(best_pos));
+        out->right = build_helper(netlist, right_nets, x1, y1, x2, y2, std::floor(best_pos + 1), layer2);
     }
 
     if (out->left)
@@ -176,7 +252,6 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
     if (out->right)
         out->right->parent = out.get();
 
-    out->bb = {x1, x2, y1, y2, 0, 0};
     out->nets = my_nets;
     out->cutline_axis = best_axis;
     out->cutline_pos = best_pos;
@@ -184,25 +259,102 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
     /* Build net to ptree node lookup */
     for (auto net_id : my_nets) {
         _net_to_ptree_node[net_id] = out.get();
+        out->subtree_fanouts += netlist.net_sinks(net_id).size();
     }
+    if (out->left)
+        out->subtree_fanouts += out->left->subtree_fanouts;
+    if (out->right)
+        out->subtree_fanouts += out->right->subtree_fanouts;
+    out->built_imbalance = get_imbalance(*out);
+
     return out;
 }
 
 inline bool net_in_ptree_node(ParentNetId net_id, const PartitionTreeNode* node) {
     auto& route_ctx = g_vpr_ctx.routing();
     const t_bb& bb = route_ctx.route_bb[net_id];
-    return bb.xmin >= node->bb.xmin && bb.xmax <= node->bb.xmax && bb.ymin >= node->bb.ymin && bb.ymax <= node->bb.ymax;
+    return bb.xmin >= node->bb.xmin && bb.xmax <= node->bb.xmax && bb.ymin >= node->bb.ymin && bb.ymax <= node->bb.ymax
+           && bb.layer_min >= node->bb.layer_min && bb.layer_max <= node->bb.layer_max;
 }
 
-void PartitionTree::update_nets(const std::vector<ParentNetId>& nets) {
+size_t PartitionTree::update_nets(const std::vector<ParentNetId>& nets) {
+    /* Branch nodes which lost fanout from one of their sides */
+    std::unordered_set<PartitionTreeNode*> changed_nodes;
+
     for (auto net_id : nets) {
         PartitionTreeNode* old_ptree_node = _net_to_ptree_node[net_id];
         PartitionTreeNode* new_ptree_node = old_ptree_node;
         while (!net_in_ptree_node(net_id, new_ptree_node))
             new_ptree_node = new_ptree_node->parent;
+        if (new_ptree_node == old_ptree_node)
+            continue;
         old_ptree_node->nets.erase(net_id);
         new_ptree_node->nets.insert(net_id);
         _net_to_ptree_node[net_id] = new_ptree_node;
+
+        /* The net left every subtree between the old node and the new node */
+        size_t fanouts = _netlist->net_sinks(net_id).size();
+        for (PartitionTreeNode* node = old_ptree_node; node != new_ptree_node; node = node->parent) {
+            node->subtree_fanouts -= fanouts;
+            changed_nodes.insert(node->parent);
+        }
+    }
+
+    /* Find lopsided nodes. Only rebuild the topmost ones: rebuilding a node also rebuilds its subtree */
+    std::vector<PartitionTreeNode*> to_rebuild;
+    for (PartitionTreeNode* node : changed_nodes) {
+        if (node->subtree_fanouts < MIN_FANOUTS_TO_REBALANCE)
+            continue;
+        if (get_imbalance(*node) < REBALANCE_IMBALANCE_FAC * node->built_imbalance)
+            continue;
+        bool has_lopsided_ancestor = false;
+        for (PartitionTreeNode* p = node->parent; p; p = p->parent) {
+            if (changed_nodes.count(p) && p->subtree_fanouts >= MIN_FANOUTS_TO_REBALANCE
+                && get_imbalance(*p) >= REBALANCE_IMBALANCE_FAC * p->built_imbalance) {
+                has_lopsided_ancestor = true;
+                break;
+            }
+        }
+        if (!has_lopsided_ancestor)
+            to_rebuild.push_back(node);
+    }
+
+    for (PartitionTreeNode* node : to_rebuild) {
+        rebuild_subtree(node);
+    }
+
+    PartitionTreeDebug::log("Moved " + std::to_string(nets.size()) + " nets, rebuilt " + std::to_string(to_rebuild.size()) + " subtrees");
+    return to_rebuild.size();
+}
+
+void PartitionTree::rebuild_subtree(PartitionTreeNode* node) {
+    /* Collect the nets in this subtree */
+    std::unordered_set<ParentNetId> nets;
+    std::stack<PartitionTreeNode*> stack;
+    stack.push(node);
+    while (!stack.empty()) {
+        PartitionTreeNode* n = stack.top();
+        stack.pop();
+        nets.insert(n->nets.begin(), n->nets.end());
+        if (n->left)
+            stack.push(n->left.get());
+        if (n->right)
+            stack.push(n->right.get());
+    }
+
+    PartitionTreeNode* parent = node->parent;
+    std::unique_ptr<PartitionTreeNode> new_node = build_helper(*_netlist, nets, node->bb.xmin, node->bb.ymin, node->bb.xmax, node->bb.ymax, node->bb.layer_min, node->bb.layer_max);
+    /* Only branch nodes are rebuilt, so they hold enough nets to produce a new node */
+    VTR_ASSERT(new_node);
+    new_node->parent = parent;
+
+    if (!parent) {
+        _root = std::move(new_node);
+    } else if (parent->left.get() == node) {
+        parent->left = std::move(new_node);
+    } else {
+        VTR_ASSERT(parent->right.get() == node);
+        parent->right = std::move(new_node);
     }
 }
 
@@ -10,9 +10,10 @@
 #include <tbb/concurrent_vector.h>
 #endif
 
-/** Self-descriptive */
+/** Self-descriptive. LAYER cutlines separate the dies of a 3D device */
 enum class Axis { X,
-                  Y };
+                  Y,
+                  LAYER };
 
 /** Which side of a line? */
 enum class Side { LEFT = 0,
@@ -47,7 +48,12 @@ class VirtualNet {
  * by the cutline. Leaf nodes represent a final set of nets reached by partitioning.
  *
  * To route this in parallel, we first route the nets in the root node, then add
- * its left and right to a task queue, and repeat this for the whole tree. */
+ * its left and right to a task queue, and repeat this for the whole tree.
+ *
+ * On multi-layer or interposer-based devices, the boundaries between layers and dies are
+ * tried as cutlines before any other: the nets crossing them are usually few (they can only
+ * use the inter-die wires), so they are routed first, as a separate phase, at the top of the
+ * tree, and the dies are then routed in parallel. */
 class PartitionTreeNode {
   public:
     /** Nets claimed by this node (intersected by cutline if branch, nets in final region if leaf) */
@@ -60,12 +66,18 @@ class PartitionTreeNode {
     std::unique_ptr<PartitionTreeNode> right = nullptr;
     /** Parent node. */
     PartitionTreeNode* parent = nullptr;
-    /* Axis of the cutline. */
+    /* Axis of the cutline. Only X and Y cutlines are used to decompose nets (\see DecompNetlistRouter) */
     Axis cutline_axis = Axis::X;
     /* Position of the cutline. It's a float, because cutlines are considered to be "between" integral coordinates. */
     float cutline_pos = std::numeric_limits<float>::quiet_NaN();
     /* Bounding box of *this* node. (The cutline cuts this box) */
     t_bb bb;
+    /** Total fanout of the nets in this subtree (including this node). Kept up to date by
+     * \ref PartitionTree::update_nets() */
+    size_t subtree_fanouts = 0;
+    /** max(left, right) / min(left, right) subtree fanouts when this node was built.
+     * Used to detect subtrees which got lopsided after bounding box updates */
+    float built_imbalance = 1.0;
 };
 
 /** Holds the root PartitionTreeNode and exposes top level operations. */
@@ -85,8 +97,13 @@ class PartitionTree {
 
     /** Handle nets which had a bounding box update.
      * Bounding boxes can only grow, so we should find a new partition tree node for
-     * these nets by moving them up until they fit in a node's bounds */
-    void update_nets(const std::vector<ParentNetId>& nets);
+     * these nets by moving them up until they fit in a node's bounds.
+     *
+     * Only the given nets are touched. If moving them leaves a branch node with one side much
+     * heavier than it was when the node was built, the subtree under that node is rebuilt
+     * from its own nets. The rest of the tree is kept as is.
+     * \return Number of subtrees rebuilt */
+    size_t update_nets(const std::vector<ParentNetId>& nets);
 
     /** Delete all virtual nets in the tree. Used for the net decomposing router.
      * Virtual nets are invalidated between iterations due to changing bounding
@@ -94,9 +111,13 @@ class PartitionTree {
     void clear_vnets(void);
 
   private:
+    /** The netlist this tree was built from. Pointer instead of reference to keep PartitionTree movable */
+    const Netlist<>* _netlist;
     std::unique_ptr<PartitionTreeNode> _root;
     std::unordered_map<ParentNetId, PartitionTreeNode*> _net_to_ptree_node;
-    std::unique_ptr<PartitionTreeNode> build_helper(const Netlist<>& netlist, const std::unordered_set<ParentNetId>& nets, int x1, int y1, int x2, int y2);
+    std::unique_ptr<PartitionTreeNode> build_helper(const Netlist<>& netlist, const std::unordered_set<ParentNetId>& nets, int x1, int y1, int x2, int y2, int layer1, int layer2);
+    /** Rebuild the subtree under \p node from the nets currently in it. Invalidates \p node */
+    void rebuild_subtree(PartitionTreeNode* node);
 };
 
 #ifdef VPR_DEBUG_PARTITION_TREE
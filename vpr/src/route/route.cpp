@@ -1,17 +1,24 @@
 #include "concrete_timing_info.h"
 #include "connection_based_routing.h"
 #include "draw.h"
+#include "global_route_prepass.h"
 #include "netlist_routers.h"
 #include "place_and_route.h"
 #include "read_route.h"
 #include "route.h"
+#include "route_checkpoint.h"
 #include "route_common.h"
 #include "route_debug.h"
+#include "route_net_profile.h"
 #include "route_profiling.h"
+#include "route_utilization.h"
 #include "route_utils.h"
 #include "rr_graph.h"
+#include "rr_graph_track_mask.h"
 #include "router_lookahead_report.h"
+#include "setup_cache.h"
 #include "vtr_time.h"
+#include "vtr_profile.h"
 #include "vtr_expr_eval.h"
 
 bool route(const Netlist<>& net_list,
@@ -26,7 +33,8 @@ bool route(const Netlist<>& net_list,
            t_chan_width_dist chan_width_dist,
            const std::vector<t_direct_inf>& directs,
            ScreenUpdatePriority first_iteration_priority,
-           bool is_flat) {
+           bool is_flat,
+           RoutingFailureEstimate* failure_estimate) {
     auto& device_ctx = g_vpr_ctx.mutable_device();
     const auto& cluster_ctx = g_vpr_ctx.clustering();
     const auto& atom_ctx = g_vpr_ctx.atom();
@@ -53,18 +61,21 @@ bool route(const Netlist<>& net_list,
     t_chan_width chan_width = init_chan(width_fac, chan_width_dist, graph_directionality);
 
     /* Set up the routing resource graph defined by this FPGA architecture. */
-    int warning_count;
-
-    create_rr_graph(graph_type,
-                    device_ctx.physical_tile_types,
-                    device_ctx.grid,
-                    chan_width,
-                    det_routing_arch,
-                    segment_inf,
-                    router_opts,
-                    directs,
-                    &warning_count,
-                    is_flat);
+    int warning_count = 0;
+
+    // For narrower channel widths, the RR graph built for a wider one may be reused with its extra tracks masked off
+    if (!router_opts.masked_chan_width_search || !mask_rr_graph_tracks(chan_width, graph_type, is_flat)) {
+        create_rr_graph(graph_type,
+                        device_ctx.physical_tile_types,
+                        device_ctx.grid,
+                        chan_width,
+                        det_routing_arch,
+                        segment_inf,
+                        router_opts,
+                        directs,
+                        &warning_count,
+                        is_flat);
+    }
 
     //Initialize drawing, now that we have an RR graph
     init_draw_coords(width_fac, g_vpr_ctx.placement().blk_loc_registry());
@@ -77,6 +88,15 @@ bool route(const Netlist<>& net_list,
                        router_opts.has_choke_point,
                        is_flat);
 
+    if (router_opts.global_route_prepass) {
+        run_global_route_prepass(net_list, router_opts);
+    }
+
+    // The bidirectional connection search walks the RR graph backwards from the sinks
+    if (router_opts.bidirectional_search) {
+        device_ctx.rr_graph_builder.init_reverse_edges();
+    }
+
     IntraLbPbPinLookup intra_lb_pb_pin_lookup(device_ctx.logical_block_types);
     ClusteredPinAtomPinsLookup netlist_pin_lookup(cluster_ctx.clb_nlist, atom_ctx.netlist(), intra_lb_pb_pin_lookup);
 
@@ -100,7 +120,7 @@ bool route(const Netlist<>& net_list,
     float abort_iteration_threshold = std::numeric_limits<float>::infinity(); //Default no early abort
     if (router_opts.routing_failure_predictor == SAFE) {
         abort_iteration_threshold = ROUTING_PREDICTOR_ITERATION_ABORT_FACTOR_SAFE * router_opts.max_router_iterations;
-    } else if (router_opts.routing_failure_predictor == AGGRESSIVE) {
+    } else if (router_opts.routing_failure_predictor == AGGRESSIVE || router_opts.routing_failure_predictor == PRODUCTION) {
         abort_iteration_threshold = ROUTING_PREDICTOR_ITERATION_ABORT_FACTOR_AGGRESSIVE * router_opts.max_router_iterations;
     } else {
         VTR_ASSERT_MSG(router_opts.routing_failure_predictor == OFF, "Unrecognized routing failure predictor setting");
@@ -130,7 +150,10 @@ bool route(const Netlist<>& net_list,
                                                                           router_opts.read_router_lookahead,
                                                                           segment_inf,
                                                                           is_flat,
-                                                                          router_opts.route_verbosity);
+                                                                          router_opts.route_verbosity,
+                                                                          router_opts.setup_cache_dir,
+                                                                          router_opts.lookahead_lazy,
+                                                                          router_opts.lookahead_quantized);
 
     if (is_flat) {
         // If is_flat is true, the router lookahead maps related to intra-cluster resources should be initialized since
@@ -139,10 +162,27 @@ bool route(const Netlist<>& net_list,
         std::unique_ptr<RouterLookahead> mut_router_lookahead(route_ctx.cached_router_lookahead_.release());
         VTR_ASSERT(mut_router_lookahead);
         route_ctx.cached_router_lookahead_.clear();
+        // Only the map lookahead can write (and read) its intra-cluster lookahead
+        std::string intra_cluster_cache_file;
+        if (router_opts.read_intra_cluster_router_lookahead.empty() && router_opts.lookahead_type == e_router_lookahead::MAP) {
+            intra_cluster_cache_file = get_router_lookahead_cache_file(router_opts.setup_cache_dir,
+                                                                       router_opts.lookahead_type,
+                                                                       segment_inf,
+                                                                       is_flat);
+            if (!intra_cluster_cache_file.empty()) {
+                intra_cluster_cache_file.insert(intra_cluster_cache_file.size() - std::string(".capnp").size(), ".intra_cluster");
+            }
+        }
         if (!router_opts.read_intra_cluster_router_lookahead.empty()) {
             mut_router_lookahead->read_intra_cluster(router_opts.read_intra_cluster_router_lookahead);
+        } else if (setup_cache_file_exists(intra_cluster_cache_file)) {
+            VTR_LOG("Reading intra-cluster router lookahead from the setup cache '%s'\n", intra_cluster_cache_file.c_str());
+            mut_router_lookahead->read_intra_cluster(intra_cluster_cache_file);
         } else {
             mut_router_lookahead->compute_intra_tile();
+            write_setup_cache_file(intra_cluster_cache_file, [&](const std::string& file) {
+                mut_router_lookahead->write_intra_cluster(file);
+            });
         }
         route_ctx.cached_router_lookahead_.set(cache_key, std::move(mut_router_lookahead));
         router_lookahead = get_cached_router_lookahead(det_routing_arch,
@@ -151,7 +191,10 @@ bool route(const Netlist<>& net_list,
                                                        router_opts.read_router_lookahead,
                                                        segment_inf,
                                                        is_flat,
-                                                       router_opts.route_verbosity);
+                                                       router_opts.route_verbosity,
+                                                       router_opts.setup_cache_dir,
+                                                       router_opts.lookahead_lazy,
+                                                       router_opts.lookahead_quantized);
         if (!router_opts.write_intra_cluster_router_lookahead.empty()) {
             router_lookahead->write_intra_cluster(router_opts.write_intra_cluster_router_lookahead);
         }
@@ -234,6 +277,10 @@ bool route(const Netlist<>& net_list,
         router_opts.route_verbosity);
 
     RouterStats router_stats;
+    std::unique_ptr<NetRouteProfileWriter> net_profile_writer;
+    if (!router_opts.net_profile_file.empty()) {
+        net_profile_writer = std::make_unique<NetRouteProfileWriter>(router_opts.net_profile_file, net_list);
+    }
     float prev_iter_cumm_time = 0;
     vtr::Timer iteration_timer;
     int num_net_bounding_boxes_updated = 0;
@@ -251,12 +298,65 @@ bool route(const Netlist<>& net_list,
 
     int rcv_finished_count = RCV_FINISH_EARLY_COUNTDOWN;
 
+    bool predicted_unroutable = false;
+
+    int first_itry = 1;
+    RouteCheckpointState checkpoint;
+    if (router_opts.resume_routing
+        && read_route_checkpoint(router_opts.route_checkpoint_file, net_list, connections_inf, checkpoint, router_opts, width_fac, is_flat)) {
+        first_itry = checkpoint.itry + 1;
+        pres_fac = checkpoint.pres_fac;
+        update_draw_pres_fac(pres_fac);
+        bb_fac = checkpoint.bb_fac;
+        itry_conflicted_mode = checkpoint.itry_conflicted_mode;
+        itry_since_last_convergence = checkpoint.itry_since_last_convergence;
+        rcv_finished_count = checkpoint.rcv_finished_count;
+        if (checkpoint.conflicted_mode) {
+            router_congestion_mode = RouterCongestionMode::CONFLICTED;
+        }
+
+        //Bring the net delays and timing up to date with the restored routing
+        for (auto net_id : net_list.nets()) {
+            if (!net_list.net_is_ignored(net_id) && route_ctx.route_trees[net_id]) {
+                update_net_delays_from_route_tree(net_delay[net_id].data(), net_list, net_id, timing_info.get(), pin_timing_invalidator.get());
+            }
+        }
+        timing_info->update();
+        pin_timing_invalidator->reset();
+
+        if (router_opts.with_timing_analysis) {
+            connections_inf.set_stable_critical_path_delay(checkpoint.stable_critical_path_delay);
+            //The budgets are derived from the first iteration's delays, which aren't kept: use the
+            //restored ones instead
+            budgeting_inf.load_route_budgets(net_delay, timing_info, netlist_pin_lookup, router_opts);
+            if (router_opts.routing_budgets_algorithm == YOYO)
+                netlist_router->set_rcv_enabled(true);
+        }
+    } else if (!router_opts.eco_route_file.empty()
+               && read_eco_route(router_opts.eco_route_file.c_str(), net_list, is_flat) > 0) {
+        //Route around the kept routing from the first iteration: it is only ripped up (by setup_net())
+        //where it turns out to be congested
+        pres_fac = router_opts.initial_pres_fac;
+        update_draw_pres_fac(pres_fac);
+
+        //Bring the net delays and timing up to date with the kept routing
+        for (auto net_id : net_list.nets()) {
+            if (!net_list.net_is_ignored(net_id) && route_ctx.route_trees[net_id]) {
+                update_net_delays_from_route_tree(net_delay[net_id].data(), net_list, net_id, timing_info.get(), pin_timing_invalidator.get());
+            }
+        }
+        timing_info->update();
+        pin_timing_invalidator->reset();
+    }
+
     print_route_status_header();
 #ifndef NO_GRAPHICS
     // Reset router iteration in the current route attempt.
     get_bp_state_globals()->get_glob_breakpoint_state()->router_iter = 0;
 #endif
-    for (itry = 1; itry <= router_opts.max_router_iterations; ++itry) {
+    for (itry = first_itry; itry <= router_opts.max_router_iterations; ++itry) {
+        VTR_PROFILE_ZONE("Routing iteration");
+
         /* Reset "is_routed" and "is_fixed" flags to indicate nets not pre-routed (yet) */
         for (auto net_id : net_list.nets()) {
             route_ctx.net_status.set_is_routed(net_id, false);
@@ -352,6 +452,11 @@ bool route(const Netlist<>& net_list,
             print_route(net_list, nullptr, filename.c_str(), is_flat);
         }
 
+        if (net_profile_writer) {
+            net_profile_writer->write_iteration(itry, iter_results.stats.net_profiles);
+            iter_results.stats.net_profiles.clear(); //Don't keep them around for the whole routing
+        }
+
         //Update router stats (total)
         router_stats.combine(iter_results.stats);
 
@@ -427,6 +532,17 @@ bool route(const Netlist<>& net_list,
 
             if (!std::isnan(est_success_iteration) && est_success_iteration > abort_iteration_threshold && router_opts.routing_budgets_algorithm != YOYO) {
                 VTR_LOG("Routing aborted, the predicted iteration for a successful route (%.1f) is too high.\n", est_success_iteration);
+                predicted_unroutable = true;
+                break; //Abort
+            }
+
+            //In production mode, also give up once the overuse stops going down (the
+            //fit above can stay optimistic for a long time on a plateau)
+            if (router_opts.routing_failure_predictor == PRODUCTION && router_opts.routing_budgets_algorithm != YOYO
+                && routing_predictor.iterations_since_overuse_improvement(ROUTING_PREDICTOR_STALL_MIN_IMPROVEMENT) >= ROUTING_PREDICTOR_STALL_ITERATIONS) {
+                VTR_LOG("Routing aborted, the number of overused resources has not decreased by %g%% in %zu iterations.\n",
+                        100 * ROUTING_PREDICTOR_STALL_MIN_IMPROVEMENT, ROUTING_PREDICTOR_STALL_ITERATIONS);
+                predicted_unroutable = true;
                 break; //Abort
             }
         }
@@ -576,6 +692,21 @@ bool route(const Netlist<>& net_list,
         if (router_opts.congestion_analysis) profiling::congestion_analysis();
         if (router_opts.fanout_analysis) profiling::time_on_fanout_analysis();
         // profiling::time_on_criticality_analysis();
+
+        //Checkpoint the routing state, until a legal routing (which isn't checkpointed) was found
+        if (!router_opts.route_checkpoint_file.empty()
+            && itry % router_opts.route_checkpoint_interval == 0
+            && legal_convergence_count == 0) {
+            checkpoint.itry = itry;
+            checkpoint.pres_fac = pres_fac;
+            checkpoint.bb_fac = bb_fac;
+            checkpoint.itry_conflicted_mode = itry_conflicted_mode;
+            checkpoint.itry_since_last_convergence = itry_since_last_convergence;
+            checkpoint.rcv_finished_count = rcv_finished_count;
+            checkpoint.conflicted_mode = (router_congestion_mode == RouterCongestionMode::CONFLICTED);
+            checkpoint.stable_critical_path_delay = connections_inf.get_stable_critical_path_delay();
+            write_route_checkpoint(router_opts.route_checkpoint_file, net_list, connections_inf, checkpoint, router_opts, width_fac, is_flat);
+        }
     }
 
     /* Write out partition tree logs (no-op if debug option not set) */
@@ -609,6 +740,11 @@ bool route(const Netlist<>& net_list,
         //If the routing fails, print the overused info
         print_overused_nodes_status(router_opts, overuse_info);
 
+        if (failure_estimate) {
+            failure_estimate->predicted_unroutable = predicted_unroutable;
+            failure_estimate->peak_channel_util = calculate_peak_channel_util(is_flat);
+        }
+
         if constexpr (VTR_ENABLE_DEBUG_LOGGING_CONST_EXPR) {
             if (f_router_debug) {
                 print_invalid_routing_info(net_list, is_flat);
@@ -616,6 +752,10 @@ bool route(const Netlist<>& net_list,
         }
     }
 
+    if (net_profile_writer) {
+        net_profile_writer->print_summary();
+    }
+
     if (router_opts.with_timing_analysis) {
         VTR_LOG("Final Net Connection Criticality Histogram:\n");
         print_router_criticality_histogram(net_list, *timing_info, netlist_pin_lookup, is_flat);
@@ -626,6 +766,19 @@ bool route(const Netlist<>& net_list,
     VTR_LOG(
         "Router Stats: total_nets_routed: %zu total_connections_routed: %zu total_heap_pushes: %zu total_heap_pops: %zu ",
         router_stats.nets_routed, router_stats.connections_routed, router_stats.heap_pushes, router_stats.heap_pops);
+    if (router_opts.enable_parallel_connection_router) {
+        VTR_LOG(
+            "total_heap_stale_pops: %zu total_wasted_expansions: %zu total_heap_lock_contention: %zu total_node_lock_contention: %zu ",
+            router_stats.heap_stale_pops, router_stats.wasted_expansions,
+            router_stats.heap_lock_contention, router_stats.node_lock_contention);
+    }
+    if (router_opts.lookahead_cache_entries > 0) {
+        size_t lookahead_queries = router_stats.lookahead_cache_hits + router_stats.lookahead_cache_misses;
+        VTR_LOG(
+            "total_lookahead_cache_hits: %zu total_lookahead_cache_misses: %zu lookahead_cache_hit_rate: %.3f ",
+            router_stats.lookahead_cache_hits, router_stats.lookahead_cache_misses,
+            lookahead_queries > 0 ? float(router_stats.lookahead_cache_hits) / lookahead_queries : 0.f);
+    }
     if constexpr (VTR_ENABLE_DEBUG_LOGGING_CONST_EXPR) {
         VTR_LOG(
             "total_internal_heap_pushes: %zu total_internal_heap_pops: %zu total_external_heap_pushes: %zu total_external_heap_pops: %zu ",
@@ -640,6 +793,7 @@ bool route(const Netlist<>& net_list,
             VTR_LOG("rt_node_%s_pushes: %zu ", rr_node_typename[rr_type], router_stats.rt_node_pushes[rr_type]);
         }
     }
+    VTR_LOG("total_connections_reused: %zu", router_stats.connections_reused);
     VTR_LOG("\n");
 
     return success;
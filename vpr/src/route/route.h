@@ -6,6 +6,14 @@
 #include "vpr_types.h"
 #include "netlist.h"
 
+/** What route() learned from a failed routing, which predicts how other channel widths will fare */
+struct RoutingFailureEstimate {
+    ///@brief Whether the routing failure predictor gave up on the routing (as opposed to running out of iterations)
+    bool predicted_unroutable = false;
+    ///@brief Highest ratio of used to available tracks over all channels, in the final routing
+    float peak_channel_util = 0.;
+};
+
 /** Attempts a routing via the AIR algorithm [0].
  *
  * \p width_fac specifies the relative width of the channels, while the members of
@@ -16,6 +24,8 @@
  *
  * [0]: K. E. Murray, S. Zhong, and V. Betz, "AIR: A fast but lazy timing-driven FPGA router", in ASPDAC 2020
  *
+ * If \p failure_estimate is given, it is filled in when the routing fails.
+ *
  * \return Success status. */
 bool route(const Netlist<>& net_list,
            int width_fac,
@@ -29,4 +39,5 @@ bool route(const Netlist<>& net_list,
            t_chan_width_dist chan_width_dist,
            const std::vector<t_direct_inf>& directs,
            ScreenUpdatePriority first_iteration_priority,
-           bool is_flat);
+           bool is_flat,
+           RoutingFailureEstimate* failure_estimate = nullptr);
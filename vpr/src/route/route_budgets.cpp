@@ -30,6 +30,11 @@
 #include "route_budgets.h"
 #include "vtr_time.h"
 
+#ifdef VPR_USE_TBB
+#include <tbb/combinable.h>
+#include <tbb/parallel_for_each.h>
+#endif
+
 #define SHORT_PATH_EXP 0.5
 
 route_budgets::route_budgets(const Netlist<>& net_list, bool is_flat)
@@ -125,6 +130,10 @@ void route_budgets::load_route_budgets(NetPinsMatrix<float>& net_delay,
     } else if (router_opts.routing_budgets_algorithm == SCALE_DELAY) {
         allocate_slack_using_delays_and_criticalities(net_delay, timing_info, netlist_pin_lookup, router_opts);
     }
+
+    /*the timing analyses refer to the delay matrices, which only live during this call*/
+    budget_timing_analyses_.clear();
+
     set = true;
 }
 
@@ -182,11 +191,11 @@ void route_budgets::allocate_slack_using_weights(NetPinsMatrix<float>& net_delay
     // An experimentally derived constant that allows for a balance between budget calculation time, and quality
     constexpr float MAX_BUDGET_CHANGE_THRESHOLD = 5e-12;
 
-    original_timing_info = perform_sta(net_delay);
+    original_timing_info = perform_sta(net_delay, netlist_pin_lookup);
 
     /*This allocates long path slack and increases the budgets*/
     while ((iteration > 3 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD) || iteration <= 3) {
-        timing_info = perform_sta(delay_max_budget);
+        timing_info = perform_sta(delay_max_budget, netlist_pin_lookup);
 
         max_budget_change = minimax_PERT(original_timing_info, timing_info, delay_max_budget, net_delay, netlist_pin_lookup, SETUP, true, BOTH);
 
@@ -207,15 +216,15 @@ void route_budgets::allocate_slack_using_weights(NetPinsMatrix<float>& net_delay
     /*Set the minimum budgets equal to the maximum budgets*/
     set_min_max_budgets_equal();
 
-    original_timing_info = perform_sta(net_delay);
-    timing_info_min = perform_sta(delay_min_budget);
+    original_timing_info = perform_sta(net_delay, netlist_pin_lookup);
+    timing_info_min = perform_sta(delay_min_budget, netlist_pin_lookup);
 
     iteration = 0;
     max_budget_change = 900e-12;
 
     /*Allocate the short path slack to decrease the budgets accordingly*/
     while ((iteration > 3 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD) || iteration <= 3) {
-        timing_info_min = perform_sta(delay_min_budget);
+        timing_info_min = perform_sta(delay_min_budget, netlist_pin_lookup);
         max_budget_change = minimax_PERT(original_timing_info, timing_info_min, delay_min_budget, net_delay, netlist_pin_lookup, HOLD, true, POSITIVE);
         iteration++;
 
@@ -230,13 +239,13 @@ void route_budgets::allocate_slack_using_weights(NetPinsMatrix<float>& net_delay
     max_budget_change = 900e-12;
     float bottom_range = -1e-9;
 
-    original_timing_info = perform_sta(net_delay);
+    original_timing_info = perform_sta(net_delay, netlist_pin_lookup);
     while (iteration < 5 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD) {
         /*budgets must be in bounds before timing analysis*/
         if (iteration != 0) {
             keep_budget_in_bounds(delay_min_budget);
         }
-        timing_info_min = perform_sta(delay_min_budget);
+        timing_info_min = perform_sta(delay_min_budget, netlist_pin_lookup);
         max_budget_change = minimax_PERT(original_timing_info, timing_info_min, delay_min_budget, net_delay, netlist_pin_lookup, HOLD, false, POSITIVE);
         iteration++;
     }
@@ -257,7 +266,7 @@ void route_budgets::process_negative_slack_using_minimax(NetPinsMatrix<float>& n
     iteration = 0;
     max_budget_change = 900e-12;
     float second_max_budget_change = 900e-12;
-    original_timing_info = perform_sta(net_delay);
+    original_timing_info = perform_sta(net_delay, netlist_pin_lookup);
 
     // Cutoff threshold so if budgets aren't changing, stop early
     constexpr float MAX_BUDGET_CHANGE_THRESHOLD_PREPROCESSING = 5e-12;
@@ -265,11 +274,11 @@ void route_budgets::process_negative_slack_using_minimax(NetPinsMatrix<float>& n
     while (iteration < 20 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD_PREPROCESSING) {
         if (iteration == 0) {
             max_budget_change = minimax_PERT(original_timing_info, original_timing_info, delay_max_budget, net_delay, netlist_pin_lookup, HOLD, true, NEGATIVE);
-            timing_info = perform_sta(delay_max_budget);
+            timing_info = perform_sta(delay_max_budget, netlist_pin_lookup);
         } else {
             second_max_budget_change = minimax_PERT(original_timing_info, timing_info, delay_max_budget, net_delay, netlist_pin_lookup, HOLD, true, NEGATIVE);
             max_budget_change = std::max(max_budget_change, second_max_budget_change);
-            timing_info = perform_sta(delay_max_budget);
+            timing_info = perform_sta(delay_max_budget, netlist_pin_lookup);
         }
 
         iteration++;
@@ -341,11 +350,15 @@ float route_budgets::minimax_PERT(std::shared_ptr<SetupHoldTimingInfo> orig_timi
      * The weights are deteremined by how much delay of the whole path is present in this connection*/
 
     std::shared_ptr<const tatum::SetupHoldTimingAnalyzer> timing_analyzer = orig_timing_info->setup_hold_analyzer();
-    float total_path_delay = 0;
-    float path_slack;
-    float hold_path_slack;
-    float max_budget_change = 0;
-    for (auto net_id : net_list_.nets()) {
+
+    /*Allocates the slack of the connections of a net and returns the largest budget change.
+     * Each connection only updates its own budget (and cached path delay), so the nets can
+     * be processed in parallel*/
+    auto allocate_net_slack = [&](ParentNetId net_id, bool& reroute_for_hold) {
+        float total_path_delay = 0;
+        float path_slack;
+        float hold_path_slack;
+        float max_budget_change = 0;
         for (auto pin_id : net_list_.net_sinks(net_id)) {
             int ipin = net_list_.pin_net_index(pin_id);
             AtomPinId atom_pin;
@@ -405,10 +418,41 @@ float route_budgets::minimax_PERT(std::shared_ptr<SetupHoldTimingInfo> orig_timi
             }
 
             if ((slack_type == NEGATIVE && path_slack < 0 && analysis_type == HOLD) || hold_path_slack < 0) {
-                should_reroute_for_hold[net_id] = true;
+                reroute_for_hold = true;
             }
         }
+        return max_budget_change;
+    };
+
+    float max_budget_change = 0;
+#ifdef VPR_USE_TBB
+    tbb::combinable<float> thread_max_budget_change(0.f);
+    tbb::combinable<std::vector<ParentNetId>> thread_reroute_nets;
+
+    tbb::parallel_for_each(net_list_.nets().begin(), net_list_.nets().end(), [&](ParentNetId net_id) {
+        bool reroute_for_hold = false;
+        float& thread_max = thread_max_budget_change.local();
+        thread_max = std::max(thread_max, allocate_net_slack(net_id, reroute_for_hold));
+        if (reroute_for_hold) {
+            thread_reroute_nets.local().push_back(net_id);
+        }
+    });
+
+    max_budget_change = thread_max_budget_change.combine([](float a, float b) { return std::max(a, b); });
+    thread_reroute_nets.combine_each([&](const std::vector<ParentNetId>& reroute_nets) {
+        for (ParentNetId net_id : reroute_nets) {
+            should_reroute_for_hold[net_id] = true;
+        }
+    });
+#else
+    for (auto net_id : net_list_.nets()) {
+        bool reroute_for_hold = false;
+        max_budget_change = std::max(max_budget_change, allocate_net_slack(net_id, reroute_for_hold));
+        if (reroute_for_hold) {
+            should_reroute_for_hold[net_id] = true;
+        }
     }
+#endif
     return max_budget_change;
 }
 
@@ -635,20 +679,53 @@ void route_budgets::check_if_budgets_in_bounds() {
     }
 }
 
-std::shared_ptr<SetupHoldTimingInfo> route_budgets::perform_sta(NetPinsMatrix<float>& temp_budgets) {
+std::shared_ptr<SetupHoldTimingInfo> route_budgets::perform_sta(NetPinsMatrix<float>& temp_budgets,
+                                                                const ClusteredPinAtomPinsLookup& netlist_pin_lookup) {
     auto& atom_ctx = g_vpr_ctx.atom();
-    /*Perform static timing analysis to get the delay and path weights for slack allocation*/
-    std::shared_ptr<RoutingDelayCalculator> routing_delay_calc = std::make_shared<RoutingDelayCalculator>(atom_ctx.netlist(), atom_ctx.lookup(), temp_budgets, is_flat_);
-
-    //TODO: now that we support incremental timing updates, we should avoid re-building the timing analyzer from scratch and try
-    //      to calculate this incrementally
-    std::shared_ptr<SetupHoldTimingInfo> timing_info = make_setup_hold_timing_info(routing_delay_calc, e_timing_update_type::AUTO);
+    /*Perform static timing analysis to get the delay and path weights for slack allocation.
+     *
+     * The same delay matrix is analyzed many times while the budgets converge, so each matrix
+     * keeps its own incremental analyzer, and only the connections whose delay changed since
+     * its last analysis are re-timed*/
+    auto iter = budget_timing_analyses_.find(&temp_budgets);
+    if (iter == budget_timing_analyses_.end()) {
+        BudgetTimingAnalysis analysis;
+
+        std::shared_ptr<RoutingDelayCalculator> routing_delay_calc = std::make_shared<RoutingDelayCalculator>(atom_ctx.netlist(), atom_ctx.lookup(), temp_budgets, is_flat_);
+        analysis.timing_info = make_setup_hold_timing_info(routing_delay_calc, e_timing_update_type::INCREMENTAL);
+        analysis.pin_timing_invalidator = make_net_pin_timing_invalidator(e_timing_update_type::INCREMENTAL,
+                                                                          net_list_,
+                                                                          netlist_pin_lookup,
+                                                                          atom_ctx.netlist(),
+                                                                          atom_ctx.lookup(),
+                                                                          analysis.timing_info,
+                                                                          is_flat_);
+        analysis.analyzed_delays = temp_budgets;
+
+        /*Unconstrained nodes should be warned in the main routing function, do not report it here*/
+        analysis.timing_info->set_warn_unconstrained(false);
+
+        /*The first analysis is a full one*/
+        iter = budget_timing_analyses_.emplace(&temp_budgets, std::move(analysis)).first;
+    } else {
+        BudgetTimingAnalysis& analysis = iter->second;
+
+        for (auto net_id : net_list_.nets()) {
+            for (auto pin_id : net_list_.net_sinks(net_id)) {
+                int ipin = net_list_.pin_net_index(pin_id);
+                if (analysis.analyzed_delays[net_id][ipin] != temp_budgets[net_id][ipin]) {
+                    analysis.pin_timing_invalidator->invalidate_connection(pin_id);
+                    analysis.analyzed_delays[net_id][ipin] = temp_budgets[net_id][ipin];
+                }
+            }
+        }
+    }
 
-    /*Unconstrained nodes should be warned in the main routing function, do not report it here*/
-    timing_info->set_warn_unconstrained(false);
-    timing_info->update();
+    BudgetTimingAnalysis& analysis = iter->second;
+    analysis.timing_info->update();
+    analysis.pin_timing_invalidator->reset();
 
-    return timing_info;
+    return analysis.timing_info;
 }
 
 void route_budgets::update_congestion_times(ParentNetId net_id) {
@@ -3,9 +3,12 @@
  * target, upper bound, and lower bound budgets. These information are
  * used by the router to optimize for hold time. */
 
+#include <map>
+#include <memory>
 #include <vector>
 #include <queue>
 #include "RoutingDelayCalculator.h"
+#include "NetPinTimingInvalidator.h"
 #include "clustered_netlist_utils.h"
 #include "timing_info.h"
 
@@ -82,7 +85,8 @@ class route_budgets {
     void process_negative_slack_using_minimax(NetPinsMatrix<float>& net_delay, const ClusteredPinAtomPinsLookup& netlist_pin_lookup);
 
     /*Perform static timing analysis*/
-    std::shared_ptr<SetupHoldTimingInfo> perform_sta(NetPinsMatrix<float>& temp_budgets);
+    std::shared_ptr<SetupHoldTimingInfo> perform_sta(NetPinsMatrix<float>& temp_budgets,
+                                                     const ClusteredPinAtomPinsLookup& netlist_pin_lookup);
 
     /*checks*/
     void keep_budget_in_bounds(NetPinsMatrix<float>& temp_budgets);
@@ -135,6 +139,15 @@ class route_budgets {
     /*budgets only valid when loaded*/
     bool set;
 
+    /*Incremental timing analysis of one set of connection delays (the net delays,
+     * or the minimum or maximum budgets) while the budgets are calculated*/
+    struct BudgetTimingAnalysis {
+        std::shared_ptr<SetupHoldTimingInfo> timing_info;
+        std::unique_ptr<NetPinTimingInvalidator> pin_timing_invalidator;
+        NetPinsMatrix<float> analyzed_delays; //Connection delays of the last analysis
+    };
+    std::map<const NetPinsMatrix<float>*, BudgetTimingAnalysis> budget_timing_analyses_;
+
     /*flag to reroute each net for hold violation*/
     std::map<ParentNetId, bool> should_reroute_for_hold;
     std::map<ParentNetId, int> hold_fac;
@@ -0,0 +1,345 @@
+#include "route_checkpoint.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#include "check_route.h"
+#include "globals.h"
+#include "old_traceback.h"
+#include "route_common.h"
+#include "vpr_error.h"
+#include "vtr_log.h"
+
+/** Identifies route checkpoint files */
+static constexpr char ROUTE_CHECKPOINT_MAGIC[8] = {'V', 'P', 'R', 'R', 'T', 'C', 'K', 'P'};
+/** Bumped whenever the layout of the file changes */
+static constexpr uint32_t ROUTE_CHECKPOINT_VERSION = 1;
+
+template<typename T>
+static void write_value(std::ofstream& os, const T& value);
+
+static void write_string(std::ofstream& os, const std::string& str);
+
+template<typename T>
+static T read_value(std::ifstream& is, const std::string& filename);
+
+static std::string read_string(std::ifstream& is, const std::string& filename);
+
+static void write_route_tree(std::ofstream& os, const vtr::optional<RouteTree>& tree);
+
+static vtr::optional<RouteTree> read_route_tree(std::ifstream& is, const std::string& filename, ParentNetId net_id);
+
+/******************************* Writing **********************************/
+
+void write_route_checkpoint(const std::string& filename,
+                            const Netlist<>& net_list,
+                            const CBRR& connections_inf,
+                            const RouteCheckpointState& state,
+                            const t_router_opts& router_opts,
+                            int width_fac,
+                            bool is_flat) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& route_ctx = g_vpr_ctx.routing();
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    std::string tmp_filename = filename + ".tmp";
+    std::ofstream os(tmp_filename, std::ios::binary | std::ios::trunc);
+    if (!os) {
+        VTR_LOG_WARN("Could not open '%s' to write the route checkpoint\n", tmp_filename.c_str());
+        return;
+    }
+
+    /* What the checkpoint was built for */
+    os.write(ROUTE_CHECKPOINT_MAGIC, sizeof(ROUTE_CHECKPOINT_MAGIC));
+    write_value<uint32_t>(os, ROUTE_CHECKPOINT_VERSION);
+    write_string(os, g_vpr_ctx.placement().placement_id);
+    write_value<int32_t>(os, width_fac);
+    write_value<uint8_t>(os, is_flat);
+    write_value<uint64_t>(os, device_ctx.rr_graph.num_nodes());
+    write_value<uint64_t>(os, net_list.nets().size());
+    write_value<int32_t>(os, (int)router_opts.lookahead_type);
+    write_string(os, router_opts.read_router_lookahead);
+
+    /* Scalar state of the routing loop */
+    write_value<int32_t>(os, state.itry);
+    write_value<float>(os, state.pres_fac);
+    write_value<int32_t>(os, state.bb_fac);
+    write_value<int32_t>(os, state.itry_conflicted_mode);
+    write_value<int32_t>(os, state.itry_since_last_convergence);
+    write_value<int32_t>(os, state.rcv_finished_count);
+    write_value<uint8_t>(os, state.conflicted_mode);
+    write_value<float>(os, state.stable_critical_path_delay);
+
+    /* Historical congestion */
+    for (RRNodeId inode : device_ctx.rr_graph.nodes()) {
+        write_value<float>(os, route_ctx.rr_node_route_inf[inode].acc_cost);
+    }
+
+    /* Per-net state */
+    for (ParentNetId net_id : net_list.nets()) {
+        const t_bb& bb = route_ctx.route_bb[net_id];
+        for (int coord : {bb.xmin, bb.xmax, bb.ymin, bb.ymax, bb.layer_min, bb.layer_max}) {
+            write_value<int32_t>(os, coord);
+        }
+
+        for (size_t ipin = 1; ipin < net_list.net_pins(net_id).size(); ipin++) {
+            write_value<float>(os, connections_inf.get_lower_bound_connection_delay(net_id, ipin));
+        }
+
+        write_route_tree(os, route_ctx.route_trees[net_id]);
+    }
+
+    if (!is_flat) {
+        for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+            const std::vector<std::vector<RRNodeId>>& blk_opins = route_ctx.clb_opins_used_locally[blk_id];
+            write_value<uint32_t>(os, blk_opins.size());
+            for (const std::vector<RRNodeId>& class_opins : blk_opins) {
+                write_value<uint32_t>(os, class_opins.size());
+                for (RRNodeId inode : class_opins) {
+                    write_value<int32_t>(os, inode ? int32_t(size_t(inode)) : -1);
+                }
+            }
+        }
+    }
+
+    os.close();
+    if (!os) {
+        VTR_LOG_WARN("Failed to write the route checkpoint to '%s'\n", tmp_filename.c_str());
+        std::remove(tmp_filename.c_str());
+        return;
+    }
+
+    // Replace the previous checkpoint in one step, so an interrupted write never leaves a partial one
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        VTR_LOG_WARN("Failed to rename '%s' to '%s': %s\n", tmp_filename.c_str(), filename.c_str(), std::strerror(errno));
+        return;
+    }
+
+    if (router_opts.route_verbosity > 1) {
+        VTR_LOG("Wrote route checkpoint '%s' after routing iteration %d\n", filename.c_str(), state.itry);
+    }
+}
+
+/******************************* Reading **********************************/
+
+bool read_route_checkpoint(const std::string& filename,
+                           const Netlist<>& net_list,
+                           CBRR& connections_inf,
+                           RouteCheckpointState& state,
+                           const t_router_opts& router_opts,
+                           int width_fac,
+                           bool is_flat) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const char* fname = filename.c_str();
+
+    std::ifstream is(filename, std::ios::binary);
+    if (!is) {
+        VTR_LOG("No route checkpoint '%s' to resume from, routing from scratch\n", fname);
+        return false;
+    }
+
+    /* Check that the checkpoint belongs to this routing problem */
+    char magic[sizeof(ROUTE_CHECKPOINT_MAGIC)];
+    is.read(magic, sizeof(magic));
+    if (!is || std::memcmp(magic, ROUTE_CHECKPOINT_MAGIC, sizeof(magic)) != 0
+        || read_value<uint32_t>(is, filename) != ROUTE_CHECKPOINT_VERSION) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "'%s' is not a route checkpoint written by this version of VPR\n", fname);
+    }
+
+    std::string placement_id = read_string(is, filename);
+    if (placement_id != g_vpr_ctx.placement().placement_id) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Route checkpoint '%s' does not match the loaded placement (ID %s != %s)\n",
+                        fname, placement_id.c_str(), g_vpr_ctx.placement().placement_id.c_str());
+    }
+
+    int file_width_fac = read_value<int32_t>(is, filename);
+    if (file_width_fac != width_fac) {
+        VTR_LOG("Route checkpoint '%s' is for channel width %d, routing channel width %d from scratch\n",
+                fname, file_width_fac, width_fac);
+        return false;
+    }
+
+    bool file_is_flat = read_value<uint8_t>(is, filename);
+    uint64_t num_rr_nodes = read_value<uint64_t>(is, filename);
+    uint64_t num_nets = read_value<uint64_t>(is, filename);
+    if (file_is_flat != is_flat || num_rr_nodes != device_ctx.rr_graph.num_nodes() || num_nets != net_list.nets().size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Route checkpoint '%s' was written for another RR graph or netlist (%zu RR nodes and %zu nets, expected %zu and %zu)\n",
+                        fname, size_t(num_rr_nodes), size_t(num_nets), device_ctx.rr_graph.num_nodes(), net_list.nets().size());
+    }
+
+    e_router_lookahead lookahead_type = (e_router_lookahead)read_value<int32_t>(is, filename);
+    std::string read_router_lookahead = read_string(is, filename);
+    if (lookahead_type != router_opts.lookahead_type || read_router_lookahead != router_opts.read_router_lookahead) {
+        VTR_LOG_WARN("Route checkpoint '%s' was written with another router lookahead, resuming with the current one\n", fname);
+    }
+
+    /* Scalar state of the routing loop */
+    state.itry = read_value<int32_t>(is, filename);
+    state.pres_fac = read_value<float>(is, filename);
+    state.bb_fac = read_value<int32_t>(is, filename);
+    state.itry_conflicted_mode = read_value<int32_t>(is, filename);
+    state.itry_since_last_convergence = read_value<int32_t>(is, filename);
+    state.rcv_finished_count = read_value<int32_t>(is, filename);
+    state.conflicted_mode = read_value<uint8_t>(is, filename);
+    state.stable_critical_path_delay = read_value<float>(is, filename);
+
+    /* Historical congestion */
+    for (RRNodeId inode : device_ctx.rr_graph.nodes()) {
+        route_ctx.rr_node_route_inf[inode].acc_cost = read_value<float>(is, filename);
+    }
+
+    /* Per-net state */
+    for (ParentNetId net_id : net_list.nets()) {
+        int coords[6];
+        for (int& coord : coords) {
+            coord = read_value<int32_t>(is, filename);
+        }
+        route_ctx.route_bb[net_id] = t_bb(coords[0], coords[1], coords[2], coords[3], coords[4], coords[5]);
+
+        for (size_t ipin = 1; ipin < net_list.net_pins(net_id).size(); ipin++) {
+            // The lower bounds start out at infinity, so this sets them
+            connections_inf.update_lower_bound_connection_delay(net_id, ipin, read_value<float>(is, filename));
+        }
+
+        route_ctx.route_trees[net_id] = read_route_tree(is, filename, net_id);
+    }
+
+    if (!is_flat) {
+        for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+            std::vector<std::vector<RRNodeId>>& blk_opins = route_ctx.clb_opins_used_locally[blk_id];
+            if (read_value<uint32_t>(is, filename) != blk_opins.size()) {
+                VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Route checkpoint '%s' does not match the locally used OPINs of block %zu\n", fname, size_t(blk_id));
+            }
+            for (std::vector<RRNodeId>& class_opins : blk_opins) {
+                if (read_value<uint32_t>(is, filename) != class_opins.size()) {
+                    VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Route checkpoint '%s' does not match the locally used OPINs of block %zu\n", fname, size_t(blk_id));
+                }
+                for (RRNodeId& inode : class_opins) {
+                    int32_t node = read_value<int32_t>(is, filename);
+                    if (node < -1 || node >= (int64_t)num_rr_nodes) {
+                        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Route checkpoint '%s' is corrupted (RR node %d)\n", fname, node);
+                    }
+                    inode = (node < 0) ? RRNodeId::INVALID() : RRNodeId(node);
+                }
+            }
+        }
+    }
+
+    if (is.peek() != std::ifstream::traits_type::eof()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Route checkpoint '%s' is corrupted (trailing data)\n", fname);
+    }
+
+    /* The occupancies follow from the restored routing */
+    recompute_occupancy_from_scratch(net_list, is_flat);
+
+    VTR_LOG("Resuming routing from checkpoint '%s' after routing iteration %d\n", fname, state.itry);
+    return true;
+}
+
+/******************************* Helpers **********************************/
+
+template<typename T>
+static void write_value(std::ofstream& os, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void write_string(std::ofstream& os, const std::string& str) {
+    write_value<uint64_t>(os, str.size());
+    os.write(str.data(), str.size());
+}
+
+template<typename T>
+static T read_value(std::ifstream& is, const std::string& filename) {
+    T value;
+    is.read(reinterpret_cast<char*>(&value), sizeof(T));
+    if (!is) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Route checkpoint '%s' is truncated\n", filename.c_str());
+    }
+    return value;
+}
+
+static std::string read_string(std::ifstream& is, const std::string& filename) {
+    uint64_t size = read_value<uint64_t>(is, filename);
+    // Strings are IDs and file names: anything longer means the file is garbage
+    if (size > (1 << 16)) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Route checkpoint '%s' is corrupted (string of %zu characters)\n", filename.c_str(), size_t(size));
+    }
+    std::string str(size, '\0');
+    is.read(str.data(), size);
+    if (!is) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Route checkpoint '%s' is truncated\n", filename.c_str());
+    }
+    return str;
+}
+
+/** Writes a route tree as its (legacy) traceback, which is a flat list of nodes */
+static void write_route_tree(std::ofstream& os, const vtr::optional<RouteTree>& tree) {
+    if (!tree) {
+        write_value<uint32_t>(os, 0);
+        return;
+    }
+
+    t_trace* head = TracebackCompat::traceback_from_route_tree(tree.value());
+    uint32_t num_elements = 0;
+    for (t_trace* tptr = head; tptr; tptr = tptr->next) {
+        num_elements++;
+    }
+
+    write_value<uint32_t>(os, num_elements);
+    for (t_trace* tptr = head; tptr; tptr = tptr->next) {
+        write_value<int32_t>(os, tptr->index);
+        write_value<int32_t>(os, tptr->net_pin_index);
+        write_value<int16_t>(os, tptr->iswitch);
+    }
+    free_traceback(head);
+}
+
+/** Reads back a route tree written by write_route_tree, checking that it is a valid routing of net_id */
+static vtr::optional<RouteTree> read_route_tree(std::ifstream& is, const std::string& filename, ParentNetId net_id) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    uint32_t num_elements = read_value<uint32_t>(is, filename);
+    if (num_elements == 0) {
+        return vtr::nullopt;
+    }
+
+    int num_sinks = route_ctx.net_rr_terminals[net_id].size() - 1;
+    t_trace* head = nullptr;
+    t_trace* tail = nullptr;
+    for (uint32_t ielement = 0; ielement < num_elements; ielement++) {
+        t_trace* tptr = alloc_trace_data();
+        tptr->index = read_value<int32_t>(is, filename);
+        tptr->net_pin_index = read_value<int32_t>(is, filename);
+        tptr->iswitch = read_value<int16_t>(is, filename);
+        tptr->next = nullptr;
+
+        if (tail) {
+            tail->next = tptr;
+        } else {
+            head = tptr;
+        }
+        tail = tptr;
+
+        if (tptr->index < 0 || size_t(tptr->index) >= device_ctx.rr_graph.num_nodes() || tptr->net_pin_index > num_sinks) {
+            free_traceback(head);
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Route checkpoint '%s' is corrupted (routing of net %zu)\n", filename.c_str(), size_t(net_id));
+        }
+    }
+
+    if (RRNodeId(head->index) != route_ctx.net_rr_terminals[net_id][0] || !validate_and_update_traceback(head)) {
+        free_traceback(head);
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Route checkpoint '%s' has an invalid routing for net %zu\n", filename.c_str(), size_t(net_id));
+    }
+
+    vtr::optional<RouteTree> tree = TracebackCompat::traceback_to_route_tree(head, net_id);
+    free_traceback(head);
+    return tree;
+}
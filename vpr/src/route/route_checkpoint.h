@@ -0,0 +1,80 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Checkpointing of the router state between routing iterations.
+ *
+ * A checkpoint is written at the end of a routing iteration (see write_route_checkpoint()) and holds
+ * everything the main routing loop in route() needs to carry on with the next iteration as if it had
+ * never stopped:
+ *  - the route tree of each net, the locally used OPINs and the route bounding boxes,
+ *  - the accumulated (historical) congestion cost of each RR node,
+ *  - the lower bound connection delays of the connection based rerouting,
+ *  - the iteration counters, present congestion factor and congestion mode (RouteCheckpointState).
+ *
+ * The occupancy of the RR nodes and the net delays follow from the routing, so they are recomputed
+ * instead of being stored. The file also records what it was built for (placement, channel width,
+ * RR graph and router lookahead), so that a checkpoint is never applied to a different problem.
+ *
+ * The file is a compact binary dump in host byte order: it is meant to be read back by the same VPR
+ * binary on the same kind of machine (e.g. a re-run of a preempted job), not to be exchanged.
+ */
+
+#include <string>
+
+#include "connection_based_routing.h"
+#include "netlist.h"
+#include "vpr_types.h"
+
+/** The scalar state of the main routing loop, at the end of a routing iteration */
+struct RouteCheckpointState {
+    ///@brief Last routing iteration completed
+    int itry = 0;
+    ///@brief Present congestion factor for the next iteration
+    float pres_fac = 0.;
+    ///@brief Current bounding box factor (scaled up in conflicted mode)
+    int bb_fac = 0;
+    ///@brief Number of iterations routed in conflicted congestion mode
+    int itry_conflicted_mode = 0;
+    ///@brief Number of iterations since the last legal routing (-1 if none)
+    int itry_since_last_convergence = -1;
+    ///@brief Countdown to stopping RCV early
+    int rcv_finished_count = 0;
+    ///@brief Whether the router switched to conflicted congestion mode
+    bool conflicted_mode = false;
+    ///@brief Critical path delay of the last stable routing configuration
+    float stable_critical_path_delay = 0.;
+};
+
+/**
+ * @brief Writes the current routing and router state to a checkpoint file.
+ *
+ * The checkpoint is written to a temporary file which is then renamed to filename, so a job killed
+ * while writing it leaves the previous checkpoint intact.
+ */
+void write_route_checkpoint(const std::string& filename,
+                            const Netlist<>& net_list,
+                            const CBRR& connections_inf,
+                            const RouteCheckpointState& state,
+                            const t_router_opts& router_opts,
+                            int width_fac,
+                            bool is_flat);
+
+/**
+ * @brief Restores the routing and router state from a checkpoint file written by write_route_checkpoint().
+ *
+ * Expects the routing structures to be freshly initialized. Loads the route trees, recomputes the RR
+ * node occupancies from them, restores the accumulated costs, bounding boxes and lower bound
+ * connection delays, and returns the scalar state in state.
+ *
+ * @return False, leaving the routing untouched, if there is no checkpoint file or it was written for
+ *         another channel width (e.g. by another step of the minimum channel width search).
+ *         A checkpoint of another placement or RR graph, or a corrupted one, is a fatal error.
+ */
+bool read_route_checkpoint(const std::string& filename,
+                           const Netlist<>& net_list,
+                           CBRR& connections_inf,
+                           RouteCheckpointState& state,
+                           const t_router_opts& router_opts,
+                           int width_fac,
+                           bool is_flat);
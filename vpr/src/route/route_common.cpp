@@ -11,6 +11,7 @@
 #include "route_export.h"
 #include "vpr_utils.h"
 #include "route_utilization.h"
+#include "rr_graph_track_mask.h"
 
 #if defined(VPR_USE_TBB)
 #include <tbb/parallel_for_each.h>
@@ -446,6 +447,11 @@ static float comp_initial_acc_cost(RRNodeId node_id,
     // This helps the router avoid channels that are likely to be congested.
     float cost = 1.f;
 
+    // The tracks masked off to reuse a wider RR graph are not to be used (see mask_rr_graph_tracks())
+    if (is_masked_rr_track(node_id)) {
+        return MASKED_TRACK_ACC_COST;
+    }
+
     const e_rr_type rr_type = rr_graph.node_type(node_id);
     const double threshold = route_opts.initial_acc_cost_chan_congestion_threshold;
     const double weight = route_opts.initial_acc_cost_chan_congestion_weight;
@@ -500,6 +506,17 @@ void reset_rr_node_route_structs(const t_router_opts& route_opts) {
     }
 }
 
+void load_initial_acc_cost(const t_router_opts& route_opts,
+                           const vtr::NdMatrix<double, 3>& chanx_util,
+                           const vtr::NdMatrix<double, 3>& chany_util) {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    const auto& device_ctx = g_vpr_ctx.device();
+
+    for (const RRNodeId rr_id : device_ctx.rr_graph.nodes()) {
+        route_ctx.rr_node_route_inf[rr_id].acc_cost = comp_initial_acc_cost(rr_id, route_opts, chanx_util, chany_util);
+    }
+}
+
 /* Allocates and loads the route_ctx.net_rr_terminals data structure. For each net it stores the rr_node   *
  * index of the SOURCE of the net and all the SINKs of the net [clb_nlist.nets()][clb_nlist.net_pins()].    *
  * Entry [inet][pnum] stores the rr index corresponding to the SOURCE (opin) or SINK (ipin) of the pin.     */
@@ -511,12 +528,26 @@ static vtr::vector<ParentNetId, std::vector<RRNodeId>> load_net_rr_terminals(con
 
     net_rr_terminals.resize(net_list.nets().size());
 
-    for (auto net_id : net_list.nets()) {
-        net_rr_terminals[net_id].resize(net_list.net_pins(net_id).size());
+    /* Unless the routing is flat, net_list is the clustered netlist: take its pins and their blocks
+     * from the flat arrays shared with the placer */
+    const ClbNetPinsCsr& clb_net_pins = g_vpr_ctx.clustering().clb_net_pins;
+    const bool use_clb_net_pins = !is_flat && clb_net_pins.is_current(net_list);
 
-        int pin_count = 0;
-        for (auto pin_id : net_list.net_pins(net_id)) {
-            auto block_id = net_list.pin_block(pin_id);
+    for (auto net_id : net_list.nets()) {
+        size_t num_pins = net_list.net_pins(net_id).size();
+        net_rr_terminals[net_id].resize(num_pins);
+
+        for (size_t pin_count = 0; pin_count < num_pins; pin_count++) {
+            ParentPinId pin_id;
+            ParentBlockId block_id;
+            if (use_clb_net_pins) {
+                ClusterNetId clb_net_id = convert_to_cluster_net_id(net_id);
+                pin_id = clb_net_pins.net_pins(clb_net_id)[pin_count];
+                block_id = clb_net_pins.net_pin_block(clb_net_id, pin_count);
+            } else {
+                pin_id = net_list.net_pin(net_id, pin_count);
+                block_id = net_list.pin_block(pin_id);
+            }
 
             t_block_loc blk_loc;
             blk_loc = get_block_loc(block_id, is_flat);
@@ -546,7 +577,6 @@ static vtr::vector<ParentNetId, std::vector<RRNodeId>> load_net_rr_terminals(con
             VTR_ASSERT(inode != RRNodeId::INVALID());
 
             net_rr_terminals[net_id][pin_count] = inode;
-            pin_count++;
         }
     }
 
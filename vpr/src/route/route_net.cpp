@@ -29,7 +29,9 @@ void setup_net(int itry,
 
     // for nets below a certain size (min_incremental_reroute_fanout), rip up any old routing
     // otherwise, we incrementally reroute by reusing legal parts of the previous iteration
-    if (num_sinks < router_opts.min_incremental_reroute_fanout || itry == 1 || ripup_high_fanout_nets) {
+    // (or of the previous routing seeding an incremental routing, see read_eco_route())
+    bool first_route = (itry == 1 && router_opts.eco_route_file.empty());
+    if (num_sinks < router_opts.min_incremental_reroute_fanout || first_route || ripup_high_fanout_nets) {
         profiling::net_rerouted();
 
         /* rip up the whole net */
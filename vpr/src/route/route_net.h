@@ -24,6 +24,10 @@ struct NetResultFlags {
     bool retry_with_full_bb = false;
 };
 
+/** Sinks of high fanout nets more critical than this are routed from the whole route tree
+ * instead of only the spatially close-by routing */
+constexpr float HIGH_FANOUT_CRITICALITY_THRESHOLD = 0.9;
+
 /** When RCV is enabled, it's necessary to be able to completely ripup high fanout nets
  * if there is still negative hold slack. Normally the router will prune the illegal branches
  * of high fanout nets, this will bypass that */
@@ -7,6 +7,7 @@
 #include <tuple>
 
 #include "connection_based_routing.h"
+#include "clock_tree_router.h"
 #include "connection_router_interface.h"
 #include "describe_rr_node.h"
 #include "draw.h"
@@ -15,8 +16,41 @@
 #include "route_profiling.h"
 #include "routing_predictor.h"
 #include "rr_graph_fwd.h"
+#include "sink_sampling.h"
 #include "vtr_dynamic_bitset.h"
 
+/** Reorder the remaining (criticality-sorted) targets of a high fanout net to route a skeleton of the net first
+ * (see sink_sampling::skeleton_first_order()). The critical targets are routed from the whole route tree anyway,
+ * so they stay in front. */
+inline void order_high_fanout_skeleton_first(std::vector<size_t>& remaining_targets,
+                                             const std::vector<float>& pin_criticality,
+                                             ParentNetId net_id,
+                                             const SpatialRouteTreeLookup& spatial_route_tree_lookup) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& route_ctx = g_vpr_ctx.routing();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    auto first_non_critical = std::find_if(remaining_targets.begin(), remaining_targets.end(), [&](size_t ipin) {
+        return pin_criticality[ipin] <= HIGH_FANOUT_CRITICALITY_THRESHOLD;
+    });
+
+    std::vector<SinkPoint> sinks;
+    sinks.reserve(remaining_targets.end() - first_non_critical);
+    for (auto it = first_non_critical; it != remaining_targets.end(); ++it) {
+        RRNodeId rr_sink = route_ctx.net_rr_terminals[net_id][*it];
+        sinks.push_back({rr_graph.node_xlow(rr_sink), rr_graph.node_ylow(rr_sink), int(*it)});
+    }
+    RRNodeId rr_source = route_ctx.net_rr_terminals[net_id][0];
+    SinkPoint source{rr_graph.node_xlow(rr_source), rr_graph.node_ylow(rr_source), 0};
+
+    /* Same bin size as grid_to_bin_x/y() */
+    int bin_width = std::ceil(float(device_ctx.grid.width()) / spatial_route_tree_lookup.dim_size(0));
+    int bin_height = std::ceil(float(device_ctx.grid.height()) / spatial_route_tree_lookup.dim_size(1));
+
+    std::vector<int> order = sink_sampling::skeleton_first_order(sinks, source, bin_width, bin_height);
+    std::copy(order.begin(), order.end(), first_non_critical);
+}
+
 /** Attempt to route a single net.
  *
  * @param router The ConnectionRouterType instance
@@ -71,6 +105,8 @@ inline NetResultFlags route_net(ConnectionRouterType& router,
     if (!should_route_net(net_list, net_id, connections_inf, budgeting_inf, worst_negative_slack, true))
         return flags;
 
+    NetRouteProfileScope net_profile_scope(!router_opts.net_profile_file.empty(), net_id, router_stats);
+
     // track time spent vs fanout
     profiling::net_fanout_start();
 
@@ -118,6 +154,14 @@ inline NetResultFlags route_net(ConnectionRouterType& router,
 
     auto remaining_targets = sink_mask_to_vector(remaining_targets_mask, num_sinks);
 
+    // the requested sinks still reached after setup_net pruned the tree don't need to be rerouted
+    if (should_setup) {
+        auto reused_targets_mask = tree.get_is_isink_reached();
+        if (sink_mask)
+            reused_targets_mask &= sink_mask.value();
+        router_stats.connections_reused += reused_targets_mask.count();
+    }
+
     // calculate criticality of remaining target pins
     for (int ipin : remaining_targets) {
         auto pin = net_list.net_pin(net_id, ipin);
@@ -135,6 +179,10 @@ inline NetResultFlags route_net(ConnectionRouterType& router,
         return pin_criticality[a] > pin_criticality[b];
     });
 
+    if (high_fanout && router_opts.high_fanout_skeleton) {
+        order_high_fanout_skeleton_first(remaining_targets, pin_criticality, net_id, spatial_route_tree_lookup);
+    }
+
     /* Update base costs according to fanout and criticality rules */
     update_rr_base_costs(num_sinks);
 
@@ -197,6 +245,17 @@ inline NetResultFlags route_net(ConnectionRouterType& router,
 
             if (flags.success == false)
                 return flags;
+
+            // Second stage: reach the sinks by walking the clock network from its drive point
+            if (router_opts.clock_tree_routing) {
+                router_stats.connections_routed += route_clock_net_on_clock_tree(net_id,
+                                                                                 net_list,
+                                                                                 sink_node,
+                                                                                 remaining_targets,
+                                                                                 tree,
+                                                                                 high_fanout ? &spatial_route_tree_lookup : nullptr,
+                                                                                 is_flat);
+            }
         }
     }
 
@@ -208,12 +267,23 @@ inline NetResultFlags route_net(ConnectionRouterType& router,
     for (unsigned itarget = 0; itarget < remaining_targets.size(); ++itarget) {
         int target_pin = remaining_targets[itarget];
 
+        // Already routed on the clock network
+        if (tree.get_is_isink_reached().get(target_pin))
+            continue;
+
         RRNodeId sink_rr = route_ctx.net_rr_terminals[net_id][target_pin];
 
         enable_router_debug(router_opts, net_id, sink_rr, itry, &router);
 
         cost_params.criticality = pin_criticality[target_pin];
 
+        // Long, non-critical connections are worth a bidirectional search
+        RRNodeId source_rr = route_ctx.net_rr_terminals[net_id][0];
+        cost_params.bidirectional_search = router_opts.bidirectional_search
+                                           && !budgeting_inf.if_set()
+                                           && cost_params.criticality <= router_opts.bidirectional_search_max_criticality
+                                           && std::abs(rr_graph.node_xlow(source_rr) - rr_graph.node_xlow(sink_rr)) + std::abs(rr_graph.node_ylow(source_rr) - rr_graph.node_ylow(sink_rr)) >= router_opts.bidirectional_search_min_distance;
+
         if (budgeting_inf.if_set()) {
             conn_delay_budget.max_delay = budgeting_inf.get_max_delay_budget(net_id, target_pin);
             conn_delay_budget.target_delay = budgeting_inf.get_delay_target(net_id, target_pin);
@@ -436,7 +506,6 @@ inline NetResultFlags route_sink(ConnectionRouterType& router,
 
     bool net_is_global = net_list.net_is_global(net_id);
     bool high_fanout = is_high_fanout(net_list.net_sinks(net_id).size(), router_opts.high_fanout_threshold);
-    constexpr float HIGH_FANOUT_CRITICALITY_THRESHOLD = 0.9;
     bool sink_critical = (cost_params.criticality > HIGH_FANOUT_CRITICALITY_THRESHOLD);
     bool net_is_clock = route_ctx.is_clock_net[net_id] != 0;
 
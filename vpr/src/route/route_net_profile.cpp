@@ -0,0 +1,82 @@
+#include "route_net_profile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "vpr_error.h"
+#include "vtr_log.h"
+
+/** Share of the nets (the most time consuming ones) reported by NetRouteProfileWriter::print_summary() */
+static constexpr float NET_PROFILE_SUMMARY_TOP_FRAC = 0.01;
+
+NetRouteProfileWriter::NetRouteProfileWriter(const std::string& filename, const Netlist<>& net_list)
+    : os_(filename)
+    , net_list_(net_list)
+    , net_route_sec_(net_list.nets().size(), 0.)
+    , net_times_routed_(net_list.nets().size(), 0) {
+    if (!os_) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to open net route profile file '%s' for writing\n", filename.c_str());
+    }
+    os_ << "iteration,net_id,net_name,fanout,route_time_sec,heap_pushes,heap_pops,connections_routed,times_routed\n";
+}
+
+void NetRouteProfileWriter::write_iteration(int itry, const std::vector<NetRouteProfile>& net_profiles) {
+    /* Sum up nets routed in parts */
+    vtr::vector<ParentNetId, NetRouteProfile> iter_profiles(net_list_.nets().size());
+    std::vector<ParentNetId> routed_nets;
+    for (const NetRouteProfile& profile : net_profiles) {
+        NetRouteProfile& net_profile = iter_profiles[profile.net_id];
+        if (!net_profile.net_id) {
+            net_profile.net_id = profile.net_id;
+            routed_nets.push_back(profile.net_id);
+        }
+        net_profile.route_sec += profile.route_sec;
+        net_profile.heap_pushes += profile.heap_pushes;
+        net_profile.heap_pops += profile.heap_pops;
+        net_profile.connections_routed += profile.connections_routed;
+    }
+
+    /* Most time consuming first; by net ID between equals, so the order doesn't depend on the threads */
+    std::sort(routed_nets.begin(), routed_nets.end(), [&](ParentNetId a, ParentNetId b) {
+        if (iter_profiles[a].route_sec != iter_profiles[b].route_sec)
+            return iter_profiles[a].route_sec > iter_profiles[b].route_sec;
+        return a < b;
+    });
+
+    for (ParentNetId net_id : routed_nets) {
+        const NetRouteProfile& profile = iter_profiles[net_id];
+        net_route_sec_[net_id] += profile.route_sec;
+        net_times_routed_[net_id]++;
+
+        os_ << itry << ','
+            << size_t(net_id) << ','
+            << '"' << net_list_.net_name(net_id) << '"' << ','
+            << net_list_.net_sinks(net_id).size() << ','
+            << profile.route_sec << ','
+            << profile.heap_pushes << ','
+            << profile.heap_pops << ','
+            << profile.connections_routed << ','
+            << net_times_routed_[net_id] << '\n';
+    }
+    os_.flush();
+}
+
+void NetRouteProfileWriter::print_summary() const {
+    std::vector<float> route_sec;
+    for (float net_sec : net_route_sec_) {
+        if (net_sec > 0.)
+            route_sec.push_back(net_sec);
+    }
+    if (route_sec.empty())
+        return;
+
+    size_t num_top = std::max<size_t>(1, std::ceil(NET_PROFILE_SUMMARY_TOP_FRAC * route_sec.size()));
+    std::partial_sort(route_sec.begin(), route_sec.begin() + num_top, route_sec.end(), std::greater<float>());
+    float total_sec = std::accumulate(route_sec.begin(), route_sec.end(), 0.f);
+    float top_sec = std::accumulate(route_sec.begin(), route_sec.begin() + num_top, 0.f);
+
+    VTR_LOG("Net route profile: the top %g%% most time consuming nets (%zu of %zu routed) took %.3f of %.3f sec (%.1f%%) of net routing time\n",
+            100 * NET_PROFILE_SUMMARY_TOP_FRAC, num_top, route_sec.size(), top_sec, total_sec,
+            total_sec > 0. ? 100 * top_sec / total_sec : 0.);
+}
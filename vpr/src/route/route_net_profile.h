@@ -0,0 +1,42 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Per-net routing effort profile (see --router_net_profile_file).
+ *
+ * route_net() records a NetRouteProfile of each net it routes into the RouterStats of the routing
+ * iteration, whichever netlist router runs it. NetRouteProfileWriter then sums them up per net and
+ * writes one CSV row per net routed in the iteration, most time consuming net first:
+ *
+ *     iteration,net_id,net_name,fanout,route_time_sec,heap_pushes,heap_pops,connections_routed,times_routed
+ *
+ * where times_routed counts the iterations in which the net was (re)routed so far.
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "netlist.h"
+#include "router_stats.h"
+#include "vtr_vector.h"
+
+class NetRouteProfileWriter {
+  public:
+    /** Opens (and truncates) filename and writes the CSV header */
+    NetRouteProfileWriter(const std::string& filename, const Netlist<>& net_list);
+
+    /** Writes the net profiles of routing iteration itry */
+    void write_iteration(int itry, const std::vector<NetRouteProfile>& net_profiles);
+
+    /** Logs which share of the net routing time the most time consuming nets took, over all iterations */
+    void print_summary() const;
+
+  private:
+    std::ofstream os_;
+    const Netlist<>& net_list_;
+    /** Total time spent routing each net */
+    vtr::vector<ParentNetId, float> net_route_sec_;
+    /** Number of iterations in which each net was routed */
+    vtr::vector<ParentNetId, int> net_times_routed_;
+};
@@ -1,5 +1,7 @@
 #include "route_tree.h"
 
+#include <algorithm>
+
 #include "connection_based_routing.h"
 #include "globals.h"
 #include "netlist_fwd.h"
@@ -72,9 +74,35 @@ void RouteTreeNode::print_x(int depth) const {
     }
 }
 
+RouteTreeNodePool::RouteTreeNodePool(RouteTreeNodePool&& rhs) noexcept {
+    *this = std::move(rhs);
+}
+
+RouteTreeNodePool& RouteTreeNodePool::operator=(RouteTreeNodePool&& rhs) noexcept {
+    _chunks = std::move(rhs._chunks);
+    _free_nodes = std::move(rhs._free_nodes);
+    _chunk_size = std::exchange(rhs._chunk_size, 0);
+    _chunk_used = std::exchange(rhs._chunk_used, 0);
+    _capacity = std::exchange(rhs._capacity, 0);
+    rhs._chunks.clear();
+    rhs._free_nodes.clear();
+    return *this;
+}
+
+size_t RouteTreeNodePool::capacity() const {
+    return _capacity;
+}
+
+void RouteTreeNodePool::add_chunk() {
+    _chunk_size = std::clamp(_capacity, MIN_CHUNK_SIZE, MAX_CHUNK_SIZE);
+    _chunks.emplace_back(new t_node_storage[_chunk_size]);
+    _chunk_used = 0;
+    _capacity += _chunk_size;
+}
+
 /* Construct a top-level route tree. */
 RouteTree::RouteTree(RRNodeId _inode) {
-    _root = new RouteTreeNode(_inode, RRSwitchId::INVALID(), nullptr);
+    _root = _node_pool.create(_inode, RRSwitchId::INVALID(), nullptr);
     _net_id = ParentNetId::INVALID();
     _rr_node_to_rt_node[_inode] = _root;
 }
@@ -83,7 +111,7 @@ RouteTree::RouteTree(ParentNetId _inet) {
     auto& route_ctx = g_vpr_ctx.routing();
 
     RRNodeId inode = RRNodeId(route_ctx.net_rr_terminals[_inet][0]);
-    _root = new RouteTreeNode(inode, RRSwitchId::INVALID(), nullptr);
+    _root = _node_pool.create(inode, RRSwitchId::INVALID(), nullptr);
     _net_id = _inet;
     _rr_node_to_rt_node[inode] = _root;
 
@@ -95,7 +123,7 @@ RouteTree::RouteTree(ParentNetId _inet) {
 /** Make a copy of rhs and return it.
  * Traverse it as a tree so we can keep parent & child ptrs valid. */
 RouteTreeNode* RouteTree::copy_tree(const RouteTreeNode* rhs) {
-    RouteTreeNode* root = new RouteTreeNode(rhs->inode, RRSwitchId::INVALID(), nullptr);
+    RouteTreeNode* root = _node_pool.create(rhs->inode, RRSwitchId::INVALID(), nullptr);
     _rr_node_to_rt_node[root->inode] = root;
     copy_tree_x(root, *rhs);
     return root;
@@ -104,7 +132,7 @@ RouteTreeNode* RouteTree::copy_tree(const RouteTreeNode* rhs) {
 /* Helper for copy_list: copy child nodes of rhs into lhs */
 void RouteTree::copy_tree_x(RouteTreeNode* lhs, const RouteTreeNode& rhs) {
     for (auto& rchild : rhs.child_nodes()) {
-        RouteTreeNode* child = new RouteTreeNode(rchild);
+        RouteTreeNode* child = _node_pool.create(rchild);
         child->_is_leaf = true;
         add_node(lhs, child);
         copy_tree_x(child, rchild);
@@ -127,6 +155,7 @@ RouteTree::RouteTree(const RouteTree& rhs) {
  * from multiple threads, but better safe than sorry */
 RouteTree::RouteTree(RouteTree&& rhs) {
     std::unique_lock<std::mutex> rhs_write_lock(rhs._write_mutex);
+    _node_pool = std::move(rhs._node_pool);
     _root = rhs._root;
     _net_id = rhs._net_id;
     rhs._root = nullptr;
@@ -166,6 +195,7 @@ RouteTree& RouteTree::operator=(RouteTree&& rhs) {
     std::unique_lock<std::mutex> rhs_write_lock(rhs._write_mutex, std::defer_lock);
     std::lock(write_lock, rhs_write_lock);
     free_list(_root);
+    _node_pool = std::move(rhs._node_pool);
     _root = rhs._root;
     _net_id = rhs._net_id;
     rhs._root = nullptr;
@@ -487,13 +517,14 @@ void RouteTree::print(void) const {
  * This routine returns a tuple: RouteTreeNode of the branch it adds to the route tree and
  * RouteTreeNode of the SINK it adds to the routing. */
 std::tuple<vtr::optional<const RouteTreeNode&>, vtr::optional<const RouteTreeNode&>>
-RouteTree::update_from_heap(RTExploredNode* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat) {
+RouteTree::update_from_heap(RTExploredNode* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat, const vtr::vector<RRNodeId, t_rr_node_route_inf>* rr_node_route_inf) {
     /* Lock the route tree for writing. At least on Linux this shouldn't have an impact on single-threaded code */
     std::unique_lock<std::mutex> write_lock(_write_mutex);
 
     //Create a new subtree from the target in hptr to existing routing
     vtr::optional<RouteTreeNode&> start_of_new_subtree_rt_node, sink_rt_node;
-    std::tie(start_of_new_subtree_rt_node, sink_rt_node) = add_subtree_from_heap(hptr, target_net_pin_index, is_flat);
+    std::tie(start_of_new_subtree_rt_node, sink_rt_node) = add_subtree_from_heap(hptr, target_net_pin_index, is_flat,
+                                                                                 rr_node_route_inf ? *rr_node_route_inf : g_vpr_ctx.routing().rr_node_route_inf);
 
     if (!start_of_new_subtree_rt_node)
         return {vtr::nullopt, *sink_rt_node};
@@ -516,10 +547,9 @@ RouteTree::update_from_heap(RTExploredNode* hptr, int target_net_pin_index, Spat
  * to the SINK indicated by hptr. Returns the first (most upstream) new rt_node,
  * and the rt_node of the new SINK. Traverses up from SINK  */
 std::tuple<vtr::optional<RouteTreeNode&>, vtr::optional<RouteTreeNode&>>
-RouteTree::add_subtree_from_heap(RTExploredNode* hptr, int target_net_pin_index, bool is_flat) {
+RouteTree::add_subtree_from_heap(RTExploredNode* hptr, int target_net_pin_index, bool is_flat, const vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
-    auto& route_ctx = g_vpr_ctx.routing();
 
     RRNodeId sink_inode = RRNodeId(hptr->index);
 
@@ -544,7 +574,7 @@ RouteTree::add_subtree_from_heap(RTExploredNode* hptr, int target_net_pin_index,
     while (!_rr_node_to_rt_node.count(new_inode)) {
         new_branch_inodes.push_back(new_inode);
         new_branch_iswitches.push_back(new_iswitch);
-        edge = route_ctx.rr_node_route_inf[new_inode].prev_edge;
+        edge = rr_node_route_inf[new_inode].prev_edge;
         new_inode = rr_graph.edge_src_node(edge);
         new_iswitch = RRSwitchId(rr_graph.rr_nodes().edge_switch(edge));
     }
@@ -560,7 +590,7 @@ RouteTree::add_subtree_from_heap(RTExploredNode* hptr, int target_net_pin_index,
      * ---
      * Walk through new_branch_iswitches and corresponding new_branch_inodes. */
     for (int i = new_branch_inodes.size() - 1; i >= 0; i--) {
-        RouteTreeNode* new_node = new RouteTreeNode(new_branch_inodes[i], new_branch_iswitches[i], last_node);
+        RouteTreeNode* new_node = _node_pool.create(new_branch_inodes[i], new_branch_iswitches[i], last_node);
 
         e_rr_type node_type = rr_graph.node_type(new_branch_inodes[i]);
         // If is_flat is enabled, IPINs should be added, since they are used for intra-cluster routing
@@ -623,7 +653,7 @@ void RouteTree::add_non_configurable_nodes(RouteTreeNode* rt_node,
 
         RRSwitchId edge_switch(rr_graph.edge_switch(rr_node, iedge));
 
-        RouteTreeNode* new_node = new RouteTreeNode(to_rr_node, edge_switch, rt_node);
+        RouteTreeNode* new_node = _node_pool.create(to_rr_node, edge_switch, rt_node);
         add_node(rt_node, new_node);
 
         new_node->net_pin_index = UNDEFINED;
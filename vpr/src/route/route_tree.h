@@ -81,17 +81,24 @@
 
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "connection_based_routing_fwd.h"
 #include "route_path_manager.h"
 #include "route_tree_fwd.h"
 #include "spatial_route_tree_lookup.h"
 #include "vtr_dynamic_bitset.h"
+#include "vtr_flat_hash_map.h"
 #include "vtr_optional.h"
 #include "vtr_range.h"
 
+struct t_rr_node_route_inf;
+
 /**
  * @brief A single route tree node
  *
@@ -317,6 +324,75 @@ class RouteTreeNode {
     };
 };
 
+/* The fields of a node are ordered so that there is no padding: a node fits in a cache line. */
+static_assert(sizeof(RouteTreeNode) <= 64, "RouteTreeNode should fit in a cache line");
+
+/**
+ * @brief Per-RouteTree allocator of RouteTreeNodes.
+ *
+ * Nodes are carved out of chunks of contiguous storage, which grow geometrically with the tree,
+ * and freed nodes are kept for reuse rather than returned to the system allocator. Pruning, rebuilding
+ * and copying trees between routing iterations then mostly recycle the nodes of the tree, instead of
+ * calling malloc/free for every node of every net.
+ *
+ * Chunks are never moved or released before the pool is destroyed, so pointers and references to
+ * the nodes stay valid when the pool (i.e. the owning RouteTree) is moved.
+ */
+class RouteTreeNodePool {
+  public:
+    RouteTreeNodePool() = default;
+    RouteTreeNodePool(const RouteTreeNodePool&) = delete;
+    RouteTreeNodePool& operator=(const RouteTreeNodePool&) = delete;
+    /** Take over rhs' storage (and its nodes). rhs is left empty */
+    RouteTreeNodePool(RouteTreeNodePool&& rhs) noexcept;
+    RouteTreeNodePool& operator=(RouteTreeNodePool&& rhs) noexcept;
+
+    /** Construct a node in the pool with the given RouteTreeNode constructor arguments */
+    template<class... Args>
+    inline RouteTreeNode* create(Args&&... args) {
+        void* storage;
+        if (!_free_nodes.empty()) {
+            storage = _free_nodes.back();
+            _free_nodes.pop_back();
+        } else {
+            if (_chunk_used == _chunk_size)
+                add_chunk();
+            storage = &_chunks.back()[_chunk_used++];
+        }
+        return new (storage) RouteTreeNode(std::forward<Args>(args)...);
+    }
+
+    /** Return a node created by this pool to the pool */
+    inline void destroy(RouteTreeNode* node) {
+        node->~RouteTreeNode();
+        _free_nodes.push_back(node);
+    }
+
+    /** Number of nodes the pool has storage for (used or free) */
+    size_t capacity() const;
+
+  private:
+    struct alignas(RouteTreeNode) t_node_storage {
+        unsigned char bytes[sizeof(RouteTreeNode)];
+    };
+
+    void add_chunk();
+
+    /** Size of the first chunk. Most nets are small, so start with a few nodes only */
+    static constexpr size_t MIN_CHUNK_SIZE = 8;
+    /** Chunks stop growing past this, to bound the unused storage of large trees */
+    static constexpr size_t MAX_CHUNK_SIZE = 1024;
+
+    std::vector<std::unique_ptr<t_node_storage[]>> _chunks;
+    /** Size of the last chunk, and number of its slots handed out so far */
+    size_t _chunk_size = 0;
+    size_t _chunk_used = 0;
+    /** Total size of the chunks */
+    size_t _capacity = 0;
+    /** Destroyed nodes, reused before taking new slots from the last chunk */
+    std::vector<RouteTreeNode*> _free_nodes;
+};
+
 /** fwd definition for compatibility class in old_traceback.h */
 class TracebackCompat;
 
@@ -390,9 +466,10 @@ class RouteTree {
      * is the net pin index corresponding to the SINK that was reached. This routine
      * returns a tuple: RouteTreeNode of the branch it adds to the route tree and
      * RouteTreeNode of the SINK it adds to the routing.
+     * The path is traced back through rr_node_route_inf, which defaults to the global routing context's.
      * Locking operation: only one thread can update_from_heap() a RouteTree at a time. */
     std::tuple<vtr::optional<const RouteTreeNode&>, vtr::optional<const RouteTreeNode&>>
-    update_from_heap(RTExploredNode* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat);
+    update_from_heap(RTExploredNode* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat, const vtr::vector<RRNodeId, t_rr_node_route_inf>* rr_node_route_inf = nullptr);
 
     /** Reload timing values (R_upstream, C_downstream, Tdel).
      * Can take a RouteTreeNode& to do an incremental update.
@@ -457,6 +534,9 @@ class RouteTree {
     /** Get a reference to the root RouteTreeNode. */
     constexpr const RouteTreeNode& root(void) const { return *_root; } /* this file is 90% const and 10% code */
 
+    /** Number of nodes this tree has storage for, including the freed nodes kept for reuse. */
+    size_t num_allocated_nodes(void) const { return _node_pool.capacity(); }
+
     /** Iterator implementation for remaining or reached isinks. Goes over [1..num_sinks]
      * and only returns a value when the sink state is right */
     template<bool sink_state>
@@ -526,7 +606,7 @@ class RouteTree {
 
   private:
     std::tuple<vtr::optional<RouteTreeNode&>, vtr::optional<RouteTreeNode&>>
-    add_subtree_from_heap(RTExploredNode* hptr, int target_net_pin_index, bool is_flat);
+    add_subtree_from_heap(RTExploredNode* hptr, int target_net_pin_index, bool is_flat, const vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf);
 
     void add_non_configurable_nodes(RouteTreeNode* rt_node,
                                     bool reached_by_non_configurable_edge,
@@ -600,7 +680,7 @@ class RouteTree {
             node->_prev->_next = node->_next;
         if (node->_next)
             node->_next->_prev = node->_prev;
-        delete node;
+        _node_pool.destroy(node);
     }
 
     /** Iterate through parent's child nodes and remove if p returns true.
@@ -638,6 +718,9 @@ class RouteTree {
             parent._is_leaf = true;
     }
 
+    /** Storage of the nodes of this tree. Declared before _root, so that it outlives the nodes */
+    RouteTreeNodePool _node_pool;
+
     /** Root node.
      * This is also the internal node list via the ptrs in RouteTreeNode. */
     RouteTreeNode* _root;
@@ -655,7 +738,7 @@ class RouteTree {
      * tree if we go to the same SINK more than once. rr_node_to_rt_node[inode] will
      * therefore store the last rt_node created of all the SINK nodes with the same
      * index "inode". */
-    std::unordered_map<RRNodeId, RouteTreeNode*> _rr_node_to_rt_node;
+    vtr::flat_hash_map<RRNodeId, RouteTreeNode*> _rr_node_to_rt_node;
 
     /** RRNodeId is not a unique lookup for sink RouteTreeNodes, but net_pin_index
      * is. Store a 0-indexed lookup here for users who need to look up a sink from
@@ -1,4 +1,7 @@
 #include "route_utilization.h"
+
+#include <algorithm>
+
 #include "draw_global.h"
 #include "draw_types.h"
 #include "globals.h"
@@ -52,8 +55,8 @@ vtr::Matrix<float> calculate_routing_usage(e_rr_type rr_type, bool is_flat, bool
 
     vtr::Matrix<float> usage({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0.);
 
-    // Collect all the in-use RR nodes
-    std::set<RRNodeId> rr_nodes;
+    // Flag all the in-use RR nodes (a flag per node rather than a set: routings use millions of nodes)
+    std::vector<char> is_used(rr_graph.num_nodes(), false);
     for (ClusterNetId net : cluster_ctx.clb_nlist.nets()) {
         ParentNetId parent_id = get_cluster_net_parent_id(g_vpr_ctx.atom().lookup(), net, is_flat);
 
@@ -61,13 +64,15 @@ vtr::Matrix<float> calculate_routing_usage(e_rr_type rr_type, bool is_flat, bool
             continue;
         for (const RouteTreeNode& rt_node : route_ctx.route_trees[parent_id].value().all_nodes()) {
             if (rr_graph.node_type(rt_node.inode) == rr_type) {
-                rr_nodes.insert(rt_node.inode);
+                is_used[size_t(rt_node.inode)] = true;
             }
         }
     }
 
     // Record number of used resources in each x/y channel
-    for (RRNodeId rr_node : rr_nodes) {
+    for (RRNodeId rr_node : rr_graph.nodes()) {
+        if (!is_used[size_t(rr_node)])
+            continue;
 #ifndef NO_GRAPHICS
         if (!is_print) {
             t_draw_state* draw_state = get_draw_state_vars();
@@ -141,3 +146,22 @@ float routing_util(float used, float avail) {
     }
     return 0.;
 }
+
+float calculate_peak_channel_util(bool is_flat) {
+    const auto& grid = g_vpr_ctx.device().grid;
+
+    vtr::Matrix<float> chanx_usage = calculate_routing_usage(e_rr_type::CHANX, is_flat, false);
+    vtr::Matrix<float> chany_usage = calculate_routing_usage(e_rr_type::CHANY, is_flat, false);
+    vtr::Matrix<float> chanx_avail = calculate_routing_avail(e_rr_type::CHANX);
+    vtr::Matrix<float> chany_avail = calculate_routing_avail(e_rr_type::CHANY);
+
+    float peak_util = 0.;
+    for (size_t x = 0; x < grid.width() - 1; ++x) {
+        for (size_t y = 0; y < grid.height() - 1; ++y) {
+            peak_util = std::max({peak_util,
+                                  routing_util(chanx_usage[x][y], chanx_avail[x][y]),
+                                  routing_util(chany_usage[x][y], chany_avail[x][y])});
+        }
+    }
+    return peak_util;
+}
@@ -38,3 +38,6 @@ vtr::Matrix<float> calculate_routing_avail(e_rr_type rr_type);
 vtr::Matrix<float> calculate_routing_usage(e_rr_type rr_type, bool is_flat, bool is_print);
 
 float routing_util(float used, float avail);
+
+/** Returns the highest utilization (used over available tracks) of any CHANX or CHANY channel location */
+float calculate_peak_channel_util(bool is_flat);
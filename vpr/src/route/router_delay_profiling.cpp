@@ -6,10 +6,24 @@
 #include "route_tree.h"
 #include "rr_graph.h"
 
+#if defined(VPR_USE_TBB)
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
+struct RouterDelayProfiler::t_worker_profilers {
+#if defined(VPR_USE_TBB)
+    tbb::enumerable_thread_specific<std::unique_ptr<RouterDelayProfiler>> profilers;
+#endif
+};
+
 RouterDelayProfiler::RouterDelayProfiler(const Netlist<>& net_list,
                                          const RouterLookahead* lookahead,
-                                         bool is_flat)
+                                         bool is_flat,
+                                         bool is_worker)
     : net_list_(net_list)
+    , lookahead_(lookahead)
+    , worker_rr_node_route_inf_(is_worker ? g_vpr_ctx.routing().rr_node_route_inf : vtr::vector<RRNodeId, t_rr_node_route_inf>())
     , router_(
           g_vpr_ctx.device().grid,
           *lookahead,
@@ -17,10 +31,17 @@ RouterDelayProfiler::RouterDelayProfiler(const Netlist<>& net_list,
           &g_vpr_ctx.device().rr_graph,
           g_vpr_ctx.device().rr_rc_data,
           g_vpr_ctx.device().rr_graph.rr_switch(),
-          g_vpr_ctx.mutable_routing().rr_node_route_inf,
+          is_worker ? worker_rr_node_route_inf_ : g_vpr_ctx.mutable_routing().rr_node_route_inf,
           is_flat,
           /*route_verbosity=*/1)
-    , is_flat_(is_flat) {
+    , is_flat_(is_flat)
+    , is_worker_(is_worker) {
+}
+
+RouterDelayProfiler::RouterDelayProfiler(const Netlist<>& net_list,
+                                         const RouterLookahead* lookahead,
+                                         bool is_flat)
+    : RouterDelayProfiler(net_list, lookahead, is_flat, /*is_worker=*/false) {
     const auto& grid = g_vpr_ctx.device().grid;
     int num_layers = grid.get_num_layers();
 
@@ -47,6 +68,8 @@ RouterDelayProfiler::RouterDelayProfiler(const Netlist<>& net_list,
     }
 }
 
+RouterDelayProfiler::~RouterDelayProfiler() = default;
+
 bool RouterDelayProfiler::calculate_delay(RRNodeId source_node,
                                           RRNodeId sink_node,
                                           const t_router_opts& router_opts,
@@ -60,10 +83,15 @@ bool RouterDelayProfiler::calculate_delay(RRNodeId source_node,
     auto& route_ctx = g_vpr_ctx.mutable_routing();
 
     RouteTree tree((RRNodeId(source_node)));
-    enable_router_debug(router_opts, ParentNetId(), sink_node, 0, &router_);
 
-    /* Update base costs according to fanout and criticality rules */
-    update_rr_base_costs(1);
+    // Workers only run within for_each_parallel(), which has already done this and
+    // must not touch the global router debug flag or base costs from several threads
+    if (!is_worker_) {
+        enable_router_debug(router_opts, ParentNetId(), sink_node, 0, &router_);
+
+        /* Update base costs according to fanout and criticality rules */
+        update_rr_base_costs(1);
+    }
 
     //maximum bounding box for placement
     t_bb bounding_box;
@@ -108,7 +136,8 @@ bool RouterDelayProfiler::calculate_delay(RRNodeId source_node,
         VTR_ASSERT(cheapest.index == sink_node);
 
         vtr::optional<const RouteTreeNode&> rt_node_of_sink;
-        std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&cheapest, UNDEFINED, nullptr, is_flat_);
+        std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&cheapest, UNDEFINED, nullptr, is_flat_,
+                                                                is_worker_ ? &worker_rr_node_route_inf_ : nullptr);
 
         //find delay
         *net_delay = rt_node_of_sink->Tdel;
@@ -130,6 +159,30 @@ float RouterDelayProfiler::get_min_delay(int physical_tile_type_idx, int from_la
     return min_delays_[physical_tile_type_idx][from_layer][to_layer][dx][dy];
 }
 
+void RouterDelayProfiler::for_each_parallel(size_t num_tasks, const std::function<void(size_t, RouterDelayProfiler&)>& fn) {
+    VTR_ASSERT(!is_worker_);
+#if defined(VPR_USE_TBB)
+    /* All the connections are routed with the same fanout, so the base costs can be set once for all the workers */
+    update_rr_base_costs(1);
+
+    if (!workers_) {
+        workers_ = std::make_unique<t_worker_profilers>();
+    }
+
+    tbb::parallel_for(size_t(0), num_tasks, [&](size_t itask) {
+        std::unique_ptr<RouterDelayProfiler>& worker = workers_->profilers.local();
+        if (!worker) {
+            worker.reset(new RouterDelayProfiler(net_list_, lookahead_, is_flat_, /*is_worker=*/true));
+        }
+        fn(itask, *worker);
+    });
+#else
+    for (size_t itask = 0; itask < num_tasks; itask++) {
+        fn(itask, *this);
+    }
+#endif
+}
+
 //Returns the shortest path delay from src_node to all RR nodes in the RR graph, or NaN if no path exists
 vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(RRNodeId src_rr_node,
                                                                     const t_router_opts& router_opts,
@@ -6,6 +6,8 @@
 #include "router_stats.h"
 #include "serial_connection_router.h"
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 class RouterDelayProfiler {
@@ -13,6 +15,7 @@ class RouterDelayProfiler {
     RouterDelayProfiler(const Netlist<>& net_list,
                         const RouterLookahead* lookahead,
                         bool is_flat);
+    ~RouterDelayProfiler();
 
     /**
      * @brief Returns true as long as found some way to hook up this net, even if that
@@ -32,12 +35,33 @@ class RouterDelayProfiler {
      */
     float get_min_delay(int physical_tile_type_idx, int from_layer, int to_layer, int dx, int dy) const;
 
+    /**
+     * @brief Calls fn(i, profiler) for each i in [0, num_tasks), in parallel when VPR is built with TBB.
+     *
+     * Each thread routes with its own profiler (router, heap and RR node routing state), so fn may call
+     * calculate_delay() on the profiler it is given. The worker profilers are created on first use and kept
+     * for later calls. Tasks run in no particular order: fn should store its result by index.
+     */
+    void for_each_parallel(size_t num_tasks, const std::function<void(size_t, RouterDelayProfiler&)>& fn);
+
   private:
+    struct t_worker_profilers;
+
+    ///@brief Creates a worker profiler, which routes with a private copy of the RR node routing state
+    RouterDelayProfiler(const Netlist<>& net_list,
+                        const RouterLookahead* lookahead,
+                        bool is_flat,
+                        bool is_worker);
+
     const Netlist<>& net_list_;
+    const RouterLookahead* lookahead_;
     RouterStats router_stats_;
+    vtr::vector<RRNodeId, t_rr_node_route_inf> worker_rr_node_route_inf_; // Only used by worker profilers
     SerialConnectionRouter<FourAryHeap> router_;
     vtr::NdMatrix<float, 5> min_delays_; // [physical_type_idx][from_layer][to_layer][dx][dy]
     bool is_flat_;
+    bool is_worker_;
+    std::unique_ptr<t_worker_profilers> workers_;
 };
 
 vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(RRNodeId src_rr_node,
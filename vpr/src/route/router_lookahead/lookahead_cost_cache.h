@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Memoization of the router lookahead costs (see --router_lookahead_cache_entries).
+ *
+ * A connection router queries the lookahead for the same (node, target) pairs again and again:
+ * within a search, for nodes pushed more than once, and across routing iterations, every time
+ * the connection is rerouted. For lookaheads whose cost only depends on the two nodes and the
+ * criticality of the connection (see RouterLookahead::is_cost_cacheable()), the cost can be
+ * reused as long as the criticality did not change.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "router_stats.h"
+#include "rr_graph_fwd.h"
+
+/**
+ * @brief Direct-mapped cache of lookahead costs, keyed by (node, target).
+ *
+ * Not thread safe: each connection router has its own.
+ */
+class LookaheadCostCache {
+  public:
+    /** Disabled until resize() */
+    LookaheadCostCache() = default;
+
+    /** Hold (at least) num_entries costs, rounded up to a power of two. 0 disables the cache */
+    void resize(size_t num_entries) {
+        num_bits_ = 0;
+        while (num_entries > (size_t(1) << num_bits_)) {
+            num_bits_++;
+        }
+        entries_.assign(num_entries > 0 ? size_t(1) << num_bits_ : 0, Entry());
+    }
+
+    bool enabled() const { return !entries_.empty(); }
+
+    /**
+     * @brief Returns the cost from node to target at this criticality, computed with compute_cost() if it isn't cached
+     *
+     * The hits and misses are counted in router_stats (if not null).
+     */
+    template<typename ComputeCost>
+    float get(RRNodeId node, RRNodeId target, float criticality, RouterStats* router_stats, const ComputeCost& compute_cost) {
+        uint64_t key = (uint64_t(size_t(node)) << 32) | uint64_t(size_t(target));
+        Entry& entry = entries_[num_bits_ > 0 ? (key * 0x9E3779B97F4A7C15ULL) >> (64 - num_bits_) : 0];
+        if (entry.key == key && entry.criticality == criticality) {
+            if (router_stats)
+                router_stats->lookahead_cache_hits++;
+            return entry.cost;
+        }
+
+        if (router_stats)
+            router_stats->lookahead_cache_misses++;
+        entry.key = key;
+        entry.criticality = criticality;
+        entry.cost = compute_cost();
+        return entry.cost;
+    }
+
+  private:
+    struct Entry {
+        uint64_t key = UINT64_MAX; ///<(node, target), never a valid pair when empty
+        float criticality = 0.;
+        float cost = 0.;
+    };
+
+    std::vector<Entry> entries_;
+    int num_bits_ = 0;
+};
@@ -7,6 +7,7 @@
 #include "router_lookahead_simple.h"
 #include "vpr_error.h"
 #include "globals.h"
+#include "setup_cache.h"
 
 /**
  * Assuming inode is CHANX or CHANY, this function calculates the number of required wires of the same type as inode
@@ -23,15 +24,17 @@ static int round_up(float x);
 static std::unique_ptr<RouterLookahead> make_router_lookahead_object(const t_det_routing_arch& det_routing_arch,
                                                                      e_router_lookahead router_lookahead_type,
                                                                      bool is_flat,
-                                                                     int route_verbosity) {
+                                                                     int route_verbosity,
+                                                                     bool lazy,
+                                                                     bool quantized) {
     if (router_lookahead_type == e_router_lookahead::CLASSIC) {
         return std::make_unique<ClassicLookahead>();
     } else if (router_lookahead_type == e_router_lookahead::MAP) {
         return std::make_unique<MapLookahead>(det_routing_arch, is_flat, route_verbosity);
     } else if (router_lookahead_type == e_router_lookahead::COMPRESSED_MAP) {
-        return std::make_unique<CompressedMapLookahead>(det_routing_arch, is_flat, route_verbosity);
+        return std::make_unique<CompressedMapLookahead>(det_routing_arch, is_flat, route_verbosity, quantized);
     } else if (router_lookahead_type == e_router_lookahead::EXTENDED_MAP) {
-        return std::make_unique<ExtendedMapLookahead>(is_flat, route_verbosity);
+        return std::make_unique<ExtendedMapLookahead>(is_flat, route_verbosity, lazy);
     } else if (router_lookahead_type == e_router_lookahead::SIMPLE) {
         return std::make_unique<SimpleLookahead>();
     } else if (router_lookahead_type == e_router_lookahead::NO_OP) {
@@ -48,11 +51,15 @@ std::unique_ptr<RouterLookahead> make_router_lookahead(const t_det_routing_arch&
                                                        const std::string& read_lookahead,
                                                        const std::vector<t_segment_inf>& segment_inf,
                                                        bool is_flat,
-                                                       int route_verbosity) {
+                                                       int route_verbosity,
+                                                       bool lazy,
+                                                       bool quantized) {
     std::unique_ptr<RouterLookahead> router_lookahead = make_router_lookahead_object(det_routing_arch,
                                                                                      router_lookahead_type,
                                                                                      is_flat,
-                                                                                     route_verbosity);
+                                                                                     route_verbosity,
+                                                                                     lazy,
+                                                                                     quantized);
 
     if (read_lookahead.empty()) {
         router_lookahead->compute(segment_inf);
@@ -217,7 +224,10 @@ const RouterLookahead* get_cached_router_lookahead(const t_det_routing_arch& det
                                                    const std::string& read_lookahead,
                                                    const std::vector<t_segment_inf>& segment_inf,
                                                    bool is_flat,
-                                                   int route_verbosity) {
+                                                   int route_verbosity,
+                                                   const std::string& setup_cache_dir,
+                                                   bool lazy,
+                                                   bool quantized) {
     auto& router_ctx = g_vpr_ctx.routing();
     auto& mut_router_ctx = g_vpr_ctx.mutable_routing();
 
@@ -229,14 +239,49 @@ const RouterLookahead* get_cached_router_lookahead(const t_det_routing_arch& det
     if (router_lookahead) {
         return router_lookahead;
     } else {
-        return mut_router_ctx.cached_router_lookahead_.set(
-            cache_key,
-            make_router_lookahead(det_routing_arch,
-                                  router_lookahead_type,
-                                  write_lookahead,
-                                  read_lookahead,
-                                  segment_inf,
-                                  is_flat,
-                                  route_verbosity));
+        // An explicitly read lookahead takes precedence over the setup cache
+        std::string cache_file;
+        if (read_lookahead.empty()) {
+            cache_file = get_router_lookahead_cache_file(setup_cache_dir, router_lookahead_type, segment_inf, is_flat);
+        }
+        bool cache_hit = setup_cache_file_exists(cache_file);
+        if (cache_hit) {
+            VTR_LOG("Reading router lookahead from the setup cache '%s'\n", cache_file.c_str());
+        }
+
+        std::unique_ptr<RouterLookahead> new_lookahead = make_router_lookahead(det_routing_arch,
+                                                                               router_lookahead_type,
+                                                                               write_lookahead,
+                                                                               cache_hit ? cache_file : read_lookahead,
+                                                                               segment_inf,
+                                                                               is_flat,
+                                                                               route_verbosity,
+                                                                               lazy,
+                                                                               quantized);
+        if (!cache_file.empty() && !cache_hit) {
+            write_setup_cache_file(cache_file, [&](const std::string& file) {
+                new_lookahead->write(file);
+            });
+        }
+
+        return mut_router_ctx.cached_router_lookahead_.set(cache_key, std::move(new_lookahead));
     }
 }
+
+std::string get_router_lookahead_cache_file(const std::string& setup_cache_dir,
+                                            e_router_lookahead router_lookahead_type,
+                                            const std::vector<t_segment_inf>& segment_inf,
+                                            bool is_flat) {
+    // Only these lookaheads can be written to (and read from) Cap'n Proto files
+    if (setup_cache_dir.empty()
+        || (router_lookahead_type != e_router_lookahead::MAP && router_lookahead_type != e_router_lookahead::SIMPLE)) {
+        return std::string();
+    }
+
+    std::string options_key = std::to_string(int(router_lookahead_type)) + ";" + std::to_string(is_flat);
+    for (const t_segment_inf& seg : segment_inf) {
+        options_key += ";" + seg.name + ":" + std::to_string(seg.length) + ":" + std::to_string(seg.frequency);
+    }
+
+    return get_setup_cache_file(setup_cache_dir, "router_lookahead", options_key);
+}
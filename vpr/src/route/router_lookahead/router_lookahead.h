@@ -76,12 +76,26 @@ class RouterLookahead {
      */
     virtual float get_opin_distance_min_delay(int physical_tile_idx, int from_layer, int to_layer, int dx, int dy) const = 0;
 
+    /**
+     * @brief Memory used by the lookahead tables, in bytes.
+     * @return Zero if the lookahead does not account for its memory.
+     */
+    virtual size_t memory_used() const { return 0; }
+
+    /**
+     * @brief Whether get_expected_cost() only depends on the two nodes and the criticality of the connection
+     *        (not on R_upstream or the routing state), so that its results can be memoized (see lookahead_cost_cache.h).
+     */
+    virtual bool is_cost_cacheable() const { return false; }
+
     virtual ~RouterLookahead() {}
 };
 
 /**
  * @brief Force creation of lookahead object.
  * @attention This may involve recomputing the lookahead, so only use if lookahead cache cannot be used.
+ * @param lazy If true, lookaheads which support it (extended_map) defer computing their cost maps until first queried.
+ * @param quantized If true, lookaheads which support it (compressed_map) are queried from 16-bit quantized cost maps.
  * @return Return a unique pointer that points to the router lookahead object
  */
 std::unique_ptr<RouterLookahead> make_router_lookahead(const t_det_routing_arch& det_routing_arch,
@@ -90,7 +104,9 @@ std::unique_ptr<RouterLookahead> make_router_lookahead(const t_det_routing_arch&
                                                        const std::string& read_lookahead,
                                                        const std::vector<t_segment_inf>& segment_inf,
                                                        bool is_flat,
-                                                       int route_verbosity);
+                                                       int route_verbosity,
+                                                       bool lazy = false,
+                                                       bool quantized = false);
 
 /**
  * @brief Clear router lookahead cache (e.g. when changing or free rrgraph).
@@ -100,6 +116,10 @@ void invalidate_router_lookahead_cache();
 /**
  * @brief Returns lookahead for given rr graph.
  * @attention Object is cached in RouterContext, but access to cached object should performed via this function.
+ *
+ * If setup_cache_dir is non-empty (and no lookahead file is read explicitly), the lookahead is also
+ * cached on disk: it is read from the setup cache if a matching one was stored by an earlier run,
+ * and stored there after being computed otherwise (see setup_cache.h).
  * @return
  */
 const RouterLookahead* get_cached_router_lookahead(const t_det_routing_arch& det_routing_arch,
@@ -108,7 +128,19 @@ const RouterLookahead* get_cached_router_lookahead(const t_det_routing_arch& det
                                                    const std::string& read_lookahead,
                                                    const std::vector<t_segment_inf>& segment_inf,
                                                    bool is_flat,
-                                                   int route_verbosity);
+                                                   int route_verbosity,
+                                                   const std::string& setup_cache_dir = "",
+                                                   bool lazy = false,
+                                                   bool quantized = false);
+
+/**
+ * @brief Returns the setup cache file of the router lookahead of the given type, or an empty string if
+ *        the lookahead can't be cached (caching disabled or unsupported by the lookahead type).
+ */
+std::string get_router_lookahead_cache_file(const std::string& setup_cache_dir,
+                                            e_router_lookahead router_lookahead_type,
+                                            const std::vector<t_segment_inf>& segment_inf,
+                                            bool is_flat);
 
 class ClassicLookahead : public RouterLookahead {
   public:
@@ -11,31 +11,29 @@
 #include "vtr_assert.h"
 #include "vtr_time.h"
 #include "router_lookahead_map_utils.h"
+#include "router_lookahead_quantized_cost.h"
 
-vtr::Matrix<int> compressed_loc_index_map;
-std::unordered_map<int, std::unordered_set<int>> sample_locations;
+static int initialize_compressed_loc_structs(t_compressed_map_tables& tables, const std::vector<t_segment_inf>& segment_inf_vec);
 
-t_compressed_wire_cost_map f_compressed_wire_cost_map;
-
-static int initialize_compressed_loc_structs(const std::vector<t_segment_inf>& segment_inf_vec);
-
-static void compute_router_wire_compressed_lookahead(const std::vector<t_segment_inf>& segment_inf_vec, int route_verbosity);
+static void compute_router_wire_compressed_lookahead(t_compressed_map_tables& tables, const std::vector<t_segment_inf>& segment_inf_vec, int route_verbosity);
 
 /* sets the lookahead cost map entries based on representative cost entries from routing_cost_map */
-static void set_compressed_lookahead_map_costs(int from_layer_num, int segment_index, e_rr_type chan_type, util::t_routing_cost_map& routing_cost_map);
+static void set_compressed_lookahead_map_costs(t_compressed_map_tables& tables, int from_layer_num, int segment_index, e_rr_type chan_type, util::t_routing_cost_map& routing_cost_map);
 
 /* fills in missing lookahead map entries by copying the cost of the closest valid entry */
-static void fill_in_missing_compressed_lookahead_entries(const std::map<int, std::set<int>>& sorted_sample_loc, int segment_index, e_rr_type chan_type);
+static void fill_in_missing_compressed_lookahead_entries(t_compressed_map_tables& tables, const std::map<int, std::set<int>>& sorted_sample_loc, int segment_index, e_rr_type chan_type);
 
-/* returns a cost entry in the f_wire_cost_map that is near the specified coordinates (and preferably towards (0,0)) */
-static util::Cost_Entry get_nearby_cost_entry_compressed_lookahead(int from_layer_num,
+/* returns a cost entry in tables.wire_cost_map that is near the specified coordinates (and preferably towards (0,0)) */
+static util::Cost_Entry get_nearby_cost_entry_compressed_lookahead(const t_compressed_map_tables& tables,
+                                                                   int from_layer_num,
                                                                    int x,
                                                                    int y,
                                                                    int to_layer_num,
                                                                    int segment_index,
                                                                    int chan_index);
 
-static util::Cost_Entry get_nearby_cost_entry_average_neighbour(const std::map<int, std::set<int>>& sorted_sample_loc,
+static util::Cost_Entry get_nearby_cost_entry_average_neighbour(const t_compressed_map_tables& tables,
+                                                                const std::map<int, std::set<int>>& sorted_sample_loc,
                                                                 int from_layer_num,
                                                                 int missing_dx,
                                                                 int missing_dy,
@@ -43,11 +41,16 @@ static util::Cost_Entry get_nearby_cost_entry_average_neighbour(const std::map<i
                                                                 int segment_index,
                                                                 int chan_index);
 
-static util::Cost_Entry get_wire_cost_entry_compressed_lookahead(e_rr_type rr_type, int seg_index, int from_layer_num, int delta_x, int delta_y, int to_layer_num);
+static util::Cost_Entry get_wire_cost_entry_compressed_lookahead(const t_compressed_map_tables& tables, e_rr_type rr_type, int seg_index, int from_layer_num, int delta_x, int delta_y, int to_layer_num);
+
+static util::Cost_Entry get_wire_cost_entry_quantized_compressed_lookahead(const t_compressed_map_tables& tables, e_rr_type rr_type, int seg_index, int from_layer_num, int delta_x, int delta_y, int to_layer_num);
+
+/* builds tables.quantized_wire_cost_map from tables.wire_cost_map and reports the quantization error */
+static void quantize_compressed_wire_cost_map(t_compressed_map_tables& tables);
 
-static int initialize_compressed_loc_structs(const std::vector<t_segment_inf>& segment_inf_vec) {
+static int initialize_compressed_loc_structs(t_compressed_map_tables& tables, const std::vector<t_segment_inf>& segment_inf_vec) {
     const auto& grid = g_vpr_ctx.device().grid;
-    compressed_loc_index_map.resize({grid.width(), grid.height()}, UNDEFINED);
+    tables.compressed_loc_index_map.resize({grid.width(), grid.height()}, UNDEFINED);
 
     int max_seg_lenght = std::numeric_limits<int>::min();
 
@@ -85,10 +88,10 @@ static int initialize_compressed_loc_structs(const std::vector<t_segment_inf>& s
                 y_step = 8;
             }
 
-            if (sample_locations.count(x) == 0) {
-                sample_locations[x] = std::unordered_set<int>();
+            if (tables.sample_locations.count(x) == 0) {
+                tables.sample_locations[x] = std::unordered_set<int>();
             }
-            sample_locations[x].insert(y);
+            tables.sample_locations[x].insert(y);
 
             int step = std::max(x_step, y_step);
             int sample_region_x_max = std::min(x + step, grid_width);
@@ -96,7 +99,7 @@ static int initialize_compressed_loc_structs(const std::vector<t_segment_inf>& s
 
             for (int sample_x = x; sample_x < sample_region_x_max; sample_x++) {
                 for (int sample_y = y; sample_y < sample_region_y_max; sample_y++) {
-                    compressed_loc_index_map[sample_x][sample_y] = sample_point_num;
+                    tables.compressed_loc_index_map[sample_x][sample_y] = sample_point_num;
                 }
             }
 
@@ -109,16 +112,17 @@ static int initialize_compressed_loc_structs(const std::vector<t_segment_inf>& s
     return sample_point_num;
 }
 
-static void compute_router_wire_compressed_lookahead(const std::vector<t_segment_inf>& segment_inf_vec,
+static void compute_router_wire_compressed_lookahead(t_compressed_map_tables& tables,
+                                                     const std::vector<t_segment_inf>& segment_inf_vec,
                                                      int route_verbosity) {
     vtr::ScopedStartFinishTimer timer("Computing wire lookahead");
 
     const auto& device_ctx = g_vpr_ctx.device();
     const auto& grid = device_ctx.grid;
 
-    int num_sampling_points = initialize_compressed_loc_structs(segment_inf_vec);
+    int num_sampling_points = initialize_compressed_loc_structs(tables, segment_inf_vec);
 
-    f_compressed_wire_cost_map = t_compressed_wire_cost_map({static_cast<unsigned long>(grid.get_num_layers()),
+    tables.wire_cost_map = t_compressed_wire_cost_map({static_cast<unsigned long>(grid.get_num_layers()),
                                                              2,
                                                              segment_inf_vec.size(),
                                                              grid.get_num_layers(),
@@ -130,7 +134,7 @@ static void compute_router_wire_compressed_lookahead(const std::vector<t_segment
     }
 
     std::map<int, std::set<int>> sorted_sample_loc;
-    for (const auto& sample_loc : sample_locations) {
+    for (const auto& sample_loc : tables.sample_locations) {
         sorted_sample_loc[sample_loc.first] = std::set<int>(sample_loc.second.begin(), sample_loc.second.end());
     }
     //Profile each wire segment type
@@ -150,7 +154,7 @@ static void compute_router_wire_compressed_lookahead(const std::vector<t_segment
                                                                                        from_layer_num,
                                                                                        chan_type,
                                                                                        segment_inf,
-                                                                                       sample_locations,
+                                                                                       tables.sample_locations,
                                                                                        /*sample_all_locs=*/false,
                                                                                        route_verbosity);
                 if (routing_cost_map.empty()) {
@@ -159,17 +163,17 @@ static void compute_router_wire_compressed_lookahead(const std::vector<t_segment
 
                 /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
                  * cost map */
-                set_compressed_lookahead_map_costs(from_layer_num, segment_inf.seg_index, chan_type, routing_cost_map);
+                set_compressed_lookahead_map_costs(tables, from_layer_num, segment_inf.seg_index, chan_type, routing_cost_map);
 
                 /* fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
                  * a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed) */
-                fill_in_missing_compressed_lookahead_entries(sorted_sample_loc, segment_inf.seg_index, chan_type);
+                fill_in_missing_compressed_lookahead_entries(tables, sorted_sample_loc, segment_inf.seg_index, chan_type);
             }
         }
     }
 }
 
-static void set_compressed_lookahead_map_costs(int from_layer_num, int segment_index, e_rr_type chan_type, util::t_routing_cost_map& routing_cost_map) {
+static void set_compressed_lookahead_map_costs(t_compressed_map_tables& tables, int from_layer_num, int segment_index, e_rr_type chan_type, util::t_routing_cost_map& routing_cost_map) {
     int chan_index = 0;
     if (chan_type == e_rr_type::CHANY) {
         chan_index = 1;
@@ -182,20 +186,21 @@ static void set_compressed_lookahead_map_costs(int from_layer_num, int segment_i
         for (int ix = 0; ix < x_dim; ix++) {
             int y_dim = static_cast<int>(routing_cost_map.dim_size(2));
             for (int iy = 0; iy < y_dim; iy++) {
-                if (sample_locations.find(ix) == sample_locations.end() || sample_locations.at(ix).find(iy) == sample_locations[ix].end()) {
+                if (tables.sample_locations.find(ix) == tables.sample_locations.end() || tables.sample_locations.at(ix).find(iy) == tables.sample_locations[ix].end()) {
                     continue;
                 }
                 util::Expansion_Cost_Entry& expansion_cost_entry = routing_cost_map[to_layer][ix][iy];
-                int compressed_idx = compressed_loc_index_map[ix][iy];
+                int compressed_idx = tables.compressed_loc_index_map[ix][iy];
                 VTR_ASSERT(compressed_idx != UNDEFINED);
 
-                f_compressed_wire_cost_map[from_layer_num][chan_index][segment_index][to_layer][compressed_idx] = expansion_cost_entry.get_representative_cost_entry(util::e_representative_entry_method::SMALLEST);
+                tables.wire_cost_map[from_layer_num][chan_index][segment_index][to_layer][compressed_idx] = expansion_cost_entry.get_representative_cost_entry(util::e_representative_entry_method::SMALLEST);
             }
         }
     }
 }
 
-static void fill_in_missing_compressed_lookahead_entries(const std::map<int, std::set<int>>& sorted_sample_loc,
+static void fill_in_missing_compressed_lookahead_entries(t_compressed_map_tables& tables,
+                                                         const std::map<int, std::set<int>>& sorted_sample_loc,
                                                          int segment_index,
                                                          e_rr_type chan_type) {
     int chan_index = 0;
@@ -213,21 +218,22 @@ static void fill_in_missing_compressed_lookahead_entries(const std::map<int, std
         for (int to_layer_num = 0; to_layer_num < grid_layers; ++to_layer_num) {
             for (int ix = 0; ix < grid_width; ix++) {
                 for (int iy = 0; iy < grid_height; iy++) {
-                    if (sample_locations.find(ix) == sample_locations.end() || sample_locations.at(ix).find(iy) == sample_locations[ix].end()) {
+                    if (tables.sample_locations.find(ix) == tables.sample_locations.end() || tables.sample_locations.at(ix).find(iy) == tables.sample_locations[ix].end()) {
                         continue;
                     }
-                    int compressed_idx = compressed_loc_index_map[ix][iy];
-                    util::Cost_Entry cost_entry = f_compressed_wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][compressed_idx];
+                    int compressed_idx = tables.compressed_loc_index_map[ix][iy];
+                    util::Cost_Entry cost_entry = tables.wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][compressed_idx];
 
                     if (std::isnan(cost_entry.delay) && std::isnan(cost_entry.congestion)) {
-                        util::Cost_Entry copied_entry = get_nearby_cost_entry_average_neighbour(sorted_sample_loc,
+                        util::Cost_Entry copied_entry = get_nearby_cost_entry_average_neighbour(tables,
+                                                                                                sorted_sample_loc,
                                                                                                 from_layer_num,
                                                                                                 ix,
                                                                                                 iy,
                                                                                                 to_layer_num,
                                                                                                 segment_index,
                                                                                                 chan_index);
-                        f_compressed_wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][compressed_idx] = copied_entry;
+                        tables.wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][compressed_idx] = copied_entry;
                     }
                 }
             }
@@ -235,8 +241,9 @@ static void fill_in_missing_compressed_lookahead_entries(const std::map<int, std
     }
 }
 
-/* returns a cost entry in the f_wire_cost_map that is near the specified coordinates (and preferably towards (0,0)) */
-static util::Cost_Entry get_nearby_cost_entry_compressed_lookahead(int from_layer_num,
+/* returns a cost entry in tables.wire_cost_map that is near the specified coordinates (and preferably towards (0,0)) */
+static util::Cost_Entry get_nearby_cost_entry_compressed_lookahead(const t_compressed_map_tables& tables,
+                                                                   int from_layer_num,
                                                                    int x,
                                                                    int y,
                                                                    int to_layer_num,
@@ -268,9 +275,9 @@ static util::Cost_Entry get_nearby_cost_entry_compressed_lookahead(int from_laye
     copy_y = std::max(copy_y, 0); //Clip to zero
     copy_x = std::max(copy_x, 0); //Clip to zero
 
-    int compressed_idx = compressed_loc_index_map[copy_x][copy_y];
+    int compressed_idx = tables.compressed_loc_index_map[copy_x][copy_y];
 
-    util::Cost_Entry copy_entry = f_compressed_wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][compressed_idx];
+    util::Cost_Entry copy_entry = tables.wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][compressed_idx];
 
     /* if the entry to be copied is also empty, recurse */
     if (std::isnan(copy_entry.delay) && std::isnan(copy_entry.congestion)) {
@@ -284,24 +291,25 @@ static util::Cost_Entry get_nearby_cost_entry_compressed_lookahead(int from_laye
                 copy_entry = util::Cost_Entry(std::numeric_limits<float>::max() / 1e12, std::numeric_limits<float>::max() / 1e12);
             }
         } else {
-            copy_entry = get_nearby_cost_entry_compressed_lookahead(from_layer_num, copy_x, copy_y, to_layer_num, segment_index, chan_index);
+            copy_entry = get_nearby_cost_entry_compressed_lookahead(tables, from_layer_num, copy_x, copy_y, to_layer_num, segment_index, chan_index);
         }
     }
 
     return copy_entry;
 }
 
-static util::Cost_Entry get_nearby_cost_entry_average_neighbour(const std::map<int, std::set<int>>& sorted_sample_loc,
+static util::Cost_Entry get_nearby_cost_entry_average_neighbour(const t_compressed_map_tables& tables,
+                                                                const std::map<int, std::set<int>>& sorted_sample_loc,
                                                                 int from_layer_num,
                                                                 int missing_dx,
                                                                 int missing_dy,
                                                                 int to_layer_num,
                                                                 int segment_index,
                                                                 int chan_index) {
-    int missing_point_idx = compressed_loc_index_map[missing_dx][missing_dy];
+    int missing_point_idx = tables.compressed_loc_index_map[missing_dx][missing_dy];
     VTR_ASSERT(missing_point_idx != UNDEFINED);
-    VTR_ASSERT(std::isnan(f_compressed_wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][missing_point_idx].delay));
-    VTR_ASSERT(std::isnan(f_compressed_wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][missing_point_idx].congestion));
+    VTR_ASSERT(std::isnan(tables.wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][missing_point_idx].delay));
+    VTR_ASSERT(std::isnan(tables.wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][missing_point_idx].congestion));
 
     auto missing_point_compressed_iter_x = sorted_sample_loc.lower_bound(missing_dx);
     if (missing_point_compressed_iter_x->first != missing_dx) {
@@ -354,8 +362,8 @@ static util::Cost_Entry get_nearby_cost_entry_average_neighbour(const std::map<i
             }
             std::advance(missing_point_compressed_iter_y, dy);
             neighbour_y = *missing_point_compressed_iter_y;
-            int neighbour_compressed_idx = compressed_loc_index_map[neighbour_x][neighbour_y];
-            util::Cost_Entry copy_entry = f_compressed_wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][neighbour_compressed_idx];
+            int neighbour_compressed_idx = tables.compressed_loc_index_map[neighbour_x][neighbour_y];
+            util::Cost_Entry copy_entry = tables.wire_cost_map[from_layer_num][chan_index][segment_index][to_layer_num][neighbour_compressed_idx];
             if (std::isnan(copy_entry.delay) || std::isnan(copy_entry.congestion)) {
                 continue;
             }
@@ -369,11 +377,27 @@ static util::Cost_Entry get_nearby_cost_entry_average_neighbour(const std::map<i
         return {neighbour_delay_sum / static_cast<float>(neighbour_num),
                 neighbour_cong_sum / static_cast<float>(neighbour_num)};
     } else {
-        return get_nearby_cost_entry_compressed_lookahead(from_layer_num, missing_dx, missing_dy, to_layer_num, segment_index, chan_index);
+        return get_nearby_cost_entry_compressed_lookahead(tables, from_layer_num, missing_dx, missing_dy, to_layer_num, segment_index, chan_index);
+    }
+}
+
+static util::Cost_Entry get_wire_cost_entry_compressed_lookahead(const t_compressed_map_tables& tables, e_rr_type rr_type, int seg_index, int from_layer_num, int delta_x, int delta_y, int to_layer_num) {
+    VTR_ASSERT_SAFE(rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY);
+
+    int chan_index = 0;
+    if (rr_type == e_rr_type::CHANY) {
+        chan_index = 1;
     }
+
+    int compressed_idx = tables.compressed_loc_index_map[delta_x][delta_y];
+    VTR_ASSERT_SAFE(from_layer_num < (int)tables.wire_cost_map.dim_size(0));
+    VTR_ASSERT_SAFE(to_layer_num < (int)tables.wire_cost_map.dim_size(3));
+    VTR_ASSERT_SAFE(compressed_idx < (int)tables.wire_cost_map.dim_size(4));
+
+    return tables.wire_cost_map[from_layer_num][chan_index][seg_index][to_layer_num][compressed_idx];
 }
 
-static util::Cost_Entry get_wire_cost_entry_compressed_lookahead(e_rr_type rr_type, int seg_index, int from_layer_num, int delta_x, int delta_y, int to_layer_num) {
+static util::Cost_Entry get_wire_cost_entry_quantized_compressed_lookahead(const t_compressed_map_tables& tables, e_rr_type rr_type, int seg_index, int from_layer_num, int delta_x, int delta_y, int to_layer_num) {
     VTR_ASSERT_SAFE(rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY);
 
     int chan_index = 0;
@@ -381,19 +405,83 @@ static util::Cost_Entry get_wire_cost_entry_compressed_lookahead(e_rr_type rr_ty
         chan_index = 1;
     }
 
-    int compressed_idx = compressed_loc_index_map[delta_x][delta_y];
-    VTR_ASSERT_SAFE(from_layer_num < (int)f_compressed_wire_cost_map.dim_size(0));
-    VTR_ASSERT_SAFE(to_layer_num < (int)f_compressed_wire_cost_map.dim_size(3));
-    VTR_ASSERT_SAFE(compressed_idx < (int)f_compressed_wire_cost_map.dim_size(4));
+    int compressed_idx = tables.compressed_loc_index_map[delta_x][delta_y];
+    VTR_ASSERT_SAFE(from_layer_num < (int)tables.quantized_wire_cost_map.dim_size(0));
+    VTR_ASSERT_SAFE(to_layer_num < (int)tables.quantized_wire_cost_map.dim_size(3));
+    VTR_ASSERT_SAFE(compressed_idx < (int)tables.quantized_wire_cost_map.dim_size(4));
 
-    return f_compressed_wire_cost_map[from_layer_num][chan_index][seg_index][to_layer_num][compressed_idx];
+    const util::t_quantized_cost_entry& entry = tables.quantized_wire_cost_map[from_layer_num][chan_index][seg_index][to_layer_num][compressed_idx];
+    return util::Cost_Entry(tables.quantized_delay_scale.decode(entry.delay),
+                            tables.quantized_congestion_scale.decode(entry.congestion));
+}
+
+static void quantize_compressed_wire_cost_map(t_compressed_map_tables& tables) {
+    vtr::ScopedStartFinishTimer timer("Quantizing router lookahead map");
+
+    const size_t num_entries = tables.wire_cost_map.size();
+
+    // The scales are chosen so that the smallest costs of the table are representable
+    float min_delay = std::numeric_limits<float>::infinity();
+    float min_congestion = std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < num_entries; i++) {
+        const util::Cost_Entry& entry = tables.wire_cost_map.get(i);
+        if (entry.delay > 0.f) {
+            min_delay = std::min(min_delay, entry.delay);
+        }
+        if (entry.congestion > 0.f) {
+            min_congestion = std::min(min_congestion, entry.congestion);
+        }
+    }
+    tables.quantized_delay_scale = util::QuantizedCostScale(min_delay);
+    tables.quantized_congestion_scale = util::QuantizedCostScale(min_congestion);
+
+    std::array<size_t, 5> dims;
+    for (size_t i = 0; i < dims.size(); i++) {
+        dims[i] = tables.wire_cost_map.dim_size(i);
+    }
+    tables.quantized_wire_cost_map.resize(dims);
+
+    // Accuracy report against the float table
+    size_t num_valid = 0;
+    double max_delay_error = 0., sum_delay_error = 0.;
+    double max_cong_error = 0., sum_cong_error = 0.;
+    auto relative_error = [](float orig, float quantized) {
+        return orig > 0.f ? std::abs(double(quantized) - orig) / orig : std::abs(double(quantized));
+    };
+    for (size_t i = 0; i < num_entries; i++) {
+        const util::Cost_Entry& entry = tables.wire_cost_map.get(i);
+        util::t_quantized_cost_entry& quantized_entry = tables.quantized_wire_cost_map.get(i);
+        quantized_entry.delay = tables.quantized_delay_scale.encode(entry.delay);
+        quantized_entry.congestion = tables.quantized_congestion_scale.encode(entry.congestion);
+
+        if (!entry.valid()) {
+            continue;
+        }
+        num_valid++;
+        double delay_error = relative_error(entry.delay, tables.quantized_delay_scale.decode(quantized_entry.delay));
+        double cong_error = relative_error(entry.congestion, tables.quantized_congestion_scale.decode(quantized_entry.congestion));
+        max_delay_error = std::max(max_delay_error, delay_error);
+        max_cong_error = std::max(max_cong_error, cong_error);
+        sum_delay_error += delay_error;
+        sum_cong_error += cong_error;
+    }
+
+    VTR_LOG("Quantized router lookahead map: %zu entries, %.1f KiB (float map: %.1f KiB)\n",
+            num_entries,
+            num_entries * sizeof(util::t_quantized_cost_entry) / 1024.,
+            num_entries * sizeof(util::Cost_Entry) / 1024.);
+    VTR_LOG("Quantization relative error over %zu valid entries: delay max %g mean %g, congestion max %g mean %g\n",
+            num_valid,
+            max_delay_error, num_valid ? sum_delay_error / num_valid : 0.,
+            max_cong_error, num_valid ? sum_cong_error / num_valid : 0.);
 }
 
 /******** Interface class member function definitions ********/
-CompressedMapLookahead::CompressedMapLookahead(const t_det_routing_arch& det_routing_arch, bool is_flat, int route_verbosity)
+CompressedMapLookahead::CompressedMapLookahead(const t_det_routing_arch& det_routing_arch, bool is_flat, int route_verbosity, bool quantized)
     : det_routing_arch_(det_routing_arch)
     , is_flat_(is_flat)
-    , route_verbosity_(route_verbosity) {}
+    , route_verbosity_(route_verbosity)
+    , quantized_(quantized) {}
 
 float CompressedMapLookahead::get_expected_cost(RRNodeId current_node, RRNodeId target_node, const t_conn_cost_params& params, float R_upstream) const {
     auto& device_ctx = g_vpr_ctx.device();
@@ -433,11 +521,16 @@ std::pair<float, float> CompressedMapLookahead::get_expected_delay_and_cong(RRNo
     float expected_delay_cost = std::numeric_limits<float>::infinity();
     float expected_cong_cost = std::numeric_limits<float>::infinity();
 
+    auto get_wire_cost_entry = [this](e_rr_type rr_type, int seg_index, int from_layer, int dx, int dy, int to_layer) {
+        return quantized_ ? get_wire_cost_entry_quantized_compressed_lookahead(tables_, rr_type, seg_index, from_layer, dx, dy, to_layer)
+                          : get_wire_cost_entry_compressed_lookahead(tables_, rr_type, seg_index, from_layer, dx, dy, to_layer);
+    };
+
     e_rr_type from_type = rr_graph.node_type(from_node);
     if (from_type == e_rr_type::SOURCE || from_type == e_rr_type::OPIN) {
         //When estimating costs from a SOURCE/OPIN we look-up to find which wire types (and the
         //cost to reach them) in src_opin_delays. Once we know what wire types are
-        //reachable, we query the f_wire_cost_map (i.e. the wire lookahead) to get the final
+        //reachable, we query tables_.wire_cost_map (i.e. the wire lookahead) to get the final
         //delay to reach the sink.
 
         t_physical_tile_type_ptr from_tile_type = device_ctx.grid.get_physical_type({rr_graph.node_xlow(from_node),
@@ -452,7 +545,7 @@ std::pair<float, float> CompressedMapLookahead::get_expected_delay_and_cong(RRNo
                                                                                          delta_x,
                                                                                          delta_y,
                                                                                          to_layer_num,
-                                                                                         get_wire_cost_entry_compressed_lookahead);
+                                                                                         get_wire_cost_entry);
 
         expected_delay_cost *= params.criticality;
         expected_cong_cost *= (1 - params.criticality);
@@ -469,7 +562,7 @@ std::pair<float, float> CompressedMapLookahead::get_expected_delay_and_cong(RRNo
                                 .c_str());
 
     } else if (from_type == e_rr_type::CHANX || from_type == e_rr_type::CHANY) {
-        //When estimating costs from a wire, we directly look-up the result in the wire lookahead (f_wire_cost_map)
+        //When estimating costs from a wire, we directly look-up the result in the wire lookahead (tables_.wire_cost_map)
 
         RRIndexedDataId from_cost_index = rr_graph.node_cost_index(from_node);
         int from_seg_index = device_ctx.rr_indexed_data[from_cost_index].seg_index;
@@ -477,12 +570,12 @@ std::pair<float, float> CompressedMapLookahead::get_expected_delay_and_cong(RRNo
         VTR_ASSERT(from_seg_index >= 0);
 
         /* now get the expected cost from our lookahead map */
-        util::Cost_Entry cost_entry = get_wire_cost_entry_compressed_lookahead(from_type,
-                                                                               from_seg_index,
-                                                                               from_layer_num,
-                                                                               delta_x,
-                                                                               delta_y,
-                                                                               to_layer_num);
+        util::Cost_Entry cost_entry = get_wire_cost_entry(from_type,
+                                                          from_seg_index,
+                                                          from_layer_num,
+                                                          delta_x,
+                                                          delta_y,
+                                                          to_layer_num);
         expected_delay_cost = cost_entry.delay;
         expected_cong_cost = cost_entry.congestion;
 
@@ -515,20 +608,32 @@ void CompressedMapLookahead::compute(const std::vector<t_segment_inf>& segment_i
 
     // First compute the delay map when starting from the various wire types
     // (CHANX/CHANY) in the routing architecture
-    compute_router_wire_compressed_lookahead(segment_inf, route_verbosity_);
+    compute_router_wire_compressed_lookahead(tables_, segment_inf, route_verbosity_);
+
+    if (quantized_) {
+        quantize_compressed_wire_cost_map(tables_);
+    }
 
     // Next, compute which wire types are accessible (and the cost to reach them)
     // from the different physical tile type's SOURCEs & OPINs
     this->src_opin_delays = util::compute_router_src_opin_lookahead(is_flat_, route_verbosity_);
 }
 
+size_t CompressedMapLookahead::memory_used() const {
+    return (tables_.wire_cost_map.size() + distance_based_min_cost.size()) * sizeof(util::Cost_Entry)
+           + tables_.quantized_wire_cost_map.size() * sizeof(util::t_quantized_cost_entry);
+}
+
 void CompressedMapLookahead::write(const std::string& file_name) const {
     if (vtr::check_file_name_extension(file_name, ".csv")) {
-        std::vector<int> wire_cost_map_size(f_compressed_wire_cost_map.ndims());
-        for (size_t i = 0; i < f_compressed_wire_cost_map.ndims(); ++i) {
-            wire_cost_map_size[i] = static_cast<int>(f_compressed_wire_cost_map.dim_size(i));
+        std::vector<int> wire_cost_map_size(tables_.wire_cost_map.ndims());
+        for (size_t i = 0; i < tables_.wire_cost_map.ndims(); ++i) {
+            wire_cost_map_size[i] = static_cast<int>(tables_.wire_cost_map.dim_size(i));
         }
-        dump_readable_router_lookahead_map(file_name, wire_cost_map_size, get_wire_cost_entry_compressed_lookahead);
+        util::dump_readable_router_lookahead_map(file_name, wire_cost_map_size,
+                                                 [this](e_rr_type rr_type, int seg_index, int from_layer, int dx, int dy, int to_layer) {
+                                                     return get_wire_cost_entry_compressed_lookahead(tables_, rr_type, seg_index, from_layer, dx, dy, to_layer);
+                                                 });
 
     } else {
         VTR_ASSERT(vtr::check_file_name_extension(file_name, ".capnp"));
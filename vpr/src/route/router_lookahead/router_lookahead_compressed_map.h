@@ -1,23 +1,62 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include "vtr_ndmatrix.h"
 #include "router_lookahead.h"
 #include "router_lookahead_map_utils.h"
+#include "router_lookahead_quantized_cost.h"
+
+// This is a 5D array that stores estimates of the cost to reach a location at a particular distance away from the current location.
+// The router look-ahead is built under the assumption of translation-invariance, meaning the current location (in terms of x-y coordinates) is not crucial.
+// The indices of this array are as follows:
+//   from_layer: The layer number that the node under consideration is on.
+//   Chan type: The type of channel (x/y) that the node under consideration belongs to.
+//   Seg type: The type of segment (listed under "segmentlist" tag in the architecture file) that the node under consideration belongs to.
+//   to_layer: The layer number that the target node is on.
+//   compressed index: In this type of router look-ahead, we do not sample every x and y. Another data structure maps every x and y to
+//   an index. That index should be used here.
+
+typedef vtr::NdMatrix<util::Cost_Entry, 5> t_compressed_wire_cost_map; //[0..num_layers][0..1][[0..num_seg_types-1][0..num_layers][compressed_idx]
+                                                                       //[0..1] entry distinguish between CHANX/CHANY start nodes respectively
+                                                                       // The first index is the layer number that the node under consideration is on, and the forth index
+                                                                       // is the layer number that the target node is on.
+
+/// @brief The tables of a CompressedMapLookahead
+struct t_compressed_map_tables {
+    /// Index in the compressed dimension of wire_cost_map of each (dx, dy)
+    vtr::Matrix<int> compressed_loc_index_map;
+    /// The sampled dy of each sampled dx
+    std::unordered_map<int, std::unordered_set<int>> sample_locations;
+    t_compressed_wire_cost_map wire_cost_map;
+    /// Quantized copy of wire_cost_map, queried instead of it by a quantized lookahead (same indices)
+    vtr::NdMatrix<util::t_quantized_cost_entry, 5> quantized_wire_cost_map;
+    util::QuantizedCostScale quantized_delay_scale;
+    util::QuantizedCostScale quantized_congestion_scale;
+};
 
 class CompressedMapLookahead : public RouterLookahead {
   public:
-    explicit CompressedMapLookahead(const t_det_routing_arch& det_routing_arch, bool is_flat, int route_verbosity);
+    /**
+     * @param quantized If true, the wire cost map is queried from a 16-bit quantized copy (see router_lookahead_quantized_cost.h),
+     *                  a third of the size of the float map.
+     */
+    explicit CompressedMapLookahead(const t_det_routing_arch& det_routing_arch, bool is_flat, int route_verbosity, bool quantized = false);
 
   private:
     //Look-up table from SOURCE/OPIN to CHANX/CHANY of various types
     util::t_src_opin_delays src_opin_delays;
     // Lookup table to store the minimum cost for each dx and dy
     vtr::NdMatrix<util::Cost_Entry, 3> distance_based_min_cost; // [layer_num][dx][dy] -> cost
+    // The wire lookahead tables, held by each lookahead (rather than at file scope) so that the flows
+    // running in the same process each use their own
+    t_compressed_map_tables tables_;
 
     const t_det_routing_arch& det_routing_arch_;
     bool is_flat_;
     int route_verbosity_;
+    bool quantized_;
 
   protected:
     float get_expected_cost(RRNodeId node, RRNodeId target_node, const t_conn_cost_params& params, float R_upstream) const override;
@@ -50,19 +89,7 @@ class CompressedMapLookahead : public RouterLookahead {
     float get_opin_distance_min_delay(int /*physical_tile_idx*/, int /*from_layer*/, int /*to_layer*/, int /*dx*/, int /*dy*/) const override {
         return -1.;
     }
-};
-
-// This is a 5D array that stores estimates of the cost to reach a location at a particular distance away from the current location.
-// The router look-ahead is built under the assumption of translation-invariance, meaning the current location (in terms of x-y coordinates) is not crucial.
-// The indices of this array are as follows:
-//   from_layer: The layer number that the node under consideration is on.
-//   Chan type: The type of channel (x/y) that the node under consideration belongs to.
-//   Seg type: The type of segment (listed under "segmentlist" tag in the architecture file) that the node under consideration belongs to.
-//   to_layer: The layer number that the target node is on.
-//   compressed index: In this type of router look-ahead, we do not sample every x and y. Another data structure maps every x and y to
-//   an index. That index should be used here.
 
-typedef vtr::NdMatrix<util::Cost_Entry, 5> t_compressed_wire_cost_map; //[0..num_layers][0..1][[0..num_seg_types-1][0..num_layers][compressed_idx]
-                                                                       //[0..1] entry distinguish between CHANX/CHANY start nodes respectively
-                                                                       // The first index is the layer number that the node under consideration is on, and the forth index
-                                                                       // is the layer number that the target node is on.
+    size_t memory_used() const override;
+    bool is_cost_cacheable() const override { return true; }
+};
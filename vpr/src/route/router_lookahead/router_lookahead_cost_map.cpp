@@ -216,9 +216,18 @@ void CostMap::fill_holes(vtr::NdMatrix<util::Cost_Entry, 2>& matrix, int seg_ind
     }
 }
 
-// set the cost map for a segment type and chan type, filling holes
+// set the cost map for all segment types, filling holes
 void CostMap::set_cost_map(const util::RoutingCosts& delay_costs, const util::RoutingCosts& base_costs) {
-    // Calculate the bounding boxes
+    for (size_t seg = 0; seg < seg_count_; seg++) {
+        set_segment_cost_map(seg, delay_costs, base_costs);
+    }
+}
+
+// set the cost map for a segment type, filling holes
+void CostMap::set_segment_cost_map(int seg, const util::RoutingCosts& delay_costs, const util::RoutingCosts& base_costs) {
+    VTR_ASSERT(seg >= 0 && seg < (ssize_t)seg_count_);
+
+    // Calculate the bounding box
     // Bounding boxes are used to reduce the cost map size. They are generated based on the minimum
     // and maximum coordinates of the x/y delta delays obtained for each segment.
     //
@@ -227,54 +236,56 @@ void CostMap::set_cost_map(const util::RoutingCosts& delay_costs, const util::Ro
     // In case the lookahead is queried to return a cost that is outside of the bounding box, the closest
     // cost within the bounding box is returned, with the addition of a calculated penalty cost.
     //
-    // The bounding boxes do have two dimensions and are specified as matrices.
-    // The first dimension though is unused and set to be constant as it is required to keep consistency
+    // The cost map is indexed with a first, unused dimension, which is required to keep consistency
     // with the lookahead map. The extended lookahead map and the normal one index the various costs as follows:
     //      - Lookahead map         : [0..chan_index][seg_index][dx][dy]
     //      - Extended lookahead map: [0][seg_index][dx][dy]
     //
     // The extended lookahead map does not require the first channel index distinction, therefore the first dimension
     // remains unused.
-    vtr::Matrix<vtr::Rect<int>> bounds({1, seg_count_});
+    vtr::Rect<int> seg_bounds;
     for (const auto& entry : delay_costs) {
-        bounds[0][entry.first.seg_index].expand_bounding_box(vtr::Rect<int>(entry.first.delta));
+        if (entry.first.seg_index == seg) {
+            seg_bounds.expand_bounding_box(vtr::Rect<int>(entry.first.delta));
+        }
     }
     for (const auto& entry : base_costs) {
-        bounds[0][entry.first.seg_index].expand_bounding_box(vtr::Rect<int>(entry.first.delta));
+        if (entry.first.seg_index == seg) {
+            seg_bounds.expand_bounding_box(vtr::Rect<int>(entry.first.delta));
+        }
     }
 
+    penalty_[0][seg] = std::numeric_limits<float>::infinity();
+
     // Adds the above generated bounds to the cost map.
     // Also the offset_ data is stored, to allow the application of the adjustment factor to the
     // delta x/y coordinates.
-    for (size_t seg = 0; seg < seg_count_; seg++) {
-        const auto& seg_bounds = bounds[0][seg];
-        if (seg_bounds.empty()) {
-            // Didn't find any sample routes, so routing isn't possible between these segment/chan types.
-            offset_[0][seg] = std::make_pair(0, 0);
-            cost_map_[0][seg] = vtr::NdMatrix<util::Cost_Entry, 2>(
-                {size_t(0), size_t(0)});
-            continue;
-        } else {
-            offset_[0][seg] = std::make_pair(seg_bounds.xmin(), seg_bounds.ymin());
-            cost_map_[0][seg] = vtr::NdMatrix<util::Cost_Entry, 2>(
-                {size_t(seg_bounds.width()), size_t(seg_bounds.height())});
-        }
+    if (seg_bounds.empty()) {
+        // Didn't find any sample routes, so routing isn't possible between these segment/chan types.
+        offset_[0][seg] = std::make_pair(0, 0);
+        cost_map_[0][seg] = vtr::NdMatrix<util::Cost_Entry, 2>(
+            {size_t(0), size_t(0)});
+        return;
     }
 
+    offset_[0][seg] = std::make_pair(seg_bounds.xmin(), seg_bounds.ymin());
+    auto& matrix = cost_map_[0][seg];
+    matrix = vtr::NdMatrix<util::Cost_Entry, 2>({size_t(seg_bounds.width()), size_t(seg_bounds.height())});
+
     // Fill the cost map entries with the delay and congestion costs obtained in the dijkstra expansion step.
     for (const auto& entry : delay_costs) {
-        int seg = entry.first.seg_index;
-        const auto& seg_bounds = bounds[0][seg];
-        int x = entry.first.delta.x() - seg_bounds.xmin();
-        int y = entry.first.delta.y() - seg_bounds.ymin();
-        cost_map_[0][seg][x][y].delay = entry.second;
+        if (entry.first.seg_index == seg) {
+            int x = entry.first.delta.x() - seg_bounds.xmin();
+            int y = entry.first.delta.y() - seg_bounds.ymin();
+            matrix[x][y].delay = entry.second;
+        }
     }
     for (const auto& entry : base_costs) {
-        int seg = entry.first.seg_index;
-        const auto& seg_bounds = bounds[0][seg];
-        int x = entry.first.delta.x() - seg_bounds.xmin();
-        int y = entry.first.delta.y() - seg_bounds.ymin();
-        cost_map_[0][seg][x][y].congestion = entry.second;
+        if (entry.first.seg_index == seg) {
+            int x = entry.first.delta.x() - seg_bounds.xmin();
+            int y = entry.first.delta.y() - seg_bounds.ymin();
+            matrix[x][y].congestion = entry.second;
+        }
     }
 
     // Adjust the cost map in two steps.
@@ -283,21 +294,21 @@ void CostMap::set_cost_map(const util::RoutingCosts& delay_costs, const util::Ro
     //      2. holes filling: some entries might miss delay/congestion data. These holes are being
     //                        filled in a spiral fashion, starting from the hole, to find the nearby
     //                        valid cost.
-    for (size_t seg = 0; seg < seg_count_; seg++) {
-        penalty_[0][seg] = std::numeric_limits<float>::infinity();
-        const auto& seg_bounds = bounds[0][seg];
-        if (seg_bounds.empty()) {
-            continue;
-        }
-        auto& matrix = cost_map_[0][seg];
 
-        // Penalty factor calculation for the current segment
-        float delay_penalty = this->get_penalty(matrix);
-        penalty_[0][seg] = delay_penalty;
+    // Penalty factor calculation for the current segment
+    float delay_penalty = this->get_penalty(matrix);
+    penalty_[0][seg] = delay_penalty;
+
+    // Holes filling
+    this->fill_holes(matrix, seg, seg_bounds.width(), seg_bounds.height(), delay_penalty);
+}
 
-        // Holes filling
-        this->fill_holes(matrix, seg, seg_bounds.width(), seg_bounds.height(), delay_penalty);
+size_t CostMap::memory_used() const {
+    size_t bytes = cost_map_.size() * sizeof(vtr::Matrix<util::Cost_Entry>);
+    for (size_t i = 0; i < cost_map_.size(); i++) {
+        bytes += cost_map_.get(i).size() * sizeof(util::Cost_Entry);
     }
+    return bytes + offset_.size() * sizeof(std::pair<int, int>) + penalty_.size() * sizeof(float);
 }
 
 // prints an ASCII diagram of each cost map for a segment type (debug)
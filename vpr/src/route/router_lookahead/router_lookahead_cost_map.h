@@ -54,6 +54,18 @@ class CostMap {
      */
     void set_cost_map(const util::RoutingCosts& delay_costs, const util::RoutingCosts& base_costs);
 
+    /**
+     * @brief Sets the cost map of a single segment type, leaving the others untouched
+     *
+     * Entries of other segment types in delay_costs and base_costs are ignored. Cost maps of different
+     * segment types may be set (and queried with find_cost) concurrently.
+     *
+     * @param seg_index index of the segment type to set
+     * @param delay_costs delay costs calculated with the dijkstra expansions
+     * @param base_costs congestion costs calculated with the dijkstra expansions
+     */
+    void set_segment_cost_map(int seg_index, const util::RoutingCosts& delay_costs, const util::RoutingCosts& base_costs);
+
     /**
      * @brief Gets the cost of an entry that is close to a hole in the cost map
      *
@@ -82,6 +94,10 @@ class CostMap {
     void write(const std::string& file) const;
 
     void print(int iseg) const;
+
+    ///@brief Memory used by the cost maps, in bytes
+    size_t memory_used() const;
+
     std::vector<std::pair<int, int>> list_empty() const;
 
   private:
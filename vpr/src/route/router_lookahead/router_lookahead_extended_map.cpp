@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <queue>
+#include <mutex>
 
 #include "connection_router_interface.h"
 #include "describe_rr_node.h"
@@ -25,6 +26,7 @@
 
 #if defined(VPR_USE_TBB)
 #include <tbb/parallel_for_each.h>
+#include <tbb/task_arena.h>
 #endif
 
 /* we're profiling routing cost over many tracks for each wire type, so we'll
@@ -68,7 +70,7 @@ std::pair<float, float> ExtendedMapLookahead::get_src_opin_cost(RRNodeId from_no
 
     //When estimating costs from a SOURCE/OPIN we look-up to find which wire types (and the
     //cost to reach them) in f_src_opin_delays. Once we know what wire types are
-    //reachable, we query the f_wire_cost_map (i.e. the wire lookahead) to get the final
+    //reachable, we query the wire cost map (i.e. the wire lookahead) to get the final
     //delay to reach the sink.
 
     t_physical_tile_type_ptr tile_type = device_ctx.grid.get_physical_type({rr_graph.node_xlow(from_node),
@@ -119,7 +121,7 @@ std::pair<float, float> ExtendedMapLookahead::get_src_opin_cost(RRNodeId from_no
             } else {
                 //For an actual accessible wire, we query the wire look-up to get it's
                 //delay and congestion cost estimates
-                cost_entry = cost_map_.find_cost(reachable_wire_inf.wire_seg_index, delta_x, delta_y);
+                cost_entry = find_cost(reachable_wire_inf.wire_seg_index, delta_x, delta_y);
             }
 
             float this_delay_cost = (1. - params.criticality) * (reachable_wire_inf.delay + cost_entry.delay);
@@ -205,7 +207,7 @@ std::pair<float, float> ExtendedMapLookahead::get_expected_delay_and_cong(RRNode
     }
 
     int from_seg_index = cost_map_.node_to_segment(size_t(from_node));
-    util::Cost_Entry cost_entry = cost_map_.find_cost(from_seg_index, dx, dy);
+    util::Cost_Entry cost_entry = find_cost(from_seg_index, dx, dy);
 
     if (!cost_entry.valid()) {
         // there is no route
@@ -272,7 +274,7 @@ template<typename Entry>
 bool ExtendedMapLookahead::add_paths(RRNodeId start_node,
                                      Entry current,
                                      const std::vector<util::Search_Path>& paths,
-                                     util::RoutingCosts* routing_costs) {
+                                     util::RoutingCosts* routing_costs) const {
     auto& device_ctx = g_vpr_ctx.device();
     auto& rr_graph = device_ctx.rr_graph;
 
@@ -367,7 +369,7 @@ template<typename Entry>
 std::pair<float, int> ExtendedMapLookahead::run_dijkstra(RRNodeId start_node,
                                                          std::vector<bool>* node_expanded,
                                                          std::vector<util::Search_Path>* paths,
-                                                         util::RoutingCosts* routing_costs) {
+                                                         util::RoutingCosts* routing_costs) const {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
     int path_count = 0;
@@ -422,18 +424,76 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
 
     this->chan_ipins_delays = util::compute_router_chan_ipin_lookahead(route_verbosity_);
 
-    vtr::ScopedStartFinishTimer timer("Computing connection box lookahead map");
-
     size_t num_segments = segment_inf.size();
     std::vector<SampleRegion> sample_regions = find_sample_regions(num_segments);
 
     /* free previous delay map and allocate new one */
-    auto& device_ctx = g_vpr_ctx.device();
     cost_map_.set_counts(segment_inf.size());
 
     VTR_ASSERT(REPRESENTATIVE_ENTRY_METHOD == util::SMALLEST);
+
+    if (lazy_) {
+        // Only keep the sample regions of each segment type: its cost map is computed
+        // the first time the lookahead is queried for a wire of that type.
+        pending_sample_regions_.assign(num_segments, std::vector<SampleRegion>());
+        for (SampleRegion& region : sample_regions) {
+            pending_sample_regions_[region.segment_type].push_back(std::move(region));
+        }
+        segment_filled_ = std::make_unique<std::once_flag[]>(num_segments);
+
+        VTR_LOG("Connection box lookahead map of %zu segment types will be computed on demand\n", num_segments);
+        return;
+    }
+
+    pending_sample_regions_.clear();
+    segment_filled_.reset();
+
+    vtr::ScopedStartFinishTimer timer("Computing connection box lookahead map");
+
     util::RoutingCosts all_delay_costs;
     util::RoutingCosts all_base_costs;
+    expand_sample_regions(sample_regions, &all_delay_costs, &all_base_costs);
+
+    VTR_LOG("Combining results\n");
+    /* boil down the cost list in routing_cost_map at each coordinate to a
+     * representative cost entry and store it in the lookahead cost map */
+    cost_map_.set_cost_map(all_delay_costs, all_base_costs);
+
+// diagnostics
+#if defined(CONNECTION_BOX_LOOKAHEAD_MAP_PRINT_COST_ENTRIES)
+    for (auto& cost : all_costs) {
+        const auto& key = cost.first;
+        const auto& val = cost.second;
+        VTR_LOG("%d -> %d (%d, %d): %g, %g\n",
+                val.from_node, val.to_node,
+                key.delta.x(), key.delta.y(),
+                val.cost_entry.delay, val.cost_entry.congestion);
+    }
+#endif
+
+#if defined(CONNECTION_BOX_LOOKAHEAD_MAP_PRINT_COST_MAPS)
+    for (int iseg = 0; iseg < (ssize_t)num_segments; iseg++) {
+        VTR_LOG("cost map for %s(%d)\n",
+                segment_inf[iseg].name.c_str(), iseg);
+        cost_map_.print(iseg);
+    }
+#endif
+
+#if defined(CONNECTION_BOX_LOOKAHEAD_MAP_PRINT_EMPTY_MAPS)
+    for (std::pair<int, int> p : cost_map_.list_empty()) {
+        int ichan, iseg;
+        std::tie(ichan, iseg) = p;
+        VTR_LOG("cost map for %s(%d), chan %d EMPTY\n",
+                segment_inf[iseg].name.c_str(), iseg, box_id);
+    }
+#endif
+}
+
+void ExtendedMapLookahead::expand_sample_regions(const std::vector<SampleRegion>& sample_regions,
+                                                 util::RoutingCosts* all_delay_costs,
+                                                 util::RoutingCosts* all_base_costs) const {
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
 
     /* run Dijkstra's algorithm for each segment type & channel type combination */
 #if defined(VPR_USE_TBB) // Run in parallel
@@ -442,12 +502,14 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
 #else // Run serially
     for (const auto& region : sample_regions) {
 #endif
+        const std::string& segment_name = rr_graph.rr_segments(RRSegmentId(region.segment_type)).name;
+
         // holds the cost entries for a run
         util::RoutingCosts delay_costs;
         util::RoutingCosts base_costs;
         int total_path_count = 0;
-        std::vector<bool> node_expanded(device_ctx.rr_graph.num_nodes());
-        std::vector<util::Search_Path> paths(device_ctx.rr_graph.num_nodes());
+        std::vector<bool> node_expanded(rr_graph.num_nodes());
+        std::vector<util::Search_Path> paths(rr_graph.num_nodes());
 
         // Each point in a sample region contains a set of nodes. Each node becomes a starting node
         // for the dijkstra expansions, and different paths are explored to reach different locations.
@@ -482,7 +544,7 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
 
             if (path_count > 0) {
                 VTR_LOG("Expanded %d paths of segment type %s(%d) starting at (%d, %d) from %d segments, max_cost %e %e (%g paths/sec)\n",
-                        path_count, segment_inf[region.segment_type].name.c_str(), region.segment_type,
+                        path_count, segment_name.c_str(), region.segment_type,
                         point.location.x(), point.location.y(),
                         (int)point.nodes.size(),
                         max_delay_cost, max_base_cost,
@@ -508,13 +570,13 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
 
         if (total_path_count == 0) {
             VTR_LOG_WARN("No paths found for sample region %s(%d, %d)\n",
-                         segment_inf[region.segment_type].name.c_str(), region.grid_location.x(), region.grid_location.y());
+                         segment_name.c_str(), region.grid_location.x(), region.grid_location.y());
         }
 
         // combine the cost map from this run with the final cost maps for each segment
         for (const auto& cost : delay_costs) {
             const auto& val = cost.second;
-            auto result = all_delay_costs.insert(std::make_pair(cost.first, val));
+            auto result = all_delay_costs->insert(std::make_pair(cost.first, val));
             if (!result.second) {
                 // implements REPRESENTATIVE_ENTRY_METHOD == SMALLEST
                 result.first->second = std::min(result.first->second, val);
@@ -522,7 +584,7 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
         }
         for (const auto& cost : base_costs) {
             const auto& val = cost.second;
-            auto result = all_base_costs.insert(std::make_pair(cost.first, val));
+            auto result = all_base_costs->insert(std::make_pair(cost.first, val));
             if (!result.second) {
                 // implements REPRESENTATIVE_ENTRY_METHOD == SMALLEST
                 result.first->second = std::min(result.first->second, val);
@@ -535,40 +597,59 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
 #else
     }
 #endif
+}
 
-    VTR_LOG("Combining results\n");
-    /* boil down the cost list in routing_cost_map at each coordinate to a
-     * representative cost entry and store it in the lookahead cost map */
-    cost_map_.set_cost_map(all_delay_costs, all_base_costs);
-
-// diagnostics
-#if defined(CONNECTION_BOX_LOOKAHEAD_MAP_PRINT_COST_ENTRIES)
-    for (auto& cost : all_costs) {
-        const auto& key = cost.first;
-        const auto& val = cost.second;
-        VTR_LOG("%d -> %d (%d, %d): %g, %g\n",
-                val.from_node, val.to_node,
-                key.delta.x(), key.delta.y(),
-                val.cost_entry.delay, val.cost_entry.congestion);
+util::Cost_Entry ExtendedMapLookahead::find_cost(int from_seg_index, int delta_x, int delta_y) const {
+    if (segment_filled_) {
+        // Threads querying a segment type which is being filled wait for it to be done
+        std::call_once(segment_filled_[from_seg_index], [&]() {
+            fill_segment_cost_map(from_seg_index);
+        });
     }
+    return cost_map_.find_cost(from_seg_index, delta_x, delta_y);
+}
+
+void ExtendedMapLookahead::fill_segment_cost_map(int seg_index) const {
+    const std::string& segment_name = g_vpr_ctx.device().rr_graph.rr_segments(RRSegmentId(seg_index)).name;
+    vtr::ScopedStartFinishTimer timer(vtr::string_fmt("Computing connection box lookahead map of segment type %s(%d)",
+                                                      segment_name.c_str(), seg_index));
+
+    // Only the sample regions of this segment type are expanded, so the entries of this cost map don't
+    // depend on which other segment types were filled before it. They can however be slightly more
+    // pessimistic than the ones of a full computation, which also keeps the costs found along paths
+    // started from the other segment types.
+    util::RoutingCosts delay_costs;
+    util::RoutingCosts base_costs;
+#if defined(VPR_USE_TBB)
+    // This may run inside a task of the parallel router: isolate the expansions, so that a
+    // thread waiting for them doesn't pick up a router task which queries this same segment type.
+    tbb::this_task_arena::isolate([&]() {
+        expand_sample_regions(pending_sample_regions_[seg_index], &delay_costs, &base_costs);
+    });
+#else
+    expand_sample_regions(pending_sample_regions_[seg_index], &delay_costs, &base_costs);
 #endif
 
+    cost_map_.set_segment_cost_map(seg_index, delay_costs, base_costs);
+
+    // The sample regions are no longer needed
+    std::vector<SampleRegion>().swap(pending_sample_regions_[seg_index]);
+
 #if defined(CONNECTION_BOX_LOOKAHEAD_MAP_PRINT_COST_MAPS)
-    for (int iseg = 0; iseg < (ssize_t)num_segments; iseg++) {
-        VTR_LOG("cost map for %s(%d)\n",
-                segment_inf[iseg].name.c_str(), iseg);
-        cost_map_.print(iseg);
-    }
+    VTR_LOG("cost map for %s(%d)\n", segment_name.c_str(), seg_index);
+    cost_map_.print(seg_index);
 #endif
+}
 
-#if defined(CONNECTION_BOX_LOOKAHEAD_MAP_PRINT_EMPTY_MAPS)
-    for (std::pair<int, int> p : cost_map_.list_empty()) {
-        int ichan, iseg;
-        std::tie(ichan, iseg) = p;
-        VTR_LOG("cost map for %s(%d), chan %d EMPTY\n",
-                segment_inf[iseg].name.c_str(), iseg, box_id);
+void ExtendedMapLookahead::fill_all_segment_cost_maps() const {
+    if (!segment_filled_) {
+        return;
+    }
+    for (size_t iseg = 0; iseg < pending_sample_regions_.size(); iseg++) {
+        std::call_once(segment_filled_[iseg], [&]() {
+            fill_segment_cost_map(iseg);
+        });
     }
-#endif
 }
 
 // get an expected minimum cost for routing from the current node to the target node
@@ -600,6 +681,8 @@ float ExtendedMapLookahead::get_expected_cost(
 void ExtendedMapLookahead::read(const std::string& file) {
 #ifndef VTR_ENABLE_CAPNPROTO
     cost_map_.read(file);
+    pending_sample_regions_.clear();
+    segment_filled_.reset();
 
     this->src_opin_delays = util::compute_router_src_opin_lookahead(is_flat_, route_verbosity_);
 
@@ -612,6 +695,7 @@ void ExtendedMapLookahead::read(const std::string& file) {
 
 void ExtendedMapLookahead::write(const std::string& file) const {
 #ifndef VTR_ENABLE_CAPNPROTO
+    fill_all_segment_cost_maps();
     cost_map_.write(file);
 #else  // VTR_ENABLE_CAPNPROTO
     (void)file;
@@ -1,21 +1,32 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <vector>
 #include "physical_types.h"
 #include "router_lookahead.h"
 #include "router_lookahead_map_utils.h"
 #include "router_lookahead_cost_map.h"
-
-// Implementation of RouterLookahead based on source segment and destination connection box types
+#include "router_lookahead_sampling.h"
+
+/**
+ * @brief Implementation of RouterLookahead based on source segment and destination connection box types
+ *
+ * In lazy mode, compute() only finds the sample regions: the cost map of a segment type is computed
+ * the first time the lookahead is queried for a wire of that type. Each segment type is filled exactly
+ * once, even if the router queries the lookahead from several threads.
+ */
 class ExtendedMapLookahead : public RouterLookahead {
   public:
-    ExtendedMapLookahead(bool is_flat, int route_verbosity)
+    ExtendedMapLookahead(bool is_flat, int route_verbosity, bool lazy = false)
         : is_flat_(is_flat)
-        , route_verbosity_(route_verbosity) {}
+        , route_verbosity_(route_verbosity)
+        , lazy_(lazy) {}
 
   private:
     bool is_flat_;
     int route_verbosity_;
+    bool lazy_;
     ///<Look-up table from SOURCE/OPIN to CHANX/CHANY of various types
     util::t_src_opin_delays src_opin_delays;
 
@@ -51,15 +62,44 @@ class ExtendedMapLookahead : public RouterLookahead {
     bool add_paths(RRNodeId start_node,
                    Entry current,
                    const std::vector<util::Search_Path>& paths,
-                   util::RoutingCosts* routing_costs);
+                   util::RoutingCosts* routing_costs) const;
 
     template<typename Entry>
     std::pair<float, int> run_dijkstra(RRNodeId start_node,
                                        std::vector<bool>* node_expanded,
                                        std::vector<util::Search_Path>* paths,
-                                       util::RoutingCosts* routing_costs);
+                                       util::RoutingCosts* routing_costs) const;
+
+    /**
+     * @brief Runs the dijkstra expansions from the given sample regions and merges the costs found
+     *        (keeping the smallest cost of each segment type and delta) into all_delay_costs and all_base_costs.
+     */
+    void expand_sample_regions(const std::vector<SampleRegion>& sample_regions,
+                               util::RoutingCosts* all_delay_costs,
+                               util::RoutingCosts* all_base_costs) const;
+
+    /**
+     * @brief Returns the cost map entry of a segment type at the given deltas, computing the
+     *        cost map of that segment type first if it is still pending (lazy mode).
+     */
+    util::Cost_Entry find_cost(int from_seg_index, int delta_x, int delta_y) const;
 
-    CostMap cost_map_; ///<Cost map containing all data to extract the entry cost when querying the lookahead.
+    /// @brief Computes the cost map of a segment type whose computation was deferred (lazy mode).
+    void fill_segment_cost_map(int seg_index) const;
+
+    /// @brief Computes the cost maps of all segment types whose computation was deferred (lazy mode).
+    void fill_all_segment_cost_maps() const;
+
+    ///<Cost map containing all data to extract the entry cost when querying the lookahead.
+    ///<Mutable since, in lazy mode, the cost maps of the segment types are filled when first queried.
+    mutable CostMap cost_map_;
+
+    ///<Lazy mode: sample regions of each segment type whose cost map is still pending, indexed by segment type
+    mutable std::vector<std::vector<SampleRegion>> pending_sample_regions_;
+
+    ///<Lazy mode: set once the cost map of a segment type has been filled, indexed by segment type.
+    ///<Null when all cost maps are already filled.
+    std::unique_ptr<std::once_flag[]> segment_filled_;
   public:
     /**
      * @brief Returns the expected cost to get to a destination node
@@ -107,4 +147,10 @@ class ExtendedMapLookahead : public RouterLookahead {
     float get_opin_distance_min_delay(int /*physical_tile_idx*/, int /*from_layer*/, int /*to_layer*/, int /*dx*/, int /*dy*/) const override {
         return -1.;
     }
+
+    bool is_cost_cacheable() const override { return true; }
+
+    size_t memory_used() const override {
+        return cost_map_.memory_used();
+    }
 };
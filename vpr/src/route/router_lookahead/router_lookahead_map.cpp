@@ -36,6 +36,10 @@
 #include "router_lookahead_map_utils.h"
 #include "rr_graph.h"
 
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for_each.h>
+#endif
+
 #ifdef VTR_ENABLE_CAPNPROTO
 #include "capnp/serialize.h"
 #include "map_lookahead.capnp.h"
@@ -58,25 +62,22 @@ enum e_representative_entry_method {
     MEDIAN
 };
 
-/******** File-Scope Variables ********/
-
-//Look-up table from CHANX/CHANY (to SINKs) for various distances
-t_wire_cost_map f_wire_cost_map;
-
 /******** File-Scope Functions ********/
 
-/***
- * @brief Fill f_wire_cost_map. It is a look-up table from CHANX/CHANY (to SINKs) for various distances
- * @param segment_inf
- */
-static util::Cost_Entry get_wire_cost_entry(e_rr_type rr_type,
+///@brief Returns the entry of wire_cost_map for a wire of the given type and segment, to go delta_x, delta_y further on to_layer_num
+static util::Cost_Entry get_wire_cost_entry(const t_wire_cost_map& wire_cost_map,
+                                            e_rr_type rr_type,
                                             int seg_index,
                                             int from_layer_num,
                                             int delta_x,
                                             int delta_y,
                                             int to_layer_num);
 
-static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segment_inf, int route_verbosity);
+/***
+ * @brief Fill wire_cost_map. It is a look-up table from CHANX/CHANY (to SINKs) for various distances
+ * @param segment_inf
+ */
+static void compute_router_wire_lookahead(t_wire_cost_map& wire_cost_map, const std::vector<t_segment_inf>& segment_inf, int route_verbosity);
 
 /***
  * @brief Compute the cost from pin to sinks of tiles - Compute the minimum cost to get to each tile sink from pins on the cluster
@@ -112,10 +113,10 @@ static void store_min_cost_to_sinks(std::unordered_map<int, std::unordered_map<i
                                     const std::unordered_map<int, util::t_ipin_primitive_sink_delays>& intra_tile_pin_primitive_pin_delay);
 
 /**
- * @brief Iterate over the first (channel type) and second (segment type) dimensions of f_wire_cost_map to get the minimum cost for each dx and dy_
+ * @brief Iterate over the first (channel type) and second (segment type) dimensions of wire_cost_map to get the minimum cost for each dx and dy_
  * @param internal_opin_global_cost_map This map is populated in this function. [dx][dy] -> cost
  */
-static void min_chann_global_cost_map(vtr::NdMatrix<util::Cost_Entry, 4>& distance_min_cost);
+static void min_chann_global_cost_map(const t_wire_cost_map& wire_cost_map, vtr::NdMatrix<util::Cost_Entry, 4>& distance_min_cost);
 
 /**
  * @brief // Given the src/opin map of each physical tile type, iterate over all OPINs/sources of a type and create
@@ -123,7 +124,7 @@ static void min_chann_global_cost_map(vtr::NdMatrix<util::Cost_Entry, 4>& distan
  * @param src_opin_delays
  * @param distance_min_cost
  */
-static void min_opin_distance_cost_map(const util::t_src_opin_delays& src_opin_delays, vtr::NdMatrix<util::Cost_Entry, 5>& distance_min_cost);
+static void min_opin_distance_cost_map(const t_wire_cost_map& wire_cost_map, const util::t_src_opin_delays& src_opin_delays, vtr::NdMatrix<util::Cost_Entry, 5>& distance_min_cost);
 
 // Read the file and fill intra_tile_pin_primitive_pin_delay and tile_min_cost
 static void read_intra_cluster_router_lookahead(std::unordered_map<int, util::t_ipin_primitive_sink_delays>& intra_tile_pin_primitive_pin_delay,
@@ -134,16 +135,17 @@ static void write_intra_cluster_router_lookahead(const std::string& file,
                                                  const std::unordered_map<int, util::t_ipin_primitive_sink_delays>& intra_tile_pin_primitive_pin_delay);
 
 ///@brief Sets the lookahead cost map entries based on representative cost entries from routing_cost_map.
-static void set_lookahead_map_costs(unsigned from_layer_num,
+static void set_lookahead_map_costs(t_wire_cost_map& wire_cost_map,
+                                    unsigned from_layer_num,
                                     int segment_index,
                                     e_rr_type chan_type,
                                     util::t_routing_cost_map& routing_cost_map);
 
 /* fills in missing lookahead map entries by copying the cost of the closest valid entry */
-static void fill_in_missing_lookahead_entries(int segment_index, e_rr_type chan_type);
+static void fill_in_missing_lookahead_entries(t_wire_cost_map& wire_cost_map, int segment_index, e_rr_type chan_type);
 
-/* returns a cost entry in the f_wire_cost_map that is near the specified coordinates (and preferably towards (0,0)) */
-static util::Cost_Entry get_nearby_cost_entry(int from_layer_num, int x, int y, int to_layer_num, int segment_index, int chan_index);
+/* returns a cost entry in the wire_cost_map that is near the specified coordinates (and preferably towards (0,0)) */
+static util::Cost_Entry get_nearby_cost_entry(const t_wire_cost_map& wire_cost_map, int from_layer_num, int x, int y, int to_layer_num, int segment_index, int chan_index);
 
 /**
  * @brief Fill in the missing entry in router lookahead map
@@ -157,7 +159,8 @@ static util::Cost_Entry get_nearby_cost_entry(int from_layer_num, int x, int y,
  * @param chan_index The channel index of the source node
  * @return The cost for the missing entry
  */
-static util::Cost_Entry get_nearby_cost_entry_average_neighbour(int from_layer_num,
+static util::Cost_Entry get_nearby_cost_entry_average_neighbour(const t_wire_cost_map& wire_cost_map,
+                                                                int from_layer_num,
                                                                 int missing_dx,
                                                                 int missing_dy,
                                                                 int to_layer_num,
@@ -323,7 +326,7 @@ std::pair<float, float> MapLookahead::get_expected_delay_and_cong(RRNodeId from_
     if (from_type == e_rr_type::SOURCE || from_type == e_rr_type::OPIN) {
         //When estimating costs from a SOURCE/OPIN we look-up to find which wire types (and the
         //cost to reach them) in src_opin_delays. Once we know what wire types are
-        //reachable, we query the f_wire_cost_map (i.e. the wire lookahead) to get the final
+        //reachable, we query wire_cost_map_ (i.e. the wire lookahead) to get the final
         //delay to reach the sink.
 
         t_physical_tile_type_ptr from_tile_type = device_ctx.grid.get_physical_type({rr_graph.node_xlow(from_node),
@@ -343,7 +346,9 @@ std::pair<float, float> MapLookahead::get_expected_delay_and_cong(RRNodeId from_
                                                                                         delta_x,
                                                                                         delta_y,
                                                                                         to_layer_num,
-                                                                                        get_wire_cost_entry);
+                                                                                        [this](e_rr_type rr_type, int seg_index, int from_layer, int dx, int dy, int to_layer) {
+                                                                                            return get_wire_cost_entry(wire_cost_map_, rr_type, seg_index, from_layer, dx, dy, to_layer);
+                                                                                        });
             expected_delay_cost = std::min(expected_delay_cost, this_delay_cost);
             expected_cong_cost = std::min(expected_cong_cost, this_cong_cost);
         }
@@ -363,7 +368,7 @@ std::pair<float, float> MapLookahead::get_expected_delay_and_cong(RRNodeId from_
                                 .c_str());
 
     } else if (from_type == e_rr_type::CHANX || from_type == e_rr_type::CHANY || from_type == e_rr_type::CHANZ) {
-        // When estimating costs from a wire, we directly look-up the result in the wire lookahead (f_wire_cost_map)
+        // When estimating costs from a wire, we directly look-up the result in the wire lookahead (wire_cost_map_)
 
         // For CHANZ nodes, if the direction is
         // 1) incremental --> `chanz_node` now drives other nodes on node_layer_high(chanz_node).
@@ -384,7 +389,8 @@ std::pair<float, float> MapLookahead::get_expected_delay_and_cong(RRNodeId from_
         VTR_ASSERT(from_seg_index >= 0);
 
         // Now get the expected cost from our lookahead map
-        util::Cost_Entry cost_entry = get_wire_cost_entry(from_type,
+        util::Cost_Entry cost_entry = get_wire_cost_entry(wire_cost_map_,
+                                                          from_type,
                                                           from_seg_index,
                                                           from_layer_num,
                                                           delta_x,
@@ -419,14 +425,14 @@ void MapLookahead::compute(const std::vector<t_segment_inf>& segment_inf) {
 
     // First compute the delay map when starting from the various wire types
     // (CHANX/CHANY/CHANZ) in the routing architecture
-    compute_router_wire_lookahead(segment_inf, route_verbosity_);
+    compute_router_wire_lookahead(wire_cost_map_, segment_inf, route_verbosity_);
 
     //Next, compute which wire types are accessible (and the cost to reach them)
     //from the different physical tile type's SOURCEs & OPINs
     this->src_opin_delays = util::compute_router_src_opin_lookahead(is_flat_, route_verbosity_);
 
-    min_chann_global_cost_map(chann_distance_based_min_cost);
-    min_opin_distance_cost_map(src_opin_delays, opin_distance_based_min_cost);
+    min_chann_global_cost_map(wire_cost_map_, chann_distance_based_min_cost);
+    min_opin_distance_cost_map(wire_cost_map_, src_opin_delays, opin_distance_based_min_cost);
 }
 
 void MapLookahead::compute_intra_tile() {
@@ -442,21 +448,21 @@ void MapLookahead::compute_intra_tile() {
 }
 
 void MapLookahead::read(const std::string& file) {
-    read_router_lookahead(file);
+    read_router_lookahead(file, wire_cost_map_);
 
     //Next, compute which wire types are accessible (and the cost to reach them)
     //from the different physical tile type's SOURCEs & OPINs
     this->src_opin_delays = util::compute_router_src_opin_lookahead(is_flat_, route_verbosity_);
 
-    min_chann_global_cost_map(chann_distance_based_min_cost);
-    min_opin_distance_cost_map(src_opin_delays, opin_distance_based_min_cost);
+    min_chann_global_cost_map(wire_cost_map_, chann_distance_based_min_cost);
+    min_opin_distance_cost_map(wire_cost_map_, src_opin_delays, opin_distance_based_min_cost);
 }
 
 void MapLookahead::read_intra_cluster(const std::string& file) {
     vtr::ScopedStartFinishTimer timer("Loading router intra cluster lookahead map");
     is_flat_ = true;
     // Maps related to global resources should not be empty
-    VTR_ASSERT(!f_wire_cost_map.empty());
+    VTR_ASSERT(!wire_cost_map_.empty());
     read_intra_cluster_router_lookahead(intra_tile_pin_primitive_pin_delay,
                                         file);
 
@@ -473,14 +479,17 @@ void MapLookahead::read_intra_cluster(const std::string& file) {
 
 void MapLookahead::write(const std::string& file_name) const {
     if (vtr::check_file_name_extension(file_name, ".csv")) {
-        std::vector<int> wire_cost_map_size(f_wire_cost_map.ndims());
-        for (size_t i = 0; i < f_wire_cost_map.ndims(); ++i) {
-            wire_cost_map_size[i] = static_cast<int>(f_wire_cost_map.dim_size(i));
+        std::vector<int> wire_cost_map_size(wire_cost_map_.ndims());
+        for (size_t i = 0; i < wire_cost_map_.ndims(); ++i) {
+            wire_cost_map_size[i] = static_cast<int>(wire_cost_map_.dim_size(i));
         }
-        dump_readable_router_lookahead_map(file_name, wire_cost_map_size, get_wire_cost_entry);
+        util::dump_readable_router_lookahead_map(file_name, wire_cost_map_size,
+                                                 [this](e_rr_type rr_type, int seg_index, int from_layer, int dx, int dy, int to_layer) {
+                                                     return get_wire_cost_entry(wire_cost_map_, rr_type, seg_index, from_layer, dx, dy, to_layer);
+                                                 });
     } else {
         VTR_ASSERT(vtr::check_file_name_extension(file_name, ".capnp") || vtr::check_file_name_extension(file_name, ".bin"));
-        write_router_lookahead(file_name);
+        write_router_lookahead(file_name, wire_cost_map_);
     }
 }
 
@@ -493,21 +502,26 @@ float MapLookahead::get_opin_distance_min_delay(int physical_tile_idx, int from_
     return opin_distance_based_min_cost[physical_tile_idx][from_layer][to_layer][dx][dy].delay;
 }
 
+size_t MapLookahead::memory_used() const {
+    return (wire_cost_map_.size() + chann_distance_based_min_cost.size() + opin_distance_based_min_cost.size()) * sizeof(util::Cost_Entry);
+}
+
 /******** Function Definitions ********/
 
-static util::Cost_Entry get_wire_cost_entry(e_rr_type rr_type, int seg_index, int from_layer_num, int delta_x, int delta_y, int to_layer_num) {
+static util::Cost_Entry get_wire_cost_entry(const t_wire_cost_map& wire_cost_map, e_rr_type rr_type, int seg_index, int from_layer_num, int delta_x, int delta_y, int to_layer_num) {
     VTR_ASSERT_SAFE(rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY || rr_type == e_rr_type::CHANZ);
-    VTR_ASSERT_SAFE(from_layer_num < static_cast<int>(f_wire_cost_map.dim_size(0)));
-    VTR_ASSERT_SAFE(to_layer_num < static_cast<int>(f_wire_cost_map.dim_size(1)));
-    VTR_ASSERT_SAFE(seg_index < static_cast<int>(f_wire_cost_map.dim_size(3)));
-    VTR_ASSERT_SAFE(delta_x < static_cast<int>(f_wire_cost_map.dim_size(4)));
-    VTR_ASSERT_SAFE(delta_y < static_cast<int>(f_wire_cost_map.dim_size(5)));
+    VTR_ASSERT_SAFE(from_layer_num < static_cast<int>(wire_cost_map.dim_size(0)));
+    VTR_ASSERT_SAFE(to_layer_num < static_cast<int>(wire_cost_map.dim_size(1)));
+    VTR_ASSERT_SAFE(seg_index < static_cast<int>(wire_cost_map.dim_size(3)));
+    VTR_ASSERT_SAFE(delta_x < static_cast<int>(wire_cost_map.dim_size(4)));
+    VTR_ASSERT_SAFE(delta_y < static_cast<int>(wire_cost_map.dim_size(5)));
 
     const int chan_index = util::chan_type_to_index(rr_type);
-    return f_wire_cost_map[from_layer_num][to_layer_num][chan_index][seg_index][delta_x][delta_y];
+    return wire_cost_map[from_layer_num][to_layer_num][chan_index][seg_index][delta_x][delta_y];
 }
 
-static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segment_inf_vec,
+static void compute_router_wire_lookahead(t_wire_cost_map& wire_cost_map,
+                                          const std::vector<t_segment_inf>& segment_inf_vec,
                                           int route_verbosity) {
     vtr::ScopedStartFinishTimer timer("Computing wire lookahead");
 
@@ -523,7 +537,7 @@ static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segm
     const size_t chan_type_dim_size = (num_layers == 1) ? 2 : 3;
 
     //Re-allocate
-    f_wire_cost_map = t_wire_cost_map({num_layers,
+    wire_cost_map = t_wire_cost_map({num_layers,
                                        num_layers,
                                        chan_type_dim_size,
                                        segment_inf_vec.size(),
@@ -537,6 +551,10 @@ static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segm
 
     // Profile each wire segment type
     for (size_t from_layer_num = 0; from_layer_num < num_layers; from_layer_num++) {
+        // Each (segment, channel type) pair is profiled independently and only touches its own
+        // [chan_index][seg_index] slice of wire_cost_map, so they can be computed in parallel.
+        // Layers are kept in order: filling in missing entries looks at every from_layer.
+        std::vector<std::pair<const t_segment_inf*, e_rr_type>> profile_tasks;
         for (const t_segment_inf& segment_inf : segment_inf_vec) {
             std::vector<e_rr_type> chan_types;
             if (segment_inf.parallel_axis == e_parallel_axis::X_AXIS) {
@@ -552,30 +570,43 @@ static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segm
             }
 
             for (e_rr_type chan_type : chan_types) {
-                util::t_routing_cost_map routing_cost_map = util::get_routing_cost_map(longest_seg_length,
-                                                                                       from_layer_num,
-                                                                                       chan_type,
-                                                                                       segment_inf,
-                                                                                       std::unordered_map<int, std::unordered_set<int>>(),
-                                                                                       /*sample_all_locs=*/true,
-                                                                                       route_verbosity);
-                if (routing_cost_map.empty()) {
-                    continue;
-                }
-
-                // boil down the cost list in routing_cost_map at each coordinate to a representative cost entry
-                // and store it in the lookahead cost map
-                set_lookahead_map_costs(from_layer_num, segment_inf.seg_index, chan_type, routing_cost_map);
-
-                // Fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
-                // a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed)
-                fill_in_missing_lookahead_entries(segment_inf.seg_index, chan_type);
+                profile_tasks.emplace_back(&segment_inf, chan_type);
             }
         }
+
+        auto profile_segment = [&](const std::pair<const t_segment_inf*, e_rr_type>& task) {
+            const t_segment_inf& segment_inf = *task.first;
+            e_rr_type chan_type = task.second;
+            util::t_routing_cost_map routing_cost_map = util::get_routing_cost_map(longest_seg_length,
+                                                                                   from_layer_num,
+                                                                                   chan_type,
+                                                                                   segment_inf,
+                                                                                   std::unordered_map<int, std::unordered_set<int>>(),
+                                                                                   /*sample_all_locs=*/true,
+                                                                                   route_verbosity);
+            if (routing_cost_map.empty()) {
+                return;
+            }
+
+            // boil down the cost list in routing_cost_map at each coordinate to a representative cost entry
+            // and store it in the lookahead cost map
+            set_lookahead_map_costs(wire_cost_map, from_layer_num, segment_inf.seg_index, chan_type, routing_cost_map);
+
+            // Fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
+            // a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed)
+            fill_in_missing_lookahead_entries(wire_cost_map, segment_inf.seg_index, chan_type);
+        };
+
+#if defined(VPR_USE_TBB)
+        tbb::parallel_for_each(profile_tasks.begin(), profile_tasks.end(), profile_segment);
+#else
+        std::for_each(profile_tasks.begin(), profile_tasks.end(), profile_segment);
+#endif
     }
 }
 
-static void set_lookahead_map_costs(unsigned from_layer_num,
+static void set_lookahead_map_costs(t_wire_cost_map& wire_cost_map,
+                                    unsigned from_layer_num,
                                     int segment_index,
                                     e_rr_type chan_type,
                                     util::t_routing_cost_map& routing_cost_map) {
@@ -587,13 +618,13 @@ static void set_lookahead_map_costs(unsigned from_layer_num,
             for (unsigned iy = 0; iy < routing_cost_map.dim_size(2); iy++) {
                 util::Expansion_Cost_Entry& expansion_cost_entry = routing_cost_map[to_layer][ix][iy];
 
-                f_wire_cost_map[from_layer_num][to_layer][chan_index][segment_index][ix][iy] = expansion_cost_entry.get_representative_cost_entry(util::e_representative_entry_method::SMALLEST);
+                wire_cost_map[from_layer_num][to_layer][chan_index][segment_index][ix][iy] = expansion_cost_entry.get_representative_cost_entry(util::e_representative_entry_method::SMALLEST);
             }
         }
     }
 }
 
-static void fill_in_missing_lookahead_entries(int segment_index, e_rr_type chan_type) {
+static void fill_in_missing_lookahead_entries(t_wire_cost_map& wire_cost_map, int segment_index, e_rr_type chan_type) {
     const DeviceContext& device_ctx = g_vpr_ctx.device();
 
     const int chan_index = util::chan_type_to_index(chan_type);
@@ -607,16 +638,17 @@ static void fill_in_missing_lookahead_entries(int segment_index, e_rr_type chan_
         for (int to_layer_num = 0; to_layer_num < num_layers; ++to_layer_num) {
             for (int ix = 0; ix < grid_width; ix++) {
                 for (int iy = 0; iy < grid_height; iy++) {
-                    util::Cost_Entry cost_entry = f_wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][ix][iy];
+                    util::Cost_Entry cost_entry = wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][ix][iy];
 
                     if (std::isnan(cost_entry.delay) && std::isnan(cost_entry.congestion)) {
-                        util::Cost_Entry copied_entry = get_nearby_cost_entry_average_neighbour(from_layer_num,
+                        util::Cost_Entry copied_entry = get_nearby_cost_entry_average_neighbour(wire_cost_map,
+                                                                                                from_layer_num,
                                                                                                 ix,
                                                                                                 iy,
                                                                                                 to_layer_num,
                                                                                                 segment_index,
                                                                                                 chan_index);
-                        f_wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][ix][iy] = copied_entry;
+                        wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][ix][iy] = copied_entry;
                     }
                 }
             }
@@ -624,8 +656,8 @@ static void fill_in_missing_lookahead_entries(int segment_index, e_rr_type chan_
     }
 }
 
-/* returns a cost entry in the f_wire_cost_map that is near the specified coordinates (and preferably towards (0,0)) */
-static util::Cost_Entry get_nearby_cost_entry(int from_layer_num, int x, int y, int to_layer_num, int segment_index, int chan_index) {
+/* returns a cost entry in the wire_cost_map that is near the specified coordinates (and preferably towards (0,0)) */
+static util::Cost_Entry get_nearby_cost_entry(const t_wire_cost_map& wire_cost_map, int from_layer_num, int x, int y, int to_layer_num, int segment_index, int chan_index) {
     /* compute the slope from x,y to 0,0 and then move towards 0,0 by one unit to get the coordinates
      * of the cost entry to be copied */
 
@@ -652,7 +684,7 @@ static util::Cost_Entry get_nearby_cost_entry(int from_layer_num, int x, int y,
     copy_y = std::max(copy_y, 0); //Clip to zero
     copy_x = std::max(copy_x, 0); //Clip to zero
 
-    util::Cost_Entry copy_entry = f_wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][copy_x][copy_y];
+    util::Cost_Entry copy_entry = wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][copy_x][copy_y];
 
     /* if the entry to be copied is also empty, recurse */
     if (std::isnan(copy_entry.delay) && std::isnan(copy_entry.congestion)) {
@@ -666,22 +698,23 @@ static util::Cost_Entry get_nearby_cost_entry(int from_layer_num, int x, int y,
                 copy_entry = util::Cost_Entry(std::numeric_limits<float>::max() / 1e12, std::numeric_limits<float>::max() / 1e12);
             }
         } else {
-            copy_entry = get_nearby_cost_entry(from_layer_num, copy_x, copy_y, to_layer_num, segment_index, chan_index);
+            copy_entry = get_nearby_cost_entry(wire_cost_map, from_layer_num, copy_x, copy_y, to_layer_num, segment_index, chan_index);
         }
     }
 
     return copy_entry;
 }
 
-static util::Cost_Entry get_nearby_cost_entry_average_neighbour(int from_layer_num,
+static util::Cost_Entry get_nearby_cost_entry_average_neighbour(const t_wire_cost_map& wire_cost_map,
+                                                                int from_layer_num,
                                                                 int missing_dx,
                                                                 int missing_dy,
                                                                 int to_layer_num,
                                                                 int segment_index,
                                                                 int chan_index) {
     // Make sure that the given location doesn't have a valid entry
-    VTR_ASSERT(std::isnan(f_wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][missing_dx][missing_dy].delay));
-    VTR_ASSERT(std::isnan(f_wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][missing_dx][missing_dy].congestion));
+    VTR_ASSERT(std::isnan(wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][missing_dx][missing_dy].delay));
+    VTR_ASSERT(std::isnan(wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][missing_dx][missing_dy].congestion));
 
     int neighbour_num = 0;                  // Number of neighbours with valid entry
     float neighbour_delay_sum = 0;          // Acc of valid delay costs
@@ -689,15 +722,15 @@ static util::Cost_Entry get_nearby_cost_entry_average_neighbour(int from_layer_n
     std::array<int, 3> window = {-1, 0, 1}; // Average window size
     for (int dx : window) {
         int neighbour_x = missing_dx + dx;
-        if (neighbour_x < 0 || neighbour_x >= (int)f_wire_cost_map.dim_size(4)) {
+        if (neighbour_x < 0 || neighbour_x >= (int)wire_cost_map.dim_size(4)) {
             continue;
         }
         for (int dy : window) {
             int neighbour_y = missing_dy + dy;
-            if (neighbour_y < 0 || neighbour_y >= (int)f_wire_cost_map.dim_size(5)) {
+            if (neighbour_y < 0 || neighbour_y >= (int)wire_cost_map.dim_size(5)) {
                 continue;
             }
-            util::Cost_Entry copy_entry = f_wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][neighbour_x][neighbour_y];
+            util::Cost_Entry copy_entry = wire_cost_map[from_layer_num][to_layer_num][chan_index][segment_index][neighbour_x][neighbour_y];
             if (std::isnan(copy_entry.delay) || std::isnan(copy_entry.congestion)) {
                 continue;
             }
@@ -713,7 +746,7 @@ static util::Cost_Entry get_nearby_cost_entry_average_neighbour(int from_layer_n
                 neighbour_cong_sum / static_cast<float>(neighbour_num)};
     } else {
         // If there are not enough neighbours with valid entry, retrieve to the previous way of getting the missing cost
-        return get_nearby_cost_entry(from_layer_num, missing_dx, missing_dy, to_layer_num, segment_index, chan_index);
+        return get_nearby_cost_entry(wire_cost_map, from_layer_num, missing_dx, missing_dy, to_layer_num, segment_index, chan_index);
     }
 }
 
@@ -803,7 +836,7 @@ static void store_min_cost_to_sinks(std::unordered_map<int, std::unordered_map<i
     VTR_ASSERT(insert_res.second);
 }
 
-static void min_chann_global_cost_map(vtr::NdMatrix<util::Cost_Entry, 4>& distance_min_cost) {
+static void min_chann_global_cost_map(const t_wire_cost_map& wire_cost_map, vtr::NdMatrix<util::Cost_Entry, 4>& distance_min_cost) {
     int num_layers = g_vpr_ctx.device().grid.get_num_layers();
     int width = (int)g_vpr_ctx.device().grid.width();
     int height = (int)g_vpr_ctx.device().grid.height();
@@ -817,10 +850,10 @@ static void min_chann_global_cost_map(vtr::NdMatrix<util::Cost_Entry, 4>& distan
             for (int dx = 0; dx < width; dx++) {
                 for (int dy = 0; dy < height; dy++) {
                     util::Cost_Entry min_cost(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
-                    for (int chan_idx = 0; chan_idx < (int)f_wire_cost_map.dim_size(2); chan_idx++) {
-                        for (int seg_idx = 0; seg_idx < (int)f_wire_cost_map.dim_size(3); seg_idx++) {
-                            auto cost = util::Cost_Entry(f_wire_cost_map[from_layer_num][to_layer_num][chan_idx][seg_idx][dx][dy].delay,
-                                                         f_wire_cost_map[from_layer_num][to_layer_num][chan_idx][seg_idx][dx][dy].congestion);
+                    for (int chan_idx = 0; chan_idx < (int)wire_cost_map.dim_size(2); chan_idx++) {
+                        for (int seg_idx = 0; seg_idx < (int)wire_cost_map.dim_size(3); seg_idx++) {
+                            auto cost = util::Cost_Entry(wire_cost_map[from_layer_num][to_layer_num][chan_idx][seg_idx][dx][dy].delay,
+                                                         wire_cost_map[from_layer_num][to_layer_num][chan_idx][seg_idx][dx][dy].congestion);
                             if (cost.delay < min_cost.delay) {
                                 min_cost.delay = cost.delay;
                                 min_cost.congestion = cost.congestion;
@@ -834,7 +867,7 @@ static void min_chann_global_cost_map(vtr::NdMatrix<util::Cost_Entry, 4>& distan
     }
 }
 
-static void min_opin_distance_cost_map(const util::t_src_opin_delays& src_opin_delays, vtr::NdMatrix<util::Cost_Entry, 5>& distance_min_cost) {
+static void min_opin_distance_cost_map(const t_wire_cost_map& wire_cost_map, const util::t_src_opin_delays& src_opin_delays, vtr::NdMatrix<util::Cost_Entry, 5>& distance_min_cost) {
     /**
      * This function calculates and stores the minimum cost to reach a point on layer `n_sink`, which is `dx` and `dy` further from the current point
      * on layer `n_source` and is located on physical tile type `t`. To compute this cost, the function iterates over all output pins of tile `t`,
@@ -876,7 +909,8 @@ static void min_opin_distance_cost_map(const util::t_src_opin_delays& src_opin_d
                                         }
                                         util::Cost_Entry wire_cost_entry;
 
-                                        wire_cost_entry = get_wire_cost_entry(reachable_wire_inf.wire_rr_type,
+                                        wire_cost_entry = get_wire_cost_entry(wire_cost_map,
+                                                                              reachable_wire_inf.wire_rr_type,
                                                                               reachable_wire_inf.wire_seg_index,
                                                                               reachable_wire_inf.layer_number,
                                                                               dx,
@@ -918,11 +952,11 @@ static void min_opin_distance_cost_map(const util::t_src_opin_delays& src_opin_d
     "is disabled because VTR_ENABLE_CAPNPROTO=OFF." \
     "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
 
-void read_router_lookahead(const std::string& /*file*/) {
+void read_router_lookahead(const std::string& /*file*/, t_wire_cost_map& /*wire_cost_map*/) {
     VPR_THROW(VPR_ERROR_PLACE, "MapLookahead::read_router_lookahead " DISABLE_ERROR);
 }
 
-void write_router_lookahead(const std::string& /*file*/) {
+void write_router_lookahead(const std::string& /*file*/, const t_wire_cost_map& /*wire_cost_map*/) {
     VPR_THROW(VPR_ERROR_PLACE, "MapLookahead::write_router_lookahead " DISABLE_ERROR);
 }
 
@@ -943,11 +977,6 @@ static void ToCostEntry(util::Cost_Entry* out, const VprMapCostEntry::Reader& in
     out->congestion = in.getCongestion();
 }
 
-static void FromCostEntry(VprMapCostEntry::Builder* out, const util::Cost_Entry& in) {
-    out->setDelay(in.delay);
-    out->setCongestion(in.congestion);
-}
-
 static void toIntEntry(std::vector<int>& out,
                        int idx,
                        const int& cost) {
@@ -1106,26 +1135,32 @@ static void write_intra_cluster_router_lookahead(const std::string& file,
     writeMessageToFile(file, &builder);
 }
 
-void read_router_lookahead(const std::string& file) {
+void read_router_lookahead(const std::string& file, t_wire_cost_map& wire_cost_map) {
     vtr::ScopedStartFinishTimer timer("Loading router wire lookahead map");
-    MmapFile f(file);
+    auto f = std::make_shared<MmapFile>(file);
 
     /* Increase reader limit to 1G words to allow for large files. */
     ::capnp::ReaderOptions opts = default_large_capnp_opts();
-    ::capnp::FlatArrayMessageReader reader(f.getData(), opts);
+    ::capnp::FlatArrayMessageReader reader(f->getData(), opts);
 
     auto map = reader.getRoot<VprMapLookahead>();
 
-    ToNdMatrix<6, VprMapCostEntry, util::Cost_Entry>(&f_wire_cost_map, map.getCostMap(), ToCostEntry);
+    /* The cost map of newer files is used in place, keeping the file mapped: concurrent
+     * VPR processes on the same host share one copy through the page cache */
+    if (map.hasRawCostMap()) {
+        AliasNdMatrix<6, util::Cost_Entry>(&wire_cost_map, map.getRawCostMap(), f);
+    } else {
+        ToNdMatrix<6, VprMapCostEntry, util::Cost_Entry>(&wire_cost_map, map.getCostMap(), ToCostEntry);
+    }
 }
 
-void write_router_lookahead(const std::string& file) {
+void write_router_lookahead(const std::string& file, const t_wire_cost_map& wire_cost_map) {
     ::capnp::MallocMessageBuilder builder;
 
     auto map = builder.initRoot<VprMapLookahead>();
 
-    auto cost_map = map.initCostMap();
-    FromNdMatrix<6, VprMapCostEntry, util::Cost_Entry>(&cost_map, f_wire_cost_map, FromCostEntry);
+    auto cost_map = map.initRawCostMap();
+    FromNdMatrixRaw<6, util::Cost_Entry>(&cost_map, wire_cost_map);
 
     writeMessageToFile(file, &builder);
 }
@@ -5,6 +5,28 @@
 #include "router_lookahead.h"
 #include "router_lookahead_map_utils.h"
 
+/**
+ * @brief Provides delay/congestion estimates to travel specified distances
+ * in the x/y direction
+ *
+ * This is a 6D array storing the cost to travel from a node of type CHANX/CHANY/CHANZ
+ * to a point that is dx, dy further, and is on the "layer_num" layer.
+ *
+ * To store this information:
+ * - The first index is the layer number that the node under consideration is on.
+ * - The second index is the layer number of the target node.
+ * - The third index represents the type of channel (X/Y/Z) that the node under consideration belongs to.
+ * - The forth is the segment type (specified in the architecture file under the "segmentlist" tag).
+ * - The fifth is dx.
+ * - The last one is dy.
+ *
+ * @note [0..num_layers][0..num_layers][0..2][0..num_seg_types-1][0..device_ctx.grid.width()-1][0..device_ctx.grid.height()-1]
+ * - [0..2] entry distinguish between CHANX/CHANY/CHANZ start nodes respectively
+ * - The first index is the layer number that the node under consideration is on.
+ * - The second index is the layer number that the target node is on.
+ */
+typedef vtr::NdMatrix<util::Cost_Entry, 6> t_wire_cost_map;
+
 /**
  * @brief Current VPR RouterLookahead implementation.
  */
@@ -23,6 +45,9 @@ class MapLookahead : public RouterLookahead {
     // Lookup table to store the minimum cost for each dx and dy
     vtr::NdMatrix<util::Cost_Entry, 4> chann_distance_based_min_cost; // [from_layer_num][to_layer_num][dx][dy] -> cost
     vtr::NdMatrix<util::Cost_Entry, 5> opin_distance_based_min_cost;  // [physical_tile_idx][from_layer_num][to_layer_num][dx][dy] -> cost
+    // Look-up table from CHANX/CHANY/CHANZ (to SINKs) for various distances. Held by each lookahead (rather than
+    // at file scope), so that the flows running in the same process each use their own.
+    t_wire_cost_map wire_cost_map_;
 
     const t_det_routing_arch& det_routing_arch_;
     bool is_flat_;
@@ -39,29 +64,12 @@ class MapLookahead : public RouterLookahead {
     void write(const std::string& file_name) const override;
     void write_intra_cluster(const std::string& file) const override;
     float get_opin_distance_min_delay(int physical_tile_idx, int from_layer, int to_layer, int dx, int dy) const override;
+    size_t memory_used() const override;
+    bool is_cost_cacheable() const override { return true; }
 };
 
-/**
- * @brief Provides delay/congestion estimates to travel specified distances
- * in the x/y direction
- *
- * This is a 6D array storing the cost to travel from a node of type CHANX/CHANY/CHANZ
- * to a point that is dx, dy further, and is on the "layer_num" layer.
- *
- * To store this information:
- * - The first index is the layer number that the node under consideration is on.
- * - The second index is the layer number of the target node.
- * - The third index represents the type of channel (X/Y/Z) that the node under consideration belongs to.
- * - The forth is the segment type (specified in the architecture file under the "segmentlist" tag).
- * - The fifth is dx.
- * - The last one is dy.
- *
- * @note [0..num_layers][0..num_layers][0..2][0..num_seg_types-1][0..device_ctx.grid.width()-1][0..device_ctx.grid.height()-1]
- * - [0..2] entry distinguish between CHANX/CHANY/CHANZ start nodes respectively
- * - The first index is the layer number that the node under consideration is on.
- * - The second index is the layer number that the target node is on.
- */
-typedef vtr::NdMatrix<util::Cost_Entry, 6> t_wire_cost_map;
 
-void read_router_lookahead(const std::string& file);
-void write_router_lookahead(const std::string& file);
+/// @brief Reads the wire lookahead table of a MapLookahead from file into wire_cost_map
+void read_router_lookahead(const std::string& file, t_wire_cost_map& wire_cost_map);
+/// @brief Writes the wire lookahead table wire_cost_map of a MapLookahead to file
+void write_router_lookahead(const std::string& file, const t_wire_cost_map& wire_cost_map);
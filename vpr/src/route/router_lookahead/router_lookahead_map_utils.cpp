@@ -22,6 +22,11 @@
 #include "route_common.h"
 #include "route_debug.h"
 
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
 /**
  * We will profile delay/congestion using this many tracks for each wire type.
  * Larger values increase the time to compute the lookahead, but may give
@@ -819,95 +824,69 @@ t_routing_cost_map get_routing_cost_map(int longest_seg_length,
         // reset cost for this segment
         routing_cost_map.fill(Expansion_Cost_Entry());
 
-        // to avoid multiple memory allocation and de-allocations in run_dijkstra()
-        // dijkstra_data is created outside the for loop and passed by reference to dijkstra_data()
-        t_dijkstra_data dijkstra_data;
-
-        for (RRNodeId sample_node : sample_nodes) {
-            int sample_x = rr_graph.node_xlow(sample_node);
-            int sample_y = rr_graph.node_ylow(sample_node);
-
-            if (rr_graph.node_direction(sample_node) == Direction::DEC) {
-                sample_x = rr_graph.node_xhigh(sample_node);
-                sample_y = rr_graph.node_yhigh(sample_node);
-            }
-
-            run_dijkstra(sample_node,
-                         sample_x,
-                         sample_y,
-                         routing_cost_map,
-                         dijkstra_data,
-                         sample_locs,
-                         sample_all_locs);
-        }
-    }
+        // Runs the Dijkstra floods of sample_nodes[begin, end) into cost_map
+        auto run_sample_floods = [&](size_t begin, size_t end, t_routing_cost_map& cost_map) {
+            // to avoid multiple memory allocation and de-allocations in run_dijkstra()
+            // dijkstra_data is created outside the for loop and passed by reference to dijkstra_data()
+            t_dijkstra_data dijkstra_data;
 
-    return routing_cost_map;
-}
+            for (size_t isample = begin; isample < end; isample++) {
+                RRNodeId sample_node = sample_nodes[isample];
+                int sample_x = rr_graph.node_xlow(sample_node);
+                int sample_y = rr_graph.node_ylow(sample_node);
 
-std::pair<float, float> get_cost_from_src_opin(const std::map<int, util::t_reachable_wire_inf>& src_opin_delay_map,
-                                               int delta_x,
-                                               int delta_y,
-                                               int to_layer_num,
-                                               WireCostFunc wire_cost_func) {
-    float expected_delay_cost = std::numeric_limits<float>::infinity();
-    float expected_cong_cost = std::numeric_limits<float>::infinity();
-    if (src_opin_delay_map.empty()) {
-        //During lookahead profiling we were unable to find any wires which connected
-        //to this PTC.
-        //
-        //This can sometimes occur at very low channel widths (e.g. during min W search on
-        //small designs) where W discretization combined with fraction Fc may cause some
-        //pins/sources to be left disconnected.
-        //
-        //Such RR graphs are of course unroutable, but that should be determined by the
-        //router. So just return an arbitrary value here rather than error.
+                if (rr_graph.node_direction(sample_node) == Direction::DEC) {
+                    sample_x = rr_graph.node_xhigh(sample_node);
+                    sample_y = rr_graph.node_yhigh(sample_node);
+                }
 
-        //We choose to return the largest (non-infinite) value possible, but scaled
-        //down by a large factor to maintain some dynamic range in case this value ends
-        //up being processed (e.g. by the timing analyzer).
-        //
-        //The cost estimate should still be *extremely* large compared to a typical delay, and
-        //so should ensure that the router de-prioritizes exploring this path, but does not
-        //forbid the router from trying.
-        expected_delay_cost = std::numeric_limits<float>::max() / 1e12;
-        expected_cong_cost = std::numeric_limits<float>::max() / 1e12;
-    } else {
-        //From the current SOURCE/OPIN we look-up the wiretypes which are reachable
-        //and then add the estimates from those wire types for the distance of interest.
-        //If there are multiple options we use the minimum value.
-        for (const auto& [_, reachable_wire_inf] : src_opin_delay_map) {
-
-            util::Cost_Entry wire_cost_entry;
-            if (reachable_wire_inf.wire_rr_type == e_rr_type::SINK) {
-                //Some pins maybe reachable via a direct (OPIN -> IPIN) connection.
-                //In the lookahead, we treat such connections as 'special' wire types
-                //with no delay/congestion cost
-                wire_cost_entry.delay = 0;
-                wire_cost_entry.congestion = 0;
+                run_dijkstra(sample_node,
+                             sample_x,
+                             sample_y,
+                             cost_map,
+                             dijkstra_data,
+                             sample_locs,
+                             sample_all_locs);
+            }
+        };
+
+#if defined(VPR_USE_TBB)
+        // The floods are independent, so split the samples into contiguous blocks, each flooded into its
+        // own cost map. Merging the maps in block order adds the entries in the same order as a serial
+        // run would, so the result is identical.
+        const size_t num_samples = sample_nodes.size();
+        const size_t num_blocks = std::min<size_t>(num_samples, std::max(1, tbb::this_task_arena::max_concurrency()));
+        std::vector<t_routing_cost_map> block_cost_maps(num_blocks - 1);
+        tbb::parallel_for(size_t(0), num_blocks, [&](size_t iblock) {
+            size_t begin = iblock * num_samples / num_blocks;
+            size_t end = (iblock + 1) * num_samples / num_blocks;
+            if (iblock == 0) {
+                run_sample_floods(begin, end, routing_cost_map);
             } else {
-                //For an actual accessible wire, we query the wire look-up to get its
-                //delay and congestion cost estimates
-                wire_cost_entry = wire_cost_func(reachable_wire_inf.wire_rr_type,
-                                                 reachable_wire_inf.wire_seg_index,
-                                                 reachable_wire_inf.layer_number,
-                                                 delta_x,
-                                                 delta_y,
-                                                 to_layer_num);
+                t_routing_cost_map& block_map = block_cost_maps[iblock - 1];
+                block_map.resize({routing_cost_map.dim_size(0), routing_cost_map.dim_size(1), routing_cost_map.dim_size(2)});
+                run_sample_floods(begin, end, block_map);
             }
+        });
 
-            float this_delay_cost = reachable_wire_inf.delay + wire_cost_entry.delay;
-            float this_cong_cost = reachable_wire_inf.congestion + wire_cost_entry.congestion;
-
-            expected_delay_cost = std::min(expected_delay_cost, this_delay_cost);
-            expected_cong_cost = std::min(expected_cong_cost, this_cong_cost);
+        for (const t_routing_cost_map& block_map : block_cost_maps) {
+            for (size_t layer = 0; layer < routing_cost_map.dim_size(0); layer++) {
+                for (size_t x = 0; x < routing_cost_map.dim_size(1); x++) {
+                    for (size_t y = 0; y < routing_cost_map.dim_size(2); y++) {
+                        routing_cost_map[layer][x][y].add_cost_entries(SMALLEST, block_map[layer][x][y]);
+                    }
+                }
+            }
         }
+#else
+        run_sample_floods(0, sample_nodes.size(), routing_cost_map);
+#endif
     }
 
-    return std::make_pair(expected_delay_cost, expected_cong_cost);
+    return routing_cost_map;
 }
 
-void dump_readable_router_lookahead_map(const std::string& file_name, const std::vector<int>& dim_sizes, WireCostCallBackFunction wire_cost_func) {
+void dump_readable_router_lookahead_map(const std::string& file_name, const std::vector<int>& dim_sizes, const WireCostCallBackFunction& wire_cost_func) {
     VTR_ASSERT(vtr::check_file_name_extension(file_name, ".csv"));
     const auto& grid = g_vpr_ctx.device().grid;
 
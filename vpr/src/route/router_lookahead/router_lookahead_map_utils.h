@@ -15,7 +15,9 @@
  */
 
 #include <cmath>
+#include <functional>
 #include <limits>
+#include <map>
 #include <vector>
 #include <queue>
 #include <unordered_map>
@@ -31,7 +33,7 @@ class Expansion_Cost_Entry;
  * the list at each coordinate is later boiled down to a single representative cost entry to be stored in the final cost map */
 typedef vtr::NdMatrix<Expansion_Cost_Entry, 3> t_routing_cost_map; //[0..num_layers][0..device_ctx.grid.width()-1][0..device_ctx.grid.height()-1]
 
-typedef Cost_Entry (*WireCostCallBackFunction)(e_rr_type, int, int, int, int, int);
+typedef std::function<Cost_Entry(e_rr_type, int, int, int, int, int)> WireCostCallBackFunction;
 
 /* a class that represents an entry in the Dijkstra expansion priority queue */
 class PQ_Entry {
@@ -147,6 +149,13 @@ class Expansion_Cost_Entry {
         this->cost_vector.clear();
     }
 
+    /// @brief Add all the entries of other, in order, as if they had been added to this entry directly
+    void add_cost_entries(e_representative_entry_method method, const Expansion_Cost_Entry& other) {
+        for (const Cost_Entry& entry : other.cost_vector) {
+            add_cost_entry(method, entry.delay, entry.congestion);
+        }
+    }
+
     Cost_Entry get_representative_cost_entry(e_representative_entry_method method) const {
         Cost_Entry entry;
 
@@ -304,8 +313,6 @@ typedef std::vector<std::unordered_map<int, Cost_Entry>> t_ipin_primitive_sink_d
 // and the tile's IPIN. If there are many connections to the same IPIN, the one with the minimum delay is selected.
 typedef std::vector<std::vector<std::vector<t_reachable_wire_inf>>> t_chan_ipins_delays;
 
-typedef Cost_Entry (*WireCostFunc)(e_rr_type, int, int, int, int, int);
-
 /**
  * @brief For each tile, iterate over its OPINs and store which segment types are accessible from each OPIN
  */
@@ -346,18 +353,75 @@ t_routing_cost_map get_routing_cost_map(int longest_seg_length,
  * @param delta_x
  * @param delta_y
  * @param to_layer_num
- * @param wire_cost_func call back function that would return a cost ot get to a given location from the given segment
+ * @param wire_cost_func call back (a function of (wire type, segment index, from layer, delta x, delta y, to layer)) that would return a cost ot get to a given location from the given segment
  * @return (delay, congestion)
  */
+template<typename WireCostFunc>
 std::pair<float, float> get_cost_from_src_opin(const std::map<int, util::t_reachable_wire_inf>& src_opin_delay_map,
                                                int delta_x,
                                                int delta_y,
                                                int to_layer_num,
-                                               WireCostFunc wire_cost_func);
+                                               const WireCostFunc& wire_cost_func) {
+    float expected_delay_cost = std::numeric_limits<float>::infinity();
+    float expected_cong_cost = std::numeric_limits<float>::infinity();
+    if (src_opin_delay_map.empty()) {
+        //During lookahead profiling we were unable to find any wires which connected
+        //to this PTC.
+        //
+        //This can sometimes occur at very low channel widths (e.g. during min W search on
+        //small designs) where W discretization combined with fraction Fc may cause some
+        //pins/sources to be left disconnected.
+        //
+        //Such RR graphs are of course unroutable, but that should be determined by the
+        //router. So just return an arbitrary value here rather than error.
+
+        //We choose to return the largest (non-infinite) value possible, but scaled
+        //down by a large factor to maintain some dynamic range in case this value ends
+        //up being processed (e.g. by the timing analyzer).
+        //
+        //The cost estimate should still be *extremely* large compared to a typical delay, and
+        //so should ensure that the router de-prioritizes exploring this path, but does not
+        //forbid the router from trying.
+        expected_delay_cost = std::numeric_limits<float>::max() / 1e12;
+        expected_cong_cost = std::numeric_limits<float>::max() / 1e12;
+    } else {
+        //From the current SOURCE/OPIN we look-up the wiretypes which are reachable
+        //and then add the estimates from those wire types for the distance of interest.
+        //If there are multiple options we use the minimum value.
+        for (const auto& [_, reachable_wire_inf] : src_opin_delay_map) {
+
+            util::Cost_Entry wire_cost_entry;
+            if (reachable_wire_inf.wire_rr_type == e_rr_type::SINK) {
+                //Some pins maybe reachable via a direct (OPIN -> IPIN) connection.
+                //In the lookahead, we treat such connections as 'special' wire types
+                //with no delay/congestion cost
+                wire_cost_entry.delay = 0;
+                wire_cost_entry.congestion = 0;
+            } else {
+                //For an actual accessible wire, we query the wire look-up to get its
+                //delay and congestion cost estimates
+                wire_cost_entry = wire_cost_func(reachable_wire_inf.wire_rr_type,
+                                                 reachable_wire_inf.wire_seg_index,
+                                                 reachable_wire_inf.layer_number,
+                                                 delta_x,
+                                                 delta_y,
+                                                 to_layer_num);
+            }
+
+            float this_delay_cost = reachable_wire_inf.delay + wire_cost_entry.delay;
+            float this_cong_cost = reachable_wire_inf.congestion + wire_cost_entry.congestion;
+
+            expected_delay_cost = std::min(expected_delay_cost, this_delay_cost);
+            expected_cong_cost = std::min(expected_cong_cost, this_cong_cost);
+        }
+    }
+
+    return std::make_pair(expected_delay_cost, expected_cong_cost);
+}
 
 void dump_readable_router_lookahead_map(const std::string& file_name,
                                         const std::vector<int>& dim_sizes,
-                                        WireCostCallBackFunction wire_cost_func);
+                                        const WireCostCallBackFunction& wire_cost_func);
 
 /// @brief Converts a routing channel type (CHANX/CHANY/CHANZ) to an index
 /// to access the channel type dimension of the router lookahead table.
@@ -0,0 +1,80 @@
+#pragma once
+/**
+ * @file
+ * @brief 16-bit encoding of router lookahead cost entries.
+ *
+ * A cost is stored as a half precision float (10 mantissa bits, so a relative error of at most 2^-11)
+ * whose exponent bias is chosen per table, from the smallest cost it holds. Delays (in seconds) are far
+ * below the range of an IEEE fp16, but span only a few orders of magnitude within a table, which fits
+ * the 64 octaves a 6-bit biased exponent covers.
+ *
+ * Decoding is an integer add and a shift, cheap enough for the lookahead queries made on every heap push,
+ * while a quantized entry is a third of the size of a util::Cost_Entry.
+ */
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace util {
+
+class QuantizedCostScale {
+  public:
+    ///@brief Code of a zero cost (and of costs too small for the table's range)
+    static constexpr uint16_t ZERO = 0;
+    ///@brief Code of an invalid (NaN) cost
+    static constexpr uint16_t INVALID = 0xFFFF;
+    ///@brief Largest code of a valid cost (larger costs saturate to it)
+    static constexpr uint16_t MAX_CODE = INVALID - 1;
+
+    QuantizedCostScale() = default;
+
+    ///@brief Creates a scale whose smallest non-zero code is (approximately) min_positive.
+    explicit QuantizedCostScale(float min_positive) {
+        if (min_positive > 0.f && std::isfinite(min_positive)) {
+            offset_ = (std::bit_cast<uint32_t>(min_positive) >> MANTISSA_SHIFT) - 1;
+        }
+    }
+
+    uint16_t encode(float value) const {
+        if (std::isnan(value)) {
+            return INVALID;
+        }
+        if (!(value > 0.f)) {
+            return ZERO;
+        }
+        // Round to nearest: a carry out of the mantissa correctly bumps the exponent
+        uint32_t rounded = (std::bit_cast<uint32_t>(value) + (1u << (MANTISSA_SHIFT - 1))) >> MANTISSA_SHIFT;
+        if (rounded <= offset_) {
+            return ZERO;
+        }
+        uint32_t code = rounded - offset_;
+        return code > MAX_CODE ? MAX_CODE : uint16_t(code);
+    }
+
+    float decode(uint16_t code) const {
+        if (code == ZERO) {
+            return 0.f;
+        }
+        if (code == INVALID) {
+            return std::numeric_limits<float>::quiet_NaN();
+        }
+        return std::bit_cast<float>((uint32_t(code) + offset_) << MANTISSA_SHIFT);
+    }
+
+  private:
+    ///@brief Number of float mantissa bits dropped by the encoding
+    static constexpr int MANTISSA_SHIFT = 13;
+
+    ///@brief Subtracted from the top 19 bits of a float to get its code
+    uint32_t offset_ = 0;
+};
+
+///@brief A quantized util::Cost_Entry
+struct t_quantized_cost_entry {
+    uint16_t delay = QuantizedCostScale::INVALID;
+    uint16_t congestion = QuantizedCostScale::INVALID;
+};
+
+} // namespace util
@@ -33,22 +33,18 @@
 #include "serdes_utils.h"
 #endif /* VTR_ENABLE_CAPNPROTO */
 
-/******** File-Scope Variables ********/
-
-//Look-up table from CHANX/CHANY (to SINKs) for various distances
-static t_simple_cost_map simple_cost_map;
-
 /******** File-Scope Functions ********/
 
-static util::Cost_Entry get_wire_cost_entry(e_rr_type rr_type,
+static util::Cost_Entry get_wire_cost_entry(const t_simple_cost_map& simple_cost_map,
+                                            e_rr_type rr_type,
                                             int seg_index,
                                             int from_layer_num,
                                             int delta_x,
                                             int delta_y,
                                             int to_layer_num);
 
-static void read_router_lookahead(const std::string& file);
-static void write_router_lookahead(const std::string& file);
+static void read_router_lookahead(const std::string& file, t_simple_cost_map& simple_cost_map);
+static void write_router_lookahead(const std::string& file, const t_simple_cost_map& simple_cost_map);
 
 /******** Interface class member function definitions ********/
 
@@ -79,7 +75,7 @@ std::pair<float, float> SimpleLookahead::get_expected_delay_and_cong(RRNodeId fr
         auto from_cost_index = rr_graph.node_cost_index(from_node);
         int from_seg_index = device_ctx.rr_indexed_data[from_cost_index].seg_index;
 
-        cost_entry = get_wire_cost_entry(from_type, from_seg_index, from_layer_num, delta_x, delta_y, to_layer_num);
+        cost_entry = get_wire_cost_entry(simple_cost_map_, from_type, from_seg_index, from_layer_num, delta_x, delta_y, to_layer_num);
     }
 
     if (cost_entry.valid()) {
@@ -97,7 +93,7 @@ void SimpleLookahead::read(const std::string& file) {
     const size_t num_layers = g_vpr_ctx.device().grid.get_num_layers();
     VTR_ASSERT_MSG(num_layers == 1, "Simple router look-ahead does not support 3-d architectures.");
 
-    read_router_lookahead(file);
+    read_router_lookahead(file, simple_cost_map_);
 }
 
 void SimpleLookahead::write(const std::string& file) const {
@@ -105,20 +101,23 @@ void SimpleLookahead::write(const std::string& file) const {
     VTR_ASSERT_MSG(num_layers == 1, "Simple router look-ahead does not support 3-d architectures.");
 
     if (vtr::check_file_name_extension(file, ".csv")) {
-        std::vector<int> simple_cost_map_size(simple_cost_map.ndims());
-        for (size_t i = 0; i < simple_cost_map.ndims(); ++i) {
-            simple_cost_map_size[i] = static_cast<int>(simple_cost_map.dim_size(i));
+        std::vector<int> simple_cost_map_size(simple_cost_map_.ndims());
+        for (size_t i = 0; i < simple_cost_map_.ndims(); ++i) {
+            simple_cost_map_size[i] = static_cast<int>(simple_cost_map_.dim_size(i));
         }
-        dump_readable_router_lookahead_map(file, simple_cost_map_size, get_wire_cost_entry);
+        util::dump_readable_router_lookahead_map(file, simple_cost_map_size,
+                                                 [this](e_rr_type rr_type, int seg_index, int from_layer, int dx, int dy, int to_layer) {
+                                                     return get_wire_cost_entry(simple_cost_map_, rr_type, seg_index, from_layer, dx, dy, to_layer);
+                                                 });
     } else {
         VTR_ASSERT(vtr::check_file_name_extension(file, ".capnp") || vtr::check_file_name_extension(file, ".bin"));
-        write_router_lookahead(file);
+        write_router_lookahead(file, simple_cost_map_);
     }
 }
 
 /******** Function Definitions ********/
 
-static util::Cost_Entry get_wire_cost_entry(e_rr_type rr_type, int seg_index, int from_layer_num, int delta_x, int delta_y, int to_layer_num) {
+static util::Cost_Entry get_wire_cost_entry(const t_simple_cost_map& simple_cost_map, e_rr_type rr_type, int seg_index, int from_layer_num, int delta_x, int delta_y, int to_layer_num) {
     VTR_ASSERT_SAFE(rr_type == e_rr_type::CHANX || rr_type == e_rr_type::CHANY);
     VTR_ASSERT_SAFE(from_layer_num < static_cast<int>(simple_cost_map.dim_size(0)));
     VTR_ASSERT_SAFE(to_layer_num < static_cast<int>(simple_cost_map.dim_size(1)));
@@ -145,11 +144,11 @@ static util::Cost_Entry get_wire_cost_entry(e_rr_type rr_type, int seg_index, in
     "is disabled because VTR_ENABLE_CAPNPROTO=OFF." \
     "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
 
-void read_router_lookahead(const std::string& /*file*/) {
+void read_router_lookahead(const std::string& /*file*/, t_simple_cost_map& /*simple_cost_map*/) {
     VPR_THROW(VPR_ERROR_PLACE, "SimpleLookahead::read_router_lookahead " DISABLE_ERROR);
 }
 
-void write_router_lookahead(const std::string& /*file*/) {
+void write_router_lookahead(const std::string& /*file*/, const t_simple_cost_map& /*simple_cost_map*/) {
     VPR_THROW(VPR_ERROR_PLACE, "SimpleLookahead::write_router_lookahead " DISABLE_ERROR);
 }
 
@@ -160,31 +159,32 @@ static void ToCostEntry(util::Cost_Entry* out, const VprMapCostEntry::Reader& in
     out->congestion = in.getCongestion();
 }
 
-static void FromCostEntry(VprMapCostEntry::Builder* out, const util::Cost_Entry& in) {
-    out->setDelay(in.delay);
-    out->setCongestion(in.congestion);
-}
-
-void read_router_lookahead(const std::string& file) {
+void read_router_lookahead(const std::string& file, t_simple_cost_map& simple_cost_map) {
     vtr::ScopedStartFinishTimer timer("Loading router wire lookahead map");
-    MmapFile f(file);
+    auto f = std::make_shared<MmapFile>(file);
 
     /* Increase reader limit to 1G words to allow for large files. */
     ::capnp::ReaderOptions opts = default_large_capnp_opts();
-    ::capnp::FlatArrayMessageReader reader(f.getData(), opts);
+    ::capnp::FlatArrayMessageReader reader(f->getData(), opts);
 
     auto map = reader.getRoot<VprMapLookahead>();
 
-    ToNdMatrix<6, VprMapCostEntry, util::Cost_Entry>(&simple_cost_map, map.getCostMap(), ToCostEntry);
+    /* The cost map of newer files is used in place, keeping the file mapped: concurrent
+     * VPR processes on the same host share one copy through the page cache */
+    if (map.hasRawCostMap()) {
+        AliasNdMatrix<6, util::Cost_Entry>(&simple_cost_map, map.getRawCostMap(), f);
+    } else {
+        ToNdMatrix<6, VprMapCostEntry, util::Cost_Entry>(&simple_cost_map, map.getCostMap(), ToCostEntry);
+    }
 }
 
-void write_router_lookahead(const std::string& file) {
+void write_router_lookahead(const std::string& file, const t_simple_cost_map& simple_cost_map) {
     ::capnp::MallocMessageBuilder builder;
 
     auto map = builder.initRoot<VprMapLookahead>();
 
-    auto cost_map = map.initCostMap();
-    FromNdMatrix<6, VprMapCostEntry, util::Cost_Entry>(&cost_map, simple_cost_map, FromCostEntry);
+    auto cost_map = map.initRawCostMap();
+    FromNdMatrixRaw<6, util::Cost_Entry>(&cost_map, simple_cost_map);
 
     writeMessageToFile(file, &builder);
 }
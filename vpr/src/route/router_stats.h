@@ -5,6 +5,9 @@
 #include "rr_node_types.h"
 #include "vtr_assert.h"
 #include "vtr_array.h"
+#include "vtr_time.h"
+
+#include <vector>
 
 // This struct instructs the router on how to route the given connection
 struct ConnectionParameters {
@@ -30,8 +33,20 @@ struct ConnectionParameters {
     const std::unordered_map<RRNodeId, int>& connection_choking_spots_;
 };
 
+/** Routing effort of one route_net() call, recorded if --router_net_profile_file is set */
+struct NetRouteProfile {
+    ParentNetId net_id;
+    float route_sec = 0.;
+    size_t heap_pushes = 0;
+    size_t heap_pops = 0;
+    size_t connections_routed = 0;
+};
+
 struct RouterStats {
     size_t connections_routed = 0;
+    /** Legally routed connections of rerouted nets kept as they were by incremental rerouting
+     * (see --min_incremental_reroute_fanout), i.e. connection searches saved */
+    size_t connections_reused = 0;
     size_t nets_routed = 0;
     size_t heap_pushes = 0;
     size_t heap_pops = 0;
@@ -47,9 +62,24 @@ struct RouterStats {
     // For debugging purposes
     vtr::array<e_rr_type, size_t, (size_t)e_rr_type::NUM_RR_TYPES> rt_node_pushes{0};
 
+    // MultiQueue statistics of the parallel connection router (always 0 for the serial one)
+    size_t heap_stale_pops = 0;      ///< Popped nodes not expanded: superseded by a cheaper path, or pruned after reaching the target
+    size_t wasted_expansions = 0;    ///< Nodes expanded again, after a cheaper path to them was found
+    size_t heap_lock_contention = 0; ///< Failed attempts to lock a queue of the MultiQueue
+    size_t node_lock_contention = 0; ///< Node cost updates which had to wait for another thread
+
+    // Lookahead cost cache statistics (see --router_lookahead_cache_entries, always 0 if disabled)
+    size_t lookahead_cache_hits = 0;
+    size_t lookahead_cache_misses = 0;
+
+    /** Profile of each route_net() call (only recorded if net profiling is enabled).
+     * A net shows up more than once if it was routed in parts (e.g. by the decomposing router) */
+    std::vector<NetRouteProfile> net_profiles;
+
     /** Add rhs's stats to mine */
     void combine(RouterStats& rhs) {
         connections_routed += rhs.connections_routed;
+        connections_reused += rhs.connections_reused;
         nets_routed += rhs.nets_routed;
         heap_pushes += rhs.heap_pushes;
         inter_cluster_node_pushes += rhs.inter_cluster_node_pushes;
@@ -57,6 +87,12 @@ struct RouterStats {
         heap_pops += rhs.heap_pops;
         inter_cluster_node_pops += rhs.inter_cluster_node_pops;
         intra_cluster_node_pops += rhs.intra_cluster_node_pops;
+        heap_stale_pops += rhs.heap_stale_pops;
+        wasted_expansions += rhs.wasted_expansions;
+        heap_lock_contention += rhs.heap_lock_contention;
+        node_lock_contention += rhs.node_lock_contention;
+        lookahead_cache_hits += rhs.lookahead_cache_hits;
+        lookahead_cache_misses += rhs.lookahead_cache_misses;
         for (e_rr_type rr_type : RR_TYPES) {
             inter_cluster_node_type_cnt_pushes[rr_type] += rhs.inter_cluster_node_type_cnt_pushes[rr_type];
             inter_cluster_node_type_cnt_pops[rr_type] += rhs.inter_cluster_node_type_cnt_pops[rr_type];
@@ -64,7 +100,42 @@ struct RouterStats {
             intra_cluster_node_type_cnt_pops[rr_type] += rhs.intra_cluster_node_type_cnt_pops[rr_type];
             rt_node_pushes[rr_type] += rhs.rt_node_pushes[rr_type];
         }
+        net_profiles.insert(net_profiles.end(), rhs.net_profiles.begin(), rhs.net_profiles.end());
+    }
+};
+
+/** Records a NetRouteProfile into router_stats for the scope it lives in (a route_net() call),
+ * from the heap operations and connections router_stats gained in the meantime */
+class NetRouteProfileScope {
+  public:
+    NetRouteProfileScope(bool enabled, ParentNetId net_id, RouterStats& router_stats)
+        : enabled_(enabled)
+        , net_id_(net_id)
+        , router_stats_(router_stats)
+        , heap_pushes_(router_stats.heap_pushes)
+        , heap_pops_(router_stats.heap_pops)
+        , connections_routed_(router_stats.connections_routed) {}
+
+    ~NetRouteProfileScope() {
+        if (!enabled_)
+            return;
+        NetRouteProfile profile;
+        profile.net_id = net_id_;
+        profile.route_sec = timer_.elapsed_sec();
+        profile.heap_pushes = router_stats_.heap_pushes - heap_pushes_;
+        profile.heap_pops = router_stats_.heap_pops - heap_pops_;
+        profile.connections_routed = router_stats_.connections_routed - connections_routed_;
+        router_stats_.net_profiles.push_back(profile);
     }
+
+  private:
+    bool enabled_;
+    ParentNetId net_id_;
+    RouterStats& router_stats_;
+    size_t heap_pushes_;
+    size_t heap_pops_;
+    size_t connections_routed_;
+    vtr::Timer timer_;
 };
 
 class WirelengthInfo {
@@ -208,3 +208,20 @@ void RoutingPredictor::add_iteration_overuse(size_t iteration, size_t overused_r
         slope_ = model.get_slope();
     }
 }
+
+size_t RoutingPredictor::iterations_since_overuse_improvement(float min_improvement) const {
+    if (iterations_.empty()) {
+        return 0;
+    }
+
+    size_t best_overuse = iteration_overused_rr_node_counts_[0];
+    size_t best_iteration = iterations_[0];
+    for (size_t i = 1; i < iterations_.size(); ++i) {
+        if (iteration_overused_rr_node_counts_[i] < (1. - min_improvement) * best_overuse) {
+            best_overuse = iteration_overused_rr_node_counts_[i];
+            best_iteration = iterations_[i];
+        }
+    }
+
+    return iterations_.back() - best_iteration;
+}
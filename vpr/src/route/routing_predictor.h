@@ -13,6 +13,11 @@ constexpr float ROUTING_PREDICTOR_ITERATION_ABORT_FACTOR_AGGRESSIVE = 1.5;
 // This avoids giving up when solutions are nearly legal, but converging slowly
 constexpr size_t ROUTING_PREDICTOR_MIN_ABSOLUTE_OVERUSE_THRESHOLD = 100;
 
+//In PRODUCTION mode the router also aborts when the number of overused resources
+//has not improved on its best by this fraction for this many iterations
+constexpr float ROUTING_PREDICTOR_STALL_MIN_IMPROVEMENT = 0.05;
+constexpr size_t ROUTING_PREDICTOR_STALL_ITERATIONS = 20;
+
 class RoutingPredictor {
   public:
     RoutingPredictor(size_t min_history = 8, float history_factor = 0.5);
@@ -27,6 +32,10 @@ class RoutingPredictor {
 
     float get_slope() const;
 
+    //Returns the number of iterations since the overuse last dropped below
+    //(1 - min_improvement) times its previous best (0 with no history)
+    size_t iterations_since_overuse_improvement(float min_improvement) const;
+
   private:
     size_t min_history_;
     float history_factor_;
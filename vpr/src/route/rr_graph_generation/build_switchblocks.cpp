@@ -127,6 +127,7 @@
 
 #include <algorithm>
 #include <string_view>
+#include <unordered_map>
 
 #include "vtr_assert.h"
 #include "vtr_memory.h"
@@ -141,12 +142,39 @@
 #include "physical_types.h"
 #include "parse_switchblocks.h"
 #include "vtr_expr_eval.h"
+#include "vtr_hash.h"
 #include "rr_types.h"
 #include "switchblock_scatter_gather_common_utils.h"
 
+/* A switch block formula along with the values of its two variables ((W, t) for permutation
+ * formulas, (from, to) for the number of connections formulas) */
+struct t_formula_key {
+    std::string_view formula;
+    int var1;
+    int var2;
+
+    bool operator==(const t_formula_key& other) const {
+        return formula == other.formula && var1 == other.var1 && var2 == other.var2;
+    }
+};
+
+struct t_formula_key_hash {
+    std::size_t operator()(const t_formula_key& key) const noexcept {
+        std::size_t seed = std::hash<std::string_view>{}(key.formula);
+        vtr::hash_combine(seed, key.var1);
+        vtr::hash_combine(seed, key.var2);
+        return seed;
+    }
+};
+
 struct t_wireconn_scratchpad {
     vtr::FormulaParser formula_parser;
     vtr::t_formula_data formula_data;
+    /* The formulas only depend on a few values which repeat across the grid (the wire set sizes and
+     * the source wire index), so each formula is only parsed once for each set of values.
+     * The formulas are keyed by views of the architecture's strings, which outlive the scratchpad. */
+    std::unordered_map<t_formula_key, int, t_formula_key_hash> permutation_results;
+    std::unordered_map<t_formula_key, int, t_formula_key_hash> num_conns_results;
     std::vector<t_wire_switchpoint> potential_src_wires;
     std::vector<t_wire_switchpoint> potential_dest_wires;
     std::vector<t_wire_switchpoint> scratch_wires;
@@ -217,6 +245,12 @@ static void get_switchpoint_wires(const t_chan_seg_details* chan_details,
 /* adjusts a negative destination wire index calculated from a permutation formula */
 static int adjust_formula_result(int dest_wire, int src_W, int dest_W, int connection_ind);
 
+/* returns the raw result of the permutation formula for the given destination set size (W) and source wire index (t) */
+static int evaluate_permutation_formula(const std::string& perm, int dest_W, int src_wire_ind, t_wireconn_scratchpad* scratchpad);
+
+/* returns the number of connections given by the formula for the given source (from) and destination (to) set sizes */
+static int evaluate_wireconn_num_conns(const std::string& num_conns_formula, int src_W, int dest_W, t_wireconn_scratchpad* scratchpad);
+
 /************ Function Definitions ************/
 
 t_sb_connection_map* alloc_and_load_switchblock_permutations(const t_chan_details& chan_details_x,
@@ -512,11 +546,7 @@ static void compute_wireconn_connections(e_directionality directionality,
     //      * interleave (to ensure good diversity)
 
     // Determine how many connections to make
-    int num_conns = evaluate_num_conns_formula(scratchpad->formula_parser,
-                                               scratchpad->formula_data,
-                                               wireconn.num_conns_formula,
-                                               potential_src_wires.size(),
-                                               potential_dest_wires.size());
+    int num_conns = evaluate_wireconn_num_conns(wireconn.num_conns_formula, src_W, dest_W, scratchpad);
     VTR_ASSERT_MSG(num_conns >= 0, "Number of switchblock connections to create must be non-negative");
 
     VTR_LOGV(verbose, "  num_conns: %zu\n", num_conns);
@@ -554,11 +584,7 @@ static void compute_wireconn_connections(e_directionality directionality,
         const std::vector<std::string>& permutations_ref = iter->second;
         for (const std::string& perm : permutations_ref) {
             /* Convert the symbolic permutation formula to a number */
-            vtr::t_formula_data& formula_data = scratchpad->formula_data;
-            formula_data.clear();
-            formula_data.set_var_value("W", dest_W);
-            formula_data.set_var_value("t", src_wire_ind);
-            int raw_dest_wire_ind = get_sb_formula_raw_result(scratchpad->formula_parser, perm.c_str(), formula_data);
+            int raw_dest_wire_ind = evaluate_permutation_formula(perm, dest_W, src_wire_ind, scratchpad);
             int dest_wire_ind = adjust_formula_result(raw_dest_wire_ind, src_W, dest_W, iconn);
 
             if (dest_wire_ind < 0) {
@@ -600,6 +626,38 @@ static void compute_wireconn_connections(e_directionality directionality,
     }
 }
 
+static int evaluate_permutation_formula(const std::string& perm, int dest_W, int src_wire_ind, t_wireconn_scratchpad* scratchpad) {
+    t_formula_key key{perm, dest_W, src_wire_ind};
+    auto iter = scratchpad->permutation_results.find(key);
+    if (iter != scratchpad->permutation_results.end()) {
+        return iter->second;
+    }
+
+    vtr::t_formula_data& formula_data = scratchpad->formula_data;
+    formula_data.clear();
+    formula_data.set_var_value("W", dest_W);
+    formula_data.set_var_value("t", src_wire_ind);
+    int result = get_sb_formula_raw_result(scratchpad->formula_parser, perm.c_str(), formula_data);
+    scratchpad->permutation_results.emplace(key, result);
+    return result;
+}
+
+static int evaluate_wireconn_num_conns(const std::string& num_conns_formula, int src_W, int dest_W, t_wireconn_scratchpad* scratchpad) {
+    t_formula_key key{num_conns_formula, src_W, dest_W};
+    auto iter = scratchpad->num_conns_results.find(key);
+    if (iter != scratchpad->num_conns_results.end()) {
+        return iter->second;
+    }
+
+    int result = evaluate_num_conns_formula(scratchpad->formula_parser,
+                                            scratchpad->formula_data,
+                                            num_conns_formula,
+                                            src_W,
+                                            dest_W);
+    scratchpad->num_conns_results.emplace(key, result);
+    return result;
+}
+
 /* adjusts the destination wire calculated from a permutation formula to account for negative indices,
  * source wire set offset, and modulo by destination wire set size
  * */
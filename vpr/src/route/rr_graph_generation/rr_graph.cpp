@@ -1,6 +1,7 @@
 #include <cstdio>
 #include <cmath>
 #include <algorithm>
+#include <fstream>
 #include <utility>
 #include <vector>
 #include "alloc_and_load_rr_indexed_data.h"
@@ -42,10 +43,16 @@
 #include "edge_groups.h"
 #include "rr_graph_builder.h"
 #include "tileable_rr_graph_builder.h"
+#include "setup_cache.h"
 
 #include "rr_types.h"
 #include "rr_node_indices.h"
 
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
 //#define VERBOSE
 //used for getting the exact count of each edge type and printing it to std out.
 
@@ -313,26 +320,42 @@ static void add_intra_tile_edges_rr_graph(RRGraphBuilder& rr_graph_builder,
                                           t_physical_tile_type_ptr physical_tile,
                                           const t_physical_tile_loc& root_loc);
 
-static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
-                          const int layer,
-                          const int x_coord,
-                          const int y_coord,
-                          const e_rr_type chan_type,
-                          const t_track_to_pin_lookup& track_to_pin_lookup,
-                          t_sb_connection_map* sb_conn_map,
-                          const vtr::NdMatrix<std::vector<int>, 3>& switch_block_conn,
-                          const int cost_index_offset,
-                          const t_chan_width& nodes_per_chan,
-                          const DeviceGrid& grid,
-                          const int tracks_per_chan,
-                          t_sblock_pattern& sblock_pattern,
-                          const int Fs_per_side,
-                          const t_chan_details& chan_details_x,
-                          const t_chan_details& chan_details_y,
-                          t_rr_edge_info_set& rr_edges_to_create,
-                          const int wire_to_ipin_switch,
-                          const int wire_to_pin_between_dice_switch,
-                          const e_directionality directionality);
+/**
+ * @brief Collects the fan-out edges of the channel segments starting at (layer, x_coord, y_coord).
+ *
+ * Only reads the RR node lookup, so it may be called concurrently for different channels.
+ * The node attributes of the segments are set by load_rr_chan_nodes().
+ */
+static void build_rr_chan_edges(RRGraphBuilder& rr_graph_builder,
+                                const int layer,
+                                const int x_coord,
+                                const int y_coord,
+                                const e_rr_type chan_type,
+                                const t_track_to_pin_lookup& track_to_pin_lookup,
+                                t_sb_connection_map* sb_conn_map,
+                                const vtr::NdMatrix<std::vector<int>, 3>& switch_block_conn,
+                                const t_chan_width& nodes_per_chan,
+                                const DeviceGrid& grid,
+                                const int tracks_per_chan,
+                                t_sblock_pattern& sblock_pattern,
+                                const int Fs_per_side,
+                                const t_chan_details& chan_details_x,
+                                const t_chan_details& chan_details_y,
+                                t_rr_edge_info_set& rr_edges_to_create,
+                                const int wire_to_ipin_switch,
+                                const int wire_to_pin_between_dice_switch,
+                                const e_directionality directionality);
+
+/// @brief Sets the attributes (type, coordinates, RC, ...) of the channel segment nodes starting at (layer, x_coord, y_coord).
+static void load_rr_chan_nodes(RRGraphBuilder& rr_graph_builder,
+                               const int layer,
+                               const int x_coord,
+                               const int y_coord,
+                               const e_rr_type chan_type,
+                               const int cost_index_offset,
+                               const int tracks_per_chan,
+                               const t_chan_details& chan_details_x,
+                               const t_chan_details& chan_details_y);
 
 void alloc_and_load_edges(RRGraphBuilder& rr_graph_builder,
                           const t_rr_edge_info_set& rr_edges_to_create);
@@ -410,6 +433,16 @@ static void add_and_connect_non_3d_sg_links(RRGraphBuilder& rr_graph_builder,
  */
 static void alloc_and_init_channel_width();
 
+/**
+ * @brief Checks the RR graph loaded from a file, unless an identical RR graph was checked before.
+ *
+ * The digest of each RR graph passing the check is recorded in the setup cache (as an empty
+ * file named after it), so reading the same RR graph file again only costs the digest computation.
+ */
+static void check_loaded_rr_graph_with_digest(e_graph_type graph_type,
+                                              const std::string& setup_cache_dir,
+                                              bool is_flat);
+
 /******************* Subroutine definitions *******************************/
 
 void create_rr_graph(e_graph_type graph_type,
@@ -441,6 +474,11 @@ void create_rr_graph(e_graph_type graph_type,
             if (device_ctx.loaded_rr_graph_filename != det_routing_arch.read_rr_graph_filename) {
                 free_rr_graph();
 
+                // With a trusted digest, the check is done (or skipped) below instead of while loading
+                bool trust_digest = router_opts.do_check_rr_graph
+                                    && router_opts.check_rr_graph_trusted_digest
+                                    && !router_opts.setup_cache_dir.empty();
+
                 load_rr_file(&mutable_device_ctx.rr_graph_builder,
                              &mutable_device_ctx.rr_graph,
                              device_ctx.physical_tile_types,
@@ -458,10 +496,13 @@ void create_rr_graph(e_graph_type graph_type,
                              det_routing_arch.read_rr_graph_filename.c_str(),
                              &mutable_device_ctx.loaded_rr_graph_filename,
                              router_opts.read_rr_edge_metadata,
-                             router_opts.do_check_rr_graph,
+                             router_opts.do_check_rr_graph && !trust_digest,
                              echo_enabled,
                              echo_file_name,
                              is_flat);
+                if (trust_digest) {
+                    check_loaded_rr_graph_with_digest(graph_type, router_opts.setup_cache_dir, is_flat);
+                }
                 if (router_opts.reorder_rr_graph_nodes_algorithm != DONT_REORDER) {
                     mutable_device_ctx.rr_graph_builder.reorder_nodes(router_opts.reorder_rr_graph_nodes_algorithm,
                                                                       router_opts.reorder_rr_graph_nodes_threshold,
@@ -494,6 +535,14 @@ void create_rr_graph(e_graph_type graph_type,
                                is_flat,
                                Warnings,
                                router_opts.route_verbosity);
+                // Reorder nodes of the built graph upon request. A flat graph is reordered below,
+                // after the intra-cluster resources are added, so don't do the work twice.
+                // The tileable builder keeps node references (rr_node_track_ids), so it's skipped.
+                if (router_opts.reorder_rr_graph_nodes_algorithm != DONT_REORDER && !is_flat) {
+                    mutable_device_ctx.rr_graph_builder.reorder_nodes(router_opts.reorder_rr_graph_nodes_algorithm,
+                                                                      router_opts.reorder_rr_graph_nodes_threshold,
+                                                                      router_opts.reorder_rr_graph_nodes_seed);
+                }
             } else {
                 // Note: We do not support dedicated network for clocks in tileable rr_graph generation
                 build_tileable_unidir_rr_graph(block_types,
@@ -562,6 +611,9 @@ void create_rr_graph(e_graph_type graph_type,
 
     rr_set_sink_locs(device_ctx.rr_graph, mutable_device_ctx.rr_graph_builder, grid);
 
+    // No more nodes are added to the graph, so pack the node look-up
+    mutable_device_ctx.rr_graph_builder.node_lookup().compress();
+
     verify_rr_node_indices(grid,
                            device_ctx.rr_graph,
                            device_ctx.rr_indexed_data,
@@ -570,6 +622,9 @@ void create_rr_graph(e_graph_type graph_type,
 
     alloc_and_init_channel_width();
 
+    // The graph was (re)built or extended, so the digest of the previous graph is stale
+    invalidate_rr_graph_digest();
+
     print_rr_graph_stats();
 
     // Write out rr graph file if needed - Currently, writing the flat rr-graph is not supported since loading from a flat rr-graph is not supported.
@@ -591,6 +646,12 @@ void create_rr_graph(e_graph_type graph_type,
                        echo_file_name,
                        is_flat);
     }
+
+    // Edge sources are only needed while building the graph; drop them to save memory.
+    // Note that they are rebuilt automatically if edges are added later (e.g. for flat routing).
+    if (router_opts.compress_rr_graph_edges) {
+        mutable_device_ctx.rr_graph_builder.compress_edges();
+    }
 }
 
 static void add_intra_tile_edges_rr_graph(RRGraphBuilder& rr_graph_builder,
@@ -1213,6 +1274,38 @@ static void alloc_and_init_channel_width() {
     }
 }
 
+static void check_loaded_rr_graph_with_digest(e_graph_type graph_type,
+                                              const std::string& setup_cache_dir,
+                                              bool is_flat) {
+    const DeviceContext& device_ctx = g_vpr_ctx.device();
+
+    // The RR graph was just loaded, so any digest computed so far is the one of the previous RR graph
+    invalidate_rr_graph_digest();
+    std::string options_key = std::to_string(int(graph_type)) + ";" + std::to_string(is_flat);
+    std::string cache_file = get_setup_cache_file(setup_cache_dir, "rr_graph_check", options_key);
+
+    if (!cache_file.empty() && setup_cache_file_exists(cache_file)) {
+        VTR_LOG("RR graph digest matches a previously checked RR graph, skipping RR graph check\n");
+        return;
+    }
+
+    const VibDeviceGrid vib_grid;
+    check_rr_graph(device_ctx.rr_graph,
+                   device_ctx.physical_tile_types,
+                   device_ctx.rr_indexed_data,
+                   device_ctx.grid,
+                   vib_grid,
+                   device_ctx.chan_width,
+                   graph_type,
+                   is_flat);
+
+    if (!cache_file.empty()) {
+        write_setup_cache_file(cache_file, [](const std::string& file_name) {
+            std::ofstream(file_name) << "checked\n";
+        });
+    }
+}
+
 void build_tile_rr_graph(RRGraphBuilder& rr_graph_builder,
                          const t_det_routing_arch& det_routing_arch,
                          t_physical_tile_type_ptr physical_tile,
@@ -1598,71 +1691,124 @@ static std::function<void(t_chan_width*)> alloc_and_load_rr_graph(RRGraphBuilder
 
     t_rr_edge_info_set interdie_3d_rr_edges_to_create;
 
-    for (size_t i = 0; i < grid.width() - 1; ++i) {
-        for (size_t j = 0; j < grid.height() - 1; ++j) {
-
-            // In multi-die FPGAs with track-to-track connections between layers, we need to load CHANZ nodes
-            // These extra nodes can be driven from many tracks in the source layer and can drive multiple tracks in the destination layer,
-            // since these die-crossing connections have more delays.
-            if (grid.get_num_layers() > 1) {
-                build_inter_die_3d_rr_chan(rr_graph_builder, i, j, interdie_3d_links[i][j],
-                                           CHANX_COST_INDEX_START + num_seg_types_x + num_seg_types_y);
-            }
+    // The edges of each channel segment only depend on read-only lookups, so they are
+    // collected in parallel, one grid column per task. They are then loaded (together with
+    // the node attributes and the 3D connections) serially, in the same column, row, layer
+    // and channel type order as before, so the RR graph does not depend on the number of
+    // threads. Columns are processed in batches to bound the memory held by the edge
+    // buffers, since RR graph creation is the high-watermark of VPR's memory use.
+    const auto& device_ctx = g_vpr_ctx.device();
+    const size_t num_chan_cols = grid.width() - 1;
+    const size_t num_chan_rows = grid.height() - 1;
+    const size_t num_layers = grid.get_num_layers();
+#if defined(VPR_USE_TBB)
+    const size_t batch_cols = std::min<size_t>(num_chan_cols, 4 * std::max(1, tbb::this_task_arena::max_concurrency()));
+#else
+    const size_t batch_cols = std::min<size_t>(num_chan_cols, 1);
+#endif
+    // [0..batch_cols-1][0..num_chan_rows-1][0..num_layers-1][0: CHANX, 1: CHANY]
+    vtr::NdMatrix<t_rr_edge_info_set, 4> chan_edges_to_create({batch_cols, num_chan_rows, num_layers, 2});
 
-            for (int layer = 0; layer < (int)grid.get_num_layers(); ++layer) {
-                const auto& device_ctx = g_vpr_ctx.device();
+    auto build_chan_column_edges = [&](size_t i, size_t icol) {
+        for (size_t j = 0; j < num_chan_rows; ++j) {
+            for (size_t layer = 0; layer < num_layers; ++layer) {
                 // Skip the current die if architecture file specifies that it doesn't require inter-cluster programmable resource routing
                 if (!device_ctx.inter_cluster_prog_routing_resources.at(layer)) {
                     continue;
                 }
 
                 if (i > 0) {
+                    t_rr_edge_info_set& chanx_edges = chan_edges_to_create[icol][j][layer][0];
                     int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.x_list[j]);
-                    build_rr_chan(rr_graph_builder, layer, i, j, e_rr_type::CHANX, track_to_pin_lookup_x, sb_conn_map,
-                                  switch_block_conn,
-                                  CHANX_COST_INDEX_START,
-                                  chan_width, grid, tracks_per_chan,
-                                  sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
-                                  rr_edges_to_create,
-                                  wire_to_ipin_switch,
-                                  wire_to_pin_between_dice_switch,
-                                  directionality);
-
-                    // Create the actual CHAN->CHAN edges
-                    uniquify_edges(rr_edges_to_create);
-                    alloc_and_load_edges(rr_graph_builder, rr_edges_to_create);
-                    num_edges += rr_edges_to_create.size();
-
-                    rr_edges_to_create.clear();
+                    build_rr_chan_edges(rr_graph_builder, layer, i, j, e_rr_type::CHANX, track_to_pin_lookup_x, sb_conn_map,
+                                        switch_block_conn,
+                                        chan_width, grid, tracks_per_chan,
+                                        sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
+                                        chanx_edges,
+                                        wire_to_ipin_switch,
+                                        wire_to_pin_between_dice_switch,
+                                        directionality);
+                    uniquify_edges(chanx_edges);
                 }
                 if (j > 0) {
+                    t_rr_edge_info_set& chany_edges = chan_edges_to_create[icol][j][layer][1];
                     int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.y_list[i]);
-                    build_rr_chan(rr_graph_builder, layer, i, j, e_rr_type::CHANY, track_to_pin_lookup_y, sb_conn_map,
-                                  switch_block_conn,
-                                  CHANX_COST_INDEX_START + num_seg_types_x,
-                                  chan_width, grid, tracks_per_chan,
-                                  sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
-                                  rr_edges_to_create,
-                                  wire_to_ipin_switch,
-                                  wire_to_pin_between_dice_switch,
-                                  directionality);
-
-                    // Create the actual CHAN->CHAN edges
-                    uniquify_edges(rr_edges_to_create);
-                    alloc_and_load_edges(rr_graph_builder, rr_edges_to_create);
-                    num_edges += rr_edges_to_create.size();
-                    rr_edges_to_create.clear();
+                    build_rr_chan_edges(rr_graph_builder, layer, i, j, e_rr_type::CHANY, track_to_pin_lookup_y, sb_conn_map,
+                                        switch_block_conn,
+                                        chan_width, grid, tracks_per_chan,
+                                        sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
+                                        chany_edges,
+                                        wire_to_ipin_switch,
+                                        wire_to_pin_between_dice_switch,
+                                        directionality);
+                    uniquify_edges(chany_edges);
                 }
             }
+        }
+    };
+
+    for (size_t batch_start = 0; batch_start < num_chan_cols; batch_start += batch_cols) {
+        const size_t batch_end = std::min(batch_start + batch_cols, num_chan_cols);
 
-            if (grid.get_num_layers() > 1) {
-                add_inter_die_3d_edges(rr_graph_builder, i, j,
-                                       chan_details_x, chan_details_y,
-                                       interdie_3d_links[i][j], interdie_3d_rr_edges_to_create);
-                uniquify_edges(interdie_3d_rr_edges_to_create);
-                alloc_and_load_edges(rr_graph_builder, interdie_3d_rr_edges_to_create);
-                num_edges += interdie_3d_rr_edges_to_create.size();
-                interdie_3d_rr_edges_to_create.clear();
+#if defined(VPR_USE_TBB)
+        tbb::parallel_for(batch_start, batch_end, [&](size_t i) {
+            build_chan_column_edges(i, i - batch_start);
+        });
+#else
+        for (size_t i = batch_start; i < batch_end; ++i) {
+            build_chan_column_edges(i, i - batch_start);
+        }
+#endif
+
+        for (size_t i = batch_start; i < batch_end; ++i) {
+            for (size_t j = 0; j < num_chan_rows; ++j) {
+
+                // In multi-die FPGAs with track-to-track connections between layers, we need to load CHANZ nodes
+                // These extra nodes can be driven from many tracks in the source layer and can drive multiple tracks in the destination layer,
+                // since these die-crossing connections have more delays.
+                if (num_layers > 1) {
+                    build_inter_die_3d_rr_chan(rr_graph_builder, i, j, interdie_3d_links[i][j],
+                                               CHANX_COST_INDEX_START + num_seg_types_x + num_seg_types_y);
+                }
+
+                for (size_t layer = 0; layer < num_layers; ++layer) {
+                    if (!device_ctx.inter_cluster_prog_routing_resources.at(layer)) {
+                        continue;
+                    }
+
+                    if (i > 0) {
+                        int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.x_list[j]);
+                        load_rr_chan_nodes(rr_graph_builder, layer, i, j, e_rr_type::CHANX, CHANX_COST_INDEX_START,
+                                           tracks_per_chan, chan_details_x, chan_details_y);
+
+                        // Create the actual CHAN->CHAN edges
+                        t_rr_edge_info_set& chanx_edges = chan_edges_to_create[i - batch_start][j][layer][0];
+                        alloc_and_load_edges(rr_graph_builder, chanx_edges);
+                        num_edges += chanx_edges.size();
+                        t_rr_edge_info_set().swap(chanx_edges);
+                    }
+                    if (j > 0) {
+                        int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.y_list[i]);
+                        load_rr_chan_nodes(rr_graph_builder, layer, i, j, e_rr_type::CHANY, CHANX_COST_INDEX_START + num_seg_types_x,
+                                           tracks_per_chan, chan_details_x, chan_details_y);
+
+                        // Create the actual CHAN->CHAN edges
+                        t_rr_edge_info_set& chany_edges = chan_edges_to_create[i - batch_start][j][layer][1];
+                        alloc_and_load_edges(rr_graph_builder, chany_edges);
+                        num_edges += chany_edges.size();
+                        t_rr_edge_info_set().swap(chany_edges);
+                    }
+                }
+
+                if (num_layers > 1) {
+                    add_inter_die_3d_edges(rr_graph_builder, i, j,
+                                           chan_details_x, chan_details_y,
+                                           interdie_3d_links[i][j], interdie_3d_rr_edges_to_create);
+                    uniquify_edges(interdie_3d_rr_edges_to_create);
+                    alloc_and_load_edges(rr_graph_builder, interdie_3d_rr_edges_to_create);
+                    num_edges += interdie_3d_rr_edges_to_create.size();
+                    interdie_3d_rr_edges_to_create.clear();
+                }
             }
         }
     }
@@ -1857,6 +2003,8 @@ void free_rr_graph() {
     device_ctx.loaded_rr_graph_filename.clear();
     device_ctx.loaded_rr_edge_override_filename.clear();
 
+    invalidate_rr_graph_digest();
+
     device_ctx.rr_graph_builder.clear();
 
     device_ctx.rr_node_track_ids.clear();
@@ -1867,35 +2015,36 @@ void free_rr_graph() {
 
     device_ctx.rr_graph_is_flat = false;
 
+    device_ctx.rr_graph_built_chan_width = vtr::nullopt;
+    device_ctx.masked_rr_node_capacities.clear();
+
     invalidate_router_lookahead_cache();
 }
 
 /* Allocates/loads edges for nodes belonging to specified channel segment and initializes
  * node properties such as cost, occupancy and capacity */
-static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
-                          const int layer,
-                          const int x_coord,
-                          const int y_coord,
-                          const e_rr_type chan_type,
-                          const t_track_to_pin_lookup& track_to_pin_lookup,
-                          t_sb_connection_map* sb_conn_map,
-                          const vtr::NdMatrix<std::vector<int>, 3>& switch_block_conn,
-                          const int cost_index_offset,
-                          const t_chan_width& nodes_per_chan,
-                          const DeviceGrid& grid,
-                          const int tracks_per_chan,
-                          t_sblock_pattern& sblock_pattern,
-                          const int Fs_per_side,
-                          const t_chan_details& chan_details_x,
-                          const t_chan_details& chan_details_y,
-                          t_rr_edge_info_set& rr_edges_to_create,
-                          const int wire_to_ipin_switch,
-                          const int wire_to_pin_between_dice_switch,
-                          const e_directionality directionality) {
+static void build_rr_chan_edges(RRGraphBuilder& rr_graph_builder,
+                                const int layer,
+                                const int x_coord,
+                                const int y_coord,
+                                const e_rr_type chan_type,
+                                const t_track_to_pin_lookup& track_to_pin_lookup,
+                                t_sb_connection_map* sb_conn_map,
+                                const vtr::NdMatrix<std::vector<int>, 3>& switch_block_conn,
+                                const t_chan_width& nodes_per_chan,
+                                const DeviceGrid& grid,
+                                const int tracks_per_chan,
+                                t_sblock_pattern& sblock_pattern,
+                                const int Fs_per_side,
+                                const t_chan_details& chan_details_x,
+                                const t_chan_details& chan_details_y,
+                                t_rr_edge_info_set& rr_edges_to_create,
+                                const int wire_to_ipin_switch,
+                                const int wire_to_pin_between_dice_switch,
+                                const e_directionality directionality) {
     // this function builds both x and y-directed channel segments, so set up our coordinates based on channel type
 
     const auto& device_ctx = g_vpr_ctx.device();
-    auto& mutable_device_ctx = g_vpr_ctx.mutable_device();
 
     // Initially assumes CHANX
     int seg_coord = x_coord;                           //The absolute coordinate of this segment within the channel
@@ -2030,7 +2179,50 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
             }
         }
 
-        // Edge arrays have now been built up.  Do everything else.
+    }
+}
+
+static void load_rr_chan_nodes(RRGraphBuilder& rr_graph_builder,
+                               const int layer,
+                               const int x_coord,
+                               const int y_coord,
+                               const e_rr_type chan_type,
+                               const int cost_index_offset,
+                               const int tracks_per_chan,
+                               const t_chan_details& chan_details_x,
+                               const t_chan_details& chan_details_y) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    auto& mutable_device_ctx = g_vpr_ctx.mutable_device();
+
+    // Same coordinate set up and segment walk as build_rr_chan_edges()
+    int seg_coord = x_coord;
+    int chan_coord = y_coord;
+    int seg_dimension = device_ctx.grid.width() - 2;
+    if (chan_type == e_rr_type::CHANY) {
+        std::swap(seg_coord, chan_coord);
+        seg_dimension = device_ctx.grid.height() - 2;
+    }
+
+    const t_chan_details& from_chan_details = (chan_type == e_rr_type::CHANX) ? chan_details_x : chan_details_y;
+    const t_chan_seg_details* seg_details = from_chan_details[x_coord][y_coord].data();
+
+    for (int track = 0; track < tracks_per_chan; ++track) {
+        if (seg_details[track].length() == 0)
+            continue;
+
+        int start = get_seg_start(seg_details, track, chan_coord, seg_coord);
+        int end = get_seg_end(seg_details, track, start, chan_coord, seg_dimension);
+
+        if (seg_coord > start) {
+            continue; // Only process segments which start at this location
+        }
+
+        RRNodeId node = rr_graph_builder.node_lookup().find_node(layer, x_coord, y_coord, chan_type, track);
+
+        if (!node) {
+            continue;
+        }
+
         // AA: The cost_index should be w.r.t the index of the segment to its **parallel** segment_inf vector.
         // Note that when building channels, we use the indices w.r.t segment_inf_x and segment_inf_y as
         // computed earlier in build_rr_graph so it's fine to use .index() for to get the correct index.
@@ -3344,12 +3536,38 @@ static RRNodeId pick_best_direct_connect_target_rr_node(const RRGraphView& rr_gr
 static void create_edge_groups(EdgeGroups* groups) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
-    rr_graph.rr_nodes().for_each_edge(
-        [&](RREdgeId edge, RRNodeId src, RRNodeId sink) {
-            if (!rr_graph.rr_switch_inf(RRSwitchId(rr_graph.rr_nodes().edge_switch(edge))).configurable()) {
-                groups->add_non_config_edge(src, sink);
+
+    //Scan the edges of blocks of nodes in parallel. The blocks are fixed, and their edges added
+    //in order, so the groups don't depend on the number of threads
+    constexpr size_t NODES_PER_BLOCK = 4096;
+    const size_t num_nodes = rr_graph.num_nodes();
+    const size_t num_blocks = (num_nodes + NODES_PER_BLOCK - 1) / NODES_PER_BLOCK;
+    std::vector<std::vector<std::pair<RRNodeId, RRNodeId>>> block_edges(num_blocks);
+
+    auto scan_block = [&](size_t iblock) {
+        size_t end = std::min(num_nodes, (iblock + 1) * NODES_PER_BLOCK);
+        for (size_t inode = iblock * NODES_PER_BLOCK; inode < end; inode++) {
+            RRNodeId src(inode);
+            for (t_edge_size iedge : rr_graph.edges(src)) {
+                if (!rr_graph.edge_is_configurable(src, iedge)) {
+                    block_edges[iblock].emplace_back(src, rr_graph.edge_sink_node(src, iedge));
+                }
             }
-        });
+        }
+    };
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), num_blocks, scan_block);
+#else
+    for (size_t iblock = 0; iblock < num_blocks; iblock++) {
+        scan_block(iblock);
+    }
+#endif
+
+    for (const auto& edges : block_edges) {
+        for (const auto& edge : edges) {
+            groups->add_non_config_edge(edge.first, edge.second);
+        }
+    }
 
     groups->create_sets();
 }
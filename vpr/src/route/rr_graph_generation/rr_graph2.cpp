@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <atomic>
 
 #include "physical_types_util.h"
 #include "vpr_utils.h"
@@ -1545,10 +1546,15 @@ static int get_unidir_track_to_chan_seg(RRGraphBuilder& rr_graph_builder,
             if (to_mux == UN_SET)
                 continue;
 
-            int to_track = sblock_pattern[sb_x][sb_y][from_side][to_side][from_track][j + 1];
+            // The channel edges may be built from several threads, and neighbouring channels
+            // share switch block entries. The lazily assigned track only depends on the entry
+            // itself (i == 0 on first use), so concurrent writers always store the same value;
+            // atomic_ref just makes those accesses well-defined.
+            std::atomic_ref<short> to_track_entry(sblock_pattern[sb_x][sb_y][from_side][to_side][from_track][j + 1]);
+            int to_track = to_track_entry.load(std::memory_order_relaxed);
             if (to_track == UN_SET) {
                 to_track = mux_labels[(to_mux + i) % num_labels];
-                sblock_pattern[sb_x][sb_y][from_side][to_side][from_track][j + 1] = to_track;
+                to_track_entry.store(static_cast<short>(to_track), std::memory_order_relaxed);
             }
             RRNodeId to_node = rr_graph_builder.node_lookup().find_node(layer, to_x, to_y, to_type, to_track);
 
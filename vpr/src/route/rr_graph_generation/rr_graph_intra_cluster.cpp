@@ -424,7 +424,11 @@ static void add_pb_edges(RRGraphBuilder& rr_graph_builder,
         }
 
         RRNodeId parent_pin_node_id = get_pin_rr_node_id(rr_graph_builder.node_lookup(), physical_type, root_loc, pin_physical_num);
-        VTR_ASSERT(parent_pin_node_id != RRNodeId::INVALID());
+        // The pin is not added to the RR Graph if it is not on any path between the cluster's tile and primitive pins
+        if (parent_pin_node_id == RRNodeId::INVALID()) {
+            VTR_ASSERT(!primitive_pin && !pin_on_tile);
+            continue;
+        }
 
         std::vector<int> conn_pins_physical_num = get_physical_pin_sink_pins(physical_type, logical_block, pin_physical_num);
 
@@ -0,0 +1,83 @@
+#include "rr_graph_track_mask.h"
+
+#include "globals.h"
+#include "vtr_log.h"
+
+/// @brief Whether the channels of wide_chan_width are all at least as wide as the ones of chan_width
+static bool is_chan_width_at_least(const t_chan_width& wide_chan_width, const t_chan_width& chan_width) {
+    if (wide_chan_width.x_list.size() != chan_width.x_list.size() || wide_chan_width.y_list.size() != chan_width.y_list.size()) {
+        return false;
+    }
+    for (size_t y = 0; y < chan_width.x_list.size(); y++) {
+        if (wide_chan_width.x_list[y] < chan_width.x_list[y]) {
+            return false;
+        }
+    }
+    for (size_t x = 0; x < chan_width.y_list.size(); x++) {
+        if (wide_chan_width.y_list[x] < chan_width.y_list[x]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool mask_rr_graph_tracks(const t_chan_width& chan_width, e_graph_type graph_type, bool is_flat) {
+    DeviceContext& device_ctx = g_vpr_ctx.mutable_device();
+    const RRGraphView& rr_graph = device_ctx.rr_graph;
+
+    if (rr_graph.empty()
+        || graph_type == e_graph_type::UNIDIR_TILEABLE
+        || !device_ctx.loaded_rr_graph_filename.empty()
+        || device_ctx.rr_graph_is_flat != is_flat) {
+        return false;
+    }
+
+    const t_chan_width& built_chan_width = device_ctx.rr_graph_built_chan_width ? *device_ctx.rr_graph_built_chan_width : device_ctx.chan_width;
+    if (!is_chan_width_at_least(built_chan_width, chan_width)) {
+        return false;
+    }
+
+    unmask_rr_graph_tracks();
+    device_ctx.rr_graph_built_chan_width = device_ctx.chan_width;
+
+    for (RRNodeId node : rr_graph.nodes()) {
+        e_rr_type type = rr_graph.node_type(node);
+        if (!is_chanxy(type)) {
+            continue;
+        }
+
+        int width = (type == e_rr_type::CHANX) ? chan_width.x_list[rr_graph.node_ylow(node)] : chan_width.y_list[rr_graph.node_xlow(node)];
+        if (rr_graph.node_track_num(node) >= width) {
+            device_ctx.masked_rr_node_capacities.emplace_back(node, rr_graph.node_capacity(node));
+            device_ctx.rr_graph_builder.set_node_capacity(node, 0);
+        }
+    }
+    device_ctx.chan_width = chan_width;
+
+    VTR_LOG("Reusing the RR graph built for a channel width of %d at a channel width of %d (%zu tracks masked off)\n",
+            device_ctx.rr_graph_built_chan_width->max, chan_width.max, device_ctx.masked_rr_node_capacities.size());
+    return true;
+}
+
+void unmask_rr_graph_tracks() {
+    DeviceContext& device_ctx = g_vpr_ctx.mutable_device();
+
+    for (const auto& [node, capacity] : device_ctx.masked_rr_node_capacities) {
+        device_ctx.rr_graph_builder.set_node_capacity(node, capacity);
+    }
+    device_ctx.masked_rr_node_capacities.clear();
+
+    if (device_ctx.rr_graph_built_chan_width) {
+        device_ctx.chan_width = *device_ctx.rr_graph_built_chan_width;
+        device_ctx.rr_graph_built_chan_width = vtr::nullopt;
+    }
+}
+
+bool is_masked_rr_track(RRNodeId node) {
+    const DeviceContext& device_ctx = g_vpr_ctx.device();
+    const RRGraphView& rr_graph = device_ctx.rr_graph;
+
+    return device_ctx.rr_graph_built_chan_width
+           && is_chanxy(rr_graph.node_type(node))
+           && rr_graph.node_capacity(node) == 0;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Reuse of an RR graph for narrower channel widths by masking off its extra tracks.
+ *
+ * The minimum channel width search routes the same design at many channel widths, and used to
+ * rebuild the RR graph (and its router lookahead) for each of them. An RR graph built for a wider
+ * channel width can instead be reused for a narrower one: the tracks at or above the width of their
+ * channel are masked off by setting their capacity to 0. The initial acc_cost of the masked tracks
+ * is huge (see comp_initial_acc_cost()), so the router does not use them, and a routing using one
+ * of them is not legal.
+ *
+ * The connection and switch block patterns are the ones of the wider RR graph, so this is an
+ * approximation of the RR graph which would be built for the narrower channel width.
+ */
+
+#include "rr_graph_fwd.h"
+#include "rr_graph_type.h"
+
+///@brief Initial acc_cost of the masked tracks: high enough for the router to never use them
+constexpr float MASKED_TRACK_ACC_COST = 1e12f;
+
+/**
+ * @brief Masks off the tracks of the RR graph built above the channel widths, if the RR graph can be reused
+ *        for them (i.e. was built, not loaded, for channel widths at least as wide, and is not tileable).
+ *
+ * The tracks masked for a previous channel width are unmasked first. On success, the device channel widths
+ * are set to chan_width.
+ *
+ * @return Whether the RR graph was reused. If not, the RR graph is left unchanged.
+ */
+bool mask_rr_graph_tracks(const t_chan_width& chan_width, e_graph_type graph_type, bool is_flat);
+
+///@brief Restores the capacities of the masked tracks, and the device channel widths to the ones the RR graph was built for
+void unmask_rr_graph_tracks();
+
+///@brief Whether the RR node is a track masked off by mask_rr_graph_tracks()
+bool is_masked_rr_track(RRNodeId node);
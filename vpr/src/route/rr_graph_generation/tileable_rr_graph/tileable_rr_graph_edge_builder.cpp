@@ -4,6 +4,10 @@
  ***********************************************************************/
 #include <algorithm>
 
+#ifdef VPR_USE_TBB
+#include <tbb/parallel_for.h>
+#endif // VPR_USE_TBB
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -15,6 +19,14 @@
 #include "tileable_rr_graph_gsb.h"
 #include "tileable_rr_graph_edge_builder.h"
 
+/* The connections found for one GSB, before its edges are created */
+struct t_gsb_connections {
+    RRGSB rr_gsb;
+    t_track2pin_map track2ipin_map;   /* [0..track_gsb_side][0..num_tracks][ipin_indices] */
+    t_pin2track_map opin2track_map;   /* [0..gsb_side][0..num_opin_node][track_indices] */
+    t_track2track_map sb_conn;        /* [0..from_gsb_side][0..chan_width-1][track_indices] */
+};
+
 /************************************************************************
  * Build the edges for all the SOURCE and SINKs nodes:
  * 1. create edges between SOURCE and OPINs
@@ -318,36 +330,48 @@ void build_rr_graph_regular_edges(const RRGraphView& rr_graph,
 
     vtr::Point<size_t> gsb_range(grids.width() - 1, grids.height() - 1);
 
-    /* Go Switch Block by Switch Block */
-    for (size_t ix = 0; ix <= gsb_range.x(); ++ix) {
-        for (size_t iy = 0; iy <= gsb_range.y(); ++iy) {
-            //vpr_printf(TIO_MESSAGE_INFO, "Building edges for GSB[%lu][%lu]\n", ix, iy);
-
-            vtr::Point<size_t> gsb_coord(ix, iy);
-            /* Create a GSB object */
-            const RRGSB& rr_gsb = build_one_tileable_rr_gsb(grids, rr_graph,
-                                                            device_chan_width, segment_inf_x, segment_inf_y,
-                                                            layer, gsb_coord, perimeter_cb);
+    /* The connections of a GSB only depend on the nodes of the graph, so the connections of
+     * the GSBs of a column are found in parallel. The edges are then created GSB by GSB,
+     * in the same order as a serial build, so the graph does not depend on the number of threads.
+     */
+    std::vector<t_gsb_connections> column_gsbs(gsb_range.y() + 1);
+    auto find_gsb_connections = [&](size_t ix, size_t iy) {
+        vtr::Point<size_t> gsb_coord(ix, iy);
+        t_gsb_connections& gsb = column_gsbs[iy];
+        /* Create a GSB object */
+        gsb.rr_gsb = build_one_tileable_rr_gsb(grids, rr_graph,
+                                               device_chan_width, segment_inf_x, segment_inf_y,
+                                               layer, gsb_coord, perimeter_cb);
 
-            /* adapt the track_to_ipin_lookup for the GSB nodes */
-            t_track2pin_map track2ipin_map; /* [0..track_gsb_side][0..num_tracks][ipin_indices] */
-            track2ipin_map = build_gsb_track_to_ipin_map(rr_graph, rr_gsb, grids, segment_inf, Fc_in);
+        /* adapt the track_to_ipin_lookup for the GSB nodes */
+        gsb.track2ipin_map = build_gsb_track_to_ipin_map(rr_graph, gsb.rr_gsb, grids, segment_inf, Fc_in);
 
-            /* adapt the opin_to_track_map for the GSB nodes */
-            t_pin2track_map opin2track_map; /* [0..gsb_side][0..num_opin_node][track_indices] */
-            opin2track_map = build_gsb_opin_to_track_map(rr_graph, rr_gsb, grids, segment_inf, Fc_out, opin2all_sides);
+        /* adapt the opin_to_track_map for the GSB nodes */
+        gsb.opin2track_map = build_gsb_opin_to_track_map(rr_graph, gsb.rr_gsb, grids, segment_inf, Fc_out, opin2all_sides);
 
-            /* adapt the switch_block_conn for the GSB nodes */
-            t_track2track_map sb_conn; /* [0..from_gsb_side][0..chan_width-1][track_indices] */
-            sb_conn = build_gsb_track_to_track_map(rr_graph, rr_gsb,
+        /* adapt the switch_block_conn for the GSB nodes */
+        gsb.sb_conn = build_gsb_track_to_track_map(rr_graph, gsb.rr_gsb,
                                                    sb_type, Fs, sb_subtype, sub_fs, concat_wire, wire_opposite_side,
                                                    segment_inf);
+    };
 
+    /* Go Switch Block by Switch Block */
+    for (size_t ix = 0; ix <= gsb_range.x(); ++ix) {
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(size_t(0), column_gsbs.size(), [&](size_t iy) {
+            find_gsb_connections(ix, iy);
+        });
+#else
+        for (size_t iy = 0; iy < column_gsbs.size(); ++iy) {
+            find_gsb_connections(ix, iy);
+        }
+#endif // VPR_USE_TBB
+
+        for (const t_gsb_connections& gsb : column_gsbs) {
             /* Build edges for a GSB */
-            /* Build edges for a GSB */
-            build_edges_for_one_tileable_rr_gsb(rr_graph_builder, rr_gsb,
-                                                track2ipin_map, opin2track_map,
-                                                sb_conn, rr_node_driver_switches, num_edges_to_create);
+            build_edges_for_one_tileable_rr_gsb(rr_graph_builder, gsb.rr_gsb,
+                                                gsb.track2ipin_map, gsb.opin2track_map,
+                                                gsb.sb_conn, rr_node_driver_switches, num_edges_to_create);
             /* Finish this GSB, go to the next*/
             rr_graph_builder.build_edges(true);
         }
@@ -1,6 +1,7 @@
 #include "serial_connection_router.h"
 
 #include <algorithm>
+#include "bucket_heap.h"
 #include "d_ary_heap.h"
 #include "rr_graph_fwd.h"
 
@@ -10,6 +11,14 @@ inline void update_serial_router_stats(RouterStats* router_stats,
                                        RRNodeId rr_node_id,
                                        const RRGraphView* rr_graph);
 
+/** Manhattan distance (in tiles, plus layers) between the spans of two RR nodes */
+inline int rr_node_distance(const RRGraphView* rr_graph, RRNodeId a, RRNodeId b) {
+    int dx = std::max({0, rr_graph->node_xlow(a) - rr_graph->node_xhigh(b), rr_graph->node_xlow(b) - rr_graph->node_xhigh(a)});
+    int dy = std::max({0, rr_graph->node_ylow(a) - rr_graph->node_yhigh(b), rr_graph->node_ylow(b) - rr_graph->node_yhigh(a)});
+    int dlayer = std::max({0, rr_graph->node_layer_low(a) - rr_graph->node_layer_high(b), rr_graph->node_layer_low(b) - rr_graph->node_layer_high(a)});
+    return dx + dy + dlayer;
+}
+
 template<typename Heap>
 void SerialConnectionRouter<Heap>::timing_driven_find_single_shortest_path_from_heap(RRNodeId sink_node,
                                                                                      const t_conn_cost_params& cost_params,
@@ -18,6 +27,11 @@ void SerialConnectionRouter<Heap>::timing_driven_find_single_shortest_path_from_
     const auto& device_ctx = g_vpr_ctx.device();
     auto& route_ctx = g_vpr_ctx.mutable_routing();
 
+    if (cost_params.bidirectional_search && this->rr_nodes_.has_reverse_edges() && !this->rcv_path_manager.is_enabled()) {
+        timing_driven_find_single_shortest_path_bidirectional(sink_node, cost_params, bounding_box, target_bb);
+        return;
+    }
+
     HeapNode cheapest;
     while (this->heap_.try_pop(cheapest)) {
         // Pop a new inode with the cheapest total cost in current route tree to be expanded on
@@ -55,6 +69,196 @@ void SerialConnectionRouter<Heap>::timing_driven_find_single_shortest_path_from_
     }
 }
 
+template<typename Heap>
+void SerialConnectionRouter<Heap>::timing_driven_find_single_shortest_path_bidirectional(RRNodeId sink_node,
+                                                                                         const t_conn_cost_params& cost_params,
+                                                                                         const t_bb& bounding_box,
+                                                                                         const t_bb& target_bb) {
+    if (reverse_node_inf_.size() != this->rr_node_route_inf_.size()) {
+        reverse_node_inf_.clear();
+        reverse_node_inf_.resize(this->rr_node_route_inf_.size());
+    }
+
+    // Set up with the first (cheapest) route tree node popped
+    RRNodeId reverse_target = RRNodeId::INVALID();
+    float cost_per_tile = 0.;
+
+    RRNodeId meet_node = RRNodeId::INVALID();
+    HeapNode cheapest;
+    while (this->heap_.try_pop(cheapest)) {
+        // One step of the forward search
+        const auto& [new_total_cost, inode] = cheapest;
+        update_serial_router_stats(this->router_stats_,
+                                   /*is_push=*/false,
+                                   inode,
+                                   this->rr_graph_);
+
+        if (inode == sink_node) {
+            // The forward search reached the target by itself
+            VTR_LOGV_DEBUG(this->router_debug_, "  Found target %8d\n", inode);
+            break;
+        }
+
+        if (reverse_target == RRNodeId::INVALID()) {
+            // The reverse search heads towards the route tree node the lookahead found cheapest,
+            // at the cost per tile the lookahead expects for this connection
+            reverse_target = inode;
+            int distance = rr_node_distance(this->rr_graph_, inode, sink_node);
+            if (distance > 0) {
+                cost_per_tile = std::max(0.f, new_total_cost - this->rr_node_route_inf_[inode].backward_path_cost) / distance;
+            }
+
+            modified_reverse_node_inf_.push_back(sink_node);
+            reverse_node_inf_[sink_node].path_cost = 0.;
+            reverse_node_inf_[sink_node].total_cost = cost_per_tile * rr_node_distance(this->rr_graph_, sink_node, reverse_target);
+            reverse_heap_.add_to_heap({reverse_node_inf_[sink_node].total_cost, sink_node});
+        }
+
+        if (this->rr_node_route_inf_[inode].path_cost == new_total_cost && !std::isinf(reverse_node_inf_[inode].path_cost)) {
+            meet_node = inode;
+            break;
+        }
+
+        timing_driven_expand_cheapest(inode,
+                                      new_total_cost,
+                                      sink_node,
+                                      cost_params,
+                                      bounding_box,
+                                      target_bb);
+
+        // One step of the reverse search
+        HeapNode reverse_cheapest;
+        if (reverse_heap_.try_pop(reverse_cheapest)) {
+            const auto& [reverse_total_cost, reverse_inode] = reverse_cheapest;
+            update_serial_router_stats(this->router_stats_,
+                                       /*is_push=*/false,
+                                       reverse_inode,
+                                       this->rr_graph_);
+
+            if (reverse_total_cost == reverse_node_inf_[reverse_inode].total_cost) {
+                if (!std::isinf(this->rr_node_route_inf_[reverse_inode].path_cost)) {
+                    meet_node = reverse_inode;
+                    break;
+                }
+                timing_driven_expand_reverse_neighbours(reverse_inode, cost_params, bounding_box, reverse_target, cost_per_tile);
+            }
+        }
+    }
+
+    if (meet_node != RRNodeId::INVALID()) {
+        VTR_LOGV_DEBUG(this->router_debug_, "  Forward and reverse searches met at node %d\n", meet_node);
+        splice_reverse_path(meet_node, sink_node);
+    }
+
+    reset_reverse_search();
+}
+
+template<typename Heap>
+void SerialConnectionRouter<Heap>::timing_driven_expand_reverse_neighbours(RRNodeId to_node,
+                                                                           const t_conn_cost_params& cost_params,
+                                                                           const t_bb& bounding_box,
+                                                                           RRNodeId reverse_target,
+                                                                           float cost_per_tile) {
+    // The cost of reaching to_node from any of its fan-in nodes, as in evaluate_timing_driven_node_backward_costs()
+    // but with the upstream resistance unknown (i.e. as if reached through a buffered switch)
+    auto rc_index = this->rr_graph_->node_rc_index(to_node);
+    float node_C = this->rr_rc_data_[rc_index].C;
+    float node_R = this->rr_rc_data_[rc_index].R;
+    float to_cong_cost = get_rr_cong_cost(to_node, cost_params.pres_fac);
+    e_rr_type to_type = this->rr_graph_->node_type(to_node);
+    float to_path_cost = reverse_node_inf_[to_node].path_cost;
+
+    vtr::array_view<const RREdgeId> edges = this->rr_nodes_.reverse_edges(to_node);
+    vtr::array_view<const RRNodeId> from_nodes = this->rr_nodes_.reverse_edge_src_nodes(to_node);
+    for (size_t iedge = 0; iedge < edges.size(); iedge++) {
+        RREdgeId edge = edges[iedge];
+        RRNodeId from_node = from_nodes[iedge];
+
+        if (!inside_bb(from_node, bounding_box)) {
+            continue;
+        }
+
+        // Pins of other blocks can't be on the path from the route tree: only expand the ones the forward search reached
+        e_rr_type from_type = this->rr_graph_->node_type(from_node);
+        if ((from_type == e_rr_type::SOURCE || from_type == e_rr_type::OPIN) && std::isinf(this->rr_node_route_inf_[from_node].path_cost)) {
+            continue;
+        }
+
+        const t_rr_switch_inf& rr_switch = this->rr_switch_inf_[this->rr_nodes_.edge_switch(edge)];
+        float Tdel = rr_switch.Tdel + (rr_switch.R + 0.5 * node_R) * node_C;
+        float cong_cost = rr_switch.configurable() ? to_cong_cost : 0.;
+
+        float path_cost = to_path_cost;
+        path_cost += (1. - cost_params.criticality) * cong_cost;
+        path_cost += cost_params.criticality * Tdel;
+        if (cost_params.bend_cost != 0.
+            && ((from_type == e_rr_type::CHANX && to_type == e_rr_type::CHANY) || (from_type == e_rr_type::CHANY && to_type == e_rr_type::CHANX))) {
+            path_cost += cost_params.bend_cost;
+        }
+
+        t_reverse_node_inf& from_inf = reverse_node_inf_[from_node];
+        if (path_cost >= from_inf.path_cost) {
+            continue;
+        }
+        if (std::isinf(from_inf.path_cost)) {
+            modified_reverse_node_inf_.push_back(from_node);
+        }
+        from_inf.path_cost = path_cost;
+        from_inf.total_cost = path_cost + cost_per_tile * rr_node_distance(this->rr_graph_, from_node, reverse_target);
+        from_inf.next_edge = edge;
+
+        reverse_heap_.add_to_heap({from_inf.total_cost, from_node});
+        update_serial_router_stats(this->router_stats_,
+                                   /*is_push=*/true,
+                                   from_node,
+                                   this->rr_graph_);
+    }
+}
+
+template<typename Heap>
+void SerialConnectionRouter<Heap>::splice_reverse_path(RRNodeId meet_node, RRNodeId sink_node) {
+    // Nodes of the forward path to meet_node
+    std::vector<RRNodeId> forward_path;
+    for (RRNodeId node = meet_node;;) {
+        forward_path.push_back(node);
+        RREdgeId prev_edge = this->rr_node_route_inf_[node].prev_edge;
+        if (prev_edge == RREdgeId::INVALID()) {
+            break;
+        }
+        node = this->rr_graph_->edge_src_node(prev_edge);
+    }
+    std::sort(forward_path.begin(), forward_path.end());
+
+    // If the reverse path goes through the forward path again, splice it from the last
+    // node they share instead, so the spliced path has no loop
+    for (RRNodeId node = meet_node; node != sink_node;) {
+        node = this->rr_nodes_.edge_sink_node(reverse_node_inf_[node].next_edge);
+        if (std::binary_search(forward_path.begin(), forward_path.end(), node)) {
+            meet_node = node;
+        }
+    }
+
+    float total_cost = this->rr_node_route_inf_[meet_node].backward_path_cost + reverse_node_inf_[meet_node].path_cost;
+    for (RRNodeId node = meet_node; node != sink_node;) {
+        RREdgeId next_edge = reverse_node_inf_[node].next_edge;
+        node = this->rr_nodes_.edge_sink_node(next_edge);
+
+        add_to_mod_list(node);
+        this->rr_node_route_inf_[node].prev_edge = next_edge;
+        this->rr_node_route_inf_[node].path_cost = total_cost;
+        this->rr_node_route_inf_[node].backward_path_cost = total_cost - reverse_node_inf_[node].path_cost;
+    }
+}
+
+template<typename Heap>
+void SerialConnectionRouter<Heap>::reset_reverse_search() {
+    for (RRNodeId node : modified_reverse_node_inf_) {
+        reverse_node_inf_[node] = t_reverse_node_inf();
+    }
+    modified_reverse_node_inf_.clear();
+    reverse_heap_.empty_heap();
+}
+
 template<typename Heap>
 vtr::vector<RRNodeId, RTExploredNode> SerialConnectionRouter<Heap>::timing_driven_find_all_shortest_paths_from_route_tree(
     const RouteTreeNode& rt_root,
@@ -341,11 +545,23 @@ void SerialConnectionRouter<Heap>::timing_driven_add_to_heap(const t_conn_cost_p
         next.path_data->backward_delay = this->rcv_path_data[from_node]->backward_delay;
     }
 
-    this->evaluate_timing_driven_node_costs(&next, cost_params, from_node, target_node);
+    this->evaluate_timing_driven_node_backward_costs(&next, cost_params, from_node);
 
     float best_total_cost = this->rr_node_route_inf_[to_node].path_cost;
     float best_back_cost = this->rr_node_route_inf_[to_node].backward_path_cost;
 
+    // Without RCV, pre-heap pruning only looks at the backward cost. Prune here, before
+    // asking the router lookahead for the expected cost: most neighbours of a popped node
+    // have been reached through a cheaper path already, and the lookahead query is the
+    // expensive part of evaluating the node costs.
+    if (!this->rcv_path_manager.is_enabled() && best_back_cost <= next.backward_path_cost) {
+        VTR_LOGV_DEBUG(this->router_debug_, "      Didn't expand to %d (%s)\n", to_node, describe_rr_node(device_ctx.rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, to_node, this->is_flat_).c_str());
+        VTR_LOGV_DEBUG(this->router_debug_, "        Prev back Cost %g New back Cost %g \n", best_back_cost, next.backward_path_cost);
+        return;
+    }
+
+    this->evaluate_timing_driven_node_total_cost(&next, cost_params, target_node);
+
     float new_total_cost = next.total_cost;
     float new_back_cost = next.backward_path_cost;
 
@@ -416,7 +632,7 @@ void SerialConnectionRouter<Heap>::add_route_tree_node_to_heap(
     // float expected_cost = router_lookahead_.get_expected_cost(inode, target_node, cost_params, R_upstream);
 
     if (!this->rcv_path_manager.is_enabled()) {
-        float expected_cost = this->router_lookahead_.get_expected_cost(inode, target_node, cost_params, R_upstream);
+        float expected_cost = this->get_expected_cost(inode, target_node, cost_params, R_upstream);
         float tot_cost = backward_path_cost + cost_params.astar_fac * std::max(0.f, expected_cost - cost_params.astar_offset);
         VTR_LOGV_DEBUG(this->router_debug_, "  Adding node %8d to heap from init route tree with cost %g (%s)\n",
                        inode,
@@ -490,6 +706,17 @@ std::unique_ptr<ConnectionRouterInterface> make_serial_connection_router(e_heap_
                 rr_node_route_inf,
                 is_flat,
                 route_verbosity);
+        case e_heap_type::BUCKET_HEAP:
+            return std::make_unique<SerialConnectionRouter<BucketHeap>>(
+                grid,
+                router_lookahead,
+                rr_nodes,
+                rr_graph,
+                rr_rc_data,
+                rr_switch_inf,
+                rr_node_route_inf,
+                is_flat,
+                route_verbosity);
         default:
             VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap_type %d",
                             heap_type);
@@ -21,6 +21,7 @@ class SerialConnectionRouter : public ConnectionRouter<HeapImplementation> {
         bool is_flat,
         int route_verbosity)
         : ConnectionRouter<HeapImplementation>(grid, router_lookahead, rr_nodes, rr_graph, rr_rc_data, rr_switch_inf, rr_node_route_inf, is_flat, route_verbosity) {
+        reverse_heap_.init_heap(grid);
     }
 
     ~SerialConnectionRouter() {
@@ -64,6 +65,15 @@ class SerialConnectionRouter : public ConnectionRouter<HeapImplementation> {
         }
     }
 
+    /**
+     * @brief Memoizes up to num_entries lookahead costs (see lookahead_cost_cache.h)
+     * @note Has no effect (the cache stays disabled) if the costs of the lookahead can't be memoized.
+     * @param num_entries Number of cached costs (rounded up to a power of two), 0 to disable the cache
+     */
+    void set_lookahead_cache_size(size_t num_entries) {
+        this->lookahead_cost_cache_.resize(this->router_lookahead_.is_cost_cacheable() ? num_entries : 0);
+    }
+
     /**
      * @brief Finds shortest paths from the route tree rooted at rt_root to all sinks available
      * @note Unlike timing_driven_route_connection_from_route_tree(), only part of the route tree which
@@ -132,6 +142,53 @@ class SerialConnectionRouter : public ConnectionRouter<HeapImplementation> {
                                                            const t_bb& bounding_box,
                                                            const t_bb& target_bb) final;
 
+    /**
+     * @brief Bidirectional variant of timing_driven_find_single_shortest_path_from_heap(), used for
+     * connections with cost_params.bidirectional_search set (long, non-critical connections).
+     *
+     * The forward search expands from the current heap (i.e. the route tree) as usual, alternating with
+     * a reverse search from sink_node over the reverse edge index of the RR graph. The reverse search is
+     * guided by the per-tile cost the lookahead predicted for the connection, towards the route tree node
+     * it found cheapest. The search stops at the first node popped by one search which was already reached
+     * by the other, and the reverse path from that node is spliced into rr_node_route_inf_ so the sink can be
+     * traced back as for a forward search. Two wavefronts meeting half way expand far fewer nodes than one
+     * sweeping the whole distance.
+     *
+     * The reverse costs don't know the upstream resistance of the nodes, so the delays they estimate are
+     * optimistic for unbuffered switches: this is why only low criticality connections use this mode.
+     * @param sink_node Sink node ID to route to
+     * @param cost_params Cost function parameters
+     * @param bounding_box Keep search confined to this bounding box
+     * @param target_bb Prune IPINs that lead to blocks other than the target block
+     */
+    void timing_driven_find_single_shortest_path_bidirectional(RRNodeId sink_node,
+                                                               const t_conn_cost_params& cost_params,
+                                                               const t_bb& bounding_box,
+                                                               const t_bb& target_bb);
+
+    /**
+     * @brief Expands the fan-in of a node popped by the reverse search of the bidirectional search
+     * @param to_node Node whose incoming edges are expanded (the path continues from it to the sink)
+     * @param cost_params Cost function parameters
+     * @param bounding_box Keep search confined to this bounding box
+     * @param reverse_target Node the reverse search heads towards
+     * @param cost_per_tile Expected cost per tile of distance to reverse_target
+     */
+    void timing_driven_expand_reverse_neighbours(RRNodeId to_node,
+                                                 const t_conn_cost_params& cost_params,
+                                                 const t_bb& bounding_box,
+                                                 RRNodeId reverse_target,
+                                                 float cost_per_tile);
+
+    /**
+     * @brief Links the reverse search path from meet_node to sink_node into rr_node_route_inf_
+     * (prev_edge and costs), after the forward path to meet_node.
+     */
+    void splice_reverse_path(RRNodeId meet_node, RRNodeId sink_node);
+
+    /** @brief Resets the state of the reverse search of the bidirectional search */
+    void reset_reverse_search();
+
     /**
      * @brief Expands this current node if it is a cheaper path
      * @param from_node Current node ID being explored
@@ -232,6 +289,24 @@ class SerialConnectionRouter : public ConnectionRouter<HeapImplementation> {
 
     /** Node IDs of modified nodes in rr_node_route_inf */
     std::vector<RRNodeId> modified_rr_node_inf_;
+
+    /** Reverse search state of a node (bidirectional search only) */
+    struct t_reverse_node_inf {
+        /** Known cost of the path from the node (excluded) to the sink */
+        float path_cost = std::numeric_limits<float>::infinity();
+        /** path_cost plus the expected cost from the route tree to the node (the heap key) */
+        float total_cost = std::numeric_limits<float>::infinity();
+        /** Edge from the node towards the sink on the cheapest known path */
+        RREdgeId next_edge = RREdgeId::INVALID();
+    };
+
+    //@{
+    /** Reverse search of the bidirectional search: the heap, the per-node state
+     * (allocated on first use) and the nodes whose state must be reset */
+    HeapImplementation reverse_heap_;
+    vtr::vector<RRNodeId, t_reverse_node_inf> reverse_node_inf_;
+    std::vector<RRNodeId> modified_reverse_node_inf_;
+    //@}
 };
 
 /** Construct a serial connection router that uses the specified heap type.
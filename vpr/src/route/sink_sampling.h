@@ -8,8 +8,11 @@
  * that the initial routing provides enough hints while routing to as
  * few sinks as possible. */
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <map>
+#include <utility>
 #include <vector>
 #include "globals.h"
 #include "partition_tree.h"
@@ -112,6 +115,60 @@ inline std::vector<SinkPoint> quickhull(const std::vector<SinkPoint>& points) {
     return std::vector<SinkPoint>(out.begin(), out.end());
 }
 
+/** Order the sinks of a high fanout net to route a skeleton of the net first.
+ *
+ * The grid is cut into bins of bin_width x bin_height (the bins of the net's SpatialRouteTreeLookup).
+ * The skeleton is the sink closest to the center of each bin; it is routed first, closest to the
+ * source first, so that the route tree reaches every bin early on. The remaining sinks follow in
+ * their original order: each of them then finds existing routing in its own bin, and its wave
+ * expansion is bounded by the spatial lookup instead of starting from the whole route tree.
+ *
+ * @param sinks Sinks to order, in the order they would be routed otherwise (e.g. by criticality)
+ * @return The isink of each sink, in the order they should be routed */
+inline std::vector<int> skeleton_first_order(const std::vector<SinkPoint>& sinks, const SinkPoint& source, int bin_width, int bin_height) {
+    /* Twice the distance to the bin center, to stay in integers */
+    auto dist_to_bin_center = [&](const SinkPoint& p) {
+        int center_x = 2 * (p.x / bin_width) * bin_width + bin_width - 1;
+        int center_y = 2 * (p.y / bin_height) * bin_height + bin_height - 1;
+        return abs(2 * p.x - center_x) + abs(2 * p.y - center_y);
+    };
+
+    /* Bin -> index of its skeleton sink. Ties go to the earlier sink */
+    std::map<std::pair<int, int>, size_t> bin_skeleton_sink;
+    for (size_t i = 0; i < sinks.size(); i++) {
+        std::pair<int, int> bin(sinks[i].x / bin_width, sinks[i].y / bin_height);
+        auto it = bin_skeleton_sink.find(bin);
+        if (it == bin_skeleton_sink.end()) {
+            bin_skeleton_sink.emplace(bin, i);
+        } else if (dist_to_bin_center(sinks[i]) < dist_to_bin_center(sinks[it->second])) {
+            it->second = i;
+        }
+    }
+
+    std::vector<size_t> skeleton;
+    std::vector<bool> is_skeleton(sinks.size(), false);
+    for (const auto& [bin, i] : bin_skeleton_sink) {
+        skeleton.push_back(i);
+        is_skeleton[i] = true;
+    }
+    /* Closest to the source first, keeping the original order between equally distant sinks */
+    std::sort(skeleton.begin(), skeleton.end());
+    std::stable_sort(skeleton.begin(), skeleton.end(), [&](size_t a, size_t b) {
+        return abs(sinks[a].x - source.x) + abs(sinks[a].y - source.y) < abs(sinks[b].x - source.x) + abs(sinks[b].y - source.y);
+    });
+
+    std::vector<int> order;
+    order.reserve(sinks.size());
+    for (size_t i : skeleton) {
+        order.push_back(sinks[i].isink);
+    }
+    for (size_t i = 0; i < sinks.size(); i++) {
+        if (!is_skeleton[i])
+            order.push_back(sinks[i].isink);
+    }
+    return order;
+}
+
 } // namespace sink_sampling
 
 /** Which side of the cutline is this RRNode on?
@@ -78,6 +78,16 @@ class ByteArray : public std::vector<char> {
         insert(end(), appendix.begin(), appendix.end());
     }
 
+    /**
+     * @brief Appends raw bytes to the end of the byte array.
+     *
+     * @param data A pointer to the bytes to append.
+     * @param size The number of bytes to append.
+     */
+    void append(const char* data, std::size_t size) {
+        insert(end(), data, data + size);
+    }
+
     /**
      * @brief Appends a byte to the end of the byte array.
      *
@@ -98,25 +108,15 @@ class ByteArray : public std::vector<char> {
      *
      * @param sequence A pointer to the sequence of characters to search for.
      * @param sequence_size The size of the sequence to search for.
+     * @param start_index The index to start the search from.
      * @return A `std::pair` where the first element is a boolean indicating whether the sequence was
      * found (`true`) or not (`false`), and the second element is the starting index of the sequence if
      * found.
      */
-    std::pair<bool, std::size_t> find_sequence(const char* sequence, std::size_t sequence_size) {
-        const std::size_t ssize = size();
-        if (ssize >= sequence_size) {
-            for (std::size_t i = 0; i <= ssize - sequence_size; ++i) {
-                bool found = true;
-                for (std::size_t j = 0; j < sequence_size; ++j) {
-                    if (at(i + j) != sequence[j]) {
-                        found = false;
-                        break;
-                    }
-                }
-                if (found) {
-                    return std::make_pair(true, i);
-                }
-            }
+    std::pair<bool, std::size_t> find_sequence(const char* sequence, std::size_t sequence_size, std::size_t start_index = 0) const {
+        std::size_t index = std::string_view(*this).find(std::string_view(sequence, sequence_size), start_index);
+        if (index != std::string_view::npos) {
+            return std::make_pair(true, index);
         }
         return std::make_pair(false, 0);
     }
@@ -13,6 +13,11 @@ inline const std::string KEY_DATA{"DATA"};
 inline const std::string KEY_STATUS{"STATUS"};
 inline const std::string ECHO_TELEGRAM_BODY{"ECHO"};
 
+// values of KEY_STATUS
+const int STATUS_FAIL = 0;
+const int STATUS_SUCCESS = 1;
+const int STATUS_IN_PROGRESS = 2; // partial result, the final response follows
+
 const unsigned char ZLIB_COMPRESSOR_ID = 'z';
 const unsigned char NONE_COMPRESSOR_ID = '\x0';
 
@@ -24,6 +29,14 @@ inline const std::string OPTION_PATH_ELEMENTS{"path_elements"};
 inline const std::string OPTION_HIGHLIGHT_MODE{"high_light_mode"};
 inline const std::string OPTION_DRAW_PATH_CONTOUR{"draw_path_contour"};
 
+// optional path list filters (regexes may not contain the ':' and ';' option separators, slacks are in ns)
+inline const std::string OPTION_PATH_FROM{"from"};
+inline const std::string OPTION_PATH_TO{"to"};
+inline const std::string OPTION_LAUNCH_CLOCK{"launch_clock"};
+inline const std::string OPTION_CAPTURE_CLOCK{"capture_clock"};
+inline const std::string OPTION_MIN_SLACK{"min_slack"};
+inline const std::string OPTION_MAX_SLACK{"max_slack"};
+
 inline const std::string KEY_SETUP_PATH_LIST{"setup"};
 inline const std::string KEY_HOLD_PATH_LIST{"hold"};
 
@@ -16,6 +16,14 @@ std::optional<int> try_convert_to_int(const std::string& str) {
     }
 }
 
+std::optional<float> try_convert_to_float(const std::string& str) {
+    try {
+        return vtr::atof(str);
+    } catch (const vtr::VtrError&) {
+        return std::nullopt;
+    }
+}
+
 static std::string get_pretty_str_from_double(double value) {
     std::ostringstream ss;
     ss << std::fixed << std::setprecision(2) << value; // Set precision to 2 digit after the decimal point
@@ -79,7 +79,7 @@ static ActivityStatus handle_receiving_data(sockpp::tcp6_socket& client, comm::T
 
     if ((bytes_actually_received > 0) && (bytes_actually_received <= CHUNK_MAX_BYTES_NUM)) {
         logger.queue(LogLevel::Detail, "received chunk:", get_pretty_size_str_from_bytes_num(bytes_actually_received));
-        telegram_buff.append(comm::ByteArray{received_message.c_str(), bytes_actually_received});
+        telegram_buff.append(received_message.data(), bytes_actually_received);
         status = ActivityStatus::CLIENT_ACTIVITY;
     }
 
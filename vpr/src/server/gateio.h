@@ -123,7 +123,8 @@ class TLogger {
  * Operable only with a single client. As soon as client connection is detected
  * it begins listening on the specified port number for incoming client requests,
  * collects and encapsulates them into tasks (see @ref Task).
- * The incoming tasks are extracted and handled by the top-level logic @ref TaskResolver in the main thread.
+ * The incoming tasks are extracted and handled by the top-level logic @ref TaskResolver in the main thread
+ * (which runs the heavy ones in its worker threads).
  * Once the tasks are resolved by the @ref TaskResolver, they are returned to be sent back to the client app as a response.
  * Moving @ref Task across threads happens in @ref server::update.
  * 
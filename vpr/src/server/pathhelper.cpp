@@ -9,6 +9,7 @@
 #include "RoutingDelayCalculator.h"
 #include "timing_info.h"
 
+#include <mutex>
 #include <sstream>
 
 namespace server {
@@ -32,10 +33,25 @@ static void collect_crit_path_metadata(std::stringstream& ss, const std::vector<
 /**
  * @brief Helper function to calculate critical path timing report with specified parameters.
  */
-CritPathsResultPtr calc_critical_path(const std::string& report_type, int crit_path_num, e_timing_report_detail details_level, bool is_flat_routing) {
+CritPathsResultPtr calc_critical_path(const std::string& report_type,
+                                      int crit_path_num,
+                                      e_timing_report_detail details_level,
+                                      bool is_flat_routing,
+                                      const CritPathsFilter& filter,
+                                      const std::function<bool()>& is_cancelled,
+                                      const std::function<void(std::string&&)>& on_partial_result) {
+    CritPathsResultPtr result = std::make_shared<CritPathsResult>();
+
+    //The timing path cache and the delay calculator (which lazily caches the edge delays) are shared across requests
+    static std::mutex calc_mutex;
+    std::unique_lock<std::mutex> lock(calc_mutex);
+    if (is_cancelled && is_cancelled()) {
+        return result;
+    }
+
     // shortcuts
-    const std::shared_ptr<SetupHoldTimingInfo>& timing_info = g_vpr_ctx.server().timing_info;
-    const std::shared_ptr<RoutingDelayCalculator>& routing_delay_calc = g_vpr_ctx.server().routing_delay_calc;
+    const std::shared_ptr<SetupHoldTimingInfo> timing_info = g_vpr_ctx.server().timing_info;
+    const std::shared_ptr<RoutingDelayCalculator> routing_delay_calc = g_vpr_ctx.server().routing_delay_calc;
 
     auto& timing_ctx = g_vpr_ctx.timing();
     auto& atom_ctx = g_vpr_ctx.atom();
@@ -51,20 +67,55 @@ CritPathsResultPtr calc_critical_path(const std::string& report_type, int crit_p
 
     tatum::TimingReporter timing_reporter(resolver, *timing_ctx.graph, *timing_ctx.constraints);
 
-    CritPathsResultPtr result = std::make_shared<CritPathsResult>();
+    //The paths are cached across requests, and only re-collected once the timing analysis changes
+    const std::shared_ptr<tatum::TimingPathCache> timing_path_cache = g_vpr_ctx.server().timing_path_cache;
+
+    if (filter.empty()) {
+        if (report_type == comm::KEY_SETUP_PATH_LIST) {
+            result->paths = timing_path_cache->worst_setup_timing_paths(*timing_info->setup_analyzer(), analysis_opts.timing_report_npaths);
+        } else if (report_type == comm::KEY_HOLD_PATH_LIST) {
+            result->paths = timing_path_cache->worst_hold_timing_paths(*timing_info->hold_analyzer(), analysis_opts.timing_report_npaths);
+        }
+    } else {
+        tatum::TimingPathFilter path_filter;
+        path_filter.launch_domain = filter.launch_domain;
+        path_filter.capture_domain = filter.capture_domain;
+        path_filter.min_slack = tatum::Time(filter.min_slack);
+        path_filter.max_slack = tatum::Time(filter.max_slack);
+        if (filter.from) {
+            path_filter.startpoint = [&](tatum::NodeId node) {
+                return std::regex_search(resolver.node_name(node), *filter.from);
+            };
+        }
+        if (filter.to) {
+            path_filter.endpoint = [&](tatum::NodeId node) {
+                return std::regex_search(resolver.node_name(node), *filter.to);
+            };
+        }
+
+        if (report_type == comm::KEY_SETUP_PATH_LIST) {
+            result->paths = timing_path_cache->query_setup_timing_paths(*timing_info->setup_analyzer(), path_filter, analysis_opts.timing_report_npaths);
+        } else if (report_type == comm::KEY_HOLD_PATH_LIST) {
+            result->paths = timing_path_cache->query_hold_timing_paths(*timing_info->hold_analyzer(), path_filter, analysis_opts.timing_report_npaths);
+        }
+    }
 
-    std::stringstream ss;
-    if (report_type == comm::KEY_SETUP_PATH_LIST) {
-        timing_reporter.report_timing_setup(result->paths, ss, *timing_info->setup_analyzer(), analysis_opts.timing_report_npaths);
-    } else if (report_type == comm::KEY_HOLD_PATH_LIST) {
-        timing_reporter.report_timing_hold(result->paths, ss, *timing_info->hold_analyzer(), analysis_opts.timing_report_npaths);
+    if (result->paths.empty() || (is_cancelled && is_cancelled())) {
+        result->paths.clear();
+        return result;
     }
 
-    if (!result->paths.empty()) {
-        collect_crit_path_metadata(ss, result->paths);
-        result->report = ss.str();
+    std::stringstream metadata_ss;
+    collect_crit_path_metadata(metadata_ss, result->paths);
+    if (on_partial_result) {
+        on_partial_result(metadata_ss.str());
     }
 
+    std::stringstream ss;
+    timing_reporter.report_timing(ss, result->paths);
+    ss << metadata_ss.str();
+    result->report = ss.str();
+
     return result;
 }
 
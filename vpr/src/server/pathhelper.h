@@ -5,6 +5,10 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <regex>
 
 #include "tatum/report/TimingPath.hpp"
 #include "vpr_types.h"
@@ -35,17 +39,67 @@ struct CritPathsResult {
 };
 using CritPathsResultPtr = std::shared_ptr<CritPathsResult>;
 
+/**
+ * @brief Structure to select the critical paths to report.
+ *
+ * The paths are queried from the index of the timing path cache (see @ref tatum::TimingPathCache),
+ * so that exploring the paths with different filters does not repeat the timing analysis nor the path tracing.
+ */
+struct CritPathsFilter {
+    /**
+     * @brief Checks if the filter selects all the paths.
+     */
+    bool empty() const {
+        return !from && !to && !launch_domain && !capture_domain
+               && min_slack == -std::numeric_limits<float>::infinity() && max_slack == std::numeric_limits<float>::infinity();
+    }
+
+    /**
+     * @brief Regex searched in the start-point pin names (any start-point if not set).
+     */
+    std::optional<std::regex> from;
+
+    /**
+     * @brief Regex searched in the end-point pin names (any end-point if not set).
+     */
+    std::optional<std::regex> to;
+
+    /**
+     * @brief Launch and capture clock domains (any domain if invalid).
+     */
+    tatum::DomainId launch_domain;
+    tatum::DomainId capture_domain;
+
+    /**
+     * @brief Slack range in seconds (inclusive).
+     */
+    float min_slack = -std::numeric_limits<float>::infinity();
+    float max_slack = std::numeric_limits<float>::infinity();
+};
+
 /**
  * @brief Calculates the critical path.
  *
  * This function calculates the critical path based on the provided parameters.
+ * It may be called from worker threads: the calculations, which share the timing path cache and the delay
+ * calculator caches of the server context, are serialized.
  * @param type The type of the critical path. Must be either "setup" or "hold".
  * @param crit_path_num The max number of critical paths to record.
  * @param details_level The level of detail for the timing report. See @ref e_timing_report_detail.
  * @param is_flat_routing Indicates whether flat routing should be used.
+ * @param filter Selects the paths to report, among the worst ones (see @ref CritPathsFilter).
+ * @param is_cancelled If set, polled between the calculation stages: the calculation is abandoned, with an empty result, once it returns true.
+ * @param on_partial_result If set, called with the report metadata (see the "#RPT METADATA" section of the report) once the paths are collected,
+ *                          before the (longer) generation of the report.
  * @return A `CritPathsResultPtr` which is a pointer to the result of the critical path calculation (see @ref CritPathsResult).
  */
-CritPathsResultPtr calc_critical_path(const std::string& type, int crit_path_num, e_timing_report_detail details_level, bool is_flat_routing);
+CritPathsResultPtr calc_critical_path(const std::string& type,
+                                      int crit_path_num,
+                                      e_timing_report_detail details_level,
+                                      bool is_flat_routing,
+                                      const CritPathsFilter& filter = {},
+                                      const std::function<bool()>& is_cancelled = {},
+                                      const std::function<void(std::string&&)>& on_partial_result = {});
 
 } // namespace server
 
@@ -2,6 +2,7 @@
 
 #include "task.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "convertutils.h"
@@ -18,14 +19,12 @@ Task::Task(int jobId, comm::CMD cmd, const std::string& options)
 }
 
 void Task::chop_num_sent_bytes_from_response_buffer(std::size_t bytes_sent_num) {
-    if (m_response_buffer.size() >= bytes_sent_num) {
-        m_response_buffer.erase(0, bytes_sent_num);
-    } else {
-        m_response_buffer.clear();
-    }
+    // the sent bytes are skipped rather than erased, which would shift the rest of a large response for each chunk
+    m_response_bytes_sent_num = std::min(m_response_bytes_sent_num + bytes_sent_num, m_response.size());
 
-    if (m_response_buffer.empty()) {
+    if (m_response_bytes_sent_num == m_response.size()) {
         m_is_response_fully_sent = true;
+        m_response = std::string{};
     }
 }
 
@@ -53,6 +52,13 @@ void Task::set_success(std::string&& result) {
     bake_response();
 }
 
+TaskPtr Task::make_progress_response(std::string&& partial_result) const {
+    TaskPtr progress = std::make_unique<Task>(m_job_id, m_cmd, m_options);
+    progress->m_is_progress = true;
+    progress->set_success(std::move(partial_result));
+    return progress;
+}
+
 std::string Task::info(bool skip_duration) const {
     std::stringstream ss;
     ss << "task["
@@ -71,43 +77,46 @@ int64_t Task::time_ms_elapsed() const {
 }
 
 void Task::bake_response() {
+    // The JSON message is composed of the (small) prefix and suffix around the (possibly large) data,
+    // which are streamed to the compressor, or copied, right after the header in the response
     std::stringstream ss;
     ss << "{";
 
     ss << "\"" << comm::KEY_JOB_ID << "\":\"" << m_job_id << "\",";
     ss << "\"" << comm::KEY_CMD << "\":\"" << static_cast<int>(m_cmd) << "\",";
     ss << "\"" << comm::KEY_OPTIONS << "\":\"" << m_options << "\",";
-    if (has_error()) {
-        ss << "\"" << comm::KEY_DATA << "\":\"" << m_error << "\",";
-    } else {
-        ss << "\"" << comm::KEY_DATA << "\":\"" << m_result << "\",";
-    }
-    int status = has_error() ? 0 : 1;
-    ss << "\"" << comm::KEY_STATUS << "\":\"" << status << "\"";
+    ss << "\"" << comm::KEY_DATA << "\":\"";
+    const std::string prefix = ss.str();
 
-    ss << "}";
+    int status = has_error() ? comm::STATUS_FAIL : (m_is_progress ? comm::STATUS_IN_PROGRESS : comm::STATUS_SUCCESS);
+    const std::string suffix = "\",\"" + comm::KEY_STATUS + "\":\"" + std::to_string(status) + "\"}";
 
-    std::optional<std::string> body_opt;
-    uint8_t compressor_id = comm::NONE_COMPRESSOR_ID;
+    const std::vector<std::string_view> body_parts{prefix, has_error() ? m_error : m_result, suffix};
+
+    // reserve the header bytes, filled in once the body is known
+    m_response.assign(comm::TelegramHeader::size(), '\0');
+
+    bool is_compressed = false;
 #ifndef FORCE_DISABLE_ZLIB_TELEGRAM_COMPRESSION
-    body_opt = try_compress(ss.str());
-    if (body_opt) {
-        compressor_id = comm::ZLIB_COMPRESSOR_ID;
-    }
+    is_compressed = try_compress_append(body_parts, m_response);
 #endif
-    if (!body_opt) {
+    if (!is_compressed) {
         // fail to compress, use raw
-        compressor_id = comm::NONE_COMPRESSOR_ID;
-        body_opt = ss.str();
+        for (std::string_view part : body_parts) {
+            m_response.append(part);
+        }
     }
+    uint8_t compressor_id = is_compressed ? comm::ZLIB_COMPRESSOR_ID : comm::NONE_COMPRESSOR_ID;
 
-    std::string body{std::move(body_opt.value())};
+    std::string_view body = std::string_view(m_response).substr(comm::TelegramHeader::size());
     m_telegram_header = comm::TelegramHeader::construct_from_body(body, compressor_id);
+    std::copy(m_telegram_header.buffer().begin(), m_telegram_header.buffer().end(), m_response.begin());
 
-    m_response_buffer.append(m_telegram_header.buffer().begin(), m_telegram_header.buffer().end());
-    m_response_buffer.append(body);
+    m_response_bytes_sent_num = 0;
+    m_orig_reponse_bytes_num = m_response.size();
 
-    m_orig_reponse_bytes_num = m_response_buffer.size();
+    // the result is only needed in the response
+    m_result = std::string{};
 }
 
 } // namespace server
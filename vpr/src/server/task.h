@@ -3,6 +3,7 @@
 #ifndef NO_SERVER
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <chrono>
 
@@ -69,11 +70,12 @@ class Task {
     /**
      * @brief Retrieves the response buffer.
      * 
-     * This method returns a constant reference to the response buffer, which contains the data after task execution.
+     * This method returns a view of the response buffer, which contains the data after task execution
+     * not sent yet (see @ref chop_num_sent_bytes_from_response_buffer).
      * 
-     * @return A constant reference to the response buffer.
+     * @return A view of the response bytes left to send.
      */
-    const std::string& response_buffer() const { return m_response_buffer; }
+    std::string_view response_buffer() const { return std::string_view(m_response).substr(m_response_bytes_sent_num); }
 
     /**
      * @brief Checks if the task has finished execution.
@@ -147,6 +149,23 @@ class Task {
      */
     void set_success(std::string&& result);
 
+    /**
+     * @brief Creates a progress response of the task, carrying a partial result.
+     *
+     * The progress response is a finished task with the same job ID, command and options,
+     * whose response has the in progress status (see @ref comm::STATUS_IN_PROGRESS).
+     * It is sent to the client ahead of the final response of the task, while the task is still executed.
+     *
+     * @param partial_result The partial result of the task execution.
+     * @return The progress response, to be sent like a finished task.
+     */
+    std::unique_ptr<Task> make_progress_response(std::string&& partial_result) const;
+
+    /**
+     * @brief Checks if the task is a progress response (see @ref make_progress_response).
+     */
+    bool is_progress() const { return m_is_progress; }
+
     /**
      * @brief Generates a string containing information about the task.
      * 
@@ -185,9 +204,11 @@ class Task {
     std::string m_error;
     bool m_is_finished = false;
     comm::TelegramHeader m_telegram_header;
-    std::string m_response_buffer;
+    std::string m_response; // header followed by the body
+    std::size_t m_response_bytes_sent_num = 0;
     std::size_t m_orig_reponse_bytes_num = 0;
     bool m_is_response_fully_sent = false;
+    bool m_is_progress = false;
 
     std::chrono::high_resolution_clock::time_point m_creation_time;
 
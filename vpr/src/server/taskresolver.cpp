@@ -12,6 +12,27 @@
 
 namespace server {
 
+TaskResolver::~TaskResolver() {
+    stop();
+}
+
+void TaskResolver::stop() {
+    for (auto& [job_id, job] : m_async_jobs) {
+        job.is_cancelled->store(true);
+    }
+    m_worker_pool.stop();
+    m_async_jobs.clear();
+}
+
+void TaskResolver::cancel_async_job(int job_id) {
+    auto it = m_async_jobs.find(job_id);
+    if (it != m_async_jobs.end()) {
+        // the worker abandons the calculation at its next stage, and its result is dropped
+        it->second.is_cancelled->store(true);
+        m_async_jobs.erase(it);
+    }
+}
+
 void TaskResolver::own_task(TaskPtr&& new_task) {
     // pre-process task before adding, where we could quickly detect failure scenarios
     for (const auto& task : m_tasks) {
@@ -24,6 +45,7 @@ void TaskResolver::own_task(TaskPtr&& new_task) {
                 if (new_task->job_id() > task->job_id()) {
                     std::string msg = "old " + task->info() + " is overridden by a new " + new_task->info();
                     task->set_fail(msg);
+                    cancel_async_job(task->job_id());
                 }
             }
         }
@@ -34,6 +56,17 @@ void TaskResolver::own_task(TaskPtr&& new_task) {
 }
 
 void TaskResolver::take_finished_tasks(std::vector<TaskPtr>& result) {
+    {
+        std::unique_lock<std::mutex> lock(m_progress_tasks_mutex);
+        for (auto& [is_cancelled, progress_task] : m_progress_tasks) {
+            // skip the progress of cancelled tasks, which may have been queued after their final response
+            if (!is_cancelled->load()) {
+                result.push_back(std::move(progress_task));
+            }
+        }
+        m_progress_tasks.clear();
+    }
+
     for (auto it = m_tasks.begin(); it != m_tasks.end();) {
         TaskPtr& task = *it;
         if (task->is_finished()) {
@@ -59,19 +92,73 @@ std::optional<e_timing_report_detail> TaskResolver::try_get_details_level_enum(c
     return std::nullopt;
 }
 
+std::optional<CritPathsFilter> TaskResolver::try_get_crit_paths_filter(TelegramOptions& options, std::string& error) const {
+    constexpr float SLACK_UNIT_SCALE = 1e-9; // the slacks are in ns, as in the report
+
+    CritPathsFilter filter;
+    try {
+        if (options.has_key(comm::OPTION_PATH_FROM)) {
+            filter.from = std::regex(options.get_string(comm::OPTION_PATH_FROM));
+        }
+        if (options.has_key(comm::OPTION_PATH_TO)) {
+            filter.to = std::regex(options.get_string(comm::OPTION_PATH_TO));
+        }
+    } catch (const std::regex_error& e) {
+        error = std::string("bad pin name regex (") + e.what() + ")";
+        return std::nullopt;
+    }
+
+    const tatum::TimingConstraints& timing_constraints = *g_vpr_ctx.timing().constraints;
+    for (auto [key, domain] : {std::make_pair(&comm::OPTION_LAUNCH_CLOCK, &filter.launch_domain),
+                               std::make_pair(&comm::OPTION_CAPTURE_CLOCK, &filter.capture_domain)}) {
+        if (options.has_key(*key)) {
+            const std::string clock_name = options.get_string(*key);
+            *domain = timing_constraints.find_clock_domain(clock_name);
+            if (!*domain) {
+                error = "unknown clock " + clock_name;
+                return std::nullopt;
+            }
+        }
+    }
+
+    if (options.has_key(comm::OPTION_MIN_SLACK)) {
+        filter.min_slack = options.get_float(comm::OPTION_MIN_SLACK, 0.) * SLACK_UNIT_SCALE;
+    }
+    if (options.has_key(comm::OPTION_MAX_SLACK)) {
+        filter.max_slack = options.get_float(comm::OPTION_MAX_SLACK, 0.) * SLACK_UNIT_SCALE;
+    }
+    if (options.has_errors()) {
+        error = options.errors_str();
+        return std::nullopt;
+    }
+
+    return filter;
+}
+
 bool TaskResolver::update(ezgl::application* app) {
     bool has_processed_task = false;
     for (auto& task : m_tasks) {
         if (!task->is_finished()) {
             switch (task->cmd()) {
                 case comm::CMD::GET_PATH_LIST_ID: {
-                    process_get_path_list_task(app, task);
-                    has_processed_task = true;
+                    auto it = m_async_jobs.find(task->job_id());
+                    if (it == m_async_jobs.end()) {
+                        start_get_path_list_task(task);
+                    } else if (it->second.result.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                        CritPathsResultPtr crit_paths_result = it->second.result.get();
+                        m_async_jobs.erase(it);
+                        finish_get_path_list_task(task, crit_paths_result);
+                    }
+                    has_processed_task |= task->is_finished();
                     break;
                 }
                 case comm::CMD::DRAW_PATH_ID: {
-                    process_draw_critical_path_task(app, task);
-                    has_processed_task = true;
+                    // the path elements refer to the path list requested before, wait for it
+                    bool is_waiting_path_list = !m_async_jobs.empty() && m_async_jobs.begin()->first < task->job_id();
+                    if (!is_waiting_path_list) {
+                        process_draw_critical_path_task(app, task);
+                        has_processed_task = true;
+                    }
                     break;
                 }
                 default:
@@ -83,32 +170,46 @@ bool TaskResolver::update(ezgl::application* app) {
     return has_processed_task;
 }
 
-void TaskResolver::process_get_path_list_task(ezgl::application*, const TaskPtr& task) {
+void TaskResolver::start_get_path_list_task(const TaskPtr& task) {
     static const std::vector<std::string> keys{comm::OPTION_PATH_NUM, comm::OPTION_PATH_TYPE, comm::OPTION_DETAILS_LEVEL, comm::OPTION_IS_FLAT_ROUTING};
     TelegramOptions options{task->options(), keys};
     if (!options.has_errors()) {
-        ServerContext& server_ctx = g_vpr_ctx.mutable_server(); // shortcut
-
-        server_ctx.crit_path_element_indexes.clear(); // reset selection if path list options has changed
-
         // read options
         const int n_critical_path_num = options.get_int(comm::OPTION_PATH_NUM, 1);
         const std::string path_type = options.get_string(comm::OPTION_PATH_TYPE);
         const std::string details_level_str = options.get_string(comm::OPTION_DETAILS_LEVEL);
         const bool is_flat = options.get_bool(comm::OPTION_IS_FLAT_ROUTING, false);
 
-        // calculate critical path depending on options and store result in server context
+        // calculate critical path depending on options in a worker thread
         std::optional<e_timing_report_detail> details_level_opt = try_get_details_level_enum(details_level_str);
-        if (details_level_opt) {
-            CritPathsResultPtr crit_paths_result = calc_critical_path(path_type, n_critical_path_num, details_level_opt.value(), is_flat);
-            if (crit_paths_result->is_valid()) {
-                server_ctx.crit_paths = std::move(crit_paths_result->paths);
-                task->set_success(std::move(crit_paths_result->report));
-            } else {
-                std::string msg{"Critical paths report is empty"};
-                VTR_LOG_ERROR(msg.c_str());
-                task->set_fail(msg);
-            }
+        std::string filter_error;
+        std::optional<CritPathsFilter> filter_opt = try_get_crit_paths_filter(options, filter_error);
+        if (details_level_opt && filter_opt) {
+            e_timing_report_detail details_level = details_level_opt.value();
+
+            AsyncJob job;
+            job.is_cancelled = std::make_shared<std::atomic<bool>>(false);
+            // the worker creates the progress responses from a copy, as the task itself may be sent in the meantime
+            std::shared_ptr<const Task> task_copy = std::make_shared<Task>(task->job_id(), task->cmd(), task->options());
+
+            auto calc_task = std::make_shared<std::packaged_task<CritPathsResultPtr()>>(
+                [this, path_type, n_critical_path_num, details_level, is_flat, filter = std::move(filter_opt.value()), is_cancelled = job.is_cancelled, task_copy]() {
+                    return calc_critical_path(
+                        path_type, n_critical_path_num, details_level, is_flat, filter,
+                        [&is_cancelled]() { return is_cancelled->load(); },
+                        [this, &is_cancelled, &task_copy](std::string&& partial_result) {
+                            std::unique_lock<std::mutex> lock(m_progress_tasks_mutex);
+                            m_progress_tasks.emplace_back(is_cancelled, task_copy->make_progress_response(std::move(partial_result)));
+                        });
+                });
+            job.result = calc_task->get_future();
+            m_async_jobs.emplace(task->job_id(), std::move(job));
+
+            m_worker_pool.submit([calc_task]() { (*calc_task)(); });
+        } else if (!filter_opt) {
+            std::string msg{"bad path filter in get crit path list telegram: " + filter_error};
+            VTR_LOG_ERROR(msg.c_str());
+            task->set_fail(msg);
         } else {
             std::string msg{"unsupported report details level " + details_level_str};
             VTR_LOG_ERROR(msg.c_str());
@@ -121,6 +222,22 @@ void TaskResolver::process_get_path_list_task(ezgl::application*, const TaskPtr&
     }
 }
 
+void TaskResolver::finish_get_path_list_task(const TaskPtr& task, CritPathsResultPtr crit_paths_result) {
+    if (crit_paths_result->is_valid()) {
+        ServerContext& server_ctx = g_vpr_ctx.mutable_server(); // shortcut
+
+        server_ctx.crit_path_element_indexes.clear(); // reset selection if path list options has changed
+
+        // store result in server context
+        server_ctx.crit_paths = std::move(crit_paths_result->paths);
+        task->set_success(std::move(crit_paths_result->report));
+    } else {
+        std::string msg{"Critical paths report is empty"};
+        VTR_LOG_ERROR(msg.c_str());
+        task->set_fail(msg);
+    }
+}
+
 void TaskResolver::process_draw_critical_path_task(ezgl::application* app, const TaskPtr& task) {
     TelegramOptions options{task->options(), {comm::OPTION_PATH_ELEMENTS, comm::OPTION_HIGHLIGHT_MODE, comm::OPTION_DRAW_PATH_CONTOUR}};
     if (!options.has_errors()) {
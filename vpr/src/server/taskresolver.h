@@ -3,8 +3,15 @@
 #ifndef NO_SERVER
 
 #include "task.h"
+#include "pathhelper.h"
+#include "telegramoptions.h"
+#include "workerpool.h"
 #include "vpr_types.h"
 
+#include <atomic>
+#include <future>
+#include <map>
+#include <mutex>
 #include <vector>
 #include <optional>
 
@@ -18,15 +25,26 @@ namespace server {
  * @brief Resolve server task.
  * 
  * Process and resolve server task, store result and status for processed task.
+ *
+ * The heavy tasks (critical path list requests) are executed asynchronously by a @ref WorkerPool, so that
+ * they do not block the main thread (GUI) nor the other requests. While executed, they stream their partial results
+ * back to the client as progress responses (see @ref Task::make_progress_response), and they are cancelled once
+ * overridden by a newer request. Their results are applied to the server context from the main thread, in @ref update.
+ * The tasks touching the GUI are executed in the main thread.
  */
 class TaskResolver {
+    static constexpr std::size_t WORKERS_NUM = 2;
+
   public:
     /**
      * @brief Default constructor for TaskResolver.
      */
     TaskResolver() = default;
 
-    ~TaskResolver() = default;
+    ~TaskResolver();
+
+    TaskResolver(const TaskResolver&) = delete;
+    TaskResolver& operator=(const TaskResolver&) = delete;
 
     int tasks_num() const { return m_tasks.size(); }
 
@@ -54,21 +72,48 @@ class TaskResolver {
      *
      * This function removes finished tasks from the internal task queue and appends them to the provided vector.
      * After this operation, the internal task queue will no longer hold the extracted tasks.
+     * The progress responses of the asynchronous tasks are appended first.
      *
      * @param tasks A reference to a vector where the finished tasks will be appended.
      */
     void take_finished_tasks(std::vector<TaskPtr>& tasks);
 
+    /**
+     * @brief Cancels the asynchronous tasks and waits for the worker threads to stop.
+     *
+     * Must be called before the data structures the tasks read (e.g. the timing graph) are freed.
+     */
+    void stop();
+
     // helper method used in tests
     const std::vector<TaskPtr>& tasks() const { return m_tasks; }
 
   private:
+    /**
+     * @brief A task executed by the worker pool.
+     */
+    struct AsyncJob {
+        std::shared_ptr<std::atomic<bool>> is_cancelled;
+        std::future<CritPathsResultPtr> result;
+    };
+
     std::vector<TaskPtr> m_tasks;
 
-    void process_get_path_list_task(ezgl::application*, const TaskPtr&);
+    std::map<int, AsyncJob> m_async_jobs; // by job ID, accessed from the main thread only
+
+    std::mutex m_progress_tasks_mutex;
+    std::vector<std::pair<std::shared_ptr<std::atomic<bool>>, TaskPtr>> m_progress_tasks; // progress responses queued by the worker threads, with the cancellation flag of their task
+
+    WorkerPool m_worker_pool{WORKERS_NUM};
+
+    void cancel_async_job(int job_id);
+
+    void start_get_path_list_task(const TaskPtr&);
+    void finish_get_path_list_task(const TaskPtr&, CritPathsResultPtr);
     void process_draw_critical_path_task(ezgl::application*, const TaskPtr&);
 
     std::optional<e_timing_report_detail> try_get_details_level_enum(const std::string& path_details_level_str) const;
+    std::optional<CritPathsFilter> try_get_crit_paths_filter(TelegramOptions& options, std::string& error) const;
 };
 
 } // namespace server
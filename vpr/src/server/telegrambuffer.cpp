@@ -8,15 +8,21 @@ void TelegramBuffer::append(const ByteArray& bytes) {
     m_raw_buffer.append(bytes);
 }
 
-bool TelegramBuffer::check_telegram_header_presence() {
-    auto [found, signature_start_index] = m_raw_buffer.find_sequence(TelegramHeader::SIGNATURE, TelegramHeader::SIGNATURE_SIZE);
+void TelegramBuffer::append(const char* data, std::size_t size) {
+    m_raw_buffer.append(data, size);
+}
+
+bool TelegramBuffer::check_telegram_header_presence(std::size_t& offset) {
+    auto [found, signature_start_index] = m_raw_buffer.find_sequence(TelegramHeader::SIGNATURE, TelegramHeader::SIGNATURE_SIZE, offset);
     if (found) {
-        if (signature_start_index != 0) {
-            // discard bytes preceding the header start position.
-            m_raw_buffer.erase(m_raw_buffer.begin(), m_raw_buffer.begin() + signature_start_index);
-        }
+        // discard bytes preceding the header start position.
+        offset = signature_start_index;
         return true;
     }
+    // keep the tail which may be the beginning of a signature
+    if (m_raw_buffer.size() - offset >= TelegramHeader::SIGNATURE_SIZE) {
+        offset = m_raw_buffer.size() - TelegramHeader::SIGNATURE_SIZE + 1;
+    }
     return false;
 }
 
@@ -25,13 +31,17 @@ void TelegramBuffer::take_telegram_frames(std::vector<comm::TelegramFramePtr>& r
         return;
     }
 
+    // The consumed bytes are only discarded once all the complete telegrams are extracted,
+    // instead of shifting the (possibly large) remaining bytes after each telegram
+    std::size_t offset = 0;
+
     bool may_contain_full_telegram = true;
     while (may_contain_full_telegram) {
         may_contain_full_telegram = false;
         // attempt to extract telegram header
         if (!m_header_opt) {
-            if (check_telegram_header_presence()) {
-                TelegramHeader header(m_raw_buffer);
+            if (check_telegram_header_presence(offset) && (m_raw_buffer.size() - offset >= TelegramHeader::size())) {
+                TelegramHeader header(std::string_view(m_raw_buffer).substr(offset));
                 if (header.is_valid()) {
                     m_header_opt = std::move(header);
                 }
@@ -42,27 +52,30 @@ void TelegramBuffer::take_telegram_frames(std::vector<comm::TelegramFramePtr>& r
         if (m_header_opt) {
             const TelegramHeader& header = m_header_opt.value();
             std::size_t expected_telegram_size = TelegramHeader::size() + header.body_bytes_num();
-            if (m_raw_buffer.size() >= expected_telegram_size) {
+            if (m_raw_buffer.size() - offset >= expected_telegram_size) {
                 // checksum validation
-                ByteArray body(m_raw_buffer.begin() + TelegramHeader::size(), m_raw_buffer.begin() + expected_telegram_size);
-                uint32_t actual_check_sum = body.calc_check_sum();
+                std::string_view body = std::string_view(m_raw_buffer).substr(offset + TelegramHeader::size(), header.body_bytes_num());
+                uint32_t actual_check_sum = ByteArray::calc_check_sum(body);
                 if (actual_check_sum == header.body_check_sum()) {
                     // construct telegram frame if checksum matches
                     TelegramFramePtr telegram_frame_ptr = std::make_shared<TelegramFrame>();
                     telegram_frame_ptr->header = header;
-                    telegram_frame_ptr->body = std::move(body);
-                    body.clear(); // post std::move safety step
+                    telegram_frame_ptr->body = ByteArray(body.data(), body.size());
 
                     result.push_back(telegram_frame_ptr);
                 } else {
                     m_errors.push_back("wrong checkSums " + std::to_string(actual_check_sum) + " for " + header.info() + " , drop this chunk");
                 }
-                m_raw_buffer.erase(m_raw_buffer.begin(), m_raw_buffer.begin() + expected_telegram_size);
+                offset += expected_telegram_size;
                 m_header_opt.reset();
                 may_contain_full_telegram = true;
             }
         }
     }
+
+    if (offset != 0) {
+        m_raw_buffer.erase(m_raw_buffer.begin(), m_raw_buffer.begin() + offset);
+    }
 }
 
 void TelegramBuffer::take_errors(std::vector<std::string>& errors) {
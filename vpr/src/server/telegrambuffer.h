@@ -50,6 +50,14 @@ class TelegramBuffer {
      */
     void append(const ByteArray& data);
 
+    /**
+     * @brief Append raw bytes to the internal byte buffer.
+     *
+     * @param data A pointer to the bytes to append.
+     * @param size The number of bytes to append.
+     */
+    void append(const char* data, std::size_t size);
+
     /**
      * @brief Extracts well-formed telegram frames from the internal byte buffer.
      * 
@@ -84,13 +92,14 @@ class TelegramBuffer {
     /**
      * @brief Checks for the presence of the telegram header in the buffer.
      *
-     * This function searches for the telegram header signature in the raw buffer.
-     * If the signature is found, any bytes preceding the header start position
-     * are discarded from the buffer.
+     * This function searches for the telegram header signature in the raw buffer, from the given offset.
+     * The offset is moved to the header start position if the signature is found, so that any bytes preceding it
+     * are discarded from the buffer, or past the bytes which cannot be part of a signature otherwise.
      *
+     * @param offset The offset of the first unprocessed byte in the raw buffer.
      * @return true if the telegram header signature is found, false otherwise.
      */
-    bool check_telegram_header_presence();
+    bool check_telegram_header_presence(std::size_t& offset);
 };
 
 } // namespace comm
@@ -28,7 +28,7 @@ TelegramHeader::TelegramHeader(uint32_t length, uint32_t check_sum, uint8_t comp
     m_is_valid = true;
 }
 
-TelegramHeader::TelegramHeader(const ByteArray& buffer) {
+TelegramHeader::TelegramHeader(std::string_view buffer) {
     m_buffer.resize(TelegramHeader::size());
 
     bool has_error = false;
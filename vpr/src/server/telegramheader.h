@@ -51,9 +51,9 @@ class TelegramHeader {
      *
      * This constructor initializes a TelegramHeader object using the length and checksum information taken from the provided byte buffer.
      *
-     * @param buffer The ByteArray containing the header data of the telegram.
+     * @param buffer The bytes starting with the header data of the telegram.
      */
-    explicit TelegramHeader(const ByteArray& buffer);
+    explicit TelegramHeader(std::string_view buffer);
 
     ~TelegramHeader() = default;
 
@@ -80,6 +80,15 @@ int TelegramOptions::get_int(const std::string& name, int fail_value) {
     }
 }
 
+float TelegramOptions::get_float(const std::string& name, float fail_value) {
+    if (std::optional<float> opt = try_convert_to_float(m_options[name].value)) {
+        return opt.value();
+    } else {
+        m_errors.emplace_back("cannot get float value for option " + name);
+        return fail_value;
+    }
+}
+
 bool TelegramOptions::get_bool(const std::string& name, bool fail_value) {
     if (std::optional<int> opt = try_convert_to_int(m_options[name].value)) {
         return opt.value();
@@ -98,7 +107,7 @@ std::string TelegramOptions::errors_str() const {
 }
 
 bool TelegramOptions::is_data_type_supported(const std::string& type) const {
-    constexpr std::array<std::string_view, 3> supported_types{"int", "string", "bool"};
+    constexpr std::array<std::string_view, 4> supported_types{"int", "float", "string", "bool"};
     return std::find(supported_types.begin(), supported_types.end(), type) != supported_types.end();
 }
 
@@ -92,6 +92,25 @@ class TelegramOptions {
      */
     int get_int(const std::string& key, int fail_value);
 
+    /**
+     * @brief Retrieves the float value associated with the specified key.
+     *
+     * @param key The key whose associated float value is to be retrieved.
+     * @param fail_value The value to return if the key is not found.
+     * @return The float value associated with the specified key, or fail_value if the key is not found.
+     */
+    float get_float(const std::string& key, float fail_value);
+
+    /**
+     * @brief Checks if an option with the specified key is present.
+     *
+     * It allows to handle optional keys, which are not part of the expected keys.
+     *
+     * @param key The key to look for.
+     * @return True if the option is present, false otherwise.
+     */
+    bool has_key(const std::string& key) const { return m_options.find(key) != m_options.end(); }
+
     /**
      * @brief Retrieves the boolean value associated with the specified key.
      *
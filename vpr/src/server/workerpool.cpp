@@ -0,0 +1,68 @@
+#ifndef NO_SERVER
+
+#include "workerpool.h"
+
+#include <algorithm>
+
+namespace server {
+
+WorkerPool::WorkerPool(std::size_t workers_num)
+    : m_workers_num(std::max<std::size_t>(workers_num, 1)) {
+}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+void WorkerPool::submit(std::function<void()>&& job) {
+    {
+        std::unique_lock<std::mutex> lock(m_jobs_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+
+    if (m_workers.empty()) {
+        for (std::size_t i = 0; i < m_workers_num; i++) {
+            m_workers.emplace_back(&WorkerPool::run_worker, this);
+        }
+    }
+    m_jobs_cv.notify_one();
+}
+
+void WorkerPool::stop() {
+    {
+        std::unique_lock<std::mutex> lock(m_jobs_mutex);
+        m_is_stopping = true;
+        m_jobs.clear();
+    }
+    m_jobs_cv.notify_all();
+
+    for (std::thread& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+
+    std::unique_lock<std::mutex> lock(m_jobs_mutex);
+    m_is_stopping = false;
+}
+
+void WorkerPool::run_worker() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_jobs_mutex);
+            m_jobs_cv.wait(lock, [this]() { return m_is_stopping || !m_jobs.empty(); });
+            if (m_is_stopping) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
+
+} // namespace server
+
+#endif /* NO_SERVER */
@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef NO_SERVER
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace server {
+
+/**
+ * @brief A fixed-size pool of worker threads executing queued jobs in FIFO order.
+ *
+ * It allows the @ref TaskResolver to run heavy tasks (e.g. critical path reports) outside of the main thread,
+ * so that the GUI and the other client requests stay responsive while they are computed.
+ *
+ * @note
+ * - The worker threads are started lazily, by the first submitted job.
+ * - Jobs are expected to handle their own errors: an exception escaping a job terminates the application.
+ */
+class WorkerPool {
+  public:
+    /**
+     * @brief Constructs a WorkerPool.
+     *
+     * @param workers_num The number of worker threads to run the jobs with.
+     */
+    explicit WorkerPool(std::size_t workers_num);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Queues a job, to be executed by the first available worker thread.
+     *
+     * @param job The job to execute.
+     */
+    void submit(std::function<void()>&& job);
+
+    /**
+     * @brief Stops the worker threads.
+     *
+     * The jobs currently being executed are waited for, while the jobs still in the queue are dropped.
+     * Jobs submitted afterwards restart the worker threads.
+     */
+    void stop();
+
+  private:
+    std::size_t m_workers_num = 1;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_jobs_mutex; // guards m_jobs and m_is_stopping
+    std::condition_variable m_jobs_cv;
+    std::deque<std::function<void()>> m_jobs;
+    bool m_is_stopping = false;
+
+    void run_worker(); // worker thread function
+};
+
+} // namespace server
+
+#endif /* NO_SERVER */
@@ -6,40 +6,59 @@
 #include <zlib.h>
 
 std::optional<std::string> try_compress(const std::string& decompressed) {
+    std::string result;
+    if (!try_compress_append({decompressed}, result)) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+bool try_compress_append(const std::vector<std::string_view>& parts, std::string& result) {
     z_stream zs;
     memset(&zs, 0, sizeof(zs));
 
     if (deflateInit(&zs, Z_BEST_COMPRESSION) != Z_OK) {
-        return std::nullopt;
+        return false;
     }
 
-    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(decompressed.data()));
-    zs.avail_in = decompressed.size();
-
-    int ret_code;
-    char* result_buffer = new char[BYTES_NUM_IN_32KB];
-    std::string result;
+    uLong decompressed_size = 0;
+    for (std::string_view part : parts) {
+        decompressed_size += part.size();
+    }
 
-    do {
-        zs.next_out = reinterpret_cast<Bytef*>(result_buffer);
-        zs.avail_out = sizeof(result_buffer);
+    // deflate straight into the result, sized for the worst case and shrunk afterwards
+    const std::size_t orig_size = result.size();
+    result.resize(orig_size + deflateBound(&zs, decompressed_size));
+
+    int ret_code = Z_OK;
+    for (std::size_t i = 0; i <= parts.size() && ret_code == Z_OK; i++) {
+        // the parts are followed by an empty input finishing the stream
+        const bool is_finishing = (i == parts.size());
+        if (!is_finishing) {
+            zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(parts[i].data()));
+            zs.avail_in = parts[i].size();
+        }
 
-        ret_code = deflate(&zs, Z_FINISH);
+        while (ret_code == Z_OK && (zs.avail_in > 0 || is_finishing)) {
+            if (result.size() == orig_size + zs.total_out) {
+                result.resize(result.size() + BYTES_NUM_IN_32KB);
+            }
+            zs.next_out = reinterpret_cast<Bytef*>(result.data() + orig_size + zs.total_out);
+            zs.avail_out = result.size() - orig_size - zs.total_out;
 
-        if (result.size() < zs.total_out) {
-            result.append(result_buffer, zs.total_out - result.size());
+            ret_code = deflate(&zs, is_finishing ? Z_FINISH : Z_NO_FLUSH);
         }
-    } while (ret_code == Z_OK);
-
-    delete[] result_buffer;
+    }
 
     deflateEnd(&zs);
 
     if (ret_code != Z_STREAM_END) {
-        return std::nullopt;
+        result.resize(orig_size);
+        return false;
     }
 
-    return result;
+    result.resize(orig_size + zs.total_out);
+    return true;
 }
 
 std::optional<std::string> try_decompress(const std::string& compressed) {
@@ -59,7 +78,7 @@ std::optional<std::string> try_decompress(const std::string& compressed) {
 
     do {
         zs.next_out = reinterpret_cast<Bytef*>(result_buffer);
-        zs.avail_out = sizeof(result_buffer);
+        zs.avail_out = BYTES_NUM_IN_32KB;
 
         ret_code = inflate(&zs, 0);
 
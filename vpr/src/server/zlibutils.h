@@ -3,7 +3,9 @@
 #ifndef NO_SERVER
 
 #include <string>
+#include <string_view>
 #include <optional>
+#include <vector>
 
 constexpr const int BYTES_NUM_IN_32KB = 32768;
 
@@ -21,6 +23,19 @@ constexpr const int BYTES_NUM_IN_32KB = 32768;
  */
 std::optional<std::string> try_compress(const std::string& decompressed);
 
+/**
+ * @brief Compresses the concatenation of the input parts using zlib, appending the compressed data to the result.
+ *
+ * The parts are streamed through the compressor one after the other, so that large responses (e.g. critical path
+ * reports embedded in a JSON message) are compressed without being concatenated first. The compressed data is
+ * the same as the one of @ref try_compress for the concatenated parts.
+ *
+ * @param parts The parts of the decompressed data.
+ * @param result The string the compressed data is appended to. It is left unchanged if the compression fails.
+ * @return True if the compression is successful, false otherwise.
+ */
+bool try_compress_append(const std::vector<std::string_view>& parts, std::string& result);
+
 /**
  * @brief Decompresses the compressed sequence using zlib.
  *
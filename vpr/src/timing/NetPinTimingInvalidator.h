@@ -9,7 +9,10 @@
 #include "move_transactions.h"
 
 #ifdef VPR_USE_TBB
+#include <algorithm>
+#include <vector>
 #include <tbb/concurrent_unordered_set.h>
+#include <tbb/enumerable_thread_specific.h>
 #else
 #include "vtr_vec_id_set.h"
 #endif
@@ -177,6 +180,55 @@ class NoopNetPinTimingInvalidator : public NetPinTimingInvalidator {
     }
 };
 
+#ifdef VPR_USE_TBB
+/** Records the connections invalidated by concurrent tasks, and passes them on to another invalidator
+ * in ascending pin order when flushed. Invalidating into the timing graph is not thread safe, and its
+ * order would depend on thread timing: the parallel routers use this class in deterministic mode. */
+class DeferredNetPinTimingInvalidator : public NetPinTimingInvalidator {
+  public:
+    explicit DeferredNetPinTimingInvalidator(NetPinTimingInvalidator* invalidator)
+        : invalidator_(invalidator) {}
+
+    tedge_range pin_timing_edges(ParentPinId pin) const {
+        return invalidator_->pin_timing_edges(pin);
+    }
+
+    /** Is concurrently safe. */
+    void invalidate_connection(ParentPinId pin) {
+        pins_th_.local().push_back(pin);
+    }
+
+    /** Forgets the recorded connections without invalidating them. Not concurrently safe! */
+    void reset() {
+        for (auto& pins : pins_th_) {
+            pins.clear();
+        }
+    }
+
+    /** Invalidates the recorded connections in the wrapped invalidator, in ascending pin order.
+     * Not concurrently safe! */
+    void flush() {
+        std::vector<ParentPinId> pins;
+        for (const auto& thread_pins : pins_th_) {
+            pins.insert(pins.end(), thread_pins.begin(), thread_pins.end());
+        }
+        std::sort(pins.begin(), pins.end());
+        pins.erase(std::unique(pins.begin(), pins.end()), pins.end());
+
+        if (invalidator_) {
+            for (ParentPinId pin : pins) {
+                invalidator_->invalidate_connection(pin);
+            }
+        }
+        reset();
+    }
+
+  private:
+    NetPinTimingInvalidator* invalidator_;
+    tbb::enumerable_thread_specific<std::vector<ParentPinId>> pins_th_;
+};
+#endif
+
 /** Make a NetPinTimingInvalidator depending on update_type. Will return a NoopInvalidator if it's not INCREMENTAL. */
 inline std::unique_ptr<NetPinTimingInvalidator> make_net_pin_timing_invalidator(
     e_timing_update_type update_type,
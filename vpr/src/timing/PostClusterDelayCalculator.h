@@ -33,6 +33,9 @@ class PostClusterDelayCalculator : public tatum::DelayCalculator {
   private:
     friend VprTimingGraphResolver;
 
+    //Scales a nominal delay to each of the timing corners analyzed
+    tatum::Time scale_to_corners(tatum::Time delay) const;
+
     //Returns the generic edge delay
     tatum::Time calc_edge_delay(const tatum::TimingGraph& tg, tatum::EdgeId edge_id, DelayType delay_type) const;
 
@@ -74,6 +77,9 @@ class PostClusterDelayCalculator : public tatum::DelayCalculator {
     float tsu_margin_rel_ = 1.0;
     float tsu_margin_abs_ = 0.0e-12;
 
+    //Delay scale factor of each timing corner (see TimingContext::corner_delay_scales)
+    tatum::Time corner_delay_scales_;
+
     mutable vtr::vector<tatum::EdgeId, tatum::Time> edge_min_delay_cache_;
     mutable vtr::vector<tatum::EdgeId, tatum::Time> edge_max_delay_cache_;
     mutable vtr::vector<tatum::EdgeId, tatum::Time> driver_clb_min_delay_cache_;
@@ -18,6 +18,7 @@ inline PostClusterDelayCalculator::PostClusterDelayCalculator(const AtomNetlist&
     , netlist_lookup_(netlist_lookup)
     , net_delay_(net_delay)
     , atom_delay_calc_(netlist, netlist_lookup)
+    , corner_delay_scales_(g_vpr_ctx.timing().corner_delay_scales)
     , edge_min_delay_cache_(g_vpr_ctx.timing().graph->edges().size(), tatum::Time(NAN))
     , edge_max_delay_cache_(g_vpr_ctx.timing().graph->edges().size(), tatum::Time(NAN))
     , driver_clb_min_delay_cache_(g_vpr_ctx.timing().graph->edges().size(), tatum::Time(NAN))
@@ -51,28 +52,35 @@ inline tatum::Time PostClusterDelayCalculator::max_edge_delay(const tatum::Timin
 #ifdef POST_CLUSTER_DELAY_CALC_DEBUG
     VTR_LOG("=== Edge %zu (max) ===\n", size_t(edge_id));
 #endif
-    return calc_edge_delay(tg, edge_id, DelayType::MAX);
+    return scale_to_corners(calc_edge_delay(tg, edge_id, DelayType::MAX));
 }
 
 inline tatum::Time PostClusterDelayCalculator::min_edge_delay(const tatum::TimingGraph& tg, tatum::EdgeId edge_id) const {
 #ifdef POST_CLUSTER_DELAY_CALC_DEBUG
     VTR_LOG("=== Edge %zu (min) ===\n", size_t(edge_id));
 #endif
-    return calc_edge_delay(tg, edge_id, DelayType::MIN);
+    return scale_to_corners(calc_edge_delay(tg, edge_id, DelayType::MIN));
 }
 
 inline tatum::Time PostClusterDelayCalculator::setup_time(const tatum::TimingGraph& tg, tatum::EdgeId edge_id) const {
 #ifdef POST_CLUSTER_DELAY_CALC_DEBUG
     VTR_LOG("=== Edge %zu (setup) ===\n", size_t(edge_id));
 #endif
-    return atom_setup_time(tg, edge_id);
+    return scale_to_corners(atom_setup_time(tg, edge_id));
 }
 
 inline tatum::Time PostClusterDelayCalculator::hold_time(const tatum::TimingGraph& tg, tatum::EdgeId edge_id) const {
 #ifdef POST_CLUSTER_DELAY_CALC_DEBUG
     VTR_LOG("=== Edge %zu (hold) ===\n", size_t(edge_id));
 #endif
-    return atom_hold_time(tg, edge_id);
+    return scale_to_corners(atom_hold_time(tg, edge_id));
+}
+
+inline tatum::Time PostClusterDelayCalculator::scale_to_corners(tatum::Time delay) const {
+#if TIME_VEC_WIDTH > 1
+    delay *= corner_delay_scales_;
+#endif
+    return delay;
 }
 
 inline tatum::Time PostClusterDelayCalculator::calc_edge_delay(const tatum::TimingGraph& tg, tatum::EdgeId edge, DelayType delay_type) const {
@@ -18,6 +18,8 @@
 #include "echo_files.h"
 #include "physical_types_util.h"
 #include "prepack.h"
+#include "report_stream.h"
+#include "tatum/TimingGraph.hpp"
 #include "tatum/TimingReporter.hpp"
 #include "tatum/echo_writer.hpp"
 #include "vpr_types.h"
@@ -80,6 +82,14 @@ PreClusterTimingManager::PreClusterTimingManager(bool timing_driven,
     float inter_cluster_net_delay = approximate_inter_cluster_delay(arch, routing_arch, device_layout);
     VTR_LOG("Using inter-cluster delay: %g\n", inter_cluster_net_delay);
     timing_arc_delays_.resize(atom_netlist.pins().size(), inter_cluster_net_delay);
+    timing_arc_modified_.resize(atom_netlist.pins().size(), false);
+
+    // The timing arc delays are typically refined many times (for example
+    // once per global placement iteration), each time only changing some of
+    // the arcs. Auto therefore uses incremental updates here.
+    if (timing_update_type == e_timing_update_type::AUTO)
+        timing_update_type = e_timing_update_type::INCREMENTAL;
+    is_incremental_ = (timing_update_type == e_timing_update_type::INCREMENTAL);
 
     // Initialize the timing analyzer
     clustering_delay_calc_ = std::make_shared<PreClusterDelayCalculator>(atom_netlist,
@@ -89,6 +99,29 @@ PreClusterTimingManager::PreClusterTimingManager(bool timing_driven,
                                                                          prepacker);
     timing_info_ = make_setup_timing_info(clustering_delay_calc_, timing_update_type);
 
+    // Look up the timing edge of each arc, which is invalidated when the
+    // delay of the arc changes.
+    if (is_incremental_) {
+        const tatum::TimingGraph& timing_graph = *g_vpr_ctx.timing().graph;
+        timing_arc_edges_.resize(atom_netlist.pins().size(), tatum::EdgeId::INVALID());
+        for (AtomPinId pin_id : atom_netlist.pins()) {
+            if (atom_netlist.pin_type(pin_id) != PinType::SINK)
+                continue;
+
+            tatum::NodeId sink_tnode = atom_lookup.atom_pin_tnode(pin_id);
+            if (!sink_tnode)
+                continue;
+
+            // The arc is the interconnect edge from the net driver to this pin.
+            for (tatum::EdgeId edge_id : timing_graph.node_in_edges(sink_tnode)) {
+                if (timing_graph.edge_type(edge_id) == tatum::EdgeType::INTERCONNECT) {
+                    timing_arc_edges_[pin_id] = edge_id;
+                    break;
+                }
+            }
+        }
+    }
+
     // Calculate the initial timing
     timing_info_->update();
 
@@ -96,7 +129,7 @@ PreClusterTimingManager::PreClusterTimingManager(bool timing_driven,
     if (isEchoFileEnabled(E_ECHO_PRE_PACKING_TIMING_GRAPH)) {
         auto& timing_ctx = g_vpr_ctx.timing();
         tatum::write_echo(getEchoFileName(E_ECHO_PRE_PACKING_TIMING_GRAPH),
-                          *timing_ctx.graph, *timing_ctx.constraints, *clustering_delay_calc_, timing_info_->analyzer());
+                          *timing_ctx.graph, *timing_ctx.constraints, *clustering_delay_calc_, timing_info_->analyzer(), getTimingGraphEchoAnonymized());
 
         tatum::NodeId debug_tnode = id_or_pin_name_to_tnode(analysis_opts.echo_dot_timing_graph_node);
         write_setup_timing_graph_dot(getEchoFileName(E_ECHO_PRE_PACKING_TIMING_GRAPH) + std::string(".dot"),
@@ -117,7 +150,7 @@ PreClusterTimingManager::PreClusterTimingManager(bool timing_driven,
                                               *timing_ctx.constraints);
 
         timing_reporter.report_timing_setup(
-            "pre_pack.report_timing.setup.rpt",
+            *open_report_stream("pre_pack.report_timing.setup.rpt", analysis_opts.timing_report_compress),
             *timing_info_->setup_analyzer(),
             analysis_opts.timing_report_npaths);
     }
@@ -304,5 +337,16 @@ float PreClusterTimingManager::calc_net_setup_criticality(AtomNetId net_id,
 }
 
 void PreClusterTimingManager::update_timing_info() {
+    // Nothing changed since the last analysis, the timing info is up to date.
+    if (modified_timing_arcs_.empty())
+        return;
+
+    for (AtomPinId sink_pin_id : modified_timing_arcs_) {
+        if (is_incremental_ && timing_arc_edges_[sink_pin_id])
+            timing_info_->invalidate_delay(timing_arc_edges_[sink_pin_id]);
+        timing_arc_modified_[sink_pin_id] = false;
+    }
+    modified_timing_arcs_.clear();
+
     timing_info_->update();
 }
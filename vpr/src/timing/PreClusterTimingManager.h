@@ -8,6 +8,8 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+#include "tatum/TimingGraphFwd.hpp"
 #include "vpr_types.h"
 #include "vtr_assert.h"
 #include "vtr_vector.h"
@@ -51,7 +53,10 @@ class PreClusterTimingManager {
      *  @param prepacker
      *          The prepacker object used to prepack primitives into molecules.
      *  @param timing_update_type
-     *          The type of timing update this class should perform.
+     *          The type of timing update this class should perform. With
+     *          incremental (or auto) updates, only the part of the timing
+     *          graph affected by timing arcs whose delay changed is
+     *          re-analyzed by update_timing_info.
      *  @param arch
      *          The architecture.
      *  @param routing_arch
@@ -94,20 +99,31 @@ class PreClusterTimingManager {
      *
      * This method only updates an internal variable to this class and does not
      * perform STA. Call update_timing_info after updating the delays of all
-     * arcs to save time.
+     * arcs to save time. Arcs whose delay actually changed are recorded, so
+     * the next update only has to re-analyze what they affect.
      */
     void set_timing_arc_delay(AtomPinId sink_pin_id, float delay) {
         VTR_ASSERT_SAFE_MSG(sink_pin_id.is_valid(),
                             "Cannot set arc delay of invalid pin");
 
+        if (timing_arc_delays_[sink_pin_id] == delay)
+            return;
+
         timing_arc_delays_[sink_pin_id] = delay;
+        if (!timing_arc_modified_[sink_pin_id]) {
+            timing_arc_modified_[sink_pin_id] = true;
+            modified_timing_arcs_.push_back(sink_pin_id);
+        }
     }
 
     /**
      * @brief Perform STA to updating the timing information.
      *
      * This should be called after set_timing_arc_delay has been called on the
-     * timing arcs that have changed.
+     * timing arcs that have changed. If no arc delay changed since the last
+     * update, the timing information is still up to date and no STA is run.
+     * With incremental updates, only the timing edges of the modified arcs
+     * are invalidated, and the analysis only revisits the nodes they affect.
      */
     void update_timing_info();
 
@@ -139,6 +155,9 @@ class PreClusterTimingManager {
     }
 
   private:
+    /// @brief Whether the timing analysis is updated incrementally.
+    bool is_incremental_ = false;
+
     /// @brief A valid flag used to signify if the pre-cluster timing manager
     ///        class has been initialized or not. For example, if the flow is
     ///        not timing-driven, then this class will just be a shell which
@@ -157,4 +176,14 @@ class PreClusterTimingManager {
     ///        delay calculator can query them when Tatum performs a timing analysis.
     ///        Here, we use sink pins as unique identifiers for the the timing arc.
     vtr::vector<AtomPinId, float> timing_arc_delays_;
+
+    /// @brief The timing graph edge of each timing arc (identified by its sink
+    ///        pin). Only built for incremental updates.
+    vtr::vector<AtomPinId, tatum::EdgeId> timing_arc_edges_;
+
+    /// @brief The timing arcs whose delay changed since the last update.
+    std::vector<AtomPinId> modified_timing_arcs_;
+
+    /// @brief Flag of whether each timing arc is in modified_timing_arcs_.
+    vtr::vector<AtomPinId, bool> timing_arc_modified_;
 };
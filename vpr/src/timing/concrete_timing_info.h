@@ -7,6 +7,7 @@
 #include "timing_util.h"
 #include "slack_evaluation.h"
 #include "globals.h"
+#include "vtr_profile.h"
 
 void warn_unconstrained(std::shared_ptr<const tatum::TimingAnalyzer> analyzer);
 
@@ -106,6 +107,8 @@ class ConcreteSetupTimingInfo : public SetupTimingInfo {
     }
 
     void update_setup() override {
+        VTR_PROFILE_ZONE("Setup timing update");
+
         //Update the arrival and required times and re-calculate slacks
         double sta_wallclock_time = 0.;
         {
@@ -127,6 +130,7 @@ class ConcreteSetupTimingInfo : public SetupTimingInfo {
 
         //Update global timing analysis stats
         auto& timing_ctx = g_vpr_ctx.mutable_timing();
+        std::lock_guard<std::mutex> stats_lock(timing_ctx.stats_mutex);
         timing_ctx.stats.sta_wallclock_time += sta_wallclock_time;
         timing_ctx.stats.slack_wallclock_time += slack_wallclock_time;
         timing_ctx.stats.num_full_setup_updates += 1;
@@ -225,6 +229,8 @@ class ConcreteHoldTimingInfo : public HoldTimingInfo {
     }
 
     void update_hold() override {
+        VTR_PROFILE_ZONE("Hold timing update");
+
         double sta_wallclock_time = 0.;
         {
             auto start_time = Clock::now();
@@ -245,6 +251,7 @@ class ConcreteHoldTimingInfo : public HoldTimingInfo {
 
         //Update global timing analysis stats
         auto& timing_ctx = g_vpr_ctx.mutable_timing();
+        std::lock_guard<std::mutex> stats_lock(timing_ctx.stats_mutex);
         timing_ctx.stats.sta_wallclock_time += sta_wallclock_time;
         timing_ctx.stats.slack_wallclock_time += slack_wallclock_time;
         timing_ctx.stats.num_full_hold_updates += 1;
@@ -333,6 +340,8 @@ class ConcreteSetupHoldTimingInfo : public SetupHoldTimingInfo {
     //  it performs a single combined STA to update both setup and hold (instead of calling it
     //  twice).
     void update() override {
+        VTR_PROFILE_ZONE("Timing update");
+
         double sta_wallclock_time = 0.;
         {
             auto start_time = Clock::now();
@@ -358,6 +367,7 @@ class ConcreteSetupHoldTimingInfo : public SetupHoldTimingInfo {
 
         //Update global timing analysis stats
         auto& timing_ctx = g_vpr_ctx.mutable_timing();
+        std::lock_guard<std::mutex> stats_lock(timing_ctx.stats_mutex);
         timing_ctx.stats.sta_wallclock_time += sta_wallclock_time;
         timing_ctx.stats.slack_wallclock_time += slack_wallclock_time;
         timing_ctx.stats.num_full_setup_hold_updates += 1;
@@ -460,7 +470,7 @@ std::unique_ptr<SetupTimingInfo> make_setup_timing_info(std::shared_ptr<DelayCal
         analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
     } else {
         VTR_ASSERT(update_type == e_timing_update_type::INCREMENTAL);
-        analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, tatum::SerialIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+        analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, tatum::ParallelIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
     }
 
     return std::make_unique<ConcreteSetupTimingInfo<DelayCalc>>(timing_ctx.graph, timing_ctx.constraints, delay_calculator, analyzer);
@@ -476,7 +486,7 @@ std::unique_ptr<HoldTimingInfo> make_hold_timing_info(std::shared_ptr<DelayCalc>
         analyzer = tatum::AnalyzerFactory<tatum::HoldAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
     } else {
         VTR_ASSERT(update_type == e_timing_update_type::INCREMENTAL);
-        analyzer = tatum::AnalyzerFactory<tatum::HoldAnalysis, tatum::SerialIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+        analyzer = tatum::AnalyzerFactory<tatum::HoldAnalysis, tatum::ParallelIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
     }
 
     return std::make_unique<ConcreteHoldTimingInfo<DelayCalc>>(timing_ctx.graph, timing_ctx.constraints, delay_calculator, analyzer);
@@ -492,7 +502,7 @@ std::unique_ptr<SetupHoldTimingInfo> make_setup_hold_timing_info(std::shared_ptr
         analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
     } else {
         VTR_ASSERT(update_type == e_timing_update_type::INCREMENTAL);
-        analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis, tatum::SerialIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+        analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis, tatum::ParallelIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
     }
 
     return std::make_unique<ConcreteSetupHoldTimingInfo<DelayCalc>>(timing_ctx.graph, timing_ctx.constraints, delay_calculator, analyzer);
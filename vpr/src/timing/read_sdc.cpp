@@ -1,7 +1,10 @@
 #include "read_sdc.h"
 
+#include <cctype>
+#include <cstring>
 #include <limits>
 #include <regex>
+#include <unordered_map>
 
 #include "vtr_log.h"
 #include "vtr_assert.h"
@@ -51,7 +54,9 @@ void constrain_all_ios(const AtomNetlist& netlist,
 std::map<std::string, AtomPinId> find_netlist_primary_ios(const AtomNetlist& netlist);
 std::string orig_blif_name(std::string name);
 
+std::string glob_pattern_to_regex_str(const std::string& glob_pattern);
 std::regex glob_pattern_to_regex(const std::string& glob_pattern);
+bool glob_pattern_to_literal(const std::string& glob_pattern, std::string& literal);
 
 class SdcParseCallback : public sdcparse::Callback {
   public:
@@ -152,6 +157,9 @@ class SdcParseCallback : public sdcparse::Callback {
                 }
             }
         }
+
+        //The clock domains have changed
+        clock_domains_by_name_valid_ = false;
     }
 
     void set_io_delay(const sdcparse::SetIoDelay& cmd) override {
@@ -876,17 +884,29 @@ class SdcParseCallback : public sdcparse::Callback {
 
         std::set<AtomPinId> pins;
         for (const auto& port_pattern : port_group.strings) {
-            std::regex port_regex = glob_pattern_to_regex(port_pattern);
-
             bool found = false;
-            for (const auto& kv : netlist_primary_ios_) {
-                const std::string& io_name = kv.first;
-                if (std::regex_match(io_name, port_regex)) {
+
+            std::string port_name;
+            if (glob_pattern_to_literal(port_pattern, port_name)) {
+                //A plain port name, look it up directly
+                auto iter = netlist_primary_ios_.find(port_name);
+                if (iter != netlist_primary_ios_.end()) {
                     found = true;
 
-                    AtomPinId pin = kv.second;
+                    pins.insert(iter->second);
+                }
+            } else {
+                const std::regex& port_regex = pattern_regex(port_pattern);
+
+                for (const auto& kv : netlist_primary_ios_) {
+                    const std::string& io_name = kv.first;
+                    if (std::regex_match(io_name, port_regex)) {
+                        found = true;
+
+                        AtomPinId pin = kv.second;
 
-                    pins.insert(pin);
+                        pins.insert(pin);
+                    }
                 }
             }
 
@@ -913,9 +933,29 @@ class SdcParseCallback : public sdcparse::Callback {
         }
 
         for (const auto& clock_glob_pattern : clock_group.strings) {
-            std::regex clock_regex = glob_pattern_to_regex(clock_glob_pattern);
-
             bool found = false;
+
+            std::string clock_name;
+            if (glob_pattern_to_literal(clock_glob_pattern, clock_name)) {
+                //A plain clock name, look it up directly
+                const auto& name_domains = clock_domains_by_name();
+                auto iter = name_domains.find(clock_name);
+                if (iter != name_domains.end()) {
+                    found = true;
+
+                    domains.insert(iter->second.begin(), iter->second.end());
+                }
+
+                if (!found) {
+                    VTR_LOGF_WARN(fname_.c_str(), lineno_,
+                                  "get_clocks target name or pattern '%s' matched no clocks\n",
+                                  clock_glob_pattern.c_str());
+                }
+                continue;
+            }
+
+            const std::regex& clock_regex = pattern_regex(clock_glob_pattern);
+
             for (tatum::DomainId domain : tc_.clock_domains()) {
                 const auto& clock_name = tc_.clock_domain_name(domain);
 
@@ -973,16 +1013,29 @@ class SdcParseCallback : public sdcparse::Callback {
         }
 
         for (const auto& pin_pattern : pin_group.strings) {
-            std::regex pin_regex = glob_pattern_to_regex(pin_pattern);
-
             bool found = false;
-            for (AtomPinId pin : netlist_.pins()) {
-                const std::string& pin_name = netlist_.pin_name(pin);
 
-                if (std::regex_match(pin_name, pin_regex)) {
+            std::string pin_name;
+            if (glob_pattern_to_literal(pin_pattern, pin_name)) {
+                //A plain pin name, look it up directly
+                const auto& name_pins = netlist_pins_by_name();
+                auto iter = name_pins.find(pin_name);
+                if (iter != name_pins.end()) {
                     found = true;
 
-                    pins.insert(pin);
+                    pins.insert(iter->second);
+                }
+            } else {
+                const std::regex& pin_regex = pattern_regex(pin_pattern);
+
+                for (AtomPinId pin : netlist_.pins()) {
+                    const std::string& name = netlist_.pin_name(pin);
+
+                    if (std::regex_match(name, pin_regex)) {
+                        found = true;
+
+                        pins.insert(pin);
+                    }
                 }
             }
 
@@ -996,6 +1049,51 @@ class SdcParseCallback : public sdcparse::Callback {
         return pins;
     }
 
+    //Returns the regex matching the glob pattern. Each distinct pattern is only
+    //converted and compiled once, since large SDC files repeat the same patterns
+    //across many commands.
+    const std::regex& pattern_regex(const std::string& glob_pattern) {
+        auto iter = pattern_regexes_.find(glob_pattern);
+        if (iter == pattern_regexes_.end()) {
+            iter = pattern_regexes_.emplace(glob_pattern, glob_pattern_to_regex(glob_pattern)).first;
+        }
+        return iter->second;
+    }
+
+    //Returns the look-up from clock names (including the aliases of netlist
+    //clock nets) to the clock domains they refer to
+    const std::unordered_map<std::string, std::vector<tatum::DomainId>>& clock_domains_by_name() {
+        if (!clock_domains_by_name_valid_) {
+            clock_domains_by_name_.clear();
+
+            for (tatum::DomainId domain : tc_.clock_domains()) {
+                const auto& clock_name = tc_.clock_domain_name(domain);
+
+                //Virtual clocks have no net (and hence no net aliases), see get_clocks()
+                if (tc_.is_virtual_clock(domain)) {
+                    clock_domains_by_name_[clock_name].push_back(domain);
+                } else {
+                    for (const auto& alias : netlist_.net_aliases(clock_name)) {
+                        clock_domains_by_name_[alias].push_back(domain);
+                    }
+                }
+            }
+            clock_domains_by_name_valid_ = true;
+        }
+        return clock_domains_by_name_;
+    }
+
+    //Returns the look-up from netlist pin names to pins (built on first use)
+    const std::unordered_map<std::string, AtomPinId>& netlist_pins_by_name() {
+        if (netlist_pins_by_name_.empty()) {
+            netlist_pins_by_name_.reserve(netlist_.pins().size());
+            for (AtomPinId pin : netlist_.pins()) {
+                netlist_pins_by_name_.emplace(netlist_.pin_name(pin), pin);
+            }
+        }
+        return netlist_pins_by_name_;
+    }
+
     std::set<tatum::DomainId> get_all_clocks() {
         auto domains = tc_.clock_domains();
         return std::set<tatum::DomainId>(domains.begin(), domains.end());
@@ -1052,6 +1150,12 @@ class SdcParseCallback : public sdcparse::Callback {
     std::set<AtomPinId> netlist_clock_drivers_;
     std::map<std::string, AtomPinId> netlist_primary_ios_;
 
+    //Look-ups used to resolve the SDC object names and patterns
+    std::unordered_map<std::string, std::regex> pattern_regexes_;
+    std::unordered_map<std::string, std::vector<tatum::DomainId>> clock_domains_by_name_;
+    bool clock_domains_by_name_valid_ = false;
+    std::unordered_map<std::string, AtomPinId> netlist_pins_by_name_;
+
     std::set<std::pair<tatum::DomainId, tatum::DomainId>> disabled_domain_pairs_;
     std::map<std::pair<tatum::DomainId, tatum::DomainId>, float> setup_override_constraints_;
     std::map<std::pair<tatum::DomainId, tatum::DomainId>, float> hold_override_constraints_;
@@ -1321,7 +1425,7 @@ std::string orig_blif_name(std::string name) {
 }
 
 //Converts a glob pattern to a std::regex
-std::regex glob_pattern_to_regex(const std::string& glob_pattern) {
+std::string glob_pattern_to_regex_str(const std::string& glob_pattern) {
     //In glob (i.e. unix-shell style):
     //   '*' is a wildcard match of zero or more instances of any characters
     //
@@ -1336,5 +1440,36 @@ std::regex glob_pattern_to_regex(const std::string& glob_pattern) {
     std::string regex_str = vtr::replace_all(glob_pattern, ".", "\\.");
     regex_str = vtr::replace_all(regex_str, "*", ".*");
 
-    return std::regex(regex_str);
+    return regex_str;
+}
+
+std::regex glob_pattern_to_regex(const std::string& glob_pattern) {
+    return std::regex(glob_pattern_to_regex_str(glob_pattern));
+}
+
+//Returns true if the glob pattern only matches a single literal name (returned
+//in literal), which can then be looked up directly instead of being matched
+//against every candidate name.
+bool glob_pattern_to_literal(const std::string& glob_pattern, std::string& literal) {
+    //Decide on the regex the pattern converts to, so that a direct look-up
+    //matches exactly what the regex would
+    std::string regex_str = glob_pattern_to_regex_str(glob_pattern);
+
+    literal.clear();
+    for (size_t i = 0; i < regex_str.size(); ++i) {
+        char c = regex_str[i];
+        if (c == '\\') {
+            //An escaped punctuation character is literal (e.g. '\.' or '\['), while
+            //escaped alphanumerics are character classes or back-references (e.g. '\d')
+            if (i + 1 == regex_str.size() || std::isalnum(static_cast<unsigned char>(regex_str[i + 1]))) {
+                return false;
+            }
+            literal += regex_str[++i];
+        } else if (c == '\0' || std::strchr("^$.|?*+()[]{}", c)) {
+            return false;
+        } else {
+            literal += c;
+        }
+    }
+    return true;
 }
@@ -11,6 +11,7 @@
 #include <tbb/task_group.h>
 #include <tbb/parallel_for_each.h>
 #include <tbb/combinable.h>
+#include <tbb/parallel_for.h>
 #endif
 
 template<typename T>
@@ -22,6 +23,51 @@ void nodes_to_pins(T nodes, const AtomLookup& atom_lookup, std::vector<AtomPinId
     }
 }
 
+//Number of timing graph nodes updated together when updating slacks or criticalities in parallel
+constexpr size_t NODE_UPDATE_CHUNK_SIZE = 4096;
+
+//Calls update_node() on each of the nodes, recording the (valid) pins it returns in modified_pins.
+//
+//The nodes are processed in fixed size chunks, each recording its own modified pins, which are then
+//appended in chunk order: the modified pins are in the same (node) order as for a serial update.
+//update_node() must be safe to call concurrently on different nodes.
+template<typename NodeRange, typename UpdateNode>
+void update_nodes_in_chunks(const NodeRange& nodes, const UpdateNode& update_node, std::vector<AtomPinId>& modified_pins) {
+    size_t num_nodes = nodes.size();
+    size_t num_chunks = (num_nodes + NODE_UPDATE_CHUNK_SIZE - 1) / NODE_UPDATE_CHUNK_SIZE;
+
+#if defined(VPR_USE_TBB)
+    if (num_chunks > 1) {
+        std::vector<std::vector<AtomPinId>> chunk_modified_pins(num_chunks);
+        tbb::parallel_for(size_t(0), num_chunks, [&](size_t ichunk) {
+            auto first = nodes.begin() + ichunk * NODE_UPDATE_CHUNK_SIZE;
+            auto last = nodes.begin() + std::min(num_nodes, (ichunk + 1) * NODE_UPDATE_CHUNK_SIZE);
+            for (auto it = first; it != last; ++it) {
+                AtomPinId modified_pin = update_node(*it);
+                if (modified_pin) {
+                    chunk_modified_pins[ichunk].push_back(modified_pin);
+                }
+            }
+        });
+
+        for (const std::vector<AtomPinId>& pins : chunk_modified_pins) {
+            modified_pins.insert(modified_pins.end(), pins.begin(), pins.end());
+        }
+        return;
+    }
+#else
+    (void)num_chunks;
+#endif
+
+    //Few nodes (or no TBB), update serially
+    for (tatum::NodeId node : nodes) {
+        AtomPinId modified_pin = update_node(node);
+        if (modified_pin) {
+            modified_pins.push_back(modified_pin);
+        }
+    }
+}
+
 /*
  * SetupSlackCrit
  */
@@ -93,13 +139,9 @@ void SetupSlackCrit::update_slacks(const tatum::SetupTimingAnalyzer& analyzer) {
 
     pins_with_modified_slacks_.clear();
 
-    /** We could do this in parallel, but the overhead of combining the results is not worth it */
-    for (tatum::NodeId node : nodes) {
-        AtomPinId modified_pin = update_pin_slack(node, analyzer);
-        if (modified_pin) {
-            pins_with_modified_slacks_.push_back(modified_pin);
-        }
-    }
+    //Each pin is only written through its external tnode, so the nodes can be updated in parallel
+    update_nodes_in_chunks(
+        nodes, [&, this](tatum::NodeId node) { return update_pin_slack(node, analyzer); }, pins_with_modified_slacks_);
 
     ++incr_slack_updates_;
     incr_slack_update_time_sec_ += timer.elapsed_sec();
@@ -338,13 +380,9 @@ template<typename NodeRange>
 void SetupSlackCrit::update_pin_criticalities_from_nodes(const NodeRange& nodes, const tatum::SetupTimingAnalyzer& analyzer) {
     pins_with_modified_criticalities_.clear();
 
-    /** We could do this in parallel, but the overhead of combining the results is not worth it */
-    for (tatum::NodeId node : nodes) {
-        AtomPinId modified_pin = update_pin_criticality(node, analyzer);
-        if (modified_pin) {
-            pins_with_modified_criticalities_.push_back(modified_pin);
-        }
-    }
+    //Each pin is only written through its external tnode, so the nodes can be updated in parallel
+    update_nodes_in_chunks(
+        nodes, [&, this](tatum::NodeId node) { return update_pin_criticality(node, analyzer); }, pins_with_modified_criticalities_);
 }
 
 AtomPinId SetupSlackCrit::update_pin_criticality(const tatum::NodeId node,
@@ -216,10 +216,18 @@
  * for convenience (i.e. both map to the same tnode).
  *
  */
+#include <algorithm>
+#include <limits>
 #include <set>
+#include <tuple>
+
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
 
 #include "logic_types.h"
 #include "vtr_log.h"
+#include "vtr_util.h"
 
 #include "timing_graph_builder.h"
 #include "vpr_error.h"
@@ -233,6 +241,12 @@ using tatum::NodeId;
 using tatum::NodeType;
 using tatum::TimingGraph;
 
+//The local tnode index of a block timing sub-graph standing for no tnode
+static constexpr size_t NO_TNODE = std::numeric_limits<size_t>::max();
+
+//The number of blocks whose timing sub-graphs are built at once
+static constexpr size_t BLOCK_CHUNK_SIZE = 1 << 16;
+
 template<class K, class V>
 tatum::util::linear_map<K, V> remap_valid(const tatum::util::linear_map<K, V>& data, const tatum::util::linear_map<K, K>& id_map) {
     tatum::util::linear_map<K, V> new_data;
@@ -249,6 +263,66 @@ tatum::util::linear_map<K, V> remap_valid(const tatum::util::linear_map<K, V>& d
     return new_data;
 }
 
+//The timing sub-graph of a netlist block: its timing nodes, their mapping to the block's pins, and
+//the edges between them, which are numbered locally to the block until the sub-graph is added to the
+//timing graph (see add_subgraph_to_timing_graph()). The messages and error raised while building the
+//sub-graph are also kept, so they are reported in netlist order.
+struct TimingGraphBuilder::t_block_timing_subgraph {
+    struct t_pin_tnode {
+        AtomPinId pin;
+        size_t tnode;
+        BlockTnode block_tnode_type;
+    };
+
+    struct t_edge {
+        tatum::EdgeType type;
+        size_t src_tnode;
+        size_t sink_tnode;
+    };
+
+    struct t_message {
+        bool is_warning;
+        std::string text;
+    };
+
+    struct t_clock_buffer_edge {
+        size_t edge;
+        AtomPinId src_pin;
+        AtomPinId sink_pin;
+    };
+
+    std::vector<NodeType> node_types;
+    std::vector<t_pin_tnode> pin_tnodes; //In the order the mappings are set
+    std::vector<t_edge> edges;           //In the order the edges are added
+    std::vector<t_message> messages;
+    std::vector<t_clock_buffer_edge> clock_buffer_edges; //The edges added to let clocks propagate through primitives
+    bool allow_dangling_combinational_nodes = false;
+    std::string error;
+
+    size_t add_node(NodeType type) {
+        node_types.push_back(type);
+        return node_types.size() - 1;
+    }
+
+    void set_atom_pin_tnode(AtomPinId pin, size_t tnode, BlockTnode block_tnode_type) {
+        pin_tnodes.push_back({pin, tnode, block_tnode_type});
+    }
+
+    //Returns the tnode of the pin (NO_TNODE if none). Blocks only have a few pins, so they are searched linearly.
+    size_t atom_pin_tnode(AtomPinId pin, BlockTnode block_tnode_type = BlockTnode::EXTERNAL) const {
+        for (auto itr = pin_tnodes.rbegin(); itr != pin_tnodes.rend(); ++itr) {
+            if (itr->pin == pin && itr->block_tnode_type == block_tnode_type) {
+                return itr->tnode;
+            }
+        }
+        return NO_TNODE;
+    }
+
+    void add_edge(tatum::EdgeType type, size_t src_tnode, size_t sink_tnode) {
+        edges.push_back({type, src_tnode, sink_tnode});
+    }
+};
+
 TimingGraphBuilder::TimingGraphBuilder(const AtomNetlist& netlist,
                                        AtomLookup& netlist_lookup,
                                        const LogicalModels& models)
@@ -258,9 +332,11 @@ TimingGraphBuilder::TimingGraphBuilder(const AtomNetlist& netlist,
     //pass
 }
 
-std::unique_ptr<TimingGraph> TimingGraphBuilder::timing_graph(bool allow_dangling_combinational_nodes) {
+std::unique_ptr<TimingGraph> TimingGraphBuilder::timing_graph(bool allow_dangling_combinational_nodes, bool opt_layout) {
     build(allow_dangling_combinational_nodes);
-    opt_memory_layout();
+    if (opt_layout) {
+        opt_memory_layout();
+    }
 
     VTR_ASSERT(tg_);
 
@@ -282,15 +358,30 @@ void TimingGraphBuilder::build(bool allow_dangling_combinational_nodes) {
     //each block (i.e. the timing nodes and internal edges of the block)
     //
     //Note that this does not add timing graph edges which are external to each block.
-    for (AtomBlockId blk : netlist_.blocks()) {
-        AtomBlockType blk_type = netlist_.block_type(blk);
+    //
+    //The sub-graphs of a chunk of blocks are built independently (in parallel), then
+    //added to the timing graph in netlist order, so the node and edge ids do not
+    //depend on the number of threads.
+    auto blocks = netlist_.blocks();
+    size_t num_blocks = blocks.size();
+    std::vector<t_block_timing_subgraph> subgraphs;
+    for (size_t chunk_begin = 0; chunk_begin < num_blocks; chunk_begin += BLOCK_CHUNK_SIZE) {
+        size_t chunk_size = std::min(BLOCK_CHUNK_SIZE, num_blocks - chunk_begin);
+        subgraphs.assign(chunk_size, t_block_timing_subgraph());
+
+        auto build_subgraph = [&](size_t iblk) {
+            build_block_timing_subgraph(*(blocks.begin() + chunk_begin + iblk), subgraphs[iblk]);
+        };
+#if defined(VPR_USE_TBB)
+        tbb::parallel_for(size_t(0), chunk_size, build_subgraph);
+#else
+        for (size_t iblk = 0; iblk < chunk_size; iblk++) {
+            build_subgraph(iblk);
+        }
+#endif
 
-        if (blk_type == AtomBlockType::INPAD || blk_type == AtomBlockType::OUTPAD) {
-            add_io_to_timing_graph(blk);
-        } else if (blk_type == AtomBlockType::BLOCK) {
-            add_block_to_timing_graph(blk);
-        } else {
-            VPR_FATAL_ERROR(VPR_ERROR_TIMING, "Unrecognized atom block type while constructing timing graph");
+        for (const t_block_timing_subgraph& subgraph : subgraphs) {
+            add_subgraph_to_timing_graph(subgraph);
         }
     }
 
@@ -323,8 +414,61 @@ void TimingGraphBuilder::opt_memory_layout() {
     remap_ids(id_map);
 }
 
+//Creates the timing sub-graph of a netlist block (primary I/O or primitive)
+void TimingGraphBuilder::build_block_timing_subgraph(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const {
+    AtomBlockType blk_type = netlist_.block_type(blk);
+
+    if (blk_type == AtomBlockType::INPAD || blk_type == AtomBlockType::OUTPAD) {
+        add_io_to_timing_subgraph(blk, subgraph);
+    } else if (blk_type == AtomBlockType::BLOCK) {
+        add_block_to_timing_subgraph(blk, subgraph);
+    } else {
+        subgraph.error = "Unrecognized atom block type while constructing timing graph";
+    }
+}
+
+//Adds the nodes and edges of a block's timing sub-graph to the timing graph
+void TimingGraphBuilder::add_subgraph_to_timing_graph(const t_block_timing_subgraph& subgraph) {
+    for (const auto& message : subgraph.messages) {
+        if (message.is_warning) {
+            VTR_LOG_WARN("%s", message.text.c_str());
+        } else {
+            VTR_LOG("%s", message.text.c_str());
+        }
+    }
+
+    if (!subgraph.error.empty()) {
+        VPR_FATAL_ERROR(VPR_ERROR_TIMING, "%s", subgraph.error.c_str());
+    }
+
+    if (subgraph.allow_dangling_combinational_nodes) {
+        tg_->set_allow_dangling_combinational_nodes(true);
+    }
+
+    std::vector<NodeId> tnodes;
+    tnodes.reserve(subgraph.node_types.size());
+    for (NodeType node_type : subgraph.node_types) {
+        tnodes.push_back(tg_->add_node(node_type));
+    }
+
+    for (const auto& pin_tnode : subgraph.pin_tnodes) {
+        netlist_lookup_.set_atom_pin_tnode(pin_tnode.pin, tnodes[pin_tnode.tnode], pin_tnode.block_tnode_type);
+    }
+
+    for (const auto& edge : subgraph.edges) {
+        tg_->add_edge(edge.type, tnodes[edge.src_tnode], tnodes[edge.sink_tnode]);
+    }
+
+    for (const auto& clock_buffer_edge : subgraph.clock_buffer_edges) {
+        const auto& edge = subgraph.edges[clock_buffer_edge.edge];
+        VTR_LOG("Adding edge from '%s' (tnode: %zu) -> '%s' (tnode: %zu) to allow clocks to propagate\n",
+                netlist_.pin_name(clock_buffer_edge.src_pin).c_str(), size_t(tnodes[edge.src_tnode]),
+                netlist_.pin_name(clock_buffer_edge.sink_pin).c_str(), size_t(tnodes[edge.sink_tnode]));
+    }
+}
+
 //Creates the timing graph nodes for the associated primary I/O
-void TimingGraphBuilder::add_io_to_timing_graph(const AtomBlockId blk) {
+void TimingGraphBuilder::add_io_to_timing_subgraph(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const {
     NodeType node_type;
     AtomPinId pin;
     if (netlist_.block_type(blk) == AtomBlockType::INPAD) {
@@ -351,13 +495,13 @@ void TimingGraphBuilder::add_io_to_timing_graph(const AtomBlockId blk) {
         }
     }
 
-    NodeId tnode = tg_->add_node(node_type);
+    size_t tnode = subgraph.add_node(node_type);
 
-    netlist_lookup_.set_atom_pin_tnode(pin, tnode, BlockTnode::EXTERNAL);
+    subgraph.set_atom_pin_tnode(pin, tnode, BlockTnode::EXTERNAL);
 }
 
 //Creates the timing graph nodes and internal edges for a netlist block
-void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
+void TimingGraphBuilder::add_block_to_timing_subgraph(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const {
     /*
      * How the code builds the primitive timing sub-graph
      * -------------------------------------------------
@@ -391,15 +535,18 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
      * SOURCE (and leave any combinational inputs to that node disconnected).
      */
 
-    auto clock_generator_tnodes = create_block_timing_nodes(blk);
-    create_block_internal_data_timing_edges(blk, clock_generator_tnodes);
-    create_block_internal_clock_timing_edges(blk, clock_generator_tnodes);
+    auto clock_generator_tnodes = create_block_timing_nodes(blk, subgraph);
+    create_block_internal_data_timing_edges(blk, clock_generator_tnodes, subgraph);
+    if (!subgraph.error.empty()) {
+        return;
+    }
+    create_block_internal_clock_timing_edges(blk, clock_generator_tnodes, subgraph);
 }
 
 //Constructs the timing graph nodes for the specified block
 //
 //Returns the set of created tnodese which are clock generators
-std::set<tatum::NodeId> TimingGraphBuilder::create_block_timing_nodes(const AtomBlockId blk) {
+std::set<size_t> TimingGraphBuilder::create_block_timing_nodes(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const {
     std::set<std::string> output_ports_used_as_combinational_sinks;
 
     //Create the tnodes corresponding to input pins
@@ -409,26 +556,26 @@ std::set<tatum::NodeId> TimingGraphBuilder::create_block_timing_nodes(const Atom
         //Inspect the port model to determine pin type
         const t_model_ports* model_port = netlist_.port_model(input_port);
 
-        NodeId tnode;
+        size_t tnode;
         VTR_ASSERT(!model_port->is_clock);
         if (model_port->clock.empty()) {
             //No clock => combinational input
-            tnode = tg_->add_node(NodeType::IPIN);
+            tnode = subgraph.add_node(NodeType::IPIN);
 
             //A combinational pin is really both internal and external, mark it internal here
             //and external in the default case below
-            netlist_lookup_.set_atom_pin_tnode(input_pin, tnode, BlockTnode::INTERNAL);
+            subgraph.set_atom_pin_tnode(input_pin, tnode, BlockTnode::INTERNAL);
         } else {
             //This is a sequential data input (i.e. a sequential data capture point/timing path end-point)
-            tnode = tg_->add_node(NodeType::SINK);
+            tnode = subgraph.add_node(NodeType::SINK);
 
             if (!model_port->combinational_sink_ports.empty()) {
                 //There is an internal combinational connection starting at this sequential input
                 //pin. This is a new timing path and hence we must create a new SOURCE node.
 
                 //Create the internal source
-                NodeId internal_tnode = tg_->add_node(NodeType::SOURCE);
-                netlist_lookup_.set_atom_pin_tnode(input_pin, internal_tnode, BlockTnode::INTERNAL);
+                size_t internal_tnode = subgraph.add_node(NodeType::SOURCE);
+                subgraph.set_atom_pin_tnode(input_pin, internal_tnode, BlockTnode::INTERNAL);
             }
         }
 
@@ -439,7 +586,7 @@ std::set<tatum::NodeId> TimingGraphBuilder::create_block_timing_nodes(const Atom
                                                         model_port->combinational_sink_ports.end());
 
         //Save the pin to external tnode mapping
-        netlist_lookup_.set_atom_pin_tnode(input_pin, tnode, BlockTnode::EXTERNAL);
+        subgraph.set_atom_pin_tnode(input_pin, tnode, BlockTnode::EXTERNAL);
     }
 
     //Create the clock pins
@@ -452,23 +599,23 @@ std::set<tatum::NodeId> TimingGraphBuilder::create_block_timing_nodes(const Atom
         VTR_ASSERT(model_port->is_clock);
         VTR_ASSERT(model_port->clock.empty());
 
-        NodeId tnode = tg_->add_node(NodeType::CPIN);
+        size_t tnode = subgraph.add_node(NodeType::CPIN);
 
-        netlist_lookup_.set_atom_pin_tnode(clock_pin, tnode, BlockTnode::EXTERNAL);
+        subgraph.set_atom_pin_tnode(clock_pin, tnode, BlockTnode::EXTERNAL);
     }
 
     //Create the output pins
-    std::set<tatum::NodeId> clock_generator_tnodes;
+    std::set<size_t> clock_generator_tnodes;
     for (AtomPinId output_pin : netlist_.block_output_pins(blk)) {
         AtomPortId output_port = netlist_.pin_port(output_pin);
 
         //Inspect the port model to determine pin type
         const t_model_ports* model_port = netlist_.port_model(output_port);
 
-        NodeId tnode;
+        size_t tnode;
         if (is_netlist_clock_source(output_pin)) {
             //A generated clock source
-            tnode = tg_->add_node(NodeType::SOURCE);
+            tnode = subgraph.add_node(NodeType::SOURCE);
 
             clock_generator_tnodes.insert(tnode);
 
@@ -476,56 +623,56 @@ std::set<tatum::NodeId> TimingGraphBuilder::create_block_timing_nodes(const Atom
                 //An implicit clock source, possibly clock derived from data
 
                 AtomNetId clock_net = netlist_.pin_net(output_pin);
-                VTR_LOG_WARN("Inferred implicit clock source %s for netlist clock %s (possibly data used as clock)\n",
-                             netlist_.pin_name(output_pin).c_str(), netlist_.net_name(clock_net).c_str());
+                subgraph.messages.push_back({true, vtr::string_fmt("Inferred implicit clock source %s for netlist clock %s (possibly data used as clock)\n",
+                                                                   netlist_.pin_name(output_pin).c_str(), netlist_.net_name(clock_net).c_str())});
 
                 //This type of situation often requires cutting paths between the implicit clock source and
                 //it's inputs which can cause dangling combinational nodes. Do not error if this occurs.
-                tg_->set_allow_dangling_combinational_nodes(true);
+                subgraph.allow_dangling_combinational_nodes = true;
             }
         } else {
             VTR_ASSERT_MSG(!model_port->is_clock, "Primitive data output (i.e. non-clock source output pin) should not be marked as a clock generator");
 
             if (model_port->clock.empty()) {
                 //No clock => combinational output
-                tnode = tg_->add_node(NodeType::OPIN);
+                tnode = subgraph.add_node(NodeType::OPIN);
 
                 //A combinational pin is really both internal and external, mark it internal here
                 //and external in the default case below
-                netlist_lookup_.set_atom_pin_tnode(output_pin, tnode, BlockTnode::INTERNAL);
+                subgraph.set_atom_pin_tnode(output_pin, tnode, BlockTnode::INTERNAL);
 
             } else {
                 VTR_ASSERT(!model_port->clock.empty());
                 //Has an associated clock => sequential output
-                tnode = tg_->add_node(NodeType::SOURCE);
+                tnode = subgraph.add_node(NodeType::SOURCE);
 
                 if (output_ports_used_as_combinational_sinks.count(model_port->name)) {
                     //There is a combinational path within the primitive terminating at this sequential output
 
                     //Create the internal sink node
-                    NodeId internal_tnode = tg_->add_node(NodeType::SINK);
-                    netlist_lookup_.set_atom_pin_tnode(output_pin, internal_tnode, BlockTnode::INTERNAL);
+                    size_t internal_tnode = subgraph.add_node(NodeType::SINK);
+                    subgraph.set_atom_pin_tnode(output_pin, internal_tnode, BlockTnode::INTERNAL);
                 }
             }
         }
 
         //Record as external tnode
-        netlist_lookup_.set_atom_pin_tnode(output_pin, tnode, BlockTnode::EXTERNAL);
+        subgraph.set_atom_pin_tnode(output_pin, tnode, BlockTnode::EXTERNAL);
     }
 
     return clock_generator_tnodes;
 }
 
-void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBlockId blk, const std::set<tatum::NodeId>& clock_generator_tnodes) {
+void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBlockId blk, const std::set<size_t>& clock_generator_tnodes, t_block_timing_subgraph& subgraph) const {
     //Connect the clock pins to the sources and sinks
     for (AtomPinId pin : netlist_.block_pins(blk)) {
         for (auto blk_tnode_type : {BlockTnode::EXTERNAL, BlockTnode::INTERNAL}) {
-            NodeId tnode = netlist_lookup_.atom_pin_tnode(pin, blk_tnode_type);
-            if (!tnode) continue;
+            size_t tnode = subgraph.atom_pin_tnode(pin, blk_tnode_type);
+            if (tnode == NO_TNODE) continue;
 
             if (clock_generator_tnodes.count(tnode)) continue; //Clock sources don't have incoming clock pin connections
 
-            auto node_type = tg_->node_type(tnode);
+            auto node_type = subgraph.node_types[tnode];
 
             if (node_type != NodeType::SOURCE && node_type != NodeType::SINK) continue;
 
@@ -546,8 +693,8 @@ void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBloc
             VTR_ASSERT(clk_pin);
 
             //Convert the pin to its tnode
-            NodeId clk_tnode = netlist_lookup_.atom_pin_tnode(clk_pin);
-            VTR_ASSERT(clk_tnode);
+            size_t clk_tnode = subgraph.atom_pin_tnode(clk_pin);
+            VTR_ASSERT(clk_tnode != NO_TNODE);
 
             //Determine the type of edge to create
             //This corresponds to how the clock (clk_tnode) relates
@@ -564,7 +711,7 @@ void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBloc
             }
 
             //Add the edge from the clock to the source/sink
-            tg_->add_edge(type, clk_tnode, tnode);
+            subgraph.add_edge(type, clk_tnode, tnode);
         }
     }
 
@@ -572,9 +719,9 @@ void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBloc
     //
     //These are typically used to represent clock buffers
     for (AtomPinId src_clock_pin : netlist_.block_clock_pins(blk)) {
-        NodeId src_tnode = netlist_lookup_.atom_pin_tnode(src_clock_pin, BlockTnode::EXTERNAL);
+        size_t src_tnode = subgraph.atom_pin_tnode(src_clock_pin, BlockTnode::EXTERNAL);
 
-        if (!src_tnode) continue;
+        if (src_tnode == NO_TNODE) continue;
 
         //Look-up the combinationally connected sink ports name on the port model
         AtomPortId src_port = netlist_.pin_port(src_clock_pin);
@@ -588,16 +735,18 @@ void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBloc
             //output port
             for (AtomPinId sink_pin : netlist_.port_pins(sink_port)) {
                 //Get the tnode of the sink
-                NodeId sink_tnode = netlist_lookup_.atom_pin_tnode(sink_pin, BlockTnode::EXTERNAL);
+                size_t sink_tnode = subgraph.atom_pin_tnode(sink_pin, BlockTnode::EXTERNAL);
+                VTR_ASSERT(sink_tnode != NO_TNODE);
 
-                tg_->add_edge(tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode);
-                VTR_LOG("Adding edge from '%s' (tnode: %zu) -> '%s' (tnode: %zu) to allow clocks to propagate\n", netlist_.pin_name(src_clock_pin).c_str(), size_t(src_tnode), netlist_.pin_name(sink_pin).c_str(), size_t(sink_tnode));
+                //Logged once the edge is added (and its tnodes are numbered)
+                subgraph.clock_buffer_edges.push_back({subgraph.edges.size(), src_clock_pin, sink_pin});
+                subgraph.add_edge(tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode);
             }
         }
     }
 }
 
-void TimingGraphBuilder::create_block_internal_data_timing_edges(const AtomBlockId blk, const std::set<tatum::NodeId>& clock_generator_tnodes) {
+void TimingGraphBuilder::create_block_internal_data_timing_edges(const AtomBlockId blk, const std::set<size_t>& clock_generator_tnodes, t_block_timing_subgraph& subgraph) const {
     //Connect the combinational edges from data input pins
     //
     //These edges may represent an intermediate (combinational) sub-path of a
@@ -611,11 +760,11 @@ void TimingGraphBuilder::create_block_internal_data_timing_edges(const AtomBlock
         //Note that we have already created all the relevant nodes, and appropriately labelled them as
         //internal/external. As a result, we only need to consider the 'internal' tnodes when creating
         //the edges within the current block.
-        NodeId src_tnode = netlist_lookup_.atom_pin_tnode(src_pin, BlockTnode::INTERNAL);
+        size_t src_tnode = subgraph.atom_pin_tnode(src_pin, BlockTnode::INTERNAL);
 
-        if (!src_tnode) continue;
+        if (src_tnode == NO_TNODE) continue;
 
-        NodeType src_type = tg_->node_type(src_tnode);
+        NodeType src_type = subgraph.node_types[src_tnode];
 
         //Look-up the combinationally connected sink ports name on the port model
         AtomPortId src_port = netlist_.pin_port(src_pin);
@@ -630,28 +779,29 @@ void TimingGraphBuilder::create_block_internal_data_timing_edges(const AtomBlock
             //output port
             for (AtomPinId sink_pin : netlist_.port_pins(sink_port)) {
                 //Get the tnode of the sink
-                NodeId sink_tnode = netlist_lookup_.atom_pin_tnode(sink_pin, BlockTnode::INTERNAL);
+                size_t sink_tnode = subgraph.atom_pin_tnode(sink_pin, BlockTnode::INTERNAL);
 
-                if (!sink_tnode) {
+                if (sink_tnode == NO_TNODE) {
                     //No tnode found, either a combinational clock generator or an error
 
                     //Try again looking for an external tnode
-                    sink_tnode = netlist_lookup_.atom_pin_tnode(sink_pin, BlockTnode::EXTERNAL);
+                    sink_tnode = subgraph.atom_pin_tnode(sink_pin, BlockTnode::EXTERNAL);
 
                     //Is the sink a clock generator?
-                    if (sink_tnode && clock_generator_tnodes.count(sink_tnode)) {
+                    if (sink_tnode != NO_TNODE && clock_generator_tnodes.count(sink_tnode)) {
                         //Do not create the edge
-                        VTR_LOG_WARN("Timing edge from %s to %s will not be created since %s has been identified as a clock generator\n",
-                                     netlist_.pin_name(src_pin).c_str(), netlist_.pin_name(sink_pin).c_str(), netlist_.pin_name(sink_pin).c_str());
+                        subgraph.messages.push_back({true, vtr::string_fmt("Timing edge from %s to %s will not be created since %s has been identified as a clock generator\n",
+                                                                           netlist_.pin_name(src_pin).c_str(), netlist_.pin_name(sink_pin).c_str(), netlist_.pin_name(sink_pin).c_str())});
                     } else {
-                        //Unknown
-                        VPR_FATAL_ERROR(VPR_ERROR_TIMING, "Unable to find matching sink tnode for timing edge from %s to %s",
-                                        netlist_.pin_name(src_pin).c_str(), netlist_.pin_name(src_pin).c_str());
+                        //Unknown (reported when the sub-graph is added to the timing graph)
+                        subgraph.error = vtr::string_fmt("Unable to find matching sink tnode for timing edge from %s to %s",
+                                                         netlist_.pin_name(src_pin).c_str(), netlist_.pin_name(src_pin).c_str());
+                        return;
                     }
 
                 } else {
                     //Valid tnode create the edge
-                    auto sink_type = tg_->node_type(sink_tnode);
+                    auto sink_type = subgraph.node_types[sink_tnode];
 
                     VTR_ASSERT_MSG((src_type == NodeType::IPIN && sink_type == NodeType::OPIN)
                                        || (src_type == NodeType::SOURCE && sink_type == NodeType::SINK)
@@ -660,7 +810,7 @@ void TimingGraphBuilder::create_block_internal_data_timing_edges(const AtomBlock
                                    "Internal primitive combinational edges must be between {IPIN, SOURCE} and {OPIN, SINK}");
 
                     //Add the edge between the pins
-                    tg_->add_edge(tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode);
+                    subgraph.add_edge(tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode);
                 }
             }
         }
@@ -731,7 +881,10 @@ tatum::EdgeId TimingGraphBuilder::find_scc_edge_to_break(std::vector<tatum::Node
 }
 
 void TimingGraphBuilder::remap_ids(const tatum::GraphIdMaps& id_mapping) {
-    //Update the pin-tnode mapping
+    //Collect the remapped pin-tnode mapping first: re-setting the pins one at a
+    //time would leave stale entries in the tnode -> pin lookup for old ids
+    //which are not re-used by a pin.
+    std::vector<std::tuple<AtomPinId, tatum::NodeId, BlockTnode>> new_pin_tnodes;
     for (BlockTnode type : {BlockTnode::EXTERNAL, BlockTnode::INTERNAL}) {
         for (auto kv : netlist_lookup_.atom_pin_tnodes(type)) {
             AtomPinId pin = kv.first;
@@ -741,9 +894,15 @@ void TimingGraphBuilder::remap_ids(const tatum::GraphIdMaps& id_mapping) {
 
             tatum::NodeId new_tnode = id_mapping.node_id_map[old_tnode];
 
-            netlist_lookup_.set_atom_pin_tnode(pin, new_tnode, type);
+            new_pin_tnodes.emplace_back(pin, new_tnode, type);
         }
     }
+
+    //Update the pin-tnode mapping
+    netlist_lookup_.clear_atom_pin_tnodes();
+    for (const auto& [pin, tnode, type] : new_pin_tnodes) {
+        netlist_lookup_.set_atom_pin_tnode(pin, tnode, type);
+    }
 }
 
 bool TimingGraphBuilder::is_netlist_clock_source(const AtomPinId pin) const {
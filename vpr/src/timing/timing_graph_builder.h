@@ -26,20 +26,33 @@ class TimingGraphBuilder {
                        AtomLookup& netlist_lookup,
                        const LogicalModels& models);
 
-    std::unique_ptr<tatum::TimingGraph> timing_graph(bool allow_dangling_combinational_nodes);
+    /**
+     * @brief Builds and returns the timing graph.
+     *
+     *   @param allow_dangling_combinational_nodes  Allow combinational nodes with no fan-in or fan-out
+     *   @param opt_layout                          Renumber the nodes and edges in level order (see opt_memory_layout())
+     */
+    std::unique_ptr<tatum::TimingGraph> timing_graph(bool allow_dangling_combinational_nodes, bool opt_layout = true);
 
   private:
     void build(bool allow_dangling_combinational_nodes);
     void opt_memory_layout();
 
-    void add_io_to_timing_graph(const AtomBlockId blk);
-    void add_block_to_timing_graph(const AtomBlockId blk);
+    //The timing nodes and internal edges of a netlist block, built independently of the timing graph
+    struct t_block_timing_subgraph;
+
+    //Builds the sub-graph of a block. Only reads the netlist, so the sub-graphs of several blocks can be built concurrently
+    void build_block_timing_subgraph(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const;
+    void add_subgraph_to_timing_graph(const t_block_timing_subgraph& subgraph);
+
+    void add_io_to_timing_subgraph(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const;
+    void add_block_to_timing_subgraph(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const;
     void add_net_to_timing_graph(const AtomNetId net);
 
-    //Helper functions for add_block_to_timing_graph()
-    std::set<tatum::NodeId> create_block_timing_nodes(const AtomBlockId blk);
-    void create_block_internal_data_timing_edges(const AtomBlockId blk, const std::set<tatum::NodeId>& clock_generator_tnodes);
-    void create_block_internal_clock_timing_edges(const AtomBlockId blk, const std::set<tatum::NodeId>& clock_generator_tnodes);
+    //Helper functions for add_block_to_timing_subgraph()
+    std::set<size_t> create_block_timing_nodes(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const;
+    void create_block_internal_data_timing_edges(const AtomBlockId blk, const std::set<size_t>& clock_generator_tnodes, t_block_timing_subgraph& subgraph) const;
+    void create_block_internal_clock_timing_edges(const AtomBlockId blk, const std::set<size_t>& clock_generator_tnodes, t_block_timing_subgraph& subgraph) const;
 
     void fix_comb_loops();
     tatum::EdgeId find_scc_edge_to_break(std::vector<tatum::NodeId> scc);
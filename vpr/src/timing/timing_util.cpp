@@ -58,13 +58,13 @@ tatum::TimingPathInfo find_least_slack_critical_path_delay(const tatum::TimingCo
     return crit_path_info;
 }
 
-float find_setup_total_negative_slack(const tatum::SetupTimingAnalyzer& setup_analyzer) {
+float find_setup_total_negative_slack(const tatum::SetupTimingAnalyzer& setup_analyzer, size_t corner) {
     auto& timing_ctx = g_vpr_ctx.timing();
 
     float tns = 0.;
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : setup_analyzer.setup_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().value(corner);
             if (slack < 0.) {
                 tns += slack;
             }
@@ -73,13 +73,13 @@ float find_setup_total_negative_slack(const tatum::SetupTimingAnalyzer& setup_an
     return tns;
 }
 
-float find_setup_worst_negative_slack(const tatum::SetupTimingAnalyzer& setup_analyzer) {
+float find_setup_worst_negative_slack(const tatum::SetupTimingAnalyzer& setup_analyzer, size_t corner) {
     auto& timing_ctx = g_vpr_ctx.timing();
 
     float wns = 0.;
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : setup_analyzer.setup_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().value(corner);
 
             if (slack < 0.) {
                 wns = std::min(wns, slack);
@@ -278,6 +278,41 @@ void write_setup_timing_summary(std::string_view timing_summary_filename, const
     }
 }
 
+void set_timing_corner_delay_scales(const std::vector<float>& extra_corner_delay_scales) {
+    auto& timing_ctx = g_vpr_ctx.mutable_timing();
+
+    VTR_ASSERT(extra_corner_delay_scales.size() < tatum::Time::num_corners());
+    timing_ctx.num_timing_corners = extra_corner_delay_scales.size() + 1;
+
+    //The primary corner uses the nominal delays, and unused corners duplicate it
+    timing_ctx.corner_delay_scales = tatum::Time(1.);
+    for (size_t icorner = 0; icorner < extra_corner_delay_scales.size(); icorner++) {
+        timing_ctx.corner_delay_scales.set_value(icorner + 1, extra_corner_delay_scales[icorner]);
+    }
+}
+
+void print_timing_corner_slacks(const tatum::SetupTimingAnalyzer& setup_analyzer, std::string_view prefix) {
+    auto& timing_ctx = g_vpr_ctx.timing();
+
+    for (size_t corner = 1; corner < timing_ctx.num_timing_corners; corner++) {
+        VTR_LOG("%ssetup WNS/TNS of timing corner %zu (delay scale %g): %g / %g ns\n",
+                prefix.data(), corner, timing_ctx.corner_delay_scales.value(corner),
+                sec_to_nanosec(find_setup_worst_negative_slack(setup_analyzer, corner)),
+                sec_to_nanosec(find_setup_total_negative_slack(setup_analyzer, corner)));
+    }
+}
+
+void print_timing_corner_slacks(const tatum::HoldTimingAnalyzer& hold_analyzer, std::string_view prefix) {
+    auto& timing_ctx = g_vpr_ctx.timing();
+
+    for (size_t corner = 1; corner < timing_ctx.num_timing_corners; corner++) {
+        VTR_LOG("%shold WNS/TNS of timing corner %zu (delay scale %g): %g / %g ns\n",
+                prefix.data(), corner, timing_ctx.corner_delay_scales.value(corner),
+                sec_to_nanosec(find_hold_worst_negative_slack(hold_analyzer, corner)),
+                sec_to_nanosec(find_hold_total_negative_slack(hold_analyzer, corner)));
+    }
+}
+
 void print_setup_timing_summary(const tatum::TimingConstraints& constraints,
                                 const tatum::SetupTimingAnalyzer& setup_analyzer,
                                 std::string_view prefix,
@@ -308,6 +343,7 @@ void print_setup_timing_summary(const tatum::TimingConstraints& constraints,
 
     VTR_LOG("%ssetup Worst Negative Slack (sWNS): %g ns\n", prefix.data(), setup_worst_neg_slack);
     VTR_LOG("%ssetup Total Negative Slack (sTNS): %g ns\n", prefix.data(), setup_total_neg_slack);
+    print_timing_corner_slacks(setup_analyzer, prefix);
     VTR_LOG("\n");
 
     VTR_LOG("%ssetup slack histogram:\n", prefix.data());
@@ -434,13 +470,13 @@ void print_setup_timing_summary(const tatum::TimingConstraints& constraints,
 /*
  * Hold-time related statistics
  */
-float find_hold_total_negative_slack(const tatum::HoldTimingAnalyzer& hold_analyzer) {
+float find_hold_total_negative_slack(const tatum::HoldTimingAnalyzer& hold_analyzer, size_t corner) {
     auto& timing_ctx = g_vpr_ctx.timing();
 
     float tns = 0.;
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : hold_analyzer.hold_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().value(corner);
             if (slack < 0.) {
                 tns += slack;
             }
@@ -519,13 +555,13 @@ float find_total_negative_slack_within_clb_blocks(const tatum::HoldTimingAnalyze
     return slack_in_block;
 }
 
-float find_hold_worst_negative_slack(const tatum::HoldTimingAnalyzer& hold_analyzer) {
+float find_hold_worst_negative_slack(const tatum::HoldTimingAnalyzer& hold_analyzer, size_t corner) {
     auto& timing_ctx = g_vpr_ctx.timing();
 
     float wns = 0.;
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : hold_analyzer.hold_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().value(corner);
 
             if (slack < 0.) {
                 wns = std::min(wns, slack);
@@ -616,6 +652,7 @@ void print_hold_timing_summary(const tatum::TimingConstraints& constraints,
 
     VTR_LOG("%shold Worst Negative Slack (hWNS): %g ns\n", prefix.data(), hold_worst_neg_slack);
     VTR_LOG("%shold Total Negative Slack (hTNS): %g ns\n", prefix.data(), hold_total_neg_slack);
+    print_timing_corner_slacks(hold_analyzer, prefix);
 
     /*For testing*/
     //VTR_LOG("Hold Total Negative Slack within clbs: %g ns\n", sec_to_nanosec(find_total_negative_slack_within_clb_blocks(hold_analyzer)));
@@ -29,11 +29,11 @@ tatum::TimingPathInfo find_longest_critical_path_delay(const tatum::TimingConstr
 //Returns the path delay of the least-slack critical timing path (i.e. across all domains)
 tatum::TimingPathInfo find_least_slack_critical_path_delay(const tatum::TimingConstraints& constraints, const tatum::SetupTimingAnalyzer& setup_analyzer);
 
-//Returns the total negative slack (setup) of all timing end-points and clock domain pairs
-float find_setup_total_negative_slack(const tatum::SetupTimingAnalyzer& setup_analyzer);
+//Returns the total negative slack (setup) of all timing end-points and clock domain pairs, in the specified timing corner
+float find_setup_total_negative_slack(const tatum::SetupTimingAnalyzer& setup_analyzer, size_t corner = 0);
 
-//Returns the worst negative slack (setup) across all timing end-points and clock domain pairs
-float find_setup_worst_negative_slack(const tatum::SetupTimingAnalyzer& setup_analyzer);
+//Returns the worst negative slack (setup) across all timing end-points and clock domain pairs, in the specified timing corner
+float find_setup_worst_negative_slack(const tatum::SetupTimingAnalyzer& setup_analyzer, size_t corner = 0);
 
 //Returns the slack at a particular node for the specified clock domains (if found), otherwise NAN
 float find_node_setup_slack(const tatum::SetupTimingAnalyzer& setup_analyzer, tatum::NodeId node, tatum::DomainId launch_domain, tatum::DomainId capture_domain);
@@ -49,6 +49,14 @@ std::vector<HistogramBucket> create_criticality_histogram(const Netlist<>& net_l
                                                           size_t num_bins = 10);
 
 //Print a useful summary of timing information
+//Sets the delay scale factors of the timing corners analyzed on top of the nominal (primary) one
+//(see --timing_corner_delay_scales)
+void set_timing_corner_delay_scales(const std::vector<float>& extra_corner_delay_scales);
+
+//Logs the worst and total negative slacks of each timing corner other than the primary one
+void print_timing_corner_slacks(const tatum::SetupTimingAnalyzer& setup_analyzer, std::string_view prefix);
+void print_timing_corner_slacks(const tatum::HoldTimingAnalyzer& hold_analyzer, std::string_view prefix);
+
 void print_setup_timing_summary(const tatum::TimingConstraints& constraints,
                                 const tatum::SetupTimingAnalyzer& setup_analyzer,
                                 std::string_view prefix,
@@ -57,11 +65,11 @@ void print_setup_timing_summary(const tatum::TimingConstraints& constraints,
 /*
  * Hold-time related statistics
  */
-//Returns the total negative slack (hold) of all timing end-points and clock domain pairs
-float find_hold_total_negative_slack(const tatum::HoldTimingAnalyzer& hold_analyzer);
+//Returns the total negative slack (hold) of all timing end-points and clock domain pairs, in the specified timing corner
+float find_hold_total_negative_slack(const tatum::HoldTimingAnalyzer& hold_analyzer, size_t corner = 0);
 
-//Returns the worst negative slack (hold) across all timing end-points and clock domain pairs
-float find_hold_worst_negative_slack(const tatum::HoldTimingAnalyzer& hold_analyzer);
+//Returns the worst negative slack (hold) across all timing end-points and clock domain pairs, in the specified timing corner
+float find_hold_worst_negative_slack(const tatum::HoldTimingAnalyzer& hold_analyzer, size_t corner = 0);
 
 //Returns the worst slack (hold) between the specified launch and capture clock domains
 float find_hold_worst_slack(const tatum::HoldTimingAnalyzer& hold_analyzer, const tatum::DomainId launch, const tatum::DomainId capture);
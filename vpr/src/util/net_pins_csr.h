@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Flat (CSR) snapshot of the pins of the nets of a netlist, and of the blocks of those pins.
+ *
+ * Walking net_pins() and then pin_block() for every pin of every net jumps between several arrays
+ * of the netlist. The placement cost, the placer timing and the routing setup all do it for every
+ * net, so ClusteringContext keeps one NetPinsCsr of the clustered netlist (clb_net_pins) which they
+ * share: the pins of all nets, net after net (driver first), and the block of each pin next to it.
+ *
+ * The snapshot is immutable: whoever changes the nets or pins of the netlist (e.g. compress())
+ * has to rebuild it.
+ */
+
+#include <vector>
+
+#include "clustered_netlist_fwd.h"
+#include "vtr_array_view.h"
+#include "vtr_assert.h"
+
+template<typename NetId, typename PinId, typename BlockId>
+class NetPinsCsr {
+  public:
+    NetPinsCsr() = default;
+
+    /** Snapshot of the pins of the nets of \p nlist, in the order of Netlist::net_pins() */
+    template<typename Netlist>
+    explicit NetPinsCsr(const Netlist& nlist) {
+        offsets_.reserve(nlist.nets().size() + 1);
+        offsets_.push_back(0);
+        pins_.reserve(nlist.pins().size());
+        blocks_.reserve(nlist.pins().size());
+        for (NetId net_id : nlist.nets()) {
+            VTR_ASSERT(size_t(net_id) + 1 == offsets_.size());
+            for (PinId pin_id : nlist.net_pins(net_id)) {
+                pins_.push_back(pin_id);
+                blocks_.push_back(pin_id ? BlockId(nlist.pin_block(pin_id)) : BlockId::INVALID());
+            }
+            offsets_.push_back(pins_.size());
+        }
+        num_netlist_pins_ = nlist.pins().size();
+    }
+
+    size_t num_nets() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    /** Number of pins in the flat arrays, including the missing drivers of undriven nets */
+    size_t num_pins() const { return pins_.size(); }
+
+    /** Index of the driver of \p net_id in the flat arrays: its pin `ipin` is at net_pin_offset(net_id) + ipin */
+    size_t net_pin_offset(NetId net_id) const { return offsets_[size_t(net_id)]; }
+
+    /** Same as Netlist::net_pins() */
+    vtr::array_view<const PinId> net_pins(NetId net_id) const {
+        return vtr::array_view<const PinId>(pins_.data() + offsets_[size_t(net_id)], net_size(net_id));
+    }
+
+    /** Same as Netlist::net_sinks() */
+    vtr::array_view<const PinId> net_sinks(NetId net_id) const {
+        VTR_ASSERT_SAFE(net_size(net_id) > 0);
+        return vtr::array_view<const PinId>(pins_.data() + offsets_[size_t(net_id)] + 1, net_size(net_id) - 1);
+    }
+
+    /** The blocks of net_pins(net_id) */
+    vtr::array_view<const BlockId> net_pin_blocks(NetId net_id) const {
+        return vtr::array_view<const BlockId>(blocks_.data() + offsets_[size_t(net_id)], net_size(net_id));
+    }
+
+    /** Block of the pin `ipin` of \p net_id (0 is the driver) */
+    BlockId net_pin_block(NetId net_id, size_t ipin) const {
+        VTR_ASSERT_SAFE(ipin < net_size(net_id));
+        return blocks_[offsets_[size_t(net_id)] + ipin];
+    }
+
+    /** Cheap check that the snapshot was built from \p nlist as it is now (same numbers of nets and pins) */
+    template<typename Netlist>
+    bool is_current(const Netlist& nlist) const {
+        return !offsets_.empty() && num_nets() == nlist.nets().size() && num_netlist_pins_ == nlist.pins().size();
+    }
+
+  private:
+    size_t net_size(NetId net_id) const {
+        return offsets_[size_t(net_id) + 1] - offsets_[size_t(net_id)];
+    }
+
+    std::vector<size_t> offsets_; ///<[0..num_nets()]: the pins of net n are at [offsets_[n]..offsets_[n+1]-1]
+    std::vector<PinId> pins_;
+    std::vector<BlockId> blocks_; ///<Block of each pin in pins_
+    size_t num_netlist_pins_ = 0;
+};
+
+using ClbNetPinsCsr = NetPinsCsr<ClusterNetId, ClusterPinId, ClusterBlockId>;
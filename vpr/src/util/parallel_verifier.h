@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Parallel loops for the independent verifiers (verify_clustering(), verify_placement()).
+ *
+ * The checks of the verifiers are independent from one block (or macro, grid column, ...) to
+ * the next, so they can run in parallel. Their errors are collected per chunk of items, and
+ * logged once all the items are checked, in the order of the items: the log is the same as the
+ * one of a serial loop.
+ */
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "vtr_log.h"
+#include "vtr_util.h"
+
+#if defined(VPR_USE_TBB)
+#include <tbb/parallel_for.h>
+#endif
+
+/** The errors found by the checks of a chunk of items, in the order they were found */
+class VerifierErrors {
+  public:
+    /** Records an error, which VTR_LOG_ERROR() will print at file:line. Use VERIFIER_LOG_ERROR() */
+    void add_error(const char* file, int line, std::string msg) {
+        errors_.push_back({file, line, std::move(msg)});
+    }
+
+    size_t size() const { return errors_.size(); }
+
+    /** Logs the recorded errors with VTR_LOG_ERROR() */
+    void log() const {
+        for (const t_error& error : errors_) {
+            VTR_LOGF_ERROR(error.file, error.line, "%s", error.msg.c_str());
+        }
+    }
+
+  private:
+    struct t_error {
+        const char* file;
+        int line;
+        std::string msg;
+    };
+
+    std::vector<t_error> errors_;
+};
+
+/** Records an error in VerifierErrors, with the printf-style arguments of VTR_LOG_ERROR() */
+#define VERIFIER_LOG_ERROR(errors, ...) (errors).add_error(__FILE__, __LINE__, vtr::string_fmt(__VA_ARGS__))
+
+/**
+ * @brief Calls check_item(i, errors) for each i in [0, num_items), in parallel if VPR is built
+ *        with TBB, where check_item() records the errors of item i in errors (VerifierErrors&).
+ *
+ * The errors are then logged in the order of the items.
+ *
+ *  @return The number of errors.
+ */
+template<typename CheckItem>
+unsigned parallel_verify(size_t num_items, const CheckItem& check_item) {
+    // Items are checked in fixed chunks, so the errors can be put back in item order
+    constexpr size_t CHUNK_SIZE = 512;
+    const size_t num_chunks = (num_items + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<VerifierErrors> chunk_errors(num_chunks);
+
+    auto check_chunk = [&](size_t ichunk) {
+        const size_t end = std::min(num_items, (ichunk + 1) * CHUNK_SIZE);
+        for (size_t i = ichunk * CHUNK_SIZE; i < end; i++) {
+            check_item(i, chunk_errors[ichunk]);
+        }
+    };
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), num_chunks, check_chunk);
+#else
+    for (size_t ichunk = 0; ichunk < num_chunks; ichunk++) {
+        check_chunk(ichunk);
+    }
+#endif
+
+    unsigned num_errors = 0;
+    for (const VerifierErrors& errors : chunk_errors) {
+        errors.log();
+        num_errors += errors.size();
+    }
+    return num_errors;
+}
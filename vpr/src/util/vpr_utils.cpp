@@ -1,3 +1,4 @@
+#include <unordered_map>
 #include <unordered_set>
 #include <regex>
 #include <algorithm>
@@ -42,6 +43,18 @@ static AtomPinId find_atom_pin_for_pb_route_id(ClusterBlockId clb, int pb_route_
 static bool block_type_contains_blif_model(t_logical_block_type_ptr type, const std::regex& blif_model_regex);
 static bool pb_type_contains_blif_model(const t_pb_type* pb_type, const std::regex& blif_model_regex);
 
+/**
+ * @brief Returns the internal pins of the cluster which are on a path between two of its terminals
+ *        (the pins on the tile and the pins of its primitives).
+ *
+ * The other internal pins belong to used pbs but only lead to (or come from) child pbs which are not
+ * used, e.g. the inputs of a BLE whose LUT is unused. They would only add dead-end RR nodes, and
+ * their fan-in edges, to the flat routing graph.
+ */
+static std::vector<int> get_cluster_live_internal_pins(t_physical_tile_type_ptr physical_type,
+                                                       ClusterBlockId cluster_blk_id,
+                                                       int abs_cap);
+
 /******************** Subroutine definitions *********************************/
 
 /**
@@ -1267,8 +1280,12 @@ int num_ext_inputs_atom_block(AtomBlockId blk_id) {
  *              Pointer to t_pb to be freed
  *  @param atom_pb_bimap
  *              Reference to the atom to pb bimap to free the data from
+ *  @param clear_atom_clb
+ *              Also clear the cluster of the freed atoms in the atom lookup of the
+ *              global atom context. Legalizers working concurrently on copies of
+ *              clusters (the speculative replicas) must leave it alone.
  */
-void free_pb(t_pb* pb, AtomPBBimap& atom_pb_bimap) {
+void free_pb(t_pb* pb, AtomPBBimap& atom_pb_bimap, bool clear_atom_clb) {
     if (pb == nullptr) {
         return;
     }
@@ -1288,7 +1305,7 @@ void free_pb(t_pb* pb, AtomPBBimap& atom_pb_bimap) {
         for (i = 0; i < pb_type->modes[mode].num_pb_type_children && pb->child_pbs != nullptr; i++) {
             for (j = 0; j < pb_type->modes[mode].pb_type_children[i].num_pb && pb->child_pbs[i] != nullptr; j++) {
                 if (pb->child_pbs[i][j].name != nullptr || pb->child_pbs[i][j].child_pbs != nullptr) {
-                    free_pb(&pb->child_pbs[i][j], atom_pb_bimap);
+                    free_pb(&pb->child_pbs[i][j], atom_pb_bimap, clear_atom_clb);
                 }
             }
             if (pb->child_pbs[i]) {
@@ -1305,11 +1322,12 @@ void free_pb(t_pb* pb, AtomPBBimap& atom_pb_bimap) {
 
     } else {
         /* Primitive */
-        auto& atom_ctx = g_vpr_ctx.mutable_atom();
         auto blk_id = atom_pb_bimap.pb_atom(pb);
         if (blk_id) {
             //Update atom netlist mapping
-            atom_ctx.mutable_lookup().set_atom_clb(blk_id, ClusterBlockId::INVALID());
+            if (clear_atom_clb) {
+                g_vpr_ctx.mutable_atom().mutable_lookup().set_atom_clb(blk_id, ClusterBlockId::INVALID());
+            }
             atom_pb_bimap.set_atom_pb(blk_id, nullptr);
         }
         atom_pb_bimap.set_atom_pb(AtomBlockId::INVALID(), pb);
@@ -1887,7 +1905,13 @@ std::vector<int> get_cluster_netlist_intra_tile_pins_at_loc(const t_physical_til
         ClusterBlockId cluster_blk_id = grid_block.block_at_location({tile_loc, abs_cap});
         VTR_ASSERT(cluster_blk_id != ClusterBlockId::INVALID());
 
-        cluster_internal_pins = get_cluster_internal_pins(cluster_blk_id);
+        // The edges of the pins on a chain are built from the chain (not from the pb graph), so the dead-end
+        // pins are only pruned from the clusters without chains
+        if (pin_chains[cluster_blk_id].chain_sink.empty()) {
+            cluster_internal_pins = get_cluster_live_internal_pins(physical_type, cluster_blk_id, abs_cap);
+        } else {
+            cluster_internal_pins = get_cluster_internal_pins(cluster_blk_id);
+        }
         const std::unordered_set<int>& cluster_pin_chains = pin_chains_num[cluster_blk_id];
         const std::vector<int>& cluster_chain_sinks = pin_chains[cluster_blk_id].chain_sink;
         const std::vector<int>& cluster_pin_chain_idx = pin_chains[cluster_blk_id].pin_chain_idx;
@@ -1909,6 +1933,68 @@ std::vector<int> get_cluster_netlist_intra_tile_pins_at_loc(const t_physical_til
     return pin_num_vec;
 }
 
+static std::vector<int> get_cluster_live_internal_pins(t_physical_tile_type_ptr physical_type,
+                                                       ClusterBlockId cluster_blk_id,
+                                                       int abs_cap) {
+    t_logical_block_type_ptr logical_block = std::get<3>(get_cluster_blk_physical_spec(cluster_blk_id));
+
+    // The pins of the cluster (on the tile first) and the pb graph edges between them
+    std::vector<int> cluster_pins = get_cluster_block_pins(physical_type, cluster_blk_id, abs_cap);
+    const size_t num_tile_pins = physical_type->num_pins / physical_type->capacity;
+
+    std::unordered_map<int, size_t> pin_index;
+    for (size_t ipin = 0; ipin < cluster_pins.size(); ipin++) {
+        pin_index.emplace(cluster_pins[ipin], ipin);
+    }
+
+    std::vector<std::vector<size_t>> fanout(cluster_pins.size());
+    std::vector<std::vector<size_t>> fanin(cluster_pins.size());
+    for (size_t ipin = 0; ipin < cluster_pins.size(); ipin++) {
+        for (int sink_pin : get_physical_pin_sink_pins(physical_type, logical_block, cluster_pins[ipin])) {
+            auto it = pin_index.find(sink_pin);
+            if (it != pin_index.end()) {
+                fanout[ipin].push_back(it->second);
+                fanin[it->second].push_back(ipin);
+            }
+        }
+    }
+
+    // Marks the pins reachable from the terminals through the given edges
+    auto mark_reachable = [&](const std::vector<std::vector<size_t>>& edges) {
+        std::vector<bool> reached(cluster_pins.size(), false);
+        std::vector<size_t> stack;
+        for (size_t ipin = 0; ipin < cluster_pins.size(); ipin++) {
+            if (ipin < num_tile_pins || is_primitive_pin(physical_type, cluster_pins[ipin])) {
+                reached[ipin] = true;
+                stack.push_back(ipin);
+            }
+        }
+        while (!stack.empty()) {
+            size_t ipin = stack.back();
+            stack.pop_back();
+            for (size_t next_pin : edges[ipin]) {
+                if (!reached[next_pin]) {
+                    reached[next_pin] = true;
+                    stack.push_back(next_pin);
+                }
+            }
+        }
+        return reached;
+    };
+    std::vector<bool> driven = mark_reachable(fanout);
+    std::vector<bool> used = mark_reachable(fanin);
+
+    std::vector<int> live_pins;
+    live_pins.reserve(cluster_pins.size() - num_tile_pins);
+    for (size_t ipin = num_tile_pins; ipin < cluster_pins.size(); ipin++) {
+        if (driven[ipin] && used[ipin]) {
+            live_pins.push_back(cluster_pins[ipin]);
+        }
+    }
+    live_pins.shrink_to_fit();
+    return live_pins;
+}
+
 std::vector<int> get_cluster_block_pins(t_physical_tile_type_ptr physical_tile,
                                         ClusterBlockId cluster_blk_id,
                                         int abs_cap) {
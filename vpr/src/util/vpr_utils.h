@@ -228,7 +228,7 @@ int num_ext_inputs_atom_block(AtomBlockId blk_id);
 std::tuple<int, int, std::string, std::string> parse_direct_pin_name(std::string_view src_string, int line);
 
 void free_pb_stats(t_pb* pb);
-void free_pb(t_pb* pb, AtomPBBimap& atom_pb_bimap);
+void free_pb(t_pb* pb, AtomPBBimap& atom_pb_bimap, bool clear_atom_clb = true);
 
 void print_switch_usage();
 void print_usage_by_wire_length();
@@ -323,6 +323,8 @@ std::vector<int> get_cluster_netlist_intra_tile_classes_at_loc(const t_physical_
 
 /**
  * @brief Returns the list of pins inside the tile located at tile_loc, except for the ones which are on a chain
+ *        and (in the clusters without chains) the ones which are not on any path between the pins on the tile
+ *        and the primitive pins of the cluster.
  */
 std::vector<int> get_cluster_netlist_intra_tile_pins_at_loc(const t_physical_tile_loc& tile_loc,
                                                             const vtr::vector<ClusterBlockId, t_cluster_pin_chain>& pin_chains,
@@ -0,0 +1,39 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "annealing_convergence_monitor.h"
+
+namespace {
+
+TEST_CASE("annealing_convergence_monitor", "[vpr]") {
+    SECTION("Hot temperatures do not converge") {
+        AnnealingConvergenceMonitor monitor(0.01);
+
+        // Temperatures making the placement worse
+        for (int itemp = 0; itemp < 5; itemp++) {
+            monitor.add_temperature(100., 101., 1000, 1.);
+        }
+        REQUIRE(monitor.predicted_gain(1000) < 0.);
+        REQUIRE(!monitor.converged(1000));
+    }
+
+    SECTION("Converges once the gains drop") {
+        AnnealingConvergenceMonitor monitor(0.01, 2);
+
+        monitor.add_temperature(100., 90., 1000, 2.);
+        REQUIRE(!monitor.converged(1000));
+        monitor.add_temperature(90., 89.9, 1000, 1.);
+        REQUIRE_THAT(monitor.predicted_gain(1000), Catch::Matchers::WithinRel(0.05 + 0.1 / 180., 1e-9));
+        REQUIRE(!monitor.converged(1000));
+        REQUIRE_THAT(monitor.average_temperature_time(), Catch::Matchers::WithinRel(1.5, 1e-6));
+
+        // The prediction scales with the moves of the next temperature
+        REQUIRE(monitor.predicted_gain(100) < 0.01);
+        REQUIRE(monitor.converged(100));
+
+        monitor.add_temperature(89.9, 89.9, 1000, 1.);
+        REQUIRE(monitor.converged(1000));
+    }
+}
+
+} // namespace
@@ -0,0 +1,104 @@
+/**
+ * @file
+ * @brief   Unit tests for the ElectrostaticFieldSolver
+ *
+ * Checks that the fast cosine / sine transforms match their definition, and
+ * that the field of simple charge densities has the symmetries expected from
+ * Poisson's equation.
+ */
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "cosine_transform.h"
+#include "electrostatic_field.h"
+#include "vtr_ndmatrix.h"
+
+namespace {
+
+TEST_CASE("test_ap_cosine_transform", "[vpr_ap]") {
+    // Power of two (radix-2) lengths, and other short (direct sums) and long
+    // (Bluestein) lengths, even and odd.
+    for (size_t size : {1, 2, 3, 8, 12, 31, 64, 200, 257}) {
+        std::vector<double> in(size);
+        for (size_t i = 0; i < size; i++)
+            in[i] = std::sin(1.7 * static_cast<double>(i) + 0.3) + 0.1 * static_cast<double>(i);
+
+        CosineTransform transform(size);
+        CosineTransform::t_scratch scratch;
+        std::vector<double> forward_cosine(size), inverse_cosine(size), inverse_sine(size);
+        transform.forward_cosine(in.data(), forward_cosine.data(), scratch);
+        transform.inverse_cosine(in.data(), inverse_cosine.data(), scratch);
+        transform.inverse_sine(in.data(), inverse_sine.data(), scratch);
+
+        for (size_t i = 0; i < size; i++) {
+            double expected_forward_cosine = 0.0;
+            double expected_inverse_cosine = 0.0;
+            double expected_inverse_sine = 0.0;
+            for (size_t j = 0; j < size; j++) {
+                double w_i = M_PI * static_cast<double>(i) / static_cast<double>(size);
+                double w_j = M_PI * static_cast<double>(j) / static_cast<double>(size);
+                expected_forward_cosine += in[j] * std::cos(w_i * (static_cast<double>(j) + 0.5));
+                expected_inverse_cosine += in[j] * std::cos(w_j * (static_cast<double>(i) + 0.5));
+                expected_inverse_sine += in[j] * std::sin(w_j * (static_cast<double>(i) + 0.5));
+            }
+            REQUIRE(std::abs(forward_cosine[i] - expected_forward_cosine) < 1e-9);
+            REQUIRE(std::abs(inverse_cosine[i] - expected_inverse_cosine) < 1e-9);
+            REQUIRE(std::abs(inverse_sine[i] - expected_inverse_sine) < 1e-9);
+        }
+    }
+}
+
+TEST_CASE("test_ap_electrostatic_field_point_charge", "[vpr_ap]") {
+    // A single charge in the center of an odd-sized grid.
+    const size_t width = 9;
+    const size_t height = 7;
+    vtr::NdMatrix<double, 2> density({width, height}, 0.0);
+    density[width / 2][height / 2] = 1.0;
+
+    ElectrostaticFieldSolver solver(width, height);
+    solver.solve(density);
+
+    // The field at the charge is zero, and points away from the charge
+    // everywhere else.
+    REQUIRE(std::abs(solver.field_x()[width / 2][height / 2]) < 1e-9);
+    REQUIRE(std::abs(solver.field_y()[width / 2][height / 2]) < 1e-9);
+    REQUIRE(solver.field_x()[width / 2 + 1][height / 2] > 0.0);
+    REQUIRE(solver.field_x()[width / 2 - 1][height / 2] < 0.0);
+    REQUIRE(solver.field_y()[width / 2][height / 2 + 1] > 0.0);
+    REQUIRE(solver.field_y()[width / 2][height / 2 - 1] < 0.0);
+
+    // The field is antisymmetric around the charge, and the potential is
+    // largest at the charge.
+    for (size_t x = 0; x < width; x++) {
+        for (size_t y = 0; y < height; y++) {
+            size_t mirror_x = width - 1 - x;
+            size_t mirror_y = height - 1 - y;
+            REQUIRE(std::abs(solver.field_x()[x][y] + solver.field_x()[mirror_x][y]) < 1e-9);
+            REQUIRE(std::abs(solver.field_y()[x][y] + solver.field_y()[x][mirror_y]) < 1e-9);
+            REQUIRE(solver.potential()[x][y] <= solver.potential()[width / 2][height / 2]);
+        }
+    }
+}
+
+TEST_CASE("test_ap_electrostatic_field_uniform_density", "[vpr_ap]") {
+    // A uniform density has no field.
+    const size_t width = 6;
+    const size_t height = 4;
+    vtr::NdMatrix<double, 2> density({width, height}, 0.5);
+
+    ElectrostaticFieldSolver solver(width, height);
+    solver.solve(density);
+
+    for (size_t x = 0; x < width; x++) {
+        for (size_t y = 0; y < height; y++) {
+            REQUIRE(std::abs(solver.field_x()[x][y]) < 1e-9);
+            REQUIRE(std::abs(solver.field_y()[x][y]) < 1e-9);
+            REQUIRE(std::abs(solver.potential()[x][y]) < 1e-9);
+        }
+    }
+}
+
+} // namespace
@@ -73,4 +73,52 @@ TEST_CASE("test_ap_netlist_data_storage", "[vpr_ap_netlist]") {
     }
 }
 
+TEST_CASE("test_ap_netlist_batched_removal", "[vpr_ap_netlist]") {
+    // Create a net driven by one block and sinking into five others.
+    APNetlist test_netlist("test_netlist");
+    APNetId net_id = test_netlist.create_net("Net", AtomNetId::INVALID());
+    std::vector<APBlockId> sink_blocks;
+    for (int i = 0; i < 6; i++) {
+        std::string name = "Block" + std::to_string(i);
+        APBlockId block_id = test_netlist.create_block(name, PackMoleculeId::INVALID());
+        bool is_driver = i == 0;
+        APPortId port_id = test_netlist.create_port(block_id, "P", 1, is_driver ? PortType::OUTPUT : PortType::INPUT);
+        test_netlist.create_pin(port_id, 0, net_id, is_driver ? PinType::DRIVER : PinType::SINK, AtomPinId::INVALID());
+        if (!is_driver)
+            sink_blocks.push_back(block_id);
+    }
+    REQUIRE(test_netlist.net_sinks(net_id).size() == 5);
+
+    // Remove the first, third and last sinks, then the pin of the driver.
+    test_netlist.remove_blocks({sink_blocks[0], sink_blocks[2], sink_blocks[4]});
+    APPinId driver_pin = test_netlist.net_driver(net_id);
+    test_netlist.remove_pins({driver_pin});
+
+    SECTION("Test the net is updated before compression") {
+        REQUIRE(!test_netlist.net_driver(net_id));
+        std::vector<APBlockId> remaining_blocks;
+        int expected_index = 1;
+        for (APPinId pin_id : test_netlist.net_sinks(net_id)) {
+            REQUIRE(test_netlist.pin_net_index(pin_id) == expected_index++);
+            remaining_blocks.push_back(test_netlist.pin_block(pin_id));
+        }
+        std::vector<APBlockId> expected_blocks = {sink_blocks[1], sink_blocks[3]};
+        REQUIRE(remaining_blocks == expected_blocks);
+        REQUIRE(!test_netlist.find_block("Block1"));
+        REQUIRE(test_netlist.find_block("Block2") == sink_blocks[1]);
+    }
+
+    SECTION("Test the netlist is consistent after compression") {
+        test_netlist.compress();
+        REQUIRE(test_netlist.verify());
+        REQUIRE(test_netlist.blocks().size() == 3);
+        REQUIRE(test_netlist.pins().size() == 2);
+        net_id = test_netlist.find_net("Net");
+        REQUIRE(!test_netlist.net_driver(net_id));
+        REQUIRE(test_netlist.net_sinks(net_id).size() == 2);
+        for (APPinId pin_id : test_netlist.net_sinks(net_id))
+            REQUIRE(test_netlist.pin_net(pin_id) == net_id);
+    }
+}
+
 } // namespace
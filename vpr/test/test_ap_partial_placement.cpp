@@ -10,8 +10,12 @@
 
 #include "catch2/catch_test_macros.hpp"
 
+#include <cstdio>
+#include <filesystem>
+
 #include "ap_netlist.h"
 #include "partial_placement.h"
+#include "partial_placement_checkpoint.h"
 #include "prepack.h"
 
 namespace {
@@ -130,4 +134,40 @@ TEST_CASE("test_ap_partial_placement_verify", "[vpr_ap]") {
     }
 }
 
+TEST_CASE("test_ap_partial_placement_checkpoint", "[vpr_ap]") {
+    // Create a test netlist object with a few blocks.
+    APNetlist test_netlist("test_netlist");
+    PackMoleculeId mol_a_id;
+    PackMoleculeId mol_b_id;
+    APBlockId block_id_a = test_netlist.create_block("BlockA", mol_a_id);
+    APBlockId block_id_b = test_netlist.create_block("BlockB", mol_b_id);
+
+    // Place the blocks.
+    PartialPlacement test_placement(test_netlist);
+    test_placement.block_x_locs[block_id_a] = 1.25;
+    test_placement.block_y_locs[block_id_a] = 7.5;
+    test_placement.block_layer_nums[block_id_a] = 0;
+    test_placement.block_sub_tiles[block_id_a] = 3;
+    test_placement.block_x_locs[block_id_b] = 42.125;
+    test_placement.block_y_locs[block_id_b] = 0.0;
+    test_placement.block_layer_nums[block_id_b] = 1;
+    test_placement.block_sub_tiles[block_id_b] = 0;
+
+    // Write the placement to a checkpoint in the temporary directory and read
+    // it back.
+    const std::string checkpoint_file = (std::filesystem::temp_directory_path() / "test_ap_partial_placement_checkpoint.bin").string();
+    write_partial_placement_checkpoint(checkpoint_file, test_placement, test_netlist);
+    PartialPlacement read_placement(test_netlist);
+    read_partial_placement_checkpoint(checkpoint_file, read_placement, test_netlist);
+    std::remove(checkpoint_file.c_str());
+
+    // The placement should be restored exactly.
+    for (APBlockId blk_id : test_netlist.blocks()) {
+        REQUIRE(read_placement.block_x_locs[blk_id] == test_placement.block_x_locs[blk_id]);
+        REQUIRE(read_placement.block_y_locs[blk_id] == test_placement.block_y_locs[blk_id]);
+        REQUIRE(read_placement.block_layer_nums[blk_id] == test_placement.block_layer_nums[blk_id]);
+        REQUIRE(read_placement.block_sub_tiles[blk_id] == test_placement.block_sub_tiles[blk_id]);
+    }
+}
+
 } // namespace
@@ -390,6 +390,42 @@ TEST_CASE("test_ap_primitive_vector_verify", "[vpr_ap]") {
         vec2.set_dim_val(dim_0, 3.f);
         REQUIRE(!vec1.are_dims_disjoint(vec2));
     }
+
+    SECTION("Test high dimensions") {
+        // Operations mixing small dims and large dims should behave the same
+        // as operations on small dims.
+        PrimitiveVector vec1, vec2;
+        vec1.set_dim_val(dim_1, 1.f);
+        vec1.set_dim_val(dim_42, 2.f);
+        vec2.set_dim_val(dim_10, 3.f);
+        PrimitiveVector vec_sum = vec1 + vec2;
+        REQUIRE(vec_sum.get_dim_val(dim_1) == 1.f);
+        REQUIRE(vec_sum.get_dim_val(dim_10) == 3.f);
+        REQUIRE(vec_sum.get_dim_val(dim_42) == 2.f);
+        REQUIRE(vec_sum.manhattan_norm() == 6.f);
+        REQUIRE(vec_sum - vec2 == vec1);
+        REQUIRE(vec_sum != vec1);
+        REQUIRE(vec1 < vec_sum);
+        REQUIRE(!(vec_sum < vec1));
+        REQUIRE(vec1.are_dims_disjoint(vec2));
+        std::vector<PrimitiveVectorDim> non_zero_dims = vec_sum.get_non_zero_dims();
+        std::vector<PrimitiveVectorDim> golden_dims = {dim_1, dim_10, dim_42};
+        REQUIRE(non_zero_dims == golden_dims);
+
+        // Projecting onto a vector without the large dim removes it.
+        vec_sum.project(vec2);
+        REQUIRE(vec_sum.get_dim_val(dim_42) == 0.f);
+        REQUIRE(vec_sum.get_dim_val(dim_10) == 3.f);
+        REQUIRE(vec_sum == vec2);
+
+        // A vector with only a negative large dim is not non-negative.
+        vec1.clear();
+        vec1.set_dim_val(dim_42, -1.f);
+        REQUIRE(!vec1.is_non_negative());
+        REQUIRE(!vec1.is_zero());
+        vec1.relu();
+        REQUIRE(vec1.is_zero());
+    }
 }
 
 } // namespace
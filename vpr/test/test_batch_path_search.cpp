@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @brief Unit tests for the CPU batch path search of the gpu_batch router.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include "batch_path_search.h"
+
+#include <utility>
+#include <vector>
+
+namespace {
+
+/** Builds a BatchRRGraph from the out edges of each node, with the nodes at (x, 0, 0) */
+BatchRRGraph make_graph(const std::vector<std::vector<int>>& out_nodes, const std::vector<int>& xs) {
+    BatchRRGraph graph;
+    graph.edge_offsets.push_back(0);
+    for (size_t node = 0; node < out_nodes.size(); node++) {
+        for (int to_node : out_nodes[node]) {
+            graph.edge_srcs.push_back(node);
+            graph.edge_sinks.push_back(to_node);
+        }
+        graph.edge_offsets.push_back(graph.edge_sinks.size());
+        graph.node_x.push_back(xs[node]);
+        graph.node_y.push_back(0);
+        graph.node_layer.push_back(0);
+    }
+    return graph;
+}
+
+BatchNet make_net(int source, std::vector<int> sinks, int xmax) {
+    BatchNet net;
+    net.source = source;
+    net.sinks = std::move(sinks);
+    net.xmin = 0;
+    net.xmax = xmax;
+    net.ymin = net.ymax = 0;
+    net.layer_min = net.layer_max = 0;
+    return net;
+}
+
+/** The nodes along a path from source */
+std::vector<int> path_nodes(const BatchRRGraph& graph, int source, const std::vector<int>& path) {
+    std::vector<int> nodes{source};
+    for (int e : path) {
+        REQUIRE(graph.edge_srcs[e] == nodes.back());
+        nodes.push_back(graph.edge_sinks[e]);
+    }
+    return nodes;
+}
+
+TEST_CASE("test_batch_path_search", "[vpr_batch_path_search]") {
+    // 0 -> 1 -> 3 -> 4, 0 -> 2 -> 3, 5 is unreachable. Node 1 is cheap but at x = 2.
+    BatchRRGraph graph = make_graph({{1, 2}, {3}, {3}, {4}, {}, {4}}, {0, 2, 1, 1, 1, 0});
+    std::vector<float> node_costs{1., 1., 4., 1., 1., 1.};
+
+    REQUIRE(graph.num_nodes() == 6);
+    REQUIRE(graph.num_edges() == 6);
+
+    SECTION("Test the cheapest paths of a net share their prefix") {
+        auto paths = find_batch_paths(graph, node_costs, {make_net(0, {3, 4}, 2)});
+        REQUIRE(paths.size() == 1);
+        REQUIRE(paths[0].size() == 2);
+        REQUIRE(path_nodes(graph, 0, paths[0][0]) == (std::vector<int>{0, 1, 3}));
+        REQUIRE(path_nodes(graph, 0, paths[0][1]) == (std::vector<int>{0, 1, 3, 4}));
+    }
+
+    SECTION("Test the paths stay in the bounding box and unreached sinks have no path") {
+        // Node 1 is outside the bounding box of the first net; the other nets reuse the search arrays
+        auto paths = find_batch_paths(graph, node_costs, {make_net(0, {4, 5}, 1), make_net(0, {3}, 2), make_net(3, {4, 4}, 1)});
+        REQUIRE(paths.size() == 3);
+        REQUIRE(path_nodes(graph, 0, paths[0][0]) == (std::vector<int>{0, 2, 3, 4}));
+        REQUIRE(paths[0][1].empty());
+        REQUIRE(path_nodes(graph, 0, paths[1][0]) == (std::vector<int>{0, 1, 3}));
+        REQUIRE(path_nodes(graph, 3, paths[2][0]) == (std::vector<int>{3, 4}));
+        REQUIRE(paths[2][1] == paths[2][0]);
+    }
+}
+
+} // namespace
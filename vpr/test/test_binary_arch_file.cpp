@@ -0,0 +1,74 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "arch_util.h"
+#include "binary_arch_file.h"
+#include "echo_arch.h"
+#include "read_xml_arch_file.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+static constexpr const char kArchFile[] = "test_read_arch_metadata.xml";
+static constexpr const char kBinaryArchFile[] = "test_binary_arch_file.bin";
+
+std::string read_file(const std::string& file_name) {
+    std::ifstream file(file_name);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+/**
+ * @brief Loads the architecture from XML (or from the binary file if binary is set), and returns
+ *        its echo file contents. The loaded architecture is written to new_binary_file if not empty.
+ */
+std::string load_arch(bool binary, const std::string& new_binary_file = "") {
+    t_arch arch;
+    std::vector<t_physical_tile_type> physical_tile_types;
+    std::vector<t_logical_block_type> logical_block_types;
+
+    if (binary) {
+        read_binary_arch_file(kBinaryArchFile, kArchFile, &arch, physical_tile_types, logical_block_types);
+    } else {
+        xml_read_arch(kArchFile, /*timing_enabled=*/true,
+                      &arch, physical_tile_types, logical_block_types);
+    }
+
+    REQUIRE(binary_arch_file_supported(arch));
+    if (!new_binary_file.empty()) {
+        write_binary_arch_file(new_binary_file, arch, physical_tile_types, logical_block_types);
+    }
+
+    // The pointers between the types are rebuilt
+    for (const t_logical_block_type& type : logical_block_types) {
+        if (!type.is_empty()) {
+            REQUIRE(type.pb_type->parent_mode == nullptr);
+            for (const t_physical_tile_type_ptr tile : type.equivalent_tiles) {
+                REQUIRE(&physical_tile_types[tile->index] == tile);
+            }
+        }
+    }
+
+    EchoArch("test_binary_arch_file.echo", physical_tile_types, logical_block_types, &arch);
+
+    free_type_descriptors(logical_block_types);
+    free_type_descriptors(physical_tile_types);
+    free_arch(&arch);
+
+    return read_file("test_binary_arch_file.echo");
+}
+
+TEST_CASE("binary_arch_file", "[vpr]") {
+    std::string xml_echo = load_arch(false, kBinaryArchFile);
+    std::string binary_echo = load_arch(true, "test_binary_arch_file_copy.bin");
+
+    // The binary file loads to the same architecture, which is written back identically
+    REQUIRE(binary_echo == xml_echo);
+    REQUIRE(read_file("test_binary_arch_file_copy.bin") == read_file(kBinaryArchFile));
+}
+
+} // namespace
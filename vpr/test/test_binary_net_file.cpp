@@ -0,0 +1,140 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "globals.h"
+#include "read_netlist.h"
+#include "vpr_api.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+#ifdef VTR_ENABLE_CAPNPROTO
+static constexpr const char kArchFile[] = "test_post_verilog_arch.xml";
+static constexpr const char kCircuitFile[] = "unconnected.eblif";
+static constexpr const char kNetFile[] = "test_binary_net_file.net";
+
+/**
+ * @brief Records the loaded clustering (clusters, intra-cluster routing, cluster
+ *        nets and atom mapping) as strings, so that two loads can be compared.
+ */
+std::vector<std::string> describe_clustering() {
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& atom_ctx = g_vpr_ctx.atom();
+    const ClusteredNetlist& clb_nlist = cluster_ctx.clb_nlist;
+
+    std::vector<std::string> description;
+    description.push_back("id " + clb_nlist.netlist_id());
+
+    for (ClusterBlockId blk_id : clb_nlist.blocks()) {
+        const t_pb* pb = clb_nlist.block_pb(blk_id);
+        description.push_back("block " + clb_nlist.block_name(blk_id) + " " + pb->hierarchical_type_name());
+
+        for (const auto& [pin, route] : pb->pb_route) {
+            std::string route_str = "  pin " + std::to_string(pin) + " driver " + std::to_string(route.driver_pb_pin_id);
+            if (route.atom_net_id) {
+                route_str += " net " + atom_ctx.netlist().net_name(route.atom_net_id);
+            }
+            for (int sink : route.sink_pb_pin_ids) {
+                route_str += " " + std::to_string(sink);
+            }
+            description.push_back(route_str);
+        }
+    }
+
+    for (ClusterNetId net_id : clb_nlist.nets()) {
+        std::string net_str = "net " + clb_nlist.net_name(net_id);
+        for (ClusterPinId pin_id : clb_nlist.net_pins(net_id)) {
+            net_str += " " + clb_nlist.block_name(clb_nlist.pin_block(pin_id)) + "." + std::to_string(clb_nlist.pin_logical_index(pin_id));
+        }
+        description.push_back(net_str);
+    }
+
+    for (AtomBlockId atom_blk : atom_ctx.netlist().blocks()) {
+        const t_pb* pb = atom_ctx.lookup().atom_pb_bimap().atom_pb(atom_blk);
+        std::string atom_str = "atom " + atom_ctx.netlist().block_name(atom_blk) + " " + pb->hierarchical_type_name();
+        for (AtomPinId atom_pin : atom_ctx.netlist().block_pins(atom_blk)) {
+            const t_pb_graph_pin* gpin = atom_ctx.lookup().atom_pin_pb_graph_pin(atom_pin);
+            atom_str += " " + (gpin ? std::to_string(gpin->pin_count_in_cluster) : std::string("none"));
+        }
+        description.push_back(atom_str);
+    }
+
+    return description;
+}
+
+/**
+ * @brief Runs VPR up to the loading of the packing (packing first if do_packing is set),
+ *        and returns the loaded clustering.
+ */
+std::vector<std::string> load_clustering(bool do_packing) {
+    auto options = t_options();
+    auto arch = t_arch();
+    auto vpr_setup = t_vpr_setup();
+
+    const char* argv[] = {
+        "test_vpr",
+        kArchFile,
+        kCircuitFile,
+        "--net_file", kNetFile,
+        "--binary_net_file", "on",
+        "--pack"};
+
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+
+    if (do_packing) {
+        REQUIRE(vpr_pack_flow(vpr_setup, arch));
+    } else {
+        vpr_load_packing(vpr_setup, arch);
+    }
+
+    std::vector<std::string> description = describe_clustering();
+
+    vpr_free_all(arch, vpr_setup);
+
+    return description;
+}
+
+TEST_CASE("binary_net_file", "[vpr]") {
+    const std::string binary_file = get_binary_net_file_name(kNetFile);
+    std::filesystem::remove(binary_file);
+
+    // the binary copy is written when the .net file is loaded after packing
+    std::vector<std::string> packed_clustering = load_clustering(true);
+    REQUIRE(std::filesystem::exists(binary_file));
+
+    // the binary copy is loaded while the .net file is unchanged: overwrite the
+    // .net file (keeping its size and modification time) to check the XML is not read
+    std::string net_file_contents;
+    {
+        std::ifstream net_file(kNetFile, std::ios::binary);
+        net_file_contents.assign(std::istreambuf_iterator<char>(net_file), std::istreambuf_iterator<char>());
+    }
+    auto net_file_time = std::filesystem::last_write_time(kNetFile);
+    {
+        std::ofstream net_file(kNetFile, std::ios::binary);
+        net_file << std::string(net_file_contents.size(), ' ');
+    }
+    std::filesystem::last_write_time(kNetFile, net_file_time);
+
+    std::vector<std::string> binary_clustering = load_clustering(false);
+    REQUIRE(binary_clustering == packed_clustering);
+
+    // once the .net file is modified, it is loaded again (and the binary copy rewritten)
+    {
+        std::ofstream net_file(kNetFile, std::ios::binary);
+        net_file << net_file_contents;
+    }
+    std::filesystem::last_write_time(kNetFile, net_file_time + std::chrono::seconds(1));
+    auto binary_file_time = std::filesystem::last_write_time(binary_file);
+
+    std::vector<std::string> reloaded_clustering = load_clustering(false);
+    REQUIRE(reloaded_clustering == packed_clustering);
+    REQUIRE(std::filesystem::last_write_time(binary_file) != binary_file_time);
+}
+#endif
+
+} // namespace
@@ -0,0 +1,106 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "globals.h"
+#include "old_traceback.h"
+#include "router_delay_profiling.h"
+#include "vpr_api.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+#ifdef VTR_ENABLE_CAPNPROTO
+static constexpr const char kArchFile[] = "test_post_verilog_arch.xml";
+static constexpr const char kCircuitFile[] = "unconnected.eblif";
+
+/**
+ * @brief Records the loaded placement and routing (block locations and the traceback of
+ *        each net) as strings, so that two loads can be compared.
+ */
+std::vector<std::string> describe_implementation() {
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& place_ctx = g_vpr_ctx.placement();
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    std::vector<std::string> description;
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        const t_pl_loc& loc = place_ctx.block_locs()[blk_id].loc;
+        description.push_back("block " + cluster_ctx.clb_nlist.block_name(blk_id) + " "
+                              + std::to_string(loc.x) + "," + std::to_string(loc.y) + ","
+                              + std::to_string(loc.sub_tile) + "," + std::to_string(loc.layer));
+    }
+
+    for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
+        if (!route_ctx.route_trees[net_id]) {
+            continue;
+        }
+
+        std::string net_str = "net " + cluster_ctx.clb_nlist.net_name(net_id);
+        t_trace* head = TracebackCompat::traceback_from_route_tree(route_ctx.route_trees[net_id].value());
+        for (t_trace* tptr = head; tptr != nullptr; tptr = tptr->next) {
+            net_str += " " + std::to_string(tptr->index) + ":" + std::to_string(tptr->iswitch) + ":" + std::to_string(tptr->net_pin_index);
+        }
+        free_traceback(head);
+        description.push_back(net_str);
+    }
+
+    return description;
+}
+
+/**
+ * @brief Runs the VPR flow with the given extra options, and returns the resulting
+ *        placement and routing.
+ */
+std::vector<std::string> run_vpr_flow(std::vector<const char*> extra_args) {
+    auto options = t_options();
+    auto arch = t_arch();
+    auto vpr_setup = t_vpr_setup();
+
+    std::vector<const char*> argv = {
+        "test_vpr",
+        kArchFile,
+        kCircuitFile,
+        "--net_file", "test_binary_place_route.net",
+        "--route_chan_width", "100"};
+    argv.insert(argv.end(), extra_args.begin(), extra_args.end());
+
+    vpr_init(argv.size(), argv.data(),
+             &options, &vpr_setup, &arch);
+
+    bool flow_succeeded = vpr_flow(vpr_setup, arch);
+    std::vector<std::string> description = describe_implementation();
+
+    free_routing_structs();
+    vpr_free_all(arch, vpr_setup);
+
+    REQUIRE(flow_succeeded == true);
+
+    return description;
+}
+
+TEST_CASE("binary_place_route", "[vpr]") {
+    // implement the circuit, with the text placement and routing files
+    std::vector<std::string> implementation = run_vpr_flow({"--place_file", "test_binary_place_route.place",
+                                                            "--route_file", "test_binary_place_route.route"});
+
+    // convert them to the binary formats
+    std::vector<std::string> text_implementation = run_vpr_flow({"--analysis",
+                                                                 "--place_file", "test_binary_place_route.place",
+                                                                 "--route_file", "test_binary_place_route.route",
+                                                                 "--write_place_file", "test_binary_place_route.place.bin",
+                                                                 "--write_route_file", "test_binary_place_route.route.bin"});
+    REQUIRE(text_implementation == implementation);
+    REQUIRE(std::filesystem::exists("test_binary_place_route.place.bin"));
+    REQUIRE(std::filesystem::exists("test_binary_place_route.route.bin"));
+
+    // the binary files load to the same placement and routing
+    std::vector<std::string> binary_implementation = run_vpr_flow({"--analysis",
+                                                                   "--place_file", "test_binary_place_route.place.bin",
+                                                                   "--route_file", "test_binary_place_route.route.bin"});
+    REQUIRE(binary_implementation == implementation);
+}
+#endif
+
+} // namespace
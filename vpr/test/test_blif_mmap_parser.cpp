@@ -0,0 +1,230 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "blif_mmap_parser.h"
+#include "blifparse.hpp"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Records every callback call (and its arguments) as a string, so
+ * that the calls made by two parsers can be compared.
+ */
+class RecordingCallback : public blifparse::Callback {
+  public:
+    std::vector<std::string> calls;
+
+    void start_parse() override { calls.emplace_back("start_parse"); }
+    void filename(std::string /*fname*/) override {}
+    void lineno(int line_num) override { line_ = line_num; }
+
+    void begin_model(std::string model_name) override { record(".model " + model_name); }
+    void inputs(std::vector<std::string> inputs) override { record(".inputs" + join(inputs)); }
+    void outputs(std::vector<std::string> outputs) override { record(".outputs" + join(outputs)); }
+
+    void names(std::vector<std::string> nets, std::vector<std::vector<blifparse::LogicValue>> so_cover) override {
+        std::string call = ".names" + join(nets);
+        for (const auto& row : so_cover) {
+            call += " |";
+            for (blifparse::LogicValue value : row) {
+                call += std::to_string((int)value);
+            }
+        }
+        record(call);
+    }
+
+    void latch(std::string input, std::string output, blifparse::LatchType type, std::string control, blifparse::LogicValue init) override {
+        record(".latch " + input + " " + output + " " + std::to_string((int)type) + " '" + control + "' " + std::to_string((int)init));
+    }
+
+    void subckt(std::string model, std::vector<std::string> ports, std::vector<std::string> nets) override {
+        std::string call = ".subckt " + model;
+        for (size_t i = 0; i < ports.size(); i++) {
+            call += " " + ports[i] + "=" + nets[i];
+        }
+        record(call);
+    }
+
+    void blackbox() override { record(".blackbox"); }
+    void end_model() override { record(".end"); }
+    void conn(std::string src, std::string dst) override { record(".conn " + src + " " + dst); }
+    void cname(std::string cell_name) override { record(".cname " + cell_name); }
+    void attr(std::string name, std::string value) override { record(".attr " + name + " " + value); }
+    void param(std::string name, std::string value) override { record(".param " + name + " " + value); }
+
+    void finish_parse() override { calls.emplace_back("finish_parse"); }
+
+    void parse_error(const int curr_lineno, const std::string& /*near_text*/, const std::string& /*msg*/) override {
+        calls.emplace_back("error@" + std::to_string(curr_lineno));
+        has_error = true;
+    }
+
+    bool has_error = false;
+
+  private:
+    void record(const std::string& call) {
+        calls.push_back(std::to_string(line_) + ": " + call);
+    }
+
+    static std::string join(const std::vector<std::string>& strings) {
+        std::string joined;
+        for (const std::string& str : strings) {
+            joined += " " + str;
+        }
+        return joined;
+    }
+
+    int line_ = -1;
+};
+
+void write_file(const std::string& filename, const std::string& contents) {
+    std::ofstream file(filename, std::ios::binary);
+    file << contents;
+}
+
+/**
+ * @brief Removes the line numbers recorded by RecordingCallback.
+ */
+std::vector<std::string> strip_line_numbers(std::vector<std::string> calls) {
+    for (std::string& call : calls) {
+        size_t separator = call.find(": ");
+        if (separator != std::string::npos) {
+            call = call.substr(separator + 2);
+        }
+    }
+    return calls;
+}
+
+std::vector<std::string> parse_with_mmap_parser(const std::string& filename, bool& has_error) {
+    RecordingCallback callback;
+    BlifMmapParser parser(filename);
+    parser.parse(callback);
+    has_error = callback.has_error;
+    return callback.calls;
+}
+
+TEST_CASE("test_blif_mmap_parser", "[vpr_blif]") {
+    const std::string filename = "test_blif_mmap_parser.eblif";
+
+    SECTION("Test case where all the BLIF constructs are parsed.") {
+        write_file(filename,
+                   "# a comment\n"
+                   ".model top\n"
+                   ".inputs a b \\\n"
+                   "  clk # an end of line comment\n"
+                   ".outputs o\\\n"
+                   "\n"
+                   "\n"
+                   ".names a b n1\n"
+                   "1- 1\n"
+                   "-1 1\n"
+                   ".names vcc\n"
+                   "1\n"
+                   ".names gnd\n"
+                   ".latch n1 q re clk 0\n"
+                   ".latch n1 q2\n"
+                   ".latch n1 q3 fe NIL 3\n"
+                   ".subckt adder a = a b=b cout=c[0]\n"
+                   ".cname \"my adder\"\n"
+                   ".attr src \"adder.v:3\"\n"
+                   ".param WIDTH 0101\n"
+                   ".conn c[0] o\r\n"
+                   ".end\n"
+                   ".model adder\n"
+                   ".inputs a b\n"
+                   ".outputs cout\n"
+                   ".blackbox\n"
+                   ".end");
+
+        bool has_error = false;
+        std::vector<std::string> calls = parse_with_mmap_parser(filename, has_error);
+        REQUIRE(has_error == false);
+
+        const std::vector<std::string> expected_calls{
+            "start_parse",
+            "2: .model top",
+            "3: .inputs a b clk",
+            "5: .outputs o",
+            "8: .names a b n1 |121 |211",
+            "11: .names vcc |1",
+            "13: .names gnd",
+            "14: .latch n1 q 1 'clk' 0",
+            "15: .latch n1 q2 5 '' 3",
+            "16: .latch n1 q3 0 '' 3",
+            "17: .subckt adder a=a b=b cout=c[0]",
+            "18: .cname \"my adder\"",
+            "19: .attr src \"adder.v:3\"",
+            "20: .param WIDTH 0101",
+            "21: .conn c[0] o",
+            "22: .end",
+            "23: .model adder",
+            "24: .inputs a b",
+            "25: .outputs cout",
+            "26: .blackbox",
+            "27: .end",
+            "finish_parse"};
+        REQUIRE(calls == expected_calls);
+
+        // libblifparse makes the same calls (it reports the line a statement ends at, rather than starts at)
+        RecordingCallback libblifparse_callback;
+        blifparse::blif_parse_filename(filename, libblifparse_callback);
+        REQUIRE(libblifparse_callback.has_error == false);
+        REQUIRE(strip_line_numbers(libblifparse_callback.calls) == strip_line_numbers(calls));
+    }
+
+    SECTION("Test case where the parser finds errors.") {
+        bool has_error = false;
+
+        // the cover row does not match the number of nets
+        write_file(filename, ".model top\n.names a b\n1 1 1\n.end\n");
+        REQUIRE(parse_with_mmap_parser(filename, has_error).back() == "finish_parse");
+        REQUIRE(has_error == true);
+
+        // the statements before the error are passed to the callback
+        write_file(filename, ".model top\n.inputs a\n.bogus a\n.end\n");
+        std::vector<std::string> calls = parse_with_mmap_parser(filename, has_error);
+        REQUIRE(has_error == true);
+        REQUIRE(calls[2] == "2: .inputs a");
+        REQUIRE(calls[3] == "error@3");
+
+        // malformed .subckt and .latch
+        write_file(filename, ".model top\n.subckt adder a b=b\n.end\n");
+        parse_with_mmap_parser(filename, has_error);
+        REQUIRE(has_error == true);
+
+        write_file(filename, ".model top\n.latch a b re\n.end\n");
+        parse_with_mmap_parser(filename, has_error);
+        REQUIRE(has_error == true);
+
+        // unterminated quoted string
+        write_file(filename, ".model top\n.cname \"abc\n.end\n");
+        parse_with_mmap_parser(filename, has_error);
+        REQUIRE(has_error == true);
+    }
+
+    SECTION("Test case where the file is parsed in several chunks.") {
+        // enough statements for several chunks, some of them continued over several lines
+        std::string contents = ".model top\n.inputs a\n";
+        const size_t num_names = BlifMmapParser::CHUNK_SIZE / 4;
+        for (size_t i = 0; i < num_names; i++) {
+            contents += ".names a n" + std::to_string(i) + " \\\n  o" + std::to_string(i) + "\n11 1\n";
+        }
+        contents += ".end\n";
+        write_file(filename, contents);
+
+        bool has_error = false;
+        std::vector<std::string> calls = parse_with_mmap_parser(filename, has_error);
+        REQUIRE(has_error == false);
+        REQUIRE(calls.size() == num_names + 5);
+
+        // the line numbers continue across the chunks
+        const size_t last = num_names - 1;
+        REQUIRE(calls[3 + last] == std::to_string(3 + 3 * last) + ": .names a n" + std::to_string(last) + " o" + std::to_string(last) + " |111");
+        REQUIRE(calls[3 + num_names] == std::to_string(3 + 3 * num_names) + ": .end");
+    }
+}
+
+} // namespace
@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "bucket_heap.h"
+
+namespace {
+
+TEST_CASE("bucket_heap_key_order", "[vpr]") {
+    std::vector<float> prios = {-1e10f, -3.5f, -1e-20f, 0.f, 1e-20f, 1e-12f, 0.5f, 1.f, 3.5f, 1e10f};
+    for (size_t i = 1; i < prios.size(); i++) {
+        REQUIRE(BucketHeap::to_key(prios[i - 1]) < BucketHeap::to_key(prios[i]));
+    }
+}
+
+TEST_CASE("bucket_heap_pop_order", "[vpr]") {
+    BucketHeap heap;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(0.f, 1e-9f);
+
+    REQUIRE(heap.is_empty_heap());
+    HeapNode heap_node;
+    REQUIRE(!heap.try_pop(heap_node));
+
+    // Mimic a search: push the sources, then pop nodes and push their neighbours, mostly
+    // behind the popped one but now and then slightly ahead of it
+    std::vector<float> pushed;
+    for (int i = 0; i < 10; i++) {
+        float prio = dist(rng);
+        heap.push_back({prio, RRNodeId(i)});
+        pushed.push_back(prio);
+    }
+    heap.build_heap();
+    REQUIRE(heap.is_valid());
+
+    std::vector<float> popped;
+    while (heap.try_pop(heap_node)) {
+        // Nothing smaller than the popped node is left in the heap
+        std::vector<float>::iterator it = std::find(pushed.begin(), pushed.end(), heap_node.prio);
+        REQUIRE(it != pushed.end());
+        REQUIRE(*std::min_element(pushed.begin(), pushed.end()) == heap_node.prio);
+        pushed.erase(it);
+        popped.push_back(heap_node.prio);
+
+        if (popped.size() < 2000) {
+            for (int i = 0; i < 3; i++) {
+                float prio = heap_node.prio + dist(rng) - (i == 0 ? 1e-10f : 0.f);
+                heap.add_to_heap({std::max(prio, 0.f), RRNodeId(popped.size())});
+                pushed.push_back(std::max(prio, 0.f));
+            }
+        }
+        REQUIRE(heap.is_valid());
+    }
+    REQUIRE(pushed.empty());
+    REQUIRE(heap.is_empty_heap());
+
+    // The heap can be reused after being emptied
+    heap.add_to_heap({5.f, RRNodeId(1)});
+    heap.add_to_heap({2.f, RRNodeId(2)});
+    heap.empty_heap();
+    REQUIRE(heap.is_empty_heap());
+    heap.add_to_heap({1.f, RRNodeId(3)});
+    REQUIRE(heap.try_pop(heap_node));
+    REQUIRE(heap_node.node == RRNodeId(3));
+    REQUIRE(heap.is_empty_heap());
+}
+
+} // namespace
@@ -0,0 +1,112 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "channel_dependency_graph.h"
+
+#include <functional>
+#include <random>
+
+namespace {
+
+/**
+ * @brief Checks whether the dependencies of the given routes form a cycle
+ * by running a DFS over the graph built from scratch.
+ */
+bool routes_have_cycle(const std::vector<std::vector<NocLinkId>>& routes, size_t n_links) {
+    std::vector<std::vector<size_t>> adjacency_list(n_links);
+    for (const auto& route : routes) {
+        for (size_t i = 1; i < route.size(); i++) {
+            adjacency_list[(size_t)route[i - 1]].push_back((size_t)route[i]);
+        }
+    }
+
+    // 0: not visited, 1: on the DFS path, 2: done
+    std::vector<int> state(n_links, 0);
+    std::function<bool(size_t)> visit = [&](size_t vertex) {
+        state[vertex] = 1;
+        for (size_t neighbor : adjacency_list[vertex]) {
+            if (state[neighbor] == 1) {
+                return true;
+            }
+            if (state[neighbor] == 0 && visit(neighbor)) {
+                return true;
+            }
+        }
+        state[vertex] = 2;
+        return false;
+    };
+
+    for (size_t vertex = 0; vertex < n_links; vertex++) {
+        if (state[vertex] == 0 && visit(vertex)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+TEST_CASE("test_incremental_channel_dependency_graph", "[vpr_noc_cdg]") {
+    SECTION("Test case where routes form and then break a cycle.") {
+        ChannelDependencyGraph cdg(3);
+
+        std::vector<NocLinkId> route_a{NocLinkId(0), NocLinkId(1)};
+        std::vector<NocLinkId> route_b{NocLinkId(1), NocLinkId(2)};
+        std::vector<NocLinkId> route_c{NocLinkId(2), NocLinkId(0)};
+
+        cdg.add_route(route_a);
+        cdg.add_route(route_b);
+        REQUIRE(cdg.has_cycles() == false);
+
+        // L0 -> L1 -> L2 -> L0
+        cdg.add_route(route_c);
+        REQUIRE(cdg.has_cycles() == true);
+
+        // the same dependency used twice is only removed with its last route
+        cdg.add_route(route_a);
+        cdg.remove_route(route_a);
+        REQUIRE(cdg.has_cycles() == true);
+
+        // breaking the cycle anywhere removes it
+        cdg.remove_route(route_a);
+        REQUIRE(cdg.has_cycles() == false);
+
+        cdg.add_route(route_a);
+        REQUIRE(cdg.has_cycles() == true);
+
+        cdg.clear();
+        REQUIRE(cdg.has_cycles() == false);
+    }
+
+    SECTION("Test case where routes are randomly added and removed.") {
+        constexpr size_t n_links = 16;
+        constexpr size_t n_routes = 12;
+        constexpr size_t n_iterations = 2000;
+
+        std::mt19937 rand_num_gen(3);
+        std::uniform_int_distribution<size_t> link_dist(0, n_links - 1);
+        std::uniform_int_distribution<size_t> length_dist(2, 5);
+        std::uniform_int_distribution<size_t> route_dist(0, n_routes - 1);
+
+        ChannelDependencyGraph cdg(n_links);
+        std::vector<std::vector<NocLinkId>> routes(n_routes);
+
+        for (size_t iteration = 0; iteration < n_iterations; iteration++) {
+            // re-route a random route with random links. Consecutive links are different.
+            auto& route = routes[route_dist(rand_num_gen)];
+            cdg.remove_route(route);
+
+            route.clear();
+            const size_t length = length_dist(rand_num_gen);
+            while (route.size() < length) {
+                NocLinkId link_id(link_dist(rand_num_gen));
+                if (route.empty() || route.back() != link_id) {
+                    route.push_back(link_id);
+                }
+            }
+            cdg.add_route(route);
+
+            REQUIRE(cdg.has_cycles() == routes_have_cycle(routes, n_links));
+        }
+    }
+}
+
+} // namespace
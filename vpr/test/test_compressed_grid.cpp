@@ -181,6 +181,23 @@ TEST_CASE("test_compressed_grid", "[vpr_compressed_grid]") {
         REQUIRE(compressed_grids[large_logical_type.index].compressed_to_grid_y[0].size() == 7);
     }
 
+    SECTION("Check compressed grid columns") {
+        const t_compressed_block_grid& tall_grid = compressed_grids[tall_logical_type.index];
+
+        // A column of tall blocks every 5 rows from y = 5 to y = 90
+        t_compressed_column rows = tall_grid.get_column_rows(tall_grid.grid_loc_to_compressed_loc({7, 5, 0}).x, 0);
+        REQUIRE(rows.size() == 18);
+        REQUIRE(std::is_sorted(rows.begin(), rows.end()));
+        REQUIRE(rows.count(tall_grid.grid_loc_to_compressed_loc({7, 40, 0}).y) == 1);
+        REQUIRE(tall_grid.compressed_loc_to_grid_loc({0, *rows.lower_bound(3), 0}) == t_physical_tile_loc{7, 20, 0});
+        REQUIRE(rows.upper_bound(17) == rows.end());
+
+        // The large blocks replaced some of the small ones
+        const t_compressed_block_grid& small_grid = compressed_grids[small_logical_type.index];
+        REQUIRE(small_grid.get_column_rows(0, 0).size() == 98);
+        REQUIRE(small_grid.get_column_rows(small_grid.grid_loc_to_compressed_loc({8, 1, 0}).x, 0).size() < 98);
+    }
+
     SECTION("Exact mapped locations in the compressed grids") {
         t_physical_tile_loc comp_loc = compressed_grids[large_logical_type.index].grid_loc_to_compressed_loc_approx({25, 33, 0});
         t_physical_tile_loc grid_loc = compressed_grids[large_logical_type.index].compressed_loc_to_grid_loc(comp_loc);
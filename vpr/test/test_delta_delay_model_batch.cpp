@@ -0,0 +1,50 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "delta_delay_model.h"
+
+namespace {
+
+TEST_CASE("delta_delay_model_batch_matches_single", "[vpr]") {
+    constexpr size_t kDimLayer = 2;
+    constexpr size_t kDimX = 7;
+    constexpr size_t kDimY = 5;
+    vtr::NdMatrix<float, 4> delays;
+    delays.resize({kDimLayer, kDimLayer, kDimX, kDimY});
+    for (size_t from_layer = 0; from_layer < kDimLayer; ++from_layer) {
+        for (size_t to_layer = 0; to_layer < kDimLayer; ++to_layer) {
+            for (size_t x = 0; x < kDimX; ++x) {
+                for (size_t y = 0; y < kDimY; ++y) {
+                    delays[from_layer][to_layer][x][y] = 1000 * from_layer + 100 * to_layer + 10 * x + y;
+                }
+            }
+        }
+    }
+
+    DeltaDelayModel model(/*min_cross_layer_delay=*/0., std::move(delays), /*is_flat=*/false);
+
+    t_delay_batch batch;
+    for (int from_layer = 0; from_layer < int(kDimLayer); ++from_layer) {
+        for (int to_layer = 0; to_layer < int(kDimLayer); ++to_layer) {
+            for (int x = 0; x < int(kDimX); ++x) {
+                for (int y = 0; y < int(kDimY); ++y) {
+                    // Both directions, so that the deltas are negated
+                    batch.add({3, 2, from_layer}, 0, {x, y, to_layer}, 1);
+                    batch.add({x, y, from_layer}, 0, {3, 2, to_layer}, 1);
+                }
+            }
+        }
+    }
+
+    std::vector<float> batch_delays(batch.size());
+    model.delays(batch, batch_delays.data());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        float single_delay = model.delay({batch.from_x[i], batch.from_y[i], batch.from_layer[i]}, batch.from_pin[i],
+                                         {batch.to_x[i], batch.to_y[i], batch.to_layer[i]}, batch.to_pin[i]);
+        CHECK(batch_delays[i] == single_delay);
+    }
+
+    batch.clear();
+    REQUIRE(batch.size() == 0);
+}
+
+} // namespace
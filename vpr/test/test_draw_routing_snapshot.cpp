@@ -0,0 +1,75 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "draw_routing_snapshot.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// Three channel wires and a pin on a 4x4 grid with two layers
+t_draw_routing_inputs make_inputs(const std::vector<short>& occ) {
+    auto rr_nodes = std::make_shared<vtr::vector<RRNodeId, t_draw_rr_node_info>>();
+    rr_nodes->push_back({e_rr_type::CHANX, 1, 2, 0, 0, 0, 1});
+    rr_nodes->push_back({e_rr_type::CHANX, 1, 1, 0, 0, 1, 1});
+    rr_nodes->push_back({e_rr_type::CHANY, 2, 2, 1, 2, 0, 2});
+    rr_nodes->push_back({e_rr_type::IPIN, 1, 1, 1, 1, 0, 1});
+
+    t_draw_routing_inputs inputs;
+    inputs.rr_nodes = rr_nodes;
+    inputs.grid_width = 4;
+    inputs.grid_height = 4;
+    inputs.num_layers = 2;
+    for (short node_occ : occ) {
+        inputs.occ.push_back(node_occ);
+    }
+    return inputs;
+}
+
+TEST_CASE("draw_routing_snapshot", "[vpr]") {
+    t_draw_routing_snapshot snapshot = prepare_draw_routing_snapshot(make_inputs({1, 3, 6, 2}));
+
+    // channel capacity over all layers, and usage over the visible ones
+    REQUIRE(snapshot.chanx_avail[1][0] == 2.);
+    REQUIRE(snapshot.chanx_avail[2][0] == 1.);
+    REQUIRE(snapshot.chany_avail[2][1] == 2.);
+    REQUIRE(snapshot.chany_avail[2][2] == 2.);
+    REQUIRE(snapshot.chany_avail[1][1] == 0.);
+
+    vtr::Matrix<float> chanx_usage = snapshot.channel_usage(e_rr_type::CHANX, {true, true});
+    REQUIRE(chanx_usage[1][0] == 4.);
+    REQUIRE(chanx_usage[2][0] == 1.);
+    REQUIRE(snapshot.channel_usage(e_rr_type::CHANX, {true, false})[1][0] == 1.);
+    REQUIRE(snapshot.channel_usage(e_rr_type::CHANY, {true, true})[2][2] == 6.);
+
+    // overused nodes in ascending order of congestion (ties in id order)
+    const std::vector<RRNodeId> congested_rr_nodes{RRNodeId(3), RRNodeId(1), RRNodeId(2)};
+    const std::vector<float> congestion_ratios{2., 3., 3.};
+    REQUIRE(snapshot.congested_rr_nodes == congested_rr_nodes);
+    REQUIRE(snapshot.congestion_ratios == congestion_ratios);
+    REQUIRE(snapshot.max_congestion_ratio == 3.);
+
+    SECTION("background preparation") {
+        DrawRoutingSnapshotPreparer preparer;
+        REQUIRE(!preparer.has_requests());
+        REQUIRE(preparer.latest() == nullptr);
+
+        // only the latest routing state matters once waited for
+        preparer.request(make_inputs({0, 0, 0, 0}));
+        preparer.request(make_inputs({1, 1, 1, 1}));
+        preparer.request(make_inputs({1, 3, 6, 2}));
+        REQUIRE(preparer.has_requests());
+        preparer.wait();
+
+        std::shared_ptr<const t_draw_routing_snapshot> latest = preparer.latest();
+        REQUIRE(latest != nullptr);
+        REQUIRE(latest->congested_rr_nodes == snapshot.congested_rr_nodes);
+        REQUIRE(latest->channel_usage(e_rr_type::CHANX, {true, true})[1][0] == chanx_usage[1][0]);
+
+        preparer.clear();
+        REQUIRE(!preparer.has_requests());
+        REQUIRE(preparer.latest() == nullptr);
+    }
+}
+
+} // namespace
@@ -75,4 +75,33 @@ TEST_CASE("edge_groups_create_sets", "[vpr]") {
     }
 }
 
+TEST_CASE("edge_groups_output_sets", "[vpr]") {
+    EdgeGroups groups;
+    groups.add_non_config_edge(RRNodeId(5), RRNodeId(2));
+    groups.add_non_config_edge(RRNodeId(5), RRNodeId(2)); // Duplicate
+    groups.add_non_config_edge(RRNodeId(2), RRNodeId(7));
+    groups.add_non_config_edge(RRNodeId(9), RRNodeId(1));
+
+    groups.create_sets();
+    t_non_configurable_rr_sets sets = groups.output_sets();
+
+    // Sets are ordered by their smallest node
+    REQUIRE(sets.node_sets.size() == 2);
+    std::set<RRNodeId> set0{RRNodeId(1), RRNodeId(9)};
+    std::set<RRNodeId> set1{RRNodeId(2), RRNodeId(5), RRNodeId(7)};
+    REQUIRE(sets.node_sets[0] == set0);
+    REQUIRE(sets.node_sets[1] == set1);
+
+    // Edges are undirected: both directions are reported
+    REQUIRE(sets.edge_sets.size() == 2);
+    REQUIRE(sets.edge_sets[0].size() == 2);
+    REQUIRE(sets.edge_sets[0].count(t_node_edge(RRNodeId(9), RRNodeId(1))) == 1);
+    REQUIRE(sets.edge_sets[0].count(t_node_edge(RRNodeId(1), RRNodeId(9))) == 1);
+    REQUIRE(sets.edge_sets[1].size() == 4);
+    REQUIRE(sets.edge_sets[1].count(t_node_edge(RRNodeId(2), RRNodeId(5))) == 1);
+    REQUIRE(sets.edge_sets[1].count(t_node_edge(RRNodeId(5), RRNodeId(2))) == 1);
+    REQUIRE(sets.edge_sets[1].count(t_node_edge(RRNodeId(2), RRNodeId(7))) == 1);
+    REQUIRE(sets.edge_sets[1].count(t_node_edge(RRNodeId(7), RRNodeId(2))) == 1);
+}
+
 } // namespace
@@ -0,0 +1,109 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "estimate_activity.h"
+#include "read_activity.h"
+
+#include "atom_netlist.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Catch::Matchers::WithinAbs;
+
+/// Adds a LUT computing the given cover over the input nets
+AtomNetId add_lut(AtomNetlist& netlist, const LogicalModels& models, const std::vector<AtomNetId>& inputs, const std::string& output, const AtomNetlist::TruthTable& cover) {
+    const t_model& names_model = models.get_model(LogicalModels::MODEL_NAMES_ID);
+    AtomBlockId blk = netlist.create_block(output, LogicalModels::MODEL_NAMES_ID, cover);
+
+    AtomPortId input_port = netlist.create_port(blk, names_model.inputs);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        netlist.create_pin(input_port, i, inputs[i], PinType::SINK);
+    }
+
+    AtomNetId out_net = netlist.create_net(output);
+    netlist.create_pin(netlist.create_port(blk, names_model.outputs), 0, out_net, PinType::DRIVER);
+    return out_net;
+}
+
+TEST_CASE("estimate_activity", "[vpr]") {
+    LogicalModels models;
+    // 2-LUTs (the architecture sets the LUT size)
+    models.get_model(LogicalModels::MODEL_NAMES_ID).inputs->size = 2;
+    AtomNetlist netlist("top");
+
+    // Primary inputs a, b and clk
+    auto add_input = [&](const std::string& name) {
+        AtomBlockId blk = netlist.create_block(name, LogicalModels::MODEL_INPUT_ID);
+        AtomNetId net = netlist.create_net(name);
+        netlist.create_pin(netlist.create_port(blk, models.get_model(LogicalModels::MODEL_INPUT_ID).outputs), 0, net, PinType::DRIVER);
+        return net;
+    };
+    AtomNetId a = add_input("a");
+    AtomNetId b = add_input("b");
+    AtomNetId clk = add_input("clk");
+
+    // and = a & b, nor = !(a | b) (as the off-set of a | b), and q = the and of the previous cycle
+    using vtr::LogicValue;
+    AtomNetId and_net = add_lut(netlist, models, {a, b}, "and", {{LogicValue::TRUE, LogicValue::TRUE, LogicValue::TRUE}});
+    AtomNetId nor_net = add_lut(netlist, models, {a, b}, "nor", {{LogicValue::TRUE, LogicValue::DONT_CARE, LogicValue::FALSE}, {LogicValue::DONT_CARE, LogicValue::TRUE, LogicValue::FALSE}});
+
+    const t_model& latch_model = models.get_model(LogicalModels::MODEL_LATCH_ID);
+    AtomBlockId latch = netlist.create_block("q", LogicalModels::MODEL_LATCH_ID, {{LogicValue::FALSE}});
+    AtomNetId q = netlist.create_net("q");
+    netlist.create_pin(netlist.create_port(latch, latch_model.inputs), 0, and_net, PinType::SINK);
+    netlist.create_pin(netlist.create_port(latch, latch_model.inputs->next), 0, clk, PinType::SINK);
+    netlist.create_pin(netlist.create_port(latch, latch_model.outputs), 0, q, PinType::DRIVER);
+
+    // A constant one (an empty cube) and a constant zero (an empty cover)
+    AtomNetId vcc = add_lut(netlist, models, {}, "vcc", {{LogicValue::TRUE}});
+    AtomNetId gnd = add_lut(netlist, models, {}, "gnd", {});
+
+    std::unordered_map<AtomNetId, t_net_power> activity = estimate_activity(netlist, models, 2000);
+
+    // The primary inputs are at 1 half of the time, and switch with a probability of 0.2
+    REQUIRE_THAT(activity[a].probability, WithinAbs(0.5, 0.01));
+    REQUIRE_THAT(activity[a].density, WithinAbs(0.2, 0.01));
+    REQUIRE_THAT(activity[b].probability, WithinAbs(0.5, 0.01));
+
+    // The output of an and gate switches when it is 1 and an input switches (0.25 * 0.36), and back
+    REQUIRE_THAT(activity[and_net].probability, WithinAbs(0.25, 0.01));
+    REQUIRE_THAT(activity[and_net].density, WithinAbs(0.18, 0.01));
+    REQUIRE_THAT(activity[nor_net].probability, WithinAbs(0.25, 0.01));
+    REQUIRE_THAT(activity[nor_net].density, WithinAbs(0.18, 0.01));
+    REQUIRE_THAT(activity[q].probability, WithinAbs(0.25, 0.01));
+    REQUIRE_THAT(activity[q].density, WithinAbs(0.18, 0.01));
+
+    REQUIRE(activity[vcc].probability == 1.);
+    REQUIRE(activity[vcc].density == 0.);
+    REQUIRE(activity[gnd].probability == 0.);
+    REQUIRE(activity[gnd].density == 0.);
+
+    // The clocks are given the same activity as by ACE
+    REQUIRE(activity[clk].probability == 0.5);
+    REQUIRE(activity[clk].density == 2.);
+
+    // The estimate is the same from run to run
+    std::unordered_map<AtomNetId, t_net_power> activity_again = estimate_activity(netlist, models, 2000);
+    for (AtomNetId net : netlist.nets()) {
+        REQUIRE(activity_again[net].probability == activity[net].probability);
+        REQUIRE(activity_again[net].density == activity[net].density);
+    }
+
+    SECTION("activity file") {
+        const char* activity_file = "test_estimate_activity.act";
+        write_activity(netlist, activity, activity_file);
+
+        std::unordered_map<AtomNetId, t_net_power> read = read_activity(netlist, activity_file);
+        for (AtomNetId net : netlist.nets()) {
+            REQUIRE_THAT(read[net].probability, WithinAbs(activity[net].probability, 1e-6));
+            REQUIRE_THAT(read[net].density, WithinAbs(activity[net].density, 1e-6));
+        }
+        std::remove(activity_file);
+    }
+}
+
+} // namespace
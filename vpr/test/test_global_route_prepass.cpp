@@ -0,0 +1,54 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "global_route_prepass.h"
+#include "globals.h"
+#include "vpr_api.h"
+
+namespace {
+
+TEST_CASE("global_route_prepass", "[vpr]") {
+    auto options = t_options();
+    auto arch = t_arch();
+    auto vpr_setup = t_vpr_setup();
+
+    const char* argv[] = {
+        "test_vpr",
+        "test_post_verilog_arch.xml",
+        "unconnected.eblif",
+        "--net_file", "test_global_route_prepass.net",
+        "--place_file", "test_global_route_prepass.place",
+        "--route_file", "test_global_route_prepass.route",
+        "--route_chan_width", "100",
+        "--router_global_route_prepass", "on",
+        "--router_global_route_gcell_size", "2"};
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+
+    // The detailed routing succeeds within the global routing corridors
+    bool flow_succeeded = vpr_flow(vpr_setup, arch);
+    REQUIRE(flow_succeeded);
+
+    // The global routing of the (uncongested) implemented design, done again
+    const Netlist<>& net_list = (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    GlobalRoutePrepass global_route(net_list, 2);
+    REQUIRE(global_route.route(6) == 1);
+    REQUIRE(global_route.num_overused_edges() == 0);
+
+    for (ParentNetId net_id : net_list.nets()) {
+        // Every corridor covers the terminals of its net
+        t_bb corridor = global_route.net_corridor(net_id);
+        for (RRNodeId terminal : route_ctx.net_rr_terminals[net_id]) {
+            REQUIRE(rr_graph.node_xlow(terminal) >= corridor.xmin);
+            REQUIRE(rr_graph.node_xlow(terminal) <= corridor.xmax);
+            REQUIRE(rr_graph.node_ylow(terminal) >= corridor.ymin);
+            REQUIRE(rr_graph.node_ylow(terminal) <= corridor.ymax);
+        }
+    }
+
+    vpr_free_all(arch, vpr_setup);
+}
+
+} // namespace
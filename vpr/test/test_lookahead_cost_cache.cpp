@@ -0,0 +1,55 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "lookahead_cost_cache.h"
+
+namespace {
+
+TEST_CASE("lookahead_cost_cache_hits", "[vpr]") {
+    LookaheadCostCache cache;
+    REQUIRE(!cache.enabled());
+
+    cache.resize(1000);
+    REQUIRE(cache.enabled());
+
+    RouterStats stats;
+    int num_computed = 0;
+    auto compute = [&]() {
+        num_computed++;
+        return 42.f;
+    };
+
+    REQUIRE(cache.get(RRNodeId(3), RRNodeId(7), 0.5f, &stats, compute) == 42.f);
+    REQUIRE(cache.get(RRNodeId(3), RRNodeId(7), 0.5f, &stats, compute) == 42.f);
+    REQUIRE(num_computed == 1);
+    REQUIRE(stats.lookahead_cache_hits == 1);
+    REQUIRE(stats.lookahead_cache_misses == 1);
+
+    // Same pair at another criticality: the cost has to be recomputed
+    REQUIRE(cache.get(RRNodeId(3), RRNodeId(7), 0.9f, &stats, compute) == 42.f);
+    REQUIRE(num_computed == 2);
+
+    // Reversed pair is a different key
+    cache.get(RRNodeId(7), RRNodeId(3), 0.9f, &stats, compute);
+    REQUIRE(num_computed == 3);
+    REQUIRE(stats.lookahead_cache_misses == 3);
+}
+
+TEST_CASE("lookahead_cost_cache_single_entry", "[vpr]") {
+    LookaheadCostCache cache;
+    cache.resize(1);
+
+    float cost = 1.f;
+    auto compute = [&]() { return cost; };
+
+    REQUIRE(cache.get(RRNodeId(0), RRNodeId(0), 1.f, nullptr, compute) == 1.f);
+    cost = 2.f;
+    // The only entry is evicted by the next pair
+    REQUIRE(cache.get(RRNodeId(1), RRNodeId(0), 1.f, nullptr, compute) == 2.f);
+    cost = 3.f;
+    REQUIRE(cache.get(RRNodeId(0), RRNodeId(0), 1.f, nullptr, compute) == 3.f);
+
+    cache.resize(0);
+    REQUIRE(!cache.enabled());
+}
+
+} // namespace
@@ -0,0 +1,56 @@
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "move_profiler.h"
+
+namespace {
+
+TEST_CASE("move_profiler_csv", "[vpr]") {
+    const std::string profile_file = "test_move_profiler.csv";
+    using namespace std::chrono_literals;
+
+    {
+        MoveProfiler profiler(profile_file);
+        REQUIRE(profiler.enabled());
+
+        // Discarded moves don't appear in the profile
+        profiler.record_move(e_move_type::UNIFORM, e_move_result::ACCEPTED, 1s, 1s);
+        profiler.discard();
+
+        profiler.record_move(e_move_type::UNIFORM, e_move_result::ACCEPTED, 1ms, 3ms);
+        profiler.record_move(e_move_type::UNIFORM, e_move_result::REJECTED, 1ms, 3ms);
+        profiler.record_move(e_move_type::CENTROID, e_move_result::ABORTED, 2ms, 0ms);
+        profiler.record_timing_update(2ms);
+        profiler.end_temperature(1, 10.f, 5.f);
+
+        profiler.end_temperature(2, 5.f, 4.f);
+    }
+
+    std::ifstream profile(profile_file);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(profile, line);) {
+        lines.push_back(line);
+    }
+
+    // Header, one line per move type used and the totals of each temperature
+    REQUIRE(lines.size() == 5);
+    REQUIRE(lines[0].rfind("temp_num,temp,rlim,move_type,", 0) == 0);
+    REQUIRE(lines[1].rfind("1,10,5," + move_type_to_string(e_move_type::UNIFORM) + ",2,1,1,0,", 0) == 0);
+    REQUIRE(lines[2].rfind("1,10,5," + move_type_to_string(e_move_type::CENTROID) + ",1,0,0,1,", 0) == 0);
+    // 3 moves in 12 ms, including the timing update
+    REQUIRE(lines[3].rfind("1,10,5,Total,3,1,1,1,0.004,0.006,1,0.002,", 0) == 0);
+    REQUIRE(lines[3].substr(lines[3].rfind(',') + 1) == "250");
+    REQUIRE(lines[4] == "2,5,4,Total,0,0,0,0,0,0,0,0,0,0");
+}
+
+TEST_CASE("move_profiler_disabled", "[vpr]") {
+    MoveProfiler profiler("");
+    REQUIRE(!profiler.enabled());
+    REQUIRE(profiler.now() == MoveProfiler::clock::time_point());
+    profiler.end_temperature(1, 1.f, 1.f);
+}
+
+} // namespace
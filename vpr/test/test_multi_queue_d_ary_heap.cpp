@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "multi_queue_d_ary_heap.h"
+
+namespace {
+
+/** Pushes num_nodes nodes, then pops them all from num_threads threads and returns the popped node IDs */
+std::vector<size_t> push_and_pop_all(MultiQueueDAryHeap<4>& heap, size_t num_threads, size_t num_nodes) {
+    for (size_t inode = 0; inode < num_nodes; inode++) {
+        heap.add_to_heap({float((inode * 7919) % num_nodes), RRNodeId(inode)});
+    }
+
+    std::vector<std::vector<size_t>> popped(num_threads);
+    std::vector<std::thread> threads;
+    for (size_t ithread = 0; ithread < num_threads; ithread++) {
+        threads.emplace_back([&, ithread]() {
+            if (heap.get_pop_batch_size() > 1) {
+                std::vector<HeapNode> batch;
+                while (heap.try_pop_batch(batch)) {
+                    // Catch2 assertions aren't thread-safe, so just make a bad batch fail the test
+                    bool bad_batch = batch.size() > heap.get_pop_batch_size()
+                                     || !std::is_sorted(batch.begin(), batch.end(), [](const HeapNode& u, const HeapNode& v) {
+                                            return u.prio < v.prio;
+                                        });
+                    if (bad_batch) {
+                        popped[ithread].push_back(num_nodes);
+                    }
+                    for (const HeapNode& heap_node : batch) {
+                        popped[ithread].push_back(size_t(heap_node.node));
+                    }
+                }
+            } else {
+                HeapNode heap_node;
+                while (heap.try_pop(heap_node)) {
+                    popped[ithread].push_back(size_t(heap_node.node));
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<size_t> all_popped;
+    for (const std::vector<size_t>& thread_popped : popped) {
+        all_popped.insert(all_popped.end(), thread_popped.begin(), thread_popped.end());
+    }
+    std::sort(all_popped.begin(), all_popped.end());
+    return all_popped;
+}
+
+TEST_CASE("multi_queue_d_ary_heap_pops_all", "[vpr]") {
+    constexpr size_t num_nodes = 10000;
+    std::vector<size_t> all_nodes(num_nodes);
+    for (size_t inode = 0; inode < num_nodes; inode++) {
+        all_nodes[inode] = inode;
+    }
+
+    MultiQueueDAryHeap<4> heap;
+
+    SECTION("single pops, queue count not a power of 2") {
+        heap.set_num_threads_and_queues(3, 12);
+        REQUIRE(push_and_pop_all(heap, 3, num_nodes) == all_nodes);
+    }
+
+    SECTION("sticky pops") {
+        heap.set_num_threads_and_queues(4, 16, 8, 1);
+        REQUIRE(push_and_pop_all(heap, 4, num_nodes) == all_nodes);
+    }
+
+    SECTION("batch pops") {
+        heap.set_num_threads_and_queues(4, 16, 1, 8);
+        REQUIRE(push_and_pop_all(heap, 4, num_nodes) == all_nodes);
+    }
+
+    REQUIRE(heap.is_empty_heap());
+    REQUIRE(heap.get_num_pushes() == num_nodes);
+    REQUIRE(heap.get_num_pops() == num_nodes);
+
+    // Statistics are cleared for the next search
+    heap.reset();
+    REQUIRE(heap.get_num_pushes() == 0);
+    REQUIRE(heap.get_num_pops() == 0);
+    REQUIRE(heap.get_num_lock_fails() == 0);
+}
+
+TEST_CASE("multi_queue_d_ary_heap_serial_order", "[vpr]") {
+    // With one thread and two queues, the first pop compares the tops of both queues, so it is
+    // the minimum; sticky pops then relax the order, but nothing is lost or duplicated
+    MultiQueueDAryHeap<4> heap;
+    heap.set_num_threads_and_queues(1, 2, 4, 1);
+    for (size_t inode = 0; inode < 100; inode++) {
+        heap.add_to_heap({float(inode), RRNodeId(inode)});
+    }
+
+    std::vector<size_t> popped;
+    HeapNode heap_node;
+    while (heap.try_pop(heap_node)) {
+        REQUIRE(heap_node.prio == float(size_t(heap_node.node)));
+        popped.push_back(size_t(heap_node.node));
+    }
+    REQUIRE(popped[0] == 0);
+    std::sort(popped.begin(), popped.end());
+    REQUIRE(popped.size() == 100);
+    REQUIRE(std::adjacent_find(popped.begin(), popped.end()) == popped.end());
+    REQUIRE(heap.get_num_lock_fails() == 0);
+}
+
+} // namespace
@@ -0,0 +1,62 @@
+#ifdef VPR_USE_TBB
+
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "NetPinTimingInvalidator.h"
+
+#include <tbb/parallel_for.h>
+
+namespace {
+
+/** Records the invalidated connections in order */
+class RecordingNetPinTimingInvalidator : public NetPinTimingInvalidator {
+  public:
+    tedge_range pin_timing_edges(ParentPinId /* pin */) const {
+        return vtr::make_range((const tatum::EdgeId*)nullptr, (const tatum::EdgeId*)nullptr);
+    }
+
+    void invalidate_connection(ParentPinId pin) {
+        pins.push_back(pin);
+    }
+
+    void reset() {
+        pins.clear();
+    }
+
+    std::vector<ParentPinId> pins;
+};
+
+TEST_CASE("deferred_net_pin_timing_invalidator", "[vpr]") {
+    RecordingNetPinTimingInvalidator recorder;
+    DeferredNetPinTimingInvalidator deferred(&recorder);
+
+    // Invalidate each pin twice, from many tasks and in no particular order
+    constexpr size_t num_pins = 1000;
+    tbb::parallel_for(size_t(0), 2 * num_pins, [&](size_t i) {
+        deferred.invalidate_connection(ParentPinId((i * 7919) % num_pins));
+    });
+    REQUIRE(recorder.pins.empty());
+
+    deferred.flush();
+    REQUIRE(recorder.pins.size() == num_pins);
+    for (size_t ipin = 0; ipin < num_pins; ipin++) {
+        REQUIRE(recorder.pins[ipin] == ParentPinId(ipin));
+    }
+
+    // Flushing forgets the recorded connections
+    recorder.reset();
+    deferred.flush();
+    REQUIRE(recorder.pins.empty());
+
+    // So does resetting
+    deferred.invalidate_connection(ParentPinId(3));
+    deferred.reset();
+    deferred.flush();
+    REQUIRE(recorder.pins.empty());
+}
+
+} // namespace
+
+#endif // VPR_USE_TBB
@@ -0,0 +1,63 @@
+/**
+ * @file
+ * @brief Unit tests for NetPinsCsr, the flat snapshot of the pins of the nets of a netlist.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include "ap_netlist.h"
+#include "net_pins_csr.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+TEST_CASE("test_net_pins_csr", "[vpr_net_pins_csr]") {
+    // Block0 drives Net0 into Block1 and Block2; Net1 has no driver and sinks into Block0.
+    APNetlist test_netlist("test_netlist");
+    std::vector<APBlockId> blocks;
+    for (int i = 0; i < 3; i++) {
+        blocks.push_back(test_netlist.create_block("Block" + std::to_string(i), PackMoleculeId::INVALID()));
+    }
+    APNetId net0 = test_netlist.create_net("Net0", AtomNetId::INVALID());
+    APNetId net1 = test_netlist.create_net("Net1", AtomNetId::INVALID());
+    for (int i = 0; i < 3; i++) {
+        bool is_driver = i == 0;
+        APPortId port_id = test_netlist.create_port(blocks[i], "P", 1, is_driver ? PortType::OUTPUT : PortType::INPUT);
+        test_netlist.create_pin(port_id, 0, net0, is_driver ? PinType::DRIVER : PinType::SINK, AtomPinId::INVALID());
+    }
+    APPortId in_port = test_netlist.create_port(blocks[0], "I", 1, PortType::INPUT);
+    test_netlist.create_pin(in_port, 0, net1, PinType::SINK, AtomPinId::INVALID());
+
+    NetPinsCsr<APNetId, APPinId, APBlockId> net_pins(test_netlist);
+
+    SECTION("Test the snapshot matches the netlist") {
+        REQUIRE(net_pins.num_nets() == 2);
+        // The missing driver of Net1 keeps its slot
+        REQUIRE(net_pins.num_pins() == 5);
+        REQUIRE(net_pins.is_current(test_netlist));
+
+        for (APNetId net_id : test_netlist.nets()) {
+            auto pins = test_netlist.net_pins(net_id);
+            auto csr_pins = net_pins.net_pins(net_id);
+            REQUIRE(std::vector<APPinId>(pins.begin(), pins.end()) == std::vector<APPinId>(csr_pins.begin(), csr_pins.end()));
+            REQUIRE(net_pins.net_sinks(net_id).size() == test_netlist.net_sinks(net_id).size());
+        }
+        REQUIRE(net_pins.net_pin_offset(net1) == 3);
+        REQUIRE(net_pins.net_pin_block(net0, 0) == blocks[0]);
+        REQUIRE(net_pins.net_pin_block(net0, 2) == blocks[2]);
+        REQUIRE(!net_pins.net_pin_block(net1, 0));
+        REQUIRE(net_pins.net_pin_blocks(net1)[1] == blocks[0]);
+    }
+
+    SECTION("Test the snapshot goes stale when the netlist changes") {
+        test_netlist.remove_pins({test_netlist.net_driver(net0)});
+        test_netlist.compress();
+        REQUIRE(!net_pins.is_current(test_netlist));
+        NetPinsCsr<APNetId, APPinId, APBlockId> rebuilt_net_pins(test_netlist);
+        REQUIRE(rebuilt_net_pins.is_current(test_netlist));
+        REQUIRE(!rebuilt_net_pins.net_pin_block(test_netlist.find_net("Net0"), 0));
+    }
+}
+
+} // namespace
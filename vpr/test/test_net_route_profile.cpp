@@ -0,0 +1,45 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "router_stats.h"
+
+namespace {
+
+TEST_CASE("net_route_profile_scope", "[vpr]") {
+    RouterStats stats;
+    stats.heap_pushes = 10;
+    stats.heap_pops = 5;
+    stats.connections_routed = 2;
+
+    {
+        NetRouteProfileScope scope(true, ParentNetId(3), stats);
+        stats.heap_pushes += 7;
+        stats.heap_pops += 4;
+        stats.connections_routed += 1;
+    }
+    {
+        NetRouteProfileScope scope(false, ParentNetId(4), stats);
+        stats.heap_pushes += 1;
+    }
+
+    // Only the enabled scope is recorded, with what was routed while it was alive
+    REQUIRE(stats.net_profiles.size() == 1);
+    REQUIRE(stats.net_profiles[0].net_id == ParentNetId(3));
+    REQUIRE(stats.net_profiles[0].heap_pushes == 7);
+    REQUIRE(stats.net_profiles[0].heap_pops == 4);
+    REQUIRE(stats.net_profiles[0].connections_routed == 1);
+    REQUIRE(stats.net_profiles[0].route_sec >= 0.);
+
+    // Profiles of other threads are appended when combining their stats
+    RouterStats other_stats;
+    {
+        NetRouteProfileScope scope(true, ParentNetId(3), other_stats);
+        other_stats.heap_pops += 2;
+    }
+    stats.combine(other_stats);
+    REQUIRE(stats.net_profiles.size() == 2);
+    REQUIRE(stats.net_profiles[1].net_id == ParentNetId(3));
+    REQUIRE(stats.net_profiles[1].heap_pops == 2);
+    REQUIRE(stats.heap_pops == 11);
+}
+
+} // namespace
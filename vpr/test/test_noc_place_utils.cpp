@@ -628,6 +628,9 @@ TEST_CASE("test_find_affected_noc_routers_and_update_noc_costs, test_commit_noc_
     // now go and route all the traffic flows //
     // start by creating the routing algorithm
     noc_ctx.noc_flows_router = std::make_unique<XYRouting>();
+    // the route table lets the cost changes also be estimated without applying the moves
+    noc_ctx.noc_model.finished_building_noc();
+    noc_ctx.noc_model.build_route_table(*noc_ctx.noc_flows_router);
 
     // create a local routing algorithm for the unit test
     auto routing_algorithm = std::make_unique<XYRouting>();
@@ -849,11 +852,25 @@ TEST_CASE("test_find_affected_noc_routers_and_update_noc_costs, test_commit_noc_
             }
         }
 
+        // estimate the cost change before the test function updates the NoC routing
+        NocCostTerms estimated_delta_cost;
+        std::vector<NocTrafficFlowId> estimated_traffic_flows;
+        std::vector<NocLinkId> estimated_links;
+        REQUIRE(noc_cost_handler.can_estimate_noc_cost_change());
+        REQUIRE(noc_cost_handler.estimate_noc_cost_change(blocks_affected, estimated_delta_cost, estimated_traffic_flows, estimated_links));
+        REQUIRE(estimated_traffic_flows.size() == routed_traffic_flows.size());
+
         NocCostTerms delta_cost;
 
         // call the test function
         noc_cost_handler.find_affected_noc_routers_and_update_noc_costs(blocks_affected, delta_cost);
 
+        // the estimate changes nothing, and matches the cost change of the test function
+        REQUIRE(vtr::isclose(estimated_delta_cost.aggregate_bandwidth, delta_cost.aggregate_bandwidth));
+        REQUIRE(vtr::isclose(estimated_delta_cost.latency, delta_cost.latency));
+        REQUIRE(vtr::isclose(estimated_delta_cost.latency_overrun, delta_cost.latency_overrun));
+        REQUIRE(vtr::isclose(estimated_delta_cost.congestion, delta_cost.congestion));
+
         // update the test noc cost terms based on the cost changes found by the test functions
         test_noc_costs.aggregate_bandwidth += delta_cost.aggregate_bandwidth;
         test_noc_costs.latency += delta_cost.latency;
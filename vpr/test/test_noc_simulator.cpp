@@ -0,0 +1,107 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "noc_simulator.h"
+
+namespace {
+
+constexpr double LINK_BANDWIDTH = 1.e9;
+constexpr double LINK_LATENCY = 1.e-9;
+constexpr double ROUTER_LATENCY = 2.e-9;
+constexpr double PACKET_SIZE = 512.;
+// the latency constraint of the traffic flows, about 20 cycles
+constexpr double MAX_LATENCY = 1.e-5;
+
+/**
+ * @brief Builds a NoC made of three routers connected in a line:
+ * router 0 -> router 1 -> router 2.
+ */
+void build_line_noc(NocStorage& noc_model) {
+    noc_model.set_device_grid_spec(3, 1);
+
+    for (int i = 0; i < 3; i++) {
+        noc_model.add_router(i, i, 0, 0, ROUTER_LATENCY);
+    }
+
+    noc_model.make_room_for_noc_router_link_list();
+
+    noc_model.add_link(NocRouterId(0), NocRouterId(1), LINK_BANDWIDTH, LINK_LATENCY);
+    noc_model.add_link(NocRouterId(1), NocRouterId(2), LINK_BANDWIDTH, LINK_LATENCY);
+
+    noc_model.set_noc_link_bandwidth(LINK_BANDWIDTH);
+    noc_model.set_noc_link_latency(LINK_LATENCY);
+    noc_model.set_noc_router_latency(ROUTER_LATENCY);
+
+    noc_model.finished_building_noc();
+}
+
+TEST_CASE("test_noc_simulator", "[vpr_noc_simulator]") {
+    NocStorage noc_model;
+    build_line_noc(noc_model);
+
+    NocTrafficFlows traffic_flow_storage;
+    vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> traffic_flow_routes;
+
+    // both traffic flows go over the link router 1 -> router 2
+    const std::vector<NocLinkId> route_0_to_2{NocLinkId(0), NocLinkId(1)};
+    const std::vector<NocLinkId> route_1_to_2{NocLinkId(1)};
+
+    SECTION("Test case where the NoC is lightly loaded.") {
+        traffic_flow_storage.create_noc_traffic_flow("r0", "r2", ClusterBlockId(0), ClusterBlockId(2), 0.3 * LINK_BANDWIDTH, MAX_LATENCY, 1);
+        traffic_flow_storage.create_noc_traffic_flow("r1", "r2", ClusterBlockId(1), ClusterBlockId(2), 0.2 * LINK_BANDWIDTH, MAX_LATENCY, 1);
+        traffic_flow_storage.finished_noc_traffic_flows_setup();
+        traffic_flow_routes.push_back(route_0_to_2);
+        traffic_flow_routes.push_back(route_1_to_2);
+
+        NocSimulator noc_simulator(noc_model, traffic_flow_storage, traffic_flow_routes, PACKET_SIZE);
+        t_noc_sim_results results = noc_simulator.run(20000, 2000, 1);
+
+        REQUIRE(results.num_saturated_links == 0);
+        REQUIRE(results.num_traffic_flows_meeting_latency == 2);
+        REQUIRE(results.num_delivered_packets > 0);
+        REQUIRE_THAT(results.cycle_time, Catch::Matchers::WithinRel(PACKET_SIZE / LINK_BANDWIDTH));
+
+        // the link bandwidth utilization matches the offered load
+        REQUIRE_THAT(results.link_stats[NocLinkId(0)].offered_load, Catch::Matchers::WithinRel(0.3));
+        REQUIRE_THAT(results.link_stats[NocLinkId(1)].offered_load, Catch::Matchers::WithinRel(0.5));
+        REQUIRE_THAT(results.link_stats[NocLinkId(0)].utilization, Catch::Matchers::WithinAbs(0.3, 0.02));
+        REQUIRE_THAT(results.link_stats[NocLinkId(1)].utilization, Catch::Matchers::WithinAbs(0.5, 0.02));
+
+        // at this load, most packets are not queued and only see the zero-load latency of their flow
+        const auto& flow_stats = results.traffic_flow_stats[NocTrafficFlowId(0)];
+        const double zero_load_latency = 3 * ROUTER_LATENCY + 2 * LINK_LATENCY;
+        REQUIRE(flow_stats.num_delivered_packets > 0);
+        REQUIRE(flow_stats.mean_latency >= zero_load_latency);
+        REQUIRE(results.p50_latency <= zero_load_latency + results.cycle_time);
+
+        // the results do not depend on anything but the seed
+        t_noc_sim_results rerun_results = noc_simulator.run(20000, 2000, 1);
+        REQUIRE(rerun_results.num_delivered_packets == results.num_delivered_packets);
+        REQUIRE(rerun_results.max_latency == results.max_latency);
+    }
+
+    SECTION("Test case where a link is overloaded.") {
+        traffic_flow_storage.create_noc_traffic_flow("r0", "r2", ClusterBlockId(0), ClusterBlockId(2), 0.7 * LINK_BANDWIDTH, MAX_LATENCY, 1);
+        traffic_flow_storage.create_noc_traffic_flow("r1", "r2", ClusterBlockId(1), ClusterBlockId(2), 0.6 * LINK_BANDWIDTH, MAX_LATENCY, 1);
+        traffic_flow_storage.finished_noc_traffic_flows_setup();
+        traffic_flow_routes.push_back(route_0_to_2);
+        traffic_flow_routes.push_back(route_1_to_2);
+
+        NocSimulator noc_simulator(noc_model, traffic_flow_storage, traffic_flow_routes, PACKET_SIZE);
+        t_noc_sim_results results = noc_simulator.run(20000, 2000, 1);
+
+        // only the shared link is saturated, and its queue keeps growing
+        REQUIRE(results.num_saturated_links == 1);
+        REQUIRE(results.link_stats[NocLinkId(0)].saturated == false);
+        REQUIRE(results.link_stats[NocLinkId(1)].saturated == true);
+        REQUIRE_THAT(results.link_stats[NocLinkId(1)].offered_load, Catch::Matchers::WithinRel(1.3));
+        REQUIRE(results.link_stats[NocLinkId(1)].max_queue_length > 1000);
+        REQUIRE(results.num_undelivered_packets > 0);
+
+        // the queueing delay makes the packets miss their latency constraint
+        REQUIRE(results.num_traffic_flows_meeting_latency == 0);
+        REQUIRE(results.p99_latency > MAX_LATENCY);
+    }
+}
+
+} // namespace
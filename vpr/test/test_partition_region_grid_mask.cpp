@@ -0,0 +1,52 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "device_grid.h"
+#include "partition_region_grid_mask.h"
+#include "physical_types.h"
+
+namespace {
+
+TEST_CASE("partition_region_grid_mask", "[vpr]") {
+    constexpr int grid_width = 10;
+    constexpr int grid_height = 8;
+
+    t_physical_tile_type tile_type;
+    tile_type.name = "tile";
+    tile_type.capacity = 2;
+
+    vtr::NdMatrix<t_grid_tile, 3> test_grid({1, grid_width, grid_height});
+    for (int x = 0; x < grid_width; x++) {
+        for (int y = 0; y < grid_height; y++) {
+            test_grid[0][x][y].type = &tile_type;
+        }
+    }
+    DeviceGrid grid("test_device_grid", test_grid, {}, {});
+
+    // Overlapping regions, one restricted to a sub-tile, and one extending past the grid
+    PartitionRegion pr;
+    pr.add_to_part_region(Region(1, 1, 3, 4, 0));
+    Region sub_tile_region(3, 3, 6, 6, 0);
+    sub_tile_region.set_sub_tile(1);
+    pr.add_to_part_region(sub_tile_region);
+    pr.add_to_part_region(Region(8, 0, 12, 2, 0, 1));
+
+    PartitionRegionGridMask mask(pr, grid);
+
+    // The mask agrees with scanning the regions everywhere on the grid
+    for (int x = 0; x < grid_width; x++) {
+        for (int y = 0; y < grid_height; y++) {
+            for (int sub_tile = 0; sub_tile < tile_type.capacity; sub_tile++) {
+                t_pl_loc loc(x, y, sub_tile, 0);
+                REQUIRE(mask.is_loc_in_part_reg(loc, pr) == pr.is_loc_in_part_reg(loc));
+            }
+        }
+    }
+
+    REQUIRE(mask.is_loc_in_part_reg(t_pl_loc(3, 3, 0, 0), pr));
+    REQUIRE(mask.is_loc_in_part_reg(t_pl_loc(5, 5, 1, 0), pr));
+    REQUIRE(!mask.is_loc_in_part_reg(t_pl_loc(5, 5, 0, 0), pr));
+    REQUIRE(mask.is_loc_in_part_reg(t_pl_loc(9, 2, 0, 0), pr));
+    REQUIRE(!mask.is_loc_in_part_reg(t_pl_loc(0, 0, 0, 0), pr));
+}
+
+} // namespace
@@ -0,0 +1,35 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "placement_seed_race.h"
+
+namespace {
+
+TEST_CASE("placement_seed_race", "[vpr]") {
+    SECTION("Losing seeds stop") {
+        PlacementSeedRace seed_race(1.5);
+
+        // The first seed to reach a temperature keeps annealing
+        REQUIRE(seed_race.keep_annealing(0, 10.));
+        REQUIRE(seed_race.keep_annealing(0, 14.));
+        REQUIRE(!seed_race.keep_annealing(0, 16.));
+
+        // A better seed lowers the best quality of the temperature
+        REQUIRE(seed_race.keep_annealing(1, 8.));
+        REQUIRE(seed_race.keep_annealing(1, 4.));
+        REQUIRE(!seed_race.keep_annealing(1, 8.));
+        REQUIRE(seed_race.keep_annealing(1, 6.));
+
+        // Temperatures are compared independently
+        REQUIRE(seed_race.keep_annealing(3, 100.));
+        REQUIRE(seed_race.keep_annealing(2, 5.));
+    }
+
+    SECTION("No seed stops with a zero ratio") {
+        PlacementSeedRace seed_race(0.);
+
+        REQUIRE(seed_race.keep_annealing(0, 1.));
+        REQUIRE(seed_race.keep_annealing(0, 1000.));
+    }
+}
+
+} // namespace
@@ -0,0 +1,47 @@
+#include <cmath>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "router_lookahead_quantized_cost.h"
+
+namespace {
+
+TEST_CASE("quantized_cost_round_trip", "[vpr]") {
+    // Typical wire delays, in seconds
+    const float min_delay = 1e-12f;
+    util::QuantizedCostScale scale(min_delay);
+
+    uint16_t prev_code = util::QuantizedCostScale::ZERO;
+    for (float delay = min_delay; delay < 1e-6f; delay *= 1.37f) {
+        uint16_t code = scale.encode(delay);
+        REQUIRE(code != util::QuantizedCostScale::ZERO);
+        REQUIRE(code != util::QuantizedCostScale::INVALID);
+        REQUIRE(code >= prev_code);
+        prev_code = code;
+
+        float decoded = scale.decode(code);
+        REQUIRE(std::abs(decoded - delay) <= delay / 2048.f);
+    }
+}
+
+TEST_CASE("quantized_cost_special_values", "[vpr]") {
+    util::QuantizedCostScale scale(1e-12f);
+
+    REQUIRE(scale.encode(0.f) == util::QuantizedCostScale::ZERO);
+    REQUIRE(scale.decode(util::QuantizedCostScale::ZERO) == 0.f);
+
+    REQUIRE(scale.encode(std::nanf("")) == util::QuantizedCostScale::INVALID);
+    REQUIRE(std::isnan(scale.decode(util::QuantizedCostScale::INVALID)));
+
+    // Costs far below the smallest cost of the table round to zero
+    REQUIRE(scale.encode(1e-30f) == util::QuantizedCostScale::ZERO);
+
+    // Costs beyond the range saturate instead of becoming invalid
+    REQUIRE(scale.encode(std::numeric_limits<float>::infinity()) == util::QuantizedCostScale::MAX_CODE);
+
+    util::t_quantized_cost_entry entry;
+    REQUIRE(std::isnan(scale.decode(entry.delay)));
+    REQUIRE(std::isnan(scale.decode(entry.congestion)));
+}
+
+} // namespace
@@ -0,0 +1,30 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "routing_predictor.h"
+
+namespace {
+
+TEST_CASE("routing_predictor_overuse_stall", "[vpr]") {
+    RoutingPredictor predictor;
+    REQUIRE(predictor.iterations_since_overuse_improvement(0.05) == 0);
+
+    // Steadily converging
+    size_t itry = 1;
+    for (size_t overuse = 1000000; itry <= 10; itry++, overuse /= 2) {
+        predictor.add_iteration_overuse(itry, overuse);
+    }
+    REQUIRE(predictor.iterations_since_overuse_improvement(0.05) == 0);
+
+    // Plateau at the last overuse (1953): wiggles below the improvement threshold don't count as progress
+    for (; itry <= 30; itry++) {
+        predictor.add_iteration_overuse(itry, 1953 - 10 * (itry % 2));
+    }
+    REQUIRE(predictor.iterations_since_overuse_improvement(0.05) == 20);
+    REQUIRE(predictor.iterations_since_overuse_improvement(0.) == 19);
+
+    // Real progress resets the count
+    predictor.add_iteration_overuse(itry, 1000);
+    REQUIRE(predictor.iterations_since_overuse_improvement(0.05) == 0);
+}
+
+} // namespace
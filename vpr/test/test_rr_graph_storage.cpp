@@ -0,0 +1,103 @@
+#include <vector>
+#include <tuple>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "rr_graph_storage.h"
+
+namespace {
+
+/// Build a small storage with edges added out of source order, then partition it.
+void build_test_graph(t_rr_graph_storage& storage, vtr::vector<RRSwitchId, t_rr_switch_inf>& rr_switches) {
+    constexpr size_t num_nodes = 6;
+    for (size_t i = 0; i < num_nodes; i++) {
+        storage.emplace_back();
+    }
+
+    rr_switches.resize(1);
+    rr_switches[RRSwitchId(0)].set_type(e_switch_type::MUX);
+
+    // Node 3 has no fan-out on purpose
+    const std::vector<std::pair<size_t, size_t>> edges = {{4, 5}, {0, 1}, {2, 3}, {0, 2}, {5, 0}, {1, 4}, {4, 1}, {2, 0}};
+    for (const auto& [src, dest] : edges) {
+        storage.emplace_back_edge(RRNodeId(src), RRNodeId(dest), 0, false);
+    }
+    storage.mark_edges_as_rr_switch_ids();
+    storage.partition_edges(rr_switches);
+}
+
+TEST_CASE("rr_graph_storage_compress_edges", "[vpr]") {
+    t_rr_graph_storage storage;
+    vtr::vector<RRSwitchId, t_rr_switch_inf> rr_switches;
+    build_test_graph(storage, rr_switches);
+
+    std::vector<std::tuple<RREdgeId, RRNodeId, RRNodeId>> expected;
+    storage.for_each_edge([&](RREdgeId edge, RRNodeId src, RRNodeId dest) {
+        expected.emplace_back(edge, src, dest);
+    });
+    REQUIRE(expected.size() == 8);
+
+    // Dropping the edge sources saves their storage
+    size_t uncompressed_bytes = storage.memory_used();
+    storage.compress_edges();
+    REQUIRE(storage.edges_compressed());
+    REQUIRE(storage.memory_used() <= uncompressed_bytes - expected.size() * sizeof(RRNodeId));
+
+    for (const auto& [edge, src, dest] : expected) {
+        REQUIRE(storage.edge_src_node(edge) == src);
+        REQUIRE(storage.edge_sink_node(edge) == dest);
+    }
+
+    std::vector<std::tuple<RREdgeId, RRNodeId, RRNodeId>> compressed;
+    storage.for_each_edge([&](RREdgeId edge, RRNodeId src, RRNodeId dest) {
+        compressed.emplace_back(edge, src, dest);
+    });
+    REQUIRE(compressed == expected);
+
+    storage.decompress_edges();
+    REQUIRE(!storage.edges_compressed());
+    for (const auto& [edge, src, dest] : expected) {
+        REQUIRE(storage.edge_src_node(edge) == src);
+    }
+}
+
+TEST_CASE("rr_graph_storage_reverse_edges", "[vpr]") {
+    t_rr_graph_storage storage;
+    vtr::vector<RRSwitchId, t_rr_switch_inf> rr_switches;
+    build_test_graph(storage, rr_switches);
+    REQUIRE(!storage.has_reverse_edges());
+
+    // Also works without the edge sources
+    storage.compress_edges();
+    storage.init_fan_in();
+    storage.init_reverse_edges();
+    REQUIRE(storage.has_reverse_edges());
+
+    std::vector<std::vector<std::pair<RREdgeId, RRNodeId>>> expected(storage.size());
+    storage.for_each_edge([&](RREdgeId edge, RRNodeId src, RRNodeId dest) {
+        expected[size_t(dest)].emplace_back(edge, src);
+    });
+
+    t_rr_graph_view view = storage.view();
+    REQUIRE(view.has_reverse_edges());
+    for (size_t inode = 0; inode < storage.size(); inode++) {
+        RRNodeId node(inode);
+        REQUIRE(storage.reverse_edges(node).size() == storage.fan_in(node));
+        std::vector<std::pair<RREdgeId, RRNodeId>> reverse;
+        for (size_t i = 0; i < view.reverse_edges(node).size(); i++) {
+            RREdgeId edge = view.reverse_edges(node)[i];
+            REQUIRE(storage.edge_sink_node(edge) == node);
+            REQUIRE(view.reverse_edge_src_nodes(node)[i] == storage.reverse_edge_src_nodes(node)[i]);
+            reverse.emplace_back(edge, view.reverse_edge_src_nodes(node)[i]);
+        }
+        REQUIRE(reverse == expected[inode]);
+    }
+    // Node 3 is only driven by node 2
+    REQUIRE(storage.reverse_edges(RRNodeId(3)).size() == 1);
+    REQUIRE(storage.reverse_edge_src_nodes(RRNodeId(3))[0] == RRNodeId(2));
+
+    storage.clear_reverse_edges();
+    REQUIRE(!storage.has_reverse_edges());
+}
+
+} // namespace
@@ -0,0 +1,84 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "rr_spatial_index.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Whether the regions overlap, including their edges
+bool touches(const vtr::Rect<float>& lhs, const vtr::Rect<float>& rhs) {
+    return lhs.xmin() <= rhs.xmax() && rhs.xmin() <= lhs.xmax()
+           && lhs.ymin() <= rhs.ymax() && rhs.ymin() <= lhs.ymax();
+}
+
+TEST_CASE("rr_spatial_index", "[vpr]") {
+    // Wires, pins and a few device-wide nodes
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(0., 1000.);
+    std::uniform_real_distribution<float> length(0., 40.);
+
+    std::vector<std::pair<RRNodeId, vtr::Rect<float>>> node_bboxes;
+    for (size_t inode = 0; inode < 5000; inode++) {
+        float x = coord(rng);
+        float y = coord(rng);
+        vtr::Rect<float> bbox;
+        switch (inode % 4) {
+            case 0: // horizontal wire
+                bbox = vtr::Rect<float>(x, y, x + length(rng), y);
+                break;
+            case 1: // vertical wire
+                bbox = vtr::Rect<float>(x, y, x, y + length(rng));
+                break;
+            case 2: // pin
+                bbox = vtr::Rect<float>(x, y, x, y);
+                break;
+            default:
+                bbox = vtr::Rect<float>(x, y, x + length(rng), y + length(rng));
+                break;
+        }
+        if (inode % 1000 == 999) {
+            bbox = vtr::Rect<float>(0., y, 1000., y + 1.);
+        }
+        // Nodes which are not drawn are not indexed
+        if (inode % 7 != 3) {
+            node_bboxes.emplace_back(RRNodeId(inode), bbox);
+        }
+    }
+
+    RRSpatialIndex index;
+    REQUIRE(index.empty());
+    REQUIRE(index.query(vtr::Rect<float>(0., 0., 1000., 1000.)).empty());
+
+    index.build(node_bboxes);
+    REQUIRE(!index.empty());
+
+    // The query returns the same nodes as a search through all of them, in increasing id order
+    std::vector<vtr::Rect<float>> views{vtr::Rect<float>(-10., -10., 1010., 1010.),
+                                        vtr::Rect<float>(100., 200., 150., 230.),
+                                        vtr::Rect<float>(500., 500., 500., 500.),
+                                        vtr::Rect<float>(0., 990., 1000., 1100.),
+                                        vtr::Rect<float>(2000., 2000., 2100., 2100.)};
+    for (size_t iview = 0; iview < 50; iview++) {
+        float x = coord(rng);
+        float y = coord(rng);
+        views.emplace_back(x, y, x + 4 * length(rng), y + 4 * length(rng));
+    }
+
+    for (const vtr::Rect<float>& view : views) {
+        std::vector<RRNodeId> expected_nodes;
+        for (const auto& [inode, bbox] : node_bboxes) {
+            if (touches(bbox, view)) {
+                expected_nodes.push_back(inode);
+            }
+        }
+        REQUIRE(index.query(view) == expected_nodes);
+    }
+
+    index.clear();
+    REQUIRE(index.empty());
+}
+
+} // namespace
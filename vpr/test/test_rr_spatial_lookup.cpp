@@ -0,0 +1,84 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "rr_spatial_lookup.h"
+
+#include <vector>
+
+namespace {
+
+TEST_CASE("rr_spatial_lookup_compress", "[vpr]") {
+    RRSpatialLookup lookup;
+    // Resizing does not keep the nodes added, so the look-up is sized first (as when building a graph)
+    for (e_rr_type type : {e_rr_type::CHANX, e_rr_type::SOURCE, e_rr_type::SINK}) {
+        lookup.resize_nodes(0, 3, 2, type, TOTAL_2D_SIDES[0]);
+    }
+    lookup.resize_nodes(0, 3, 2, e_rr_type::IPIN, LEFT);
+
+    // A channel with a missing track, pins on two sides, and SOURCEs mirrored over a 2-high block
+    size_t inode = 0;
+    for (int x = 0; x < 4; x++) {
+        for (int y = 0; y < 3; y++) {
+            for (int track = 0; track < 6; track++) {
+                if (track != 2) {
+                    lookup.add_node(RRNodeId(inode++), 0, x, y, e_rr_type::CHANX, track);
+                }
+            }
+            lookup.add_node(RRNodeId(inode++), 0, x, y, e_rr_type::IPIN, 1, TOP);
+            lookup.add_node(RRNodeId(inode++), 0, x, y, e_rr_type::IPIN, 1, RIGHT);
+        }
+    }
+    lookup.add_node(RRNodeId(inode++), 0, 1, 1, e_rr_type::SOURCE, 0);
+    lookup.mirror_nodes(0, vtr::Point<int>(1, 1), vtr::Point<int>(1, 2), e_rr_type::SOURCE, TOP);
+    // A trailing unused ptc
+    lookup.add_node(RRNodeId(inode++), 0, 3, 2, e_rr_type::SINK, 4);
+    REQUIRE(lookup.remove_node(RRNodeId(inode - 1), 0, 3, 2, e_rr_type::SINK, 4));
+
+    auto check_lookup = [&]() {
+        REQUIRE(lookup.find_channel_nodes(0, 2, 1, e_rr_type::CHANX).size() == 5);
+        REQUIRE(lookup.find_channel_nodes(0, 4, 1, e_rr_type::CHANX).empty());
+        REQUIRE(lookup.find_channel_nodes(0, 2, 1, e_rr_type::CHANY).empty());
+        REQUIRE(lookup.find_node(0, 2, 1, e_rr_type::CHANX, 0) == RRNodeId((2 * 3 + 1) * 7));
+        REQUIRE(lookup.find_node(0, 2, 1, e_rr_type::CHANX, 2) == RRNodeId::INVALID());
+        REQUIRE(lookup.find_node(0, 2, 1, e_rr_type::CHANX, 6) == RRNodeId::INVALID());
+        REQUIRE(lookup.find_node(1, 2, 1, e_rr_type::CHANX, 0) == RRNodeId::INVALID());
+        REQUIRE(lookup.find_node(0, -1, 1, e_rr_type::CHANX, 0) == RRNodeId::INVALID());
+
+        REQUIRE(lookup.find_node(0, 3, 0, e_rr_type::IPIN, 1, RIGHT) == RRNodeId((3 * 3 + 0) * 7 + 6));
+        REQUIRE(lookup.find_node(0, 3, 0, e_rr_type::IPIN, 1, BOTTOM) == RRNodeId::INVALID());
+        REQUIRE(lookup.find_nodes_at_all_sides(0, 3, 0, e_rr_type::IPIN, 1).size() == 2);
+        REQUIRE(lookup.find_grid_nodes_at_all_sides(0, 3, 0, e_rr_type::IPIN).size() == 2);
+
+        REQUIRE(lookup.find_node(0, 1, 2, e_rr_type::SOURCE, 0) == RRNodeId(4 * 3 * 7));
+        REQUIRE(lookup.find_nodes_in_range(0, 0, 0, 3, 2, e_rr_type::SOURCE, 0).size() == 1);
+        REQUIRE(lookup.find_grid_nodes_at_all_sides(0, 3, 2, e_rr_type::SINK).empty());
+    };
+
+    check_lookup();
+    size_t uncompressed_memory = lookup.memory_used();
+
+    lookup.compress();
+    REQUIRE(lookup.is_compressed());
+    check_lookup();
+    REQUIRE(lookup.memory_used() < uncompressed_memory);
+
+    // Renumbering the nodes keeps the look-up compressed
+    vtr::vector<RRNodeId, RRNodeId> dest_order(inode);
+    for (size_t i = 0; i < inode; i++) {
+        dest_order[RRNodeId(i)] = RRNodeId(inode - 1 - i);
+    }
+    lookup.reorder(dest_order);
+    REQUIRE(lookup.is_compressed());
+    REQUIRE(lookup.find_node(0, 1, 2, e_rr_type::SOURCE, 0) == RRNodeId(inode - 1 - 4 * 3 * 7));
+    lookup.reorder(dest_order);
+
+    // Adding a node decompresses the look-up, keeping the nodes
+    lookup.add_node(RRNodeId(inode), 0, 0, 0, e_rr_type::CHANY, 3);
+    REQUIRE(!lookup.is_compressed());
+    check_lookup();
+    REQUIRE(lookup.find_node(0, 0, 0, e_rr_type::CHANY, 3) == RRNodeId(inode));
+
+    lookup.clear();
+    REQUIRE(lookup.find_node(0, 2, 1, e_rr_type::CHANX, 0) == RRNodeId::INVALID());
+}
+
+} // namespace
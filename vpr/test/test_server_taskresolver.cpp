@@ -3,6 +3,9 @@
 #include "catch2/catch_test_macros.hpp"
 
 #include "taskresolver.h"
+#include "commconstants.h"
+#include "telegramparser.h"
+#include "zlibutils.h"
 #include <memory>
 
 TEST_CASE("test_server_taskresolver_cmdSpamFilter", "[vpr]") {
@@ -111,4 +114,35 @@ TEST_CASE("test_server_taskresolver_cmdSpamAndOverrideOptions", "[vpr]") {
     REQUIRE(task1->options() == "");
 }
 
+TEST_CASE("test_server_task_progressResponse", "[vpr]") {
+    const comm::CMD cmd = comm::CMD::GET_PATH_LIST_ID;
+    server::Task task(7, cmd, "options");
+
+    server::TaskPtr progress = task.make_progress_response("partial");
+    REQUIRE(progress->is_progress());
+    REQUIRE(progress->is_finished());
+    REQUIRE(!progress->has_error());
+    REQUIRE(progress->job_id() == 7);
+    REQUIRE(progress->cmd() == cmd);
+    REQUIRE(progress->options() == "options");
+    REQUIRE(!task.is_finished());
+
+    // the progress response has the in progress status, and carries the partial result
+    std::string body{progress->response_buffer().substr(comm::TelegramHeader::size())};
+    if (progress->telegram_header().is_body_compressed()) {
+        body = try_decompress(body).value();
+    }
+    REQUIRE(comm::TelegramParser::try_extract_field_job_id(body) == std::optional<int>{7});
+    REQUIRE(comm::TelegramParser::try_extract_field_status(body) == std::optional<int>{comm::STATUS_IN_PROGRESS});
+    REQUIRE(comm::TelegramParser::try_extract_field_data(body) == std::optional<std::string>{"partial"});
+
+    task.set_success("result");
+    body = task.response_buffer().substr(comm::TelegramHeader::size());
+    if (task.telegram_header().is_body_compressed()) {
+        body = try_decompress(body).value();
+    }
+    REQUIRE(comm::TelegramParser::try_extract_field_status(body) == std::optional<int>{comm::STATUS_SUCCESS});
+    REQUIRE(comm::TelegramParser::try_extract_field_data(body) == std::optional<std::string>{"result"});
+}
+
 #endif /* NO_SERVER */
@@ -119,6 +119,35 @@ TEST_CASE("test_server_telegrambuffer_twoFinished", "[vpr]") {
     REQUIRE(comm::ByteArray{} == tBuff.data());
 }
 
+TEST_CASE("test_server_telegrambuffer_incrementalAppend", "[vpr]") {
+    comm::TelegramBuffer tBuff;
+
+    const comm::ByteArray msgBody1{"message1"};
+    const comm::ByteArray msgBody2{"message2"};
+
+    const comm::TelegramHeader msgHeader1{comm::TelegramHeader::construct_from_body(msgBody1)};
+    const comm::TelegramHeader msgHeader2{comm::TelegramHeader::construct_from_body(msgBody2)};
+
+    comm::ByteArray stream{"#@!"};
+    stream.append(msgHeader1.buffer());
+    stream.append(msgBody1);
+    stream.append(msgHeader2.buffer());
+    stream.append(msgBody2);
+
+    // the telegrams are extracted as soon as they are complete, whatever the bytes are received by
+    std::vector<comm::TelegramFramePtr> frames;
+    for (char b : stream) {
+        tBuff.append(&b, 1);
+        tBuff.take_telegram_frames(frames);
+    }
+    REQUIRE(2 == frames.size());
+
+    REQUIRE(msgBody1 == frames[0]->body);
+    REQUIRE(msgBody2 == frames[1]->body);
+
+    REQUIRE(comm::ByteArray{} == tBuff.data());
+}
+
 TEST_CASE("test_server_telegrambuffer_clear", "[vpr]") {
     comm::TelegramBuffer tBuff;
 
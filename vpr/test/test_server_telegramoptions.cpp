@@ -26,4 +26,17 @@ TEST_CASE("test_server_telegramoptions_get_wrong_keys", "[vpr]") {
     REQUIRE(options.get_bool("_is_flat_routing", true) == true);
 }
 
+TEST_CASE("test_server_telegramoptions_optional_keys", "[vpr]") {
+    server::TelegramOptions options{"int:path_num:11;float:min_slack:-0.25;string:to:^out", {"path_num"}};
+
+    REQUIRE(options.errors_str() == "");
+
+    REQUIRE(options.has_key("min_slack"));
+    REQUIRE(options.has_key("to"));
+    REQUIRE(!options.has_key("max_slack"));
+
+    REQUIRE(options.get_float("min_slack", 0.0f) == -0.25f);
+    REQUIRE(options.get_string("to") == "^out");
+}
+
 #endif /* NO_SERVER */
@@ -0,0 +1,60 @@
+#ifndef NO_SERVER
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "workerpool.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+TEST_CASE("test_server_workerpool_executesJobs", "[vpr]") {
+    server::WorkerPool pool(2);
+
+    std::atomic<int> counter{0};
+    std::promise<void> done;
+    const int jobs_num = 100;
+    for (int i = 0; i < jobs_num; i++) {
+        pool.submit([&]() {
+            if (++counter == jobs_num) {
+                done.set_value();
+            }
+        });
+    }
+
+    REQUIRE(done.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    REQUIRE(counter == jobs_num);
+}
+
+TEST_CASE("test_server_workerpool_concurrentJobs", "[vpr]") {
+    server::WorkerPool pool(2);
+
+    // the second job runs while the first one waits for it
+    std::promise<void> second_started;
+    std::future<void> second_started_future = second_started.get_future();
+    std::promise<bool> first_finished;
+    pool.submit([&]() {
+        bool is_second_started = second_started_future.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+        first_finished.set_value(is_second_started);
+    });
+    pool.submit([&]() { second_started.set_value(); });
+
+    std::future<bool> first_finished_future = first_finished.get_future();
+    REQUIRE(first_finished_future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    REQUIRE(first_finished_future.get());
+}
+
+TEST_CASE("test_server_workerpool_restartAfterStop", "[vpr]") {
+    server::WorkerPool pool(1);
+    pool.stop();
+
+    std::promise<int> result;
+    pool.submit([&]() { result.set_value(42); });
+
+    std::future<int> result_future = result.get_future();
+    REQUIRE(result_future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    REQUIRE(result_future.get() == 42);
+}
+
+#endif /* NO_SERVER */
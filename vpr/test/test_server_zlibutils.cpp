@@ -17,4 +17,27 @@ TEST_CASE("test_server_zlib_utils", "[vpr]") {
     REQUIRE(orig == decompressedOpt.value());
 }
 
+TEST_CASE("test_server_zlib_utils_compress_parts", "[vpr]") {
+    // large enough for the compressed data to take several output chunks
+    std::string data;
+    for (int i = 0; i < 100000; i++) {
+        data += std::to_string(i * 7919 % 100003) + " ";
+    }
+    const std::string prefix{"{\"DATA\":\""};
+    const std::string suffix{"\"}"};
+
+    std::string compressed{"header"};
+    REQUIRE(try_compress_append({prefix, "", data, suffix}, compressed));
+    REQUIRE(compressed.substr(0, 6) == "header");
+
+    // same data as for the concatenated parts
+    std::optional<std::string> whole_compressed_opt = try_compress(prefix + data + suffix);
+    REQUIRE(whole_compressed_opt);
+    REQUIRE(compressed.substr(6) == whole_compressed_opt.value());
+
+    std::optional<std::string> decompressedOpt = try_decompress(compressed.substr(6));
+    REQUIRE(decompressedOpt);
+    REQUIRE(decompressedOpt.value() == prefix + data + suffix);
+}
+
 #endif /* NO_SERVER */
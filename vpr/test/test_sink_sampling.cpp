@@ -0,0 +1,36 @@
+#include <algorithm>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "sink_sampling.h"
+
+namespace {
+
+TEST_CASE("skeleton_first_order", "[vpr]") {
+    // 4x4 bins; sinks given in criticality order
+    std::vector<SinkPoint> sinks = {
+        {0, 0, 1},  // bin (0, 0), corner
+        {8, 8, 2},  // bin (2, 2), corner
+        {1, 2, 3},  // bin (0, 0), center
+        {5, 1, 4},  // bin (1, 0), only sink
+        {10, 9, 5}, // bin (2, 2), center
+        {2, 1, 6},  // bin (0, 0), as close to the center as 3
+        {1, 1, 7},  // bin (0, 0), as close to the center as 3
+    };
+    SinkPoint source{0, 0, 0};
+
+    std::vector<int> order = sink_sampling::skeleton_first_order(sinks, source, 4, 4);
+
+    // One sink per bin (closest to the bin center, earliest on a tie) ordered by distance to the source,
+    // followed by the other sinks in their original order
+    REQUIRE(order == std::vector<int>({3, 4, 5, 1, 2, 6, 7}));
+
+    // Each sink is routed exactly once
+    std::sort(order.begin(), order.end());
+    REQUIRE(order == std::vector<int>({1, 2, 3, 4, 5, 6, 7}));
+
+    REQUIRE(sink_sampling::skeleton_first_order({}, source, 4, 4).empty());
+}
+
+} // namespace
@@ -0,0 +1,142 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "tatum/TimingConstraints.hpp"
+#include "tatum/TimingGraph.hpp"
+#include "tatum/analyzer_factory.hpp"
+#include "tatum/delay_calc/FixedDelayCalculator.hpp"
+#include "tatum/report/TimingPathCache.hpp"
+
+#include <set>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Returns the (start-point, end-point, launch domain, capture domain) of the paths, to compare them.
+ */
+std::vector<std::tuple<tatum::NodeId, tatum::NodeId, tatum::DomainId, tatum::DomainId>> path_ids(const std::vector<tatum::TimingPath>& paths) {
+    std::vector<std::tuple<tatum::NodeId, tatum::NodeId, tatum::DomainId, tatum::DomainId>> ids;
+    for (const tatum::TimingPath& path : paths) {
+        const tatum::TimingPathInfo& info = path.path_info();
+        ids.emplace_back(info.startpoint(), info.endpoint(), info.launch_domain(), info.capture_domain());
+    }
+    return ids;
+}
+
+TEST_CASE("timing_path_cache_query", "[vpr]") {
+    // Input to output paths of increasing delays, alternating between two (virtual) clock domains
+    constexpr size_t NUM_PATHS = 20;
+    constexpr float PERIOD = 10e-9;
+
+    tatum::TimingGraph timing_graph;
+    std::vector<tatum::NodeId> sources;
+    std::vector<tatum::NodeId> sinks;
+    for (size_t i = 0; i < NUM_PATHS; i++) {
+        sources.push_back(timing_graph.add_node(tatum::NodeType::SOURCE));
+        sinks.push_back(timing_graph.add_node(tatum::NodeType::SINK));
+        timing_graph.add_edge(tatum::EdgeType::PRIMITIVE_COMBINATIONAL, sources.back(), sinks.back());
+    }
+    timing_graph.levelize();
+
+    tatum::util::linear_map<tatum::EdgeId, tatum::Time> edge_delays(timing_graph.edges().size());
+    tatum::util::linear_map<tatum::EdgeId, tatum::Time> setup_times(timing_graph.edges().size(), tatum::Time(0.));
+    for (size_t i = 0; i < NUM_PATHS; i++) {
+        // ties on a few slacks
+        edge_delays[tatum::EdgeId(i)] = tatum::Time((i / 2 % 7 + 1) * 1e-9);
+    }
+    tatum::FixedDelayCalculator delay_calc(edge_delays, setup_times);
+
+    tatum::TimingConstraints timing_constraints;
+    tatum::DomainId clk_a = timing_constraints.create_clock_domain("clk_a");
+    tatum::DomainId clk_b = timing_constraints.create_clock_domain("clk_b");
+    timing_constraints.set_setup_constraint(clk_a, clk_a, tatum::Time(PERIOD));
+    timing_constraints.set_setup_constraint(clk_b, clk_b, tatum::Time(PERIOD));
+    for (size_t i = 0; i < NUM_PATHS; i++) {
+        tatum::DomainId domain = (i % 2) ? clk_b : clk_a;
+        timing_constraints.set_input_constraint(sources[i], domain, tatum::DelayType::MAX, tatum::Time(0.));
+        timing_constraints.set_input_constraint(sources[i], domain, tatum::DelayType::MIN, tatum::Time(0.));
+        timing_constraints.set_output_constraint(sinks[i], domain, tatum::DelayType::MAX, tatum::Time(0.));
+        timing_constraints.set_output_constraint(sinks[i], domain, tatum::DelayType::MIN, tatum::Time(0.));
+    }
+
+    auto setup_analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis>::make(timing_graph, timing_constraints, delay_calc);
+    setup_analyzer->update_timing();
+
+    tatum::TimingPathCache path_cache(timing_graph);
+    const std::vector<tatum::TimingPath> worst_paths = path_cache.worst_setup_timing_paths(*setup_analyzer, NUM_PATHS);
+    REQUIRE(worst_paths.size() == NUM_PATHS);
+
+    // The queries return the worst paths accepted by the filter, in the same order
+    auto filtered_worst_paths = [&](auto accept, size_t npaths) {
+        std::vector<tatum::TimingPath> paths;
+        for (const tatum::TimingPath& path : worst_paths) {
+            if (paths.size() < npaths && accept(path)) {
+                paths.push_back(path);
+            }
+        }
+        return paths;
+    };
+
+    SECTION("no filter") {
+        tatum::TimingPathFilter filter;
+        REQUIRE(path_ids(path_cache.query_setup_timing_paths(*setup_analyzer, filter, NUM_PATHS)) == path_ids(worst_paths));
+        REQUIRE(path_ids(path_cache.query_setup_timing_paths(*setup_analyzer, filter, 5)) == path_ids(filtered_worst_paths([](const tatum::TimingPath&) { return true; }, 5)));
+    }
+
+    SECTION("slack range") {
+        tatum::TimingPathFilter filter;
+        filter.min_slack = tatum::Time(5e-9);
+        filter.max_slack = tatum::Time(7.5e-9);
+        auto in_range = [](const tatum::TimingPath& path) {
+            float slack = path.slack_tag().time().value();
+            return slack >= 5e-9f && slack <= 7.5e-9f;
+        };
+        std::vector<tatum::TimingPath> paths = path_cache.query_setup_timing_paths(*setup_analyzer, filter, NUM_PATHS);
+        REQUIRE(!paths.empty());
+        REQUIRE(path_ids(paths) == path_ids(filtered_worst_paths(in_range, NUM_PATHS)));
+        REQUIRE(path_ids(path_cache.query_setup_timing_paths(*setup_analyzer, filter, 2)) == path_ids(filtered_worst_paths(in_range, 2)));
+    }
+
+    SECTION("clock domains") {
+        tatum::TimingPathFilter filter;
+        filter.launch_domain = clk_b;
+        filter.capture_domain = clk_b;
+        auto in_clk_b = [&](const tatum::TimingPath& path) {
+            return path.path_info().launch_domain() == clk_b && path.path_info().capture_domain() == clk_b;
+        };
+        std::vector<tatum::TimingPath> paths = path_cache.query_setup_timing_paths(*setup_analyzer, filter, NUM_PATHS);
+        REQUIRE(paths.size() == NUM_PATHS / 2);
+        REQUIRE(path_ids(paths) == path_ids(filtered_worst_paths(in_clk_b, NUM_PATHS)));
+
+        filter.capture_domain = clk_a;
+        REQUIRE(path_cache.query_setup_timing_paths(*setup_analyzer, filter, NUM_PATHS).empty());
+    }
+
+    SECTION("start and end points") {
+        const std::set<tatum::NodeId> startpoints{sources[3], sources[4], sources[11]};
+        const std::set<tatum::NodeId> endpoints{sinks[4], sinks[11], sinks[12]};
+
+        tatum::TimingPathFilter filter;
+        filter.startpoint = [&](tatum::NodeId node) { return startpoints.count(node) > 0; };
+        filter.endpoint = [&](tatum::NodeId node) { return endpoints.count(node) > 0; };
+        auto accept = [&](const tatum::TimingPath& path) {
+            return startpoints.count(path.path_info().startpoint()) && endpoints.count(path.path_info().endpoint());
+        };
+        std::vector<tatum::TimingPath> paths = path_cache.query_setup_timing_paths(*setup_analyzer, filter, NUM_PATHS);
+        REQUIRE(paths.size() == 2);
+        REQUIRE(path_ids(paths) == path_ids(filtered_worst_paths(accept, NUM_PATHS)));
+    }
+
+    SECTION("timing update") {
+        // the index is rebuilt from the new slacks
+        tatum::TimingPathFilter filter;
+        filter.max_slack = tatum::Time(4e-9);
+        size_t num_paths = path_cache.query_setup_timing_paths(*setup_analyzer, filter, NUM_PATHS).size();
+
+        timing_constraints.set_setup_constraint(clk_a, clk_a, tatum::Time(PERIOD / 2));
+        setup_analyzer->update_timing();
+        REQUIRE(path_cache.query_setup_timing_paths(*setup_analyzer, filter, NUM_PATHS).size() > num_paths);
+    }
+}
+
+} // namespace
@@ -10,6 +10,8 @@
 #include "partition.h"
 #include "region.h"
 #include "place_constraints.h"
+#include "atom_name_index.h"
+#include "atom_netlist.h"
 
 /**
  * This file contains unit tests that check the functionality of all classes related to vpr constraints. These classes include
@@ -573,6 +575,38 @@ TEST_CASE("MacroConstraints", "[vpr]") {
     REQUIRE(mac_first_reg_coord.ymax() == 7);
 }
 
+//Test that the atom name index finds the same atoms as matching every regex against every atom name
+TEST_CASE("AtomNameIndex", "[vpr]") {
+    AtomNetlist netlist("test_netlist");
+    for (const char* name : {"top.core1.alu.add", "top.core0.alu.sub", "top.core0.fpu", "core0.top", "topcore", "out:q"}) {
+        netlist.create_block(name, LogicalModelId::INVALID());
+    }
+
+    REQUIRE(AtomNameIndex::literal_prefix("top.core0") == std::make_pair(std::string("top"), false));
+    REQUIRE(AtomNameIndex::literal_prefix("^top.core0") == std::make_pair(std::string("top"), true));
+    REQUIRE(AtomNameIndex::literal_prefix("topc*") == std::make_pair(std::string("top"), false));
+    REQUIRE(AtomNameIndex::literal_prefix("core0|fpu").first.empty());
+    REQUIRE(AtomNameIndex::literal_prefix(".*alu").first.empty());
+
+    AtomNameIndex index(netlist);
+    std::vector<std::string> patterns = {"top.core0", "^top.core0", "^topc*o", "alu|fpu", ".*alu.*", "core[01]$", "^out:", "^nothing", "p\\.c"};
+    std::vector<std::regex> regexes(patterns.begin(), patterns.end());
+    std::vector<std::vector<AtomBlockId>> pattern_atoms = index.find_matching_atoms(patterns, regexes);
+
+    REQUIRE(pattern_atoms.size() == patterns.size());
+    for (size_t ipattern = 0; ipattern < patterns.size(); ipattern++) {
+        std::vector<AtomBlockId> expected_atoms;
+        for (AtomBlockId blk_id : netlist.blocks()) {
+            if (std::regex_search(netlist.block_name(blk_id), regexes[ipattern])) {
+                expected_atoms.push_back(blk_id);
+            }
+        }
+        REQUIRE(pattern_atoms[ipattern] == expected_atoms);
+    }
+    REQUIRE(pattern_atoms[1].size() == 2);
+    REQUIRE(pattern_atoms[7].empty());
+}
+
 #if 0
 static constexpr const char kArchFile[] = "test_read_arch_metadata.xml";
 
@@ -223,6 +223,25 @@ TEST_CASE("test_route_flow", "[vpr_noc_xy_routing]") {
         // make sure that size of the found route and golden route match
         compare_routes(golden_path, found_path, noc_model);
     }
+    SECTION("Test case where the routes between all the routers are looked up in the all-pairs route table.") {
+        // XY routes only depend on the source and destination routers
+        REQUIRE(!routing_algorithm.route_depends_on_traffic_flow());
+
+        noc_model.build_route_table(routing_algorithm);
+        REQUIRE(noc_model.has_route_table());
+
+        // every route in the table should be the route found by the algorithm
+        for (int start_router = 0; start_router < 16; start_router++) {
+            for (int sink_router = 0; sink_router < 16; sink_router++) {
+                std::vector<NocLinkId> golden_path;
+                routing_algorithm.route_flow(NocRouterId(start_router), NocRouterId(sink_router), NocTrafficFlowId(0), golden_path, noc_model);
+
+                std::vector<NocLinkId> found_path;
+                REQUIRE(noc_model.get_route_from_table(NocRouterId(start_router), NocRouterId(sink_router), found_path));
+                REQUIRE(found_path == golden_path);
+            }
+        }
+    }
 }
 TEST_CASE("test_route_flow when it fails in a mesh topology.", "[vpr_noc_xy_routing]") {
     /*
@@ -388,5 +407,12 @@ TEST_CASE("test_route_flow when it fails in a non mesh topology.", "[vpr_noc_xy_
     // now use the XY router to find a route. We expect this to fail to check that.
     REQUIRE_THROWS_WITH(routing_algorithm.route_flow(start_router_id, sink_router_id, traffic_flow_id, found_path, noc_model),
                         "No route could be found from starting router with ID:'3' and the destination router with ID:'1' using the XY-Routing algorithm.");
+
+    // the route table should record that there is no route between these routers, while still storing the legal routes
+    noc_model.build_route_table(routing_algorithm);
+    REQUIRE(noc_model.has_route_table());
+    REQUIRE(!noc_model.get_route_from_table(start_router_id, sink_router_id, found_path));
+    REQUIRE(noc_model.get_route_from_table(NocRouterId(0), NocRouterId(3), found_path));
+    REQUIRE(found_path.size() == 1);
 }
 } // namespace
@@ -0,0 +1,275 @@
+#!/usr/bin/env python3
+"""
+Runs the jobs of VTR tasks in parallel, packing them by the memory, cores and
+run time they need rather than running a fixed number of them at a time.
+
+The jobs are the scripts written by 'run_vtr_task.py -system scripts' (one
+vtr_flow.sh per <arch>/<circuit>/<script_params> job directory; their paths are
+read from the command line, or from stdin if none is given), or arbitrary shell
+commands with -commands.
+
+The peak memory and run time of each job are taken from the parse_results.txt
+(or golden_results.txt) files of previous runs given with -history, and the
+cores from the --num_workers VPR option of the job. Jobs are started largest
+(longest) first, each as soon as enough cores and memory are free for it. Jobs
+with no history are assumed to be as long as the longest known job, and to need
+-default_memory, so they start early and cannot starve at the end of the run.
+"""
+import argparse
+import csv
+import os
+import re
+import shlex
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+KEY_COLUMNS = ("arch", "circuit", "script_params")
+
+# Peak memory metrics, in KiB unless they are stage_* (MiB), in order of preference
+MEMORY_METRICS = ("vtr_max_mem", "max_vpr_mem", "stage_vpr_max_rss")
+RUNTIME_METRICS = ("vtr_flow_elapsed_time", "stage_vpr_time")
+
+NUM_WORKERS_REGEX = re.compile(r"--num_workers[\s=]+(\d+)")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("jobs", nargs="*", help="Job scripts (or commands with -commands); read from stdin if none")
+    parser.add_argument(
+        "-history",
+        nargs="+",
+        default=[],
+        help="parse_results.txt/golden_results.txt files of previous runs of the jobs (later files take precedence)",
+    )
+    parser.add_argument(
+        "-commands",
+        action="store_true",
+        help="The jobs are shell commands rather than job scripts",
+    )
+    parser.add_argument(
+        "-cores",
+        type=int,
+        default=os.cpu_count(),
+        help="Number of cores the jobs may use together (default: %(default)s)",
+    )
+    parser.add_argument(
+        "-memory",
+        type=float,
+        default=None,
+        help="Memory (in MiB) the jobs may use together (default: 90%% of the machine's memory)",
+    )
+    parser.add_argument(
+        "-memory_margin",
+        type=float,
+        default=1.10,
+        help="Factor applied to the peak memory of previous runs (default: %(default)s)",
+    )
+    parser.add_argument(
+        "-default_memory",
+        type=float,
+        default=1024.0,
+        help="Memory (in MiB) assumed for jobs with no history (default: %(default)s)",
+    )
+    parser.add_argument(
+        "-log_dir",
+        default=".",
+        help="Directory of the output of -commands jobs (default: %(default)s)",
+    )
+    parser.add_argument(
+        "-dry_run",
+        action="store_true",
+        help="Print the jobs with their estimates in the order they would start, and exit",
+    )
+    return parser.parse_args()
+
+
+class Job:
+    def __init__(self, index, text, is_command):
+        self.index = index
+        self.is_command = is_command
+        if is_command:
+            self.name = text
+            self.key = None
+            self.body = text
+        else:
+            self.script = Path(text).resolve()
+            # <task>/runNNN/<arch>/<circuit>/<script_params>/vtr_flow.sh
+            self.key = tuple(self.script.parent.parts[-3:])
+            self.name = "/".join(self.key)
+            self.body = self.script.read_text()
+
+        match = NUM_WORKERS_REGEX.search(self.body)
+        self.cores = max(1, int(match.group(1))) if match else 1
+        self.memory = None  # MiB
+        self.runtime = None  # Seconds
+        self.process = None
+        self.log = None
+        self.start_time = None
+
+    def describe(self):
+        return "{} (cores: {}, memory: {:.0f} MiB, run time: {})".format(
+            self.name,
+            self.cores,
+            self.memory,
+            "{:.1f} s".format(self.runtime) if self.runtime is not None else "unknown",
+        )
+
+    def start(self, log_dir):
+        if self.is_command:
+            self.log = open(Path(log_dir) / "job_{}.out".format(self.index), "w")
+            self.process = subprocess.Popen(self.body, shell=True, stdout=self.log, stderr=subprocess.STDOUT)
+        else:
+            self.log = open(self.script.parent / "schedule_vtr_jobs.out", "w")
+            self.process = subprocess.Popen(
+                ["bash", str(self.script)], cwd=self.script.parent, stdout=self.log, stderr=subprocess.STDOUT
+            )
+        self.start_time = time.time()
+
+    def finish(self):
+        self.log.close()
+        return self.process.returncode, time.time() - self.start_time
+
+
+def machine_memory():
+    """Returns the total memory of the machine in MiB, or None if unknown"""
+    try:
+        with open("/proc/meminfo") as f:
+            for line in f:
+                if line.startswith("MemTotal:"):
+                    return int(line.split()[1]) / 1024
+    except OSError:
+        pass
+    return None
+
+
+def to_float(value):
+    try:
+        return float(value)
+    except (TypeError, ValueError):
+        return None  # Missing or non-numeric (e.g. the job failed)
+
+
+def load_history(filenames):
+    """Returns {(arch, circuit, script_params): (memory in MiB or None, run time in seconds or None)}"""
+    history = {}
+    for filename in filenames:
+        with open(filename, newline="") as f:
+            for row in csv.DictReader(f, delimiter="\t"):
+                row = {name.strip(): value.strip() for name, value in row.items() if name is not None and value is not None}
+                key = tuple(row.get(column, "") for column in KEY_COLUMNS)
+
+                memory = None
+                for metric in MEMORY_METRICS:
+                    value = to_float(row.get(metric))
+                    if value is not None and value > 0:
+                        memory = value if metric.startswith("stage_") else value / 1024
+                        break
+                runtime = None
+                for metric in RUNTIME_METRICS:
+                    runtime = to_float(row.get(metric))
+                    if runtime is not None:
+                        break
+                history[key] = (memory, runtime)
+    return history
+
+
+def find_history(job, history):
+    """Looks up the previous runs of a job: by its (arch, circuit, script_params), else by the arch and circuit in its command"""
+    if job.key in history:
+        return history[job.key]
+
+    tokens = set(Path(token).name for token in shlex.split(job.body, comments=True, posix=True))
+    matches = [value for (arch, circuit, _), value in history.items() if arch in tokens and circuit in tokens]
+    if not matches:
+        return (None, None)
+    # Several script_params: assume the most demanding
+    memories = [memory for memory, _ in matches if memory is not None]
+    runtimes = [runtime for _, runtime in matches if runtime is not None]
+    return (max(memories) if memories else None, max(runtimes) if runtimes else None)
+
+
+def estimate(jobs, history, args):
+    for job in jobs:
+        memory, job.runtime = find_history(job, history)
+        job.memory = memory * args.memory_margin if memory is not None else args.default_memory
+
+    # Unknown jobs start with the longest ones
+    known_runtimes = [job.runtime for job in jobs if job.runtime is not None]
+    longest = max(known_runtimes) if known_runtimes else 0.0
+    return sorted(
+        jobs,
+        key=lambda job: (
+            -(job.runtime if job.runtime is not None else longest),
+            -job.memory,
+            -job.cores,
+            job.index,
+        ),
+    )
+
+
+def run(queue, args, memory_limit):
+    running = []
+    free_cores = args.cores
+    free_memory = memory_limit
+    num_failed = 0
+    while queue or running:
+        # Start, largest first, every job which fits in the free cores and memory
+        for job in list(queue):
+            fits = job.cores <= free_cores and job.memory <= free_memory
+            too_large = job.cores > args.cores or job.memory > memory_limit
+            if fits or (too_large and not running):
+                if too_large:
+                    print("Warning: {} does not fit in the machine, running it alone".format(job.describe()))
+                job.start(args.log_dir)
+                queue.remove(job)
+                running.append(job)
+                free_cores -= job.cores
+                free_memory -= job.memory
+            if free_cores <= 0:
+                break
+
+        time.sleep(0.5)
+        for job in [job for job in running if job.process.poll() is not None]:
+            running.remove(job)
+            free_cores += job.cores
+            free_memory += job.memory
+            returncode, elapsed = job.finish()
+            if returncode == 0:
+                print("{:<60}  OK (took {:.2f} seconds)".format(job.name, elapsed))
+            else:
+                num_failed += 1
+                print("{:<60}  FAILED (exit code {}, took {:.2f} seconds)".format(job.name, returncode, elapsed))
+            sys.stdout.flush()
+    return num_failed
+
+
+def main():
+    args = parse_args()
+
+    lines = args.jobs if args.jobs else [line.strip() for line in sys.stdin]
+    jobs = [Job(index, line, args.commands) for index, line in enumerate(line for line in lines if line)]
+    if not jobs:
+        print("No jobs to run")
+        return 0
+
+    memory_limit = args.memory
+    if memory_limit is None:
+        total = machine_memory()
+        memory_limit = 0.9 * total if total is not None else float("inf")
+
+    queue = estimate(jobs, load_history(args.history), args)
+    if args.dry_run:
+        print("{} job(s) on {} cores and {:.0f} MiB, in start order:".format(len(queue), args.cores, memory_limit))
+        for job in queue:
+            print("  " + job.describe())
+        return 0
+
+    num_failed = run(queue, args, memory_limit)
+    print("{} of {} job(s) failed".format(num_failed, len(jobs)))
+    return num_failed
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+Compares the per-stage run time and peak memory of two vtr_reg_perf runs.
+
+Both inputs are parse_results.txt files (as produced by parse_vtr_task.py, or
+a task's golden_results.txt), the first one being the baseline. Every stage_*
+metric present in both files is compared circuit by circuit, and summarized by
+the geometric mean of the ratios. Changes larger than the relative threshold
+(and larger than the absolute floor, so that short stages are not reported for
+noise) are flagged as regressions or improvements.
+"""
+import argparse
+import csv
+import math
+import sys
+
+KEY_COLUMNS = ("arch", "circuit", "script_params")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="Baseline parse_results.txt (or golden_results.txt)")
+    parser.add_argument("candidate", help="parse_results.txt to compare against the baseline")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.10,
+        help="Relative change flagged as a regression/improvement (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--min_time",
+        type=float,
+        default=5.0,
+        help="Run time changes (in seconds) below this are never flagged (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--min_mem",
+        type=float,
+        default=64.0,
+        help="Memory changes (in MiB) below this are never flagged (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--fail_on_regression",
+        action="store_true",
+        help="Exit with a non-zero status if any regression is flagged",
+    )
+    return parser.parse_args()
+
+
+def load_results(filename):
+    """Returns {(arch, circuit, script_params): {metric: value}} for the stage_* metrics of filename"""
+    results = {}
+    with open(filename, newline="") as f:
+        for row in csv.DictReader(f, delimiter="\t"):
+            key = tuple(row.get(column, "") for column in KEY_COLUMNS)
+            metrics = {}
+            for metric, value in row.items():
+                if metric is None or not metric.startswith("stage_"):
+                    continue
+                try:
+                    metrics[metric] = float(value)
+                except (TypeError, ValueError):
+                    pass  # Missing or non-numeric (e.g. the stage did not run)
+            results[key] = metrics
+    return results
+
+
+def geomean(values):
+    if not values:
+        return float("nan")
+    return math.exp(sum(math.log(v) for v in values) / len(values))
+
+
+def main():
+    args = parse_args()
+    baseline = load_results(args.baseline)
+    candidate = load_results(args.candidate)
+
+    common_keys = [key for key in baseline if key in candidate]
+    if not common_keys:
+        print("No circuits in common between {} and {}".format(args.baseline, args.candidate))
+        return 1
+
+    metrics = sorted({metric for key in common_keys for metric in baseline[key] if metric in candidate[key]})
+
+    ratios = {metric: [] for metric in metrics}
+    regressions = []
+    improvements = []
+    for key in common_keys:
+        for metric in metrics:
+            base_value = baseline[key].get(metric)
+            new_value = candidate[key].get(metric)
+            if base_value is None or new_value is None or base_value <= 0 or new_value <= 0:
+                continue
+            ratio = new_value / base_value
+            ratios[metric].append(ratio)
+
+            floor = args.min_mem if metric.endswith("_max_rss") else args.min_time
+            if abs(new_value - base_value) < floor:
+                continue
+            if ratio > 1 + args.threshold:
+                regressions.append((key, metric, base_value, new_value, ratio))
+            elif ratio < 1 - args.threshold:
+                improvements.append((key, metric, base_value, new_value, ratio))
+
+    print("Geometric mean of {} / {} over {} circuit(s):".format(args.candidate, args.baseline, len(common_keys)))
+    width = max(len(metric) for metric in metrics) if metrics else 0
+    for metric in metrics:
+        print("  {:<{width}}  {:.3f}  ({} circuits)".format(metric, geomean(ratios[metric]), len(ratios[metric]), width=width))
+
+    for title, changes in (("Regressions", regressions), ("Improvements", improvements)):
+        print()
+        print("{} (beyond {:.0f}%): {}".format(title, 100 * args.threshold, len(changes)))
+        for (arch, circuit, script_params), metric, base_value, new_value, ratio in changes:
+            print(
+                "  {} {} {}: {} {:g} -> {:g} ({:.2f}x)".format(
+                    arch, circuit, script_params, metric, base_value, new_value, ratio
+                ).rstrip()
+            )
+
+    if args.fail_on_regression and regressions:
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())